@@ -28,6 +28,17 @@
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
 
+#include "yb/util/flag_tags.h"
+#include "yb/util/size_literals.h"
+
+using namespace yb::size_literals;
+
+DEFINE_int32(cdc_max_get_changes_response_bytes, 8_MB,
+             "Approximate limit of the size of changes returned by a single GetChanges call. "
+             "Operations that are larger than this limit are split between several calls.");
+TAG_FLAG(cdc_max_get_changes_response_bytes, advanced);
+TAG_FLAG(cdc_max_get_changes_response_bytes, runtime);
+
 namespace yb {
 namespace cdc {
 
@@ -201,7 +212,8 @@ Result<TransactionStatusResult> GetTransactionStatus(
 Result<TxnStatusMap> BuildTxnStatusMap(const ReplicateMsgs& messages,
                                        bool more_replicate_msgs,
                                        const HybridTime& hybrid_time,
-                                       TransactionParticipant* txn_participant) {
+                                       TransactionParticipant* txn_participant,
+                                       TransactionStatusCache* txn_status_cache) {
   TxnStatusMap txn_map;
   // First go through all APPLYING records and mark transaction as committed.
   for (const auto& msg : messages) {
@@ -209,15 +221,22 @@ Result<TxnStatusMap> BuildTxnStatusMap(const ReplicateMsgs& messages,
         && msg->transaction_state().status() == TransactionStatus::APPLYING) {
       auto txn_id = VERIFY_RESULT(FullyDecodeTransactionId(
           msg->transaction_state().transaction_id()));
-      txn_map.emplace(txn_id,
-                      TransactionStatusResult(
-                          TransactionStatus::COMMITTED,
-                          HybridTime(msg->transaction_state().commit_hybrid_time())));
+      TransactionStatusResult txn_status(
+          TransactionStatus::COMMITTED,
+          HybridTime(msg->transaction_state().commit_hybrid_time()));
+      txn_map.emplace(txn_id, txn_status);
+      if (txn_status_cache) {
+        txn_status_cache->Put(txn_id, txn_status);
+      }
     }
   }
 
   // Now go through all WRITE_OP records and get transaction status of records for which
   // corresponding APPLYING record does not exist in WAL as yet.
+  // Records are not returned beyond the first write of a pending transaction, so once such
+  // a transaction is found, the rest of transactions are considered pending without asking
+  // the transaction participant for them.
+  bool found_pending = false;
   for (const auto& msg : messages) {
     if (msg->op_type() == consensus::OperationType::WRITE_OP
         && msg->write_request().write_batch().has_transaction()) {
@@ -227,24 +246,38 @@ Result<TxnStatusMap> BuildTxnStatusMap(const ReplicateMsgs& messages,
       if (!txn_map.count(txn_id)) {
         TransactionStatusResult txn_status(TransactionStatus::PENDING, HybridTime::kMin);
 
-        auto result = GetTransactionStatus(txn_id, hybrid_time, txn_participant);
-        if (!result.ok()) {
-          if (result.status().IsNotFound()) {
-            // Consider the transaction as aborted only if more_replicate_msgs is false.
-            // If more_replicate_messages is true, then it's possible that transaction is committed
-            // but we haven't read the commit message yet.
-            // Such a transaction will be considered as pending and will not be returned by CDC
-            // producer until the transaction is committed.
-            // TODO (#2405) : Handle long running or very large transactions correctly.
-            if (!more_replicate_msgs) {
-              LOG(INFO) << "Transaction not found, considering it aborted: " << txn_id;
-              txn_status = TransactionStatusResult::Aborted();
+        auto cached_status = txn_status_cache ? txn_status_cache->Get(txn_id) : boost::none;
+        if (cached_status) {
+          txn_status = *cached_status;
+        } else if (!found_pending) {
+          auto result = GetTransactionStatus(txn_id, hybrid_time, txn_participant);
+          if (!result.ok()) {
+            if (result.status().IsNotFound()) {
+              // Consider the transaction as aborted only if more_replicate_msgs is false.
+              // If more_replicate_messages is true, then it's possible that transaction is
+              // committed but we haven't read the commit message yet.
+              // Such a transaction will be considered as pending and will not be returned by CDC
+              // producer until the transaction is committed.
+              // TODO (#2405) : Handle long running or very large transactions correctly.
+              if (!more_replicate_msgs) {
+                LOG(INFO) << "Transaction not found, considering it aborted: " << txn_id;
+                txn_status = TransactionStatusResult::Aborted();
+              }
+            } else {
+              return result.status();
             }
           } else {
-            return result.status();
+            txn_status = *result;
+            if (txn_status_cache) {
+              txn_status_cache->Put(txn_id, txn_status);
+            }
           }
-        } else {
-          txn_status = *result;
+        }
+        // Writes from external sources are skipped when records are ordered, so they do not
+        // stop the records.
+        if ((txn_status.status == PENDING || txn_status.status == CREATED) &&
+            !msg->write_request().has_external_hybrid_time()) {
+          found_pending = true;
         }
         txn_map.emplace(txn_id, txn_status);
       }
@@ -265,11 +298,29 @@ CHECKED_STATUS SetRecordTxnAndTime(const TransactionId& txn_id,
   return Status::OK();
 }
 
+// Returns the size of write pairs of msg starting from first_pair, used to limit response size.
+size_t WritePairsSize(const consensus::ReplicateMsg& msg, size_t first_pair) {
+  if (msg.op_type() != consensus::OperationType::WRITE_OP) {
+    return 0;
+  }
+  const auto& write_pairs = msg.write_request().write_batch().write_pairs();
+  size_t result = 0;
+  for (auto i = first_pair; i < static_cast<size_t>(write_pairs.size()); ++i) {
+    result += write_pairs.Get(i).key().size() + write_pairs.Get(i).value().size();
+  }
+  return result;
+}
+
 // Populate CDC record corresponding to WAL batch in ReplicateMsg.
-CHECKED_STATUS PopulateWriteRecord(const ReplicateMsgPtr& msg,
+// Starts from write pair first_pair, and stops at the start of a row, once the write pairs
+// added to the response are larger than max_bytes. Returns the index of the first write pair
+// that was not added, which is the number of write pairs when the whole batch was added.
+Result<size_t> PopulateWriteRecord(const ReplicateMsgPtr& msg,
                                    const TxnStatusMap& txn_map,
                                    const StreamMetadata& metadata,
                                    const Schema& schema,
+                                   size_t first_pair,
+                                   size_t max_bytes,
                                    GetChangesResponsePB* resp) {
   const auto& batch = msg->write_request().write_batch();
 
@@ -278,7 +329,10 @@ CHECKED_STATUS PopulateWriteRecord(const ReplicateMsgPtr& msg,
   // We'll use DocDB key hash to identify the records that belong to the same row.
   Slice prev_key;
   CDCRecordPB* record = nullptr;
-  for (const auto& write_pair : batch.write_pairs()) {
+  size_t added_bytes = 0;
+  for (auto pair_index = first_pair; pair_index < static_cast<size_t>(batch.write_pairs_size());
+       ++pair_index) {
+    const auto& write_pair = batch.write_pairs(pair_index);
     Slice key = write_pair.key();
     const auto key_size = VERIFY_RESULT(
         docdb::DocKey::EncodedSize(key, docdb::DocKeyPart::WHOLE_DOC_KEY));
@@ -291,6 +345,9 @@ CHECKED_STATUS PopulateWriteRecord(const ReplicateMsgPtr& msg,
     // is part of the same row or not.
     Slice primary_key(key.data(), key_size);
     if (prev_key != primary_key) {
+      if (record && added_bytes > max_bytes) {
+        return pair_index;
+      }
       // Write pair contains record for different row. Create a new CDCRecord in this case.
       record = resp->add_records();
       Slice sub_doc_key = key;
@@ -325,6 +382,7 @@ CHECKED_STATUS PopulateWriteRecord(const ReplicateMsgPtr& msg,
     }
     prev_key = primary_key;
     DCHECK(record);
+    added_bytes += write_pair.key().size() + write_pair.value().size();
 
     if (metadata.record_format == CDCRecordFormat::WAL) {
       auto kv_pair = record->add_changes();
@@ -342,7 +400,30 @@ CHECKED_STATUS PopulateWriteRecord(const ReplicateMsgPtr& msg,
       }
     }
   }
-  return Status::OK();
+  return batch.write_pairs_size();
+}
+
+// Leaves only messages that fit max_bytes, but at least one message, in read_ops.
+void LimitMessagesSize(size_t first_write_pair, size_t max_bytes,
+                       consensus::ReadOpsResult* read_ops) {
+  auto& messages = read_ops->messages;
+  size_t total_bytes = 0;
+  size_t num_messages = 0;
+  for (const auto& msg : messages) {
+    const auto bytes = WritePairsSize(*msg, num_messages == 0 ? first_write_pair : 0);
+    if (num_messages > 0 && total_bytes + bytes > max_bytes) {
+      break;
+    }
+    total_bytes += bytes;
+    ++num_messages;
+  }
+  if (num_messages < messages.size()) {
+    messages.resize(num_messages);
+    if (read_ops->serialized_messages.size() > num_messages) {
+      read_ops->serialized_messages.resize(num_messages);
+    }
+    read_ops->have_more_messages = true;
+  }
 }
 
 // Populate CDC record corresponding to WAL UPDATE_TRANSACTION_OP entry.
@@ -357,15 +438,121 @@ CHECKED_STATUS PopulateTransactionRecord(const ReplicateMsgPtr& msg,
 
 } // namespace
 
+ChangesCache::ChangesCache(size_t capacity_bytes, MonoDelta ttl)
+    : capacity_bytes_(capacity_bytes), ttl_(ttl) {
+}
+
+std::string ChangesCache::MakeKey(const std::string& tablet_id,
+                                  const OpId& from_op_id,
+                                  uint32_t from_write_pair_index,
+                                  const StreamMetadata& stream_metadata,
+                                  uint32_t schema_version) {
+  return Format("$0:$1:$2:$3:$4:$5", tablet_id, from_op_id, from_write_pair_index,
+                static_cast<int>(stream_metadata.record_type),
+                static_cast<int>(stream_metadata.record_format), schema_version);
+}
+
+bool ChangesCache::Get(const std::string& key, GetChangesResponsePB* resp,
+                       int64_t* last_readable_opid_index) {
+  const auto now = CoarseMonoClock::Now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end() || it->second->expiration <= now) {
+    return false;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  const auto& entry = *it->second;
+  resp->mutable_records()->CopyFrom(entry.resp.records());
+  resp->mutable_checkpoint()->CopyFrom(entry.resp.checkpoint());
+  if (last_readable_opid_index) {
+    *last_readable_opid_index = entry.last_readable_opid_index;
+  }
+  return true;
+}
+
+void ChangesCache::Put(const std::string& key, const GetChangesResponsePB& resp,
+                       int64_t last_readable_opid_index) {
+  const auto now = CoarseMonoClock::Now();
+  const size_t size = key.size() + resp.SpaceUsedLong();
+  if (size > capacity_bytes_) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (index_.count(key)) {
+    return;
+  }
+  entries_.push_front(Entry {
+      key, GetChangesResponsePB(), last_readable_opid_index, size, now + ttl_ });
+  auto& entry = entries_.front();
+  entry.resp.mutable_records()->CopyFrom(resp.records());
+  entry.resp.mutable_checkpoint()->CopyFrom(resp.checkpoint());
+  index_.emplace(key, entries_.begin());
+  size_ += size;
+  EvictUnlocked(now);
+}
+
+void ChangesCache::EvictUnlocked(CoarseTimePoint now) {
+  // Entries are not ordered by expiration, so expired entries in the middle of the list are
+  // evicted when they reach its end, or are found expired by Get.
+  while (!entries_.empty() &&
+         (size_ > capacity_bytes_ || entries_.back().expiration <= now)) {
+    size_ -= entries_.back().size;
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+}
+
+TransactionStatusCache::TransactionStatusCache(size_t capacity) : capacity_(capacity) {
+}
+
+boost::optional<TransactionStatusResult> TransactionStatusCache::Get(const TransactionId& txn_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = statuses_.find(txn_id);
+  if (it == statuses_.end()) {
+    return boost::none;
+  }
+  return it->second;
+}
+
+void TransactionStatusCache::Put(const TransactionId& txn_id,
+                                 const TransactionStatusResult& status) {
+  if (status.status != TransactionStatus::COMMITTED &&
+      status.status != TransactionStatus::ABORTED) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!statuses_.emplace(txn_id, status).second) {
+    return;
+  }
+  order_.push_back(txn_id);
+  while (order_.size() > capacity_) {
+    statuses_.erase(order_.front());
+    order_.pop_front();
+  }
+}
+
 Status GetChanges(const std::string& stream_id,
                   const std::string& tablet_id,
                   const OpId& from_op_id,
+                  uint32_t from_write_pair_index,
                   const StreamMetadata& stream_metadata,
                   const std::shared_ptr<tablet::TabletPeer>& tablet_peer,
                   const MemTrackerPtr& mem_tracker,
                   consensus::ReplicateMsgsHolder* msgs_holder,
                   GetChangesResponsePB* resp,
-                  int64_t* last_readable_opid_index) {
+                  int64_t* last_readable_opid_index,
+                  ChangesCache* cache,
+                  TransactionStatusCache* txn_status_cache) {
+  std::string cache_key;
+  if (cache) {
+    const auto schema_version = tablet_peer->tablet()->metadata()->schema_version();
+    cache_key = ChangesCache::MakeKey(
+        tablet_id, from_op_id, from_write_pair_index, stream_metadata, schema_version);
+    if (cache->Get(cache_key, resp, last_readable_opid_index)) {
+      return Status::OK();
+    }
+  }
+
   // Request scope on transaction participant so that transactions are not removed from participant
   // while RequestScope is active.
   RequestScope request_scope;
@@ -381,11 +568,20 @@ Status GetChanges(const std::string& stream_id,
     consumption = ScopedTrackedConsumption(mem_tracker, read_ops.read_from_disk_size);
   }
 
+  const size_t max_bytes = std::max(FLAGS_cdc_max_get_changes_response_bytes, 1);
+  LimitMessagesSize(from_write_pair_index, max_bytes, &read_ops);
+  // The first message was partially returned by the previous call.
+  const ReplicateMsgPtr first_message =
+      read_ops.messages.empty() ? nullptr : read_ops.messages.front();
+
   TxnStatusMap txn_map = VERIFY_RESULT(BuildTxnStatusMap(
-      read_ops.messages, read_ops.have_more_messages, tablet_peer->Now(), txn_participant));
+      read_ops.messages, read_ops.have_more_messages, tablet_peer->Now(), txn_participant,
+      txn_status_cache));
 
   OpId checkpoint;
   auto ordered_messages = VERIFY_RESULT(SortWrites(read_ops.messages, txn_map, &checkpoint));
+  // Number of write pairs of the first message, that were returned, when it was split.
+  size_t split_write_pair_index = 0;
 
   for (const auto& msg : ordered_messages) {
     switch (msg->op_type()) {
@@ -393,10 +589,20 @@ Status GetChanges(const std::string& stream_id,
         RETURN_NOT_OK(PopulateTransactionRecord(msg, resp->add_records()));
         break;
 
-      case consensus::OperationType::WRITE_OP:
-        RETURN_NOT_OK(PopulateWriteRecord(msg, txn_map, stream_metadata,
-                                          *tablet_peer->tablet()->schema(), resp));
+      case consensus::OperationType::WRITE_OP: {
+        // Only the first message could be split, since it is the only message when it alone is
+        // larger than the limit.
+        const bool first = msg == first_message;
+        const auto next_pair = VERIFY_RESULT(PopulateWriteRecord(
+            msg, txn_map, stream_metadata, *tablet_peer->tablet()->schema(),
+            first ? from_write_pair_index : 0,
+            first ? max_bytes : std::numeric_limits<size_t>::max(), resp));
+        const auto& write_batch = msg->write_request().write_batch();
+        if (next_pair < static_cast<size_t>(write_batch.write_pairs_size())) {
+          split_write_pair_index = next_pair;
+        }
         break;
+      }
 
       default:
         // Nothing to do for other operation types.
@@ -409,8 +615,19 @@ Status GetChanges(const std::string& stream_id,
   }
   *msgs_holder = consensus::ReplicateMsgsHolder(
       nullptr, std::move(ordered_messages), std::move(consumption));
-  (checkpoint.index > 0 ? checkpoint : from_op_id).ToPB(
-      resp->mutable_checkpoint()->mutable_op_id());
+  if (split_write_pair_index) {
+    // The rest of the first message is returned by the next call.
+    from_op_id.ToPB(resp->mutable_checkpoint()->mutable_op_id());
+    resp->mutable_checkpoint()->set_write_pair_index(split_write_pair_index);
+  } else {
+    (checkpoint.index > 0 ? checkpoint : from_op_id).ToPB(
+        resp->mutable_checkpoint()->mutable_op_id());
+  }
+
+  // Empty results are not cached, so a later call could find newly replicated records.
+  if (cache && resp->records_size() > 0) {
+    cache->Put(cache_key, *resp, last_readable_opid_index ? *last_readable_opid_index : 0);
+  }
   return Status::OK();
 }
 
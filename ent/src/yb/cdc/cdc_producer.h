@@ -13,10 +13,15 @@
 #ifndef ENT_SRC_YB_CDC_CDC_PRODUCER_H
 #define ENT_SRC_YB_CDC_CDC_PRODUCER_H
 
+#include <deque>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include <boost/functional/hash.hpp>
+#include <boost/optional.hpp>
 #include <boost/unordered_map.hpp>
 
 #include "yb/cdc/cdc_service.service.h"
@@ -26,6 +31,7 @@
 #include "yb/consensus/consensus.pb.h"
 #include "yb/docdb/docdb.pb.h"
 #include "yb/tablet/tablet_fwd.h"
+#include "yb/util/monotime.h"
 #include "yb/util/opid.h"
 
 namespace yb {
@@ -43,15 +49,103 @@ struct StreamMetadata {
   }
 };
 
+// Cache of recent GetChanges results, shared by all streams of the tablet server.
+//
+// Streams with the same record type and format, that read a tablet from the same checkpoint,
+// produce the same records. So records decoded for one of them are reused by the others, instead
+// of reading and decoding the same WAL entries again. A cached result could have fewer records
+// than a fresh read, when more entries were replicated since it was produced. The rest of the
+// records are returned by the next call, that starts at the checkpoint of the cached result.
+class ChangesCache {
+ public:
+  ChangesCache(size_t capacity_bytes, MonoDelta ttl);
+
+  ChangesCache(const ChangesCache&) = delete;
+  void operator=(const ChangesCache&) = delete;
+
+  static std::string MakeKey(const std::string& tablet_id,
+                             const OpId& from_op_id,
+                             uint32_t from_write_pair_index,
+                             const StreamMetadata& stream_metadata,
+                             uint32_t schema_version);
+
+  // Fills records and checkpoint of resp from the entry for key. Returns false if there is no
+  // such entry.
+  bool Get(const std::string& key, GetChangesResponsePB* resp, int64_t* last_readable_opid_index);
+
+  void Put(const std::string& key, const GetChangesResponsePB& resp,
+           int64_t last_readable_opid_index);
+
+ private:
+  struct Entry {
+    std::string key;
+    GetChangesResponsePB resp;
+    int64_t last_readable_opid_index;
+    size_t size;
+    CoarseTimePoint expiration;
+  };
+
+  typedef std::list<Entry> Entries;
+
+  // Removes expired entries, and least recently used ones, while the cache is over capacity.
+  void EvictUnlocked(CoarseTimePoint now);
+
+  const size_t capacity_bytes_;
+  const MonoDelta ttl_;
+
+  std::mutex mutex_;
+  // Most recently used entries are at the front.
+  Entries entries_;
+  std::unordered_map<std::string, Entries::iterator> index_;
+  size_t size_ = 0;
+};
+
+// Final statuses of transactions, shared by all GetChanges calls of the tablet server.
+//
+// Commit times are learned from APPLYING records in the WAL, or from the transaction participant
+// when the APPLYING record was not read yet. Once known, they do not change, so following polls,
+// and other streams, reuse them instead of asking the transaction participant again. Only
+// committed and aborted statuses are cached. When the cache is full, the oldest entries are
+// evicted.
+class TransactionStatusCache {
+ public:
+  explicit TransactionStatusCache(size_t capacity);
+
+  TransactionStatusCache(const TransactionStatusCache&) = delete;
+  void operator=(const TransactionStatusCache&) = delete;
+
+  boost::optional<TransactionStatusResult> Get(const TransactionId& txn_id);
+
+  // Does nothing for statuses that are not final.
+  void Put(const TransactionId& txn_id, const TransactionStatusResult& status);
+
+ private:
+  const size_t capacity_;
+
+  std::mutex mutex_;
+  boost::unordered_map<TransactionId, TransactionStatusResult, TransactionIdHash> statuses_;
+  // Transaction ids in the order they were added.
+  std::deque<TransactionId> order_;
+};
+
+// Reads changes after from_op_id, skipping the first from_write_pair_index write pairs of the
+// following operation, that were returned by a previous call.
+// Responses are limited to about cdc_max_get_changes_response_bytes of changes. When a single
+// operation is larger, its rows are split between several responses, see CDCCheckpointPB.
+// When cache is not null, the result is taken from or stored to it. When txn_status_cache is not
+// null, transaction statuses are looked up in it before asking the transaction participant.
 CHECKED_STATUS GetChanges(const std::string& stream_id,
                           const std::string& tablet_id,
                           const OpId& op_id,
+                          uint32_t from_write_pair_index,
                           const StreamMetadata& record,
                           const std::shared_ptr<tablet::TabletPeer>& tablet_peer,
                           const std::shared_ptr<MemTracker>& mem_tracker,
                           consensus::ReplicateMsgsHolder* msgs_holder,
                           GetChangesResponsePB* resp,
-                          int64_t* last_readable_opid_index = nullptr);
+                          int64_t* last_readable_opid_index = nullptr,
+                          ChangesCache* cache = nullptr,
+                          TransactionStatusCache* txn_status_cache = nullptr);
 
 }  // namespace cdc
 }  // namespace yb
@@ -12,6 +12,7 @@
 
 #include "yb/cdc/cdc_service.h"
 
+#include <algorithm>
 #include <shared_mutex>
 #include <chrono>
 #include <memory>
@@ -46,6 +47,8 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/shared_lock.h"
+#include "yb/util/size_literals.h"
+#include "yb/util/threadpool.h"
 #include "yb/yql/cql/ql/util/statement_result.h"
 
 DEFINE_int32(cdc_read_rpc_timeout_ms, 30 * 1000,
@@ -67,6 +70,30 @@ DEFINE_int32(cdc_state_checkpoint_update_interval_ms, 15 * 1000,
 DEFINE_string(certs_for_cdc_dir, "",
               "Directory that contains certificate authorities for CDC producer universes.");
 
+DEFINE_int32(cdc_long_poll_check_interval_ms, 10,
+             "How often GetChanges calls that wait for new records check for them.");
+TAG_FLAG(cdc_long_poll_check_interval_ms, advanced);
+TAG_FLAG(cdc_long_poll_check_interval_ms, runtime);
+
+DEFINE_int32(cdc_long_poll_max_threads, 16,
+             "Maximum number of threads that serve GetChanges calls resumed after waiting for new "
+             "records.");
+TAG_FLAG(cdc_long_poll_max_threads, advanced);
+
+DEFINE_int32(cdc_changes_cache_size_mb, 64,
+             "Size of the cache of decoded GetChanges results, that is shared by streams that "
+             "read the same tablets. 0 disables the cache.");
+TAG_FLAG(cdc_changes_cache_size_mb, advanced);
+
+DEFINE_int32(cdc_changes_cache_ttl_ms, 10 * 1000,
+             "How long a decoded GetChanges result is kept in the cache.");
+TAG_FLAG(cdc_changes_cache_ttl_ms, advanced);
+
+DEFINE_int32(cdc_txn_status_cache_size, 100000,
+             "Number of committed and aborted transaction statuses, that GetChanges keeps to avoid "
+             "asking transaction participants for them again. 0 disables the cache.");
+TAG_FLAG(cdc_txn_status_cache_size, advanced);
+
 DEFINE_int32(update_min_cdc_indices_interval_secs, 60,
              "How often to read cdc_state table to get the minimum applied index for each tablet "
              "across all streams. This information is used to correctly keep log files that "
@@ -84,6 +111,7 @@ namespace yb {
 namespace cdc {
 
 using namespace std::literals;
+using namespace yb::size_literals;
 
 using rpc::RpcContext;
 using tserver::TSTabletManager;
@@ -107,15 +135,40 @@ CDCServiceImpl::CDCServiceImpl(TSTabletManager* tablet_manager,
       server->messenger());
   async_client_init_->Start();
 
+  if (FLAGS_cdc_changes_cache_size_mb > 0) {
+    changes_cache_ = std::make_unique<ChangesCache>(
+        FLAGS_cdc_changes_cache_size_mb * 1_MB,
+        MonoDelta::FromMilliseconds(FLAGS_cdc_changes_cache_ttl_ms));
+  }
+  if (FLAGS_cdc_txn_status_cache_size > 0) {
+    txn_status_cache_ = std::make_unique<TransactionStatusCache>(FLAGS_cdc_txn_status_cache_size);
+  }
+
   get_minimum_checkpoints_and_update_peers_thread_.reset(new std::thread(
       &CDCServiceImpl::ReadCdcMinReplicatedIndexForAllTabletsAndUpdatePeers, this));
+  CHECK_OK(ThreadPoolBuilder("cdc_long_poll")
+               .set_max_threads(std::max(FLAGS_cdc_long_poll_max_threads, 1))
+               .Build(&long_poll_pool_));
+  long_poll_thread_.reset(new std::thread(&CDCServiceImpl::LongPollChanges, this));
 }
 
 CDCServiceImpl::~CDCServiceImpl() {
+  cdc_service_stopped_.store(true, std::memory_order_release);
   if (get_minimum_checkpoints_and_update_peers_thread_) {
-    cdc_service_stopped_.store(true, std::memory_order_release);
     get_minimum_checkpoints_and_update_peers_thread_->join();
   }
+  if (long_poll_thread_) {
+    {
+      std::lock_guard<std::mutex> lock(long_poll_mutex_);
+      long_poll_cond_.notify_all();
+    }
+    long_poll_thread_->join();
+  }
+  if (long_poll_pool_) {
+    // Resumed calls must respond, so wait for them instead of dropping them.
+    long_poll_pool_->Wait();
+    long_poll_pool_->Shutdown();
+  }
 }
 
 namespace {
@@ -295,6 +348,22 @@ void CDCServiceImpl::GetChanges(const GetChangesRequestPB* req,
 
   YB_LOG_EVERY_N_SECS(INFO, 300) << "Received GetChanges request " << req->ShortDebugString();
 
+  // Only wait for calls that know their checkpoint, so resuming them does not read cdc_state.
+  // Respond before the client deadline, so an empty response is not mistaken for a failure.
+  auto wait_deadline = CoarseTimePoint::min();
+  if (req->wait_for_records_ms() > 0 && req->has_from_checkpoint()) {
+    wait_deadline = std::min(
+        CoarseMonoClock::Now() + req->wait_for_records_ms() * 1ms,
+        context.GetClientDeadline() - FLAGS_cdc_long_poll_check_interval_ms * 1ms);
+  }
+  DoGetChanges(req, resp, std::move(context), wait_deadline);
+}
+
+void CDCServiceImpl::DoGetChanges(const GetChangesRequestPB* req,
+                                  GetChangesResponsePB* resp,
+                                  RpcContext context,
+                                  CoarseTimePoint wait_deadline) {
+
   RPC_CHECK_AND_RETURN_ERROR(req->has_tablet_id(),
                              STATUS(InvalidArgument, "Tablet ID is required to get CDC changes"),
                              resp->mutable_error(),
@@ -338,9 +407,11 @@ void CDCServiceImpl::GetChanges(const GetChangesRequestPB* req,
 
   auto session = async_client_init_->client()->NewSession();
   OpId op_id;
+  uint32_t write_pair_index = 0;
 
   if (req->has_from_checkpoint()) {
     op_id = OpId::FromPB(req->from_checkpoint().op_id());
+    write_pair_index = req->from_checkpoint().write_pair_index();
   } else {
     auto result = GetLastCheckpoint(producer_tablet, session);
     RPC_CHECK_AND_RETURN_ERROR(result.ok(), result.status(), resp->mutable_error(),
@@ -356,14 +427,26 @@ void CDCServiceImpl::GetChanges(const GetChangesRequestPB* req,
   consensus::ReplicateMsgsHolder msgs_holder;
   MemTrackerPtr mem_tracker = GetMemTracker(tablet_peer, producer_tablet);
   s = cdc::GetChanges(
-      req->stream_id(), req->tablet_id(), op_id, *record->get(), tablet_peer, mem_tracker,
-      &msgs_holder, resp, &last_readable_index);
+      req->stream_id(), req->tablet_id(), op_id, write_pair_index, *record->get(), tablet_peer,
+      mem_tracker,
+      &msgs_holder, resp, &last_readable_index, changes_cache_.get(), txn_status_cache_.get());
   RPC_STATUS_RETURN_ERROR(
       s,
       resp->mutable_error(),
       s.IsNotFound() ? CDCErrorPB::CHECKPOINT_TOO_OLD : CDCErrorPB::UNKNOWN_ERROR,
       context);
 
+  if (resp->records_size() == 0 && OpId::FromPB(resp->checkpoint().op_id()) == op_id &&
+      resp->checkpoint().write_pair_index() == write_pair_index &&
+      CoarseMonoClock::Now() < wait_deadline) {
+    // Nothing new to send, park the call until new entries are committed.
+    resp->Clear();
+    std::lock_guard<std::mutex> lock(long_poll_mutex_);
+    long_poll_calls_.push_back(LongPollCall {
+        req, resp, std::move(context), tablet_peer, op_id.index, wait_deadline });
+    return;
+  }
+
   uint64_t last_record_hybrid_time = resp->records_size() > 0 ?
       resp->records(resp->records_size() - 1).time() : 0;
 
@@ -406,6 +489,62 @@ void CDCServiceImpl::GetChanges(const GetChangesRequestPB* req,
   context.RespondSuccess();
 }
 
+void CDCServiceImpl::LongPollChanges() {
+  std::vector<LongPollCall> calls;
+  std::vector<LongPollCall> ready_calls;
+  for (;;) {
+    const bool stopped = cdc_service_stopped_.load(std::memory_order_acquire);
+    {
+      std::unique_lock<std::mutex> lock(long_poll_mutex_);
+      calls.insert(calls.end(), std::make_move_iterator(long_poll_calls_.begin()),
+                   std::make_move_iterator(long_poll_calls_.end()));
+      long_poll_calls_.clear();
+      if (calls.empty()) {
+        if (stopped) {
+          break;
+        }
+        long_poll_cond_.wait_for(
+            lock, GetAtomicFlag(&FLAGS_cdc_long_poll_check_interval_ms) * 1ms);
+        continue;
+      }
+    }
+
+    // Calls that still have to wait are moved to the front.
+    const auto now = CoarseMonoClock::Now();
+    auto it = std::partition(calls.begin(), calls.end(), [stopped, now](LongPollCall& call) {
+      if (stopped || now >= call.deadline) {
+        return false;
+      }
+      auto consensus = call.tablet_peer->shared_consensus();
+      return consensus && consensus->GetLastCommittedOpId().index <= call.from_index &&
+             IsTabletPeerLeader(call.tablet_peer);
+    });
+    ready_calls.assign(std::make_move_iterator(it), std::make_move_iterator(calls.end()));
+    calls.erase(it, calls.end());
+
+    // Resumed calls do not wait anymore, so they always respond. They read the log and update
+    // cdc_state, so they are served by long_poll_pool_, and this thread only tracks waits.
+    for (auto& call : ready_calls) {
+      auto resumed_call = std::make_shared<LongPollCall>(std::move(call));
+      auto status = long_poll_pool_->SubmitFunc([this, resumed_call] {
+        DoGetChanges(resumed_call->req, resumed_call->resp, std::move(resumed_call->context),
+                     CoarseTimePoint::min());
+      });
+      if (!status.ok()) {
+        LOG(WARNING) << "Failed to resume GetChanges call in thread pool: " << status;
+        DoGetChanges(resumed_call->req, resumed_call->resp, std::move(resumed_call->context),
+                     CoarseTimePoint::min());
+      }
+    }
+    ready_calls.clear();
+
+    if (!stopped) {
+      std::unique_lock<std::mutex> lock(long_poll_mutex_);
+      long_poll_cond_.wait_for(lock, GetAtomicFlag(&FLAGS_cdc_long_poll_check_interval_ms) * 1ms);
+    }
+  }
+}
+
 void CDCServiceImpl::UpdatePeersCdcMinReplicatedIndex(const TabletId& tablet_id,
                                                       int64_t min_index) {
   std::vector<client::internal::RemoteTabletServer *> servers;
@@ -15,6 +15,10 @@
 
 #include "yb/cdc/cdc_service.service.h"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/mem_fun.hpp>
 #include <boost/multi_index/member.hpp>
@@ -40,6 +44,8 @@
 
 namespace yb {
 
+class ThreadPool;
+
 namespace tserver {
 
 class TSTabletManager;
@@ -117,6 +123,16 @@ class CDCServiceImpl : public CDCServiceIf {
   template <class ReqType, class RespType>
   bool CheckOnline(const ReqType* req, RespType* resp, rpc::RpcContext* rpc);
 
+  // Serves GetChanges. When no records are available and wait_deadline is not reached yet, the
+  // call is parked until new entries are committed to the tablet, see LongPollChanges.
+  void DoGetChanges(const GetChangesRequestPB* req,
+                    GetChangesResponsePB* resp,
+                    rpc::RpcContext context,
+                    CoarseTimePoint wait_deadline);
+
+  // Body of long_poll_thread_, that resumes parked GetChanges calls on long_poll_pool_.
+  void LongPollChanges();
+
   Result<OpId> GetLastCheckpoint(const ProducerTabletInfo& producer_tablet,
                                  const std::shared_ptr<client::YBSession>& session);
 
@@ -258,6 +274,34 @@ class CDCServiceImpl : public CDCServiceIf {
   // True when this service is stopped. Used to inform
   // get_minimum_checkpoints_and_update_peers_thread_ that it should exit.
   std::atomic<bool> cdc_service_stopped_{false};
+
+  // GetChanges call that waits for new records.
+  struct LongPollCall {
+    const GetChangesRequestPB* req;
+    GetChangesResponsePB* resp;
+    rpc::RpcContext context;
+    std::shared_ptr<tablet::TabletPeer> tablet_peer;
+    // The call is resumed when an entry after this index is committed.
+    int64_t from_index;
+    CoarseTimePoint deadline;
+  };
+
+  // Decoded GetChanges results shared by streams, null when disabled.
+  std::unique_ptr<ChangesCache> changes_cache_;
+
+  // Final transaction statuses shared by GetChanges calls, null when disabled.
+  std::unique_ptr<TransactionStatusCache> txn_status_cache_;
+
+  std::mutex long_poll_mutex_;
+  std::condition_variable long_poll_cond_;
+  std::vector<LongPollCall> long_poll_calls_ GUARDED_BY(long_poll_mutex_);
+
+  // Thread that periodically checks parked GetChanges calls, and resumes those that have new
+  // records or whose wait time has expired.
+  std::unique_ptr<std::thread> long_poll_thread_;
+
+  // Serves GetChanges calls resumed by long_poll_thread_.
+  std::unique_ptr<ThreadPool> long_poll_pool_;
 };
 
 }  // namespace cdc
@@ -1,6 +1,9 @@
 // Copyright (c) YugaByte, Inc.
 
+#include <thread>
+
 #include <boost/lexical_cast.hpp>
+#include <boost/optional.hpp>
 
 #include "yb/common/wire_protocol.h"
 #include "yb/common/wire_protocol-test-util.h"
@@ -43,6 +46,7 @@ DECLARE_bool(enable_load_balancing);
 DECLARE_bool(enable_log_retention_by_op_idx);
 DECLARE_bool(enable_ysql);
 DECLARE_double(leader_failure_max_missed_heartbeat_periods);
+DECLARE_int32(cdc_max_get_changes_response_bytes);
 DECLARE_int32(cdc_min_replicated_index_considered_stale_secs);
 DECLARE_int32(cdc_state_checkpoint_update_interval_ms);
 DECLARE_int32(cdc_wal_retention_time_secs);
@@ -609,6 +613,173 @@ TEST_F(CDCServiceTest, TestGetChanges) {
   }
 }
 
+// Streams that read the same tablet get the same records, when the results are shared through
+// the changes cache.
+TEST_F(CDCServiceTest, TestGetChangesSameTabletMultipleStreams) {
+  constexpr int kNumStreams = 3;
+  std::vector<CDCStreamId> stream_ids(kNumStreams);
+  for (auto& stream_id : stream_ids) {
+    CreateCDCStream(cdc_proxy_, table_.table()->id(), &stream_id);
+  }
+
+  std::string tablet_id;
+  GetTablet(&tablet_id);
+
+  tserver::WriteRequestPB write_req;
+  tserver::WriteResponsePB write_resp;
+  write_req.set_tablet_id(tablet_id);
+  AddTestRowInsert(1, 11, "key1", &write_req);
+  AddTestRowInsert(2, 22, "key2", &write_req);
+  {
+    RpcController rpc;
+    ASSERT_OK(cluster_->mini_tablet_server(0)->server()->proxy()->Write(
+        write_req, &write_resp, &rpc));
+    ASSERT_FALSE(write_resp.has_error()) << write_resp.ShortDebugString();
+  }
+
+  boost::optional<GetChangesResponsePB> first_resp;
+  for (const auto& stream_id : stream_ids) {
+    GetChangesRequestPB change_req;
+    GetChangesResponsePB change_resp;
+    change_req.set_tablet_id(tablet_id);
+    change_req.set_stream_id(stream_id);
+    change_req.mutable_from_checkpoint()->mutable_op_id()->set_index(0);
+    change_req.mutable_from_checkpoint()->mutable_op_id()->set_term(0);
+
+    RpcController rpc;
+    ASSERT_OK(cdc_proxy_->GetChanges(change_req, &change_resp, &rpc));
+    ASSERT_FALSE(change_resp.has_error()) << change_resp.ShortDebugString();
+    ASSERT_EQ(change_resp.records_size(), 2);
+    if (!first_resp) {
+      first_resp = change_resp;
+      continue;
+    }
+    ASSERT_EQ(first_resp->checkpoint().ShortDebugString(),
+              change_resp.checkpoint().ShortDebugString());
+    for (int i = 0; i != change_resp.records_size(); ++i) {
+      ASSERT_EQ(first_resp->records(i).ShortDebugString(),
+                change_resp.records(i).ShortDebugString());
+    }
+  }
+}
+
+TEST_F(CDCServiceTest, TestGetChangesSplitsLargeOperations) {
+  CDCStreamId stream_id;
+  CreateCDCStream(cdc_proxy_, table_.table()->id(), &stream_id);
+
+  std::string tablet_id;
+  GetTablet(&tablet_id);
+
+  const auto& proxy = cluster_->mini_tablet_server(0)->server()->proxy();
+  {
+    // Single operation with 3 rows.
+    tserver::WriteRequestPB write_req;
+    tserver::WriteResponsePB write_resp;
+    write_req.set_tablet_id(tablet_id);
+    AddTestRowInsert(1, 11, "key1", &write_req);
+    AddTestRowInsert(2, 22, "key2", &write_req);
+    AddTestRowInsert(3, 33, "key3", &write_req);
+    RpcController rpc;
+    ASSERT_OK(proxy->Write(write_req, &write_resp, &rpc));
+    ASSERT_FALSE(write_resp.has_error()) << write_resp.ShortDebugString();
+  }
+  WriteTestRow(4, 44, "key4", tablet_id, proxy);
+
+  // Every response is limited to a single row.
+  FLAGS_cdc_max_get_changes_response_bytes = 1;
+
+  GetChangesRequestPB change_req;
+  change_req.set_tablet_id(tablet_id);
+  change_req.set_stream_id(stream_id);
+  change_req.mutable_from_checkpoint()->mutable_op_id()->set_index(0);
+  change_req.mutable_from_checkpoint()->mutable_op_id()->set_term(0);
+
+  std::vector<int32_t> keys;
+  bool split = false;
+  for (int i = 0; i != 20 && keys.size() < 4; ++i) {
+    GetChangesResponsePB change_resp;
+    RpcController rpc;
+    ASSERT_OK(cdc_proxy_->GetChanges(change_req, &change_resp, &rpc));
+    ASSERT_FALSE(change_resp.has_error()) << change_resp.ShortDebugString();
+    ASSERT_LE(change_resp.records_size(), 1) << change_resp.ShortDebugString();
+    for (const auto& record : change_resp.records()) {
+      keys.push_back(record.key(0).value().int32_value());
+    }
+    split = split || change_resp.checkpoint().write_pair_index() > 0;
+    *change_req.mutable_from_checkpoint() = change_resp.checkpoint();
+  }
+  ASSERT_EQ(keys, std::vector<int32_t>({1, 2, 3, 4}));
+  ASSERT_TRUE(split);
+}
+
+TEST_F(CDCServiceTest, TestGetChangesLongPoll) {
+  CDCStreamId stream_id;
+  CreateCDCStream(cdc_proxy_, table_.table()->id(), &stream_id);
+
+  std::string tablet_id;
+  GetTablet(&tablet_id);
+
+  const auto& proxy = cluster_->mini_tablet_server(0)->server()->proxy();
+  auto write_row = [&](int key) {
+    tserver::WriteRequestPB write_req;
+    tserver::WriteResponsePB write_resp;
+    write_req.set_tablet_id(tablet_id);
+    AddTestRowInsert(key, key * 11, Format("key$0", key), &write_req);
+    RpcController rpc;
+    ASSERT_OK(proxy->Write(write_req, &write_resp, &rpc));
+    ASSERT_FALSE(write_resp.has_error()) << write_resp.ShortDebugString();
+  };
+  ASSERT_NO_FATALS(write_row(1));
+
+  GetChangesRequestPB change_req;
+  GetChangesResponsePB change_resp;
+  change_req.set_tablet_id(tablet_id);
+  change_req.set_stream_id(stream_id);
+  change_req.mutable_from_checkpoint()->mutable_op_id()->set_index(0);
+  change_req.mutable_from_checkpoint()->mutable_op_id()->set_term(0);
+  {
+    RpcController rpc;
+    ASSERT_OK(cdc_proxy_->GetChanges(change_req, &change_resp, &rpc));
+    ASSERT_FALSE(change_resp.has_error()) << change_resp.ShortDebugString();
+    ASSERT_EQ(change_resp.records_size(), 1);
+  }
+
+  // Without new records, the call waits for the requested time and returns nothing.
+  constexpr auto kShortWait = 500ms;
+  change_req.mutable_from_checkpoint()->CopyFrom(change_resp.checkpoint());
+  change_req.set_wait_for_records_ms(ToMilliseconds(kShortWait));
+  change_resp.Clear();
+  {
+    RpcController rpc;
+    auto start = CoarseMonoClock::Now();
+    ASSERT_OK(cdc_proxy_->GetChanges(change_req, &change_resp, &rpc));
+    ASSERT_FALSE(change_resp.has_error()) << change_resp.ShortDebugString();
+    ASSERT_EQ(change_resp.records_size(), 0);
+    ASSERT_GE(CoarseMonoClock::Now() - start, kShortWait);
+  }
+
+  // A waiting call responds as soon as a new record is written.
+  constexpr auto kLongWait = 20s;
+  change_req.set_wait_for_records_ms(ToMilliseconds(kLongWait));
+  change_resp.Clear();
+  auto start = CoarseMonoClock::Now();
+  Status status;
+  std::thread poll_thread([this, &change_req, &change_resp, &status] {
+    RpcController rpc;
+    rpc.set_timeout(MonoDelta::FromSeconds(60));
+    status = cdc_proxy_->GetChanges(change_req, &change_resp, &rpc);
+  });
+  std::this_thread::sleep_for(kShortWait);
+  write_row(2);
+  poll_thread.join();
+  ASSERT_FALSE(HasFatalFailure());
+  ASSERT_OK(status);
+  ASSERT_FALSE(change_resp.has_error()) << change_resp.ShortDebugString();
+  ASSERT_EQ(change_resp.records_size(), 1);
+  ASSERT_NO_FATALS(AssertIntKey(change_resp.records(0).key(), 2));
+  ASSERT_LT(CoarseMonoClock::Now() - start, kLongWait);
+}
+
 TEST_F(CDCServiceTest, TestGetChangesInvalidStream) {
   std::string tablet_id;
   GetTablet(&tablet_id);
@@ -32,6 +32,8 @@
 namespace yb {
 namespace cdc {
 
+using namespace std::literals;
+
 using client::Flush;
 using client::TransactionTestBase;
 using client::WriteOpType;
@@ -220,5 +222,78 @@ TEST_F(CDCServiceTxnTest, TestGetChangesForPendingTransaction) {
   }
 }
 
+TEST_F(CDCServiceTxnTest, TestGetChangesStopsAtPendingTransaction) {
+  // Consider the following writes:
+  // T0: WRITE K1 (TXN1)
+  // T1: APPLYING TXN1
+  // T2: WRITE K2 (TXN2)
+  // T3: WRITE K3 (TXN3)
+  // T4: APPLYING TXN3
+  // While TXN2 is pending, only K1 could be returned, because K3 could be committed after K2.
+  // Once TXN2 is committed, the rest of records are returned in commit order: K3, K2.
+
+  // Get tablet ID.
+  google::protobuf::RepeatedPtrField<master::TabletLocationsPB> tablets;
+  ASSERT_OK(client_->GetTablets(table_->name(), 0, &tablets));
+  ASSERT_EQ(tablets.size(), 1);
+
+  // Create CDC stream on table.
+  CDCStreamId stream_id;
+  CreateCDCStream(cdc_proxy_, table_.table()->id(), &stream_id);
+
+  auto txn1 = CreateTransaction();
+  auto session1 = CreateSession(txn1);
+  ASSERT_RESULT(WriteRow(session1, 10001 /* key */, 10001 /* value */, WriteOpType::INSERT,
+                         Flush::kTrue));
+  ASSERT_OK(txn1->CommitFuture().get());
+
+  auto txn2 = CreateTransaction();
+  auto session2 = CreateSession(txn2);
+  ASSERT_RESULT(WriteRow(session2, 10002 /* key */, 10002 /* value */, WriteOpType::INSERT,
+                         Flush::kTrue));
+
+  auto txn3 = CreateTransaction();
+  auto session3 = CreateSession(txn3);
+  ASSERT_RESULT(WriteRow(session3, 10003 /* key */, 10003 /* value */, WriteOpType::INSERT,
+                         Flush::kTrue));
+  ASSERT_OK(txn3->CommitFuture().get());
+
+  GetChangesRequestPB change_req;
+  GetChangesResponsePB change_resp;
+
+  change_req.set_stream_id(stream_id);
+  change_req.set_tablet_id(tablets.Get(0).tablet_id());
+  change_req.mutable_from_checkpoint()->mutable_op_id()->set_index(0);
+  change_req.mutable_from_checkpoint()->mutable_op_id()->set_term(0);
+
+  std::vector<int32_t> keys;
+  auto get_changes = [&]() -> Status {
+    RpcController rpc;
+    change_resp.Clear();
+    RETURN_NOT_OK(cdc_proxy_->GetChanges(change_req, &change_resp, &rpc));
+    if (change_resp.has_error()) {
+      return StatusFromPB(change_resp.error().status());
+    }
+    for (const auto& record : change_resp.records()) {
+      if (record.key_size() > 0) {
+        keys.push_back(record.key(0).value().int32_value());
+      }
+    }
+    *change_req.mutable_from_checkpoint() = change_resp.checkpoint();
+    return Status::OK();
+  };
+
+  ASSERT_OK(get_changes());
+  ASSERT_EQ(keys, std::vector<int32_t>({10001}));
+
+  ASSERT_OK(txn2->CommitFuture().get());
+
+  ASSERT_OK(WaitFor([&]() -> Result<bool> {
+    RETURN_NOT_OK(get_changes());
+    return keys.size() >= 3;
+  }, 10s * kTimeMultiplier, "Wait for records of committed transactions"));
+  ASSERT_EQ(keys, std::vector<int32_t>({10001, 10003, 10002}));
+}
+
 } // namespace cdc
 } // namespace yb
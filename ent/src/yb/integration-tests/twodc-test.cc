@@ -72,6 +72,8 @@ DECLARE_bool(TEST_check_broadcast_address);
 DECLARE_int32(replication_failure_delay_exponent);
 DECLARE_double(respond_write_failed_probability);
 DECLARE_int32(cdc_max_apply_batch_num_records);
+DECLARE_int32(cdc_max_parallel_apply_writes);
+DECLARE_bool(async_replication_pipeline_polls);
 
 namespace yb {
 
@@ -340,6 +342,32 @@ class TwoDCTest : public YBTest, public testing::WithParamInterface<int> {
     return size;
   }
 
+  uint32_t GetUnexpectedApplyResponses(MiniCluster* cluster) {
+    uint32_t size = 0;
+    for (const auto& mini_tserver : cluster->mini_tablet_servers()) {
+      auto* tserver = dynamic_cast<tserver::enterprise::TabletServer*>(
+          mini_tserver->server());
+      CDCConsumer* cdc_consumer;
+      if (tserver && (cdc_consumer = tserver->GetCDCConsumer())) {
+        size += cdc_consumer->GetNumUnexpectedApplyResponses();
+      }
+    }
+    return size;
+  }
+
+  // Writes inserts and deletes of the same keys, so the result depends on the order, in which
+  // writes to each tablet are applied. Keys inserted at the end make the final result differ from
+  // the intermediate ones.
+  void WriteInsertDeleteWorkload(uint32_t num_keys, uint32_t num_runs, YBClient* client,
+                                 const YBTableName& table) {
+    WriteWorkload(0, num_keys, client, table);
+    for (uint32_t i = 0; i < num_runs; i++) {
+      WriteWorkload(0, num_keys, client, table, true /* delete_op */);
+      WriteWorkload(0, num_keys, client, table);
+    }
+    WriteWorkload(num_keys, num_keys + 10, client, table);
+  }
+
   void WriteTransactionalWorkload(uint32_t start, uint32_t end, YBClient* client,
                                   client::TransactionManager* txn_mgr, const YBTableName& table) {
     auto session = client->NewSession();
@@ -857,6 +885,93 @@ TEST_P(TwoDCTest, ApplyOperations) {
   Destroy();
 }
 
+TEST_P(TwoDCTest, ApplyOperationsManyProducerTablets) {
+  // Writes of all producer tablets go to the same consumer tablet, and could be merged.
+  auto tables = ASSERT_RESULT(SetUpWithParams({8}, {1}, 1));
+
+  std::vector<std::shared_ptr<client::YBTable>> producer_tables;
+  producer_tables.push_back(tables[0]);
+  ASSERT_OK(SetupUniverseReplication(
+      producer_cluster(), consumer_cluster(), consumer_client(), kUniverseId, producer_tables));
+
+  ASSERT_OK(CorrectlyPollingAllTablets(consumer_cluster(), 8));
+
+  WriteWorkload(0, 100, producer_client(), tables[0]->name());
+  ASSERT_OK(VerifyWrittenRecords(tables[0]->name(), tables[1]->name()));
+
+  DeleteWorkload(0, 50, producer_client(), tables[0]->name());
+  ASSERT_OK(VerifyWrittenRecords(tables[0]->name(), tables[1]->name()));
+
+  ASSERT_OK(DeleteUniverseReplication(kUniverseId));
+  Destroy();
+}
+
+TEST_P(TwoDCTest, ApplyOperationsParallelWrites) {
+  // Each batch of changes of the producer tablet is written to many consumer tablets in parallel,
+  // writes to the same consumer tablet should still be applied in order.
+  FLAGS_cdc_max_parallel_apply_writes = 4;
+  auto tables = ASSERT_RESULT(SetUpWithParams({8}, {1}, 1));
+
+  WriteInsertDeleteWorkload(100, 3, producer_client(), tables[0]->name());
+
+  std::vector<std::shared_ptr<client::YBTable>> producer_tables;
+  producer_tables.push_back(tables[0]);
+  ASSERT_OK(SetupUniverseReplication(
+      producer_cluster(), consumer_cluster(), consumer_client(), kUniverseId, producer_tables));
+  ASSERT_OK(CorrectlyPollingAllTablets(consumer_cluster(), 1));
+
+  ASSERT_OK(VerifyWrittenRecords(tables[0]->name(), tables[1]->name()));
+  ASSERT_EQ(GetUnexpectedApplyResponses(consumer_cluster()), 0);
+
+  ASSERT_OK(DeleteUniverseReplication(kUniverseId));
+  Destroy();
+}
+
+TEST_P(TwoDCTest, ApplyOperationsParallelWritesWithFailures) {
+  // Some of the parallel writes fail while others are in flight. The poller should get exactly
+  // one response with the error for each attempt to apply a batch, and apply it again.
+  FLAGS_cdc_max_parallel_apply_writes = 4;
+  SetAtomicFlag(0.25, &FLAGS_respond_write_failed_probability);
+  auto tables = ASSERT_RESULT(SetUpWithParams({8}, {1}, 1));
+
+  WriteInsertDeleteWorkload(100, 3, producer_client(), tables[0]->name());
+
+  std::vector<std::shared_ptr<client::YBTable>> producer_tables;
+  producer_tables.push_back(tables[0]);
+  ASSERT_OK(SetupUniverseReplication(
+      producer_cluster(), consumer_cluster(), consumer_client(), kUniverseId, producer_tables));
+  ASSERT_OK(CorrectlyPollingAllTablets(consumer_cluster(), 1));
+
+  ASSERT_OK(VerifyWrittenRecords(tables[0]->name(), tables[1]->name()));
+  ASSERT_EQ(GetUnexpectedApplyResponses(consumer_cluster()), 0);
+
+  SetAtomicFlag(0.0, &FLAGS_respond_write_failed_probability);
+  ASSERT_OK(DeleteUniverseReplication(kUniverseId));
+  Destroy();
+}
+
+TEST_P(TwoDCTest, PipelinedPollsApplyInOrder) {
+  // Changes are polled while the previous ones are applied, the applied checkpoint of each poller
+  // should still move forward only.
+  FLAGS_async_replication_pipeline_polls = true;
+  FLAGS_cdc_max_parallel_apply_writes = 4;
+  auto tables = ASSERT_RESULT(SetUpWithParams({8}, {4}, 1));
+
+  std::vector<std::shared_ptr<client::YBTable>> producer_tables;
+  producer_tables.push_back(tables[0]);
+  ASSERT_OK(SetupUniverseReplication(
+      producer_cluster(), consumer_cluster(), consumer_client(), kUniverseId, producer_tables));
+  ASSERT_OK(CorrectlyPollingAllTablets(consumer_cluster(), 4));
+
+  WriteInsertDeleteWorkload(100, 5, producer_client(), tables[0]->name());
+
+  ASSERT_OK(VerifyWrittenRecords(tables[0]->name(), tables[1]->name()));
+  ASSERT_EQ(GetUnexpectedApplyResponses(consumer_cluster()), 0);
+
+  ASSERT_OK(DeleteUniverseReplication(kUniverseId));
+  Destroy();
+}
+
 TEST_P(TwoDCTest, ApplyOperationsWithTransactions) {
   uint32_t replication_factor = NonTsanVsTsan(3, 1);
   auto tables = ASSERT_RESULT(SetUpWithParams({2}, {2}, replication_factor));
@@ -16,6 +16,7 @@
 #include "yb/rpc/messenger.h"
 
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet.pb.h"
 #include "yb/tablet/tablet_snapshots.h"
 
 #include "yb/tserver/backup.proxy.h"
@@ -24,6 +25,12 @@
 #include "yb/tserver/tablet_server-test-base.h"
 #include "yb/tserver/ts_tablet_manager.h"
 
+#include "yb/util/countdown_latch.h"
+#include "yb/util/pb_util.h"
+
+DECLARE_int32(max_concurrent_tablet_restores);
+DECLARE_int32(TEST_delay_tablet_restore_ms);
+
 namespace yb {
 namespace tserver {
 
@@ -177,5 +184,132 @@ TEST_F(BackupServiceTest, TestSnapshotData) {
   LOG(INFO) << "THE TABLET DATA IS VALID. Test TestSnapshotData finished.";
 }
 
+TEST_F(BackupServiceTest, TestSnapshotManifest) {
+  std::shared_ptr<TabletPeer> tablet;
+  ASSERT_TRUE(mini_server_->server()->tablet_manager()->LookupTablet(kTabletId, &tablet));
+  Env* const env = tablet->tablet_metadata()->fs_manager()->env();
+  const string top_snapshots_dir =
+      tablet::TabletSnapshots::SnapshotsDirName(tablet->tablet_metadata()->rocksdb_dir());
+
+  const string snapshot_ids[] = {
+      "00000000000000000000000000000001", "00000000000000000000000000000002" };
+  std::vector<tablet::SnapshotManifestPB> manifests;
+  int32_t key = 0;
+  for (const auto& snapshot_id : snapshot_ids) {
+    ++key;
+    WriteRequestPB write_req;
+    WriteResponsePB write_resp;
+    write_req.set_tablet_id(kTabletId);
+    AddTestRowInsert(key, key * 11, "key1", &write_req);
+    {
+      RpcController rpc;
+      ASSERT_OK(proxy_->Write(write_req, &write_resp, &rpc));
+      ASSERT_FALSE(write_resp.has_error()) << write_resp.ShortDebugString();
+    }
+
+    TabletSnapshotOpRequestPB req;
+    TabletSnapshotOpResponsePB resp;
+    req.set_operation(TabletSnapshotOpRequestPB::CREATE);
+    req.set_dest_uuid(mini_server_->server()->fs_manager()->uuid());
+    req.set_snapshot_id(snapshot_id);
+    req.set_tablet_id(kTabletId);
+    {
+      RpcController rpc;
+      ASSERT_OK(backup_proxy_->TabletSnapshotOp(req, &resp, &rpc));
+      ASSERT_FALSE(resp.has_error()) << resp.ShortDebugString();
+    }
+
+    tablet::SnapshotManifestPB manifest;
+    ASSERT_OK(pb_util::ReadPBContainerFromPath(
+        env,
+        tablet::TabletSnapshots::SnapshotManifestPath(
+            JoinPathSegments(top_snapshots_dir, snapshot_id)),
+        &manifest));
+    LOG(INFO) << "Manifest: " << manifest.ShortDebugString();
+    ASSERT_EQ(manifest.snapshot_id(), snapshot_id);
+    manifests.push_back(std::move(manifest));
+  }
+
+  // The first snapshot has no base, all of its files are new.
+  ASSERT_FALSE(manifests[0].has_base_snapshot_id());
+  for (const auto& file : manifests[0].files()) {
+    ASSERT_FALSE(file.in_base()) << file.ShortDebugString();
+  }
+
+  // The second snapshot shares the SST file, flushed by the first one, with it.
+  ASSERT_EQ(manifests[1].base_snapshot_id(), snapshot_ids[0]);
+  std::unordered_map<string, string> base_content_ids;
+  for (const auto& file : manifests[0].files()) {
+    base_content_ids.emplace(file.name(), file.content_id());
+  }
+  int shared_files = 0;
+  for (const auto& file : manifests[1].files()) {
+    if (file.in_base()) {
+      ASSERT_EQ(file.content_id(), base_content_ids[file.name()]);
+      ++shared_files;
+    } else if (base_content_ids.count(file.name())) {
+      ASSERT_NE(file.content_id(), base_content_ids[file.name()]);
+    }
+  }
+  ASSERT_GT(shared_files, 0);
+  ASSERT_LT(shared_files, manifests[1].files_size());
+}
+
+class BackupServiceRestoreLimitTest : public BackupServiceTest {
+ protected:
+  void SetUp() override {
+    FLAGS_max_concurrent_tablet_restores = 1;
+    BackupServiceTest::SetUp();
+  }
+};
+
+// Restores over the limit are rejected before being submitted, and the limit is released when a
+// restore completes.
+TEST_F(BackupServiceRestoreLimitTest, TestConcurrentRestores) {
+  TabletSnapshotOpRequestPB req;
+  req.set_operation(TabletSnapshotOpRequestPB::CREATE);
+  req.set_dest_uuid(mini_server_->server()->fs_manager()->uuid());
+  req.set_snapshot_id("00000000000000000000000000000000");
+  req.set_tablet_id(kTabletId);
+  {
+    TabletSnapshotOpResponsePB resp;
+    RpcController rpc;
+    ASSERT_OK(backup_proxy_->TabletSnapshotOp(req, &resp, &rpc));
+    ASSERT_FALSE(resp.has_error()) << resp.DebugString();
+  }
+
+  req.set_operation(TabletSnapshotOpRequestPB::RESTORE);
+  FLAGS_TEST_delay_tablet_restore_ms = 1000;
+  constexpr int kNumRestores = 2;
+  TabletSnapshotOpResponsePB resps[kNumRestores];
+  RpcController rpcs[kNumRestores];
+  CountDownLatch latch(kNumRestores);
+  for (int i = 0; i != kNumRestores; ++i) {
+    backup_proxy_->TabletSnapshotOpAsync(req, &resps[i], &rpcs[i], [&latch] {
+      latch.CountDown();
+    });
+  }
+  latch.Wait();
+
+  int num_rejected = 0;
+  for (int i = 0; i != kNumRestores; ++i) {
+    ASSERT_OK(rpcs[i].status());
+    if (resps[i].has_error()) {
+      ASSERT_TRUE(StatusFromPB(resps[i].error().status()).IsServiceUnavailable())
+          << resps[i].DebugString();
+      ++num_rejected;
+    }
+  }
+  ASSERT_EQ(1, num_rejected);
+
+  FLAGS_TEST_delay_tablet_restore_ms = 0;
+  {
+    TabletSnapshotOpResponsePB resp;
+    RpcController rpc;
+    ASSERT_OK(backup_proxy_->TabletSnapshotOp(req, &resp, &rpc));
+    ASSERT_FALSE(resp.has_error()) << resp.DebugString();
+  }
+}
+
 } // namespace tserver
 } // namespace yb
@@ -21,9 +21,48 @@
 #include "yb/tserver/service_util.h"
 #include "yb/tserver/ts_tablet_manager.h"
 
+#include "yb/util/flag_tags.h"
+
+DEFINE_int32(max_concurrent_tablet_restores, 8,
+             "Maximum number of tablet snapshot restores a tablet server runs at the same time. "
+             "Other restores are rejected before being submitted and are retried by the master, "
+             "so restoring many tablets does not overload the disks.");
+TAG_FLAG(max_concurrent_tablet_restores, advanced);
+
+DEFINE_test_flag(int32, TEST_delay_tablet_restore_ms, 0,
+                 "Delay before submitting a tablet snapshot restore, in milliseconds.");
+
 namespace yb {
 namespace tserver {
 
+namespace {
+
+// Releases the restore semaphore when the restore operation completes, and then completes the
+// wrapped callback.
+class RestoreCompletionCallback : public tablet::OperationCompletionCallback {
+ public:
+  RestoreCompletionCallback(
+      std::unique_ptr<tablet::OperationCompletionCallback> callback, Semaphore* semaphore)
+      : callback_(std::move(callback)), semaphore_(semaphore) {}
+
+  void OperationCompleted() override {
+    if (!released_.exchange(true, std::memory_order_acq_rel)) {
+      semaphore_->Release();
+    }
+    if (has_error()) {
+      callback_->set_error(status(), error_code());
+    }
+    callback_->OperationCompleted();
+  }
+
+ private:
+  std::unique_ptr<tablet::OperationCompletionCallback> callback_;
+  Semaphore* const semaphore_;
+  std::atomic<bool> released_{false};
+};
+
+} // namespace
+
 using rpc::RpcContext;
 using tablet::SnapshotOperationState;
 using tablet::OperationCompletionCallback;
@@ -32,7 +71,8 @@ using tablet::Tablet;
 TabletServiceBackupImpl::TabletServiceBackupImpl(TSTabletManager* tablet_manager,
                                                  const scoped_refptr<MetricEntity>& metric_entity)
     : TabletServerBackupServiceIf(metric_entity),
-      tablet_manager_(tablet_manager) {
+      tablet_manager_(tablet_manager),
+      restores_semaphore_(std::max(FLAGS_max_concurrent_tablet_restores, 1)) {
 }
 
 void TabletServiceBackupImpl::TabletSnapshotOp(const TabletSnapshotOpRequestPB* req,
@@ -63,11 +103,31 @@ void TabletServiceBackupImpl::TabletSnapshotOp(const TabletSnapshotOpRequestPB*
     return;
   }
 
+  // Restores are limited before being submitted, rather than while being applied, so that a
+  // waiting restore does not hold up the Raft log of its tablet. The master retries rejected
+  // restores.
+  const bool is_restore = req->operation() == TabletSnapshotOpRequestPB::RESTORE;
+  if (is_restore && !restores_semaphore_.TryAcquire()) {
+    auto status = STATUS_FORMAT(
+        ServiceUnavailable, "Too many concurrent tablet restores, limit: $0",
+        FLAGS_max_concurrent_tablet_restores);
+    SetupErrorAndRespond(
+        resp->mutable_error(), status, TabletServerErrorPB::UNKNOWN_ERROR, &context);
+    return;
+  }
+
   auto tx_state = std::make_unique<SnapshotOperationState>(tablet.peer->tablet(), req);
 
   auto clock = tablet_manager_->server()->Clock();
-  tx_state->set_completion_callback(
-      MakeRpcOperationCompletionCallback(std::move(context), resp, clock));
+  auto callback = MakeRpcOperationCompletionCallback(std::move(context), resp, clock);
+  if (is_restore) {
+    callback = std::make_unique<RestoreCompletionCallback>(
+        std::move(callback), &restores_semaphore_);
+    if (FLAGS_TEST_delay_tablet_restore_ms > 0) {
+      SleepFor(MonoDelta::FromMilliseconds(FLAGS_TEST_delay_tablet_restore_ms));
+    }
+  }
+  tx_state->set_completion_callback(std::move(callback));
 
   // Submit the create snapshot op. The RPC will be responded to asynchronously.
   tablet.peer->Submit(
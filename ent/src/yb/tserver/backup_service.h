@@ -15,6 +15,8 @@
 
 #include "yb/tserver/backup.service.h"
 
+#include "yb/util/semaphore.h"
+
 namespace yb {
 namespace tserver {
 
@@ -30,6 +32,9 @@ class TabletServiceBackupImpl : public TabletServerBackupServiceIf {
                                 rpc::RpcContext context) override;
  private:
   TSTabletManager* tablet_manager_;
+
+  // Limits the number of restore operations of this tablet server that are in flight.
+  Semaphore restores_semaphore_;
 };
 
 }  // namespace tserver
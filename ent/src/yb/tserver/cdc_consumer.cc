@@ -19,6 +19,7 @@
 #include "yb/rpc/secure_stream.h"
 #include "yb/tserver/cdc_consumer.h"
 #include "yb/tserver/twodc_output_client.h"
+#include "yb/tserver/twodc_write_batcher.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/cdc_poller.h"
 
@@ -101,7 +102,8 @@ CDCConsumer::CDCConsumer(std::function<bool(const std::string&)> is_leader_for_t
                          std::unique_ptr<CDCClient> local_client) :
   is_leader_for_tablet_(std::move(is_leader_for_tablet)),
   log_prefix_(Format("[TS $0]: ", ts_uuid)),
-  local_client_(std::move(local_client)) {}
+  local_client_(std::move(local_client)),
+  write_batcher_(std::make_unique<TwoDCWriteBatcher>(local_client_)) {}
 
 CDCConsumer::~CDCConsumer() {
   Shutdown();
@@ -51,6 +51,7 @@ namespace enterprise {
 
 class CDCPoller;
 class TabletServer;
+class TwoDCWriteBatcher;
 
 struct CDCClient {
   std::unique_ptr<rpc::Messenger> messenger;
@@ -97,6 +98,21 @@ class CDCConsumer {
     return TEST_num_successful_write_rpcs.load(std::memory_order_acquire);
   }
 
+  // Apply responses that were not expected by a poller, i.e. more than one response to the same
+  // ApplyChanges, or a response that moves the applied op id back.
+  void IncrementNumUnexpectedApplyResponses() {
+    TEST_num_unexpected_apply_responses++;
+  }
+
+  uint32_t GetNumUnexpectedApplyResponses() {
+    return TEST_num_unexpected_apply_responses.load(std::memory_order_acquire);
+  }
+
+  // Sends writes of all pollers to the local cluster tablets.
+  TwoDCWriteBatcher* write_batcher() const {
+    return write_batcher_.get();
+  }
+
  private:
   // Runs a thread that periodically polls for any new threads.
   void RunThread();
@@ -143,6 +159,7 @@ class CDCConsumer {
 
   std::string log_prefix_;
   std::shared_ptr<CDCClient> local_client_;
+  std::unique_ptr<TwoDCWriteBatcher> write_batcher_;
 
   // map: {universe_uuid : ...}.
   std::unordered_map<std::string, std::shared_ptr<CDCClient>> remote_clients_
@@ -156,6 +173,7 @@ class CDCConsumer {
   std::atomic<int32_t> cluster_config_version_ GUARDED_BY(master_data_mutex_) = {-1};
 
   std::atomic<uint32_t> TEST_num_successful_write_rpcs {0};
+  std::atomic<uint32_t> TEST_num_unexpected_apply_responses {0};
 };
 
 } // namespace enterprise
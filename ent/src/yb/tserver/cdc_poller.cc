@@ -21,6 +21,8 @@
 #include "yb/client/client.h"
 
 #include "yb/consensus/opid_util.h"
+#include "yb/util/atomic.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/threadpool.h"
 
@@ -28,6 +30,14 @@ DEFINE_int32(async_replication_polling_delay_ms, 0,
              "How long to delay in ms between applying and repolling.");
 DEFINE_int32(replication_failure_delay_exponent, 16 /* ~ 2^16/1000 ~= 65 sec */,
              "Max number of failures (N) to use when calculating exponential backoff (2^N-1).");
+DEFINE_int32(async_replication_max_poll_wait_ms, 1000,
+             "How long in ms the producer may hold a poll that has no new records, waiting for "
+             "them. 0 makes the producer respond immediately.");
+TAG_FLAG(async_replication_max_poll_wait_ms, advanced);
+TAG_FLAG(async_replication_max_poll_wait_ms, runtime);
+DEFINE_bool(async_replication_pipeline_polls, true,
+            "Poll for the next changes of a producer tablet while the previous ones are applied.");
+TAG_FLAG(async_replication_pipeline_polls, advanced);
 DEFINE_bool(cdc_consumer_use_proxy_forwarding, false,
             "When enabled, read requests from the CDC Consumer that go to the wrong node are "
             "forwarded to the correct node by the Producer.");
@@ -51,6 +61,7 @@ CDCPoller::CDCPoller(const cdc::ProducerTabletInfo& producer_tablet_info,
     consumer_tablet_info_(consumer_tablet_info),
     should_continue_polling_(std::move(should_continue_polling)),
     remove_self_from_pollers_map_(std::move(remove_self_from_pollers_map)),
+    pipeline_polls_(FLAGS_async_replication_pipeline_polls),
     op_id_(consensus::MinimumOpId()),
     resp_(std::make_unique<cdc::GetChangesResponsePB>()),
     output_client_(CreateTwoDCOutputClient(
@@ -83,8 +94,34 @@ bool CDCPoller::CheckOnline() {
 
 void CDCPoller::Poll() {
   RETURN_WHEN_OFFLINE();
-  WARN_NOT_OK(thread_pool_->SubmitFunc(std::bind(&CDCPoller::DoPoll, this)),
-              "Could not submit Poll to thread pool");
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++operations_in_flight_;
+  }
+  auto s = thread_pool_->SubmitFunc(std::bind(&CDCPoller::DoPoll, this));
+  if (!s.ok()) {
+    LOG_WITH_PREFIX_UNLOCKED(WARNING) << "Could not submit Poll to thread pool: " << s;
+    FinishOperation();
+  }
+}
+
+bool CDCPoller::FinishOperation() {
+  bool remove = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --operations_in_flight_;
+    if (!stopping_ && !should_continue_polling_()) {
+      stopping_ = true;
+    }
+    if (!stopping_) {
+      return false;
+    }
+    remove = operations_in_flight_ == 0;
+  }
+  if (remove) {
+    remove_self_from_pollers_map_();
+  }
+  return true;
 }
 
 void CDCPoller::DoPoll() {
@@ -101,9 +138,16 @@ void CDCPoller::DoPoll() {
   req.set_stream_id(producer_tablet_info_.stream_id);
   req.set_tablet_id(producer_tablet_info_.tablet_id);
   req.set_serve_as_proxy(FLAGS_cdc_consumer_use_proxy_forwarding);
+  const auto max_wait_ms = GetAtomicFlag(&FLAGS_async_replication_max_poll_wait_ms);
+  if (max_wait_ms > 0) {
+    req.set_wait_for_records_ms(max_wait_ms);
+  }
 
   cdc::CDCCheckpointPB checkpoint;
-  *checkpoint.mutable_op_id() = op_id_;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    checkpoint = poll_checkpoint_;
+  }
   if (checkpoint.op_id().index() > 0 || checkpoint.op_id().term() > 0) {
     // Only send non-zero checkpoints in request.
     // If we don't know the latest checkpoint, then CDC producer can use the checkpoint from
@@ -131,7 +175,8 @@ void CDCPoller::DoPoll() {
     (**read_rpc_handle).SendRpc();
   } else {
     // Handle the Poll as a failure so repeated invocations will incur backoff.
-    HandlePoll(STATUS(Aborted, LogPrefixUnlocked() + "InvalidHandle for GetChangesCDCRpc"), resp_);
+    HandlePoll(STATUS(Aborted, LogPrefixUnlocked() + "InvalidHandle for GetChangesCDCRpc"),
+               nullptr);
   }
 }
 
@@ -139,23 +184,20 @@ void CDCPoller::HandlePoll(yb::Status status,
                            std::shared_ptr<cdc::GetChangesResponsePB> resp) {
   RETURN_WHEN_OFFLINE();
 
-  if (!should_continue_polling_()) {
-    return remove_self_from_pollers_map_();
+  if (FinishOperation()) {
+    return;
   }
 
-  status_ = status;
-  resp_ = resp;
-
   bool failed = false;
-  if (!status_.ok()) {
-    LOG_WITH_PREFIX_UNLOCKED(INFO) << "CDCPoller failure: " << status_.ToString();
+  if (!status.ok()) {
+    LOG_WITH_PREFIX_UNLOCKED(INFO) << "CDCPoller failure: " << status.ToString();
     failed = true;
-  } else if (resp_->has_error()) {
+  } else if (resp->has_error()) {
     LOG_WITH_PREFIX_UNLOCKED(WARNING) << "CDCPoller failure response: code="
-                                      << resp_->error().code()
+                                      << resp->error().code()
                                       << ", status=" << resp->error().status().DebugString();
     failed = true;
-  } else if (!resp_->has_checkpoint()) {
+  } else if (!resp->has_checkpoint()) {
     LOG_WITH_PREFIX_UNLOCKED(ERROR) << "CDCPoller failure: no checkpoint";
     failed = true;
   }
@@ -166,22 +208,67 @@ void CDCPoller::HandlePoll(yb::Status status,
   }
   poll_failures_ = max(poll_failures_ - 2, 0); // otherwise, recover slowly if we're congested
 
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    poll_checkpoint_ = resp->checkpoint();
+    if (applying_) {
+      // Previous changes are still being applied, these ones are applied after them.
+      prefetched_resp_ = std::move(resp);
+      return;
+    }
+    applying_ = true;
+  }
+
   // Success Case: ApplyChanges() from Poll
+  StartApplyChanges(std::move(resp));
+}
+
+void CDCPoller::StartApplyChanges(std::shared_ptr<cdc::GetChangesResponsePB> resp) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    resp_ = std::move(resp);
+  }
+  ApplyChanges();
+  if (pipeline_polls_) {
+    Poll();
+  }
+}
+
+void CDCPoller::ApplyChanges() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++operations_in_flight_;
+    apply_in_flight_ = true;
+  }
   WARN_NOT_OK(output_client_->ApplyChanges(resp_.get()), "Could not ApplyChanges");
 }
 
 void CDCPoller::HandleApplyChanges(cdc::OutputClientResponse response) {
   RETURN_WHEN_OFFLINE();
 
-  WARN_NOT_OK(thread_pool_->SubmitFunc(std::bind(&CDCPoller::DoHandleApplyChanges, this, response)),
-              "Could not submit HandleApplyChanges to thread pool");
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!apply_in_flight_) {
+      LOG_WITH_PREFIX_UNLOCKED(ERROR) << "Unexpected ApplyChanges response: " << response.status;
+      cdc_consumer_->IncrementNumUnexpectedApplyResponses();
+      return;
+    }
+    apply_in_flight_ = false;
+  }
+
+  auto s = thread_pool_->SubmitFunc(std::bind(&CDCPoller::DoHandleApplyChanges, this, response));
+  if (!s.ok()) {
+    LOG_WITH_PREFIX_UNLOCKED(WARNING) << "Could not submit HandleApplyChanges to thread pool: "
+                                      << s;
+    FinishOperation();
+  }
 }
 
 void CDCPoller::DoHandleApplyChanges(cdc::OutputClientResponse response) {
   RETURN_WHEN_OFFLINE();
 
-  if (!should_continue_polling_()) {
-    return remove_self_from_pollers_map_();
+  if (FinishOperation()) {
+    return;
   }
   if (!response.status.ok()) {
     LOG_WITH_PREFIX_UNLOCKED(WARNING) << "ApplyChanges failure: " << response.status;
@@ -189,14 +276,36 @@ void CDCPoller::DoHandleApplyChanges(cdc::OutputClientResponse response) {
     apply_failures_ = min(apply_failures_ + 1, FLAGS_replication_failure_delay_exponent);
     int64_t delay = (1 << apply_failures_) -1;
     SleepFor(MonoDelta::FromMilliseconds(delay));
-    WARN_NOT_OK(output_client_->ApplyChanges(resp_.get()), "Could not ApplyChanges");
+    ApplyChanges();
     return;
   }
   apply_failures_ = max(apply_failures_ - 2, 0); // recover slowly if we've gotten congested
 
-  op_id_ = response.last_applied_op_id;
+  std::shared_ptr<cdc::GetChangesResponsePB> next_resp;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (consensus::OpIdLessThan(response.last_applied_op_id, op_id_)) {
+      LOG_WITH_PREFIX_UNLOCKED(ERROR)
+          << "Applied op id moved back from " << op_id_.ShortDebugString() << " to "
+          << response.last_applied_op_id.ShortDebugString();
+      cdc_consumer_->IncrementNumUnexpectedApplyResponses();
+    }
+    op_id_ = response.last_applied_op_id;
+    next_resp = std::move(prefetched_resp_);
+    if (!next_resp) {
+      applying_ = false;
+      if (pipeline_polls_) {
+        // The poll for the next changes is in flight, it applies them when they arrive.
+        return;
+      }
+    }
+  }
 
-  Poll();
+  if (next_resp) {
+    StartApplyChanges(std::move(next_resp));
+  } else {
+    Poll();
+  }
 }
 #undef RETURN_WHEN_OFFLINE
 
@@ -12,6 +12,7 @@
 //
 
 #include <stdlib.h>
+#include <mutex>
 #include <string>
 
 #include "yb/cdc/cdc_util.h"
@@ -76,16 +77,50 @@ class CDCPoller {
   // Does the work of polling for new changes.
   void DoHandleApplyChanges(cdc::OutputClientResponse response);
 
+  // Sends resp to the output client, and with pipelined polls, starts polling for the next
+  // changes while resp is applied.
+  void StartApplyChanges(std::shared_ptr<cdc::GetChangesResponsePB> resp);
+
+  // Sends resp_ to the output client.
+  void ApplyChanges();
+
+  // Called when a poll or an apply, that was in flight, is done. Returns true if the poller is
+  // stopping, and the caller should not continue. The last operation to finish removes the
+  // poller from the pollers map.
+  bool FinishOperation();
+
   cdc::ProducerTabletInfo producer_tablet_info_;
   cdc::ConsumerTabletInfo consumer_tablet_info_;
   std::function<bool()> should_continue_polling_;
   std::function<void(void)> remove_self_from_pollers_map_;
 
+  // Whether the next changes are polled while the previous ones are applied.
+  const bool pipeline_polls_;
+
+  // Protects op_id_, poll_checkpoint_ and the pipeline state below.
+  std::mutex mutex_;
+
+  // Last applied op id.
   consensus::OpId op_id_;
 
-  yb::Status status_;
+  // Checkpoint of the last received changes, the next poll starts after it.
+  cdc::CDCCheckpointPB poll_checkpoint_;
+
+  // The changes that are being applied.
   std::shared_ptr<cdc::GetChangesResponsePB> resp_;
 
+  bool applying_ = false;
+
+  // Whether the output client is applying resp_, and did not respond yet.
+  bool apply_in_flight_ = false;
+
+  // Changes that were received while the previous ones were being applied.
+  std::shared_ptr<cdc::GetChangesResponsePB> prefetched_resp_;
+
+  // Number of polls and applies in flight.
+  int operations_in_flight_ = 0;
+  bool stopping_ = false;
+
   std::unique_ptr<cdc::CDCOutputClient> output_client_;
   std::shared_ptr<CDCClient> producer_client_;
 
@@ -12,6 +12,7 @@
 
 #include "yb/tserver/twodc_output_client.h"
 
+#include <deque>
 #include <shared_mutex>
 
 #include "yb/cdc/cdc_util.h"
@@ -23,12 +24,17 @@
 #include "yb/rpc/rpc_fwd.h"
 #include "yb/tserver/cdc_consumer.h"
 #include "yb/tserver/tserver_service.proxy.h"
+#include "yb/tserver/twodc_write_batcher.h"
 #include "yb/tserver/twodc_write_interface.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/net/net_util.h"
 
-DECLARE_int32(cdc_write_rpc_timeout_ms);
+DEFINE_int32(cdc_max_parallel_apply_writes, 16,
+             "Max number of write RPCs a CDC consumer sends in parallel, to different tablets, "
+             "while applying a batch of changes. Writes to the same tablet are always sent one "
+             "at a time, in order.");
+TAG_FLAG(cdc_max_parallel_apply_writes, runtime);
 
 DEFINE_bool(cdc_force_remote_tserver, false,
             "Avoid local tserver apply optimization for CDC and force remote RPCs.");
@@ -61,7 +67,7 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
   CHECKED_STATUS ApplyChanges(const cdc::GetChangesResponsePB* resp) override;
 
   void WriteCDCRecordDone(const Status& status, const WriteResponsePB& response,
-                          rpc::Rpcs::Handle handle);
+                          const std::string& tablet_id);
 
  private:
   void TabletLookupCallback(
@@ -71,7 +77,11 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
 
   void WriteIfAllRecordsProcessed();
 
-  void SendNextCDCWriteToTablet();
+  // Sends the next write to each tablet that has pending writes and no write in flight, up to
+  // cdc_max_parallel_apply_writes writes in flight. Responds when all writes are done.
+  void SendCDCWrites();
+
+  void SendCDCWrite(std::unique_ptr<WriteRequestPB> write_request);
 
   // Increment processed record count.
   // Returns true if all records are processed, false if there are still some pending records.
@@ -100,6 +110,11 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
   uint32_t processed_record_count_ GUARDED_BY(lock_) = 0;
   uint32_t record_count_ GUARDED_BY(lock_) = 0;
 
+  // Tablets that could have pending writes, and don't have a write in flight.
+  std::deque<std::string> idle_tablets_ GUARDED_BY(lock_);
+  int writes_in_flight_ GUARDED_BY(lock_) = 0;
+  bool writes_done_ GUARDED_BY(lock_) = false;
+
   // This will cache the response to an ApplyChanges() request.
   cdc::GetChangesResponsePB twodc_resp_copy_;
 
@@ -127,6 +142,9 @@ Status TwoDCOutputClient::ApplyChanges(const cdc::GetChangesResponsePB* poller_r
     processed_record_count_ = 0;
     record_count_ = poller_resp->records_size();
     ResetWriteInterface(&write_strategy_);
+    idle_tablets_.clear();
+    writes_in_flight_ = 0;
+    writes_done_ = false;
   }
 
   // Ensure we have records.
@@ -202,7 +220,12 @@ void TwoDCOutputClient::WriteIfAllRecordsProcessed() {
       HandleResponse();
     } else {
       // Apply the writes on consumer.
-      SendNextCDCWriteToTablet();
+      {
+        std::lock_guard<decltype(lock_)> l(lock_);
+        auto tablet_ids = write_strategy_->GetTabletIds();
+        idle_tablets_.assign(tablet_ids.begin(), tablet_ids.end());
+      }
+      SendCDCWrites();
     }
   }
 }
@@ -228,47 +251,66 @@ void TwoDCOutputClient::TabletLookupCallbackFastTrack(const size_t record_idx) {
   WriteIfAllRecordsProcessed();
 }
 
-void TwoDCOutputClient::SendNextCDCWriteToTablet() {
-  auto write_request = write_strategy_->GetNextWriteRequest();
-
-  auto deadline = CoarseMonoClock::Now() +
-                  MonoDelta::FromMilliseconds(FLAGS_cdc_write_rpc_timeout_ms);
-  auto write_rpc_handle = local_client_->rpcs->Prepare();
-  if (write_rpc_handle != local_client_->rpcs->InvalidHandle()) {
-    // Send in nullptr for RemoteTablet since cdc rpc now gets the tablet_id from the write request.
-    *write_rpc_handle = CreateCDCWriteRpc(
-        deadline,
-        nullptr /* RemoteTablet */,
-        local_client_->client.get(),
-        write_request.get(),
-        std::bind(&TwoDCOutputClient::WriteCDCRecordDone, this,
-                  std::placeholders::_1, std::placeholders::_2, write_rpc_handle),
-        UseLocalTserver());
-    (**write_rpc_handle).SendRpc();
-  } else {
-    LOG(WARNING) << "Invalid handle for CDC write, tablet ID: " << write_request->tablet_id();
+void TwoDCOutputClient::SendCDCWrites() {
+  std::vector<std::unique_ptr<WriteRequestPB>> write_requests;
+  {
+    std::lock_guard<decltype(lock_)> l(lock_);
+    const int max_writes_in_flight = std::max(FLAGS_cdc_max_parallel_apply_writes, 1);
+    while (error_status_.ok() && writes_in_flight_ < max_writes_in_flight &&
+           !idle_tablets_.empty()) {
+      auto write_request = write_strategy_->GetNextWriteRequest(idle_tablets_.front());
+      idle_tablets_.pop_front();
+      if (write_request) {
+        ++writes_in_flight_;
+        write_requests.push_back(std::move(write_request));
+      }
+    }
+    if (write_requests.empty()) {
+      // Respond once, after the last write, or after the last write in flight failed.
+      if (writes_in_flight_ > 0 || writes_done_) {
+        return;
+      }
+      writes_done_ = true;
+    }
   }
-}
 
-void TwoDCOutputClient::WriteCDCRecordDone(const Status& status, const WriteResponsePB& response,
-                                           rpc::Rpcs::Handle handle) {
-  auto retained = local_client_->rpcs->Unregister(handle);
-  if (!status.ok()) {
-    HandleError(status, true /* done */);
-    return;
-  } else if (response.has_error()) {
-    HandleError(StatusFromPB(response.error().status()), true /* done */);
+  if (write_requests.empty()) {
+    // All records applied, or there was an error, return response to caller.
+    HandleResponse();
     return;
   }
+  for (auto& write_request : write_requests) {
+    SendCDCWrite(std::move(write_request));
+  }
+}
 
-  cdc_consumer_->IncrementNumSuccessfulWriteRpcs();
+void TwoDCOutputClient::SendCDCWrite(std::unique_ptr<WriteRequestPB> write_request) {
+  auto tablet_id = write_request->tablet_id();
+  cdc_consumer_->write_batcher()->Write(
+      std::move(write_request), UseLocalTserver(),
+      std::bind(&TwoDCOutputClient::WriteCDCRecordDone, this,
+                std::placeholders::_1, std::placeholders::_2, tablet_id));
+}
 
-  if (!write_strategy_->HasMoreWrites()) {
-    // Last record, return response to caller.
-    HandleResponse();
+void TwoDCOutputClient::WriteCDCRecordDone(const Status& status, const WriteResponsePB& response,
+                                           const std::string& tablet_id) {
+  Status write_status = status;
+  if (write_status.ok() && response.has_error()) {
+    write_status = StatusFromPB(response.error().status());
+  }
+  if (!write_status.ok()) {
+    HandleError(write_status, false /* done */);
   } else {
-    SendNextCDCWriteToTablet();
+    cdc_consumer_->IncrementNumSuccessfulWriteRpcs();
+  }
+
+  {
+    std::lock_guard<decltype(lock_)> l(lock_);
+    --writes_in_flight_;
+    // Writes to this tablet continue after the previous one is done, to keep them in order.
+    idle_tablets_.push_back(tablet_id);
   }
+  SendCDCWrites();
 }
 
 void TwoDCOutputClient::HandleError(const Status& s, bool done) {
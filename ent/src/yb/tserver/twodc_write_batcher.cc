@@ -0,0 +1,160 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+
+#include "yb/tserver/twodc_write_batcher.h"
+
+#include "yb/cdc/cdc_rpc.h"
+#include "yb/tserver/cdc_consumer.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+
+DEFINE_bool(cdc_consumer_merge_tablet_writes, true,
+            "Merge CDC writes to the same consumer tablet, that are queued while a write to this "
+            "tablet is in flight, into a single write RPC.");
+TAG_FLAG(cdc_consumer_merge_tablet_writes, runtime);
+
+DECLARE_int32(cdc_write_rpc_timeout_ms);
+DECLARE_int32(consensus_max_batch_size_bytes);
+
+namespace yb {
+namespace tserver {
+namespace enterprise {
+
+namespace {
+
+// Whether the write could be merged with other writes without changing how it is applied.
+bool CanMerge(const WriteRequestPB& req) {
+  if (!req.has_write_batch() || req.write_batch().has_transaction() ||
+      req.write_batch().read_pairs_size() != 0) {
+    return false;
+  }
+  for (const auto& write_pair : req.write_batch().write_pairs()) {
+    if (!write_pair.has_external_hybrid_time()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+TwoDCWriteBatcher::TwoDCWriteBatcher(std::shared_ptr<CDCClient> client)
+    : client_(std::move(client)) {}
+
+TwoDCWriteBatcher::~TwoDCWriteBatcher() = default;
+
+void TwoDCWriteBatcher::Write(
+    std::unique_ptr<WriteRequestPB> req, bool use_local_tserver, Callback callback) {
+  const auto tablet_id = req->tablet_id();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& writes = tablets_[tablet_id];
+    writes.queue.push_back(PendingWrite {
+        std::move(req), use_local_tserver, std::move(callback) });
+    if (writes.in_flight) {
+      // Will be sent, possibly merged with other queued writes, when the write in flight is done.
+      return;
+    }
+    writes.in_flight = true;
+  }
+  SendNextWrite(tablet_id);
+}
+
+TwoDCWriteBatcher::MergedWrite TwoDCWriteBatcher::TakeWrite(TabletWrites* writes) {
+  MergedWrite result;
+  if (writes->queue.empty()) {
+    return result;
+  }
+  auto& front = writes->queue.front();
+  result.req = std::move(front.req);
+  result.use_local_tserver = front.use_local_tserver;
+  result.callbacks.push_back(std::move(front.callback));
+  writes->queue.pop_front();
+
+  if (!FLAGS_cdc_consumer_merge_tablet_writes || !CanMerge(*result.req)) {
+    return result;
+  }
+  const size_t max_size = std::max(FLAGS_consensus_max_batch_size_bytes, 1);
+  size_t size = result.req->ByteSizeLong();
+  while (!writes->queue.empty()) {
+    auto& next = writes->queue.front();
+    const size_t next_size = next.req->ByteSizeLong();
+    if (next.use_local_tserver != result.use_local_tserver || size + next_size > max_size ||
+        !CanMerge(*next.req)) {
+      break;
+    }
+    auto* write_pairs = result.req->mutable_write_batch()->mutable_write_pairs();
+    for (auto& write_pair : *next.req->mutable_write_batch()->mutable_write_pairs()) {
+      write_pairs->Add()->Swap(&write_pair);
+    }
+    if (next.req->external_hybrid_time() > result.req->external_hybrid_time()) {
+      result.req->set_external_hybrid_time(next.req->external_hybrid_time());
+    }
+    size += next_size;
+    result.callbacks.push_back(std::move(next.callback));
+    writes->queue.pop_front();
+  }
+  return result;
+}
+
+void TwoDCWriteBatcher::SendNextWrite(const std::string& tablet_id) {
+  for (;;) {
+    auto write = std::make_shared<MergedWrite>();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = tablets_.find(tablet_id);
+      *write = TakeWrite(&it->second);
+      if (!write->req) {
+        // No more writes to this tablet, next write will be sent right away.
+        tablets_.erase(it);
+        return;
+      }
+    }
+
+    auto handle = client_->rpcs->Prepare();
+    if (handle != client_->rpcs->InvalidHandle()) {
+      auto deadline = CoarseMonoClock::Now() +
+                      MonoDelta::FromMilliseconds(FLAGS_cdc_write_rpc_timeout_ms);
+      // Send in nullptr for RemoteTablet since cdc rpc gets the tablet_id from the write request.
+      *handle = CreateCDCWriteRpc(
+          deadline,
+          nullptr /* RemoteTablet */,
+          client_->client.get(),
+          write->req.get(),
+          std::bind(&TwoDCWriteBatcher::WriteDone, this, std::placeholders::_1,
+                    std::placeholders::_2, tablet_id, write, handle),
+          write->use_local_tserver);
+      (**handle).SendRpc();
+      return;
+    }
+
+    LOG(WARNING) << "Invalid handle for CDC write, tablet ID: " << tablet_id;
+    const auto status = STATUS(Aborted, "Invalid handle for CDC write");
+    for (const auto& callback : write->callbacks) {
+      callback(status, WriteResponsePB());
+    }
+  }
+}
+
+void TwoDCWriteBatcher::WriteDone(
+    const Status& status, const WriteResponsePB& response, const std::string& tablet_id,
+    const std::shared_ptr<MergedWrite>& write, rpc::Rpcs::Handle handle) {
+  auto retained = client_->rpcs->Unregister(handle);
+  for (const auto& callback : write->callbacks) {
+    callback(status, response);
+  }
+  SendNextWrite(tablet_id);
+}
+
+} // namespace enterprise
+} // namespace tserver
+} // namespace yb
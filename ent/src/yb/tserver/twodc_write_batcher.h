@@ -0,0 +1,93 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+
+#ifndef ENT_SRC_YB_TSERVER_TWODC_WRITE_BATCHER_H
+#define ENT_SRC_YB_TSERVER_TWODC_WRITE_BATCHER_H
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+#include "yb/gutil/thread_annotations.h"
+#include "yb/rpc/rpc.h"
+#include "yb/tserver/tserver.pb.h"
+
+namespace yb {
+namespace tserver {
+namespace enterprise {
+
+struct CDCClient;
+
+// Sends CDC writes to consumer tablets on behalf of all pollers of a CDC consumer.
+//
+// Many producer tablets could map to the same consumer tablet, so their pollers write to the same
+// tablet concurrently. Only one write per consumer tablet is sent at a time. Writes that arrive
+// while a write to the tablet is in flight are queued, and when it is done, the queued writes are
+// merged into a single write RPC, that is replicated as a single Raft operation.
+// Only non-transactional writes, whose write pairs all carry their own external hybrid time, are
+// merged, so merging does not change the hybrid time any record is applied at.
+class TwoDCWriteBatcher {
+ public:
+  typedef std::function<void(const Status&, const WriteResponsePB&)> Callback;
+
+  explicit TwoDCWriteBatcher(std::shared_ptr<CDCClient> client);
+  ~TwoDCWriteBatcher();
+
+  TwoDCWriteBatcher(const TwoDCWriteBatcher&) = delete;
+  void operator=(const TwoDCWriteBatcher&) = delete;
+
+  // Sends req to its tablet, callback is invoked with the response to the RPC that req was sent
+  // with, possibly merged with other writes.
+  void Write(std::unique_ptr<WriteRequestPB> req, bool use_local_tserver, Callback callback);
+
+ private:
+  struct PendingWrite {
+    std::unique_ptr<WriteRequestPB> req;
+    bool use_local_tserver;
+    Callback callback;
+  };
+
+  struct TabletWrites {
+    bool in_flight = false;
+    std::deque<PendingWrite> queue;
+  };
+
+  struct MergedWrite {
+    std::unique_ptr<WriteRequestPB> req;
+    bool use_local_tserver;
+    std::vector<Callback> callbacks;
+  };
+
+  // Takes writes from the front of the queue and merges them into a single write.
+  // Returns write with null req when the queue is empty.
+  MergedWrite TakeWrite(TabletWrites* writes);
+
+  // Sends the next write to tablet_id, or forgets the tablet if it has no queued writes.
+  void SendNextWrite(const std::string& tablet_id);
+
+  void WriteDone(
+      const Status& status, const WriteResponsePB& response,
+      const std::string& tablet_id, const std::shared_ptr<MergedWrite>& write,
+      rpc::Rpcs::Handle handle);
+
+  std::shared_ptr<CDCClient> client_;
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, TabletWrites> tablets_ GUARDED_BY(mutex_);
+};
+
+} // namespace enterprise
+} // namespace tserver
+} // namespace yb
+
+#endif // ENT_SRC_YB_TSERVER_TWODC_WRITE_BATCHER_H
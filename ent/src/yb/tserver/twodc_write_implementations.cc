@@ -10,6 +10,7 @@
 // or implied.  See the License for the specific language governing permissions and limitations
 // under the License.
 
+#include <algorithm>
 #include <deque>
 
 #include "yb/tserver/twodc_write_interface.h"
@@ -78,10 +79,32 @@ class SequentialWriteImplementation : public TwoDCWriteInterface {
     return next_req;
   }
 
+  std::unique_ptr<WriteRequestPB> GetNextWriteRequest(const std::string& tablet_id) override {
+    auto it = std::find_if(records_.begin(), records_.end(), [&tablet_id](const auto& req) {
+      return req->tablet_id() == tablet_id;
+    });
+    if (it == records_.end()) {
+      return nullptr;
+    }
+    auto next_req = std::move(*it);
+    records_.erase(it);
+    return next_req;
+  }
+
   bool HasMoreWrites() override {
     return records_.size() > 0;
   }
 
+  std::vector<std::string> GetTabletIds() override {
+    std::vector<std::string> result;
+    for (const auto& req : records_) {
+      if (std::find(result.begin(), result.end(), req->tablet_id()) == result.end()) {
+        result.push_back(req->tablet_id());
+      }
+    }
+    return result;
+  }
+
  private:
   std::deque <std::unique_ptr<WriteRequestPB>> records_;
 
@@ -144,10 +167,32 @@ class BatchedWriteImplementation : public TwoDCWriteInterface {
     return next_req;
   }
 
+  std::unique_ptr<WriteRequestPB> GetNextWriteRequest(const std::string& tablet_id) override {
+    auto it = records_.find(tablet_id);
+    if (it == records_.end()) {
+      return nullptr;
+    }
+    auto next_req = std::move(it->second.front());
+    it->second.pop_front();
+    if (it->second.empty()) {
+      records_.erase(it);
+    }
+    return next_req;
+  }
+
   bool HasMoreWrites() override {
     return records_.size() > 0;
   }
 
+  std::vector<std::string> GetTabletIds() override {
+    std::vector<std::string> result;
+    result.reserve(records_.size());
+    for (const auto& entry : records_) {
+      result.push_back(entry.first);
+    }
+    return result;
+  }
+
  private:
   std::map <std::string, std::deque<std::unique_ptr < WriteRequestPB>>>
   records_;
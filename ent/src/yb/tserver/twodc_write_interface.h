@@ -15,6 +15,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace yb {
 namespace cdc {
@@ -32,8 +33,12 @@ class TwoDCWriteInterface {
  public:
   virtual ~TwoDCWriteInterface() {}
   virtual std::unique_ptr <WriteRequestPB> GetNextWriteRequest() = 0;
+  // Returns the next write request for tablet_id, or null if there are no more writes to it.
+  virtual std::unique_ptr<WriteRequestPB> GetNextWriteRequest(const std::string& tablet_id) = 0;
   virtual void ProcessRecord(const std::string& tablet_id, const cdc::CDCRecordPB& record) = 0;
   virtual bool HasMoreWrites() = 0;
+  // Returns ids of tablets that have pending writes.
+  virtual std::vector<std::string> GetTabletIds() = 0;
 };
 
 void ResetWriteInterface(std::unique_ptr<TwoDCWriteInterface>* write_strategy);
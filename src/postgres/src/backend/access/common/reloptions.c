@@ -158,6 +158,15 @@ static relopt_bool boolRelOpts[] =
 		 * colocated. This option will be ignored in non-colocated database. */
 		true
 	},
+	{
+		{
+			"packed_row",
+			"store each inserted row as a single packed DocDB value",
+			RELOPT_KIND_HEAP,
+			AccessExclusiveLock
+		},
+		false
+	},
 	/* list terminator */
 	{{NULL}}
 };
@@ -1396,6 +1405,8 @@ default_reloptions(Datum reloptions, bool validate, relopt_kind kind)
 		offsetof(StdRdOptions, vacuum_cleanup_index_scale_factor)},
 		{"colocated", RELOPT_TYPE_BOOL,
 		offsetof(StdRdOptions, colocated)},
+		{"packed_row", RELOPT_TYPE_BOOL,
+		offsetof(StdRdOptions, packed_row)},
 	};
 
 	options = parseRelOptions(reloptions, validate, kind, &numoptions);
@@ -2104,6 +2104,10 @@ CommitTransaction(void)
 	 */
 	PreCommit_Notify();
 
+	/* Ship the catalog invalidation messages not shipped with the writes yet. */
+	if (IsYugaByteEnabled())
+		YBPreCommit_Inval();
+
 	/* Prevent cancel/die interrupt while cleaning up */
 	HOLD_INTERRUPTS();
 
@@ -604,7 +604,8 @@ Datum YBCDocdbToDatum(const uint8 *data, int64 bytes, const YBCPgTypeAttrs *type
 static const YBCPgTypeEntity YBCTypeEntityTable[] = {
 	{ BOOLOID, YB_YQL_DATA_TYPE_BOOL, true, sizeof(bool),
 		(YBCPgDatumToData)YBCDatumToBool,
-		(YBCPgDatumFromData)YBCBoolToDatum },
+		(YBCPgDatumFromData)YBCBoolToDatum,
+		true },
 
 	{ BYTEAOID, YB_YQL_DATA_TYPE_BINARY, true, -1,
 		(YBCPgDatumToData)YBCDatumToBinary,
@@ -612,7 +613,8 @@ static const YBCPgTypeEntity YBCTypeEntityTable[] = {
 
 	{ CHAROID, YB_YQL_DATA_TYPE_INT8, true, -1,
 		(YBCPgDatumToData)YBCDatumToChar,
-		(YBCPgDatumFromData)YBCCharToDatum },
+		(YBCPgDatumFromData)YBCCharToDatum,
+		true },
 
 	{ NAMEOID, YB_YQL_DATA_TYPE_STRING, true, -1,
 		(YBCPgDatumToData)YBCDatumToName,
@@ -620,11 +622,13 @@ static const YBCPgTypeEntity YBCTypeEntityTable[] = {
 
 	{ INT8OID, YB_YQL_DATA_TYPE_INT64, true, sizeof(int64),
 		(YBCPgDatumToData)YBCDatumToInt64,
-		(YBCPgDatumFromData)YBCInt64ToDatum },
+		(YBCPgDatumFromData)YBCInt64ToDatum,
+		true },
 
 	{ INT2OID, YB_YQL_DATA_TYPE_INT16, true, sizeof(int16),
 		(YBCPgDatumToData)YBCDatumToInt16,
-		(YBCPgDatumFromData)YBCInt16ToDatum },
+		(YBCPgDatumFromData)YBCInt16ToDatum,
+		true },
 
 	{ INT2VECTOROID, YB_YQL_DATA_TYPE_BINARY, true, -1,
 		(YBCPgDatumToData)YBCDatumToBinary,
@@ -632,11 +636,13 @@ static const YBCPgTypeEntity YBCTypeEntityTable[] = {
 
 	{ INT4OID, YB_YQL_DATA_TYPE_INT32, true, sizeof(int32),
 		(YBCPgDatumToData)YBCDatumToInt32,
-		(YBCPgDatumFromData)YBCInt32ToDatum },
+		(YBCPgDatumFromData)YBCInt32ToDatum,
+		true },
 
 	{ REGPROCOID, YB_YQL_DATA_TYPE_UINT32, true, sizeof(Oid),
 		(YBCPgDatumToData)YBCDatumToOid,
-		(YBCPgDatumFromData)YBCOidToDatum },
+		(YBCPgDatumFromData)YBCOidToDatum,
+		true },
 
 	{ TEXTOID, YB_YQL_DATA_TYPE_STRING, true, -1,
 		(YBCPgDatumToData)YBCDatumToText,
@@ -644,7 +650,8 @@ static const YBCPgTypeEntity YBCTypeEntityTable[] = {
 
 	{ OIDOID, YB_YQL_DATA_TYPE_UINT32, true, sizeof(Oid),
 		(YBCPgDatumToData)YBCDatumToOid,
-		(YBCPgDatumFromData)YBCOidToDatum },
+		(YBCPgDatumFromData)YBCOidToDatum,
+		true },
 
 	{ TIDOID, YB_YQL_DATA_TYPE_BINARY, false, sizeof(ItemPointerData),
 		(YBCPgDatumToData)YBCDatumToDocdb,
@@ -652,11 +659,13 @@ static const YBCPgTypeEntity YBCTypeEntityTable[] = {
 
 	{ XIDOID, YB_YQL_DATA_TYPE_UINT32, true, sizeof(TransactionId),
 		(YBCPgDatumToData)YBCDatumToTransactionId,
-		(YBCPgDatumFromData)YBCTransactionIdToDatum },
+		(YBCPgDatumFromData)YBCTransactionIdToDatum,
+		true },
 
 	{ CIDOID, YB_YQL_DATA_TYPE_UINT32, false, sizeof(CommandId),
 		(YBCPgDatumToData)YBCDatumToCommandId,
-		(YBCPgDatumFromData)YBCCommandIdToDatum },
+		(YBCPgDatumFromData)YBCCommandIdToDatum,
+		true },
 
 	{ OIDVECTOROID, YB_YQL_DATA_TYPE_BINARY, true, -1,
 		(YBCPgDatumToData)YBCDatumToBinary,
@@ -688,11 +697,13 @@ static const YBCPgTypeEntity YBCTypeEntityTable[] = {
 
 	{ PGDDLCOMMANDOID, YB_YQL_DATA_TYPE_INT64, true, sizeof(int64),
 		(YBCPgDatumToData)YBCDatumToInt64,
-		(YBCPgDatumFromData)YBCInt64ToDatum },
+		(YBCPgDatumFromData)YBCInt64ToDatum,
+		true },
 
 	{ SMGROID, YB_YQL_DATA_TYPE_INT16, true, sizeof(int16),
 		(YBCPgDatumToData)YBCDatumToInt16,
-		(YBCPgDatumFromData)YBCInt16ToDatum },
+		(YBCPgDatumFromData)YBCInt16ToDatum,
+		true },
 
 	{ POINTOID, YB_YQL_DATA_TYPE_BINARY, false, sizeof(Point),
 		(YBCPgDatumToData)YBCDatumToDocdb,
@@ -761,7 +772,8 @@ static const YBCPgTypeEntity YBCTypeEntityTable[] = {
 	/* We're using int64 to represent monetary type, just like Postgres does. */
 	{ CASHOID, YB_YQL_DATA_TYPE_INT64, true, sizeof(int64),
 		(YBCPgDatumToData)YBCDatumToMoneyInt64,
-		(YBCPgDatumFromData)YBCMoneyInt64ToDatum },
+		(YBCPgDatumFromData)YBCMoneyInt64ToDatum,
+		true },
 
 	{ MONEYARRAYOID, YB_YQL_DATA_TYPE_BINARY, false, -1,
 		(YBCPgDatumToData)YBCDatumToDocdb,
@@ -929,15 +941,18 @@ static const YBCPgTypeEntity YBCTypeEntityTable[] = {
 
 	{ DATEOID, YB_YQL_DATA_TYPE_INT32, true, sizeof(int32),
 		(YBCPgDatumToData)YBCDatumToDate,
-		(YBCPgDatumFromData)YBCDateToDatum },
+		(YBCPgDatumFromData)YBCDateToDatum,
+		true },
 
 	{ TIMEOID, YB_YQL_DATA_TYPE_INT64, true, sizeof(int64),
 		(YBCPgDatumToData)YBCDatumToTime,
-		(YBCPgDatumFromData)YBCTimeToDatum },
+		(YBCPgDatumFromData)YBCTimeToDatum,
+		true },
 
 	{ TIMESTAMPOID, YB_YQL_DATA_TYPE_INT64, true, sizeof(int64),
 		(YBCPgDatumToData)YBCDatumToInt64,
-		(YBCPgDatumFromData)YBCInt64ToDatum },
+		(YBCPgDatumFromData)YBCInt64ToDatum,
+		true },
 
 	{ TIMESTAMPARRAYOID, YB_YQL_DATA_TYPE_BINARY, false, -1,
 		(YBCPgDatumToData)YBCDatumToBinary,
@@ -953,7 +968,8 @@ static const YBCPgTypeEntity YBCTypeEntityTable[] = {
 
 	{ TIMESTAMPTZOID, YB_YQL_DATA_TYPE_INT64, true, sizeof(int64),
 		(YBCPgDatumToData)YBCDatumToInt64,
-		(YBCPgDatumFromData)YBCInt64ToDatum },
+		(YBCPgDatumFromData)YBCInt64ToDatum,
+		true },
 
 	{ TIMESTAMPTZARRAYOID, YB_YQL_DATA_TYPE_BINARY, false, -1,
 		(YBCPgDatumToData)YBCDatumToBinary,
@@ -1005,31 +1021,38 @@ static const YBCPgTypeEntity YBCTypeEntityTable[] = {
 
 	{ REGPROCEDUREOID, YB_YQL_DATA_TYPE_UINT32, true, sizeof(Oid),
 		(YBCPgDatumToData)YBCDatumToOid,
-		(YBCPgDatumFromData)YBCOidToDatum },
+		(YBCPgDatumFromData)YBCOidToDatum,
+		true },
 
 	{ REGOPEROID, YB_YQL_DATA_TYPE_UINT32, true, sizeof(Oid),
 		(YBCPgDatumToData)YBCDatumToOid,
-		(YBCPgDatumFromData)YBCOidToDatum },
+		(YBCPgDatumFromData)YBCOidToDatum,
+		true },
 
 	{ REGOPERATOROID, YB_YQL_DATA_TYPE_UINT32, true, sizeof(Oid),
 		(YBCPgDatumToData)YBCDatumToOid,
-		(YBCPgDatumFromData)YBCOidToDatum },
+		(YBCPgDatumFromData)YBCOidToDatum,
+		true },
 
 	{ REGCLASSOID, YB_YQL_DATA_TYPE_UINT32, true, sizeof(Oid),
 		(YBCPgDatumToData)YBCDatumToOid,
-		(YBCPgDatumFromData)YBCOidToDatum },
+		(YBCPgDatumFromData)YBCOidToDatum,
+		true },
 
 	{ REGTYPEOID, YB_YQL_DATA_TYPE_UINT32, true, sizeof(Oid),
 		(YBCPgDatumToData)YBCDatumToOid,
-		(YBCPgDatumFromData)YBCOidToDatum },
+		(YBCPgDatumFromData)YBCOidToDatum,
+		true },
 
 	{ REGROLEOID, YB_YQL_DATA_TYPE_UINT32, true, sizeof(Oid),
 		(YBCPgDatumToData)YBCDatumToOid,
-		(YBCPgDatumFromData)YBCOidToDatum },
+		(YBCPgDatumFromData)YBCOidToDatum,
+		true },
 
 	{ REGNAMESPACEOID, YB_YQL_DATA_TYPE_UINT32, true, sizeof(Oid),
 		(YBCPgDatumToData)YBCDatumToOid,
-		(YBCPgDatumFromData)YBCOidToDatum },
+		(YBCPgDatumFromData)YBCOidToDatum,
+		true },
 
 	{ REGPROCEDUREARRAYOID, YB_YQL_DATA_TYPE_BINARY, false, -1,
 		(YBCPgDatumToData)YBCDatumToBinary,
@@ -1069,7 +1092,8 @@ static const YBCPgTypeEntity YBCTypeEntityTable[] = {
 
 	{ LSNOID, YB_YQL_DATA_TYPE_UINT64, true, sizeof(uint64),
 		(YBCPgDatumToData)YBCDatumToUInt64,
-		(YBCPgDatumFromData)YBCUInt64ToDatum },
+		(YBCPgDatumFromData)YBCUInt64ToDatum,
+		true },
 
 	{ PG_LSNARRAYOID, YB_YQL_DATA_TYPE_BINARY, false, -1,
 		(YBCPgDatumToData)YBCDatumToBinary,
@@ -1089,11 +1113,13 @@ static const YBCPgTypeEntity YBCTypeEntityTable[] = {
 
 	{ REGCONFIGOID, YB_YQL_DATA_TYPE_UINT32, true, sizeof(Oid),
 		(YBCPgDatumToData)YBCDatumToOid,
-		(YBCPgDatumFromData)YBCOidToDatum },
+		(YBCPgDatumFromData)YBCOidToDatum,
+		true },
 
 	{ REGDICTIONARYOID, YB_YQL_DATA_TYPE_UINT32, true, sizeof(Oid),
 		(YBCPgDatumToData)YBCDatumToOid,
-		(YBCPgDatumFromData)YBCOidToDatum },
+		(YBCPgDatumFromData)YBCOidToDatum,
+		true },
 
 	{ TSVECTORARRAYOID, YB_YQL_DATA_TYPE_BINARY, false, -1,
 		(YBCPgDatumToData)YBCDatumToBinary,
@@ -1194,7 +1220,8 @@ static const YBCPgTypeEntity YBCTypeEntityTable[] = {
 
 	{ ANYOID, YB_YQL_DATA_TYPE_INT32, true, sizeof(int32),
 		(YBCPgDatumToData)YBCDatumToInt32,
-		(YBCPgDatumFromData)YBCInt32ToDatum },
+		(YBCPgDatumFromData)YBCInt32ToDatum,
+		true },
 
 	{ ANYARRAYOID, YB_YQL_DATA_TYPE_BINARY, false, -1,
 		(YBCPgDatumToData)YBCDatumToBinary,
@@ -1202,51 +1229,63 @@ static const YBCPgTypeEntity YBCTypeEntityTable[] = {
 
 	{ VOIDOID, YB_YQL_DATA_TYPE_INT64, true, sizeof(int64),
 		(YBCPgDatumToData)YBCDatumToInt64,
-		(YBCPgDatumFromData)YBCInt64ToDatum },
+		(YBCPgDatumFromData)YBCInt64ToDatum,
+		true },
 
 	{ TRIGGEROID, YB_YQL_DATA_TYPE_UINT32, true, sizeof(Oid),
 		(YBCPgDatumToData)YBCDatumToOid,
-		(YBCPgDatumFromData)YBCOidToDatum },
+		(YBCPgDatumFromData)YBCOidToDatum,
+		true },
 
 	{ EVTTRIGGEROID, YB_YQL_DATA_TYPE_UINT32, true, sizeof(Oid),
 		(YBCPgDatumToData)YBCDatumToOid,
-		(YBCPgDatumFromData)YBCOidToDatum },
+		(YBCPgDatumFromData)YBCOidToDatum,
+		true },
 
 	{ LANGUAGE_HANDLEROID, YB_YQL_DATA_TYPE_UINT32, true, sizeof(Oid),
 		(YBCPgDatumToData)YBCDatumToOid,
-		(YBCPgDatumFromData)YBCOidToDatum },
+		(YBCPgDatumFromData)YBCOidToDatum,
+		true },
 
 	{ INTERNALOID, YB_YQL_DATA_TYPE_INT64, true, sizeof(int64),
 		(YBCPgDatumToData)YBCDatumToInt64,
-		(YBCPgDatumFromData)YBCInt64ToDatum },
+		(YBCPgDatumFromData)YBCInt64ToDatum,
+		true },
 
 	{ OPAQUEOID, YB_YQL_DATA_TYPE_INT32, true, sizeof(int32),
 		(YBCPgDatumToData)YBCDatumToInt32,
-		(YBCPgDatumFromData)YBCInt32ToDatum },
+		(YBCPgDatumFromData)YBCInt32ToDatum,
+		true },
 
 	{ ANYELEMENTOID, YB_YQL_DATA_TYPE_INT32, true, sizeof(int32),
 		(YBCPgDatumToData)YBCDatumToInt32,
-		(YBCPgDatumFromData)YBCInt32ToDatum },
+		(YBCPgDatumFromData)YBCInt32ToDatum,
+		true },
 
 	{ ANYNONARRAYOID, YB_YQL_DATA_TYPE_INT32, true, sizeof(int32),
 		(YBCPgDatumToData)YBCDatumToInt32,
-		(YBCPgDatumFromData)YBCInt32ToDatum },
+		(YBCPgDatumFromData)YBCInt32ToDatum,
+		true },
 
 	{ ANYENUMOID, YB_YQL_DATA_TYPE_INT32, true, sizeof(int32),
 		(YBCPgDatumToData)YBCDatumToInt32,
-		(YBCPgDatumFromData)YBCInt32ToDatum },
+		(YBCPgDatumFromData)YBCInt32ToDatum,
+		true },
 
 	{ FDW_HANDLEROID, YB_YQL_DATA_TYPE_UINT32, true, sizeof(Oid),
 		(YBCPgDatumToData)YBCDatumToOid,
-		(YBCPgDatumFromData)YBCOidToDatum },
+		(YBCPgDatumFromData)YBCOidToDatum,
+		true },
 
 	{ INDEX_AM_HANDLEROID, YB_YQL_DATA_TYPE_UINT32, true, sizeof(Oid),
 		(YBCPgDatumToData)YBCDatumToOid,
-		(YBCPgDatumFromData)YBCOidToDatum },
+		(YBCPgDatumFromData)YBCOidToDatum,
+		true },
 
 	{ TSM_HANDLEROID, YB_YQL_DATA_TYPE_UINT32, true, sizeof(Oid),
 		(YBCPgDatumToData)YBCDatumToOid,
-		(YBCPgDatumFromData)YBCOidToDatum },
+		(YBCPgDatumFromData)YBCOidToDatum,
+		true },
 
 	{ ANYRANGEOID, YB_YQL_DATA_TYPE_BINARY, false, -1,
 		(YBCPgDatumToData)YBCDatumToDocdb,
@@ -1260,7 +1299,8 @@ static const YBCPgTypeEntity YBCTypeEntityTable[] = {
 static const YBCPgTypeEntity YBCFixedLenByValTypeEntity =
 	{ InvalidOid, YB_YQL_DATA_TYPE_INT64, false, sizeof(int64),
 		(YBCPgDatumToData)YBCDatumToInt64,
-		(YBCPgDatumFromData)YBCInt64ToDatum };
+		(YBCPgDatumFromData)YBCInt64ToDatum,
+		true };
 /* Special type entity used for null-terminated, pass-by-reference user-defined types.
  * TODO(jason): When user-defined types as primary keys are supported, change the below `false` to
  * `true`.
@@ -43,6 +43,7 @@
 #include "port/pg_bswap.h"
 #include "rewrite/rewriteHandler.h"
 #include "storage/fd.h"
+#include "storage/lmgr.h"
 #include "tcop/tcopprot.h"
 #include "utils/builtins.h"
 #include "utils/lsyscache.h"
@@ -308,6 +309,7 @@ static uint64 DoCopyTo(CopyState cstate);
 static uint64 CopyTo(CopyState cstate);
 static void CopyOneRowTo(CopyState cstate, Oid tupleOid,
 			 Datum *values, bool *nulls);
+static bool YBIsRelationEmpty(Relation rel);
 static void CopyFromInsertBatch(CopyState cstate, EState *estate,
 					CommandId mycid, int hi_options,
 					ResultRelInfo *resultRelInfo, TupleTableSlot *myslot,
@@ -2348,8 +2350,11 @@ CopyFrom(CopyState cstate)
 	int			nBufferedTuples = 0;
 	int			prev_leaf_part_index = -1;
 	bool		useNonTxnInsert;
+	bool		useNonTxnUpsert = false;
+	YBCTupleIdSet *upsertedTupleIds = NULL;
 
 #define MAX_BUFFERED_TUPLES 1000
+#define MAX_UPSERTED_TUPLES 100000
 	HeapTuple  *bufferedTuples = NULL;	/* initialize to silence warning */
 	Size		bufferedTuplesSize = 0;
 	uint64		firstBufferedLineNo = 0;
@@ -2625,6 +2630,25 @@ CopyFrom(CopyState cstate)
 		useNonTxnInsert = false;
 	}
 
+	/*
+	 * Bulk load of an empty table does not need the duplicate key check of
+	 * each row against the existing rows, so write rows as upserts, and
+	 * check the loaded rows against each other on this side.
+	 *
+	 * Lock out the writers of other sessions first, so that the table stays
+	 * empty after the check, and check it with a snapshot taken after the
+	 * lock is granted.  The lock is held till the end of the transaction.
+	 */
+	if (useNonTxnInsert && YBIsNonTxnCopyBulkLoadEnabled())
+	{
+		LockRelation(cstate->rel, ShareRowExclusiveLock);
+		if (YBIsRelationEmpty(cstate->rel))
+		{
+			useNonTxnUpsert = true;
+			upsertedTupleIds = YBCCreateTupleIdSet();
+		}
+	}
+
 	/*
 	 * Check BEFORE STATEMENT insertion triggers. It's debatable whether we
 	 * should do this for COPY, since it's not really an "INSERT" statement as
@@ -2867,7 +2891,21 @@ CopyFrom(CopyState cstate)
 					/* OK, store the tuple and create index entries for it */
 					if (IsYBRelation(resultRelInfo->ri_RelationDesc))
 					{
-						if (useNonTxnInsert)
+						if (useNonTxnUpsert)
+						{
+							YBCExecuteNonTxnUpsert(cstate->rel, tupDesc, tuple,
+												   upsertedTupleIds);
+
+							/*
+							 * Stop tracking the keys of a huge load, the rest
+							 * of the rows are checked against the rows loaded
+							 * so far by the tablet servers.
+							 */
+							if (YBCTupleIdSetSize(upsertedTupleIds) >=
+								MAX_UPSERTED_TUPLES)
+								useNonTxnUpsert = false;
+						}
+						else if (useNonTxnInsert)
 						{
 							YBCExecuteNonTxnInsert(cstate->rel, tupDesc, tuple);
 						}
@@ -2983,6 +3021,9 @@ CopyFrom(CopyState cstate)
 
 	FreeExecutorState(estate);
 
+	if (upsertedTupleIds)
+		YBCFreeTupleIdSet(upsertedTupleIds);
+
 	/*
 	 * If we skipped writing WAL, then we need to sync the heap (but not
 	 * indexes since those use WAL anyway)
@@ -2993,6 +3034,23 @@ CopyFrom(CopyState cstate)
 	return processed;
 }
 
+/*
+ * A subroutine of CopyFrom, to check whether the YugaByte relation has no
+ * rows yet.
+ */
+static bool
+YBIsRelationEmpty(Relation rel)
+{
+	HeapScanDesc scan;
+	bool		is_empty;
+
+	scan = heap_beginscan(rel, GetLatestSnapshot(), 0, NULL);
+	is_empty = heap_getnext(scan, ForwardScanDirection) == NULL;
+	heap_endscan(scan);
+
+	return is_empty;
+}
+
 /*
  * A subroutine of CopyFrom, to write the current batch of buffered heap
  * tuples to the heap. Also updates indexes and runs AFTER ROW INSERT
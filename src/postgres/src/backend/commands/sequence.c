@@ -750,6 +750,13 @@ nextval_internal(Oid relid, bool check_permissions)
 	cycle = pgsform->seqcycle;
 	ReleaseSysCache(pgstuple);
 
+	/*
+	 * Each refill of the cache is a round trip to the tablet of the sequences
+	 * table, so reserve at least the configured number of values at once.
+	 */
+	if (IsYugaByteEnabled())
+		cache = Max(cache, YBCGetSequenceCacheMinval());
+
 retry:
 	rescnt = 0;
 	if (IsYugaByteEnabled())
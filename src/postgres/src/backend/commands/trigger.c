@@ -6010,6 +6010,15 @@ AfterTriggerSaveEvent(EState *estate, ResultRelInfo *relinfo,
 				continue;		/* Uniqueness definitely not violated */
 		}
 
+		/*
+		 * Let YugaByte read the rows referenced by FK check triggers of the
+		 * statement in batches, before the first check is fired.
+		 */
+		if (IsYBRelation(rel) && row_trigger && newtup != NULL &&
+			YBCGetForeignKeyCheckBatchSize() > 0 &&
+			RI_FKey_trigger_type(trigger->tgfoid) == RI_TRIGGER_FK)
+			YBAddForeignKeyReferenceIntent(trigger, rel, newtup);
+
 		/*
 		 * Fill in event structure and add it to the current query's queue.
 		 * Note we set ats_table to NULL whenever this trigger doesn't use
@@ -487,7 +487,8 @@ YBCCreateTable(CreateStmt *stmt, char relkind, TupleDesc desc, Oid relationId, O
 	// Set the default option to true so that tables created in a colocated database will be
 	// colocated by default. For regular database, this argument will be ignored.
 	bool		colocated = true;
-	/* Scan list to see if colocated was included */
+	bool		packed_row = false;
+	/* Scan list to see if colocated or packed_row was included */
 	foreach(opt_cell, stmt->options)
 	{
 		DefElem *def = (DefElem *) lfirst(opt_cell);
@@ -496,6 +497,10 @@ YBCCreateTable(CreateStmt *stmt, char relkind, TupleDesc desc, Oid relationId, O
 		{
 			colocated = defGetBoolean(def);
 		}
+		else if (strcmp(def->defname, "packed_row") == 0)
+		{
+			packed_row = defGetBoolean(def);
+		}
 	}
 
 	HandleYBStatus(YBCPgNewCreateTable(db_name,
@@ -511,6 +516,9 @@ YBCCreateTable(CreateStmt *stmt, char relkind, TupleDesc desc, Oid relationId, O
 
 	CreateTableAddColumns(handle, desc, primary_key);
 
+	if (packed_row)
+		HandleYBStmtStatus(YBCPgCreateTableSetPackedRow(handle, packed_row), handle);
+
 	/* Handle SPLIT statement, if present */
 	OptSplit *split_options = stmt->split_options;
 	if (split_options)
@@ -626,7 +634,8 @@ YBCCreateIndex(const char *indexName,
 	{
 		DefElem *def = (DefElem *) lfirst(opt_cell);
 
-		if (strcmp(def->defname, "colocated") == 0)
+		if (strcmp(def->defname, "colocated") == 0 ||
+			strcmp(def->defname, "packed_row") == 0)
 		{
 			ereport(ERROR,
 					(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
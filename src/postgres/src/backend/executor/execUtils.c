@@ -176,7 +176,9 @@ CreateExecutorState(void)
 	estate->yb_exec_params.limit_count = -1;
 	estate->yb_exec_params.limit_offset = 0;
 	estate->yb_exec_params.limit_use_default = true;
+	estate->yb_exec_params.limit_applies_to_scan = false;
 	estate->yb_exec_params.rowmark = -1;
+	estate->yb_exec_params.wait_policy = LockWaitBlock;
 
 	return estate;
 }
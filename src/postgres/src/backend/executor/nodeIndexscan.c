@@ -135,13 +135,17 @@ IndexNext(IndexScanState *node)
 		scandesc->yb_exec_params = &estate->yb_exec_params;
 		// Add row marks.
 		scandesc->yb_exec_params->rowmark = -1;
+		scandesc->yb_exec_params->wait_policy = LockWaitBlock;
 		ListCell   *l;
 		foreach(l, estate->es_rowMarks) {
 			ExecRowMark *erm = (ExecRowMark *) lfirst(l);
 			// Do not propogate non-row-locking row marks.
 			if (erm->markType != ROW_MARK_REFERENCE &&
 				erm->markType != ROW_MARK_COPY)
+			{
 				scandesc->yb_exec_params->rowmark = erm->markType;
+				scandesc->yb_exec_params->wait_policy = erm->waitPolicy;
+			}
 			break;
 		}
 	}
@@ -31,8 +31,41 @@
 
 static void recompute_limits(LimitState *node);
 static int64 compute_tuples_needed(LimitState *node);
+static bool YbLimitAppliesToScan(LimitState *node);
 
 
+/*
+ * Returns true if each row returned by DocDB to the subplan of the Limit node
+ * reaches the Limit node. That is the subplan is a scan that neither filters
+ * rows in Postgres, nor evaluates subplans.
+ */
+static bool
+YbLimitAppliesToScan(LimitState *node)
+{
+	PlanState  *outerPlan = outerPlanState(node);
+
+	if (outerPlan->qual || outerPlan->initPlan || outerPlan->subPlan)
+		return false;
+
+	switch (nodeTag(outerPlan))
+	{
+		case T_ForeignScanState:
+			return true;
+		/*
+		 * Index scan keys that are not bound in DocDB are checked in Postgres,
+		 * so only index scans without keys qualify.
+		 */
+		case T_IndexScanState:
+			return ((IndexScanState *) outerPlan)->iss_NumScanKeys == 0 &&
+				((IndexScanState *) outerPlan)->iss_NumOrderByKeys == 0;
+		case T_IndexOnlyScanState:
+			return ((IndexOnlyScanState *) outerPlan)->ioss_NumScanKeys == 0 &&
+				((IndexOnlyScanState *) outerPlan)->ioss_NumOrderByKeys == 0;
+		default:
+			return false;
+	}
+}
+
 /* ----------------------------------------------------------------
  *		ExecLimit
  *
@@ -106,12 +139,23 @@ ExecLimit(PlanState *pstate)
 				return NULL;
 			}
 
+			/*
+			 * The first fetch starts the scan of the subplan, let the scan
+			 * stop at the limit when the limit applies to each of its rows.
+			 */
+			if (IsYugaByteEnabled())
+				pstate->state->yb_exec_params.limit_applies_to_scan =
+					YbLimitAppliesToScan(node);
+
 			/*
 			 * Fetch rows from subplan until we reach position > offset.
 			 */
 			for (;;)
 			{
 				slot = ExecProcNode(outerPlan);
+				/* Scans started later, e.g. by other nodes, must read all rows. */
+				if (IsYugaByteEnabled())
+					pstate->state->yb_exec_params.limit_applies_to_scan = false;
 				if (TupIsNull(slot))
 				{
 					/*
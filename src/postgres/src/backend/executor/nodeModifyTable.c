@@ -72,6 +72,8 @@
 /*  YB includes. */
 #include "access/sysattr.h"
 #include "catalog/pg_database.h"
+#include "catalog/pg_type.h"
+#include "catalog/ybctype.h"
 #include "executor/ybcModifyTable.h"
 #include "parser/parsetree.h"
 #include "pg_yb_utils.h"
@@ -95,6 +97,10 @@ static void ExecSetupChildParentMapForTcs(ModifyTableState *mtstate);
 static void ExecSetupChildParentMapForSubplan(ModifyTableState *mtstate);
 static TupleConversionMap *tupconv_map_for_subplan(ModifyTableState *node,
 						int whichplan);
+static void YBInitOnConflictBatch(ModifyTableState *mtstate, ModifyTable *node);
+static TupleTableSlot *YBNextOnConflictPlanSlot(ModifyTableState *mtstate,
+						PlanState *subplanstate);
+static bool YBTakeAbsentOnConflictKey(ModifyTableState *mtstate);
 
 /*
  * Verify that the tuples to be produced by INSERT or UPDATE match the
@@ -467,7 +473,8 @@ ExecInsert(ModifyTableState *mtstate,
 			 */
 	vlock:
 			specConflict = false;
-			if (!ExecCheckIndexConstraints(slot, estate, &conflictTid,
+			if (!YBTakeAbsentOnConflictKey(mtstate) &&
+				!ExecCheckIndexConstraints(slot, estate, &conflictTid,
 										   arbiterIndexes))
 			{
 				/* committed conflict tuple found */
@@ -1137,7 +1144,8 @@ ExecUpdate(ModifyTableState *mtstate,
 		RangeTblEntry *rte = rt_fetch(resultRelInfo->ri_RangeTableIndex,
 									  estate->es_range_table);
 
-		bool row_found = YBCExecuteUpdate(resultRelationDesc, planSlot, tuple, estate, mtstate, rte->updatedCols);
+		bool row_found = YBCExecuteUpdate(resultRelationDesc, planSlot, tuple, slot, estate, mtstate,
+										  rte->updatedCols);
 
 		if (!row_found)
 		{
@@ -1148,6 +1156,9 @@ ExecUpdate(ModifyTableState *mtstate,
 			return NULL;
 		}
 
+		/* Values of pushed down SET expressions might have changed tuple */
+		tuple = ExecMaterializeSlot(slot);
+
 		/*
 		 * Update indexes if needed.
 		 */
@@ -1743,6 +1754,233 @@ yb_skip_transaction_control_check:
 	return true;
 }
 
+/*
+ * YBOnConflictSetKeepsPrimaryKey
+ *
+ * Returns true if ON CONFLICT DO UPDATE SET assigns each primary key column
+ * either itself or the same column of the EXCLUDED row, which has the same
+ * value when the conflict is on the primary key.
+ */
+static bool
+YBOnConflictSetKeepsPrimaryKey(ModifyTable *node, Relation rel)
+{
+	Bitmapset  *pkey = GetYBTablePrimaryKey(rel);
+	ListCell   *lc;
+
+	foreach(lc, node->onConflictSet)
+	{
+		TargetEntry *tle = lfirst_node(TargetEntry, lc);
+
+		if (tle->resjunk ||
+			!bms_is_member(tle->resno - FirstLowInvalidHeapAttributeNumber - 1, pkey))
+			continue;
+
+		if (!IsA(tle->expr, Var) || ((Var *) tle->expr)->varattno != tle->resno)
+			return false;
+	}
+	return true;
+}
+
+/*
+ * YBInitOnConflictBatch
+ *
+ * Set up batched conflict checks of INSERT ... ON CONFLICT into a YugaByte
+ * table, whose only arbiter is the primary key.  Rows are read ahead from the
+ * subplan, and their primary keys are read with one batched read, so that the
+ * rows without conflicts are inserted without a read per row, and their
+ * writes are buffered until the next batch is read.
+ *
+ * Batching is not used when the rows could be changed between the batched
+ * read and the insert (BEFORE ROW triggers, partition routing), or when other
+ * writes of the statement could insert the keys that were found absent.
+ */
+static void
+YBInitOnConflictBatch(ModifyTableState *mtstate, ModifyTable *node)
+{
+	EState	   *estate = mtstate->ps.state;
+	ResultRelInfo *resultRelInfo = mtstate->resultRelInfo;
+	Relation	rel = resultRelInfo->ri_RelationDesc;
+	int			batch_size = YBCGetInsertOnConflictBatchSize();
+	bool		has_primary_key_arbiter = false;
+	int			i;
+
+	if (batch_size <= 0 || !IsYBRelation(rel) || mtstate->mt_nplans != 1 ||
+		mtstate->mt_partition_tuple_routing != NULL ||
+		resultRelInfo->ri_junkFilter != NULL ||
+		estate->es_plannedstmt->hasModifyingCTE ||
+		(resultRelInfo->ri_TrigDesc != NULL &&
+		 resultRelInfo->ri_TrigDesc->trig_insert_before_row))
+		return;
+
+	/* Same arbiters as the ones checked by ExecCheckIndexConstraints. */
+	for (i = 0; i < resultRelInfo->ri_NumIndices; i++)
+	{
+		Relation	index = resultRelInfo->ri_IndexRelationDescs[i];
+		IndexInfo  *indexInfo = resultRelInfo->ri_IndexRelationInfo[i];
+
+		if (index == NULL ||
+			(!indexInfo->ii_Unique && !indexInfo->ii_ExclusionOps) ||
+			(node->arbiterIndexes != NIL &&
+			 !list_member_oid(node->arbiterIndexes, RelationGetRelid(index))))
+			continue;
+
+		if (!index->rd_index->indisprimary)
+			return;
+		has_primary_key_arbiter = true;
+	}
+
+	if (!has_primary_key_arbiter ||
+		(node->onConflictAction == ONCONFLICT_UPDATE &&
+		 !YBOnConflictSetKeepsPrimaryKey(node, rel)))
+		return;
+
+	mtstate->yb_oc_batch_size = batch_size;
+	mtstate->yb_oc_slots =
+		(TupleTableSlot **) palloc0(batch_size * sizeof(TupleTableSlot *));
+	mtstate->yb_oc_ybctids = (char **) palloc0(batch_size * sizeof(char *));
+	mtstate->yb_oc_ybctid_sizes =
+		(int64_t *) palloc0(batch_size * sizeof(int64_t));
+	mtstate->yb_oc_context = AllocSetContextCreate(estate->es_query_cxt,
+												   "YB ON CONFLICT batch",
+												   ALLOCSET_DEFAULT_SIZES);
+}
+
+/*
+ * YBReadOnConflictBatch
+ *
+ * Read the next batch of rows from the subplan, and check their primary keys
+ * for conflicts with one batched read.
+ */
+static void
+YBReadOnConflictBatch(ModifyTableState *mtstate, PlanState *subplanstate)
+{
+	EState	   *estate = mtstate->ps.state;
+	Relation	rel = mtstate->resultRelInfo->ri_RelationDesc;
+	Oid			relid = RelationGetRelid(rel);
+	const YBCPgTypeEntity *ybctid_type =
+		YBCDataTypeFromOidMod(YBTupleIdAttributeNumber, BYTEAOID);
+	Bitmapset  *pkey;
+	YBCPgStatement ybc_stmt;
+	MemoryContext oldcontext;
+
+	mtstate->yb_oc_num_rows = 0;
+	mtstate->yb_oc_next_row = 0;
+	mtstate->yb_oc_current_ybctid = NULL;
+	MemoryContextReset(mtstate->yb_oc_context);
+
+	oldcontext = MemoryContextSwitchTo(mtstate->yb_oc_context);
+	pkey = GetYBTablePrimaryKey(rel);
+	HandleYBStatus(YBCPgNewSelect(YBCGetDatabaseOid(rel), relid,
+								  NULL /* prepare_params */, &ybc_stmt));
+	MemoryContextSwitchTo(oldcontext);
+
+	while (mtstate->yb_oc_num_rows < mtstate->yb_oc_batch_size)
+	{
+		int			row = mtstate->yb_oc_num_rows;
+		TupleTableSlot *planSlot;
+		TupleTableSlot *slot;
+		HeapTuple	tuple;
+		bool		has_null_key = false;
+		int			col = -1;
+
+		planSlot = ExecProcNode(subplanstate);
+		if (TupIsNull(planSlot))
+		{
+			mtstate->yb_oc_subplan_done = true;
+			break;
+		}
+
+		if (mtstate->yb_oc_slots[row] == NULL)
+		{
+			oldcontext = MemoryContextSwitchTo(estate->es_query_cxt);
+			mtstate->yb_oc_slots[row] =
+				MakeSingleTupleTableSlot(planSlot->tts_tupleDescriptor);
+			MemoryContextSwitchTo(oldcontext);
+		}
+		slot = mtstate->yb_oc_slots[row];
+		ExecCopySlot(slot, planSlot);
+		tuple = ExecMaterializeSlot(slot);
+
+		oldcontext = MemoryContextSwitchTo(mtstate->yb_oc_context);
+		mtstate->yb_oc_ybctids[row] = NULL;
+		mtstate->yb_oc_ybctid_sizes[row] = 0;
+		while ((col = bms_next_member(pkey, col)) >= 0)
+		{
+			if (heap_attisnull(tuple, col + FirstLowInvalidHeapAttributeNumber + 1,
+							   slot->tts_tupleDescriptor))
+				has_null_key = true;
+		}
+
+		/* Rows without a full primary key are left to the insert to reject. */
+		if (!has_null_key)
+		{
+			Datum		ybctid = YBCGetYBTupleIdFromTuple(ybc_stmt, rel, tuple,
+														  slot->tts_tupleDescriptor);
+
+			ybctid_type->datum_to_yb(ybctid, &mtstate->yb_oc_ybctids[row],
+									 &mtstate->yb_oc_ybctid_sizes[row]);
+			HandleYBStatus(YBCAddInsertOnConflictKeyIntent(relid,
+														   mtstate->yb_oc_ybctids[row],
+														   mtstate->yb_oc_ybctid_sizes[row]));
+		}
+		MemoryContextSwitchTo(oldcontext);
+
+		mtstate->yb_oc_num_rows++;
+	}
+
+	HandleYBStatus(YBCPgDeleteStatement(ybc_stmt));
+	if (mtstate->yb_oc_num_rows > 0)
+		HandleYBStatus(YBCResolveInsertOnConflictKeyIntents(YBCGetDatabaseOid(rel),
+															relid));
+}
+
+/*
+ * YBNextOnConflictPlanSlot
+ *
+ * Return the next row of the subplan for batched INSERT ... ON CONFLICT,
+ * reading the next batch when the rows read ahead are used up.
+ */
+static TupleTableSlot *
+YBNextOnConflictPlanSlot(ModifyTableState *mtstate, PlanState *subplanstate)
+{
+	int			row;
+
+	if (mtstate->yb_oc_next_row == mtstate->yb_oc_num_rows)
+	{
+		if (mtstate->yb_oc_subplan_done)
+			return NULL;
+		YBReadOnConflictBatch(mtstate, subplanstate);
+		if (mtstate->yb_oc_num_rows == 0)
+			return NULL;
+	}
+
+	row = mtstate->yb_oc_next_row++;
+	mtstate->yb_oc_current_ybctid = mtstate->yb_oc_ybctids[row];
+	mtstate->yb_oc_current_ybctid_size = mtstate->yb_oc_ybctid_sizes[row];
+	return mtstate->yb_oc_slots[row];
+}
+
+/*
+ * YBTakeAbsentOnConflictKey
+ *
+ * Returns true if the batched read found no row with the primary key of the
+ * row being inserted, so the row could be inserted without the conflict check.
+ */
+static bool
+YBTakeAbsentOnConflictKey(ModifyTableState *mtstate)
+{
+	char	   *ybctid = mtstate->yb_oc_current_ybctid;
+
+	if (ybctid == NULL)
+		return false;
+
+	/* If the row is checked again, the check reads the table. */
+	mtstate->yb_oc_current_ybctid = NULL;
+	return YBCTakeAbsentInsertOnConflictKey(
+		RelationGetRelid(mtstate->resultRelInfo->ri_RelationDesc),
+		ybctid, mtstate->yb_oc_current_ybctid_size);
+}
+
 /*
  * Process BEFORE EACH STATEMENT triggers
  */
@@ -2222,7 +2460,10 @@ ExecModifyTable(PlanState *pstate)
 		 */
 		ResetPerTupleExprContext(estate);
 
-		planSlot = ExecProcNode(subplanstate);
+		if (node->yb_oc_batch_size > 0)
+			planSlot = YBNextOnConflictPlanSlot(node, subplanstate);
+		else
+			planSlot = ExecProcNode(subplanstate);
 
 		if (TupIsNull(planSlot))
 		{
@@ -2908,6 +3149,13 @@ ExecInitModifyTable(ModifyTable *node, EState *estate, int eflags)
 		}
 	}
 
+	/*
+	 * For YugaByte relations, check the rows of INSERT ... ON CONFLICT for
+	 * conflicts in batches, if possible.
+	 */
+	if (node->onConflictAction != ONCONFLICT_NONE)
+		YBInitOnConflictBatch(mtstate, node);
+
 	/*
 	 * Set up a tuple table slot for use for trigger output tuples. In a plan
 	 * containing multiple ModifyTable nodes, all can share one such slot, so
@@ -2983,6 +3231,18 @@ ExecEndModifyTable(ModifyTableState *node)
 	 */
 	for (i = 0; i < node->mt_nplans; i++)
 		ExecEndNode(node->mt_plans[i]);
+
+	/* Drop the rows read ahead by batched INSERT ... ON CONFLICT */
+	if (node->yb_oc_batch_size > 0)
+	{
+		for (i = 0; i < node->yb_oc_batch_size; i++)
+		{
+			if (node->yb_oc_slots[i] != NULL)
+				ExecDropSingleTupleTableSlot(node->yb_oc_slots[i]);
+		}
+		MemoryContextDelete(node->yb_oc_context);
+		YBCClearInsertOnConflictKeys();
+	}
 }
 
 void
@@ -24,7 +24,21 @@
 #include "executor/execdebug.h"
 #include "executor/nodeNestloop.h"
 #include "miscadmin.h"
+#include "nodes/nodeFuncs.h"
+#include "utils/array.h"
+#include "utils/datum.h"
+#include "utils/lsyscache.h"
 #include "utils/memutils.h"
+#include "utils/typcache.h"
+
+#include "pg_yb_utils.h"
+
+/* GUC parameter */
+int			yb_nest_loop_batch_size = 1;
+
+static void YbInitBatchedNestLoop(NestLoopState *nlstate, NestLoop *node,
+								  EState *estate);
+static TupleTableSlot *YbExecBatchedNestLoop(PlanState *pstate);
 
 
 /* ----------------------------------------------------------------
@@ -255,6 +269,448 @@ ExecNestLoop(PlanState *pstate)
 	}
 }
 
+/*
+ * YugaByte batched nested loop join.
+ *
+ * Rescanning the inner index scan of a YugaByte table for each outer tuple
+ * costs at least one RPC per outer tuple.  When the inner scan has a single
+ * equality condition on a parameter passed from the outer side, the join
+ * collects up to yb_nest_loop_batch_size outer tuples, and fetches the inner
+ * tuples matching all of them with a single scan, where the parameter is
+ * replaced by an IN-list of the outer key values.  Each outer tuple is then
+ * joined with the buffered inner tuples having the same key, in the order of
+ * outer tuples, so the output order is the same as without batching.
+ */
+
+/*
+ * Inner tuple of a batch.  Inner tuples are sorted by key, and then by seq,
+ * the position of the tuple in the inner scan, so the matches of an outer
+ * tuple are found by binary search, and are returned in the scan order.
+ */
+typedef struct YbBatchInnerTuple
+{
+	Datum		key;
+	MinimalTuple tuple;
+	int			seq;
+} YbBatchInnerTuple;
+
+/*
+ * Returns true if node references the PARAM_EXEC parameter with given id.
+ */
+static bool
+yb_references_param_walker(Node *node, int *paramid)
+{
+	if (node == NULL)
+		return false;
+	if (IsA(node, Param))
+	{
+		Param	   *param = (Param *) node;
+
+		return param->paramkind == PARAM_EXEC && param->paramid == *paramid;
+	}
+	return expression_tree_walker(node, yb_references_param_walker,
+								  (void *) paramid);
+}
+
+/*
+ * Sets up batching for the join if it is enabled and the plan supports it,
+ * otherwise leaves yb_batch_size as 0.
+ */
+static void
+YbInitBatchedNestLoop(NestLoopState *nlstate, NestLoop *node, EState *estate)
+{
+	PlanState  *innerPlan = innerPlanState(nlstate);
+	IndexScanState *iss;
+	IndexScan  *plan;
+	NestLoopParam *nlp;
+	IndexRuntimeKeyInfo *runtime_key;
+	ScanKey		key;
+	Param	   *param;
+	Relation	relation;
+	AttrNumber	inner_attno;
+	TypeCacheEntry *typentry;
+	int			i;
+
+	if (!IsYugaByteEnabled() || yb_nest_loop_batch_size <= 1)
+		return;
+
+	if (list_length(node->nestParams) != 1 || !IsA(innerPlan, IndexScanState) ||
+		innerPlan->plan->parallel_aware || innerPlan->plan->initPlan != NIL)
+		return;
+
+	iss = castNode(IndexScanState, innerPlan);
+	plan = castNode(IndexScan, innerPlan->plan);
+	relation = iss->ss.ss_currentRelation;
+	if (!IsYBRelation(relation))
+		return;
+
+	/* The only run-time key should be the equality on the join parameter. */
+	if (iss->iss_NumRuntimeKeys != 1 || iss->iss_NumArrayKeys != 0 ||
+		iss->iss_NumOrderByKeys != 0)
+		return;
+
+	nlp = linitial_node(NestLoopParam, node->nestParams);
+	runtime_key = &iss->iss_RuntimeKeys[0];
+	if (!IsA(runtime_key->key_expr->expr, Param))
+		return;
+	param = (Param *) runtime_key->key_expr->expr;
+	if (param->paramkind != PARAM_EXEC || param->paramid != nlp->paramno)
+		return;
+
+	key = runtime_key->scan_key;
+	if (key->sk_strategy != BTEqualStrategyNumber)
+		return;
+
+	/*
+	 * Index quals are not rechecked while the IN-list is used, so all scan
+	 * keys should be plain ones, that are checked by the index AM itself.
+	 */
+	for (i = 0; i < iss->iss_NumScanKeys; i++)
+	{
+		if (iss->iss_ScanKeys[i].sk_flags != 0)
+			return;
+	}
+
+	/* Key should be a plain column of the same type as the parameter. */
+	inner_attno = iss->iss_RelationDesc->rd_index->indkey.values[key->sk_attno - 1];
+	if (inner_attno <= 0 ||
+		TupleDescAttr(RelationGetDescr(relation), inner_attno - 1)->atttypid !=
+		param->paramtype)
+		return;
+
+	/* Other parts of the inner plan should not depend on the parameter. */
+	if (yb_references_param_walker((Node *) plan->scan.plan.qual, &param->paramid) ||
+		yb_references_param_walker((Node *) plan->scan.plan.targetlist, &param->paramid) ||
+		yb_references_param_walker((Node *) plan->indexorderby, &param->paramid))
+		return;
+
+	/*
+	 * Inner tuples are matched by sorting them with the comparison function
+	 * of the type, so the equality of the scan key should be the one of the
+	 * type's default btree opclass.
+	 */
+	typentry = lookup_type_cache(param->paramtype,
+								 TYPECACHE_EQ_OPR | TYPECACHE_CMP_PROC_FINFO);
+	if (!OidIsValid(typentry->eq_opr) || !OidIsValid(typentry->cmp_proc_finfo.fn_oid) ||
+		get_opcode(typentry->eq_opr) != key->sk_func.fn_oid)
+		return;
+
+	nlstate->yb_batch_size = yb_nest_loop_batch_size;
+	nlstate->yb_batch_key = key;
+	nlstate->yb_batch_outer_attno = nlp->paramval->varattno;
+	nlstate->yb_batch_inner_attno = inner_attno;
+	nlstate->yb_batch_typid = param->paramtype;
+	nlstate->yb_batch_cmp = &typentry->cmp_proc_finfo;
+	get_typlenbyvalalign(param->paramtype, &nlstate->yb_batch_typlen,
+						 &nlstate->yb_batch_typbyval, &nlstate->yb_batch_typalign);
+	nlstate->yb_batch_context = AllocSetContextCreate(CurrentMemoryContext,
+													  "NestLoop batch",
+													  ALLOCSET_DEFAULT_SIZES);
+	nlstate->yb_batch_outer = palloc(sizeof(MinimalTuple) * nlstate->yb_batch_size);
+	nlstate->yb_batch_outer_slot =
+		ExecInitExtraTupleSlot(estate, ExecGetResultType(outerPlanState(nlstate)));
+	nlstate->yb_batch_inner_slot =
+		ExecInitExtraTupleSlot(estate, ExecGetResultType(innerPlan));
+	nlstate->js.ps.ExecProcNode = YbExecBatchedNestLoop;
+}
+
+/*
+ * Compares keys of inner or outer tuples of the batch.
+ */
+static int
+yb_batch_key_cmp(NestLoopState *node, Datum a, Datum b)
+{
+	return DatumGetInt32(FunctionCall2Coll(node->yb_batch_cmp,
+										   node->yb_batch_key->sk_collation,
+										   a, b));
+}
+
+static int
+yb_batch_inner_cmp(const void *a, const void *b, void *arg)
+{
+	const YbBatchInnerTuple *lhs = (const YbBatchInnerTuple *) a;
+	const YbBatchInnerTuple *rhs = (const YbBatchInnerTuple *) b;
+	int			result = yb_batch_key_cmp((NestLoopState *) arg, lhs->key, rhs->key);
+
+	if (result != 0)
+		return result;
+	return lhs->seq < rhs->seq ? -1 : (lhs->seq > rhs->seq ? 1 : 0);
+}
+
+/*
+ * Reads the next batch of outer tuples, and fetches the inner tuples matching
+ * any of them.
+ */
+static void
+YbFillBatch(NestLoopState *node)
+{
+	PlanState  *outerPlan = outerPlanState(node);
+	PlanState  *innerPlan = innerPlanState(node);
+	IndexScanState *iss = castNode(IndexScanState, innerPlan);
+	NestLoop   *nl = (NestLoop *) node->js.ps.plan;
+	NestLoopParam *nlp = linitial_node(NestLoopParam, nl->nestParams);
+	ExprContext *econtext = node->js.ps.ps_ExprContext;
+	ParamExecData *prm = &(econtext->ecxt_param_exec_vals[nlp->paramno]);
+	ScanKey		key = node->yb_batch_key;
+	ExprState  *indexqualorig;
+	MemoryContext oldcontext;
+	Datum	   *values;
+	int			num_values = 0;
+
+	ExecClearTuple(node->yb_batch_outer_slot);
+	ExecClearTuple(node->yb_batch_inner_slot);
+	MemoryContextReset(node->yb_batch_context);
+	node->yb_batch_num_outer = 0;
+	node->yb_batch_outer_idx = 0;
+	node->yb_batch_num_inner = 0;
+	node->yb_batch_inner_capacity = 0;
+	node->yb_batch_inner = NULL;
+
+	values = MemoryContextAlloc(node->yb_batch_context,
+								sizeof(Datum) * node->yb_batch_size);
+	while (node->yb_batch_num_outer < node->yb_batch_size)
+	{
+		TupleTableSlot *outerTupleSlot = ExecProcNode(outerPlan);
+		MinimalTuple tuple;
+		Datum		value;
+		bool		isnull;
+
+		if (TupIsNull(outerTupleSlot))
+		{
+			node->yb_batch_outer_done = true;
+			break;
+		}
+
+		oldcontext = MemoryContextSwitchTo(node->yb_batch_context);
+		tuple = ExecCopySlotMinimalTuple(outerTupleSlot);
+		MemoryContextSwitchTo(oldcontext);
+		node->yb_batch_outer[node->yb_batch_num_outer++] = tuple;
+
+		/* Take the key from the copy, so it stays valid until the next batch. */
+		ExecStoreMinimalTuple(tuple, node->yb_batch_outer_slot, false);
+		value = slot_getattr(node->yb_batch_outer_slot, node->yb_batch_outer_attno,
+							 &isnull);
+		/* Equality is strict, so outer tuples with NULL key have no matches. */
+		if (!isnull)
+			values[num_values++] = value;
+	}
+	ExecClearTuple(node->yb_batch_outer_slot);
+
+	if (num_values == 0)
+		return;
+
+	/*
+	 * Let the regular rescan evaluate the run-time key, and then replace it
+	 * with the array of all keys of the batch.  The index AM removes
+	 * duplicate values of the array.
+	 */
+	key->sk_flags &= ~SK_SEARCHARRAY;
+	prm->value = values[0];
+	prm->isnull = false;
+	innerPlan->chgParam = bms_add_member(innerPlan->chgParam, nlp->paramno);
+	ExecReScan(innerPlan);
+
+	oldcontext = MemoryContextSwitchTo(node->yb_batch_context);
+	key->sk_argument = PointerGetDatum(construct_array(values, num_values,
+													   node->yb_batch_typid,
+													   node->yb_batch_typlen,
+													   node->yb_batch_typbyval,
+													   node->yb_batch_typalign));
+	MemoryContextSwitchTo(oldcontext);
+	key->sk_flags = SK_SEARCHARRAY;
+	if (iss->iss_ScanDesc)
+		index_rescan(iss->iss_ScanDesc,
+					 iss->iss_ScanKeys, iss->iss_NumScanKeys,
+					 iss->iss_OrderByKeys, iss->iss_NumOrderByKeys);
+
+	/*
+	 * The original index quals compare the key with the parameter, i.e. with
+	 * a single outer tuple, so they cannot be used to recheck inner tuples of
+	 * the batch.  Keys are matched against each outer tuple below instead.
+	 */
+	indexqualorig = iss->indexqualorig;
+	iss->indexqualorig = NULL;
+	for (;;)
+	{
+		TupleTableSlot *innerTupleSlot = ExecProcNode(innerPlan);
+		Datum		value;
+		bool		isnull;
+
+		if (TupIsNull(innerTupleSlot))
+			break;
+
+		value = slot_getattr(iss->ss.ss_ScanTupleSlot, node->yb_batch_inner_attno,
+							 &isnull);
+		if (isnull)
+			continue;
+
+		oldcontext = MemoryContextSwitchTo(node->yb_batch_context);
+		if (node->yb_batch_num_inner == node->yb_batch_inner_capacity)
+		{
+			node->yb_batch_inner_capacity = Max(node->yb_batch_inner_capacity * 2,
+												node->yb_batch_size);
+			if (node->yb_batch_inner)
+				node->yb_batch_inner =
+					repalloc(node->yb_batch_inner,
+							 sizeof(YbBatchInnerTuple) * node->yb_batch_inner_capacity);
+			else
+				node->yb_batch_inner =
+					palloc(sizeof(YbBatchInnerTuple) * node->yb_batch_inner_capacity);
+		}
+		node->yb_batch_inner[node->yb_batch_num_inner].key =
+			datumCopy(value, node->yb_batch_typbyval, node->yb_batch_typlen);
+		node->yb_batch_inner[node->yb_batch_num_inner].tuple =
+			ExecCopySlotMinimalTuple(innerTupleSlot);
+		node->yb_batch_inner[node->yb_batch_num_inner].seq = node->yb_batch_num_inner;
+		node->yb_batch_num_inner++;
+		MemoryContextSwitchTo(oldcontext);
+	}
+	iss->indexqualorig = indexqualorig;
+
+	if (node->yb_batch_num_inner > 1)
+		qsort_arg(node->yb_batch_inner, node->yb_batch_num_inner,
+				  sizeof(YbBatchInnerTuple), yb_batch_inner_cmp, node);
+}
+
+/*
+ * Positions yb_batch_inner_idx at the first buffered inner tuple with the key
+ * of the current outer tuple, using binary search over the sorted inner
+ * tuples.
+ */
+static void
+YbFindInnerMatches(NestLoopState *node)
+{
+	int			lo = 0;
+	int			hi = node->yb_batch_num_inner;
+
+	if (node->yb_batch_outer_key_isnull)
+	{
+		node->yb_batch_inner_idx = hi;
+		return;
+	}
+
+	while (lo < hi)
+	{
+		int			mid = lo + (hi - lo) / 2;
+
+		if (yb_batch_key_cmp(node, node->yb_batch_inner[mid].key,
+							 node->yb_batch_outer_key) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	node->yb_batch_inner_idx = lo;
+}
+
+/*
+ * Returns the next buffered inner tuple with the key of the current outer
+ * tuple, or NULL if there are no more such tuples.
+ */
+static TupleTableSlot *
+YbNextInnerMatch(NestLoopState *node)
+{
+	YbBatchInnerTuple *inner;
+
+	if (node->yb_batch_inner_idx >= node->yb_batch_num_inner)
+		return NULL;
+
+	inner = &node->yb_batch_inner[node->yb_batch_inner_idx];
+	if (yb_batch_key_cmp(node, inner->key, node->yb_batch_outer_key) != 0)
+	{
+		node->yb_batch_inner_idx = node->yb_batch_num_inner;
+		return NULL;
+	}
+	node->yb_batch_inner_idx++;
+	return ExecStoreMinimalTuple(inner->tuple, node->yb_batch_inner_slot, false);
+}
+
+/*
+ * Same as ExecNestLoop, but takes outer tuples and matching inner tuples from
+ * the current batch.
+ */
+static TupleTableSlot *
+YbExecBatchedNestLoop(PlanState *pstate)
+{
+	NestLoopState *node = castNode(NestLoopState, pstate);
+	ExprState  *joinqual = node->js.joinqual;
+	ExprState  *otherqual = node->js.ps.qual;
+	ExprContext *econtext = node->js.ps.ps_ExprContext;
+	TupleTableSlot *innerTupleSlot;
+
+	CHECK_FOR_INTERRUPTS();
+
+	ResetExprContext(econtext);
+
+	for (;;)
+	{
+		if (node->nl_NeedNewOuter)
+		{
+			if (node->yb_batch_outer_idx >= node->yb_batch_num_outer)
+			{
+				if (node->yb_batch_outer_done)
+					return NULL;
+				YbFillBatch(node);
+				if (node->yb_batch_num_outer == 0)
+					return NULL;
+			}
+
+			econtext->ecxt_outertuple =
+				ExecStoreMinimalTuple(node->yb_batch_outer[node->yb_batch_outer_idx++],
+									  node->yb_batch_outer_slot, false);
+			node->yb_batch_outer_key = slot_getattr(econtext->ecxt_outertuple,
+													node->yb_batch_outer_attno,
+													&node->yb_batch_outer_key_isnull);
+			YbFindInnerMatches(node);
+			node->nl_NeedNewOuter = false;
+			node->nl_MatchedOuter = false;
+		}
+
+		innerTupleSlot = YbNextInnerMatch(node);
+		econtext->ecxt_innertuple = innerTupleSlot;
+
+		if (innerTupleSlot == NULL)
+		{
+			node->nl_NeedNewOuter = true;
+
+			if (!node->nl_MatchedOuter &&
+				(node->js.jointype == JOIN_LEFT ||
+				 node->js.jointype == JOIN_ANTI))
+			{
+				econtext->ecxt_innertuple = node->nl_NullInnerTupleSlot;
+
+				if (otherqual == NULL || ExecQual(otherqual, econtext))
+					return ExecProject(node->js.ps.ps_ProjInfo);
+				else
+					InstrCountFiltered2(node, 1);
+			}
+			continue;
+		}
+
+		if (ExecQual(joinqual, econtext))
+		{
+			node->nl_MatchedOuter = true;
+
+			if (node->js.jointype == JOIN_ANTI)
+			{
+				node->nl_NeedNewOuter = true;
+				continue;
+			}
+
+			if (node->js.single_match)
+				node->nl_NeedNewOuter = true;
+
+			if (otherqual == NULL || ExecQual(otherqual, econtext))
+				return ExecProject(node->js.ps.ps_ProjInfo);
+			else
+				InstrCountFiltered2(node, 1);
+		}
+		else
+			InstrCountFiltered1(node, 1);
+
+		ResetExprContext(econtext);
+	}
+}
+
 /* ----------------------------------------------------------------
  *		ExecInitNestLoop
  * ----------------------------------------------------------------
@@ -345,6 +801,8 @@ ExecInitNestLoop(NestLoop *node, EState *estate, int eflags)
 	nlstate->nl_NeedNewOuter = true;
 	nlstate->nl_MatchedOuter = false;
 
+	YbInitBatchedNestLoop(nlstate, node, estate);
+
 	NL1_printf("ExecInitNestLoop: %s\n",
 			   "node initialized");
 
@@ -379,6 +837,9 @@ ExecEndNestLoop(NestLoopState *node)
 	ExecEndNode(outerPlanState(node));
 	ExecEndNode(innerPlanState(node));
 
+	if (node->yb_batch_context)
+		MemoryContextDelete(node->yb_batch_context);
+
 	NL1_printf("ExecEndNestLoop: %s\n",
 			   "node processing ended");
 }
@@ -407,4 +868,9 @@ ExecReScanNestLoop(NestLoopState *node)
 
 	node->nl_NeedNewOuter = true;
 	node->nl_MatchedOuter = false;
+
+	/* Drop the rest of the current batch. */
+	node->yb_batch_num_outer = 0;
+	node->yb_batch_outer_idx = 0;
+	node->yb_batch_outer_done = false;
 }
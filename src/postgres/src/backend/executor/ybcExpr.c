@@ -25,6 +25,7 @@
 
 #include "access/htup_details.h"
 #include "catalog/pg_type.h"
+#include "nodes/primnodes.h"
 #include "catalog/pg_proc.h"
 #include "utils/relcache.h"
 #include "utils/rel.h"
@@ -35,6 +36,7 @@
 #include "miscadmin.h"
 #include "utils/syscache.h"
 #include "utils/builtins.h"
+#include "utils/typcache.h"
 
 #include "pg_yb_utils.h"
 #include "executor/ybcExpr.h"
@@ -82,3 +84,159 @@ YBCPgExpr YBCNewEvalExprCall(YBCPgStatement ybc_stmt,
 
 	return ybc_expr;
 }
+
+/*
+ * Returns the name of the comparison operator "opno" on values of type "typid", if DocDB compares
+ * such values exactly as Postgres does, NULL otherwise.
+ */
+static const char *
+YBCGetPushdownOperatorName(Oid opno, Oid typid)
+{
+	TypeCacheEntry *typentry;
+	bool		is_ordered;
+
+	switch (typid)
+	{
+		case BOOLOID:
+		case INT2OID:
+		case INT4OID:
+		case INT8OID:
+		case OIDOID:
+			is_ordered = true;
+			break;
+		case TEXTOID:
+			/*
+			 * Equal texts have equal bytes, but text order depends on collation, so
+			 * only (in)equality could be pushed down.
+			 */
+			is_ordered = false;
+			break;
+		default:
+			return NULL;
+	}
+
+	typentry = lookup_type_cache(typid,
+								 TYPECACHE_EQ_OPR | TYPECACHE_LT_OPR | TYPECACHE_GT_OPR);
+	if (opno == typentry->eq_opr)
+		return "=";
+	if (opno == get_negator(typentry->eq_opr))
+		return "<>";
+	if (!is_ordered)
+		return NULL;
+	if (opno == typentry->lt_opr)
+		return "<";
+	if (opno == typentry->gt_opr)
+		return ">";
+	if (opno == get_negator(typentry->gt_opr))
+		return "<=";
+	if (opno == get_negator(typentry->lt_opr))
+		return ">=";
+	return NULL;
+}
+
+/*
+ * Splits comparison "opexpr" of a column with a constant into its parts. The operator is
+ * commuted if the constant is the left operand. Returns the operator name, or NULL if DocDB can
+ * not evaluate the comparison.
+ */
+static const char *
+YBCGetPushdownComparison(OpExpr *opexpr, Index varno, Var **var, Const **constant)
+{
+	Node	   *left;
+	Node	   *right;
+	Oid			opno = opexpr->opno;
+
+	if (list_length(opexpr->args) != 2)
+		return NULL;
+
+	left = (Node *) linitial(opexpr->args);
+	right = (Node *) lsecond(opexpr->args);
+	if (IsA(left, Const) && IsA(right, Var))
+	{
+		Node	   *tmp = left;
+
+		left = right;
+		right = tmp;
+		opno = get_commutator(opno);
+	}
+
+	if (!IsA(left, Var) || !IsA(right, Const))
+		return NULL;
+
+	*var = (Var *) left;
+	*constant = (Const *) right;
+	if ((*var)->varno != varno || (*var)->varlevelsup != 0 || (*var)->varattno <= 0 ||
+		(*constant)->constisnull || (*constant)->consttype != (*var)->vartype)
+		return NULL;
+
+	return YBCGetPushdownOperatorName(opno, (*var)->vartype);
+}
+
+bool
+YBCIsPushdownCondition(Expr *expr, Index varno)
+{
+	ListCell   *lc;
+	Var		   *var;
+	Const	   *constant;
+
+	switch (nodeTag(expr))
+	{
+		case T_OpExpr:
+			return YBCGetPushdownComparison((OpExpr *) expr, varno, &var, &constant) != NULL;
+		case T_BoolExpr:
+			foreach(lc, ((BoolExpr *) expr)->args)
+			{
+				if (!YBCIsPushdownCondition((Expr *) lfirst(lc), varno))
+					return false;
+			}
+			return true;
+		default:
+			return false;
+	}
+}
+
+YBCPgExpr
+YBCNewCondition(YBCPgStatement ybc_stmt, Expr *expr, Index varno)
+{
+	YBCPgExpr	ybc_expr = NULL;
+	const YBCPgTypeEntity *type_ent = YBCDataTypeFromOidMod(InvalidAttrNumber, BOOLOID);
+
+	if (IsA(expr, OpExpr))
+	{
+		Var		   *var = NULL;
+		Const	   *constant = NULL;
+		const char *opname = YBCGetPushdownComparison((OpExpr *) expr, varno, &var, &constant);
+		YBCPgTypeAttrs type_attrs;
+
+		Assert(opname != NULL);
+		HandleYBStatus(YBCPgNewOperator(ybc_stmt, opname, type_ent, &ybc_expr));
+		type_attrs.typmod = var->vartypmod;
+		HandleYBStatus(YBCPgOperatorAppendArg(ybc_expr,
+											  YBCNewColumnRef(ybc_stmt,
+															  var->varattno,
+															  var->vartype,
+															  &type_attrs)));
+		HandleYBStatus(YBCPgOperatorAppendArg(ybc_expr,
+											  YBCNewConstant(ybc_stmt,
+															 constant->consttype,
+															 constant->constvalue,
+															 false /* is_null */)));
+	}
+	else
+	{
+		BoolExpr   *boolexpr = castNode(BoolExpr, expr);
+		ListCell   *lc;
+		const char *opname = boolexpr->boolop == AND_EXPR ? "and" :
+			(boolexpr->boolop == OR_EXPR ? "or" : "not");
+
+		HandleYBStatus(YBCPgNewOperator(ybc_stmt, opname, type_ent, &ybc_expr));
+		foreach(lc, boolexpr->args)
+		{
+			HandleYBStatus(YBCPgOperatorAppendArg(ybc_expr,
+												  YBCNewCondition(ybc_stmt,
+																  (Expr *) lfirst(lc),
+																  varno)));
+		}
+	}
+	return ybc_expr;
+}
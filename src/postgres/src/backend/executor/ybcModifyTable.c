@@ -23,6 +23,7 @@
 
 #include "postgres.h"
 
+#include "access/hash.h"
 #include "access/htup_details.h"
 #include "access/sysattr.h"
 #include "access/xact.h"
@@ -42,7 +43,9 @@
 #include "catalog/pg_namespace.h"
 #include "catalog/pg_database.h"
 #include "utils/catcache.h"
+#include "utils/datum.h"
 #include "utils/inval.h"
+#include "utils/memutils.h"
 #include "utils/relcache.h"
 #include "utils/rel.h"
 #include "executor/tuptable.h"
@@ -290,10 +293,24 @@ static void YBCExecWriteStmt(YBCPgStatement ybc_stmt, Relation rel, int *rows_af
 	bool is_syscatalog_version_change = is_syscatalog_change
 			&& (modifies_row || RelationHasCachedLists(rel));
 
-	/* Let the master know if this should increment the catalog version. */
+	/*
+	 * Let the master know if this should increment the catalog version, and
+	 * ship the invalidation messages of the transaction so far with it, so that
+	 * other backends can invalidate only the affected cache entries.
+	 */
 	if (is_syscatalog_version_change)
 	{
 		HandleYBStmtStatus(YBCPgSetIsSysCatalogVersionChange(ybc_stmt), ybc_stmt);
+
+		SharedInvalidationMessage *inval_msgs;
+		int nmsgs = YBGetInvalidationMessages(&inval_msgs);
+		if (nmsgs > 0)
+		{
+			HandleYBStmtStatus(YBCPgSetCatalogInvalidationMessages(
+				ybc_stmt, (const char *) inval_msgs,
+				nmsgs * sizeof(SharedInvalidationMessage)), ybc_stmt);
+			pfree(inval_msgs);
+		}
 	}
 
 	HandleYBStmtStatus(YBCPgSetCatalogCacheVersion(ybc_stmt,
@@ -317,16 +334,115 @@ static void YBCExecWriteStmt(YBCPgStatement ybc_stmt, Relation rel, int *rows_af
 	{
 		// TODO(shane) also update the shared memory catalog version here.
 		yb_catalog_cache_version += 1;
+		yb_catalog_cache_local_increments += 1;
+		YBMarkInvalidationMessagesShipped();
 	}
 }
 
+struct YBCTupleIdSet
+{
+	MemoryContext context;		/* holds the table and the ybctids */
+	HTAB	   *ybctids;		/* entries are pointers to the ybctids */
+};
+
+static uint32
+YBCTupleIdHash(const void *key, Size keysize)
+{
+	const bytea *ybctid = *(bytea *const *) key;
+
+	return DatumGetUInt32(hash_any((const unsigned char *) VARDATA_ANY(ybctid),
+								   VARSIZE_ANY_EXHDR(ybctid)));
+}
+
+static int
+YBCTupleIdMatch(const void *key1, const void *key2, Size keysize)
+{
+	const bytea *lhs = *(bytea *const *) key1;
+	const bytea *rhs = *(bytea *const *) key2;
+	Size		len = VARSIZE_ANY_EXHDR(lhs);
+
+	if (len != VARSIZE_ANY_EXHDR(rhs))
+		return 1;
+	return memcmp(VARDATA_ANY(lhs), VARDATA_ANY(rhs), len);
+}
+
+YBCTupleIdSet *
+YBCCreateTupleIdSet(void)
+{
+	YBCTupleIdSet *set = palloc(sizeof(YBCTupleIdSet));
+	HASHCTL		ctl;
+
+	set->context = AllocSetContextCreate(CurrentMemoryContext,
+										 "YB upserted ybctids",
+										 ALLOCSET_DEFAULT_SIZES);
+	MemSet(&ctl, 0, sizeof(ctl));
+	ctl.keysize = sizeof(bytea *);
+	ctl.entrysize = sizeof(bytea *);
+	ctl.hash = YBCTupleIdHash;
+	ctl.match = YBCTupleIdMatch;
+	ctl.hcxt = set->context;
+	set->ybctids = hash_create("YB upserted ybctids", 1024, &ctl,
+							   HASH_ELEM | HASH_FUNCTION | HASH_COMPARE |
+							   HASH_CONTEXT);
+	return set;
+}
+
+long
+YBCTupleIdSetSize(YBCTupleIdSet *set)
+{
+	return hash_get_num_entries(set->ybctids);
+}
+
+void
+YBCFreeTupleIdSet(YBCTupleIdSet *set)
+{
+	/* The table is allocated in a child of the context. */
+	MemoryContextDelete(set->context);
+	pfree(set);
+}
+
+/*
+ * Adds the ybctid of a row to be upserted to the set, reporting a duplicate
+ * key if it is already there. An upsert would silently overwrite the row.
+ */
+static void YBCAddUpsertedTupleId(YBCTupleIdSet *set,
+                                  Relation rel,
+                                  Datum ybctid,
+                                  YBCPgStatement stmt)
+{
+	bytea *key = DatumGetByteaPP(ybctid);
+	bool  found;
+
+	hash_search(set->ybctids, &key, HASH_FIND, &found);
+	if (found)
+	{
+		Oid pkey_oid = RelationGetPrimaryKeyIndex(rel);
+
+		HandleYBStatus(YBCPgDeleteStatement(stmt));
+		ereport(ERROR,
+		        (errcode(ERRCODE_UNIQUE_VIOLATION),
+		         errmsg("duplicate key value violates unique constraint \"%s\"",
+		                OidIsValid(pkey_oid) ? get_rel_name(pkey_oid)
+		                                     : RelationGetRelationName(rel)),
+		         errdetail("The key is loaded more than once into table \"%s\".",
+		                   RelationGetRelationName(rel))));
+	}
+
+	MemoryContext old_context = MemoryContextSwitchTo(set->context);
+	key = DatumGetByteaPP(datumCopy(ybctid, false /* typByVal */, -1 /* typLen */));
+	MemoryContextSwitchTo(old_context);
+	hash_search(set->ybctids, &key, HASH_ENTER, NULL);
+}
+
 /*
  * Utility method to insert a tuple into the relation's backing YugaByte table.
+ * If upserted is set, the tuple is upserted and its ybctid is tracked there.
  */
 static Oid YBCExecuteInsertInternal(Relation rel,
                                     TupleDesc tupleDesc,
                                     HeapTuple tuple,
-                                    bool is_single_row_txn)
+                                    bool is_single_row_txn,
+                                    YBCTupleIdSet *upserted)
 {
 	Oid            dboid    = YBCGetDatabaseOid(rel);
 	Oid            relid    = RelationGetRelid(rel);
@@ -348,9 +464,13 @@ static Oid YBCExecuteInsertInternal(Relation rel,
 	                              relid,
 	                              is_single_row_txn,
 	                              &insert_stmt));
+	if (upserted)
+		HandleYBStmtStatus(YBCPgInsertStmtSetUpsertMode(insert_stmt), insert_stmt);
 
 	/* Get the ybctid for the tuple and bind to statement */
 	tuple->t_ybctid = YBCGetYBTupleIdFromTuple(insert_stmt, rel, tuple, tupleDesc);
+	if (upserted)
+		YBCAddUpsertedTupleId(upserted, rel, tuple->t_ybctid, insert_stmt);
 	YBCBindTupleId(insert_stmt, tuple->t_ybctid);
 
 	for (AttrNumber attnum = minattr; attnum <= natts; attnum++)
@@ -473,7 +593,8 @@ Oid YBCExecuteInsert(Relation rel,
 	return YBCExecuteInsertInternal(rel,
 	                                tupleDesc,
 	                                tuple,
-	                                false /* is_single_row_txn */);
+	                                false /* is_single_row_txn */,
+	                                NULL /* upserted */);
 }
 
 Oid YBCExecuteNonTxnInsert(Relation rel,
@@ -483,7 +604,21 @@ Oid YBCExecuteNonTxnInsert(Relation rel,
 	return YBCExecuteInsertInternal(rel,
 	                                tupleDesc,
 	                                tuple,
-	                                true /* is_single_row_txn */);
+	                                true /* is_single_row_txn */,
+	                                NULL /* upserted */);
+}
+
+Oid YBCExecuteNonTxnUpsert(Relation rel,
+						   TupleDesc tupleDesc,
+						   HeapTuple tuple,
+						   YBCTupleIdSet *upserted)
+{
+	Assert(upserted);
+	return YBCExecuteInsertInternal(rel,
+	                                tupleDesc,
+	                                tuple,
+	                                true /* is_single_row_txn */,
+	                                upserted);
 }
 
 Oid YBCHeapInsert(TupleTableSlot *slot,
@@ -627,6 +762,7 @@ void YBCExecuteDeleteIndex(Relation index, Datum *values, bool *isnull, Datum yb
 bool YBCExecuteUpdate(Relation rel,
 					  TupleTableSlot *slot,
 					  HeapTuple tuple,
+					  TupleTableSlot *tupleSlot,
 					  EState *estate,
 					  ModifyTableState *mtstate,
 					  Bitmapset *updatedCols)
@@ -682,6 +818,7 @@ bool YBCExecuteUpdate(Relation rel,
 
 	ModifyTable *mt_plan = (ModifyTable *) mtstate->ps.plan;
 	ListCell* pushdown_lc = list_head(mt_plan->ybPushdownTlist);
+	Bitmapset *pushdown_attrs = NULL;
 
 	for (int idx = 0; idx < tupleDesc->natts; idx++)
 	{
@@ -713,6 +850,16 @@ bool YBCExecuteUpdate(Relation rel,
 
 			HandleYBStmtStatus(YBCPgDmlAssignColumn(update_stmt, attnum, ybc_expr), update_stmt);
 
+			/*
+			 * The value of a pushed down expression is only known after DocDB evaluated it,
+			 * request it back in the same RPC so the tuple (used by RETURNING, triggers and
+			 * indexes) gets the updated value without reading the row.
+			 */
+			YBCPgTypeAttrs type_attrs = {type_mod};
+			YBCPgExpr target = YBCNewColumnRef(update_stmt, attnum, type_id, &type_attrs);
+			HandleYBStmtStatus(YBCPgDmlAppendTarget(update_stmt, target), update_stmt);
+			pushdown_attrs = bms_add_member(pushdown_attrs, attnum);
+
 			pushdown_lc = lnext(pushdown_lc);
 		}
 		else
@@ -730,6 +877,39 @@ bool YBCExecuteUpdate(Relation rel,
 	int rows_affected_count = 0;
 	YBCExecWriteStmt(update_stmt, rel, isSingleRow ? &rows_affected_count : NULL);
 
+	/* Replace the dummy values of pushed down columns with the values returned by DocDB. */
+	if (pushdown_attrs != NULL && rows_affected_count > 0)
+	{
+		Datum  *values  = (Datum *) palloc0(tupleDesc->natts * sizeof(Datum));
+		bool   *isnull  = (bool *) palloc(tupleDesc->natts * sizeof(bool));
+		bool   *replace = (bool *) palloc0(tupleDesc->natts * sizeof(bool));
+		bool    has_data = false;
+
+		HandleYBStmtStatus(YBCPgDmlFetch(update_stmt,
+		                                 tupleDesc->natts,
+		                                 (uint64_t *) values,
+		                                 isnull,
+		                                 NULL /* syscols */,
+		                                 &has_data),
+		                   update_stmt);
+		if (has_data)
+		{
+			int attnum = -1;
+			while ((attnum = bms_next_member(pushdown_attrs, attnum)) >= 0)
+				replace[attnum - 1] = true;
+
+			HeapTuple new_tuple = heap_modify_tuple(tuple, tupleDesc, values, isnull, replace);
+			new_tuple->t_tableOid = tuple->t_tableOid;
+			ExecStoreTuple(new_tuple, tupleSlot, InvalidBuffer, true /* shouldFree */);
+			tuple = new_tuple;
+		}
+
+		pfree(values);
+		pfree(isnull);
+		pfree(replace);
+		bms_free(pushdown_attrs);
+	}
+
 	/* Cleanup. */
 	HandleYBStatus(YBCPgDeleteStatement(update_stmt));
 	update_stmt = NULL;
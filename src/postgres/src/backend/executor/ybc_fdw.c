@@ -149,6 +149,7 @@ ybcGetForeignPlan(PlannerInfo *root,
 {
 	YbFdwPlanState *yb_plan_state = (YbFdwPlanState *) baserel->fdw_private;
 	Index          scan_relid     = baserel->relid;
+	List           *remote_exprs  = NIL;
 	ListCell       *lc;
 
 	scan_clauses = extract_actual_clauses(scan_clauses, false);
@@ -170,6 +171,14 @@ ybcGetForeignPlan(PlannerInfo *root,
 		                        baserel->relid,
 		                        &yb_plan_state->target_attrs,
 		                        baserel->min_attr);
+
+		/*
+		 * Conditions that DocDB can evaluate are also sent to DocDB, so it does not return the
+		 * rows that do not match them. They are kept in the scan clauses, so Postgres rechecks
+		 * them.
+		 */
+		if (yb_enable_where_pushdown && YBCIsPushdownCondition(expr, scan_relid))
+			remote_exprs = lappend(remote_exprs, expr);
 	}
 
 	/* Set scan targets. */
@@ -218,7 +227,7 @@ ybcGetForeignPlan(PlannerInfo *root,
 	return make_foreignscan(tlist,  /* target list */
 	                        scan_clauses,
 	                        scan_relid,
-	                        NIL,    /* expressions YB may evaluate (none) */
+	                        remote_exprs,  /* expressions YB may evaluate */
 	                        target_attrs,  /* fdw_private data for YB */
 	                        NIL,    /* custom YB target list (none for now) */
 	                        NIL,    /* custom YB target list (none for now) */
@@ -270,13 +279,17 @@ ybcBeginForeignScan(ForeignScanState *node, int eflags)
 	ybc_state->exec_params = &estate->yb_exec_params;
 
 	ybc_state->exec_params->rowmark = -1;
+	ybc_state->exec_params->wait_policy = LockWaitBlock;
 	ListCell   *l;
 	foreach(l, estate->es_rowMarks) {
 		ExecRowMark *erm = (ExecRowMark *) lfirst(l);
 		// Do not propogate non-row-locking row marks.
 		if (erm->markType != ROW_MARK_REFERENCE &&
 			erm->markType != ROW_MARK_COPY)
+		{
 			ybc_state->exec_params->rowmark = erm->markType;
+			ybc_state->exec_params->wait_policy = erm->waitPolicy;
+		}
 		break;
 	}
 
@@ -449,6 +462,27 @@ ybcSetupScanTargets(ForeignScanState *node)
 	MemoryContextSwitchTo(oldcontext);
 }
 
+/*
+ * Send the scan conditions, that DocDB can evaluate, to DocDB.
+ */
+static void
+ybcSetupScanConditions(ForeignScanState *node)
+{
+	ForeignScan *foreignScan = (ForeignScan *) node->ss.ps.plan;
+	YbFdwExecState *ybc_state = (YbFdwExecState *) node->fdw_state;
+	ListCell *lc;
+
+	foreach(lc, foreignScan->fdw_exprs)
+	{
+		YBCPgExpr condition = YBCNewCondition(ybc_state->handle,
+											  (Expr *) lfirst(lc),
+											  foreignScan->scan.scanrelid);
+		HandleYBStmtStatusWithOwner(YBCPgDmlAppendWhereExpr(ybc_state->handle, condition),
+									ybc_state->handle,
+									ybc_state->stmt_owner);
+	}
+}
+
 /*
  * ybcIterateForeignScan
  *		Read next record from the data file and store it into the
@@ -469,6 +503,7 @@ ybcIterateForeignScan(ForeignScanState *node)
 	 */
 	if (!ybc_state->is_exec_done) {
 		ybcSetupScanTargets(node);
+		ybcSetupScanConditions(node);
 		HandleYBStmtStatusWithOwner(YBCPgExecSelect(ybc_state->handle, ybc_state->exec_params),
 																ybc_state->handle,
 																ybc_state->stmt_owner);
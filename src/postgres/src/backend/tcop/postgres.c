@@ -3698,23 +3698,53 @@ static void YBRefreshCache()
 				        errmsg("Cannot refresh cache within a transaction")));
 	}
 
-	/* Get the latest syscatalog version from the master */
+	/*
+	 * Get the latest syscatalog version from the master, with the invalidation
+	 * messages of the catalog changes since our caches were refreshed, if the
+	 * master still has all of them.
+	 */
 	uint64_t catalog_master_version = 0;
-	YBCPgGetCatalogMasterVersion(&catalog_master_version);
+	const char *inval_messages = NULL;
+	size_t inval_messages_size = 0;
+	uint64_t since_version =
+		yb_catalog_cache_version > yb_catalog_cache_local_increments ?
+		yb_catalog_cache_version - yb_catalog_cache_local_increments :
+		YB_CATCACHE_VERSION_UNINITIALIZED;
+	YBCStatus status = YBCPgGetCatalogInvalidations(since_version,
+													&catalog_master_version,
+													&inval_messages,
+													&inval_messages_size);
+	if (status)
+	{
+		/* The next statement refreshes the caches again to the right version. */
+		YBCFreeStatus(status);
+		catalog_master_version = 0;
+		inval_messages = NULL;
+	}
 
 	/* Need to execute some (read) queries internally so start a local txn. */
 	start_xact_command();
 
-	/* Clear and reload system catalog caches, including all callbacks. */
-	ResetCatalogCaches();
-	CallSystemCacheCallbacks();
-	YBPreloadRelCache();
+	if (inval_messages != NULL)
+	{
+		/* Invalidate only the cache entries affected by the catalog changes. */
+		YBProcessInvalidationMessages(inval_messages, inval_messages_size);
+		YBCheckDatabaseIsValid();
+	}
+	else
+	{
+		/* Clear and reload system catalog caches, including all callbacks. */
+		ResetCatalogCaches();
+		CallSystemCacheCallbacks();
+		YBPreloadRelCache();
 
-	/* Also invalidate the pggate cache. */
-	YBCPgInvalidateCache();
+		/* Also invalidate the pggate cache. */
+		YBCPgInvalidateCache();
+	}
 
 	/* Set the new ysql cache version. */
 	yb_catalog_cache_version = catalog_master_version;
+	yb_catalog_cache_local_increments = 0;
 	yb_need_cache_refresh = false;
 
 	finish_xact_command();
@@ -250,6 +250,9 @@ static void ri_ReportViolation(const RI_ConstraintInfo *riinfo,
 
 static void BuildYBTupleId(Relation pk_rel, Relation fk_rel, Relation idx,
 					const RI_ConstraintInfo *riinfo, HeapTuple tup, void **data, int64_t *bytes);
+static void YBGetReferencedTupleId(const RI_ConstraintInfo *riinfo,
+					Relation pk_rel, Relation fk_rel, HeapTuple new_row,
+					Oid *ref_table_id, char **tuple_id, int64_t *tuple_id_size);
 
 
 /* ----------
@@ -403,23 +406,17 @@ RI_FKey_check(TriggerData *trigdata)
 	 */
 	if (IsYBRelation(pk_rel))
 	{
+		YBGetReferencedTupleId(riinfo, pk_rel, fk_rel, new_row,
+							   &ref_table_id, &tuple_id, &tuple_id_size);
+
 		/*
-		 * Get the referenced index table.
-		 * For primary key index, we need to use the base table relation.
+		 * On a cache miss, read the rows registered by the other rows of the
+		 * statement in one batch, so the following checks hit the cache.
 		 */
-		Relation idx_rel = RelationIdGetRelation(riinfo->conindid);
-		if (idx_rel->rd_index != NULL)
-		{
-			ref_table_id = idx_rel->rd_index->indisprimary ?
-					idx_rel->rd_index->indrelid : riinfo->conindid;
-		}
-
-		BuildYBTupleId(
-			pk_rel /* Primary table */,
-			fk_rel /* Reference table */,
-			ref_table_id == pk_rel->rd_id ? pk_rel : idx_rel /* Reference index */,
-			riinfo, new_row, (void **)&tuple_id, &tuple_id_size);
-		RelationClose(idx_rel);
+		if (tuple_id != NULL &&
+			!YBCForeignKeyReferenceExists(ref_table_id, tuple_id, tuple_id_size))
+			HandleYBStatus(YBCResolveForeignKeyReferenceIntents(YBCGetDatabaseOid(pk_rel),
+																ref_table_id));
 
 		if (tuple_id != NULL && YBCForeignKeyReferenceExists(ref_table_id, tuple_id, tuple_id_size))
 		{
@@ -507,6 +504,45 @@ RI_FKey_check(TriggerData *trigdata)
 }
 
 
+/* ----------
+ * YBAddForeignKeyReferenceIntent -
+ *
+ *	Register the row referenced by a new FK row, so that the references of
+ *	all rows of the statement could be checked with batched reads.
+ * ----------
+ */
+void
+YBAddForeignKeyReferenceIntent(Trigger *trigger, Relation fk_rel,
+							   HeapTuple new_row)
+{
+	const RI_ConstraintInfo *riinfo;
+	Relation	pk_rel;
+	Oid			ref_table_id = InvalidOid;
+	char	   *tuple_id = NULL;
+	int64_t		tuple_id_size = 0;
+
+	riinfo = ri_FetchConstraintInfo(trigger, fk_rel, false);
+
+	/* Only fully qualified keys are looked up by the check. */
+	if (riinfo->confmatchtype == FKCONSTR_MATCH_PARTIAL ||
+		ri_NullCheck(RelationGetDescr(fk_rel), new_row, riinfo, false) !=
+		RI_KEYS_NONE_NULL)
+		return;
+
+	pk_rel = heap_open(riinfo->pk_relid, RowShareLock);
+	if (IsYBRelation(pk_rel))
+	{
+		YBGetReferencedTupleId(riinfo, pk_rel, fk_rel, new_row,
+							   &ref_table_id, &tuple_id, &tuple_id_size);
+		if (tuple_id != NULL)
+			HandleYBStatus(YBCAddForeignKeyReferenceIntent(ref_table_id,
+														   tuple_id,
+														   tuple_id_size));
+	}
+	heap_close(pk_rel, RowShareLock);
+}
+
+
 /* ----------
  * RI_FKey_check_ins -
  *
@@ -2758,6 +2794,34 @@ BuildYBTupleId(Relation pk_rel, Relation fk_rel, Relation idx_rel,
 	HandleYBStatus(YBCPgDeleteStatement(ybc_stmt));
 }
 
+/*
+ * Get the ID of the referenced relation (table or unique index) and the
+ * ybctid of the row referenced by new_row.
+ */
+static void
+YBGetReferencedTupleId(const RI_ConstraintInfo *riinfo,
+					   Relation pk_rel, Relation fk_rel, HeapTuple new_row,
+					   Oid *ref_table_id, char **tuple_id, int64_t *tuple_id_size)
+{
+	/*
+	 * Get the referenced index table.
+	 * For primary key index, we need to use the base table relation.
+	 */
+	Relation idx_rel = RelationIdGetRelation(riinfo->conindid);
+	if (idx_rel->rd_index != NULL)
+	{
+		*ref_table_id = idx_rel->rd_index->indisprimary ?
+				idx_rel->rd_index->indrelid : riinfo->conindid;
+	}
+
+	BuildYBTupleId(
+		pk_rel /* Primary table */,
+		fk_rel /* Reference table */,
+		*ref_table_id == pk_rel->rd_id ? pk_rel : idx_rel /* Reference index */,
+		riinfo, new_row, (void **)tuple_id, tuple_id_size);
+	RelationClose(idx_rel);
+}
+
 /*
  * Extract fields from a tuple into Datum/nulls arrays
  */
@@ -102,6 +102,7 @@
 #include "access/xact.h"
 #include "catalog/catalog.h"
 #include "catalog/pg_constraint.h"
+#include "catalog/pg_database.h"
 #include "miscadmin.h"
 #include "storage/sinval.h"
 #include "storage/smgr.h"
@@ -114,6 +115,8 @@
 #include "utils/snapmgr.h"
 #include "utils/syscache.h"
 
+#include "pg_yb_utils.h"
+
 
 /*
  * To minimize palloc traffic, we keep pending requests in successively-
@@ -176,6 +179,25 @@ static SharedInvalidationMessage *SharedInvalidMessagesArray;
 static int	numSharedInvalidMessagesArray;
 static int	maxSharedInvalidMessagesArray;
 
+/*
+ * YugaByte: backends of other nodes do not read our shared invalidation
+ * queue, so the messages registered by a transaction that changes the
+ * catalog are shipped to the master with the catalog version increments.
+ * Backends noticing a new catalog version fetch the messages of the versions
+ * they missed, and invalidate only the affected cache entries.
+ *
+ * Whether messages were registered since the messages of the transaction
+ * were last shipped, and whether the transaction shipped any.
+ */
+static bool yb_unshipped_inval_messages = false;
+static bool yb_shipped_inval_messages = false;
+
+/*
+ * Above this number of messages none are shipped, so other backends reset
+ * their caches.
+ */
+#define YB_MAX_SHIPPED_INVAL_MESSAGES 4096
+
 
 /*
  * Dynamically-registered callback functions.  Current implementation
@@ -261,6 +283,8 @@ AddInvalidationMessage(InvalidationChunk **listHdr,
 	/* Okay, add message to current chunk */
 	chunk->msgs[chunk->nitems] = *msg;
 	chunk->nitems++;
+
+	yb_unshipped_inval_messages = true;
 }
 
 /*
@@ -996,6 +1020,138 @@ AtEOXact_Inval(bool isCommit)
 	transInvalInfo = NULL;
 	SharedInvalidMessagesArray = NULL;
 	numSharedInvalidMessagesArray = 0;
+	yb_unshipped_inval_messages = false;
+	yb_shipped_inval_messages = false;
+}
+
+/*
+ * Append the messages of the list to array, or only count them if array is
+ * NULL.
+ */
+static void
+YBCollectInvalidationMessages(InvalidationListHeader *hdr,
+							  SharedInvalidationMessage *array, int *count)
+{
+	ProcessMessageListMulti(hdr->cclist,
+							if (array)
+								memcpy(array + *count, msgs,
+									   n * sizeof(SharedInvalidationMessage));
+							*count += n);
+	ProcessMessageListMulti(hdr->rclist,
+							if (array)
+								memcpy(array + *count, msgs,
+									   n * sizeof(SharedInvalidationMessage));
+							*count += n);
+}
+
+/*
+ * YBGetInvalidationMessages
+ *		Collect the invalidation messages registered so far by the current
+ *		transaction, at all subtransaction levels, into a palloc'd array.
+ *
+ * Returns the number of messages, that is 0 if there are too many of them to
+ * ship.
+ */
+int
+YBGetInvalidationMessages(SharedInvalidationMessage **msgs)
+{
+	TransInvalidationInfo *info;
+	int			nmsgs = 0;
+
+	*msgs = NULL;
+	for (info = transInvalInfo; info != NULL; info = info->parent)
+	{
+		YBCollectInvalidationMessages(&info->CurrentCmdInvalidMsgs, NULL, &nmsgs);
+		YBCollectInvalidationMessages(&info->PriorCmdInvalidMsgs, NULL, &nmsgs);
+	}
+	if (nmsgs == 0 || nmsgs > YB_MAX_SHIPPED_INVAL_MESSAGES)
+		return 0;
+
+	*msgs = (SharedInvalidationMessage *)
+		palloc(nmsgs * sizeof(SharedInvalidationMessage));
+	nmsgs = 0;
+	for (info = transInvalInfo; info != NULL; info = info->parent)
+	{
+		YBCollectInvalidationMessages(&info->CurrentCmdInvalidMsgs, *msgs, &nmsgs);
+		YBCollectInvalidationMessages(&info->PriorCmdInvalidMsgs, *msgs, &nmsgs);
+	}
+	return nmsgs;
+}
+
+/*
+ * YBMarkInvalidationMessagesShipped
+ *		Note that the messages returned by YBGetInvalidationMessages were
+ *		shipped with a catalog version increment.
+ */
+void
+YBMarkInvalidationMessagesShipped(void)
+{
+	yb_unshipped_inval_messages = false;
+	yb_shipped_inval_messages = true;
+}
+
+/*
+ * YBPreCommit_Inval
+ *		Ship the messages registered after the last catalog version increment
+ *		of the transaction, e.g. explicit relcache invalidations of the
+ *		relations affected by a DDL, with one more catalog version increment.
+ *
+ * Transactions that did not increment the catalog version are left alone,
+ * since other backends do not look for their changes anyway.
+ */
+void
+YBPreCommit_Inval(void)
+{
+	SharedInvalidationMessage *msgs;
+	int			nmsgs;
+	uint64_t	version;
+
+	if (!yb_shipped_inval_messages || !yb_unshipped_inval_messages)
+		return;
+
+	nmsgs = YBGetInvalidationMessages(&msgs);
+	HandleYBStatus(YBCPgIncrementCatalogVersion((const char *) msgs,
+												nmsgs * sizeof(SharedInvalidationMessage),
+												&version));
+	YBMarkInvalidationMessagesShipped();
+
+	/* Our caches already reflect the change, as for other local increments. */
+	yb_catalog_cache_version += 1;
+	yb_catalog_cache_local_increments += 1;
+}
+
+/*
+ * YBProcessInvalidationMessages
+ *		Invalidate the local cache entries affected by the catalog changes of
+ *		other backends, given their shipped invalidation messages.
+ */
+void
+YBProcessInvalidationMessages(const char *data, size_t size)
+{
+	size_t		pos;
+
+	for (pos = 0;
+		 pos + sizeof(SharedInvalidationMessage) <= size;
+		 pos += sizeof(SharedInvalidationMessage))
+	{
+		SharedInvalidationMessage msg;
+
+		/* The shipped messages need not be aligned */
+		memcpy(&msg, data + pos, sizeof(msg));
+		LocalExecuteInvalidationMessage(&msg);
+
+		/* Table descriptors cached by pggate go with the relcache entries */
+		if (msg.id == SHAREDINVALRELCACHE_ID &&
+			(msg.rc.dbId == MyDatabaseId || msg.rc.dbId == InvalidOid))
+		{
+			if (msg.rc.relId == InvalidOid)
+				HandleYBStatus(YBCPgInvalidateCache());
+			else
+				HandleYBStatus(YBCPgInvalidateTableCacheByTableId(
+					msg.rc.dbId == InvalidOid ? TemplateDbOid : MyDatabaseId,
+					msg.rc.relId));
+		}
+	}
 }
 
 /*
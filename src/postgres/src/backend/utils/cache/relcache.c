@@ -138,6 +138,12 @@ bool		criticalRelcachesBuilt = false;
  */
 bool		criticalSharedRelcachesBuilt = false;
 
+/*
+ * Master catalog version the init files were checked against, if any.
+ */
+static uint64_t yb_init_file_master_version = 0;
+static bool yb_init_file_master_version_valid = false;
+
 /*
  * This counter counts relcache inval events received since backend startup
  * (but only for rels that are actually in cache).  Presently, we use it only
@@ -1278,18 +1284,14 @@ equalPartitionDescs(PartitionKey key, PartitionDesc partdesc1,
  *  Note: We assume that any error happening here will fatal so as to not end
  *  up with partial information in the cache.
  */
-void YBPreloadRelCache()
+/*
+ * Make sure that the connection is still valid.
+ * - If the name is already dropped from the cache, raise error.
+ * - If the name is still in the cache, we look for the associated OID in the system.
+ *   Raise error if that OID is not MyDatabaseId, which must be either invalid or new DB.
+ */
+void YBCheckDatabaseIsValid()
 {
-	Relation    relation;
-	Oid         relid;
-	SysScanDesc scandesc;
-
-	/*
-	 * Make sure that the connection is still valid.
-	 * - If the name is already dropped from the cache, raise error.
-	 * - If the name is still in the cache, we look for the associated OID in the system.
-	 *   Raise error if that OID is not MyDatabaseId, which must be either invalid or new DB.
-	 */
 	Oid dboid = InvalidOid;
 	const char *dbname = get_database_name(MyDatabaseId);
 	if (dbname != NULL)
@@ -1302,6 +1304,15 @@ void YBPreloadRelCache()
 						 errmsg("Could not reconnect to database"),
 						 errhint("Database might have been dropped by another user")));
 	}
+}
+
+void YBPreloadRelCache()
+{
+	Relation    relation;
+	Oid         relid;
+	SysScanDesc scandesc;
+
+	YBCheckDatabaseIsValid();
 
 	/*
 	 * Loading the relation cache requires per-relation lookups to a number of related system tables
@@ -4542,9 +4553,11 @@ RelationCacheInitializePhase3(void)
 
 	/*
 	 * During initdb also preload catalog caches (not just relation cache) as
-	 * they will be used heavily.
+	 * they will be used heavily. Regular connections do the same if requested,
+	 * so that they don't flood the master with single row lookups.
 	 */
-	if (IsYugaByteEnabled() && YBIsPreparingTemplates())
+	if (IsYugaByteEnabled() &&
+		(YBIsPreparingTemplates() || yb_preload_catalog_caches_on_connect))
 	{
 		YBPreloadCatalogCaches();
 	}
@@ -6143,12 +6156,19 @@ load_relcache_init_file(bool shared)
 			goto read_failed;
 		}
 
-		/* Else, still need to check with the master version to be sure. */
-		uint64_t catalog_master_version = 0;
-		YBCPgGetCatalogMasterVersion(&catalog_master_version);
+		/*
+		 * Else, still need to check with the master version to be sure.
+		 * Both init files are loaded during backend startup, so the master is
+		 * asked only once.
+		 */
+		if (!yb_init_file_master_version_valid)
+		{
+			YBCPgGetCatalogMasterVersion(&yb_init_file_master_version);
+			yb_init_file_master_version_valid = true;
+		}
 
 		/* File version does not match actual master version (i.e. too old) */
-		if (ybc_stored_cache_version != catalog_master_version)
+		if (ybc_stored_cache_version != yb_init_file_master_version)
 		{
 			unlink_initfile(initfilename, ERROR);
 			goto read_failed;
@@ -1318,7 +1318,8 @@ YBPreloadCatalogCacheIfEssential(int cache_id)
  * Preload catalog caches with data from the master to avoid master lookups
  * later.
  *
- * Used during initdb.
+ * Used during initdb, and at connection start if
+ * yb_preload_catalog_caches_on_connect is set.
  */
 void
 YBPreloadCatalogCaches(void)
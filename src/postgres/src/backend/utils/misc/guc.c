@@ -41,6 +41,7 @@
 #include "commands/vacuum.h"
 #include "commands/variable.h"
 #include "commands/trigger.h"
+#include "executor/nodeNestloop.h"
 #include "funcapi.h"
 #include "jit/jit.h"
 #include "libpq/auth.h"
@@ -1843,6 +1844,28 @@ static struct config_bool ConfigureNamesBool[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"yb_preload_catalog_caches_on_connect", PGC_SIGHUP, CONN_AUTH_SETTINGS,
+			gettext_noop("Preload the most used catalog caches when a connection starts."),
+			gettext_noop("Loads each cache with a single scan of its catalog table, "
+						 "instead of many lookups made later by the connection."),
+		},
+		&yb_preload_catalog_caches_on_connect,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"yb_enable_where_pushdown", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Push conditions of sequential scans down to DocDB."),
+			gettext_noop("Rows that do not match the conditions are filtered out by DocDB, "
+						 "instead of being sent to Postgres."),
+		},
+		&yb_enable_where_pushdown,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"data_sync_retry", PGC_POSTMASTER, ERROR_HANDLING_OPTIONS,
 			gettext_noop("Whether to continue running after a failure to sync data files."),
@@ -3085,6 +3108,19 @@ static struct config_int ConfigureNamesInt[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"yb_nest_loop_batch_size", PGC_USERSET, QUERY_TUNING_OTHER,
+			gettext_noop("Sets the number of outer rows of a nested loop join, "
+						 "that are joined using a single scan of the inner YugaByte table."),
+			gettext_noop("Applies to joins whose inner side is an index scan with a "
+						 "single equality condition on the join key. "
+						 "1 disables batching.")
+		},
+		&yb_nest_loop_batch_size,
+		1, 1, 1024,
+		NULL, NULL, NULL
+	},
+
 	/* End-of-list marker */
 	{
 		{NULL, 0, 0, NULL, NULL}, NULL, 0, 0, 0, NULL, NULL, NULL
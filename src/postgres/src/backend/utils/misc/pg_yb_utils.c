@@ -56,6 +56,12 @@
 
 uint64_t yb_catalog_cache_version = YB_CATCACHE_VERSION_UNINITIALIZED;
 
+uint64_t yb_catalog_cache_local_increments = 0;
+
+bool yb_preload_catalog_caches_on_connect = false;
+
+bool yb_enable_where_pushdown = false;
+
 /** These values are lazily initialized based on corresponding environment variables. */
 int ybc_pg_double_write = -1;
 int ybc_disable_pg_locking = -1;
@@ -382,6 +388,14 @@ YBCRestartTransaction()
 	HandleYBStatus(YBCPgRestartTransaction());
 }
 
+void
+YBCResetTransactionReadPoint()
+{
+	if (!IsYugaByteEnabled())
+		return;
+	HandleYBStatus(YBCPgResetTransactionReadPoint());
+}
+
 static void
 YBCResetCommitStatus()
 {
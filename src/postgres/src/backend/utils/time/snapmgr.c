@@ -366,6 +366,15 @@ GetTransactionSnapshot(void)
 	/* Don't allow catalog snapshot to be older than xact snapshot. */
 	InvalidateCatalogSnapshot();
 
+	/*
+	 * New statement of a READ COMMITTED transaction should see data committed
+	 * before it.  The YB read point is shared by the whole transaction, so it
+	 * is kept while snapshots of earlier statements are still in use, e.g. by
+	 * open cursors, that should continue reading at the point they started.
+	 */
+	if (pairingheap_is_empty(&RegisteredSnapshots) && ActiveSnapshot == NULL)
+		YBCResetTransactionReadPoint();
+
 	CurrentSnapshot = GetSnapshotData(&CurrentSnapshotData);
 
 	return CurrentSnapshot;
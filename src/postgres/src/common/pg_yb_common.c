@@ -133,3 +133,14 @@ YBIsNonTxnCopyEnabled()
 	}
 	return cached_value;
 }
+
+bool
+YBIsNonTxnCopyBulkLoadEnabled()
+{
+	static int cached_value = -1;
+	if (cached_value == -1)
+	{
+		cached_value = YBCIsEnvVarTrue("FLAGS_ysql_non_txn_copy_bulk_load");
+	}
+	return cached_value;
+}
@@ -271,4 +271,7 @@ extern bool RI_Initial_Check(Trigger *trigger,
 
 extern int	RI_FKey_trigger_type(Oid tgfoid);
 
+extern void YBAddForeignKeyReferenceIntent(Trigger *trigger, Relation fk_rel,
+							   HeapTuple new_row);
+
 #endif							/* TRIGGER_H */
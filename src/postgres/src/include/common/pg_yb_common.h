@@ -83,4 +83,10 @@ extern int YBUnsupportedFeatureSignalLevel();
  */
 extern bool YBIsNonTxnCopyEnabled();
 
+/**
+ * Returns whether non-transactional COPY into empty tables should write rows
+ * as upserts.
+ */
+extern bool YBIsNonTxnCopyBulkLoadEnabled();
+
 #endif /* PG_YB_COMMON_H */
@@ -42,4 +42,10 @@ extern YBCPgExpr YBCNewConstant(YBCPgStatement ybc_stmt, Oid type_id, Datum datu
 // Construct a generic eval_expr call for given a PG Expr and its expected type and attno.
 extern YBCPgExpr YBCNewEvalExprCall(YBCPgStatement ybc_stmt, Expr *expr, int32_t attno, int32_t type_id, int32_t type_mod);
 
+// Whether DocDB evaluates the given condition on columns of relation "varno" exactly as Postgres.
+extern bool YBCIsPushdownCondition(Expr *expr, Index varno);
+
+// Construct condition expression, that must be accepted by YBCIsPushdownCondition.
+extern YBCPgExpr YBCNewCondition(YBCPgStatement ybc_stmt, Expr *expr, Index varno);
+
 #endif							/* YBCEXPR_H */
@@ -53,6 +53,28 @@ extern Oid YBCExecuteNonTxnInsert(Relation rel,
 								  TupleDesc tupleDesc,
 								  HeapTuple tuple);
 
+/*
+ * Set of ybctids of the rows written by YBCExecuteNonTxnUpsert, used to
+ * report duplicate keys within the written rows.
+ */
+typedef struct YBCTupleIdSet YBCTupleIdSet;
+
+extern YBCTupleIdSet *YBCCreateTupleIdSet(void);
+extern long YBCTupleIdSetSize(YBCTupleIdSet *set);
+extern void YBCFreeTupleIdSet(YBCTupleIdSet *set);
+
+/*
+ * Execute the insert outside of a transaction, overwriting the row with the
+ * same primary key if there is one.
+ * Raises a unique violation if the row has the same primary key as one of
+ * the rows in upserted, and adds the row to upserted otherwise.
+ * Assumes the caller checked that it is safe to do so.
+ */
+extern Oid YBCExecuteNonTxnUpsert(Relation rel,
+								  TupleDesc tupleDesc,
+								  HeapTuple tuple,
+								  YBCTupleIdSet *upserted);
+
 /*
  * Insert a tuple into the an index's backing YugaByte index table.
  */
@@ -85,10 +107,13 @@ extern void YBCExecuteDeleteIndex(Relation index,
  * If this is a single row op we will return false in the case that there was
  * no row to update. This can occur because we do not first perform a scan if
  * it is a single row op.
+ * If SET expressions were pushed down to DocDB, their results are stored in a
+ * new tuple of tupleSlot (the slot holding tuple).
  */
 extern bool YBCExecuteUpdate(Relation rel,
 							 TupleTableSlot *slot,
 							 HeapTuple tuple,
+							 TupleTableSlot *tupleSlot,
 							 EState *estate,
 							 ModifyTableState *mtstate,
 							 Bitmapset *updatedCols);
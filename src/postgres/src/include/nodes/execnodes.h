@@ -1085,6 +1085,23 @@ typedef struct ModifyTableState
 
 	/* YB specific attributes. */
 	bool yb_mt_is_single_row_update_or_delete;
+
+	/*
+	 * Rows of INSERT ... ON CONFLICT read ahead from the subplan, so that
+	 * their primary keys are checked for conflicts with a batched read.
+	 * yb_oc_batch_size is 0 when conflict checks are not batched.
+	 */
+	int			yb_oc_batch_size;
+	TupleTableSlot **yb_oc_slots;
+	char	  **yb_oc_ybctids;	/* ybctid of each row, NULL if not checked */
+	int64_t    *yb_oc_ybctid_sizes;
+	int			yb_oc_num_rows;
+	int			yb_oc_next_row;
+	bool		yb_oc_subplan_done;
+	MemoryContext yb_oc_context;	/* for ybctids of the current batch */
+	/* ybctid of the row being inserted, NULL if it was not checked */
+	char	   *yb_oc_current_ybctid;
+	int64_t		yb_oc_current_ybctid_size;
 } ModifyTableState;
 
 /* ----------------
@@ -1724,6 +1741,10 @@ typedef struct JoinState
  *		NeedNewOuter	   true if need new outer tuple on next call
  *		MatchedOuter	   true if found a join match for current outer tuple
  *		NullInnerTupleSlot prepared null tuple for left outer joins
+ *
+ *		The yb_batch_* fields are used by YugaByte batched nested loop join,
+ *		that fetches inner tuples for a batch of outer tuples at once, see
+ *		nodeNestloop.c.  yb_batch_size is 0 if the join is not batched.
  * ----------------
  */
 typedef struct NestLoopState
@@ -1732,6 +1753,29 @@ typedef struct NestLoopState
 	bool		nl_NeedNewOuter;
 	bool		nl_MatchedOuter;
 	TupleTableSlot *nl_NullInnerTupleSlot;
+	int			yb_batch_size;	/* max number of outer tuples in a batch */
+	ScanKey		yb_batch_key;	/* inner scan key replaced by array of keys */
+	AttrNumber	yb_batch_outer_attno;	/* key attribute of outer tuples */
+	AttrNumber	yb_batch_inner_attno;	/* key attribute of inner scan tuples */
+	Oid			yb_batch_typid;	/* type of the key */
+	FmgrInfo   *yb_batch_cmp;	/* comparison function of the key type */
+	int16		yb_batch_typlen;
+	bool		yb_batch_typbyval;
+	char		yb_batch_typalign;
+	MemoryContext yb_batch_context;	/* holds tuples of the current batch */
+	MinimalTuple *yb_batch_outer;	/* outer tuples of the batch */
+	int			yb_batch_num_outer;
+	int			yb_batch_outer_idx;	/* next outer tuple to join */
+	bool		yb_batch_outer_done;	/* true if outer plan is exhausted */
+	Datum		yb_batch_outer_key;	/* key of the current outer tuple */
+	bool		yb_batch_outer_key_isnull;
+	struct YbBatchInnerTuple *yb_batch_inner;	/* inner tuples matching the
+												 * batch, sorted by key */
+	int			yb_batch_num_inner;
+	int			yb_batch_inner_capacity;
+	int			yb_batch_inner_idx;	/* next inner tuple to return */
+	TupleTableSlot *yb_batch_outer_slot;
+	TupleTableSlot *yb_batch_inner_slot;
 } NestLoopState;
 
 /* ----------------
@@ -55,8 +55,30 @@
  */
 extern uint64_t yb_catalog_cache_version;
 
+/*
+ * Number of local increments of yb_catalog_cache_version since the last cache
+ * refresh, made for the catalog changes of this backend, that its caches
+ * already reflect. The master versions of these changes are not known for
+ * sure, so incremental cache refreshes fetch the invalidation messages of all
+ * the catalog changes after the version the caches were refreshed to.
+ */
+extern uint64_t yb_catalog_cache_local_increments;
+
 #define YB_CATCACHE_VERSION_UNINITIALIZED (0)
 
+/*
+ * Whether new backends should preload the most used catalog caches (pg_class,
+ * pg_type, pg_attribute, pg_proc, pg_operator, pg_cast) with a few full scans
+ * at connection start, instead of looking up their entries one by one later.
+ */
+extern bool yb_preload_catalog_caches_on_connect;
+
+/*
+ * Whether the planner should push conditions of sequential scans down to DocDB, when DocDB can
+ * evaluate them.
+ */
+extern bool yb_enable_where_pushdown;
+
 /*
  * Checks whether YugaByte functionality is enabled within PostgreSQL.
  * This relies on pgapi being non-NULL, so probably should not be used
@@ -157,6 +179,12 @@ extern void YBOnPostgresBackendShutdown();
  */
 extern void YBCRestartTransaction();
 
+/*
+ * Signals PgTxnManager that a new statement of a READ COMMITTED transaction starts, so it should
+ * pick a new read point.
+ */
+extern void YBCResetTransactionReadPoint();
+
 /*
  * Commits the current YugaByte-level transaction. Returns true in case of
  * successful commit and false in case of failure. If there is no transaction in
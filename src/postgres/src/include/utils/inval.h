@@ -16,6 +16,7 @@
 
 #include "access/htup.h"
 #include "storage/relfilenode.h"
+#include "storage/sinval.h"
 #include "utils/relcache.h"
 
 
@@ -35,6 +36,14 @@ extern void PostPrepare_Inval(void);
 
 extern void CommandEndInvalidationMessages(void);
 
+extern int	YBGetInvalidationMessages(SharedInvalidationMessage **msgs);
+
+extern void YBMarkInvalidationMessagesShipped(void);
+
+extern void YBPreCommit_Inval(void);
+
+extern void YBProcessInvalidationMessages(const char *data, size_t size);
+
 extern void CacheInvalidateHeapTuple(Relation relation,
 						 HeapTuple tuple,
 						 HeapTuple newtuple);
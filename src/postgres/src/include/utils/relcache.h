@@ -92,6 +92,7 @@ extern void RelationCacheInitialize(void);
 extern void RelationCacheInitializePhase2(void);
 extern void RelationCacheInitializePhase3(void);
 
+extern void YBCheckDatabaseIsValid();
 extern void YBPreloadRelCache();
 
 /*
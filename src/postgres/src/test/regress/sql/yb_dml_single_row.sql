@@ -552,3 +552,9 @@ SELECT * FROM single_row_col_order ORDER BY d, b;
 
 DELETE FROM single_row_col_order WHERE b = 2 and d = 4;
 SELECT * FROM single_row_col_order ORDER BY d, b;
+
+-- Test RETURNING of pushed down SET expressions.
+EXPLAIN (COSTS OFF) UPDATE single_row_col_order SET c = c * 2 WHERE b = 3 and d = 5 RETURNING c;
+UPDATE single_row_col_order SET c = c * 2 WHERE b = 3 and d = 5 RETURNING c;
+UPDATE single_row_col_order SET c = c + 1, e = e * 2 WHERE b = 3 and d = 5 RETURNING b, c, d, e;
+SELECT * FROM single_row_col_order ORDER BY d, b;
@@ -0,0 +1,21 @@
+--
+-- LIMIT over YugaByte scans
+--
+CREATE TABLE limit_t1 (k int PRIMARY KEY, v int);
+CREATE TABLE limit_t2 (k int PRIMARY KEY, v int);
+INSERT INTO limit_t1 SELECT i, i % 5 FROM generate_series(1, 100) i;
+INSERT INTO limit_t2 SELECT i, i % 5 FROM generate_series(1, 100) i;
+-- LIMIT directly over the scan.
+SELECT count(*) FROM (SELECT * FROM limit_t1 LIMIT 7) s;
+SELECT count(*) FROM (SELECT * FROM limit_t1 LIMIT 7 OFFSET 95) s;
+SELECT count(*) FROM (SELECT * FROM limit_t1 LIMIT 200) s;
+-- Scans under a join read more rows than the LIMIT.
+SELECT count(*) FROM (SELECT * FROM limit_t1 JOIN limit_t2 ON limit_t1.v = limit_t2.k LIMIT 10) s;
+SELECT count(*) FROM (SELECT * FROM limit_t1 WHERE k IN (SELECT v FROM limit_t2) LIMIT 10) s;
+-- DISTINCT reads more rows than the LIMIT.
+SELECT count(*) FROM (SELECT DISTINCT v FROM limit_t1 LIMIT 10) s;
+-- Filter that is not pushed down reads more rows than the LIMIT.
+SELECT count(*) FROM (SELECT * FROM limit_t1 WHERE v + 1 = 3 LIMIT 5) s;
+SELECT count(*) FROM (SELECT * FROM limit_t1 WHERE v + 1 = 3 LIMIT 50) s;
+DROP TABLE limit_t1;
+DROP TABLE limit_t2;
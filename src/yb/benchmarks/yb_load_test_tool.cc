@@ -102,6 +102,33 @@ DEFINE_bool(
     stop_on_empty_read, true,
     "Stop reading if we get an empty set of rows on a read operation");
 
+DEFINE_double(
+    open_loop_target_ops_per_sec, 0,
+    "If positive, after num_rows rows are written, run the open-loop mode: reads and writes of "
+    "these rows are issued asynchronously with Poisson arrivals at this rate, and latency is "
+    "measured from the intended send time of each operation.");
+
+DEFINE_int32(open_loop_read_percentage, 50,
+             "Percentage of reads among operations of the open-loop mode, the rest are writes.");
+
+DEFINE_double(
+    open_loop_zipf_theta, 0,
+    "Skew of Zipfian key distribution in the open-loop mode, in (0, 1). 0 means uniform "
+    "distribution.");
+
+DEFINE_int32(open_loop_duration_sec, 60, "Duration of the open-loop mode run.");
+
+DEFINE_int32(open_loop_report_interval_ms, 1000,
+             "Interval of throughput and latency percentile reports in the open-loop mode.");
+
+DEFINE_string(
+    open_loop_output_file, "",
+    "CSV file to write the time series of per interval throughput and latency percentiles of "
+    "the open-loop mode to.");
+
+DEFINE_int32(open_loop_max_inflight, 10000,
+             "Maximum number of operations in flight in the open-loop mode.");
+
 using strings::Substitute;
 using std::atomic_long;
 using std::atomic_bool;
@@ -139,6 +166,8 @@ using yb::load_generator::RedisNoopSessionFactory;
 using yb::load_generator::RedisSessionFactory;
 using yb::load_generator::MultiThreadedReader;
 using yb::load_generator::MultiThreadedWriter;
+using yb::load_generator::OpenLoopLoadGenerator;
+using yb::load_generator::OpenLoopOptions;
 using yb::load_generator::SingleThreadedScanner;
 using yb::load_generator::FormatHexForLoadTestKey;
 
@@ -150,6 +179,9 @@ void CreateYBTable(const YBTableName &table_name, YBClient* client);
 
 void LaunchYBLoadTest(SessionFactory *session_factory);
 
+void LaunchOpenLoopLoadTest(
+    YBClient* client, yb::client::TableHandle* table, SessionFactory* session_factory);
+
 std::unique_ptr<YBClient> CreateYBClient();
 
 void SetupYBTable(YBClient* client);
@@ -197,6 +229,9 @@ int main(int argc, char *argv[]) {
         // Noop operations are done as write operations.
         FLAGS_writes_only = true;
         LaunchYBLoadTest(&session_factory);
+      } else if (FLAGS_open_loop_target_ops_per_sec > 0) {
+        YBSessionFactory session_factory(client.get(), &table);
+        LaunchOpenLoopLoadTest(client.get(), &table, &session_factory);
       } else {
         YBSessionFactory session_factory(client.get(), &table);
         LaunchYBLoadTest(&session_factory);
@@ -364,3 +399,29 @@ void LaunchYBLoadTest(SessionFactory *session_factory) {
     reader.WaitForCompletion();
   }
 }
+
+void LaunchOpenLoopLoadTest(
+    YBClient* client, yb::client::TableHandle* table, SessionFactory* session_factory) {
+  atomic_bool stop_flag(false);
+  // Open-loop operations use the keys of this load, so reads find the rows.
+  LOG(INFO) << "Writing " << FLAGS_num_rows << " rows before the open-loop run";
+  MultiThreadedWriter writer(
+      FLAGS_num_rows, 0, FLAGS_num_writer_threads, session_factory, &stop_flag,
+      FLAGS_value_size_bytes, FLAGS_max_num_write_errors);
+  writer.Start();
+  writer.WaitForCompletion();
+
+  OpenLoopOptions options;
+  options.target_ops_per_sec = FLAGS_open_loop_target_ops_per_sec;
+  options.read_percentage = FLAGS_open_loop_read_percentage;
+  options.zipf_theta = FLAGS_open_loop_zipf_theta;
+  options.duration = MonoDelta::FromSeconds(FLAGS_open_loop_duration_sec);
+  options.report_interval = MonoDelta::FromMilliseconds(FLAGS_open_loop_report_interval_ms);
+  options.output_file = FLAGS_open_loop_output_file;
+  options.max_inflight = FLAGS_open_loop_max_inflight;
+  OpenLoopLoadGenerator generator(
+      FLAGS_num_rows, client, table, session_factory->ClientId(), &stop_flag,
+      FLAGS_value_size_bytes, options);
+  generator.Start();
+  generator.WaitForCompletion();
+}
@@ -0,0 +1,500 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// Transactional benchmark driver, that runs YCSB-like and TPC-C-like transaction mixes using
+// YBClient and YBTransaction directly, i.e. without a SQL layer. Outcomes of transactions are
+// reported separately: commits, write conflicts, aborts, read restarts and other errors.
+
+#include <atomic>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include "yb/client/client.h"
+#include "yb/client/error.h"
+#include "yb/client/session.h"
+#include "yb/client/table_handle.h"
+#include "yb/client/transaction.h"
+#include "yb/client/transaction_manager.h"
+#include "yb/client/yb_op.h"
+
+#include "yb/common/ql_value.h"
+#include "yb/common/transaction_error.h"
+
+#include "yb/integration-tests/load_generator.h"
+
+#include "yb/server/hybrid_clock.h"
+
+#include "yb/util/flags.h"
+#include "yb/util/format.h"
+#include "yb/util/hdr_histogram.h"
+#include "yb/util/logging.h"
+#include "yb/util/physical_time.h"
+#include "yb/util/thread.h"
+
+DEFINE_string(txn_bench_master_addresses, "",
+              "Addresses of masters for the cluster to operate on.");
+DEFINE_string(txn_bench_keyspace, "txn_bench", "Keyspace of the benchmark table.");
+DEFINE_string(txn_bench_table_name, "txn_bench", "Name of the benchmark table.");
+DEFINE_int32(txn_bench_num_tablets, 16, "Number of tablets of the benchmark table.");
+DEFINE_bool(txn_bench_drop_table, false, "Drop the benchmark table, if it exists.");
+DEFINE_string(txn_bench_workload, "ycsb", "Transaction mix to run: ycsb or tpcc.");
+DEFINE_string(txn_bench_isolation, "snapshot",
+              "Isolation level of transactions: snapshot or serializable.");
+DEFINE_int32(txn_bench_num_threads, 16, "Number of concurrently running transactions.");
+DEFINE_int32(txn_bench_duration_sec, 60, "Duration of the run.");
+DEFINE_int32(txn_bench_report_interval_sec, 5, "Interval of reports.");
+DEFINE_int32(txn_bench_rpc_timeout_sec, 30, "Timeout of client operations.");
+
+DEFINE_int64(ycsb_num_keys, 100000, "Number of keys in the ycsb workload.");
+DEFINE_int32(ycsb_ops_per_txn, 4, "Number of operations per transaction in the ycsb workload.");
+DEFINE_int32(ycsb_read_percentage, 50,
+             "Percentage of reads among operations of the ycsb workload, the rest are writes.");
+DEFINE_double(ycsb_zipf_theta, 0.99,
+              "Skew of Zipfian key distribution of the ycsb workload, in (0, 1). 0 means uniform "
+              "distribution.");
+
+DEFINE_int32(tpcc_warehouses, 10,
+             "Number of warehouses in the tpcc workload. Each has 10 districts with 3000 "
+             "customers each, and stock of 100000 items.");
+
+namespace yb {
+namespace {
+
+constexpr uint64_t kMaxTrackedLatencyUs = 120 * 1000 * 1000;
+constexpr int kLatencySignificantDigits = 3;
+const std::string kKeyColumn = "k";
+const std::string kValueColumn = "v";
+
+struct TransactionStats {
+  std::atomic<int64_t> committed{0};
+  std::atomic<int64_t> conflicts{0};
+  std::atomic<int64_t> aborted{0};
+  std::atomic<int64_t> read_restarts{0};
+  std::atomic<int64_t> errors{0};
+  // Latency of committed transactions, including read restarts.
+  HdrHistogram latencies{kMaxTrackedLatencyUs, kLatencySignificantDigits};
+  // Latencies since the last report.
+  HdrHistogram interval_latencies{kMaxTrackedLatencyUs, kLatencySignificantDigits};
+};
+
+// Reads and writes of int64 values by string keys in the session of the current transaction.
+// Writes are buffered until Flush or the next read.
+class TransactionSession {
+ public:
+  TransactionSession(client::TableHandle* table, client::YBSessionPtr session)
+      : table_(table), session_(std::move(session)) {
+  }
+
+  void SetTransaction(client::YBTransactionPtr transaction) {
+    session_->SetTransaction(std::move(transaction));
+  }
+
+  // Returns 0 for a missing row.
+  Result<int64_t> Read(const std::string& key) {
+    auto op = table_->NewReadOp();
+    auto* const req = op->mutable_request();
+    QLAddStringHashValue(req, key);
+    table_->AddColumns({kValueColumn}, req);
+    RETURN_NOT_OK(session_->Apply(op));
+    RETURN_NOT_OK(Flush());
+    RETURN_NOT_OK(CheckResponse(*op));
+    auto rowblock = VERIFY_RESULT(op->MakeRowBlock());
+    if (rowblock.row_count() == 0 || rowblock.row(0).column(0).IsNull()) {
+      return 0;
+    }
+    return rowblock.row(0).column(0).int64_value();
+  }
+
+  CHECKED_STATUS Write(const std::string& key, int64_t value) {
+    auto op = table_->NewInsertOp();
+    auto* const req = op->mutable_request();
+    QLAddStringHashValue(req, key);
+    table_->AddInt64ColumnValue(req, kValueColumn, value);
+    RETURN_NOT_OK(session_->Apply(op));
+    pending_writes_.push_back(std::move(op));
+    return Status::OK();
+  }
+
+  // Flushes buffered operations. Returns the status of the first failed operation, so that its
+  // transaction error code, e.g. conflict, is preserved.
+  CHECKED_STATUS Flush() {
+    auto status = session_->Flush();
+    auto writes = std::move(pending_writes_);
+    pending_writes_.clear();
+    if (!status.ok()) {
+      for (const auto& error : session_->GetPendingErrors()) {
+        return error->status();
+      }
+      return status;
+    }
+    for (const auto& write : writes) {
+      RETURN_NOT_OK(CheckResponse(*write));
+    }
+    return Status::OK();
+  }
+
+  void Abort() {
+    session_->Abort();
+    session_->GetPendingErrors();
+    pending_writes_.clear();
+  }
+
+ private:
+  static CHECKED_STATUS CheckResponse(const client::YBqlOp& op) {
+    if (op.response().status() == QLResponsePB::YQL_STATUS_OK) {
+      return Status::OK();
+    }
+    return STATUS_FORMAT(
+        QLError, "$0: $1", QLResponsePB::QLStatus_Name(op.response().status()),
+        op.response().error_message());
+  }
+
+  client::TableHandle* const table_;
+  const client::YBSessionPtr session_;
+  std::vector<client::YBqlWriteOpPtr> pending_writes_;
+};
+
+typedef std::mt19937_64 RandomGenerator;
+
+class Workload {
+ public:
+  virtual ~Workload() = default;
+
+  // Executes reads and writes of a single transaction, the caller commits it.
+  virtual CHECKED_STATUS Execute(TransactionSession* session, RandomGenerator* random) = 0;
+};
+
+// Transactions of ycsb_ops_per_txn reads or blind updates of keys with Zipfian distribution.
+class YcsbWorkload : public Workload {
+ public:
+  YcsbWorkload() {
+    if (FLAGS_ycsb_zipf_theta > 0) {
+      zipfian_ = std::make_unique<load_generator::ZipfianGenerator>(
+          FLAGS_ycsb_num_keys, FLAGS_ycsb_zipf_theta);
+    }
+  }
+
+  CHECKED_STATUS Execute(TransactionSession* session, RandomGenerator* random) override {
+    std::uniform_int_distribution<int64_t> uniform_key(0, FLAGS_ycsb_num_keys - 1);
+    for (int i = 0; i != FLAGS_ycsb_ops_per_txn; ++i) {
+      const auto key_index = zipfian_ ? zipfian_->Next(random) : uniform_key(*random);
+      const auto key = Format("ycsb_$0", key_index);
+      if (static_cast<int>((*random)() % 100) < FLAGS_ycsb_read_percentage) {
+        RETURN_NOT_OK(session->Read(key));
+      } else {
+        RETURN_NOT_OK(session->Write(key, (*random)() >> 1));
+      }
+    }
+    return session->Flush();
+  }
+
+ private:
+  std::unique_ptr<load_generator::ZipfianGenerator> zipfian_;
+};
+
+// Simplified TPC-C mix of NewOrder (45%), Payment (43%) and read-only OrderStatus (12%)
+// transactions. District order counters and warehouse balances are hot rows, as in TPC-C.
+class TpccWorkload : public Workload {
+ public:
+  CHECKED_STATUS Execute(TransactionSession* session, RandomGenerator* random) override {
+    const auto warehouse = Uniform(random, 0, FLAGS_tpcc_warehouses - 1);
+    const auto district = Uniform(random, 0, kDistrictsPerWarehouse - 1);
+    const auto kind = Uniform(random, 0, 99);
+    if (kind < 45) {
+      return NewOrder(session, random, warehouse, district);
+    }
+    const auto customer = Uniform(random, 0, kCustomersPerDistrict - 1);
+    if (kind < 88) {
+      return Payment(session, random, warehouse, district, customer);
+    }
+    return OrderStatus(session, warehouse, district, customer);
+  }
+
+ private:
+  static constexpr int kDistrictsPerWarehouse = 10;
+  static constexpr int kCustomersPerDistrict = 3000;
+  static constexpr int kItems = 100000;
+
+  static int64_t Uniform(RandomGenerator* random, int64_t min, int64_t max) {
+    return std::uniform_int_distribution<int64_t>(min, max)(*random);
+  }
+
+  static std::string DistrictKey(int64_t warehouse, int64_t district, const char* field) {
+    return Format("d_$0_$1_$2", warehouse, district, field);
+  }
+
+  static std::string CustomerKey(int64_t warehouse, int64_t district, int64_t customer) {
+    return Format("c_$0_$1_$2", warehouse, district, customer);
+  }
+
+  CHECKED_STATUS NewOrder(
+      TransactionSession* session, RandomGenerator* random, int64_t warehouse,
+      int64_t district) {
+    const auto next_order_key = DistrictKey(warehouse, district, "next_o_id");
+    const auto order_id = VERIFY_RESULT(session->Read(next_order_key));
+    RETURN_NOT_OK(session->Write(next_order_key, order_id + 1));
+    const auto num_lines = Uniform(random, 5, 15);
+    for (int64_t line = 0; line != num_lines; ++line) {
+      const auto item = Uniform(random, 0, kItems - 1);
+      const auto stock_key = Format("s_$0_$1", warehouse, item);
+      const auto quantity = VERIFY_RESULT(session->Read(stock_key));
+      RETURN_NOT_OK(session->Write(stock_key, quantity - Uniform(random, 1, 10)));
+      RETURN_NOT_OK(session->Write(
+          Format("ol_$0_$1_$2_$3", warehouse, district, order_id, line), item));
+    }
+    return session->Flush();
+  }
+
+  CHECKED_STATUS Payment(
+      TransactionSession* session, RandomGenerator* random, int64_t warehouse, int64_t district,
+      int64_t customer) {
+    const auto amount = Uniform(random, 1, 5000);
+    const auto warehouse_key = Format("w_$0_ytd", warehouse);
+    const auto district_key = DistrictKey(warehouse, district, "ytd");
+    const auto customer_key = CustomerKey(warehouse, district, customer);
+    for (const auto& key : {warehouse_key, district_key}) {
+      const auto ytd = VERIFY_RESULT(session->Read(key));
+      RETURN_NOT_OK(session->Write(key, ytd + amount));
+    }
+    const auto balance = VERIFY_RESULT(session->Read(customer_key));
+    RETURN_NOT_OK(session->Write(customer_key, balance - amount));
+    return session->Flush();
+  }
+
+  CHECKED_STATUS OrderStatus(
+      TransactionSession* session, int64_t warehouse, int64_t district, int64_t customer) {
+    RETURN_NOT_OK(session->Read(CustomerKey(warehouse, district, customer)));
+    const auto order_id = VERIFY_RESULT(session->Read(
+        DistrictKey(warehouse, district, "next_o_id")));
+    if (order_id > 0) {
+      RETURN_NOT_OK(session->Read(Format("ol_$0_$1_$2_0", warehouse, district, order_id - 1)));
+    }
+    return Status::OK();
+  }
+};
+
+class TransactionBench {
+ public:
+  TransactionBench() = default;
+
+  CHECKED_STATUS Run() {
+    std::unique_ptr<Workload> workload;
+    if (FLAGS_txn_bench_workload == "ycsb") {
+      workload = std::make_unique<YcsbWorkload>();
+    } else if (FLAGS_txn_bench_workload == "tpcc") {
+      workload = std::make_unique<TpccWorkload>();
+    } else {
+      return STATUS_FORMAT(InvalidArgument, "Unknown workload: $0", FLAGS_txn_bench_workload);
+    }
+    if (FLAGS_txn_bench_isolation == "snapshot") {
+      isolation_ = IsolationLevel::SNAPSHOT_ISOLATION;
+    } else if (FLAGS_txn_bench_isolation == "serializable") {
+      isolation_ = IsolationLevel::SERIALIZABLE_ISOLATION;
+    } else {
+      return STATUS_FORMAT(InvalidArgument, "Unknown isolation: $0", FLAGS_txn_bench_isolation);
+    }
+
+    client_ = VERIFY_RESULT(client::YBClientBuilder()
+        .add_master_server_addr(FLAGS_txn_bench_master_addresses)
+        .default_rpc_timeout(MonoDelta::FromSeconds(FLAGS_txn_bench_rpc_timeout_sec))
+        .Build());
+    RETURN_NOT_OK(SetupTable());
+
+    server::ClockPtr clock(new server::HybridClock(WallClock()));
+    RETURN_NOT_OK(clock->Init());
+    transaction_manager_ = std::make_unique<client::TransactionManager>(
+        client_.get(), clock, client::LocalTabletFilter());
+
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> threads;
+    for (int i = 0; i != FLAGS_txn_bench_num_threads; ++i) {
+      threads.emplace_back([this, &stop, workload = workload.get()] {
+        CDSAttacher attacher;
+        RunWorker(workload, &stop);
+      });
+    }
+    const auto start = MonoTime::Now();
+    ReportUntil(start, MonoDelta::FromSeconds(FLAGS_txn_bench_duration_sec));
+    stop.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    ReportSummary((MonoTime::Now() - start).ToSeconds());
+    return Status::OK();
+  }
+
+ private:
+  CHECKED_STATUS SetupTable() {
+    const client::YBTableName table_name(
+        YQL_DATABASE_CQL, FLAGS_txn_bench_keyspace, FLAGS_txn_bench_table_name);
+    RETURN_NOT_OK(client_->CreateNamespaceIfNotExists(table_name.namespace_name(),
+                                                      table_name.namespace_type()));
+    if (table_.Open(table_name, client_.get()).ok()) {
+      if (!FLAGS_txn_bench_drop_table) {
+        LOG(INFO) << "Using existing table " << table_name.ToString();
+        return Status::OK();
+      }
+      LOG(INFO) << "Dropping table " << table_name.ToString();
+      RETURN_NOT_OK(client_->DeleteTable(table_name));
+    }
+
+    client::YBSchemaBuilder builder;
+    builder.AddColumn(kKeyColumn)->Type(STRING)->HashPrimaryKey()->NotNull();
+    builder.AddColumn(kValueColumn)->Type(INT64);
+    TableProperties table_properties;
+    table_properties.SetTransactional(true);
+    builder.SetTableProperties(table_properties);
+    LOG(INFO) << "Creating table " << table_name.ToString();
+    return table_.Create(table_name, FLAGS_txn_bench_num_tablets, client_.get(), &builder);
+  }
+
+  void RunWorker(Workload* workload, std::atomic<bool>* stop) {
+    RandomGenerator random(std::random_device{}());
+    auto yb_session = client_->NewSession();
+    yb_session->SetTimeout(MonoDelta::FromSeconds(FLAGS_txn_bench_rpc_timeout_sec));
+    TransactionSession session(&table_, yb_session);
+    while (!stop->load(std::memory_order_acquire)) {
+      const auto start = MonoTime::Now();
+      auto transaction = std::make_shared<client::YBTransaction>(transaction_manager_.get());
+      auto status = transaction->Init(isolation_);
+      for (;;) {
+        bool commit_attempted = false;
+        if (status.ok()) {
+          session.SetTransaction(transaction);
+          status = workload->Execute(&session, &random);
+        }
+        if (status.ok()) {
+          commit_attempted = true;
+          status = transaction->CommitFuture().get();
+        }
+        if (status.ok()) {
+          const auto latency_us = std::min<uint64_t>(
+              (MonoTime::Now() - start).ToMicroseconds(), kMaxTrackedLatencyUs);
+          stats_.latencies.Increment(latency_us);
+          stats_.interval_latencies.Increment(latency_us);
+          stats_.committed.fetch_add(1, std::memory_order_acq_rel);
+          break;
+        }
+        session.Abort();
+        if (!commit_attempted && transaction->IsRestartRequired()) {
+          stats_.read_restarts.fetch_add(1, std::memory_order_acq_rel);
+          auto restarted = transaction->CreateRestartedTransaction();
+          if (restarted.ok()) {
+            transaction = std::move(*restarted);
+            status = Status::OK();
+            continue;
+          }
+          status = restarted.status();
+        }
+        AccountFailure(status);
+        if (!commit_attempted) {
+          transaction->Abort();
+        }
+        break;
+      }
+    }
+    session.SetTransaction(nullptr);
+  }
+
+  void AccountFailure(const Status& status) {
+    const auto code = TransactionError(status).value();
+    if (code == TransactionErrorCode::kConflict) {
+      stats_.conflicts.fetch_add(1, std::memory_order_acq_rel);
+    } else if (code == TransactionErrorCode::kAborted || status.IsExpired()) {
+      stats_.aborted.fetch_add(1, std::memory_order_acq_rel);
+    } else {
+      stats_.errors.fetch_add(1, std::memory_order_acq_rel);
+      YB_LOG_EVERY_N_SECS(WARNING, 5) << "Transaction failed: " << status;
+    }
+  }
+
+  void ReportUntil(MonoTime start, MonoDelta duration) {
+    const auto interval = MonoDelta::FromSeconds(FLAGS_txn_bench_report_interval_sec);
+    MonoTime end = start;
+    end += duration;
+    auto prev_time = start;
+    int64_t prev_committed = 0;
+    for (;;) {
+      const auto now = MonoTime::Now();
+      if (now >= end) {
+        break;
+      }
+      SleepFor(std::min(interval, end - now));
+      const auto report_time = MonoTime::Now();
+      // Non-consistent snapshot, transactions committed between the snapshot and the reset are
+      // lost for the interval.
+      HdrHistogram latencies(stats_.interval_latencies);
+      stats_.interval_latencies.ResetPercentiles();
+      const auto committed = stats_.committed.load(std::memory_order_acquire);
+      LOG(INFO) << Format(
+          "Commits: $0 ($1/s), conflicts: $2, aborts: $3, read restarts: $4, errors: $5, "
+          "latency p50: $6 us, p99: $7 us, p99.9: $8 us",
+          committed, (committed - prev_committed) / (report_time - prev_time).ToSeconds(),
+          stats_.conflicts.load(), stats_.aborted.load(), stats_.read_restarts.load(),
+          stats_.errors.load(), latencies.ValueAtPercentile(50), latencies.ValueAtPercentile(99),
+          latencies.ValueAtPercentile(99.9));
+      prev_time = report_time;
+      prev_committed = committed;
+    }
+  }
+
+  void ReportSummary(double elapsed_sec) {
+    const auto committed = stats_.committed.load();
+    const auto conflicts = stats_.conflicts.load();
+    const auto aborted = stats_.aborted.load();
+    const auto errors = stats_.errors.load();
+    const auto finished = std::max<int64_t>(committed + conflicts + aborted + errors, 1);
+    LOG(INFO) << Format(
+        "Workload $0, isolation $1, $2 threads, $3 sec", FLAGS_txn_bench_workload,
+        FLAGS_txn_bench_isolation, FLAGS_txn_bench_num_threads, elapsed_sec);
+    LOG(INFO) << Format(
+        "Committed: $0 ($1/s, $2%), conflicts: $3 ($4%), aborted: $5 ($6%), errors: $7, "
+        "read restarts: $8",
+        committed, committed / elapsed_sec, committed * 100.0 / finished, conflicts,
+        conflicts * 100.0 / finished, aborted, aborted * 100.0 / finished, errors,
+        stats_.read_restarts.load());
+    LOG(INFO) << Format(
+        "Commit latency p50: $0 us, p90: $1 us, p99: $2 us, p99.9: $3 us, max: $4 us",
+        stats_.latencies.ValueAtPercentile(50), stats_.latencies.ValueAtPercentile(90),
+        stats_.latencies.ValueAtPercentile(99), stats_.latencies.ValueAtPercentile(99.9),
+        stats_.latencies.MaxValue());
+  }
+
+  IsolationLevel isolation_ = IsolationLevel::SNAPSHOT_ISOLATION;
+  std::unique_ptr<client::YBClient> client_;
+  client::TableHandle table_;
+  std::unique_ptr<client::TransactionManager> transaction_manager_;
+  TransactionStats stats_;
+};
+
+} // namespace
+} // namespace yb
+
+int main(int argc, char** argv) {
+  yb::ParseCommandLineFlags(&argc, &argv, true);
+  yb::InitGoogleLoggingSafe(argv[0]);
+  if (FLAGS_txn_bench_master_addresses.empty()) {
+    LOG(FATAL) << "Need to specify --txn_bench_master_addresses";
+  }
+  yb::TransactionBench bench;
+  auto status = bench.Run();
+  if (!status.ok()) {
+    LOG(ERROR) << "Benchmark failed: " << status;
+    return 1;
+  }
+  return 0;
+}
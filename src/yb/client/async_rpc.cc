@@ -11,6 +11,8 @@
 // under the License.
 //
 
+#include <mutex>
+
 #include "yb/client/async_rpc.h"
 #include "yb/client/batcher.h"
 #include "yb/client/client.h"
@@ -26,9 +28,12 @@
 #include "yb/common/wire_protocol.h"
 
 #include "yb/gutil/strings/substitute.h"
+#include "yb/rpc/messenger.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/cast.h"
 #include "yb/util/debug-util.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/yb_pg_errcodes.h"
 
@@ -52,6 +57,7 @@ METRIC_DEFINE_histogram(
     "Microseconds spent before sending the request to the server", 60000000LU, 2);
 DECLARE_bool(rpc_dump_all_traces);
 DECLARE_bool(collect_end_to_end_traces);
+DECLARE_bool(hedged_reads);
 
 DEFINE_bool(forward_redis_requests, true, "If false, the redis op will not be served if it's not "
             "a local request. The op response will be set to the redis error "
@@ -63,7 +69,14 @@ DEFINE_bool(detect_duplicates_for_retryable_requests, true,
             "Enable tracking of write requests that prevents the same write from being applied "
                 "twice.");
 
+DEFINE_bool(enable_multi_write_batching, false,
+            "Send write RPCs of a single flush, that are addressed to different tablets of the "
+            "same tablet server, in a single MultiWrite RPC.");
+TAG_FLAG(enable_multi_write_batching, advanced);
+TAG_FLAG(enable_multi_write_batching, runtime);
+
 DEFINE_CAPABILITY(PickReadTimeAtTabletServer, 0x8284d67b);
+DEFINE_CAPABILITY(MultiWrite, 0x3f6e1a95);
 
 using namespace std::placeholders;
 
@@ -123,8 +136,10 @@ AsyncRpc::AsyncRpc(AsyncRpcData* data, YBConsistencyLevel yb_consistency_level)
   mutable_retrier()->mutable_controller()->set_allow_local_calls_in_curr_thread(
       data->allow_local_calls_in_curr_thread);
   if (Trace::CurrentTrace()) {
-    Trace::CurrentTrace()->AddChildTrace(trace_.get());
+    Trace::CurrentTrace()->AddChildTrace(trace_.get(), "AsyncRpc");
   }
+  // Client requests to tablets start sampled distributed traces, unless already a part of one.
+  trace_->MaybeStartRootSpan("AsyncRpc");
 }
 
 AsyncRpc::~AsyncRpc() {
@@ -164,13 +179,18 @@ const YBTable* AsyncRpc::table() const {
 void AsyncRpc::Finished(const Status& status) {
   Status new_status = status;
   if (tablet_invoker_.Done(&new_status)) {
-    ProcessResponseFromTserver(new_status);
-    batcher_->RemoveInFlightOpsAfterFlushing(ops_, new_status, MakeFlushExtraResult());
-    batcher_->CheckForFinishedFlush();
-    retained_self_.reset();
+    Completed(new_status);
   }
 }
 
+void AsyncRpc::Completed(const Status& status) {
+  ProcessResponseFromTserver(status);
+  trace_->EndSpan();
+  batcher_->RemoveInFlightOpsAfterFlushing(ops_, status, MakeFlushExtraResult());
+  batcher_->CheckForFinishedFlush();
+  retained_self_.reset();
+}
+
 void AsyncRpc::Failed(const Status& status) {
   std::string error_message = status.message().ToBuffer();
   auto redis_error_code = status.IsInvalidCommand() || status.IsInvalidArgument() ?
@@ -424,6 +444,17 @@ WriteRpc::~WriteRpc() {
 }
 
 void WriteRpc::CallRemoteMethod() {
+  batch_controller_.reset();
+  auto* collector = MultiWriteCollector::Current();
+  if (collector && num_attempts() == 1 && !IsLocalCall() &&
+      tablet_invoker_.current_ts().HasCapability(CAPABILITY_MultiWrite)) {
+    collector->Add(this);
+    return;
+  }
+  SendSeparately();
+}
+
+void WriteRpc::SendSeparately() {
   auto trace = trace_; // It is possible that we receive reply before returning from WriteAsync.
                        // Since send happens before we return from WriteAsync.
                        // So under heavy load it is possible that our request is handled and
@@ -504,8 +535,7 @@ void WriteRpc::SwapRequestsAndResponses(bool skip_responses = false) {
         ql_op->mutable_response()->Swap(resp_.mutable_ql_response_batch(ql_idx));
         const auto& ql_response = ql_op->response();
         if (ql_response.has_rows_data_sidecar()) {
-          Slice rows_data = CHECK_RESULT(
-              retrier().controller().GetSidecar(ql_response.rows_data_sidecar()));
+          Slice rows_data = CHECK_RESULT(GetSidecar(ql_response.rows_data_sidecar()));
           ql_op->mutable_rows_data()->assign(rows_data.cdata(), rows_data.size());
         }
         ql_idx++;
@@ -521,8 +551,7 @@ void WriteRpc::SwapRequestsAndResponses(bool skip_responses = false) {
         pgsql_op->mutable_response()->Swap(resp_.mutable_pgsql_response_batch(pgsql_idx));
         const auto& pgsql_response = pgsql_op->response();
         if (pgsql_response.has_rows_data_sidecar()) {
-          Slice rows_data = CHECK_RESULT(retrier().controller().GetSidecar(
-              pgsql_response.rows_data_sidecar()));
+          Slice rows_data = CHECK_RESULT(GetSidecar(pgsql_response.rows_data_sidecar()));
           down_cast<YBPgsqlWriteOp*>(yb_op)->mutable_rows_data()->assign(
               util::to_char_ptr(rows_data.data()), rows_data.size());
         }
@@ -569,11 +598,133 @@ void WriteRpc::ProcessResponseFromTserver(const Status& status) {
   SwapRequestsAndResponses(false);
 }
 
+Result<Slice> WriteRpc::GetSidecar(int idx) const {
+  if (batch_controller_) {
+    return batch_controller_->GetSidecar(idx);
+  }
+  return retrier().controller().GetSidecar(idx);
+}
+
+namespace {
+
+thread_local MultiWriteCollector* current_multi_write_collector = nullptr;
+
+} // namespace
+
+struct MultiWriteCollector::Batch {
+  tserver::MultiWriteRequestPB request;
+  tserver::MultiWriteResponsePB response;
+  rpc::RpcController controller;
+  std::vector<WriteRpc*> rpcs;
+};
+
+MultiWriteCollector::MultiWriteCollector()
+    : previous_(current_multi_write_collector),
+      active_(GetAtomicFlag(&FLAGS_enable_multi_write_batching)) {
+  if (active_) {
+    current_multi_write_collector = this;
+  }
+}
+
+MultiWriteCollector::~MultiWriteCollector() {
+  Flush();
+}
+
+MultiWriteCollector* MultiWriteCollector::Current() {
+  return current_multi_write_collector;
+}
+
+void MultiWriteCollector::Add(WriteRpc* rpc) {
+  auto proxy = rpc->tablet_invoker_.proxy();
+  for (auto& group : groups_) {
+    if (group.first == proxy) {
+      group.second.push_back(rpc);
+      return;
+    }
+  }
+  groups_.emplace_back(std::move(proxy), std::vector<WriteRpc*>{rpc});
+}
+
+void MultiWriteCollector::Flush() {
+  if (!active_) {
+    return;
+  }
+  // Writes sent while flushing, for instance retries of writes that failed inline, should not be
+  // collected anymore.
+  active_ = false;
+  current_multi_write_collector = previous_;
+
+  auto groups = std::move(groups_);
+  groups_.clear();
+  for (auto& group : groups) {
+    if (group.second.size() == 1) {
+      group.second.front()->SendSeparately();
+    } else {
+      SendBatch(group.first, std::move(group.second));
+    }
+  }
+}
+
+void MultiWriteCollector::SendBatch(
+    const std::shared_ptr<tserver::TabletServerServiceProxy>& proxy, std::vector<WriteRpc*> rpcs) {
+  auto batch = std::make_shared<Batch>();
+  // All writes of the flush have the same deadline, so the timeout of the first one is used for
+  // the whole batch.
+  batch->controller.set_timeout(rpcs.front()->PrepareController()->timeout());
+  for (auto* rpc : rpcs) {
+    TRACE_TO(rpc->trace_, "Added to MultiWrite batch of $0 writes", rpcs.size());
+    batch->request.add_write_request()->Swap(&rpc->req_);
+  }
+  batch->rpcs = std::move(rpcs);
+  proxy->MultiWriteAsync(
+      batch->request, &batch->response, &batch->controller,
+      std::bind(&MultiWriteCollector::ProcessResponse, batch));
+}
+
+void MultiWriteCollector::ProcessResponse(const std::shared_ptr<Batch>& batch) {
+  auto status = batch->controller.status();
+  auto& response = batch->response;
+  if (status.ok() && response.has_error()) {
+    status = StatusFromPB(response.error().status());
+  }
+  if (status.ok() &&
+      static_cast<size_t>(response.write_response_size()) != batch->rpcs.size()) {
+    status = STATUS_FORMAT(
+        IllegalState, "Wrong number of MultiWrite responses: $0, while $1 expected",
+        response.write_response_size(), batch->rpcs.size());
+  }
+  if (!status.ok()) {
+    LOG(WARNING) << "MultiWrite of " << batch->rpcs.size() << " writes failed: " << status
+                 << ", sending them separately";
+  }
+
+  std::shared_ptr<const rpc::RpcController> controller(batch, &batch->controller);
+  for (size_t i = 0; i != batch->rpcs.size(); ++i) {
+    auto* rpc = batch->rpcs[i];
+    rpc->req_.Swap(batch->request.mutable_write_request(static_cast<int>(i)));
+    if (!status.ok()) {
+      // Writes carry retryable request ids, so resending them separately is safe even if the
+      // server has applied some of them, and failures are handled by the usual retry logic.
+      rpc->SendSeparately();
+      continue;
+    }
+    rpc->resp_.Swap(response.mutable_write_response(static_cast<int>(i)));
+    rpc->batch_controller_ = controller;
+    rpc->Finished(Status::OK());
+  }
+}
+
 ReadRpc::ReadRpc(AsyncRpcData* data, YBConsistencyLevel yb_consistency_level)
     : AsyncRpcBase(data, yb_consistency_level) {
   TRACE_TO(trace_, "ReadRpc initiated to $0", data->tablet->tablet_id());
   req_.set_consistency_level(yb_consistency_level);
   req_.set_proxy_uuid(data->batcher->proxy_uuid());
+  auto max_staleness = data->batcher->follower_read_max_staleness();
+  if (yb_consistency_level == YBConsistencyLevel::CONSISTENT_PREFIX &&
+      max_staleness.Initialized()) {
+    req_.set_max_staleness_ms(max_staleness.ToMilliseconds());
+    tablet_invoker_.set_bounded_staleness(true);
+  }
 
   int ctr = 0;
   for (auto& op : ops_) {
@@ -644,12 +795,123 @@ void ReadRpc::CallRemoteMethod() {
   TRACE_TO(trace, "SendRpcToTserver");
   ADOPT_TRACE(trace.get());
 
-  tablet_invoker_.proxy()->ReadAsync(
-      req_, &resp_, PrepareController(),
-      std::bind(&ReadRpc::Finished, this, Status::OK()));
+  if (FLAGS_hedged_reads && tablet_invoker_.CanHedge(num_attempts())) {
+    CallRemoteMethodWithHedging();
+  } else {
+    tablet_invoker_.proxy()->ReadAsync(
+        req_, &resp_, PrepareController(),
+        std::bind(&ReadRpc::Finished, this, Status::OK()));
+  }
   TRACE_TO(trace, "RpcDispatched Asynchronously");
 }
 
+// State of a read that could be hedged. It is shared by callbacks of the calls, since RPC calls
+// could not be cancelled, so the call that lost the race still finishes into its own buffers.
+struct ReadRpc::HedgedCall {
+  enum class State {
+    kPrimaryOnly,
+    kHedged,
+    kDone,
+  };
+
+  std::mutex mutex;
+  State state = State::kPrimaryOnly;
+  MonoTime start;
+  tserver::ReadResponsePB primary_resp;
+
+  RemoteTabletServer* hedge_ts = nullptr;
+  tserver::ReadRequestPB hedge_req;
+  tserver::ReadResponsePB hedge_resp;
+  rpc::RpcController hedge_controller;
+};
+
+void ReadRpc::CallRemoteMethodWithHedging() {
+  auto& policy = table()->hedged_read_policy();
+  policy.ReadStarted();
+  auto call = std::make_shared<HedgedCall>();
+  call->start = MonoTime::Now();
+  // Callbacks keep this RPC alive until both calls finish, even when it was already completed.
+  auto self = std::static_pointer_cast<ReadRpc>(shared_from_this());
+  auto delay = policy.HedgeDelay();
+  tablet_invoker_.proxy()->ReadAsync(
+      req_, &call->primary_resp, PrepareController(), [self, call] {
+    self->PrimaryFinished(call);
+  });
+  if (!delay.Initialized()) {
+    return;
+  }
+  retrier().messenger()->scheduler().Schedule([self, call](const Status& status) {
+    if (status.ok()) {
+      self->SendHedge(call);
+    }
+  }, delay.ToSteadyDuration());
+}
+
+void ReadRpc::SendHedge(const std::shared_ptr<HedgedCall>& call) {
+  {
+    std::lock_guard<std::mutex> lock(call->mutex);
+    if (call->state != HedgedCall::State::kPrimaryOnly) {
+      return;
+    }
+    call->hedge_ts = tablet_invoker_.SelectHedgeTabletServer();
+    if (!call->hedge_ts || !table()->hedged_read_policy().TryStartHedge()) {
+      return;
+    }
+    call->hedge_req = req_;
+    call->state = HedgedCall::State::kHedged;
+  }
+
+  TRACE_TO(trace_, "Hedging read to $0", call->hedge_ts->ToString());
+  call->hedge_controller.set_deadline(retrier().deadline());
+  call->hedge_controller.set_allow_local_calls_in_curr_thread(false);
+  auto self = std::static_pointer_cast<ReadRpc>(shared_from_this());
+  call->hedge_ts->proxy()->ReadAsync(
+      call->hedge_req, &call->hedge_resp, &call->hedge_controller, [self, call] {
+    self->HedgeFinished(call);
+  });
+}
+
+void ReadRpc::PrimaryFinished(const std::shared_ptr<HedgedCall>& call) {
+  if (retrier().controller().status().ok()) {
+    table()->hedged_read_policy().RecordLatency(MonoTime::Now().GetDeltaSince(call->start));
+  }
+  {
+    std::lock_guard<std::mutex> lock(call->mutex);
+    if (call->state == HedgedCall::State::kDone) {
+      // Hedge already delivered the response.
+      return;
+    }
+    call->state = HedgedCall::State::kDone;
+  }
+  resp_.Swap(&call->primary_resp);
+  Finished(Status::OK());
+}
+
+void ReadRpc::HedgeFinished(const std::shared_ptr<HedgedCall>& call) {
+  // Failed hedge is ignored, the primary call is retried as usual if it fails too.
+  if (!call->hedge_controller.status().ok() || call->hedge_resp.has_error()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(call->mutex);
+    if (call->state == HedgedCall::State::kDone) {
+      return;
+    }
+    call->state = HedgedCall::State::kDone;
+  }
+  TRACE_TO(trace_, "Hedged read to $0 finished first", call->hedge_ts->ToString());
+  resp_.Swap(&call->hedge_resp);
+  winning_hedge_ = call;
+  Completed(Status::OK());
+}
+
+Result<Slice> ReadRpc::GetSidecar(int idx) const {
+  if (winning_hedge_) {
+    return winning_hedge_->hedge_controller.GetSidecar(idx);
+  }
+  return retrier().controller().GetSidecar(idx);
+}
+
 void ReadRpc::SwapRequestsAndResponses(bool skip_responses) {
   size_t redis_idx = 0;
   size_t ql_idx = 0;
@@ -715,8 +977,7 @@ void ReadRpc::SwapRequestsAndResponses(bool skip_responses) {
         ql_op->mutable_response()->Swap(resp_.mutable_ql_batch(ql_idx));
         const auto& ql_response = ql_op->response();
         if (ql_response.has_rows_data_sidecar()) {
-          Slice rows_data = CHECK_RESULT(retrier().controller().GetSidecar(
-              ql_response.rows_data_sidecar()));
+          Slice rows_data = CHECK_RESULT(GetSidecar(ql_response.rows_data_sidecar()));
           ql_op->mutable_rows_data()->assign(util::to_char_ptr(rows_data.data()), rows_data.size());
         }
         ql_idx++;
@@ -732,8 +993,7 @@ void ReadRpc::SwapRequestsAndResponses(bool skip_responses) {
         pgsql_op->mutable_response()->Swap(resp_.mutable_pgsql_batch(pgsql_idx));
         const auto& pgsql_response = pgsql_op->response();
         if (pgsql_response.has_rows_data_sidecar()) {
-          Slice rows_data = CHECK_RESULT(retrier().controller().GetSidecar(
-              pgsql_response.rows_data_sidecar()));
+          Slice rows_data = CHECK_RESULT(GetSidecar(pgsql_response.rows_data_sidecar()));
           down_cast<YBPgsqlReadOp*>(yb_op)->mutable_rows_data()->assign(
               util::to_char_ptr(rows_data.data()), rows_data.size());
         }
@@ -87,6 +87,9 @@ class AsyncRpc : public rpc::Rpc, public TabletRpc {
  protected:
   void Finished(const Status& status) override;
 
+  // Processes the response and completes the RPC, after the tablet invoker is done with it.
+  void Completed(const Status& status);
+
   void SendRpcToTserver(int attempt_num) override;
 
   virtual void CallRemoteMethod() = 0;
@@ -156,9 +159,49 @@ class WriteRpc : public AsyncRpcBase<tserver::WriteRequestPB, tserver::WriteResp
   virtual ~WriteRpc();
 
  private:
+  friend class MultiWriteCollector;
+
   void SwapRequestsAndResponses(bool skip_responses);
   void CallRemoteMethod() override;
+  void SendSeparately();
   void ProcessResponseFromTserver(const Status& status) override;
+  Result<Slice> GetSidecar(int idx) const;
+
+  // Controller of the MultiWrite RPC that delivered the response, when the write was batched.
+  std::shared_ptr<const rpc::RpcController> batch_controller_;
+};
+
+// Collects first attempts of write RPCs that are sent by the current thread while the collector
+// is active, and sends the ones addressed to the same tablet server in a single MultiWrite RPC
+// on Flush. So a flush that touches many tablets of the same server costs a single round trip.
+//
+// Does nothing unless enable_multi_write_batching is set.
+class MultiWriteCollector {
+ public:
+  MultiWriteCollector();
+  ~MultiWriteCollector();
+
+  MultiWriteCollector(const MultiWriteCollector&) = delete;
+  void operator=(const MultiWriteCollector&) = delete;
+
+  // Deactivates the collector and sends collected RPCs.
+  void Flush();
+
+  // Returns the collector active in the current thread, nullptr if there is none.
+  static MultiWriteCollector* Current();
+
+ private:
+  struct Batch;
+
+  void Add(WriteRpc* rpc);
+  static void SendBatch(
+      const std::shared_ptr<tserver::TabletServerServiceProxy>& proxy, std::vector<WriteRpc*> rpcs);
+  static void ProcessResponse(const std::shared_ptr<Batch>& batch);
+
+  MultiWriteCollector* const previous_;
+  bool active_;
+  std::vector<std::pair<std::shared_ptr<tserver::TabletServerServiceProxy>,
+                        std::vector<WriteRpc*>>> groups_;
 };
 
 class ReadRpc : public AsyncRpcBase<tserver::ReadRequestPB, tserver::ReadResponsePB> {
@@ -169,9 +212,22 @@ class ReadRpc : public AsyncRpcBase<tserver::ReadRequestPB, tserver::ReadRespons
   virtual ~ReadRpc();
 
  private:
+  struct HedgedCall;
+
   void SwapRequestsAndResponses(bool skip_responses);
   void CallRemoteMethod() override;
   void ProcessResponseFromTserver(const Status& status) override;
+  Result<Slice> GetSidecar(int idx) const;
+
+  // Sends the read to the selected replica, and schedules the hedge of the read to another
+  // replica, when the first one does not respond in time.
+  void CallRemoteMethodWithHedging();
+  void SendHedge(const std::shared_ptr<HedgedCall>& call);
+  void PrimaryFinished(const std::shared_ptr<HedgedCall>& call);
+  void HedgeFinished(const std::shared_ptr<HedgedCall>& call);
+
+  // Hedged call that delivered the response, its controller holds sidecars of the response.
+  std::shared_ptr<HedgedCall> winning_hedge_;
 };
 
 }  // namespace internal
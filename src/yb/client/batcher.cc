@@ -276,9 +276,7 @@ void Batcher::FlushAsync(StatusFunctor callback) {
   FlushBuffersIfReady();
 }
 
-Status Batcher::Add(shared_ptr<YBOperation> yb_op) {
-  // As soon as we get the op, start looking up where it belongs,
-  // so that when the user calls Flush, we are ready to go.
+Result<InFlightOpPtr> Batcher::PrepareInFlightOp(const shared_ptr<YBOperation>& yb_op) {
   auto in_flight_op = std::make_shared<InFlightOp>(yb_op);
   RETURN_NOT_OK(yb_op->GetPartitionKey(&in_flight_op->partition_key));
 
@@ -315,6 +313,14 @@ Status Batcher::Add(shared_ptr<YBOperation> yb_op) {
     }
   }
 
+  return in_flight_op;
+}
+
+Status Batcher::Add(shared_ptr<YBOperation> yb_op) {
+  // As soon as we get the op, start looking up where it belongs,
+  // so that when the user calls Flush, we are ready to go.
+  auto in_flight_op = VERIFY_RESULT(PrepareInFlightOp(yb_op));
+
   AddInFlightOp(in_flight_op);
   VLOG(3) << "Looking up tablet for " << in_flight_op->yb_op->ToString();
 
@@ -331,6 +337,97 @@ Status Batcher::Add(shared_ptr<YBOperation> yb_op) {
   return Status::OK();
 }
 
+Status Batcher::Add(const std::vector<YBOperationPtr>& ops, size_t* num_added) {
+  *num_added = 0;
+  if (ops.empty()) {
+    return Status::OK();
+  }
+
+  // Partition keys and hash codes are calculated before taking any lock.
+  InFlightOps in_flight_ops;
+  in_flight_ops.reserve(ops.size());
+  Status status;
+  for (const auto& yb_op : ops) {
+    auto in_flight_op = PrepareInFlightOp(yb_op);
+    if (!in_flight_op.ok()) {
+      status = in_flight_op.status();
+      break;
+    }
+    in_flight_ops.push_back(std::move(*in_flight_op));
+  }
+
+  if (in_flight_ops.empty()) {
+    return status;
+  }
+
+  {
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    CHECK_EQ(state_, BatcherState::kGatheringOps);
+    for (const auto& op : in_flight_ops) {
+      LOG_IF(DFATAL, op->state != InFlightOpState::kLookingUpTablet)
+          << "Adding in flight op in a wrong state: " << op->state;
+      CHECK(ops_.insert(op).second);
+      op->sequence_number_ = next_op_sequence_number_++;
+    }
+    outstanding_lookups_ += in_flight_ops.size();
+  }
+  *num_added = in_flight_ops.size();
+
+  // Resolve tablets of all ops that have no tablet assigned in a single pass over the meta cache.
+  std::vector<std::pair<const YBTable*, const std::string*>> keys;
+  InFlightOps lookup_ops;
+  for (const auto& op : in_flight_ops) {
+    if (!op->yb_op->tablet()) {
+      const auto* table = op->yb_op->table();
+      keys.emplace_back(table, &table->FindPartitionStart(op->partition_key));
+      lookup_ops.push_back(op);
+    }
+  }
+  std::vector<internal::RemoteTabletPtr> tablets;
+  if (!keys.empty()) {
+    client_->data_->meta_cache_->FastLookupTabletsByPartitionStart(keys, &tablets);
+  }
+
+  bool all_lookups_finished;
+  {
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    bool finished = true;
+    size_t lookup_idx = 0;
+    for (const auto& op : in_flight_ops) {
+      if (op->yb_op->tablet()) {
+        finished = TabletLookupFinishedUnlocked(op, op->yb_op->tablet()) && finished;
+        continue;
+      }
+      const auto& tablet = tablets[lookup_idx++];
+      if (tablet) {
+        finished = TabletLookupFinishedUnlocked(op, tablet) && finished;
+      }
+    }
+    all_lookups_finished = finished && outstanding_lookups_ == 0;
+  }
+
+  // Ops that were not found in cache go through the regular lookup, that could ask master.
+  CoarseTimePoint deadline;
+  for (size_t i = 0; i != lookup_ops.size(); ++i) {
+    if (tablets[i]) {
+      continue;
+    }
+    if (deadline == CoarseTimePoint()) {
+      deadline = ComputeDeadlineUnlocked();
+    }
+    const auto& op = lookup_ops[i];
+    client_->data_->meta_cache_->LookupTabletByKey(
+        op->yb_op->table(), op->partition_key, deadline,
+        std::bind(&Batcher::TabletLookupFinished, BatcherPtr(this), op, _1));
+  }
+
+  if (all_lookups_finished) {
+    FlushBuffersIfReady();
+  }
+
+  return status;
+}
+
 void Batcher::AddInFlightOp(const InFlightOpPtr& op) {
   LOG_IF(DFATAL, op->state != InFlightOpState::kLookingUpTablet)
       << "Adding in flight op in a wrong state: " << op->state;
@@ -374,78 +471,85 @@ void Batcher::TabletLookupFinished(
   bool all_lookups_finished;
   {
     std::lock_guard<decltype(mutex_)> lock(mutex_);
-
-    --outstanding_lookups_;
-    all_lookups_finished = outstanding_lookups_ == 0;
-
-    if (IsAbortedUnlocked()) {
-      VLOG(1) << "Aborted batch: TabletLookupFinished for " << op->yb_op->ToString();
-      MarkInFlightOpFailedUnlocked(op, STATUS(Aborted, "Batch aborted"));
-      // 'op' is deleted by above function.
+    if (!TabletLookupFinishedUnlocked(op, lookup_result)) {
       return;
     }
+    all_lookups_finished = outstanding_lookups_ == 0;
+  }
 
-    if (state_ != BatcherState::kResolvingTablets && state_ != BatcherState::kGatheringOps) {
-      LOG(DFATAL) << "Lookup finished in wrong state: " << ToString(state_);
-      return;
-    }
+  if (!lookup_result.ok()) {
+    CheckForFinishedFlush();
+  }
 
-    if (lookup_result.ok()) {
-      op->tablet = *lookup_result;
-#ifndef NDEBUG
-      const Partition& partition = op->tablet->partition();
-
-      bool partition_contains_row = false;
-      std::string partition_key;
-      switch (op->yb_op->type()) {
-        case YBOperation::QL_READ: FALLTHROUGH_INTENDED;
-        case YBOperation::QL_WRITE: FALLTHROUGH_INTENDED;
-        case YBOperation::PGSQL_READ: FALLTHROUGH_INTENDED;
-        case YBOperation::PGSQL_WRITE: FALLTHROUGH_INTENDED;
-        case YBOperation::REDIS_READ: FALLTHROUGH_INTENDED;
-        case YBOperation::REDIS_WRITE: {
-          CHECK_OK(op->yb_op->GetPartitionKey(&partition_key));
-          partition_contains_row = partition.ContainsKey(partition_key);
-          break;
-        }
-      }
+  if (all_lookups_finished) {
+    FlushBuffersIfReady();
+  }
+}
 
-      if (!partition_contains_row) {
-        const Schema& schema = GetSchema(op->yb_op->table()->schema());
-        const PartitionSchema& partition_schema = op->yb_op->table()->partition_schema();
-        LOG(DFATAL)
-            << "Row " << op->yb_op->ToString()
-            << " not in partition " << partition_schema.PartitionDebugString(partition, schema)
-            << " partition_key: '" << Slice(partition_key).ToDebugHexString() << "'";
-      }
-#endif
-    }
+bool Batcher::TabletLookupFinishedUnlocked(
+    const InFlightOpPtr& op, const Result<internal::RemoteTabletPtr>& lookup_result) {
+  --outstanding_lookups_;
 
-    VLOG(3) << "TabletLookupFinished for " << op->yb_op->ToString() << ": " << lookup_result
-            << ", outstanding lookups: " << outstanding_lookups_;
+  if (IsAbortedUnlocked()) {
+    VLOG(1) << "Aborted batch: TabletLookupFinished for " << op->yb_op->ToString();
+    MarkInFlightOpFailedUnlocked(op, STATUS(Aborted, "Batch aborted"));
+    // 'op' is deleted by above function.
+    return false;
+  }
 
-    if (lookup_result.ok()) {
-      CHECK(*lookup_result);
+  if (state_ != BatcherState::kResolvingTablets && state_ != BatcherState::kGatheringOps) {
+    LOG(DFATAL) << "Lookup finished in wrong state: " << ToString(state_);
+    return false;
+  }
 
-      auto expected_state = InFlightOpState::kLookingUpTablet;
-      if (op->state.compare_exchange_strong(
-          expected_state, InFlightOpState::kBufferedToTabletServer, std::memory_order_acq_rel)) {
-        ops_queue_.push_back(op);
-      } else {
-        LOG(DFATAL) << "Finished lookup for operation in a bad state: " << ToString(expected_state);
+  if (lookup_result.ok()) {
+    op->tablet = *lookup_result;
+#ifndef NDEBUG
+    const Partition& partition = op->tablet->partition();
+
+    bool partition_contains_row = false;
+    std::string partition_key;
+    switch (op->yb_op->type()) {
+      case YBOperation::QL_READ: FALLTHROUGH_INTENDED;
+      case YBOperation::QL_WRITE: FALLTHROUGH_INTENDED;
+      case YBOperation::PGSQL_READ: FALLTHROUGH_INTENDED;
+      case YBOperation::PGSQL_WRITE: FALLTHROUGH_INTENDED;
+      case YBOperation::REDIS_READ: FALLTHROUGH_INTENDED;
+      case YBOperation::REDIS_WRITE: {
+        CHECK_OK(op->yb_op->GetPartitionKey(&partition_key));
+        partition_contains_row = partition.ContainsKey(partition_key);
+        break;
       }
-    } else {
-      MarkInFlightOpFailedUnlocked(op, lookup_result.status());
     }
-  }
 
-  if (!lookup_result.ok()) {
-    CheckForFinishedFlush();
+    if (!partition_contains_row) {
+      const Schema& schema = GetSchema(op->yb_op->table()->schema());
+      const PartitionSchema& partition_schema = op->yb_op->table()->partition_schema();
+      LOG(DFATAL)
+          << "Row " << op->yb_op->ToString()
+          << " not in partition " << partition_schema.PartitionDebugString(partition, schema)
+          << " partition_key: '" << Slice(partition_key).ToDebugHexString() << "'";
+    }
+#endif
   }
 
-  if (all_lookups_finished) {
-    FlushBuffersIfReady();
+  VLOG(3) << "TabletLookupFinished for " << op->yb_op->ToString() << ": " << lookup_result
+          << ", outstanding lookups: " << outstanding_lookups_;
+
+  if (lookup_result.ok()) {
+    CHECK(*lookup_result);
+
+    auto expected_state = InFlightOpState::kLookingUpTablet;
+    if (op->state.compare_exchange_strong(
+        expected_state, InFlightOpState::kBufferedToTabletServer, std::memory_order_acq_rel)) {
+      ops_queue_.push_back(op);
+    } else {
+      LOG(DFATAL) << "Finished lookup for operation in a bad state: " << ToString(expected_state);
+    }
+  } else {
+    MarkInFlightOpFailedUnlocked(op, lookup_result.status());
   }
+  return true;
 }
 
 void Batcher::TransactionReady(const Status& status, const BatcherPtr& self) {
@@ -568,9 +672,13 @@ void Batcher::ExecuteOperations(Initial initial) {
     << "Ops queue was modified while creating RPCs";
   ops_queue_.clear();
 
+  // Writes to tablets with known locations are sent inline, so the ones addressed to the same
+  // tablet server are collected into a single MultiWrite RPC.
+  MultiWriteCollector collector;
   for (const auto& rpc : rpcs) {
     rpc->SendRpc();
   }
+  collector.Flush();
 }
 
 rpc::Messenger* Batcher::messenger() const {
@@ -130,6 +130,13 @@ class Batcher : public RefCountedThreadSafe<Batcher> {
   // NOTE: If this returns not-OK, does not take ownership of 'write_op'.
   CHECKED_STATUS Add(std::shared_ptr<YBOperation> yb_op) WARN_UNUSED_RESULT;
 
+  // Adds a batch of operations, taking the batcher lock once for the whole batch and resolving
+  // tablets of all operations in a single pass over the meta cache.
+  // When an operation fails to be added, operations before it are still added, and num_added is
+  // set to their number.
+  CHECKED_STATUS Add(const std::vector<YBOperationPtr>& ops, size_t* num_added)
+      WARN_UNUSED_RESULT;
+
   // Return true if any operations are still pending. An operation is no longer considered
   // pending once it has either errored or succeeded.  Operations are considering pending
   // as soon as they are added, even if Flush has not been called.
@@ -194,6 +201,14 @@ class Batcher : public RefCountedThreadSafe<Batcher> {
 
   double RejectionScore(int attempt_num);
 
+  void SetFollowerReadMaxStaleness(MonoDelta max_staleness) {
+    follower_read_max_staleness_ = max_staleness;
+  }
+
+  MonoDelta follower_read_max_staleness() const {
+    return follower_read_max_staleness_;
+  }
+
   // This is a status error string used when there are multiple errors that need to be fetched
   // from the error collector.
   static const std::string kErrorReachingOutToTServersMsg;
@@ -206,6 +221,9 @@ class Batcher : public RefCountedThreadSafe<Batcher> {
 
   ~Batcher();
 
+  // Creates an in-flight op for the operation and fills its partition key and hash code.
+  Result<InFlightOpPtr> PrepareInFlightOp(const std::shared_ptr<YBOperation>& yb_op);
+
   // Add an op to the in-flight set and increment the ref-count.
   void AddInFlightOp(const InFlightOpPtr& op);
 
@@ -249,6 +267,11 @@ class Batcher : public RefCountedThreadSafe<Batcher> {
   // Async Callbacks.
   void TabletLookupFinished(InFlightOpPtr op, const Result<internal::RemoteTabletPtr>& result);
 
+  // Applies the lookup result to the op. Returns false if the batcher is aborted or in a wrong
+  // state, so the caller should not proceed with flushing.
+  bool TabletLookupFinishedUnlocked(
+      const InFlightOpPtr& op, const Result<internal::RemoteTabletPtr>& result) REQUIRES(mutex_);
+
   // Compute a new deadline based on timeout_. If no timeout_ has been set,
   // uses a hard-coded default and issues periodic warnings.
   CoarseTimePoint ComputeDeadlineUnlocked() const;
@@ -321,6 +344,9 @@ class Batcher : public RefCountedThreadSafe<Batcher> {
 
   RejectionScoreSourcePtr rejection_score_source_;
 
+  // Bounded staleness of CONSISTENT_PREFIX reads, see YBSession::SetFollowerReadMaxStaleness.
+  MonoDelta follower_read_max_staleness_;
+
   DISALLOW_COPY_AND_ASSIGN(Batcher);
 };
 
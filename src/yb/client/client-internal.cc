@@ -262,6 +262,7 @@ YB_CLIENT_SPECIALIZE_SIMPLE(AlterNamespace);
 YB_CLIENT_SPECIALIZE_SIMPLE(ListNamespaces);
 YB_CLIENT_SPECIALIZE_SIMPLE(ReservePgsqlOids);
 YB_CLIENT_SPECIALIZE_SIMPLE(GetYsqlCatalogConfig);
+YB_CLIENT_SPECIALIZE_SIMPLE(IncrementYsqlCatalogVersion);
 YB_CLIENT_SPECIALIZE_SIMPLE(CreateUDType);
 YB_CLIENT_SPECIALIZE_SIMPLE(DeleteUDType);
 YB_CLIENT_SPECIALIZE_SIMPLE(ListUDTypes);
@@ -326,7 +327,8 @@ RemoteTabletServer* YBClient::Data::SelectTServer(RemoteTablet* rt,
       break;
     }
     case CLOSEST_REPLICA:
-    case FIRST_REPLICA: {
+    case FIRST_REPLICA:
+    case LOWEST_LATENCY_REPLICA: {
       if (PREDICT_TRUE(FLAGS_assert_tablet_server_select_is_in_zone.empty())) {
         rt->GetRemoteTabletServers(candidates);
       } else {
@@ -346,6 +348,19 @@ RemoteTabletServer* YBClient::Data::SelectTServer(RemoteTablet* rt,
         if (!filtered.empty()) {
           ret = filtered[0];
         }
+      } else if (selection == LOWEST_LATENCY_REPLICA) {
+        MonoDelta best_latency;
+        for (RemoteTabletServer* rts : filtered) {
+          auto latency = rts->latency();
+          if (!latency.Initialized()) {
+            ret = rts;
+            break;
+          }
+          if (ret == nullptr || latency < best_latency) {
+            ret = rts;
+            best_latency = latency;
+          }
+        }
       } else if (selection == CLOSEST_REPLICA) {
         // Choose the closest replica.
         bool local_zone_ts = false;
@@ -31,6 +31,7 @@
 //
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <thread>
 #include <set>
@@ -85,6 +86,7 @@
 #include "yb/tserver/ts_tablet_manager.h"
 
 #include "yb/util/capabilities.h"
+#include "yb/util/countdown_latch.h"
 #include "yb/util/metrics.h"
 #include "yb/util/net/sockaddr.h"
 #include "yb/util/status.h"
@@ -112,6 +114,7 @@ DECLARE_int32(min_backoff_ms_exponent);
 DECLARE_int32(max_backoff_ms_exponent);
 
 METRIC_DECLARE_counter(rpcs_queue_overflow);
+METRIC_DECLARE_histogram(handler_latency_yb_master_MasterService_GetTabletLocations);
 
 DEFINE_CAPABILITY(ClientTest, 0x1523c5ae);
 
@@ -233,6 +236,32 @@ class ClientTest: public YBMiniClusterTestBase<MiniCluster> {
     ASSERT_NO_FATALS(CheckNoRpcOverflow());
   }
 
+  // Inserts num_rows rows starting from first_row one by one, applying the next row from the
+  // continuation of the previous flush instead of blocking a thread to wait for it.
+  void InsertTestRowsAsync(
+      const YBSessionPtr& session, int first_row, int num_rows, std::atomic<int>* failures,
+      CountDownLatch* latch) {
+    if (num_rows == 0) {
+      latch->CountDown();
+      return;
+    }
+    auto status = session->Apply(BuildTestRow(client_table_, first_row));
+    if (!status.ok()) {
+      LOG(WARNING) << "Apply failed: " << status;
+      failures->fetch_add(1);
+      latch->CountDown();
+      return;
+    }
+    session->FlushAsyncFuture().OnReady(
+        [this, session, first_row, num_rows, failures, latch](const Status& flush_status) {
+      if (!flush_status.ok()) {
+        LOG(WARNING) << "Flush failed: " << flush_status;
+        failures->fetch_add(1);
+      }
+      InsertTestRowsAsync(session, first_row + 1, num_rows - 1, failures, latch);
+    });
+  }
+
   // Inserts 'num_rows' using the default client.
   void InsertTestRows(const TableHandle& table, int num_rows, int first_row = 0) {
     InsertTestRows(client_.get(), table, num_rows, first_row);
@@ -754,6 +783,58 @@ TEST_F(ClientTest, TestGetTabletServerBlacklist) {
   }
 }
 
+TEST_F(ClientTest, TestGetTabletServerLowestLatency) {
+  TableHandle table;
+  ASSERT_NO_FATALS(CreateTable(YBTableName(YQL_DATABASE_CQL, "latency"), kNumTablets, &table));
+  InsertTestRows(table, 1, 0);
+
+  scoped_refptr<internal::RemoteTablet> rt;
+  vector<internal::RemoteTabletServer*> tservers;
+  while (true) {
+    rt = ASSERT_RESULT(LookupFirstTabletFuture(table.get()).get());
+    ASSERT_TRUE(rt.get() != nullptr);
+    rt->GetRemoteTabletServers(&tservers);
+    if (tservers.size() == 3) {
+      break;
+    }
+    rt->MarkStale();
+    SleepFor(MonoDelta::FromMilliseconds(10));
+  }
+
+  // Feed enough samples to hide the latency learned while inserting rows.
+  auto set_latency = [](internal::RemoteTabletServer* ts, MonoDelta latency) {
+    for (int i = 0; i != 100; ++i) {
+      ts->UpdateLatency(latency);
+    }
+  };
+  for (size_t i = 0; i != tservers.size(); ++i) {
+    set_latency(tservers[i], MonoDelta::FromMilliseconds(10 * (i + 1)));
+  }
+
+  internal::RemoteTabletServer* rts;
+  set<string> blacklist;
+  vector<internal::RemoteTabletServer*> candidates;
+  ASSERT_OK(client_->data_->GetTabletServer(client_.get(), rt,
+                                            YBClient::LOWEST_LATENCY_REPLICA,
+                                            blacklist, &candidates, &rts));
+  ASSERT_EQ(tservers[0], rts);
+
+  // Stale replica is skipped.
+  blacklist.insert(tservers[0]->permanent_uuid());
+  ASSERT_OK(client_->data_->GetTabletServer(client_.get(), rt,
+                                            YBClient::LOWEST_LATENCY_REPLICA,
+                                            blacklist, &candidates, &rts));
+  ASSERT_EQ(tservers[1], rts);
+
+  // Latency changes are learned.
+  blacklist.clear();
+  set_latency(tservers[2], MonoDelta::FromMilliseconds(1));
+  ASSERT_OK(client_->data_->GetTabletServer(client_.get(), rt,
+                                            YBClient::LOWEST_LATENCY_REPLICA,
+                                            blacklist, &candidates, &rts));
+  ASSERT_EQ(tservers[2], rts);
+}
+
 TEST_F(ClientTest, TestScanWithEncodedRangePredicate) {
   TableHandle table;
   ASSERT_NO_FATALS(CreateTable(YBTableName(YQL_DATABASE_CQL, "split-table"),
@@ -951,6 +1032,61 @@ TEST_F(ClientTest, TestAsyncFlushResponseAfterSessionDropped) {
   ASSERT_OK(s.Wait());
 }
 
+// Compares throughput of many concurrent writers, that either block a thread each to wait for
+// their flushes, or continue from the flush completions on reactor threads using AsyncFuture.
+TEST_F(ClientTest, AsyncFutureWriteThroughput) {
+  constexpr int kWriters = 32;
+  constexpr int kRowsPerWriter = 50;
+  constexpr int kTotalRows = kWriters * kRowsPerWriter;
+
+  std::atomic<int> failures(0);
+  Stopwatch blocking_stopwatch(Stopwatch::ALL_THREADS);
+  blocking_stopwatch.start();
+  {
+    std::vector<std::thread> threads;
+    for (int writer = 0; writer != kWriters; ++writer) {
+      threads.emplace_back([this, writer, &failures] {
+        auto session = CreateSession();
+        for (int i = 0; i != kRowsPerWriter; ++i) {
+          auto status = session->Apply(BuildTestRow(client_table_, writer * kRowsPerWriter + i));
+          if (status.ok()) {
+            status = session->FlushFuture().get();
+          }
+          if (!status.ok()) {
+            LOG(WARNING) << "Write failed: " << status;
+            failures.fetch_add(1);
+          }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+  blocking_stopwatch.stop();
+  ASSERT_EQ(0, failures.load());
+
+  Stopwatch async_stopwatch(Stopwatch::ALL_THREADS);
+  async_stopwatch.start();
+  CountDownLatch latch(kWriters);
+  for (int writer = 0; writer != kWriters; ++writer) {
+    InsertTestRowsAsync(
+        CreateSession(), kTotalRows + writer * kRowsPerWriter, kRowsPerWriter, &failures, &latch);
+  }
+  latch.Wait();
+  async_stopwatch.stop();
+  ASSERT_EQ(0, failures.load());
+
+  for (const auto* stopwatch : {&blocking_stopwatch, &async_stopwatch}) {
+    auto times = stopwatch->elapsed();
+    LOG(INFO) << (stopwatch == &blocking_stopwatch ? "Blocking" : "AsyncFuture") << " writers: "
+              << kTotalRows / times.wall_seconds() << " rows/s, "
+              << kTotalRows / (times.user_cpu_seconds() + times.system_cpu_seconds())
+              << " rows per CPU second";
+  }
+  ASSERT_EQ(2 * kTotalRows, CountRowsFromClient(client_table_));
+}
+
 TEST_F(ClientTest, TestSessionClose) {
   auto session = CreateSession();
   ASSERT_OK(ApplyInsertToSession(session.get(), client_table_, 1, 1, "row"));
@@ -997,6 +1133,29 @@ TEST_F(ClientTest, TestMultipleMultiRowManualBatches) {
   ASSERT_EQ("{ int32:0, int32:0, string:\"hello world\", null }", rows[0]);
 }
 
+// Test applying operations of several tables as a single vector, some of them twice, so lookups
+// of the first batch go to master and lookups of the second batch are served from meta cache.
+TEST_F(ClientTest, TestApplyVectorOfOps) {
+  const int kNumRows = 100;
+  auto session = CreateSession();
+
+  for (int batch = 0; batch != 2; ++batch) {
+    std::vector<YBOperationPtr> ops;
+    for (int i = 0; i != kNumRows; ++i) {
+      ops.push_back(BuildTestRow(i % 2 == 0 ? client_table_ : client_table2_, i));
+    }
+    ASSERT_OK(session->Apply(ops));
+    ASSERT_TRUE(session->HasPendingOperations()) << "Should be pending until we Flush";
+    FlushSessionOrDie(session);
+    for (const auto& op : ops) {
+      ASSERT_TRUE(op->succeeded()) << op->ToString();
+    }
+  }
+
+  ASSERT_EQ(kNumRows / 2, CountRowsFromClient(client_table_));
+  ASSERT_EQ(kNumRows / 2, CountRowsFromClient(client_table2_));
+}
+
 // Test a batch where one of the inserted rows succeeds and duplicates succeed too.
 TEST_F(ClientTest, TestBatchWithDuplicates) {
   auto session = CreateSession();
@@ -1754,6 +1913,36 @@ TEST_F(ClientTest, TestMasterLookupPermits) {
             client_->data_->meta_cache_->master_lookup_sem_.GetValue());
 }
 
+// Tests that concurrent lookups of the same tablet by id share a single master RPC.
+TEST_F(ClientTest, TestCoalescedLookupsById) {
+  const string tablet_id = GetFirstTabletId(client_table_.get());
+  auto hist = METRIC_handler_latency_yb_master_MasterService_GetTabletLocations.Instantiate(
+      cluster_->mini_master()->master()->metric_entity());
+  const auto initial_count = hist->TotalCount();
+
+  // Make sure all lookups are issued while the first one is still in flight.
+  FLAGS_master_inject_latency_on_tablet_lookups_ms = 500;
+  constexpr int kNumLookups = 100;
+  CountDownLatch latch(kNumLookups);
+  std::atomic<int> failures(0);
+  for (int i = 0; i != kNumLookups; ++i) {
+    client_->LookupTabletById(
+        tablet_id, CoarseMonoClock::Now() + 20s,
+        [&latch, &failures, &tablet_id](const Result<internal::RemoteTabletPtr>& result) {
+          if (!result.ok() || (*result)->tablet_id() != tablet_id) {
+            ++failures;
+          }
+          latch.CountDown();
+        },
+        UseCache::kFalse);
+  }
+  latch.Wait();
+  FLAGS_master_inject_latency_on_tablet_lookups_ms = 0;
+
+  ASSERT_EQ(0, failures.load());
+  ASSERT_LE(hist->TotalCount(), initial_count + 1);
+}
+
 // Define callback for deadlock simulation, as well as various helper methods.
 namespace {
 
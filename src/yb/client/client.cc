@@ -635,6 +635,39 @@ Status YBClient::GetYsqlCatalogMasterVersion(uint64_t *ysql_catalog_version) {
   return Status::OK();
 }
 
+Status YBClient::GetYsqlCatalogInvalidations(
+    uint64_t since_version, uint64_t* ysql_catalog_version,
+    boost::optional<std::string>* invalidation_messages) {
+  GetYsqlCatalogConfigRequestPB req;
+  GetYsqlCatalogConfigResponsePB resp;
+  req.set_invalidations_since_version(since_version);
+  CALL_SYNC_LEADER_MASTER_RPC(req, resp, GetYsqlCatalogConfig);
+  *ysql_catalog_version = resp.version();
+
+  // Versions are recorded in order, so all of them are present when the count matches.
+  *invalidation_messages = boost::none;
+  if (resp.version() < since_version ||
+      static_cast<uint64_t>(resp.invalidations_size()) != resp.version() - since_version) {
+    return Status::OK();
+  }
+  std::string messages;
+  for (const auto& invalidation : resp.invalidations()) {
+    messages += invalidation.messages();
+  }
+  *invalidation_messages = std::move(messages);
+  return Status::OK();
+}
+
+Status YBClient::IncrementYsqlCatalogVersion(const std::string& invalidation_messages,
+                                             uint64_t* ysql_catalog_version) {
+  IncrementYsqlCatalogVersionRequestPB req;
+  IncrementYsqlCatalogVersionResponsePB resp;
+  req.set_invalidation_messages(invalidation_messages);
+  CALL_SYNC_LEADER_MASTER_RPC(req, resp, IncrementYsqlCatalogVersion);
+  *ysql_catalog_version = resp.version();
+  return Status::OK();
+}
+
 Status YBClient::GrantRevokePermission(GrantRevokeStatementType statement_type,
                                        const PermissionType& permission,
                                        const ResourceType& resource_type,
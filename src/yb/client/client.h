@@ -341,6 +341,18 @@ class YBClient {
 
   CHECKED_STATUS GetYsqlCatalogMasterVersion(uint64_t *ysql_catalog_version);
 
+  // Gets the current YSQL catalog version, and the concatenated catalog cache invalidation
+  // messages of all the catalog versions after since_version. Sets invalidation_messages to none
+  // if the master does not have the messages of some of these versions.
+  CHECKED_STATUS GetYsqlCatalogInvalidations(
+      uint64_t since_version, uint64_t* ysql_catalog_version,
+      boost::optional<std::string>* invalidation_messages);
+
+  // Increments the YSQL catalog version, recording the catalog cache invalidation messages with
+  // the new version.
+  CHECKED_STATUS IncrementYsqlCatalogVersion(const std::string& invalidation_messages,
+                                             uint64_t* ysql_catalog_version);
+
   // Grant permission with given arguments.
   CHECKED_STATUS GrantRevokePermission(GrantRevokeStatementType statement_type,
                                        const PermissionType& permission,
@@ -536,7 +548,11 @@ class YBClient {
     CLOSEST_REPLICA,
 
     // Select the first replica in the list.
-    FIRST_REPLICA
+    FIRST_REPLICA,
+
+    // Select the replica with the lowest observed RPC latency. Replicas without latency samples
+    // are selected first, so latency of every replica is learned.
+    LOWEST_LATENCY_REPLICA
   };
 
   bool IsMultiMaster() const;
@@ -0,0 +1,73 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/client/hedged_read_policy.h"
+
+#include "yb/util/random_util.h"
+#include "yb/util/test_util.h"
+
+DECLARE_int32(hedged_reads_budget_percent);
+DECLARE_int32(hedged_reads_max_burst);
+DECLARE_int32(hedged_reads_min_delay_us);
+
+namespace yb {
+namespace client {
+namespace internal {
+
+class HedgedReadPolicyTest : public YBTest {
+};
+
+// Delay should settle near the 95th percentile of latencies.
+TEST_F(HedgedReadPolicyTest, DelayTracksPercentile) {
+  FLAGS_hedged_reads_min_delay_us = 0;
+  HedgedReadPolicy policy;
+  ASSERT_FALSE(policy.HedgeDelay().Initialized());
+
+  for (int i = 0; i != 100000; ++i) {
+    policy.RecordLatency(MonoDelta::FromMicroseconds(RandomUniformInt(1000, 1999)));
+  }
+  auto delay_us = policy.HedgeDelay().ToMicroseconds();
+  ASSERT_GE(delay_us, 1700);
+  ASSERT_LE(delay_us, 2100);
+
+  FLAGS_hedged_reads_min_delay_us = 5000;
+  ASSERT_EQ(policy.HedgeDelay().ToMicroseconds(), 5000);
+}
+
+// Hedges should be limited by the budget, that is earned by reads up to the max burst.
+TEST_F(HedgedReadPolicyTest, Budget) {
+  FLAGS_hedged_reads_budget_percent = 10;
+  FLAGS_hedged_reads_max_burst = 3;
+  HedgedReadPolicy policy;
+  ASSERT_FALSE(policy.TryStartHedge());
+
+  for (int i = 0; i != 9; ++i) {
+    policy.ReadStarted();
+  }
+  ASSERT_FALSE(policy.TryStartHedge());
+  policy.ReadStarted();
+  ASSERT_TRUE(policy.TryStartHedge());
+  ASSERT_FALSE(policy.TryStartHedge());
+
+  for (int i = 0; i != 1000; ++i) {
+    policy.ReadStarted();
+  }
+  for (int i = 0; i != FLAGS_hedged_reads_max_burst; ++i) {
+    ASSERT_TRUE(policy.TryStartHedge());
+  }
+  ASSERT_FALSE(policy.TryStartHedge());
+}
+
+} // namespace internal
+} // namespace client
+} // namespace yb
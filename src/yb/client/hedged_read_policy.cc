@@ -0,0 +1,98 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/client/hedged_read_policy.h"
+
+#include <algorithm>
+
+#include "yb/util/flag_tags.h"
+
+DEFINE_bool(hedged_reads, false,
+            "Whether reads that could be served by any replica are sent to another replica as "
+            "well, when the first replica does not respond within the 95th percentile of the read "
+            "latency of the table.");
+TAG_FLAG(hedged_reads, advanced);
+TAG_FLAG(hedged_reads, runtime);
+
+DEFINE_int32(hedged_reads_budget_percent, 5,
+             "Max number of hedged reads, in percent of the reads that could be hedged.");
+TAG_FLAG(hedged_reads_budget_percent, advanced);
+TAG_FLAG(hedged_reads_budget_percent, runtime);
+
+DEFINE_int32(hedged_reads_max_burst, 10,
+             "Max number of hedged reads of a table that could be sent in a burst, when the "
+             "budget was not used for a while.");
+TAG_FLAG(hedged_reads_max_burst, advanced);
+TAG_FLAG(hedged_reads_max_burst, runtime);
+
+DEFINE_int32(hedged_reads_min_delay_us, 1000,
+             "Min delay before a read is hedged.");
+TAG_FLAG(hedged_reads_min_delay_us, advanced);
+TAG_FLAG(hedged_reads_min_delay_us, runtime);
+
+namespace yb {
+namespace client {
+namespace internal {
+
+void HedgedReadPolicy::ReadStarted() {
+  const int64_t max_budget = static_cast<int64_t>(FLAGS_hedged_reads_max_burst) * kBudgetUnit;
+  auto budget = budget_.load(std::memory_order_acquire);
+  while (budget < max_budget) {
+    auto new_budget = std::min(budget + FLAGS_hedged_reads_budget_percent, max_budget);
+    if (budget_.compare_exchange_weak(budget, new_budget, std::memory_order_acq_rel)) {
+      break;
+    }
+  }
+}
+
+bool HedgedReadPolicy::TryStartHedge() {
+  auto budget = budget_.load(std::memory_order_acquire);
+  while (budget >= kBudgetUnit) {
+    if (budget_.compare_exchange_weak(budget, budget - kBudgetUnit, std::memory_order_acq_rel)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void HedgedReadPolicy::RecordLatency(MonoDelta latency) {
+  const auto value = std::max<int64_t>(latency.ToMicroseconds(), 1);
+  auto estimate = latency_estimate_us_.load(std::memory_order_acquire);
+  for (;;) {
+    int64_t new_estimate;
+    if (estimate == 0) {
+      new_estimate = value;
+    } else {
+      const auto step = std::max<int64_t>(estimate / kStepDivisor, 1);
+      new_estimate = value > estimate ? estimate + step * kUpStepRatio
+                                      : std::max<int64_t>(estimate - step, 1);
+    }
+    if (latency_estimate_us_.compare_exchange_weak(
+            estimate, new_estimate, std::memory_order_acq_rel)) {
+      return;
+    }
+  }
+}
+
+MonoDelta HedgedReadPolicy::HedgeDelay() const {
+  auto estimate = latency_estimate_us();
+  if (estimate == 0) {
+    return MonoDelta();
+  }
+  return MonoDelta::FromMicroseconds(
+      std::max<int64_t>(estimate, FLAGS_hedged_reads_min_delay_us));
+}
+
+} // namespace internal
+} // namespace client
+} // namespace yb
@@ -0,0 +1,69 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_CLIENT_HEDGED_READ_POLICY_H
+#define YB_CLIENT_HEDGED_READ_POLICY_H
+
+#include <atomic>
+
+#include "yb/util/monotime.h"
+
+namespace yb {
+namespace client {
+namespace internal {
+
+// Decides when a read that could be served by any replica should be hedged, i.e. sent to another
+// replica as well, when the first replica takes too long to respond.
+//
+// The read is hedged after the 95th percentile of the observed read latencies, so about 5% of
+// reads are hedged when replicas behave the same, and slow replicas don't drive the tail latency.
+// Each read earns a share of a hedge budget, so hedges don't amplify the load when all replicas
+// are slow.
+//
+// This class is thread-safe.
+class HedgedReadPolicy {
+ public:
+  // The estimate moves up 19 times faster than it moves down, so it settles where 1 of 20
+  // observed latencies is above it.
+  static constexpr int64_t kUpStepRatio = 19;
+  // Step of the estimate relative to its current value.
+  static constexpr int64_t kStepDivisor = 512;
+  // Hedge budget is kept in hundredths of a hedge.
+  static constexpr int64_t kBudgetUnit = 100;
+
+  // Called for each read that could be hedged.
+  void ReadStarted();
+
+  void RecordLatency(MonoDelta latency);
+
+  // Returns the delay after which a read should be hedged. Uninitialized delay means that reads
+  // should not be hedged yet, because no latency was observed.
+  MonoDelta HedgeDelay() const;
+
+  // Takes budget for one hedge. Returns false if there is not enough budget.
+  bool TryStartHedge();
+
+  int64_t latency_estimate_us() const {
+    return latency_estimate_us_.load(std::memory_order_acquire);
+  }
+
+ private:
+  std::atomic<int64_t> latency_estimate_us_{0};
+  std::atomic<int64_t> budget_{0};
+};
+
+} // namespace internal
+} // namespace client
+} // namespace yb
+
+#endif // YB_CLIENT_HEDGED_READ_POLICY_H
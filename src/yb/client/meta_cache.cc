@@ -32,6 +32,7 @@
 
 #include "yb/client/meta_cache.h"
 
+#include <algorithm>
 #include <shared_mutex>
 #include <mutex>
 
@@ -176,6 +177,20 @@ void RemoteTabletServer::Update(const master::TSInfoPB& pb) {
   std::sort(capabilities_.begin(), capabilities_.end());
 }
 
+void RemoteTabletServer::UpdateLatency(MonoDelta latency) {
+  // Weight of the new sample is 1/8, like in TCP round trip time estimation. Concurrent updates
+  // could lose samples, that is acceptable for an estimate.
+  auto sample = std::max<int64_t>(latency.ToMicroseconds(), 1);
+  auto old_value = latency_us_.load(std::memory_order_relaxed);
+  auto new_value = old_value ? old_value + (sample - old_value) / 8 : sample;
+  latency_us_.store(std::max<int64_t>(new_value, 1), std::memory_order_relaxed);
+}
+
+MonoDelta RemoteTabletServer::latency() const {
+  auto value = latency_us_.load(std::memory_order_relaxed);
+  return value ? MonoDelta::FromMicroseconds(value) : MonoDelta();
+}
+
 bool RemoteTabletServer::IsLocal() const {
   return local_tserver_ != nullptr;
 }
@@ -733,6 +748,14 @@ RemoteTabletPtr MetaCache::ProcessTabletLocations(
           first = false;
         }
 
+        auto lookup_by_id_iter = tablet_lookups_by_id_.find(tablet_id);
+        if (lookup_by_id_iter != tablet_lookups_by_id_.end()) {
+          for (auto& lookup : lookup_by_id_iter->second) {
+            to_notify.emplace_back(std::move(lookup.callback), remote);
+          }
+          tablet_lookups_by_id_.erase(lookup_by_id_iter);
+        }
+
         if (partition_group_start) {
           auto lookup_by_group_iter =
               table_data.tablet_lookups_by_group.find(*partition_group_start);
@@ -832,13 +855,11 @@ void MetaCache::LookupFailed(
 class LookupByIdRpc : public LookupRpc {
  public:
   LookupByIdRpc(const scoped_refptr<MetaCache>& meta_cache,
-                LookupTabletCallback user_cb,
                 TabletId tablet_id,
                 CoarseTimePoint deadline,
                 Messenger* messenger,
                 rpc::ProxyCache* proxy_cache)
       : LookupRpc(meta_cache, deadline, messenger, proxy_cache),
-        user_cb_(std::move(user_cb)),
         tablet_id_(std::move(tablet_id)) {}
 
   std::string ToString() const override {
@@ -861,18 +882,11 @@ class LookupByIdRpc : public LookupRpc {
 
   void Notify(const Status& status, const RemoteTabletPtr& remote_tablet) override {
     if (status.ok()) {
-      user_cb_(remote_tablet);
-    } else {
-      user_cb_(status);
+      return; // This case is handled by ProcessTabletLocations.
     }
+    meta_cache()->LookupByIdFailed(tablet_id_, status);
   }
 
-
-  // User-specified callback to invoke when the lookup finishes.
-  //
-  // Always invoked, regardless of success or failure.
-  LookupTabletCallback user_cb_;
-
   // Tablet to lookup.
   TabletId tablet_id_;
 
@@ -1033,6 +1047,25 @@ void MetaCache::LookupTabletByKey(const YBTable* table,
       client_->data_->proxy_cache_.get());
 }
 
+void MetaCache::FastLookupTabletsByPartitionStart(
+    const std::vector<std::pair<const YBTable*, const std::string*>>& keys,
+    std::vector<RemoteTabletPtr>* tablets) {
+  tablets->clear();
+  tablets->resize(keys.size());
+  SharedLock<decltype(mutex_)> lock(mutex_);
+  for (size_t i = 0; i != keys.size(); ++i) {
+    // Keys of consecutive operations usually fall into the same tablet.
+    if (i != 0 && keys[i].first == keys[i - 1].first && *keys[i].second == *keys[i - 1].second) {
+      (*tablets)[i] = (*tablets)[i - 1];
+      continue;
+    }
+    auto result = LookupTabletByKeyFastPathUnlocked(keys[i].first, *keys[i].second);
+    if (result && result->HasLeader()) {
+      (*tablets)[i] = std::move(result);
+    }
+  }
+}
+
 RemoteTabletPtr MetaCache::LookupTabletByIdFastPath(const TabletId& tablet_id) {
   SharedLock<decltype(mutex_)> l(mutex_);
   auto it = tablets_by_id_.find(tablet_id);
@@ -1056,9 +1089,64 @@ void MetaCache::LookupTabletById(const TabletId& tablet_id,
     }
   }
 
+  {
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    auto& lookups = tablet_lookups_by_id_[tablet_id];
+    bool was_empty = lookups.empty();
+    lookups.push_back({std::move(callback), deadline});
+    if (!was_empty) {
+      // The tablet is looked up already, and its response will refresh the cached tablet as well.
+      return;
+    }
+  }
+
   rpc::StartRpc<LookupByIdRpc>(
-      this, std::move(callback), tablet_id, deadline, client_->data_->messenger_,
-      client_->data_->proxy_cache_.get());
+      this, tablet_id, deadline, client_->data_->messenger_, client_->data_->proxy_cache_.get());
+}
+
+void MetaCache::LookupByIdFailed(const TabletId& tablet_id, const Status& status) {
+  VLOG(1) << "Lookup for tablet " << tablet_id << ", failed with: " << status;
+
+  std::vector<LookupTabletCallback> to_notify;
+  CoarseTimePoint max_deadline;
+  {
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    auto it = tablet_lookups_by_id_.find(tablet_id);
+    if (it == tablet_lookups_by_id_.end()) {
+      return;
+    }
+    auto& lookups = it->second;
+
+    // The RPC uses deadline of the lookup that started it, so lookups with later deadline should
+    // be retried on timeout.
+    auto now = CoarseMonoClock::Now();
+    auto w = lookups.begin();
+    for (auto i = lookups.begin(); i != lookups.end(); ++i) {
+      if (!status.IsTimedOut() || i->deadline <= now) {
+        to_notify.push_back(std::move(i->callback));
+      } else {
+        max_deadline = std::max(max_deadline, i->deadline);
+        if (i != w) {
+          *w = std::move(*i);
+        }
+        ++w;
+      }
+    }
+    lookups.erase(w, lookups.end());
+    if (lookups.empty()) {
+      tablet_lookups_by_id_.erase(it);
+    }
+  }
+
+  for (const auto& callback : to_notify) {
+    callback(status);
+  }
+
+  if (max_deadline != CoarseTimePoint()) {
+    rpc::StartRpc<LookupByIdRpc>(
+        this, tablet_id, max_deadline, client_->data_->messenger_,
+        client_->data_->proxy_cache_.get());
+  }
 }
 
 void MetaCache::MarkTSFailed(RemoteTabletServer* ts,
@@ -33,6 +33,7 @@
 #ifndef YB_CLIENT_META_CACHE_H
 #define YB_CLIENT_META_CACHE_H
 
+#include <atomic>
 #include <map>
 #include <string>
 #include <memory>
@@ -157,6 +158,12 @@ class RemoteTabletServer {
 
   bool HasCapability(CapabilityId capability) const;
 
+  // Updates the estimated latency of this server with the duration of a completed RPC.
+  void UpdateLatency(MonoDelta latency);
+
+  // Returns the estimated latency of this server, uninitialized if no RPC has completed yet.
+  MonoDelta latency() const;
+
  private:
   mutable rw_spinlock mutex_;
   const std::string uuid_;
@@ -170,6 +177,9 @@ class RemoteTabletServer {
   scoped_refptr<Histogram> dns_resolve_histogram_;
   std::vector<CapabilityId> capabilities_;
 
+  // Exponentially weighted moving average of RPC latency in microseconds, 0 when unknown.
+  std::atomic<int64_t> latency_us_{0};
+
   DISALLOW_COPY_AND_ASSIGN(RemoteTabletServer);
 };
 
@@ -348,6 +358,13 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
                          CoarseTimePoint deadline,
                          LookupTabletCallback callback);
 
+  // Looks up tablets hosting the given partition starts of the given tables, only consulting
+  // local information, under a single acquisition of the cache lock. tablets is resized to the
+  // number of keys, a tablet that is not cached or has no leader is left null.
+  void FastLookupTabletsByPartitionStart(
+      const std::vector<std::pair<const YBTable*, const std::string*>>& keys,
+      std::vector<RemoteTabletPtr>* tablets);
+
   std::future<Result<internal::RemoteTabletPtr>> LookupTabletByKeyFuture(
       const YBTable* table,
       const std::string& partition_key,
@@ -410,6 +427,10 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   void LookupFailed(
       const YBTable* table, const std::string& partition_group_start, const Status& status);
 
+  // Notify callbacks waiting for lookup of specified tablet that it was failed because of
+  // specified status.
+  void LookupByIdFailed(const TabletId& tablet_id, const Status& status);
+
   template <class Lock>
   bool FastLookupTabletByKeyUnlocked(
       const YBTable* table,
@@ -459,6 +480,11 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   // Cache of tablets, keyed by tablet ID.
   std::unordered_map<std::string, RemoteTabletPtr> tablets_by_id_ GUARDED_BY(mutex_);
 
+  // Lookups of tablets by tablet ID, waiting for the master response. Concurrent lookups of the
+  // same tablet, e.g. by all requests that failed to find the tablet leader after a leader change,
+  // share a single master RPC.
+  std::unordered_map<TabletId, std::vector<LookupData>> tablet_lookups_by_id_ GUARDED_BY(mutex_);
+
   // Prevents master lookup "storms" by delaying master lookups when all
   // permits have been acquired.
   Semaphore master_lookup_sem_;
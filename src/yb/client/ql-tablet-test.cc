@@ -27,6 +27,7 @@
 
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/consensus.pb.h"
+#include "yb/consensus/raft_consensus.h"
 
 #include "yb/docdb/consensus_frontier.h"
 
@@ -36,6 +37,7 @@
 #include "yb/master/master.h"
 
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_peer.h"
 
 #include "yb/server/skewed_clock.h"
 
@@ -72,6 +74,8 @@ DECLARE_int32(tablet_inject_latency_on_apply_write_txn_ms);
 DECLARE_bool(TEST_log_cache_skip_eviction);
 DECLARE_uint64(sst_files_hard_limit);
 DECLARE_uint64(sst_files_soft_limit);
+DECLARE_bool(enable_multi_raft_heartbeat_batcher);
+DECLARE_bool(multi_raft_batch_leader_lease);
 
 namespace yb {
 namespace client {
@@ -536,6 +540,64 @@ TEST_F(QLTabletTest, LeaderLease) {
   ASSERT_TRUE(status.IsIOError()) << "Status: " << status;
 }
 
+// With batch level leases, heartbeats of all tablets led by the same server are sent with a single
+// lease. Checks that every follower of the batch still records the lease of its leader, and keeps
+// getting it extended.
+TEST_F(QLTabletTest, BatchedLeaderLease) {
+  FLAGS_enable_multi_raft_heartbeat_batcher = true;
+  FLAGS_multi_raft_batch_leader_lease = true;
+
+  TableHandle table;
+  CreateTable(kTable1Name, &table, 8);
+  FillTable(0, kTotalKeys, &table);
+
+  auto get_leases = [this]() -> Result<std::unordered_map<std::string, MicrosTime>> {
+    std::unordered_map<std::string, std::string> leaders;
+    for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kLeaders)) {
+      leaders.emplace(peer->tablet_id(), peer->permanent_uuid());
+    }
+    std::unordered_map<std::string, MicrosTime> result;
+    for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kNonLeaders)) {
+      auto lease = peer->raft_consensus()->TEST_OldLeaderHtLease();
+      auto key = peer->tablet_id() + "/" + peer->permanent_uuid();
+      if (!lease || lease.holder_uuid != leaders[peer->tablet_id()]) {
+        return STATUS_FORMAT(IllegalState, "$0 does not have lease of $1: $2",
+                             key, leaders[peer->tablet_id()], lease.holder_uuid);
+      }
+      result.emplace(key, lease.expiration);
+    }
+    return result;
+  };
+
+  std::unordered_map<std::string, MicrosTime> initial_leases;
+  ASSERT_OK(WaitFor([&get_leases, &initial_leases]() -> Result<bool> {
+    auto leases = get_leases();
+    if (!leases.ok()) {
+      LOG(INFO) << leases.status();
+      return false;
+    }
+    initial_leases = std::move(*leases);
+    return true;
+  }, 10s, "Followers record lease"));
+  ASSERT_FALSE(initial_leases.empty());
+
+  // Table is idle, so leases are extended only by status only heartbeats, i.e. in batches.
+  ASSERT_OK(WaitFor([&get_leases, &initial_leases]() -> Result<bool> {
+    auto leases = get_leases();
+    if (!leases.ok()) {
+      LOG(INFO) << leases.status();
+      return false;
+    }
+    for (const auto& p : initial_leases) {
+      auto it = leases->find(p.first);
+      if (it == leases->end() || it->second <= p.second) {
+        return false;
+      }
+    }
+    return true;
+  }, 10s, "Followers extend lease"));
+}
+
 // This test tries to catch situation when some entries were applied and flushed in RocksDB,
 // but is not present in persistent logs.
 //
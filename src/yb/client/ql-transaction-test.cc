@@ -24,8 +24,11 @@
 
 #include "yb/consensus/consensus.h"
 
+#include "yb/docdb/intents_summary.h"
+
 #include "yb/rpc/rpc.h"
 
+#include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/transaction_coordinator.h"
 
@@ -62,6 +65,11 @@ DECLARE_bool(rocksdb_disable_compactions);
 DECLARE_int32(delay_init_tablet_peer_ms);
 DECLARE_bool(fail_in_apply_if_no_metadata);
 DECLARE_bool(delete_intents_sst_files);
+DECLARE_int32(txn_apply_batch_max_records);
+DECLARE_int32(wait_for_conflicting_transactions_ms);
+DECLARE_bool(enable_transaction_heartbeat_batching);
+DECLARE_int32(remove_intents_batch_max_transactions);
+DECLARE_int32(TEST_remove_intents_batch_delay_ms);
 
 namespace yb {
 namespace client {
@@ -100,8 +108,37 @@ class QLTransactionTest : public TransactionTestBase {
     return WaitFor(
       [this] { return CountIntents(cluster_.get()) == 0; }, kIntentsCleanupTime, "Intents cleaned");
   }
+
+  // Writes rows with committed and aborted transactions, using different keys for each of them.
+  void WriteCommittedAndAbortedTransactions(size_t num_transactions);
+
+  void CheckIntentsSummariesEmpty();
 };
 
+void QLTransactionTest::WriteCommittedAndAbortedTransactions(size_t num_transactions) {
+  for (size_t i = 0; i != num_transactions; ++i) {
+    auto txn = CreateTransaction();
+    WriteRows(CreateSession(txn), i);
+    if (i % 2 == 0) {
+      ASSERT_OK(txn->CommitFuture().get());
+    } else {
+      txn->Abort();
+    }
+  }
+}
+
+void QLTransactionTest::CheckIntentsSummariesEmpty() {
+  for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+    auto* tablet = peer->tablet();
+    if (!tablet || !tablet->doc_db().intents_summary) {
+      continue;
+    }
+    auto* summary = tablet->doc_db().intents_summary;
+    ASSERT_FALSE(summary->disabled()) << peer->tablet_id();
+    ASSERT_EQ(summary->TEST_NumIntents(), 0) << peer->tablet_id();
+  }
+}
+
 typedef TransactionCustomLogSegmentSizeTest<0, QLTransactionTest>
     QLTransactionBigLogSegmentSizeTest;
 
@@ -407,6 +444,17 @@ TEST_F(QLTransactionTest, InsertUpdate) {
   ASSERT_OK(cluster_->RestartSync());
 }
 
+TEST_F(QLTransactionTest, ApplyInChunks) {
+  // Each transaction writes a few rows to each tablet, so its apply is split into several batches.
+  FLAGS_txn_apply_batch_max_records = 1;
+  WriteData();
+  ASSERT_OK(WaitTransactionsCleaned());
+  VerifyData();
+  ASSERT_OK(cluster_->RestartSync());
+  VerifyData();
+  CheckNoRunningTransactions();
+}
+
 TEST_F(QLTransactionTest, Cleanup) {
   WriteData();
   VerifyData();
@@ -418,6 +466,47 @@ TEST_F(QLTransactionTest, Cleanup) {
   CheckNoRunningTransactions();
 }
 
+// Intents of applied and aborted transactions should be removed in several batches.
+TEST_F(QLTransactionTest, RemoveIntentsInBatches) {
+  constexpr size_t kTransactions = 10;
+  FLAGS_remove_intents_batch_max_transactions = 2;
+
+  WriteCommittedAndAbortedTransactions(kTransactions);
+
+  ASSERT_OK(WaitTransactionsCleaned());
+  ASSERT_OK(WaitIntentsCleaned());
+  CheckIntentsSummariesEmpty();
+  auto session = CreateSession();
+  for (size_t i = 0; i != kTransactions; i += 2) {
+    VerifyRows(session, i);
+  }
+  CheckNoRunningTransactions();
+}
+
+// Shutdown should not wait for intents removal of all queued transactions, and intents left in
+// intents DB should be removed after restart.
+TEST_F(QLTransactionTest, RemoveIntentsInBatchesShutdown) {
+  constexpr size_t kTransactions = 10;
+  FLAGS_remove_intents_batch_max_transactions = 1;
+  FLAGS_TEST_remove_intents_batch_delay_ms = 200;
+
+  WriteCommittedAndAbortedTransactions(kTransactions);
+  // Each batch takes at least 200ms, so most of the transactions are still queued.
+  ASSERT_GT(CountIntents(cluster_.get()), 0);
+
+  cluster_->Shutdown();
+  FLAGS_TEST_remove_intents_batch_delay_ms = 0;
+  ASSERT_OK(cluster_->StartSync());
+
+  ASSERT_OK(WaitIntentsCleaned());
+  CheckIntentsSummariesEmpty();
+  auto session = CreateSession();
+  for (size_t i = 0; i != kTransactions; i += 2) {
+    VerifyRows(session, i);
+  }
+  CheckNoRunningTransactions();
+}
+
 TEST_F(QLTransactionTest, Heartbeat) {
   auto txn = CreateTransaction();
   auto session = CreateSession(txn);
@@ -428,6 +517,25 @@ TEST_F(QLTransactionTest, Heartbeat) {
   CheckNoRunningTransactions();
 }
 
+// Check that transactions are kept alive by batched heartbeats.
+TEST_F(QLTransactionTest, BatchedHeartbeat) {
+  FLAGS_enable_transaction_heartbeat_batching = true;
+  constexpr size_t kTransactions = 10;
+  std::vector<YBTransactionPtr> transactions;
+  for (size_t i = 0; i != kTransactions; ++i) {
+    auto txn = CreateTransaction();
+    auto session = CreateSession(txn);
+    WriteRows(session, i);
+    transactions.push_back(std::move(txn));
+  }
+  std::this_thread::sleep_for(GetTransactionTimeout() * 2);
+  for (const auto& txn : transactions) {
+    ASSERT_OK(txn->CommitFuture().get());
+  }
+  VerifyData(kTransactions);
+  CheckNoRunningTransactions();
+}
+
 TEST_F(QLTransactionTest, Expire) {
   SetDisableHeartbeatInTests(true);
   auto txn = CreateTransaction();
@@ -570,6 +678,28 @@ TEST_F(QLTransactionTest, SimpleWriteConflict) {
   ASSERT_NOK(transaction->CommitFuture().get());
 }
 
+TEST_F(QLTransactionTest, WaitForConflictingTransaction) {
+  FLAGS_wait_for_conflicting_transactions_ms = 10000;
+
+  auto transaction = CreateTransaction();
+  ASSERT_OK(WriteRow(CreateSession(transaction), 0 /* key */, 1 /* value */));
+
+  std::thread write_thread([this] {
+    ASSERT_OK(WriteRow(CreateSession(), 0 /* key */, 2 /* value */));
+  });
+  std::this_thread::sleep_for(1s);
+
+  // Waiting write does not hold locks, so the pending transaction could write the same key again.
+  ASSERT_OK(WriteRow(CreateSession(transaction), 0 /* key */, 3 /* value */));
+
+  // Non transactional write waits for pending transaction, instead of aborting it.
+  ASSERT_OK(transaction->CommitFuture().get());
+  write_thread.join();
+
+  auto value = ASSERT_RESULT(SelectRow(CreateSession(), 0 /* key */));
+  ASSERT_EQ(2, value);
+}
+
 void QLTransactionTest::TestReadOnlyTablets(IsolationLevel isolation_level,
                                             bool perform_write,
                                             bool written_intents_expected) {
@@ -81,6 +81,13 @@ void YBSession::SetRejectionScoreSource(RejectionScoreSourcePtr rejection_score_
   rejection_score_source_ = std::move(rejection_score_source);
 }
 
+void YBSession::SetFollowerReadMaxStaleness(MonoDelta max_staleness) {
+  if (batcher_) {
+    batcher_->SetFollowerReadMaxStaleness(max_staleness);
+  }
+  follower_read_max_staleness_ = max_staleness;
+}
+
 YBSession::~YBSession() {
   WARN_NOT_OK(Close(true), "Closed Session with pending operations.");
 }
@@ -143,6 +150,10 @@ std::future<Status> YBSession::FlushFuture() {
   return MakeFuture<Status>([this](auto callback) { this->FlushAsync(std::move(callback)); });
 }
 
+AsyncFuture<Status> YBSession::FlushAsyncFuture() {
+  return MakeAsyncFuture<Status>([this](auto callback) { this->FlushAsync(std::move(callback)); });
+}
+
 Status YBSession::ReadSync(std::shared_ptr<YBOperation> yb_op) {
   Synchronizer s;
   ReadAsync(std::move(yb_op), s.AsStatusFunctor());
@@ -202,6 +213,7 @@ internal::Batcher& YBSession::Batcher() {
       batcher_->SetTimeout(timeout_);
     }
     batcher_->SetRejectionScoreSource(rejection_score_source_);
+    batcher_->SetFollowerReadMaxStaleness(follower_read_max_staleness_);
     if (hybrid_time_for_write_.is_valid()) {
       batcher_->WriteWithHybridTime(hybrid_time_for_write_);
     }
@@ -226,13 +238,11 @@ Status YBSession::ApplyAndFlush(YBOperationPtr yb_op) {
 }
 
 Status YBSession::Apply(const std::vector<YBOperationPtr>& ops) {
-  auto& batcher = Batcher();
-  for (const auto& op : ops) {
-    Status s = batcher.Add(op);
-    if (!PREDICT_FALSE(s.ok())) {
-      error_collector_->AddError(op, s);
-      return s;
-    }
+  size_t num_added = 0;
+  Status s = Batcher().Add(ops, &num_added);
+  if (!PREDICT_FALSE(s.ok())) {
+    error_collector_->AddError(ops[num_added], s);
+    return s;
   }
   return Status::OK();
 }
@@ -21,6 +21,7 @@
 #include "yb/common/common_fwd.h"
 #include "yb/common/hybrid_time.h"
 
+#include "yb/util/async_future.h"
 #include "yb/util/async_util.h"
 #include "yb/util/locks.h"
 #include "yb/util/monotime.h"
@@ -187,6 +188,10 @@ class YBSession : public std::enable_shared_from_this<YBSession> {
   void FlushAsync(StatusFunctor callback);
   std::future<Status> FlushFuture();
 
+  // Same as FlushAsync, but returns a future, whose continuations are invoked by the thread that
+  // completes the flush, see AsyncFuture.
+  AsyncFuture<Status> FlushAsyncFuture();
+
   // Abort the unflushed or in-flight operations in the session.
   void Abort();
 
@@ -249,6 +254,11 @@ class YBSession : public std::enable_shared_from_this<YBSession> {
 
   void SetRejectionScoreSource(RejectionScoreSourcePtr rejection_score_source);
 
+  // Sets bounded staleness for reads with CONSISTENT_PREFIX consistency level. Such reads are sent
+  // to the replica with the lowest observed latency, and a follower serves them only when its safe
+  // time is not staler than max_staleness. Uninitialized value disables bounded staleness.
+  void SetFollowerReadMaxStaleness(MonoDelta max_staleness);
+
  private:
   friend class YBClient;
   friend class internal::Batcher;
@@ -292,6 +302,8 @@ class YBSession : public std::enable_shared_from_this<YBSession> {
 
   RejectionScoreSourcePtr rejection_score_source_;
 
+  MonoDelta follower_read_max_staleness_;
+
   DISALLOW_COPY_AND_ASSIGN(YBSession);
 };
 
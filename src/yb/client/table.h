@@ -14,6 +14,7 @@
 #ifndef YB_CLIENT_TABLE_H
 #define YB_CLIENT_TABLE_H
 
+#include "yb/client/hedged_read_policy.h"
 #include "yb/client/yb_table_name.h"
 #include "yb/client/schema.h"
 
@@ -94,6 +95,10 @@ class YBTable : public std::enable_shared_from_this<YBTable> {
   const IndexInfo& index_info() const;
 
   std::string ToString() const;
+
+  // Decides when reads of this table that could be served by any replica are hedged.
+  internal::HedgedReadPolicy& hedged_read_policy() const { return hedged_read_policy_; }
+
   //------------------------------------------------------------------------------------------------
   // CQL support
   // Create a new QL operation for this table.
@@ -135,6 +140,7 @@ class YBTable : public std::enable_shared_from_this<YBTable> {
   YBTableType table_type_;
   YBTableInfo info_;
   std::vector<std::string> partitions_;
+  mutable internal::HedgedReadPolicy hedged_read_policy_;
 
   DISALLOW_COPY_AND_ASSIGN(YBTable);
 };
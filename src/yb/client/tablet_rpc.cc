@@ -60,9 +60,24 @@ void TabletInvoker::SelectTabletServerWithConsistentPrefix() {
   TRACE_TO(trace_, "SelectTabletServerWithConsistentPrefix()");
 
   std::vector<RemoteTabletServer*> candidates;
-  current_ts_ = client_->data_->SelectTServer(tablet_.get(),
-                                              YBClient::ReplicaSelection::CLOSEST_REPLICA, {},
-                                              &candidates);
+  if (!bounded_staleness_) {
+    current_ts_ = client_->data_->SelectTServer(tablet_.get(),
+                                                YBClient::ReplicaSelection::CLOSEST_REPLICA, {},
+                                                &candidates);
+    VLOG(1) << "Using tserver: " << yb::ToString(current_ts_);
+    return;
+  }
+
+  std::set<std::string> blacklist;
+  for (const auto* ts : followers_) {
+    blacklist.insert(ts->permanent_uuid());
+  }
+  current_ts_ = client_->data_->SelectTServer(
+      tablet_.get(), YBClient::ReplicaSelection::LOWEST_LATENCY_REPLICA, blacklist, &candidates);
+  if (!current_ts_) {
+    // All replicas are too stale, the leader could always serve the read.
+    SelectTabletServer();
+  }
   VLOG(1) << "Using tserver: " << yb::ToString(current_ts_);
 }
 
@@ -211,9 +226,30 @@ void TabletInvoker::Execute(const std::string& tablet_id, bool leader_only) {
   VLOG(2) << "Tablet " << tablet_id_ << ": Writing batch to replica "
           << current_ts_->ToString();
 
+  send_time_ = MonoTime::Now();
   rpc_->SendRpcToTserver(retrier_->attempt_num());
 }
 
+bool TabletInvoker::CanHedge(int attempt_num) const {
+  return attempt_num == 1 && consistent_prefix_ && !local_tserver_only_ && tablet_ &&
+         current_ts_;
+}
+
+RemoteTabletServer* TabletInvoker::SelectHedgeTabletServer() {
+  std::set<std::string> blacklist;
+  blacklist.insert(current_ts_->permanent_uuid());
+  for (const auto* ts : followers_) {
+    blacklist.insert(ts->permanent_uuid());
+  }
+  std::vector<RemoteTabletServer*> candidates;
+  auto* result = client_->data_->SelectTServer(
+      tablet_.get(), YBClient::ReplicaSelection::LOWEST_LATENCY_REPLICA, blacklist, &candidates);
+  if (!result || !result->InitProxy(client_).ok()) {
+    return nullptr;
+  }
+  return result;
+}
+
 Status TabletInvoker::FailToNewReplica(const Status& reason,
                                        const tserver::TabletServerErrorPB* error_code) {
   if (ErrorCode(error_code) == tserver::TabletServerErrorPB::STALE_FOLLOWER) {
@@ -247,6 +283,12 @@ bool TabletInvoker::Done(Status* status) {
     return true;
   }
 
+  // Server responded, so the RPC time is a good estimate of its latency.
+  if (current_ts_ && send_time_.Initialized() && !status->IsNetworkError() &&
+      !status->IsTimedOut()) {
+    current_ts_->UpdateLatency(MonoTime::Now().GetDeltaSince(send_time_));
+  }
+
   // Prefer early failures over controller failures.
   if (status->ok() && retrier_->HandleResponse(command_, status)) {
     return false;
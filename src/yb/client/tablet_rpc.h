@@ -79,6 +79,18 @@ class TabletInvoker {
   const RemoteTabletServer& current_ts() { return *current_ts_; }
   bool local_tserver_only() const { return local_tserver_only_; }
 
+  // Bounded staleness reads go to the replica with the lowest latency, skipping replicas that
+  // rejected the read as stale followers. The leader is used when no such replica is left.
+  void set_bounded_staleness(bool value) { bounded_staleness_ = value; }
+
+  // Whether the RPC could be served by any replica, and could be hedged, i.e. sent to another
+  // replica as well, while it is sent to current_ts_ for the first time.
+  bool CanHedge(int attempt_num) const;
+
+  // Returns the replica with the lowest latency other than current_ts_, with initialized proxy,
+  // to send a hedged RPC to. Returns nullptr if there is no such replica.
+  RemoteTabletServer* SelectHedgeTabletServer();
+
  private:
   friend class TabletRpcTest;
   FRIEND_TEST(TabletRpcTest, TabletInvokerSelectTabletServerRace);
@@ -139,6 +151,11 @@ class TabletInvoker {
 
   const bool consistent_prefix_;
 
+  bool bounded_staleness_ = false;
+
+  // Time when the RPC was sent to current_ts_, used to learn latency of tablet servers.
+  MonoTime send_time_;
+
   // The TS receiving the write. May change if the write is retried.
   // RemoteTabletServer is taken from YBClient cache, so it is guaranteed that those objects are
   // alive while YBClient is alive. Because we don't delete them, but only add and update.
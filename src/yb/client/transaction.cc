@@ -46,6 +46,12 @@ DEFINE_uint64(transaction_heartbeat_usec, 500000, "Interval of transaction heart
 DEFINE_bool(transaction_disable_heartbeat_in_tests, false, "Disable heartbeat during test.");
 DEFINE_bool(transaction_disable_proactive_cleanup_in_tests, false,
             "Disable cleanup of intents in abort path.");
+DEFINE_bool(enable_transaction_heartbeat_batching, false,
+            "Send PENDING heartbeats of transactions that use the same status tablet in a single "
+            "UpdateTransactions RPC. All tablet servers of the cluster should support this RPC "
+            "before it is enabled.");
+TAG_FLAG(enable_transaction_heartbeat_batching, advanced);
+TAG_FLAG(enable_transaction_heartbeat_batching, runtime);
 DECLARE_uint64(max_clock_skew_usec);
 
 DEFINE_test_flag(int32, TEST_transaction_inject_flushed_delay_ms, 0,
@@ -603,6 +609,9 @@ class YBTransaction::Impl final {
       return;
     }
 
+    // Even when intents were written to a single tablet, commit goes through the status tablet.
+    // Other transactions could abort this one via its coordinator during conflict resolution, and
+    // the status tablet is the only place that arbitrates between such an abort and our commit.
     tserver::UpdateTransactionRequestPB req;
     req.set_tablet_id(status_tablet_->tablet_id());
     req.set_propagated_hybrid_time(manager_->Now().ToUint64());
@@ -813,6 +822,16 @@ class YBTransaction::Impl final {
       return;
     }
 
+    if (status == TransactionStatus::PENDING &&
+        GetAtomicFlag(&FLAGS_enable_transaction_heartbeat_batching)) {
+      // CREATED heartbeats are not batched, since the transaction waits for them before the
+      // first write.
+      manager_->SendHeartbeat(
+          status_tablet_, metadata_.transaction_id,
+          std::bind(&Impl::HeartbeatDone, this, _1, _2, status, transaction));
+      return;
+    }
+
     tserver::UpdateTransactionRequestPB req;
     req.set_tablet_id(status_tablet_->tablet_id());
     req.set_propagated_hybrid_time(manager_->Now().ToUint64());
@@ -1062,6 +1081,13 @@ std::future<Status> YBTransaction::CommitFuture(
   });
 }
 
+AsyncFuture<Status> YBTransaction::CommitAsyncFuture(
+    CoarseTimePoint deadline, SealOnly seal_only) {
+  return MakeAsyncFuture<Status>([this, deadline, seal_only](auto callback) {
+    impl_->Commit(AdjustDeadline(deadline), seal_only, std::move(callback));
+  });
+}
+
 void YBTransaction::Abort(CoarseTimePoint deadline) {
   impl_->Abort(AdjustDeadline(deadline));
 }
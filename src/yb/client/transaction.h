@@ -28,6 +28,7 @@
 
 #include "yb/client/client_fwd.h"
 
+#include "yb/util/async_future.h"
 #include "yb/util/async_util.h"
 #include "yb/util/status.h"
 
@@ -121,6 +122,11 @@ class YBTransaction : public std::enable_shared_from_this<YBTransaction> {
   std::future<Status> CommitFuture(
       CoarseTimePoint deadline = CoarseTimePoint(), SealOnly seal_only = SealOnly::kFalse);
 
+  // Utility function for Commit, that does not block a thread to wait for the result, see
+  // AsyncFuture.
+  AsyncFuture<Status> CommitAsyncFuture(
+      CoarseTimePoint deadline = CoarseTimePoint(), SealOnly seal_only = SealOnly::kFalse);
+
   // Aborts this transaction.
   void Abort(CoarseTimePoint deadline = CoarseTimePoint());
 
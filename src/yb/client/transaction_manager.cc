@@ -15,19 +15,42 @@
 
 #include "yb/client/transaction_manager.h"
 
+#include <unordered_map>
+
+#include "yb/rpc/messenger.h"
 #include "yb/rpc/rpc.h"
+#include "yb/rpc/scheduler.h"
 #include "yb/rpc/thread_pool.h"
 #include "yb/rpc/tasks_pool.h"
 
+#include "yb/util/flag_tags.h"
 #include "yb/util/random_util.h"
 #include "yb/util/thread_restrictions.h"
 
 #include "yb/client/client.h"
+#include "yb/client/meta_cache.h"
 
 #include "yb/common/transaction.h"
+#include "yb/common/wire_protocol.h"
 
+#include "yb/master/master.pb.h"
 #include "yb/master/master_defaults.h"
 
+#include "yb/tserver/tserver_service.pb.h"
+
+DEFINE_bool(prefer_region_local_status_tablets, true,
+            "Pick transaction status tablets, whose leaders are in the same cloud and region as "
+            "the client, when there are such tablets. So heartbeats and commits of transactions "
+            "don't cross regions.");
+TAG_FLAG(prefer_region_local_status_tablets, advanced);
+TAG_FLAG(prefer_region_local_status_tablets, runtime);
+
+DEFINE_int32(transaction_heartbeat_batch_window_ms, 5,
+             "Time to collect heartbeats of transactions that use the same status tablet before "
+             "sending them in a single UpdateTransactions RPC.");
+TAG_FLAG(transaction_heartbeat_batch_window_ms, advanced);
+TAG_FLAG(transaction_heartbeat_batch_window_ms, runtime);
+
 namespace yb {
 namespace client {
 
@@ -41,7 +64,40 @@ const YBTableName kTransactionTableName(
 // Resolved - final state, when all tablets are resolved and written to cache.
 YB_DEFINE_ENUM(TransactionTableStatus, (kExists)(kUpdating)(kResolved));
 
+struct TransactionTableState {
+  LocalTabletFilter local_tablet_filter;
+  std::atomic<TransactionTableStatus> status{TransactionTableStatus::kExists};
+  std::vector<TabletId> tablets;
+  // Tablets whose leaders were in the same region as the client, when tablets were resolved.
+  std::vector<TabletId> region_local_tablets;
+};
+
+bool SameRegion(const CloudInfoPB& lhs, const CloudInfoPB& rhs) {
+  return lhs.placement_cloud() == rhs.placement_cloud() &&
+         lhs.placement_region() == rhs.placement_region();
+}
+
+std::vector<TabletId> RegionLocalTablets(
+    const CloudInfoPB& client_cloud_info,
+    const std::vector<master::TabletLocationsPB>& locations) {
+  std::vector<TabletId> result;
+  if (!client_cloud_info.has_placement_region()) {
+    return result;
+  }
+  for (const auto& location : locations) {
+    for (const auto& replica : location.replicas()) {
+      if (replica.role() == consensus::RaftPeerPB::LEADER &&
+          SameRegion(replica.ts_info().cloud_info(), client_cloud_info)) {
+        result.push_back(location.tablet_id());
+        break;
+      }
+    }
+  }
+  return result;
+}
+
 void InvokeCallback(const LocalTabletFilter& filter, const std::vector<TabletId>& tablets,
+                    const std::vector<TabletId>& region_local_tablets,
                     const PickStatusTabletCallback& callback) {
   if (filter) {
     std::vector<const TabletId*> ids;
@@ -56,15 +112,13 @@ void InvokeCallback(const LocalTabletFilter& filter, const std::vector<TabletId>
     }
     LOG(WARNING) << "No local transaction status tablet";
   }
+  if (FLAGS_prefer_region_local_status_tablets && !region_local_tablets.empty()) {
+    callback(RandomElement(region_local_tablets));
+    return;
+  }
   callback(RandomElement(tablets));
 }
 
-struct TransactionTableState {
-  LocalTabletFilter local_tablet_filter;
-  std::atomic<TransactionTableStatus> status{TransactionTableStatus::kExists};
-  std::vector<TabletId> tablets;
-};
-
 // Picks status tablet for transaction.
 class PickStatusTabletTask {
  public:
@@ -78,7 +132,9 @@ class PickStatusTabletTask {
   void Run() {
     // TODO(dtxn) async
     std::vector<TabletId> tablets;
-    auto status = client_->GetTablets(kTransactionTableName, 0, &tablets, /* ranges */ nullptr);
+    std::vector<master::TabletLocationsPB> locations;
+    auto status = client_->GetTablets(
+        kTransactionTableName, 0, &tablets, /* ranges */ nullptr, &locations);
     if (!status.ok()) {
       VLOG(1) << "Failed to get tablets of txn status table: " << status;
       callback_(status);
@@ -90,14 +146,17 @@ class PickStatusTabletTask {
       callback_(s);
       return;
     }
+    auto region_local_tablets = RegionLocalTablets(client_->cloud_info(), locations);
     auto expected = TransactionTableStatus::kExists;
     if (table_state_->status.compare_exchange_strong(
         expected, TransactionTableStatus::kUpdating, std::memory_order_acq_rel)) {
+      VLOG(1) << "Region local status tablets: " << yb::ToString(region_local_tablets);
       table_state_->tablets = tablets;
+      table_state_->region_local_tablets = region_local_tablets;
       table_state_->status.store(TransactionTableStatus::kResolved, std::memory_order_release);
     }
 
-    InvokeCallback(table_state_->local_tablet_filter, tablets, callback_);
+    InvokeCallback(table_state_->local_tablet_filter, tablets, region_local_tablets, callback_);
   }
 
   void Done(const Status& status) {
@@ -123,7 +182,8 @@ class InvokeCallbackTask {
   }
 
   void Run() {
-    InvokeCallback(table_state_->local_tablet_filter, table_state_->tablets, callback_);
+    InvokeCallback(table_state_->local_tablet_filter, table_state_->tablets,
+                   table_state_->region_local_tablets, callback_);
   }
 
   void Done(const Status& status) {
@@ -138,6 +198,147 @@ class InvokeCallbackTask {
   PickStatusTabletCallback callback_;
 };
 
+// Coalesces PENDING heartbeats of transactions, that use the same status tablet, into a single
+// UpdateTransactions RPC per status tablet.
+class HeartbeatBatcher : public std::enable_shared_from_this<HeartbeatBatcher> {
+ public:
+  HeartbeatBatcher(YBClient* client, const scoped_refptr<ClockBase>& clock, rpc::Rpcs* rpcs)
+      : client_(client), clock_(clock), rpcs_(rpcs) {
+  }
+
+  ~HeartbeatBatcher() {
+    // Scheduled flush holds a weak pointer only, so heartbeats that were not sent yet should be
+    // failed here.
+    for (const auto& p : batches_) {
+      p.second->Fail(STATUS(Aborted, "Transaction manager shutdown"));
+    }
+  }
+
+  HeartbeatBatcher(const HeartbeatBatcher&) = delete;
+  void operator=(const HeartbeatBatcher&) = delete;
+
+  void Add(const internal::RemoteTabletPtr& status_tablet, const TransactionId& id,
+           UpdateTransactionCallback callback) {
+    bool schedule_flush = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto& batch = batches_[status_tablet->tablet_id()];
+      if (!batch) {
+        batch = std::make_shared<Batch>(status_tablet, rpcs_->InvalidHandle());
+      }
+      auto& state = *batch->request.add_state();
+      state.set_transaction_id(id.begin(), id.size());
+      state.set_status(TransactionStatus::PENDING);
+      batch->callbacks.push_back(std::move(callback));
+      if (!flush_scheduled_) {
+        flush_scheduled_ = true;
+        schedule_flush = true;
+      }
+    }
+
+    if (schedule_flush) {
+      std::weak_ptr<HeartbeatBatcher> weak_self = shared_from_this();
+      client_->messenger()->scheduler().Schedule(
+          [weak_self](const Status& status) {
+            auto self = weak_self.lock();
+            if (self) {
+              self->Flush(status);
+            }
+          },
+          std::chrono::milliseconds(FLAGS_transaction_heartbeat_batch_window_ms));
+    }
+  }
+
+ private:
+  struct Batch {
+    internal::RemoteTabletPtr status_tablet;
+    tserver::UpdateTransactionsRequestPB request;
+    std::vector<UpdateTransactionCallback> callbacks;
+    rpc::Rpcs::Handle handle;
+
+    Batch(internal::RemoteTabletPtr tablet, rpc::Rpcs::Handle invalid_handle)
+        : status_tablet(std::move(tablet)), handle(invalid_handle) {}
+
+    void Fail(const Status& status) {
+      for (const auto& callback : callbacks) {
+        callback(status, tserver::UpdateTransactionResponsePB());
+      }
+      callbacks.clear();
+    }
+  };
+  typedef std::shared_ptr<Batch> BatchPtr;
+
+  void Flush(const Status& status) {
+    decltype(batches_) batches;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      flush_scheduled_ = false;
+      batches.swap(batches_);
+    }
+    for (const auto& p : batches) {
+      if (!status.ok()) {
+        // Flush was aborted, most likely because the messenger is shutting down.
+        p.second->Fail(status);
+      } else {
+        Send(p.second);
+      }
+    }
+  }
+
+  void Send(const BatchPtr& batch) {
+    auto& request = batch->request;
+    request.set_tablet_id(batch->status_tablet->tablet_id());
+    request.set_propagated_hybrid_time(clock_->Now().ToUint64());
+    auto* rpcs = rpcs_;
+    rpcs->RegisterAndStart(
+        UpdateTransactions(
+            TransactionRpcDeadline(),
+            batch->status_tablet.get(),
+            client_,
+            &request,
+            [batch, rpcs](const Status& status,
+                          const tserver::UpdateTransactionsResponsePB& response) {
+              rpcs->Unregister(&batch->handle);
+              ProcessResponse(batch, status, response);
+            }),
+        &batch->handle);
+    if (batch->handle == rpcs->InvalidHandle()) {
+      batch->Fail(STATUS(Aborted, "Transaction manager shutdown"));
+    }
+  }
+
+  static void ProcessResponse(
+      const BatchPtr& batch, const Status& status,
+      const tserver::UpdateTransactionsResponsePB& response) {
+    if (!status.ok()) {
+      batch->Fail(status);
+      return;
+    }
+    if (static_cast<size_t>(response.statuses_size()) != batch->callbacks.size()) {
+      batch->Fail(STATUS_FORMAT(
+          IllegalState, "Wrong number of heartbeat statuses: $0, while $1 expected",
+          response.statuses_size(), batch->callbacks.size()));
+      return;
+    }
+    tserver::UpdateTransactionResponsePB entry_response;
+    if (response.has_propagated_hybrid_time()) {
+      entry_response.set_propagated_hybrid_time(response.propagated_hybrid_time());
+    }
+    for (size_t i = 0; i != batch->callbacks.size(); ++i) {
+      batch->callbacks[i](StatusFromPB(response.statuses(static_cast<int>(i))), entry_response);
+    }
+    batch->callbacks.clear();
+  }
+
+  YBClient* const client_;
+  scoped_refptr<ClockBase> clock_;
+  rpc::Rpcs* const rpcs_;
+
+  std::mutex mutex_;
+  std::unordered_map<TabletId, BatchPtr> batches_;
+  bool flush_scheduled_ = false;
+};
+
 constexpr size_t kQueueLimit = 150;
 constexpr size_t kMaxWorkers = 50;
 
@@ -152,14 +353,16 @@ class TransactionManager::Impl {
         table_state_{std::move(local_tablet_filter)},
         thread_pool_("TransactionManager", kQueueLimit, kMaxWorkers),
         tasks_pool_(kQueueLimit),
-        invoke_callback_tasks_(kQueueLimit) {
+        invoke_callback_tasks_(kQueueLimit),
+        heartbeat_batcher_(std::make_shared<HeartbeatBatcher>(client, clock, &rpcs_)) {
     CHECK(clock);
   }
 
   void PickStatusTablet(PickStatusTabletCallback callback) {
     if (table_state_.status.load(std::memory_order_acquire) == TransactionTableStatus::kResolved) {
       if (ThreadRestrictions::IsWaitAllowed()) {
-        InvokeCallback(table_state_.local_tablet_filter, table_state_.tablets, callback);
+        InvokeCallback(table_state_.local_tablet_filter, table_state_.tablets,
+                       table_state_.region_local_tablets, callback);
       } else if (!invoke_callback_tasks_.Enqueue(&thread_pool_, &table_state_, callback)) {
         callback(STATUS_FORMAT(ServiceUnavailable,
                               "Invoke callback queue overflow, number of tasks: $0",
@@ -172,6 +375,11 @@ class TransactionManager::Impl {
     }
   }
 
+  void SendHeartbeat(const internal::RemoteTabletPtr& status_tablet, const TransactionId& id,
+                     UpdateTransactionCallback callback) {
+    heartbeat_batcher_->Add(status_tablet, id, std::move(callback));
+  }
+
   const scoped_refptr<ClockBase>& clock() const {
     return clock_;
   }
@@ -199,6 +407,7 @@ class TransactionManager::Impl {
   void Shutdown() {
     rpcs_.Shutdown();
     thread_pool_.Shutdown();
+    heartbeat_batcher_.reset();
   }
 
  private:
@@ -210,6 +419,7 @@ class TransactionManager::Impl {
   yb::rpc::TasksPool<PickStatusTabletTask> tasks_pool_;
   yb::rpc::TasksPool<InvokeCallbackTask> invoke_callback_tasks_;
   yb::rpc::Rpcs rpcs_;
+  std::shared_ptr<HeartbeatBatcher> heartbeat_batcher_;
 };
 
 TransactionManager::TransactionManager(
@@ -225,6 +435,12 @@ void TransactionManager::PickStatusTablet(PickStatusTabletCallback callback) {
   impl_->PickStatusTablet(std::move(callback));
 }
 
+void TransactionManager::SendHeartbeat(
+    const internal::RemoteTabletPtr& status_tablet, const TransactionId& id,
+    UpdateTransactionCallback callback) {
+  impl_->SendHeartbeat(status_tablet, id, std::move(callback));
+}
+
 YBClient* TransactionManager::client() const {
   return impl_->client();
 }
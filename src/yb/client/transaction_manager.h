@@ -20,9 +20,11 @@
 #include <memory>
 
 #include "yb/client/client_fwd.h"
+#include "yb/client/transaction_rpc.h"
 
 #include "yb/common/clock.h"
 #include "yb/common/hybrid_time.h"
+#include "yb/common/transaction.h"
 
 #include "yb/rpc/rpc_fwd.h"
 
@@ -42,6 +44,13 @@ class TransactionManager {
 
   void PickStatusTablet(PickStatusTabletCallback callback);
 
+  // Sends PENDING heartbeat of the transaction with the specified id. Heartbeats of transactions
+  // that use the same status tablet are collected during transaction_heartbeat_batch_window_ms
+  // and sent in a single UpdateTransactions RPC. Callback receives the status of this transaction
+  // heartbeat.
+  void SendHeartbeat(const internal::RemoteTabletPtr& status_tablet, const TransactionId& id,
+                     UpdateTransactionCallback callback);
+
   rpc::Rpcs& rpcs();
   YBClient* client() const;
 
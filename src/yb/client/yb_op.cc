@@ -625,6 +625,10 @@ Status YBPgsqlReadOp::GetPartitionKey(string* partition_key) const {
       const uint16 hash_code = VERIFY_RESULT(docdb::DocKey::DecodeHash(ybctid.binary_value()));
       read_request_->set_hash_code(hash_code);
       *partition_key = PartitionSchema::EncodeMultiColumnHashValue(hash_code);
+    } else if (read_request_->has_hash_code()) {
+      // Scan is limited to a hash range, so start it from the lower bound of the range.
+      *partition_key = PartitionSchema::EncodeMultiColumnHashValue(
+          static_cast<uint16>(read_request_->hash_code()));
     } else {
       // Default to empty key, this will start a scan from the beginning.
       partition_key->clear();
@@ -15,8 +15,10 @@
 #include <rapidjson/prettywriter.h>
 
 #include "yb/common/jsonb.h"
+#include "yb/common/ql_value.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/test_util.h"
+#include "yb/util/varint.h"
 
 using std::to_string;
 using std::numeric_limits;
@@ -151,5 +153,89 @@ TEST(JsonbTest, TestArrays) {
   VerifyArray(document);
 }
 
+namespace {
+
+void AddPathElement(const std::string& key,
+                    google::protobuf::RepeatedPtrField<QLJsonOperationPB>* path) {
+  auto* op = path->Add();
+  op->set_json_operator(JsonOperatorPB::JSON_OBJECT);
+  op->mutable_operand()->mutable_value()->set_string_value(key);
+}
+
+void AddPathElement(int64_t index, google::protobuf::RepeatedPtrField<QLJsonOperationPB>* path) {
+  auto* op = path->Add();
+  op->set_json_operator(JsonOperatorPB::JSON_OBJECT);
+  op->mutable_operand()->mutable_value()->set_varint_value(
+      util::VarInt(index).EncodeToComparable());
+}
+
+std::string ReplaceElement(const std::string& json,
+                           const google::protobuf::RepeatedPtrField<QLJsonOperationPB>& path,
+                           const std::string& value_json) {
+  Jsonb jsonb, value;
+  CHECK_OK(jsonb.FromString(json));
+  CHECK_OK(value.FromString(value_json));
+  std::string result;
+  CHECK_OK(Jsonb::ReplaceElement(jsonb.SerializedJsonb(), path, value.SerializedJsonb(),
+                                 &result));
+  std::string result_json;
+  CHECK_OK(Jsonb(result).ToJsonString(&result_json));
+  return result_json;
+}
+
+} // namespace
+
+TEST(JsonbTest, TestReplaceElement) {
+  const std::string json = R"#({"a": {"b": "text", "c": [1, 2, {"d": 3}]}, "e": 10})#";
+
+  google::protobuf::RepeatedPtrField<QLJsonOperationPB> path;
+  AddPathElement("e", &path);
+  ASSERT_EQ(R"#({"a":{"b":"text","c":[1,2,{"d":3}]},"e":"longer value"})#",
+            ReplaceElement(json, path, R"#("longer value")#"));
+
+  path.Clear();
+  AddPathElement("a", &path);
+  AddPathElement("b", &path);
+  ASSERT_EQ(R"#({"a":{"b":{"x":[true,null]},"c":[1,2,{"d":3}]},"e":10})#",
+            ReplaceElement(json, path, R"#({"x": [true, null]})#"));
+
+  path.Clear();
+  AddPathElement("a", &path);
+  AddPathElement("c", &path);
+  AddPathElement(2, &path);
+  AddPathElement("d", &path);
+  ASSERT_EQ(R"#({"a":{"b":"text","c":[1,2,{"d":false}]},"e":10})#",
+            ReplaceElement(json, path, "false"));
+
+  path.Clear();
+  AddPathElement("a", &path);
+  AddPathElement("c", &path);
+  AddPathElement(0, &path);
+  ASSERT_EQ(R"#({"a":{"b":"text","c":["x",2,{"d":3}]},"e":10})#",
+            ReplaceElement(json, path, R"#("x")#"));
+
+  // Paths that don't point to an existing element.
+  Jsonb jsonb, value;
+  ASSERT_OK(jsonb.FromString(json));
+  ASSERT_OK(value.FromString("1"));
+  std::string result;
+  const std::vector<std::vector<std::string>> missing_paths = {{"f"}, {"e", "f"}, {"a", "c", "d"}};
+  for (const auto& missing : missing_paths) {
+    path.Clear();
+    for (const auto& key : missing) {
+      AddPathElement(key, &path);
+    }
+    auto status = Jsonb::ReplaceElement(jsonb.SerializedJsonb(), path, value.SerializedJsonb(),
+                                        &result);
+    ASSERT_TRUE(status.IsNotFound()) << status;
+  }
+  path.Clear();
+  AddPathElement("a", &path);
+  AddPathElement("c", &path);
+  AddPathElement(3, &path);
+  ASSERT_TRUE(Jsonb::ReplaceElement(jsonb.SerializedJsonb(), path, value.SerializedJsonb(),
+                                    &result).IsNotFound());
+}
+
 }  // namespace common
 }  // namespace yb
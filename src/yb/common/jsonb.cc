@@ -678,38 +678,165 @@ Status Jsonb::ApplyJsonbOperatorToObject(const Slice& jsonb, const QLJsonOperati
   }
 
   size_t num_kv_pairs = GetCount(jsonb_header);
-  const string& search_key = json_op.operand().value().string_value();
+  const size_t index = VERIFY_RESULT(FindObjectKey(
+      jsonb, num_kv_pairs, json_op.operand().value().string_value()));
+  return GetObjectValue(index, jsonb, sizeof(jsonb_header),
+                        ComputeDataOffset(num_kv_pairs, kJBObject), num_kv_pairs,
+                        result, element_metadata);
+}
 
-  size_t metadata_begin_offset = sizeof(jsonb_header);
+Result<size_t> Jsonb::FindObjectKey(const Slice& jsonb, size_t num_kv_pairs,
+                                    const Slice& search_key) {
+  size_t metadata_begin_offset = sizeof(JsonbHeader);
   size_t data_begin_offset = ComputeDataOffset(num_kv_pairs, kJBObject);
 
   // Binary search to find the key.
   int64_t low = 0, high = num_kv_pairs - 1;
-  auto search_key_slice = Slice(search_key);
   while (low <= high) {
     size_t mid = low + (high - low)/2;
     Slice mid_key;
     RETURN_NOT_OK(GetObjectKey(mid, jsonb, metadata_begin_offset, data_begin_offset, &mid_key));
 
-    if (mid_key == search_key_slice) {
-      RETURN_NOT_OK(GetObjectValue(mid, jsonb, sizeof(jsonb_header),
-                                   ComputeDataOffset(num_kv_pairs, kJBObject), num_kv_pairs,
-                                   result, element_metadata));
-      return Status::OK();
-    } else if (mid_key.ToBuffer() > search_key) {
+    const int cmp = mid_key.compare(search_key);
+    if (cmp == 0) {
+      return mid;
+    } else if (cmp > 0) {
       high = mid - 1;
     } else {
       low = mid + 1;
     }
   }
-  return STATUS_SUBSTITUTE(NotFound, "Couldn't find key $0 in json document", search_key);
+  return STATUS_SUBSTITUTE(NotFound, "Couldn't find key $0 in json document",
+                           search_key.ToBuffer());
+}
+
+Result<size_t> Jsonb::FindElementIndex(const Slice& jsonb, const QLJsonOperationPB& json_op) {
+  if (jsonb.size() < sizeof(JsonbHeader)) {
+    return STATUS(InvalidArgument, "Not enough data to process");
+  }
+
+  JsonbHeader jsonb_header = BigEndian::Load32(jsonb.data());
+  const size_t num_entries = GetCount(jsonb_header);
+  if ((jsonb_header & kJBScalar) && (jsonb_header & kJBArray)) {
+    return STATUS(NotFound, "Cannot apply operators to scalar values");
+  } else if (jsonb_header & kJBArray) {
+    if (!json_op.operand().value().has_varint_value()) {
+      return STATUS_SUBSTITUTE(NotFound, "Couldn't apply json operator");
+    }
+    util::VarInt varint;
+    RETURN_NOT_OK(varint.DecodeFromComparable(json_op.operand().value().varint_value()));
+    int64_t array_index = VERIFY_RESULT(varint.ToInt64());
+    if (array_index < 0 || array_index >= num_entries) {
+      return STATUS_SUBSTITUTE(NotFound, "Array index: $0 out of bounds [0, $1)",
+                               array_index, num_entries);
+    }
+    return array_index;
+  } else if (jsonb_header & kJBObject) {
+    if (!json_op.operand().value().has_string_value()) {
+      return STATUS_SUBSTITUTE(NotFound, "Couldn't apply json operator");
+    }
+    // Value JEntries follow the JEntries of all keys.
+    return num_entries + VERIFY_RESULT(FindObjectKey(
+        jsonb, num_entries, json_op.operand().value().string_value()));
+  }
+
+  return STATUS(InvalidArgument, "Invalid json operation");
+}
+
+Status Jsonb::ReplaceElement(
+    const Slice& jsonb, const google::protobuf::RepeatedPtrField<QLJsonOperationPB>& path,
+    const Slice& value, std::string* result) {
+  if (path.empty()) {
+    return STATUS(InvalidArgument, "Json path is empty");
+  }
+  if (value.size() < sizeof(JsonbHeader)) {
+    return STATUS(InvalidArgument, "Not enough data to process");
+  }
+
+  // Scalars are serialized as an array with one element, but only the element itself is stored
+  // within a container.
+  JsonbHeader value_header = BigEndian::Load32(value.data());
+  if ((value_header & kJBScalar) && (value_header & kJBArray)) {
+    Slice scalar;
+    JEntry scalar_metadata;
+    RETURN_NOT_OK(GetArrayElement(0, value, sizeof(JsonbHeader), ComputeDataOffset(1, kJBArray),
+                                  &scalar, &scalar_metadata));
+    return ReplaceElementInternal(jsonb, path, 0, scalar, scalar_metadata, result);
+  }
+  const JEntry value_metadata = (value_header & kJBObject) ? kJEIsObject : kJEIsArray;
+  return ReplaceElementInternal(jsonb, path, 0, value, value_metadata, result);
+}
+
+Status Jsonb::ReplaceElementInternal(
+    const Slice& jsonb, const google::protobuf::RepeatedPtrField<QLJsonOperationPB>& path,
+    int path_index, const Slice& value, JEntry value_metadata, std::string* result) {
+  const size_t index = VERIFY_RESULT(FindElementIndex(jsonb, path.Get(path_index)));
+
+  JsonbHeader jsonb_header = BigEndian::Load32(jsonb.data());
+  const size_t data_begin_offset = ComputeDataOffset(GetCount(jsonb_header), jsonb_header);
+  const size_t element_metadata_offset = sizeof(JsonbHeader) + index * sizeof(JEntry);
+  if (data_begin_offset > jsonb.size()) {
+    return STATUS(Corruption, "json metadata out of bounds of serialized jsonb");
+  }
+
+  const JEntry element_metadata = BigEndian::Load32(jsonb.data() + element_metadata_offset);
+  const size_t element_begin = index == 0 ? 0 : GetOffset(
+      BigEndian::Load32(jsonb.data() + element_metadata_offset - sizeof(JEntry)));
+  const size_t element_end = GetOffset(element_metadata);
+  if (element_begin > element_end || data_begin_offset + element_end > jsonb.size()) {
+    return STATUS(Corruption, "json value out of bounds of serialized jsonb");
+  }
+  const Slice element(jsonb.data() + data_begin_offset + element_begin,
+                      element_end - element_begin);
+
+  Slice new_element = value;
+  JEntry new_element_metadata = value_metadata;
+  std::string nested;
+  if (path_index + 1 < path.size()) {
+    if (IsScalar(element_metadata)) {
+      return STATUS(NotFound, "Cannot apply operators to scalar values");
+    }
+    RETURN_NOT_OK(ReplaceElementInternal(element, path, path_index + 1, value, value_metadata,
+                                         &nested));
+    new_element = nested;
+    new_element_metadata = element_metadata;
+  }
+
+  // The header and the JEntries of the preceding elements are not changed, while the end offsets
+  // of the replaced element and all elements following it are shifted by the change of size.
+  result->clear();
+  result->reserve(jsonb.size() + new_element.size() - element.size());
+  result->append(jsonb.cdata(), element_metadata_offset);
+  for (size_t metadata_offset = element_metadata_offset; metadata_offset < data_begin_offset;
+       metadata_offset += sizeof(JEntry)) {
+    const JEntry jentry = BigEndian::Load32(jsonb.data() + metadata_offset);
+    const size_t end_offset = GetOffset(jentry) + new_element.size() - element.size();
+    if (end_offset > kJEOffsetMask) {
+      return STATUS(InvalidArgument, "Serialized jsonb is too large");
+    }
+    const uint32_t type = GetJEType(
+        metadata_offset == element_metadata_offset ? new_element_metadata : jentry);
+    char buffer[sizeof(JEntry)];
+    BigEndian::Store32(buffer, GetOffset(end_offset) | type);
+    result->append(buffer, sizeof(buffer));
+  }
+  result->append(jsonb.cdata() + data_begin_offset, element_begin);
+  result->append(new_element.cdata(), new_element.size());
+  result->append(element.cdata() + element.size(),
+                 jsonb.size() - data_begin_offset - element_end);
+  return Status::OK();
 }
 
 Status Jsonb::ApplyJsonbOperators(const QLJsonColumnOperationsPB& json_ops, QLValue* result) const {
+  return ApplyJsonbOperators(serialized_jsonb_, json_ops, result);
+}
+
+Status Jsonb::ApplyJsonbOperators(const Slice& jsonb, const QLJsonColumnOperationsPB& json_ops,
+                                  QLValue* result) {
   const int num_ops = json_ops.json_operations().size();
 
   Slice jsonop_result;
-  Slice operand(serialized_jsonb_);
+  Slice operand(jsonb);
   JEntry element_metadata;
   for (int i = 0; i < num_ops; i++) {
     const QLJsonOperationPB &op = json_ops.json_operations().Get(i);
@@ -14,10 +14,13 @@
 #ifndef YB_COMMON_JSONB_H
 #define YB_COMMON_JSONB_H
 
+#include <google/protobuf/repeated_field.h>
+
 #include <rapidjson/document.h>
 
 #include "yb/common/common_fwd.h"
 
+#include "yb/util/result.h"
 #include "yb/util/status.h"
 
 namespace yb {
@@ -84,6 +87,21 @@ class Jsonb {
   CHECKED_STATUS ApplyJsonbOperators(const QLJsonColumnOperationsPB& json_ops,
                                      QLValue* result) const;
 
+  // Same as above, but applies the operators to the provided serialized jsonb, so that the
+  // column value doesn't have to be copied to evaluate the operators.
+  static CHECKED_STATUS ApplyJsonbOperators(const Slice& jsonb,
+                                            const QLJsonColumnOperationsPB& json_ops,
+                                            QLValue* result);
+
+  // Replaces the element of the serialized jsonb, located by the given path of json operations,
+  // with the serialized jsonb value. The value is spliced into the serialized document, only the
+  // offsets of the containers along the path are updated, and the rest of the document is copied
+  // as is, without being deserialized. Returns NotFound if the path doesn't point to an existing
+  // element.
+  static CHECKED_STATUS ReplaceElement(
+      const Slice& jsonb, const google::protobuf::RepeatedPtrField<QLJsonOperationPB>& path,
+      const Slice& value, std::string* result);
+
   const std::string& SerializedJsonb() const;
 
   // Use with extreme care since this destroys the internal state of the object. The only purpose
@@ -186,6 +204,20 @@ class Jsonb {
                                                    Slice* result,
                                                    JEntry* element_metadata);
 
+  // Returns index of the element of the serialized jsonb container, that json_op refers to.
+  // The index is the position of the element's JEntry among all JEntries of the container.
+  static Result<size_t> FindElementIndex(const Slice& jsonb, const QLJsonOperationPB& json_op);
+
+  // Binary searches the serialized jsonb object for the key, and returns its index.
+  static Result<size_t> FindObjectKey(const Slice& jsonb, size_t num_kv_pairs,
+                                      const Slice& search_key);
+
+  // Implements ReplaceElement for the part of the path starting at path_index, where the value
+  // entry is the metadata of the spliced value.
+  static CHECKED_STATUS ReplaceElementInternal(
+      const Slice& jsonb, const google::protobuf::RepeatedPtrField<QLJsonOperationPB>& path,
+      int path_index, const Slice& value, JEntry value_entry, std::string* result);
+
   static inline size_t GetOffset(JEntry metadata) { return metadata & kJEOffsetMask; }
 
   static inline uint32_t GetJEType(JEntry metadata) { return metadata & kJETypeMask; }
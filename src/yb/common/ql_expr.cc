@@ -4,6 +4,9 @@
 
 #include "yb/common/ql_expr.h"
 
+#include <algorithm>
+#include <map>
+
 #include "yb/common/ql_bfunc.h"
 #include "yb/common/ql_value.h"
 #include "yb/common/jsonb.h"
@@ -46,11 +49,12 @@ CHECKED_STATUS QLExprExecutor::EvalExpr(const QLExpressionPB& ql_expr,
       break;
 
     case QLExpressionPB::ExprCase::kJsonColumn: {
-      QLValue ql_value;
+      // Operators are applied to the column value in place, so only the requested fragment of
+      // the document is decoded and copied to the result.
       const QLJsonColumnOperationsPB& json_ops = ql_expr.json_column();
-      RETURN_NOT_OK(table_row.ReadColumn(json_ops.column_id(), &ql_value));
-      common::Jsonb jsonb(std::move(ql_value.jsonb_value()));
-      RETURN_NOT_OK(jsonb.ApplyJsonbOperators(json_ops, result));
+      const QLValuePB* column_value = table_row.GetColumn(json_ops.column_id());
+      const Slice jsonb = column_value ? Slice(column_value->jsonb_value()) : Slice();
+      RETURN_NOT_OK(common::Jsonb::ApplyJsonbOperators(jsonb, json_ops, result));
       break;
     }
 
@@ -171,29 +175,31 @@ CHECKED_STATUS QLExprExecutor::EvalCondition(const QLConditionPB& condition,
 CHECKED_STATUS QLExprExecutor::EvalCondition(const QLConditionPB& condition,
                                              const QLTableRow& table_row,
                                              QLValue *result) {
+// Operands are evaluated in place when they are constants or column references, so evaluating a
+// condition for a row does not copy the values of the request or of the row.
 #define QL_EVALUATE_RELATIONAL_OP(op)                                                              \
   do {                                                                                             \
     CHECK_EQ(operands.size(), 2);                                                                  \
-    QLValue left, right;                                                                           \
-    RETURN_NOT_OK(EvalExpr(operands.Get(0), table_row, &left));                                    \
-    RETURN_NOT_OK(EvalExpr(operands.Get(1), table_row, &right));                                   \
-    if (!left.Comparable(right))                                                                   \
+    QLValue left_temp, right_temp;                                                                 \
+    const QLValuePB* left = VERIFY_RESULT(EvalOperand(operands.Get(0), table_row, &left_temp));    \
+    const QLValuePB* right = VERIFY_RESULT(EvalOperand(operands.Get(1), table_row, &right_temp));  \
+    if (!Comparable(*left, *right))                                                                \
       return STATUS(RuntimeError, "values not comparable");                                        \
-    result->set_bool_value(left.value() op right.value());                                         \
+    result->set_bool_value(*left op *right);                                                       \
     return Status::OK();                                                                           \
   } while (false)
 
 #define QL_EVALUATE_BETWEEN(op1, op2, rel_op)                                                      \
   do {                                                                                             \
       CHECK_EQ(operands.size(), 3);                                                                \
-      QLValue lower, upper;                                                                        \
-      RETURN_NOT_OK(EvalExpr(operands.Get(0), table_row, &temp));                                  \
-      RETURN_NOT_OK(EvalExpr(operands.Get(1), table_row, &lower));                                 \
-      RETURN_NOT_OK(EvalExpr(operands.Get(2), table_row, &upper));                                 \
-      if (!temp.Comparable(lower) || !temp.Comparable(upper)) {                                    \
+      QLValue lower_temp, upper_temp;                                                              \
+      const QLValuePB* value = VERIFY_RESULT(EvalOperand(operands.Get(0), table_row, &temp));      \
+      const QLValuePB* lower = VERIFY_RESULT(EvalOperand(operands.Get(1), table_row, &lower_temp));\
+      const QLValuePB* upper = VERIFY_RESULT(EvalOperand(operands.Get(2), table_row, &upper_temp));\
+      if (!Comparable(*value, *lower) || !Comparable(*value, *upper)) {                            \
         return STATUS(RuntimeError, "values not comparable");                                      \
       }                                                                                            \
-      result->set_bool_value(temp.value() op1 lower.value() rel_op temp.value() op2 upper.value());\
+      result->set_bool_value(*value op1 *lower rel_op *value op2 *upper);                          \
       return Status::OK();                                                                         \
   } while (false)
 
@@ -209,14 +215,14 @@ CHECKED_STATUS QLExprExecutor::EvalCondition(const QLConditionPB& condition,
 
     case QL_OP_IS_NULL:
       CHECK_EQ(operands.size(), 1);
-      RETURN_NOT_OK(EvalExpr(operands.Get(0), table_row, &temp));
-      result->set_bool_value(temp.IsNull());
+      result->set_bool_value(
+          IsNull(*VERIFY_RESULT(EvalOperand(operands.Get(0), table_row, &temp))));
       return Status::OK();
 
     case QL_OP_IS_NOT_NULL:
       CHECK_EQ(operands.size(), 1);
-      RETURN_NOT_OK(EvalExpr(operands.Get(0), table_row, &temp));
-      result->set_bool_value(!temp.IsNull());
+      result->set_bool_value(
+          !IsNull(*VERIFY_RESULT(EvalOperand(operands.Get(0), table_row, &temp))));
       return Status::OK();
 
     case QL_OP_IS_TRUE:
@@ -295,16 +301,16 @@ CHECKED_STATUS QLExprExecutor::EvalCondition(const QLConditionPB& condition,
 
     case QL_OP_IN: {
       CHECK_EQ(operands.size(), 2);
-      QLValue left, right;
-      RETURN_NOT_OK(EvalExpr(operands.Get(0), table_row, &left));
-      RETURN_NOT_OK(EvalExpr(operands.Get(1), table_row, &right));
+      QLValue left_temp, right_temp;
+      const QLValuePB* left = VERIFY_RESULT(EvalOperand(operands.Get(0), table_row, &left_temp));
+      const QLValuePB* right = VERIFY_RESULT(EvalOperand(operands.Get(1), table_row, &right_temp));
 
       result->set_bool_value(false);
-      for (const QLValuePB& elem : right.list_value().elems()) {
-        if (!Comparable(elem, left)) {
-           return STATUS(RuntimeError, "values not comparable");
+      for (const QLValuePB& elem : right->list_value().elems()) {
+        if (!Comparable(elem, *left)) {
+          return STATUS(RuntimeError, "values not comparable");
         }
-        if (elem == left) {
+        if (elem == *left) {
           result->set_bool_value(true);
           break;
         }
@@ -314,16 +320,16 @@ CHECKED_STATUS QLExprExecutor::EvalCondition(const QLConditionPB& condition,
 
     case QL_OP_NOT_IN: {
       CHECK_EQ(operands.size(), 2);
-      QLValue left, right;
-      RETURN_NOT_OK(EvalExpr(operands.Get(0), table_row, &left));
-      RETURN_NOT_OK(EvalExpr(operands.Get(1), table_row, &right));
+      QLValue left_temp, right_temp;
+      const QLValuePB* left = VERIFY_RESULT(EvalOperand(operands.Get(0), table_row, &left_temp));
+      const QLValuePB* right = VERIFY_RESULT(EvalOperand(operands.Get(1), table_row, &right_temp));
 
       result->set_bool_value(true);
-      for (const QLValuePB& elem : right.list_value().elems()) {
-        if (!Comparable(elem, left)) {
+      for (const QLValuePB& elem : right->list_value().elems()) {
+        if (!Comparable(elem, *left)) {
           return STATUS(RuntimeError, "values not comparable");
         }
-        if (elem == left) {
+        if (elem == *left) {
           result->set_bool_value(false);
           break;
         }
@@ -347,6 +353,14 @@ CHECKED_STATUS QLExprExecutor::EvalCondition(const QLConditionPB& condition,
 #undef QL_EVALUATE_BETWEEN
 }
 
+Result<const QLValuePB*> QLExprExecutor::EvalOperand(const QLExpressionPB& operand,
+                                                     const QLTableRow& table_row,
+                                                     QLValue* temp) {
+  const QLValuePB* result = nullptr;
+  RETURN_NOT_OK(EvalExpr(operand, table_row, temp, nullptr /* schema */, &result));
+  return result ? result : &temp->value();
+}
+
 //--------------------------------------------------------------------------------------------------
 
 bfpg::TSOpcode QLExprExecutor::GetTSWriteInstruction(const PgsqlExpressionPB& ql_expr) const {
@@ -646,13 +660,26 @@ CHECKED_STATUS QLExprExecutor::EvalCondition(const PgsqlConditionPB& condition,
 
 //--------------------------------------------------------------------------------------------------
 
-const QLValuePB* QLTableRow::GetColumn(ColumnIdRep col_id) const {
-  const auto& col_iter = col_map_.find(col_id);
-  if (col_iter == col_map_.end()) {
-    return nullptr;
+const QLTableColumn* QLTableRow::FindColumn(ColumnIdRep col_id) const {
+  const auto index = static_cast<size_t>(col_id - kFirstColumnId.rep());
+  if (col_id >= kFirstColumnId.rep() && index < kMaxDirectColumns) {
+    return index < assigned_.size() && assigned_[index] ? &direct_columns_[index] : nullptr;
+  }
+  const auto it = other_columns_.find(col_id);
+  return it != other_columns_.end() ? &it->second : nullptr;
+}
+
+void QLTableRow::Clear() {
+  if (num_assigned_ != 0) {
+    std::fill(assigned_.begin(), assigned_.end(), false);
+    num_assigned_ = 0;
   }
+  other_columns_.clear();
+}
 
-  return &col_iter->second.value;
+const QLValuePB* QLTableRow::GetColumn(ColumnIdRep col_id) const {
+  const auto* column = FindColumn(col_id);
+  return column != nullptr ? &column->value : nullptr;
 }
 
 CHECKED_STATUS QLTableRow::ReadColumn(ColumnIdRep col_id, QLValue *col_value) const {
@@ -671,21 +698,21 @@ CHECKED_STATUS QLTableRow::ReadSubscriptedColumn(const QLSubscriptedColPB& subco
                                                  QLValue *col_value) const {
   col_value->SetNull();
 
-  const auto& col_iter = col_map_.find(subcol.column_id());
-  if (col_iter == col_map_.end()) {
+  const auto* column = FindColumn(subcol.column_id());
+  if (column == nullptr) {
     // Not exists.
     return Status::OK();
-  } else if (col_iter->second.value.has_map_value()) {
+  } else if (column->value.has_map_value()) {
     // map['key']
-    auto& map = col_iter->second.value.map_value();
+    auto& map = column->value.map_value();
     for (int i = 0; i < map.keys_size(); i++) {
       if (map.keys(i) == index_arg.value()) {
           *col_value = map.values(i);
       }
     }
-  } else if (col_iter->second.value.has_list_value()) {
+  } else if (column->value.has_list_value()) {
     // list[index]
-    auto& list = col_iter->second.value.list_value();
+    auto& list = column->value.list_value();
     if (index_arg.value().has_int32_value()) {
       int list_index = index_arg.int32_value();
       if (list_index >= 0 && list_index < list.elems_size()) {
@@ -697,95 +724,130 @@ CHECKED_STATUS QLTableRow::ReadSubscriptedColumn(const QLSubscriptedColPB& subco
 }
 
 CHECKED_STATUS QLTableRow::GetTTL(ColumnIdRep col_id, int64_t *ttl_seconds) const {
-  const auto& col_iter = col_map_.find(col_id);
-  if (col_iter == col_map_.end()) {
+  const auto* column = FindColumn(col_id);
+  if (column == nullptr) {
     // Not exists.
     return STATUS(InternalError, "Column unexpectedly not found in cache");
   }
-  *ttl_seconds = col_iter->second.ttl_seconds;
+  *ttl_seconds = column->ttl_seconds;
   return Status::OK();
 }
 
 CHECKED_STATUS QLTableRow::GetWriteTime(ColumnIdRep col_id, int64_t *write_time) const {
-  const auto& col_iter = col_map_.find(col_id);
-  if (col_iter == col_map_.end()) {
+  const auto* column = FindColumn(col_id);
+  if (column == nullptr) {
     // Not exists.
     return STATUS(InternalError, "Column unexpectedly not found in cache");
   }
-  DCHECK_NE(QLTableColumn::kUninitializedWriteTime, col_iter->second.write_time);
-  *write_time = col_iter->second.write_time;
+  DCHECK_NE(QLTableColumn::kUninitializedWriteTime, column->write_time);
+  *write_time = column->write_time;
   return Status::OK();
 }
 
 CHECKED_STATUS QLTableRow::GetValue(ColumnIdRep col_id, QLValue *column) const {
-  const auto& col_iter = col_map_.find(col_id);
-  if (col_iter == col_map_.end()) {
+  const auto* table_column = FindColumn(col_id);
+  if (table_column == nullptr) {
     // Not exists.
     return STATUS(InternalError, "Column unexpectedly not found in cache");
   }
-  *column = std::move(col_iter->second.value);
+  *column = table_column->value;
   return Status::OK();
 }
 
 boost::optional<const QLValuePB&> QLTableRow::GetValue(ColumnIdRep col_id) const {
-  const auto& col_iter = col_map_.find(col_id);
-  if (col_iter == col_map_.end()) {
+  const auto* column = FindColumn(col_id);
+  if (column == nullptr) {
     return boost::none;
   }
-  return col_iter->second.value;
+  return column->value;
 }
 
 bool QLTableRow::IsColumnSpecified(ColumnIdRep col_id) const {
-  return col_map_.find(col_id) != col_map_.end();
+  return FindColumn(col_id) != nullptr;
 }
 
 void QLTableRow::ClearValue(ColumnIdRep col_id) {
-  col_map_[col_id].value.Clear();
+  AllocColumn(col_id).value.Clear();
 }
 
 bool QLTableRow::MatchColumn(ColumnIdRep col_id, const QLTableRow& source) const {
-  auto this_iter = col_map_.find(col_id);
-  auto source_iter = source.col_map_.find(col_id);
-  if (this_iter != col_map_.end() && source_iter != source.col_map_.end()) {
-    return this_iter->second.value == source_iter->second.value;
-  }
-  if (this_iter != col_map_.end() || source_iter != source.col_map_.end()) {
-    return false;
+  const auto* this_column = FindColumn(col_id);
+  const auto* source_column = source.FindColumn(col_id);
+  if (this_column != nullptr && source_column != nullptr) {
+    return this_column->value == source_column->value;
   }
-  return true;
+  return this_column == nullptr && source_column == nullptr;
 }
 
 QLTableColumn& QLTableRow::AllocColumn(ColumnIdRep col_id) {
-  return col_map_[col_id];
+  const auto index = static_cast<size_t>(col_id - kFirstColumnId.rep());
+  if (col_id < kFirstColumnId.rep() || index >= kMaxDirectColumns) {
+    return other_columns_[col_id];
+  }
+  if (index >= direct_columns_.size()) {
+    direct_columns_.resize(index + 1);
+    assigned_.resize(index + 1);
+  }
+  auto& column = direct_columns_[index];
+  if (!assigned_[index]) {
+    // Reset the column left by a previous row to the state of a newly allocated column.
+    assigned_[index] = true;
+    ++num_assigned_;
+    if (column.value.value_case() != QLValuePB::VALUE_NOT_SET) {
+      column.value.Clear();
+    }
+    column.ttl_seconds = 0;
+    column.write_time = QLTableColumn::kUninitializedWriteTime;
+  }
+  return column;
 }
 
 QLTableColumn& QLTableRow::AllocColumn(ColumnIdRep col_id, const QLValue& ql_value) {
-  col_map_[col_id].value = ql_value.value();
-  return col_map_[col_id];
+  auto& column = AllocColumn(col_id);
+  column.value = ql_value.value();
+  return column;
 }
 
 QLTableColumn& QLTableRow::AllocColumn(ColumnIdRep col_id, const QLValuePB& ql_value) {
-  col_map_[col_id].value = ql_value;
-  return col_map_[col_id];
+  auto& column = AllocColumn(col_id);
+  column.value = ql_value;
+  return column;
 }
 
 CHECKED_STATUS QLTableRow::CopyColumn(ColumnIdRep col_id,
                                       const QLTableRow& source) {
-  auto col_iter = source.col_map_.find(col_id);
-  if (col_iter != source.col_map_.end()) {
-    col_map_[col_id] = col_iter->second;
+  const auto* column = source.FindColumn(col_id);
+  if (column != nullptr) {
+    AllocColumn(col_id) = *column;
   }
   return Status::OK();
 }
 
+std::string QLTableRow::ToString() const {
+  std::map<ColumnIdRep, const QLTableColumn*> columns;
+  for (size_t index = 0; index != direct_columns_.size(); ++index) {
+    if (assigned_[index]) {
+      columns.emplace(kFirstColumnId.rep() + index, &direct_columns_[index]);
+    }
+  }
+  for (const auto& column : other_columns_) {
+    columns.emplace(column.first, &column.second);
+  }
+  std::string result = "{";
+  for (const auto& column : columns) {
+    result += Format(" { $0 $1 }", column.first, column.second->ToString());
+  }
+  return result + " }";
+}
+
 std::string QLTableRow::ToString(const Schema& schema) const {
   std::string ret;
   ret.append("{ ");
 
   for (size_t col_idx = 0; col_idx < schema.num_columns(); col_idx++) {
-    auto it = col_map_.find(schema.column_id(col_idx));
-    if (it != col_map_.end() && it->second.value.value_case() != QLValuePB::VALUE_NOT_SET) {
-      ret += it->second.value.ShortDebugString();
+    const auto* column = FindColumn(schema.column_id(col_idx));
+    if (column != nullptr && column->value.value_case() != QLValuePB::VALUE_NOT_SET) {
+      ret += column->value.ShortDebugString();
     } else {
       ret += "null";
     }
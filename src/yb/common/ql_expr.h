@@ -7,6 +7,9 @@
 #ifndef YB_COMMON_QL_EXPR_H_
 #define YB_COMMON_QL_EXPR_H_
 
+#include <unordered_map>
+#include <vector>
+
 #include "yb/common/common_fwd.h"
 #include "yb/common/schema.h"
 #include "yb/util/bfql/tserver_opcodes.h"
@@ -80,16 +83,16 @@ class QLTableRow {
 
   // Check if row is empty (no column).
   bool IsEmpty() const {
-    return col_map_.empty();
+    return ColumnCount() == 0;
   }
 
   // Get column count.
   size_t ColumnCount() const {
-    return col_map_.size();
+    return num_assigned_ + other_columns_.size();
   }
 
-  // Clear the row.
-  void Clear() { col_map_.clear(); }
+  // Clear the row. Storage of columns is kept, so it is reused by the next row read into this row.
+  void Clear();
 
   // Compare column value between two rows.
   bool MatchColumn(ColumnIdRep col_id, const QLTableRow& source) const;
@@ -151,20 +154,33 @@ class QLTableRow {
 
   // For testing only (no status check).
   const QLTableColumn& TestValue(ColumnIdRep col_id) const {
-    return col_map_.at(col_id);
+    auto column = FindColumn(col_id);
+    CHECK(column != nullptr) << "Column not found: " << col_id;
+    return *column;
   }
   const QLTableColumn& TestValue(const ColumnId& col) const {
-    return col_map_.at(col.rep());
+    return TestValue(col.rep());
   }
 
-  std::string ToString() const {
-    return yb::ToString(col_map_);
-  }
+  std::string ToString() const;
 
   std::string ToString(const Schema& schema) const;
 
  private:
-  std::unordered_map<ColumnIdRep, QLTableColumn> col_map_;
+  // Columns with ids in [kFirstColumnId, kFirstColumnId + kMaxDirectColumns) are stored at index
+  // col_id - kFirstColumnId of direct_columns_, the other columns are stored in other_columns_.
+  static constexpr ColumnIdRep kMaxDirectColumns = 256;
+
+  // Returns the column with the specified id, or nullptr if the column is not assigned.
+  const QLTableColumn* FindColumn(ColumnIdRep col_id) const;
+
+  // Columns of a row read from DocDB usually have consecutive ids, so they are looked up without
+  // hashing. Values of cleared columns are not destroyed, so reading the next row into this row
+  // does not allocate map nodes.
+  std::vector<QLTableColumn> direct_columns_;
+  std::vector<bool> assigned_;
+  size_t num_assigned_ = 0;
+  std::unordered_map<ColumnIdRep, QLTableColumn> other_columns_;
 };
 
 class QLExprExecutor {
@@ -230,6 +246,13 @@ class QLExprExecutor {
                                        const QLTableRow& table_row,
                                        QLValue *result);
 
+  // Evaluate an operand of a condition. Constants and column references are not copied, and the
+  // result points to the value in the expression or in the row. Other operands are evaluated into
+  // temp, and the result points to its value.
+  Result<const QLValuePB*> EvalOperand(const QLExpressionPB& operand,
+                                       const QLTableRow& table_row,
+                                       QLValue* temp);
+
   //------------------------------------------------------------------------------------------------
   // PGSQL Support.
 
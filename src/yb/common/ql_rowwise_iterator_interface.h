@@ -15,6 +15,10 @@
 #define YB_COMMON_QL_ROWWISE_ITERATOR_INTERFACE_H
 
 #include <memory>
+#include <string>
+#include <vector>
+
+#include "yb/common/ql_expr.h"
 
 #include "yb/util/result.h"
 #include "yb/util/status.h"
@@ -27,8 +31,6 @@ class PgsqlReadRequestPB;
 class PgsqlResponsePB;
 class QLReadRequestPB;
 class QLResponsePB;
-class QLTableRow;
-class Schema;
 
 namespace common {
 
@@ -75,6 +77,12 @@ class YQLRowwiseIteratorIf {
     return STATUS(NotSupported, "This iterator does not provide tuple id");
   }
 
+  // Returns the encoded doc key of the current row, i.e. its tuple id with the table prefix. It
+  // stays valid until the iterator is moved to the next row.
+  virtual Result<Slice> GetRowKey() const {
+    return STATUS(NotSupported, "This iterator does not provide row key");
+  }
+
   // Seeks to the given tuple by its id. See DocRowwiseIterator for details.
   virtual Result<bool> SeekTuple(const Slice& tuple_id) {
     return STATUS(NotSupported, "This iterator cannot seek by tuple id");
@@ -92,6 +100,47 @@ class YQLRowwiseIteratorIf {
     return DoNextRow(schema(), table_row);
   }
 
+  // Read up to max_rows next rows using the specified projection into the first entries of rows.
+  // Rows already present in the vector are cleared and reused, so passing the same vector to
+  // subsequent calls avoids per-row allocations. Returns the number of rows read, which is less
+  // than max_rows only when the scan is finished.
+  // If row_keys is not null, the row key of each row is stored into the entry with the same index,
+  // because the iterator is already positioned after the batch once it is returned.
+  Result<size_t> NextRowBatch(const Schema& projection, size_t max_rows,
+                              std::vector<QLTableRow::SharedPtr>* rows,
+                              std::vector<std::string>* row_keys = nullptr) {
+    if (rows->size() < max_rows) {
+      rows->reserve(max_rows);
+      while (rows->size() < max_rows) {
+        rows->push_back(std::make_shared<QLTableRow>());
+      }
+    }
+    if (row_keys && row_keys->size() < max_rows) {
+      row_keys->resize(max_rows);
+    }
+    return DoNextRowBatch(projection, max_rows, rows, row_keys);
+  }
+
+ protected:
+  // Default batch implementation, that reads rows one by one. rows and row_keys, if not null,
+  // contain at least max_rows entries.
+  virtual Result<size_t> DoNextRowBatch(const Schema& projection, size_t max_rows,
+                                        std::vector<QLTableRow::SharedPtr>* rows,
+                                        std::vector<std::string>* row_keys) {
+    size_t num_rows = 0;
+    while (num_rows < max_rows && VERIFY_RESULT(HasNext())) {
+      auto& row = *(*rows)[num_rows];
+      row.Clear();
+      RETURN_NOT_OK(DoNextRow(projection, &row));
+      if (row_keys) {
+        const auto row_key = VERIFY_RESULT(GetRowKey());
+        (*row_keys)[num_rows].assign(row_key.cdata(), row_key.size());
+      }
+      ++num_rows;
+    }
+    return num_rows;
+  }
+
  private:
   virtual CHECKED_STATUS DoNextRow(const Schema& projection, QLTableRow* table_row) = 0;
 };
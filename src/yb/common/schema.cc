@@ -97,6 +97,8 @@ void TableProperties::ToTablePropertiesPB(TablePropertiesPB *pb) const {
   }
   pb->set_is_ysql_catalog_table(is_ysql_catalog_table_);
   pb->set_is_backfilling(is_backfilling_);
+  pb->set_use_packed_row(use_packed_row_);
+  pb->set_num_bloom_filter_range_components(num_bloom_filter_range_components_);
 }
 
 TableProperties TableProperties::FromTablePropertiesPB(const TablePropertiesPB& pb) {
@@ -128,6 +130,12 @@ TableProperties TableProperties::FromTablePropertiesPB(const TablePropertiesPB&
   if (pb.has_is_backfilling()) {
     table_properties.SetIsBackfilling(pb.is_backfilling());
   }
+  if (pb.has_use_packed_row()) {
+    table_properties.SetUsePackedRow(pb.use_packed_row());
+  }
+  if (pb.has_num_bloom_filter_range_components()) {
+    table_properties.SetNumBloomFilterRangeComponents(pb.num_bloom_filter_range_components());
+  }
   return table_properties;
 }
 
@@ -156,6 +164,12 @@ void TableProperties::AlterFromTablePropertiesPB(const TablePropertiesPB& pb) {
   if (pb.has_is_backfilling()) {
     SetIsBackfilling(pb.is_backfilling());
   }
+  if (pb.has_use_packed_row()) {
+    SetUsePackedRow(pb.use_packed_row());
+  }
+  if (pb.has_num_bloom_filter_range_components()) {
+    SetNumBloomFilterRangeComponents(pb.num_bloom_filter_range_components());
+  }
 }
 
 void TableProperties::Reset() {
@@ -168,6 +182,8 @@ void TableProperties::Reset() {
   num_tablets_ = 0;
   is_ysql_catalog_table_ = false;
   is_backfilling_ = false;
+  use_packed_row_ = false;
+  num_bloom_filter_range_components_ = 0;
 }
 
 string TableProperties::ToString() const {
@@ -458,6 +458,14 @@ class TableProperties {
 
   void SetIsBackfilling(bool is_backfilling) { is_backfilling_ = is_backfilling; }
 
+  bool use_packed_row() const { return use_packed_row_; }
+
+  void SetUsePackedRow(bool use_packed_row) { use_packed_row_ = use_packed_row; }
+
+  int num_bloom_filter_range_components() const { return num_bloom_filter_range_components_; }
+
+  void SetNumBloomFilterRangeComponents(int value) { num_bloom_filter_range_components_ = value; }
+
   void ToTablePropertiesPB(TablePropertiesPB *pb) const;
 
   static TableProperties FromTablePropertiesPB(const TablePropertiesPB& pb);
@@ -480,6 +488,8 @@ class TableProperties {
   bool use_mangled_column_name_ = false;
   int num_tablets_ = 0;
   bool is_ysql_catalog_table_ = false;
+  bool use_packed_row_ = false;
+  int num_bloom_filter_range_components_ = 0;
 };
 
 typedef uint32_t PgTableOid;
@@ -25,7 +25,10 @@ YB_DEFINE_ENUM(TransactionErrorCode,
     (kAborted)
     (kReadRestartRequired)
     (kConflict)
-    (kSnapshotTooOld));
+    (kSnapshotTooOld)
+    // Conflicting transactions are still pending, the write should release its locks and retry
+    // later. Used only inside the tablet server, see wait_for_conflicting_transactions_ms.
+    (kWaitForConflicts));
 
 struct TransactionErrorTag : IntegralErrorTag<TransactionErrorCode> {
   // It is part of the wire protocol and should not be changed once released.
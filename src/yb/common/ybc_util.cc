@@ -187,6 +187,7 @@ uint32_t YBCStatusPgsqlError(YBCStatus s) {
         case TransactionErrorCode::kSnapshotTooOld:
           result = YBPgErrorCode::YB_PG_SNAPSHOT_TOO_OLD;
           break;
+        case TransactionErrorCode::kWaitForConflicts: FALLTHROUGH_INTENDED;
         case TransactionErrorCode::kNone: FALLTHROUGH_INTENDED;
         default:
           result = YBPgErrorCode::YB_PG_INTERNAL_ERROR;
@@ -14,6 +14,9 @@
 #ifndef YB_CONSENSUS_CONSENSUS_CONTEXT_H
 #define YB_CONSENSUS_CONSENSUS_CONTEXT_H
 
+#include <string>
+#include <vector>
+
 #include "yb/common/common_fwd.h"
 
 #include "yb/consensus/consensus_fwd.h"
@@ -39,10 +42,21 @@ class ConsensusContext {
   virtual CHECKED_STATUS StartReplicaOperation(
       const ConsensusRoundPtr& context, HybridTime propagated_safe_time) = 0;
 
+  // Called after a batch of operations was started with StartReplicaOperation(), once the
+  // consensus state lock is released. The implementation could defer submitting the started
+  // operations for prepare until this call, so this work is not done under the lock.
+  virtual void ReplicaOperationsStarted() = 0;
+
   virtual void SetPropagatedSafeTime(HybridTime ht) = 0;
 
   virtual bool ShouldApplyWrite() = 0;
 
+  // Called before applying a run of consecutive committed write operations, and after the last
+  // of them was applied. The implementation could combine the writes of these operations, and
+  // make them visible only in FinishApplyBatch.
+  virtual void StartApplyBatch() = 0;
+  virtual void FinishApplyBatch() = 0;
+
   // Returns the current safe time, so we can send it from leaders to followers.
   virtual HybridTime PropagatedSafeTime() = 0;
 
@@ -64,6 +78,14 @@ class ConsensusContext {
   // Listener could be set only once and then reset.
   virtual void ListenNumSSTFilesChanged(std::function<void()> listener) = 0;
 
+  // Returns keys recently read from the tablet, that are sent to the new leader on leadership
+  // transfer, so it could warm up its block cache.
+  virtual std::vector<std::string> HotKeys() = 0;
+
+  // Whether the local peer keeps only the log, and does not have the data. Such peer should never
+  // become a leader, even when the config lists it as a full replica, see RaftPeerPB::log_only.
+  virtual bool IsLogOnly() = 0;
+
   virtual ~ConsensusContext() = default;
 };
 
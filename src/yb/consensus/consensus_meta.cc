@@ -89,9 +89,8 @@ Status ConsensusMetadata::Load(FsManager* fs_manager,
                                const std::string& peer_uuid,
                                std::unique_ptr<ConsensusMetadata>* cmeta_out) {
   std::unique_ptr<ConsensusMetadata> cmeta(new ConsensusMetadata(fs_manager, tablet_id, peer_uuid));
-  RETURN_NOT_OK(pb_util::ReadPBContainerFromPath(fs_manager->env(),
-                                                 fs_manager->GetConsensusMetadataPath(tablet_id),
-                                                 &cmeta->pb_));
+  RETURN_NOT_OK(fs_manager->ReadMetadataFile(fs_manager->GetConsensusMetadataPath(tablet_id),
+                                             &cmeta->pb_));
   cmeta->UpdateActiveRole(); // Needs to happen here as we sidestep the accessor APIs.
   RETURN_NOT_OK(cmeta->UpdateOnDiskSize());
   cmeta_out->swap(cmeta);
@@ -100,11 +99,10 @@ Status ConsensusMetadata::Load(FsManager* fs_manager,
 
 Status ConsensusMetadata::DeleteOnDiskData(FsManager* fs_manager, const string& tablet_id) {
   string cmeta_path = fs_manager->GetConsensusMetadataPath(tablet_id);
-  Env* env = fs_manager->env();
-  if (!env->FileExists(cmeta_path)) {
+  if (!fs_manager->MetadataFileExists(cmeta_path)) {
     return Status::OK();
   }
-  RETURN_NOT_OK_PREPEND(env->DeleteFile(cmeta_path),
+  RETURN_NOT_OK_PREPEND(fs_manager->DeleteMetadataFile(cmeta_path),
                         "Unable to delete consensus metadata file for tablet " + tablet_id);
   return Status::OK();
 }
@@ -240,11 +238,8 @@ Status ConsensusMetadata::Flush() {
   }
 
   string meta_file_path = fs_manager_->GetConsensusMetadataPath(tablet_id_);
-  RETURN_NOT_OK_PREPEND(pb_util::WritePBContainerToPath(
-      fs_manager_->env(), meta_file_path, pb_,
-      pb_util::OVERWRITE,
-      // Always fsync the consensus metadata.
-      pb_util::SYNC),
+  // Consensus metadata is always synced, either directly or via the metadata journal.
+  RETURN_NOT_OK_PREPEND(fs_manager_->WriteMetadataFile(meta_file_path, pb_),
           Substitute("Unable to write consensus meta file for tablet $0 to path $1",
                      tablet_id_, meta_file_path));
   RETURN_NOT_OK(UpdateOnDiskSize());
@@ -280,7 +275,7 @@ void ConsensusMetadata::UpdateActiveRole() {
 
 Status ConsensusMetadata::UpdateOnDiskSize() {
   string path = fs_manager_->GetConsensusMetadataPath(tablet_id_);
-  on_disk_size_.store(VERIFY_RESULT(fs_manager_->env()->GetFileSize(path)));
+  on_disk_size_.store(VERIFY_RESULT(fs_manager_->GetMetadataFileSize(path)));
   return Status::OK();
 }
 
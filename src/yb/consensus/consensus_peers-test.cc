@@ -413,5 +413,104 @@ TEST_F(ConsensusPeersTest, TestDontSendOneRpcPerWriteWhenPeerIsDown) {
   ASSERT_LT(mock_proxy->update_count() - initial_update_count, 5);
 }
 
+namespace {
+
+// Proxy that accepts status only requests as a part of a heartbeat batch.
+class HeartbeatBatchingPeerProxy : public MockedPeerProxy {
+ public:
+  explicit HeartbeatBatchingPeerProxy(ThreadPool* pool) : MockedPeerProxy(pool) {}
+
+  void UpdateAsync(const ConsensusRequestPB* request,
+                   RequestTriggerMode trigger_mode,
+                   ConsensusResponsePB* response,
+                   rpc::RpcController* controller,
+                   const rpc::ResponseCallback& callback) override {
+    {
+      std::lock_guard<simple_spinlock> l(lock_);
+      last_sent_committed_index_ = request->committed_index().index();
+    }
+    MockedPeerProxy::UpdateAsync(request, trigger_mode, response, controller, callback);
+  }
+
+  bool HeartbeatAsync(const ConsensusRequestPB* request,
+                      ConsensusResponsePB* response,
+                      const StdStatusCallback& callback) override {
+    {
+      std::lock_guard<simple_spinlock> l(lock_);
+      ++heartbeat_count_;
+      if (request->ops_size() > 0 ||
+          request->committed_index().index() > last_sent_committed_index_) {
+        ++batched_progress_count_;
+      }
+      last_sent_committed_index_ = request->committed_index().index();
+      *response = update_response_;
+    }
+    WARN_NOT_OK(pool_->SubmitFunc(std::bind(callback, Status::OK())), "Submit failed");
+    return true;
+  }
+
+  int heartbeat_count() const {
+    std::lock_guard<simple_spinlock> l(lock_);
+    return heartbeat_count_;
+  }
+
+  // Number of batched requests that carried ops or advanced the committed index.
+  int batched_progress_count() const {
+    std::lock_guard<simple_spinlock> l(lock_);
+    return batched_progress_count_;
+  }
+
+  int64_t last_sent_committed_index() const {
+    std::lock_guard<simple_spinlock> l(lock_);
+    return last_sent_committed_index_;
+  }
+
+ private:
+  int heartbeat_count_ = 0;
+  int batched_progress_count_ = 0;
+  int64_t last_sent_committed_index_ = 0;
+};
+
+} // namespace
+
+// Requests that carry ops or advance the committed index are not delayed by heartbeat batching.
+TEST_F(ConsensusPeersTest, TestHeartbeatBatchingSkipsCommitIndexAdvance) {
+  auto proxy = new HeartbeatBatchingPeerProxy(raft_pool_.get());
+  auto peer = ASSERT_RESULT(Peer::NewRemotePeer(
+      FakeRaftPeerPB(kFollowerUuid), kTabletId, kLeaderUuid, PeerProxyPtr(proxy),
+      message_queue_.get(), raft_pool_token_.get(), nullptr /* consensus */,
+      messenger_.get()));
+
+  auto se = ScopeExit([&peer] {
+    // This guarantees that the Peer object doesn't get destroyed if there is a pending request.
+    peer->Close();
+  });
+
+  ConsensusResponsePB resp;
+  resp.set_responder_uuid(kFollowerUuid);
+  resp.set_responder_term(0);
+  resp.mutable_status()->mutable_last_received()->CopyFrom(MakeOpId(1, 1));
+  resp.mutable_status()->mutable_last_received_current_leader()->CopyFrom(MakeOpId(1, 1));
+  resp.mutable_status()->set_last_committed_idx(1);
+  proxy->set_update_response(resp);
+
+  AppendReplicateMessagesToQueue(message_queue_.get(), clock_, 1, 1);
+  ASSERT_OK(peer->SignalRequest(RequestTriggerMode::kAlwaysSend));
+  WaitForMajorityReplicatedIndex(1);
+
+  // Heartbeats tell the follower about the new committed index, and then become status only.
+  ASSERT_OK(WaitFor([peer, proxy] {
+    if (proxy->heartbeat_count() >= 3) {
+      return true;
+    }
+    WARN_NOT_OK(peer->SignalRequest(RequestTriggerMode::kAlwaysSend), "Signal failed");
+    return false;
+  }, 10s, "Heartbeats batched"));
+
+  ASSERT_EQ(1, proxy->last_sent_committed_index());
+  ASSERT_EQ(0, proxy->batched_progress_count());
+  ASSERT_GE(proxy->update_count(), 2);
+}
+
 }  // namespace consensus
 }  // namespace yb
@@ -48,6 +48,7 @@
 #include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/consensus_queue.h"
 #include "yb/consensus/log.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/consensus/replicate_msgs_holder.h"
 
 #include "yb/gutil/map-util.h"
@@ -66,6 +67,7 @@
 #include "yb/util/net/net_util.h"
 #include "yb/util/status_callback.h"
 #include "yb/util/threadpool.h"
+#include "yb/util/trace.h"
 #include "yb/util/tsan_util.h"
 
 using namespace std::literals;
@@ -95,6 +97,7 @@ DEFINE_test_flag(bool, enable_remote_bootstrap, true,
                  "replica.");
 
 DECLARE_int32(log_change_config_every_n);
+DECLARE_bool(enable_multi_raft_heartbeat_batcher);
 
 namespace yb {
 namespace consensus {
@@ -279,7 +282,8 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   request_.set_caller_uuid(leader_uuid_);
   request_.set_dest_uuid(peer_pb_.permanent_uuid());
 
-  const bool req_has_ops = (request_.ops_size() > 0) || (commit_index_after > commit_index_before);
+  const bool advances_commit_index = commit_index_after > commit_index_before;
+  const bool req_has_ops = (request_.ops_size() > 0) || advances_commit_index;
 
   // If the queue is empty, check if we were told to send a status-only message (which is what
   // happens during heartbeats). If not, just return.
@@ -301,6 +305,36 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   // condition. When rest of this function is running in parallel to ProcessResponse.
   msgs_holder.ReleaseOps();
 
+  // If an op is a part of a sampled distributed trace, the update becomes a child span of this op,
+  // and the follower continues the trace.
+  scoped_refptr<Trace> trace;
+  for (const auto& op : request_.ops()) {
+    if (op.has_trace_id()) {
+      trace = new Trace;
+      trace->JoinSpan(op.trace_id(), op.trace_span_id());
+      break;
+    }
+  }
+
+  // Ops were serialized by the log cache once for all peers, so send the serialized data instead
+  // of serializing the ops again. The follower parses them as usual request ops.
+  auto& serialized_messages = msgs_holder.serialized_messages();
+  if (!serialized_messages.empty() && proxy_->SupportsRequestAttachments()) {
+    DCHECK_EQ(serialized_messages.size(), static_cast<size_t>(request_.ops_size()));
+    request_.mutable_ops()->ExtractSubrange(0, request_.ops().size(), nullptr /* elements */);
+    controller_.set_request_attachments(std::move(serialized_messages));
+  }
+
+  // Status only requests could be sent together with heartbeats of other tablets. Requests that
+  // advance the committed index are sent directly, so the batch window does not delay commit
+  // propagation to followers.
+  if (!req_has_ops && !advances_commit_index &&
+      proxy_->HeartbeatAsync(
+          &request_, &response_, std::bind(&Peer::DoProcessResponse, retain_self, _1))) {
+    return;
+  }
+
+  ADOPT_TRACE(trace.get());
   proxy_->UpdateAsync(&request_, trigger_mode, &response_, &controller_,
                       std::bind(&Peer::ProcessResponse, retain_self));
 }
@@ -316,11 +350,15 @@ std::unique_lock<simple_spinlock> Peer::StartProcessingUnlocked() {
 }
 
 void Peer::ProcessResponse() {
+  Status status = controller_.status();
+  controller_.Reset();
+  DoProcessResponse(status);
+}
+
+void Peer::DoProcessResponse(const Status& status) {
   request_.mutable_ops()->ExtractSubrange(0, request_.ops().size(), nullptr /* elements */);
 
   DCHECK(performing_mutex_.is_locked()) << "Got a response when nothing was pending";
-  Status status = controller_.status();
-  controller_.Reset();
 
   auto performing_lock = LockPerforming(std::adopt_lock);
 
@@ -474,8 +512,10 @@ Peer::~Peer() {
   CHECK_EQ(state_, kPeerClosed) << "Peer cannot be implicitly closed";
 }
 
-RpcPeerProxy::RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy)
-    : hostport_(std::move(hostport)), consensus_proxy_(std::move(consensus_proxy)) {
+RpcPeerProxy::RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy,
+                           MultiRaftHeartbeatBatcherPtr heartbeat_batcher)
+    : hostport_(std::move(hostport)), consensus_proxy_(std::move(consensus_proxy)),
+      heartbeat_batcher_(std::move(heartbeat_batcher)) {
 }
 
 void RpcPeerProxy::UpdateAsync(const ConsensusRequestPB* request,
@@ -487,6 +527,16 @@ void RpcPeerProxy::UpdateAsync(const ConsensusRequestPB* request,
   consensus_proxy_->UpdateConsensusAsync(*request, response, controller, callback);
 }
 
+bool RpcPeerProxy::HeartbeatAsync(const ConsensusRequestPB* request,
+                                  ConsensusResponsePB* response,
+                                  const StdStatusCallback& callback) {
+  if (!heartbeat_batcher_ || !FLAGS_enable_multi_raft_heartbeat_batcher) {
+    return false;
+  }
+  heartbeat_batcher_->AddRequestToBatch(*request, response, callback);
+  return true;
+}
+
 void RpcPeerProxy::RequestConsensusVoteAsync(const VoteRequestPB* request,
                                              VoteResponsePB* response,
                                              rpc::RpcController* controller,
@@ -519,13 +569,20 @@ void RpcPeerProxy::StartRemoteBootstrap(const StartRemoteBootstrapRequestPB* req
 RpcPeerProxy::~RpcPeerProxy() {}
 
 RpcPeerProxyFactory::RpcPeerProxyFactory(
-    Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from)
-    : messenger_(messenger), proxy_cache_(proxy_cache), from_(std::move(from)) {}
+    Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from,
+    MultiRaftManager* multi_raft_manager)
+    : messenger_(messenger), proxy_cache_(proxy_cache), from_(std::move(from)),
+      multi_raft_manager_(multi_raft_manager) {}
 
 PeerProxyPtr RpcPeerProxyFactory::NewProxy(const RaftPeerPB& peer_pb) {
   auto hostport = HostPortFromPB(DesiredHostPort(peer_pb, from_));
   auto proxy = std::make_unique<ConsensusServiceProxy>(proxy_cache_, hostport);
-  return std::make_unique<RpcPeerProxy>(std::move(hostport), std::move(proxy));
+  MultiRaftHeartbeatBatcherPtr heartbeat_batcher;
+  if (multi_raft_manager_) {
+    heartbeat_batcher = multi_raft_manager_->AddOrGetBatcher(peer_pb.permanent_uuid(), hostport);
+  }
+  return std::make_unique<RpcPeerProxy>(
+      std::move(hostport), std::move(proxy), std::move(heartbeat_batcher));
 }
 
 RpcPeerProxyFactory::~RpcPeerProxyFactory() {}
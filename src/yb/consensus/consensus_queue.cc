@@ -538,7 +538,8 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
       consumption = ScopedTrackedConsumption(operations_mem_tracker_, result->read_from_disk_size);
     }
     *msgs_holder = ReplicateMsgsHolder(
-        request->mutable_ops(), std::move(result->messages), std::move(consumption));
+        request->mutable_ops(), std::move(result->messages), std::move(consumption),
+        std::move(result->serialized_messages));
 
     if (propagated_safe_time && !result->have_more_messages) {
       // Get the current local safe time on the leader and propagate it to the follower.
@@ -56,6 +56,11 @@ DECLARE_bool(never_fsync);
 DECLARE_bool(writable_file_use_fsync);
 DECLARE_int32(o_direct_block_alignment_bytes);
 DECLARE_int32(o_direct_block_size_bytes);
+DECLARE_int32(log_reader_readahead_bytes);
+DECLARE_string(log_archive_dir);
+DECLARE_int32(log_archive_max_attempts);
+DECLARE_int32(log_archive_retry_delay_ms);
+DECLARE_int32(log_archive_max_segments_per_tablet);
 
 namespace yb {
 namespace log {
@@ -222,6 +227,30 @@ TEST_F(LogTest, TestFsync) {
   ASSERT_OK(log_->Close());
 }
 
+// Tests that entries of compressed segments could be read back.
+TEST_F(LogTest, TestCompression) {
+  options_.compression_type = LZ4_COMPRESSION;
+  BuildLog();
+
+  OpId opid;
+  opid.set_term(0);
+  opid.set_index(1);
+
+  // Small batches are stored uncompressed, while the big one is compressed.
+  ASSERT_OK(AppendNoOps(&opid, 5));
+  ASSERT_OK(AppendNoOpsToLogSync(clock_, log_.get(), &opid, 20));
+  ASSERT_OK(log_->AllocateSegmentAndRollOver());
+
+  SegmentSequence segments;
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  ASSERT_EQ(LZ4_COMPRESSION, segments[0]->header().compression_type());
+  ASSERT_EQ(kLogCompressedMajorVersion, segments[0]->header().major_version());
+  auto read_entries = segments[0]->ReadEntries();
+  ASSERT_OK(read_entries.status);
+  ASSERT_EQ(25, read_entries.entries.size());
+  ASSERT_OK(log_->Close());
+}
+
 // Tests interval for durable wal write
 TEST_F(LogTest, TestFsyncInterval) {
   options_.interval_durable_wal_write = MonoDelta::FromMilliseconds(1);
@@ -634,6 +663,136 @@ TEST_F(LogTest, TestGCWithLogRunning) {
   }
 }
 
+Result<int> CountArchivedSegments(Env* env, const std::string& archive_dir) {
+  int result = 0;
+  for (const auto& file : VERIFY_RESULT(env->GetChildren(archive_dir))) {
+    if (HasPrefixString(file, FsManager::kWalFileNamePrefix)) {
+      ++result;
+    }
+  }
+  return result;
+}
+
+// Test that closed segments are copied to the log archive and are GCed only after that.
+TEST_F(LogTest, TestArchiveSegments) {
+  google::FlagSaver saver;
+  FLAGS_log_archive_dir = GetTestPath("archive");
+  const auto archive_dir = JoinPathSegments(FLAGS_log_archive_dir, kTestTablet);
+  BuildLog();
+
+  vector<LogAnchor*> anchors;
+  ElementDeleter deleter(&anchors);
+
+  const int kNumTotalSegments = 4;
+  const int kNumOpsPerSegment = 5;
+  OpId op_id = MakeOpId(1, 1);
+  ASSERT_OK(AppendMultiSegmentSequence(kNumTotalSegments, kNumOpsPerSegment, &op_id, &anchors));
+
+  SegmentSequence segments;
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  ASSERT_EQ(kNumTotalSegments, segments.size()) << DumpSegmentsToString(segments);
+
+  // All segments except the active one should be archived with the same content.
+  for (int i = 0; i < kNumTotalSegments - 1; i++) {
+    const auto& path = segments[i]->path();
+    const auto archived_path = JoinPathSegments(archive_dir, BaseName(path));
+    ASSERT_OK(WaitFor([this, &archived_path] {
+      return env_->FileExists(archived_path);
+    }, MonoDelta::FromSeconds(30), "Archive " + path));
+    faststring expected, archived;
+    ASSERT_OK(ReadFileToString(env_.get(), path, &expected));
+    ASSERT_OK(ReadFileToString(env_.get(), archived_path, &archived));
+    ASSERT_EQ(expected.ToString(), archived.ToString());
+  }
+
+  // Keep the anchor of the active segment.
+  for (int i = 0; i < kNumTotalSegments - 1; i++) {
+    ASSERT_OK(log_anchor_registry_->Unregister(anchors[i]));
+  }
+  int64_t anchored_index = -1;
+  ASSERT_OK(log_anchor_registry_->GetEarliestRegisteredLogIndex(&anchored_index));
+  int num_gced_segments = 0;
+  ASSERT_OK(log_->GC(anchored_index, &num_gced_segments));
+  ASSERT_EQ(kNumTotalSegments - FLAGS_log_min_segments_to_retain, num_gced_segments);
+
+  // Archived segments are kept after GC.
+  ASSERT_EQ(kNumTotalSegments - 1, ASSERT_RESULT(CountArchivedSegments(env_.get(), archive_dir)));
+
+  ASSERT_OK(log_->Close());
+  ASSERT_OK(log_anchor_registry_->Unregister(anchors[kNumTotalSegments - 1]));
+}
+
+// Test that only the latest log_archive_max_segments_per_tablet archived segments are kept.
+TEST_F(LogTest, TestArchiveRetention) {
+  google::FlagSaver saver;
+  FLAGS_log_archive_dir = GetTestPath("archive");
+  FLAGS_log_archive_max_segments_per_tablet = 2;
+  const auto archive_dir = JoinPathSegments(FLAGS_log_archive_dir, kTestTablet);
+  BuildLog();
+
+  vector<LogAnchor*> anchors;
+  ElementDeleter deleter(&anchors);
+
+  const int kNumTotalSegments = 5;
+  OpId op_id = MakeOpId(1, 1);
+  ASSERT_OK(AppendMultiSegmentSequence(kNumTotalSegments, 5, &op_id, &anchors));
+
+  SegmentSequence segments;
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  ASSERT_EQ(kNumTotalSegments, segments.size()) << DumpSegmentsToString(segments);
+
+  // The last closed segment is archived last, so when it is archived older ones are deleted.
+  const auto last_archived_path = JoinPathSegments(
+      archive_dir, BaseName(segments[kNumTotalSegments - 2]->path()));
+  ASSERT_OK(WaitFor([this, &last_archived_path] {
+    return env_->FileExists(last_archived_path);
+  }, MonoDelta::FromSeconds(30), "Archive last closed segment"));
+  ASSERT_OK(WaitFor([this, &archive_dir]() -> Result<bool> {
+    return VERIFY_RESULT(CountArchivedSegments(env_.get(), archive_dir)) ==
+           FLAGS_log_archive_max_segments_per_tablet;
+  }, MonoDelta::FromSeconds(30), "Delete old archived segments"));
+  ASSERT_FALSE(env_->FileExists(JoinPathSegments(archive_dir, BaseName(segments[0]->path()))));
+
+  ASSERT_OK(log_->Close());
+}
+
+// Test that a segment that could not be archived does not block GC forever.
+TEST_F(LogTest, TestArchiveFailureDoesNotBlockGC) {
+  google::FlagSaver saver;
+  FLAGS_log_archive_dir = GetTestPath("archive");
+  FLAGS_log_archive_max_attempts = 3;
+  FLAGS_log_archive_retry_delay_ms = 10;
+  const auto archive_dir = JoinPathSegments(FLAGS_log_archive_dir, kTestTablet);
+  BuildLog();
+
+  // Replace the archive directory with a file, so segments could not be copied to it.
+  ASSERT_OK(env_->DeleteDir(archive_dir));
+  ASSERT_OK(WriteStringToFile(env_.get(), "not a directory", archive_dir));
+
+  vector<LogAnchor*> anchors;
+  ElementDeleter deleter(&anchors);
+
+  const int kNumTotalSegments = 4;
+  OpId op_id = MakeOpId(1, 1);
+  ASSERT_OK(AppendMultiSegmentSequence(kNumTotalSegments, 5, &op_id, &anchors));
+
+  for (int i = 0; i < kNumTotalSegments - 1; i++) {
+    ASSERT_OK(log_anchor_registry_->Unregister(anchors[i]));
+  }
+  int64_t anchored_index = -1;
+  ASSERT_OK(log_anchor_registry_->GetEarliestRegisteredLogIndex(&anchored_index));
+  int total_gced_segments = 0;
+  ASSERT_OK(WaitFor([this, anchored_index, &total_gced_segments]() -> Result<bool> {
+    int num_gced_segments = 0;
+    RETURN_NOT_OK(log_->GC(anchored_index, &num_gced_segments));
+    total_gced_segments += num_gced_segments;
+    return total_gced_segments == kNumTotalSegments - FLAGS_log_min_segments_to_retain;
+  }, MonoDelta::FromSeconds(30), "GC segments that could not be archived"));
+
+  ASSERT_OK(log_->Close());
+  ASSERT_OK(log_anchor_registry_->Unregister(anchors[kNumTotalSegments - 1]));
+}
+
 // Test that, when we are set to retain a given number of log segments,
 // we also retain any relevant log index chunks, even if those operations
 // are not necessary for recovery.
@@ -1140,5 +1299,35 @@ TEST_F(LogTest, TestReadReplicatesHighIndex) {
   ASSERT_EQ(kSequenceLength, repls.size());
 }
 
+// Reads a range that spans several segments with a readahead smaller than some batches, so both
+// buffered and direct reads of entry batches are exercised.
+TEST_F(LogTest, TestReadReplicatesWithReadahead) {
+  FLAGS_log_reader_readahead_bytes = 4096;
+  const int kNumSegments = 3;
+  const int kOpsPerSegment = 50;
+
+  BuildLog();
+  OpId op_id = MakeOpId(1, 1);
+  for (int i = 0; i != kNumSegments; ++i) {
+    ASSERT_OK(AppendNoOps(&op_id, kOpsPerSegment - 1));
+    // Large op that does not fit into the readahead buffer.
+    const int index = static_cast<int>(op_id.index());
+    AppendReplicateBatch(op_id, op_id, {TupleForAppend(index, 0, std::string(8192, 'x'))});
+    op_id.set_index(op_id.index() + 1);
+    ASSERT_OK(RollLog());
+  }
+
+  auto* reader = log_->GetLogReader();
+  const int64_t last_index = kNumSegments * kOpsPerSegment;
+  for (int64_t start : {1, kOpsPerSegment - 1, kOpsPerSegment + 10}) {
+    ReplicateMsgs repls;
+    ASSERT_OK(reader->ReadReplicatesInRange(start, last_index, LogReader::kNoSizeLimit, &repls));
+    ASSERT_EQ(last_index - start + 1, repls.size());
+    for (const auto& repl : repls) {
+      ASSERT_EQ(start++, repl->id().index());
+    }
+  }
+}
+
 } // namespace log
 } // namespace yb
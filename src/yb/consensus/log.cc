@@ -37,8 +37,11 @@
 #include <thread>
 
 #include <boost/thread/shared_mutex.hpp>
+#include <google/protobuf/wire_format_lite.h>
+#include <google/protobuf/wire_format_lite_inl.h>
 
 #include "yb/common/wire_protocol.h"
+#include "yb/consensus/consensus.pb.h"
 #include "yb/consensus/log_index.h"
 #include "yb/consensus/log_metrics.h"
 #include "yb/consensus/log_reader.h"
@@ -48,9 +51,11 @@
 #include "yb/gutil/ref_counted.h"
 #include "yb/gutil/stl_util.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/gutil/strings/util.h"
 #include "yb/gutil/walltime.h"
 #include "yb/util/coding.h"
 #include "yb/util/countdown_latch.h"
+#include "yb/util/background_io_rate_controller.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/env_util.h"
 #include "yb/util/fault_injection.h"
@@ -58,6 +63,7 @@
 #include "yb/util/kernel_stack_watchdog.h"
 #include "yb/util/logging.h"
 #include "yb/util/metrics.h"
+#include "yb/util/net/rate_limiter.h"
 #include "yb/util/opid.h"
 #include "yb/util/path_util.h"
 #include "yb/util/pb_util.h"
@@ -95,6 +101,38 @@ DEFINE_int32(log_min_seconds_to_retain, 900,
 TAG_FLAG(log_min_seconds_to_retain, runtime);
 TAG_FLAG(log_min_seconds_to_retain, advanced);
 
+DEFINE_string(log_archive_dir, "",
+              "If not empty, closed log segments of each tablet are asynchronously copied to "
+              "a subdirectory of this directory, named after the tablet id, and are not GCed "
+              "before they are copied. Along with snapshots, archived segments could be used to "
+              "recover a tablet to a point in time.");
+TAG_FLAG(log_archive_dir, advanced);
+
+DEFINE_int64(log_archive_rate_limit_bytes_per_sec, 64_MB,
+             "Maximal rate at which log segments are copied to log_archive_dir, shared by all "
+             "tablets that are archiving at the same time. Zero means unlimited.");
+TAG_FLAG(log_archive_rate_limit_bytes_per_sec, runtime);
+TAG_FLAG(log_archive_rate_limit_bytes_per_sec, advanced);
+
+DEFINE_int32(log_archive_max_attempts, 10,
+             "Number of attempts to archive a log segment. After that the failure is reported "
+             "as an error and the segment is skipped, so it could be GCed without being "
+             "archived.");
+TAG_FLAG(log_archive_max_attempts, runtime);
+TAG_FLAG(log_archive_max_attempts, advanced);
+
+DEFINE_int32(log_archive_retry_delay_ms, 1000,
+             "Delay before the first retry of a failed log segment archiving. The delay is "
+             "doubled after each failed attempt, up to 60 seconds.");
+TAG_FLAG(log_archive_retry_delay_ms, runtime);
+TAG_FLAG(log_archive_retry_delay_ms, advanced);
+
+DEFINE_int32(log_archive_max_segments_per_tablet, 256,
+             "Maximal number of archived log segments kept for each tablet in log_archive_dir, "
+             "the oldest ones are deleted after a new one is archived. Zero means unlimited.");
+TAG_FLAG(log_archive_max_segments_per_tablet, runtime);
+TAG_FLAG(log_archive_max_segments_per_tablet, advanced);
+
 // Flags for controlling kernel watchdog limits.
 DEFINE_int32(consensus_log_scoped_watch_delay_callback_threshold_ms, 1000,
              "If calling consensus log callback(s) take longer than this, the kernel watchdog "
@@ -154,6 +192,10 @@ static bool dummy = google::RegisterFlagValidator(
     &FLAGS_log_min_segments_to_retain, &ValidateLogsToRetain);
 
 static const char kSegmentPlaceholderFileTemplate[] = ".tmp.newsegmentXXXXXX";
+static const char kArchiveTempFileSuffix[] = ".tmp";
+
+// Number of tablets that are currently archiving log segments, used to share the archive rate.
+static std::atomic<int> log_archive_tasks{0};
 
 namespace yb {
 namespace log {
@@ -400,6 +442,13 @@ Status Log::Init() {
                                 metric_entity_.get(),
                                 &reader_));
 
+  if (!FLAGS_log_archive_dir.empty()) {
+    RETURN_NOT_OK(env_util::CreateDirIfMissing(get_env(), FLAGS_log_archive_dir));
+    archive_dir_ = JoinPathSegments(FLAGS_log_archive_dir, tablet_id_);
+    RETURN_NOT_OK(env_util::CreateDirIfMissing(get_env(), archive_dir_));
+    RETURN_NOT_OK(ThreadPoolBuilder("log-archive").set_max_threads(1).Build(&archive_pool_));
+  }
+
   // The case where we are continuing an existing log.  We must pick up where the previous WAL left
   // off in terms of sequence numbers.
   if (reader_->num_segments() != 0) {
@@ -410,6 +459,15 @@ Status Log::Init() {
     RETURN_NOT_OK(reader_->GetSegmentsSnapshot(&segments));
     active_segment_sequence_number_ = segments.back()->header().sequence_number();
     LOG_WITH_PREFIX(INFO) << "Opened existing logs. Last segment is " << segments.back()->path();
+
+    if (archive_pool_) {
+      // Existing segments could have not been archived before restart, segments that were
+      // archived are skipped by the archive task.
+      last_archived_segment_seq_ = segments.front()->header().sequence_number() - 1;
+      for (const auto& segment : segments) {
+        ArchiveSegmentAsync(segment->header().sequence_number(), segment->path());
+      }
+    }
   }
 
   if (durable_wal_write_) {
@@ -468,9 +526,14 @@ Status Log::RollOver() {
   RETURN_NOT_OK(Sync());
   RETURN_NOT_OK(CloseCurrentSegment());
 
+  const auto closed_segment_seq = active_segment_sequence_number_;
+  const auto closed_segment_path = active_segment_->path();
   RETURN_NOT_OK(SwitchToAllocatedSegment());
 
   LOG_WITH_PREFIX(INFO) << "Rolled over to a new segment: " << active_segment_->path();
+  if (archive_pool_) {
+    ArchiveSegmentAsync(closed_segment_seq, closed_segment_path);
+  }
   return Status::OK();
 }
 
@@ -523,7 +586,8 @@ Status Log::AsyncAppend(LogEntryBatch* entry_batch, const StatusCallback& callba
 
 Status Log::AsyncAppendReplicates(const ReplicateMsgs& msgs, const yb::OpId& committed_op_id,
                                   RestartSafeCoarseTimePoint batch_mono_time,
-                                  const StatusCallback& callback) {
+                                  const StatusCallback& callback,
+                                  std::vector<RefCntBuffer> serialized_replicates) {
   auto batch = CreateBatchFromAllocatedOperations(msgs);
   if (committed_op_id) {
     committed_op_id.ToPB(batch.mutable_committed_op_id());
@@ -538,7 +602,10 @@ Status Log::AsyncAppendReplicates(const ReplicateMsgs& msgs, const yb::OpId& com
 
   // If we're able to reserve, set the vector of replicate shared pointers in the LogEntryBatch.
   // This will make sure there's a reference for each replicate while we're appending.
-  reserved_entry_batch->SetReplicates(msgs);
+  if (serialized_replicates.size() != msgs.size()) {
+    serialized_replicates.clear();
+  }
+  reserved_entry_batch->SetReplicates(msgs, std::move(serialized_replicates));
 
   RETURN_NOT_OK(AsyncAppend(reserved_entry_batch, callback));
   return Status::OK();
@@ -703,9 +770,14 @@ Status Log::Sync() {
     if (durable_wal_write_ || timed_or_data_limit_sync) {
       periodic_sync_needed_.store(false);
       periodic_sync_unsynced_bytes_ = 0;
+      const auto sync_start = CoarseMonoClock::Now();
       LOG_SLOW_EXECUTION(WARNING, 50, "Fsync log took a long time") {
         RETURN_NOT_OK(active_segment_->Sync());
       }
+      // WAL syncs are the latency sensitive I/O, that background I/O is throttled for.
+      const auto sync_end = CoarseMonoClock::Now();
+      BackgroundIoRateController::Instance()->RecordLatency(
+          MonoDelta(sync_end - sync_start), sync_end);
     }
   }
 
@@ -762,6 +834,167 @@ Status Log::GetSegmentsToGCUnlocked(int64_t min_op_idx, SegmentSequence* segment
     }
   }
 
+  if (!archive_dir_.empty()) {
+    const auto last_archived_seq = last_archived_segment_seq_.load(std::memory_order_acquire);
+    for (int i = 0; i < segments_to_gc->size(); i++) {
+      if ((*segments_to_gc)[i]->header().sequence_number() > last_archived_seq) {
+        VLOG_WITH_PREFIX(2)
+            << "Segment " << (*segments_to_gc)[i]->path() << " is not archived yet: "
+            << "cannot GC it.";
+        segments_to_gc->resize(i);
+        break;
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+void Log::ArchiveSegmentAsync(int64_t sequence_number, const std::string& path) {
+  std::lock_guard<std::mutex> lock(archive_mutex_);
+  segments_to_archive_.emplace_back(sequence_number, path);
+  if (archive_task_running_) {
+    return;
+  }
+  auto status = archive_pool_->SubmitFunc(std::bind(&Log::ArchiveSegmentsTask, this));
+  if (!status.ok()) {
+    LOG_WITH_PREFIX(WARNING) << "Failed to submit log archive task: " << status;
+    return;
+  }
+  archive_task_running_ = true;
+}
+
+void Log::ArchiveSegmentsTask() {
+  std::unique_ptr<RateLimiter> rate_limiter;
+  log_archive_tasks.fetch_add(1, std::memory_order_acq_rel);
+  auto se = ScopeExit([] {
+    log_archive_tasks.fetch_sub(1, std::memory_order_acq_rel);
+  });
+  if (FLAGS_log_archive_rate_limit_bytes_per_sec > 0) {
+    rate_limiter = std::make_unique<RateLimiter>([]() {
+      auto tasks = std::max(log_archive_tasks.load(std::memory_order_acquire), 1);
+      return static_cast<uint64_t>(FLAGS_log_archive_rate_limit_bytes_per_sec / tasks);
+    });
+  } else {
+    // Inactive RateLimiter.
+    rate_limiter = std::make_unique<RateLimiter>();
+  }
+
+  int attempts = 0;
+  for (;;) {
+    std::pair<int64_t, std::string> segment;
+    {
+      std::lock_guard<std::mutex> lock(archive_mutex_);
+      if (segments_to_archive_.empty() || archive_stop_latch_.count() == 0) {
+        archive_task_running_ = false;
+        return;
+      }
+      segment = segments_to_archive_.front();
+    }
+
+    auto status = ArchiveSegment(segment.second, rate_limiter.get());
+    if (!status.ok() && archive_stop_latch_.count() != 0) {
+      // Segments should be archived in order, so the failed one is retried after a delay. It
+      // blocks GC of the following segments, so the log gives up on it after a bounded number of
+      // attempts.
+      ++attempts;
+      if (attempts < FLAGS_log_archive_max_attempts) {
+        const auto delay = MonoDelta::FromMilliseconds(std::min<int64_t>(
+            static_cast<int64_t>(FLAGS_log_archive_retry_delay_ms) << std::min(attempts - 1, 16),
+            60000));
+        LOG_WITH_PREFIX(WARNING) << "Failed to archive log segment " << segment.second
+                                 << ", attempt " << attempts << ", retry in " << delay << ": "
+                                 << status;
+        archive_stop_latch_.WaitFor(delay);
+        continue;
+      }
+      LOG_WITH_PREFIX(ERROR) << "Failed to archive log segment " << segment.second << " after "
+                             << attempts << " attempts, it could be GCed without being "
+                             << "archived: " << status;
+    } else if (status.ok()) {
+      WARN_NOT_OK(CleanupArchive(), "Failed to delete old archived log segments");
+    }
+    attempts = 0;
+
+    std::lock_guard<std::mutex> lock(archive_mutex_);
+    if (!status.ok() && archive_stop_latch_.count() == 0) {
+      // Not archived because of shutdown, it is archived after the log is opened again.
+      archive_task_running_ = false;
+      return;
+    }
+    last_archived_segment_seq_.store(segment.first, std::memory_order_release);
+    segments_to_archive_.pop_front();
+  }
+}
+
+Status Log::CleanupArchive() {
+  const auto max_segments = FLAGS_log_archive_max_segments_per_tablet;
+  if (max_segments <= 0) {
+    return Status::OK();
+  }
+  auto* env = get_env();
+  std::vector<std::string> segment_files;
+  for (auto& file : VERIFY_RESULT(env->GetChildren(archive_dir_, ExcludeDots::kTrue))) {
+    if (!HasSuffixString(file, kArchiveTempFileSuffix) && IsLogFileName(file)) {
+      segment_files.push_back(std::move(file));
+    }
+  }
+  if (segment_files.size() <= static_cast<size_t>(max_segments)) {
+    return Status::OK();
+  }
+  // Segment file names contain zero padded sequence numbers, so they are ordered by name.
+  std::sort(segment_files.begin(), segment_files.end());
+  segment_files.resize(segment_files.size() - max_segments);
+  for (const auto& file : segment_files) {
+    const auto path = JoinPathSegments(archive_dir_, file);
+    RETURN_NOT_OK(env->DeleteFile(path));
+    VLOG_WITH_PREFIX(1) << "Deleted archived log segment " << path;
+  }
+  return Status::OK();
+}
+
+Status Log::ArchiveSegment(const std::string& path, RateLimiter* rate_limiter) {
+  auto* env = get_env();
+  const auto dest_path = JoinPathSegments(archive_dir_, BaseName(path));
+  const auto size = VERIFY_RESULT(env->GetFileSize(path));
+  if (env->FileExists(dest_path) && VERIFY_RESULT(env->GetFileSize(dest_path)) == size) {
+    VLOG_WITH_PREFIX(1) << "Log segment " << path << " is already archived";
+    return Status::OK();
+  }
+
+  const auto tmp_path = dest_path + kArchiveTempFileSuffix;
+  std::unique_ptr<SequentialFile> source;
+  RETURN_NOT_OK(env->NewSequentialFile(path, &source));
+  std::unique_ptr<WritableFile> dest;
+  RETURN_NOT_OK(env->NewWritableFile(WritableFileOptions(), tmp_path, &dest));
+
+  const size_t kBufferSize = 1_MB;
+  std::unique_ptr<uint8_t[]> scratch(new uint8_t[kBufferSize]);
+  uint64_t bytes_copied = 0;
+  while (bytes_copied < size) {
+    if (archive_stop_latch_.count() == 0) {
+      return kLogShutdownStatus;
+    }
+    Slice data;
+    RETURN_NOT_OK(rate_limiter->SendOrReceiveData([&]() -> Status {
+      RETURN_NOT_OK(source->Read(std::min<uint64_t>(size - bytes_copied, kBufferSize), &data,
+                                 scratch.get()));
+      if (data.empty()) {
+        return STATUS_FORMAT(Corruption, "Unexpected end of log segment $0 at $1 of $2",
+                             path, bytes_copied, size);
+      }
+      return dest->Append(data);
+    }, [&data]() -> uint64_t {
+      return data.size();
+    }));
+    bytes_copied += data.size();
+  }
+  RETURN_NOT_OK(dest->Sync());
+  RETURN_NOT_OK(dest->Close());
+  RETURN_NOT_OK(env->RenameFile(tmp_path, dest_path));
+  RETURN_NOT_OK(env->SyncDir(archive_dir_));
+
+  LOG_WITH_PREFIX(INFO) << "Archived log segment " << path << " to " << dest_path;
   return Status::OK();
 }
 
@@ -958,6 +1191,10 @@ Status Log::GetSegmentsSnapshot(SegmentSequence* segments) const {
   return reader_->GetSegmentsSnapshot(segments);
 }
 
+uint64_t Log::BytesLogged() const {
+  return metrics_ ? metrics_->bytes_logged->value() : 0;
+}
+
 uint64_t Log::OnDiskSize() {
   SegmentSequence segments;
   {
@@ -988,6 +1225,11 @@ Status Log::Close() {
   // Allocation pool is used from appender pool, so we should shutdown appender first.
   appender_->Shutdown();
   allocation_pool_->Shutdown();
+  if (archive_pool_) {
+    // Segments that were not archived yet are archived after the log is opened again.
+    archive_stop_latch_.CountDown();
+    archive_pool_->Shutdown();
+  }
 
   std::lock_guard<percpu_rwlock> l(state_lock_);
   switch (log_state_) {
@@ -1027,16 +1269,16 @@ scoped_refptr<ReadableLogSegment> Log::GetSegmentBySequenceNumber(int64_t seq) c
   return reader_->GetSegmentBySequenceNumber(seq);
 }
 
-Status Log::DeleteOnDiskData(Env* env,
+Status Log::DeleteOnDiskData(FsManager* fs_manager,
                              const string& tablet_id,
                              const string& tablet_wal_path,
                              const string& peer_uuid) {
-  if (!env->FileExists(tablet_wal_path)) {
+  if (!fs_manager->env()->FileExists(tablet_wal_path)) {
     return Status::OK();
   }
   LOG(INFO) << "T " << tablet_id << "P " << peer_uuid
             << ": Deleting WAL dir " << tablet_wal_path;
-  RETURN_NOT_OK_PREPEND(env->DeleteRecursively(tablet_wal_path),
+  RETURN_NOT_OK_PREPEND(fs_manager->DeleteRecursivelyThrottled(tablet_wal_path),
                         "Unable to recursively delete WAL dir for tablet " + tablet_id);
   return Status::OK();
 }
@@ -1091,6 +1333,12 @@ Status Log::SwitchToAllocatedSegment() {
   header.set_minor_version(kLogMinorVersion);
   header.set_sequence_number(active_segment_sequence_number_);
   header.set_tablet_id(tablet_id_);
+  // Segments without compression keep the old format, so they could be read by older versions.
+  // Compressed segments get a new major version, so they are not read as the old format.
+  if (options_.compression_type != NO_COMPRESSION) {
+    header.set_major_version(kLogCompressedMajorVersion);
+    header.set_compression_type(options_.compression_type);
+  }
 
   // Set up the new footer. This will be maintained as the segment is written.
   footer_builder_.Clear();
@@ -1220,6 +1468,11 @@ Status LogEntryBatch::Serialize() {
     return Status::OK();
   }
   DCHECK_NE(entry_batch_pb_.mono_time(), 0);
+  if (!serialized_replicates_.empty()) {
+    SerializeFromSerializedReplicates();
+    state_ = kEntrySerialized;
+    return Status::OK();
+  }
   total_size_bytes_ = entry_batch_pb_.ByteSize();
   buffer_.reserve(total_size_bytes_);
 
@@ -1232,6 +1485,65 @@ Status LogEntryBatch::Serialize() {
   return Status::OK();
 }
 
+// Produces the same bytes as serializing entry_batch_pb_. Each replicate is serialized as a
+// ConsensusRequestPB::ops element, i.e. tag followed by length delimited ReplicateMsg, so the
+// length delimited ReplicateMsg is copied as LogEntryPB::replicate after its own tag.
+void LogEntryBatch::SerializeFromSerializedReplicates() {
+  using google::protobuf::internal::WireFormatLite;
+  using google::protobuf::io::CodedOutputStream;
+
+  static const uint32_t kOpsTag = WireFormatLite::MakeTag(
+      consensus::ConsensusRequestPB::kOpsFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+  static const uint32_t kEntryTag = WireFormatLite::MakeTag(
+      LogEntryBatchPB::kEntryFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+  static const uint32_t kTypeTag = WireFormatLite::MakeTag(
+      LogEntryPB::kTypeFieldNumber, WireFormatLite::WIRETYPE_VARINT);
+  static const uint32_t kReplicateTag = WireFormatLite::MakeTag(
+      LogEntryPB::kReplicateFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+  const size_t ops_tag_size = CodedOutputStream::VarintSize32(kOpsTag);
+  const size_t entry_header_size = CodedOutputStream::VarintSize32(kTypeTag) +
+                                   CodedOutputStream::VarintSize32(LogEntryTypePB::REPLICATE) +
+                                   CodedOutputStream::VarintSize32(kReplicateTag);
+
+  DCHECK_EQ(type_, LogEntryTypePB::REPLICATE);
+  DCHECK_EQ(serialized_replicates_.size(), static_cast<size_t>(entry_batch_pb_.entry_size()));
+
+  // Fields other than entries are serialized by protobuf, after the entries as protobuf does.
+  LogEntryBatchPB tail;
+  if (entry_batch_pb_.has_committed_op_id()) {
+    *tail.mutable_committed_op_id() = entry_batch_pb_.committed_op_id();
+  }
+  if (entry_batch_pb_.has_mono_time()) {
+    tail.set_mono_time(entry_batch_pb_.mono_time());
+  }
+  const size_t tail_size = tail.ByteSize();
+
+  size_t total_size = tail_size;
+  for (const auto& serialized : serialized_replicates_) {
+    DCHECK_GT(serialized.size(), ops_tag_size);
+    const size_t entry_size = entry_header_size + serialized.size() - ops_tag_size;
+    total_size += CodedOutputStream::VarintSize32(kEntryTag) +
+                  CodedOutputStream::VarintSize32(static_cast<uint32_t>(entry_size)) + entry_size;
+  }
+
+  buffer_.resize(total_size);
+  uint8_t* dst = buffer_.data();
+  for (const auto& serialized : serialized_replicates_) {
+    const size_t replicate_size = serialized.size() - ops_tag_size;
+    const size_t entry_size = entry_header_size + replicate_size;
+    dst = CodedOutputStream::WriteTagToArray(kEntryTag, dst);
+    dst = CodedOutputStream::WriteVarint32ToArray(static_cast<uint32_t>(entry_size), dst);
+    dst = CodedOutputStream::WriteTagToArray(kTypeTag, dst);
+    dst = CodedOutputStream::WriteVarint32ToArray(LogEntryTypePB::REPLICATE, dst);
+    dst = CodedOutputStream::WriteTagToArray(kReplicateTag, dst);
+    memcpy(dst, serialized.udata() + ops_tag_size, replicate_size);
+    dst += replicate_size;
+  }
+  dst = tail.SerializeWithCachedSizesToArray(dst);
+  DCHECK_EQ(dst, buffer_.data() + total_size);
+  total_size_bytes_ = static_cast<uint32_t>(total_size);
+}
+
 void LogEntryBatch::MarkReady() {
   DCHECK_EQ(state_, kEntryReserved);
   state_ = kEntryReady;
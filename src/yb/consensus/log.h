@@ -34,8 +34,10 @@
 #define YB_CONSENSUS_LOG_H_
 
 #include <atomic>
+#include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -50,17 +52,21 @@
 #include "yb/gutil/spinlock.h"
 #include "yb/util/async_util.h"
 #include "yb/util/blocking_queue.h"
+#include "yb/util/countdown_latch.h"
 #include "yb/util/locks.h"
 #include "yb/util/monotime.h"
 #include "yb/util/opid.h"
 #include "yb/util/promise.h"
+#include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/status.h"
 #include "yb/util/threadpool.h"
 #include "yb/util/shared_lock.h"
 
 namespace yb {
 
+class FsManager;
 class MetricEntity;
+class RateLimiter;
 class ThreadPool;
 
 namespace cdc {
@@ -143,9 +149,13 @@ class Log : public RefCountedThreadSafe<Log> {
 
   // Append the given set of replicate messages, asynchronously.  This requires that the replicates
   // have already been assigned OpIds.
+  // When serialized_replicates is not empty, it contains the replicates serialized as
+  // ConsensusRequestPB::ops elements, that are written to the log without serializing the
+  // replicates again.
   CHECKED_STATUS AsyncAppendReplicates(const ReplicateMsgs& replicates, const OpId& committed_op_id,
                                        RestartSafeCoarseTimePoint batch_mono_time,
-                                       const StatusCallback& callback);
+                                       const StatusCallback& callback,
+                                       std::vector<RefCntBuffer> serialized_replicates = {});
 
   // Blocks the current thread until all the entries in the log queue are flushed and fsynced (if
   // fsync of log entries is enabled).
@@ -158,12 +168,16 @@ class Log : public RefCountedThreadSafe<Log> {
   // The closure submitted to allocation_pool_ to allocate a new segment.
   void SegmentAllocationTask();
 
+  // The closure submitted to archive_pool_ to copy closed segments to the log archive.
+  void ArchiveSegmentsTask() EXCLUDES(archive_mutex_);
+
   // Syncs all state and closes the log.
   CHECKED_STATUS Close();
 
-  // Delete all WAL data from the log associated with this tablet.
+  // Delete all WAL data from the log associated with this tablet, see
+  // FsManager::DeleteRecursivelyThrottled.
   // REQUIRES: The Log must be closed.
-  static CHECKED_STATUS DeleteOnDiskData(Env* env,
+  static CHECKED_STATUS DeleteOnDiskData(FsManager* fs_manager,
                                          const std::string& tablet_id,
                                          const std::string& tablet_wal_path,
                                          const std::string& peer_uuid);
@@ -233,6 +247,9 @@ class Log : public RefCountedThreadSafe<Log> {
   // Returns 0 if the log is shut down.
   uint64_t OnDiskSize();
 
+  // Returns the number of bytes appended to the log since it was opened, or 0 without metrics.
+  uint64_t BytesLogged() const;
+
   void ListenPostAppend(std::function<void()> listener) {
     post_append_listener_ = std::move(listener);
   }
@@ -368,6 +385,16 @@ class Log : public RefCountedThreadSafe<Log> {
 
   CHECKED_STATUS Sync();
 
+  // Queues the closed segment for archiving and starts the archive task, if not running.
+  void ArchiveSegmentAsync(int64_t sequence_number, const std::string& path)
+      EXCLUDES(archive_mutex_);
+
+  // Copies the closed segment to archive_dir_, throttled by rate_limiter.
+  CHECKED_STATUS ArchiveSegment(const std::string& path, RateLimiter* rate_limiter);
+
+  // Deletes the oldest archived segments above log_archive_max_segments_per_tablet.
+  CHECKED_STATUS CleanupArchive();
+
   // Helper method to get the segment sequence to GC based on the provided min_op_idx.
   CHECKED_STATUS GetSegmentsToGCUnlocked(int64_t min_op_idx, SegmentSequence* segments_to_gc) const;
 
@@ -504,6 +531,24 @@ class Log : public RefCountedThreadSafe<Log> {
   // The current replicated index that CDC has read.  Used for CDC read cache optimization.
   std::atomic<int64_t> cdc_min_replicated_index_{std::numeric_limits<int64_t>::max()};
 
+  // Directory where closed segments of this tablet are archived, empty when archiving is disabled.
+  std::string archive_dir_;
+
+  std::mutex archive_mutex_;
+
+  // Closed segments, as sequence number and path, that are not archived yet, oldest first.
+  std::deque<std::pair<int64_t, std::string>> segments_to_archive_ GUARDED_BY(archive_mutex_);
+  bool archive_task_running_ GUARDED_BY(archive_mutex_) = false;
+
+  // Sequence number of the last archived segment. Segments after it are not GCed.
+  std::atomic<int64_t> last_archived_segment_seq_{-1};
+
+  // Counted down when the log is closed, to stop archiving and waiting for archive retries.
+  CountDownLatch archive_stop_latch_{1};
+
+  // A thread pool for asynchronously archiving closed log segments.
+  gscoped_ptr<ThreadPool> archive_pool_;
+
   DISALLOW_COPY_AND_ASSIGN(Log);
 };
 
@@ -521,6 +566,9 @@ class LogEntryBatch {
   // Serializes contents of the entry to an internal buffer.
   CHECKED_STATUS Serialize();
 
+  // Serializes the entry using serialized_replicates_ instead of serializing replicates.
+  void SerializeFromSerializedReplicates();
+
   // Sets the callback that will be invoked after the entry is
   // appended and synced to disk
   void set_callback(const StatusCallback& cb) {
@@ -570,8 +618,10 @@ class LogEntryBatch {
     return entry_batch_pb_.entry(idx).replicate().id();
   }
 
-  void SetReplicates(const ReplicateMsgs& replicates) {
+  void SetReplicates(const ReplicateMsgs& replicates,
+                     std::vector<RefCntBuffer> serialized_replicates = {}) {
     replicates_ = replicates;
+    serialized_replicates_ = std::move(serialized_replicates);
   }
 
   // The type of entries in this batch.
@@ -590,6 +640,10 @@ class LogEntryBatch {
   // replicate message until we're finished appending.
   ReplicateMsgs replicates_;
 
+  // When not empty, replicates_ serialized as ConsensusRequestPB::ops elements, shared with the log
+  // cache and requests to followers.
+  std::vector<RefCntBuffer> serialized_replicates_;
+
   // Callback to be invoked upon the entries being written and synced to disk.
   StatusCallback callback_;
 
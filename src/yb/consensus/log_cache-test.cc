@@ -258,11 +258,62 @@ TEST_F(LogCacheTest, TestCacheEdgeCases) {
 }
 
 
+// Tests that serialized messages could be parsed as request ops and are shared by the following
+// reads.
+TEST_F(LogCacheTest, TestSerializedMessages) {
+  const size_t kNumOps = 10;
+  ASSERT_OK(AppendReplicateMessagesToCache(1, kNumOps));
+  ASSERT_OK(log_->WaitUntilAllFlushed());
+  const auto size_before_read = cache_->metrics_.size->value();
+
+  // Messages were serialized when appended, so reads do not use additional memory.
+  auto read_result = ASSERT_RESULT(cache_->ReadOps(0, 8_MB));
+  ASSERT_EQ(kNumOps, read_result.messages.size());
+  ASSERT_EQ(kNumOps, read_result.serialized_messages.size());
+  ASSERT_EQ(size_before_read, cache_->metrics_.size->value());
+
+  std::string serialized;
+  for (const auto& buffer : read_result.serialized_messages) {
+    serialized.append(buffer.data(), buffer.size());
+  }
+  ConsensusRequestPB request;
+  ASSERT_TRUE(request.ParsePartialFromString(serialized));
+  ASSERT_EQ(kNumOps, static_cast<size_t>(request.ops_size()));
+  for (size_t i = 0; i != kNumOps; ++i) {
+    ASSERT_EQ(read_result.messages[i]->SerializeAsString(), request.ops(i).SerializeAsString());
+  }
+
+  // Following reads reuse the same data.
+  const auto size_after_read = cache_->metrics_.size->value();
+  auto second_read_result = ASSERT_RESULT(cache_->ReadOps(0, 8_MB));
+  ASSERT_EQ(kNumOps, second_read_result.serialized_messages.size());
+  for (size_t i = 0; i != kNumOps; ++i) {
+    ASSERT_EQ(read_result.serialized_messages[i].data(),
+              second_read_result.serialized_messages[i].data());
+  }
+  ASSERT_EQ(size_after_read, cache_->metrics_.size->value());
+
+  // Messages read from disk are also serialized. WAL entries were written from the serialized
+  // messages, so they should be the same as the appended messages.
+  cache_->EvictThroughOp(kNumOps);
+  ASSERT_EQ(0, cache_->num_cached_ops());
+  auto disk_read_result = ASSERT_RESULT(cache_->ReadOps(0, 8_MB));
+  ASSERT_EQ(kNumOps, disk_read_result.messages.size());
+  ASSERT_EQ(kNumOps, disk_read_result.serialized_messages.size());
+  ASSERT_EQ(0, cache_->num_cached_ops());
+  for (size_t i = 0; i != kNumOps; ++i) {
+    ASSERT_EQ(read_result.messages[i]->SerializeAsString(),
+              disk_read_result.messages[i]->SerializeAsString());
+  }
+}
+
+
 TEST_F(LogCacheTest, TestMemoryLimit) {
   FLAGS_log_cache_size_limit_mb = 1;
   CloseAndReopenCache(MinimumOpId());
 
-  const int kPayloadSize = 400_KB;
+  // Each op is kept both as a message and serialized.
+  const int kPayloadSize = 200_KB;
   // Limit should not be violated.
   ASSERT_OK(AppendReplicateMessagesToCache(1, 1, kPayloadSize));
   ASSERT_OK(log_->WaitUntilAllFlushed());
@@ -311,7 +362,8 @@ TEST_F(LogCacheTest, TestGlobalMemoryLimit) {
   // Exceed the global hard limit.
   ScopedTrackedConsumption consumption(cache_->parent_tracker_, 3_MB);
 
-  const int kPayloadSize = 768_KB;
+  // Each op is kept both as a message and serialized.
+  const int kPayloadSize = 384_KB;
 
   // Should succeed, but only end up caching one of the two ops because of the global limit.
   ASSERT_OK(AppendReplicateMessagesToCache(1, 2, kPayloadSize));
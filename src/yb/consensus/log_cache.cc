@@ -70,6 +70,13 @@ DEFINE_int32(global_log_cache_size_limit_mb, 1024,
              "caching log entries across all tablets is kept under this threshold.");
 TAG_FLAG(global_log_cache_size_limit_mb, advanced);
 
+DEFINE_bool(consensus_reuse_serialized_ops, true,
+            "Serialize each operation of the log cache once, when it is appended, and use the same "
+            "serialized data for the WAL write and for requests to all followers, instead of "
+            "serializing it again for the WAL and for every request to every follower.");
+TAG_FLAG(consensus_reuse_serialized_ops, advanced);
+TAG_FLAG(consensus_reuse_serialized_ops, runtime);
+
 DEFINE_test_flag(bool, TEST_log_cache_skip_eviction, false,
                  "Don't evict log entries in tests.");
 
@@ -92,6 +99,23 @@ namespace {
 
 const std::string kParentMemTrackerId = "log_cache"s;
 
+// Serializes msg in the same way as it is serialized as an element of ConsensusRequestPB::ops.
+RefCntBuffer SerializeAsRequestOp(const ReplicateMsg& msg) {
+  using google::protobuf::internal::WireFormatLite;
+  using google::protobuf::io::CodedOutputStream;
+
+  const uint32_t tag = WireFormatLite::MakeTag(
+      ConsensusRequestPB::kOpsFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+  const int msg_size = msg.ByteSize();
+  RefCntBuffer result(
+      CodedOutputStream::VarintSize32(tag) + WireFormatLite::LengthDelimitedSize(msg_size));
+  uint8_t* dst = CodedOutputStream::WriteTagToArray(tag, result.udata());
+  dst = CodedOutputStream::WriteVarint32ToArray(msg_size, dst);
+  dst = msg.SerializeWithCachedSizesToArray(dst);
+  DCHECK_EQ(dst, result.udata() + result.size());
+  return result;
+}
+
 }
 
 typedef vector<const ReplicateMsg*>::const_iterator MsgIter;
@@ -151,8 +175,18 @@ Result<LogCache::PrepareAppendResult> LogCache::PrepareAppendOperations(const Re
   PrepareAppendResult result;
   std::vector<CacheEntry> entries_to_insert;
   entries_to_insert.reserve(msgs.size());
+  // Ops are serialized once here, the same data is written to the WAL and sent to followers.
+  const bool serialize = FLAGS_consensus_reuse_serialized_ops;
+  if (serialize) {
+    result.serialized_messages.reserve(msgs.size());
+  }
   for (const auto& msg : msgs) {
     CacheEntry e = { msg, static_cast<int64_t>(msg->SpaceUsedLong()) };
+    if (serialize) {
+      e.serialized = SerializeAsRequestOp(*msg);
+      e.mem_usage += e.serialized.size();
+      result.serialized_messages.push_back(e.serialized);
+    }
     result.mem_required += e.mem_usage;
     entries_to_insert.emplace_back(std::move(e));
   }
@@ -197,7 +231,8 @@ Status LogCache::AppendOperations(const ReplicateMsgs& msgs, const yb::OpId& com
 
   Status log_status = log_->AsyncAppendReplicates(
     msgs, committed_op_id, batch_mono_time,
-    Bind(&LogCache::LogCallback, Unretained(this), prepare_result.last_idx_in_batch, callback));
+    Bind(&LogCache::LogCallback, Unretained(this), prepare_result.last_idx_in_batch, callback),
+    std::move(prepare_result.serialized_messages));
 
   if (!log_status.ok()) {
     LOG_WITH_PREFIX_UNLOCKED(WARNING) << "Couldn't append to log: " << log_status;
@@ -327,6 +362,9 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
         remaining_space -= current_message_size;
         if (remaining_space >= 0 || result.messages.empty()) {
           result.messages.push_back(msg);
+          if (FLAGS_consensus_reuse_serialized_ops) {
+            result.serialized_messages.emplace_back();
+          }
           result.read_from_disk_size += current_message_size;
           next_index++;
         } else {
@@ -354,14 +392,71 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
         }
 
         result.messages.push_back(msg);
+        if (FLAGS_consensus_reuse_serialized_ops) {
+          result.serialized_messages.push_back(iter->second.serialized);
+        }
         next_index++;
       }
     }
   }
 
+  if (!result.serialized_messages.empty()) {
+    FillSerializedMessages(&l, &result);
+  }
+
   return result;
 }
 
+void LogCache::FillSerializedMessages(
+    std::unique_lock<simple_spinlock>* lock, ReadOpsResult* result) {
+  // The flag could be changed while reading.
+  if (result->serialized_messages.size() != result->messages.size()) {
+    result->serialized_messages.clear();
+    return;
+  }
+
+  std::vector<size_t> new_serialized;
+  for (size_t i = 0; i != result->messages.size(); ++i) {
+    if (!result->serialized_messages[i]) {
+      new_serialized.push_back(i);
+    }
+  }
+  if (new_serialized.empty()) {
+    return;
+  }
+
+  lock->unlock();
+  for (auto i : new_serialized) {
+    result->serialized_messages[i] = SerializeAsRequestOp(*result->messages[i]);
+  }
+  lock->lock();
+
+  // Store serialized messages in the cache, so the following reads for other peers reuse them.
+  // Entry could be evicted or replaced while the lock was released, so check it is still the same.
+  int64_t mem_required = 0;
+  int64_t tracked_mem_required = 0;
+  for (auto i : new_serialized) {
+    const auto& msg = result->messages[i];
+    auto it = cache_.find(msg->id().index());
+    if (it == cache_.end() || it->second.msg != msg || it->second.serialized) {
+      continue;
+    }
+    auto& entry = it->second;
+    entry.serialized = result->serialized_messages[i];
+    entry.mem_usage += entry.serialized.size();
+    mem_required += entry.serialized.size();
+    if (entry.tracked) {
+      tracked_mem_required += entry.serialized.size();
+    }
+  }
+  if (mem_required) {
+    metrics_.size->IncrementBy(mem_required);
+  }
+  if (tracked_mem_required) {
+    tracker_->Consume(tracked_mem_required);
+  }
+}
+
 size_t LogCache::EvictThroughOp(int64_t index, int64_t bytes_to_evict) {
   std::lock_guard<simple_spinlock> lock(lock_);
   return EvictSomeUnlocked(index, bytes_to_evict);
@@ -47,6 +47,7 @@
 #include "yb/util/locks.h"
 #include "yb/util/metrics.h"
 #include "yb/util/opid.h"
+#include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/restart_safe_clock.h"
 #include "yb/util/result.h"
 
@@ -69,6 +70,9 @@ struct ReadOpsResult {
   yb::OpId preceding_op;
   bool have_more_messages = false;
   int64_t read_from_disk_size = 0;
+  // When not empty, contains messages serialized as ConsensusRequestPB::ops elements, in the same
+  // order as messages. See consensus_reuse_serialized_ops.
+  std::vector<RefCntBuffer> serialized_messages;
 };
 
 // Write-through cache for the log.
@@ -185,6 +189,11 @@ class LogCache {
 
     // Did we start memory tracking for this entry.
     bool tracked = false;
+
+    // msg serialized as ConsensusRequestPB::ops element, filled when the entry is appended or on
+    // the first read of the entry. Shared by the WAL write and requests to all peers. Accounted in
+    // mem_usage.
+    RefCntBuffer serialized;
   };
 
   // Try to evict the oldest operations from the queue, stopping either when
@@ -196,6 +205,11 @@ class LogCache {
   // given message.
   void AccountForMessageRemovalUnlocked(const CacheEntry& entry);
 
+  // Fills result->serialized_messages, serializing messages that were not serialized yet and
+  // storing them in the cache. Lock should be held on entry, but acquired and released during
+  // serialization.
+  void FillSerializedMessages(std::unique_lock<simple_spinlock>* lock, ReadOpsResult* result);
+
   // Return a string with stats
   std::string StatsStringUnlocked() const;
 
@@ -212,6 +226,9 @@ class LogCache {
     int64_t mem_required = 0;
     // Last idx in batch of provided operations.
     int64_t last_idx_in_batch = -1;
+    // Provided operations serialized as ConsensusRequestPB::ops elements, empty when
+    // consensus_reuse_serialized_ops is disabled.
+    std::vector<RefCntBuffer> serialized_messages;
   };
 
   Result<PrepareAppendResult> PrepareAppendOperations(const ReplicateMsgs& msgs);
@@ -61,6 +61,12 @@ DEFINE_int32(log_max_seconds_to_retain, 24 * 3600, "Log files that are older wil
              "ignored. This flag is ignored if a log segment contains entries that haven't been"
              "flushed to RocksDB.");
 
+DEFINE_int32(log_reader_readahead_bytes, 1024 * 1024,
+             "Size of sequential reads issued when a range of operations is read from a log "
+             "segment, e.g. to catch up a lagging follower. 0 means that each entry batch is "
+             "read separately.");
+TAG_FLAG(log_reader_readahead_bytes, advanced);
+
 DEFINE_int64(log_stop_retaining_min_disk_mb, 100 * 1024, "Stop retaining logs if the space "
              "available for the logs falls below this limit. This flag is ignored if a log segment "
              "contains unflushed entries.");
@@ -381,7 +387,7 @@ scoped_refptr<ReadableLogSegment> LogReader::GetSegmentBySequenceNumber(int64_t
 }
 
 Status LogReader::ReadBatchUsingIndexEntry(const LogIndexEntry& index_entry,
-                                           faststring* tmp_buf,
+                                           std::unique_ptr<LogEntryBatchReader>* reader,
                                            LogEntryBatchPB* batch) const {
   const int64_t index = index_entry.op_id.index;
 
@@ -393,10 +399,16 @@ Status LogReader::ReadBatchUsingIndexEntry(const LogIndexEntry& index_entry,
                                        index));
   }
 
+  if (!*reader || (*reader)->segment() != segment) {
+    reader->reset(new LogEntryBatchReader(
+        segment, std::max(FLAGS_log_reader_readahead_bytes, 0)));
+  }
+
   CHECK_GT(index_entry.offset_in_segment, 0);
   int64_t offset = index_entry.offset_in_segment;
+  int64_t next_offset = offset;
   ScopedLatencyMetric scoped(read_batch_latency_.get());
-  RETURN_NOT_OK_PREPEND(segment->ReadEntryHeaderAndBatch(&offset, tmp_buf, batch),
+  RETURN_NOT_OK_PREPEND((*reader)->Read(offset, batch, &next_offset),
                         Substitute("Failed to read LogEntry for index $0 from log segment "
                                    "$1 offset $2",
                                    index,
@@ -404,7 +416,7 @@ Status LogReader::ReadBatchUsingIndexEntry(const LogIndexEntry& index_entry,
                                    index_entry.offset_in_segment));
 
   if (bytes_read_) {
-    bytes_read_->IncrementBy(kEntryHeaderSize + tmp_buf->length());
+    bytes_read_->IncrementBy(next_offset - offset);
     entries_read_->IncrementBy(batch->entry_size());
   }
 
@@ -427,7 +439,7 @@ Status LogReader::ReadReplicatesInRange(
 
   int64_t total_size = 0;
   bool limit_exceeded = false;
-  faststring tmp_buf;
+  std::unique_ptr<LogEntryBatchReader> reader;
   LogEntryBatchPB batch;
   for (int64_t index = starting_at; index <= up_to && !limit_exceeded; index++) {
     LogIndexEntry index_entry;
@@ -441,7 +453,7 @@ Status LogReader::ReadReplicatesInRange(
     if (index == starting_at ||
         index_entry.segment_sequence_number != prev_index_entry.segment_sequence_number ||
         index_entry.offset_in_segment != prev_index_entry.offset_in_segment) {
-      RETURN_NOT_OK(ReadBatchUsingIndexEntry(index_entry, &tmp_buf, &batch));
+      RETURN_NOT_OK(ReadBatchUsingIndexEntry(index_entry, &reader, &batch));
 
       // Sanity-check the property that a batch should only have increasing indexes.
       int64_t prev_index = 0;
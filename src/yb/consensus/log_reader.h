@@ -33,6 +33,7 @@
 #define YB_CONSENSUS_LOG_READER_H
 
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -190,9 +191,10 @@ class LogReader {
   void UpdateLastSegmentOffset(int64_t readable_to_offset);
 
   // Read the LogEntryBatch pointed to by the provided index entry.
-  // 'tmp_buf' is used as scratch space to avoid extra allocation.
+  // 'reader' is reused while consecutive entries are located in the same segment, so sequential
+  // batches are served from its readahead buffer. It is replaced when the segment changes.
   CHECKED_STATUS ReadBatchUsingIndexEntry(const LogIndexEntry& index_entry,
-                                          faststring* tmp_buf,
+                                          std::unique_ptr<LogEntryBatchReader>* reader,
                                           LogEntryBatchPB* batch) const;
 
   LogReader(Env* env, const scoped_refptr<LogIndex>& index,
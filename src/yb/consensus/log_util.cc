@@ -37,6 +37,10 @@
 #include <limits>
 #include <utility>
 
+#include <lz4.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+
 #include <gflags/gflags.h>
 #include <glog/logging.h>
 
@@ -79,6 +83,15 @@ DEFINE_int32(bytes_durable_wal_write_mb, 1,
              "If 0 fsysnc() is not called.");
 TAG_FLAG(bytes_durable_wal_write_mb, stable);
 
+DEFINE_string(log_compression_type, "none",
+              "Compression used for entry batches of new WAL segments: none or lz4.");
+TAG_FLAG(log_compression_type, advanced);
+
+DEFINE_int32(log_min_compressed_batch_size, 256,
+             "Entry batches smaller than this size are not compressed, since compression of "
+             "small batches does not save much space.");
+TAG_FLAG(log_min_compressed_batch_size, advanced);
+
 DEFINE_bool(log_preallocate_segments, true,
             "Whether the WAL should preallocate the entire segment before writing to it");
 TAG_FLAG(log_preallocate_segments, advanced);
@@ -122,11 +135,87 @@ const size_t kLogSegmentFooterMagicAndFooterLength  = 12;
 const size_t kEntryHeaderSize = 12;
 
 const int kLogMajorVersion = 1;
+const int kLogCompressedMajorVersion = 2;
 const int kLogMinorVersion = 0;
 
 // Maximum log segment header/footer size, in bytes (8 MB).
 const uint32_t kLogSegmentMaxHeaderOrFooterSize = 8 * 1024 * 1024;
 
+namespace {
+
+// Size of the compression type and uncompressed size, that prefix compressed entry batches.
+constexpr size_t kCompressedBatchPrefixSize = 1 + sizeof(uint32_t);
+
+LogCompressionType ParseLogCompressionType(const std::string& value) {
+  if (boost::iequals(value, "lz4")) {
+    return LZ4_COMPRESSION;
+  }
+  LOG_IF(DFATAL, !boost::iequals(value, "none"))
+      << "Unknown log compression type: " << value << ", compression disabled";
+  return NO_COMPRESSION;
+}
+
+// Encodes entry batch for the segment with the specified compression type, see
+// LogSegmentHeaderPB::compression_type for the format.
+void EncodeEntryBatch(LogCompressionType type, const Slice& data, faststring* out) {
+  out->clear();
+  if (type == LZ4_COMPRESSION &&
+      data.size() >= static_cast<size_t>(FLAGS_log_min_compressed_batch_size)) {
+    int bound = LZ4_compressBound(data.size());
+    out->resize(kCompressedBatchPrefixSize + bound);
+    int compressed_size = LZ4_compress_default(
+        data.cdata(), reinterpret_cast<char*>(out->data()) + kCompressedBatchPrefixSize,
+        data.size(), bound);
+    // Keep the batch uncompressed if compression does not save space.
+    if (compressed_size > 0 && kCompressedBatchPrefixSize + compressed_size < data.size() + 1) {
+      out->data()[0] = LZ4_COMPRESSION;
+      EncodeFixed32(out->data() + 1, data.size());
+      out->resize(kCompressedBatchPrefixSize + compressed_size);
+      return;
+    }
+    out->clear();
+  }
+  out->push_back(NO_COMPRESSION);
+  out->append(data.data(), data.size());
+}
+
+// Decodes entry batch of compressed segment, result points either to data or to buffer.
+Status DecodeEntryBatch(const Slice& data, faststring* buffer, Slice* result) {
+  if (data.empty()) {
+    return STATUS(Corruption, "Empty compressed entry batch");
+  }
+  switch (data[0]) {
+    case NO_COMPRESSION:
+      *result = data;
+      result->remove_prefix(1);
+      return Status::OK();
+    case LZ4_COMPRESSION: {
+      if (data.size() < kCompressedBatchPrefixSize) {
+        return STATUS_FORMAT(Corruption, "Too short compressed entry batch: $0", data.size());
+      }
+      uint32_t uncompressed_size = DecodeFixed32(data.data() + 1);
+      if (uncompressed_size > LZ4_MAX_INPUT_SIZE) {
+        return STATUS_FORMAT(Corruption, "Too big uncompressed entry batch: $0", uncompressed_size);
+      }
+      buffer->resize(uncompressed_size);
+      int decompressed_size = LZ4_decompress_safe(
+          data.cdata() + kCompressedBatchPrefixSize, reinterpret_cast<char*>(buffer->data()),
+          data.size() - kCompressedBatchPrefixSize, uncompressed_size);
+      if (decompressed_size < 0 || static_cast<uint32_t>(decompressed_size) != uncompressed_size) {
+        return STATUS_FORMAT(
+            Corruption, "Failed to decompress entry batch, expected size: $0, decompressed: $1",
+            uncompressed_size, decompressed_size);
+      }
+      *result = Slice(buffer->data(), uncompressed_size);
+      return Status::OK();
+    }
+  }
+  return STATUS_FORMAT(Corruption, "Unknown entry batch compression type: $0",
+                       static_cast<int>(data[0]));
+}
+
+} // namespace
+
 LogOptions::LogOptions()
     : segment_size_bytes(FLAGS_log_segment_size_bytes == 0 ? FLAGS_log_segment_size_mb * 1_MB
                                                            : FLAGS_log_segment_size_bytes),
@@ -135,6 +224,7 @@ LogOptions::LogOptions()
                                      MonoDelta::FromMilliseconds(
                                          FLAGS_interval_durable_wal_write_ms) : MonoDelta()),
       bytes_durable_wal_write_mb(FLAGS_bytes_durable_wal_write_mb),
+      compression_type(ParseLogCompressionType(FLAGS_log_compression_type)),
       preallocate_segments(FLAGS_log_preallocate_segments),
       async_preallocate_segments(FLAGS_log_async_preallocate_segments),
       env(Env::Default()) {
@@ -311,6 +401,15 @@ Status ReadableLogSegment::ReadHeader() {
                                                 header_size),
                         "Unable to parse protobuf");
 
+  if (header.major_version() > kLogCompressedMajorVersion) {
+    return STATUS_FORMAT(NotSupported, "Unsupported log segment major version $0 in $1",
+                         header.major_version(), path_);
+  }
+  if (header.has_compression_type() && header.major_version() < kLogCompressedMajorVersion) {
+    return STATUS_FORMAT(Corruption, "Compressed log segment $0 has major version $1",
+                         path_, header.major_version());
+  }
+
   header_.CopyFrom(header);
   first_entry_offset_ = header_size + kLogSegmentHeaderMagicAndHeaderLength;
 
@@ -812,29 +911,91 @@ Status ReadableLogSegment::ReadEntryBatch(int64_t *offset,
   if (!s.ok()) return STATUS(IOError, Substitute("Could not read entry. Cause: $0",
                                                  s.ToString()));
 
+  RETURN_NOT_OK(ParseEntryBatch(*offset, header, entry_batch_slice, entry_batch));
+  *offset += entry_batch_slice.size();
+  return Status::OK();
+}
+
+Status ReadableLogSegment::ParseEntryBatch(int64_t offset,
+                                           const EntryHeader& header,
+                                           const Slice& data,
+                                           LogEntryBatchPB* entry_batch) {
   // Verify the CRC.
-  uint32_t read_crc = crc::Crc32c(entry_batch_slice.data(), entry_batch_slice.size());
+  uint32_t read_crc = crc::Crc32c(data.data(), data.size());
   if (PREDICT_FALSE(read_crc != header.msg_crc)) {
     return STATUS(Corruption, Substitute("Entry CRC mismatch in byte range $0-$1: "
                                          "expected CRC=$2, computed=$3",
-                                         *offset, *offset + header.msg_length,
+                                         offset, offset + header.msg_length,
                                          header.msg_crc, read_crc));
   }
 
+  Slice batch_data = data;
+  faststring decompressed_buf;
+  if (header_.has_compression_type()) {
+    RETURN_NOT_OK(DecodeEntryBatch(data, &decompressed_buf, &batch_data));
+  }
 
   LogEntryBatchPB read_entry_batch;
-  s = pb_util::ParseFromArray(&read_entry_batch,
-                              entry_batch_slice.data(),
-                              header.msg_length);
+  Status s = pb_util::ParseFromArray(&read_entry_batch,
+                                     batch_data.data(),
+                                     batch_data.size());
 
   if (!s.ok()) return STATUS(Corruption, Substitute("Could parse PB. Cause: $0",
                                                     s.ToString()));
 
-  *offset += entry_batch_slice.size();
   entry_batch->Swap(&read_entry_batch);
   return Status::OK();
 }
 
+LogEntryBatchReader::LogEntryBatchReader(
+    scoped_refptr<ReadableLogSegment> segment, size_t readahead_size)
+    : segment_(std::move(segment)), readahead_size_(readahead_size) {
+}
+
+Status LogEntryBatchReader::Read(int64_t offset, LogEntryBatchPB* batch, int64_t* next_offset) {
+  ReadableLogSegment::EntryHeader header;
+  RETURN_NOT_OK_PREPEND(segment_->DecodeEntryHeader(
+                            VERIFY_RESULT(ReadRange(offset, kEntryHeaderSize)), &header),
+                        "Could not read log entry header");
+  offset += kEntryHeaderSize;
+
+  if (header.msg_length == 0) {
+    return STATUS(Corruption, "Invalid 0 entry length");
+  }
+  int64_t limit = segment_->readable_up_to();
+  if (PREDICT_FALSE(header.msg_length + offset > limit)) {
+    // The log was likely truncated during writing.
+    return STATUS_FORMAT(
+        Corruption,
+        "Could not read $0-byte log entry from offset $1 in $2: log only readable up to offset $3",
+        header.msg_length, offset, segment_->path(), limit);
+  }
+
+  auto data = VERIFY_RESULT(ReadRange(offset, header.msg_length));
+  RETURN_NOT_OK(segment_->ParseEntryBatch(offset, header, data, batch));
+  *next_offset = offset + header.msg_length;
+  return Status::OK();
+}
+
+Result<Slice> LogEntryBatchReader::ReadRange(int64_t offset, size_t size) {
+  if (offset >= buffered_offset_ &&
+      offset + size <= buffered_offset_ + buffered_.size()) {
+    return Slice(buffered_.data() + (offset - buffered_offset_), size);
+  }
+
+  // Read ahead, but not beyond the readable part of the segment.
+  auto readable_size = segment_->readable_up_to() - offset;
+  size_t read_size = size;
+  if (readable_size > 0) {
+    read_size = std::max(size, std::min<size_t>(readahead_size_, readable_size));
+  }
+  buffer_.resize(read_size);
+  RETURN_NOT_OK(ReadFully(
+      segment_->readable_file().get(), offset, read_size, &buffered_, buffer_.data()));
+  buffered_offset_ = offset;
+  return Slice(buffered_.data(), size);
+}
+
 WritableLogSegment::WritableLogSegment(string path,
                                        shared_ptr<WritableFile> writable_file)
     : path_(std::move(path)),
@@ -896,9 +1057,14 @@ Status WritableLogSegment::WriteFooterAndClose(const LogSegmentFooterPB& footer)
 }
 
 
-Status WritableLogSegment::WriteEntryBatch(const Slice& data) {
+Status WritableLogSegment::WriteEntryBatch(const Slice& entry_batch_data) {
   DCHECK(is_header_written_);
   DCHECK(!is_footer_written_);
+  Slice data = entry_batch_data;
+  if (header_.has_compression_type()) {
+    EncodeEntryBatch(header_.compression_type(), entry_batch_data, &encode_buffer_);
+    data = Slice(encode_buffer_);
+  }
   uint8_t header_buf[kEntryHeaderSize];
 
   // First encode the length of the message.
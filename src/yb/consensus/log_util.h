@@ -48,6 +48,7 @@
 #include "yb/gutil/ref_counted.h"
 #include "yb/util/atomic.h"
 #include "yb/util/env.h"
+#include "yb/util/faststring.h"
 #include "yb/util/monotime.h"
 #include "yb/util/opid.h"
 #include "yb/util/restart_safe_clock.h"
@@ -75,6 +76,9 @@ extern const char kTmpSuffix[];
 extern const size_t kEntryHeaderSize;
 
 extern const int kLogMajorVersion;
+// Major version of segments with compressed entry batches, that could not be read as the old
+// format.
+extern const int kLogCompressedMajorVersion;
 extern const int kLogMinorVersion;
 
 class ReadableLogSegment;
@@ -95,6 +99,9 @@ struct LogOptions {
   // If non-zero, call fsync on a call to Append() if more than given amount of data to sync.
   int32_t bytes_durable_wal_write_mb;
 
+  // Compression of entry batches in new segments.
+  LogCompressionType compression_type;
+
   // Whether to fallocate segments before writing to them.
   bool preallocate_segments;
 
@@ -259,6 +266,7 @@ class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
  private:
   friend class RefCountedThreadSafe<ReadableLogSegment>;
   friend class LogReader;
+  friend class LogEntryBatchReader;
   FRIEND_TEST(LogTest, TestWriteAndReadToAndFromInProgressSegment);
 
   struct EntryHeader {
@@ -325,6 +333,13 @@ class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
                                 faststring* tmp_buf,
                                 LogEntryBatchPB* entry_batch);
 
+  // Verifies the CRC of the entry batch data read at the given offset and decodes it into
+  // 'entry_batch'.
+  CHECKED_STATUS ParseEntryBatch(int64_t offset,
+                                 const EntryHeader& header,
+                                 const Slice& data,
+                                 LogEntryBatchPB* entry_batch);
+
   void UpdateReadableToOffset(int64_t readable_to_offset);
 
   const std::string path_;
@@ -363,6 +378,34 @@ class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
   DISALLOW_COPY_AND_ASSIGN(ReadableLogSegment);
 };
 
+// Reads entry batches of a log segment. Batches that follow each other in the segment are read
+// with large sequential reads, instead of separate small reads of each entry header and batch.
+class LogEntryBatchReader {
+ public:
+  LogEntryBatchReader(scoped_refptr<ReadableLogSegment> segment, size_t readahead_size);
+
+  // Reads the entry batch located at offset. Sets *next_offset to the offset of the next batch.
+  CHECKED_STATUS Read(int64_t offset, LogEntryBatchPB* batch, int64_t* next_offset);
+
+  const scoped_refptr<ReadableLogSegment>& segment() const {
+    return segment_;
+  }
+
+ private:
+  // Returns size bytes of the segment starting at offset, reading ahead when they are not buffered.
+  Result<Slice> ReadRange(int64_t offset, size_t size);
+
+  const scoped_refptr<ReadableLogSegment> segment_;
+  const size_t readahead_size_;
+
+  faststring buffer_;
+  // Buffered data and the segment offset it was read from.
+  Slice buffered_;
+  int64_t buffered_offset_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(LogEntryBatchReader);
+};
+
 // A writable log segment where state data is stored.
 class WritableLogSegment {
  public:
@@ -385,7 +428,7 @@ class WritableLogSegment {
   }
 
   // Appends the provided batch of data, including a header
-  // and checksum.
+  // and checksum. The batch is compressed if the segment header specifies compression.
   // Makes sure that the log segment has not been closed.
   CHECKED_STATUS WriteEntryBatch(const Slice& entry_batch_data);
 
@@ -446,6 +489,9 @@ class WritableLogSegment {
 
   LogSegmentFooterPB footer_;
 
+  // Buffer used to encode entry batches of compressed segments.
+  faststring encode_buffer_;
+
   // the offset of the first entry in the log
   int64_t first_entry_offset_;
 
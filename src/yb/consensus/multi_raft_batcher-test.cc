@@ -0,0 +1,99 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "yb/consensus/multi_raft_batcher.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace consensus {
+
+class MultiRaftBatcherTest : public YBTest {
+ protected:
+  ConsensusRequestPB MakeRequest(const std::string& tablet_id) {
+    ConsensusRequestPB request;
+    request.set_tablet_id(tablet_id);
+    return request;
+  }
+
+  ConsensusRequestPB MakeRequest(
+      const std::string& tablet_id, int32_t lease_duration_ms, uint64_t ht_lease_expiration) {
+    auto request = MakeRequest(tablet_id);
+    request.set_leader_lease_duration_ms(lease_duration_ms);
+    request.set_ht_lease_expiration(ht_lease_expiration);
+    return request;
+  }
+};
+
+// Every request of the batch should get a lease that covers the lease sent by its leader, when
+// the receiver applies the batch lease.
+TEST_F(MultiRaftBatcherTest, BatchLeaseCoversAllTablets) {
+  MultiRaftConsensusRequestPB batch;
+  *batch.add_consensus_request() = MakeRequest("tablet-1", 2000, 1000);
+  *batch.add_consensus_request() = MakeRequest("tablet-2", 3000, 900);
+  *batch.add_consensus_request() = MakeRequest("tablet-3", 1000, 1200);
+  // Heartbeat without lease, for instance sent by a leader that did not replicate its lease yet.
+  *batch.add_consensus_request() = MakeRequest("tablet-4");
+
+  std::vector<ConsensusRequestPB> original(
+      batch.consensus_request().begin(), batch.consensus_request().end());
+  for (auto& request : *batch.mutable_consensus_request()) {
+    MoveLeaderLeaseToBatch(&request, &batch);
+    ASSERT_FALSE(request.has_leader_lease_duration_ms());
+    ASSERT_FALSE(request.has_ht_lease_expiration());
+  }
+  ASSERT_EQ(3000, batch.leader_lease_duration_ms());
+  ASSERT_EQ(1200U, batch.ht_lease_expiration());
+
+  for (size_t i = 0; i != original.size(); ++i) {
+    auto& request = *batch.mutable_consensus_request(static_cast<int>(i));
+    ApplyBatchLeaderLease(batch, &request);
+    SCOPED_TRACE(request.ShortDebugString());
+    ASSERT_TRUE(request.has_leader_lease_duration_ms());
+    ASSERT_GE(request.leader_lease_duration_ms(), original[i].leader_lease_duration_ms());
+    ASSERT_GE(request.ht_lease_expiration(), original[i].ht_lease_expiration());
+  }
+}
+
+// Requests that carry their own lease, for instance because the sender does not use batch
+// leases, should keep it.
+TEST_F(MultiRaftBatcherTest, OwnLeaseIsKept) {
+  MultiRaftConsensusRequestPB batch;
+  batch.set_leader_lease_duration_ms(3000);
+  batch.set_ht_lease_expiration(1200);
+
+  auto with_lease = MakeRequest("tablet-1", 2000, 1000);
+  ApplyBatchLeaderLease(batch, &with_lease);
+  ASSERT_EQ(2000, with_lease.leader_lease_duration_ms());
+  ASSERT_EQ(1000U, with_lease.ht_lease_expiration());
+
+  auto without_lease = MakeRequest("tablet-2");
+  ApplyBatchLeaderLease(batch, &without_lease);
+  ASSERT_EQ(3000, without_lease.leader_lease_duration_ms());
+  ASSERT_EQ(1200U, without_lease.ht_lease_expiration());
+
+  // Batch without lease does not change requests.
+  MultiRaftConsensusRequestPB batch_without_lease;
+  auto request = MakeRequest("tablet-3");
+  ApplyBatchLeaderLease(batch_without_lease, &request);
+  ASSERT_FALSE(request.has_leader_lease_duration_ms());
+  ASSERT_FALSE(request.has_ht_lease_expiration());
+}
+
+} // namespace consensus
+} // namespace yb
@@ -0,0 +1,261 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/multi_raft_batcher.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include <gflags/gflags.h>
+
+#include "yb/consensus/consensus.proxy.h"
+
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/rpc_controller.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/status.h"
+
+DEFINE_bool(enable_multi_raft_heartbeat_batcher, false,
+            "Send status only Raft heartbeats of all tablets hosted by the same pair of tablet "
+            "servers in a single MultiRaftUpdateConsensus RPC. All tablet servers of the cluster "
+            "should support this RPC before it is enabled.");
+TAG_FLAG(enable_multi_raft_heartbeat_batcher, advanced);
+TAG_FLAG(enable_multi_raft_heartbeat_batcher, runtime);
+
+DEFINE_int32(multi_raft_heartbeat_batch_window_ms, 10,
+             "Time to collect heartbeats to the same tablet server before sending them in a "
+             "single batch.");
+TAG_FLAG(multi_raft_heartbeat_batch_window_ms, advanced);
+
+DEFINE_int32(multi_raft_batch_size, 0,
+             "Max number of heartbeats in a single batch, 0 means no limit.");
+TAG_FLAG(multi_raft_batch_size, advanced);
+
+DEFINE_bool(multi_raft_batch_leader_lease, false,
+            "Send a single leader lease for all heartbeats of a MultiRaftUpdateConsensus batch, "
+            "instead of a lease per tablet. This is a safety requirement, not only a "
+            "compatibility one: it must be enabled only after all tablet servers of the cluster "
+            "were upgraded to a version that supports batch level leases. An older tablet server "
+            "drops the batch lease, so its followers would not record the lease that the leader "
+            "counts on, and could elect a new leader while the old one still serves reads.");
+TAG_FLAG(multi_raft_batch_leader_lease, advanced);
+
+DECLARE_int32(consensus_rpc_timeout_ms);
+
+namespace yb {
+namespace consensus {
+
+void MoveLeaderLeaseToBatch(ConsensusRequestPB* request, MultiRaftConsensusRequestPB* batch) {
+  if (!request->has_leader_lease_duration_ms() || !request->has_ht_lease_expiration()) {
+    return;
+  }
+  // The leader considers its lease valid based on the values it has sent in the request, so
+  // the batch lease should be the longest one, in order to be safe for every tablet.
+  batch->set_leader_lease_duration_ms(std::max(
+      batch->leader_lease_duration_ms(), request->leader_lease_duration_ms()));
+  batch->set_ht_lease_expiration(std::max(
+      batch->ht_lease_expiration(), request->ht_lease_expiration()));
+  request->clear_leader_lease_duration_ms();
+  request->clear_ht_lease_expiration();
+}
+
+void ApplyBatchLeaderLease(const MultiRaftConsensusRequestPB& batch, ConsensusRequestPB* request) {
+  if (batch.has_leader_lease_duration_ms() && !request->has_leader_lease_duration_ms()) {
+    request->set_leader_lease_duration_ms(batch.leader_lease_duration_ms());
+    request->set_ht_lease_expiration(batch.ht_lease_expiration());
+  }
+}
+
+struct MultiRaftHeartbeatBatcher::Batch {
+  struct Entry {
+    ConsensusResponsePB* response;
+    StdStatusCallback callback;
+  };
+
+  MultiRaftConsensusRequestPB request;
+  MultiRaftConsensusResponsePB response;
+  rpc::RpcController controller;
+  std::vector<Entry> entries;
+
+  void Fail(const Status& status) {
+    for (const auto& entry : entries) {
+      entry.callback(status);
+    }
+    entries.clear();
+  }
+};
+
+MultiRaftHeartbeatBatcher::MultiRaftHeartbeatBatcher(
+    std::string dest_uuid, const HostPort& hostport, rpc::ProxyCache* proxy_cache,
+    rpc::Messenger* messenger)
+    : dest_uuid_(std::move(dest_uuid)),
+      hostport_(hostport),
+      proxy_(std::make_unique<ConsensusServiceProxy>(proxy_cache, hostport)),
+      messenger_(messenger) {
+}
+
+MultiRaftHeartbeatBatcher::~MultiRaftHeartbeatBatcher() {
+  // Scheduled flush holds a weak pointer only, so requests that were not sent yet should be
+  // failed here.
+  if (current_batch_) {
+    current_batch_->Fail(STATUS_FORMAT(
+        Aborted, "Heartbeat batcher for $0 at $1 destroyed", dest_uuid_, hostport_));
+  }
+}
+
+void MultiRaftHeartbeatBatcher::AddRequestToBatch(
+    const ConsensusRequestPB& request, ConsensusResponsePB* response,
+    StdStatusCallback callback) {
+  BatchPtr batch_to_send;
+  bool schedule_flush = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!current_batch_) {
+      current_batch_ = std::make_shared<Batch>();
+    }
+    auto& batch_request = current_batch_->request;
+    auto* added_request = batch_request.add_consensus_request();
+    *added_request = request;
+    if (FLAGS_multi_raft_batch_leader_lease) {
+      MoveLeaderLeaseToBatch(added_request, &batch_request);
+    }
+    current_batch_->entries.push_back(Batch::Entry{response, std::move(callback)});
+    if (FLAGS_multi_raft_batch_size > 0 &&
+        current_batch_->entries.size() >= static_cast<size_t>(FLAGS_multi_raft_batch_size)) {
+      batch_to_send = std::move(current_batch_);
+      current_batch_.reset();
+    } else if (!flush_scheduled_) {
+      flush_scheduled_ = true;
+      schedule_flush = true;
+    }
+  }
+
+  if (batch_to_send) {
+    SendBatch(batch_to_send);
+    return;
+  }
+
+  if (schedule_flush) {
+    std::weak_ptr<MultiRaftHeartbeatBatcher> weak_self = shared_from_this();
+    messenger_->scheduler().Schedule(
+        [weak_self](const Status& status) {
+          auto self = weak_self.lock();
+          if (self) {
+            self->FlushBatch(status);
+          }
+        },
+        std::chrono::milliseconds(FLAGS_multi_raft_heartbeat_batch_window_ms));
+  }
+}
+
+void MultiRaftHeartbeatBatcher::FlushBatch(const Status& status) {
+  BatchPtr batch;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    flush_scheduled_ = false;
+    batch = std::move(current_batch_);
+    current_batch_.reset();
+  }
+  if (!batch) {
+    // Batch was already sent because it reached the max size.
+    return;
+  }
+  if (!status.ok()) {
+    // Flush was aborted, most likely because the messenger is shutting down.
+    batch->Fail(status);
+    return;
+  }
+  SendBatch(batch);
+}
+
+void MultiRaftHeartbeatBatcher::SendBatch(const BatchPtr& batch) {
+  batch->request.set_dest_uuid(dest_uuid_);
+  batch->controller.set_timeout(MonoDelta::FromMilliseconds(FLAGS_consensus_rpc_timeout_ms));
+  proxy_->MultiRaftUpdateConsensusAsync(
+      batch->request, &batch->response, &batch->controller,
+      std::bind(&MultiRaftHeartbeatBatcher::ProcessResponse, shared_from_this(), batch));
+}
+
+void MultiRaftHeartbeatBatcher::ProcessResponse(const BatchPtr& batch) {
+  auto status = batch->controller.status();
+  if (!status.ok()) {
+    batch->Fail(status);
+    return;
+  }
+
+  auto& response = batch->response;
+  if (response.has_error()) {
+    // Error related to the whole batch, for instance WRONG_SERVER_UUID, is reported to every peer.
+    for (const auto& entry : batch->entries) {
+      entry.response->Clear();
+      *entry.response->mutable_error() = response.error();
+    }
+    batch->Fail(Status::OK());
+    return;
+  }
+
+  if (static_cast<size_t>(response.consensus_response_size()) != batch->entries.size()) {
+    batch->Fail(STATUS_FORMAT(
+        IllegalState, "Wrong number of responses from $0: $1, while $2 expected",
+        hostport_, response.consensus_response_size(), batch->entries.size()));
+    return;
+  }
+
+  for (size_t i = 0; i != batch->entries.size(); ++i) {
+    const auto& entry = batch->entries[i];
+    entry.response->Swap(response.mutable_consensus_response(static_cast<int>(i)));
+    entry.callback(Status::OK());
+  }
+  batch->entries.clear();
+}
+
+MultiRaftManager::MultiRaftManager(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache)
+    : messenger_(messenger), proxy_cache_(proxy_cache) {
+}
+
+size_t MultiRaftManager::BatcherKeyHash::operator()(const BatcherKey& key) const {
+  size_t result = 0;
+  boost::hash_combine(result, key.first);
+  boost::hash_combine(result, key.second.host());
+  boost::hash_combine(result, key.second.port());
+  return result;
+}
+
+MultiRaftHeartbeatBatcherPtr MultiRaftManager::AddOrGetBatcher(
+    const std::string& dest_uuid, const HostPort& hostport) {
+  BatcherKey key(dest_uuid, hostport);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& weak_batcher = batchers_[key];
+  auto result = weak_batcher.lock();
+  if (!result) {
+    result = std::make_shared<MultiRaftHeartbeatBatcher>(
+        dest_uuid, hostport, proxy_cache_, messenger_);
+    weak_batcher = result;
+  }
+
+  // Cleanup batchers that are not used anymore, so the map does not grow with the cluster churn.
+  for (auto it = batchers_.begin(); it != batchers_.end();) {
+    if (it->second.expired()) {
+      it = batchers_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return result;
+}
+
+}  // namespace consensus
+}  // namespace yb
@@ -0,0 +1,105 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+#define YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "yb/consensus/consensus_fwd.h"
+#include "yb/consensus/consensus.pb.h"
+
+#include "yb/rpc/rpc_fwd.h"
+
+#include "yb/util/net/net_util.h"
+#include "yb/util/status_callback.h"
+
+namespace yb {
+namespace consensus {
+
+// Moves the leader lease of request to the batch level lease, that is extended to cover it.
+void MoveLeaderLeaseToBatch(ConsensusRequestPB* request, MultiRaftConsensusRequestPB* batch);
+
+// Applies the batch level leader lease to request, unless it carries its own lease.
+void ApplyBatchLeaderLease(const MultiRaftConsensusRequestPB& batch, ConsensusRequestPB* request);
+
+// Coalesces status only UpdateConsensus requests (i.e. heartbeats), sent by the leaders of
+// different tablets to the same tablet server, into a single MultiRaftUpdateConsensus RPC.
+//
+// Requests are collected during multi_raft_heartbeat_batch_window_ms after the first request of
+// the batch was added, or until the batch contains multi_raft_batch_size requests.
+class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftHeartbeatBatcher> {
+ public:
+  MultiRaftHeartbeatBatcher(
+      std::string dest_uuid, const HostPort& hostport, rpc::ProxyCache* proxy_cache,
+      rpc::Messenger* messenger);
+  ~MultiRaftHeartbeatBatcher();
+
+  MultiRaftHeartbeatBatcher(const MultiRaftHeartbeatBatcher&) = delete;
+  void operator=(const MultiRaftHeartbeatBatcher&) = delete;
+
+  // Adds a copy of request to the current batch. When the batch RPC finishes, response is filled
+  // and callback is invoked with the status of the batch RPC.
+  void AddRequestToBatch(
+      const ConsensusRequestPB& request, ConsensusResponsePB* response,
+      StdStatusCallback callback);
+
+ private:
+  struct Batch;
+  typedef std::shared_ptr<Batch> BatchPtr;
+
+  void FlushBatch(const Status& status);
+  void SendBatch(const BatchPtr& batch);
+  void ProcessResponse(const BatchPtr& batch);
+
+  const std::string dest_uuid_;
+  const HostPort hostport_;
+  ConsensusServiceProxyPtr proxy_;
+  rpc::Messenger* const messenger_;
+
+  std::mutex mutex_;
+  BatchPtr current_batch_;
+  bool flush_scheduled_ = false;
+};
+
+// Provides heartbeat batchers shared by the Raft peers of all tablets of the server, one per
+// destination server.
+class MultiRaftManager {
+ public:
+  MultiRaftManager(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache);
+
+  MultiRaftHeartbeatBatcherPtr AddOrGetBatcher(
+      const std::string& dest_uuid, const HostPort& hostport);
+
+ private:
+  typedef std::pair<std::string, HostPort> BatcherKey;
+
+  struct BatcherKeyHash {
+    size_t operator()(const BatcherKey& key) const;
+  };
+
+  rpc::Messenger* const messenger_;
+  rpc::ProxyCache* const proxy_cache_;
+
+  std::mutex mutex_;
+  std::unordered_map<BatcherKey, std::weak_ptr<MultiRaftHeartbeatBatcher>, BatcherKeyHash>
+      batchers_;
+};
+
+}  // namespace consensus
+}  // namespace yb
+
+#endif  // YB_CONSENSUS_MULTI_RAFT_BATCHER_H
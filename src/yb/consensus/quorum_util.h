@@ -54,6 +54,9 @@ enum RaftConfigState {
 bool IsRaftConfigMember(const std::string& uuid, const RaftConfigPB& config);
 bool IsRaftConfigVoter(const std::string& uuid, const RaftConfigPB& config);
 
+// Whether the specified member of the config is a log-only peer, see RaftPeerPB::log_only.
+bool IsRaftConfigLogOnlyMember(const std::string& uuid, const RaftConfigPB& config);
+
 // Get the specified member of the config.
 // Returns Status::NotFound if a member with the specified uuid could not be
 // found in the config.
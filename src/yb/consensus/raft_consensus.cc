@@ -68,6 +68,7 @@
 #include "yb/util/net/dns_resolver.h"
 #include "yb/util/random.h"
 #include "yb/util/random_util.h"
+#include "yb/util/scope_exit.h"
 #include "yb/util/threadpool.h"
 #include "yb/util/tostring.h"
 #include "yb/util/trace.h"
@@ -225,9 +226,10 @@ shared_ptr<RaftConsensus> RaftConsensus::Create(
     const Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
     TableType table_type,
     ThreadPool* raft_pool,
-    RetryableRequests* retryable_requests) {
+    RetryableRequests* retryable_requests,
+    MultiRaftManager* multi_raft_manager) {
   auto rpc_factory = std::make_unique<RpcPeerProxyFactory>(
-      messenger, proxy_cache, local_peer_pb.cloud_info());
+      messenger, proxy_cache, local_peer_pb.cloud_info(), multi_raft_manager);
 
   // The message queue that keeps track of which operations need to be replicated
   // where.
@@ -350,6 +352,10 @@ Status RaftConsensus::Start(const ConsensusBootstrapInfo& info) {
       MinimumElectionTimeout());
 
   {
+    // Pending operations are submitted for prepare after the state lock is released.
+    auto se = ScopeExit([this] {
+      state_->context()->ReplicaOperationsStarted();
+    });
     ReplicaState::UniqueLock lock;
     RETURN_NOT_OK(state_->LockForStart(&lock));
     state_->ClearLeaderUnlocked();
@@ -464,6 +470,13 @@ Status RaftConsensus::DoStartElection(const LeaderElectionData& data, PreElected
                             << ", active_role=" << active_role;
       return Status::OK();
     }
+    if (IsRaftConfigLogOnlyMember(state_->GetPeerUuid(), state_->GetActiveConfigUnlocked()) ||
+        state_->context()->IsLogOnly()) {
+      // Log-only peer does not have the data, so it should never become a leader.
+      SnoozeFailureDetector(DO_NOT_LOG);
+      LOG_WITH_PREFIX(INFO) << "Not starting " << election_name << " -- log-only peer";
+      return Status::OK();
+    }
     if (PREDICT_FALSE(active_role == RaftPeerPB::NON_PARTICIPANT)) {
       // Avoid excessive election noise while in this state.
       SnoozeFailureDetector(DO_NOT_LOG);
@@ -692,7 +705,7 @@ Status RaftConsensus::StepDown(const LeaderStepDownRequestPB* req, LeaderStepDow
     bool new_leader_found = false;
     const RaftConfigPB& active_config = state_->GetActiveConfigUnlocked();
     for (const RaftPeerPB& peer : active_config.peers()) {
-      if (peer.member_type() == RaftPeerPB::VOTER &&
+      if (peer.member_type() == RaftPeerPB::VOTER && !peer.log_only() &&
           peer.permanent_uuid() == new_leader_uuid) {
         auto election_state = std::make_shared<RunLeaderElectionState>();
         // TODO(sergei) Currently we preserved synchronous DNS resolution in this case.
@@ -703,6 +716,9 @@ Status RaftConsensus::StepDown(const LeaderStepDownRequestPB* req, LeaderStepDow
         election_state->req.set_dest_uuid(new_leader_uuid);
         election_state->req.set_tablet_id(tablet_id);
         state_->GetCommittedOpIdUnlocked().ToPB(election_state->req.mutable_committed_index());
+        for (auto& key : state_->context()->HotKeys()) {
+          election_state->req.add_hot_keys(std::move(key));
+        }
         election_state->proxy->RunLeaderElectionAsync(
             &election_state->req, &election_state->resp, &election_state->rpc,
             std::bind(&RaftConsensus::RunLeaderElectionResponseRpcCallback, this,
@@ -714,7 +730,7 @@ Status RaftConsensus::StepDown(const LeaderStepDownRequestPB* req, LeaderStepDow
     }
     if (!new_leader_found) {
       LOG(WARNING) << "New leader " << new_leader_uuid << " not found among " << tablet_id
-                   << " tablet peers.";
+                   << " tablet peers that could become a leader.";
       resp->mutable_error()->set_code(TabletServerErrorPB::LEADER_NOT_READY_TO_STEP_DOWN);
       StatusToPB(STATUS(IllegalState, "New leader not found among peers"),
                  resp->mutable_error()->mutable_status());
@@ -1206,7 +1222,11 @@ Status RaftConsensus::Update(ConsensusRequestPB* request,
     }
 
     LongOperationTracker operation_tracker("UpdateReplica", 1s);
-    result = VERIFY_RESULT(UpdateReplica(request, response));
+    auto update_result = UpdateReplica(request, response);
+    // Operations started by UpdateReplica are submitted for prepare here, after the state lock
+    // was released but still under the update mutex, so they are submitted in the log order.
+    state_->context()->ReplicaOperationsStarted();
+    result = VERIFY_RESULT(std::move(update_result));
 
     auto delay = TEST_delay_update_.load(std::memory_order_acquire);
     if (delay != MonoDelta::kZero) {
@@ -2126,6 +2146,12 @@ Status RaftConsensus::ChangeConfig(const ChangeConfigRequestPB& req,
                          "member_type received: $1", server_uuid,
                          RaftPeerPB::MemberType_Name(server.member_type())));
         }
+        if (server.log_only() && server.member_type() != RaftPeerPB::PRE_VOTER) {
+          return STATUS(InvalidArgument,
+              Substitute("Log-only server with UUID $0 must be of member_type PRE_VOTER. "
+                         "member_type received: $1", server_uuid,
+                         RaftPeerPB::MemberType_Name(server.member_type())));
+        }
         if (server.last_known_private_addr().empty()) {
           return STATUS(InvalidArgument, "server must have last_known_addr specified",
                                          req.ShortDebugString());
@@ -2201,6 +2227,18 @@ Status RaftConsensus::ChangeConfig(const ChangeConfigRequestPB& req,
                                                   ChangeConfigType_Name(type)));
     }
 
+    // DocDB of a log-only peer does not have the data, so it could become a full replica only
+    // after remote bootstrap, i.e. when it is removed from the config and added back.
+    for (const RaftPeerPB& peer : committed_config.peers()) {
+      if (peer.log_only() && IsRaftConfigMember(peer.permanent_uuid(), new_config) &&
+          !IsRaftConfigLogOnlyMember(peer.permanent_uuid(), new_config)) {
+        *error_code = TabletServerErrorPB::INVALID_CONFIG;
+        return STATUS_FORMAT(IllegalState,
+                             "Cannot turn log-only peer $0 into a full replica. RaftConfig: $1",
+                             peer.permanent_uuid(), committed_config.ShortDebugString());
+      }
+    }
+
     auto cc_replicate = std::make_shared<ReplicateMsg>();
     cc_replicate->set_op_type(CHANGE_CONFIG_OP);
     ChangeConfigRecordPB* cc_req = cc_replicate->mutable_change_config_record();
@@ -2975,6 +3013,11 @@ RetryableRequestsCounts RaftConsensus::TEST_CountRetryableRequests() {
   return state_->TEST_CountRetryableRequests();
 }
 
+PhysicalComponentLease RaftConsensus::TEST_OldLeaderHtLease() {
+  auto lock = state_->LockForRead();
+  return state_->old_leader_ht_lease();
+}
+
 void RaftConsensus::TrackOperationMemory(const yb::OpId& op_id) {
   queue_->TrackOperationsMemory({op_id});
 }
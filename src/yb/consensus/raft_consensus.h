@@ -47,6 +47,7 @@
 #include "yb/consensus/consensus_peers.h"
 #include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/consensus_queue.h"
+#include "yb/consensus/leader_lease.h"
 
 #include "yb/util/opid.h"
 #include "yb/util/random.h"
@@ -109,7 +110,8 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
     const Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
     TableType table_type,
     ThreadPool* raft_pool,
-    RetryableRequests* retryable_requests);
+    RetryableRequests* retryable_requests,
+    MultiRaftManager* multi_raft_manager);
 
   RaftConsensus(
     const ConsensusOptions& options,
@@ -224,6 +226,9 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
 
   RetryableRequestsCounts TEST_CountRetryableRequests();
 
+  // Hybrid time leader lease recorded by this peer, while it was not a leader.
+  PhysicalComponentLease TEST_OldLeaderHtLease();
+
   void TEST_RejectMode(RejectMode value) {
     reject_mode_.store(value, std::memory_order_release);
   }
@@ -101,10 +101,13 @@ class RaftConsensusQuorumTest : public YBTest {
     FLAGS_enable_leader_failure_detection = false;
   }
 
-  // Builds an initial configuration of 'num' elements.
-  // All of the peers start as followers.
-  void BuildInitialRaftConfigPB(int num) {
+  // Builds an initial configuration of 'num' elements, with the first 'num_log_only' of them being
+  // log-only peers. All of the peers start as followers.
+  void BuildInitialRaftConfigPB(int num, int num_log_only = 0) {
     config_ = BuildRaftConfigPBForTests(num);
+    for (int i = 0; i < num_log_only; ++i) {
+      config_.mutable_peers(i)->set_log_only(true);
+    }
     config_.set_opid_index(kInvalidOpIdIndex);
     peers_.reset(new TestPeerMapManager(config_));
   }
@@ -213,17 +216,17 @@ class RaftConsensusQuorumTest : public YBTest {
     return Status::OK();
   }
 
-  Status BuildConfig(int num) {
+  Status BuildConfig(int num, int num_log_only = 0) {
     RETURN_NOT_OK(ThreadPoolBuilder("raft").Build(&raft_pool_));
     RETURN_NOT_OK(ThreadPoolBuilder("append").Build(&append_pool_));
-    BuildInitialRaftConfigPB(num);
+    BuildInitialRaftConfigPB(num, num_log_only);
     RETURN_NOT_OK(BuildFsManagersAndLogs());
     BuildPeers();
     return Status::OK();
   }
 
-  Status BuildAndStartConfig(int num) {
-    RETURN_NOT_OK(BuildConfig(num));
+  Status BuildAndStartConfig(int num, int num_log_only = 0) {
+    RETURN_NOT_OK(BuildConfig(num, num_log_only));
     RETURN_NOT_OK(StartPeers());
 
     // Automatically elect the last node in the list.
@@ -839,6 +842,64 @@ TEST_F(RaftConsensusQuorumTest, TestLeaderElectionWithQuiescedQuorum) {
   VerifyLogs(2, 0, 1);
 }
 
+// Log-only peer keeps the log and votes, but never starts an election and does not get the
+// leadership on leader step down.
+TEST_F(RaftConsensusQuorumTest, TestLogOnlyPeerNeverBecomesLeader) {
+  ASSERT_OK(BuildAndStartConfig(3, 1 /* num_log_only */));
+
+  OpId last_op_id;
+  vector<scoped_refptr<ConsensusRound> > rounds;
+  REPLICATE_SEQUENCE_OF_MESSAGES(10,
+                                 2, // The index of the initial leader.
+                                 WAIT_FOR_ALL_REPLICAS,
+                                 COMMIT_ONE_BY_ONE,
+                                 &last_op_id,
+                                 &rounds);
+  WaitForCommitIfNotAlreadyPresent(last_op_id, 0, 2);
+  WaitForCommitIfNotAlreadyPresent(last_op_id, 1, 2);
+
+  shared_ptr<RaftConsensus> log_only_peer;
+  ASSERT_OK(peers_->GetPeerByIdx(0, &log_only_peer));
+  shared_ptr<RaftConsensus> leader;
+  ASSERT_OK(peers_->GetPeerByIdx(2, &leader));
+
+  ASSERT_OK(log_only_peer->StartElection({ElectionMode::ELECT_EVEN_IF_LEADER_IS_ALIVE}));
+  ASSERT_NOK(log_only_peer->WaitUntilLeaderForTests(MonoDelta::FromMilliseconds(500)));
+  ASSERT_EQ(RaftPeerPB::FOLLOWER, log_only_peer->role());
+  ASSERT_EQ(RaftPeerPB::LEADER, leader->role());
+
+  LeaderStepDownRequestPB step_down_req;
+  step_down_req.set_dest_uuid(leader->peer_uuid());
+  step_down_req.set_tablet_id(kTestTablet);
+  step_down_req.set_new_leader_uuid(log_only_peer->peer_uuid());
+  step_down_req.set_force_step_down(true);
+  LeaderStepDownResponsePB step_down_resp;
+  ASSERT_OK(leader->StepDown(&step_down_req, &step_down_resp));
+  ASSERT_TRUE(step_down_resp.has_error());
+  ASSERT_EQ(tserver::TabletServerErrorPB::LEADER_NOT_READY_TO_STEP_DOWN,
+            step_down_resp.error().code());
+  ASSERT_EQ(RaftPeerPB::LEADER, leader->role());
+
+  // With the leader down, the remaining full replica needs the vote of the log-only peer to win
+  // the election, and its ack to commit operations.
+  leader->Shutdown();
+  peers_->RemovePeer(leader->peer_uuid());
+
+  shared_ptr<RaftConsensus> new_leader;
+  ASSERT_OK(peers_->GetPeerByIdx(1, &new_leader));
+  ASSERT_OK(new_leader->StartElection({ElectionMode::ELECT_EVEN_IF_LEADER_IS_ALIVE}));
+  ASSERT_OK(new_leader->WaitUntilLeaderForTests(MonoDelta::FromSeconds(15)));
+
+  REPLICATE_SEQUENCE_OF_MESSAGES(10,
+                                 1, // The index of the new leader.
+                                 WAIT_FOR_MAJORITY,
+                                 COMMIT_ONE_BY_ONE,
+                                 &last_op_id,
+                                 &rounds);
+  WaitForCommitIfNotAlreadyPresent(last_op_id, 0, 1);
+  ASSERT_EQ(RaftPeerPB::FOLLOWER, log_only_peer->role());
+}
+
 TEST_F(RaftConsensusQuorumTest, TestReplicasEnforceTheLogMatchingProperty) {
   ASSERT_OK(BuildAndStartConfig(3));
 
@@ -42,6 +42,7 @@
 #include "yb/gutil/strings/join.h"
 #include "yb/gutil/strings/strcat.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/util/atomic.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
@@ -60,6 +61,12 @@ DEFINE_int32(inject_delay_commit_pre_voter_to_voter_secs, 0,
 TAG_FLAG(inject_delay_commit_pre_voter_to_voter_secs, unsafe);
 TAG_FLAG(inject_delay_commit_pre_voter_to_voter_secs, hidden);
 
+DEFINE_int32(apply_write_batch_max_ops, 0,
+             "Max number of consecutive committed write operations of a tablet, that are applied "
+             "with a single RocksDB write and made visible together. 0 or 1 disables batching.");
+TAG_FLAG(apply_write_batch_max_ops, advanced);
+TAG_FLAG(apply_write_batch_max_ops, runtime);
+
 namespace yb {
 namespace consensus {
 
@@ -821,6 +828,15 @@ Status ReplicaState::ApplyPendingOperationsUnlocked(
   OpIds applied_op_ids;
   applied_op_ids.reserve(committed_op_id.index - prev_id.index);
 
+  const auto max_batched_writes = GetAtomicFlag(&FLAGS_apply_write_batch_max_ops);
+  int batched_writes = 0;
+  auto finish_batch = [this, &batched_writes] {
+    if (batched_writes != 0) {
+      context_->FinishApplyBatch();
+      batched_writes = 0;
+    }
+  };
+
   while (!pending_operations_.empty()) {
     auto round = pending_operations_.front();
     auto current_id = yb::OpId::FromPB(round->id());
@@ -833,6 +849,11 @@ Status ReplicaState::ApplyPendingOperationsUnlocked(
     }
 
     auto type = round->replicate_msg()->op_type();
+    if (type != OperationType::WRITE_OP) {
+      // Non write operations could wait for safe op id, or depend on visibility of previous
+      // writes, so the batch is finished before them.
+      finish_batch();
+    }
 
     // For write operations we block rocksdb flush, until appropriate records are written to the
     // log file. So we could apply them before adding to log.
@@ -857,8 +878,15 @@ Status ReplicaState::ApplyPendingOperationsUnlocked(
     }
 
     prev_id = current_id;
+    if (type == OperationType::WRITE_OP && max_batched_writes > 1 && batched_writes++ == 0) {
+      context_->StartApplyBatch();
+    }
     NotifyReplicationFinishedUnlocked(round, Status::OK(), leader_term, &applied_op_ids);
+    if (batched_writes >= max_batched_writes) {
+      finish_batch();
+    }
   }
+  finish_batch();
 
   SetLastCommittedIndexUnlocked(prev_id);
 
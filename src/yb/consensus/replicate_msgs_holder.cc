@@ -18,13 +18,15 @@ namespace consensus {
 
 ReplicateMsgsHolder::ReplicateMsgsHolder(
     google::protobuf::RepeatedPtrField<ReplicateMsg>* ops, ReplicateMsgs messages,
-    ScopedTrackedConsumption consumption)
-    : ops_(ops), messages_(std::move(messages)), consumption_(std::move(consumption)) {
+    ScopedTrackedConsumption consumption, std::vector<RefCntBuffer> serialized_messages)
+    : ops_(ops), messages_(std::move(messages)), consumption_(std::move(consumption)),
+      serialized_messages_(std::move(serialized_messages)) {
 }
 
 ReplicateMsgsHolder::ReplicateMsgsHolder(ReplicateMsgsHolder&& rhs)
     : ops_(rhs.ops_), messages_(std::move(rhs.messages_)),
-      consumption_(std::move(rhs.consumption_)) {
+      consumption_(std::move(rhs.consumption_)),
+      serialized_messages_(std::move(rhs.serialized_messages_)) {
   rhs.ops_ = nullptr;
 }
 
@@ -33,6 +35,7 @@ void ReplicateMsgsHolder::operator=(ReplicateMsgsHolder&& rhs) {
   ops_ = rhs.ops_;
   messages_ = std::move(rhs.messages_);
   consumption_ = std::move(rhs.consumption_);
+  serialized_messages_ = std::move(rhs.serialized_messages_);
   rhs.ops_ = nullptr;
 }
 
@@ -47,6 +50,7 @@ void ReplicateMsgsHolder::Reset() {
   }
 
   messages_.clear();
+  serialized_messages_.clear();
   consumption_ = ScopedTrackedConsumption();
 }
 
@@ -14,11 +14,14 @@
 #ifndef YB_CONSENSUS_REPLICATE_MSGS_HOLDER_H
 #define YB_CONSENSUS_REPLICATE_MSGS_HOLDER_H
 
+#include <vector>
+
 #include <google/protobuf/repeated_field.h>
 
 #include "yb/consensus/consensus_fwd.h"
 
 #include "yb/util/mem_tracker.h"
+#include "yb/util/ref_cnt_buffer.h"
 
 namespace yb {
 namespace consensus {
@@ -29,7 +32,8 @@ class ReplicateMsgsHolder {
 
   explicit ReplicateMsgsHolder(
       google::protobuf::RepeatedPtrField<ReplicateMsg>* ops, ReplicateMsgs messages,
-      ScopedTrackedConsumption consumption);
+      ScopedTrackedConsumption consumption,
+      std::vector<RefCntBuffer> serialized_messages = std::vector<RefCntBuffer>());
 
   ReplicateMsgsHolder(ReplicateMsgsHolder&& rhs);
   void operator=(ReplicateMsgsHolder&& rhs);
@@ -46,6 +50,11 @@ class ReplicateMsgsHolder {
     ops_ = nullptr;
   }
 
+  // Messages serialized as ConsensusRequestPB::ops elements, empty if not available.
+  std::vector<RefCntBuffer>& serialized_messages() {
+    return serialized_messages_;
+  }
+
  private:
   google::protobuf::RepeatedPtrField<ReplicateMsg>* ops_;
 
@@ -56,6 +65,8 @@ class ReplicateMsgsHolder {
   ReplicateMsgs messages_;
 
   ScopedTrackedConsumption consumption_;
+
+  std::vector<RefCntBuffer> serialized_messages_;
 };
 
 }  // namespace consensus
@@ -0,0 +1,141 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/consensus/consensus.h"
+#include "yb/consensus/retryable_requests.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace consensus {
+
+namespace {
+
+// Matches the window of out of order request ids tracked by a replicated range.
+constexpr RetryableRequestId kWindowSize = 64;
+
+} // namespace
+
+class RetryableRequestsTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    requests_.Clock().Adjust(RestartSafeCoarseTimePoint::FromCoarseTimePointAndDelta(
+        CoarseMonoClock::Now(), CoarseDuration::zero()));
+  }
+
+  ConsensusRoundPtr MakeRound(RetryableRequestId request_id, Status* status) {
+    auto msg = std::make_shared<ReplicateMsg>();
+    msg->set_op_type(WRITE_OP);
+    msg->mutable_id()->set_term(1);
+    msg->mutable_id()->set_index(++last_index_);
+    auto* write_request = msg->mutable_write_request();
+    write_request->set_client_id1(1);
+    write_request->set_client_id2(2);
+    write_request->set_request_id(request_id);
+    write_request->set_min_running_request_id(1);
+    ConsensusRoundPtr round(new ConsensusRound(nullptr, std::move(msg)));
+    round->SetConsensusReplicatedCallback(
+        [status](const Status& replicated_status, int64_t, OpIds*) {
+      *status = replicated_status;
+    });
+    return round;
+  }
+
+  // Registers a new request and replicates it.
+  void Replicate(RetryableRequestId request_id) {
+    Status status;
+    auto round = MakeRound(request_id, &status);
+    ASSERT_TRUE(requests_.Register(round)) << "Request " << request_id << ": " << status;
+    requests_.ReplicationFinished(*round->replicate_msg(), Status::OK(), 1);
+  }
+
+  // Checks that request is rejected as a duplicate of a replicated one.
+  void CheckDuplicate(RetryableRequestId request_id) {
+    Status status;
+    ASSERT_FALSE(requests_.Register(MakeRound(request_id, &status))) << "Request " << request_id;
+    ASSERT_TRUE(status.IsAlreadyPresent()) << "Request " << request_id << ": " << status;
+  }
+
+  RetryableRequests requests_;
+  int64_t last_index_ = 0;
+};
+
+TEST_F(RetryableRequestsTest, DuplicateOfRunning) {
+  Status first_status;
+  Status duplicate_status;
+  auto first = MakeRound(1, &first_status);
+  ASSERT_TRUE(requests_.Register(first));
+  ASSERT_FALSE(requests_.Register(MakeRound(1, &duplicate_status)));
+  ASSERT_EQ(1, requests_.TEST_Counts().running);
+
+  // The duplicate is notified when the original request is replicated.
+  requests_.ReplicationFinished(*first->replicate_msg(), Status::OK(), 1);
+  ASSERT_TRUE(duplicate_status.IsAlreadyPresent()) << duplicate_status;
+  ASSERT_EQ(0, requests_.TEST_Counts().running);
+  ASSERT_EQ(1, requests_.TEST_Counts().replicated);
+
+  ASSERT_NO_FATALS(CheckDuplicate(1));
+}
+
+TEST_F(RetryableRequestsTest, OutOfOrder) {
+  constexpr RetryableRequestId kNumRequests = 20;
+  // Replicate odd requests first, they are tracked by the window of the first range.
+  for (RetryableRequestId id = 1; id <= kNumRequests; id += 2) {
+    ASSERT_NO_FATALS(Replicate(id));
+  }
+  ASSERT_EQ(1, requests_.TEST_Counts().replicated);
+  for (RetryableRequestId id = 1; id <= kNumRequests; id += 2) {
+    ASSERT_NO_FATALS(CheckDuplicate(id));
+  }
+
+  // Even requests are not replicated yet.
+  for (RetryableRequestId id = kNumRequests; id > 1; id -= 2) {
+    ASSERT_NO_FATALS(Replicate(id));
+  }
+  ASSERT_EQ(1, requests_.TEST_Counts().replicated);
+  for (RetryableRequestId id = 1; id <= kNumRequests; ++id) {
+    ASSERT_NO_FATALS(CheckDuplicate(id));
+  }
+  ASSERT_NO_FATALS(Replicate(kNumRequests + 1));
+  ASSERT_EQ(1, requests_.TEST_Counts().replicated);
+}
+
+TEST_F(RetryableRequestsTest, WindowOverflow) {
+  // The last request that fits into the window of the first range.
+  const RetryableRequestId kLastInWindow = 1 + kWindowSize;
+  ASSERT_NO_FATALS(Replicate(1));
+  ASSERT_NO_FATALS(Replicate(kLastInWindow));
+  ASSERT_EQ(1, requests_.TEST_Counts().replicated);
+
+  // Requests after the window start new ranges.
+  ASSERT_NO_FATALS(Replicate(kLastInWindow + 2));
+  ASSERT_EQ(2, requests_.TEST_Counts().replicated);
+  ASSERT_NO_FATALS(CheckDuplicate(kLastInWindow));
+  ASSERT_NO_FATALS(CheckDuplicate(kLastInWindow + 2));
+
+  // Filling the gaps joins all ranges.
+  for (RetryableRequestId id = 2; id != kLastInWindow; ++id) {
+    ASSERT_NO_FATALS(Replicate(id));
+  }
+  ASSERT_NO_FATALS(Replicate(kLastInWindow + 1));
+  ASSERT_EQ(1, requests_.TEST_Counts().replicated);
+  for (RetryableRequestId id = 1; id <= kLastInWindow + 2; ++id) {
+    ASSERT_NO_FATALS(CheckDuplicate(id));
+  }
+}
+
+} // namespace consensus
+} // namespace yb
@@ -13,6 +13,10 @@
 
 #include "yb/consensus/retryable_requests.h"
 
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index/hashed_index.hpp>
@@ -44,6 +48,35 @@ METRIC_DEFINE_gauge_int64(tablet, replicated_retryable_request_ranges,
                           yb::MetricUnit::kRequests,
                           "Number of replicated retryable request ranges.");
 
+METRIC_DEFINE_gauge_int64(tablet, retryable_requests_memory_usage,
+                          "Memory used by retryable requests.",
+                          yb::MetricUnit::kBytes,
+                          "Approximate memory used to track running and replicated retryable "
+                          "requests, updated on cleanup of expired requests.");
+
+METRIC_DEFINE_counter(tablet, retryable_request_lookups,
+                      "Number of retryable request lookups.",
+                      yb::MetricUnit::kRequests,
+                      "Number of new requests checked against running and replicated retryable "
+                      "requests.");
+
+METRIC_DEFINE_counter(tablet, retryable_request_lookup_time,
+                      "Time spent on retryable request lookups.",
+                      yb::MetricUnit::kNanoseconds,
+                      "Total time spent checking new requests against retryable requests, "
+                      "estimated by timing one of every 64 lookups.");
+
+METRIC_DEFINE_counter(tablet, retryable_request_inserts,
+                      "Number of replicated retryable request inserts.",
+                      yb::MetricUnit::kRequests,
+                      "Number of requests added to replicated retryable requests.");
+
+METRIC_DEFINE_counter(tablet, retryable_request_insert_time,
+                      "Time spent on replicated retryable request inserts.",
+                      yb::MetricUnit::kNanoseconds,
+                      "Total time spent adding requests to replicated retryable requests, "
+                      "estimated by timing one of every 64 inserts.");
+
 namespace yb {
 namespace consensus {
 
@@ -64,36 +97,78 @@ struct RunningRetryableRequest {
   }
 };
 
+// Number of request ids after the last id of a range, that could be replicated out of order and
+// still be tracked by the same range.
+constexpr RetryableRequestId kReplicatedWindowSize = 64;
+
+// Range of replicated request ids [first_id, last_id], followed by a window of request ids
+// (last_id, last_id + kReplicatedWindowSize] that were replicated before some request with lower
+// id, one bit per request id. When the gap is filled, last_id advances over the window.
 struct ReplicatedRetryableRequestRange {
-  mutable RetryableRequestId first_id;
+  RetryableRequestId first_id;
   RetryableRequestId last_id;
+  // Bit i is set when request last_id + 1 + i is replicated.
+  uint64_t window = 0;
   yb::OpId min_op_id;
-  mutable RestartSafeCoarseTimePoint min_time;
-  mutable RestartSafeCoarseTimePoint max_time;
+  RestartSafeCoarseTimePoint min_time;
+  RestartSafeCoarseTimePoint max_time;
 
   ReplicatedRetryableRequestRange(RetryableRequestId id, const yb::OpId& op_id,
                               RestartSafeCoarseTimePoint time)
       : first_id(id), last_id(id), min_op_id(op_id), min_time(time),
         max_time(time) {}
 
-  void InsertTime(const RestartSafeCoarseTimePoint& time) const {
+  // Max replicated request id tracked by this range.
+  RetryableRequestId max_id() const {
+    return window ? last_id + kReplicatedWindowSize - __builtin_clzll(window) : last_id;
+  }
+
+  bool Contains(RetryableRequestId id) const {
+    if (id < first_id) {
+      return false;
+    }
+    if (id <= last_id) {
+      return true;
+    }
+    return id - last_id <= kReplicatedWindowSize && ((window >> (id - last_id - 1)) & 1);
+  }
+
+  void InsertTime(const RestartSafeCoarseTimePoint& time) {
     min_time = std::min(min_time, time);
     max_time = std::max(max_time, time);
   }
 
-  void PrepareJoinWithPrev(const ReplicatedRetryableRequestRange& prev) const {
-    min_time = std::min(min_time, prev.min_time);
-    max_time = std::max(max_time, prev.max_time);
-    first_id = prev.first_id;
+  // Adds request with id in the window of this range.
+  void Insert(RetryableRequestId id, const yb::OpId& op_id, RestartSafeCoarseTimePoint time) {
+    DCHECK_GT(id, last_id);
+    DCHECK_LE(id - last_id, kReplicatedWindowSize);
+    window |= 1ULL << (id - last_id - 1);
+    // Advance last_id over requests that became contiguous.
+    const int contiguous = ~window ? __builtin_ctzll(~window) : kReplicatedWindowSize;
+    last_id += contiguous;
+    window = contiguous < kReplicatedWindowSize ? window >> contiguous : 0;
+    min_op_id = std::min(min_op_id, op_id);
+    InsertTime(time);
+  }
+
+  // Joins range that starts right after the last id of this range, when window is empty.
+  void JoinNext(const ReplicatedRetryableRequestRange& next) {
+    DCHECK_EQ(window, 0);
+    DCHECK_EQ(last_id + 1, next.first_id);
+    last_id = next.last_id;
+    window = next.window;
+    min_op_id = std::min(min_op_id, next.min_op_id);
+    InsertTime(next.min_time);
+    InsertTime(next.max_time);
   }
 
   std::string ToString() const {
-    return Format("{ first_id: $0 last_id: $1 min_op_id: $2 min_time: $3 max_time: $4 }",
-                  first_id, last_id, min_op_id, min_time, max_time);
+    return Format("{ first_id: $0 last_id: $1 window: $2 min_op_id: $3 min_time: $4 "
+                      "max_time: $5 }",
+                  first_id, last_id, window, min_op_id, min_time, max_time);
   }
 };
 
-struct LastIdIndex;
 struct OpIdIndex;
 struct RequestIdIndex;
 
@@ -115,28 +190,66 @@ typedef boost::multi_index_container <
     >
 > RunningRetryableRequests;
 
-typedef boost::multi_index_container <
-    ReplicatedRetryableRequestRange,
-    boost::multi_index::indexed_by <
-        boost::multi_index::ordered_unique <
-            boost::multi_index::tag<LastIdIndex>,
-            boost::multi_index::member <
-                ReplicatedRetryableRequestRange, RetryableRequestId,
-                &ReplicatedRetryableRequestRange::last_id
-            >
-        >,
-        boost::multi_index::ordered_unique <
-            boost::multi_index::tag<OpIdIndex>,
-            boost::multi_index::member <
-                ReplicatedRetryableRequestRange, yb::OpId,
-                &ReplicatedRetryableRequestRange::min_op_id
-            >
-        >
-    >
-> ReplicatedRetryableRequestRanges;
+// Approximate memory used by a running request, including nodes of both indexes.
+constexpr size_t kRunningRetryableRequestMemoryUsage =
+    sizeof(RunningRetryableRequest) + 6 * sizeof(void*);
+
+// Replicated request ranges of a client ordered by first_id. Ranges do not overlap, including
+// their windows, so they are also ordered by last_id and max_id().
+// Ranges are kept in a flat vector, since new ranges are usually added to the end and old ranges
+// are removed from the beginning.
+typedef std::vector<ReplicatedRetryableRequestRange> ReplicatedRetryableRequestRanges;
+
+// Returns iterator to the first range that starts after id.
+ReplicatedRetryableRequestRanges::iterator RangeAfter(
+    RetryableRequestId id, ReplicatedRetryableRequestRanges* ranges) {
+  return std::upper_bound(
+      ranges->begin(), ranges->end(), id,
+      [](RetryableRequestId lhs, const ReplicatedRetryableRequestRange& rhs) {
+    return lhs < rhs.first_id;
+  });
+}
+
+bool ContainsReplicated(RetryableRequestId id, ReplicatedRetryableRequestRanges* ranges) {
+  auto it = RangeAfter(id, ranges);
+  return it != ranges->begin() && std::prev(it)->Contains(id);
+}
+
+// Only one of this number of calls is timed, since reading the clock costs about as much as a
+// lookup.
+constexpr int64_t kCostTrackerTimingSampleRate = 64;
+
+// Adds number of calls and estimated time spent in the scope to counters, when they are set.
+class ScopedCostTracker {
+ public:
+  // num_calls is the local number of calls, used to pick calls to time without reading calls.
+  ScopedCostTracker(const scoped_refptr<Counter>& calls, const scoped_refptr<Counter>& time,
+                    int64_t* num_calls)
+      : calls_(calls), time_(time),
+        timed_(calls_ && (*num_calls)++ % kCostTrackerTimingSampleRate == 0) {
+    if (timed_) {
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~ScopedCostTracker() {
+    if (!calls_) {
+      return;
+    }
+    calls_->Increment();
+    if (timed_) {
+      time_->IncrementBy(kCostTrackerTimingSampleRate *
+                         std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now() - start_).count());
+    }
+  }
 
-typedef ReplicatedRetryableRequestRanges::index<LastIdIndex>::type
-    ReplicatedRetryableRequestRangesByLastId;
+ private:
+  const scoped_refptr<Counter>& calls_;
+  const scoped_refptr<Counter>& time_;
+  const bool timed_;
+  std::chrono::steady_clock::time_point start_;
+};
 
 struct ClientRetryableRequests {
   RunningRetryableRequests running;
@@ -216,6 +329,8 @@ class RetryableRequests::Impl {
       return true;
     }
 
+    ScopedCostTracker cost_tracker(lookups_counter_, lookup_time_counter_, &num_lookups_);
+
     if (entry_time == RestartSafeCoarseTimePoint()) {
       entry_time = clock_.Now();
     }
@@ -232,9 +347,7 @@ class RetryableRequests::Impl {
       return false;
     }
 
-    auto& replicated_indexed_by_last_id = client_retryable_requests.replicated.get<LastIdIndex>();
-    auto it = replicated_indexed_by_last_id.lower_bound(data.request_id());
-    if (it != replicated_indexed_by_last_id.end() && it->first_id <= data.request_id()) {
+    if (ContainsReplicated(data.request_id(), &client_retryable_requests.replicated)) {
       round->NotifyReplicationFinished(
           STATUS(AlreadyPresent, "Duplicate request"), round->bound_term(),
           nullptr /* applied_op_ids */);
@@ -262,25 +375,27 @@ class RetryableRequests::Impl {
     auto now = clock_.Now();
     auto clean_start =
         now - std::chrono::seconds(GetAtomicFlag(&FLAGS_retryable_request_timeout_secs));
+    size_t memory_usage = 0;
     for (auto ci = clients_.begin(); ci != clients_.end();) {
       ClientRetryableRequests& client_retryable_requests = ci->second;
-      auto& op_id_index = client_retryable_requests.replicated.get<OpIdIndex>();
-      auto it = op_id_index.begin();
-      int64_t count = 0;
-      while (it != op_id_index.end() && it->max_time < clean_start) {
-        ++it;
-        ++count;
-      }
+      auto& replicated = client_retryable_requests.replicated;
+      const auto old_size = replicated.size();
+      replicated.erase(
+          std::remove_if(replicated.begin(), replicated.end(), [clean_start](const auto& range) {
+            return range.max_time < clean_start;
+          }),
+          replicated.end());
       if (replicated_request_ranges_gauge_) {
-        replicated_request_ranges_gauge_->DecrementBy(count);
+        replicated_request_ranges_gauge_->DecrementBy(old_size - replicated.size());
+      }
+      for (const auto& range : replicated) {
+        result = std::min(result, range.min_op_id);
       }
-      if (it != op_id_index.end()) {
-        result = std::min(result, it->min_op_id);
-        op_id_index.erase(op_id_index.begin(), it);
-      } else {
-        op_id_index.clear();
+      // Release memory of clients that had many ranges in the past.
+      if (replicated.capacity() > 2 * replicated.size() + 8) {
+        replicated.shrink_to_fit();
       }
-      if (op_id_index.empty() && client_retryable_requests.running.empty()) {
+      if (replicated.empty() && client_retryable_requests.running.empty()) {
         // We delay deleting client with empty requests, to be able to filter requests with too
         // small request id.
         if (client_retryable_requests.empty_since == RestartSafeCoarseTimePoint()) {
@@ -290,8 +405,15 @@ class RetryableRequests::Impl {
           continue;
         }
       }
+      memory_usage += sizeof(*ci) +
+                      replicated.capacity() * sizeof(ReplicatedRetryableRequestRange) +
+                      client_retryable_requests.running.size() *
+                          kRunningRetryableRequestMemoryUsage;
       ++ci;
     }
+    if (memory_usage_gauge_) {
+      memory_usage_gauge_->set(memory_usage);
+    }
 
     return result;
   }
@@ -369,6 +491,11 @@ class RetryableRequests::Impl {
     running_requests_gauge_ = METRIC_running_retryable_requests.Instantiate(metric_entity, 0);
     replicated_request_ranges_gauge_ = METRIC_replicated_retryable_request_ranges.Instantiate(
         metric_entity, 0);
+    memory_usage_gauge_ = METRIC_retryable_requests_memory_usage.Instantiate(metric_entity, 0);
+    lookup_time_counter_ = METRIC_retryable_request_lookup_time.Instantiate(metric_entity);
+    lookups_counter_ = METRIC_retryable_request_lookups.Instantiate(metric_entity);
+    insert_time_counter_ = METRIC_retryable_request_insert_time.Instantiate(metric_entity);
+    inserts_counter_ = METRIC_retryable_request_inserts.Instantiate(metric_entity);
   }
 
   RetryableRequestsCounts TEST_Counts() {
@@ -385,144 +512,84 @@ class RetryableRequests::Impl {
   void CleanupReplicatedRequests(
       RetryableRequestId new_min_running_request_id,
       ClientRetryableRequests* client_retryable_requests) {
-    auto& replicated_indexed_by_last_id = client_retryable_requests->replicated.get<LastIdIndex>();
+    auto& replicated = client_retryable_requests->replicated;
     if (new_min_running_request_id > client_retryable_requests->min_running_request_id) {
       // We are not interested in ids below write_request.min_running_request_id() anymore.
       //
-      // Request id intervals are ordered by last id of interval, and does not overlap.
-      // So we are trying to find interval with last_id >= min_running_request_id
-      // and trim it if necessary.
-      auto it = replicated_indexed_by_last_id.lower_bound(new_min_running_request_id);
-      if (it != replicated_indexed_by_last_id.end() &&
-          it->first_id < new_min_running_request_id) {
-        it->first_id = new_min_running_request_id;
+      // Ranges are ordered by request ids and does not overlap. So we are trying to find range
+      // with max_id >= min_running_request_id and trim it if necessary.
+      auto it = std::partition_point(
+          replicated.begin(), replicated.end(),
+          [new_min_running_request_id](const ReplicatedRetryableRequestRange& range) {
+        return range.max_id() < new_min_running_request_id;
+      });
+      if (it != replicated.end() && it->first_id < new_min_running_request_id) {
+        it->first_id = std::min(new_min_running_request_id, it->last_id);
       }
       if (replicated_request_ranges_gauge_) {
-        replicated_request_ranges_gauge_->DecrementBy(
-            std::distance(replicated_indexed_by_last_id.begin(), it));
+        replicated_request_ranges_gauge_->DecrementBy(std::distance(replicated.begin(), it));
       }
-      // Remove all intervals that has ids below write_request.min_running_request_id().
-      replicated_indexed_by_last_id.erase(replicated_indexed_by_last_id.begin(), it);
+      // Remove all ranges that has ids below write_request.min_running_request_id().
+      replicated.erase(replicated.begin(), it);
       client_retryable_requests->min_running_request_id = new_min_running_request_id;
     }
   }
 
   void AddReplicated(yb::OpId op_id, const ReplicateData& data, RestartSafeCoarseTimePoint time,
                      ClientRetryableRequests* client) {
+    ScopedCostTracker cost_tracker(inserts_counter_, insert_time_counter_, &num_inserts_);
+
     auto request_id = data.request_id();
-    auto& replicated_indexed_by_last_id = client->replicated.get<LastIdIndex>();
-    auto request_it = replicated_indexed_by_last_id.lower_bound(request_id);
-    if (request_it != replicated_indexed_by_last_id.end() && request_it->first_id <= request_id) {
+    auto& replicated = client->replicated;
+    auto next_it = RangeAfter(request_id, &replicated);
+    if (next_it != replicated.begin()) {
+      auto prev_it = std::prev(next_it);
+      if (prev_it->Contains(request_id)) {
 #ifndef NDEBUG
-      LOG_WITH_PREFIX(ERROR)
-          << "Replicated requests: " << yb::ToString(client->replicated);
+        LOG_WITH_PREFIX(ERROR) << "Replicated requests: " << yb::ToString(replicated);
 #endif
 
-      LOG_WITH_PREFIX(DFATAL) << "Request already replicated: " << data;
-      return;
-    }
+        LOG_WITH_PREFIX(DFATAL) << "Request already replicated: " << data;
+        return;
+      }
 
-    // Check that we have range right after this id, and we could extend it.
-    // Requests rarely attaches to begin of interval, so we could don't check for
-    // RangeTimeLimit() here.
-    if (request_it != replicated_indexed_by_last_id.end() &&
-        request_it->first_id == request_id + 1) {
-      op_id = std::min(request_it->min_op_id, op_id);
-      request_it->InsertTime(time);
-      // If previous range is right before this id, then we could just join those ranges.
-      if (!TryJoinRanges(request_it, op_id, &replicated_indexed_by_last_id)) {
-        --(request_it->first_id);
-        UpdateMinOpId(request_it, op_id, &replicated_indexed_by_last_id);
+      // Add the request to the window of the previous range, if it is not too far from the range.
+      // Requests below max id of the range are always added to it, so requests tracked by the
+      // window are not covered by the following ranges.
+      if (request_id - prev_it->last_id <= kReplicatedWindowSize &&
+          (request_id < prev_it->max_id() || time <= prev_it->min_time + RangeTimeLimit())) {
+        prev_it->Insert(request_id, op_id, time);
+        // If the range reached the next range, then we could just join those ranges, when time
+        // range will fit into limit.
+        if (next_it != replicated.end() && prev_it->window == 0 &&
+            prev_it->last_id + 1 == next_it->first_id &&
+            next_it->max_time <= prev_it->min_time + RangeTimeLimit()) {
+          prev_it->JoinNext(*next_it);
+          replicated.erase(next_it);
+          if (replicated_request_ranges_gauge_) {
+            replicated_request_ranges_gauge_->Decrement();
+          }
+        }
+        return;
       }
-      return;
     }
 
-    if (TryJoinToEndOfRange(request_it, op_id, request_id, time, &replicated_indexed_by_last_id)) {
+    // Check that we have range right after this id, and we could extend it.
+    // Requests rarely attaches to begin of range, so we could don't check for
+    // RangeTimeLimit() here.
+    if (next_it != replicated.end() && next_it->first_id == request_id + 1) {
+      --next_it->first_id;
+      next_it->min_op_id = std::min(next_it->min_op_id, op_id);
+      next_it->InsertTime(time);
       return;
     }
 
-    client->replicated.emplace(request_id, op_id, time);
+    replicated.emplace(next_it, request_id, op_id, time);
     if (replicated_request_ranges_gauge_) {
       replicated_request_ranges_gauge_->Increment();
     }
   }
 
-  void UpdateMinOpId(
-      ReplicatedRetryableRequestRangesByLastId::iterator request_it,
-      yb::OpId min_op_id,
-      ReplicatedRetryableRequestRangesByLastId* replicated_indexed_by_last_id) {
-    if (min_op_id < request_it->min_op_id) {
-      replicated_indexed_by_last_id->modify(request_it, [min_op_id](auto& entry) { // NOLINT
-        entry.min_op_id = min_op_id;
-      });
-    }
-  }
-
-  bool TryJoinRanges(
-      ReplicatedRetryableRequestRangesByLastId::iterator request_it,
-      yb::OpId min_op_id,
-      ReplicatedRetryableRequestRangesByLastId* replicated_indexed_by_last_id) {
-    if (request_it == replicated_indexed_by_last_id->begin()) {
-      return false;
-    }
-
-    auto request_prev_it = request_it;
-    --request_prev_it;
-
-    // We could join ranges if there is exactly one id between them, and request with that id was
-    // just replicated...
-    if (request_prev_it->last_id + 2 != request_it->first_id) {
-      return false;
-    }
-
-    // ...and time range will fit into limit.
-    if (request_it->max_time > request_prev_it->min_time + RangeTimeLimit()) {
-      return false;
-    }
-
-    min_op_id = std::min(min_op_id, request_prev_it->min_op_id);
-    request_it->PrepareJoinWithPrev(*request_prev_it);
-    replicated_indexed_by_last_id->erase(request_prev_it);
-    if (replicated_request_ranges_gauge_) {
-      replicated_request_ranges_gauge_->Decrement();
-    }
-    UpdateMinOpId(request_it, min_op_id, replicated_indexed_by_last_id);
-
-    return true;
-  }
-
-  bool TryJoinToEndOfRange(
-      ReplicatedRetryableRequestRangesByLastId::iterator request_it,
-      yb::OpId op_id, RetryableRequestId request_id, RestartSafeCoarseTimePoint time,
-      ReplicatedRetryableRequestRangesByLastId* replicated_indexed_by_last_id) {
-    if (request_it == replicated_indexed_by_last_id->begin()) {
-      return false;
-    }
-
-    --request_it;
-
-    if (request_it->last_id + 1 != request_id) {
-      return false;
-    }
-
-    // It is rare case when request is attaches to end of range, but his time is lower than
-    // min_time. So we could avoid checking for the case when
-    // time + RangeTimeLimit() > request_prev_it->max_time
-    if (time > request_it->min_time + RangeTimeLimit()) {
-      return false;
-    }
-
-    op_id = std::min(request_it->min_op_id, op_id);
-    request_it->InsertTime(time);
-    // Actually we should use the modify function on client.replicated, but since the order of
-    // ranges should not be changed, we could update last_id directly.
-    ++const_cast<ReplicatedRetryableRequestRange&>(*request_it).last_id;
-
-    UpdateMinOpId(request_it, op_id, replicated_indexed_by_last_id);
-
-    return true;
-  }
-
   const std::string& LogPrefix() const {
     return log_prefix_;
   }
@@ -532,6 +599,13 @@ class RetryableRequests::Impl {
   RestartSafeCoarseMonoClock clock_;
   scoped_refptr<AtomicGauge<int64_t>> running_requests_gauge_;
   scoped_refptr<AtomicGauge<int64_t>> replicated_request_ranges_gauge_;
+  scoped_refptr<AtomicGauge<int64_t>> memory_usage_gauge_;
+  scoped_refptr<Counter> lookups_counter_;
+  scoped_refptr<Counter> lookup_time_counter_;
+  scoped_refptr<Counter> inserts_counter_;
+  scoped_refptr<Counter> insert_time_counter_;
+  int64_t num_lookups_ = 0;
+  int64_t num_inserts_ = 0;
 };
 
 RetryableRequests::RetryableRequests(std::string log_prefix)
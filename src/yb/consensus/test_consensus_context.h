@@ -21,10 +21,16 @@ namespace consensus {
 
 class TestConsensusContext : public ConsensusContext {
  public:
+  void ReplicaOperationsStarted() override {}
+
   void SetPropagatedSafeTime(HybridTime ht) override {}
 
   bool ShouldApplyWrite() override { return true; }
 
+  void StartApplyBatch() override {}
+
+  void FinishApplyBatch() override {}
+
   HybridTime PropagatedSafeTime() override { return HybridTime(); }
 
   void MajorityReplicated() override {}
@@ -34,6 +40,10 @@ class TestConsensusContext : public ConsensusContext {
   uint64_t NumSSTFiles() override { return 0; }
 
   void ListenNumSSTFilesChanged(std::function<void()> listener) override {}
+
+  std::vector<std::string> HotKeys() override { return {}; }
+
+  bool IsLogOnly() override { return false; }
 };
 
 } // namespace consensus
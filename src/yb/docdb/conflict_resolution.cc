@@ -23,6 +23,7 @@
 #include "yb/docdb/docdb.pb.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent.h"
+#include "yb/docdb/operation_cost.h"
 #include "yb/docdb/shared_lock_manager.h"
 
 #include "yb/util/countdown_latch.h"
@@ -62,6 +63,86 @@ struct TransactionData {
   }
 };
 
+BoundedRocksDbIterator CreateIntentIterator(const DocDB& doc_db, Slice* intent_key_upperbound) {
+  return CreateRocksDBIterator(
+      doc_db.intents,
+      doc_db.key_bounds,
+      BloomFilterMode::DONT_USE_BLOOM_FILTER,
+      boost::none /* user_key_for_filter */,
+      rocksdb::kDefaultQueryId,
+      nullptr /* file_filter */,
+      intent_key_upperbound);
+}
+
+// Calls callback with the transaction id of every intent at intent_key_prefix, that conflicts
+// with an intent of the specified type. Stops when callback returns false.
+// intent_key_upperbound should be the upperbound of intent_iter, it is updated during the call.
+template <class Callback>
+CHECKED_STATUS EnumerateConflictingIntents(
+    BoundedRocksDbIterator* intent_iter, Slice* intent_key_upperbound, IntentTypeSet type,
+    KeyBytes* intent_key_prefix, const Callback& callback) {
+  const auto conflicting_intent_types = kIntentTypeSetConflicts[type.ToUIntPtr()];
+
+  KeyBytes upperbound_key(*intent_key_prefix);
+  upperbound_key.AppendValueType(ValueType::kMaxByte);
+  *intent_key_upperbound = upperbound_key.AsSlice();
+
+  size_t original_size = intent_key_prefix->size();
+  intent_key_prefix->AppendValueType(ValueType::kIntentTypeSet);
+  // Have only weak intents, so could skip other weak intents.
+  if (!HasStrong(type)) {
+    char value = 1 << kStrongIntentFlag;
+    intent_key_prefix->AppendRawBytes(&value, 1);
+  }
+  auto se = ScopeExit([intent_key_upperbound, intent_key_prefix, original_size] {
+    intent_key_prefix->Truncate(original_size);
+    intent_key_upperbound->clear();
+  });
+  Slice prefix_slice(intent_key_prefix->AsSlice().data(), original_size);
+  intent_iter->Seek(intent_key_prefix->AsSlice());
+  while (intent_iter->Valid()) {
+    auto existing_key = intent_iter->key();
+    auto existing_value = intent_iter->value();
+    if (!existing_key.starts_with(prefix_slice)) {
+      break;
+    }
+    // Support for obsolete intent type.
+    // When looking for intent with specific prefix it should start with this prefix, followed
+    // by ValueType::kIntentTypeSet.
+    // Previously we were using intent type, so should support its value type also, now it is
+    // kObsoleteIntentType.
+    // Actual handling of obsolete intent type is done in ParseIntentKey.
+    if (existing_key.size() <= prefix_slice.size() ||
+        !IntentValueType(existing_key[prefix_slice.size()])) {
+      break;
+    }
+    if (existing_value.empty() || existing_value[0] != ValueTypeAsChar::kTransactionId) {
+      return STATUS_FORMAT(Corruption,
+          "Transaction prefix expected in intent: $0 => $1",
+          existing_key.ToDebugHexString(),
+          existing_value.ToDebugHexString());
+    }
+    existing_value.consume_byte();
+    IncrementIntentsExamined();
+    auto existing_intent = VERIFY_RESULT(
+        docdb::ParseIntentKey(intent_iter->key(), existing_value));
+
+    const auto intent_mask = kIntentTypeSetMask[existing_intent.types.ToUIntPtr()];
+    if ((conflicting_intent_types & intent_mask) != 0) {
+      auto transaction_id = VERIFY_RESULT(FullyDecodeTransactionId(
+          Slice(existing_value.data(), TransactionId::static_size())));
+
+      if (!callback(transaction_id)) {
+        break;
+      }
+    }
+
+    intent_iter->Next();
+  }
+
+  return Status::OK();
+}
+
 CHECKED_STATUS MakeConflictStatus(const TransactionId& our_id, const TransactionId& other_id,
                                   const char* reason, Counter* conflicts_metric) {
   conflicts_metric->Increment();
@@ -100,9 +181,11 @@ class ConflictResolver {
   ConflictResolver(const DocDB& doc_db,
                    TransactionStatusManager* status_manager,
                    PartialRangeKeyIntents partial_range_key_intents,
+                   CoarseTimePoint wait_deadline,
                    ConflictResolverContext* context)
       : doc_db_(doc_db), status_manager_(*status_manager), request_scope_(status_manager),
-        partial_range_key_intents_(partial_range_key_intents), context_(*context) {}
+        partial_range_key_intents_(partial_range_key_intents), wait_deadline_(wait_deadline),
+        context_(*context) {}
 
   PartialRangeKeyIntents partial_range_key_intents() {
     return partial_range_key_intents_;
@@ -134,77 +217,19 @@ class ConflictResolver {
   CHECKED_STATUS ReadIntentConflicts(IntentTypeSet type, KeyBytes* intent_key_prefix) {
     EnsureIntentIteratorCreated();
 
-    const auto conflicting_intent_types = kIntentTypeSetConflicts[type.ToUIntPtr()];
-
-    KeyBytes upperbound_key(*intent_key_prefix);
-    upperbound_key.AppendValueType(ValueType::kMaxByte);
-    intent_key_upperbound_ = upperbound_key.AsSlice();
-
-    size_t original_size = intent_key_prefix->size();
-    intent_key_prefix->AppendValueType(ValueType::kIntentTypeSet);
-    // Have only weak intents, so could skip other weak intents.
-    if (!HasStrong(type)) {
-      char value = 1 << kStrongIntentFlag;
-      intent_key_prefix->AppendRawBytes(&value, 1);
-    }
-    auto se = ScopeExit([this, intent_key_prefix, original_size] {
-      intent_key_prefix->Truncate(original_size);
-      intent_key_upperbound_.clear();
-    });
-    Slice prefix_slice(intent_key_prefix->AsSlice().data(), original_size);
-    intent_iter_.Seek(intent_key_prefix->AsSlice());
-    while (intent_iter_.Valid()) {
-      auto existing_key = intent_iter_.key();
-      auto existing_value = intent_iter_.value();
-      if (!existing_key.starts_with(prefix_slice)) {
-        break;
-      }
-      // Support for obsolete intent type.
-      // When looking for intent with specific prefix it should start with this prefix, followed
-      // by ValueType::kIntentTypeSet.
-      // Previously we were using intent type, so should support its value type also, now it is
-      // kObsoleteIntentType.
-      // Actual handling of obsolete intent type is done in ParseIntentKey.
-      if (existing_key.size() <= prefix_slice.size() ||
-          !IntentValueType(existing_key[prefix_slice.size()])) {
-        break;
-      }
-      if (existing_value.empty() || existing_value[0] != ValueTypeAsChar::kTransactionId) {
-        return STATUS_FORMAT(Corruption,
-            "Transaction prefix expected in intent: $0 => $1",
-            existing_key.ToDebugHexString(),
-            existing_value.ToDebugHexString());
-      }
-      existing_value.consume_byte();
-      auto existing_intent = VERIFY_RESULT(
-          docdb::ParseIntentKey(intent_iter_.key(), existing_value));
-
-      const auto intent_mask = kIntentTypeSetMask[existing_intent.types.ToUIntPtr()];
-      if ((conflicting_intent_types & intent_mask) != 0) {
-        auto transaction_id = VERIFY_RESULT(FullyDecodeTransactionId(
-            Slice(existing_value.data(), TransactionId::static_size())));
-
-        if (!context_.IgnoreConflictsWith(transaction_id)) {
-          conflicts_.insert(transaction_id);
-        }
-      }
-
-      intent_iter_.Next();
-    }
-
-    return Status::OK();
+    return EnumerateConflictingIntents(
+        &intent_iter_, &intent_key_upperbound_, type, intent_key_prefix,
+        [this](const TransactionId& transaction_id) {
+          if (!context_.IgnoreConflictsWith(transaction_id)) {
+            conflicts_.insert(transaction_id);
+          }
+          return true;
+        });
   }
 
   void EnsureIntentIteratorCreated() {
     if (!intent_iter_.Initialized()) {
-      intent_iter_ = CreateRocksDBIterator(
-          doc_db_.intents,
-          doc_db_.key_bounds,
-          BloomFilterMode::DONT_USE_BLOOM_FILTER,
-          boost::none /* user_key_for_filter */,
-          rocksdb::kDefaultQueryId,
-          nullptr /* file_filter */,
-          &intent_key_upperbound_);
+      intent_iter_ = CreateIntentIterator(doc_db_, &intent_key_upperbound_);
     }
   }
 
@@ -234,6 +259,16 @@ class ConflictResolver {
         return Status::OK();
       }
 
+      // Instead of competing by priority right away, let the caller release its locks and retry
+      // later, so writes to hot keys are queued behind conflicting transactions instead of
+      // aborting them. Waiting is limited in time, so a deadlock is broken by the priority check
+      // below.
+      if (CoarseMonoClock::now() < wait_deadline_) {
+        VLOG(4) << context_.ToString() << ", wait for: " << yb::ToString(transactions_);
+        return STATUS(TryAgain, "Wait for conflicting transactions", Slice(),
+                      TransactionError(TransactionErrorCode::kWaitForConflicts));
+      }
+
       RETURN_NOT_OK(context_.CheckPriority(this, &transactions_));
 
       RETURN_NOT_OK(AbortTransactions());
@@ -365,6 +400,7 @@ class ConflictResolver {
   TransactionStatusManager& status_manager_;
   RequestScope request_scope_;
   PartialRangeKeyIntents partial_range_key_intents_;
+  const CoarseTimePoint wait_deadline_;
   ConflictResolverContext& context_;
   TransactionIdSet conflicts_;
   std::vector<TransactionData> transactions_;
@@ -666,11 +702,13 @@ Status ResolveTransactionConflicts(const DocOperations& doc_ops,
                                    const DocDB& doc_db,
                                    PartialRangeKeyIntents partial_range_key_intents,
                                    TransactionStatusManager* status_manager,
-                                   Counter* conflicts_metric) {
+                                   Counter* conflicts_metric,
+                                   CoarseTimePoint wait_deadline) {
   DCHECK(hybrid_time.is_valid());
   TransactionConflictResolverContext context(
       doc_ops, write_batch, hybrid_time, read_time, conflicts_metric);
-  ConflictResolver resolver(doc_db, status_manager, partial_range_key_intents, &context);
+  ConflictResolver resolver(
+      doc_db, status_manager, partial_range_key_intents, wait_deadline, &context);
   return resolver.Resolve();
 }
 
@@ -678,13 +716,50 @@ Result<HybridTime> ResolveOperationConflicts(const DocOperations& doc_ops,
                                              HybridTime resolution_ht,
                                              const DocDB& doc_db,
                                              PartialRangeKeyIntents partial_range_key_intents,
-                                             TransactionStatusManager* status_manager) {
+                                             TransactionStatusManager* status_manager,
+                                             CoarseTimePoint wait_deadline) {
   OperationConflictResolverContext context(&doc_ops, resolution_ht);
-  ConflictResolver resolver(doc_db, status_manager, partial_range_key_intents, &context);
+  ConflictResolver resolver(
+      doc_db, status_manager, partial_range_key_intents, wait_deadline, &context);
   RETURN_NOT_OK(resolver.Resolve());
   return context.GetResolutionHt();
 }
 
+LockedKeyChecker::LockedKeyChecker(
+    const DocDB& doc_db, const TransactionId& transaction_id, IntentTypeSet strong_intent_types,
+    PartialRangeKeyIntents partial_range_key_intents, TransactionStatusManager* status_manager)
+    : transaction_id_(transaction_id), strong_intent_types_(strong_intent_types),
+      partial_range_key_intents_(partial_range_key_intents), status_manager_(*status_manager),
+      intent_iter_(CreateIntentIterator(doc_db, &intent_key_upperbound_)) {
+}
+
+Result<bool> LockedKeyChecker::IsLocked(Slice key) {
+  bool locked = false;
+  auto conflict_callback = [this, &locked](const TransactionId& transaction_id) {
+    if (transaction_id == transaction_id_ ||
+        status_manager_.LocalCommitTime(transaction_id).is_valid()) {
+      return true;
+    }
+    locked = true;
+    return false;
+  };
+  RETURN_NOT_OK(EnumerateIntents(
+      key, /* intent_value */ Slice(),
+      [this, &locked, &conflict_callback](
+          IntentStrength strength, Slice, KeyBytes* intent_key_prefix, LastKey) -> Status {
+        if (locked) {
+          return Status::OK();
+        }
+        auto intent_types = strength == IntentStrength::kWeak
+            ? StrongToWeak(strong_intent_types_) : strong_intent_types_;
+        return EnumerateConflictingIntents(
+            &intent_iter_, &intent_key_upperbound_, intent_types, intent_key_prefix,
+            conflict_callback);
+      },
+      &encoded_key_buffer_, partial_range_key_intents_));
+  return locked;
+}
+
 #define INTENT_KEY_SCHECK(lhs, op, rhs, msg) \
   BOOST_PP_CAT(SCHECK_, op)(lhs, \
                             rhs, \
@@ -14,10 +14,16 @@
 #ifndef YB_DOCDB_CONFLICT_RESOLUTION_H
 #define YB_DOCDB_CONFLICT_RESOLUTION_H
 
+#include "yb/common/transaction.h"
+
+#include "yb/docdb/bounded_rocksdb_iterator.h"
 #include "yb/docdb/docdb_fwd.h"
 #include "yb/docdb/doc_operation.h"
+#include "yb/docdb/intent.h"
+#include "yb/docdb/key_bytes.h"
 #include "yb/docdb/value_type.h"
 
+#include "yb/util/monotime.h"
 #include "yb/util/result.h"
 
 namespace rocksdb {
@@ -46,6 +52,9 @@ namespace docdb {
 // db - db that contains tablet data.
 // status_manager - status manager that should be used during this conflict resolution.
 // conflicts_metric - transaction_conflicts metric to update.
+// wait_deadline - until this time pending conflicting transactions are not aborted, instead
+//                 TryAgain with TransactionErrorCode::kWaitForConflicts is returned, so the caller
+//                 could release its locks and retry later.
 CHECKED_STATUS ResolveTransactionConflicts(const DocOperations& doc_ops,
                                            const KeyValueWriteBatchPB& write_batch,
                                            HybridTime resolution_ht,
@@ -53,7 +62,8 @@ CHECKED_STATUS ResolveTransactionConflicts(const DocOperations& doc_ops,
                                            const DocDB& doc_db,
                                            PartialRangeKeyIntents partial_range_key_intents,
                                            TransactionStatusManager* status_manager,
-                                           Counter* conflicts_metric);
+                                           Counter* conflicts_metric,
+                                           CoarseTimePoint wait_deadline);
 
 // Resolves conflicts for doc operations.
 // Read all intents that could conflict with provided doc_ops.
@@ -67,11 +77,43 @@ CHECKED_STATUS ResolveTransactionConflicts(const DocOperations& doc_ops,
 // resolution_ht - current hybrid time. Used to request status of conflicting transactions.
 // db - db that contains tablet data.
 // status_manager - status manager that should be used during this conflict resolution.
+// wait_deadline - the same as for ResolveTransactionConflicts.
 Result<HybridTime> ResolveOperationConflicts(const DocOperations& doc_ops,
                                              HybridTime resolution_ht,
                                              const DocDB& doc_db,
                                              PartialRangeKeyIntents partial_range_key_intents,
-                                             TransactionStatusManager* status_manager);
+                                             TransactionStatusManager* status_manager,
+                                             CoarseTimePoint wait_deadline);
+
+// Checks whether other transactions hold intents, that conflict with locking keys by the given
+// transaction with strong_intent_types, i.e. whether the keys are locked by other transactions.
+// Used to skip locked rows without waiting for the conflicting transactions.
+// Intents of transactions that are committed locally are ignored, but intents of aborted
+// transactions that are not cleaned up yet are reported, since checking their status would
+// require waiting.
+class LockedKeyChecker {
+ public:
+  LockedKeyChecker(const DocDB& doc_db,
+                   const TransactionId& transaction_id,
+                   IntentTypeSet strong_intent_types,
+                   PartialRangeKeyIntents partial_range_key_intents,
+                   TransactionStatusManager* status_manager);
+
+  LockedKeyChecker(const LockedKeyChecker&) = delete;
+  void operator=(const LockedKeyChecker&) = delete;
+
+  // key is the encoded doc key to check, conflicts are checked on the key and on its prefixes.
+  Result<bool> IsLocked(Slice key);
+
+ private:
+  const TransactionId transaction_id_;
+  const IntentTypeSet strong_intent_types_;
+  const PartialRangeKeyIntents partial_range_key_intents_;
+  TransactionStatusManager& status_manager_;
+  Slice intent_key_upperbound_;
+  BoundedRocksDbIterator intent_iter_;
+  KeyBytes encoded_key_buffer_;
+};
 
 struct ParsedIntent {
   // Intent DocPath.
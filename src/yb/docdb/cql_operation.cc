@@ -13,6 +13,9 @@
 
 #include "yb/docdb/cql_operation.h"
 
+#include <algorithm>
+#include <atomic>
+
 #include "yb/common/index.h"
 #include "yb/common/jsonb.h"
 #include "yb/common/partition.h"
@@ -25,9 +28,12 @@
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/docdb_util.h"
 #include "yb/docdb/primitive_value_util.h"
+#include "yb/docdb/row_cache.h"
 
 #include "yb/util/bfpg/tserver_opcodes.h"
+#include "yb/util/bfql/gen_opcodes.h"
 #include "yb/util/flag_tags.h"
+#include "yb/util/hash_util.h"
 #include "yb/util/trace.h"
 
 #include "yb/yql/cql/ql/util/errcodes.h"
@@ -42,6 +48,23 @@ DEFINE_bool(ycql_consistent_transactional_paging, false,
             "be stale. The latter is preferable for long scans. The data returned for the first "
             "page of results is never stale regardless of this flag.");
 
+DEFINE_bool(ycql_blind_counter_updates, false,
+            "Whether YCQL counter increments and decrements of non-transactional tables are "
+            "written as counter deltas without reading the current counter value. The deltas are "
+            "added up by reads. Changes the on-disk format: should be enabled only after all "
+            "tablet servers are upgraded to a version that reads counter deltas, and tablet "
+            "servers could not be downgraded to older versions after that.");
+TAG_FLAG(ycql_blind_counter_updates, advanced);
+TAG_FLAG(ycql_blind_counter_updates, runtime);
+
+DEFINE_int32(ycql_counter_deltas_per_full_value, 16,
+             "Number of blind counter deltas written for a row, after which the next counter "
+             "update reads the counters and writes their full values. The full values let "
+             "compactions remove the older deltas, and bound the number of deltas added up by "
+             "reads.");
+TAG_FLAG(ycql_counter_deltas_per_full_value, advanced);
+TAG_FLAG(ycql_counter_deltas_per_full_value, runtime);
+
 DECLARE_bool(trace_docdb_calls);
 
 namespace yb {
@@ -169,6 +192,67 @@ bool JoinNonStaticRow(
   return join_successful;
 }
 
+// Collects values of the range key columns from the equality conditions of the WHERE condition.
+// Returns false if some range column is restricted to more than one value.
+bool CollectRangeKeyValues(const Schema& schema, const QLConditionPB& condition,
+                           std::vector<const QLValuePB*>* range_values) {
+  switch (condition.op()) {
+    case QLOperator::QL_OP_AND:
+      for (const auto& operand : condition.operands()) {
+        if (operand.has_condition() &&
+            !CollectRangeKeyValues(schema, operand.condition(), range_values)) {
+          return false;
+        }
+      }
+      return true;
+
+    case QLOperator::QL_OP_EQUAL: {
+      if (condition.operands_size() != 2 ||
+          condition.operands(0).expr_case() != QLExpressionPB::kColumnId ||
+          condition.operands(1).expr_case() != QLExpressionPB::kValue) {
+        return true;
+      }
+      int col_idx = schema.find_column_by_id(ColumnId(condition.operands(0).column_id()));
+      if (col_idx == Schema::kColumnNotFound || !schema.is_range_column(col_idx)) {
+        return true;
+      }
+      auto& value = (*range_values)[col_idx - schema.num_hash_key_columns()];
+      if (value) {
+        return false;
+      }
+      value = &condition.operands(1).value();
+      return true;
+    }
+
+    default:
+      return true;
+  }
+}
+
+// Returns whether the row read with the projection stays the same until it is written, i.e. none
+// of its columns expires.
+bool RowIsCacheable(const Schema& projection, const QLTableRow& row) {
+  bool has_value = false;
+  for (size_t i = projection.num_key_columns(); i < projection.num_columns(); i++) {
+    const auto& type = projection.column(i).type();
+    // Elements of collections and user-defined types have their own TTL.
+    if (type->IsCollection() || type->IsUserDefined()) {
+      return false;
+    }
+    const auto column_id = projection.column_id(i).rep();
+    if (!row.IsColumnSpecified(column_id)) {
+      continue;
+    }
+    int64_t ttl_seconds = 0;
+    if (!row.GetTTL(column_id, &ttl_seconds).ok() || ttl_seconds >= 0) {
+      return false;
+    }
+    has_value = true;
+  }
+  // A row without column values is kept only by its liveness column, that might expire.
+  return has_value;
+}
+
 CHECKED_STATUS FindMemberForIndex(const QLColumnValuePB& column_value,
                                   size_t index,
                                   rapidjson::Value* document,
@@ -215,6 +299,132 @@ CHECKED_STATUS FindMemberForIndex(const QLColumnValuePB& column_value,
   return Status::OK();
 }
 
+// Applies the json update of column_value to the serialized jsonb document, by deserializing the
+// whole document.
+CHECKED_STATUS UpdateJsonDocument(const QLColumnValuePB& column_value,
+                                  bool is_insert,
+                                  const std::string& jsonb_value,
+                                  std::string* result) {
+  using common::Jsonb;
+  Jsonb jsonb(jsonb_value);
+  rapidjson::Document document;
+  RETURN_NOT_OK(jsonb.ToRapidJson(&document));
+
+  // Deserialize the rhs.
+  Jsonb rhs(std::move(column_value.expr().value().jsonb_value()));
+  rapidjson::Document rhs_doc;
+  RETURN_NOT_OK(rhs.ToRapidJson(&rhs_doc));
+
+  // Update the json value.
+  rapidjson::Value::MemberIterator memberit;
+  rapidjson::Value::ValueIterator valueit;
+  bool last_elem_object;
+  rapidjson::Value* node = &document;
+
+  int i = 0;
+  auto status = FindMemberForIndex(column_value, i, node, &memberit, &valueit,
+      &last_elem_object, is_insert);
+  for (i = 1; i < column_value.json_args_size() && status.ok(); i++) {
+    node = (last_elem_object) ? &(memberit->value) : &(*valueit);
+    status = FindMemberForIndex(column_value, i, node, &memberit, &valueit,
+        &last_elem_object, is_insert);
+  }
+
+  bool update_missing = false;
+  if (is_insert) {
+    RETURN_NOT_OK(status);
+  } else {
+    update_missing = !status.ok();
+  }
+
+  if (update_missing) {
+    // NOTE: lhs path cannot exceed by more than one hop
+    if (last_elem_object && i == column_value.json_args_size()) {
+      auto val = column_value.json_args(i - 1).operand().value().string_value();
+      rapidjson::Value v(val.c_str(), val.size(), document.GetAllocator());
+      node->AddMember(v, rhs_doc, document.GetAllocator());
+    } else {
+      RETURN_NOT_OK(status);
+    }
+  } else if (last_elem_object) {
+    memberit->value = rhs_doc.Move();
+  } else {
+    *valueit = rhs_doc.Move();
+  }
+
+  Jsonb jsonb_result;
+  RETURN_NOT_OK(jsonb_result.FromRapidJson(document));
+  *result = std::move(jsonb_result.MoveSerializedJsonb());
+  return Status::OK();
+}
+
+// Returns true if one more counter delta could be written for the row with the specified encoded
+// key, or false if the full counter values should be written instead.
+//
+// Deltas are counted per hash of the row key, for all tablets of the server. Collisions and
+// restarts only change how often the full values are written.
+bool CountCounterDelta(const Slice& encoded_doc_key) {
+  static constexpr size_t kNumSlots = 1 << 16;
+  static std::atomic<uint32_t> num_deltas[kNumSlots];
+  auto hash = HashUtil::MurmurHash2_64(encoded_doc_key.data(), encoded_doc_key.size(), 0);
+  auto& slot = num_deltas[hash % kNumSlots];
+  const auto limit = static_cast<uint32_t>(
+      std::max<int32_t>(FLAGS_ycql_counter_deltas_per_full_value, 0));
+  if (slot.fetch_add(1, std::memory_order_acq_rel) >= limit) {
+    slot.store(0, std::memory_order_release);
+    return false;
+  }
+  return true;
+}
+
+// Returns the delta of an update of the form "counter = counter +/- <value>" of the column, or none
+// when the update has another form.
+boost::optional<int64_t> CounterDelta(
+    const QLColumnValuePB& column_value, const ColumnSchema& column) {
+  if (!column.is_counter() || !column_value.json_args().empty() ||
+      !column_value.subscript_args().empty() || !column_value.expr().has_bfcall()) {
+    return boost::none;
+  }
+  const QLBCallPB& bfcall = column_value.expr().bfcall();
+  const auto opcode = static_cast<bfql::BFOpcode>(bfcall.opcode());
+  if ((opcode != bfql::BFOpcode::OPCODE_COUNTER_INC &&
+       opcode != bfql::BFOpcode::OPCODE_COUNTER_DEC) ||
+      bfcall.operands_size() != 2 ||
+      !bfcall.operands(0).has_column_id() ||
+      bfcall.operands(0).column_id() != column_value.column_id() ||
+      !bfcall.operands(1).has_value() ||
+      !bfcall.operands(1).value().has_int64_value()) {
+    return boost::none;
+  }
+  const int64_t value = bfcall.operands(1).value().int64_value();
+  return opcode == bfql::BFOpcode::OPCODE_COUNTER_INC ? value : -value;
+}
+
+// Returns true if the column value is an update of the form "list[<index>] = <value>" or
+// "list = list - <value>", that is applied to the list in DocDB without the current list value.
+bool IsInPlaceListColumnUpdate(const QLColumnValuePB& column_value, const ColumnSchema& column) {
+  if (column.type()->main() != LIST || !column_value.json_args().empty()) {
+    return false;
+  }
+  const QLExpressionPB& expr = column_value.expr();
+  if (!column_value.subscript_args().empty()) {
+    return column_value.subscript_args_size() == 1 &&
+           column_value.subscript_args(0).has_value() && expr.has_value();
+  }
+  return expr.has_tscall() &&
+         static_cast<bfql::TSOpcode>(expr.tscall().opcode()) == bfql::TSOpcode::kListRemove &&
+         expr.tscall().operands_size() == 2 &&
+         expr.tscall().operands(0).has_column_id() &&
+         expr.tscall().operands(0).column_id() == column_value.column_id() &&
+         expr.tscall().operands(1).has_value();
+}
+
+MonoDelta TableDefaultTtl(const Schema& schema) {
+  return schema.table_properties().HasDefaultTimeToLive() ?
+      MonoDelta::FromMilliseconds(schema.table_properties().DefaultTimeToLive()) :
+      MonoDelta::kMax;
+}
+
 CHECKED_STATUS CheckUserTimestampForCollections(const UserTimeMicros user_timestamp) {
   if (user_timestamp != Value::kInvalidUserTimestamp) {
     return STATUS(InvalidArgument, "User supplied timestamp is only allowed for "
@@ -230,7 +440,10 @@ Status QLWriteOperation::Init(QLWriteRequestPB* request, QLResponsePB* response)
   response_ = response;
   insert_into_unique_index_ = request_.type() == QLWriteRequestPB::QL_STMT_INSERT &&
                               unique_index_key_schema_ != nullptr;
-  require_read_ = RequireRead(request_, schema_) || insert_into_unique_index_;
+  blind_counter_update_ = IsBlindCounterUpdate();
+  in_place_list_update_ = IsInPlaceListUpdate();
+  require_read_ = (!blind_counter_update_ && RequireRead(request_, schema_)) ||
+                  insert_into_unique_index_;
   update_indexes_ = !request_.update_index_ids().empty();
 
   // Determine if static / non-static columns are being written.
@@ -254,10 +467,69 @@ Status QLWriteOperation::Init(QLWriteRequestPB* request, QLResponsePB* response)
   // We need the hashed key if writing to the static columns, and need primary key if writing to
   // non-static columns or writing the full primary key (i.e. range columns are present or table
   // does not have range columns).
-  return InitializeKeys(
+  RETURN_NOT_OK(InitializeKeys(
       write_static_columns || is_range_operation,
       write_non_static_columns || !request_.range_column_values().empty() ||
-          schema_.num_range_key_columns() == 0);
+          schema_.num_range_key_columns() == 0));
+
+  // Deltas of the row are periodically folded by a read-modify-write update, that writes the full
+  // counter values.
+  if (blind_counter_update_ &&
+      !CountCounterDelta(encoded_pk_doc_key_ ? encoded_pk_doc_key_.as_slice()
+                                             : encoded_hashed_doc_key_.as_slice())) {
+    blind_counter_update_ = false;
+    require_read_ = RequireRead(request_, schema_) || insert_into_unique_index_;
+  }
+  return Status::OK();
+}
+
+bool QLWriteOperation::IsBlindCounterUpdate() const {
+  // The counter value is only needed when the update is conditional, returns the status row or
+  // updates indexes. Counter deltas are not written in transactions, that could write them to
+  // intents, and with TTL, that could expire part of the deltas of a counter.
+  if (!FLAGS_ycql_blind_counter_updates || txn_op_context_ ||
+      request_.type() != QLWriteRequestPB::QL_STMT_UPDATE || request_.has_if_expr() ||
+      request_.returns_status() || request_.has_ttl() || request_.has_user_timestamp_usec() ||
+      !request_.update_index_ids().empty() || request_.column_values().empty() ||
+      IsRangeOperation(request_, schema_) || schema_.table_properties().HasDefaultTimeToLive()) {
+    return false;
+  }
+  for (const auto& column_value : request_.column_values()) {
+    auto column = schema_.column_by_id(ColumnId(column_value.column_id()));
+    if (!column.ok() || !CounterDelta(column_value, *column)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool QLWriteOperation::IsInPlaceListUpdate() const {
+  // The list is referenced only to locate the updated or removed elements, that is done by a scan
+  // of the list in DocDB. Other column values must be constants, so they don't need the row either.
+  if (request_.type() != QLWriteRequestPB::QL_STMT_UPDATE || request_.has_if_expr() ||
+      request_.returns_status() || !request_.update_index_ids().empty() ||
+      !request_.column_refs().static_ids().empty()) {
+    return false;
+  }
+  std::unordered_set<int32_t> list_column_ids;
+  for (const auto& column_value : request_.column_values()) {
+    auto column = schema_.column_by_id(ColumnId(column_value.column_id()));
+    if (!column.ok()) {
+      return false;
+    }
+    if (IsInPlaceListColumnUpdate(column_value, *column)) {
+      list_column_ids.insert(column_value.column_id());
+    } else if (!column_value.expr().has_value() || !column_value.subscript_args().empty() ||
+               !column_value.json_args().empty()) {
+      return false;
+    }
+  }
+  for (const auto id : request_.column_refs().ids()) {
+    if (list_column_ids.count(id) == 0) {
+      return false;
+    }
+  }
+  return !list_column_ids.empty();
 }
 
 Status QLWriteOperation::InitializeKeys(const bool hashed_key, const bool primary_key) {
@@ -535,63 +807,24 @@ Status QLWriteOperation::ApplyForJsonOperators(const QLColumnValuePB& column_val
                                                QLTableRow* existing_row,
                                                bool is_insert) {
   using common::Jsonb;
-  // Read the json column value inorder to perform a read modify write.
-  QLValue ql_value;
-  RETURN_NOT_OK(existing_row->ReadColumn(column_value.column_id(), &ql_value));
-  if (ql_value.IsNull()) {
+  // Read the json column value inorder to perform a read modify write. The value is not copied,
+  // since the row is only updated after the new value is built.
+  const QLValuePB* ql_value = existing_row->GetColumn(column_value.column_id());
+  if (ql_value == nullptr || IsNull(*ql_value)) {
     return STATUS_SUBSTITUTE(QLError, "Invalid Json value: ", column_value.ShortDebugString());
   }
-  Jsonb jsonb(std::move(ql_value.jsonb_value()));
-  rapidjson::Document document;
-  RETURN_NOT_OK(jsonb.ToRapidJson(&document));
-
-  // Deserialize the rhs.
-  Jsonb rhs(std::move(column_value.expr().value().jsonb_value()));
-  rapidjson::Document rhs_doc;
-  RETURN_NOT_OK(rhs.ToRapidJson(&rhs_doc));
-
-  // Update the json value.
-  rapidjson::Value::MemberIterator memberit;
-  rapidjson::Value::ValueIterator valueit;
-  bool last_elem_object;
-  rapidjson::Value* node = &document;
-
-  int i = 0;
-  auto status = FindMemberForIndex(column_value, i, node, &memberit, &valueit,
-      &last_elem_object, is_insert);
-  for (i = 1; i < column_value.json_args_size() && status.ok(); i++) {
-    node = (last_elem_object) ? &(memberit->value) : &(*valueit);
-    status = FindMemberForIndex(column_value, i, node, &memberit, &valueit,
-        &last_elem_object, is_insert);
-  }
-
-  bool update_missing = false;
-  if (is_insert) {
-    RETURN_NOT_OK(status);
-  } else {
-    update_missing = !status.ok();
-  }
-
-  if (update_missing) {
-    // NOTE: lhs path cannot exceed by more than one hop
-    if (last_elem_object && i == column_value.json_args_size()) {
-      auto val = column_value.json_args(i - 1).operand().value().string_value();
-      rapidjson::Value v(val.c_str(), val.size(), document.GetAllocator());
-      node->AddMember(v, rhs_doc, document.GetAllocator());
-    } else {
-      RETURN_NOT_OK(status);
-    }
-  } else if (last_elem_object) {
-    memberit->value = rhs_doc.Move();
-  } else {
-    *valueit = rhs_doc.Move();
-  }
-
-  // Now write the new json value back.
+  // Splice the new value into the serialized document when the path points to an existing
+  // element. Otherwise, e.g. when a new member should be added, the document is deserialized and
+  // updated as a whole.
   QLValue result;
-  Jsonb jsonb_result;
-  RETURN_NOT_OK(jsonb_result.FromRapidJson(document));
-  *result.mutable_jsonb_value() = std::move(jsonb_result.MoveSerializedJsonb());
+  auto status = Jsonb::ReplaceElement(
+      ql_value->jsonb_value(), column_value.json_args(), column_value.expr().value().jsonb_value(),
+      result.mutable_jsonb_value());
+  if (!status.ok()) {
+    VLOG(3) << "Cannot replace json element in place: " << status;
+    RETURN_NOT_OK(UpdateJsonDocument(
+        column_value, is_insert, ql_value->jsonb_value(), result.mutable_jsonb_value()));
+  }
   const SubDocument& sub_doc =
       SubDocument::FromQLValuePB(result.value(), column.sorting_type(),
                                  yb::bfql::TSOpcode::kScalarInsert);
@@ -637,15 +870,11 @@ Status QLWriteOperation::ApplyForSubscriptArgs(const QLColumnValuePB& column_val
       break;
     }
     case LIST: {
-      MonoDelta default_ttl = schema_.table_properties().HasDefaultTimeToLive() ?
-          MonoDelta::FromMilliseconds(schema_.table_properties().DefaultTimeToLive()) :
-          MonoDelta::kMax;
-
       // At YQL layer list indexes start at 0, but internally we start at 1.
       int index = column_value.subscript_args(0).value().int32_value() + 1;
       RETURN_NOT_OK(data.doc_write_batch->ReplaceCqlInList(
           *sub_path, {index}, {sub_doc}, data.read_time, data.deadline, request_.query_id(),
-          default_ttl, ttl));
+          TableDefaultTtl(schema_), ttl));
       break;
     }
     default: {
@@ -666,10 +895,15 @@ Status QLWriteOperation::ApplyForRegularColumns(const QLColumnValuePB& column_va
                                                 QLTableRow* new_row) {
   using yb::bfql::TSOpcode;
 
+  const TSOpcode write_instr = GetTSWriteInstruction(column_value.expr());
+  if (write_instr == TSOpcode::kListRemove) {
+    return ApplyListRemove(column_value, existing_row, data, sub_path, user_timestamp, column,
+                           column_id, new_row);
+  }
+
   // Typical case, setting a columns value
   QLValue expr_result;
   RETURN_NOT_OK(EvalExpr(column_value.expr(), existing_row, &expr_result));
-  const TSOpcode write_instr = GetTSWriteInstruction(column_value.expr());
   const SubDocument& sub_doc =
       SubDocument::FromQLValuePB(expr_result.value(), column.sorting_type(), write_instr);
   switch (write_instr) {
@@ -695,16 +929,6 @@ Status QLWriteOperation::ApplyForRegularColumns(const QLColumnValuePB& column_va
           RETURN_NOT_OK(data.doc_write_batch->ExtendList(
               sub_path, sub_doc, data.read_time, data.deadline, request_.query_id(), ttl));
       break;
-    case TSOpcode::kListRemove:
-      // TODO(akashnil or mihnea) this should call RemoveFromList once thats implemented
-      // Currently list subtraction is computed in memory using builtin call so this
-      // case should never be reached. Once it is implemented the corresponding case
-      // from EvalQLExpressionPB should be uncommented to enable this optimization.
-          RETURN_NOT_OK(CheckUserTimestampForCollections(user_timestamp));
-          RETURN_NOT_OK(data.doc_write_batch->InsertSubDocument(
-              sub_path, sub_doc, data.read_time, data.deadline,
-              request_.query_id(), ttl, user_timestamp));
-      break;
     default:
       LOG(FATAL) << "Unsupported operation: " << static_cast<int>(write_instr);
       break;
@@ -716,6 +940,38 @@ Status QLWriteOperation::ApplyForRegularColumns(const QLColumnValuePB& column_va
   return Status::OK();
 }
 
+Status QLWriteOperation::ApplyListRemove(const QLColumnValuePB& column_value,
+                                         const QLTableRow& existing_row,
+                                         const DocOperationApplyData& data,
+                                         const DocPath& sub_path,
+                                         const UserTimeMicros& user_timestamp,
+                                         const ColumnSchema& column,
+                                         const ColumnId& column_id,
+                                         QLTableRow* new_row) {
+  RETURN_NOT_OK(CheckUserTimestampForCollections(user_timestamp));
+
+  // Only the elements equal to the removed values are deleted, the rest of the list is kept as is.
+  QLValue removed_values;
+  RETURN_NOT_OK(EvalExpr(column_value.expr().tscall().operands(1), existing_row, &removed_values));
+  if (!removed_values.IsNull()) {
+    std::vector<PrimitiveValue> values;
+    values.reserve(removed_values.list_value().elems_size());
+    for (const auto& elem : removed_values.list_value().elems()) {
+      values.push_back(PrimitiveValue::FromQLValuePB(elem, column.sorting_type()));
+    }
+    RETURN_NOT_OK(data.doc_write_batch->RemoveFromCqlList(
+        sub_path, values, data.read_time, data.deadline, request_.query_id(),
+        TableDefaultTtl(schema_)));
+  }
+
+  if (update_indexes_) {
+    QLValue expr_result;
+    RETURN_NOT_OK(EvalExpr(column_value.expr(), existing_row, &expr_result));
+    new_row->AllocColumn(column_id, expr_result);
+  }
+  return Status::OK();
+}
+
 Status QLWriteOperation::Apply(const DocOperationApplyData& data) {
   QLTableRow existing_row;
   if (request_.has_if_expr()) {
@@ -746,7 +1002,9 @@ Status QLWriteOperation::Apply(const DocOperationApplyData& data) {
     }
 
     TEST_PAUSE_IF_FLAG(pause_write_apply_after_if);
-  } else if (RequireReadForExpressions(request_) || request_.returns_status()) {
+  } else if ((RequireReadForExpressions(request_) && !blind_counter_update_ &&
+              !in_place_list_update_) ||
+             request_.returns_status()) {
     RETURN_NOT_OK(ReadColumns(data, nullptr, nullptr, &existing_row));
     if (request_.returns_status()) {
       RETURN_NOT_OK(PopulateStatusRow(data, /* should_apply = */ true, existing_row, &rowblock_));
@@ -818,7 +1076,12 @@ Status QLWriteOperation::Apply(const DocOperationApplyData& data) {
             PrimitiveValue(column_id));
 
         QLValue expr_result;
-        if (!column_value.json_args().empty()) {
+        if (blind_counter_update_) {
+          const Value delta(PrimitiveValue(*CounterDelta(column_value, column)), Value::kMaxTtl,
+                            Value::kInvalidUserTimestamp, Value::kCounterDeltaFlag);
+          RETURN_NOT_OK(data.doc_write_batch->SetPrimitive(
+              sub_path, delta, data.read_time, data.deadline, request_.query_id()));
+        } else if (!column_value.json_args().empty()) {
           RETURN_NOT_OK(ApplyForJsonOperators(column_value, data, sub_path, ttl,
                                               user_timestamp, column, &new_row, is_insert));
         } else if (!column_value.subscript_args().empty()) {
@@ -1171,6 +1434,11 @@ Status QLReadOperation::Execute(const common::YQLStorageIf& ql_storage,
     }
     row_count_limit = request_.limit();
   }
+  // Aggregate reads return all groups of the tablet, since a group cannot be continued by the
+  // next page.
+  if (request_.group_by_column_ids_size() > 0) {
+    row_count_limit = std::numeric_limits<std::size_t>::max();
+  }
 
   // Create the projections of the non-key columns selected by the row block plus any referenced in
   // the WHERE condition. When DocRowwiseIterator::NextRow() populates the value map, it uses this
@@ -1187,6 +1455,36 @@ Status QLReadOperation::Execute(const common::YQLStorageIf& ql_storage,
   RETURN_NOT_OK(ql_storage.BuildYQLScanSpec(
       request_, read_time, schema, read_static_columns, static_projection, &spec,
       &static_row_spec));
+
+  boost::optional<KeyBytes> row_cache_key;
+  std::vector<ColumnId> row_cache_columns;
+  uint64_t row_cache_generation = 0;
+  if (row_cache_) {
+    row_cache_key = VERIFY_RESULT(RowCacheKey(schema));
+  }
+  if (row_cache_key) {
+    row_cache_columns = non_static_projection.column_ids();
+    std::sort(row_cache_columns.begin(), row_cache_columns.end());
+    bool found = false;
+    QLTableRow cached_row;
+    if (row_cache_->Lookup(row_cache_key->AsSlice(), read_time.read, row_cache_columns, &found,
+                           &cached_row)) {
+      if (found) {
+        int match_count = 0;
+        RETURN_NOT_OK(AddRowToResult(spec, cached_row, row_count_limit, offset, resultset,
+                                     &match_count, &num_rows_skipped));
+      }
+      if (FLAGS_trace_docdb_calls) {
+        TRACE("Fetched $0 rows from row cache.", resultset->rsrow_count());
+      }
+      // No write of the row is after the version of the entry, so the read does not need restart.
+      *restart_read_ht = HybridTime::kInvalid;
+      return Status::OK();
+    }
+    // Should be obtained before the iterator is created, see RowCache.
+    row_cache_generation = row_cache_->Generation(row_cache_key->AsSlice());
+  }
+
   RETURN_NOT_OK(ql_storage.GetIterator(request_, projection, schema, txn_op_context_,
                                        deadline, read_time, *spec, &iter));
   if (FLAGS_trace_docdb_calls) {
@@ -1212,6 +1510,7 @@ Status QLReadOperation::Execute(const common::YQLStorageIf& ql_storage,
 
   // Begin the normal fetch.
   int match_count = 0;
+  size_t num_rows_read = 0;
   bool static_dealt_with = true;
   while (resultset->rsrow_count() < row_count_limit && VERIFY_RESULT(iter->HasNext())) {
     const bool last_read_static = iter->IsNextStaticColumn();
@@ -1231,6 +1530,7 @@ Status QLReadOperation::Execute(const common::YQLStorageIf& ql_storage,
       // would be to only read the first non-static column for each hash key, and skip the rest
       non_static_row.Clear();
       RETURN_NOT_OK(iter->NextRow(non_static_projection, &non_static_row));
+      ++num_rows_read;
     }
 
     // We have two possible cases: whether we use distinct or not
@@ -1305,9 +1605,56 @@ Status QLReadOperation::Execute(const common::YQLStorageIf& ql_storage,
   // SetPagingStateIfNecessary could perform read, so we assign restart_read_ht after it.
   *restart_read_ht = iter->RestartReadHt();
 
+  if (row_cache_key && !restart_read_ht->is_valid()) {
+    if (num_rows_read == 0) {
+      row_cache_->Insert(row_cache_key->AsSlice(), read_time.read, row_cache_generation,
+                         std::move(row_cache_columns), nullptr /* row */);
+    } else if (num_rows_read == 1 && RowIsCacheable(non_static_projection, non_static_row)) {
+      row_cache_->Insert(row_cache_key->AsSlice(), read_time.read, row_cache_generation,
+                         std::move(row_cache_columns), &non_static_row);
+    }
+  }
+
   return Status::OK();
 }
 
+Result<boost::optional<KeyBytes>> QLReadOperation::RowCacheKey(const Schema& schema) {
+  // Rows of transactional tables are not cached, since they could be changed by committed
+  // transactions, whose intents are not applied yet. Rows of tables with default TTL expire
+  // without being written.
+  if (txn_op_context_ || schema.table_properties().HasDefaultTimeToLive() ||
+      schema.has_statics() || schema.num_hash_key_columns() == 0 ||
+      !request_.has_hash_code() ||
+      request_.hashed_column_values_size() != schema.num_hash_key_columns() ||
+      request_.has_paging_state() || request_.has_offset() || request_.distinct() ||
+      request_.is_aggregate() || request_.group_by_column_ids_size() > 0) {
+    return boost::none;
+  }
+
+  std::vector<const QLValuePB*> range_values(schema.num_range_key_columns());
+  if (request_.has_where_expr() &&
+      !CollectRangeKeyValues(schema, request_.where_expr().condition(), &range_values)) {
+    return boost::none;
+  }
+  std::vector<PrimitiveValue> range_components;
+  range_components.reserve(range_values.size());
+  for (size_t i = 0; i != range_values.size(); ++i) {
+    if (!range_values[i] || IsNull(*range_values[i])) {
+      return boost::none;
+    }
+    const auto& column = schema.column(schema.num_hash_key_columns() + i);
+    range_components.push_back(
+        PrimitiveValue::FromQLValuePB(*range_values[i], column.sorting_type()));
+  }
+
+  std::vector<PrimitiveValue> hashed_components;
+  RETURN_NOT_OK(QLKeyColumnValuesToPrimitiveValues(
+      request_.hashed_column_values(), schema, 0, schema.num_hash_key_columns(),
+      &hashed_components));
+  return DocKey(schema, static_cast<DocKeyHash>(request_.hash_code()),
+                std::move(hashed_components), std::move(range_components)).Encode();
+}
+
 Status QLReadOperation::SetPagingStateIfNecessary(const common::YQLRowwiseIteratorIf* iter,
                                                   const QLResultSet* resultset,
                                                   const size_t row_count_limit,
@@ -1412,6 +1759,22 @@ Status QLReadOperation::PopulateAggregate(const QLTableRow& table_row, QLResultS
   return Status::OK();
 }
 
+Status QLReadOperation::StartGroupIfNeeded(const QLTableRow& table_row,
+                                           QLResultSet *resultset) {
+  std::vector<QLValue> group_key(request_.group_by_column_ids_size());
+  for (int i = 0; i != request_.group_by_column_ids_size(); ++i) {
+    RETURN_NOT_OK(table_row.ReadColumn(request_.group_by_column_ids(i), &group_key[i]));
+  }
+  // Rows are scanned in the primary key order, so the current group is complete once a row with
+  // another key is read.
+  if (!aggr_result_.empty() && group_key != group_key_) {
+    RETURN_NOT_OK(PopulateAggregate(table_row, resultset));
+    aggr_result_.clear();
+  }
+  group_key_ = std::move(group_key);
+  return Status::OK();
+}
+
 Status QLReadOperation::AddRowToResult(const std::unique_ptr<common::QLScanSpec>& spec,
                                        const QLTableRow& row,
                                        const size_t row_count_limit,
@@ -1427,6 +1790,9 @@ Status QLReadOperation::AddRowToResult(const std::unique_ptr<common::QLScanSpec>
       if (*num_rows_skipped >= offset) {
         (*match_count)++;
         if (request_.is_aggregate()) {
+          if (request_.group_by_column_ids_size() > 0) {
+            RETURN_NOT_OK(StartGroupIfNeeded(row, resultset));
+          }
           RETURN_NOT_OK(EvalAggregate(row));
         } else {
           RETURN_NOT_OK(PopulateResultSet(spec, row, resultset));
@@ -21,6 +21,7 @@
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_operation.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
+#include "yb/docdb/docdb_fwd.h"
 #include "yb/docdb/intent_aware_iterator.h"
 
 namespace yb {
@@ -88,6 +89,15 @@ class QLWriteOperation :
                                         const ColumnId& column_id,
                                         QLTableRow* new_row);
 
+  CHECKED_STATUS ApplyListRemove(const QLColumnValuePB& column_value,
+                                 const QLTableRow& current_row,
+                                 const DocOperationApplyData& data,
+                                 const DocPath& sub_path,
+                                 const UserTimeMicros& user_timestamp,
+                                 const ColumnSchema& column,
+                                 const ColumnId& column_id,
+                                 QLTableRow* new_row);
+
   const QLWriteRequestPB& request() const { return request_; }
   QLResponsePB* response() const { return response_; }
 
@@ -105,6 +115,14 @@ class QLWriteOperation :
     }
   }
 
+  // Whether this is an update of counters by constant deltas, that are written without reading the
+  // current counter values.
+  bool IsBlindCounterUpdate() const;
+
+  // Whether the columns referenced by this update are only lists, that are updated by index or
+  // have elements removed, and that are changed in place without reading the current row.
+  bool IsInPlaceListUpdate() const;
+
   // Initialize hashed_doc_key_ and/or pk_doc_key_.
   CHECKED_STATUS InitializeKeys(bool hashed_key, bool primary_key);
 
@@ -174,6 +192,12 @@ class QLWriteOperation :
   // Any indexes that may need update?
   bool update_indexes_ = false;
 
+  // Are counter deltas written without reading the counters?
+  bool blind_counter_update_ = false;
+
+  // Are list index updates and list removes applied without reading the row?
+  bool in_place_list_update_ = false;
+
   // Is this an insert into a unique index?
   bool insert_into_unique_index_ = false;
 
@@ -190,10 +214,12 @@ CHECKED_STATUS PrepareIndexWriteAndCheckIfIndexKeyChanged(QLExprExecutor* expr_e
 
 class QLReadOperation : public DocExprExecutor {
  public:
+  // row_cache, if not null, is used to serve reads of a single row by its primary key.
   QLReadOperation(
       const QLReadRequestPB& request,
-      const TransactionOperationContextOpt& txn_op_context)
-      : request_(request), txn_op_context_(txn_op_context) {}
+      const TransactionOperationContextOpt& txn_op_context,
+      RowCache* row_cache = nullptr)
+      : request_(request), txn_op_context_(txn_op_context), row_cache_(row_cache) {}
 
   CHECKED_STATUS Execute(const common::YQLStorageIf& ql_storage,
                          CoarseTimePoint deadline,
@@ -210,6 +236,10 @@ class QLReadOperation : public DocExprExecutor {
   CHECKED_STATUS EvalAggregate(const QLTableRow& table_row);
   CHECKED_STATUS PopulateAggregate(const QLTableRow& table_row, QLResultSet *resultset);
 
+  // For a grouped aggregate read, populates the aggregate values of the current group when the
+  // given row starts a new group.
+  CHECKED_STATUS StartGroupIfNeeded(const QLTableRow& table_row, QLResultSet *resultset);
+
   CHECKED_STATUS AddRowToResult(const std::unique_ptr<common::QLScanSpec>& spec,
                                 const QLTableRow& row,
                                 const size_t row_count_limit,
@@ -232,9 +262,17 @@ class QLReadOperation : public DocExprExecutor {
                                            const size_t num_rows_skipped,
                                            const ReadHybridTime& read_time);
 
+  // Returns the encoded DocKey of the row, when the request could be served by the row cache,
+  // i.e. it reads a single row by its full primary key.
+  Result<boost::optional<KeyBytes>> RowCacheKey(const Schema& schema);
+
   const QLReadRequestPB& request_;
   const TransactionOperationContextOpt txn_op_context_;
+  RowCache* const row_cache_;
   QLResponsePB response_;
+
+  // Values of the GROUP BY columns of the current group.
+  std::vector<QLValue> group_key_;
 };
 
 }  // namespace docdb
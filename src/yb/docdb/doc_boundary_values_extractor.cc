@@ -13,6 +13,7 @@
 //
 //
 
+#include "yb/rocksdb/db/compaction.h"
 #include "yb/rocksdb/db/dbformat.h"
 
 #include "yb/docdb/consensus_frontier.h"
@@ -256,5 +257,113 @@ rocksdb::UserBoundaryTag TagForRangeComponent(size_t index) {
   return PrimitiveBoundaryValue::TagForIndex(index);
 }
 
+namespace {
+
+// Excludes SST files that contain only records written after max_hybrid_time, and delegates the
+// decision about other files to base_filter.
+class HybridTimeFileFilter : public rocksdb::ReadFileFilter {
+ public:
+  HybridTimeFileFilter(HybridTime max_hybrid_time,
+                       std::shared_ptr<rocksdb::ReadFileFilter> base_filter)
+      : encoded_max_doc_ht_(DocHybridTime(max_hybrid_time, kMaxWriteId).EncodedInDocDbFormat()),
+        base_filter_(std::move(base_filter)) {
+  }
+
+  bool Filter(const rocksdb::FdWithBoundaries& file) const override {
+    // Files written before hybrid time boundaries were introduced don't have this value.
+    const auto* smallest = file.smallest.user_value_with_tag(kDocHybridTimeTag);
+    // Hybrid times are encoded in descending order, so the smallest hybrid time of the file is
+    // greater than max_hybrid_time when its encoding is less.
+    if (smallest && smallest->compare(encoded_max_doc_ht_) < 0) {
+      return false;
+    }
+    return !base_filter_ || base_filter_->Filter(file);
+  }
+
+ private:
+  const std::string encoded_max_doc_ht_;
+  const std::shared_ptr<rocksdb::ReadFileFilter> base_filter_;
+};
+
+} // namespace
+
+std::shared_ptr<rocksdb::ReadFileFilter> CreateHybridTimeFileFilter(
+    HybridTime max_hybrid_time, std::shared_ptr<rocksdb::ReadFileFilter> base_filter) {
+  return std::make_shared<HybridTimeFileFilter>(max_hybrid_time, std::move(base_filter));
+}
+
+namespace {
+
+// Excludes SST files that contain only records written before the table tombstone, so they
+// could not contain visible rows of the truncated table, and delegates the remaining files to
+// the base filter. Should be used only by iterators over rows of a single colocated table.
+class TableTombstoneFileFilter : public rocksdb::ReadFileFilter {
+ public:
+  TableTombstoneFileFilter(const DocHybridTime& tombstone_time,
+                           std::shared_ptr<rocksdb::ReadFileFilter> base_filter)
+      : encoded_tombstone_doc_ht_(tombstone_time.EncodedInDocDbFormat()),
+        base_filter_(std::move(base_filter)) {
+  }
+
+  bool Filter(const rocksdb::FdWithBoundaries& file) const override {
+    const auto* largest = file.largest.user_value_with_tag(kDocHybridTimeTag);
+    // Hybrid times are encoded in descending order, so the largest hybrid time of the file is
+    // less than the tombstone time when its encoding is greater.
+    if (largest && largest->compare(encoded_tombstone_doc_ht_) > 0) {
+      return false;
+    }
+    return !base_filter_ || base_filter_->Filter(file);
+  }
+
+ private:
+  const std::string encoded_tombstone_doc_ht_;
+  const std::shared_ptr<rocksdb::ReadFileFilter> base_filter_;
+};
+
+} // namespace
+
+std::shared_ptr<rocksdb::ReadFileFilter> CreateTableTombstoneFileFilter(
+    const DocHybridTime& tombstone_time, std::shared_ptr<rocksdb::ReadFileFilter> base_filter) {
+  return std::make_shared<TableTombstoneFileFilter>(tombstone_time, std::move(base_filter));
+}
+
+namespace {
+
+// Excludes SST files whose key range does not intersect key bounds, and delegates the decision
+// about other files to base_filter. After tablet split both children share the SST files of the parent
+// until they are compacted, so such files could contain only keys of the other child.
+class KeyBoundsFileFilter : public rocksdb::ReadFileFilter {
+ public:
+  KeyBoundsFileFilter(const KeyBounds* key_bounds,
+                      std::shared_ptr<rocksdb::ReadFileFilter> base_filter)
+      : key_bounds_(key_bounds), base_filter_(std::move(base_filter)) {
+  }
+
+  bool Filter(const rocksdb::FdWithBoundaries& file) const override {
+    // Bounds are encoded DocKeys, so comparing them with user keys of the file, that also contain
+    // hybrid times, is enough to find out whether the file contains keys within bounds.
+    if (!key_bounds_->lower.empty() &&
+        file.largest.user_key().compare(key_bounds_->lower.AsSlice()) < 0) {
+      return false;
+    }
+    if (!key_bounds_->upper.empty() &&
+        file.smallest.user_key().compare(key_bounds_->upper.AsSlice()) >= 0) {
+      return false;
+    }
+    return !base_filter_ || base_filter_->Filter(file);
+  }
+
+ private:
+  const KeyBounds* const key_bounds_;
+  const std::shared_ptr<rocksdb::ReadFileFilter> base_filter_;
+};
+
+} // namespace
+
+std::shared_ptr<rocksdb::ReadFileFilter> CreateKeyBoundsFileFilter(
+    const KeyBounds* key_bounds, std::shared_ptr<rocksdb::ReadFileFilter> base_filter) {
+  return std::make_shared<KeyBoundsFileFilter>(key_bounds, std::move(base_filter));
+}
+
 } // namespace docdb
 } // namespace yb
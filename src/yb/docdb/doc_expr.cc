@@ -19,7 +19,6 @@
 namespace yb {
 namespace docdb {
 
-using yb::util::Decimal;
 
 //--------------------------------------------------------------------------------------------------
 
@@ -301,14 +300,10 @@ CHECKED_STATUS DocExprExecutor::EvalSum(const QLValue& val, QLValue *aggr_sum) {
     case InternalType::kDoubleValue:
       aggr_sum->set_double_value(aggr_sum->double_value() + val.double_value());
       break;
-    case InternalType::kDecimalValue: {
-      Decimal sum, value;
-      RETURN_NOT_OK(sum.DecodeFromComparable(aggr_sum->decimal_value()));
-      RETURN_NOT_OK(value.DecodeFromComparable(val.decimal_value()));
-      sum = sum + value;
-      aggr_sum->set_decimal_value(sum.EncodeToComparable());
+    case InternalType::kDecimalValue:
+      RETURN_NOT_OK(util::AddComparableDecimals(
+          aggr_sum->decimal_value(), val.decimal_value(), aggr_sum->mutable_decimal_value()));
       break;
-    }
     default:
       return STATUS(RuntimeError, "Cannot find SUM of this column");
   }
@@ -433,12 +433,64 @@ TEST_F(DocKeyTest, TestKeyMatching) {
   ASSERT_FALSE(may_match(EncodeSimpleSubDocKey(absent_key))) << "Key: " << absent_key;
 }
 
+TEST_F(DocKeyTest, TestRangeComponentsKeyMatching) {
+  DocDbAwareFilterPolicy policy(
+      rocksdb::FilterPolicy::kDefaultFixedSizeFilterBits, nullptr, 1 /* num_range_components */);
+  ASSERT_STRNE(
+      DocDbAwareFilterPolicy(rocksdb::FilterPolicy::kDefaultFixedSizeFilterBits, nullptr).Name(),
+      policy.Name());
+  const auto* transformer = policy.GetKeyTransformer();
+  auto encode = [](const std::string& range_key, const std::string& second_range_key) {
+    return SubDocKey(
+        DocKey(0, PrimitiveValues("hash_key"), PrimitiveValues(range_key, second_range_key)),
+        PrimitiveValue("sub_key"), HybridTime::FromMicros(12345L)).Encode().AsStringRef();
+  };
+  std::string range_keys[] = { "foo", "bar", "test" };
+
+  std::unique_ptr<FilterBitsBuilder> builder(policy.GetFilterBitsBuilder());
+  for (const auto& key : range_keys) {
+    builder->AddKey(transformer->Transform(encode(key, "a")));
+  }
+  std::unique_ptr<const char[]> buf;
+  rocksdb::Slice filter = builder->Finish(&buf);
+  std::unique_ptr<FilterBitsReader> reader(policy.GetFilterBitsReader(filter));
+
+  auto may_match = [&](const std::string& key) {
+    EXPECT_TRUE(transformer->CanFilter(key));
+    return reader->MayMatch(transformer->Transform(key));
+  };
+
+  for (const auto& key : range_keys) {
+    ASSERT_TRUE(may_match(encode(key, "a"))) << "Key: " << key;
+    ASSERT_TRUE(may_match(encode(key, "b"))) << "Key: " << key;
+  }
+  ASSERT_FALSE(may_match(encode("fake", "a")));
+
+  // Keys without range components could not be checked against the filter.
+  ASSERT_FALSE(transformer->CanFilter(
+      DocKey(0, PrimitiveValues("hash_key")).Encode().AsSlice()));
+}
+
 TEST_F(DocKeyTest, TestWriteId) {
   SubDocKey subdoc_key(DocKey({PrimitiveValue("a"), PrimitiveValue(135)}),
                        DocHybridTime(1000000, 4091, 135));
   TestRoundTripDocOrSubDocKeyEncodingDecoding(subdoc_key);
 }
 
+TEST_F(DocKeyTest, TestHybridTimeSuffixTransform) {
+  DocDbHybridTimeSuffixTransform transform;
+  const DocKey doc_key({PrimitiveValue("a"), PrimitiveValue(135)});
+  const SubDocKey subdoc_key(doc_key, DocHybridTime(1000000, 4091, 135));
+  const auto encoded = subdoc_key.EncodeWithoutHt();
+  const auto encoded_with_ht = subdoc_key.Encode();
+  ASSERT_TRUE(transform.InDomain(encoded_with_ht.AsSlice()));
+  ASSERT_EQ(encoded.AsSlice(), transform.Transform(encoded_with_ht.AsSlice()));
+
+  // A key that is only an encoded hybrid time has no room for the preceding value type.
+  const auto ht_only = DocHybridTime(1000000, 4091, 135).EncodedInDocDbFormat();
+  ASSERT_FALSE(transform.InDomain(ht_only));
+}
+
 struct CollectedIntent {
   IntentStrength strength;
   KeyBytes intent_key;
@@ -724,5 +776,49 @@ TEST_F(DocKeyTest, TestEnumerateIntents) {
   }
 }
 
+// Measures encoding and decoding of document keys of different shapes. Uses more iterations when
+// slow tests are allowed, to get stable numbers.
+TEST_F(DocKeyTest, EncodeDecodePerf) {
+  const int kIterations = AllowSlowTests() ? 1000000 : 10000;
+  const std::string kLongText(100, 'x');
+  std::string text_with_zeros(32, 'y');
+  text_with_zeros[5] = text_with_zeros[20] = '\0';
+
+  const std::vector<std::pair<std::string, DocKey>> shapes = {
+    {"int", DocKey(kAsciiFriendlyHash, {PrimitiveValue(static_cast<int64_t>(12345))})},
+    {"short text", DocKey(kAsciiFriendlyHash, {PrimitiveValue("user123")},
+                          {PrimitiveValue("item")})},
+    {"long text", DocKey(kAsciiFriendlyHash, {PrimitiveValue(kLongText)},
+                         {PrimitiveValue(kLongText)})},
+    {"long descending text", DocKey(kAsciiFriendlyHash, {PrimitiveValue(kLongText)},
+                                    {PrimitiveValue(kLongText, SortOrder::kDescending)})},
+    {"text with zeros", DocKey(kAsciiFriendlyHash, {PrimitiveValue(text_with_zeros)},
+                               {PrimitiveValue(text_with_zeros, SortOrder::kDescending)})},
+  };
+
+  for (const auto& shape : shapes) {
+    const auto encoded = shape.second.Encode();
+    auto start = MonoTime::Now();
+    size_t total_size = 0;
+    for (int i = 0; i != kIterations; ++i) {
+      total_size += shape.second.Encode().size();
+    }
+    const auto encode_time = MonoTime::Now() - start;
+
+    start = MonoTime::Now();
+    DocKey decoded;
+    for (int i = 0; i != kIterations; ++i) {
+      ASSERT_OK(decoded.FullyDecodeFrom(encoded.AsSlice()));
+    }
+    const auto decode_time = MonoTime::Now() - start;
+    ASSERT_EQ(shape.second, decoded);
+    ASSERT_EQ(encoded.size() * kIterations, total_size);
+
+    LOG(INFO) << Format(
+        "$0, encoded size $1: encode $2 ns, decode $3 ns", shape.first, encoded.size(),
+        encode_time.ToNanoseconds() / kIterations, decode_time.ToNanoseconds() / kIterations);
+  }
+}
+
 }  // namespace docdb
 }  // namespace yb
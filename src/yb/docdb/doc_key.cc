@@ -26,6 +26,9 @@
 #include "yb/rocksutil/yb_rocksdb.h"
 #include "yb/util/enums.h"
 #include "yb/util/compare_util.h"
+#include "yb/util/flag_tags.h"
+
+DECLARE_bool(use_docdb_bloom_filter_line_mask_format);
 
 using std::ostringstream;
 
@@ -977,8 +980,63 @@ class HashedComponentsExtractor : public rocksdb::FilterPolicy::KeyTransformer {
   }
 };
 
+// Extracts hashed components and the first num_range_components range components.
+class RangeComponentsExtractor : public rocksdb::FilterPolicy::KeyTransformer {
+ public:
+  explicit RangeComponentsExtractor(size_t num_range_components)
+      : num_range_components_(num_range_components) {}
+
+  RangeComponentsExtractor(const RangeComponentsExtractor&) = delete;
+  RangeComponentsExtractor& operator=(const RangeComponentsExtractor&) = delete;
+
+  Slice Transform(Slice key) const override {
+    size_t num_decoded = 0;
+    auto size = CHECK_RESULT(EncodedPrefixSize(key, &num_decoded));
+    return Slice(key.data(), size);
+  }
+
+  bool CanFilter(Slice key) const override {
+    size_t num_decoded = 0;
+    auto size = EncodedPrefixSize(key, &num_decoded);
+    return size.ok() && num_decoded == num_range_components_;
+  }
+
+ private:
+  // Returns size of the key prefix with hashed components and up to num_range_components_ range
+  // components, num_decoded is set to the number of range components in this prefix.
+  Result<size_t> EncodedPrefixSize(Slice key, size_t* num_decoded) const {
+    auto hash_part_size = VERIFY_RESULT(DocKey::EncodedSize(key, DocKeyPart::UP_TO_HASH));
+    DocKeyDecoder decoder(Slice(key.data() + hash_part_size, key.end()));
+    while (*num_decoded < num_range_components_ && !decoder.GroupEnded()) {
+      RETURN_NOT_OK(decoder.DecodePrimitiveValue());
+      ++*num_decoded;
+    }
+    return key.size() - decoder.left_input().size();
+  }
+
+  const size_t num_range_components_;
+};
+
 } // namespace
 
+DocDbAwareFilterPolicy::DocDbAwareFilterPolicy(
+    size_t filter_block_size_bits, rocksdb::Logger* logger, size_t num_range_components)
+    : builtin_policy_(rocksdb::NewFixedSizeFilterPolicy(
+          filter_block_size_bits, rocksdb::FilterPolicy::kDefaultFixedSizeFilterErrorRate, logger,
+          FLAGS_use_docdb_bloom_filter_line_mask_format
+              ? rocksdb::FixedSizeFilterFormat::kLineMask
+              : rocksdb::FixedSizeFilterFormat::kBitProbes)),
+      num_range_components_(num_range_components),
+      name_(num_range_components == 0
+                ? "DocKeyHashedComponentsFilter"
+                : Format("DocKeyRangeComponentsFilter$0", num_range_components)) {
+  if (num_range_components != 0) {
+    range_components_extractor_ = std::make_unique<RangeComponentsExtractor>(num_range_components);
+  }
+}
+
+DocDbAwareFilterPolicy::~DocDbAwareFilterPolicy() = default;
+
 
 void DocDbAwareFilterPolicy::CreateFilter(
     const rocksdb::Slice* keys, int n, std::string* dst) const {
@@ -1005,9 +1063,35 @@ rocksdb::FilterPolicy::FilterType DocDbAwareFilterPolicy::GetFilterType() const
 }
 
 const rocksdb::FilterPolicy::KeyTransformer* DocDbAwareFilterPolicy::GetKeyTransformer() const {
+  if (range_components_extractor_) {
+    return range_components_extractor_.get();
+  }
   return &HashedComponentsExtractor::GetInstance();
 }
 
+Slice DocDbHybridTimeSuffixTransform::Transform(const Slice& key) const {
+  int encoded_ht_size = 0;
+  CHECK_OK(DocHybridTime::CheckAndGetEncodedSize(key, &encoded_ht_size));
+  return Slice(key.data(), key.size() - encoded_ht_size - 1);
+}
+
+bool DocDbHybridTimeSuffixTransform::InDomain(const Slice& key) const {
+  int encoded_ht_size = 0;
+  if (!DocHybridTime::CheckAndGetEncodedSize(key, &encoded_ht_size).ok() ||
+      key.size() <= static_cast<size_t>(encoded_ht_size)) {
+    return false;
+  }
+  return key[key.size() - encoded_ht_size - 1] == ValueTypeAsChar::kHybridTime;
+}
+
+Slice DocDbDocKeyPrefixTransform::Transform(const Slice& key) const {
+  return Slice(key.data(), CHECK_RESULT(DocKey::EncodedSize(key, DocKeyPart::WHOLE_DOC_KEY)));
+}
+
+bool DocDbDocKeyPrefixTransform::InDomain(const Slice& key) const {
+  return DocKey::EncodedSize(key, DocKeyPart::WHOLE_DOC_KEY).ok();
+}
+
 DocKeyEncoderAfterTableIdStep DocKeyEncoder::CotableId(const Uuid& cotable_id) {
   if (!cotable_id.IsNil()) {
     std::string bytes;
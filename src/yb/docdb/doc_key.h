@@ -21,6 +21,7 @@
 
 #include "yb/rocksdb/env.h"
 #include "yb/rocksdb/filter_policy.h"
+#include "yb/rocksdb/slice_transform.h"
 
 #include "yb/common/schema.h"
 
@@ -816,15 +817,19 @@ inline std::ostream& operator <<(std::ostream& out, const SubDocKey& subdoc_key)
 std::string BestEffortDocDBKeyToStr(const KeyBytes &key_bytes);
 std::string BestEffortDocDBKeyToStr(const rocksdb::Slice &slice);
 
-// This filter policy only takes into account hashed components of keys for filtering.
+// This filter policy only takes into account hashed components of keys for filtering. When
+// num_range_components is not 0, the first num_range_components range components are also taken
+// into account, so scans for a range key prefix could exclude SST files. Keys with fewer range
+// components, like the bounds of a scan by hashed components only, are not checked against such
+// a filter.
 class DocDbAwareFilterPolicy : public rocksdb::FilterPolicy {
  public:
-  explicit DocDbAwareFilterPolicy(size_t filter_block_size_bits, rocksdb::Logger* logger) {
-    builtin_policy_.reset(rocksdb::NewFixedSizeFilterPolicy(
-        filter_block_size_bits, rocksdb::FilterPolicy::kDefaultFixedSizeFilterErrorRate, logger));
-  }
+  explicit DocDbAwareFilterPolicy(
+      size_t filter_block_size_bits, rocksdb::Logger* logger, size_t num_range_components = 0);
+
+  ~DocDbAwareFilterPolicy();
 
-  const char* Name() const override { return "DocKeyHashedComponentsFilter"; }
+  const char* Name() const override { return name_.c_str(); }
 
   void CreateFilter(const rocksdb::Slice* keys, int n, std::string* dst) const override;
 
@@ -838,8 +843,45 @@ class DocDbAwareFilterPolicy : public rocksdb::FilterPolicy {
 
   const KeyTransformer* GetKeyTransformer() const override;
 
+  size_t num_range_components() const {
+    return num_range_components_;
+  }
+
  private:
   std::unique_ptr<const rocksdb::FilterPolicy> builtin_policy_;
+  const size_t num_range_components_;
+  // Filters built with different key transformers have different names, so the filter of a file
+  // is used only when it was built for the same number of range components.
+  const std::string name_;
+  std::unique_ptr<const KeyTransformer> range_components_extractor_;
+};
+
+// Strips the encoded DocHybridTime (including the preceding ValueType::kHybridTime) from the end of
+// a DocDB key, so all versions of the same SubDocKey have the same prefix. Used as the key
+// transform of the in-block data block hash index.
+class DocDbHybridTimeSuffixTransform : public rocksdb::SliceTransform {
+ public:
+  const char* Name() const override { return "DocDbHybridTimeSuffixTransform"; }
+
+  Slice Transform(const Slice& key) const override;
+
+  bool InDomain(const Slice& key) const override;
+
+  bool InRange(const Slice& prefix) const override { return true; }
+};
+
+// Extracts the encoded DocKey from a DocDB key, so all entries of the same document have the same
+// prefix. Used to align subcompaction boundaries with document boundaries, because
+// DocDBCompactionFilter keeps per-document state.
+class DocDbDocKeyPrefixTransform : public rocksdb::SliceTransform {
+ public:
+  const char* Name() const override { return "DocDbDocKeyPrefixTransform"; }
+
+  Slice Transform(const Slice& key) const override;
+
+  bool InDomain(const Slice& key) const override;
+
+  bool InRange(const Slice& prefix) const override { return true; }
 };
 
 // Optional inclusive lower bound and exclusive upper bound for keys served by DocDB.
@@ -872,6 +914,12 @@ struct DocDB {
   rocksdb::DB* regular;
   rocksdb::DB* intents;
   const KeyBounds* key_bounds;
+  // Summary of intents in the intents DB, used to skip intents DB seeks. Could be null.
+  const IntentsSummary* intents_summary = nullptr;
+  // Sample of recently read keys, updated by readers. Could be null.
+  HotKeys* hot_keys = nullptr;
+  // Number of nexts tried before a seek learned by iterators, updated by them. Could be null.
+  NextsToAvoidSeekStats* nexts_to_avoid_seek_stats = nullptr;
 
   static DocDB FromRegularUnbounded(rocksdb::DB* regular) {
     return {regular, nullptr /* intents */, &KeyBounds::kNoBounds};
@@ -115,6 +115,73 @@ TEST(DocKVUtilTest, ZeroEncodingAndDecoding) {
   }
 }
 
+namespace {
+
+// Byte by byte implementation of the encoding, used to check the optimized one.
+string ReferenceEncode(const string& s, char end_of_string) {
+  string result;
+  for (char c : s) {
+    if (c == '\0') {
+      result.push_back(end_of_string);
+      result.push_back(end_of_string ^ 1);
+    } else {
+      result.push_back(end_of_string ^ c);
+    }
+  }
+  result.push_back(end_of_string);
+  result.push_back(end_of_string);
+  return result;
+}
+
+} // namespace
+
+TEST(DocKVUtilTest, EncodingMatchesReference) {
+  rocksdb::Random rng(12345);
+  // Bytes that require escaping or are close to them are generated more often.
+  const char kSpecialBytes[] = { '\x00', '\x01', '\xfe', '\xff' };
+  for (int i = 0; i < 1000; ++i) {
+    int len = rng.Next() % 100;
+    string s;
+    for (int j = 0; j < len; ++j) {
+      s.push_back(rng.OneIn(4) ? kSpecialBytes[rng.Uniform(4)] : static_cast<char>(rng.Next()));
+    }
+    // Suffix checks that decoding consumes only the encoded string.
+    const string kSuffix = "suffix";
+
+    string encoded;
+    ZeroEncodeAndAppendStrToKey(s, &encoded);
+    ASSERT_EQ(ReferenceEncode(s, '\0'), encoded);
+    encoded += kSuffix;
+    rocksdb::Slice slice(encoded);
+    string decoded;
+    ASSERT_OK(DecodeZeroEncodedStr(&slice, &decoded));
+    ASSERT_EQ(s, decoded);
+    ASSERT_EQ(kSuffix, slice.ToBuffer());
+
+    encoded.clear();
+    ComplementZeroEncodeAndAppendStrToKey(s, &encoded);
+    ASSERT_EQ(ReferenceEncode(s, '\xff'), encoded);
+    encoded += kSuffix;
+    slice = rocksdb::Slice(encoded);
+    decoded.clear();
+    ASSERT_OK(DecodeComplementZeroEncodedStr(&slice, &decoded));
+    ASSERT_EQ(s, decoded);
+    ASSERT_EQ(kSuffix, slice.ToBuffer());
+  }
+}
+
+TEST(DocKVUtilTest, DecodeCorruptedStr) {
+  for (const auto& encoded : {BINARY_STRING("abc\x00"), BINARY_STRING("abc\x00\x02")}) {
+    rocksdb::Slice slice(encoded);
+    string decoded;
+    ASSERT_NOK(DecodeZeroEncodedStr(&slice, &decoded));
+  }
+  const auto encoded = BINARY_STRING("\x9e\x9d\xff\xfd");
+  rocksdb::Slice slice(encoded);
+  string decoded;
+  ASSERT_NOK(DecodeComplementZeroEncodedStr(&slice, &decoded));
+}
+
 TEST(DocKVUtilTest, TableTTL) {
   Schema schema;
   EXPECT_TRUE(TableTTL(schema).Equals(Value::kMaxTtl));
@@ -13,6 +13,12 @@
 
 #include "yb/docdb/doc_kv_util.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <string.h>
+
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/value.h"
@@ -74,22 +80,61 @@ Status CheckHybridTimeSizeAndValueType(
   return Status::OK();
 }
 
+namespace {
+
+// Appends len bytes starting at p to dest, XORed with END_OF_STRING, i.e. complemented for '\xff'.
+template <char END_OF_STRING>
+void AppendXoredBytes(const char* p, size_t len, string* dest);
+
+template <>
+inline void AppendXoredBytes<'\0'>(const char* p, size_t len, string* dest) {
+  dest->append(p, len);
+}
+
+template <>
+inline void AppendXoredBytes<'\xff'>(const char* p, size_t len, string* dest) {
+  const size_t old_size = dest->size();
+  dest->resize(old_size + len);
+  char* out = &(*dest)[old_size];
+  const char* end = p + len;
+#ifdef __SSE2__
+  const __m128i ones = _mm_set1_epi8(-1);
+  for (; end - p >= 16; p += 16, out += 16) {
+    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_xor_si128(data, ones));
+  }
+#endif
+  for (; p != end; ++p, ++out) {
+    *out = ~*p;
+  }
+}
+
+// Returns pointer to the first occurrence of c in [p, end), or nullptr if there is no such byte.
+// memchr scans 16 or 32 bytes at a time, depending on the instruction set of the CPU.
+inline const char* FindByte(const char* p, const char* end, char c) {
+  return static_cast<const char*>(memchr(p, c, end - p));
+}
+
+} // namespace
+
+// Both the encoding and the decoding copy runs of bytes that do not need escaping in bulk, instead
+// of processing the string byte by byte.
 template <char END_OF_STRING>
 void AppendEncodedStrToKey(const string &s, string *dest) {
   static_assert(END_OF_STRING == '\0' || END_OF_STRING == '\xff',
                 "Only characters '\0' and '\xff' allowed as a template parameter");
-  if (END_OF_STRING == '\0' && s.find('\0') == string::npos) {
-    // Fast path: no zero characters, nothing to encode.
-    dest->append(s);
-  } else {
-    for (char c : s) {
-      if (c == '\0') {
-        dest->push_back(END_OF_STRING);
-        dest->push_back(END_OF_STRING ^ 1);
-      } else {
-        dest->push_back(END_OF_STRING ^ c);
-      }
+  const char* p = s.data();
+  const char* end = p + s.size();
+  for (;;) {
+    const char* zero = FindByte(p, end, '\0');
+    if (!zero) {
+      AppendXoredBytes<END_OF_STRING>(p, end - p, dest);
+      return;
     }
+    AppendXoredBytes<END_OF_STRING>(p, zero - p, dest);
+    dest->push_back(END_OF_STRING);
+    dest->push_back(END_OF_STRING ^ 1);
+    p = zero + 1;
   }
 }
 
@@ -124,39 +169,40 @@ Status DecodeEncodedStr(rocksdb::Slice* slice, string* result) {
   const char* end = p + slice->size();
 
   while (p != end) {
+    const char* marker = FindByte(p, end, END_OF_STRING);
+    if (!marker) {
+      marker = end;
+    }
+    if (result != nullptr) {
+      AppendXoredBytes<END_OF_STRING>(p, marker - p, result);
+    }
+    p = marker;
+    if (p == end) {
+      break;
+    }
+    ++p;
+    if (p == end) {
+      return STATUS(Corruption, StringPrintf("Encoded string ends with only one \\0x%02x ",
+                                             END_OF_STRING));
+    }
     if (*p == END_OF_STRING) {
+      // Found two END_OF_STRING characters, this is the end of the encoded string.
       ++p;
-      if (p == end) {
-        return STATUS(Corruption, StringPrintf("Encoded string ends with only one \\0x%02x ",
-                                               END_OF_STRING));
-      }
-      if (*p == END_OF_STRING) {
-        // Found two END_OF_STRING characters, this is the end of the encoded string.
-        ++p;
-        break;
-      }
-      if (*p == END_OF_STRING_ESCAPE) {
-        // Character END_OF_STRING is encoded as AB.
-        if (result != nullptr) {
-          result->push_back(END_OF_STRING ^ END_OF_STRING);
-        }
-        ++p;
-      } else {
-        return STATUS(Corruption, StringPrintf(
-            "Invalid sequence in encoded string: "
-            R"#(\0x%02x\0x%02x (must be either \0x%02x\0x%02x or \0x%02x\0x%02x))#",
-            END_OF_STRING, *p, END_OF_STRING, END_OF_STRING, END_OF_STRING, END_OF_STRING_ESCAPE));
-      }
-    } else {
+      break;
+    }
+    if (*p == END_OF_STRING_ESCAPE) {
+      // Character END_OF_STRING is encoded as AB.
       if (result != nullptr) {
-        result->push_back((*p) ^ END_OF_STRING);
+        result->push_back(END_OF_STRING ^ END_OF_STRING);
       }
       ++p;
+    } else {
+      return STATUS(Corruption, StringPrintf(
+          "Invalid sequence in encoded string: "
+          R"#(\0x%02x\0x%02x (must be either \0x%02x\0x%02x or \0x%02x\0x%02x))#",
+          END_OF_STRING, *p, END_OF_STRING, END_OF_STRING, END_OF_STRING, END_OF_STRING_ESCAPE));
     }
   }
-  if (result != nullptr) {
-    result->shrink_to_fit();
-  }
   slice->remove_prefix(p - slice->cdata());
   return Status::OK();
 }
@@ -24,19 +24,30 @@
 #include "yb/docdb/docdb.h"
 #include "yb/docdb/docdb-internal.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
+#include "yb/docdb/hot_keys.h"
 #include "yb/docdb/intent_aware_iterator.h"
 #include "yb/docdb/subdocument.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/rocksdb/db/compaction.h"
 #include "yb/rocksutil/yb_rocksdb.h"
+#include "yb/util/flag_tags.h"
 
 #include "yb/yql/pggate/util/pg_doc_data.h"
 
 using std::string;
 
+DEFINE_bool(use_table_tombstone_file_filter, true,
+            "Whether scans of a truncated colocated table skip SST files written before its table "
+            "tombstone.");
+TAG_FLAG(use_table_tombstone_file_filter, advanced);
+TAG_FLAG(use_table_tombstone_file_filter, runtime);
+
 namespace yb {
 namespace docdb {
 
+std::shared_ptr<rocksdb::ReadFileFilter> CreateTableTombstoneFileFilter(
+    const DocHybridTime& tombstone_time, std::shared_ptr<rocksdb::ReadFileFilter> base_filter);
+
 class ScanChoices {
  public:
   explicit ScanChoices(bool is_forward_scan) : is_forward_scan_(is_forward_scan) {}
@@ -556,16 +567,27 @@ Status DocRowwiseIterator::DoInit(const T& doc_spec) {
   VLOG(4) << "DocKey Bounds " << DocKey::DebugSliceToString(lower_doc_key.AsSlice())
           << ", " << DocKey::DebugSliceToString(upper_doc_key.AsSlice());
 
+  if (doc_db_.hot_keys && !lower_doc_key.empty()) {
+    doc_db_.hot_keys->Record(lower_doc_key.AsSlice());
+  }
+
   // TODO(bogdan): decide if this is a good enough heuristic for using blooms for scans.
   const bool is_fixed_point_get =
       !lower_doc_key.empty() &&
-      VERIFY_RESULT(HashedComponentsEqual(lower_doc_key, upper_doc_key));
+      VERIFY_RESULT(HashedComponentsEqual(lower_doc_key, upper_doc_key)) &&
+      BloomFilterCoversRange(doc_db_.regular, lower_doc_key.AsSlice(), upper_doc_key.AsSlice());
   const auto mode = is_fixed_point_get ? BloomFilterMode::USE_BLOOM_FILTER
                                        : BloomFilterMode::DONT_USE_BLOOM_FILTER;
 
+  auto file_filter = doc_spec.CreateFileFilter();
+  if (!is_fixed_point_get && schema_.has_pgtable_id() && FLAGS_use_table_tombstone_file_filter) {
+    file_filter = VERIFY_RESULT(AddTableTombstoneFileFilter(
+        doc_spec.QueryId(), std::move(file_filter)));
+  }
+
   db_iter_ = CreateIntentAwareIterator(
       doc_db_, mode, lower_doc_key.AsSlice(), doc_spec.QueryId(), txn_op_context_,
-      deadline_, read_time_, doc_spec.CreateFileFilter());
+      deadline_, read_time_, std::move(file_filter));
 
   row_ready_ = false;
 
@@ -599,6 +621,27 @@ Status DocRowwiseIterator::DoInit(const T& doc_spec) {
   return Status::OK();
 }
 
+Result<std::shared_ptr<rocksdb::ReadFileFilter>> DocRowwiseIterator::AddTableTombstoneFileFilter(
+    rocksdb::QueryId query_id, std::shared_ptr<rocksdb::ReadFileFilter> file_filter) {
+  // All rows of a truncated table, that are older than its tombstone, are deleted. So SST files
+  // with only such records could be skipped, instead of skipping their rows one by one until they
+  // are compacted away. The tombstone time is not cached for GetSubDocument, so the main iterator
+  // still sees the tombstone and accounts it for read restarts.
+  auto iter = CreateIntentAwareIterator(
+      doc_db_, BloomFilterMode::DONT_USE_BLOOM_FILTER, boost::none /* user_key_for_filter */,
+      query_id, txn_op_context_, deadline_, read_time_);
+  DocHybridTime max_overwrite_ht(DocHybridTime::kMin);
+  Expiration exp;
+  auto tombstone_time = VERIFY_RESULT(FindTableTombstoneTime(
+      DocKey(schema_).Encode().AsSlice(), iter.get(), &max_overwrite_ht, &exp));
+  // Don't rely on the tombstone when it is within the read restart window.
+  if (tombstone_time == DocHybridTime::kMin ||
+      (iter->max_seen_ht().is_valid() && iter->max_seen_ht() > read_time_.read)) {
+    return file_filter;
+  }
+  return CreateTableTombstoneFileFilter(tombstone_time, std::move(file_filter));
+}
+
 Status DocRowwiseIterator::Init(const common::QLScanSpec& spec) {
   return DoInit(dynamic_cast<const DocQLScanSpec&>(spec));
 }
@@ -705,6 +748,12 @@ Result<bool> DocRowwiseIterator::HasNext() const {
       // SubDocument.
     }
 
+    // Containers of the previous row were allocated from row_arena_, so the row should be destroyed
+    // before the arena is reset.
+    row_ = SubDocument(ValueType::kInvalid);
+    row_arena_.Reset();
+    SubDocumentArenaScope arena_scope(&row_arena_);
+
     GetSubDocumentData data = {
       sub_doc_key,
       &row_,
@@ -762,7 +811,7 @@ CHECKED_STATUS SetQLPrimaryKeyColumnValues(const Schema& schema,
     const auto ql_type = schema.column(j).type();
     QLTableColumn& column = table_row->AllocColumn(schema.column_id(j));
     RETURN_NOT_OK(decoder->DecodePrimitiveValue(&primitive_value));
-    PrimitiveValue::ToQLValuePB(primitive_value, ql_type, &column.value);
+    PrimitiveValue::ToQLValuePB(std::move(primitive_value), ql_type, &column.value);
   }
   return decoder->ConsumeGroupEnd();
 }
@@ -821,10 +870,11 @@ Status DocRowwiseIterator::DoNextRow(const Schema& projection, QLTableRow* table
   for (size_t i = projection.num_key_columns(); i < projection.num_columns(); i++) {
     const auto& column_id = projection.column_id(i);
     const auto ql_type = projection.column(i).type();
-    const SubDocument* column_value = row_.GetChild(PrimitiveValue(column_id));
+    SubDocument* column_value = row_.GetChild(PrimitiveValue(column_id));
     if (column_value != nullptr) {
       QLTableColumn& column = table_row->AllocColumn(column_id);
-      SubDocument::ToQLValuePB(*column_value, ql_type, &column.value);
+      // The row is rebuilt by the next HasNext() call, so column values could be moved out of it.
+      SubDocument::ToQLValuePB(std::move(*column_value), ql_type, &column.value);
       column.ttl_seconds = column_value->GetTtl();
       if (column_value->IsWriteTimeSet()) {
         column.write_time = column_value->GetWriteTime();
@@ -836,6 +886,22 @@ Status DocRowwiseIterator::DoNextRow(const Schema& projection, QLTableRow* table
   return Status::OK();
 }
 
+Result<size_t> DocRowwiseIterator::DoNextRowBatch(
+    const Schema& projection, size_t max_rows, std::vector<QLTableRow::SharedPtr>* rows,
+    std::vector<std::string>* row_keys) {
+  size_t num_rows = 0;
+  while (num_rows < max_rows && VERIFY_RESULT(DocRowwiseIterator::HasNext())) {
+    auto& row = *(*rows)[num_rows];
+    row.Clear();
+    RETURN_NOT_OK(DocRowwiseIterator::DoNextRow(projection, &row));
+    if (row_keys) {
+      (*row_keys)[num_rows].assign(row_key_.cdata(), row_key_.size());
+    }
+    ++num_rows;
+  }
+  return num_rows;
+}
+
 bool DocRowwiseIterator::LivenessColumnExists() const {
   const SubDocument* subdoc = row_.GetChild(
       PrimitiveValue::SystemColumnId(SystemColumnIds::kLivenessColumn));
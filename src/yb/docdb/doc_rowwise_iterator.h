@@ -103,6 +103,11 @@ class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
   // and without the cotable id.
   Result<Slice> GetTupleId() const override;
 
+  // Returns the serialized DocKey of the current row, including the cotable id.
+  Result<Slice> GetRowKey() const override {
+    return row_key_;
+  }
+
   // Seeks to the given tuple by its id. The tuple id should be the serialized DocKey and without
   // the cotable id.
   Result<bool> SeekTuple(const Slice& tuple_id) override;
@@ -114,6 +119,11 @@ class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
   template <class T>
   CHECKED_STATUS DoInit(const T& spec);
 
+  // Looks for the table tombstone of the colocated table and, when it is found, returns the filter
+  // that skips SST files written before it, on top of file_filter.
+  Result<std::shared_ptr<rocksdb::ReadFileFilter>> AddTableTombstoneFileFilter(
+      rocksdb::QueryId query_id, std::shared_ptr<rocksdb::ReadFileFilter> file_filter);
+
   Result<bool> InitScanChoices(
       const DocQLScanSpec& doc_spec, const KeyBytes& lower_doc_key, const KeyBytes& upper_doc_key);
 
@@ -157,6 +167,11 @@ class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
   // Read next row into a value map using the specified projection.
   CHECKED_STATUS DoNextRow(const Schema& projection, QLTableRow* table_row) override;
 
+  // Same as the default implementation, but avoids virtual dispatch for every row.
+  Result<size_t> DoNextRowBatch(const Schema& projection, size_t max_rows,
+                                std::vector<QLTableRow::SharedPtr>* rows,
+                                std::vector<std::string>* row_keys) override;
+
   const Schema& projection_;
   // Used to maintain ownership of projection_.
   // Separate field is used since ownership could be optional.
@@ -193,6 +208,10 @@ class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
   // Indicates whether we've already finished iterating.
   mutable bool done_;
 
+  // Object containers of row_ are allocated from this arena, which is reset for every row. Should be
+  // declared before row_, so it is destroyed after it.
+  mutable Arena row_arena_;
+
   // HasNext constructs the whole row's SubDocument.
   mutable SubDocument row_;
 
@@ -13,6 +13,8 @@
 
 #include "yb/docdb/doc_write_batch.h"
 
+#include <algorithm>
+
 #include "yb/docdb/doc_key.h"
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/write_batch.h"
@@ -587,6 +589,71 @@ Status DocWriteBatch::ReplaceInList(
   }
 }
 
+Status DocWriteBatch::RemoveFromCqlList(
+    const DocPath& doc_path,
+    const std::vector<PrimitiveValue>& values,
+    const ReadHybridTime& read_ht,
+    const CoarseTimePoint deadline,
+    const rocksdb::QueryId query_id,
+    MonoDelta default_ttl) {
+  if (values.empty()) {
+    return Status::OK();
+  }
+
+  SubDocKey sub_doc_key;
+  RETURN_NOT_OK(sub_doc_key.FromDocPath(doc_path));
+  KeyBytes list_prefix = sub_doc_key.Encode();
+
+  auto iter = yb::docdb::CreateIntentAwareIterator(
+      doc_db_,
+      BloomFilterMode::USE_BLOOM_FILTER,
+      list_prefix.AsSlice(),
+      query_id,
+      /*txn_op_context*/ boost::none,
+      deadline,
+      read_ht);
+
+  // Skip the init marker of the list, if it exists.
+  list_prefix.AppendValueType(ValueType::kArrayIndex);
+  iter->Seek(list_prefix.AsSlice());
+
+  // Elements are deleted after the scan, since writes modify key_prefix_.
+  std::vector<DocPath> removed_paths;
+  SubDocKey found_key;
+  FetchKeyResult key_data;
+  while (iter->valid() &&
+         (key_data = VERIFY_RESULT(iter->FetchKey())).key.starts_with(list_prefix.AsSlice())) {
+    MonoDelta entry_ttl;
+    ValueType value_type;
+    Slice value_slice = iter->value();
+    RETURN_NOT_OK(Value::DecodePrimitiveValueType(value_slice, &value_type, nullptr, &entry_ttl));
+
+    bool has_expired = value_type == ValueType::kTombstone;
+    if (!has_expired) {
+      entry_ttl = ComputeTTL(entry_ttl, default_ttl);
+      RETURN_NOT_OK(HasExpiredTTL(
+          key_data.write_time.hybrid_time(), entry_ttl, read_ht.read, &has_expired));
+    }
+
+    if (!has_expired) {
+      Value value;
+      RETURN_NOT_OK(value.Decode(iter->value()));
+      if (std::find(values.begin(), values.end(), value.primitive_value()) != values.end()) {
+        RETURN_NOT_OK(found_key.FullyDecodeFrom(key_data.key, HybridTimeRequired::kFalse));
+        removed_paths.push_back(doc_path);
+        removed_paths.back().AddSubKey(found_key.subkeys()[sub_doc_key.num_subkeys()]);
+      }
+    }
+
+    iter->SeekPastSubKey(key_data.key);
+  }
+
+  for (const auto& removed_path : removed_paths) {
+    RETURN_NOT_OK(DeleteSubDoc(removed_path, read_ht, deadline, query_id));
+  }
+  return Status::OK();
+}
+
 void DocWriteBatch::Clear() {
   put_batch_.clear();
   cache_.Clear();
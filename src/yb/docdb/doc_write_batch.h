@@ -178,6 +178,16 @@ class DocWriteBatch {
                          default_ttl, write_ttl, /* is_cql */ true);
   }
 
+  // Deletes the elements of the CQL list that are equal to any of the values. Expired and deleted
+  // elements are skipped, the other elements are kept as is.
+  CHECKED_STATUS RemoveFromCqlList(
+      const DocPath& doc_path,
+      const std::vector<PrimitiveValue>& values,
+      const ReadHybridTime& read_ht,
+      const CoarseTimePoint deadline,
+      const rocksdb::QueryId query_id,
+      MonoDelta default_ttl = Value::kMaxTtl);
+
   CHECKED_STATUS DeleteSubDoc(
       const DocPath& doc_path,
       const ReadHybridTime& read_ht = ReadHybridTime::Max(),
@@ -17,6 +17,7 @@
 #include <string>
 
 #include "yb/rocksdb/db.h"
+#include "yb/rocksdb/db/compaction.h"
 #include "yb/rocksdb/db/db_impl.h"
 #include "yb/rocksdb/db/version_set.h"
 #include "yb/rocksdb/db/writebuffer.h"
@@ -29,6 +30,8 @@
 #include "yb/docdb/docdb_test_util.h"
 #include "yb/docdb/in_mem_docdb.h"
 #include "yb/docdb/intent.h"
+#include "yb/docdb/operation_cost.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/gutil/stringprintf.h"
 #include "yb/rocksutil/yb_rocksdb.h"
 #include "yb/tablet/tablet_options.h"
@@ -61,6 +64,7 @@ using rocksdb::WriteOptions;
 using namespace std::chrono_literals;
 
 DECLARE_bool(use_docdb_aware_bloom_filter);
+DECLARE_bool(rocksdb_hybrid_compaction);
 DECLARE_int32(max_nexts_to_avoid_seek);
 DECLARE_bool(docdb_sort_weak_intents_in_tests);
 
@@ -73,6 +77,8 @@ CHECKED_STATUS GetPrimitiveValue(const rocksdb::UserBoundaryValues &values,
     size_t index,
     PrimitiveValue *out);
 CHECKED_STATUS GetDocHybridTime(const rocksdb::UserBoundaryValues &values, DocHybridTime *out);
+std::shared_ptr<rocksdb::ReadFileFilter> CreateKeyBoundsFileFilter(
+    const KeyBounds* key_bounds, std::shared_ptr<rocksdb::ReadFileFilter> base_filter);
 
 YB_STRONGLY_TYPED_BOOL(InitMarkerExpired);
 YB_STRONGLY_TYPED_BOOL(UseIntermediateFlushes);
@@ -952,6 +958,39 @@ SubDocKey(DocKey([], ["list_test", 231]), ["other"; \
         )#");
 }
 
+TEST_F(DocDBTest, ListRemoveTest) {
+  DocKey doc_key(PrimitiveValues("list_test", 231));
+  KeyBytes encoded_doc_key = doc_key.Encode();
+  const DocPath list_path(encoded_doc_key, PrimitiveValue("list"));
+  ASSERT_OK(ExtendList(
+      list_path,
+      SubDocument({PrimitiveValue(1), PrimitiveValue(2), PrimitiveValue(3), PrimitiveValue(2)},
+                  ListExtendOrder::APPEND),
+      HybridTime(100)));
+  ASSERT_OK(DeleteSubDoc(DocPath(encoded_doc_key, PrimitiveValue("list"),
+                                 PrimitiveValue::ArrayIndex(4)),
+                         HybridTime(200)));
+
+  ReadHybridTime read_ht;
+  read_ht.read = HybridTime(250);
+  auto dwb = MakeDocWriteBatch();
+  ASSERT_OK(dwb.RemoveFromCqlList(list_path, {PrimitiveValue(2), PrimitiveValue(5)}, read_ht,
+                                  CoarseTimePoint::max(), rocksdb::kDefaultQueryId));
+  // The element that is already deleted is not deleted again.
+  ASSERT_EQ(dwb.size(), 1);
+  ASSERT_OK(WriteToRocksDB(dwb, HybridTime(300)));
+
+  VerifySubDocument(SubDocKey(doc_key), HybridTime(350),
+      R"#(
+  {
+    "list": {
+      ArrayIndex(1): 1,
+      ArrayIndex(3): 3
+    }
+  }
+        )#");
+}
+
 TEST_F(DocDBTest, ExpiredValueCompactionTest) {
   const DocKey doc_key(PrimitiveValues("k1"));
   const MonoDelta one_ms = 1ms;
@@ -2189,6 +2228,184 @@ SubDocKey(DocKey([], ["k"]), [HT{ physical: 6000 }]) -> "v6"  // file 11
       )#");
 }
 
+TEST_F(DocDBTest, CompactionOfEntriesAfterHistoryCutoff) {
+  ASSERT_OK(DisableCompactions());
+  const DocKey doc_key(PrimitiveValues("k"));
+  KeyBytes encoded_doc_key(doc_key.Encode());
+  for (int i = 3; i <= 5; ++i) {
+    PrimitiveValue pv = i == 4 ? PrimitiveValue::kTombstone : PrimitiveValue(Format("v$0", i));
+    ASSERT_OK(SetPrimitive(
+        DocPath(encoded_doc_key), Value(pv), HybridTime::FromMicros(i * 1000)));
+    ASSERT_OK(FlushRocksDbAndWait());
+  }
+
+  auto min_hybrid_times = [this]() -> Result<std::vector<MicrosTime>> {
+    rocksdb::TablePropertiesCollection props;
+    RETURN_NOT_OK(rocksdb()->GetPropertiesOfAllTables(&props));
+    std::vector<MicrosTime> result;
+    for (const auto& file_and_props : props) {
+      auto min_hybrid_time = MinHybridTimeFromTableProperties(*file_and_props.second);
+      result.push_back(min_hybrid_time.GetPhysicalValueMicros());
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  };
+  ASSERT_EQ((std::vector<MicrosTime>{3000, 4000, 5000}), ASSERT_RESULT(min_hybrid_times()));
+
+  // All entries are newer than the history cutoff, so they are kept, including the tombstone.
+  FullyCompactHistoryBefore(2000_usec_ht);
+  ASSERT_EQ(1, NumSSTableFiles());
+  ASSERT_EQ((std::vector<MicrosTime>{3000}), ASSERT_RESULT(min_hybrid_times()));
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(
+      R"#(
+SubDocKey(DocKey([], ["k"]), [HT{ physical: 5000 }]) -> "v5"
+SubDocKey(DocKey([], ["k"]), [HT{ physical: 4000 }]) -> DEL
+SubDocKey(DocKey([], ["k"]), [HT{ physical: 3000 }]) -> "v3"
+      )#");
+
+  FullyCompactHistoryBefore(4500_usec_ht);
+  ASSERT_EQ((std::vector<MicrosTime>{5000}), ASSERT_RESULT(min_hybrid_times()));
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(
+      R"#(
+SubDocKey(DocKey([], ["k"]), [HT{ physical: 5000 }]) -> "v5"
+      )#");
+}
+
+TEST_F(DocDBTest, HybridCompaction) {
+  FLAGS_rocksdb_hybrid_compaction = true;
+  ASSERT_OK(ReinitDBOptions());
+  const KeyBytes encoded_k1(DocKey(PrimitiveValues("k1")).Encode());
+  const KeyBytes encoded_k2(DocKey(PrimitiveValues("k2")).Encode());
+  ASSERT_OK(SetPrimitive(DocPath(encoded_k1), Value(PrimitiveValue("v1")), 1000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+  ASSERT_OK(SetPrimitive(DocPath(encoded_k1), Value(PrimitiveValue::kTombstone), 2000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+  ASSERT_OK(SetPrimitive(DocPath(encoded_k2), Value(PrimitiveValue("v2")), 3000_usec_ht));
+
+  // Compaction into the bottommost level is major, so the tombstone is removed.
+  FullyCompactHistoryBefore(2500_usec_ht);
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(
+      R"#(
+SubDocKey(DocKey([], ["k2"]), [HT{ physical: 3000 }]) -> "v2"
+      )#");
+
+  rocksdb::ColumnFamilyMetaData cf_meta;
+  rocksdb()->GetColumnFamilyMetaData(&cf_meta);
+  ASSERT_GT(cf_meta.levels.size(), 1);
+  ASSERT_EQ(0, cf_meta.levels[0].files.size());
+  ASSERT_EQ(1, cf_meta.levels.back().files.size());
+}
+
+TEST_F(DocDBTest, ExpiredFilesByTableTTL) {
+  struct TestFile {
+    std::shared_ptr<rocksdb::TableProperties> properties;
+    ConsensusFrontier largest;
+  };
+  auto make_file = [](MicrosTime max_micros, MonoDelta value_ttl) {
+    DocDBTablePropertiesCollectorFactory collector_factory;
+    std::unique_ptr<rocksdb::TablePropertiesCollector> collector(
+        collector_factory.CreateTablePropertiesCollector({}));
+    const DocKey doc_key(PrimitiveValues("k"));
+    for (auto micros : {max_micros, max_micros / 2}) {
+      auto key = SubDocKey(doc_key, HybridTime::FromMicros(micros)).Encode();
+      auto value = Value(PrimitiveValue(std::string("v")), value_ttl).Encode();
+      CHECK_OK(collector->AddUserKey(key.AsSlice(), value, rocksdb::kEntryPut, 0, 0));
+    }
+    TestFile result;
+    result.properties = std::make_shared<rocksdb::TableProperties>();
+    CHECK_OK(collector->Finish(&result.properties->user_collected_properties));
+    result.largest.set_hybrid_time(HybridTime::FromMicros(max_micros));
+    return result;
+  };
+  auto infos = [](const std::vector<TestFile>& files) {
+    std::vector<rocksdb::FileExpirationInfo> result;
+    for (const auto& file : files) {
+      result.push_back({file.properties.get(), &file.largest});
+    }
+    return result;
+  };
+
+  auto policy = std::make_shared<ManualHistoryRetentionPolicy>();
+  policy->SetHistoryCutoff(HybridTime::FromMicros(100000000));
+  DocDBCompactionFilterFactory factory(policy, &KeyBounds::kNoBounds);
+
+  std::vector<TestFile> files = {
+      make_file(50000000, Value::kMaxTtl),
+      make_file(80000000, Value::kMaxTtl),
+      make_file(60000000, Value::kMaxTtl),
+  };
+  // No table TTL.
+  ASSERT_TRUE(factory.ExpiredFiles(infos(files)).empty());
+
+  policy->SetTableTTLForTests(MonoDelta::FromSeconds(30));
+  ASSERT_EQ((std::vector<size_t>{0, 2}), factory.ExpiredFiles(infos(files)));
+
+  // Entries with their own TTL could outlive entries of expired files, that hide them.
+  files.push_back(make_file(10000000, MonoDelta::FromSeconds(1000)));
+  ASSERT_TRUE(factory.ExpiredFiles(infos(files)).empty());
+}
+
+namespace {
+
+class RejectAllFileFilter : public rocksdb::ReadFileFilter {
+ public:
+  bool Filter(const rocksdb::FdWithBoundaries&) const override {
+    return false;
+  }
+};
+
+} // namespace
+
+TEST_F(DocDBTest, KeyBoundsFileFilter) {
+  rocksdb::Arena arena;
+  auto encode = [](const std::string& key) {
+    return DocKey(PrimitiveValues(key)).Encode();
+  };
+  auto internal_key = [](const std::string& key) {
+    auto sub_doc_key = SubDocKey(DocKey(PrimitiveValues(key)), HybridTime::FromMicros(1000));
+    return rocksdb::InternalKey(sub_doc_key.Encode().AsSlice(), 1, rocksdb::kTypeValue);
+  };
+  auto make_file = [&arena, &internal_key](const std::string& smallest,
+                                           const std::string& largest) {
+    rocksdb::FileMetaData meta;
+    meta.smallest.key = internal_key(smallest);
+    meta.largest.key = internal_key(largest);
+    return rocksdb::FdWithBoundaries(&arena, meta);
+  };
+
+  // Child tablet of a split, that owns keys in [d, m).
+  KeyBounds bounds(encode("d").AsSlice(), encode("m").AsSlice());
+  auto filter = CreateKeyBoundsFileFilter(&bounds, nullptr);
+  // Parent files fully outside of bounds are skipped.
+  ASSERT_FALSE(filter->Filter(make_file("a", "c")));
+  ASSERT_FALSE(filter->Filter(make_file("m", "p")));
+  ASSERT_FALSE(filter->Filter(make_file("n", "z")));
+  // Files that straddle the boundary, or are within bounds, are still read.
+  ASSERT_TRUE(filter->Filter(make_file("a", "d")));
+  ASSERT_TRUE(filter->Filter(make_file("a", "e")));
+  ASSERT_TRUE(filter->Filter(make_file("k", "p")));
+  ASSERT_TRUE(filter->Filter(make_file("a", "z")));
+  ASSERT_TRUE(filter->Filter(make_file("e", "k")));
+
+  // Decision about files within bounds is delegated to the base filter.
+  auto chained_filter = CreateKeyBoundsFileFilter(
+      &bounds, std::make_shared<RejectAllFileFilter>());
+  ASSERT_FALSE(chained_filter->Filter(make_file("e", "k")));
+
+  // First and last children of a split have only one bound.
+  KeyBounds lower_only(encode("m").AsSlice(), Slice());
+  auto lower_filter = CreateKeyBoundsFileFilter(&lower_only, nullptr);
+  ASSERT_FALSE(lower_filter->Filter(make_file("a", "c")));
+  ASSERT_TRUE(lower_filter->Filter(make_file("k", "p")));
+  ASSERT_TRUE(lower_filter->Filter(make_file("n", "z")));
+
+  KeyBounds upper_only(Slice(), encode("d").AsSlice());
+  auto upper_filter = CreateKeyBoundsFileFilter(&upper_only, nullptr);
+  ASSERT_TRUE(upper_filter->Filter(make_file("a", "c")));
+  ASSERT_TRUE(upper_filter->Filter(make_file("a", "e")));
+  ASSERT_FALSE(upper_filter->Filter(make_file("n", "z")));
+}
+
 TEST_F(DocDBTest, BasicTest) {
   // A few points to make it easier to understand the expected binary representations here:
   // - Initial bytes such as 'S' (kString), 'I' (kInt64) correspond to members of the enum
@@ -2675,6 +2892,73 @@ TEST_F(DocDBTest, MergingIterator) {
   VerifySubDocument(SubDocKey(key2), ht, "\"value2\"");
 }
 
+TEST_F(DocDBTest, HybridTimeFileFilter) {
+  DocKey key(0, PrimitiveValues("key"), PrimitiveValues());
+  auto dwb = MakeDocWriteBatch();
+  ASSERT_OK(dwb.SetPrimitive(DocPath(key.Encode()), PrimitiveValue("value1")));
+  ASSERT_OK(WriteToRocksDB(dwb, 1000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+  dwb.Clear();
+  ASSERT_OK(dwb.SetPrimitive(DocPath(key.Encode()), PrimitiveValue("value2")));
+  ASSERT_OK(WriteToRocksDB(dwb, 3000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+
+  auto get_doc = [this, &key](const ReadHybridTime& read_time) -> Result<std::string> {
+    auto encoded_subdoc_key = SubDocKey(key).EncodeWithoutHt();
+    SubDocument doc;
+    bool found = false;
+    GetSubDocumentData data = { encoded_subdoc_key, &doc, &found };
+    RETURN_NOT_OK(GetSubDocument(
+        doc_db(), data, rocksdb::kDefaultQueryId, boost::none /* txn_op_context */,
+        CoarseTimePoint::max() /* deadline */, read_time));
+    return found ? doc.ToString() : "NOT_FOUND";
+  };
+  auto num_iterators = [this] {
+    return options().statistics->getTickerCount(rocksdb::NO_TABLE_CACHE_ITERATORS);
+  };
+
+  // The file written at 3000 is newer than the read time limit, so it should be skipped.
+  auto iterators_before = num_iterators();
+  ASSERT_EQ("\"value1\"", ASSERT_RESULT(get_doc(ReadHybridTime::SingleTime(2000_usec_ht))));
+  ASSERT_EQ(iterators_before + 1, num_iterators());
+
+  // The file is within the read restart window, so it should still be read.
+  iterators_before = num_iterators();
+  ASSERT_EQ("\"value1\"", ASSERT_RESULT(get_doc(ReadHybridTime{
+      2000_usec_ht, 2000_usec_ht, 3000_usec_ht, HybridTime::kMax, 0})));
+  ASSERT_EQ(iterators_before + 2, num_iterators());
+
+  iterators_before = num_iterators();
+  ASSERT_EQ("\"value2\"", ASSERT_RESULT(get_doc(ReadHybridTime::Max())));
+  ASSERT_EQ(iterators_before + 2, num_iterators());
+}
+
+TEST_F(DocDBTest, OperationCost) {
+  constexpr uint64_t kNumKeys = 10;
+  auto dwb = MakeDocWriteBatch();
+  for (uint64_t i = 0; i != kNumKeys; ++i) {
+    DocKey key(0, PrimitiveValues(Format("key$0", i)), PrimitiveValues());
+    ASSERT_OK(dwb.SetPrimitive(DocPath(key.Encode()), PrimitiveValue("value")));
+  }
+  ASSERT_OK(WriteToRocksDB(dwb, 1000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+
+  auto start = OperationCost::Current();
+  std::unique_ptr<rocksdb::Iterator> iter(rocksdb()->NewIterator(rocksdb::ReadOptions()));
+  uint64_t num_entries = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    ++num_entries;
+  }
+  auto cost = OperationCost::Current() - start;
+  LOG(INFO) << "Cost: " << cost.ToString();
+
+  ASSERT_EQ(kNumKeys, num_entries);
+  ASSERT_EQ(1U, cost.seeks);
+  ASSERT_EQ(kNumKeys, cost.nexts);
+  ASSERT_GT(cost.block_cache_hits + cost.blocks_read, 0U);
+  ASSERT_EQ(0U, cost.intents_examined);
+}
+
 TEST_F(DocDBTest, SetPrimitiveWithInitMarker) {
   // Both required and optional init marker should be ok.
   for (auto init_marker_behavior : kInitMarkerBehaviorList) {
@@ -2772,6 +3056,43 @@ SubDocKey(DocKey([], ["row2", 22222]), [ColumnId(10); HT{ physical: 2000 w: 1 }]
   }
 }
 
+// A single column of a packed row is not stored under its own key, so it should be read from the
+// packed row, unless the column was written after the row.
+TEST_F(DocDBTest, PackedRowColumn) {
+  const DocKey doc_key(PrimitiveValues("row1"));
+  const KeyBytes encoded_doc_key = doc_key.Encode();
+  auto column_path = [&encoded_doc_key](int32_t column_id) {
+    return DocPath(encoded_doc_key, PrimitiveValue(ColumnId(column_id)));
+  };
+  auto column_key = [&doc_key](int32_t column_id) {
+    return SubDocKey(doc_key, PrimitiveValue(ColumnId(column_id)));
+  };
+
+  PackedRowBuilder packed_row;
+  packed_row.AddColumn(
+      PrimitiveValue::SystemColumnId(SystemColumnIds::kLivenessColumn), PrimitiveValue());
+  packed_row.AddColumn(PrimitiveValue(ColumnId(10)), PrimitiveValue("a1"));
+  packed_row.AddColumn(PrimitiveValue(ColumnId(20)), PrimitiveValue("b1"));
+  packed_row.AddColumn(PrimitiveValue(ColumnId(30)), PrimitiveValue("c1"));
+
+  ASSERT_OK(SetPrimitive(column_path(40), Value(PrimitiveValue("d0")), 1000_usec_ht));
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key), Value(packed_row.Build()), 2000_usec_ht));
+  ASSERT_OK(SetPrimitive(column_path(20), Value(PrimitiveValue("b2")), 3000_usec_ht));
+  ASSERT_OK(SetPrimitive(column_path(30), Value(PrimitiveValue::kTombstone), 3000_usec_ht));
+
+  VerifySubDocument(column_key(10), 4000_usec_ht, "\"a1\"");
+  VerifySubDocument(column_key(20), 4000_usec_ht, "\"b2\"");
+  VerifySubDocument(column_key(30), 4000_usec_ht, "");
+  // Packed row overwrites columns written before it, even if it does not contain them.
+  VerifySubDocument(column_key(40), 4000_usec_ht, "");
+
+  VerifySubDocument(column_key(20), 2500_usec_ht, "\"b1\"");
+  VerifySubDocument(column_key(30), 2500_usec_ht, "\"c1\"");
+
+  VerifySubDocument(column_key(10), 1500_usec_ht, "");
+  VerifySubDocument(column_key(40), 1500_usec_ht, "\"d0\"");
+}
+
 TEST_F(DocDBTest, StaticColumnCompaction) {
   const DocKey hk(0, PrimitiveValues("h1")); // hash key
   const DocKey pk1(hk.hash(), hk.hashed_group(), PrimitiveValues("r1")); // primary key
@@ -2873,6 +3194,72 @@ SubDocKey(DocKey(0x0000, ["h1"], ["r2"]), ["c8"; HT{ physical: 1000 }]) -> "v82"
       )#");
 }
 
+TEST_F(DocDBTest, CounterDeltas) {
+  const DocKey doc_key(PrimitiveValues("k"));
+  const KeyBytes encoded_doc_key(doc_key.Encode());
+  const DocPath counter_path(encoded_doc_key, PrimitiveValue("c"));
+  const auto counter_delta = [](int64_t delta) {
+    return Value(PrimitiveValue(delta), Value::kMaxTtl, Value::kInvalidUserTimestamp,
+                 Value::kCounterDeltaFlag);
+  };
+
+  ASSERT_OK(SetPrimitive(counter_path, counter_delta(5), 1000_usec_ht));
+  ASSERT_OK(SetPrimitive(counter_path, Value(PrimitiveValue(static_cast<int64_t>(10))),
+                         2000_usec_ht));
+  ASSERT_OK(SetPrimitive(counter_path, counter_delta(3), 3000_usec_ht));
+  ASSERT_OK(SetPrimitive(counter_path, counter_delta(-1), 4000_usec_ht));
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key), Value(PrimitiveValue::kTombstone),
+                         5000_usec_ht));
+  ASSERT_OK(SetPrimitive(counter_path, counter_delta(7), 6000_usec_ht));
+
+  VerifySubDocument(SubDocKey(doc_key), 1500_usec_ht, R"#(
+{
+  "c": 5
+}
+      )#");
+  VerifySubDocument(SubDocKey(doc_key), 2500_usec_ht, R"#(
+{
+  "c": 10
+}
+      )#");
+  VerifySubDocument(SubDocKey(doc_key), 3500_usec_ht, R"#(
+{
+  "c": 13
+}
+      )#");
+  VerifySubDocument(SubDocKey(doc_key), 4500_usec_ht, R"#(
+{
+  "c": 12
+}
+      )#");
+  VerifySubDocument(SubDocKey(doc_key), 5500_usec_ht, "");
+  VerifySubDocument(SubDocKey(doc_key), 6500_usec_ht, R"#(
+{
+  "c": 7
+}
+      )#");
+
+  // The delta overwritten by the full value written at 2000 is removed, the other deltas are kept.
+  FullyCompactHistoryBefore(2500_usec_ht);
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(R"#(
+SubDocKey(DocKey([], ["k"]), [HT{ physical: 5000 }]) -> DEL
+SubDocKey(DocKey([], ["k"]), ["c"; HT{ physical: 6000 }]) -> 7; merge flags: 2
+SubDocKey(DocKey([], ["k"]), ["c"; HT{ physical: 4000 }]) -> -1; merge flags: 2
+SubDocKey(DocKey([], ["k"]), ["c"; HT{ physical: 3000 }]) -> 3; merge flags: 2
+SubDocKey(DocKey([], ["k"]), ["c"; HT{ physical: 2000 }]) -> 10
+      )#");
+  VerifySubDocument(SubDocKey(doc_key), 3500_usec_ht, R"#(
+{
+  "c": 13
+}
+      )#");
+  VerifySubDocument(SubDocKey(doc_key), 6500_usec_ht, R"#(
+{
+  "c": 7
+}
+      )#");
+}
+
 TEST_F(DocDBTest, TestUserTimestamp) {
   const DocKey doc_key(PrimitiveValues("k1"));
   KeyBytes encoded_doc_key(doc_key.Encode());
@@ -18,6 +18,8 @@
 #include <unordered_map>
 #include <vector>
 
+#include <boost/optional.hpp>
+
 #include "yb/common/hybrid_time.h"
 #include "yb/common/redis_protocol.pb.h"
 #include "yb/common/row_mark.h"
@@ -34,6 +36,7 @@
 #include "yb/docdb/docdb_util.h"
 #include "yb/docdb/intent.h"
 #include "yb/docdb/intent_aware_iterator.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/pgsql_operation.h"
 #include "yb/docdb/shared_lock_manager.h"
 #include "yb/docdb/subdocument.h"
@@ -81,6 +84,12 @@ DEFINE_bool(enable_transaction_sealing, false,
             "Whether transaction sealing is enabled.");
 DEFINE_test_flag(bool, TEST_fail_on_replicated_batch_idx_set_in_txn_record, false,
                  "Fail when a set of replicated batch indexes is found in txn record.");
+DEFINE_int32(txn_apply_batch_max_records, 0,
+             "Max number of regular records in a single RocksDB write batch while applying "
+             "intents of a committed transaction, 0 means no limit. Bounds the memtable write "
+             "size and the memory used by the batch for large transactions.");
+TAG_FLAG(txn_apply_batch_max_records, advanced);
+TAG_FLAG(txn_apply_batch_max_records, runtime);
 
 namespace yb {
 namespace docdb {
@@ -315,6 +324,18 @@ Result<PrepareDocWriteOperationResult> PrepareDocWriteOperation(
   return result;
 }
 
+Result<bool> ReadConflictsWithLockedWrites(
+    const google::protobuf::RepeatedPtrField<KeyValuePairPB>& read_pairs,
+    PartialRangeKeyIntents partial_range_key_intents,
+    SharedLockManager* lock_manager) {
+  auto determine_keys_to_lock_result = VERIFY_RESULT(DetermineKeysToLock(
+      {} /* doc_write_ops */, read_pairs, IsolationLevel::SERIALIZABLE_ISOLATION,
+      OperationKind::kRead, RowMarkType::ROW_MARK_ABSENT, /* transactional_table */ true,
+      partial_range_key_intents));
+  FilterKeysToLock(&determine_keys_to_lock_result.lock_batch);
+  return lock_manager->HasConflictingLocks(determine_keys_to_lock_result.lock_batch);
+}
+
 Status SetDocOpQLErrorResponse(DocOperation* doc_op, string err_msg) {
   switch (doc_op->OpType()) {
     case DocOperation::Type::QL_WRITE_OPERATION: {
@@ -780,6 +801,74 @@ void SeekToLowerBound(const SliceKeyBound& lower_bound, IntentAwareIterator* ite
   }
 }
 
+// Fills in the column attributes (TTL and write time) of a primitive value written at write_time.
+void SetTtlAndWriteTime(
+    const Expiration& exp, HybridTime read_time, const DocHybridTime& write_time,
+    UserTimeMicros user_timestamp, PrimitiveValue* value) {
+  // TODO: the ttl_seconds in primitive value is currently only in use for CQL. At some
+  // point streamline by refactoring CQL to use the mutable Expiration in GetSubDocumentData.
+  if (exp.ttl == Value::kMaxTtl) {
+    value->SetTtl(-1);
+  } else {
+    int64_t time_since_write_seconds = (
+        server::HybridClock::GetPhysicalValueMicros(read_time) -
+        server::HybridClock::GetPhysicalValueMicros(write_time.hybrid_time())) /
+        MonoTime::kMicrosecondsPerSecond;
+    int64_t ttl_seconds = std::max(static_cast<int64_t>(0),
+        exp.ttl.ToMilliseconds() /
+        MonoTime::kMillisecondsPerSecond - time_since_write_seconds);
+    value->SetTtl(ttl_seconds);
+  }
+  // Choose the user supplied timestamp if present.
+  value->SetWriteTime(
+      user_timestamp == Value::kInvalidUserTimestamp
+      ? write_time.hybrid_time().GetPhysicalValueMicros()
+      : user_timestamp);
+}
+
+// Decodes the packed row stored in row_value and adds its columns as children of result, skipping
+// the columns filtered out by the subkey bounds of data.
+CHECKED_STATUS AddPackedColumns(
+    const Value& row_value, const GetSubDocumentData& data, HybridTime read_time,
+    const DocHybridTime& write_time, SubDocument* result) {
+  PackedRowDecoder decoder;
+  RETURN_NOT_OK(decoder.Init(row_value.primitive_value().GetPackedRow()));
+  KeyBytes column_key(data.subdocument_key);
+  const size_t subdocument_key_size = column_key.size();
+  for (size_t i = 0; i != decoder.num_columns(); ++i) {
+    column_key.Truncate(subdocument_key_size);
+    column_key.AppendRawBytes(decoder.column(i).subkey);
+    if (!data.low_subkey->CanInclude(column_key.AsSlice()) ||
+        !data.high_subkey->CanInclude(column_key.AsSlice())) {
+      continue;
+    }
+    if (data.count_only) {
+      data.record_count++;
+      continue;
+    }
+    PrimitiveValue subkey;
+    PrimitiveValue value;
+    RETURN_NOT_OK(decoder.DecodeColumn(i, &subkey, &value));
+    SetTtlAndWriteTime(data.exp, read_time, write_time, row_value.user_timestamp(), &value);
+    result->SetChild(subkey, SubDocument(std::move(value)));
+  }
+  return Status::OK();
+}
+
+// Removes the packed column at key from result when a later write at that column turned out to
+// hide it, e.g. a tombstone written after the row was packed.
+CHECKED_STATUS RemoveOverwrittenPackedColumn(
+    const Slice& key, const GetSubDocumentData& data) {
+  Slice temp = key;
+  temp.remove_prefix(data.subdocument_key.size());
+  PrimitiveValue child;
+  RETURN_NOT_OK(child.DecodeFromKey(&temp));
+  if (temp.empty() && IsObjectType(data.result->value_type())) {
+    data.result->DeleteChild(child);
+  }
+  return Status::OK();
+}
+
 // This function does not assume that object init_markers are present. If no init marker is present,
 // or if a tombstone is found at some level, it still looks for subkeys inside it if they have
 // larger timestamps.
@@ -802,6 +891,8 @@ CHECKED_STATUS BuildSubDocument(
     int64* num_values_observed) {
   VLOG(3) << "BuildSubDocument data: " << data << " read_time: " << iter->read_time()
           << " low_ts: " << low_ts;
+  // Whether the children of the result were populated from a packed row.
+  bool packed_row_found = false;
   while (iter->valid()) {
     if (data.deadline_info && data.deadline_info->CheckAndSetDeadlinePassed()) {
       return STATUS(Expired, "Deadline for query passed.");
@@ -866,6 +957,21 @@ CHECKED_STATUS BuildSubDocument(
         value_type = ValueType::kTombstone;
       }
 
+      if (value_type == ValueType::kPackedRow) {
+        // A packed row is a full row version, so it overwrites everything written to the row
+        // before it. Columns written after it are merged in by the code below.
+        if (low_ts < write_time) {
+          low_ts = write_time;
+        }
+        *data.result = SubDocument();
+        RETURN_NOT_OK(AddPackedColumns(
+            doc_value, data, iter->read_time().read, write_time, data.result));
+        packed_row_found = true;
+        VLOG(3) << "SeekPastSubKey: " << SubDocKey::DebugSliceToString(key);
+        iter->SeekPastSubKey(key);
+        continue;
+      }
+
       const bool is_collection = IsCollectionType(value_type);
       // We have found some key that matches our entire subdocument_key, i.e. we didn't skip ahead
       // to a lower level key (with optional object init markers).
@@ -875,6 +981,10 @@ CHECKED_STATUS BuildSubDocument(
         }
         if (is_collection) {
           *data.result = SubDocument(value_type);
+        } else {
+          // The caller could have pre-populated the result with a packed column value that this
+          // tombstone overwrites.
+          *data.result = SubDocument(ValueType::kInvalid);
         }
 
         // If the subkey lower bound filters out the key we found, we want to skip to the lower
@@ -894,32 +1004,21 @@ CHECKED_STATUS BuildSubDocument(
           return STATUS_FORMAT(Corruption,
               "Expected primitive value type, got $0", value_type);
         }
-        // TODO: the ttl_seconds in primitive value is currently only in use for CQL. At some
-        // point streamline by refactoring CQL to use the mutable Expiration in GetSubDocumentData.
-        if (data.exp.ttl == Value::kMaxTtl) {
-          doc_value.mutable_primitive_value()->SetTtl(-1);
-        } else {
-          int64_t time_since_write_seconds = (
-              server::HybridClock::GetPhysicalValueMicros(iter->read_time().read) -
-              server::HybridClock::GetPhysicalValueMicros(write_time.hybrid_time())) /
-              MonoTime::kMicrosecondsPerSecond;
-          int64_t ttl_seconds = std::max(static_cast<int64_t>(0),
-              data.exp.ttl.ToMilliseconds() /
-              MonoTime::kMillisecondsPerSecond - time_since_write_seconds);
-          doc_value.mutable_primitive_value()->SetTtl(ttl_seconds);
+        if (doc_value.merge_flags() == Value::kCounterDeltaFlag) {
+          // Counter deltas are resolved by adding the older deltas and the counter value before
+          // them.
+          const auto older_sum = VERIFY_RESULT(iter->SumOlderCounterRecords(key, low_ts));
+          *doc_value.mutable_primitive_value() =
+              PrimitiveValue(doc_value.primitive_value().GetInt64() + older_sum);
         }
-        // Choose the user supplied timestamp if present.
-        const UserTimeMicros user_timestamp = doc_value.user_timestamp();
-        doc_value.mutable_primitive_value()->SetWriteTime(
-            user_timestamp == Value::kInvalidUserTimestamp
-            ? write_time.hybrid_time().GetPhysicalValueMicros()
-            : doc_value.user_timestamp());
+        SetTtlAndWriteTime(data.exp, iter->read_time().read, write_time,
+                           doc_value.user_timestamp(), doc_value.mutable_primitive_value());
         if (!data.high_index->CanInclude(current_values_observed)) {
           iter->SeekOutOfSubDoc(&key_copy);
           return Status::OK();
         }
         if (data.low_index->CanInclude(*num_values_observed)) {
-          *data.result = SubDocument(doc_value.primitive_value());
+          *data.result = SubDocument(std::move(*doc_value.mutable_primitive_value()));
         }
         (*num_values_observed)++;
         VLOG(3) << "SeekOutOfSubDoc: " << SubDocKey::DebugSliceToString(key);
@@ -939,6 +1038,9 @@ CHECKED_STATUS BuildSubDocument(
     }
     if (descendant.value_type() == ValueType::kInvalid) {
       // The document was not found in this level (maybe a tombstone was encountered).
+      if (packed_row_found) {
+        RETURN_NOT_OK(RemoveOverwrittenPackedColumn(key, data));
+      }
       continue;
     }
 
@@ -1090,6 +1192,28 @@ yb::Status GetSubDocument(
   return GetSubDocument(iter.get(), data, nullptr /* projection */, SeekFwdSuffices::kFalse);
 }
 
+Result<DocHybridTime> FindTableTombstoneTime(
+    const Slice& doc_key, IntentAwareIterator* db_iter, DocHybridTime* max_overwrite_ht,
+    Expiration* exp) {
+  // Seek to the ID level to look for a table tombstone.
+  DocKey empty_key;
+  RETURN_NOT_OK(empty_key.DecodeFrom(doc_key, DocKeyPart::UP_TO_ID));
+  db_iter->Seek(empty_key);
+  Value doc_value = Value(PrimitiveValue(ValueType::kInvalid));
+  RETURN_NOT_OK(FindLastWriteTime(
+      db_iter,
+      empty_key.Encode(),
+      max_overwrite_ht,
+      exp,
+      &doc_value));
+  if (doc_value.value_type() != ValueType::kTombstone) {
+    return DocHybridTime::kMin;
+  }
+  SCHECK_NE(*max_overwrite_ht, DocHybridTime::kInvalid, Corruption,
+            "Invalid hybrid time for table tombstone");
+  return *max_overwrite_ht;
+}
+
 yb::Status GetSubDocument(
     IntentAwareIterator *db_iter,
     const GetSubDocumentData& data,
@@ -1130,26 +1254,10 @@ yb::Status GetSubDocument(
     // kPgTableOid.
     // TODO: adjust when fixing issue #3551
     if (key_slice[0] == ValueTypeAsChar::kPgTableOid) {
-      // Seek to the ID level to look for a table tombstone.  Since this seek is expensive, cache
-      // the result in data.table_tombstone_time to avoid double seeking for the lifetime of the
-      // DocRowwiseIterator.
-      DocKey empty_key;
-      RETURN_NOT_OK(empty_key.DecodeFrom(key_slice, DocKeyPart::UP_TO_ID));
-      db_iter->Seek(empty_key);
-      Value doc_value = Value(PrimitiveValue(ValueType::kInvalid));
-      RETURN_NOT_OK(FindLastWriteTime(
-          db_iter,
-          empty_key.Encode(),
-          &max_overwrite_ht,
-          &data.exp,
-          &doc_value));
-      if (doc_value.value_type() == ValueType::kTombstone) {
-        SCHECK_NE(max_overwrite_ht, DocHybridTime::kInvalid, Corruption,
-                  "Invalid hybrid time for table tombstone");
-        *data.table_tombstone_time = max_overwrite_ht;
-      } else {
-        *data.table_tombstone_time = DocHybridTime::kMin;
-      }
+      // Since this seek is expensive, cache the result in data.table_tombstone_time to avoid
+      // double seeking for the lifetime of the DocRowwiseIterator.
+      *data.table_tombstone_time = VERIFY_RESULT(FindTableTombstoneTime(
+          key_slice, db_iter, &max_overwrite_ht, &data.exp));
     } else {
       *data.table_tombstone_time = DocHybridTime::kMin;
     }
@@ -1164,19 +1272,54 @@ yb::Status GetSubDocument(
   } else {
     db_iter->Seek(key_slice);
   }
+  // Value written at the DocKey level, when it is the only ancestor of subdocument_key, i.e. when
+  // a single column is requested. Packed rows contain values of such columns.
+  Value row_value = Value(PrimitiveValue(ValueType::kInvalid));
+  DocHybridTime row_write_ht = DocHybridTime::kMin;
+  Expiration row_exp;
   {
     auto temp_key = data.subdocument_key;
     temp_key.remove_prefix(dockey_size);
+    size_t num_subkeys = 0;
     for (;;) {
       auto decode_result = VERIFY_RESULT(SubDocKey::DecodeSubkey(&temp_key));
       if (!decode_result) {
         break;
       }
-      RETURN_NOT_OK(FindLastWriteTime(db_iter, key_slice, &max_overwrite_ht, &data.exp));
+      ++num_subkeys;
+      const bool is_row = num_subkeys == 1 && temp_key.empty();
+      RETURN_NOT_OK(FindLastWriteTime(
+          db_iter, key_slice, &max_overwrite_ht, &data.exp, is_row ? &row_value : nullptr));
+      if (is_row) {
+        row_write_ht = max_overwrite_ht;
+        row_exp = data.exp;
+      }
       key_slice = Slice(key_slice.data(), temp_key.data() - key_slice.data());
     }
   }
 
+  // The requested column is not stored under its own key when the latest version of the row is
+  // packed, so it is taken from the packed row. Column entries written after the packed row are
+  // found below and take precedence over it.
+  boost::optional<SubDocument> packed_column;
+  if (row_value.value_type() == ValueType::kPackedRow) {
+    bool has_expired = false;
+    CHECK_OK(HasExpiredTTL(row_exp.write_ht, row_exp.ttl,
+                           db_iter->read_time().read, &has_expired));
+    if (!has_expired) {
+      PackedRowDecoder packed_row;
+      RETURN_NOT_OK(packed_row.Init(row_value.primitive_value().GetPackedRow()));
+      const PackedColumn* column = packed_row.Find(Slice(
+          data.subdocument_key.data() + dockey_size, data.subdocument_key.size() - dockey_size));
+      if (column) {
+        packed_column.emplace(ValueType::kInvalid);
+        RETURN_NOT_OK(packed_column->DecodeFromValue(column->value));
+        SetTtlAndWriteTime(row_exp, db_iter->read_time().read, row_write_ht,
+                           row_value.user_timestamp(), &*packed_column);
+      }
+    }
+  }
+
   // By this point, key_slice is the DocKey and all the subkeys of subdocument_key. Check for
   // init-marker / tombstones at the top level; update max_overwrite_ht.
   Value doc_value = Value(PrimitiveValue(ValueType::kInvalid));
@@ -1197,12 +1340,17 @@ yb::Status GetSubDocument(
     if (*data.doc_found) {
       // Observe that this will have the right type but not necessarily the right value.
       *data.result = SubDocument(doc_value.primitive_value());
+    } else if (value_type == ValueType::kInvalid && packed_column) {
+      *data.doc_found = true;
+      *data.result = std::move(*packed_column);
     }
     return Status::OK();
   }
 
   if (projection == nullptr) {
-    *data.result = SubDocument(ValueType::kInvalid);
+    // Column entries older than the packed row are skipped by BuildSubDocument, since
+    // max_overwrite_ht is not earlier than the packed row write time.
+    *data.result = packed_column ? std::move(*packed_column) : SubDocument(ValueType::kInvalid);
     int64 num_values_observed = 0;
     IntentAwareIteratorPrefixScope prefix_scope(key_slice, db_iter);
     RETURN_NOT_OK(BuildSubDocument(db_iter, data, max_overwrite_ht,
@@ -1221,6 +1369,19 @@ yb::Status GetSubDocument(
     }
     return Status::OK();
   }
+  // If the latest version of the row is packed, the projected columns not written after it are
+  // served from the packed row.
+  boost::optional<PackedRowDecoder> packed_row;
+  if (value_type == ValueType::kPackedRow && key_slice.size() == data.subdocument_key.size()) {
+    bool has_expired = false;
+    CHECK_OK(HasExpiredTTL(data.exp.write_ht, data.exp.ttl,
+                           db_iter->read_time().read, &has_expired));
+    if (!has_expired) {
+      packed_row.emplace();
+      RETURN_NOT_OK(packed_row->Init(doc_value.primitive_value().GetPackedRow()));
+    }
+  }
+
   // Seed key_bytes with the subdocument key. For each subkey in the projection, build subdocument
   // and reuse key_bytes while appending the subkey.
   *data.result = SubDocument();
@@ -1239,6 +1400,16 @@ yb::Status GetSubDocument(
     IntentAwareIteratorPrefixScope prefix_scope(key_bytes, db_iter);
     db_iter->SeekForward(&key_bytes);
     SubDocument descendant(ValueType::kInvalid);
+    if (packed_row) {
+      const PackedColumn* column = packed_row->Find(Slice(
+          key_bytes.data().data() + subdocument_key_size,
+          key_bytes.size() - subdocument_key_size));
+      if (column) {
+        RETURN_NOT_OK(descendant.DecodeFromValue(column->value));
+        SetTtlAndWriteTime(data.exp, db_iter->read_time().read, max_overwrite_ht,
+                           doc_value.user_timestamp(), &descendant);
+      }
+    }
     int64 num_values_observed = 0;
     RETURN_NOT_OK(BuildSubDocument(
         db_iter, data.Adjusted(key_bytes, &descendant), max_overwrite_ht,
@@ -1486,7 +1657,8 @@ CHECKED_STATUS IntentToWriteRequest(
 Status PrepareApplyIntentsBatch(
     const TransactionId& transaction_id, HybridTime commit_ht, const KeyBounds* key_bounds,
     rocksdb::WriteBatch* regular_batch,
-    rocksdb::DB* intents_db, rocksdb::WriteBatch* intents_batch) {
+    rocksdb::DB* intents_db, rocksdb::WriteBatch* intents_batch,
+    const ApplyIntentsChunkCallback& chunk_callback) {
   // regular_batch or intents_batch could be null. In this case we don't fill apply batch for
   // appropriate DB.
 
@@ -1545,6 +1717,12 @@ Status PrepareApplyIntentsBatch(
         RETURN_NOT_OK(IntentToWriteRequest(
             transaction_id_slice, commit_ht, reverse_index_iter.key(), reverse_index_value,
             &intent_iter, regular_batch, &write_id));
+        const auto max_records = FLAGS_txn_apply_batch_max_records;
+        if (chunk_callback && max_records > 0 &&
+            regular_batch->Count() >= static_cast<uint32_t>(max_records)) {
+          chunk_callback(regular_batch);
+          regular_batch->Clear();
+        }
       }
 
       if (intents_batch) {
@@ -15,6 +15,7 @@
 #define YB_DOCDB_DOCDB_H_
 
 #include <cstdint>
+#include <functional>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -123,6 +124,13 @@ Result<PrepareDocWriteOperationResult> PrepareDocWriteOperation(
     PartialRangeKeyIntents partial_range_key_intents,
     SharedLockManager *lock_manager);
 
+// Returns true if the read locks for read_pairs, as they are taken by serializable reads, conflict
+// with locks held by in-flight writes. Does not lock anything and does not wait.
+Result<bool> ReadConflictsWithLockedWrites(
+    const google::protobuf::RepeatedPtrField<KeyValuePairPB>& read_pairs,
+    PartialRangeKeyIntents partial_range_key_intents,
+    SharedLockManager* lock_manager);
+
 // This constructs a DocWriteBatch using the given list of DocOperations, reading the previous
 // state of data from RocksDB when necessary.
 //
@@ -189,10 +197,17 @@ void PrepareTransactionWriteBatch(
     const Slice& replicated_batches_state,
     IntraTxnWriteId* write_id);
 
+// Invoked with a regular batch that reached txn_apply_batch_max_records records, in order to write
+// it before the rest of the transaction is applied. The batch is cleared after the callback.
+typedef std::function<void(rocksdb::WriteBatch*)> ApplyIntentsChunkCallback;
+
+// When chunk_callback is specified, regular records are passed to it in chunks, and only the last
+// chunk is left in regular_batch.
 CHECKED_STATUS PrepareApplyIntentsBatch(
     const TransactionId& transaction_id, HybridTime commit_ht, const KeyBounds* key_bounds,
     rocksdb::WriteBatch* regular_batch,
-    rocksdb::DB* intents_db, rocksdb::WriteBatch* intents_batch);
+    rocksdb::DB* intents_db, rocksdb::WriteBatch* intents_batch,
+    const ApplyIntentsChunkCallback& chunk_callback = ApplyIntentsChunkCallback());
 
 // A visitor class that could be overridden to consume results of scanning SubDocuments.
 // See e.g. SubDocumentBuildingVisitor (used in implementing GetSubDocument) as example usage.
@@ -425,6 +440,15 @@ yb::Status FindLastWriteTime(
     Expiration* exp,
     Value* result_value = nullptr);
 
+// Returns the hybrid time of the table tombstone of the colocated table doc_key belongs to, or
+// DocHybridTime::kMin if the table has no tombstone. max_overwrite_time and exp are updated as in
+// FindLastWriteTime for the table level key.
+Result<DocHybridTime> FindTableTombstoneTime(
+    const Slice& doc_key,
+    IntentAwareIterator* iter,
+    DocHybridTime* max_overwrite_time,
+    Expiration* exp);
+
 // Indicates if we can get away by only seeking forward, or if we must do a regular seek.
 YB_STRONGLY_TYPED_BOOL(SeekFwdSuffices);
 
@@ -0,0 +1,425 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// Microbenchmarks of the DocDB layer, in the spirit of rocksdb db_bench. Runs against an in-process
+// pair of regular and intents RocksDB instances, set up the same way as in DocDB tests.
+//
+// Example:
+//   docdb_bench --docdb_bench_dir=/tmp/docdb_bench --benchmarks=write,seek,scan,compact \
+//       --docdb_bench_schema=ysql --docdb_bench_intent_density=0.1
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+
+#include "yb/common/ql_value.h"
+#include "yb/common/schema.h"
+#include "yb/common/transaction.h"
+#include "yb/common/transaction-test-util.h"
+
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_rowwise_iterator.h"
+#include "yb/docdb/docdb_rocksdb_util.h"
+#include "yb/docdb/docdb_util.h"
+#include "yb/docdb/intent_aware_iterator.h"
+
+#include "yb/gutil/stringprintf.h"
+
+#include "yb/rocksdb/db.h"
+
+#include "yb/util/env.h"
+#include "yb/util/flags.h"
+#include "yb/util/format.h"
+#include "yb/util/hdr_histogram.h"
+#include "yb/util/logging.h"
+#include "yb/util/mem_tracker.h"
+#include "yb/util/monotime.h"
+#include "yb/util/path_util.h"
+
+DEFINE_string(benchmarks, "write,seek,scan,compact",
+              "Comma separated list of benchmarks to run: write, seek, scan, compact. The data set "
+              "is always loaded first, write only reports the load.");
+DEFINE_string(docdb_bench_dir, "/tmp/docdb_bench",
+              "Directory of the benchmark databases. Its content is removed at start.");
+DEFINE_string(docdb_bench_schema, "ycql",
+              "Schema of the benchmark table. ycql: hash and range key columns, ysql: range key "
+              "column only, as in range sharded YSQL tables.");
+DEFINE_int64(docdb_bench_num_rows, 100000, "Number of rows to load.");
+DEFINE_int32(docdb_bench_num_columns, 4, "Number of non-key columns in each row.");
+DEFINE_int32(docdb_bench_value_size, 32, "Size of values of non-key columns.");
+DEFINE_int32(docdb_bench_rows_per_hash_key, 10,
+             "Number of rows sharing the same hash key in the ycql schema.");
+DEFINE_int32(docdb_bench_write_batch_rows, 100, "Number of rows per DocWriteBatch.");
+DEFINE_int32(docdb_bench_versions_per_row, 1,
+             "Number of times each row is written. Older versions are removed by the compaction "
+             "filter in the compact benchmark.");
+DEFINE_double(docdb_bench_intent_density, 0,
+              "Fraction of rows, that also have a provisional update of a pending transaction in "
+              "the intents DB.");
+DEFINE_int64(docdb_bench_num_seeks, 100000, "Number of random seeks in the seek benchmark.");
+DEFINE_int32(docdb_bench_num_scans, 3, "Number of full table scans in the scan benchmark.");
+DEFINE_int32(docdb_bench_seed, 42, "Seed of the random generator.");
+
+namespace yb {
+namespace docdb {
+namespace {
+
+constexpr uint64_t kMaxLatencyNs = 60ULL * 1000 * 1000 * 1000;
+constexpr int kLatencySignificantDigits = 2;
+constexpr int kValueColumnIdBase = 20;
+
+// Accounts latencies and allocations of a single benchmark.
+class Stats {
+ public:
+  explicit Stats(std::string name)
+      : name_(std::move(name)), latencies_(kMaxLatencyNs, kLatencySignificantDigits) {
+  }
+
+  void Start() {
+    start_ = MonoTime::Now();
+    start_allocated_ = AllocatedBytes();
+  }
+
+  // Accounts an operation, or a batch of num_ops operations, that took the specified time.
+  void FinishedOps(MonoDelta latency, int64_t num_ops = 1) {
+    latencies_.Increment(latency.ToNanoseconds());
+    num_ops_ += num_ops;
+  }
+
+  void AddBytes(int64_t bytes) {
+    bytes_ += bytes;
+  }
+
+  void Report() const {
+    const auto elapsed = MonoTime::Now() - start_;
+    const double seconds = std::max(elapsed.ToSeconds(), 1e-9);
+    std::string bytes_info;
+    if (bytes_ > 0) {
+      bytes_info = StringPrintf(" %.1f MB/s;", bytes_ / seconds / (1024 * 1024));
+    }
+    std::string allocated_info;
+#ifdef TCMALLOC_ENABLED
+    allocated_info = StringPrintf(" allocated: %" PRId64 " bytes;",
+                                  AllocatedBytes() - start_allocated_);
+#endif
+    LOG(INFO) << StringPrintf(
+        "%-10s: %" PRId64 " ops in %.3f s; %.0f ops/s;%s%s latency us (per %s): avg %.3f, "
+        "p50 %.3f, p95 %.3f, p99 %.3f, p99.9 %.3f, max %.3f",
+        name_.c_str(), num_ops_, seconds, num_ops_ / seconds, bytes_info.c_str(),
+        allocated_info.c_str(),
+        latencies_.TotalCount() == static_cast<uint64_t>(num_ops_) ? "op" : "batch",
+        latencies_.MeanValue() / 1000, latencies_.ValueAtPercentile(50) / 1000.0,
+        latencies_.ValueAtPercentile(95) / 1000.0, latencies_.ValueAtPercentile(99) / 1000.0,
+        latencies_.ValueAtPercentile(99.9) / 1000.0, latencies_.MaxValue() / 1000.0);
+  }
+
+ private:
+  static int64_t AllocatedBytes() {
+#ifdef TCMALLOC_ENABLED
+    return MemTracker::GetTCMallocCurrentAllocatedBytes();
+#else
+    return 0;
+#endif
+  }
+
+  const std::string name_;
+  HdrHistogram latencies_;
+  MonoTime start_;
+  int64_t start_allocated_ = 0;
+  int64_t num_ops_ = 0;
+  int64_t bytes_ = 0;
+};
+
+class DocDBBench : public DocDBRocksDBUtil {
+ public:
+  DocDBBench()
+      : ysql_(FLAGS_docdb_bench_schema == "ysql"),
+        schema_(MakeSchema(ysql_)),
+        reader_txn_context_(GenerateTransactionId(), &txn_status_manager_),
+        random_(FLAGS_docdb_bench_seed) {
+  }
+
+  CHECKED_STATUS InitRocksDBDir() override {
+    rocksdb_dir_ = JoinPathSegments(FLAGS_docdb_bench_dir, "docdb");
+    RETURN_NOT_OK(Env::Default()->DeleteRecursively(rocksdb_dir_));
+    RETURN_NOT_OK(Env::Default()->DeleteRecursively(IntentsDBDir()));
+    return Env::Default()->CreateDirs(FLAGS_docdb_bench_dir);
+  }
+
+  CHECKED_STATUS InitRocksDBOptions() override {
+    return InitCommonRocksDBOptions();
+  }
+
+  std::string tablet_id() override {
+    return "docdb_bench";
+  }
+
+  CHECKED_STATUS Run() {
+    if (FLAGS_docdb_bench_schema != "ycql" && FLAGS_docdb_bench_schema != "ysql") {
+      return STATUS_FORMAT(InvalidArgument, "Unknown schema: $0", FLAGS_docdb_bench_schema);
+    }
+    std::vector<std::string> benchmarks;
+    boost::split(benchmarks, FLAGS_benchmarks, boost::is_any_of(","));
+
+    RETURN_NOT_OK(InitRocksDBDir());
+    RETURN_NOT_OK(InitRocksDBOptions());
+    RETURN_NOT_OK(OpenRocksDB());
+
+    LOG(INFO) << "Schema: " << FLAGS_docdb_bench_schema << ", rows: "
+              << FLAGS_docdb_bench_num_rows << ", columns: " << FLAGS_docdb_bench_num_columns
+              << ", intent density: " << FLAGS_docdb_bench_intent_density;
+
+    RETURN_NOT_OK(Load(std::find(benchmarks.begin(), benchmarks.end(), "write") !=
+                       benchmarks.end()));
+    for (const auto& benchmark : benchmarks) {
+      if (benchmark == "write" || benchmark.empty()) {
+        continue;
+      } else if (benchmark == "seek") {
+        RETURN_NOT_OK(Seek());
+      } else if (benchmark == "scan") {
+        RETURN_NOT_OK(Scan());
+      } else if (benchmark == "compact") {
+        RETURN_NOT_OK(Compact());
+      } else {
+        return STATUS_FORMAT(InvalidArgument, "Unknown benchmark: $0", benchmark);
+      }
+    }
+    return Status::OK();
+  }
+
+ private:
+  static Schema MakeSchema(bool ysql) {
+    std::vector<ColumnSchema> columns;
+    std::vector<ColumnId> ids;
+    if (ysql) {
+      columns.emplace_back("k", DataType::INT64);
+      ids.emplace_back(10);
+    } else {
+      columns.emplace_back("h", DataType::INT64, /* is_nullable = */ false,
+                           /* is_hash_key = */ true);
+      columns.emplace_back("r", DataType::INT64);
+      ids.emplace_back(10);
+      ids.emplace_back(11);
+    }
+    const int num_key_columns = columns.size();
+    for (int i = 0; i != FLAGS_docdb_bench_num_columns; ++i) {
+      columns.emplace_back(Format("v$0", i), DataType::STRING, /* is_nullable = */ true);
+      ids.emplace_back(kValueColumnIdBase + i);
+    }
+    return Schema(columns, ids, num_key_columns);
+  }
+
+  DocKey RowKey(int64_t row) const {
+    if (ysql_) {
+      return DocKey({ PrimitiveValue::Int64(row) });
+    }
+    const int64_t hash_value = row / FLAGS_docdb_bench_rows_per_hash_key;
+    // Spread hash keys over the whole hash space, as real hash codes do.
+    const DocKeyHash hash = static_cast<DocKeyHash>((hash_value * 2654435761ULL) >> 16);
+    return DocKey(hash, { PrimitiveValue::Int64(hash_value) },
+                  { PrimitiveValue::Int64(row % FLAGS_docdb_bench_rows_per_hash_key) });
+  }
+
+  bool RowHasIntent(int64_t row) const {
+    const double density = FLAGS_docdb_bench_intent_density;
+    if (density <= 0) {
+      return false;
+    }
+    // Deterministic, evenly spread selection of rows.
+    return static_cast<int64_t>(row * density) != static_cast<int64_t>((row + 1) * density);
+  }
+
+  PrimitiveValue ColumnValue(int64_t row, int column, int version) const {
+    auto result = Format("$0-$1-$2-", row, column, version);
+    result.resize(std::max<size_t>(FLAGS_docdb_bench_value_size, result.size()), 'x');
+    return PrimitiveValue(result);
+  }
+
+  HybridTime NextWriteTime() {
+    last_write_time_ = HybridTime::FromMicros(last_write_time_.GetPhysicalValueMicros() + 1);
+    return last_write_time_;
+  }
+
+  ReadHybridTime ReadTime() const {
+    return ReadHybridTime::SingleTime(last_write_time_);
+  }
+
+  // Loads the data set, i.e. all versions of all rows, followed by provisional updates of the
+  // intent rows. The intent transactions are never committed, so reads have to resolve and skip
+  // them.
+  CHECKED_STATUS Load(bool report) {
+    Stats stats("write");
+    stats.Start();
+    const int64_t num_rows = FLAGS_docdb_bench_num_rows;
+    const int64_t batch_rows = std::max(FLAGS_docdb_bench_write_batch_rows, 1);
+    auto dwb = MakeDocWriteBatch();
+    const auto liveness_column = PrimitiveValue::SystemColumnId(SystemColumnIds::kLivenessColumn);
+    const Value liveness_value{PrimitiveValue(ValueType::kNullLow)};
+    for (int version = 0; version < FLAGS_docdb_bench_versions_per_row; ++version) {
+      for (int64_t first_row = 0; first_row < num_rows; first_row += batch_rows) {
+        const auto end_row = std::min(first_row + batch_rows, num_rows);
+        const auto start = MonoTime::Now();
+        for (auto row = first_row; row != end_row; ++row) {
+          const auto encoded_doc_key = RowKey(row).Encode();
+          RETURN_NOT_OK(dwb.SetPrimitive(DocPath(encoded_doc_key, liveness_column),
+                                         liveness_value));
+          for (int column = 0; column != FLAGS_docdb_bench_num_columns; ++column) {
+            RETURN_NOT_OK(dwb.SetPrimitive(
+                DocPath(encoded_doc_key, PrimitiveValue(ColumnId(kValueColumnIdBase + column))),
+                Value(ColumnValue(row, column, version))));
+          }
+        }
+        for (const auto& entry : dwb.key_value_pairs()) {
+          stats.AddBytes(entry.first.size() + entry.second.size());
+        }
+        RETURN_NOT_OK(WriteToRocksDBAndClear(&dwb, NextWriteTime(), /* decode_dockey = */ false));
+        stats.FinishedOps(MonoTime::Now() - start, end_row - first_row);
+      }
+    }
+
+    for (int64_t first_row = 0; first_row < num_rows; first_row += batch_rows) {
+      const auto end_row = std::min(first_row + batch_rows, num_rows);
+      for (auto row = first_row; row != end_row; ++row) {
+        if (!RowHasIntent(row)) {
+          continue;
+        }
+        RETURN_NOT_OK(dwb.SetPrimitive(
+            DocPath(RowKey(row).Encode(), PrimitiveValue(ColumnId(kValueColumnIdBase))),
+            Value(ColumnValue(row, 0, FLAGS_docdb_bench_versions_per_row))));
+      }
+      if (dwb.IsEmpty()) {
+        continue;
+      }
+      const auto txn_id = GenerateTransactionId();
+      // Commit time is never reached, so the transaction is reported as pending.
+      txn_status_manager_.Commit(txn_id, HybridTime::kMax);
+      SetCurrentTransactionId(txn_id);
+      RETURN_NOT_OK(WriteToRocksDBAndClear(&dwb, NextWriteTime(), /* decode_dockey = */ false));
+      ResetCurrentTransactionId();
+    }
+
+    if (report) {
+      stats.Report();
+    }
+    RETURN_NOT_OK(FlushRocksDbAndWait());
+    rocksdb::FlushOptions flush_options;
+    flush_options.wait = true;
+    return intents_db()->Flush(flush_options);
+  }
+
+  CHECKED_STATUS Seek() {
+    Stats stats("seek");
+    auto iter = CreateIntentAwareIterator(
+        doc_db(), BloomFilterMode::DONT_USE_BLOOM_FILTER, boost::none, rocksdb::kDefaultQueryId,
+        reader_txn_context_, CoarseTimePoint::max(), ReadTime());
+    std::uniform_int_distribution<int64_t> distribution(0, FLAGS_docdb_bench_num_rows - 1);
+    std::vector<DocKey> keys;
+    keys.reserve(FLAGS_docdb_bench_num_seeks);
+    for (int64_t i = 0; i != FLAGS_docdb_bench_num_seeks; ++i) {
+      keys.push_back(RowKey(distribution(random_)));
+    }
+    stats.Start();
+    for (const auto& key : keys) {
+      const auto start = MonoTime::Now();
+      iter->Seek(key);
+      if (!iter->valid()) {
+        return STATUS_FORMAT(Corruption, "Key not found: $0", key);
+      }
+      RETURN_NOT_OK(iter->FetchKey());
+      stats.FinishedOps(MonoTime::Now() - start);
+    }
+    stats.Report();
+    return Status::OK();
+  }
+
+  CHECKED_STATUS Scan() {
+    Schema projection;
+    std::vector<GStringPiece> names;
+    for (size_t i = schema_.num_key_columns(); i != schema_.num_columns(); ++i) {
+      names.push_back(schema_.column(i).name());
+    }
+    RETURN_NOT_OK(schema_.CreateProjectionByNames(names, &projection));
+
+    Stats stats("scan");
+    stats.Start();
+    QLTableRow row;
+    for (int scan = 0; scan != FLAGS_docdb_bench_num_scans; ++scan) {
+      DocRowwiseIterator iter(
+          projection, schema_, reader_txn_context_, doc_db(), CoarseTimePoint::max(), ReadTime());
+      RETURN_NOT_OK(iter.Init());
+      int64_t num_rows = 0;
+      for (;;) {
+        const auto start = MonoTime::Now();
+        if (!VERIFY_RESULT(iter.HasNext())) {
+          break;
+        }
+        RETURN_NOT_OK(iter.NextRow(&row));
+        stats.FinishedOps(MonoTime::Now() - start);
+        ++num_rows;
+      }
+      if (num_rows != FLAGS_docdb_bench_num_rows) {
+        return STATUS_FORMAT(
+            Corruption, "Scanned $0 rows, while $1 were loaded", num_rows,
+            FLAGS_docdb_bench_num_rows);
+      }
+    }
+    stats.Report();
+    return Status::OK();
+  }
+
+  // Measures DocDBCompactionFilter throughput by a full compaction of the regular DB, with history
+  // cutoff at the latest write, so all overwritten versions are removed.
+  CHECKED_STATUS Compact() {
+    uint64_t num_entries = 0;
+    uint64_t sst_size = 0;
+    rocksdb()->GetIntProperty(rocksdb::DB::Properties::kEstimateNumKeys, &num_entries);
+    rocksdb()->GetIntProperty(rocksdb::DB::Properties::kTotalSstFilesSize, &sst_size);
+
+    Stats stats("compact");
+    SetHistoryCutoffHybridTime(last_write_time_);
+    stats.Start();
+    const auto start = MonoTime::Now();
+    RETURN_NOT_OK(rocksdb()->CompactRange(rocksdb::CompactRangeOptions(), nullptr, nullptr));
+    stats.FinishedOps(MonoTime::Now() - start, num_entries);
+    stats.AddBytes(sst_size);
+    stats.Report();
+    SetHistoryCutoffHybridTime(HybridTime::kMin);
+    return Status::OK();
+  }
+
+  const bool ysql_;
+  const Schema schema_;
+  TransactionStatusManagerMock txn_status_manager_;
+  const TransactionOperationContext reader_txn_context_;
+  std::mt19937_64 random_;
+  HybridTime last_write_time_ = HybridTime::FromMicros(1000);
+};
+
+} // namespace
+} // namespace docdb
+} // namespace yb
+
+int main(int argc, char** argv) {
+  yb::ParseCommandLineFlags(&argc, &argv, true);
+  yb::InitGoogleLoggingSafe(argv[0]);
+  yb::docdb::DocDBBench bench;
+  auto status = bench.Run();
+  if (!status.ok()) {
+    LOG(ERROR) << "Benchmark failed: " << status;
+    return 1;
+  }
+  return 0;
+}
@@ -17,12 +17,14 @@
 
 #include <glog/logging.h>
 
+#include "yb/gutil/strings/numbers.h"
 #include "yb/rocksdb/compaction_filter.h"
 #include "yb/util/string_util.h"
 
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/docdb-internal.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/value.h"
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/rocksutil/yb_rocksdb.h"
@@ -37,15 +39,100 @@ using rocksdb::FilterDecision;
 namespace yb {
 namespace docdb {
 
+namespace {
+
+// Rewrites a packed row value without the columns that were deleted from the schema. Returns false
+// if the packed row does not contain any of them.
+Result<bool> RemoveDeletedColumnsFromPackedRow(
+    const Slice& existing_value, const ColumnIds& deleted_cols, std::string* new_value) {
+  Value value;
+  Slice value_slice = existing_value;
+  RETURN_NOT_OK(value.DecodeControlFields(&value_slice));
+  if (ConsumeValueType(&value_slice) != ValueType::kPackedRow) {
+    return STATUS_FORMAT(Corruption, "Packed row expected: $0", existing_value.ToDebugHexString());
+  }
+  std::string packed_row(1, ValueTypeAsChar::kPackedRow);
+  std::string packed_row_body;
+  if (!VERIFY_RESULT(RemoveColumnsFromPackedRow(value_slice, deleted_cols, &packed_row_body))) {
+    return false;
+  }
+  packed_row.append(packed_row_body);
+  Slice packed_row_slice(packed_row);
+  new_value->clear();
+  // We are reusing the existing control fields without decoding/encoding the rest of the value.
+  value.EncodeAndAppend(new_value, &packed_row_slice);
+  return true;
+}
+
+const std::string kMinHybridTimePropertyName = "yb.docdb.min_hybrid_time";
+const std::string kHasValueTtlPropertyName = "yb.docdb.has_value_ttl";
+
+class DocDBTablePropertiesCollector : public rocksdb::TablePropertiesCollector {
+ public:
+  Status AddUserKey(const Slice& key, const Slice& value, rocksdb::EntryType type,
+                    rocksdb::SequenceNumber seq, uint64_t file_size) override {
+    if (!valid_) {
+      return Status::OK();
+    }
+    DocHybridTime doc_ht;
+    if (!doc_ht.DecodeFromEnd(key).ok()) {
+      // Not a DocDB key, so the minimal hybrid time of the file is unknown.
+      valid_ = false;
+      return Status::OK();
+    }
+    min_hybrid_time_ = std::min(min_hybrid_time_, doc_ht.hybrid_time());
+    if (!has_value_ttl_) {
+      ValueType value_type;
+      MonoDelta ttl;
+      uint64_t merge_flags = 0;
+      has_value_ttl_ =
+          !Value::DecodePrimitiveValueType(value, &value_type, &merge_flags, &ttl).ok() ||
+          merge_flags == Value::kTtlFlag || ttl != Value::kMaxTtl;
+    }
+    return Status::OK();
+  }
+
+  Status Finish(rocksdb::UserCollectedProperties* properties) override {
+    if (valid_ && min_hybrid_time_ != HybridTime::kMax) {
+      properties->emplace(kMinHybridTimePropertyName, std::to_string(min_hybrid_time_.ToUint64()));
+      properties->emplace(kHasValueTtlPropertyName, has_value_ttl_ ? "1" : "0");
+    }
+    return Status::OK();
+  }
+
+  rocksdb::UserCollectedProperties GetReadableProperties() const override {
+    rocksdb::UserCollectedProperties result;
+    if (valid_ && min_hybrid_time_ != HybridTime::kMax) {
+      result.emplace(kMinHybridTimePropertyName, min_hybrid_time_.ToString());
+      result.emplace(kHasValueTtlPropertyName, has_value_ttl_ ? "true" : "false");
+    }
+    return result;
+  }
+
+  const char* Name() const override {
+    return "DocDBTablePropertiesCollector";
+  }
+
+ private:
+  bool valid_ = true;
+  HybridTime min_hybrid_time_ = HybridTime::kMax;
+  // Whether some entry has its own TTL, so could outlive the table TTL.
+  bool has_value_ttl_ = false;
+};
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 
 DocDBCompactionFilter::DocDBCompactionFilter(
     HistoryRetentionDirective retention,
     IsMajorCompaction is_major_compaction,
-    const KeyBounds* key_bounds)
+    const KeyBounds* key_bounds,
+    bool all_input_after_history_cutoff)
     : retention_(std::move(retention)),
       key_bounds_(key_bounds),
-      is_major_compaction_(is_major_compaction) {
+      is_major_compaction_(is_major_compaction),
+      all_input_after_history_cutoff_(all_input_after_history_cutoff) {
 }
 
 DocDBCompactionFilter::~DocDBCompactionFilter() {
@@ -73,7 +160,8 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
     // TODO: switch this to VLOG if it becomes too chatty.
     LOG(INFO) << "DocDB compaction filter is being used for a "
               << (is_major_compaction_ ? "major" : "minor") << " compaction"
-              << ", history_cutoff=" << history_cutoff;
+              << ", history_cutoff=" << history_cutoff
+              << ", all_input_after_history_cutoff=" << all_input_after_history_cutoff_;
     filter_usage_logged_ = true;
   }
 
@@ -88,6 +176,12 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
     return FilterDecision::kDiscard;
   }
 
+  // Entries newer than the history cutoff are always kept as is, see below, and they don't affect
+  // decisions about other such entries. So when all input is newer, there is nothing to decode.
+  if (all_input_after_history_cutoff_) {
+    return FilterDecision::kKeep;
+  }
+
   auto same_bytes = strings::MemoryDifferencePos(
       key.data(), prev_subdoc_key_.data(), std::min(key.size(), prev_subdoc_key_.size()));
 
@@ -148,8 +242,11 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
   // hybrid_time stack, and we might as well do that while handling the next key/value pair that
   // does not get cleaned up the same way as this one.
   //
-  // TODO: When more merge records are supported, isTtlRow should be redefined appropriately.
-  bool isTtlRow = IsMergeRecord(existing_value);
+  uint64_t merge_flags = 0;
+  RETURN_NOT_OK(Value::DecodeMergeFlags(existing_value, &merge_flags));
+  bool isTtlRow = merge_flags == Value::kTtlFlag;
+  // A counter delta does not overwrite the older records of its counter, it is added to them.
+  const bool is_counter_delta = merge_flags == Value::kCounterDeltaFlag;
   if (ht < prev_overwrite_ht && !isTtlRow) {
     return FilterDecision::kDiscard;
   }
@@ -202,7 +299,7 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
     }
   }
 
-  auto overwrite_ht = isTtlRow ? prev_overwrite_ht : max(prev_overwrite_ht, ht);
+  auto overwrite_ht = isTtlRow || is_counter_delta ? prev_overwrite_ht : max(prev_overwrite_ht, ht);
 
   ValueType value_type;
   MonoDelta ttl;
@@ -284,6 +381,14 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
     within_merge_block_ = false;
   }
 
+  // Columns deleted from the schema are dropped from packed rows as well, the same way their
+  // regular per-column entries are discarded above.
+  if (value_type == ValueType::kPackedRow && !*value_changed &&
+      !retention_.deleted_cols->empty()) {
+    *value_changed = VERIFY_RESULT(RemoveDeletedColumnsFromPackedRow(
+        existing_value, *retention_.deleted_cols, new_value));
+  }
+
   // If we are backfilling an index table, we want to preserve the delete markers in the table
   // until the backfill process is completed. For other normal use cases, delete markers/tombstones
   // can be cleaned up on a major compaction.
@@ -330,10 +435,56 @@ DocDBCompactionFilterFactory::~DocDBCompactionFilterFactory() {
 
 unique_ptr<CompactionFilter> DocDBCompactionFilterFactory::CreateCompactionFilter(
     const CompactionFilter::Context& context) {
+  auto retention = retention_policy_->GetRetentionDirective();
+  bool all_input_after_history_cutoff = !context.input_table_properties.empty();
+  for (const auto& properties : context.input_table_properties) {
+    if (MinHybridTimeFromTableProperties(*properties) <= retention.history_cutoff) {
+      all_input_after_history_cutoff = false;
+      break;
+    }
+  }
   return std::make_unique<DocDBCompactionFilter>(
-      retention_policy_->GetRetentionDirective(),
-      IsMajorCompaction(context.is_full_compaction),
-      key_bounds_);
+      std::move(retention),
+      // With hybrid compactions full compactions are rare, but a compaction of the bottommost
+      // level includes all older records of its keys, so it is as good as a major one.
+      IsMajorCompaction(context.is_full_compaction || context.is_bottommost_level),
+      key_bounds_,
+      all_input_after_history_cutoff);
+}
+
+std::vector<size_t> DocDBCompactionFilterFactory::ExpiredFiles(
+    const std::vector<rocksdb::FileExpirationInfo>& files) {
+  // Entries with their own TTL could outlive newer entries of the same key, that are hidden by
+  // them, so files are dropped only when none of the files has such entries.
+  for (const auto& file : files) {
+    if (!file.properties || !HasNoValueTtlInTableProperties(*file.properties)) {
+      return {};
+    }
+  }
+
+  auto retention = retention_policy_->GetRetentionDirective();
+  if (retention.table_ttl == Value::kMaxTtl ||
+      retention.retain_delete_markers_in_major_compaction) {
+    return {};
+  }
+
+  std::vector<size_t> result;
+  for (size_t idx = 0; idx != files.size(); ++idx) {
+    if (!files[idx].largest_frontier) {
+      continue;
+    }
+    // Hybrid time of the largest frontier is not less than hybrid time of any entry in the file.
+    auto max_hybrid_time =
+        down_cast<const ConsensusFrontier&>(*files[idx].largest_frontier).hybrid_time();
+    bool has_expired = false;
+    if (max_hybrid_time.is_valid() &&
+        HasExpiredTTL(max_hybrid_time, retention.table_ttl, retention.history_cutoff,
+                      &has_expired).ok() &&
+        has_expired) {
+      result.push_back(idx);
+    }
+  }
+  return result;
 }
 
 const char* DocDBCompactionFilterFactory::Name() const {
@@ -342,6 +493,32 @@ const char* DocDBCompactionFilterFactory::Name() const {
 
 // ------------------------------------------------------------------------------------------------
 
+rocksdb::TablePropertiesCollector*
+DocDBTablePropertiesCollectorFactory::CreateTablePropertiesCollector(
+    rocksdb::TablePropertiesCollectorFactory::Context context) {
+  return new DocDBTablePropertiesCollector();
+}
+
+const char* DocDBTablePropertiesCollectorFactory::Name() const {
+  return "DocDBTablePropertiesCollectorFactory";
+}
+
+HybridTime MinHybridTimeFromTableProperties(const rocksdb::TableProperties& properties) {
+  auto it = properties.user_collected_properties.find(kMinHybridTimePropertyName);
+  uint64_t value;
+  if (it == properties.user_collected_properties.end() || !safe_strtou64(it->second, &value)) {
+    return HybridTime::kMin;
+  }
+  return HybridTime(value);
+}
+
+bool HasNoValueTtlInTableProperties(const rocksdb::TableProperties& properties) {
+  auto it = properties.user_collected_properties.find(kHasValueTtlPropertyName);
+  return it != properties.user_collected_properties.end() && it->second == "0";
+}
+
+// ------------------------------------------------------------------------------------------------
+
 HistoryRetentionDirective ManualHistoryRetentionPolicy::GetRetentionDirective() {
   std::lock_guard<std::mutex> lock(deleted_cols_mtx_);
   return {history_cutoff_.load(std::memory_order_acquire),
@@ -25,6 +25,7 @@
 
 #include "yb/rocksdb/compaction_filter.h"
 #include "yb/rocksdb/metadata.h"
+#include "yb/rocksdb/table_properties.h"
 
 #include "yb/common/schema.h"
 #include "yb/common/hybrid_time.h"
@@ -63,7 +64,8 @@ class DocDBCompactionFilter : public rocksdb::CompactionFilter {
   DocDBCompactionFilter(
       HistoryRetentionDirective retention,
       IsMajorCompaction is_major_compaction,
-      const KeyBounds* key_bounds);
+      const KeyBounds* key_bounds,
+      bool all_input_after_history_cutoff = false);
 
   ~DocDBCompactionFilter() override;
   rocksdb::FilterDecision Filter(
@@ -94,6 +96,10 @@ class DocDBCompactionFilter : public rocksdb::CompactionFilter {
   const KeyBounds* key_bounds_;
   const IsMajorCompaction is_major_compaction_;
 
+  // All entries of compaction input files are newer than the history cutoff, so none of them is
+  // garbage collected or rewritten, and entries could be kept without decoding them.
+  const bool all_input_after_history_cutoff_;
+
   std::vector<char> prev_subdoc_key_;
 
   // Result of DecodeDocKeyAndSubKeyEnds for prev_subdoc_key_.
@@ -148,6 +154,23 @@ class DocDBCompactionFilter : public rocksdb::CompactionFilter {
   bool within_merge_block_ = false;
 };
 
+// Collects the minimal hybrid time of DocDB entries in the SST file, so compaction could tell that
+// no input entry is old enough to be cleaned up.
+class DocDBTablePropertiesCollectorFactory : public rocksdb::TablePropertiesCollectorFactory {
+ public:
+  rocksdb::TablePropertiesCollector* CreateTablePropertiesCollector(
+      rocksdb::TablePropertiesCollectorFactory::Context context) override;
+
+  const char* Name() const override;
+};
+
+// Returns the minimal hybrid time of entries in the SST file with specified properties, or
+// HybridTime::kMin if it is unknown.
+HybridTime MinHybridTimeFromTableProperties(const rocksdb::TableProperties& properties);
+
+// Returns true if it is known that no entry of the SST file has its own TTL.
+bool HasNoValueTtlInTableProperties(const rocksdb::TableProperties& properties);
+
 // A strategy for deciding how the history of old database operations should be retained during
 // compactions. We may implement this differently in production and in tests.
 class HistoryRetentionPolicy {
@@ -163,6 +186,8 @@ class DocDBCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
   ~DocDBCompactionFilterFactory() override;
   std::unique_ptr<rocksdb::CompactionFilter> CreateCompactionFilter(
       const rocksdb::CompactionFilter::Context& context) override;
+  // Files are expired when all their entries are expired by the table TTL at the history cutoff.
+  std::vector<size_t> ExpiredFiles(const std::vector<rocksdb::FileExpirationInfo>& files) override;
   const char* Name() const override;
 
  private:
@@ -22,10 +22,15 @@ namespace docdb {
 class ConsensusFrontier;
 class DocPath;
 class DocWriteBatch;
+class HotKeys;
 class IntentAwareIterator;
+class IntentsSummary;
 class KeyValueWriteBatchPB;
+class NextsToAvoidSeekStats;
+class NextsToAvoidSeekTuner;
 class QLWriteOperation;
 class PgsqlWriteOperation;
+class RowCache;
 
 struct DocDB;
 
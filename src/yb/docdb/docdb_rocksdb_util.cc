@@ -13,12 +13,15 @@
 
 #include "yb/docdb/docdb_rocksdb_util.h"
 
+#include <algorithm>
+#include <limits>
 #include <thread>
 #include <memory>
 
 #include "yb/common/transaction.h"
 
 #include "yb/rocksdb/memtablerep.h"
+#include "yb/rocksdb/perf_context.h"
 #include "yb/rocksdb/rate_limiter.h"
 #include "yb/rocksdb/table.h"
 #include "yb/rocksdb/db/db_impl.h"
@@ -32,13 +35,17 @@
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/intent_aware_iterator.h"
+#include "yb/docdb/nexts_to_avoid_seek.h"
 #include "yb/rocksutil/yb_rocksdb.h"
 #include "yb/rocksutil/yb_rocksdb_logger.h"
 #include "yb/server/hybrid_clock.h"
+#include "yb/util/background_io_rate_controller.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/priority_thread_pool.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/trace.h"
 #include "yb/gutil/sysinfo.h"
+#include "yb/gutil/walltime.h"
 
 using namespace yb::size_literals;  // NOLINT.
 using namespace std::literals;
@@ -66,12 +73,51 @@ DEFINE_int32(rocksdb_universal_compaction_min_merge_width, 4,
              "The minimum number of files in a single compaction run.");
 DEFINE_int64(rocksdb_compact_flush_rate_limit_bytes_per_sec, 256_MB,
              "Use to control write rate of flush and compaction.");
+DEFINE_bool(rocksdb_compact_flush_rate_limit_shared, false,
+            "Whether rocksdb_compact_flush_rate_limit_bytes_per_sec limits flushes and "
+            "compactions of all tablets together, instead of each tablet individually.");
+TAG_FLAG(rocksdb_compact_flush_rate_limit_shared, advanced);
 DEFINE_uint64(rocksdb_compaction_size_threshold_bytes, 2ULL * 1024 * 1024 * 1024,
              "Threshold beyond which compaction is considered large.");
 DEFINE_uint64(rocksdb_max_file_size_for_compaction, 0,
              "Maximal allowed file size to participate in RocksDB compaction. 0 - unlimited.");
+DEFINE_bool(rocksdb_hybrid_compaction, false,
+            "Whether to use hybrid compactions for the regular DB instead of universal ones. "
+            "Recently flushed files are kept as overlapping sorted runs in level 0 and compacted "
+            "together, while older data is kept in levels of non-overlapping files of bounded "
+            "size, so a compaction rewrites only files whose key ranges overlap instead of all "
+            "data. "
+            "Tablets that have data in lower levels could not be opened after this is disabled.");
+TAG_FLAG(rocksdb_hybrid_compaction, advanced);
+DEFINE_int32(rocksdb_hybrid_compaction_num_levels, 5,
+             "Number of levels with hybrid compactions, including level 0.");
+TAG_FLAG(rocksdb_hybrid_compaction_num_levels, advanced);
+DEFINE_uint64(rocksdb_hybrid_compaction_target_file_size, 256_MB,
+              "Size of files written to lower levels with hybrid compactions.");
+TAG_FLAG(rocksdb_hybrid_compaction_target_file_size, advanced);
+DEFINE_uint64(rocksdb_hybrid_compaction_level_base_bytes, 1_GB,
+              "Minimal total size of files in the first level below level 0 with hybrid "
+              "compactions. Sizes of lower levels grow by the factor of "
+              "rocksdb_hybrid_compaction_level_size_multiplier towards the last level.");
+TAG_FLAG(rocksdb_hybrid_compaction_level_base_bytes, advanced);
+DEFINE_int32(rocksdb_hybrid_compaction_level_size_multiplier, 10,
+             "Ratio between total sizes of files in adjacent levels with hybrid compactions.");
+TAG_FLAG(rocksdb_hybrid_compaction_level_size_multiplier, advanced);
+DEFINE_int32(rocksdb_max_subcompactions, 1,
+             "Maximal number of parallel key range subcompactions a single regular DB compaction "
+             "could be split into. 1 - subcompactions are disabled.");
 DEFINE_int32(rocksdb_max_write_buffer_number, 2,
              "Maximum number of write buffers that are built up in memory.");
+DEFINE_bool(rocksdb_use_direct_io_for_compaction, false,
+            "Whether compactions read their input and write their output with O_DIRECT, so they "
+            "don't evict data used by foreground reads from the OS page cache.");
+TAG_FLAG(rocksdb_use_direct_io_for_compaction, advanced);
+
+DEFINE_bool(rocksdb_allow_concurrent_memtable_write, false,
+            "Whether concurrent writes to the regular RocksDB of a tablet insert into its memtable "
+            "in parallel. Requires a memtable that supports concurrent inserts, that is slightly "
+            "more expensive for single writer.");
+TAG_FLAG(rocksdb_allow_concurrent_memtable_write, advanced);
 
 DEFINE_int64(db_block_size_bytes, 32_KB,
              "Size of RocksDB data block (in bytes).");
@@ -79,6 +125,10 @@ DEFINE_int64(db_block_size_bytes, 32_KB,
 DEFINE_int64(db_filter_block_size_bytes, 64_KB,
              "Size of RocksDB filter block (in bytes).");
 
+DEFINE_int64(db_filter_block_prefetch_size_bytes, 0,
+             "Maximum total size of filter blocks of a single SST file (in bytes) to load into "
+             "the block cache when the file is opened. 0 disables prefetching.");
+
 DEFINE_int64(db_index_block_size_bytes, 32_KB,
              "Size of RocksDB index block (in bytes).");
 
@@ -93,10 +143,33 @@ DEFINE_int32(memstore_size_mb, 128,
 
 DEFINE_bool(use_docdb_aware_bloom_filter, true,
             "Whether to use the DocDbAwareFilterPolicy for both bloom storage and seeks.");
+DEFINE_bool(use_docdb_bloom_filter_line_mask_format, false,
+            "Whether new bloom filter blocks of the DocDbAwareFilterPolicy are written in the line "
+            "mask format, which checks all probes of a key against its cache line at once. Filter "
+            "blocks of both formats are readable, but older versions consider filter blocks of "
+            "the line mask format as matching all keys, so enable it only after all servers are "
+            "upgraded.");
+TAG_FLAG(use_docdb_bloom_filter_line_mask_format, advanced);
 DEFINE_int32(max_nexts_to_avoid_seek, 1,
              "The number of next calls to try before doing resorting to do a rocksdb seek.");
 DEFINE_bool(trace_docdb_calls, false, "Whether we should trace calls into the docdb.");
 DEFINE_bool(use_multi_level_index, true, "Whether to use multi-level data index.");
+DEFINE_bool(use_docdb_data_block_hash_index, false,
+            "Whether to build the in-block hash index keyed on the DocDB key without hybrid time "
+            "for new SST data blocks, and use it for seeks. SST files with this index could not "
+            "be read by versions that do not support it.");
+DEFINE_bool(use_docdb_shared_suffix_key_encoding, false,
+            "Whether to also omit the key suffix shared with the previous key, i.e. the hybrid "
+            "time and the sequence number, in new SST data blocks. SST files with this encoding "
+            "could not be read by versions that do not support it.");
+
+DEFINE_bool(use_hybrid_time_file_filter, true,
+            "Whether to skip SST files that contain only records written after the read time "
+            "limit when creating iterators over the regular DB.");
+
+DEFINE_bool(use_key_bounds_file_filter, true,
+            "Whether to skip SST files that do not contain keys within key bounds of the tablet "
+            "when creating iterators over the regular DB.");
 
 DEFINE_uint64(initial_seqno, 1ULL << 50, "Initial seqno for new RocksDB instances.");
 
@@ -106,11 +179,59 @@ DEFINE_int32(num_reserved_small_compaction_threads, -1, "Number of reserved smal
 DEFINE_bool(enable_ondisk_compression, true,
             "Determines whether SSTable compression is enabled or not.");
 
+DEFINE_int32(rocksdb_compression_dict_max_bytes, 0,
+             "When on-disk compression is enabled and this is positive, data blocks of each SST "
+             "file are compressed with ZSTD, or LZ4 if ZSTD is not available, using a dictionary "
+             "of at most this size built from the first data blocks of the file. It improves "
+             "compression of small rows with similar values. 0 to use Snappy without dictionary.");
+TAG_FLAG(rocksdb_compression_dict_max_bytes, advanced);
+
 DEFINE_int32(priority_thread_pool_size, -1,
              "Max running workers in compaction thread pool. "
              "If -1 and max_background_compactions is specified - use max_background_compactions. "
              "If -1 and max_background_compactions is not specified - use sqrt(num_cpus).");
 
+DEFINE_int64(tiered_storage_cold_data_age_sec, 0,
+             "Outputs of compactions, whose newest data is older than this number of seconds, "
+             "are placed on the cold storage tier configured via fs_cold_data_dirs. Flushes and "
+             "compactions of newer data are written to the data dir. 0 disables the placement.");
+TAG_FLAG(tiered_storage_cold_data_age_sec, advanced);
+TAG_FLAG(tiered_storage_cold_data_age_sec, runtime);
+
+DEFINE_bool(rocksdb_adaptive_compaction_compression, false,
+            "Whether compression of compaction outputs is chosen by their size and age. Small "
+            "outputs, that are compacted again soon, use LZ4 to save CPU. Large outputs of old "
+            "data use ZSTD, or Zlib if ZSTD is not available, with "
+            "rocksdb_strong_compression_level to save disk space and IO. Other outputs use the "
+            "default compression.");
+TAG_FLAG(rocksdb_adaptive_compaction_compression, advanced);
+TAG_FLAG(rocksdb_adaptive_compaction_compression, runtime);
+
+DEFINE_int64(rocksdb_fast_compression_max_input_bytes, 256_MB,
+             "Compactions with inputs smaller than this use LZ4 compression, see "
+             "rocksdb_adaptive_compaction_compression.");
+TAG_FLAG(rocksdb_fast_compression_max_input_bytes, advanced);
+TAG_FLAG(rocksdb_fast_compression_max_input_bytes, runtime);
+
+DEFINE_int64(rocksdb_strong_compression_min_input_bytes, 4_GB,
+             "Compactions with inputs of at least this size, whose newest data is older than "
+             "rocksdb_strong_compression_min_data_age_sec, use strong compression, see "
+             "rocksdb_adaptive_compaction_compression.");
+TAG_FLAG(rocksdb_strong_compression_min_input_bytes, advanced);
+TAG_FLAG(rocksdb_strong_compression_min_input_bytes, runtime);
+
+DEFINE_int64(rocksdb_strong_compression_min_data_age_sec, 24 * 3600,
+             "Minimal age of the newest data in compaction inputs to use strong compression, see "
+             "rocksdb_adaptive_compaction_compression.");
+TAG_FLAG(rocksdb_strong_compression_min_data_age_sec, advanced);
+TAG_FLAG(rocksdb_strong_compression_min_data_age_sec, runtime);
+
+DEFINE_int32(rocksdb_strong_compression_level, 9,
+             "Compression level used by strong compression, see "
+             "rocksdb_adaptive_compaction_compression.");
+TAG_FLAG(rocksdb_strong_compression_level, advanced);
+TAG_FLAG(rocksdb_strong_compression_level, runtime);
+
 using std::shared_ptr;
 using std::string;
 using std::unique_ptr;
@@ -120,16 +241,22 @@ namespace yb {
 namespace docdb {
 
 std::shared_ptr<rocksdb::BoundaryValuesExtractor> DocBoundaryValuesExtractorInstance();
+std::shared_ptr<rocksdb::ReadFileFilter> CreateHybridTimeFileFilter(
+    HybridTime max_hybrid_time, std::shared_ptr<rocksdb::ReadFileFilter> base_filter);
+std::shared_ptr<rocksdb::ReadFileFilter> CreateKeyBoundsFileFilter(
+    const KeyBounds* key_bounds, std::shared_ptr<rocksdb::ReadFileFilter> base_filter);
 
-void SeekForward(const rocksdb::Slice& slice, rocksdb::Iterator *iter) {
+void SeekForward(const rocksdb::Slice& slice, rocksdb::Iterator *iter,
+                 NextsToAvoidSeekTuner* tuner) {
   if (!iter->Valid() || iter->key().compare(slice) >= 0) {
     return;
   }
-  ROCKSDB_SEEK(iter, slice);
+  ROCKSDB_SEEK_WITH_TUNER(iter, slice, tuner);
 }
 
-void SeekForward(const KeyBytes& key_bytes, rocksdb::Iterator *iter) {
-  SeekForward(key_bytes.AsSlice(), iter);
+void SeekForward(const KeyBytes& key_bytes, rocksdb::Iterator *iter,
+                 NextsToAvoidSeekTuner* tuner) {
+  SeekForward(key_bytes.AsSlice(), iter, tuner);
 }
 
 KeyBytes AppendDocHt(const Slice& key, const DocHybridTime& doc_ht) {
@@ -139,13 +266,13 @@ KeyBytes AppendDocHt(const Slice& key, const DocHybridTime& doc_ht) {
   return KeyBytes(key, Slice(buf, end));
 }
 
-void SeekPastSubKey(const Slice& key, rocksdb::Iterator* iter) {
-  SeekForward(AppendDocHt(key, DocHybridTime::kMin), iter);
+void SeekPastSubKey(const Slice& key, rocksdb::Iterator* iter, NextsToAvoidSeekTuner* tuner) {
+  SeekForward(AppendDocHt(key, DocHybridTime::kMin), iter, tuner);
 }
 
-void SeekOutOfSubKey(KeyBytes* key_bytes, rocksdb::Iterator* iter) {
+void SeekOutOfSubKey(KeyBytes* key_bytes, rocksdb::Iterator* iter, NextsToAvoidSeekTuner* tuner) {
   key_bytes->AppendValueType(ValueType::kMaxByte);
-  SeekForward(*key_bytes, iter);
+  SeekForward(*key_bytes, iter, tuner);
   key_bytes->RemoveValueTypeSuffix(ValueType::kMaxByte);
 }
 
@@ -153,7 +280,8 @@ void PerformRocksDBSeek(
     rocksdb::Iterator *iter,
     const rocksdb::Slice &seek_key,
     const char* file_name,
-    int line) {
+    int line,
+    NextsToAvoidSeekTuner* tuner) {
   int next_count = 0;
   int seek_count = 0;
   if (seek_key.size() == 0) {
@@ -163,22 +291,33 @@ void PerformRocksDBSeek(
     iter->Seek(seek_key);
     ++seek_count;
   } else {
-    for (int nexts = 0; nexts <= FLAGS_max_nexts_to_avoid_seek; nexts++) {
+    const int max_nexts = tuner ? tuner->max_nexts() : FLAGS_max_nexts_to_avoid_seek;
+    for (int nexts = 0; nexts <= max_nexts; nexts++) {
       if (!iter->Valid() || iter->key().compare(seek_key) >= 0) {
         if (FLAGS_trace_docdb_calls) {
           TRACE("Did $0 Next(s) instead of a Seek", nexts);
         }
+        if (tuner) {
+          tuner->TargetReached(nexts);
+        }
         break;
       }
-      if (nexts < FLAGS_max_nexts_to_avoid_seek) {
+      if (nexts < max_nexts) {
         iter->Next();
         ++next_count;
       } else {
         if (FLAGS_trace_docdb_calls) {
-          TRACE("Forced to do an actual Seek after $0 Next(s)", FLAGS_max_nexts_to_avoid_seek);
+          TRACE("Forced to do an actual Seek after $0 Next(s)", max_nexts);
         }
         iter->Seek(seek_key);
         ++seek_count;
+        if (max_nexts > 0) {
+          ++rocksdb::perf_context.iter_forced_seek_count;
+          rocksdb::perf_context.iter_wasted_next_count += max_nexts;
+        }
+        if (tuner) {
+          tuner->SeekForced();
+        }
       }
     }
   }
@@ -248,6 +387,18 @@ unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
     const ReadHybridTime& read_time,
     std::shared_ptr<rocksdb::ReadFileFilter> file_filter,
     const Slice* iterate_upper_bound) {
+  // Records written after the global limit are invisible to this read and cannot cause a read
+  // restart, so SST files that contain only such records could be skipped.
+  if (FLAGS_use_hybrid_time_file_filter && read_time.global_limit.is_valid() &&
+      read_time.global_limit != HybridTime::kMax) {
+    file_filter = CreateHybridTimeFileFilter(read_time.global_limit, std::move(file_filter));
+  }
+  // Split tablets share SST files of the parent tablet until they are compacted, so files that
+  // contain only keys of the other child could be skipped.
+  if (FLAGS_use_key_bounds_file_filter && doc_db.key_bounds &&
+      (!doc_db.key_bounds->lower.empty() || !doc_db.key_bounds->upper.empty())) {
+    file_filter = CreateKeyBoundsFileFilter(doc_db.key_bounds, std::move(file_filter));
+  }
   // TODO(dtxn) do we need separate options for intents db?
   rocksdb::ReadOptions read_opts = PrepareReadOptions(doc_db.regular, bloom_filter_mode,
       user_key_for_filter, query_id, std::move(file_filter), iterate_upper_bound);
@@ -259,6 +410,39 @@ namespace {
 
 std::mutex rocksdb_flags_mutex;
 
+// Returns whether the newest record covered by largest_frontier is older than age_sec seconds.
+bool IsDataOlderThan(const rocksdb::UserFrontier* largest_frontier, int64_t age_sec) {
+  if (age_sec <= 0 || !largest_frontier) {
+    return false;
+  }
+  // The largest frontier contains the hybrid time of the newest record.
+  const auto newest = down_cast<const ConsensusFrontier&>(*largest_frontier).hybrid_time();
+  return newest.is_valid() &&
+         newest.GetPhysicalValueMicros() + age_sec * 1000000 <= GetCurrentTimeMicros();
+}
+
+void SelectCompactionCompression(
+    uint64_t input_size, const rocksdb::UserFrontier* largest_frontier,
+    rocksdb::CompressionType* compression, rocksdb::CompressionOptions* compression_opts) {
+  if (!FLAGS_rocksdb_adaptive_compaction_compression) {
+    return;
+  }
+  if (input_size >= static_cast<uint64_t>(FLAGS_rocksdb_strong_compression_min_input_bytes) &&
+      IsDataOlderThan(largest_frontier, FLAGS_rocksdb_strong_compression_min_data_age_sec)) {
+    for (auto type : {rocksdb::kZSTDNotFinalCompression, rocksdb::kZlibCompression}) {
+      if (rocksdb::CompressionTypeSupported(type)) {
+        *compression = type;
+        compression_opts->level = FLAGS_rocksdb_strong_compression_level;
+        return;
+      }
+    }
+  }
+  if (input_size < static_cast<uint64_t>(FLAGS_rocksdb_fast_compression_max_input_bytes) &&
+      rocksdb::LZ4_Supported()) {
+    *compression = rocksdb::kLZ4Compression;
+  }
+}
+
 // Auto initialize some of the RocksDB flags that are defaulted to -1.
 void AutoInitRocksDBFlags(rocksdb::Options* options) {
   const int kNumCpus = base::NumCPUs();
@@ -372,6 +556,28 @@ rocksdb::InternalIterator* WrapIterator(
   return iterator;
 }
 
+// Creates the rate limiter of flushes and compactions, whose rate follows the rate factor of
+// the background I/O rate controller.
+std::shared_ptr<rocksdb::RateLimiter> CreateCompactFlushRateLimiter() {
+  const auto bytes_per_sec = FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec;
+  auto* controller = BackgroundIoRateController::Instance();
+  auto scaled_rate = [bytes_per_sec](double factor) {
+    return std::max<int64_t>(bytes_per_sec * factor, 1);
+  };
+  std::shared_ptr<rocksdb::RateLimiter> result(
+      rocksdb::NewGenericRateLimiter(scaled_rate(controller->rate_factor())));
+  controller->AddListener(
+      [weak_limiter = std::weak_ptr<rocksdb::RateLimiter>(result), scaled_rate](double factor) {
+    auto limiter = weak_limiter.lock();
+    if (!limiter) {
+      return false;
+    }
+    limiter->SetBytesPerSecond(scaled_rate(factor));
+    return true;
+  });
+  return result;
+}
+
 } // namespace
 
 void InitRocksDBOptions(
@@ -387,6 +593,7 @@ void InitRocksDBOptions(
   options->initial_seqno = FLAGS_initial_seqno;
   options->boundary_extractor = DocBoundaryValuesExtractorInstance();
   options->memory_monitor = tablet_options.memory_monitor;
+  options->memtable_arena_block_pool = tablet_options.memtable_arena_block_pool;
   if (FLAGS_db_write_buffer_size != -1) {
     options->write_buffer_size = FLAGS_db_write_buffer_size;
   } else {
@@ -405,6 +612,17 @@ void InitRocksDBOptions(
 
   options->compression = rocksdb::Snappy_Supported() && FLAGS_enable_ondisk_compression
       ? rocksdb::kSnappyCompression : rocksdb::kNoCompression;
+  if (FLAGS_enable_ondisk_compression && FLAGS_rocksdb_compression_dict_max_bytes > 0) {
+    for (auto type : {rocksdb::kZSTDNotFinalCompression, rocksdb::kLZ4Compression}) {
+      if (rocksdb::CompressionDictSupported(type)) {
+        options->compression = type;
+        options->compression_opts.max_dict_bytes = FLAGS_rocksdb_compression_dict_max_bytes;
+        break;
+      }
+    }
+  }
+  options->compaction_compression_selector =
+      std::make_shared<rocksdb::CompactionCompressionSelector>(&SelectCompactionCompression);
 
   options->listeners.insert(
       options->listeners.end(), tablet_options.listeners.begin(),
@@ -414,6 +632,7 @@ void InitRocksDBOptions(
   rocksdb::BlockBasedTableOptions table_options;
   if (tablet_options.block_cache) {
     table_options.block_cache = tablet_options.block_cache;
+    table_options.persistent_cache = tablet_options.persistent_cache;
     // Cache the bloom filters in the block cache.
     table_options.cache_index_and_filter_blocks = true;
   } else {
@@ -422,6 +641,8 @@ void InitRocksDBOptions(
   }
   table_options.block_size = FLAGS_db_block_size_bytes;
   table_options.filter_block_size = FLAGS_db_filter_block_size_bytes;
+  table_options.fixed_size_filter_prefetch_bytes =
+      std::max<int64_t>(FLAGS_db_filter_block_prefetch_size_bytes, 0);
   table_options.index_block_size = FLAGS_db_index_block_size_bytes;
   table_options.min_keys_per_index_block = FLAGS_db_min_keys_per_index_block;
 
@@ -437,6 +658,12 @@ void InitRocksDBOptions(
     table_options.index_type = rocksdb::IndexType::kBinarySearch;
   }
 
+  if (FLAGS_use_docdb_data_block_hash_index) {
+    table_options.data_block_hash_index_key_transform =
+        std::make_shared<DocDbHybridTimeSuffixTransform>();
+  }
+  table_options.data_block_shared_suffix_encoding = FLAGS_use_docdb_shared_suffix_key_encoding;
+
   options->table_factory.reset(rocksdb::NewBlockBasedTableFactory(table_options));
 
   // Compaction related options.
@@ -448,6 +675,21 @@ void InitRocksDBOptions(
     : rocksdb::CompactionStyle::kCompactionStyleNone;
   // Set the number of levels to 1.
   options->num_levels = 1;
+  if (FLAGS_rocksdb_hybrid_compaction) {
+    // Level 0 keeps flushed files as overlapping sorted runs, that are compacted together into
+    // the lower levels. Sizes of the lower levels are derived from the size of the last level, so
+    // the space amplification is bounded by the level size multiplier.
+    if (compactions_enabled) {
+      options->compaction_style = rocksdb::CompactionStyle::kCompactionStyleLevel;
+    }
+    options->num_levels = std::max(FLAGS_rocksdb_hybrid_compaction_num_levels, 2);
+    options->level_compaction_dynamic_level_bytes = true;
+    options->target_file_size_base = FLAGS_rocksdb_hybrid_compaction_target_file_size;
+    options->target_file_size_multiplier = 1;
+    options->max_bytes_for_level_base = FLAGS_rocksdb_hybrid_compaction_level_base_bytes;
+    options->max_bytes_for_level_multiplier =
+        std::max(FLAGS_rocksdb_hybrid_compaction_level_size_multiplier, 2);
+  }
 
   AutoInitRocksDBFlags(options);
   if (compactions_enabled) {
@@ -467,8 +709,12 @@ void InitRocksDBOptions(
         FLAGS_rocksdb_universal_compaction_min_merge_width;
     options->compaction_size_threshold_bytes = FLAGS_rocksdb_compaction_size_threshold_bytes;
     if (FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec > 0) {
-      options->rate_limiter.reset(
-          rocksdb::NewGenericRateLimiter(FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec));
+      if (FLAGS_rocksdb_compact_flush_rate_limit_shared) {
+        static auto shared_rate_limiter = CreateCompactFlushRateLimiter();
+        options->rate_limiter = shared_rate_limiter;
+      } else {
+        options->rate_limiter = CreateCompactFlushRateLimiter();
+      }
     }
   } else {
     options->level0_slowdown_writes_trigger = std::numeric_limits<int>::max();
@@ -480,14 +726,68 @@ void InitRocksDBOptions(
     options->max_file_size_for_compaction = max_file_size_for_compaction;
   }
 
+  if (FLAGS_rocksdb_max_subcompactions > 1) {
+    options->max_subcompactions = FLAGS_rocksdb_max_subcompactions;
+    options->subcompaction_boundary_key_transform =
+        std::make_shared<DocDbDocKeyPrefixTransform>();
+  }
+
   options->max_write_buffer_number = FLAGS_rocksdb_max_write_buffer_number;
+  options->use_direct_io_for_compaction = FLAGS_rocksdb_use_direct_io_for_compaction;
 
-  options->memtable_factory = std::make_shared<rocksdb::SkipListFactory>(
-      0 /* lookahead */, rocksdb::ConcurrentWrites::kFalse);
+  SetConcurrentMemtableWrites(options, FLAGS_rocksdb_allow_concurrent_memtable_write);
 
   options->iterator_replacer = std::make_shared<rocksdb::IteratorReplacer>(&WrapIterator);
 }
 
+void SetBloomFilterRangeComponents(rocksdb::Options* options, size_t num_range_components) {
+  if (!FLAGS_use_docdb_aware_bloom_filter) {
+    return;
+  }
+  auto table_options = *static_cast<rocksdb::BlockBasedTableOptions*>(
+      options->table_factory->GetOptions());
+  table_options.filter_policy.reset(new DocDbAwareFilterPolicy(
+      table_options.filter_block_size * 8, options->info_log.get(), num_range_components));
+  options->table_factory.reset(rocksdb::NewBlockBasedTableFactory(table_options));
+}
+
+bool BloomFilterCoversRange(rocksdb::DB* db, const Slice& lower, const Slice& upper) {
+  auto table_options = static_cast<const rocksdb::BlockBasedTableOptions*>(
+      db->GetOptions().table_factory->GetOptions());
+  auto policy = table_options ? dynamic_cast<const DocDbAwareFilterPolicy*>(
+      table_options->filter_policy.get()) : nullptr;
+  if (!policy || policy->num_range_components() == 0) {
+    // Hashed components are checked by the caller.
+    return true;
+  }
+  auto transformer = policy->GetKeyTransformer();
+  return transformer->CanFilter(lower) && upper.starts_with(transformer->Transform(lower));
+}
+
+void SetConcurrentMemtableWrites(rocksdb::Options* options, bool enabled) {
+  options->allow_concurrent_memtable_write = enabled;
+  options->enable_write_thread_adaptive_yield = enabled;
+  options->memtable_factory = std::make_shared<rocksdb::SkipListFactory>(
+      0 /* lookahead */, rocksdb::ConcurrentWrites(enabled));
+}
+
+void SetColdStoragePath(
+    const std::string& db_dir, const std::string& cold_dir, rocksdb::Options* options) {
+  if (cold_dir.empty()) {
+    return;
+  }
+  constexpr uint32_t kColdPathId = 1;
+  options->db_paths = {
+      rocksdb::DbPath(db_dir, std::numeric_limits<uint64_t>::max()),
+      rocksdb::DbPath(cold_dir, std::numeric_limits<uint64_t>::max()) };
+  auto selector = [](const rocksdb::UserFrontier* largest_frontier, uint32_t default_path_id) {
+    return IsDataOlderThan(largest_frontier, FLAGS_tiered_storage_cold_data_age_sec)
+        ? kColdPathId : default_path_id;
+  };
+  options->compaction_output_path_selector =
+      std::make_shared<rocksdb::CompactionOutputPathSelector>(std::move(selector));
+}
+
 void SetLogPrefix(rocksdb::Options* options, const std::string& log_prefix) {
   options->log_prefix = log_prefix;
   options->info_log = std::make_shared<YBRocksDBLogger>(options->log_prefix);
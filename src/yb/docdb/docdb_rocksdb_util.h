@@ -38,30 +38,39 @@ class IntentAwareIterator;
 
 // See to a rocksdb point that is at least sub_doc_key.
 // If the iterator is already positioned far enough, does not perform a seek.
-void SeekForward(const rocksdb::Slice& slice, rocksdb::Iterator *iter);
+// The seek functions below use tuner to choose the number of nexts tried before a seek, when it is
+// specified, see PerformRocksDBSeek.
+void SeekForward(const rocksdb::Slice& slice, rocksdb::Iterator *iter,
+                 NextsToAvoidSeekTuner* tuner = nullptr);
 
-void SeekForward(const KeyBytes& key_bytes, rocksdb::Iterator *iter);
+void SeekForward(const KeyBytes& key_bytes, rocksdb::Iterator *iter,
+                 NextsToAvoidSeekTuner* tuner = nullptr);
 
 // When we replace HybridTime::kMin in the end of seek key, next seek will skip older versions of
 // this key, but will not skip any subkeys in its subtree. If the iterator is already positioned far
 // enough, does not perform a seek.
-void SeekPastSubKey(const Slice& key, rocksdb::Iterator* iter);
+void SeekPastSubKey(const Slice& key, rocksdb::Iterator* iter,
+                    NextsToAvoidSeekTuner* tuner = nullptr);
 
 // Seek out of the given SubDocKey. For efficiency, the method that takes a non-const KeyBytes
 // pointer avoids memory allocation by using the KeyBytes buffer to prepare the key to seek to by
 // appending an extra byte. The appended byte is removed when the method returns.
-void SeekOutOfSubKey(KeyBytes* key_bytes, rocksdb::Iterator* iter);
+void SeekOutOfSubKey(KeyBytes* key_bytes, rocksdb::Iterator* iter,
+                     NextsToAvoidSeekTuner* tuner = nullptr);
 
 KeyBytes AppendDocHt(const Slice& key, const DocHybridTime& doc_ht);
 
 // A wrapper around the RocksDB seek operation that uses Next() up to the configured number of
 // times to avoid invalidating iterator state. In debug mode it also allows printing detailed
 // information about RocksDB seeks.
+// When tuner is specified, the number of Next() calls is taken from it, and it is informed whether
+// they reached the seek key.
 void PerformRocksDBSeek(
     rocksdb::Iterator *iter,
     const rocksdb::Slice &seek_key,
     const char* file_name,
-    int line);
+    int line,
+    NextsToAvoidSeekTuner* tuner = nullptr);
 
 // TODO: is there too much overhead in passing file name and line here in release mode?
 #define ROCKSDB_SEEK(iter, key) \
@@ -69,6 +78,11 @@ void PerformRocksDBSeek(
     PerformRocksDBSeek((iter), (key), __FILE__, __LINE__); \
   } while (0)
 
+#define ROCKSDB_SEEK_WITH_TUNER(iter, key, tuner) \
+  do { \
+    PerformRocksDBSeek((iter), (key), __FILE__, __LINE__, (tuner)); \
+  } while (0)
+
 enum class BloomFilterMode {
   USE_BLOOM_FILTER,
   DONT_USE_BLOOM_FILTER,
@@ -113,6 +127,23 @@ void InitRocksDBOptions(
     const std::shared_ptr<rocksdb::Statistics>& statistics,
     const tablet::TabletOptions& tablet_options);
 
+// Makes the DocDB-aware bloom filter, if it is used, also take into account the first
+// num_range_components range components of keys. See DocDbAwareFilterPolicy.
+void SetBloomFilterRangeComponents(rocksdb::Options* options, size_t num_range_components);
+
+// Returns true if the bloom filter of the DB could be used to exclude SST files for the scan from
+// lower to upper, i.e. all keys in this range have the same bloom filter key.
+bool BloomFilterCoversRange(rocksdb::DB* db, const Slice& lower, const Slice& upper);
+
+// Configures parallel memtable inserts by the writers of a write group. Memtables that support
+// them do not support in memory erase of single deletes.
+void SetConcurrentMemtableWrites(rocksdb::Options* options, bool enabled);
+
+// Adds cold_dir as the second db path of RocksDB and places compaction outputs with data older
+// than tiered_storage_cold_data_age_sec there. Does nothing if cold_dir is empty.
+void SetColdStoragePath(
+    const std::string& db_dir, const std::string& cold_dir, rocksdb::Options* options);
+
 // Sets logs prefix for RocksDB options. This will also reinitialize options->info_log.
 void SetLogPrefix(rocksdb::Options* options, const std::string& log_prefix);
 
@@ -0,0 +1,195 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/docdb_sst_analyzer.h"
+
+#include <limits>
+#include <sstream>
+
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_kv_util.h"
+#include "yb/docdb/primitive_value.h"
+#include "yb/docdb/value.h"
+
+#include "yb/gutil/bits.h"
+
+#include "yb/util/format.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+// Upper limits of record age buckets, in seconds.
+const std::pair<int64_t, const char*> kAgeBuckets[] = {
+  { 0, "future" },
+  { 60, "< 1 minute" },
+  { 60 * 60, "< 1 hour" },
+  { 24 * 60 * 60, "< 1 day" },
+  { 7 * 24 * 60 * 60, "< 1 week" },
+  { 30 * 24 * 60 * 60, "< 30 days" },
+  { std::numeric_limits<int64_t>::max(), ">= 30 days" },
+};
+
+std::string SubKeyLabel(const PrimitiveValue& subkey) {
+  switch (subkey.value_type()) {
+    case ValueType::kColumnId:
+      return Format("column $0", subkey.GetColumnId());
+    case ValueType::kSystemColumnId:
+      return Format("system column $0", subkey.GetColumnId());
+    default:
+      return Format("subkey $0", subkey.value_type());
+  }
+}
+
+double Percent(uint64_t part, uint64_t total) {
+  return total ? 100.0 * part / total : 0;
+}
+
+} // namespace
+
+DocDBSstAnalyzer::DocDBSstAnalyzer(MicrosTime now_micros) : now_micros_(now_micros) {}
+
+void DocDBSstAnalyzer::Add(const Slice& user_key, const Slice& value) {
+  ++num_entries_;
+  if (!DoAdd(user_key, value).ok()) {
+    ++num_undecodable_;
+  }
+}
+
+Status DocDBSstAnalyzer::DoAdd(const Slice& user_key, const Slice& value) {
+  int ht_size = 0;
+  RETURN_NOT_OK(CheckHybridTimeSizeAndValueType(user_key, &ht_size));
+  DocHybridTime doc_ht;
+  RETURN_NOT_OK(DecodeHybridTimeFromEndOfKey(user_key, &doc_ht));
+  Slice key_without_ht(user_key.data(), user_key.size() - ht_size - 1);
+  auto doc_key_size = VERIFY_RESULT(DocKey::EncodedSize(key_without_ht, DocKeyPart::WHOLE_DOC_KEY));
+
+  std::string label = "row";
+  if (doc_key_size < key_without_ht.size()) {
+    Slice subkeys(key_without_ht.data() + doc_key_size, key_without_ht.end());
+    PrimitiveValue first_subkey;
+    RETURN_NOT_OK(PrimitiveValue::DecodeKey(&subkeys, &first_subkey));
+    label = SubKeyLabel(first_subkey);
+  }
+
+  ValueType value_type;
+  MonoDelta ttl;
+  RETURN_NOT_OK(Value::DecodePrimitiveValueType(value, &value_type, nullptr, &ttl));
+
+  Slice doc_key(key_without_ht.data(), doc_key_size);
+  if (doc_key != current_doc_key_) {
+    FinishRow();
+    current_doc_key_.assign(doc_key.cdata(), doc_key.size());
+  }
+  ++current_row_entries_;
+  if (key_without_ht != current_key_) {
+    FinishKey();
+    current_key_.assign(key_without_ht.cdata(), key_without_ht.size());
+  }
+  ++current_key_versions_;
+
+  auto& size_stats = by_subkey_[label];
+  ++size_stats.entries;
+  size_stats.key_bytes += user_key.size();
+  size_stats.value_bytes += value.size();
+
+  if (value_type == ValueType::kTombstone) {
+    ++num_tombstones_;
+  }
+  if (!ttl.Equals(Value::kMaxTtl)) {
+    ++num_with_ttl_;
+  }
+
+  auto age_seconds = static_cast<int64_t>(
+      now_micros_ - doc_ht.hybrid_time().GetPhysicalValueMicros()) / 1000000;
+  for (const auto& bucket : kAgeBuckets) {
+    if (age_seconds < bucket.first) {
+      ++by_age_[bucket.first];
+      break;
+    }
+  }
+  return Status::OK();
+}
+
+void DocDBSstAnalyzer::FinishKey() {
+  if (current_key_versions_) {
+    AddToHistogram(current_key_versions_, &versions_per_key_);
+    current_key_versions_ = 0;
+  }
+}
+
+void DocDBSstAnalyzer::FinishRow() {
+  if (current_row_entries_) {
+    ++num_rows_;
+    AddToHistogram(current_row_entries_, &entries_per_row_);
+    current_row_entries_ = 0;
+  }
+}
+
+void DocDBSstAnalyzer::AddToHistogram(uint64_t value, Log2Histogram* histogram) {
+  ++(*histogram)[Bits::Log2Floor64(value)];
+}
+
+std::string DocDBSstAnalyzer::HistogramToString(const Log2Histogram& histogram) {
+  std::ostringstream out;
+  for (const auto& bucket_and_count : histogram) {
+    out << "  [" << (1ULL << bucket_and_count.first) << ", "
+        << (1ULL << (bucket_and_count.first + 1)) << "): " << bucket_and_count.second << "\n";
+  }
+  return out.str();
+}
+
+std::string DocDBSstAnalyzer::Report() const {
+  // Account the last key and row, which are still being collected.
+  auto versions_per_key = versions_per_key_;
+  if (current_key_versions_) {
+    AddToHistogram(current_key_versions_, &versions_per_key);
+  }
+  auto entries_per_row = entries_per_row_;
+  auto num_rows = num_rows_;
+  if (current_row_entries_) {
+    AddToHistogram(current_row_entries_, &entries_per_row);
+    ++num_rows;
+  }
+
+  std::ostringstream out;
+  auto decoded = num_entries_ - num_undecodable_;
+  out << "DocDB entries: " << num_entries_ << " (not regular DocDB records: " << num_undecodable_
+      << ")\n"
+      << "Rows: " << num_rows << "\n"
+      << "Tombstones: " << num_tombstones_ << " (" << Percent(num_tombstones_, decoded) << "%)\n"
+      << "With TTL: " << num_with_ttl_ << " (" << Percent(num_with_ttl_, decoded) << "%)\n";
+
+  out << "Bytes by first subkey:\n";
+  for (const auto& label_and_stats : by_subkey_) {
+    const auto& stats = label_and_stats.second;
+    out << "  " << label_and_stats.first << ": entries: " << stats.entries
+        << ", key bytes: " << stats.key_bytes << ", value bytes: " << stats.value_bytes << "\n";
+  }
+
+  out << "Versions per key:\n" << HistogramToString(versions_per_key);
+  out << "Entries per row:\n" << HistogramToString(entries_per_row);
+
+  out << "Entries by hybrid time age:\n";
+  for (const auto& bucket : kAgeBuckets) {
+    auto it = by_age_.find(bucket.first);
+    if (it != by_age_.end()) {
+      out << "  " << bucket.second << ": " << it->second << "\n";
+    }
+  }
+  return out.str();
+}
+
+} // namespace docdb
+} // namespace yb
@@ -0,0 +1,85 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_DOCDB_SST_ANALYZER_H
+#define YB_DOCDB_DOCDB_SST_ANALYZER_H
+
+#include <map>
+#include <string>
+
+#include "yb/rocksdb/sst_dump_tool.h"
+
+#include "yb/util/physical_time.h"
+#include "yb/util/slice.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace docdb {
+
+// Breaks down the key space of regular DocDB SST files: bytes per column, versions per key and
+// per row, tombstone and TTL ratios, and the age of records by hybrid time.
+// Keys that are not regular SubDocKeys with a hybrid time, e.g. ones from the intents DB, are only
+// counted.
+class DocDBSstAnalyzer : public rocksdb::SstKeyValueAnalyzer {
+ public:
+  // Ages of records are computed relatively to now_micros.
+  explicit DocDBSstAnalyzer(MicrosTime now_micros);
+
+  void Add(const Slice& user_key, const Slice& value) override;
+
+  std::string Report() const override;
+
+ private:
+  struct SizeStats {
+    uint64_t entries = 0;
+    uint64_t key_bytes = 0;
+    uint64_t value_bytes = 0;
+  };
+
+  // Number of occurrences by power of two bucket, i.e. bucket n holds values in [2^n, 2^(n+1)).
+  typedef std::map<int, uint64_t> Log2Histogram;
+
+  CHECKED_STATUS DoAdd(const Slice& user_key, const Slice& value);
+  void FinishKey();
+  void FinishRow();
+
+  static void AddToHistogram(uint64_t value, Log2Histogram* histogram);
+  static std::string HistogramToString(const Log2Histogram& histogram);
+
+  const MicrosTime now_micros_;
+
+  uint64_t num_entries_ = 0;
+  uint64_t num_undecodable_ = 0;
+  uint64_t num_tombstones_ = 0;
+  uint64_t num_with_ttl_ = 0;
+  uint64_t num_rows_ = 0;
+
+  // Sizes by the first subkey of entries, e.g. column id, or "row" for entries without subkeys.
+  std::map<std::string, SizeStats> by_subkey_;
+
+  // Number of entries by age limit in seconds, see kAgeBuckets.
+  std::map<int64_t, uint64_t> by_age_;
+
+  std::string current_key_;
+  uint64_t current_key_versions_ = 0;
+  Log2Histogram versions_per_key_;
+
+  std::string current_doc_key_;
+  uint64_t current_row_entries_ = 0;
+  Log2Histogram entries_per_row_;
+};
+
+} // namespace docdb
+} // namespace yb
+
+#endif // YB_DOCDB_DOCDB_SST_ANALYZER_H
@@ -0,0 +1,27 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// sst_dump with DocDB aware --command=analyze, e.g.:
+//   docdb_sst_dump --command=analyze --file=<tablet rocksdb dir or sst file>
+
+#include "yb/docdb/docdb_sst_analyzer.h"
+
+#include "yb/gutil/walltime.h"
+
+#include "yb/rocksdb/sst_dump_tool.h"
+
+int main(int argc, char** argv) {
+  rocksdb::SSTDumpTool tool(
+      std::make_unique<yb::docdb::DocDBSstAnalyzer>(GetCurrentTimeMicros()));
+  return tool.Run(argc, argv);
+}
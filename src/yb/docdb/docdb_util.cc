@@ -194,6 +194,8 @@ Status DocDBRocksDBUtil::InitCommonRocksDBOptions() {
   rocksdb_options_.compaction_filter_factory =
       std::make_shared<docdb::DocDBCompactionFilterFactory>(
           retention_policy_, &KeyBounds::kNoBounds);
+  rocksdb_options_.table_properties_collector_factories.push_back(
+      std::make_shared<docdb::DocDBTablePropertiesCollectorFactory>());
   return Status::OK();
 }
 
@@ -17,6 +17,7 @@
 #include "yb/common/ql_value.h"
 #include "yb/common/transaction-test-util.h"
 
+#include "yb/docdb/doc_pgsql_scanspec.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
 #include "yb/docdb/docdb.h"
 #include "yb/docdb/docdb_test_base.h"
@@ -30,6 +31,7 @@
 #include "yb/util/test_util.h"
 
 DECLARE_bool(docdb_sort_weak_intents_in_tests);
+DECLARE_bool(use_table_tombstone_file_filter);
 
 namespace yb {
 namespace docdb {
@@ -1059,5 +1061,157 @@ TEST_F(DocRowwiseIteratorTest, ScanWithinTheSameTxn) {
   ASSERT_FALSE(ASSERT_RESULT(iter.HasNext()));
 }
 
+TEST_F(DocRowwiseIteratorTest, NextRowBatch) {
+  constexpr int kNumRows = 5;
+  for (int i = 0; i != kNumRows; ++i) {
+    const KeyBytes encoded_doc_key(DocKey(PrimitiveValues(Format("row$0", i), i)).Encode());
+    ASSERT_OK(SetPrimitive(
+        DocPath(encoded_doc_key, PrimitiveValue(40_ColId)),
+        PrimitiveValue(i * 10), HybridTime::FromMicros(1000)));
+  }
+
+  const Schema &schema = kSchemaForIteratorTests;
+  const Schema &projection = kProjectionForIteratorTests;
+  DocRowwiseIterator iter(
+      projection, schema, kNonTransactionalOperationContext, doc_db(),
+      CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(2000));
+  ASSERT_OK(iter.Init());
+
+  std::vector<QLTableRow::SharedPtr> rows;
+  std::vector<int64_t> values;
+  QLValue value;
+  for (;;) {
+    const auto num_rows = ASSERT_RESULT(iter.NextRowBatch(projection, 2, &rows));
+    ASSERT_LE(num_rows, 2);
+    ASSERT_GE(rows.size(), 2);
+    for (size_t i = 0; i != num_rows; ++i) {
+      ASSERT_OK(rows[i]->GetValue(projection.column_id(1), &value));
+      values.push_back(value.int64_value());
+      ASSERT_OK(rows[i]->GetValue(projection.column_id(0), &value));
+      ASSERT_TRUE(value.IsNull());
+    }
+    if (num_rows < 2) {
+      break;
+    }
+  }
+  ASSERT_EQ((std::vector<int64_t>{0, 10, 20, 30, 40}), values);
+  ASSERT_FALSE(ASSERT_RESULT(iter.HasNext()));
+}
+
+// Row keys returned with a batch should match the rows of the batch, not the current position of
+// the iterator.
+TEST_F(DocRowwiseIteratorTest, NextRowBatchRowKeys) {
+  constexpr int kNumRows = 5;
+  std::vector<std::string> expected_keys;
+  for (int i = 0; i != kNumRows; ++i) {
+    const KeyBytes encoded_doc_key(DocKey(PrimitiveValues(Format("row$0", i), i)).Encode());
+    expected_keys.push_back(encoded_doc_key.data());
+    ASSERT_OK(SetPrimitive(
+        DocPath(encoded_doc_key, PrimitiveValue(40_ColId)),
+        PrimitiveValue(i * 10), HybridTime::FromMicros(1000)));
+  }
+
+  const Schema &schema = kSchemaForIteratorTests;
+  const Schema &projection = kProjectionForIteratorTests;
+  DocRowwiseIterator iter(
+      projection, schema, kNonTransactionalOperationContext, doc_db(),
+      CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(2000));
+  ASSERT_OK(iter.Init());
+
+  std::vector<QLTableRow::SharedPtr> rows;
+  std::vector<std::string> row_keys;
+  std::vector<std::string> keys;
+  for (;;) {
+    const auto num_rows = ASSERT_RESULT(iter.NextRowBatch(projection, 3, &rows, &row_keys));
+    ASSERT_GE(row_keys.size(), 3);
+    keys.insert(keys.end(), row_keys.begin(), row_keys.begin() + num_rows);
+    if (num_rows < 3) {
+      break;
+    }
+  }
+  ASSERT_EQ(expected_keys, keys);
+}
+
+// Rows read in batches are cleared and reused, so columns of previous rows should not be visible.
+TEST_F(DocRowwiseIteratorTest, ReuseTableRow) {
+  constexpr ColumnIdRep kOtherColumnId = std::numeric_limits<ColumnIdRep>::max() - 1;
+  QLTableRow row;
+  auto& column = row.AllocColumn(40_ColId);
+  column.value.set_string_value("value");
+  column.ttl_seconds = 10;
+  column.write_time = 1000;
+  row.AllocColumn(kOtherColumnId).value.set_int64_value(1);
+  ASSERT_EQ(2, row.ColumnCount());
+
+  row.Clear();
+  ASSERT_TRUE(row.IsEmpty());
+  ASSERT_FALSE(row.IsColumnSpecified(40_ColId));
+  ASSERT_FALSE(row.IsColumnSpecified(kOtherColumnId));
+  ASSERT_EQ(nullptr, row.GetColumn(40_ColId));
+
+  const auto& reused = row.AllocColumn(40_ColId);
+  ASSERT_EQ(QLValuePB::VALUE_NOT_SET, reused.value.value_case());
+  ASSERT_EQ(0, reused.ttl_seconds);
+  ASSERT_EQ(QLTableColumn::kUninitializedWriteTime, reused.write_time);
+  ASSERT_EQ(1, row.ColumnCount());
+  ASSERT_TRUE(row.IsColumnSpecified(40_ColId));
+}
+
+TEST_F(DocRowwiseIteratorTest, ScanTruncatedColocatedTable) {
+  constexpr PgTableOid pgtable_id(0x4001);
+  const Schema schema({
+          ColumnSchema("a", DataType::STRING, /* is_nullable = */ false),
+          ColumnSchema("c", DataType::INT64, true)
+      }, {
+          10_ColId,
+          20_ColId
+      }, 1, TableProperties(), Uuid(boost::uuids::nil_uuid()), pgtable_id);
+  Schema projection;
+  ASSERT_OK(schema.CreateProjectionByNames({"c"}, &projection));
+
+  auto write_row = [this, pgtable_id](const std::string& key, int64_t value, HybridTime ht) {
+    DocKey doc_key(pgtable_id);
+    doc_key.ResizeRangeComponents(1);
+    doc_key.SetRangeComponent(PrimitiveValue(key), 0 /* idx */);
+    return SetPrimitive(
+        DocPath(doc_key.Encode(), PrimitiveValue(20_ColId)), PrimitiveValue(value), ht);
+  };
+
+  // INSERT INTO t VALUES ("r1", 1), ("r2", 2); TRUNCATE TABLE t; INSERT INTO t VALUES ("r3", 3);
+  ASSERT_OK(write_row("r1", 1, 1000_usec_ht));
+  ASSERT_OK(write_row("r2", 2, 2000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+  ASSERT_OK(SetPrimitive(
+      DocPath(DocKey(pgtable_id).Encode()), Value(PrimitiveValue::kTombstone), 3000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+  ASSERT_OK(write_row("r3", 3, 4000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+
+  auto scan = [this, &schema, &projection](MicrosTime read_time) -> Result<std::vector<int64_t>> {
+    DocRowwiseIterator iter(
+        projection, schema, kNonTransactionalOperationContext, doc_db(),
+        CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(read_time));
+    DocPgsqlScanSpec spec(
+        schema, rocksdb::kDefaultQueryId, {} /* hashed_components */, nullptr /* condition */,
+        boost::none /* hash_code */, boost::none /* max_hash_code */, nullptr /* where_expr */);
+    RETURN_NOT_OK(iter.Init(spec));
+    std::vector<int64_t> result;
+    QLTableRow row;
+    QLValue value;
+    while (VERIFY_RESULT(iter.HasNext())) {
+      RETURN_NOT_OK(iter.NextRow(&row));
+      RETURN_NOT_OK(row.GetValue(projection.column_id(0), &value));
+      result.push_back(value.int64_value());
+    }
+    return result;
+  };
+
+  for (bool use_filter : {false, true}) {
+    FLAGS_use_table_tombstone_file_filter = use_filter;
+    ASSERT_EQ((std::vector<int64_t>{1, 2}), ASSERT_RESULT(scan(2500)));
+    ASSERT_EQ((std::vector<int64_t>{3}), ASSERT_RESULT(scan(5000)));
+  }
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -0,0 +1,52 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/hot_keys.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+class HotKeysTest : public YBTest {
+};
+
+TEST_F(HotKeysTest, KeepsMostRecentDistinctKeys) {
+  HotKeys hot_keys(/* capacity */ 3, /* sample_rate */ 1);
+  ASSERT_TRUE(hot_keys.Get().empty());
+
+  hot_keys.Record("a");
+  hot_keys.Record("b");
+  hot_keys.Record("a");
+  ASSERT_EQ((std::vector<std::string>{"a", "b"}), hot_keys.Get());
+
+  hot_keys.Record("c");
+  hot_keys.Record("d");
+  ASSERT_EQ((std::vector<std::string>{"d", "c", "a"}), hot_keys.Get());
+}
+
+TEST_F(HotKeysTest, Sampling) {
+  constexpr uint32_t kSampleRate = 10;
+  HotKeys hot_keys(/* capacity */ 100, kSampleRate);
+  for (int i = 0; i != 100; ++i) {
+    hot_keys.Record(std::to_string(i));
+  }
+  auto keys = hot_keys.Get();
+  ASSERT_EQ(100 / kSampleRate, keys.size());
+  ASSERT_EQ("90", keys.front());
+  ASSERT_EQ("0", keys.back());
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,51 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/hot_keys.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace yb {
+namespace docdb {
+
+HotKeys::HotKeys(size_t capacity, uint32_t sample_rate)
+    : capacity_(std::max<size_t>(capacity, 1)), sample_rate_(std::max<uint32_t>(sample_rate, 1)) {
+}
+
+void HotKeys::DoRecord(const Slice& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (keys_.size() < capacity_) {
+    keys_.push_back(key.ToBuffer());
+  } else {
+    keys_[next_].assign(key.cdata(), key.size());
+  }
+  next_ = (next_ + 1) % capacity_;
+}
+
+std::vector<std::string> HotKeys::Get() const {
+  std::vector<std::string> result;
+  std::unordered_set<std::string> seen;
+  std::lock_guard<std::mutex> lock(mutex_);
+  result.reserve(keys_.size());
+  for (size_t i = 0; i != keys_.size(); ++i) {
+    const auto& key = keys_[(next_ + keys_.size() - 1 - i) % keys_.size()];
+    if (seen.insert(key).second) {
+      result.push_back(key);
+    }
+  }
+  return result;
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,70 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_HOT_KEYS_H
+#define YB_DOCDB_HOT_KEYS_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/util/slice.h"
+
+namespace yb {
+namespace docdb {
+
+// Sample of the encoded DocKeys recently read from a tablet.
+//
+// It approximates the read working set of the tablet, so the block cache of a new leader could be
+// warmed up by seeking to these keys after a leadership transfer. Keys are used instead of block
+// handles, because different replicas of a tablet have different SST files.
+//
+// One of each sample_rate recorded keys is kept, up to capacity most recent sampled keys.
+class HotKeys {
+ public:
+  HotKeys(size_t capacity, uint32_t sample_rate);
+
+  HotKeys(const HotKeys&) = delete;
+  void operator=(const HotKeys&) = delete;
+
+  void Record(const Slice& key) {
+    if (sample_rate_ > 1 &&
+        counter_.fetch_add(1, std::memory_order_relaxed) % sample_rate_ != 0) {
+      return;
+    }
+    DoRecord(key);
+  }
+
+  // Returns distinct sampled keys, most recently sampled first.
+  std::vector<std::string> Get() const;
+
+ private:
+  void DoRecord(const Slice& key);
+
+  const size_t capacity_;
+  const uint32_t sample_rate_;
+  std::atomic<uint64_t> counter_{0};
+
+  mutable std::mutex mutex_;
+  // Ring buffer of sampled keys, next_ is the position of the next key to be written.
+  std::vector<std::string> keys_ GUARDED_BY(mutex_);
+  size_t next_ GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif // YB_DOCDB_HOT_KEYS_H
@@ -26,6 +26,8 @@
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/docdb-internal.h"
 #include "yb/docdb/intent.h"
+#include "yb/docdb/intents_summary.h"
+#include "yb/docdb/operation_cost.h"
 #include "yb/docdb/value.h"
 
 #include "yb/server/hybrid_clock.h"
@@ -245,11 +247,17 @@ IntentAwareIterator::IntentAwareIterator(
           DocHybridTime(read_time_.global_limit, kMaxWriteId).EncodedInDocDbFormat()),
       txn_op_context_(txn_op_context),
       transaction_status_cache_(
-          txn_op_context ? &txn_op_context->txn_status_manager : nullptr, read_time, deadline) {
+          txn_op_context ? &txn_op_context->txn_status_manager : nullptr, read_time, deadline),
+      nexts_tuner_(doc_db.nexts_to_avoid_seek_stats) {
   VLOG(4) << "IntentAwareIterator, read_time: " << read_time
           << ", txn_op_context: " << txn_op_context_;
 
   if (txn_op_context.is_initialized()) {
+    // Epoch should be obtained before intents DB iterator is created, see IntentsSummary.
+    if (doc_db.intents_summary && !doc_db.intents_summary->disabled()) {
+      intents_summary_ = doc_db.intents_summary;
+      intents_summary_epoch_ = intents_summary_->CurrentEpoch();
+    }
     intent_iter_ = docdb::CreateRocksDBIterator(doc_db.intents,
                                                 doc_db.key_bounds,
                                                 docdb::BloomFilterMode::DONT_USE_BLOOM_FILTER,
@@ -282,7 +290,7 @@ void IntentAwareIterator::Seek(const Slice& key) {
     return;
   }
 
-  ROCKSDB_SEEK(&iter_, key);
+  ROCKSDB_SEEK_WITH_TUNER(&iter_, key, &nexts_tuner_);
   skip_future_records_needed_ = true;
 
   if (intent_iter_.Initialized()) {
@@ -328,7 +336,7 @@ void IntentAwareIterator::SeekPastSubKey(const Slice& key) {
     return;
   }
 
-  docdb::SeekPastSubKey(key, &iter_);
+  docdb::SeekPastSubKey(key, &iter_, &nexts_tuner_);
   skip_future_records_needed_ = true;
   if (intent_iter_.Initialized() && status_.ok()) {
     seek_intent_iter_needed_ = SeekIntentIterNeeded::kSeekForward;
@@ -344,7 +352,7 @@ void IntentAwareIterator::SeekOutOfSubDoc(KeyBytes* key_bytes) {
     return;
   }
 
-  docdb::SeekOutOfSubKey(key_bytes, &iter_);
+  docdb::SeekOutOfSubKey(key_bytes, &iter_, &nexts_tuner_);
   skip_future_records_needed_ = true;
   if (intent_iter_.Initialized() && status_.ok()) {
     seek_intent_iter_needed_ = SeekIntentIterNeeded::kSeekForward;
@@ -429,7 +437,7 @@ Status IntentAwareIterator::NextFullValue(
   }
 
   found_record = false;
-  if (intent_iter_.Initialized()) {
+  if (intent_iter_.Initialized() && !intent_iter_seek_skipped_) {
     while ((found_record = IsIntentForTheSameKey(intent_iter_.key(), key_data.key)) &&
            IsMergeRecord(v = intent_iter_.value())) {
       intent_iter_.Next();
@@ -449,8 +457,47 @@ Status IntentAwareIterator::NextFullValue(
   return status_;
 }
 
+Result<int64_t> IntentAwareIterator::SumOlderCounterRecords(
+    const Slice& key_without_ht, DocHybridTime low_ts) {
+  RETURN_NOT_OK(status_);
+  if (!IsEntryRegular()) {
+    return STATUS_FORMAT(Corruption, "Counter delta found in intents for $0",
+                         SubDocKey::DebugSliceToString(key_without_ht));
+  }
+  int64_t sum = 0;
+  for (iter_.Next(); iter_.Valid(); iter_.Next()) {
+    Slice key = iter_.key();
+    if (!key.starts_with(key_without_ht) || key.size() == key_without_ht.size() ||
+        key[key_without_ht.size()] != ValueTypeAsChar::kHybridTime) {
+      break;
+    }
+    if (VERIFY_RESULT(DocHybridTime::DecodeFromEnd(&key)) < low_ts) {
+      // Older records were overwritten by a parent.
+      break;
+    }
+    Value value;
+    RETURN_NOT_OK(value.Decode(iter_.value()));
+    if (value.merge_flags() == Value::kCounterDeltaFlag) {
+      sum += value.primitive_value().GetInt64();
+      continue;
+    }
+    if (value.merge_flags() != 0) {
+      // Other merge records do not change the value.
+      continue;
+    }
+    if (value.value_type() == ValueType::kInt64) {
+      sum += value.primitive_value().GetInt64();
+    } else if (value.value_type() != ValueType::kTombstone) {
+      return STATUS_FORMAT(Corruption, "Unexpected counter value for $0: $1",
+                           SubDocKey::DebugSliceToString(key_without_ht), value);
+    }
+    break;
+  }
+  return sum;
+}
+
 bool IntentAwareIterator::PreparePrev(const Slice& key) {
-  ROCKSDB_SEEK(&iter_, key);
+  ROCKSDB_SEEK_WITH_TUNER(&iter_, key, &nexts_tuner_);
 
   if (iter_.Valid()) {
     iter_.Prev();
@@ -536,8 +583,12 @@ void IntentAwareIterator::SeekIntentIterIfNeeded() {
     case SeekIntentIterNeeded::kNoNeed:
       break;
     case SeekIntentIterNeeded::kSeek:
-      ROCKSDB_SEEK(&intent_iter_, seek_key_buffer_);
-      SeekToSuitableIntent<Direction::kForward>();
+      if (CanSkipIntentsSeek(seek_key_buffer_)) {
+        SkipIntentsSeek(seek_key_buffer_);
+      } else {
+        ROCKSDB_SEEK(&intent_iter_, seek_key_buffer_);
+        SeekToSuitableIntent<Direction::kForward>();
+      }
       seek_intent_iter_needed_ = SeekIntentIterNeeded::kNoNeed;
       return;
     case SeekIntentIterNeeded::kSeekForward:
@@ -607,7 +658,7 @@ Slice IntentAwareIterator::value() {
 
 void IntentAwareIterator::SeekForwardRegular(const Slice& slice) {
   VLOG(4) << "SeekForwardRegular(" << SubDocKey::DebugSliceToString(slice) << ")";
-  docdb::SeekForward(slice, &iter_);
+  docdb::SeekForward(slice, &iter_, &nexts_tuner_);
   skip_future_records_needed_ = true;
 }
 
@@ -616,6 +667,7 @@ bool IntentAwareIterator::SatisfyBounds(const Slice& slice) {
 }
 
 void IntentAwareIterator::ProcessIntent() {
+  IncrementIntentsExamined();
   auto decode_result = DecodeStrongWriteIntent(
       txn_op_context_.get(), &intent_iter_, &transaction_status_cache_);
   if (!decode_result.ok()) {
@@ -684,15 +736,46 @@ void IntentAwareIterator::SeekForwardToSuitableIntent(const KeyBytes &intent_key
       resolved_intent_key_prefix_.CompareTo(intent_key_prefix) >= 0) {
     return;
   }
+  if (CanSkipIntentsSeek(intent_key_prefix)) {
+    SkipIntentsSeek(intent_key_prefix);
+    return;
+  }
   // Use ROCKSDB_SEEK() to force re-seek of "intent_iter_" in case the iterator was invalid by the
   // previous intent upperbound, but the upperbound has changed therefore requiring re-seek.
   ROCKSDB_SEEK(&intent_iter_, intent_key_prefix.AsSlice());
   SeekToSuitableIntent<Direction::kForward>();
 }
 
+bool IntentAwareIterator::CanSkipIntentsSeek(const Slice& intent_key_prefix) {
+  if (!intents_summary_) {
+    return false;
+  }
+  auto doc_key_size = DocKey::EncodedSize(intent_key_prefix, DocKeyPart::WHOLE_DOC_KEY);
+  if (!doc_key_size.ok()) {
+    return false;
+  }
+  // When both the seek key and the intent upperbound belong to the same document, all intents
+  // that could be found by this seek also belong to this document.
+  Slice encoded_doc_key(intent_key_prefix.data(), *doc_key_size);
+  if (!intent_upperbound_.starts_with(encoded_doc_key)) {
+    return false;
+  }
+  return !intents_summary_->MayHaveIntents(encoded_doc_key, intents_summary_epoch_);
+}
+
+void IntentAwareIterator::SkipIntentsSeek(const Slice& intent_key_prefix) {
+  VLOG(4) << "Skipping intents seek, no intents for: "
+          << SubDocKey::DebugSliceToString(intent_key_prefix);
+  resolved_intent_state_ = ResolvedIntentState::kNoIntent;
+  resolved_intent_txn_dht_ = DocHybridTime::kMin;
+  intent_dht_from_same_txn_ = DocHybridTime::kMin;
+  intent_iter_seek_skipped_ = true;
+}
+
 template<Direction direction>
 void IntentAwareIterator::SeekToSuitableIntent() {
   DOCDB_DEBUG_SCOPE_LOG("", std::bind(&IntentAwareIterator::DebugDump, this));
+  intent_iter_seek_skipped_ = false;
   resolved_intent_state_ = ResolvedIntentState::kNoIntent;
   resolved_intent_txn_dht_ = DocHybridTime::kMin;
   intent_dht_from_same_txn_ = DocHybridTime::kMin;
@@ -953,7 +1036,9 @@ void IntentAwareIterator::SkipFutureRecords(const Direction direction) {
 
 void IntentAwareIterator::SkipFutureIntents() {
   skip_future_intents_needed_ = false;
-  if (!intent_iter_.Initialized() || !status_.ok()) {
+  // When intents seek was skipped there are no intents up to the intent upperbound, so changing
+  // the prefix could not make any intent suitable.
+  if (!intent_iter_.Initialized() || !status_.ok() || intent_iter_seek_skipped_) {
     return;
   }
   auto prefix = prefix_stack_.empty() ? Slice() : prefix_stack_.back();
@@ -21,6 +21,7 @@
 #include "yb/docdb/bounded_rocksdb_iterator.h"
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/key_bytes.h"
+#include "yb/docdb/nexts_to_avoid_seek.h"
 
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/options.h"
@@ -159,6 +160,12 @@ class IntentAwareIterator {
       Slice* result_value,
       Slice* final_key = nullptr);
 
+  // Returns the sum of the counter value of key_without_ht, that is the current key, older than
+  // the current record. I.e. of the older counter deltas and the latest full value or tombstone
+  // before them, written not before low_ts. Counter deltas are only written to the regular DB, so
+  // the current record should be regular. The iterator should be repositioned after this call.
+  Result<int64_t> SumOlderCounterRecords(const Slice& key_without_ht, DocHybridTime low_ts);
+
   // Finds the latest record for a particular key, returns the overwrite
   // time, and optionally also the result value. This latest record may not
   // be a full record, but instead a merge record (e.g. a TTL row).
@@ -258,6 +265,14 @@ class IntentAwareIterator {
 
   void SeekIntentIterIfNeeded();
 
+  // Returns true if intents_summary_ shows that seek of intent_iter_ to intent_key_prefix with the
+  // current intent upperbound could not find any intents.
+  bool CanSkipIntentsSeek(const Slice& intent_key_prefix);
+
+  // Updates resolved intent state as if intent_iter_ was positioned to intent_key_prefix and
+  // found no intents, without actually moving intent_iter_.
+  void SkipIntentsSeek(const Slice& intent_key_prefix);
+
   // Does initial steps for prev doc key/sub doc key seek.
   // Returns true if prepare succeed.
   bool PreparePrev(const Slice& key);
@@ -313,8 +328,17 @@ class IntentAwareIterator {
   bool skip_future_intents_needed_ = false;
   SeekIntentIterNeeded seek_intent_iter_needed_ = SeekIntentIterNeeded::kNoNeed;
 
+  // Summary of intents DB, used to skip seeks of intent_iter_ for documents without intents.
+  const IntentsSummary* intents_summary_ = nullptr;
+  uint64_t intents_summary_epoch_ = 0;
+  // Whether the last seek of intent_iter_ was skipped, so intent_iter_ is not positioned.
+  bool intent_iter_seek_skipped_ = false;
+
   // Reusable buffer to prepare seek key to avoid reallocating temporary buffers in critical paths.
   KeyBytes seek_key_buffer_;
+
+  // Chooses the number of nexts tried before seeks of iter_.
+  NextsToAvoidSeekTuner nexts_tuner_;
 };
 
 // Utility class that controls stack of prefixes in IntentAwareIterator.
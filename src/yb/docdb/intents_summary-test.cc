@@ -0,0 +1,124 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/intents_summary.h"
+
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+// Use a lot of buckets, so different documents used by tests do not collide.
+constexpr size_t kNumBuckets = 1 << 16;
+
+DocKey MakeDocKey(const std::string& key) {
+  return DocKey(PrimitiveValues(key));
+}
+
+KeyBytes MakeIntentKey(const DocKey& doc_key, IntentTypeSet intent_types) {
+  KeyBytes result = SubDocKey(doc_key, PrimitiveValue("subkey")).EncodeWithoutHt();
+  result.AppendValueType(ValueType::kIntentTypeSet);
+  result.AppendIntentTypeSet(intent_types);
+  result.AppendValueType(ValueType::kHybridTime);
+  result.AppendHybridTime(DocHybridTime(HybridTime::FromMicros(1000), 0));
+  return result;
+}
+
+const IntentTypeSet kStrongWrite{IntentType::kStrongRead, IntentType::kStrongWrite};
+const IntentTypeSet kWeakWrite{IntentType::kWeakRead, IntentType::kWeakWrite};
+
+} // namespace
+
+class IntentsSummaryTest : public YBTest {
+ protected:
+  bool MayHaveIntents(const DocKey& doc_key) {
+    return summary_.MayHaveIntents(doc_key.Encode(), summary_.CurrentEpoch());
+  }
+
+  IntentsSummary summary_{kNumBuckets};
+};
+
+TEST_F(IntentsSummaryTest, AddRemove) {
+  auto doc_key1 = MakeDocKey("key1");
+  auto doc_key2 = MakeDocKey("key2");
+  ASSERT_FALSE(MayHaveIntents(doc_key1));
+
+  // Only strong write intents are tracked.
+  summary_.Add(MakeIntentKey(doc_key1, kWeakWrite));
+  summary_.Add(MakeIntentKey(doc_key1, IntentTypeSet{IntentType::kStrongRead}));
+  ASSERT_FALSE(MayHaveIntents(doc_key1));
+
+  auto intent_key = MakeIntentKey(doc_key1, kStrongWrite);
+  summary_.Add(intent_key);
+  summary_.Add(intent_key);
+  ASSERT_TRUE(MayHaveIntents(doc_key1));
+  ASSERT_FALSE(MayHaveIntents(doc_key2));
+
+  summary_.Remove(intent_key);
+  ASSERT_TRUE(MayHaveIntents(doc_key1));
+
+  auto epoch = summary_.CurrentEpoch();
+  summary_.Remove(intent_key);
+  // Reader that obtained epoch before the removal could still see the removed intent.
+  ASSERT_TRUE(summary_.MayHaveIntents(doc_key1.Encode(), epoch));
+  ASSERT_FALSE(MayHaveIntents(doc_key1));
+  ASSERT_FALSE(summary_.disabled());
+
+  // Transaction metadata and reverse index are ignored.
+  KeyBytes reverse_index_key;
+  reverse_index_key.AppendValueType(ValueType::kTransactionId);
+  reverse_index_key.AppendRawBytes(intent_key.AsSlice());
+  summary_.Add(reverse_index_key);
+  ASSERT_FALSE(MayHaveIntents(doc_key1));
+  ASSERT_FALSE(MayHaveIntents(doc_key2));
+}
+
+TEST_F(IntentsSummaryTest, WriteBatch) {
+  auto doc_key = MakeDocKey("key");
+  rocksdb::WriteBatch write_batch;
+  write_batch.Put(MakeIntentKey(doc_key, kStrongWrite), "value");
+  write_batch.Put(MakeIntentKey(MakeDocKey("other"), kStrongWrite), "value");
+  summary_.AddWriteBatch(write_batch);
+  ASSERT_TRUE(MayHaveIntents(doc_key));
+
+  rocksdb::WriteBatch remove_batch;
+  remove_batch.SingleDelete(MakeIntentKey(doc_key, kStrongWrite));
+  summary_.RemoveWriteBatch(remove_batch);
+  ASSERT_FALSE(MayHaveIntents(doc_key));
+  ASSERT_TRUE(MayHaveIntents(MakeDocKey("other")));
+}
+
+TEST_F(IntentsSummaryTest, Conservative) {
+  auto doc_key = MakeDocKey("key");
+
+  // Removal of intent that was not added makes counters unreliable.
+  summary_.Remove(MakeIntentKey(doc_key, kStrongWrite));
+  ASSERT_TRUE(summary_.disabled());
+  ASSERT_TRUE(MayHaveIntents(doc_key));
+
+  // Intents that could not be mapped to a document affect all documents.
+  IntentsSummary summary(kNumBuckets);
+  summary.Add("garbage");
+  ASSERT_TRUE(summary.MayHaveIntents(doc_key.Encode(), summary.CurrentEpoch()));
+  summary.Remove("garbage");
+  ASSERT_FALSE(summary.MayHaveIntents(doc_key.Encode(), summary.CurrentEpoch()));
+}
+
+}  // namespace docdb
+}  // namespace yb
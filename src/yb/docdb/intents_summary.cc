@@ -0,0 +1,189 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/intents_summary.h"
+
+#include <algorithm>
+#include <array>
+
+#include <glog/logging.h>
+
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/intent.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/rocksdb/util/hash.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+constexpr uint32_t kIntentsSummarySeed = 0x3c6ef372;
+
+class IntentsSummaryBatchHandler : public rocksdb::WriteBatch::Handler {
+ public:
+  IntentsSummaryBatchHandler(IntentsSummary* summary, bool add) : summary_(summary), add_(add) {}
+
+  void Put(const Slice& key, const Slice& /* value */) override {
+    if (add_) {
+      summary_->Add(key);
+    }
+  }
+
+  void Delete(const Slice& key) override {
+    if (!add_) {
+      summary_->Remove(key);
+    }
+  }
+
+  void SingleDelete(const Slice& key) override {
+    if (!add_) {
+      summary_->Remove(key);
+    }
+  }
+
+ private:
+  IntentsSummary* const summary_;
+  const bool add_;
+};
+
+} // namespace
+
+struct IntentsSummary::Bucket {
+  std::atomic<int64_t> num_intents{0};
+  // Epoch of the latest removal of an intent from this bucket.
+  std::atomic<uint64_t> last_removal_epoch{0};
+};
+
+IntentsSummary::IntentsSummary(size_t num_buckets)
+    : num_buckets_(std::max<size_t>(num_buckets, 1)),
+      buckets_(new Bucket[num_buckets_ + 1]) {
+}
+
+IntentsSummary::~IntentsSummary() = default;
+
+IntentsSummary::Bucket* IntentsSummary::BucketForIntent(const Slice& intent_key) {
+  if (intent_key.empty() || intent_key[0] == ValueTypeAsChar::kTransactionId) {
+    // Transaction metadata and reverse index.
+    return nullptr;
+  }
+  auto decoded = DecodeIntentKey(intent_key);
+  if (!decoded.ok()) {
+    return &buckets_[num_buckets_];
+  }
+  if (!decoded->intent_types.Test(IntentType::kStrongWrite)) {
+    return nullptr;
+  }
+  auto doc_key_size = DocKey::EncodedSize(decoded->intent_prefix, DocKeyPart::WHOLE_DOC_KEY);
+  if (!doc_key_size.ok()) {
+    return &buckets_[num_buckets_];
+  }
+  return &BucketForDocKey(Slice(decoded->intent_prefix.data(), *doc_key_size));
+}
+
+IntentsSummary::Bucket& IntentsSummary::BucketForDocKey(const Slice& encoded_doc_key) const {
+  auto hash = rocksdb::Hash(encoded_doc_key.cdata(), encoded_doc_key.size(), kIntentsSummarySeed);
+  return buckets_[hash % num_buckets_];
+}
+
+Status IntentsSummary::Load(rocksdb::DB* intents_db) {
+  rocksdb::ReadOptions read_opts;
+  read_opts.fill_cache = false;
+  std::unique_ptr<rocksdb::Iterator> iter(intents_db->NewIterator(read_opts));
+  static const std::array<char, 1> kAfterTransactionId{ValueTypeAsChar::kTransactionId + 1};
+  static const Slice kAfterTxnRegion(kAfterTransactionId);
+  iter->SeekToFirst();
+  while (iter->Valid()) {
+    if (iter->key()[0] == ValueTypeAsChar::kTransactionId) {
+      // Skip transaction metadata and reverse index region.
+      iter->Seek(kAfterTxnRegion);
+      continue;
+    }
+    Add(iter->key());
+    iter->Next();
+  }
+  return iter->status();
+}
+
+void IntentsSummary::Add(const Slice& intent_key) {
+  auto* bucket = BucketForIntent(intent_key);
+  if (bucket) {
+    bucket->num_intents.fetch_add(1, std::memory_order_acq_rel);
+  }
+}
+
+void IntentsSummary::Remove(const Slice& intent_key) {
+  auto* bucket = BucketForIntent(intent_key);
+  if (!bucket) {
+    return;
+  }
+  // Epoch should be published before the counter is decreased, so a reader that observes the
+  // decreased counter also observes the epoch of this removal.
+  auto epoch = epoch_.fetch_add(1, std::memory_order_acq_rel) + 1;
+  auto last_epoch = bucket->last_removal_epoch.load(std::memory_order_acquire);
+  while (last_epoch < epoch &&
+         !bucket->last_removal_epoch.compare_exchange_weak(
+             last_epoch, epoch, std::memory_order_acq_rel)) {
+  }
+  if (bucket->num_intents.fetch_sub(1, std::memory_order_acq_rel) <= 0) {
+    // Removal of the intent that was not added, the counters cannot be trusted anymore.
+    if (!disabled()) {
+      LOG(WARNING) << "Removed not added intent: " << intent_key.ToDebugHexString()
+                   << ", disabling intents summary";
+      Disable();
+    }
+  }
+}
+
+void IntentsSummary::AddWriteBatch(const rocksdb::WriteBatch& write_batch) {
+  IterateWriteBatch(write_batch, /* add= */ true);
+}
+
+void IntentsSummary::RemoveWriteBatch(const rocksdb::WriteBatch& write_batch) {
+  IterateWriteBatch(write_batch, /* add= */ false);
+}
+
+void IntentsSummary::IterateWriteBatch(const rocksdb::WriteBatch& write_batch, bool add) {
+  IntentsSummaryBatchHandler handler(this, add);
+  auto status = write_batch.Iterate(&handler);
+  if (!status.ok()) {
+    LOG(WARNING) << "Failed to iterate intents write batch: " << status
+                 << ", disabling intents summary";
+    Disable();
+  }
+}
+
+bool IntentsSummary::BucketMayHaveIntents(const Bucket& bucket, uint64_t epoch) const {
+  return bucket.num_intents.load(std::memory_order_acquire) != 0 ||
+         bucket.last_removal_epoch.load(std::memory_order_acquire) > epoch;
+}
+
+int64_t IntentsSummary::TEST_NumIntents() const {
+  int64_t result = 0;
+  for (size_t i = 0; i <= num_buckets_; ++i) {
+    result += buckets_[i].num_intents.load(std::memory_order_acquire);
+  }
+  return result;
+}
+
+bool IntentsSummary::MayHaveIntents(const Slice& encoded_doc_key, uint64_t epoch) const {
+  if (disabled()) {
+    return true;
+  }
+  return BucketMayHaveIntents(buckets_[num_buckets_], epoch) ||
+         BucketMayHaveIntents(BucketForDocKey(encoded_doc_key), epoch);
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,108 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_INTENTS_SUMMARY_H
+#define YB_DOCDB_INTENTS_SUMMARY_H
+
+#include <atomic>
+#include <memory>
+
+#include "yb/rocksdb/db.h"
+#include "yb/rocksdb/write_batch.h"
+
+#include "yb/util/slice.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace docdb {
+
+// Lock-free summary of the strong write intents present in the intents DB of a tablet. It allows
+// IntentAwareIterator to avoid seeking the intents DB iterator for documents that definitely have
+// no intents, which is the common case for read-mostly workloads.
+//
+// Intents are hashed by the encoded DocKey of the intent key into a fixed number of buckets, each
+// bucket keeps the number of intents it contains. Intent keys that could not be mapped to a DocKey
+// are counted in a separate bucket, that is checked for every document.
+//
+// The summary is allowed to have false positives only, so to keep it conservative:
+// 1) Intents should be added before they are written to the intents DB.
+// 2) Intents should be removed after their removal is written to the intents DB.
+// 3) Readers should obtain an epoch via CurrentEpoch() before creating the intents DB iterator.
+//
+// Each removal bumps the global epoch and remembers it in the bucket, so a reader whose intents
+// DB snapshot still contains the removed intent would not treat the bucket as empty.
+class IntentsSummary {
+ public:
+  explicit IntentsSummary(size_t num_buckets);
+  ~IntentsSummary();
+
+  IntentsSummary(const IntentsSummary&) = delete;
+  void operator=(const IntentsSummary&) = delete;
+
+  // Adds all intents present in intents_db. Should be called before any other intents are added
+  // or removed.
+  CHECKED_STATUS Load(rocksdb::DB* intents_db);
+
+  // Adds intent with the specified intents DB key. Keys other than strong write intents are
+  // ignored.
+  void Add(const Slice& intent_key);
+
+  // Removes intent with the specified intents DB key, previously added with Add.
+  void Remove(const Slice& intent_key);
+
+  // Calls Add for every key put to the batch.
+  void AddWriteBatch(const rocksdb::WriteBatch& write_batch);
+
+  // Calls Remove for every key deleted by the batch.
+  void RemoveWriteBatch(const rocksdb::WriteBatch& write_batch);
+
+  uint64_t CurrentEpoch() const {
+    return epoch_.load(std::memory_order_acquire);
+  }
+
+  // Returns false when the intents DB snapshot taken after epoch was obtained definitely does not
+  // contain strong write intents for the document with the specified encoded DocKey.
+  bool MayHaveIntents(const Slice& encoded_doc_key, uint64_t epoch) const;
+
+  // Disables the summary, so MayHaveIntents would always return true.
+  void Disable() {
+    disabled_.store(true, std::memory_order_release);
+  }
+
+  bool disabled() const {
+    return disabled_.load(std::memory_order_acquire);
+  }
+
+  // Returns the number of intents added and not removed yet.
+  int64_t TEST_NumIntents() const;
+
+ private:
+  struct Bucket;
+
+  // Returns bucket for specified intent key, or nullptr if the key is not a strong write intent.
+  Bucket* BucketForIntent(const Slice& intent_key);
+  Bucket& BucketForDocKey(const Slice& encoded_doc_key) const;
+  void IterateWriteBatch(const rocksdb::WriteBatch& write_batch, bool add);
+  bool BucketMayHaveIntents(const Bucket& bucket, uint64_t epoch) const;
+
+  const size_t num_buckets_;
+  // num_buckets_ regular buckets followed by the bucket for keys without DocKey.
+  std::unique_ptr<Bucket[]> buckets_;
+  std::atomic<uint64_t> epoch_{0};
+  std::atomic<bool> disabled_{false};
+};
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif // YB_DOCDB_INTENTS_SUMMARY_H
@@ -0,0 +1,96 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/nexts_to_avoid_seek.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+DECLARE_int32(max_nexts_to_avoid_seek);
+DECLARE_int32(max_adaptive_nexts_to_avoid_seek);
+
+namespace yb {
+namespace docdb {
+
+class NextsToAvoidSeekTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    FLAGS_max_nexts_to_avoid_seek = 2;
+    FLAGS_max_adaptive_nexts_to_avoid_seek = 8;
+  }
+};
+
+TEST_F(NextsToAvoidSeekTest, GrowsForNearTargets) {
+  NextsToAvoidSeekTuner tuner;
+  ASSERT_EQ(2, tuner.max_nexts());
+  for (int i = 0; i != 100; ++i) {
+    tuner.TargetReached(tuner.max_nexts());
+    tuner.SeekForced();
+    tuner.TargetReached(tuner.max_nexts());
+  }
+  ASSERT_EQ(8, tuner.max_nexts());
+}
+
+TEST_F(NextsToAvoidSeekTest, ShrinksForFarTargets) {
+  FLAGS_max_nexts_to_avoid_seek = 8;
+  NextsToAvoidSeekTuner tuner;
+  for (int i = 0; i != 100; ++i) {
+    tuner.SeekForced();
+  }
+  ASSERT_EQ(1, tuner.max_nexts());
+}
+
+TEST_F(NextsToAvoidSeekTest, KeepsWhenTargetsAreReached) {
+  NextsToAvoidSeekTuner tuner;
+  for (int i = 0; i != 100; ++i) {
+    tuner.TargetReached(1);
+    tuner.TargetReached(2);
+  }
+  ASSERT_EQ(2, tuner.max_nexts());
+}
+
+TEST_F(NextsToAvoidSeekTest, DisabledWithoutNexts) {
+  FLAGS_max_nexts_to_avoid_seek = 0;
+  NextsToAvoidSeekTuner tuner;
+  for (int i = 0; i != 100; ++i) {
+    tuner.SeekForced();
+  }
+  ASSERT_EQ(0, tuner.max_nexts());
+}
+
+TEST_F(NextsToAvoidSeekTest, Stats) {
+  NextsToAvoidSeekStats stats;
+  {
+    NextsToAvoidSeekTuner short_lived(&stats);
+    short_lived.SeekForced();
+  }
+  // Not enough seeks to tune the iterator, so nothing is learned.
+  ASSERT_EQ(0, stats.max_nexts());
+
+  {
+    NextsToAvoidSeekTuner tuner(&stats);
+    for (int i = 0; i != 100; ++i) {
+      tuner.TargetReached(tuner.max_nexts());
+      tuner.SeekForced();
+    }
+    ASSERT_EQ(8, tuner.max_nexts());
+  }
+  ASSERT_EQ(8, stats.max_nexts());
+
+  NextsToAvoidSeekTuner tuner(&stats);
+  ASSERT_EQ(8, tuner.max_nexts());
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,82 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/nexts_to_avoid_seek.h"
+
+#include <algorithm>
+
+#include <gflags/gflags.h>
+
+#include "yb/util/flag_tags.h"
+
+DECLARE_int32(max_nexts_to_avoid_seek);
+
+DEFINE_bool(adaptive_nexts_to_avoid_seek, true,
+            "Whether DocDB iterators adapt the number of next calls tried before a seek, that "
+            "starts from max_nexts_to_avoid_seek, to the observed distances to seek targets.");
+TAG_FLAG(adaptive_nexts_to_avoid_seek, advanced);
+TAG_FLAG(adaptive_nexts_to_avoid_seek, runtime);
+
+DEFINE_int32(max_adaptive_nexts_to_avoid_seek, 16,
+             "Upper limit for the number of next calls tried before a seek, when it is adapted "
+             "by DocDB iterators.");
+TAG_FLAG(max_adaptive_nexts_to_avoid_seek, advanced);
+TAG_FLAG(max_adaptive_nexts_to_avoid_seek, runtime);
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+int MaxAdaptiveNexts() {
+  return std::max(FLAGS_max_adaptive_nexts_to_avoid_seek, FLAGS_max_nexts_to_avoid_seek);
+}
+
+} // namespace
+
+void NextsToAvoidSeekStats::Update(int max_nexts) {
+  // Races between iterators could lose some updates, that is fine for a heuristic.
+  auto old_max_nexts = max_nexts_.load(std::memory_order_relaxed);
+  auto new_max_nexts = old_max_nexts == 0 ? max_nexts : (old_max_nexts * 3 + max_nexts + 2) / 4;
+  max_nexts_.store(new_max_nexts, std::memory_order_relaxed);
+}
+
+NextsToAvoidSeekTuner::NextsToAvoidSeekTuner(NextsToAvoidSeekStats* stats)
+    : stats_(stats),
+      adaptive_(FLAGS_adaptive_nexts_to_avoid_seek && FLAGS_max_nexts_to_avoid_seek > 0),
+      max_nexts_(FLAGS_max_nexts_to_avoid_seek) {
+  if (adaptive_ && stats_ && stats_->max_nexts() > 0) {
+    max_nexts_ = std::min(stats_->max_nexts(), MaxAdaptiveNexts());
+  }
+}
+
+NextsToAvoidSeekTuner::~NextsToAvoidSeekTuner() {
+  if (adjusted_ && stats_) {
+    stats_->Update(max_nexts_);
+  }
+}
+
+void NextsToAvoidSeekTuner::Adjust() {
+  if (forced_seeks_ * 2 > decisions_) {
+    max_nexts_ = std::max(max_nexts_ / 2, 1);
+  } else if (forced_seeks_ > 0 && reached_near_limit_ * 4 >= decisions_) {
+    max_nexts_ = std::min(max_nexts_ * 2, MaxAdaptiveNexts());
+  }
+  adjusted_ = true;
+  decisions_ = 0;
+  reached_near_limit_ = 0;
+  forced_seeks_ = 0;
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,109 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_NEXTS_TO_AVOID_SEEK_H
+#define YB_DOCDB_NEXTS_TO_AVOID_SEEK_H
+
+#include <atomic>
+
+namespace yb {
+namespace docdb {
+
+// Number of Next() calls tried before a seek, learned by iterators of a tablet.
+//
+// New iterators start from the value learned by previously destroyed iterators, so short lived
+// iterators, that do not make enough seeks to tune themselves, also benefit from the tuning.
+class NextsToAvoidSeekStats {
+ public:
+  NextsToAvoidSeekStats() = default;
+
+  NextsToAvoidSeekStats(const NextsToAvoidSeekStats&) = delete;
+  void operator=(const NextsToAvoidSeekStats&) = delete;
+
+  // Returns the learned number of nexts, or 0 if nothing was learned yet.
+  int max_nexts() const {
+    return max_nexts_.load(std::memory_order_relaxed);
+  }
+
+  // Moves the learned number of nexts towards the number of nexts tuned by an iterator.
+  void Update(int max_nexts);
+
+ private:
+  std::atomic<int> max_nexts_{0};
+};
+
+// Adapts the number of Next() calls tried before a seek of a single iterator to the observed
+// distances to the seek targets.
+//
+// When most targets could not be reached with the tried nexts, these nexts are wasted, so their
+// number is decreased. When some targets could not be reached, while others were reached only with
+// the last tried nexts, the targets are likely just a bit further, so the number is increased.
+//
+// Starts from max_nexts_to_avoid_seek or the number learned by stats, and does not adapt when
+// max_nexts_to_avoid_seek is 0, so seeks are always performed.
+class NextsToAvoidSeekTuner {
+ public:
+  explicit NextsToAvoidSeekTuner(NextsToAvoidSeekStats* stats = nullptr);
+  ~NextsToAvoidSeekTuner();
+
+  NextsToAvoidSeekTuner(const NextsToAvoidSeekTuner&) = delete;
+  void operator=(const NextsToAvoidSeekTuner&) = delete;
+
+  int max_nexts() const {
+    return max_nexts_;
+  }
+
+  // Records that the seek target was reached after the specified number of nexts.
+  void TargetReached(int nexts) {
+    if (adaptive_) {
+      if (nexts * 2 > max_nexts_) {
+        ++reached_near_limit_;
+      }
+      Decided();
+    }
+  }
+
+  // Records that max_nexts() nexts did not reach the seek target, so the seek was performed.
+  void SeekForced() {
+    if (adaptive_) {
+      ++forced_seeks_;
+      Decided();
+    }
+  }
+
+ private:
+  void Decided() {
+    if (++decisions_ >= kDecisionsPerAdjustment) {
+      Adjust();
+    }
+  }
+
+  void Adjust();
+
+  static constexpr int kDecisionsPerAdjustment = 32;
+
+  NextsToAvoidSeekStats* const stats_;
+  const bool adaptive_;
+  int max_nexts_;
+  bool adjusted_ = false;
+
+  // Counters since the last adjustment.
+  int decisions_ = 0;
+  int reached_near_limit_ = 0;
+  int forced_seeks_ = 0;
+};
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif // YB_DOCDB_NEXTS_TO_AVOID_SEEK_H
@@ -0,0 +1,66 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/operation_cost.h"
+
+#include "yb/rocksdb/perf_context.h"
+
+#include "yb/util/format.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+__thread uint64_t intents_examined = 0;
+
+} // namespace
+
+OperationCost OperationCost::Current() {
+  OperationCost result;
+  const auto& perf_context = rocksdb::perf_context;
+  result.block_cache_hits = perf_context.block_cache_hit_count;
+  result.blocks_read = perf_context.block_read_count;
+  result.block_bytes_read = perf_context.block_read_byte;
+  result.block_bytes_decompressed = perf_context.block_decompress_byte;
+  result.seeks = perf_context.iter_seek_count;
+  result.nexts = perf_context.iter_next_count + perf_context.iter_prev_count;
+  result.intents_examined = intents_examined;
+  return result;
+}
+
+OperationCost& OperationCost::operator-=(const OperationCost& rhs) {
+  block_cache_hits -= rhs.block_cache_hits;
+  blocks_read -= rhs.blocks_read;
+  block_bytes_read -= rhs.block_bytes_read;
+  block_bytes_decompressed -= rhs.block_bytes_decompressed;
+  seeks -= rhs.seeks;
+  nexts -= rhs.nexts;
+  intents_examined -= rhs.intents_examined;
+  return *this;
+}
+
+std::string OperationCost::ToString() const {
+  return Format(
+      "{ block_cache_hits: $0 blocks_read: $1 block_bytes_read: $2 block_bytes_decompressed: $3 "
+          "seeks: $4 nexts: $5 intents_examined: $6 }",
+      block_cache_hits, blocks_read, block_bytes_read, block_bytes_decompressed, seeks, nexts,
+      intents_examined);
+}
+
+void IncrementIntentsExamined() {
+  ++intents_examined;
+}
+
+} // namespace docdb
+} // namespace yb
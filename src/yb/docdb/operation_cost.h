@@ -0,0 +1,54 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_OPERATION_COST_H
+#define YB_DOCDB_OPERATION_COST_H
+
+#include <stdint.h>
+
+#include <string>
+
+namespace yb {
+namespace docdb {
+
+// Storage work done by the current thread, built from rocksdb::perf_context and DocDB's own
+// thread local counters. The cost of an operation is the difference between the values taken
+// before and after it, so all of the operation should be executed by the same thread.
+struct OperationCost {
+  uint64_t block_cache_hits = 0;
+  uint64_t blocks_read = 0;
+  uint64_t block_bytes_read = 0;
+  uint64_t block_bytes_decompressed = 0;
+  uint64_t seeks = 0;
+  uint64_t nexts = 0;
+  uint64_t intents_examined = 0;
+
+  // Returns the counters accumulated by the current thread so far.
+  static OperationCost Current();
+
+  OperationCost& operator-=(const OperationCost& rhs);
+
+  std::string ToString() const;
+};
+
+inline OperationCost operator-(OperationCost lhs, const OperationCost& rhs) {
+  return lhs -= rhs;
+}
+
+// Accounts an intent decoded by a reader of the current thread.
+void IncrementIntentsExamined();
+
+} // namespace docdb
+} // namespace yb
+
+#endif // YB_DOCDB_OPERATION_COST_H
@@ -0,0 +1,123 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/packed_row.h"
+
+#include "yb/docdb/value.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+class PackedRowTest : public YBTest {
+ protected:
+  PrimitiveValue BuildTestRow() {
+    PackedRowBuilder builder;
+    // Add columns out of order to check that the builder sorts them.
+    builder.AddColumn(PrimitiveValue(ColumnId(30)), PrimitiveValue("thirty"));
+    builder.AddColumn(PrimitiveValue::SystemColumnId(SystemColumnIds::kLivenessColumn),
+                      PrimitiveValue());
+    builder.AddColumn(PrimitiveValue(ColumnId(10)), PrimitiveValue::Int32(10));
+    builder.AddColumn(PrimitiveValue(ColumnId(20)),
+                      PrimitiveValue(static_cast<int64_t>(20000000000)));
+    EXPECT_EQ(4, builder.num_columns());
+    auto result = builder.Build();
+    EXPECT_EQ(0, builder.num_columns());
+    return result;
+  }
+
+  static KeyBytes EncodedSubkey(const PrimitiveValue& subkey) {
+    KeyBytes result;
+    subkey.AppendToKey(&result);
+    return result;
+  }
+};
+
+TEST_F(PackedRowTest, EncodeDecode) {
+  auto packed_row = BuildTestRow();
+  ASSERT_EQ(ValueType::kPackedRow, packed_row.value_type());
+
+  PackedRowDecoder decoder;
+  ASSERT_OK(decoder.Init(packed_row.GetPackedRow()));
+  ASSERT_EQ(4, decoder.num_columns());
+
+  std::vector<PrimitiveValue> subkeys;
+  for (size_t i = 0; i != decoder.num_columns(); ++i) {
+    PrimitiveValue subkey;
+    PrimitiveValue value;
+    ASSERT_OK(decoder.DecodeColumn(i, &subkey, &value));
+    subkeys.push_back(subkey);
+  }
+  ASSERT_EQ(PrimitiveValue::SystemColumnId(SystemColumnIds::kLivenessColumn), subkeys[0]);
+  ASSERT_EQ(PrimitiveValue(ColumnId(10)), subkeys[1]);
+  ASSERT_EQ(PrimitiveValue(ColumnId(20)), subkeys[2]);
+  ASSERT_EQ(PrimitiveValue(ColumnId(30)), subkeys[3]);
+
+  const auto* column = decoder.Find(EncodedSubkey(PrimitiveValue(ColumnId(30))).AsSlice());
+  ASSERT_NE(nullptr, column);
+  PrimitiveValue value;
+  ASSERT_OK(value.DecodeFromValue(column->value));
+  ASSERT_EQ(PrimitiveValue("thirty"), value);
+
+  ASSERT_EQ(nullptr, decoder.Find(EncodedSubkey(PrimitiveValue(ColumnId(15))).AsSlice()));
+  ASSERT_EQ(nullptr, decoder.Find(EncodedSubkey(PrimitiveValue(ColumnId(40))).AsSlice()));
+}
+
+TEST_F(PackedRowTest, ValueRoundTrip) {
+  Value value(BuildTestRow(), MonoDelta::FromSeconds(10));
+  const auto encoded = value.Encode();
+
+  ValueType value_type;
+  ASSERT_OK(Value::DecodePrimitiveValueType(encoded, &value_type));
+  ASSERT_EQ(ValueType::kPackedRow, value_type);
+
+  Value decoded;
+  ASSERT_OK(decoded.Decode(encoded));
+  ASSERT_TRUE(decoded.ttl().Equals(MonoDelta::FromSeconds(10)));
+  ASSERT_EQ(value.primitive_value().GetPackedRow(), decoded.primitive_value().GetPackedRow());
+  ASSERT_EQ(
+      "PackedRow{SystemColumnId(0): null, ColumnId(10): 10, ColumnId(20): 20000000000, "
+      "ColumnId(30): \"thirty\"}",
+      decoded.primitive_value().ToString());
+}
+
+TEST_F(PackedRowTest, RemoveColumns) {
+  auto packed_row = BuildTestRow();
+  std::string result;
+  ASSERT_FALSE(ASSERT_RESULT(RemoveColumnsFromPackedRow(
+      packed_row.GetPackedRow(), ColumnIds{ColumnId(15)}, &result)));
+  ASSERT_TRUE(result.empty());
+
+  ASSERT_TRUE(ASSERT_RESULT(RemoveColumnsFromPackedRow(
+      packed_row.GetPackedRow(), ColumnIds{ColumnId(10), ColumnId(30)}, &result)));
+  PackedRowDecoder decoder;
+  ASSERT_OK(decoder.Init(result));
+  ASSERT_EQ(2, decoder.num_columns());
+  ASSERT_NE(nullptr, decoder.Find(EncodedSubkey(
+      PrimitiveValue::SystemColumnId(SystemColumnIds::kLivenessColumn)).AsSlice()));
+  ASSERT_NE(nullptr, decoder.Find(EncodedSubkey(PrimitiveValue(ColumnId(20))).AsSlice()));
+  ASSERT_EQ(nullptr, decoder.Find(EncodedSubkey(PrimitiveValue(ColumnId(10))).AsSlice()));
+}
+
+TEST_F(PackedRowTest, Corruption) {
+  auto packed_row = BuildTestRow();
+  const auto& encoded = packed_row.GetPackedRow();
+  PackedRowDecoder decoder;
+  ASSERT_NOK(decoder.Init(Slice(encoded.data(), encoded.size() - 1)));
+  ASSERT_NOK(decoder.Init(encoded + "x"));
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,164 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/packed_row.h"
+
+#include <algorithm>
+
+#include "yb/util/fast_varint.h"
+#include "yb/util/status.h"
+
+using yb::util::FastAppendUnsignedVarIntToStr;
+using yb::util::FastDecodeUnsignedVarInt;
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+void AppendPackedColumn(const Slice& subkey, const Slice& value, std::string* out) {
+  out->append(subkey.cdata(), subkey.size());
+  FastAppendUnsignedVarIntToStr(value.size(), out);
+  out->append(value.cdata(), value.size());
+}
+
+} // namespace
+
+void PackedRowBuilder::AddColumn(const PrimitiveValue& subkey, const PrimitiveValue& value) {
+  KeyBytes encoded_subkey;
+  subkey.AppendToKey(&encoded_subkey);
+  columns_.emplace_back(std::move(*encoded_subkey.mutable_data()), value.ToValue());
+}
+
+PrimitiveValue PackedRowBuilder::Build() {
+  std::sort(columns_.begin(), columns_.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.first < rhs.first;
+  });
+
+  std::string result;
+  size_t total_size = 0;
+  for (const auto& column : columns_) {
+    total_size += column.first.size() + column.second.size() + 1;
+  }
+  result.reserve(total_size + util::kMaxVarIntBufferSize);
+  FastAppendUnsignedVarIntToStr(columns_.size(), &result);
+  for (const auto& column : columns_) {
+    AppendPackedColumn(column.first, column.second, &result);
+  }
+  columns_.clear();
+  return PrimitiveValue::PackedRow(std::move(result));
+}
+
+Status PackedRowDecoder::Init(const Slice& packed_row) {
+  columns_.clear();
+  Slice input = packed_row;
+  const auto num_columns = VERIFY_RESULT(FastDecodeUnsignedVarInt(&input));
+  columns_.reserve(num_columns);
+  PrimitiveValue subkey;
+  for (uint64_t i = 0; i != num_columns; ++i) {
+    const auto* subkey_start = input.data();
+    RETURN_NOT_OK_PREPEND(subkey.DecodeFromKey(&input),
+                          Format("Failed to decode subkey of packed column $0", i));
+    Slice encoded_subkey(subkey_start, input.data());
+    const auto value_size = VERIFY_RESULT(FastDecodeUnsignedVarInt(&input));
+    if (input.size() < value_size) {
+      return STATUS_FORMAT(
+          Corruption, "Not enough bytes for packed column $0: $1 expected, $2 left",
+          i, value_size, input.size());
+    }
+    columns_.push_back(PackedColumn{encoded_subkey, Slice(input.data(), value_size)});
+    input.remove_prefix(value_size);
+  }
+  if (!input.empty()) {
+    return STATUS_FORMAT(Corruption, "$0 extra bytes at the end of packed row", input.size());
+  }
+  return Status::OK();
+}
+
+const PackedColumn* PackedRowDecoder::Find(const Slice& encoded_subkey) const {
+  auto it = std::lower_bound(
+      columns_.begin(), columns_.end(), encoded_subkey,
+      [](const PackedColumn& column, const Slice& key) {
+        return column.subkey.compare(key) < 0;
+      });
+  if (it == columns_.end() || it->subkey != encoded_subkey) {
+    return nullptr;
+  }
+  return &*it;
+}
+
+Status PackedRowDecoder::DecodeColumn(
+    size_t idx, PrimitiveValue* subkey, PrimitiveValue* value) const {
+  const auto& column = columns_[idx];
+  Slice encoded_subkey = column.subkey;
+  RETURN_NOT_OK(subkey->DecodeFromKey(&encoded_subkey));
+  return value->DecodeFromValue(column.value);
+}
+
+Result<bool> RemoveColumnsFromPackedRow(
+    const Slice& packed_row, const ColumnIds& deleted_cols, std::string* out) {
+  PackedRowDecoder decoder;
+  RETURN_NOT_OK(decoder.Init(packed_row));
+  std::vector<size_t> kept_columns;
+  kept_columns.reserve(decoder.num_columns());
+  PrimitiveValue subkey;
+  for (size_t i = 0; i != decoder.num_columns(); ++i) {
+    Slice encoded_subkey = decoder.column(i).subkey;
+    RETURN_NOT_OK(subkey.DecodeFromKey(&encoded_subkey));
+    if (subkey.value_type() == ValueType::kColumnId &&
+        deleted_cols.count(subkey.GetColumnId()) != 0) {
+      continue;
+    }
+    kept_columns.push_back(i);
+  }
+  if (kept_columns.size() == decoder.num_columns()) {
+    return false;
+  }
+
+  out->clear();
+  FastAppendUnsignedVarIntToStr(kept_columns.size(), out);
+  for (auto idx : kept_columns) {
+    const auto& column = decoder.column(idx);
+    AppendPackedColumn(column.subkey, column.value, out);
+  }
+  return true;
+}
+
+std::string PackedRowToString(const Slice& packed_row) {
+  PackedRowDecoder decoder;
+  auto status = decoder.Init(packed_row);
+  if (!status.ok()) {
+    return status.ToString();
+  }
+  std::string result = "PackedRow{";
+  PrimitiveValue subkey;
+  PrimitiveValue value;
+  for (size_t i = 0; i != decoder.num_columns(); ++i) {
+    if (i != 0) {
+      result += ", ";
+    }
+    status = decoder.DecodeColumn(i, &subkey, &value);
+    if (!status.ok()) {
+      result += status.ToString();
+      break;
+    }
+    result += subkey.ToString();
+    result += ": ";
+    result += value.ToString();
+  }
+  result += "}";
+  return result;
+}
+
+}  // namespace docdb
+}  // namespace yb
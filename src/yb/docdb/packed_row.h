@@ -0,0 +1,104 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_PACKED_ROW_H
+#define YB_DOCDB_PACKED_ROW_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "yb/common/schema.h"
+
+#include "yb/docdb/primitive_value.h"
+
+#include "yb/util/result.h"
+#include "yb/util/slice.h"
+
+namespace yb {
+namespace docdb {
+
+// A packed row stores a whole row version as a single RocksDB value at the DocKey level, instead of
+// one SubDocKey/Value pair per column:
+//   <document_key> <hybrid_time> -> kPackedRow <packed row body>
+//
+// The packed row body is encoded as follows:
+//   <number of columns: unsigned varint>
+//   For each column, in ascending order of the encoded subkey:
+//     <column subkey: key-encoded PrimitiveValue, i.e. ColumnId or SystemColumnId>
+//     <size of the encoded column value: unsigned varint>
+//     <column value: value-encoded PrimitiveValue>
+//
+// A packed row fully overwrites the row at its write time, so columns that are absent from it are
+// treated as null. Regular per-column entries written later than the packed row take precedence
+// over the packed column values.
+class PackedRowBuilder {
+ public:
+  // Adds a column to the row. Subkeys are expected to be unique within a row.
+  void AddColumn(const PrimitiveValue& subkey, const PrimitiveValue& value);
+
+  size_t num_columns() const {
+    return columns_.size();
+  }
+
+  // Encodes the columns added so far into a kPackedRow primitive value and resets the builder.
+  PrimitiveValue Build();
+
+ private:
+  // Pairs of key-encoded subkey and value-encoded column value.
+  std::vector<std::pair<std::string, std::string>> columns_;
+};
+
+struct PackedColumn {
+  // Key-encoded column subkey.
+  Slice subkey;
+
+  // Value-encoded column value.
+  Slice value;
+};
+
+// Provides access to the columns of an encoded packed row body. The decoder does not copy the data,
+// so the underlying buffer should outlive it.
+class PackedRowDecoder {
+ public:
+  CHECKED_STATUS Init(const Slice& packed_row);
+
+  size_t num_columns() const {
+    return columns_.size();
+  }
+
+  const PackedColumn& column(size_t idx) const {
+    return columns_[idx];
+  }
+
+  // Returns the column for the given key-encoded subkey, or nullptr if the row does not contain it.
+  const PackedColumn* Find(const Slice& encoded_subkey) const;
+
+  // Decodes the subkey and the value of the column at the given index.
+  CHECKED_STATUS DecodeColumn(size_t idx, PrimitiveValue* subkey, PrimitiveValue* value) const;
+
+ private:
+  std::vector<PackedColumn> columns_;
+};
+
+// Re-encodes packed_row into out, dropping the columns listed in deleted_cols.
+// Returns false, leaving out untouched, if none of the columns was removed.
+Result<bool> RemoveColumnsFromPackedRow(
+    const Slice& packed_row, const ColumnIds& deleted_cols, std::string* out);
+
+std::string PackedRowToString(const Slice& packed_row);
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif // YB_DOCDB_PACKED_ROW_H
@@ -18,9 +18,12 @@
 #include "yb/common/partition.h"
 #include "yb/common/ql_storage_interface.h"
 #include "yb/common/ql_value.h"
+#include "yb/common/row_mark.h"
 
+#include "yb/docdb/conflict_resolution.h"
 #include "yb/docdb/doc_pgsql_scanspec.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/primitive_value_util.h"
 
 #include "yb/util/trace.h"
@@ -31,6 +34,10 @@ DECLARE_int64(retryable_rpc_single_call_timeout_ms);
 DEFINE_double(ysql_scan_timeout_multiplier, 0.5,
               "YSQL read scan timeout multipler of retryable_rpc_single_call_timeout_ms.");
 
+DEFINE_int32(ysql_scan_batch_size, 64,
+             "Number of rows fetched from the DocDB iterator at once by YSQL sequential scans. "
+             "Rows of a batch are filtered and projected together.");
+
 namespace yb {
 namespace docdb {
 
@@ -52,6 +59,16 @@ CHECKED_STATUS CreateProjection(const Schema& schema,
   return schema.CreateProjectionByIdsIgnoreMissing(column_ids, projection);
 }
 
+// Strips cotable id / pgtable id from the serialized DocKey of a row, to return it as ybctid.
+Slice TupleIdFromRowKey(Slice row_key) {
+  if (row_key.starts_with(ValueTypeAsChar::kTableId)) {
+    row_key.remove_prefix(1 + kUuidSize);
+  } else if (row_key.starts_with(ValueTypeAsChar::kPgTableOid)) {
+    row_key.remove_prefix(1 + sizeof(PgTableOid));
+  }
+  return row_key;
+}
+
 } // namespace
 
 //--------------------------------------------------------------------------------------------------
@@ -124,15 +141,12 @@ Status PgsqlWriteOperation::ApplyInsert(const DocOperationApplyData& data, IsUps
     }
   }
 
-  // Add the liveness column.
   static const PrimitiveValue kLivenessColumnId =
       PrimitiveValue::SystemColumnId(SystemColumnIds::kLivenessColumn);
 
-  RETURN_NOT_OK(data.doc_write_batch->SetPrimitive(
-      DocPath(encoded_doc_key_.as_slice(), kLivenessColumnId),
-      Value(PrimitiveValue()),
-      data.read_time, data.deadline, request_.stmt_id()));
-
+  std::vector<std::pair<PrimitiveValue, SubDocument>> columns;
+  columns.reserve(request_.column_values_size());
+  bool all_columns_primitive = true;
   for (const auto& column_value : request_.column_values()) {
     // Get the column.
     if (!column_value.has_column_id()) {
@@ -148,13 +162,40 @@ Status PgsqlWriteOperation::ApplyInsert(const DocOperationApplyData& data, IsUps
     // Evaluate column value.
     QLValue expr_result;
     RETURN_NOT_OK(EvalExpr(column_value.expr(), table_row, &expr_result));
-    const SubDocument sub_doc =
-        SubDocument::FromQLValuePB(expr_result.value(), column.sorting_type());
+    columns.emplace_back(
+        PrimitiveValue(column_id),
+        SubDocument::FromQLValuePB(expr_result.value(), column.sorting_type()));
+    all_columns_primitive = all_columns_primitive && columns.back().second.IsTombstoneOrPrimitive();
+  }
 
-    // Inserting into specified column.
-    DocPath sub_path(encoded_doc_key_.as_slice(), PrimitiveValue(column_id));
-    RETURN_NOT_OK(data.doc_write_batch->InsertSubDocument(
-        sub_path, sub_doc, data.read_time, data.deadline, request_.stmt_id()));
+  // The row is known not to exist at this point, so it could be written as a single packed value.
+  // Upserts keep using per-column entries, because they must not reset the columns they don't set.
+  if (all_columns_primitive && MayWritePackedRow()) {
+    PackedRowBuilder packed_row;
+    packed_row.AddColumn(kLivenessColumnId, PrimitiveValue());
+    for (const auto& column : columns) {
+      // Null columns are represented by their absence from the packed row.
+      if (column.second.value_type() != ValueType::kTombstone) {
+        packed_row.AddColumn(column.first, column.second);
+      }
+    }
+    RETURN_NOT_OK(data.doc_write_batch->SetPrimitive(
+        DocPath(encoded_doc_key_.as_slice()),
+        Value(packed_row.Build()),
+        data.read_time, data.deadline, request_.stmt_id()));
+  } else {
+    // Add the liveness column.
+    RETURN_NOT_OK(data.doc_write_batch->SetPrimitive(
+        DocPath(encoded_doc_key_.as_slice(), kLivenessColumnId),
+        Value(PrimitiveValue()),
+        data.read_time, data.deadline, request_.stmt_id()));
+
+    for (const auto& column : columns) {
+      // Inserting into specified column.
+      DocPath sub_path(encoded_doc_key_.as_slice(), column.first);
+      RETURN_NOT_OK(data.doc_write_batch->InsertSubDocument(
+          sub_path, column.second, data.read_time, data.deadline, request_.stmt_id()));
+    }
   }
 
   RETURN_NOT_OK(PopulateResultSet(table_row));
@@ -175,7 +216,15 @@ Status PgsqlWriteOperation::ApplyUpdate(const DocOperationApplyData& data) {
   // skipped is set to false if this operation produces some data to write.
   bool skipped = true;
 
+  // Row that RETURNING targets are evaluated against.
+  QLTableRow::SharedPtr returning_row = table_row;
+
   if (request_.has_ybctid_column_value()) {
+    // New values are evaluated against the row before the update, so RETURNING targets of requests
+    // with pushed down SET expressions are evaluated against a separate row with the new values.
+    if (!request_.targets().empty()) {
+      returning_row = std::make_shared<QLTableRow>(*table_row);
+    }
     for (const auto& column_value : request_.column_new_values()) {
       // Get the column.
       if (!column_value.has_column_id()) {
@@ -201,6 +250,9 @@ Status PgsqlWriteOperation::ApplyUpdate(const DocOperationApplyData& data) {
       DocPath sub_path(encoded_doc_key_.as_slice(), PrimitiveValue(column_id));
       RETURN_NOT_OK(data.doc_write_batch->InsertSubDocument(
           sub_path, sub_doc, data.read_time, data.deadline, request_.stmt_id()));
+      if (returning_row != table_row) {
+        returning_row->AllocColumn(column_id, expr_result);
+      }
       skipped = false;
     }
   } else {
@@ -245,8 +297,9 @@ Status PgsqlWriteOperation::ApplyUpdate(const DocOperationApplyData& data) {
     }
   }
 
-  // Returning the values before the update.
-  RETURN_NOT_OK(PopulateResultSet(table_row));
+  // Returning the values after the update for requests from the PostgreSQL layer, and the values
+  // before the update otherwise.
+  RETURN_NOT_OK(PopulateResultSet(returning_row));
 
   if (skipped) {
     response_->set_skipped(true);
@@ -317,13 +370,7 @@ Status PgsqlWriteOperation::PopulateResultSet(const QLTableRow::SharedPtr& table
   for (const PgsqlExpressionPB& expr : request_.targets()) {
     if (expr.has_column_id()) {
       if (expr.column_id() == static_cast<int>(PgSystemAttrNum::kYBTupleId)) {
-        // Strip cotable id / pgtable id from the serialized DocKey before returning it as ybctid.
-        Slice tuple_id = encoded_doc_key_.as_slice();
-        if (tuple_id.starts_with(ValueTypeAsChar::kTableId)) {
-          tuple_id.remove_prefix(1 + kUuidSize);
-        } else if (tuple_id.starts_with(ValueTypeAsChar::kPgTableOid)) {
-          tuple_id.remove_prefix(1 + sizeof(PgTableOid));
-        }
+        const Slice tuple_id = TupleIdFromRowKey(encoded_doc_key_.as_slice());
         rsrow->rscol(rscol_index)->set_binary_value(tuple_id.data(), tuple_id.size());
       } else {
         RETURN_NOT_OK(EvalExpr(expr, table_row, rsrow->rscol(rscol_index)));
@@ -334,6 +381,11 @@ Status PgsqlWriteOperation::PopulateResultSet(const QLTableRow::SharedPtr& table
   return Status::OK();
 }
 
+bool PgsqlWriteOperation::MayWritePackedRow() const {
+  return request_.stmt_type() == PgsqlWriteRequestPB::PGSQL_INSERT &&
+         schema_.table_properties().use_packed_row();
+}
+
 Status PgsqlWriteOperation::GetDocPaths(GetDocPathsMode mode,
                                         DocPathsToLock *paths,
                                         IsolationLevel *level) const {
@@ -346,7 +398,9 @@ Status PgsqlWriteOperation::GetDocPaths(GetDocPathsMode mode,
   *level = RequireReadSnapshot() ? IsolationLevel::SNAPSHOT_ISOLATION
                                  : IsolationLevel::SERIALIZABLE_ISOLATION;
 
-  if (mode == GetDocPathsMode::kIntents) {
+  // Packed row is written at the DocKey level, so the whole row should be locked, like a row
+  // delete.
+  if (mode == GetDocPathsMode::kIntents && !MayWritePackedRow()) {
     const google::protobuf::RepeatedPtrField<PgsqlColumnValuePB>* column_values = nullptr;
     if (request_.stmt_type() == PgsqlWriteRequestPB::PGSQL_INSERT ||
         request_.stmt_type() == PgsqlWriteRequestPB::PGSQL_UPSERT) {
@@ -380,6 +434,38 @@ Status PgsqlWriteOperation::GetDocPaths(GetDocPathsMode mode,
 
 //--------------------------------------------------------------------------------------------------
 
+PgsqlReadOperation::PgsqlReadOperation(const PgsqlReadRequestPB& request,
+                                       const TransactionOperationContextOpt& txn_op_context)
+    : request_(request), txn_op_context_(txn_op_context),
+      lock_rows_(IsValidRowMarkType(GetRowMarkTypeFromPB(request))) {
+}
+
+PgsqlReadOperation::~PgsqlReadOperation() = default;
+
+void PgsqlReadOperation::SkipLockedRows(const DocDB& doc_db) {
+  if (!lock_rows_ || request_.wait_policy() != RowMarkWaitPolicy::WAIT_SKIP ||
+      !txn_op_context_ || !txn_op_context_->transactional()) {
+    return;
+  }
+  // Intent types of row marks do not depend on the isolation level.
+  locked_key_checker_ = std::make_unique<LockedKeyChecker>(
+      doc_db, txn_op_context_->transaction_id,
+      GetStrongIntentTypeSet(
+          IsolationLevel::SNAPSHOT_ISOLATION, OperationKind::kRead, GetRowMarkTypeFromPB(request_)),
+      PartialRangeKeyIntents::kTrue, &txn_op_context_->txn_status_manager);
+}
+
+Result<bool> PgsqlReadOperation::SkipRowToLock(Slice row_key) {
+  if (!lock_rows_) {
+    return false;
+  }
+  if (locked_key_checker_ && VERIFY_RESULT(locked_key_checker_->IsLocked(row_key))) {
+    return true;
+  }
+  row_keys_to_lock_.push_back(row_key.ToBuffer());
+  return false;
+}
+
 Status PgsqlReadOperation::Execute(const common::YQLStorageIf& ql_storage,
                                    CoarseTimePoint deadline,
                                    const ReadHybridTime& read_time,
@@ -447,14 +533,36 @@ Status PgsqlReadOperation::Execute(const common::YQLStorageIf& ql_storage,
   // Fetching data.
   int match_count = 0;
   QLTableRow::SharedPtr row = std::make_shared<QLTableRow>();
-  while (resultset->rsrow_count() < row_count_limit && VERIFY_RESULT(iter->HasNext()) &&
-         !scan_time_exceeded) {
 
-    row->Clear();
+  // Match the row with the where condition before adding to the row block.
+  auto process_row = [this, &match_count, resultset](
+      const QLTableRow::SharedPtr& table_row, Slice row_key) -> Status {
+    current_row_key_ = row_key;
+    bool is_match = true;
+    if (request_.has_where_expr()) {
+      QLValue match;
+      RETURN_NOT_OK(EvalExpr(request_.where_expr(), table_row, &match));
+      is_match = match.bool_value();
+    }
+    if (is_match && VERIFY_RESULT(SkipRowToLock(row_key))) {
+      is_match = false;
+    }
+    if (is_match) {
+      match_count++;
+      if (request_.is_aggregate()) {
+        RETURN_NOT_OK(EvalAggregate(table_row));
+      } else {
+        RETURN_NOT_OK(PopulateResultSet(table_row, resultset));
+      }
+    }
+    return Status::OK();
+  };
 
-    // If there is an index request, fetch ybbasectid from the index and use it as ybctid
-    // to fetch from the base table. Otherwise, fetch from the base table directly.
-    if (request_.has_index_request()) {
+  if (request_.has_index_request()) {
+    while (resultset->rsrow_count() < row_count_limit && VERIFY_RESULT(iter->HasNext()) &&
+           !scan_time_exceeded) {
+      // Fetch ybbasectid from the index and use it as ybctid to fetch from the base table.
+      row->Clear();
       RETURN_NOT_OK(iter->NextRow(row.get()));
       const auto& tuple_id = row->GetValue(ybbasectid_id);
       SCHECK_NE(tuple_id, boost::none, Corruption, "ybbasectid not found in index row");
@@ -465,33 +573,43 @@ Status PgsqlReadOperation::Execute(const common::YQLStorageIf& ql_storage,
       }
       row->Clear();
       RETURN_NOT_OK(table_iter_->NextRow(projection, row.get()));
-    } else {
-      RETURN_NOT_OK(iter->NextRow(projection, row.get()));
-    }
 
-    // Match the row with the where condition before adding to the row block.
-    bool is_match = true;
-    if (request_.has_where_expr()) {
-      QLValue match;
-      RETURN_NOT_OK(EvalExpr(request_.where_expr(), row, &match));
-      is_match = match.bool_value();
-    }
-    if (is_match) {
-      match_count++;
-      if (request_.is_aggregate()) {
-        RETURN_NOT_OK(EvalAggregate(row));
-      } else {
-        RETURN_NOT_OK(PopulateResultSet(row, resultset));
+      RETURN_NOT_OK(process_row(row, VERIFY_RESULT(table_iter_->GetRowKey())));
+
+      // Check every row_count_limit matches whether we've exceeded our scan time.
+      if (match_count % row_count_limit == 0) {
+        const MonoDelta elapsed_time = MonoTime::Now().GetDeltaSince(start_time);
+        scan_time_exceeded = elapsed_time.ToMilliseconds() > scan_time_limit;
       }
     }
+  } else {
+    // Fetch the rows from the base table in batches. The batch never exceeds the number of rows
+    // that could still be added to the result set, so every fetched row is processed and the
+    // paging state stays correct.
+    const size_t max_batch_size = std::max(FLAGS_ysql_scan_batch_size, 1);
+    std::vector<QLTableRow::SharedPtr> rows;
+    // The iterator is positioned after the batch, so the tuple id of each row is taken from its
+    // row key.
+    std::vector<std::string> row_keys;
+    while (resultset->rsrow_count() < row_count_limit && !scan_time_exceeded) {
+      const size_t batch_size = std::min(
+          max_batch_size, row_count_limit - resultset->rsrow_count());
+      const size_t num_rows = VERIFY_RESULT(
+          iter->NextRowBatch(projection, batch_size, &rows, &row_keys));
+      for (size_t i = 0; i != num_rows; ++i) {
+        RETURN_NOT_OK(process_row(rows[i], row_keys[i]));
+      }
+      if (num_rows < batch_size) {
+        break;
+      }
 
-    // Check every row_count_limit matches whether we've exceeded our scan time.
-    if (match_count % row_count_limit == 0) {
       const MonoDelta elapsed_time = MonoTime::Now().GetDeltaSince(start_time);
       scan_time_exceeded = elapsed_time.ToMilliseconds() > scan_time_limit;
     }
   }
 
+  current_row_key_.clear();
+
   if (request_.is_aggregate() && match_count > 0) {
     RETURN_NOT_OK(PopulateAggregate(row, resultset));
   }
@@ -501,7 +619,43 @@ Status PgsqlReadOperation::Execute(const common::YQLStorageIf& ql_storage,
   }
   *restart_read_ht = iter->RestartReadHt();
 
-  return SetPagingStateIfNecessary(iter, resultset, row_count_limit, scan_time_exceeded);
+  RETURN_NOT_OK(SetPagingStateIfNecessary(iter, resultset, row_count_limit, scan_time_exceeded));
+
+  // All rows of the key range selected by the request were read, so the whole range is locked with
+  // a single intent, instead of an intent per row. When locked rows are skipped, only the rows
+  // that were returned should be locked.
+  if (row_keys_to_lock_.size() > 1 && !locked_key_checker_ && !response_.has_paging_state() &&
+      SelectsWholeRange()) {
+    row_keys_to_lock_.assign(1, VERIFY_RESULT(EncodeSelectedRange(schema)));
+  }
+
+  return Status::OK();
+}
+
+bool PgsqlReadOperation::SelectsWholeRange() const {
+  return !request_.has_where_expr() && !request_.has_condition_expr() &&
+         request_.range_column_values().empty() && !request_.has_ybctid_column_value() &&
+         request_.batch_arguments().empty() && !request_.has_index_request() &&
+         !request_.has_paging_state() &&
+         (!request_.partition_column_values().empty() ||
+          (!request_.has_hash_code() && !request_.has_max_hash_code()));
+}
+
+Result<std::string> PgsqlReadOperation::EncodeSelectedRange(const Schema& schema) const {
+  if (request_.partition_column_values().empty()) {
+    // Empty components mean that we don't have primary key at all, but request
+    // could still contain hash_code as part of tablet routing.
+    // So we should ignore it.
+    DocKey doc_key(schema);
+    return doc_key.Encode().data();
+  }
+
+  std::vector<PrimitiveValue> hashed_components;
+  RETURN_NOT_OK(InitKeyColumnPrimitiveValues(
+      request_.partition_column_values(), schema, 0 /* start_idx */, &hashed_components));
+
+  DocKey doc_key(schema, request_.hash_code(), hashed_components);
+  return doc_key.Encode().data();
 }
 
 Status PgsqlReadOperation::ExecuteBatch(const common::YQLStorageIf& ql_storage,
@@ -526,6 +680,12 @@ Status PgsqlReadOperation::ExecuteBatch(const common::YQLStorageIf& ql_storage,
            "Given ybctid is not associated with any row in table");
     RETURN_NOT_OK(table_iter_->NextRow(projection, row.get()));
 
+    // Rows of the batch are not skipped even if they are locked, because the response should
+    // contain a row for every batch argument.
+    if (lock_rows_) {
+      row_keys_to_lock_.push_back(VERIFY_RESULT(table_iter_->GetRowKey()).ToBuffer());
+    }
+
     // Populate result set.
     RETURN_NOT_OK(PopulateResultSet(row, resultset));
     row_count++;
@@ -577,7 +737,12 @@ Status PgsqlReadOperation::GetTupleId(QLValue *result) const {
   // TODO(neil) Check if we need to append a table_id and other info to TupleID. For example, we
   // might need info to make sure the TupleId by itself is a valid reference to a specific row of
   // a valid table.
-  const Slice tuple_id = VERIFY_RESULT(table_iter_->GetTupleId());
+  Slice tuple_id;
+  if (current_row_key_.empty()) {
+    tuple_id = VERIFY_RESULT(table_iter_->GetTupleId());
+  } else {
+    tuple_id = TupleIdFromRowKey(current_row_key_);
+  }
   result->set_binary_value(tuple_id.data(), tuple_id.size());
   return Status::OK();
 }
@@ -608,22 +773,7 @@ Status PgsqlReadOperation::PopulateAggregate(const QLTableRow::SharedPtr& table_
 
 Status PgsqlReadOperation::GetIntents(const Schema& schema, KeyValueWriteBatchPB* out) {
   auto pair = out->mutable_read_pairs()->Add();
-
-  if (request_.partition_column_values().empty()) {
-    // Empty components mean that we don't have primary key at all, but request
-    // could still contain hash_code as part of tablet routing.
-    // So we should ignore it.
-    DocKey doc_key(schema);
-    pair->set_key(doc_key.Encode().data());
-  } else {
-    std::vector<PrimitiveValue> hashed_components;
-    RETURN_NOT_OK(InitKeyColumnPrimitiveValues(
-        request_.partition_column_values(), schema, 0 /* start_idx */, &hashed_components));
-
-    DocKey doc_key(schema, request_.hash_code(), hashed_components);
-    pair->set_key(doc_key.Encode().data());
-  }
-
+  pair->set_key(VERIFY_RESULT(EncodeSelectedRange(schema)));
   pair->set_value(std::string(1, ValueTypeAsChar::kNullLow));
   return Status::OK();
 }
@@ -33,6 +33,8 @@ class YQLStorageIf;
 
 namespace docdb {
 
+class LockedKeyChecker;
+
 YB_STRONGLY_TYPED_BOOL(IsUpsert);
 
 class PgsqlWriteOperation :
@@ -79,6 +81,9 @@ class PgsqlWriteOperation :
 
   CHECKED_STATUS PopulateResultSet(const QLTableRow::SharedPtr& table_row);
 
+  // Whether the inserted row could be written as a single packed value at the DocKey level.
+  bool MayWritePackedRow() const;
+
   // Reading path to operate on.
   CHECKED_STATUS GetDocPaths(GetDocPathsMode mode,
                              DocPathsToLock *paths,
@@ -107,13 +112,20 @@ class PgsqlReadOperation : public DocExprExecutor {
  public:
   // Construct and access methods.
   PgsqlReadOperation(const PgsqlReadRequestPB& request,
-                     const TransactionOperationContextOpt& txn_op_context)
-      : request_(request), txn_op_context_(txn_op_context) {
-  }
+                     const TransactionOperationContextOpt& txn_op_context);
+  ~PgsqlReadOperation();
 
   const PgsqlReadRequestPB& request() const { return request_; }
   PgsqlResponsePB& response() { return response_; }
 
+  // Makes Execute skip the rows that are locked by other transactions in doc_db, for the SKIP
+  // LOCKED wait policy of the request row mark. Does nothing for other requests.
+  void SkipLockedRows(const DocDB& doc_db);
+
+  // Encoded doc keys of the rows returned by Execute, if the request has a row mark. The rows are
+  // collected so exactly the rows that were read could be locked.
+  std::vector<std::string>& row_keys_to_lock() { return row_keys_to_lock_; }
+
   CHECKED_STATUS Execute(const common::YQLStorageIf& ql_storage,
                          CoarseTimePoint deadline,
                          const ReadHybridTime& read_time,
@@ -149,12 +161,33 @@ class PgsqlReadOperation : public DocExprExecutor {
                                            const size_t row_count_limit,
                                            const bool scan_time_exceeded);
 
+  //------------------------------------------------------------------------------------------------
+  // Returns whether the request selects all rows of the key range returned by
+  // EncodeSelectedRange.
+  bool SelectsWholeRange() const;
+
+  // Returns the encoded doc key prefix of the rows selected by the request, that is locked by read
+  // intents of the request.
+  Result<std::string> EncodeSelectedRange(const Schema& schema) const;
+
+  // Returns whether the row should be skipped because it is locked. Also remembers the row key to
+  // lock it, when it is not skipped.
+  Result<bool> SkipRowToLock(Slice row_key);
+
   //------------------------------------------------------------------------------------------------
   const PgsqlReadRequestPB& request_;
   const TransactionOperationContextOpt txn_op_context_;
   PgsqlResponsePB response_;
   common::YQLRowwiseIteratorIf::UniPtr table_iter_;
   common::YQLRowwiseIteratorIf::UniPtr index_iter_;
+
+  // Key of the row being processed, when it differs from the current row of table_iter_, i.e. when
+  // rows are fetched in batches.
+  Slice current_row_key_;
+
+  const bool lock_rows_;
+  std::vector<std::string> row_keys_to_lock_;
+  std::unique_ptr<LockedKeyChecker> locked_key_checker_;
 };
 
 }  // namespace docdb
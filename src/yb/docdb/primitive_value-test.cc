@@ -395,6 +395,30 @@ TEST(PrimitiveValueTest, TestMove) {
   TestMove(PrimitiveValue(HybridTime(1000)), 1000, 1000);
 }
 
+TEST(PrimitiveValueTest, TestMoveToQLValuePB) {
+  const std::string kValue(1000, 'x');
+  QLValuePB string_value;
+  PrimitiveValue::ToQLValuePB(
+      PrimitiveValue(kValue), QLType::Create(DataType::STRING), &string_value);
+  ASSERT_EQ(kValue, string_value.string_value());
+
+  QLValuePB binary_value;
+  PrimitiveValue::ToQLValuePB(
+      PrimitiveValue(kValue), QLType::Create(DataType::BINARY), &binary_value);
+  ASSERT_EQ(kValue, binary_value.binary_value());
+
+  // Values without string payload are converted as usual.
+  QLValuePB int_value;
+  PrimitiveValue::ToQLValuePB(
+      PrimitiveValue(1000), QLType::Create(DataType::INT64), &int_value);
+  ASSERT_EQ(1000, int_value.int64_value());
+
+  QLValuePB null_value;
+  PrimitiveValue::ToQLValuePB(
+      PrimitiveValue(), QLType::Create(DataType::STRING), &null_value);
+  ASSERT_EQ(QLValuePB::VALUE_NOT_SET, null_value.value_case());
+}
+
 // Ensures that the serialized version of a primitive value compares the same way as the primitive
 // value.
 void ComparePrimitiveValues(const PrimitiveValue& v1, const PrimitiveValue& v2) {
@@ -208,8 +208,7 @@ Status QLRocksDBStorage::GetIterator(const PgsqlReadRequestPB& request,
                                                     start_sub_doc_key.doc_key(),
                                                     request.is_forward_scan())));
     } else {
-      // Construct the scan spec basing on the WHERE condition.
-      CHECK(!request.has_where_expr()) << "WHERE clause is not yet supported in docdb::pgsql";
+      // Construct the scan spec basing on the key conditions.
       RETURN_NOT_OK(doc_iter->Init(DocPgsqlScanSpec(schema,
                                                     request.stmt_id(),
                                                     hashed_components,
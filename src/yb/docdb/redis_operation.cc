@@ -30,6 +30,10 @@ DEFINE_bool(emulate_redis_responses,
     "and HDEL. If emulate_redis_responses is true, we read the required records to compute the "
     "response as specified by the official Redis API documentation. https://redis.io/commands");
 
+DEFINE_bool(redis_sorted_set_read_from_end, true,
+            "Read ZRANGE and ZREVRANGE index ranges that are closer to the highest score than to "
+            "the lowest one by iterating the sorted set backwards from its highest score.");
+
 namespace yb {
 namespace docdb {
 
@@ -1555,6 +1559,14 @@ Status RedisReadOperation::ExecuteCollectionGetRange() {
 
       bool add_keys = request_.get_collection_range_request().with_scores();
 
+      // Forward scan has to skip all members before the range, so leaderboard like queries for
+      // the top members of a large set are served from the end of the set instead.
+      if (FLAGS_redis_sorted_set_read_from_end &&
+          card - 1 - high_idx_normalized < low_idx_normalized) {
+        return ExecuteSortedSetGetRangeFromEnd(
+            encoded_doc_key, card, low_idx_normalized, high_idx_normalized, add_keys, reverse);
+      }
+
       IndexBound low_bound = IndexBound(low_idx_normalized, true /* is_lower */);
       IndexBound high_bound = IndexBound(high_idx_normalized, false /* is_lower */);
 
@@ -1577,6 +1589,65 @@ Status RedisReadOperation::ExecuteCollectionGetRange() {
   return Status::OK();
 }
 
+Status RedisReadOperation::ExecuteSortedSetGetRangeFromEnd(
+    const KeyBytes& encoded_forward_key, int64_t card, int64_t low_idx, int64_t high_idx,
+    bool add_keys, bool reverse) {
+  // Number of members with the highest scores that are after the requested range.
+  int64_t num_to_skip = card - 1 - high_idx;
+  int64_t num_to_take = high_idx - low_idx + 1;
+
+  // Score subdocuments are visited from the highest score one, so only members that are after
+  // the range and members of the range are read.
+  SubDocument result;
+  KeyBytes seek_key = encoded_forward_key;
+  seek_key.AppendValueType(ValueType::kMaxByte);
+  while (num_to_take > 0) {
+    if (deadline_info_->CheckAndSetDeadlinePassed()) {
+      return STATUS(Expired, "Deadline for query passed.");
+    }
+    iterator_->PrevSubDocKey(seek_key);
+    if (!iterator_->valid()) {
+      break;
+    }
+    auto key = VERIFY_RESULT(iterator_->FetchKey()).key;
+    if (!key.starts_with(encoded_forward_key.AsSlice()) ||
+        key.size() == encoded_forward_key.size()) {
+      // Reached the beginning of the forward mapping.
+      break;
+    }
+    Slice score_slice = key;
+    score_slice.remove_prefix(encoded_forward_key.size());
+    PrimitiveValue score;
+    RETURN_NOT_OK(score.DecodeFromKey(&score_slice));
+    seek_key.Reset(Slice(key.data(), score_slice.data()));
+
+    SubDocument members;
+    bool members_found = false;
+    GetSubDocumentData data = { seek_key, &members, &members_found };
+    data.deadline_info = deadline_info_.get_ptr();
+    RETURN_NOT_OK(GetSubDocument(
+        iterator_.get(), data, /* projection */ nullptr, SeekFwdSuffices::kFalse));
+    if (!members_found || !IsObjectType(members.value_type())) {
+      // All members with this score were removed.
+      continue;
+    }
+
+    const auto& container = members.object_container();
+    for (auto it = container.rbegin(); it != container.rend() && num_to_take > 0; ++it) {
+      if (num_to_skip > 0) {
+        --num_to_skip;
+        continue;
+      }
+      result.GetOrAddChild(score).first->SetChild(it->first, SubDocument(PrimitiveValue()));
+      --num_to_take;
+    }
+  }
+
+  response_.set_code(RedisResponsePB::OK);
+  return PopulateResponseFrom(result.object_container(), AddResponseValuesSortedSets, &response_,
+                              add_keys, /* add_values */ true, reverse);
+}
+
 Result<RedisDataType> RedisReadOperation::GetValueType(int subkey_index) {
   return GetRedisValueType(iterator_.get(), request_.key_value(),
                            nullptr /* doc_write_batch */, subkey_index);
@@ -128,6 +128,11 @@ class RedisReadOperation {
   CHECKED_STATUS ExecuteCollectionGetRangeByBounds(
       RedisCollectionGetRangeRequestPB::GetRangeRequestType request_type,
       const RedisSubKeyBoundPB& lower_bound, const RedisSubKeyBoundPB& upper_bound, bool add_keys);
+  // Reads members of the sorted set with ascending positions in [low_idx, high_idx] by iterating
+  // the forward mapping backwards from the highest score.
+  CHECKED_STATUS ExecuteSortedSetGetRangeFromEnd(
+      const KeyBytes& encoded_forward_key, int64_t card, int64_t low_idx, int64_t high_idx,
+      bool add_keys, bool reverse);
   CHECKED_STATUS ExecuteKeys();
 
   rocksdb::QueryId redis_query_id() { return reinterpret_cast<rocksdb::QueryId> (&request_); }
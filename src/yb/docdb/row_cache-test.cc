@@ -0,0 +1,154 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/row_cache.h"
+
+#include "yb/docdb/doc_key.h"
+
+#include "yb/util/size_literals.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+using namespace yb::size_literals;  // NOLINT.
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+constexpr size_t kCapacity = 1 << 20;
+const ColumnId kColumn1(10);
+const ColumnId kColumn2(11);
+
+HybridTime Time(uint64_t micros) {
+  return HybridTime::FromMicros(micros);
+}
+
+DocKey MakeDocKey(int32_t hash_value, int32_t range_value) {
+  return DocKey(0x1234, {PrimitiveValue::Int32(hash_value)},
+                {PrimitiveValue::Int32(range_value)});
+}
+
+QLTableRow MakeRow(int32_t value) {
+  QLTableRow row;
+  row.AllocColumn(kColumn1).value.set_int32_value(value);
+  row.AllocColumn(kColumn2).value.set_int32_value(value + 1);
+  return row;
+}
+
+void WriteColumn(const DocKey& doc_key, HybridTime write_time, RowCache* cache) {
+  rocksdb::WriteBatch write_batch;
+  write_batch.Put(SubDocKey(doc_key, PrimitiveValue(kColumn1), write_time).Encode().AsSlice(),
+                  Slice("value"));
+  cache->InvalidateWriteBatch(write_batch);
+}
+
+void Insert(const DocKey& doc_key, HybridTime read_time, RowCache* cache) {
+  auto key = doc_key.Encode();
+  auto row = MakeRow(1);
+  cache->Insert(key.AsSlice(), read_time, cache->Generation(key.AsSlice()),
+                {kColumn1, kColumn2}, &row);
+}
+
+bool Contains(const DocKey& doc_key, HybridTime read_time, RowCache* cache) {
+  bool found = false;
+  QLTableRow row;
+  return cache->Lookup(doc_key.Encode().AsSlice(), read_time, {kColumn1}, &found, &row);
+}
+
+} // namespace
+
+class RowCacheTest : public YBTest {
+ protected:
+  RowCache cache_{kCapacity};
+};
+
+TEST_F(RowCacheTest, Lookup) {
+  const auto doc_key = MakeDocKey(1, 2);
+  const auto key = doc_key.Encode();
+  Insert(doc_key, Time(1000), &cache_);
+
+  bool found = false;
+  QLTableRow row;
+  ASSERT_FALSE(cache_.Lookup(key.AsSlice(), Time(999), {kColumn1}, &found, &row));
+  ASSERT_TRUE(cache_.Lookup(key.AsSlice(), Time(1000), {kColumn1, kColumn2}, &found, &row));
+  ASSERT_TRUE(found);
+  ASSERT_EQ(row.TestValue(kColumn1).value.int32_value(), 1);
+  ASSERT_EQ(row.TestValue(kColumn2).value.int32_value(), 2);
+  // Columns that were not read are not cached.
+  ASSERT_FALSE(cache_.Lookup(key.AsSlice(), Time(2000), {kColumn1, ColumnId(12)}, &found, &row));
+
+  const auto missing_key = MakeDocKey(1, 3).Encode();
+  cache_.Insert(missing_key.AsSlice(), Time(1000), cache_.Generation(missing_key.AsSlice()),
+                {kColumn1}, nullptr /* row */);
+  ASSERT_TRUE(cache_.Lookup(missing_key.AsSlice(), Time(1500), {kColumn1}, &found, &row));
+  ASSERT_FALSE(found);
+}
+
+TEST_F(RowCacheTest, Invalidate) {
+  const auto doc_key = MakeDocKey(1, 2);
+  const auto other_doc_key = MakeDocKey(1, 3);
+  Insert(doc_key, Time(1000), &cache_);
+  Insert(other_doc_key, Time(1000), &cache_);
+
+  WriteColumn(doc_key, Time(2000), &cache_);
+  ASSERT_FALSE(Contains(doc_key, Time(3000), &cache_));
+  ASSERT_TRUE(Contains(other_doc_key, Time(3000), &cache_));
+
+  // The read started before the write, so it could miss it.
+  const auto key = doc_key.Encode();
+  const auto generation = cache_.Generation(key.AsSlice());
+  WriteColumn(doc_key, Time(3000), &cache_);
+  auto row = MakeRow(1);
+  cache_.Insert(key.AsSlice(), Time(4000), generation, {kColumn1}, &row);
+  ASSERT_FALSE(Contains(doc_key, Time(4000), &cache_));
+
+  // The read time is before the latest write.
+  Insert(doc_key, Time(2500), &cache_);
+  ASSERT_FALSE(Contains(doc_key, Time(4000), &cache_));
+
+  Insert(doc_key, Time(3000), &cache_);
+  ASSERT_TRUE(Contains(doc_key, Time(4000), &cache_));
+}
+
+TEST_F(RowCacheTest, InvalidateHashPrefix) {
+  const auto doc_key = MakeDocKey(1, 2);
+  const auto other_hash_doc_key = MakeDocKey(2, 2);
+  Insert(doc_key, Time(1000), &cache_);
+  Insert(other_hash_doc_key, Time(1000), &cache_);
+
+  // Range delete of all rows with the hash components of doc_key.
+  WriteColumn(DocKey(doc_key.hash(), doc_key.hashed_group()), Time(2000), &cache_);
+  ASSERT_FALSE(Contains(doc_key, Time(3000), &cache_));
+  ASSERT_TRUE(Contains(other_hash_doc_key, Time(3000), &cache_));
+}
+
+TEST_F(RowCacheTest, Evict) {
+  constexpr int kNumRows = 10000;
+  RowCache cache(32_KB);
+  for (int i = 0; i != kNumRows; ++i) {
+    Insert(MakeDocKey(i, i), Time(1000), &cache);
+  }
+  ASSERT_LE(cache.TEST_charge(), 32_KB);
+  ASSERT_GT(cache.TEST_num_entries(), 0);
+  ASSERT_LT(cache.TEST_num_entries(), kNumRows);
+  // Recently inserted rows are kept.
+  ASSERT_TRUE(Contains(MakeDocKey(kNumRows - 1, kNumRows - 1), Time(1000), &cache));
+
+  cache.Clear();
+  ASSERT_EQ(cache.TEST_num_entries(), 0);
+  ASSERT_EQ(cache.TEST_charge(), 0);
+}
+
+}  // namespace docdb
+}  // namespace yb
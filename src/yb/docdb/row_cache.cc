@@ -0,0 +1,314 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/row_cache.h"
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <mutex>
+
+#include <glog/logging.h>
+
+#include "yb/common/doc_hybrid_time.h"
+
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_kv_util.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/rocksdb/util/hash.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+constexpr size_t kNumShards = 16;
+constexpr uint32_t kRowCacheSeed = 0x9e3779b9;
+
+struct SliceLess {
+  bool operator()(const Slice& lhs, const Slice& rhs) const {
+    return lhs.compare(rhs) < 0;
+  }
+};
+
+class RowCacheBatchHandler : public rocksdb::WriteBatch::Handler {
+ public:
+  explicit RowCacheBatchHandler(RowCache* cache) : cache_(cache) {}
+
+  void Put(const Slice& key, const Slice& /* value */) override {
+    cache_->Invalidate(key);
+  }
+
+  void Delete(const Slice& key) override {
+    cache_->Invalidate(key);
+  }
+
+  void SingleDelete(const Slice& key) override {
+    cache_->Invalidate(key);
+  }
+
+ private:
+  RowCache* const cache_;
+};
+
+} // namespace
+
+class RowCache::Shard {
+ public:
+  void Init(size_t capacity) {
+    capacity_ = capacity;
+  }
+
+  uint64_t generation() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return generation_;
+  }
+
+  bool Lookup(const Slice& key, HybridTime read_time, const std::vector<ColumnId>& columns,
+              bool* found, QLTableRow* row) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      return false;
+    }
+    auto& entry = *it->second;
+    if (read_time < entry.version ||
+        !std::includes(entry.columns.begin(), entry.columns.end(),
+                       columns.begin(), columns.end())) {
+      return false;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second);
+    *found = entry.found;
+    if (entry.found) {
+      *row = entry.row;
+    }
+    return true;
+  }
+
+  void Insert(const Slice& key, HybridTime read_time, uint64_t generation,
+              std::vector<ColumnId> columns, const QLTableRow* row) {
+    size_t charge = sizeof(Entry) + key.size() + columns.size() * sizeof(ColumnId);
+    if (row) {
+      for (const auto& column : columns) {
+        const auto* value = row->GetColumn(column.rep());
+        charge += sizeof(QLTableColumn) + (value ? value->SpaceUsedLong() : 0);
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // A write that was invalidated after the generation was obtained could be missed by the read,
+    // as well as a write after the read time that was invalidated before.
+    if (generation != generation_ || read_time < max_write_time_ || charge > capacity_) {
+      return;
+    }
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      Erase(it);
+    }
+    while (charge_ + charge > capacity_) {
+      Erase(index_.find(Slice(lru_.back().key)));
+    }
+    lru_.emplace_front();
+    auto& entry = lru_.front();
+    entry.key = key.ToBuffer();
+    entry.version = read_time;
+    entry.columns = std::move(columns);
+    entry.found = row != nullptr;
+    if (row) {
+      entry.row = *row;
+    }
+    entry.charge = charge;
+    charge_ += charge;
+    index_.emplace(Slice(entry.key), lru_.begin());
+  }
+
+  // Removes entries with keys starting with prefix.
+  void Invalidate(const Slice& prefix, HybridTime write_time) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++generation_;
+    max_write_time_.MakeAtLeast(write_time);
+    auto it = index_.lower_bound(prefix);
+    while (it != index_.end() && it->first.starts_with(prefix)) {
+      Erase(it++);
+    }
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++generation_;
+    index_.clear();
+    lru_.clear();
+    charge_ = 0;
+  }
+
+  size_t num_entries() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_.size();
+  }
+
+  size_t charge() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return charge_;
+  }
+
+ private:
+  struct Entry {
+    std::string key;
+    HybridTime version;
+    // Sorted ids of the columns the row was read with.
+    std::vector<ColumnId> columns;
+    bool found = false;
+    QLTableRow row;
+    size_t charge = 0;
+  };
+
+  using Lru = std::list<Entry>;
+  // Keys of the index point to keys of the entries.
+  using Index = std::map<Slice, Lru::iterator, SliceLess>;
+
+  void Erase(Index::iterator it) {
+    auto lru_it = it->second;
+    index_.erase(it);
+    charge_ -= lru_it->charge;
+    lru_.erase(lru_it);
+  }
+
+  size_t capacity_ = 0;
+  mutable std::mutex mutex_;
+  uint64_t generation_ = 0;
+  // Max hybrid time of the writes invalidated in this shard.
+  HybridTime max_write_time_ = HybridTime::kMin;
+  // Entries from the most recently used to the least recently used.
+  Lru lru_;
+  Index index_;
+  size_t charge_ = 0;
+};
+
+RowCache::RowCache(size_t capacity_bytes) : shards_(new Shard[kNumShards]) {
+  for (size_t i = 0; i != kNumShards; ++i) {
+    shards_[i].Init(capacity_bytes / kNumShards);
+  }
+}
+
+RowCache::~RowCache() = default;
+
+RowCache::Shard& RowCache::ShardForHashPart(const Slice& encoded_hash_part) const {
+  // Rows of the same hash part are kept in the same shard, so writes of a hash part prefix find
+  // all of them.
+  auto hash = rocksdb::Hash(encoded_hash_part.cdata(), encoded_hash_part.size(), kRowCacheSeed);
+  return shards_[hash % kNumShards];
+}
+
+RowCache::Shard* RowCache::ShardForDocKey(const Slice& encoded_doc_key) const {
+  auto sizes = DocKey::EncodedHashPartAndDocKeySizes(encoded_doc_key);
+  if (!sizes.ok()) {
+    return nullptr;
+  }
+  return &ShardForHashPart(Slice(encoded_doc_key.data(), sizes->first));
+}
+
+uint64_t RowCache::Generation(const Slice& encoded_doc_key) const {
+  auto* shard = ShardForDocKey(encoded_doc_key);
+  return shard ? shard->generation() : 0;
+}
+
+bool RowCache::Lookup(const Slice& encoded_doc_key, HybridTime read_time,
+                      const std::vector<ColumnId>& columns, bool* found, QLTableRow* row) {
+  DCHECK(std::is_sorted(columns.begin(), columns.end()));
+  if (disabled_.load(std::memory_order_acquire)) {
+    return false;
+  }
+  auto* shard = ShardForDocKey(encoded_doc_key);
+  return shard && shard->Lookup(encoded_doc_key, read_time, columns, found, row);
+}
+
+void RowCache::Insert(const Slice& encoded_doc_key, HybridTime read_time, uint64_t generation,
+                      std::vector<ColumnId> columns, const QLTableRow* row) {
+  DCHECK(std::is_sorted(columns.begin(), columns.end()));
+  if (disabled_.load(std::memory_order_acquire)) {
+    return;
+  }
+  auto* shard = ShardForDocKey(encoded_doc_key);
+  if (shard) {
+    shard->Insert(encoded_doc_key, read_time, generation, std::move(columns), row);
+  }
+}
+
+void RowCache::InvalidateWriteBatch(const rocksdb::WriteBatch& write_batch) {
+  if (disabled_.load(std::memory_order_acquire)) {
+    return;
+  }
+  RowCacheBatchHandler handler(this);
+  auto status = write_batch.Iterate(&handler);
+  if (!status.ok()) {
+    LOG(WARNING) << "Failed to iterate regular write batch: " << status
+                 << ", disabling row cache";
+    Disable();
+  }
+}
+
+void RowCache::Invalidate(const Slice& regular_db_key) {
+  if (disabled_.load(std::memory_order_acquire)) {
+    return;
+  }
+  auto sizes = DocKey::EncodedHashPartAndDocKeySizes(regular_db_key);
+  DocHybridTime write_time;
+  Status status = sizes.ok() ? DecodeHybridTimeFromEndOfKey(regular_db_key, &write_time)
+                             : sizes.status();
+  if (status.ok() &&
+      (sizes->second == 0 || regular_db_key[sizes->second - 1] != ValueTypeAsChar::kGroupEnd)) {
+    status = STATUS(Corruption, "DocKey does not end with group end");
+  }
+  if (!status.ok()) {
+    LOG(WARNING) << "Failed to decode written key " << regular_db_key.ToDebugHexString() << ": "
+                 << status << ", disabling row cache";
+    Disable();
+    return;
+  }
+  // Without the closing group end, the DocKey is a prefix of the DocKeys of all rows it covers,
+  // for instance when all rows of the hash components are deleted.
+  ShardForHashPart(Slice(regular_db_key.data(), sizes->first)).Invalidate(
+      Slice(regular_db_key.data(), sizes->second - 1), write_time.hybrid_time());
+}
+
+void RowCache::Clear() {
+  for (size_t i = 0; i != kNumShards; ++i) {
+    shards_[i].Clear();
+  }
+}
+
+void RowCache::Disable() {
+  disabled_.store(true, std::memory_order_release);
+  // Clear bumps generations, so reads that are in progress would not add entries.
+  Clear();
+}
+
+size_t RowCache::TEST_num_entries() const {
+  size_t result = 0;
+  for (size_t i = 0; i != kNumShards; ++i) {
+    result += shards_[i].num_entries();
+  }
+  return result;
+}
+
+size_t RowCache::TEST_charge() const {
+  size_t result = 0;
+  for (size_t i = 0; i != kNumShards; ++i) {
+    result += shards_[i].charge();
+  }
+  return result;
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,98 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_ROW_CACHE_H
+#define YB_DOCDB_ROW_CACHE_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "yb/common/hybrid_time.h"
+#include "yb/common/ql_expr.h"
+
+#include "yb/rocksdb/write_batch.h"
+
+#include "yb/util/slice.h"
+
+namespace yb {
+namespace docdb {
+
+// Cache of rows assembled by point reads of a tablet, keyed by the encoded DocKey of the row.
+// Each entry keeps the row, the columns it was read with, and the read time it was read at, that
+// is the version of the entry. The entry is used for reads at or after its version, that reference
+// only columns of the entry.
+//
+// Entries are kept consistent with the regular DB as follows:
+// 1) Readers obtain the generation via Generation() before creating the DocDB iterator, and pass
+//    it to Insert().
+// 2) Each write to the regular DB is passed to InvalidateWriteBatch() after it is written. It
+//    removes entries of the written documents and bumps the generation of their shard.
+// 3) Insert() is ignored when the generation has changed since the read started, or when the read
+//    time is before a write already invalidated in the shard, since such read could miss it.
+//
+// Entries are sharded by the hash part of the DocKey, so a write of a DocKey prefix, like a range
+// delete, removes all rows it covers.
+class RowCache {
+ public:
+  explicit RowCache(size_t capacity_bytes);
+  ~RowCache();
+
+  RowCache(const RowCache&) = delete;
+  void operator=(const RowCache&) = delete;
+
+  uint64_t Generation(const Slice& encoded_doc_key) const;
+
+  // Returns true when the cache has an entry for the document, that could be used to read the
+  // specified columns at read_time. found is set to whether the row exists, and if it does, it is
+  // copied to row.
+  bool Lookup(const Slice& encoded_doc_key, HybridTime read_time,
+              const std::vector<ColumnId>& columns, bool* found, QLTableRow* row);
+
+  // Adds the result of a read of the specified columns at read_time, row is nullptr when the row
+  // was not found.
+  void Insert(const Slice& encoded_doc_key, HybridTime read_time, uint64_t generation,
+              std::vector<ColumnId> columns, const QLTableRow* row);
+
+  // Invalidates entries of the documents written to the regular DB by the batch.
+  void InvalidateWriteBatch(const rocksdb::WriteBatch& write_batch);
+
+  // Invalidates entries of the document written to the regular DB with the specified key.
+  void Invalidate(const Slice& regular_db_key);
+
+  // Removes all entries, should be called when the regular DB is replaced.
+  void Clear();
+
+  size_t TEST_num_entries() const;
+
+  size_t TEST_charge() const;
+
+ private:
+  class Shard;
+
+  Shard& ShardForHashPart(const Slice& encoded_hash_part) const;
+
+  // Returns nullptr when encoded_doc_key could not be decoded.
+  Shard* ShardForDocKey(const Slice& encoded_doc_key) const;
+
+  void Disable();
+
+  std::unique_ptr<Shard[]> shards_;
+  // Set when a written key could not be decoded, so the entries it covers are unknown.
+  std::atomic<bool> disabled_{false};
+};
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif // YB_DOCDB_ROW_CACHE_H
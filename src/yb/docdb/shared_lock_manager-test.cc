@@ -159,6 +159,40 @@ TEST_F(SharedLockManagerTest, QuickLockUnlock) {
   }
 }
 
+// Measures throughput of small non conflicting lock batches taken concurrently by many threads,
+// i.e. the pattern of many concurrent single row writes to a hot tablet.
+// Runs a full size benchmark only when slow tests are allowed.
+TEST_F(SharedLockManagerTest, ConcurrentSmallBatchesPerf) {
+  const auto kThreads = 16;
+  const auto kBatchesPerThread = AllowSlowTests() ? 100000 : 1000;
+  const auto kKeysPerBatch = 3;
+
+  std::vector<std::thread> threads;
+  auto start = MonoTime::Now();
+  while (threads.size() != kThreads) {
+    size_t thread_idx = threads.size();
+    threads.emplace_back([this, thread_idx] {
+      for (int i = 0; i != kBatchesPerThread; ++i) {
+        LockBatchEntries entries;
+        for (int j = 0; j != kKeysPerBatch; ++j) {
+          entries.push_back(LockBatchEntry{
+              RefCntPrefix(Format("key_$0_$1_$2", thread_idx, i, j)),
+              IntentTypeSet({IntentType::kStrongWrite, IntentType::kStrongRead})});
+        }
+        LockBatch lb(&lm_, std::move(entries), CoarseTimePoint::max());
+        ASSERT_OK(lb.status());
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto passed = MonoTime::Now() - start;
+  LOG(INFO) << "Lock batches per second: "
+            << kThreads * kBatchesPerThread / passed.ToSeconds() << ", passed: " << passed;
+}
+
 TEST_F(SharedLockManagerTest, LockConflicts) {
   rpc::ThreadPool tp(rpc::ThreadPoolOptions{"test_pool"s, 10, 1});
 
@@ -184,5 +218,25 @@ TEST_F(SharedLockManagerTest, LockConflicts) {
   tp.Shutdown();
 }
 
+TEST_F(SharedLockManagerTest, HasConflictingLocks) {
+  const LockBatchEntries strong_read = {{kKey1, IntentTypeSet({IntentType::kStrongRead})}};
+  const LockBatchEntries weak_read = {{kKey1, IntentTypeSet({IntentType::kWeakRead})}};
+  ASSERT_FALSE(lm_.HasConflictingLocks(strong_read));
+
+  for (size_t idx = 0; idx != kIntentTypeSetMapSize; ++idx) {
+    IntentTypeSet set(idx);
+    SCOPED_TRACE(Format("Set: $0", set));
+    LockBatch lb(&lm_, {{kKey1, set}}, CoarseTimePoint::max());
+    ASSERT_OK(lb.status());
+    ASSERT_EQ(lm_.HasConflictingLocks(strong_read),
+              IntentTypeSetsConflict(set, IntentTypeSet({IntentType::kStrongRead})));
+    ASSERT_EQ(lm_.HasConflictingLocks(weak_read),
+              IntentTypeSetsConflict(set, IntentTypeSet({IntentType::kWeakRead})));
+    ASSERT_FALSE(lm_.HasConflictingLocks({{kKey2, IntentTypeSet({IntentType::kStrongRead})}}));
+  }
+
+  ASSERT_FALSE(lm_.HasConflictingLocks(strong_read));
+}
+
 } // namespace docdb
 } // namespace yb
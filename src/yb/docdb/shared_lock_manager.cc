@@ -13,11 +13,14 @@
 
 #include "yb/docdb/shared_lock_manager.h"
 
+#include <array>
 #include <vector>
 
 #include <boost/range/adaptor/reversed.hpp>
 #include <glog/logging.h>
 
+#include "yb/gutil/port.h"
+
 #include "yb/util/bytes_formatter.h"
 #include "yb/util/enums.h"
 #include "yb/util/logging.h"
@@ -102,19 +105,23 @@ bool IntentTypeSetsConflict(IntentTypeSet lhs, IntentTypeSet rhs) {
 }
 
 struct LockedBatchEntry {
-  // Taken only for short duration, with no blocking wait.
-  mutable std::mutex mutex;
+  // Number of holders for each type
+  std::atomic<LockState> num_holding{0};
 
-  std::condition_variable cond_var;
+  std::atomic<size_t> num_waiters{0};
 
-  // Refcounting for garbage collection. Can only be used while the global mutex is locked.
-  // Global mutex resides in lock manager and the same for all LockBatchEntries.
+  // Refcounting for garbage collection. Can only be used while the mutex of the shard that
+  // contains this entry is locked.
   size_t ref_count = 0;
 
-  // Number of holders for each type
-  std::atomic<LockState> num_holding{0};
+  // Taken only for short duration, with no blocking wait.
+  mutable std::mutex mutex;
 
-  std::atomic<size_t> num_waiters{0};
+  std::condition_variable cond_var;
+
+  // Entries are allocated separately, so the padding keeps hot counters of different entries
+  // from sharing a cache line.
+  char padding[CACHELINE_SIZE];
 
   MUST_USE_RESULT bool Lock(IntentTypeSet lock, CoarseTimePoint deadline);
 
@@ -132,30 +139,49 @@ class SharedLockManager::Impl {
  public:
   MUST_USE_RESULT bool Lock(LockBatchEntries* key_to_intent_type, CoarseTimePoint deadline);
   void Unlock(const LockBatchEntries& key_to_intent_type);
+  bool HasConflictingLocks(const LockBatchEntries& key_to_intent_type);
 
   ~Impl() {
-    std::lock_guard<std::mutex> lock(global_mutex_);
-    LOG_IF(DFATAL, !locks_.empty()) << "Locks not empty in dtor: " << yb::ToString(locks_);
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      LOG_IF(DFATAL, !shard.locks.empty())
+          << "Locks not empty in dtor: " << yb::ToString(shard.locks);
+    }
   }
 
  private:
   typedef std::unordered_map<RefCntPrefix, LockedBatchEntry*, RefCntPrefixHash> LockEntryMap;
 
-  // Make sure the entries exist in the locks_ map and return pointers so we can access
-  // them without holding the global lock. Returns a vector with pointers in the same order
+  // Lock entries are distributed between shards by key hash, so concurrent writes to different
+  // keys of the same tablet usually don't contend on the same mutex.
+  struct Shard {
+    // Taken only for short duration, with no blocking wait.
+    std::mutex mutex;
+
+    LockEntryMap locks GUARDED_BY(mutex);
+    // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
+    std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries GUARDED_BY(mutex);
+    std::vector<LockedBatchEntry*> free_lock_entries GUARDED_BY(mutex);
+
+    // Keeps mutexes of neighbour shards in different cache lines.
+    char padding[CACHELINE_SIZE];
+  };
+
+  static constexpr size_t kNumShards = 16;
+
+  Shard& ShardFor(const RefCntPrefix& key) {
+    return shards_[RefCntPrefixHash()(key) % kNumShards];
+  }
+
+  // Make sure the entries exist in the locks maps and return pointers so we can access
+  // them without holding the shard lock. Returns a vector with pointers in the same order
   // as the keys in the batch.
   void Reserve(LockBatchEntries* batch);
 
   // Update refcounts and maybe collect garbage.
   void Cleanup(const LockBatchEntries& key_to_intent_type);
 
-  // The global mutex should be taken only for very short duration, with no blocking wait.
-  std::mutex global_mutex_;
-
-  LockEntryMap locks_ GUARDED_BY(global_mutex_);
-  // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
-  std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries_ GUARDED_BY(global_mutex_);
-  std::vector<LockedBatchEntry*> free_lock_entries_ GUARDED_BY(global_mutex_);
+  std::array<Shard, kNumShards> shards_;
 };
 
 const std::array<LockState, kIntentTypeSetMapSize> kIntentTypeSetMask = GenerateByMask(
@@ -274,16 +300,23 @@ bool SharedLockManager::Impl::Lock(LockBatchEntries* key_to_intent_type, CoarseT
 }
 
 void SharedLockManager::Impl::Reserve(LockBatchEntries* key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
+  Shard* locked_shard = nullptr;
+  std::unique_lock<std::mutex> lock;
   for (auto& key_and_intent_type : *key_to_intent_type) {
-    auto& value = locks_[key_and_intent_type.key];
+    auto& shard = ShardFor(key_and_intent_type.key);
+    // Keys of a batch are frequently placed in the same shard, so keep its mutex locked.
+    if (&shard != locked_shard) {
+      lock = std::unique_lock<std::mutex>(shard.mutex);
+      locked_shard = &shard;
+    }
+    auto& value = shard.locks[key_and_intent_type.key];
     if (!value) {
-      if (!free_lock_entries_.empty()) {
-        value = free_lock_entries_.back();
-        free_lock_entries_.pop_back();
+      if (!shard.free_lock_entries.empty()) {
+        value = shard.free_lock_entries.back();
+        shard.free_lock_entries.pop_back();
       } else {
-        lock_entries_.emplace_back(std::make_unique<LockedBatchEntry>());
-        value = lock_entries_.back().get();
+        shard.lock_entries.emplace_back(std::make_unique<LockedBatchEntry>());
+        value = shard.lock_entries.back().get();
       }
     }
     value->ref_count++;
@@ -301,12 +334,34 @@ void SharedLockManager::Impl::Unlock(const LockBatchEntries& key_to_intent_type)
   Cleanup(key_to_intent_type);
 }
 
+bool SharedLockManager::Impl::HasConflictingLocks(const LockBatchEntries& key_to_intent_type) {
+  for (const auto& item : key_to_intent_type) {
+    auto& shard = ShardFor(item.key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.locks.find(item.key);
+    if (it == shard.locks.end()) {
+      continue;
+    }
+    auto num_holding = it->second->num_holding.load(std::memory_order_acquire);
+    if ((num_holding & kIntentTypeSetConflicts[item.intent_types.ToUIntPtr()]) != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void SharedLockManager::Impl::Cleanup(const LockBatchEntries& key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
+  Shard* locked_shard = nullptr;
+  std::unique_lock<std::mutex> lock;
   for (const auto& item : key_to_intent_type) {
+    auto& shard = ShardFor(item.key);
+    if (&shard != locked_shard) {
+      lock = std::unique_lock<std::mutex>(shard.mutex);
+      locked_shard = &shard;
+    }
     if (--(item.locked->ref_count) == 0) {
-      locks_.erase(item.key);
-      free_lock_entries_.push_back(item.locked);
+      shard.locks.erase(item.key);
+      shard.free_lock_entries.push_back(item.locked);
     }
   }
 }
@@ -324,5 +379,9 @@ void SharedLockManager::Unlock(const LockBatchEntries& key_to_intent_type) {
   impl_->Unlock(key_to_intent_type);
 }
 
+bool SharedLockManager::HasConflictingLocks(const LockBatchEntries& key_to_intent_type) {
+  return impl_->HasConflictingLocks(key_to_intent_type);
+}
+
 }  // namespace docdb
 }  // namespace yb
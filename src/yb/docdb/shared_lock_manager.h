@@ -49,6 +49,10 @@ class SharedLockManager {
   // Release the batch of locks. Requires that the locks are held.
   void Unlock(const LockBatchEntries& key_to_intent_type);
 
+  // Returns true if locking the batch would have to wait for locks that are currently held.
+  // Does not lock anything and does not wait.
+  bool HasConflictingLocks(const LockBatchEntries& key_to_intent_type);
+
   // Whether or not the state is possible
   static std::string ToString(const LockState& state);
 
@@ -164,5 +164,33 @@ TEST(SubDocumentTest, TestCopyMove) {
   ASSERT_EQ(ValueType::kNullLow, s2.value_type());
 }
 
+TEST(SubDocumentTest, ArenaScope) {
+  auto fill = [](SubDocument* doc) {
+    doc->GetOrAddChild(PrimitiveValue("foo")).first->SetChildPrimitive(
+        PrimitiveValue("bar"), PrimitiveValue(10));
+    doc->SetChildPrimitive(PrimitiveValue("baz"), PrimitiveValue("value"));
+  };
+  SubDocument expected;
+  fill(&expected);
+
+  Arena arena;
+  SubDocument copy;
+  {
+    SubDocumentArenaScope scope(&arena);
+    ASSERT_EQ(&arena, SubDocumentArenaScope::Current());
+    SubDocument doc;
+    fill(&doc);
+    ASSERT_EQ(&arena, doc.object_container().get_allocator().arena());
+    ASSERT_EQ(expected, doc);
+
+    // Copies are allocated from the heap, so they could outlive the arena.
+    copy = doc;
+    ASSERT_EQ(nullptr, copy.object_container().get_allocator().arena());
+  }
+  ASSERT_EQ(nullptr, SubDocumentArenaScope::Current());
+  arena.Reset();
+  ASSERT_EQ(expected, copy);
+}
+
 } // namespace docdb
 } // namespace yb
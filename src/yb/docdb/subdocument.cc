@@ -33,6 +33,25 @@ using yb::bfql::TSOpcode;
 namespace yb {
 namespace docdb {
 
+namespace {
+
+thread_local Arena* current_subdocument_arena = nullptr;
+
+} // namespace
+
+SubDocumentArenaScope::SubDocumentArenaScope(Arena* arena)
+    : previous_arena_(current_subdocument_arena) {
+  current_subdocument_arena = arena;
+}
+
+SubDocumentArenaScope::~SubDocumentArenaScope() {
+  current_subdocument_arena = previous_arena_;
+}
+
+Arena* SubDocumentArenaScope::Current() {
+  return current_subdocument_arena;
+}
+
 SubDocument::SubDocument(ValueType value_type) : PrimitiveValue(value_type) {
   if (IsCollectionType(value_type)) {
     EnsureContainerAllocated();
@@ -49,7 +68,7 @@ SubDocument::~SubDocument() {
     case ValueType::kSSForward: FALLTHROUGH_INTENDED;
     case ValueType::kSSReverse:
       if (has_valid_container()) {
-        delete &object_container();
+        DestroyObjectContainer();
       }
       break;
     case ValueType::kArray:
@@ -348,13 +367,29 @@ void SubDocCollectionToStreamInternal(ostream& out,
 void SubDocument::EnsureContainerAllocated() {
   if (complex_data_structure_ == nullptr) {
     if (IsObjectType(type_)) {
-      complex_data_structure_ = new ObjectContainer();
+      auto* arena = SubDocumentArenaScope::Current();
+      if (arena) {
+        complex_data_structure_ = arena->NewObject<ObjectContainer>(
+            std::less<PrimitiveValue>(), ObjectContainer::allocator_type(arena));
+      } else {
+        complex_data_structure_ = new ObjectContainer();
+      }
     } else if (type_ == ValueType::kArray) {
       complex_data_structure_ = new ArrayContainer();
     }
   }
 }
 
+void SubDocument::DestroyObjectContainer() {
+  auto& container = object_container();
+  if (container.get_allocator().arena()) {
+    // The container itself was allocated from the arena, so only destroy it.
+    container.~ObjectContainer();
+  } else {
+    delete &container;
+  }
+}
+
 SubDocument SubDocument::FromQLValuePB(const QLValuePB& value,
                                        ColumnSchema::SortingType sorting_type,
                                        TSOpcode write_instr) {
@@ -408,6 +443,16 @@ SubDocument SubDocument::FromQLValuePB(const QLValuePB& value,
   }
 }
 
+void SubDocument::ToQLValuePB(SubDocument&& doc,
+                              const shared_ptr<QLType>& ql_type,
+                              QLValuePB* ql_value) {
+  if (ql_type->HasComplexValues()) {
+    ToQLValuePB(static_cast<const SubDocument&>(doc), ql_type, ql_value);
+    return;
+  }
+  PrimitiveValue::ToQLValuePB(std::move(doc), ql_type, ql_value);
+}
+
 void SubDocument::ToQLValuePB(const SubDocument& doc,
                               const shared_ptr<QLType>& ql_type,
                               QLValuePB* ql_value) {
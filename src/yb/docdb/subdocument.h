@@ -21,10 +21,86 @@
 
 #include "yb/docdb/primitive_value.h"
 #include "yb/common/ql_expr.h"
+#include "yb/util/memory/arena.h"
 
 namespace yb {
 namespace docdb {
 
+// Allocator for SubDocument object containers. Allocates from the arena if one is set, otherwise
+// from the global heap. Copies of a container always use the global heap, so they could outlive
+// the arena.
+template <class T>
+class SubDocumentAllocator {
+ public:
+  typedef T value_type;
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+
+  SubDocumentAllocator() = default;
+
+  explicit SubDocumentAllocator(Arena* arena) : arena_(arena) {}
+
+  template <class U>
+  SubDocumentAllocator(const SubDocumentAllocator<U>& other) : arena_(other.arena()) {} // NOLINT
+
+  T* allocate(size_t n) {
+    if (!arena_) {
+      return std::allocator<T>().allocate(n);
+    }
+    auto* result = arena_->AllocateBytesAligned(n * sizeof(T), alignof(T));
+    if (PREDICT_FALSE(!result)) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(result);
+  }
+
+  void deallocate(T* p, size_t n) {
+    // Memory allocated from the arena is released all at once, when the arena is reset.
+    if (!arena_) {
+      std::allocator<T>().deallocate(p, n);
+    }
+  }
+
+  SubDocumentAllocator select_on_container_copy_construction() const {
+    return SubDocumentAllocator();
+  }
+
+  Arena* arena() const {
+    return arena_;
+  }
+
+ private:
+  Arena* arena_ = nullptr;
+};
+
+template <class T, class U>
+bool operator==(const SubDocumentAllocator<T>& lhs, const SubDocumentAllocator<U>& rhs) {
+  return lhs.arena() == rhs.arena();
+}
+
+template <class T, class U>
+bool operator!=(const SubDocumentAllocator<T>& lhs, const SubDocumentAllocator<U>& rhs) {
+  return !(lhs == rhs);
+}
+
+// While an instance of this class is alive, object containers of SubDocuments created by the
+// current thread are allocated from the specified arena. Such SubDocuments should be destroyed
+// before the arena is reset. Copies of them are allocated from the global heap as usual.
+class SubDocumentArenaScope {
+ public:
+  explicit SubDocumentArenaScope(Arena* arena);
+  ~SubDocumentArenaScope();
+
+  SubDocumentArenaScope(const SubDocumentArenaScope&) = delete;
+  void operator=(const SubDocumentArenaScope&) = delete;
+
+  // Arena of the innermost scope of the current thread, or nullptr if there is no such scope.
+  static Arena* Current();
+
+ private:
+  Arena* const previous_arena_;
+};
+
 // A subdocument could either be a primitive value, or an arbitrarily nested JSON-like data
 // structure. This class is copyable, but care should be taken to avoid expensive implicit copies.
 class SubDocument : public PrimitiveValue {
@@ -96,7 +172,9 @@ class SubDocument : public PrimitiveValue {
   bool operator!=(const SubDocument& other) const { return !(*this == other); }
 
   // "using" did not let us use the alias when instantiating these classes, so we're using typedef.
-  typedef std::map<PrimitiveValue, SubDocument> ObjectContainer;
+  typedef std::map<
+      PrimitiveValue, SubDocument, std::less<PrimitiveValue>,
+      SubDocumentAllocator<std::pair<const PrimitiveValue, SubDocument>>> ObjectContainer;
   typedef std::vector<SubDocument> ArrayContainer;
 
   ObjectContainer& object_container() const {
@@ -181,6 +259,11 @@ class SubDocument : public PrimitiveValue {
                           const std::shared_ptr<QLType>& ql_type,
                           QLValuePB* v);
 
+  // Same as above, but moves string and binary payloads of a primitive doc into v.
+  static void ToQLValuePB(SubDocument&& doc,
+                          const std::shared_ptr<QLType>& ql_type,
+                          QLValuePB* v);
+
  private:
 
   CHECKED_STATUS ConvertToCollection(ValueType value_type);
@@ -190,6 +273,8 @@ class SubDocument : public PrimitiveValue {
 
   void EnsureContainerAllocated();
 
+  void DestroyObjectContainer();
+
   bool container_allocated() const {
     CHECK(IsCollectionType(type_));
     return complex_data_structure_ != nullptr;
@@ -44,6 +44,8 @@ class Value {
   }
 
   static const uint64_t kTtlFlag = 0x1;
+  // The int64 value of the record is a delta added to the older value of a counter column.
+  static const uint64_t kCounterDeltaFlag = 0x2;
 
   static const MonoDelta kMaxTtl;
   // kResetTtl is useful for CQL when zero TTL indicates no TTL.
@@ -120,6 +120,9 @@ namespace docdb {
     /* Indicator for whether an intent is for a row lock. */ \
     ((kRowLock, 'l'))  /* ASCII code 108 */ \
     ((kBitSet, 'm')) /* ASCII code 109 */ \
+    /* A whole row version packed into a single value stored at the DocKey level. The packed */ \
+    /* value holds the encoded subkey and value of every non-key column (see packed_row.h). */ \
+    ((kPackedRow, 'p')) /* ASCII code 112 */ \
     /* Timestamp value in microseconds */ \
     ((kTimestamp, 's'))  /* ASCII code 115 */ \
     /* TTL value in milliseconds, optionally present at the start of a value. */ \
@@ -241,9 +244,9 @@ inline ValueType DecodeValueType(char value_type_byte) {
 }
 
 // Checks if a value is a merge record, meaning it begins with the
-// kMergeFlags value type. Currently, the only merge records supported are
-// TTL records, when the flags value is 0x1. In the future, value
-// merge records may be implemented, such as a +1 merge record for INCR.
+// kMergeFlags value type. Currently, the merge records supported are
+// TTL records, when the flags value is 0x1, and counter deltas, when
+// the flags value is 0x2.
 inline bool IsMergeRecord(const rocksdb::Slice& value) {
   return DecodeValueType(value) == ValueType::kMergeFlags;
 }
@@ -44,6 +44,7 @@ using std::shared_ptr;
 
 DECLARE_string(fs_data_dirs);
 DECLARE_string(fs_wal_dirs);
+DECLARE_int64(fs_delete_rate_bytes_per_sec);
 
 namespace yb {
 
@@ -286,4 +287,33 @@ TEST_F(FsManagerTestBase, TestLogDirAlsoDeleted) {
   ASSERT_FALSE(is_dir);
 }
 
+// Deleted directory should be gone right away, while its files are deleted from trash in
+// background.
+TEST_F(FsManagerTestBase, TestDeleteRecursivelyThrottled) {
+  constexpr int kNumFiles = 10;
+  FLAGS_fs_delete_rate_bytes_per_sec = 64 * 1024;
+  ReinitFsManager();
+  ASSERT_OK(fs_manager()->Open());
+
+  const auto table_dir = JoinPathSegments(fs_manager()->GetDataRootDirs()[0], "table");
+  const auto tablet_dir = JoinPathSegments(table_dir, "tablet");
+  ASSERT_OK(fs_manager()->CreateDirIfMissing(table_dir));
+  ASSERT_OK(fs_manager()->CreateDirIfMissing(tablet_dir));
+  for (int i = 0; i != kNumFiles; ++i) {
+    ASSERT_OK(WriteStringToFile(
+        env_.get(), std::string(4096, 'x'), JoinPathSegments(tablet_dir, Format("file-$0", i))));
+  }
+  ASSERT_NE(fs_manager()->GetSstFileManager(tablet_dir), nullptr);
+  ASSERT_EQ(fs_manager()->GetSstFileManager(GetTestPath("other_root/file")), nullptr);
+
+  ASSERT_OK(fs_manager()->DeleteRecursivelyThrottled(table_dir));
+  ASSERT_FALSE(env_->FileExists(table_dir));
+
+  const auto trash_dir = JoinPathSegments(DirName(fs_manager()->GetRaftGroupMetadataDir()),
+                                          "trash");
+  ASSERT_OK(WaitFor([this, &trash_dir]() -> Result<bool> {
+    return VERIFY_RESULT(fs_manager()->ListDir(trash_dir)).empty();
+  }, MonoDelta::FromSeconds(30), "Trash is empty"));
+}
+
 } // namespace yb
@@ -42,6 +42,7 @@
 #include <google/protobuf/message.h>
 
 #include "yb/fs/fs.pb.h"
+#include "yb/fs/metadata_journal.h"
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/strings/join.h"
 #include "yb/gutil/strings/numbers.h"
@@ -51,6 +52,9 @@
 #include "yb/gutil/strings/util.h"
 #include "yb/gutil/strtoint.h"
 #include "yb/gutil/walltime.h"
+#include "yb/rocksdb/env.h"
+#include "yb/rocksdb/sst_file_manager.h"
+#include "yb/rocksdb/util/sst_file_manager_impl.h"
 #include "yb/util/env_util.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/net/net_util.h"
@@ -71,11 +75,31 @@ DEFINE_string(fs_wal_dirs, "",
                   "also and that's a reasonable default for most use cases.");
 TAG_FLAG(fs_wal_dirs, stable);
 
+DEFINE_string(fs_cold_data_dirs, "",
+              "Comma-separated list of directories on a cheaper storage tier, where SST files "
+              "with data older than tiered_storage_cold_data_age_sec are placed. Each tablet "
+              "uses one of these directories, chosen by its id, so the list should not be changed "
+              "after data was written.");
+TAG_FLAG(fs_cold_data_dirs, advanced);
+
 DEFINE_string(instance_uuid_override, "",
               "When creating local instance metadata (for master or tserver) in an empty data "
               "directory, use this UUID instead of randomly-generated one. Can be used to replace "
               "a node that had its disk wiped in some scenarios.");
 
+DEFINE_bool(metadata_journal, false,
+            "Whether consensus metadata and Raft group superblocks are written through a journal, "
+            "that group commits the changes of many tablets, instead of writing and syncing a "
+            "file for each change.");
+TAG_FLAG(metadata_journal, advanced);
+
+DEFINE_int64(fs_delete_rate_bytes_per_sec, 0,
+             "Max rate at which files of deleted tablets, WALs and snapshots are deleted from each "
+             "root. When set, deleted files are moved to the trash dir of their root and are "
+             "deleted in background, so large deletions don't stall other tablets on the same "
+             "drive. 0 to delete files inline.");
+TAG_FLAG(fs_delete_rate_bytes_per_sec, advanced);
+
 DEFINE_test_flag(bool, simulate_fs_create_failure, false,
                  "Simulate failure during initial creation of fs during the first time "
                  "process creation.");
@@ -101,6 +125,8 @@ const char *FsManager::kCorruptedSuffix = ".corrupted";
 const char *FsManager::kInstanceMetadataFileName = "instance";
 const char *FsManager::kFsLockFileName = "fs-lock";
 const char *FsManager::kConsensusMetadataDirName = "consensus-meta";
+const char *FsManager::kMetadataJournalFileName = "metadata-journal";
+const char *FsManager::kTrashDirName = "trash";
 const char *FsManager::kLogsDirName = "logs";
 
 static const char* const kTmpInfix = ".tmp";
@@ -114,6 +140,7 @@ FsManagerOpts::FsManagerOpts()
   }
   wal_paths = strings::Split(FLAGS_fs_wal_dirs, ",", strings::SkipEmpty());
   data_paths = strings::Split(FLAGS_fs_data_dirs, ",", strings::SkipEmpty());
+  cold_data_paths = strings::Split(FLAGS_fs_cold_data_dirs, ",", strings::SkipEmpty());
 }
 
 FsManagerOpts::~FsManagerOpts() {
@@ -135,6 +162,7 @@ FsManager::FsManager(Env* env,
     read_only_(opts.read_only),
     wal_fs_roots_(opts.wal_paths),
     data_fs_roots_(opts.data_paths),
+    cold_data_fs_roots_(opts.cold_data_paths),
     server_type_(opts.server_type),
     metric_entity_(opts.metric_entity),
     parent_mem_tracker_(opts.parent_mem_tracker),
@@ -216,6 +244,16 @@ Status FsManager::Init() {
     canonicalized_all_fs_roots_.insert(e.second);
   }
 
+  for (const auto& root : cold_data_fs_roots_) {
+    if (root.empty() || root[0] != '/') {
+      return STATUS_FORMAT(IOError, "Invalid cold data filesystem root: $0", root);
+    }
+    string canonicalized;
+    RETURN_NOT_OK_PREPEND(env_->Canonicalize(DirName(root), &canonicalized),
+                          Substitute("Invalid cold data filesystem root $0", root));
+    canonicalized_cold_data_fs_roots_.insert(JoinPathSegments(canonicalized, BaseName(root)));
+  }
+
   if (VLOG_IS_ON(1)) {
     VLOG(1) << "WAL roots: " << canonicalized_wal_fs_roots_;
     VLOG(1) << "Metadata root: " << canonicalized_metadata_fs_root_;
@@ -246,11 +284,84 @@ Status FsManager::Open() {
     }
   }
 
+  RETURN_NOT_OK(OpenMetadataJournal());
+  RETURN_NOT_OK(CreateSstFileManagers());
+
   LOG(INFO) << "Opened local filesystem: " << JoinStrings(canonicalized_all_fs_roots_, ",")
             << std::endl << metadata_->DebugString();
   return Status::OK();
 }
 
+Status FsManager::OpenMetadataJournal() {
+  const auto path = GetMetadataJournalPath();
+  if (!FLAGS_metadata_journal && !env_->FileExists(path)) {
+    return Status::OK();
+  }
+  std::unique_ptr<MetadataJournal> journal(new MetadataJournal(env_, path));
+  RETURN_NOT_OK(journal->Open(read_only_));
+  if (FLAGS_metadata_journal || read_only_) {
+    metadata_journal_ = std::move(journal);
+    return Status::OK();
+  }
+  // Journal was disabled, and all files were already updated from it.
+  return env_->DeleteFile(path);
+}
+
+Status FsManager::CreateSstFileManagers() {
+  if (read_only_ || FLAGS_fs_delete_rate_bytes_per_sec <= 0) {
+    return Status::OK();
+  }
+  for (const auto& root : canonicalized_all_fs_roots_) {
+    const auto trash_dir = JoinPathSegments(GetServerTypeDataPath(root, server_type_),
+                                            kTrashDirName);
+    Status status;
+    // Files that were left in trash before restart are deleted as well.
+    std::shared_ptr<rocksdb::SstFileManager> manager(rocksdb::NewSstFileManager(
+        rocksdb::Env::Default(), nullptr /* info_log */, trash_dir,
+        FLAGS_fs_delete_rate_bytes_per_sec, true /* delete_existing_trash */, &status));
+    RETURN_NOT_OK_PREPEND(status, "Unable to create trash dir " + trash_dir);
+    sst_file_managers_.emplace(root, std::move(manager));
+  }
+  return Status::OK();
+}
+
+std::shared_ptr<rocksdb::SstFileManager> FsManager::GetSstFileManager(
+    const std::string& path) const {
+  std::shared_ptr<rocksdb::SstFileManager> result;
+  size_t best_root_size = 0;
+  for (const auto& p : sst_file_managers_) {
+    const auto& root = p.first;
+    if (root.size() > best_root_size && path.size() > root.size() &&
+        path.compare(0, root.size(), root) == 0 && path[root.size()] == '/') {
+      result = p.second;
+      best_root_size = root.size();
+    }
+  }
+  return result;
+}
+
+Status FsManager::DeleteRecursivelyThrottled(const std::string& path) {
+  auto manager = GetSstFileManager(path);
+  if (!manager) {
+    return env_->DeleteRecursively(path);
+  }
+  return ScheduleDeletion(manager.get(), path);
+}
+
+Status FsManager::ScheduleDeletion(rocksdb::SstFileManager* manager, const std::string& path) {
+  bool is_dir = false;
+  RETURN_NOT_OK(env_->IsDirectory(path, &is_dir));
+  if (!is_dir) {
+    // Moves file to trash, so the directory could be deleted right away.
+    return static_cast<rocksdb::SstFileManagerImpl*>(manager)->ScheduleFileDeletion(path);
+  }
+  const auto children = VERIFY_RESULT(ListDir(path));
+  for (const auto& child : children) {
+    RETURN_NOT_OK(ScheduleDeletion(manager, JoinPathSegments(path, child)));
+  }
+  return env_->DeleteDir(path);
+}
+
 bool FsManager::HasAnyLockFiles() {
   for (const string& root : canonicalized_all_fs_roots_) {
     if (Exists(GetFsLockFilePath(root))) {
@@ -288,8 +399,16 @@ Status FsManager::DeleteFileSystemLayout(bool delete_logs_also) {
     auto removal_list = GetWalRootDirs();
     removal_list.push_back(GetRaftGroupMetadataDir());
     removal_list.push_back(GetConsensusMetadataDir());
+    if (env_->FileExists(GetMetadataJournalPath())) {
+      removal_list.push_back(GetMetadataJournalPath());
+    }
     for (const string& root : canonicalized_all_fs_roots_) {
       removal_list.push_back(GetInstanceMetadataPath(root));
+      const auto trash_dir = JoinPathSegments(GetServerTypeDataPath(root, server_type_),
+                                              kTrashDirName);
+      if (env_->FileExists(trash_dir)) {
+        removal_list.push_back(trash_dir);
+      }
     }
     auto data_dirs = GetDataRootDirs();
     removal_list.insert(removal_list.begin(), data_dirs.begin(), data_dirs.end());
@@ -506,6 +625,15 @@ vector<string> FsManager::GetDataRootDirs() const {
   return data_paths;
 }
 
+vector<string> FsManager::GetColdDataRootDirs() const {
+  vector<string> data_paths;
+  for (const auto& root : canonicalized_cold_data_fs_roots_) {
+    data_paths.push_back(
+        JoinPathSegments(GetServerTypeDataPath(root, server_type_), kDataDirName));
+  }
+  return data_paths;
+}
+
 vector<string> FsManager::GetWalRootDirs() const {
   DCHECK(initted_);
   vector<string> wal_dirs;
@@ -582,6 +710,58 @@ std::string FsManager::GetConsensusMetadataDir(const std::string& data_dir) {
   return JoinPathSegments(data_dir, kConsensusMetadataDirName);
 }
 
+std::string FsManager::GetMetadataJournalPath() const {
+  DCHECK(initted_);
+  return JoinPathSegments(
+      GetServerTypeDataPath(canonicalized_metadata_fs_root_, server_type_),
+      kMetadataJournalFileName);
+}
+
+Status FsManager::WriteMetadataFile(
+    const std::string& path, const google::protobuf::Message& pb) {
+  if (metadata_journal_) {
+    return metadata_journal_->Write(path, pb);
+  }
+  return pb_util::WritePBContainerToPath(env_, path, pb, pb_util::OVERWRITE, pb_util::SYNC);
+}
+
+Status FsManager::ReadMetadataFile(const std::string& path, google::protobuf::Message* pb) {
+  if (metadata_journal_ && VERIFY_RESULT(metadata_journal_->Read(path, pb))) {
+    return Status::OK();
+  }
+  return pb_util::ReadPBContainerFromPath(env_, path, pb);
+}
+
+Status FsManager::DeleteMetadataFile(const std::string& path) {
+  if (metadata_journal_) {
+    return metadata_journal_->Delete(path);
+  }
+  return env_->DeleteFile(path);
+}
+
+bool FsManager::MetadataFileExists(const std::string& path) {
+  if (metadata_journal_) {
+    uint64_t size = 0;
+    auto found = metadata_journal_->GetSize(path, &size);
+    if (!found.ok()) {
+      // File was deleted through the journal.
+      return false;
+    }
+    if (*found) {
+      return true;
+    }
+  }
+  return env_->FileExists(path);
+}
+
+Result<uint64_t> FsManager::GetMetadataFileSize(const std::string& path) {
+  uint64_t size = 0;
+  if (metadata_journal_ && VERIFY_RESULT(metadata_journal_->GetSize(path, &size))) {
+    return size;
+  }
+  return env_->GetFileSize(path);
+}
+
 std::string FsManager::GetFirstTabletWalDirOrDie(const std::string& table_id,
                                                  const std::string& tablet_id) const {
   auto wal_root_dirs = GetWalRootDirs();
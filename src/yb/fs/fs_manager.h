@@ -34,6 +34,7 @@
 #define YB_FS_FS_MANAGER_H
 
 #include <iosfwd>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -56,9 +57,14 @@ class Message;
 } // namespace protobuf
 } // namespace google
 
+namespace rocksdb {
+class SstFileManager;
+} // namespace rocksdb
+
 namespace yb {
 
 class MemTracker;
+class MetadataJournal;
 class MetricEntity;
 
 namespace itest {
@@ -87,6 +93,9 @@ struct FsManagerOpts {
   // The paths where data blocks will be stored. Cannot be empty.
   std::vector<std::string> data_paths;
 
+  // The paths of the cold storage tier, where SST files with old data are stored. Could be empty.
+  std::vector<std::string> cold_data_paths;
+
   // Whether or not read-write operations should be allowed. Defaults to false.
   bool read_only;
 
@@ -156,6 +165,10 @@ class FsManager {
 
   std::vector<std::string> GetWalRootDirs() const;
 
+  // Returns data root dirs of the cold storage tier, see fs_cold_data_dirs. Unlike other roots,
+  // these dirs are created on demand and do not contain the instance metadata.
+  std::vector<std::string> GetColdDataRootDirs() const;
+
   // Used for tests only. If GetWalRootDirs returns an empty vector, we will crash the process.
   std::string GetFirstTabletWalDirOrDie(const std::string& table_id,
                                         const std::string& tablet_id) const;
@@ -190,6 +203,25 @@ class FsManager {
     return JoinPathSegments(GetConsensusMetadataDir(), tablet_id);
   }
 
+  // Return the manager that throttles deletion of SST files under path, or nullptr if deletion
+  // is not throttled, see fs_delete_rate_bytes_per_sec.
+  std::shared_ptr<rocksdb::SstFileManager> GetSstFileManager(const std::string& path) const;
+
+  // Delete the file or the directory tree at path. When deletion is throttled, files are moved to
+  // the trash dir of their root, and are deleted in background at the limited rate.
+  CHECKED_STATUS DeleteRecursivelyThrottled(const std::string& path);
+
+  // Return the path of the journal of metadata files, see MetadataJournal.
+  std::string GetMetadataJournalPath() const;
+
+  // Write, read or delete a metadata file, i.e. a protobuf container that is overwritten on each
+  // change. When metadata_journal is enabled, writes go through the metadata journal.
+  CHECKED_STATUS WriteMetadataFile(const std::string& path, const google::protobuf::Message& pb);
+  CHECKED_STATUS ReadMetadataFile(const std::string& path, google::protobuf::Message* pb);
+  CHECKED_STATUS DeleteMetadataFile(const std::string& path);
+  bool MetadataFileExists(const std::string& path);
+  Result<uint64_t> GetMetadataFileSize(const std::string& path);
+
   Env *env() { return env_; }
 
   bool read_only() const {
@@ -226,6 +258,14 @@ class FsManager {
   // Create a new InstanceMetadataPB.
   void CreateInstanceMetadata(InstanceMetadataPB* metadata);
 
+  // Replays the metadata journal if it exists, and keeps it open if metadata_journal is enabled.
+  CHECKED_STATUS OpenMetadataJournal();
+
+  // Creates managers that throttle deletion of files, one for each root.
+  CHECKED_STATUS CreateSstFileManagers();
+
+  CHECKED_STATUS ScheduleDeletion(rocksdb::SstFileManager* manager, const std::string& path);
+
   // Save a InstanceMetadataPB to the filesystem.
   // Does not mutate the current state of the fsmanager.
   CHECKED_STATUS WriteInstanceMetadata(
@@ -254,6 +294,8 @@ class FsManager {
   static const char *kInstanceMetadataMagicNumber;
   static const char *kTabletSuperBlockMagicNumber;
   static const char *kConsensusMetadataDirName;
+  static const char *kMetadataJournalFileName;
+  static const char *kTrashDirName;
   static const char *kLogsDirName;
 
   Env *env_;
@@ -265,6 +307,7 @@ class FsManager {
   // as-is; they are first canonicalized during Init().
   const std::vector<std::string> wal_fs_roots_;
   const std::vector<std::string> data_fs_roots_;
+  const std::vector<std::string> cold_data_fs_roots_;
   const std::string server_type_;
 
   scoped_refptr<MetricEntity> metric_entity_;
@@ -280,9 +323,16 @@ class FsManager {
   std::string canonicalized_metadata_fs_root_;
   std::set<std::string> canonicalized_data_fs_roots_;
   std::set<std::string> canonicalized_all_fs_roots_;
+  std::set<std::string> canonicalized_cold_data_fs_roots_;
 
   gscoped_ptr<InstanceMetadataPB> metadata_;
 
+  // Set when metadata files are written through the metadata journal.
+  std::unique_ptr<MetadataJournal> metadata_journal_;
+
+  // Canonicalized root => manager that throttles deletion of files under the root.
+  std::map<std::string, std::shared_ptr<rocksdb::SstFileManager>> sst_file_managers_;
+
   bool initted_;
 
   DISALLOW_COPY_AND_ASSIGN(FsManager);
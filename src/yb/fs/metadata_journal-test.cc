@@ -0,0 +1,223 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <thread>
+
+#include "yb/fs/fs.pb.h"
+#include "yb/fs/metadata_journal.h"
+
+#include "yb/util/path_util.h"
+#include "yb/util/pb_util.h"
+#include "yb/util/size_literals.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+DECLARE_int32(metadata_journal_compaction_delay_ms);
+DECLARE_int64(metadata_journal_compaction_size_bytes);
+
+using namespace std::literals;
+using namespace yb::size_literals;  // NOLINT.
+
+namespace yb {
+
+class MetadataJournalTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    journal_path_ = GetTestPath("metadata-journal");
+  }
+
+  std::string FilePath(int idx) {
+    return GetTestPath(Format("file-$0", idx));
+  }
+
+  InstanceMetadataPB MakePB(int idx, int version) {
+    InstanceMetadataPB pb;
+    pb.set_uuid(Format("uuid-$0", idx));
+    pb.set_format_stamp(Format("version-$0", version));
+    return pb;
+  }
+
+  std::unique_ptr<MetadataJournal> OpenJournal(bool read_only) {
+    std::unique_ptr<MetadataJournal> journal(new MetadataJournal(env_.get(), journal_path_));
+    CHECK_OK(journal->Open(read_only));
+    return journal;
+  }
+
+  void CheckFile(int idx, int version) {
+    InstanceMetadataPB pb;
+    ASSERT_OK(pb_util::ReadPBContainerFromPath(env_.get(), FilePath(idx), &pb));
+    ASSERT_EQ(pb.format_stamp(), Format("version-$0", version));
+  }
+
+  std::string journal_path_;
+};
+
+// Files written through the journal should be readable from it, and should be written to the
+// files themselves when the journal is reopened.
+TEST_F(MetadataJournalTest, WriteAndReplay) {
+  constexpr int kNumFiles = 3;
+  {
+    auto journal = OpenJournal(/* read_only */ false);
+    for (int version = 0; version != 3; ++version) {
+      for (int i = 0; i != kNumFiles; ++i) {
+        ASSERT_OK(journal->Write(FilePath(i), MakePB(i, version)));
+      }
+    }
+    for (int i = 0; i != kNumFiles; ++i) {
+      ASSERT_FALSE(env_->FileExists(FilePath(i)));
+      InstanceMetadataPB pb;
+      ASSERT_TRUE(ASSERT_RESULT(journal->Read(FilePath(i), &pb)));
+      ASSERT_EQ(pb.format_stamp(), "version-2");
+    }
+  }
+
+  {
+    auto journal = OpenJournal(/* read_only */ true);
+    InstanceMetadataPB pb;
+    ASSERT_TRUE(ASSERT_RESULT(journal->Read(FilePath(0), &pb)));
+    ASSERT_EQ(pb.format_stamp(), "version-2");
+    ASSERT_FALSE(env_->FileExists(FilePath(0)));
+  }
+
+  auto journal = OpenJournal(/* read_only */ false);
+  for (int i = 0; i != kNumFiles; ++i) {
+    ASSERT_NO_FATALS(CheckFile(i, 2));
+    InstanceMetadataPB pb;
+    ASSERT_FALSE(ASSERT_RESULT(journal->Read(FilePath(i), &pb)));
+  }
+  ASSERT_EQ(ASSERT_RESULT(env_->GetFileSize(journal_path_)), 0);
+}
+
+TEST_F(MetadataJournalTest, Delete) {
+  {
+    auto journal = OpenJournal(/* read_only */ false);
+    ASSERT_OK(journal->Write(FilePath(0), MakePB(0, 0)));
+    ASSERT_OK(journal->Write(FilePath(1), MakePB(1, 0)));
+  }
+  {
+    auto journal = OpenJournal(/* read_only */ false);
+    ASSERT_OK(journal->Delete(FilePath(0)));
+    ASSERT_FALSE(env_->FileExists(FilePath(0)));
+    InstanceMetadataPB pb;
+    ASSERT_TRUE(journal->Read(FilePath(0), &pb).status().IsNotFound());
+  }
+  OpenJournal(/* read_only */ false);
+  ASSERT_FALSE(env_->FileExists(FilePath(0)));
+  ASSERT_NO_FATALS(CheckFile(1, 0));
+}
+
+// Partially written records at the end of the journal should be ignored.
+TEST_F(MetadataJournalTest, PartialRecord) {
+  {
+    auto journal = OpenJournal(/* read_only */ false);
+    ASSERT_OK(journal->Write(FilePath(0), MakePB(0, 1)));
+  }
+  faststring data;
+  ASSERT_OK(ReadFileToString(env_.get(), journal_path_, &data));
+  data.append(data.data(), data.size() / 2);
+  ASSERT_OK(WriteStringToFile(env_.get(), Slice(data), journal_path_));
+
+  OpenJournal(/* read_only */ false);
+  ASSERT_NO_FATALS(CheckFile(0, 1));
+}
+
+// Concurrent writes should be group committed, and the journal should be compacted when it grows.
+TEST_F(MetadataJournalTest, ConcurrentWrites) {
+  constexpr int kNumThreads = 8;
+  constexpr int kNumVersions = 200;
+  FLAGS_metadata_journal_compaction_size_bytes = 16_KB;
+
+  {
+    auto journal = OpenJournal(/* read_only */ false);
+    std::vector<std::thread> threads;
+    for (int i = 0; i != kNumThreads; ++i) {
+      threads.emplace_back([this, &journal, i] {
+        for (int version = 0; version != kNumVersions; ++version) {
+          ASSERT_OK(journal->Write(FilePath(i), MakePB(i, version)));
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    ASSERT_LT(ASSERT_RESULT(env_->GetFileSize(journal_path_)),
+              FLAGS_metadata_journal_compaction_size_bytes + 1_KB);
+  }
+
+  OpenJournal(/* read_only */ false);
+  for (int i = 0; i != kNumThreads; ++i) {
+    ASSERT_NO_FATALS(CheckFile(i, kNumVersions - 1));
+  }
+}
+
+// Writes should not wait for the background compaction, and the versions written during the
+// compaction should survive it.
+TEST_F(MetadataJournalTest, WriteDuringCompaction) {
+  constexpr auto kCompactionDelay = 2s;
+  FLAGS_metadata_journal_compaction_delay_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(kCompactionDelay).count();
+
+  {
+    auto journal = OpenJournal(/* read_only */ false);
+    FLAGS_metadata_journal_compaction_size_bytes = 1;
+    // This write makes the journal big enough, so it is moved aside, and its files are written
+    // after the delay.
+    ASSERT_OK(journal->Write(FilePath(0), MakePB(0, 0)));
+    ASSERT_OK(journal->Write(FilePath(1), MakePB(1, 0)));
+    ASSERT_TRUE(env_->FileExists(journal_path_ + ".compacting"));
+
+    const auto start = CoarseMonoClock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i != 2; ++i) {
+      threads.emplace_back([this, &journal, i] {
+        for (int version = 1; version != 10; ++version) {
+          ASSERT_OK(journal->Write(FilePath(i), MakePB(i, version)));
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    ASSERT_OK(journal->Write(FilePath(2), MakePB(2, 0)));
+    ASSERT_LT(CoarseMonoClock::now() - start, kCompactionDelay / 2);
+
+    for (int i = 0; i != 2; ++i) {
+      InstanceMetadataPB pb;
+      ASSERT_TRUE(ASSERT_RESULT(journal->Read(FilePath(i), &pb)));
+      ASSERT_EQ(pb.format_stamp(), "version-9");
+    }
+
+    ASSERT_OK(WaitFor([this] {
+      return !env_->FileExists(journal_path_ + ".compacting");
+    }, kCompactionDelay * 5, "Compaction"));
+    // The files hold the versions of the old journal, the newer ones are still read from the
+    // journal.
+    ASSERT_NO_FATALS(CheckFile(0, 0));
+    for (int i = 0; i != 2; ++i) {
+      InstanceMetadataPB pb;
+      ASSERT_TRUE(ASSERT_RESULT(journal->Read(FilePath(i), &pb)));
+      ASSERT_EQ(pb.format_stamp(), "version-9");
+    }
+  }
+
+  FLAGS_metadata_journal_compaction_delay_ms = 0;
+  OpenJournal(/* read_only */ false);
+  for (int i = 0; i != 2; ++i) {
+    ASSERT_NO_FATALS(CheckFile(i, 9));
+  }
+  ASSERT_NO_FATALS(CheckFile(2, 0));
+  ASSERT_FALSE(env_->FileExists(journal_path_ + ".compacting"));
+}
+
+} // namespace yb
@@ -0,0 +1,340 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/fs/metadata_journal.h"
+
+#include <glog/logging.h>
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/message.h>
+
+#include "yb/util/coding.h"
+#include "yb/util/crc.h"
+#include "yb/util/faststring.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/monotime.h"
+#include "yb/util/path_util.h"
+#include "yb/util/pb_util.h"
+#include "yb/util/size_literals.h"
+#include "yb/util/thread.h"
+
+using namespace yb::size_literals;  // NOLINT.
+
+DEFINE_int64(metadata_journal_compaction_size_bytes, 4_MB,
+             "When the metadata journal grows above this size, a new journal is started, and the "
+             "latest versions of metadata files from the old one are written to the files "
+             "themselves in the background.");
+TAG_FLAG(metadata_journal_compaction_size_bytes, advanced);
+TAG_FLAG(metadata_journal_compaction_size_bytes, runtime);
+
+DEFINE_test_flag(int32, metadata_journal_compaction_delay_ms, 0,
+                 "Delay before compaction of the metadata journal writes the files.");
+
+namespace yb {
+
+namespace {
+
+// Each record is: payload size (fixed32), crc32c of the payload (fixed32), payload.
+// Payload is: length prefixed path, length prefixed type name, serialized protobuf.
+constexpr size_t kRecordHeaderSize = 8;
+
+void EncodeRecord(const std::string& path, const std::string& type_name, const std::string& data,
+                  std::string* out) {
+  faststring payload;
+  PutLengthPrefixedSlice(&payload, path);
+  PutLengthPrefixedSlice(&payload, type_name);
+  payload.append(data);
+
+  faststring header;
+  PutFixed32(&header, static_cast<uint32_t>(payload.size()));
+  PutFixed32(&header, crc::Crc32c(payload.data(), payload.size()));
+  out->append(reinterpret_cast<const char*>(header.data()), header.size());
+  out->append(reinterpret_cast<const char*>(payload.data()), payload.size());
+}
+
+} // namespace
+
+MetadataJournal::MetadataJournal(Env* env, std::string path)
+    : env_(env), path_(std::move(path)), compacting_path_(path_ + ".compacting") {
+}
+
+MetadataJournal::~MetadataJournal() {
+  if (compaction_thread_) {
+    compaction_thread_->Join();
+  }
+}
+
+Status MetadataJournal::Open(bool read_only) {
+  // The old journal is left only when compaction did not complete, its records precede the
+  // records of the current journal.
+  RETURN_NOT_OK(Replay(compacting_path_));
+  RETURN_NOT_OK(Replay(path_));
+  if (read_only) {
+    return Status::OK();
+  }
+
+  RETURN_NOT_OK(WriteFiles(entries_));
+  if (!entries_.empty()) {
+    VLOG(1) << "Compacted " << entries_.size() << " metadata files from " << path_;
+  }
+  entries_.clear();
+  // The old journal is deleted before the current one is truncated, so it is never replayed
+  // without the newer records of the current one.
+  if (env_->FileExists(compacting_path_)) {
+    RETURN_NOT_OK_PREPEND(env_->DeleteFile(compacting_path_),
+                          "Unable to delete metadata journal " + compacting_path_);
+    RETURN_NOT_OK(env_->SyncDir(DirName(path_)));
+  }
+  RETURN_NOT_OK(CreateFile());
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  writable_ = true;
+  return Status::OK();
+}
+
+Status MetadataJournal::Replay(const std::string& path) {
+  if (!env_->FileExists(path)) {
+    return Status::OK();
+  }
+  faststring buffer;
+  RETURN_NOT_OK_PREPEND(ReadFileToString(env_, path, &buffer),
+                        "Unable to read metadata journal " + path);
+  Slice data(buffer);
+  size_t num_records = 0;
+  while (!data.empty()) {
+    if (data.size() < kRecordHeaderSize) {
+      break;
+    }
+    const uint32_t size = DecodeFixed32(data.data());
+    const uint32_t crc = DecodeFixed32(data.data() + 4);
+    if (data.size() < kRecordHeaderSize + size) {
+      break;
+    }
+    Slice payload(data.data() + kRecordHeaderSize, size);
+    if (crc::Crc32c(payload.data(), payload.size()) != crc) {
+      break;
+    }
+    Slice path, type_name;
+    if (!GetLengthPrefixedSlice(&payload, &path) || !GetLengthPrefixedSlice(&payload, &type_name)) {
+      return STATUS_FORMAT(Corruption, "Bad record $0 in metadata journal $1", num_records, path);
+    }
+    entries_[path.ToBuffer()] = Entry { type_name.ToBuffer(), payload.ToBuffer() };
+    data.remove_prefix(kRecordHeaderSize + size);
+    ++num_records;
+  }
+  // Only the last batch could be partially written, and it was not acknowledged to writers.
+  LOG_IF(WARNING, !data.empty())
+      << "Ignoring " << data.size() << " bytes of partially written records at the end of "
+      << path;
+  LOG(INFO) << "Replayed " << num_records << " records of " << entries_.size()
+            << " metadata files from " << path;
+  return Status::OK();
+}
+
+Status MetadataJournal::Write(const std::string& path, const google::protobuf::Message& pb) {
+  std::string data;
+  if (!pb.SerializeToString(&data)) {
+    return STATUS_FORMAT(Corruption, "Unable to serialize $0 for $1", pb.GetTypeName(), path);
+  }
+  return Append(path, pb.GetTypeName(), std::move(data));
+}
+
+Status MetadataJournal::Delete(const std::string& path) {
+  RETURN_NOT_OK(Append(path, std::string(), std::string()));
+  if (env_->FileExists(path)) {
+    RETURN_NOT_OK_PREPEND(env_->DeleteFile(path), "Unable to delete " + path);
+  }
+  return Status::OK();
+}
+
+Status MetadataJournal::Append(
+    const std::string& path, std::string type_name, std::string data) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  RETURN_NOT_OK(status_);
+  if (!writable_) {
+    return STATUS_FORMAT(IllegalState, "Metadata journal $0 is read only", path_);
+  }
+  EncodeRecord(path, type_name, data, &pending_);
+  pending_entries_.emplace_back(path, Entry { std::move(type_name), std::move(data) });
+  const auto seq = ++last_appended_seq_;
+
+  // The first writer that finds the journal idle writes and syncs the records of all writers
+  // that are waiting, so concurrent writes share a single sync.
+  while (synced_seq_ < seq) {
+    RETURN_NOT_OK(status_);
+    if (syncing_) {
+      cond_.wait(lock);
+      continue;
+    }
+    syncing_ = true;
+    std::string batch;
+    batch.swap(pending_);
+    decltype(pending_entries_) batch_entries;
+    batch_entries.swap(pending_entries_);
+    const auto batch_seq = last_appended_seq_;
+    lock.unlock();
+    auto status = file_->Append(batch);
+    if (status.ok()) {
+      status = file_->Sync();
+    }
+    lock.lock();
+    if (status.ok()) {
+      synced_seq_ = batch_seq;
+      // New versions are visible to readers only once they are durable.
+      for (auto& p : batch_entries) {
+        entries_[std::move(p.first)] = std::move(p.second);
+      }
+      cond_.notify_all();
+      if (!compacting_ &&
+          file_->Size() >= static_cast<uint64_t>(FLAGS_metadata_journal_compaction_size_bytes)) {
+        status = StartCompaction(&lock);
+      }
+    }
+    syncing_ = false;
+    if (!status.ok()) {
+      LOG(DFATAL) << "Failed to write metadata journal " << path_ << ": " << status;
+      status_ = status;
+    }
+    cond_.notify_all();
+  }
+  return status_;
+}
+
+Status MetadataJournal::CreateFile() {
+  RETURN_NOT_OK_PREPEND(env_->NewWritableFile(path_, &file_),
+                        "Unable to create metadata journal " + path_);
+  RETURN_NOT_OK(file_->Sync());
+  return env_->SyncDir(DirName(path_));
+}
+
+// Called by the writer that is syncing the journal, so no one else accesses file_, and entries_
+// does not change until it returns. The journal is moved aside and a new one is started, while
+// the lock is released, so other writers can append to pending_ meanwhile.
+Status MetadataJournal::StartCompaction(std::unique_lock<std::mutex>* lock) {
+  compacting_ = true;
+  auto entries = entries_;
+  lock->unlock();
+  // The previous compaction already completed, so its thread is about to exit.
+  if (compaction_thread_) {
+    compaction_thread_->Join();
+  }
+  file_.reset();
+  auto status = env_->RenameFile(path_, compacting_path_);
+  if (status.ok()) {
+    status = CreateFile();
+  }
+  if (status.ok()) {
+    status = Thread::Create(
+        "metadata_journal", "compaction", [this, entries = std::move(entries)] {
+          Compact(entries);
+        }, &compaction_thread_);
+  }
+  lock->lock();
+  if (!status.ok()) {
+    compacting_ = false;
+  }
+  return status;
+}
+
+void MetadataJournal::Compact(const Entries& entries) {
+  if (PREDICT_FALSE(FLAGS_metadata_journal_compaction_delay_ms > 0)) {
+    SleepFor(MonoDelta::FromMilliseconds(FLAGS_metadata_journal_compaction_delay_ms));
+  }
+  auto status = WriteFiles(entries);
+  if (status.ok()) {
+    status = env_->DeleteFile(compacting_path_);
+  }
+  if (status.ok()) {
+    status = env_->SyncDir(DirName(path_));
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (status.ok()) {
+    // Versions written after the journal was moved aside are kept, they are in the new journal.
+    for (const auto& p : entries) {
+      auto it = entries_.find(p.first);
+      if (it != entries_.end() && it->second.type_name == p.second.type_name &&
+          it->second.data == p.second.data) {
+        entries_.erase(it);
+      }
+    }
+    VLOG(1) << "Compacted " << entries.size() << " metadata files from " << compacting_path_;
+  } else {
+    LOG(DFATAL) << "Failed to compact metadata journal " << path_ << ": " << status;
+    status_ = status;
+  }
+  compacting_ = false;
+}
+
+Status MetadataJournal::WriteFiles(const Entries& entries) {
+  for (const auto& p : entries) {
+    RETURN_NOT_OK(WriteFile(p.first, p.second));
+  }
+  return Status::OK();
+}
+
+Status MetadataJournal::WriteFile(const std::string& path, const Entry& entry) {
+  if (entry.type_name.empty()) {
+    if (env_->FileExists(path)) {
+      RETURN_NOT_OK_PREPEND(env_->DeleteFile(path), "Unable to delete " + path);
+    }
+    return Status::OK();
+  }
+
+  const auto* descriptor =
+      google::protobuf::DescriptorPool::generated_pool()->FindMessageTypeByName(entry.type_name);
+  if (!descriptor) {
+    return STATUS_FORMAT(Corruption, "Unknown type $0 of $1", entry.type_name, path);
+  }
+  std::unique_ptr<google::protobuf::Message> pb(
+      google::protobuf::MessageFactory::generated_factory()->GetPrototype(descriptor)->New());
+  if (!pb->ParseFromString(entry.data)) {
+    return STATUS_FORMAT(Corruption, "Unable to parse $0 of $1", entry.type_name, path);
+  }
+  return pb_util::WritePBContainerToPath(env_, path, *pb, pb_util::OVERWRITE, pb_util::SYNC);
+}
+
+Result<const MetadataJournal::Entry*> MetadataJournal::Find(const std::string& path) const {
+  auto it = entries_.find(path);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  if (it->second.type_name.empty()) {
+    return STATUS_FORMAT(NotFound, "$0 was deleted", path);
+  }
+  return &it->second;
+}
+
+Result<bool> MetadataJournal::Read(
+    const std::string& path, google::protobuf::Message* pb) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto* entry = VERIFY_RESULT(Find(path));
+  if (!entry) {
+    return false;
+  }
+  if (!pb->ParseFromString(entry->data)) {
+    return STATUS_FORMAT(Corruption, "Unable to parse $0 of $1", entry->type_name, path);
+  }
+  return true;
+}
+
+Result<bool> MetadataJournal::GetSize(const std::string& path, uint64_t* size) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto* entry = VERIFY_RESULT(Find(path));
+  if (!entry) {
+    return false;
+  }
+  *size = entry->data.size();
+  return true;
+}
+
+} // namespace yb
@@ -0,0 +1,122 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_FS_METADATA_JOURNAL_H
+#define YB_FS_METADATA_JOURNAL_H
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "yb/gutil/ref_counted.h"
+
+#include "yb/util/env.h"
+#include "yb/util/result.h"
+
+namespace google {
+namespace protobuf {
+class Message;
+} // namespace protobuf
+} // namespace google
+
+namespace yb {
+
+class Thread;
+
+// Journal of metadata files, i.e. protobuf containers that are overwritten on each change, like
+// consensus metadata and Raft group superblocks.
+//
+// Instead of writing and syncing the file on each change, the new version of the file is appended
+// to the journal. Concurrent writes are group committed, so a single sync of the journal makes
+// the changes of many tablets durable. When the journal grows above
+// metadata_journal_compaction_size_bytes, it is moved aside and a new journal is started. The
+// latest version of each file changed in the old journal is written to the file itself in the
+// background, and then the old journal is deleted.
+//
+// The latest versions of files that were written through the journal are kept in memory, so they
+// should be read through the journal.
+//
+// This class is thread-safe.
+class MetadataJournal {
+ public:
+  MetadataJournal(Env* env, std::string path);
+  ~MetadataJournal();
+
+  // Replays the journal. Unless read_only is specified, writes the latest versions of replayed
+  // files to the files themselves and truncates the journal, so it is ready for writes.
+  CHECKED_STATUS Open(bool read_only);
+
+  // Durably writes the new version of the file at path. Returns after the journal is synced.
+  CHECKED_STATUS Write(const std::string& path, const google::protobuf::Message& pb);
+
+  // Durably deletes the file at path.
+  CHECKED_STATUS Delete(const std::string& path);
+
+  // Fills pb with the latest version of the file at path. Returns false if the file was not
+  // written through the journal since the last compaction, and NotFound if it was deleted.
+  Result<bool> Read(const std::string& path, google::protobuf::Message* pb) const;
+
+  // Same as Read, but provides the size of the serialized latest version.
+  Result<bool> GetSize(const std::string& path, uint64_t* size) const;
+
+  const std::string& path() const { return path_; }
+
+ private:
+  struct Entry {
+    // Empty type name means that the file was deleted.
+    std::string type_name;
+    std::string data;
+  };
+
+  typedef std::unordered_map<std::string, Entry> Entries;
+
+  CHECKED_STATUS Replay(const std::string& path);
+  CHECKED_STATUS Append(const std::string& path, std::string type_name, std::string data);
+  CHECKED_STATUS CreateFile();
+  CHECKED_STATUS StartCompaction(std::unique_lock<std::mutex>* lock);
+  void Compact(const Entries& entries);
+  CHECKED_STATUS WriteFiles(const Entries& entries);
+  CHECKED_STATUS WriteFile(const std::string& path, const Entry& entry);
+  Result<const Entry*> Find(const std::string& path) const;
+
+  Env* const env_;
+  const std::string path_;
+  // The old journal, while its files are written by compaction.
+  const std::string compacting_path_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cond_;
+  bool writable_ = false;
+  // Only accessed by the writer that is syncing the journal.
+  std::unique_ptr<WritableFile> file_;
+  // Latest synced versions of files, that were not written to the files themselves yet.
+  Entries entries_;
+  // Records that were not written to the journal yet, and their entries.
+  std::string pending_;
+  std::vector<std::pair<std::string, Entry>> pending_entries_;
+  uint64_t last_appended_seq_ = 0;
+  uint64_t synced_seq_ = 0;
+  bool syncing_ = false;
+  bool compacting_ = false;
+  scoped_refptr<Thread> compaction_thread_;
+  // Once a write to the journal fails, the journal is broken and all further writes fail.
+  Status status_;
+};
+
+} // namespace yb
+
+#endif // YB_FS_METADATA_JOURNAL_H
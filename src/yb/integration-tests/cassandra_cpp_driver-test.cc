@@ -13,6 +13,7 @@
 
 #include <cassandra.h>
 
+#include <set>
 #include <tuple>
 
 #include "yb/common/ql_value.h"
@@ -1315,6 +1316,54 @@ TEST_F_EX(CppCassandraDriverTest, TestCreateIndexSlowTServer,
   ASSERT_EQ(perm, IndexPermissions::INDEX_PERM_BACKFILL_FAILED);
 }
 
+class CppCassandraDriverTestIndexReadChunks : public CppCassandraDriverTestIndex {
+ public:
+  std::vector<std::string> ExtraTServerFlags() override {
+    auto flags = CppCassandraDriverTestIndex::ExtraTServerFlags();
+    flags.push_back("--cql_uncovered_index_read_chunk_size=3");
+    return flags;
+  }
+};
+
+// Primary keys are read from an uncovered index in chunks smaller than the page, and the rows
+// are fetched from the indexed table while the next chunk is read.
+TEST_F_EX(CppCassandraDriverTest, UncoveredIndexReadChunks, CppCassandraDriverTestIndexReadChunks) {
+  constexpr int kNumRows = 100;
+  constexpr int kLimit = 7;
+
+  ASSERT_OK(session_.ExecuteQuery(
+      "CREATE TABLE test.t (k int PRIMARY KEY, v int, w int) "
+      "WITH transactions = {'enabled' : true}"));
+  ASSERT_OK(session_.ExecuteQuery("CREATE INDEX t_by_v ON test.t (v)"));
+  const YBTableName table_name(YQL_DATABASE_CQL, "test", "t");
+  const YBTableName index_table_name(YQL_DATABASE_CQL, "test", "t_by_v");
+  ASSERT_EQ(ASSERT_RESULT(WaitUntilIndexPermissionIsAtLeast(
+                client_.get(), table_name, index_table_name,
+                IndexPermissions::INDEX_PERM_READ_WRITE_AND_DELETE)),
+            IndexPermissions::INDEX_PERM_READ_WRITE_AND_DELETE);
+
+  for (int k = 0; k != kNumRows; ++k) {
+    ASSERT_OK(session_.ExecuteQuery(Format(
+        "INSERT INTO test.t (k, v, w) VALUES ($0, $1, $2)", k, k % 2, k * 10)));
+  }
+
+  auto check = [this](const std::string& query, int expected_rows) {
+    auto result = ASSERT_RESULT(session_.ExecuteWithResult(query));
+    auto iterator = result.CreateIterator();
+    std::set<int> keys;
+    while (iterator.Next()) {
+      auto row = iterator.Row();
+      auto key = row.Value(0).As<int>();
+      ASSERT_EQ(key % 2, 1);
+      ASSERT_EQ(row.Value(1).As<int>(), key * 10);
+      ASSERT_TRUE(keys.insert(key).second) << "Duplicate key: " << key;
+    }
+    ASSERT_EQ(static_cast<int>(keys.size()), expected_rows) << query;
+  };
+  ASSERT_NO_FATALS(check("SELECT k, w FROM test.t WHERE v = 1", kNumRows / 2));
+  ASSERT_NO_FATALS(check(Format("SELECT k, w FROM test.t WHERE v = 1 LIMIT $0", kLimit), kLimit));
+}
+
 Result<IndexPermissions>
 TestBackfillCreateIndexTableSimple(CppCassandraDriverTestIndex *test) {
   RETURN_NOT_OK(test->session_.ExecuteQuery(
@@ -1471,6 +1520,53 @@ TEST_F_EX(CppCassandraDriverTest, TestTableCreateIndexUserEnforced,
   TestBackfillIndexTable(this, PKOnlyIndex::kFalse, IncludeAllColumns::kTrue, UserEnforced::kTrue);
 }
 
+class CppCassandraDriverTestIndexThreeMasters : public CppCassandraDriverTestIndex {
+ public:
+  std::vector<std::string> ExtraMasterFlags() override {
+    auto flags = CppCassandraDriverTestIndex::ExtraMasterFlags();
+    flags.push_back("--index_backfill_num_chunks_per_tablet=4");
+    return flags;
+  }
+
+ private:
+  int NumMasters() override {
+    return 3;
+  }
+};
+
+// The master leader changes during backfill, so the new leader resumes it from the checkpoints of
+// the tablets, including tablets that were already backfilled completely.
+TEST_F_EX(CppCassandraDriverTest, BackfillResumeAfterMasterFailover,
+          CppCassandraDriverTestIndexThreeMasters) {
+  constexpr int kNumRows = 200;
+
+  ASSERT_OK(session_.ExecuteQuery(
+      "create table test_table (k int primary key, v text) "
+      "with transactions = {'enabled' : true};"));
+  for (int i = 0; i != kNumRows; ++i) {
+    ASSERT_OK(session_.ExecuteQuery(
+        Format("insert into test_table (k, v) values ($0, 'value_$0');", i)));
+  }
+
+  WARN_NOT_OK(session_.ExecuteQuery("create index test_table_index_by_v on test_table (v);"),
+              "create-index failed.");
+
+  constexpr auto kNamespace = "test";
+  const YBTableName table_name(YQL_DATABASE_CQL, kNamespace, "test_table");
+  const YBTableName index_table_name(YQL_DATABASE_CQL, kNamespace, "test_table_index_by_v");
+  WaitUntilIndexPermissionIsAtLeast(
+      client_.get(), table_name, index_table_name, IndexPermissions::INDEX_PERM_DO_BACKFILL);
+  // Let backfill finish some of the tablets and chunks before the failover.
+  std::this_thread::sleep_for(3s);
+  ASSERT_OK(cluster_->StepDownMasterLeaderAndWaitForNewLeader());
+
+  IndexPermissions perm = WaitUntilIndexPermissionIsAtLeast(
+      client_.get(), table_name, index_table_name,
+      IndexPermissions::INDEX_PERM_READ_WRITE_AND_DELETE);
+  ASSERT_EQ(perm, IndexPermissions::INDEX_PERM_READ_WRITE_AND_DELETE);
+  ASSERT_EQ(kNumRows, ASSERT_RESULT(GetTableSize(&session_, "test_table_index_by_v")));
+}
+
 TEST_F_EX(CppCassandraDriverTest, ConcurrentIndexUpdate, CppCassandraDriverTestIndex) {
   constexpr int kLoops = 20;
   constexpr int kKeys = 30;
@@ -1552,6 +1648,57 @@ TEST_F_EX(CppCassandraDriverTest, ConcurrentIndexUpdate, CppCassandraDriverTestI
   }
 }
 
+// Writes of a transactional table are replicated concurrently with their index writes, so the
+// write is acknowledged only after both are done, and a failed index write fails the write.
+void TestTransactionalIndexWrites(CassandraSession* session) {
+  constexpr int kNumRows = 20;
+  ASSERT_OK(session->ExecuteQuery(
+      "CREATE TABLE t (k int PRIMARY KEY, v int, u int) "
+      "WITH transactions = { 'enabled' : true }"));
+  ASSERT_OK(session->ExecuteQuery("CREATE INDEX t_by_v ON t (v)"));
+  ASSERT_OK(session->ExecuteQuery("CREATE UNIQUE INDEX t_by_u ON t (u)"));
+
+  for (int i = 0; i != kNumRows; ++i) {
+    ASSERT_OK(session->ExecuteQuery(
+        Format("INSERT INTO t (k, v, u) VALUES ($0, $1, $0)", i, i * 10)));
+    // The index is read right after the write is acknowledged.
+    ASSERT_OK(session->ExecuteAndProcessOneRow(
+        Format("SELECT k FROM t WHERE v = $0", i * 10), [i](const CassandraRow& row) {
+      ASSERT_EQ(row.Value(0).As<int>(), i);
+    }));
+  }
+
+  // The unique index rejects the duplicate value, so the main table row is not written either.
+  ASSERT_NOK(session->ExecuteQuery(Format("INSERT INTO t (k, v, u) VALUES ($0, 0, 0)", kNumRows)));
+  ASSERT_EQ(kNumRows, ASSERT_RESULT(GetTableSize(session, "t")));
+  ASSERT_EQ(kNumRows, ASSERT_RESULT(GetTableSize(session, "t_by_v")));
+  ASSERT_EQ(kNumRows, ASSERT_RESULT(GetTableSize(session, "t_by_u")));
+}
+
+class CppCassandraDriverTestOverlapIndexWrites : public CppCassandraDriverTest {
+ public:
+  std::vector<std::string> ExtraTServerFlags() override {
+    return {"--overlap_transactional_index_writes_with_replication=true"s};
+  }
+};
+
+TEST_F_EX(CppCassandraDriverTest, OverlapTransactionalIndexWrites,
+          CppCassandraDriverTestOverlapIndexWrites) {
+  TestTransactionalIndexWrites(&session_);
+}
+
+class CppCassandraDriverTestSequentialIndexWrites : public CppCassandraDriverTest {
+ public:
+  std::vector<std::string> ExtraTServerFlags() override {
+    return {"--overlap_transactional_index_writes_with_replication=false"s};
+  }
+};
+
+TEST_F_EX(CppCassandraDriverTest, SequentialTransactionalIndexWrites,
+          CppCassandraDriverTestSequentialIndexWrites) {
+  TestTransactionalIndexWrites(&session_);
+}
+
 TEST_F(CppCassandraDriverTest, TestPrepare) {
   typedef TestTable<cass_bool_t, cass_int32_t, string, cass_int32_t, string> MyTable;
   MyTable table;
@@ -1576,6 +1723,79 @@ TEST_F(CppCassandraDriverTest, TestPrepare) {
   ExpectEqualTuples(input, output);
 }
 
+class CppCassandraDriverTestCacheQueries : public CppCassandraDriverTest {
+ public:
+  std::vector<std::string> ExtraTServerFlags() override {
+    return {"--cql_cache_unprepared_statements=true"s};
+  }
+};
+
+// Queries that were not prepared by the client are cached, so the cached parse tree should be
+// invalidated when the table it refers to is changed.
+TEST_F_EX(CppCassandraDriverTest, CachedQueries, CppCassandraDriverTestCacheQueries) {
+  const std::string kSelect = "SELECT v FROM test.t WHERE k = 1";
+  auto check_value = [this, &kSelect](int expected) {
+    ASSERT_OK(session_.ExecuteAndProcessOneRow(kSelect, [expected](const CassandraRow& row) {
+      ASSERT_EQ(row.Value(0).As<int>(), expected);
+    }));
+  };
+
+  ASSERT_OK(session_.ExecuteQuery("CREATE TABLE test.t (k int PRIMARY KEY, v int)"));
+  ASSERT_OK(session_.ExecuteQuery("INSERT INTO test.t (k, v) VALUES (1, 2)"));
+  for (int i = 0; i != 3; ++i) {
+    ASSERT_NO_FATALS(check_value(2));
+  }
+  ASSERT_OK(session_.ExecuteQuery("UPDATE test.t SET v = 3 WHERE k = 1"));
+  ASSERT_NO_FATALS(check_value(3));
+
+  ASSERT_OK(session_.ExecuteQuery("DROP TABLE test.t"));
+  ASSERT_OK(session_.ExecuteQuery("CREATE TABLE test.t (k int PRIMARY KEY, v int)"));
+  ASSERT_OK(session_.ExecuteQuery("INSERT INTO test.t (k, v) VALUES (1, 4)"));
+  ASSERT_NO_FATALS(check_value(4));
+}
+
+class CppCassandraDriverTestSplitBatch : public CppCassandraDriverTest {
+ public:
+  std::vector<std::string> ExtraTServerFlags() override {
+    return {"--cql_batch_split_min_statements=10"s};
+  }
+};
+
+// Statements of a large batch are flushed in per-tablet sub-batches, so writes to the same key
+// should still be applied in the batch order.
+TEST_F_EX(CppCassandraDriverTest, SplitBatch, CppCassandraDriverTestSplitBatch) {
+  constexpr int kNumKeys = 50;
+  constexpr int kRepeatedKey = 7;
+
+  ASSERT_OK(session_.ExecuteQuery("CREATE TABLE test.t (k int PRIMARY KEY, v int)"));
+  auto prepared = ASSERT_RESULT(session_.Prepare("INSERT INTO test.t (k, v) VALUES (?, ?)"));
+
+  CassandraBatch batch(CassBatchType::CASS_BATCH_TYPE_UNLOGGED);
+  for (int i = 0; i != kNumKeys; ++i) {
+    auto statement = prepared.Bind();
+    statement.Bind(0, i);
+    statement.Bind(1, i * 2);
+    batch.Add(&statement);
+  }
+  auto statement = prepared.Bind();
+  statement.Bind(0, kRepeatedKey);
+  statement.Bind(1, -1);
+  batch.Add(&statement);
+  ASSERT_OK(session_.ExecuteBatch(batch));
+
+  auto result = ASSERT_RESULT(session_.ExecuteWithResult("SELECT k, v FROM test.t"));
+  auto iterator = result.CreateIterator();
+  int num_rows = 0;
+  while (iterator.Next()) {
+    auto row = iterator.Row();
+    auto key = row.Value(0).As<int>();
+    auto value = row.Value(1).As<int>();
+    ASSERT_EQ(value, key == kRepeatedKey ? -1 : key * 2) << "Key: " << key;
+    ++num_rows;
+  }
+  ASSERT_EQ(num_rows, kNumKeys);
+}
+
 template <typename... ColumnsTypes>
 void TestTokenForTypes(
     CassandraSession* session,
@@ -13,6 +13,8 @@
 
 #include "yb/integration-tests/load_generator.h"
 
+#include <cmath>
+#include <fstream>
 #include <memory>
 #include <queue>
 #include <random>
@@ -40,6 +42,7 @@
 #include "yb/util/debug/leakcheck_disabler.h"
 #include "yb/util/env.h"
 #include "yb/util/flags.h"
+#include "yb/util/format.h"
 #include "yb/util/logging.h"
 #include "yb/util/net/sockaddr.h"
 #include "yb/util/stopwatch.h"
@@ -741,5 +744,211 @@ int64_t SingleThreadedReader::NextKeyIndexToRead(std::mt19937_64* random_number_
   return key_index;
 }
 
+// ------------------------------------------------------------------------------------------------
+// OpenLoopLoadGenerator
+// ------------------------------------------------------------------------------------------------
+
+namespace {
+
+// Latencies are tracked in microseconds.
+constexpr uint64_t kMaxTrackedLatencyUs = 120 * 1000 * 1000;
+constexpr int kLatencySignificantDigits = 3;
+
+std::string LatencyPercentiles(const HdrHistogram& histogram) {
+  return Format("p50: $0 us, p90: $1 us, p99: $2 us, p99.9: $3 us, max: $4 us",
+                histogram.ValueAtPercentile(50), histogram.ValueAtPercentile(90),
+                histogram.ValueAtPercentile(99), histogram.ValueAtPercentile(99.9),
+                histogram.ValueAtPercentile(100));
+}
+
+} // namespace
+
+ZipfianGenerator::ZipfianGenerator(int64_t num_items, double theta)
+    : num_items_(num_items), theta_(theta) {
+  CHECK_GT(num_items, 0);
+  CHECK(theta > 0 && theta < 1) << "Zipfian theta should be in (0, 1): " << theta;
+  zeta_n_ = 0;
+  for (int64_t i = 1; i <= num_items; ++i) {
+    zeta_n_ += 1 / std::pow(i, theta);
+  }
+  const double zeta_2 = 1 + 1 / std::pow(2, theta);
+  alpha_ = 1 / (1 - theta);
+  eta_ = (1 - std::pow(2.0 / num_items, 1 - theta)) / (1 - zeta_2 / zeta_n_);
+}
+
+int64_t ZipfianGenerator::Next(std::mt19937_64* random_number_generator) const {
+  const double u = std::uniform_real_distribution<double>()(*random_number_generator);
+  const double uz = u * zeta_n_;
+  if (uz < 1) {
+    return 0;
+  }
+  if (uz < 1 + std::pow(0.5, theta_)) {
+    return std::min<int64_t>(1, num_items_ - 1);
+  }
+  const auto result = static_cast<int64_t>(num_items_ * std::pow(eta_ * u - eta_ + 1, alpha_));
+  return std::min(result, num_items_ - 1);
+}
+
+OpenLoopLoadGenerator::OpenLoopLoadGenerator(
+    int64_t num_keys, client::YBClient* client, client::TableHandle* table,
+    const string& client_id, atomic_bool* stop_flag, int value_size,
+    const OpenLoopOptions& options)
+    : MultiThreadedAction(
+          "open loop", num_keys, 0 /* start_key */, 1 /* num_action_threads */,
+          1 /* num_extra_threads */, client_id, stop_flag, value_size),
+      client_(client),
+      table_(table),
+      options_(options),
+      read_latencies_(kMaxTrackedLatencyUs, kLatencySignificantDigits),
+      write_latencies_(kMaxTrackedLatencyUs, kLatencySignificantDigits),
+      interval_latencies_(kMaxTrackedLatencyUs, kLatencySignificantDigits) {
+  CHECK_GT(num_keys, 0);
+  CHECK_GT(options.target_ops_per_sec, 0);
+}
+
+void OpenLoopLoadGenerator::Start() {
+  start_time_ = MonoTime::Now();
+  MultiThreadedAction::Start();
+}
+
+void OpenLoopLoadGenerator::RunActionThread(int action_index) {
+  LOG(INFO) << "Open loop generator started, target rate: " << options_.target_ops_per_sec
+            << " ops/sec, reads: " << options_.read_percentage << "%, zipf theta: "
+            << options_.zipf_theta;
+  std::mt19937_64 random_number_generator(std::random_device{}());
+  // Inter-arrival times of a Poisson process are exponentially distributed.
+  std::exponential_distribution<double> interarrival_sec(options_.target_ops_per_sec);
+  std::uniform_int_distribution<int64_t> uniform_key(0, num_keys_ - 1);
+  std::unique_ptr<ZipfianGenerator> zipfian;
+  if (options_.zipf_theta > 0) {
+    zipfian = std::make_unique<ZipfianGenerator>(num_keys_, options_.zipf_theta);
+  }
+
+  MonoTime end_time = start_time_;
+  end_time += options_.duration;
+  MonoTime intended_time = start_time_;
+  while (!IsStopRequested()) {
+    intended_time += MonoDelta::FromSeconds(interarrival_sec(random_number_generator));
+    if (intended_time >= end_time) {
+      break;
+    }
+    const auto now = MonoTime::Now();
+    if (intended_time > now) {
+      SleepFor(intended_time - now);
+    }
+    // Operations are not sent while the limit is exceeded, but their latency is still measured
+    // from the intended time.
+    while (num_inflight_.load(std::memory_order_acquire) >= options_.max_inflight &&
+           !IsStopRequested()) {
+      std::this_thread::sleep_for(100us);
+    }
+    const int64_t key_index =
+        zipfian ? zipfian->Next(&random_number_generator) : uniform_key(random_number_generator);
+    const bool read =
+        static_cast<int>(random_number_generator() % 100) < options_.read_percentage;
+    Send(key_index, read, intended_time);
+  }
+
+  // Operations in flight are bounded by the session timeout.
+  while (num_inflight_.load(std::memory_order_acquire) > 0) {
+    std::this_thread::sleep_for(10ms);
+  }
+  LOG(INFO) << "Open loop generator finished";
+  running_threads_latch_.CountDown();
+}
+
+void OpenLoopLoadGenerator::Send(int64_t key_index, bool read, MonoTime intended_time) {
+  auto session = client_->NewSession();
+  ConfigureYBSession(session.get());
+  const string key_str = GetKeyByIndex(key_index);
+  num_inflight_.fetch_add(1, std::memory_order_acq_rel);
+  if (read) {
+    auto op = table_->NewReadOp();
+    QLAddStringHashValue(op->mutable_request(), key_str);
+    table_->AddColumns({"k", "v"}, op->mutable_request());
+    session->ReadAsync(op, [this, session, op, intended_time](const Status& status) {
+      OperationDone(
+          true /* read */, intended_time,
+          !status.ok() || op->response().status() != QLResponsePB::YQL_STATUS_OK);
+    });
+    return;
+  }
+
+  auto op = table_->NewInsertOp();
+  QLAddStringHashValue(op->mutable_request(), key_str);
+  table_->AddStringColumnValue(op->mutable_request(), "v", GetValueByIndex(key_index));
+  auto status = session->Apply(op);
+  if (!status.ok()) {
+    LOG(WARNING) << "Error inserting key '" << key_str << "': " << status;
+    OperationDone(false /* read */, intended_time, true /* failed */);
+    return;
+  }
+  session->FlushAsync([this, session, op, intended_time](const Status& status) {
+    OperationDone(
+        false /* read */, intended_time,
+        !status.ok() || op->response().status() != QLResponsePB::YQL_STATUS_OK);
+  });
+}
+
+void OpenLoopLoadGenerator::OperationDone(bool read, MonoTime intended_time, bool failed) {
+  const auto latency_us = std::min<uint64_t>(
+      std::max<int64_t>((MonoTime::Now() - intended_time).ToMicroseconds(), 0),
+      kMaxTrackedLatencyUs);
+  (read ? read_latencies_ : write_latencies_).Increment(latency_us);
+  interval_latencies_.Increment(latency_us);
+  if (failed) {
+    num_errors_.fetch_add(1, std::memory_order_acq_rel);
+  }
+  num_ops_.fetch_add(1, std::memory_order_acq_rel);
+  num_inflight_.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void OpenLoopLoadGenerator::RunStatsThread() {
+  std::unique_ptr<std::ofstream> output;
+  if (!options_.output_file.empty()) {
+    output = std::make_unique<std::ofstream>(options_.output_file);
+    *output << "elapsed_sec,ops,ops_per_sec,errors,p50_us,p90_us,p99_us,p99.9_us,max_us"
+            << std::endl;
+  }
+  MonoTime prev_time = start_time_;
+  int64_t prev_ops = 0;
+  int64_t prev_errors = 0;
+  while (!IsStopRequested() && running_threads_latch_.count() > 0) {
+    running_threads_latch_.WaitFor(options_.report_interval);
+    const auto now = MonoTime::Now();
+    // Non-consistent snapshot, operations finished between the snapshot and the reset are lost.
+    HdrHistogram interval(interval_latencies_);
+    interval_latencies_.ResetPercentiles();
+    const int64_t ops = num_ops();
+    const int64_t errors = num_errors();
+    const double ops_per_sec = (ops - prev_ops) / (now - prev_time).ToSeconds();
+    LOG(INFO) << "Completed " << ops << " operations (" << ops_per_sec << " ops/sec), in flight: "
+              << num_inflight_.load(std::memory_order_acquire) << ", errors: " << errors
+              << ", latency: " << LatencyPercentiles(interval);
+    if (output) {
+      *output << (now - start_time_).ToSeconds() << "," << ops - prev_ops << "," << ops_per_sec
+              << "," << errors - prev_errors << "," << interval.ValueAtPercentile(50) << ","
+              << interval.ValueAtPercentile(90) << "," << interval.ValueAtPercentile(99) << ","
+              << interval.ValueAtPercentile(99.9) << "," << interval.ValueAtPercentile(100)
+              << std::endl;
+    }
+    prev_time = now;
+    prev_ops = ops;
+    prev_errors = errors;
+  }
+}
+
+void OpenLoopLoadGenerator::WaitForCompletion() {
+  MultiThreadedAction::WaitForCompletion();
+  const double elapsed_sec = (MonoTime::Now() - start_time_).ToSeconds();
+  LOG(INFO) << "Open loop run finished: " << num_ops() << " operations in " << elapsed_sec
+            << " sec (" << num_ops() / elapsed_sec << " ops/sec, target "
+            << options_.target_ops_per_sec << "), errors: " << num_errors();
+  LOG(INFO) << "Read latency (" << read_latencies_.TotalCount() << " reads): "
+            << LatencyPercentiles(read_latencies_);
+  LOG(INFO) << "Write latency (" << write_latencies_.TotalCount() << " writes): "
+            << LatencyPercentiles(write_latencies_);
+}
+
 }  // namespace load_generator
 }  // namespace yb
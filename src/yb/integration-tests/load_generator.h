@@ -26,6 +26,7 @@
 #include "yb/gutil/stl_util.h"
 #include "yb/util/threadpool.h"
 #include "yb/util/countdown_latch.h"
+#include "yb/util/hdr_histogram.h"
 #include "yb/util/test_util.h"
 
 namespace yb {
@@ -390,6 +391,83 @@ class RedisSingleThreadedReader : public SingleThreadedReader {
   const std::string redis_server_addresses_;
 };
 
+// ------------------------------------------------------------------------------------------------
+// OpenLoopLoadGenerator
+// ------------------------------------------------------------------------------------------------
+
+// Generates integers in [0, num_items) with Zipfian distribution, 0 being the most popular one.
+// Uses the algorithm from "Quickly Generating Billion-Record Synthetic Databases" by Gray et al.,
+// the same one as YCSB.
+class ZipfianGenerator {
+ public:
+  // theta is the skew of the distribution, it should be in (0, 1).
+  ZipfianGenerator(int64_t num_items, double theta);
+
+  int64_t Next(std::mt19937_64* random_number_generator) const;
+
+ private:
+  const int64_t num_items_;
+  const double theta_;
+  double zeta_n_;
+  double alpha_;
+  double eta_;
+};
+
+struct OpenLoopOptions {
+  double target_ops_per_sec = 1000;
+  // Percentage of reads among the issued operations, the rest are writes.
+  int read_percentage = 50;
+  // Skew of Zipfian key distribution, 0 means uniform distribution of keys.
+  double zipf_theta = 0;
+  MonoDelta duration = MonoDelta::FromSeconds(60);
+  MonoDelta report_interval = MonoDelta::FromSeconds(1);
+  // CSV file for the time series of per interval throughput and latency percentiles, could be
+  // empty.
+  std::string output_file;
+  // The limit of operations in flight, protects the client from unbounded memory usage when the
+  // cluster cannot keep up with the target rate.
+  int max_inflight = 10000;
+};
+
+// Issues reads and writes of num_keys keys with Poisson arrivals at the target rate, without
+// waiting for previous operations to complete, i.e. open-loop. Latency is measured from the
+// intended send time of an operation, so delays that closed-loop generators hide (coordinated
+// omission) are accounted.
+class OpenLoopLoadGenerator : public MultiThreadedAction {
+ public:
+  OpenLoopLoadGenerator(
+      int64_t num_keys, client::YBClient* client, client::TableHandle* table,
+      const std::string& client_id, std::atomic_bool* stop_flag, int value_size,
+      const OpenLoopOptions& options);
+
+  void Start() override;
+  void WaitForCompletion() override;
+
+  int64_t num_ops() const { return num_ops_.load(std::memory_order_acquire); }
+  int64_t num_errors() const { return num_errors_.load(std::memory_order_acquire); }
+
+ private:
+  void RunActionThread(int action_index) override;
+  void RunStatsThread() override;
+
+  void Send(int64_t key_index, bool read, MonoTime intended_time);
+  void OperationDone(bool read, MonoTime intended_time, bool failed);
+
+  client::YBClient* const client_;
+  client::TableHandle* const table_;
+  const OpenLoopOptions options_;
+
+  HdrHistogram read_latencies_;
+  HdrHistogram write_latencies_;
+  // Latencies of both reads and writes, reset every report interval.
+  HdrHistogram interval_latencies_;
+
+  std::atomic<int64_t> num_ops_{0};
+  std::atomic<int64_t> num_errors_{0};
+  std::atomic<int> num_inflight_{0};
+  MonoTime start_time_;
+};
+
 }  // namespace load_generator
 }  // namespace yb
 
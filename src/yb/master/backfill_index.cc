@@ -134,6 +134,14 @@ DEFINE_int32(index_backfill_wait_for_alter_table_completion_ms, 100,
 TAG_FLAG(index_backfill_wait_for_alter_table_completion_ms, advanced);
 TAG_FLAG(index_backfill_wait_for_alter_table_completion_ms, runtime);
 
+DEFINE_int32(index_backfill_num_chunks_per_tablet, 8,
+             "Number of chunks the hash range of an indexed table tablet is split into during "
+             "index backfill. Each chunk is backfilled by a separate request and its completion "
+             "is checkpointed, so backfill resumes from the last finished chunk after a master "
+             "failover.");
+TAG_FLAG(index_backfill_num_chunks_per_tablet, advanced);
+TAG_FLAG(index_backfill_num_chunks_per_tablet, runtime);
+
 DEFINE_test_flag(int32, TEST_slowdown_backfill_alter_table_rpcs_ms, 0,
     "Slows down the send alter table rpc's so that the master may be stopped between "
     "different phases.");
@@ -599,11 +607,16 @@ Status BackfillTable::SendRpcToAllowCompactionsToGCDeleteMarkers(
 BackfillTablet::BackfillTablet(
     std::shared_ptr<BackfillTable> backfill_table, const scoped_refptr<TabletInfo>& tablet)
     : backfill_table_(backfill_table), tablet_(tablet) {
+  {
+    auto table_lock = tablet_->table()->LockForRead();
+    hash_partitioned_ = table_lock->data().pb.partition_schema().has_hash_schema();
+  }
   {
     auto l = tablet_->LockForRead();
     Partition::FromPB(tablet_->metadata().state().pb.partition(), &partition_);
     if (tablet_->metadata().state().pb.has_backfilled_until()) {
       chunk_start_ = tablet_->metadata().state().pb.backfilled_until();
+      done_ = chunk_start_ == partition_.partition_key_end();
     } else {
       chunk_start_ = partition_.partition_key_start();
     }
@@ -629,6 +642,36 @@ BackfillTablet::BackfillTablet(
   chunk_end_ = GetChunkEnd(chunk_start_);
 }
 
+std::string BackfillTablet::GetChunkEnd(const std::string& start) const {
+  const auto num_chunks = FLAGS_index_backfill_num_chunks_per_tablet;
+  if (!hash_partitioned_ || num_chunks <= 1 || start == partition_.partition_key_end()) {
+    return partition_.partition_key_end();
+  }
+
+  const uint32_t partition_start = partition_.partition_key_start().empty()
+      ? 0 : PartitionSchema::DecodeMultiColumnHashValue(partition_.partition_key_start());
+  const uint32_t partition_end = partition_.partition_key_end().empty()
+      ? PartitionSchema::kMaxPartitionKey + 1
+      : PartitionSchema::DecodeMultiColumnHashValue(partition_.partition_key_end());
+  const uint32_t chunk_start =
+      start.empty() ? 0 : PartitionSchema::DecodeMultiColumnHashValue(start);
+  const uint32_t chunk_size = std::max<uint32_t>(
+      (partition_end - partition_start + num_chunks - 1) / num_chunks, 1);
+  if (chunk_start + chunk_size >= partition_end) {
+    return partition_.partition_key_end();
+  }
+  return PartitionSchema::EncodeMultiColumnHashValue(chunk_start + chunk_size);
+}
+
+void BackfillTablet::Launch() {
+  if (done_) {
+    LOG(INFO) << "Tablet " << yb::ToString(tablet_) << " was already backfilled";
+    backfill_table_->Done(Status::OK());
+    return;
+  }
+  LaunchNextChunk();
+}
+
 void BackfillTablet::LaunchNextChunk() {
   if (!backfill_table_->done()) {
     auto chunk = std::make_shared<BackfillChunk>(shared_from_this(), chunk_start_, chunk_end_);
@@ -162,7 +162,7 @@ class BackfillTablet : public std::enable_shared_from_this<BackfillTablet> {
   BackfillTablet(
       std::shared_ptr<BackfillTable> backfill_table, const scoped_refptr<TabletInfo>& tablet);
 
-  void Launch() { LaunchNextChunk(); }
+  void Launch();
 
   void LaunchNextChunk();
   void Done(const Status& status);
@@ -181,16 +181,13 @@ class BackfillTablet : public std::enable_shared_from_this<BackfillTablet> {
 
   int32_t schema_version() { return backfill_table_->schema_version(); }
 
-  // Returns the partition key corresponding to the end of this chunk. This is encoded
-  // using the same hashing/partition scheme as used by the main/indexed table.
-  // As of Dec 2019, we consider the whole tablet range to be one chunk. But the plan is
-  // to subdivide this into smaller chunks going forward for better checkpointing
-  // and restartability (#2615).
-  std::string GetChunkEnd(std::string start) {
-    // TODO(#2615) : Ideally we want to split one tablet into multiple chunks, so that
-    // each chunk can make progress and finish relatively quickly.
-    return partition_.partition_key_end();
-  }
+  // Returns the partition key corresponding to the end of the chunk starting at start. This is
+  // encoded using the same hashing/partition scheme as used by the main/indexed table.
+  // The hash range of a hash partitioned tablet is split into
+  // index_backfill_num_chunks_per_tablet chunks, so that the progress of each chunk is
+  // checkpointed in backfilled_until and a new master leader resumes from the last finished
+  // chunk. Other tablets are backfilled as one chunk.
+  std::string GetChunkEnd(const std::string& start) const;
 
   const scoped_refptr<TabletInfo> tablet() { return tablet_; }
 
@@ -198,6 +195,10 @@ class BackfillTablet : public std::enable_shared_from_this<BackfillTablet> {
   std::shared_ptr<BackfillTable> backfill_table_;
   const scoped_refptr<TabletInfo> tablet_;
   Partition partition_;
+  bool hash_partitioned_ = false;
+  // Whether backfilled_until of the tablet shows that it was backfilled completely, e.g. by the
+  // previous master leader.
+  bool done_ = false;
 
   // partition keys corresponding to the start/end of the chunk being processed,
   // and how far backfill has been already processed.
@@ -201,6 +201,14 @@ class TabletInfo : public RefCountedThreadSafe<TabletInfo>,
   // Replaces a replica in replica_locations_ map if it exists. Otherwise, it adds it to the map.
   void UpdateReplicaLocations(const TabletReplica& replica);
 
+  // Incremented each time the replica locations are set or updated, so readers could detect
+  // whether the locations changed since they were last retrieved.
+  uint64_t replica_locations_version() const;
+
+  // Bumps the replica locations version if the tablet has a replica on the tablet server, since
+  // the locations of a replica include the addresses of its tablet server.
+  void TabletServerAddressesChanged(const std::string& ts_uuid);
+
   // Accessors for the last time the replica locations were updated.
   void set_last_update_time(const MonoTime& ts);
   MonoTime last_update_time() const;
@@ -249,6 +257,8 @@ class TabletInfo : public RefCountedThreadSafe<TabletInfo>,
   // reported. The map is keyed by tablet server UUID.
   ReplicaMap replica_locations_;
 
+  uint64_t replica_locations_version_ = 0;
+
   // Reported schema version (in-memory only).
   uint32_t reported_schema_version_ = 0;
 
@@ -260,6 +260,30 @@ TEST(TestCatalogManager, TestLeaderLoadBalanced) {
   ASSERT_OK(CatalogManagerUtil::AreLeadersOnPreferredOnly(ts_descs, replication_info));
 }
 
+TEST(TestCatalogManager, TestSortLoadByOps) {
+  google::FlagSaver flag_saver;
+  std::shared_ptr<TSDescriptor> ts0 = SetupTS("0000", "a");
+  std::shared_ptr<TSDescriptor> ts1 = SetupTS("1111", "b");
+  std::shared_ptr<TSDescriptor> ts2 = SetupTS("2222", "c");
+  ts0->set_read_ops_per_sec(500);
+  ts0->set_write_ops_per_sec(500);
+  ts1->set_read_ops_per_sec(10);
+  ts2->set_write_ops_per_sec(100);
+
+  ClusterLoadState state;
+  for (const auto& ts : {ts0, ts1, ts2}) {
+    state.UpdateTabletServer(ts);
+  }
+  // No tablets, so servers with the same load are ordered by the operations they serve.
+  state.SortLoad();
+  ASSERT_EQ((vector<TabletServerId>{"1111", "2222", "0000"}), state.sorted_load_);
+  state.SortLeaderLoad();
+  ASSERT_EQ((vector<TabletServerId>{"1111", "2222", "0000"}), state.sorted_leader_load_);
+
+  FLAGS_load_balancer_prefer_less_busy_tservers = false;
+  state.SortLoad();
+  ASSERT_EQ((vector<TabletServerId>{"0000", "1111", "2222"}), state.sorted_load_);
+}
 
 } // namespace master
 } // namespace yb
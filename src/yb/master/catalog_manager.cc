@@ -185,6 +185,21 @@ DEFINE_int32(catalog_manager_inject_latency_in_delete_table_ms, 0,
              "Number of milliseconds that the master will sleep in DeleteTable.");
 TAG_FLAG(catalog_manager_inject_latency_in_delete_table_ms, hidden);
 
+DEFINE_bool(reuse_unchanged_sys_catalog_on_election, true,
+            "When a master is elected leader again, and the sys catalog was not changed by other "
+            "masters since this master loaded it, keep the in-memory catalog state instead of "
+            "reloading the whole sys catalog.");
+TAG_FLAG(reuse_unchanged_sys_catalog_on_election, advanced);
+TAG_FLAG(reuse_unchanged_sys_catalog_on_election, runtime);
+
+DEFINE_int32(ysql_catalog_invalidation_history_size, 64,
+             "Number of the latest YSQL catalog versions, whose catalog cache invalidation "
+             "messages are kept by the master. Backends, that are behind by more versions, reset "
+             "all of their catalog caches instead of invalidating only the affected entries. "
+             "0 disables incremental catalog cache invalidation.");
+TAG_FLAG(ysql_catalog_invalidation_history_size, advanced);
+TAG_FLAG(ysql_catalog_invalidation_history_size, runtime);
+
 DEFINE_int32(replication_factor, 3,
              "Default number of replicas for tables that do not have the num_replicas set.");
 TAG_FLAG(replication_factor, advanced);
@@ -514,6 +529,10 @@ Status CatalogManager::Init(bool is_first_run) {
   metric_num_tablet_servers_dead_ =
     METRIC_num_tablet_servers_dead.Instantiate(master_->metric_entity_cluster(), 0);
 
+  master_->ts_manager()->SetTSAddressesChangedCallback([this](const TabletServerId& ts_uuid) {
+    TabletServerAddressesChanged(ts_uuid);
+  });
+
   RETURN_NOT_OK_PREPEND(InitSysCatalogAsync(is_first_run),
                         "Failed to initialize sys tables async");
 
@@ -666,6 +685,24 @@ Status CatalogManager::VisitSysCatalog(int64_t term) {
   AppendValuesFromMap(*table_ids_map_, &tables);
   AbortAndWaitForAllTasks(tables);
 
+  // All writes to the sys catalog, that were made since the previous load, were made by this
+  // master, and are already reflected in memory. So only the state, that is not persisted, has to
+  // be reset.
+  if (FLAGS_reuse_unchanged_sys_catalog_on_election && loaded_sys_catalog_state_ &&
+      sys_catalog_->ChangedOnlyByOwnWrites(*loaded_sys_catalog_state_, term)) {
+    LOG(INFO) << __func__ << ": Sys catalog was not changed since it was loaded, reusing it";
+    tasks_tracker_->Reset();
+    std::vector<std::shared_ptr<TSDescriptor>> descs;
+    master_->ts_manager()->GetAllDescriptors(&descs);
+    for (const auto& ts_desc : descs) {
+      ts_desc->set_has_tablet_report(false);
+    }
+    // Writes made in this term after the catalog was reused are ours as well.
+    loaded_sys_catalog_state_->term = term;
+    return Status::OK();
+  }
+  loaded_sys_catalog_state_ = boost::none;
+
   // Clear internal maps and run data loaders.
   RETURN_NOT_OK(RunLoaders(term));
 
@@ -759,6 +796,7 @@ Status CatalogManager::VisitSysCatalog(int64_t term) {
         table_ids_map_.CheckOut().get_ptr(), sys_catalog_.get(), ysql_catalog_config_.get(), term));
   }
 
+  loaded_sys_catalog_state_ = sys_catalog_->GetLoadedState(term);
   return Status::OK();
 }
 
@@ -1732,7 +1770,15 @@ Status CatalogManager::GetYsqlCatalogConfig(const GetYsqlCatalogConfigRequestPB*
   RETURN_NOT_OK(CheckOnline());
   VLOG(1) << "GetYsqlCatalogConfig request: " << req->ShortDebugString();
   auto l = CHECK_NOTNULL(ysql_catalog_config_.get())->LockForRead();
-  resp->set_version(l->data().pb.ysql_catalog_config().version());
+  const auto& ysql_catalog_config = l->data().pb.ysql_catalog_config();
+  resp->set_version(ysql_catalog_config.version());
+  if (req->has_invalidations_since_version()) {
+    for (const auto& invalidation : ysql_catalog_config.invalidations()) {
+      if (invalidation.version() > req->invalidations_since_version()) {
+        *resp->add_invalidations() = invalidation;
+      }
+    }
+  }
 
   return Status::OK();
 }
@@ -3876,17 +3922,24 @@ Status CatalogManager::ProcessTabletReport(TSDescriptor* ts_desc,
                           Substitute("Error handling $0", reported.ShortDebugString()));
   }
 
-  if (!ts_desc->has_tablet_report()) {
-    LOG(INFO) << ts_desc->permanent_uuid() << " now has full report for "
-              << report.updated_tablets_size() << " tablets.";
-  }
+  if (!report.is_incremental() && report.remaining_tablet_count() > 0) {
+    // The rest of the full report will be sent in the following heartbeats.
+    VLOG(1) << ts_desc->permanent_uuid() << " sent part of full report with "
+            << report.updated_tablets_size() << " tablets, "
+            << report.remaining_tablet_count() << " tablets remaining.";
+  } else {
+    if (!ts_desc->has_tablet_report()) {
+      LOG(INFO) << ts_desc->permanent_uuid() << " now has full report for "
+                << report.updated_tablets_size() << " tablets.";
+    }
 
-  if (!report.is_incremental()) {
-    if (report.updated_tablets_size() == 0) {
-      LOG(INFO) << ts_desc->permanent_uuid() << " sent full tablet report with 0 tablets.";
+    if (!report.is_incremental()) {
+      if (report.updated_tablets_size() == 0) {
+        LOG(INFO) << ts_desc->permanent_uuid() << " sent full tablet report with 0 tablets.";
+      }
+      // Do not unset full tablet report missing for ts desc for an incremental case.
+      ts_desc->set_has_tablet_report(true);
     }
-    // Do not unset full tablet report missing for ts desc for an incremental case.
-    ts_desc->set_has_tablet_report(true);
   }
 
   if (report.updated_tablets_size() > 0) {
@@ -4984,11 +5037,26 @@ bool CatalogManager::CDCStreamExistsUnlocked(const CDCStreamId& stream_id) {
   return false;
 }
 
-Result<uint64_t> CatalogManager::IncrementYsqlCatalogVersion() {
+Result<uint64_t> CatalogManager::IncrementYsqlCatalogVersion(
+    const std::string& invalidation_messages) {
 
   auto l = CHECK_NOTNULL(ysql_catalog_config_.get())->LockForWrite();
-  uint64_t new_version = l->data().pb.ysql_catalog_config().version() + 1;
-  l->mutable_data()->pb.mutable_ysql_catalog_config()->set_version(new_version);
+  auto* ysql_catalog_config = l->mutable_data()->pb.mutable_ysql_catalog_config();
+  uint64_t new_version = ysql_catalog_config->version() + 1;
+  ysql_catalog_config->set_version(new_version);
+
+  // The version is recorded only with its messages, so a version without messages makes the
+  // backends reset their caches.
+  auto* invalidations = ysql_catalog_config->mutable_invalidations();
+  const int history_size = std::max(FLAGS_ysql_catalog_invalidation_history_size, 0);
+  if (!invalidation_messages.empty() && history_size > 0) {
+    auto* invalidation = invalidations->Add();
+    invalidation->set_version(new_version);
+    invalidation->set_messages(invalidation_messages);
+  }
+  if (invalidations->size() > history_size) {
+    invalidations->DeleteSubrange(0, invalidations->size() - history_size);
+  }
 
   // Write to sys_catalog and in memory.
   RETURN_NOT_OK(sys_catalog_->UpdateItem(ysql_catalog_config_.get(), leader_ready_term_));
@@ -4997,6 +5065,15 @@ Result<uint64_t> CatalogManager::IncrementYsqlCatalogVersion() {
   return new_version;
 }
 
+Status CatalogManager::IncrementYsqlCatalogVersion(
+    const IncrementYsqlCatalogVersionRequestPB* req,
+    IncrementYsqlCatalogVersionResponsePB* resp,
+    rpc::RpcContext* rpc) {
+  RETURN_NOT_OK(CheckOnline());
+  resp->set_version(VERIFY_RESULT(IncrementYsqlCatalogVersion(req->invalidation_messages())));
+  return Status::OK();
+}
+
 Status CatalogManager::InitDbFinished(Status initdb_status, int64_t term) {
   if (initdb_status.ok()) {
     LOG(INFO) << "initdb completed successfully";
@@ -5122,6 +5199,14 @@ void CatalogManager::UpdateTabletReplica(TSDescriptor* ts_desc,
   tablet_locations_version_.fetch_add(1, std::memory_order_acq_rel);
 }
 
+void CatalogManager::TabletServerAddressesChanged(const TabletServerId& ts_uuid) {
+  LOG(INFO) << "Tablet server " << ts_uuid << " re-registered with other addresses";
+  for (const auto& tablet : GetAllTablets()) {
+    tablet->TabletServerAddressesChanged(ts_uuid);
+  }
+  tablet_locations_version_.fetch_add(1, std::memory_order_acq_rel);
+}
+
 void CatalogManager::NewReplica(TSDescriptor* ts_desc,
                                 const ReportedTabletPB& report,
                                 TabletReplica* replica) {
@@ -5481,18 +5566,28 @@ void CatalogManager::GetPendingServerTasksUnlocked(const TableId &table_uuid,
   }
 }
 
+TabletInfos CatalogManager::GetAllTablets() {
+  TabletInfos result;
+  SharedLock<LockType> l(lock_);
+  result.reserve(tablet_map_->size());
+  for (const TabletInfoMap::value_type& entry : *tablet_map_) {
+    result.push_back(entry.second);
+  }
+  return result;
+}
+
 void CatalogManager::ExtractTabletsToProcess(
     TabletInfos *tablets_to_delete,
     TabletInfos *tablets_to_process) {
-  SharedLock<LockType> l(lock_);
-
   // TODO: At the moment we loop through all the tablets
   //       we can keep a set of tablets waiting for "assignment"
   //       or just a counter to avoid to take the lock and loop through the tablets
   //       if everything is "stable".
 
-  for (const TabletInfoMap::value_type& entry : *tablet_map_) {
-    scoped_refptr<TabletInfo> tablet = entry.second;
+  // Tablets are locked outside of the catalog lock, so table creates and tablet lookups are not
+  // blocked while the background task walks through all tablets.
+  TabletInfos deleted_tablets;
+  for (const auto& tablet : GetAllTablets()) {
     auto tablet_lock = tablet->LockForRead();
 
     if (!tablet->table()) {
@@ -5504,10 +5599,7 @@ void CatalogManager::ExtractTabletsToProcess(
 
     // If the table is deleted or the tablet was replaced at table creation time.
     if (tablet_lock->data().is_deleted() || table_lock->data().started_deleting()) {
-      // Process this table deletion only once (tombstones for table may remain longer).
-      if (table_ids_map_->find(tablet->table()->id()) != table_ids_map_->end()) {
-        tablets_to_delete->push_back(tablet);
-      }
+      deleted_tablets.push_back(tablet);
       // Don't process deleted tables regardless.
       continue;
     }
@@ -5521,13 +5613,25 @@ void CatalogManager::ExtractTabletsToProcess(
     // Tablets not yet assigned or with a report just received.
     tablets_to_process->push_back(tablet);
   }
+
+  if (deleted_tablets.empty()) {
+    return;
+  }
+
+  // Process this table deletion only once (tombstones for table may remain longer).
+  SharedLock<LockType> l(lock_);
+  for (auto& tablet : deleted_tablets) {
+    if (table_ids_map_->find(tablet->table()->id()) != table_ids_map_->end()) {
+      tablets_to_delete->push_back(std::move(tablet));
+    }
+  }
 }
 
 bool CatalogManager::AreTablesDeleting() {
-  SharedLock<LockType> catalog_lock(lock_);
+  std::vector<scoped_refptr<TableInfo>> tables;
+  GetAllTables(&tables);
 
-  for (const TableInfoMap::value_type& entry : *table_ids_map_) {
-    scoped_refptr<TableInfo> table(entry.second);
+  for (const auto& table : tables) {
     auto table_lock = table->LockForRead();
     // TODO(jason): possibly change this to started_deleting when we begin removing DELETED tables
     // from table_ids_map_ (see CleanUpDeletedTables).
@@ -6103,14 +6207,13 @@ Status CatalogManager::ConsensusStateToTabletLocations(const consensus::Consensu
 
 Status CatalogManager::BuildLocationsForTablet(const scoped_refptr<TabletInfo>& tablet,
                                                TabletLocationsPB* locs_pb) {
-  {
-    auto l_tablet = tablet->LockForRead();
-    locs_pb->set_table_id(l_tablet->data().pb.table_id());
-    *locs_pb->mutable_table_ids() = l_tablet->data().pb.table_ids();
-  }
-
   // For system tables, the set of replicas is always the set of masters.
   if (system_tablets_.find(tablet->id()) != system_tablets_.end()) {
+    {
+      auto l_tablet = tablet->LockForRead();
+      locs_pb->set_table_id(l_tablet->data().pb.table_id());
+      *locs_pb->mutable_table_ids() = l_tablet->data().pb.table_ids();
+    }
     consensus::ConsensusStatePB master_consensus;
     RETURN_NOT_OK(GetCurrentConfig(&master_consensus));
     locs_pb->set_tablet_id(tablet->tablet_id());
@@ -6119,12 +6222,13 @@ Status CatalogManager::BuildLocationsForTablet(const scoped_refptr<TabletInfo>&
     return Status::OK();
   }
 
-  TSRegistrationPB reg;
-
   TabletInfo::ReplicaMap locs;
   consensus::ConsensusStatePB cstate;
   {
     auto l_tablet = tablet->LockForRead();
+    locs_pb->set_table_id(l_tablet->data().pb.table_id());
+    *locs_pb->mutable_table_ids() = l_tablet->data().pb.table_ids();
+
     if (PREDICT_FALSE(l_tablet->data().is_deleted())) {
       return STATUS(NotFound, "Tablet deleted", l_tablet->data().pb.state_msg());
     }
@@ -6155,14 +6259,7 @@ Status CatalogManager::BuildLocationsForTablet(const scoped_refptr<TabletInfo>&
       TabletLocationsPB_ReplicaPB* replica_pb = locs_pb->add_replicas();
       replica_pb->set_role(replica.second.role);
       replica_pb->set_member_type(replica.second.member_type);
-      TSInformationPB tsinfo_pb = *replica.second.ts_desc->GetTSInformationPB();
-
-      TSInfoPB* out_ts_info = replica_pb->mutable_ts_info();
-      out_ts_info->set_permanent_uuid(tsinfo_pb.tserver_instance().permanent_uuid());
-      TakeRegistration(tsinfo_pb.mutable_registration()->mutable_common(), out_ts_info);
-      out_ts_info->set_placement_uuid(tsinfo_pb.registration().common().placement_uuid());
-      *out_ts_info->mutable_capabilities() = std::move(
-          *tsinfo_pb.mutable_registration()->mutable_capabilities());
+      *replica_pb->mutable_ts_info() = *replica.second.ts_desc->GetTSInfoPB();
     }
     return Status::OK();
   }
@@ -6674,9 +6771,7 @@ std::string BlacklistState::ToString() {
 
 int64_t CatalogManager::GetNumRelevantReplicas(const BlacklistState& state, bool leaders_only) {
   int64_t res = 0;
-  std::lock_guard <LockType> tablet_map_lock(lock_);
-  for (const TabletInfoMap::value_type& entry : *tablet_map_) {
-    scoped_refptr<TabletInfo> tablet = entry.second;
+  for (const auto& tablet : GetAllTablets()) {
     auto l = tablet->LockForRead();
     // Not checking being created on purpose as we do not want initial load to be under accounted.
     if (!tablet->table() ||
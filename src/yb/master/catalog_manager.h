@@ -123,6 +123,14 @@ using PlacementId = std::string;
 
 typedef unordered_map<TabletId, TabletServerId> TabletToTabletServerMap;
 
+// State of the sys catalog data at the moment it was loaded into memory by the leader of term.
+// See SysCatalogTable::GetLoadedState.
+struct SysCatalogLoadedState {
+  int64_t term;
+  int64_t db_generation;
+  int64_t failed_writes;
+};
+
 // Component within the catalog manager which tracks blacklist (decommission) operation
 // related information.
 class BlacklistState {
@@ -184,7 +192,8 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
                                   ReservePgsqlOidsResponsePB* resp,
                                   rpc::RpcContext* rpc);
 
-  // Get the info (current only version) for the ysql system catalog.
+  // Get the info (current version and the requested invalidation messages) for the ysql system
+  // catalog.
   CHECKED_STATUS GetYsqlCatalogConfig(const GetYsqlCatalogConfigRequestPB* req,
                                       GetYsqlCatalogConfigResponsePB* resp,
                                       rpc::RpcContext* rpc);
@@ -371,7 +380,14 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   virtual CHECKED_STATUS ChangeEncryptionInfo(const ChangeEncryptionInfoRequestPB* req,
                                               ChangeEncryptionInfoResponsePB* resp);
 
-  Result<uint64_t> IncrementYsqlCatalogVersion();
+  // Increments the YSQL catalog version, and records the catalog cache invalidation messages of
+  // the catalog change with the new version.
+  Result<uint64_t> IncrementYsqlCatalogVersion(
+      const std::string& invalidation_messages = std::string());
+
+  CHECKED_STATUS IncrementYsqlCatalogVersion(const IncrementYsqlCatalogVersionRequestPB* req,
+                                             IncrementYsqlCatalogVersionResponsePB* resp,
+                                             rpc::RpcContext* rpc);
 
   // Records the fact that initdb has succesfully completed.
   CHECKED_STATUS InitDbFinished(Status initdb_status, int64_t term);
@@ -810,6 +826,10 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
                            const ReportedTabletPB& report,
                            const scoped_refptr<TabletInfo>& tablet);
 
+  // Invalidates the cached replica locations of tablets with replicas on a tablet server that
+  // re-registered with other addresses.
+  void TabletServerAddressesChanged(const TabletServerId& ts_uuid);
+
   // It works as AddReplicaToTabletIfNotFound if the replica is not in the tablet map.
   // If it already exists, it replaces the existing replica with a new replica created from the
   // report.
@@ -820,6 +840,10 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   static void NewReplica(
       TSDescriptor* ts_desc, const ReportedTabletPB& report, TabletReplica* replica);
 
+  // Returns a snapshot of all tablets in tablet_map_. The catalog lock is held only while the
+  // references are copied, so callers could lock individual tablets without blocking lookups.
+  TabletInfos GetAllTablets();
+
   // Extract the set of tablets that can be deleted and the set of tablets
   // that must be processed because not running yet.
   void ExtractTabletsToProcess(TabletInfos *tablets_to_delete,
@@ -1122,6 +1146,10 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // correctly.
   int64_t leader_ready_term_;
 
+  // State of the sys catalog data when it was last loaded into memory, or none if it was not
+  // loaded. Protected by lock_.
+  boost::optional<SysCatalogLoadedState> loaded_sys_catalog_state_;
+
   // Lock used to fence operations and leader elections. All logical operations
   // (i.e. create table, alter table, etc.) should acquire this lock for
   // reading. Following an election where this master is elected leader, it
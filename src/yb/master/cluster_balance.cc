@@ -65,6 +65,12 @@ DEFINE_int32(load_balancer_max_concurrent_moves,
              "Maximum number of tablet leaders on tablet servers to move in any one run of the "
              "load balancer.");
 
+DEFINE_bool(load_balancer_prefer_less_busy_tservers, true,
+            "When tablet servers have the same number of tablets or leaders, move load from the "
+            "one serving more operations per second to the one serving fewer.");
+TAG_FLAG(load_balancer_prefer_less_busy_tservers, advanced);
+TAG_FLAG(load_balancer_prefer_less_busy_tservers, runtime);
+
 DEFINE_int32(load_balancer_num_idle_runs,
              5,
              "Number of idle runs of load balancer to deem it idle.");
@@ -48,6 +48,8 @@ DECLARE_int32(load_balancer_max_concurrent_removals);
 
 DECLARE_int32(load_balancer_max_concurrent_moves);
 
+DECLARE_bool(load_balancer_prefer_less_busy_tservers);
+
 namespace yb {
 namespace master {
 
@@ -146,6 +148,10 @@ struct CBTabletServerMetadata {
 
   // The set of tablet leader ids that this tablet server is currently running.
   std::set<TabletId> leaders;
+
+  // Read and write operations per second served by this tablet server, from its last heartbeat.
+  // Captured once per run, so the sort order does not change while the metrics are updated.
+  double ops_per_sec = 0;
 };
 
 struct Options {
@@ -194,11 +200,17 @@ class ClusterLoadState {
   bool CompareByUuid(const TabletServerId& a, const TabletServerId& b) {
     int load_a = GetLoad(a);
     int load_b = GetLoad(b);
-    if (load_a == load_b) {
-      return a < b;
-    } else {
+    if (load_a != load_b) {
       return load_a < load_b;
     }
+    if (FLAGS_load_balancer_prefer_less_busy_tservers) {
+      auto ops_a = GetOpsLoad(a);
+      auto ops_b = GetOpsLoad(b);
+      if (ops_a != ops_b) {
+        return ops_a < ops_b;
+      }
+    }
+    return a < b;
   }
 
   bool CompareByReplica(const TabletReplica& a, const TabletReplica& b) {
@@ -234,7 +246,14 @@ class ClusterLoadState {
       }
 
       // Secondary criteria: tserver leader load.
-      return state_->GetLeaderLoad(a) < state_->GetLeaderLoad(b);
+      auto leader_load_a = state_->GetLeaderLoad(a);
+      auto leader_load_b = state_->GetLeaderLoad(b);
+      if (leader_load_a != leader_load_b || !FLAGS_load_balancer_prefer_less_busy_tservers) {
+        return leader_load_a < leader_load_b;
+      }
+
+      // Tertiary criteria: operations served by tserver.
+      return state_->GetOpsLoad(a) < state_->GetOpsLoad(b);
     }
     ClusterLoadState* state_;
   };
@@ -250,6 +269,11 @@ class ClusterLoadState {
     return per_ts_meta_.at(ts_uuid).leaders.size();
   }
 
+  // Get the operations per second served by a certain TS.
+  double GetOpsLoad(const TabletServerId& ts_uuid) const {
+    return per_ts_meta_.at(ts_uuid).ops_per_sec;
+  }
+
   void SetBlacklist(const BlacklistPB& blacklist) { blacklist_ = blacklist; }
   void SetLeaderBlacklist(const BlacklistPB& leader_blacklist) {
     leader_blacklist_ = leader_blacklist;
@@ -402,6 +426,7 @@ class ClusterLoadState {
     // tablet servers that happen to not be serving any tablets, so were not in the map yet.
     auto& ts_meta = per_ts_meta_[ts_uuid];
     ts_meta.descriptor = ts_desc;
+    ts_meta.ops_per_sec = ts_desc->read_ops_per_sec() + ts_desc->write_ops_per_sec();
 
     sorted_load_.push_back(ts_uuid);
 
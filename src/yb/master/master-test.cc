@@ -223,6 +223,15 @@ TEST_F(MasterTest, TestRegisterAndHeartbeat) {
   ASSERT_TRUE(mini_master_->master()->ts_manager()->LookupTSByUUID(kTsUUID, &ts_desc));
   ASSERT_EQ(ts_desc, descs[0]);
 
+  // Tablet locations describe the tablet server using its registration.
+  {
+    auto ts_info = ts_desc->GetTSInfoPB();
+    ASSERT_EQ(kTsUUID, ts_info->permanent_uuid());
+    ASSERT_EQ(1, ts_info->private_rpc_addresses_size());
+    ASSERT_EQ(fake_reg.common().private_rpc_addresses(0).ShortDebugString(),
+              ts_info->private_rpc_addresses(0).ShortDebugString());
+  }
+
   // If the tablet server somehow lost the response to its registration RPC, it would
   // attempt to register again. In that case, we shouldn't reject it -- we should
   // just respond the same.
@@ -237,7 +246,8 @@ TEST_F(MasterTest, TestRegisterAndHeartbeat) {
     ASSERT_TRUE(resp.needs_full_tablet_report());
   }
 
-  // Now send a tablet report
+  // Send the first part of a full tablet report, that does not fit into a single heartbeat.
+  // The master should wait for the rest of it, instead of asking for a new full report.
   {
     TSHeartbeatRequestPB req;
     TSHeartbeatResponsePB resp;
@@ -245,10 +255,27 @@ TEST_F(MasterTest, TestRegisterAndHeartbeat) {
     TabletReportPB* tr = req.mutable_tablet_report();
     tr->set_is_incremental(false);
     tr->set_sequence_number(0);
+    tr->set_remaining_tablet_count(1);
+    ASSERT_OK(proxy_->TSHeartbeat(req, &resp, ResetAndGetController()));
+
+    ASSERT_FALSE(resp.needs_reregister());
+    ASSERT_FALSE(resp.needs_full_tablet_report());
+    ASSERT_FALSE(ts_desc->has_tablet_report());
+  }
+
+  // Now send a tablet report
+  {
+    TSHeartbeatRequestPB req;
+    TSHeartbeatResponsePB resp;
+    req.mutable_common()->CopyFrom(common);
+    TabletReportPB* tr = req.mutable_tablet_report();
+    tr->set_is_incremental(false);
+    tr->set_sequence_number(1);
     ASSERT_OK(proxy_->TSHeartbeat(req, &resp, ResetAndGetController()));
 
     ASSERT_FALSE(resp.needs_reregister());
     ASSERT_FALSE(resp.needs_full_tablet_report());
+    ASSERT_TRUE(ts_desc->has_tablet_report());
   }
 
   descs.clear();
@@ -192,7 +192,10 @@ void MasterServiceImpl::TSHeartbeat(const TSHeartbeatRequestPB* req,
     }
   }
 
-  if (!ts_desc->has_tablet_report()) {
+  // Do not restart a full report, that is being sent in several heartbeats.
+  if (!ts_desc->has_tablet_report() &&
+      !(req->has_tablet_report() && !req->tablet_report().is_incremental() &&
+        req->tablet_report().remaining_tablet_count() > 0)) {
     resp->set_needs_full_tablet_report(true);
   }
 
@@ -363,6 +366,13 @@ void MasterServiceImpl::GetYsqlCatalogConfig(const GetYsqlCatalogConfigRequestPB
   HandleIn(req, resp, &rpc, &CatalogManager::GetYsqlCatalogConfig);
 }
 
+void MasterServiceImpl::IncrementYsqlCatalogVersion(
+    const IncrementYsqlCatalogVersionRequestPB* req,
+    IncrementYsqlCatalogVersionResponsePB* resp,
+    rpc::RpcContext rpc) {
+  HandleIn(req, resp, &rpc, &CatalogManager::IncrementYsqlCatalogVersion);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Permissions
 // ------------------------------------------------------------------------------------------------
@@ -115,6 +115,10 @@ class MasterServiceImpl : public MasterServiceIf,
                             GetYsqlCatalogConfigResponsePB* resp,
                             rpc::RpcContext rpc) override;
 
+  void IncrementYsqlCatalogVersion(const IncrementYsqlCatalogVersionRequestPB* req,
+                                   IncrementYsqlCatalogVersionResponsePB* resp,
+                                   rpc::RpcContext rpc) override;
+
   void CreateRole(const CreateRoleRequestPB* req,
                   CreateRoleResponsePB* resp,
                   rpc::RpcContext rpc) override;
@@ -86,5 +86,11 @@ uint64_t MasterTabletServer::ysql_catalog_version() const {
   return master_->catalog_manager()->GetYsqlCatalogVersion();
 }
 
+const std::shared_ptr<tserver::TabletServerServiceProxy>& MasterTabletServer::proxy() const {
+  // Master does not dispatch requests to its own tablet server service.
+  static const std::shared_ptr<tserver::TabletServerServiceProxy> kNullProxy;
+  return kNullProxy;
+}
+
 } // namespace master
 } // namespace yb
@@ -58,6 +58,8 @@ class MasterTabletServer : public tserver::TabletServerIf,
     return nullptr;
   }
 
+  const std::shared_ptr<tserver::TabletServerServiceProxy>& proxy() const override;
+
  private:
   Master* master_ = nullptr;
   scoped_refptr<MetricEntity> metric_entity_;
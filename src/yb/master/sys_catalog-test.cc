@@ -34,6 +34,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <thread>
 #include <vector>
 
 #include "yb/gutil/stl_util.h"
@@ -50,6 +51,8 @@ using yb::rpc::MessengerBuilder;
 using yb::rpc::RpcController;
 
 DECLARE_string(cluster_uuid);
+DECLARE_int64(sys_catalog_group_commit_max_bytes);
+DECLARE_int32(sys_catalog_group_commit_max_ops);
 
 namespace yb {
 namespace master {
@@ -183,6 +186,104 @@ TEST_F(SysCatalogTest, TestSysCatalogTablesOperations) {
   ASSERT_EQ(kNumSystemTables, loader->tables.size());
 }
 
+namespace {
+
+// Adds tables from concurrent threads and checks that all of them are persisted.
+void AddTablesConcurrently(Master* master) {
+  constexpr int kNumThreads = 8;
+  constexpr int kTablesPerThread = 10;
+  SysCatalogTable* sys_catalog = master->catalog_manager()->sys_catalog();
+
+  std::vector<std::thread> threads;
+  std::vector<Status> statuses(kNumThreads);
+  for (int i = 0; i != kNumThreads; ++i) {
+    threads.emplace_back([master, sys_catalog, i, &statuses] {
+      for (int j = 0; j != kTablesPerThread && statuses[i].ok(); ++j) {
+        scoped_refptr<TableInfo> table = master->catalog_manager()->NewTableInfo(
+            Format("table_$0_$1", i, j));
+        auto l = table->LockForWrite();
+        l->mutable_data()->pb.set_name(table->id());
+        l->mutable_data()->pb.set_state(SysTablesEntryPB::PREPARING);
+        SchemaToPB(Schema(), l->mutable_data()->pb.mutable_schema());
+        statuses[i] = sys_catalog->AddItem(table.get(), kLeaderTerm);
+        l->Commit();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto& status : statuses) {
+    ASSERT_OK(status);
+  }
+
+  TestTableLoader loader;
+  ASSERT_OK(sys_catalog->Visit(&loader));
+  ASSERT_EQ(kNumThreads * kTablesPerThread + kNumSystemTables, loader.tables.size());
+}
+
+} // namespace
+
+// Verify that concurrent writes, that are group committed, are all persisted.
+TEST_F(SysCatalogTest, TestConcurrentTablesOperations) {
+  AddTablesConcurrently(master_);
+}
+
+// Verify that concurrent writes are all persisted when groups are limited by the number of rows.
+TEST_F(SysCatalogTest, TestConcurrentTablesOperationsMaxOps) {
+  FLAGS_sys_catalog_group_commit_max_ops = 3;
+  AddTablesConcurrently(master_);
+}
+
+// Verify that concurrent writes are all persisted when each of them exceeds the group size limit.
+TEST_F(SysCatalogTest, TestConcurrentTablesOperationsMaxBytes) {
+  FLAGS_sys_catalog_group_commit_max_bytes = 1;
+  AddTablesConcurrently(master_);
+}
+
+// Verify that writes to the sys catalog are attributed to the leader by the term of the applied
+// operations, including concurrent writes that are applied in a single batch.
+TEST_F(SysCatalogTest, TestChangedOnlyByOwnWrites) {
+  constexpr int kNumThreads = 4;
+  constexpr int kTablesPerThread = 10;
+  SysCatalogTable* sys_catalog = master_->catalog_manager()->sys_catalog();
+  const auto loaded_state = sys_catalog->GetLoadedState(kLeaderTerm);
+
+  std::vector<std::thread> threads;
+  std::vector<Status> statuses(kNumThreads);
+  for (int i = 0; i != kNumThreads; ++i) {
+    threads.emplace_back([this, sys_catalog, i, &statuses] {
+      for (int j = 0; j != kTablesPerThread && statuses[i].ok(); ++j) {
+        scoped_refptr<TableInfo> table = master_->catalog_manager()->NewTableInfo(
+            Format("own_table_$0_$1", i, j));
+        auto l = table->LockForWrite();
+        l->mutable_data()->pb.set_name(table->id());
+        l->mutable_data()->pb.set_state(SysTablesEntryPB::PREPARING);
+        SchemaToPB(Schema(), l->mutable_data()->pb.mutable_schema());
+        statuses[i] = sys_catalog->AddItem(table.get(), kLeaderTerm);
+        l->Commit();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto& status : statuses) {
+    ASSERT_OK(status);
+  }
+
+  // All writes were made in the term, in which the catalog was loaded.
+  ASSERT_TRUE(sys_catalog->ChangedOnlyByOwnWrites(loaded_state, kLeaderTerm + 1));
+  ASSERT_TRUE(sys_catalog->ChangedOnlyByOwnWrites(loaded_state, kLeaderTerm));
+
+  // If the catalog was loaded by the leader of an earlier term, writes of kLeaderTerm were made by
+  // another leader.
+  const auto earlier_state = sys_catalog->GetLoadedState(kLeaderTerm - 1);
+  ASSERT_FALSE(sys_catalog->ChangedOnlyByOwnWrites(earlier_state, kLeaderTerm + 1));
+  // Writes of the term, in which the check is performed, are not attributed to other leaders.
+  ASSERT_TRUE(sys_catalog->ChangedOnlyByOwnWrites(earlier_state, kLeaderTerm));
+}
+
 // Verify that data mutations are not available from metadata() until commit.
 TEST_F(SysCatalogTest, TestTableInfoCommit) {
   scoped_refptr<TableInfo> table(master_->catalog_manager()->NewTableInfo("123"));
@@ -32,6 +32,7 @@
 
 #include "yb/master/sys_catalog.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include <gflags/gflags.h>
@@ -74,6 +75,7 @@
 #include "yb/util/threadpool.h"
 
 using namespace std::literals; // NOLINT
+using namespace yb::size_literals;
 
 using std::shared_ptr;
 using std::unique_ptr;
@@ -105,6 +107,23 @@ METRIC_DEFINE_histogram(
   "Microseconds spent resolving DNS requests during SysCatalogTable::SetupConfig",
   60000000LU, 2);
 
+DEFINE_bool(sys_catalog_group_commit, true,
+            "Combine concurrent sys catalog writes into a single Raft operation.");
+TAG_FLAG(sys_catalog_group_commit, advanced);
+TAG_FLAG(sys_catalog_group_commit, runtime);
+
+DEFINE_int32(sys_catalog_group_commit_max_ops, 1000,
+             "Maximal number of rows in a group committed sys catalog write. A single write with "
+             "more rows is still written on its own.");
+TAG_FLAG(sys_catalog_group_commit_max_ops, advanced);
+TAG_FLAG(sys_catalog_group_commit_max_ops, runtime);
+
+DEFINE_int64(sys_catalog_group_commit_max_bytes, 4_MB,
+             "Maximal size of the requests combined into a group committed sys catalog write. A "
+             "single larger write is still written on its own.");
+TAG_FLAG(sys_catalog_group_commit_max_bytes, advanced);
+TAG_FLAG(sys_catalog_group_commit_max_bytes, runtime);
+
 DECLARE_int32(master_discovery_timeout_ms);
 
 namespace yb {
@@ -524,7 +543,9 @@ Status SysCatalogTable::OpenTablet(const scoped_refptr<tablet::RaftGroupMetadata
           tablet->GetMetricEntity(),
           raft_pool(),
           tablet_prepare_pool(),
-          nullptr /* retryable_requests */),
+          nullptr /* retryable_requests */,
+          nullptr /* multi_raft_manager */,
+          nullptr /* final_status_cache */),
       "Failed to Init() TabletPeer");
 
   RETURN_NOT_OK_PREPEND(tablet_peer()->Start(consensus_info),
@@ -566,8 +587,14 @@ Status SysCatalogTable::WaitUntilRunning() {
   return Status::OK();
 }
 
+struct SysCatalogTable::PendingWrite {
+  SysCatalogWriter* writer;
+  size_t bytes;
+  Status status;
+  bool done = false;
+};
+
 CHECKED_STATUS SysCatalogTable::SyncWrite(SysCatalogWriter* writer) {
-  auto resp = std::make_shared<tserver::WriteResponsePB>();
   // If this is a PG write, them the pgsql write batch is not empty.
   //
   // If this is a QL write, then it is a normal sys_catalog write, so ignore writes that might
@@ -577,15 +604,103 @@ CHECKED_STATUS SysCatalogTable::SyncWrite(SysCatalogWriter* writer) {
     return Status::OK();
   }
 
-  auto latch = std::make_shared<CountDownLatch>(1);
-  auto operation_state = std::make_unique<tablet::WriteOperationState>(
-      tablet_peer()->tablet(), &writer->req(), resp.get());
-  operation_state->set_completion_callback(
-      tablet::MakeLatchOperationCompletionCallback(latch, resp));
+  // PG writes are rare batch copies, so they are not combined with other writes.
+  if (!FLAGS_sys_catalog_group_commit || !writer->req().pgsql_write_batch().empty()) {
+    WriteResponsePB resp;
+    return DoSyncWrite(writer->req(), writer->leader_term(), &resp);
+  }
 
-  tablet_peer()->WriteAsync(
-      std::move(operation_state), writer->leader_term(), CoarseTimePoint::max() /* deadline */);
+  PendingWrite pending_write{writer, writer->req().ByteSizeLong()};
+  std::unique_lock<std::mutex> lock(pending_writes_mutex_);
+  pending_writes_.push_back(&pending_write);
+  while (!pending_write.done) {
+    if (group_write_in_progress_) {
+      pending_writes_cond_.wait(lock);
+      continue;
+    }
+    // Take queued writes of the same term as the oldest one, writes of other terms are left for
+    // the next group, since the term is checked for the whole operation. Writes that would make
+    // the group exceed the limits on rows and bytes are left for the next group as well.
+    const auto leader_term = pending_writes_.front()->writer->leader_term();
+    const size_t max_ops = std::max(FLAGS_sys_catalog_group_commit_max_ops, 1);
+    const size_t max_bytes = std::max<int64_t>(FLAGS_sys_catalog_group_commit_max_bytes, 1);
+    std::vector<PendingWrite*> group;
+    size_t group_ops = 0;
+    size_t group_bytes = 0;
+    auto left = pending_writes_.begin();
+    for (auto* write : pending_writes_) {
+      const size_t ops = write->writer->req().ql_write_batch_size();
+      if (write->writer->leader_term() == leader_term &&
+          (group.empty() ||
+           (group_ops + ops <= max_ops && group_bytes + write->bytes <= max_bytes))) {
+        group.push_back(write);
+        group_ops += ops;
+        group_bytes += write->bytes;
+      } else {
+        *left++ = write;
+      }
+    }
+    pending_writes_.erase(left, pending_writes_.end());
+    group_write_in_progress_ = true;
+    lock.unlock();
+
+    GroupWrite(group);
+
+    lock.lock();
+    for (auto* write : group) {
+      write->done = true;
+    }
+    group_write_in_progress_ = false;
+    pending_writes_cond_.notify_all();
+  }
+  return pending_write.status;
+}
+
+void SysCatalogTable::GroupWrite(const std::vector<PendingWrite*>& writes) {
+  const auto leader_term = writes.front()->writer->leader_term();
+  WriteResponsePB resp;
+  if (writes.size() == 1) {
+    writes.front()->status = DoSyncWrite(writes.front()->writer->req(), leader_term, &resp);
+    return;
+  }
+
+  WriteRequestPB req;
+  req.set_tablet_id(writes.front()->writer->req().tablet_id());
+  // Index of the first row of each write in the combined batch, used to route per row errors.
+  std::vector<int> first_row;
+  first_row.reserve(writes.size());
+  for (auto* write : writes) {
+    first_row.push_back(req.ql_write_batch_size());
+    req.mutable_ql_write_batch()->MergeFrom(write->writer->req().ql_write_batch());
+  }
+  VLOG_WITH_PREFIX(2) << "Group committing " << writes.size() << " writes with "
+                      << req.ql_write_batch_size() << " rows";
+
+  auto status = DoSyncWrite(req, leader_term, &resp);
+  if (resp.per_row_errors().empty()) {
+    for (auto* write : writes) {
+      write->status = status;
+    }
+    return;
+  }
+  for (const auto& error : resp.per_row_errors()) {
+    auto it = std::upper_bound(first_row.begin(), first_row.end(), error.row_index());
+    if (it == first_row.begin()) {
+      continue;
+    }
+    auto& write_status = writes[it - first_row.begin() - 1]->status;
+    if (write_status.ok()) {
+      write_status = STATUS(Corruption, "One or more rows failed to write");
+    }
+  }
+}
+
+namespace {
 
+// Waits for the write submitted by SysCatalogTable::DoSyncWrite to complete, and moves its
+// response to resp.
+CHECKED_STATUS WaitSyncWrite(
+    CountDownLatch* latch, WriteResponsePB* resp_holder, WriteResponsePB* resp) {
   {
     int num_iterations = 0;
     static constexpr auto kWarningInterval = 5s;
@@ -604,6 +719,7 @@ CHECKED_STATUS SysCatalogTable::SyncWrite(SysCatalogWriter* writer) {
     }
   }
 
+  resp->Swap(resp_holder);
   if (resp->has_error()) {
     return StatusFromPB(resp->error().status());
   }
@@ -616,6 +732,49 @@ CHECKED_STATUS SysCatalogTable::SyncWrite(SysCatalogWriter* writer) {
   return Status::OK();
 }
 
+} // namespace
+
+CHECKED_STATUS SysCatalogTable::DoSyncWrite(
+    const WriteRequestPB& req, int64_t leader_term, WriteResponsePB* resp) {
+  auto resp_holder = std::make_shared<WriteResponsePB>();
+  auto latch = std::make_shared<CountDownLatch>(1);
+  auto operation_state = std::make_unique<tablet::WriteOperationState>(
+      tablet_peer()->tablet(), &req, resp_holder.get());
+  operation_state->set_completion_callback(
+      tablet::MakeLatchOperationCompletionCallback(latch, resp_holder));
+
+  tablet_peer()->WriteAsync(
+      std::move(operation_state), leader_term, CoarseTimePoint::max() /* deadline */);
+
+  auto status = WaitSyncWrite(latch.get(), resp_holder.get(), resp);
+  if (!status.ok()) {
+    num_failed_writes_.fetch_add(1, std::memory_order_acq_rel);
+  }
+  return status;
+}
+
+SysCatalogLoadedState SysCatalogTable::GetLoadedState(int64_t term) const {
+  SysCatalogLoadedState result;
+  result.term = term;
+  result.db_generation = tablet_peer()->tablet()->regular_db_generation();
+  result.failed_writes = num_failed_writes_.load(std::memory_order_acquire);
+  return result;
+}
+
+bool SysCatalogTable::ChangedOnlyByOwnWrites(
+    const SysCatalogLoadedState& state, int64_t term) const {
+  auto* tablet = tablet_peer()->tablet();
+  if (tablet->regular_db_generation() != state.db_generation ||
+      num_failed_writes_.load(std::memory_order_acquire) != state.failed_writes) {
+    return false;
+  }
+  // This master was not the leader between state.term and term, so a write applied in any of
+  // those terms was made by another master. Writes of state.term are ours, and were reflected in
+  // memory when they succeeded. Writes of term were made before the catalog is loaded, so they
+  // are not writes of the catalog manager.
+  return tablet->LastRegularDbWriteBeforeTerm(term).term <= state.term;
+}
+
 // Schema for the unified SysCatalogTable:
 //
 // (entry_type, entry_id) -> metadata
@@ -32,6 +32,9 @@
 #ifndef YB_MASTER_SYS_CATALOG_H_
 #define YB_MASTER_SYS_CATALOG_H_
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -166,6 +169,16 @@ class SysCatalogTable {
   // Drop YSQL table by removing the table metadata in sys-catalog.
   CHECKED_STATUS DeleteYsqlSystemTable(const string& table_id);
 
+  // Returns the state of the sys catalog data, that should be taken right after the leader of
+  // `term` loaded it into memory.
+  SysCatalogLoadedState GetLoadedState(int64_t term) const;
+
+  // Returns true if, since `state` was taken, the sys catalog data was changed only by successful
+  // writes of this master as the leader of state.term, so the in-memory state loaded at that
+  // moment still matches the data when this master becomes the leader of `term`. Writes of other
+  // masters are detected by the terms of the applied Raft operations.
+  bool ChangedOnlyByOwnWrites(const SysCatalogLoadedState& state, int64_t term) const;
+
  private:
   friend class CatalogManager;
 
@@ -178,8 +191,21 @@ class SysCatalogTable {
   Schema BuildTableSchema();
 
   // Returns 'Status::OK()' if the WriteTranasction completed
+  //
+  // Concurrent calls are group committed: the first caller that finds no write in flight submits
+  // the QL batches of all queued writers with the same leader term as a single Raft operation, and
+  // reports the result to each of them.
   CHECKED_STATUS SyncWrite(SysCatalogWriter* writer);
 
+  struct PendingWrite;
+
+  // Submits the batches of writes as a single write operation and fills their statuses.
+  void GroupWrite(const std::vector<PendingWrite*>& writes);
+
+  // Submits req to the tablet peer and waits for its completion.
+  CHECKED_STATUS DoSyncWrite(
+      const tserver::WriteRequestPB& req, int64_t leader_term, tserver::WriteResponsePB* resp);
+
   void SysCatalogStateChanged(const std::string& tablet_id,
                               std::shared_ptr<consensus::StateChangeContext> context);
 
@@ -248,6 +274,16 @@ class SysCatalogTable {
 
   std::unordered_map<std::string, scoped_refptr<AtomicGauge<uint64>>> visitor_duration_metrics_;
 
+  // Writes waiting to be group committed by SyncWrite.
+  std::mutex pending_writes_mutex_;
+  std::condition_variable pending_writes_cond_;
+  std::vector<PendingWrite*> pending_writes_;
+  bool group_write_in_progress_ = false;
+
+  // Number of sys catalog write operations issued by this master that failed. Such a write could
+  // still be applied, while the in-memory state was not updated.
+  std::atomic<int64_t> num_failed_writes_{0};
+
   DISALLOW_COPY_AND_ASSIGN(SysCatalogTable);
 };
 
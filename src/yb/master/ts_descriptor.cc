@@ -41,6 +41,7 @@
 #include "yb/consensus/consensus.proxy.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/master/master.pb.h"
+#include "yb/master/master_util.h"
 #include "yb/tserver/tserver_admin.proxy.h"
 #include "yb/tserver/tserver_service.proxy.h"
 #include "yb/util/net/net_util.h"
@@ -112,6 +113,13 @@ Status TSDescriptor::RegisterUnlocked(
   ts_information_->mutable_tserver_instance()->set_permanent_uuid(permanent_uuid_);
   ts_information_->mutable_tserver_instance()->set_instance_seqno(latest_seqno);
 
+  auto ts_info = std::make_shared<TSInfoPB>();
+  ts_info->set_permanent_uuid(permanent_uuid_);
+  CopyRegistration(registration.common(), ts_info.get());
+  ts_info->set_placement_uuid(registration.common().placement_uuid());
+  *ts_info->mutable_capabilities() = registration.capabilities();
+  ts_info_ = std::move(ts_info);
+
   placement_id_ = generate_placement_id(registration.common().cloud_info());
 
   proxies_.reset();
@@ -207,6 +215,12 @@ const std::shared_ptr<TSInformationPB> TSDescriptor::GetTSInformationPB() const
   return ts_information_;
 }
 
+std::shared_ptr<const TSInfoPB> TSDescriptor::GetTSInfoPB() const {
+  SharedLock<decltype(lock_)> l(lock_);
+  CHECK(ts_info_) << "No stored information";
+  return ts_info_;
+}
+
 bool TSDescriptor::MatchesCloudInfo(const CloudInfoPB& cloud_info) const {
   SharedLock<decltype(lock_)> l(lock_);
   const auto& ci = ts_information_->registration().common().cloud_info();
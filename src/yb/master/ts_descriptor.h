@@ -117,6 +117,11 @@ class TSDescriptor {
   // Returns TSInformationPB for this TSDescriptor.
   const std::shared_ptr<TSInformationPB> GetTSInformationPB() const;
 
+  // Returns TSInfoPB, that describes this tablet server in tablet locations. It is built once per
+  // registration, so building tablet locations does not have to convert the registration for
+  // every replica.
+  std::shared_ptr<const TSInfoPB> GetTSInfoPB() const;
+
   // Helper function to tell if this TS matches the cloud information provided. For now, we have
   // no wildcard functionality, so it will have to explicitly match each individual component.
   // Later, this might be extended to say if this TS is part of some wildcard expression for cloud
@@ -339,6 +344,7 @@ class TSDescriptor {
   int leader_count_;
 
   std::shared_ptr<TSInformationPB> ts_information_;
+  std::shared_ptr<const TSInfoPB> ts_info_;
   std::string placement_id_;
 
   // The (read replica) cluster uuid to which this tserver belongs.
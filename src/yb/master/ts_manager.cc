@@ -103,11 +103,27 @@ bool HasSameHostPort(const google::protobuf::RepeatedPtrField<HostPortPB>& old_a
   return false;
 }
 
+// Returns whether both lists contain the same addresses in the same order.
+bool HasSameHostPorts(const google::protobuf::RepeatedPtrField<HostPortPB>& old_addresses,
+                      const google::protobuf::RepeatedPtrField<HostPortPB>& new_addresses) {
+  if (old_addresses.size() != new_addresses.size()) {
+    return false;
+  }
+  for (int i = 0; i != old_addresses.size(); ++i) {
+    if (old_addresses.Get(i).host() != new_addresses.Get(i).host() ||
+        old_addresses.Get(i).port() != new_addresses.Get(i).port()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 Status TSManager::RegisterTS(const NodeInstancePB& instance,
                              const TSRegistrationPB& registration,
                              CloudInfoPB local_cloud_info,
                              rpc::ProxyCache* proxy_cache) {
   TSCountCallback callback_to_call;
+  TSAddressesChangedCallback addresses_changed_callback;
 
   {
     std::lock_guard<decltype(lock_)> l(lock_);
@@ -147,6 +163,15 @@ Status TSManager::RegisterTS(const NodeInstancePB& instance,
                 << " } with Master, full list: " << yb::ToString(servers_by_id_);
 
     } else {
+      const auto old_info = it->second->GetTSInformationPB();
+      const auto& old_common = old_info->registration().common();
+      if (!ts_addresses_changed_callback_.empty() &&
+          (!HasSameHostPorts(old_common.private_rpc_addresses(),
+                             registration.common().private_rpc_addresses()) ||
+           !HasSameHostPorts(old_common.broadcast_addresses(),
+                             registration.common().broadcast_addresses()))) {
+        addresses_changed_callback = ts_addresses_changed_callback_;
+      }
       RETURN_NOT_OK(it->second->Register(
           instance, registration, std::move(local_cloud_info), proxy_cache));
       LOG(INFO) << "Re-registered known tablet server { " << instance.ShortDebugString()
@@ -165,6 +190,9 @@ Status TSManager::RegisterTS(const NodeInstancePB& instance,
   if (!callback_to_call.empty()) {
     callback_to_call();
   }
+  if (!addresses_changed_callback.empty()) {
+    addresses_changed_callback(instance.permanent_uuid());
+  }
 
   return Status::OK();
 }
@@ -281,5 +309,10 @@ void TSManager::SetTSCountCallback(int min_count, TSCountCallback callback) {
   ts_count_callback_min_count_ = min_count;
 }
 
+void TSManager::SetTSAddressesChangedCallback(TSAddressesChangedCallback callback) {
+  std::lock_guard<rw_spinlock> l(lock_);
+  ts_addresses_changed_callback_ = std::move(callback);
+}
+
 } // namespace master
 } // namespace yb
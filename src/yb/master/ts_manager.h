@@ -67,6 +67,9 @@ typedef std::unordered_set<HostPort, HostPortHash> BlacklistSet;
 // A callback that is called when the number of tablet servers reaches a certain number.
 typedef boost::function<void()> TSCountCallback;
 
+// A callback that is called when a known tablet server re-registers with other addresses.
+typedef boost::function<void(const TabletServerId&)> TSAddressesChangedCallback;
+
 // Tracks the servers that the master has heard from, along with their
 // last heartbeat, etc.
 //
@@ -142,6 +145,10 @@ class TSManager {
   // The callback is removed after it is called once.
   void SetTSCountCallback(int min_count, TSCountCallback callback);
 
+  // Register a callback to be called when a known tablet server re-registers with other RPC or
+  // broadcast addresses.
+  void SetTSAddressesChangedCallback(TSAddressesChangedCallback callback);
+
  private:
 
   void GetDescriptors(std::function<bool(const TSDescriptorPtr&)> condition,
@@ -158,6 +165,8 @@ class TSManager {
   TSCountCallback ts_count_callback_ GUARDED_BY(lock_);
   int ts_count_callback_min_count_ GUARDED_BY(lock_) = 0;
 
+  TSAddressesChangedCallback ts_addresses_changed_callback_ GUARDED_BY(lock_);
+
   DISALLOW_COPY_AND_ASSIGN(TSManager);
 };
 
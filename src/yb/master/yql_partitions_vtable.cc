@@ -61,64 +61,62 @@ Result<std::shared_ptr<QLRowBlock>> YQLPartitionsVTable::RetrieveData(
     return cache_;
   }
 
+  // When the set of tablets is the same, only locations of some tablets were changed, so rows of
+  // the other tablets could be reused.
+  const bool reuse_rows = FLAGS_use_cache_for_partitions_vtable &&
+                          new_tablets_version == cached_tablets_version_;
+  std::unordered_map<TabletId, TabletRow> new_tablet_rows;
+  size_t num_reused_rows = 0;
+
   auto vtable = std::make_shared<QLRowBlock>(schema_);
   std::vector<scoped_refptr<TableInfo> > tables;
   catalog_manager->GetAllTables(&tables, true /* includeOnlyRunningTables */);
   for (const scoped_refptr<TableInfo>& table : tables) {
+    // Skip non-YQL tables.
+    if (!CatalogManager::IsYcqlTable(*table)) {
+      continue;
+    }
+
     // Get namespace for table.
     NamespaceIdentifierPB nsId;
     nsId.set_id(table->namespace_id());
     scoped_refptr<NamespaceInfo> nsInfo;
     RETURN_NOT_OK(catalog_manager->FindNamespace(nsId, &nsInfo));
-
-    // Skip non-YQL tables.
-    if (!CatalogManager::IsYcqlTable(*table)) {
-      continue;
-    }
+    const auto namespace_name = nsInfo->name();
+    const auto table_name = table->name();
 
     // Get tablets for table.
     std::vector<scoped_refptr<TabletInfo> > tablets;
     table->GetAllTablets(&tablets);
     for (const scoped_refptr<TabletInfo>& tablet : tablets) {
-      TabletLocationsPB tabletLocationsPB;
-      Status s = catalog_manager->GetTabletLocations(tablet->id(), &tabletLocationsPB);
-      // Skip not-found tablets: they might not be running yet or have been deleted.
-      if (!s.ok()) {
-        continue;
+      // Version is read before locations, so concurrent update would be picked by next rebuild.
+      const auto locations_version = tablet->replica_locations_version();
+      if (reuse_rows) {
+        auto it = tablet_rows_.find(tablet->id());
+        if (it != tablet_rows_.end() &&
+            it->second.replica_locations_version == locations_version &&
+            it->second.namespace_name == namespace_name && it->second.table_name == table_name) {
+          RETURN_NOT_OK(vtable->AddRow(it->second.row));
+          new_tablet_rows.emplace(tablet->id(), std::move(it->second));
+          ++num_reused_rows;
+          continue;
+        }
       }
 
       QLRow& row = vtable->Extend();
-      RETURN_NOT_OK(SetColumnValue(kKeyspaceName, nsInfo->name(), &row));
-      RETURN_NOT_OK(SetColumnValue(kTableName, table->name(), &row));
-
-      const PartitionPB& partition = tabletLocationsPB.partition();
-      RETURN_NOT_OK(SetColumnValue(kStartKey, partition.partition_key_start(), &row));
-      RETURN_NOT_OK(SetColumnValue(kEndKey, partition.partition_key_end(), &row));
-
-      // Note: tablet id is in host byte order.
-      Uuid uuid;
-      RETURN_NOT_OK(uuid.FromHexString(tablet->id()));
-      RETURN_NOT_OK(SetColumnValue(kId, uuid, &row));
-
-      // Get replicas for tablet.
-      QLValuePB replica_addresses;
-      QLMapValuePB *map_value = replica_addresses.mutable_map_value();
-      for (const auto& replica : tabletLocationsPB.replicas()) {
-        InetAddress addr;
-        RETURN_NOT_OK(addr.FromString(DesiredHostPort(replica.ts_info(), CloudInfoPB()).host()));
-        QLValue elem_key;
-        elem_key.set_inetaddress_value(addr);
-        *map_value->add_keys() = elem_key.value();
-
-        const string& role = consensus::RaftPeerPB::Role_Name(replica.role());
-        QLValue elem_value;
-        elem_value.set_string_value(role);
-        *map_value->add_values() = elem_value.value();
+      // Skip not-found tablets: they might not be running yet or have been deleted.
+      if (!VERIFY_RESULT(BuildTabletRow(namespace_name, *table, *tablet, &row))) {
+        vtable->rows().pop_back();
+        continue;
       }
-      RETURN_NOT_OK(SetColumnValue(kReplicaAddresses, replica_addresses, &row));
+      new_tablet_rows.emplace(
+          tablet->id(), TabletRow{locations_version, namespace_name, table_name, row});
     }
   }
 
+  VLOG(2) << "Rebuilt system.partitions, reused " << num_reused_rows << " of "
+          << vtable->row_count() << " rows";
+
   if (new_tablets_version == catalog_manager->tablets_version() &&
       new_tablet_locations_version == catalog_manager->tablet_locations_version()) {
     // Versions were not changed during calculating result, so could update cache for those
@@ -126,11 +124,52 @@ Result<std::shared_ptr<QLRowBlock>> YQLPartitionsVTable::RetrieveData(
     cached_tablets_version_ = new_tablets_version;
     cached_tablet_locations_version_ = new_tablet_locations_version;
     cache_ = vtable;
+    tablet_rows_ = std::move(new_tablet_rows);
   }
 
   return vtable;
 }
 
+Result<bool> YQLPartitionsVTable::BuildTabletRow(
+    const std::string& namespace_name, const TableInfo& table, const TabletInfo& tablet,
+    QLRow* row) const {
+  TabletLocationsPB tabletLocationsPB;
+  Status s = master_->catalog_manager()->GetTabletLocations(tablet.id(), &tabletLocationsPB);
+  if (!s.ok()) {
+    return false;
+  }
+
+  RETURN_NOT_OK(SetColumnValue(kKeyspaceName, namespace_name, row));
+  RETURN_NOT_OK(SetColumnValue(kTableName, table.name(), row));
+
+  const PartitionPB& partition = tabletLocationsPB.partition();
+  RETURN_NOT_OK(SetColumnValue(kStartKey, partition.partition_key_start(), row));
+  RETURN_NOT_OK(SetColumnValue(kEndKey, partition.partition_key_end(), row));
+
+  // Note: tablet id is in host byte order.
+  Uuid uuid;
+  RETURN_NOT_OK(uuid.FromHexString(tablet.id()));
+  RETURN_NOT_OK(SetColumnValue(kId, uuid, row));
+
+  // Get replicas for tablet.
+  QLValuePB replica_addresses;
+  QLMapValuePB *map_value = replica_addresses.mutable_map_value();
+  for (const auto& replica : tabletLocationsPB.replicas()) {
+    InetAddress addr;
+    RETURN_NOT_OK(addr.FromString(DesiredHostPort(replica.ts_info(), CloudInfoPB()).host()));
+    QLValue elem_key;
+    elem_key.set_inetaddress_value(addr);
+    *map_value->add_keys() = elem_key.value();
+
+    const string& role = consensus::RaftPeerPB::Role_Name(replica.role());
+    QLValue elem_value;
+    elem_value.set_string_value(role);
+    *map_value->add_values() = elem_value.value();
+  }
+  RETURN_NOT_OK(SetColumnValue(kReplicaAddresses, replica_addresses, row));
+  return true;
+}
+
 Schema YQLPartitionsVTable::CreateSchema() const {
   SchemaBuilder builder;
   CHECK_OK(builder.AddHashKeyColumn(kKeyspaceName, QLType::Create(DataType::STRING)));
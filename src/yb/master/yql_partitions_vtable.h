@@ -14,12 +14,17 @@
 #ifndef YB_MASTER_YQL_PARTITIONS_VTABLE_H
 #define YB_MASTER_YQL_PARTITIONS_VTABLE_H
 
+#include <unordered_map>
+
 #include "yb/master/master.h"
 #include "yb/master/yql_virtual_table.h"
 
 namespace yb {
 namespace master {
 
+class TableInfo;
+class TabletInfo;
+
 // VTable implementation of system.partitions.
 class YQLPartitionsVTable : public YQLVirtualTable {
  public:
@@ -28,10 +33,25 @@ class YQLPartitionsVTable : public YQLVirtualTable {
  protected:
   Schema CreateSchema() const;
 
+  // Row of a single tablet, kept between cache rebuilds, so only rows of tablets whose replica
+  // locations changed are recalculated.
+  struct TabletRow {
+    uint64_t replica_locations_version;
+    std::string namespace_name;
+    std::string table_name;
+    QLRow row;
+  };
+
+  // Fills the row of the specified tablet, returns false if the tablet locations are not
+  // available.
+  Result<bool> BuildTabletRow(const std::string& namespace_name, const TableInfo& table,
+                              const TabletInfo& tablet, QLRow* row) const;
+
   mutable boost::shared_mutex mutex_;
   mutable std::shared_ptr<QLRowBlock> cache_;
   mutable int cached_tablets_version_ = -1;
   mutable int cached_tablet_locations_version_ = -1;
+  mutable std::unordered_map<TabletId, TabletRow> tablet_rows_;
 };
 
 }  // namespace master
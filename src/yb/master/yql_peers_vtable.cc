@@ -19,6 +19,15 @@
 
 #include "yb/rpc/messenger.h"
 
+#include "yb/util/flag_tags.h"
+#include "yb/util/pb_util.h"
+
+DEFINE_int32(peers_vtable_resolve_cache_ms, 60000,
+             "For how long resolved addresses of tservers are reused by system.peers requests. "
+             "0 to resolve addresses on every request.");
+TAG_FLAG(peers_vtable_resolve_cache_ms, advanced);
+TAG_FLAG(peers_vtable_resolve_cache_ms, runtime);
+
 namespace yb {
 namespace master {
 
@@ -75,29 +84,48 @@ Result<std::shared_ptr<QLRowBlock>> PeersVTable::RetrieveData(
   std::vector<Entry> entries;
   entries.reserve(descs.size());
 
-  size_t index = 0;
-  for (const auto& desc : descs) {
-    size_t current_index = index++;
-
-    // This is thread safe since all operations are reads.
-    TSInformationPB ts_info = *desc->GetTSInformationPB();
-
-    if (!proxy_uuid.empty()) {
-      if (desc->permanent_uuid() == proxy_uuid) {
-        continue;
+  {
+    const auto now = CoarseMonoClock::Now();
+    const auto cache_duration = MonoDelta::FromMilliseconds(FLAGS_peers_vtable_resolve_cache_ms);
+    std::unordered_map<std::string, ResolvedPeer> resolved_peers;
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t index = 0;
+    for (const auto& desc : descs) {
+      size_t current_index = index++;
+
+      // This is thread safe since all operations are reads.
+      TSInformationPB ts_info = *desc->GetTSInformationPB();
+
+      // Addresses of all live tservers are resolved, including the requester, so cached
+      // resolution could be used by requests from any node. Only live tservers are kept in cache.
+      auto& resolved_peer = resolved_peers[desc->permanent_uuid()];
+      auto it = resolved_peers_.find(desc->permanent_uuid());
+      if (it != resolved_peers_.end() && now < it->second.resolve_started + cache_duration &&
+          pb_util::ArePBsEqual(it->second.ts_info, ts_info, /* diff_str */ nullptr)) {
+        resolved_peer = std::move(it->second);
+      } else {
+        resolved_peer.ts_info = ts_info;
+        resolved_peer.ts_ips = util::GetPublicPrivateIPFutures(ts_info, resolver_.get());
+        resolved_peer.resolve_started = now;
       }
-    } else {
-      // In case of old proxy, fallback to old endpoint based mechanism.
-      if (util::RemoteEndpointMatchesTServer(ts_info, remote_endpoint)) {
-        continue;
+
+      if (!proxy_uuid.empty()) {
+        if (desc->permanent_uuid() == proxy_uuid) {
+          continue;
+        }
+      } else {
+        // In case of old proxy, fallback to old endpoint based mechanism.
+        if (util::RemoteEndpointMatchesTServer(ts_info, remote_endpoint)) {
+          continue;
+        }
       }
-    }
 
-    entries.push_back({current_index, std::move(ts_info)});
-    auto& entry = entries.back();
-    entry.ts_ips = util::GetPublicPrivateIPFutures(entry.ts_info, resolver_.get());
+      entries.push_back({current_index, std::move(ts_info), resolved_peer.ts_ips});
+    }
+    resolved_peers_ = std::move(resolved_peers);
   }
 
+  std::vector<std::string> failed_peers;
   for (const auto& entry : entries) {
     // The system.peers table has one entry for each of its peers, whereas there is no entry for
     // the node that the CQL client connects to. In this case, this node is the 'remote_endpoint'
@@ -107,6 +135,7 @@ Result<std::shared_ptr<QLRowBlock>> PeersVTable::RetrieveData(
     if (!private_ip.ok()) {
       LOG(ERROR) << "Failed to get private ip from " << entry.ts_info.ShortDebugString()
                  << ": " << private_ip.status();
+      failed_peers.push_back(entry.ts_info.tserver_instance().permanent_uuid());
       continue;
     }
 
@@ -114,6 +143,7 @@ Result<std::shared_ptr<QLRowBlock>> PeersVTable::RetrieveData(
     if (!public_ip.ok()) {
       LOG(ERROR) << "Failed to get public ip from " << entry.ts_info.ShortDebugString()
                  << ": " << public_ip.status();
+      failed_peers.push_back(entry.ts_info.tserver_instance().permanent_uuid());
       continue;
     }
 
@@ -144,6 +174,14 @@ Result<std::shared_ptr<QLRowBlock>> PeersVTable::RetrieveData(
         kTokens, util::GetTokensValue(entry.index, descs.size()), &row));
   }
 
+  if (!failed_peers.empty()) {
+    // Failed resolutions are not cached, so they are retried by the next request.
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& uuid : failed_peers) {
+      resolved_peers_.erase(uuid);
+    }
+  }
+
   return vtable;
 }
 
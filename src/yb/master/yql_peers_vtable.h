@@ -14,8 +14,12 @@
 #ifndef YB_MASTER_YQL_PEERS_VTABLE_H
 #define YB_MASTER_YQL_PEERS_VTABLE_H
 
+#include <mutex>
+#include <unordered_map>
+
 #include "yb/master/yql_virtual_table.h"
 
+#include "yb/util/monotime.h"
 #include "yb/util/net/net_fwd.h"
 
 namespace yb {
@@ -30,7 +34,19 @@ class PeersVTable : public YQLVirtualTable {
  private:
   Schema CreateSchema() const;
 
+  // Resolution of tserver addresses, reused by following requests while the tserver registration
+  // is not changed and the result is not expired.
+  struct ResolvedPeer {
+    TSInformationPB ts_info;
+    util::PublicPrivateIPFutures ts_ips;
+    CoarseTimePoint resolve_started;
+  };
+
   std::unique_ptr<Resolver> resolver_;
+
+  mutable std::mutex mutex_;
+  // Resolved peers keyed by tserver uuid.
+  mutable std::unordered_map<std::string, ResolvedPeer> resolved_peers_;
 };
 
 }  // namespace master
@@ -34,6 +34,7 @@
 namespace rocksdb {
 
 class SliceTransform;
+struct TableProperties;
 
 // Context information of a compaction run
 struct CompactionFilterContext {
@@ -55,11 +56,17 @@ class CompactionFilter {
   struct Context {
     // Does this compaction run include all data files
     bool is_full_compaction;
+    // Does this compaction run include all data files that could contain older records for keys
+    // in its range, i.e. its output is the bottommost level for these keys.
+    bool is_bottommost_level = false;
     // Is this compaction requested by the client (true),
     // or is it occurring as an automatic compaction process
     bool is_manual_compaction;
     // Which column family this compaction is for.
     uint32_t column_family_id;
+    // Properties of all input files of this compaction, empty if properties of some of them
+    // could not be loaded.
+    std::vector<std::shared_ptr<const TableProperties>> input_table_properties;
   };
 
   virtual ~CompactionFilter() {}
@@ -146,6 +153,15 @@ class CompactionFilter {
   virtual const char* Name() const = 0;
 };
 
+// Information about SST file, that is used to decide whether it could be deleted without
+// compaction.
+struct FileExpirationInfo {
+  // Null if properties are not loaded.
+  const TableProperties* properties;
+  // Null if file does not have frontiers.
+  const UserFrontier* largest_frontier;
+};
+
 // Each compaction will create a new CompactionFilter allowing the
 // application to know about different compactions
 class CompactionFilterFactory {
@@ -155,6 +171,13 @@ class CompactionFilterFactory {
   virtual std::unique_ptr<CompactionFilter> CreateCompactionFilter(
       const CompactionFilter::Context& context) = 0;
 
+  // Invoked with all SST files of the column family, returns indexes of files whose entries would
+  // all be discarded by the compaction filter, and don't hide entries of other files, so they could
+  // be deleted without compaction. Invoked under the DB mutex, so should be cheap.
+  virtual std::vector<size_t> ExpiredFiles(const std::vector<FileExpirationInfo>& files) {
+    return {};
+  }
+
   // Returns a name that identifies this compaction filter factory.
   virtual const char* Name() const = 0;
 };
@@ -90,6 +90,12 @@ struct CompactionJobStats {
   // Time spent on preparing file write (falocate, etc)
   uint64_t file_prepare_write_nanos;
 
+  // Time spent on compression of output blocks.
+  uint64_t block_compress_nanos;
+
+  // Time spent on decompression of input blocks.
+  uint64_t block_decompress_nanos;
+
   // 0-terminated strings storing the first 8 bytes of the smallest and
   // largest key in the output.
   static const size_t kMaxPrefixLength = 8;
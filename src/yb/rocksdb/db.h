@@ -803,6 +803,12 @@ class DB {
   // rocksdb instance.
   virtual uint64_t GetCurrentVersionDataSstFilesSize() { return 0; }
 
+  // Returns approximate middle user key of the data in the SST files of the current version.
+  // Memtables are not taken into account.
+  virtual yb::Result<std::string> GetMiddleKey() {
+    return STATUS(NotSupported, "GetMiddleKey() not supported");
+  }
+
   // Returns number of memtables not flushed in default column family memtable list.
   virtual int GetCfdImmNumNotFlushed() { return 0; }
 
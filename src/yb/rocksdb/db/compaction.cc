@@ -35,6 +35,7 @@
 #include "yb/rocksdb/compaction_filter.h"
 #include "yb/rocksdb/db/column_family.h"
 #include "yb/rocksdb/db/version_set.h"
+#include "yb/rocksdb/table_properties.h"
 #include "yb/rocksdb/util/logging.h"
 #include "yb/rocksdb/util/sync_point.h"
 #include "yb/util/logging.h"
@@ -443,6 +444,21 @@ uint64_t Compaction::CalculateTotalInputSize() const {
   return size;
 }
 
+UserFrontierPtr Compaction::LargestInputFrontier(
+    const std::vector<CompactionInputFiles>& inputs) {
+  UserFrontierPtr largest;
+  for (const auto& level_inputs : inputs) {
+    for (const auto* file : level_inputs.files) {
+      if (!file->largest.user_frontier) {
+        return nullptr;
+      }
+      UserFrontier::Update(
+          file->largest.user_frontier.get(), UpdateUserValueType::kLargest, &largest);
+    }
+  }
+  return largest;
+}
+
 void Compaction::ReleaseCompactionFiles(Status status) {
   MarkFilesBeingCompacted(false);
   cfd_->compaction_picker()->ReleaseCompactionFiles(this, status);
@@ -527,8 +543,28 @@ std::unique_ptr<CompactionFilter> Compaction::CreateCompactionFilter() const {
 
   CompactionFilter::Context context;
   context.is_full_compaction = is_full_compaction_;
+  context.is_bottommost_level = bottommost_level_;
   context.is_manual_compaction = is_manual_compaction_;
   context.column_family_id = cfd_->GetID();
+  bool properties_loaded = true;
+  for (const auto& level_inputs : inputs_) {
+    for (const auto* file : level_inputs.files) {
+      std::shared_ptr<const TableProperties> properties;
+      auto status = input_version_->GetTableProperties(&properties, file);
+      if (!status.ok()) {
+        RLOG(InfoLogLevel::WARN_LEVEL, cfd_->ioptions()->info_log,
+             "Failed to load properties of compaction input file %" PRIu64 ": %s",
+             file->fd.GetNumber(), status.ToString().c_str());
+        properties_loaded = false;
+        break;
+      }
+      context.input_table_properties.push_back(std::move(properties));
+    }
+    if (!properties_loaded) {
+      context.input_table_properties.clear();
+      break;
+    }
+  }
   return cfd_->ioptions()->compaction_filter_factory->CreateCompactionFilter(
       context);
 }
@@ -544,7 +580,9 @@ bool Compaction::ShouldFormSubcompactions() const {
   if (cfd_->ioptions()->compaction_style == kCompactionStyleLevel) {
     return start_level_ == 0 && !IsOutputLevelEmpty();
   } else if (IsCompactionStyleUniversal()) {
-    return number_levels_ > 1 && output_level_ > 0;
+    // With a single level every sorted run is a level 0 file, so key-range partitioned outputs of
+    // subcompactions are not different from outputs split by max_file_size_for_compaction.
+    return number_levels_ == 1 || output_level_ > 0;
   } else {
     return false;
   }
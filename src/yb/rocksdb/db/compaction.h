@@ -265,6 +265,14 @@ class Compaction {
 
   uint64_t CalculateTotalInputSize() const;
 
+  // Returns the largest user frontier of the input files, or nullptr if some input file does not
+  // have one.
+  static UserFrontierPtr LargestInputFrontier(const std::vector<CompactionInputFiles>& inputs);
+
+  UserFrontierPtr LargestInputFrontier() const {
+    return LargestInputFrontier(inputs_);
+  }
+
   // In case of compaction error, reset the nextIndex that is used to pick up the next file to be
   // compacted from files_by_size_. Does nothing for universal compaction, since nextIndex is not
   // used in this case.
@@ -300,6 +308,10 @@ class Compaction {
   yb::PriorityThreadPoolSuspender* suspender() { return suspender_; }
   void SetSuspender(yb::PriorityThreadPoolSuspender* value) { suspender_ = value; }
 
+  // Priority of the thread pool task running this compaction, also used for its subcompactions.
+  int priority() const { return priority_.load(std::memory_order_acquire); }
+  void SetPriority(int value) { priority_.store(value, std::memory_order_release); }
+
  private:
   // mark (or clear) all files that are being compacted
   void MarkFilesBeingCompacted(bool mark_as_compacted);
@@ -379,6 +391,8 @@ class Compaction {
   CompactionReason compaction_reason_;
 
   yb::PriorityThreadPoolSuspender* suspender_ = nullptr;
+
+  std::atomic<int> priority_{0};
 };
 
 // Utility function
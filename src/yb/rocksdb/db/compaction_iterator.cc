@@ -21,16 +21,31 @@
 //
 
 #include "yb/rocksdb/db/compaction_iterator.h"
+
+#include <gflags/gflags.h>
+
 #include "yb/rocksdb/table/internal_iterator.h"
 
+#include "yb/util/priority_thread_pool.h"
+
+DECLARE_bool(allow_preempting_compactions);
+
 namespace rocksdb {
 
+namespace {
+
+// Number of input records between checks whether the compaction should be paused.
+constexpr uint64_t kPreemptionCheckInterval = 100;
+
+} // namespace
+
 CompactionIterator::CompactionIterator(
     InternalIterator* input, const Comparator* cmp, MergeHelper* merge_helper,
     SequenceNumber last_sequence, std::vector<SequenceNumber>* snapshots,
     SequenceNumber earliest_write_conflict_snapshot, Env* env,
     bool expect_valid_internal_key, Compaction* compaction,
-    CompactionFilter* compaction_filter, LogBuffer* log_buffer)
+    CompactionFilter* compaction_filter, LogBuffer* log_buffer,
+    yb::PriorityThreadPoolSuspender* suspender)
     : input_(input),
       cmp_(cmp),
       merge_helper_(merge_helper),
@@ -41,6 +56,7 @@ CompactionIterator::CompactionIterator(
       compaction_(compaction),
       compaction_filter_(compaction_filter),
       log_buffer_(log_buffer),
+      suspender_(suspender),
       merge_out_iter_(merge_helper_) {
   assert(compaction_filter_ == nullptr || compaction_ != nullptr);
   bottommost_level_ =
@@ -125,6 +141,12 @@ void CompactionIterator::NextFromInput() {
   valid_ = false;
 
   while (!valid_ && input_->Valid()) {
+    // Records dropped by the compaction never reach the output file writer, that also checks for
+    // preemption. So a compaction that drops a long run of records should be paused here.
+    if (suspender_ && iter_stats_.num_input_records % kPreemptionCheckInterval == 0 &&
+        FLAGS_allow_preempting_compactions) {
+      suspender_->PauseIfNecessary();
+    }
     key_ = input_->key();
     value_ = input_->value();
     iter_stats_.num_input_records++;
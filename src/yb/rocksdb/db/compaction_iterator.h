@@ -62,7 +62,8 @@ class CompactionIterator {
                      bool expect_valid_internal_key,
                      Compaction* compaction = nullptr,
                      CompactionFilter* compaction_filter = nullptr,
-                     LogBuffer* log_buffer = nullptr);
+                     LogBuffer* log_buffer = nullptr,
+                     yb::PriorityThreadPoolSuspender* suspender = nullptr);
 
   void ResetRecordCounts();
 
@@ -113,6 +114,8 @@ class CompactionIterator {
   Compaction* compaction_;
   CompactionFilter* compaction_filter_;
   LogBuffer* log_buffer_;
+  // Used to pause the compaction in favor of a task with higher priority, e.g. a flush.
+  yb::PriorityThreadPoolSuspender* suspender_;
   bool bottommost_level_;
   bool valid_ = false;
   SequenceNumber visible_at_tip_;
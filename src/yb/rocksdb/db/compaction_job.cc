@@ -35,6 +35,8 @@
 #include <list>
 #include <set>
 #include <thread>
+#include <condition_variable>
+#include <mutex>
 #include <utility>
 
 #include "yb/rocksdb/db/builder.h"
@@ -54,6 +56,7 @@
 #include "yb/rocksdb/port/port.h"
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/env.h"
+#include "yb/rocksdb/slice_transform.h"
 #include "yb/rocksdb/statistics.h"
 #include "yb/rocksdb/status.h"
 #include "yb/rocksdb/table.h"
@@ -62,6 +65,7 @@
 #include "yb/rocksdb/table/merger.h"
 #include "yb/rocksdb/table/table_builder.h"
 #include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/compression.h"
 #include "yb/rocksdb/util/file_reader_writer.h"
 #include "yb/rocksdb/util/log_buffer.h"
 #include "yb/rocksdb/util/logging.h"
@@ -72,6 +76,7 @@
 #include "yb/rocksdb/util/sync_point.h"
 #include "yb/rocksdb/util/thread_status_util.h"
 
+#include "yb/util/priority_thread_pool.h"
 #include "yb/util/stats/iostats_context_imp.h"
 #include "yb/util/string_util.h"
 
@@ -90,6 +95,9 @@ struct CompactionJob::SubcompactionState {
   // The return status of this subcompaction
   Status status;
 
+  // Suspender of the thread pool worker that runs this subcompaction, if any.
+  yb::PriorityThreadPoolSuspender* suspender = nullptr;
+
   // Files produced by this subcompaction
   struct Output {
     FileMetaData meta;
@@ -144,6 +152,7 @@ struct CompactionJob::SubcompactionState {
     start = std::move(o.start);
     end = std::move(o.end);
     status = std::move(o.status);
+    suspender = o.suspender;
     outputs = std::move(o.outputs);
     base_outfile = std::move(o.base_outfile);
     data_outfile = std::move(o.data_outfile);
@@ -334,6 +343,25 @@ void CompactionJob::Prepare() {
   // Is this compaction producing files at the bottommost level?
   bottommost_level_ = c->bottommost_level();
 
+  const auto* ioptions = c->column_family_data()->ioptions();
+  output_compression_ = c->output_compression();
+  output_compression_opts_ = ioptions->compression_opts;
+  // Compression could be disabled for this compaction, e.g. by compression_size_percent.
+  if (ioptions->compaction_compression_selector && output_compression_ != kNoCompression) {
+    (*ioptions->compaction_compression_selector)(
+        c->CalculateTotalInputSize(), c->LargestInputFrontier().get(), &output_compression_,
+        &output_compression_opts_);
+    if (!CompressionTypeSupported(output_compression_)) {
+      RLOG(InfoLogLevel::WARN_LEVEL, db_options_.info_log,
+           "[%s] Selected compaction output compression %s is not supported, using %s",
+           c->column_family_data()->GetName().c_str(),
+           CompressionTypeToString(output_compression_).c_str(),
+           CompressionTypeToString(c->output_compression()).c_str());
+      output_compression_ = c->output_compression();
+      output_compression_opts_ = ioptions->compression_opts;
+    }
+  }
+
   if (c->ShouldFormSubcompactions()) {
     const uint64_t start_micros = env_->NowMicros();
     GenSubcompactionBoundaries();
@@ -354,6 +382,69 @@ void CompactionJob::Prepare() {
   }
 }
 
+namespace {
+
+// Runs a subcompaction exactly once, either from a priority thread pool task or from the thread
+// running the compaction job, whichever gets to it first.
+class SubcompactionRunner {
+ public:
+  typedef std::function<void(yb::PriorityThreadPoolSuspender*)> Function;
+
+  explicit SubcompactionRunner(Function function) : function_(std::move(function)) {}
+
+  // Returns false if the subcompaction was already started by another thread.
+  bool TryRun(yb::PriorityThreadPoolSuspender* suspender) {
+    if (started_.exchange(true, std::memory_order_acq_rel)) {
+      return false;
+    }
+    function_(suspender);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      finished_ = true;
+    }
+    cond_.notify_all();
+    return true;
+  }
+
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return finished_; });
+  }
+
+ private:
+  Function function_;
+  std::atomic<bool> started_{false};
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool finished_ = false;
+};
+
+class SubcompactionTask : public yb::PriorityThreadPoolTask {
+ public:
+  explicit SubcompactionTask(std::shared_ptr<SubcompactionRunner> runner)
+      : runner_(std::move(runner)) {}
+
+  void Run(const Status& status, yb::PriorityThreadPoolSuspender* suspender) override {
+    // Aborted task would be run by the thread running the compaction job.
+    if (status.ok()) {
+      runner_->TryRun(suspender);
+    }
+  }
+
+  bool BelongsTo(void* key) override {
+    return false;
+  }
+
+  std::string ToString() const override {
+    return "{ subcompaction }";
+  }
+
+ private:
+  std::shared_ptr<SubcompactionRunner> runner_;
+};
+
+} // namespace
+
 struct RangeWithSize {
   Range range;
   uint64_t size;
@@ -412,6 +503,22 @@ void CompactionJob::GenSubcompactionBoundaries() {
     }
   }
 
+  const auto* boundary_key_transform = db_options_.subcompaction_boundary_key_transform.get();
+  if (boundary_key_transform) {
+    boundary_keys_.reserve(bounds.size());
+    for (const auto& bound : bounds) {
+      const auto user_key = ExtractUserKey(bound);
+      if (!boundary_key_transform->InDomain(user_key)) {
+        continue;
+      }
+      IterKey key;
+      key.SetInternalKey(
+          boundary_key_transform->Transform(user_key), kMaxSequenceNumber, kValueTypeForSeek);
+      boundary_keys_.push_back(key.GetKey().ToBuffer());
+    }
+    bounds.assign(boundary_keys_.begin(), boundary_keys_.end());
+  }
+
   std::sort(bounds.begin(), bounds.end(),
     [cfd_comparator] (const Slice& a, const Slice& b) -> bool {
       return cfd_comparator->Compare(ExtractUserKey(a), ExtractUserKey(b)) < 0;
@@ -426,6 +533,10 @@ void CompactionJob::GenSubcompactionBoundaries() {
   // size of data covered by keys in that range
   uint64_t sum = 0;
   std::vector<RangeWithSize> ranges;
+  if (bounds.size() < 2) {
+    sizes_.emplace_back(sum);
+    return;
+  }
   auto* v = cfd->current();
   for (auto it = bounds.begin();;) {
     const Slice a = *it;
@@ -493,20 +604,51 @@ Result<FileNumbersHolder> CompactionJob::Run() {
   assert(num_threads > 0);
   const uint64_t start_micros = env_->NowMicros();
 
-  // Launch a thread for each of subcompactions 1...num_threads-1
-  std::vector<std::thread> thread_pool;
-  thread_pool.reserve(num_threads - 1);
   FileNumbersHolder file_numbers_holder(file_numbers_provider_->CreateHolder());
   file_numbers_holder.Reserve(num_threads);
+
+  // Launch a thread for each of subcompactions 1...num_threads-1. When the priority thread pool is
+  // available, subcompactions are submitted to it instead, so they run on idle compaction workers.
+  auto* priority_thread_pool = db_options_.priority_thread_pool_for_compactions_and_flushes;
+  std::vector<std::thread> thread_pool;
+  std::vector<std::shared_ptr<SubcompactionRunner>> runners;
+  if (priority_thread_pool) {
+    runners.reserve(num_threads - 1);
+  } else {
+    thread_pool.reserve(num_threads - 1);
+  }
   for (size_t i = 1; i < compact_->sub_compact_states.size(); i++) {
-    thread_pool.emplace_back(&CompactionJob::ProcessKeyValueCompaction, this, &file_numbers_holder,
-                             &compact_->sub_compact_states[i]);
+    auto* sub_compact = &compact_->sub_compact_states[i];
+    if (!priority_thread_pool) {
+      thread_pool.emplace_back(&CompactionJob::ProcessKeyValueCompaction, this,
+                               &file_numbers_holder, sub_compact);
+      continue;
+    }
+    runners.push_back(std::make_shared<SubcompactionRunner>(
+        [this, &file_numbers_holder, sub_compact](yb::PriorityThreadPoolSuspender* suspender) {
+      sub_compact->suspender = suspender;
+      ProcessKeyValueCompaction(&file_numbers_holder, sub_compact);
+    }));
+    auto task = std::make_unique<SubcompactionTask>(runners.back());
+    // If the task could not be submitted, it is run by the current thread below.
+    WARN_NOT_OK(priority_thread_pool->Submit(compact_->compaction->priority(), &task),
+                "Failed to submit subcompaction");
   }
 
   // Always schedule the first subcompaction (whether or not there are also
   // others) in the current thread to be efficient with resources
+  compact_->sub_compact_states[0].suspender = compact_->compaction->suspender();
   ProcessKeyValueCompaction(&file_numbers_holder, &compact_->sub_compact_states[0]);
 
+  // Run subcompactions that were not picked up by the priority thread pool yet in the current
+  // thread, and wait for the others to finish. Pool workers could be busy with compactions waiting
+  // for their own subcompactions, so we should not wait for a subcompaction that was not started.
+  for (auto& runner : runners) {
+    if (!runner->TryRun(compact_->compaction->suspender())) {
+      runner->Wait();
+    }
+  }
+
   // Wait for all other threads (if there are any) to finish execution
   for (auto& thread : thread_pool) {
     thread.join();
@@ -601,7 +743,8 @@ Status CompactionJob::Install(const MutableCFOptions& mutable_cf_options) {
          << "total_output_size" << compact_->total_bytes
          << "num_input_records" << compact_->num_input_records
          << "num_output_records" << compact_->num_output_records
-         << "num_subcompactions" << compact_->sub_compact_states.size();
+         << "num_subcompactions" << compact_->sub_compact_states.size()
+         << "output_compression" << CompressionTypeToString(output_compression_);
 
   if (measure_io_stats_ && compaction_job_stats_ != nullptr) {
     stream << "file_write_nanos" << compaction_job_stats_->file_write_nanos;
@@ -610,6 +753,8 @@ Status CompactionJob::Install(const MutableCFOptions& mutable_cf_options) {
     stream << "file_fsync_nanos" << compaction_job_stats_->file_fsync_nanos;
     stream << "file_prepare_write_nanos"
            << compaction_job_stats_->file_prepare_write_nanos;
+    stream << "block_compress_nanos" << compaction_job_stats_->block_compress_nanos;
+    stream << "block_decompress_nanos" << compaction_job_stats_->block_decompress_nanos;
   }
 
   stream << "lsm_state";
@@ -639,6 +784,8 @@ void CompactionJob::ProcessKeyValueCompaction(
   uint64_t prev_fsync_nanos = 0;
   uint64_t prev_range_sync_nanos = 0;
   uint64_t prev_prepare_write_nanos = 0;
+  uint64_t prev_compress_nanos = 0;
+  uint64_t prev_decompress_nanos = 0;
   if (measure_io_stats_) {
     prev_perf_level = GetPerfLevel();
     SetPerfLevel(PerfLevel::kEnableTime);
@@ -646,6 +793,8 @@ void CompactionJob::ProcessKeyValueCompaction(
     prev_fsync_nanos = IOSTATS(fsync_nanos);
     prev_range_sync_nanos = IOSTATS(range_sync_nanos);
     prev_prepare_write_nanos = IOSTATS(prepare_write_nanos);
+    prev_compress_nanos = perf_context.block_compress_time;
+    prev_decompress_nanos = perf_context.block_decompress_time;
   }
 
   ColumnFamilyData* cfd = sub_compact->compaction->column_family_data();
@@ -660,7 +809,12 @@ void CompactionJob::ProcessKeyValueCompaction(
   if (compaction_filter) {
     // This is used to persist the history cutoff hybrid time chosen for the DocDB compaction
     // filter.
-    largest_user_frontier_ = compaction_filter->GetLargestUserFrontier();
+    auto user_frontier = compaction_filter->GetLargestUserFrontier();
+    if (user_frontier) {
+      std::lock_guard<std::mutex> lock(largest_user_frontier_mutex_);
+      UserFrontier::Update(
+          user_frontier.get(), UpdateUserValueType::kLargest, &largest_user_frontier_);
+    }
   }
 
   MergeHelper merge(
@@ -687,7 +841,8 @@ void CompactionJob::ProcessKeyValueCompaction(
   sub_compact->c_iter.reset(new CompactionIterator(
       input.get(), cfd->user_comparator(), &merge, versions_->LastSequence(),
       &existing_snapshots_, earliest_write_conflict_snapshot_, env_, false,
-      sub_compact->compaction, compaction_filter));
+      sub_compact->compaction, compaction_filter, nullptr /* log_buffer */,
+      sub_compact->suspender));
   auto c_iter = sub_compact->c_iter.get();
   c_iter->SeekToFirst();
   const auto& c_iter_stats = c_iter->iter_stats();
@@ -791,6 +946,10 @@ void CompactionJob::ProcessKeyValueCompaction(
         IOSTATS(range_sync_nanos) - prev_range_sync_nanos;
     sub_compact->compaction_job_stats.file_prepare_write_nanos +=
         IOSTATS(prepare_write_nanos) - prev_prepare_write_nanos;
+    sub_compact->compaction_job_stats.block_compress_nanos +=
+        perf_context.block_compress_time - prev_compress_nanos;
+    sub_compact->compaction_job_stats.block_decompress_nanos +=
+        perf_context.block_decompress_time - prev_decompress_nanos;
     if (prev_perf_level != PerfLevel::kEnableTime) {
       SetPerfLevel(prev_perf_level);
     }
@@ -999,7 +1158,9 @@ void CompactionJob::RecordCompactionIOStats() {
 Status CompactionJob::OpenFile(const std::string table_name, uint64_t file_number,
     const std::string file_type_label, const std::string fname,
     std::unique_ptr<WritableFile>* writable_file) {
-  Status s = NewWritableFile(env_, fname, writable_file, env_options_);
+  EnvOptions output_env_options = env_options_;
+  output_env_options.use_direct_io = db_options_.use_direct_io_for_compaction;
+  Status s = NewWritableFile(env_, fname, writable_file, output_env_options);
   if (!s.ok()) {
     RLOG(InfoLogLevel::ERROR_LEVEL, db_options_.info_log,
         "[%s] [JOB %d] OpenCompactionOutputFiles for table #%" PRIu64
@@ -1051,7 +1212,7 @@ Status CompactionJob::OpenCompactionOutputFile(
         (*writable_file)->SetPreallocationBlockSize(preallocation_block_size);
       }
       writer->reset(new WritableFileWriter(
-          std::move(*writable_file), env_options_, sub_compact->compaction->suspender()));
+          std::move(*writable_file), env_options_, sub_compact->suspender));
     };
 
     const bool is_split_sst = cfd->ioptions()->table_factory->IsSplitSstForWriteSupported();
@@ -1075,8 +1236,7 @@ Status CompactionJob::OpenCompactionOutputFile(
       *cfd->ioptions(), cfd->internal_comparator(),
       cfd->int_tbl_prop_collector_factories(), cfd->GetID(),
       sub_compact->base_outfile.get(), sub_compact->data_outfile.get(),
-      sub_compact->compaction->output_compression(), cfd->ioptions()->compression_opts,
-      skip_filters));
+      output_compression_, output_compression_opts_, skip_filters));
   LogFlush(db_options_.info_log);
   return Status::OK();
 }
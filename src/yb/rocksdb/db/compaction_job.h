@@ -30,6 +30,7 @@
 #include <deque>
 #include <functional>
 #include <limits>
+#include <mutex>
 #include <set>
 #include <string>
 #include <utility>
@@ -181,11 +182,18 @@ class CompactionJob {
   bool bottommost_level_;
   bool paranoid_file_checks_;
   bool measure_io_stats_;
+  // Compression of output files, chosen in Prepare().
+  CompressionType output_compression_ = kNoCompression;
+  CompressionOptions output_compression_opts_;
+  // Stores keys produced by subcompaction_boundary_key_transform
+  std::vector<std::string> boundary_keys_;
   // Stores the Slices that designate the boundaries for each subcompaction
   std::vector<Slice> boundaries_;
   // Stores the approx size of keys covered in the range of each subcompaction
   std::vector<uint64_t> sizes_;
 
+  // Updated by subcompactions running in parallel.
+  std::mutex largest_user_frontier_mutex_;
   UserFrontierPtr largest_user_frontier_;
 };
 
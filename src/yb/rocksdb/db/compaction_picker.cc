@@ -35,8 +35,10 @@
 
 #include <gflags/gflags.h>
 
+#include "yb/rocksdb/compaction_filter.h"
 #include "yb/rocksdb/db/column_family.h"
 #include "yb/rocksdb/db/filename.h"
+#include "yb/rocksdb/table/table_reader.h"
 #include "yb/rocksdb/util/log_buffer.h"
 #include "yb/rocksdb/util/random.h"
 #include "yb/rocksdb/util/statistics.h"
@@ -274,6 +276,21 @@ bool CompactionPicker::FilesInCompaction(
   return false;
 }
 
+uint32_t CompactionPicker::OutputPathId(
+    const std::vector<CompactionInputFiles>& inputs, uint32_t default_path_id) const {
+  if (!ioptions_.compaction_output_path_selector) {
+    return default_path_id;
+  }
+  const auto largest = Compaction::LargestInputFrontier(inputs);
+  const auto result = (*ioptions_.compaction_output_path_selector)(largest.get(), default_path_id);
+  if (result >= ioptions_.db_paths.size()) {
+    RLOG(InfoLogLevel::WARN_LEVEL, ioptions_.info_log,
+         "Invalid compaction output path id %" PRIu32 ", using %" PRIu32, result, default_path_id);
+    return default_path_id;
+  }
+  return result;
+}
+
 std::unique_ptr<Compaction> CompactionPicker::FormCompaction(
     const CompactionOptions& compact_options,
     const std::vector<CompactionInputFiles>& input_files, int output_level,
@@ -511,6 +528,7 @@ std::unique_ptr<Compaction> CompactionPicker::CompactRange(
         return nullptr;
       }
     }
+    output_path_id = OutputPathId(inputs, output_path_id);
     auto c = std::make_unique<Compaction>(
         vstorage, mutable_cf_options, std::move(inputs), output_level,
         mutable_cf_options.MaxFileSizeForLevel(output_level),
@@ -609,6 +627,10 @@ std::unique_ptr<Compaction> CompactionPicker::CompactRange(
     }
   }
 
+  if (ioptions_.compaction_style == kCompactionStyleUniversal) {
+    output_path_id = OutputPathId(compaction_inputs, output_path_id);
+  }
+
   std::vector<FileMetaData*> grandparents;
   GetGrandparents(vstorage, inputs, output_level_inputs, &grandparents);
   auto compaction = std::make_unique<Compaction>(
@@ -1353,6 +1375,11 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompaction(
     const MutableCFOptions& mutable_cf_options,
     VersionStorageInfo* vstorage,
     LogBuffer* log_buffer) {
+  auto deletion = PickExpiredFilesDeletion(cf_name, mutable_cf_options, vstorage, log_buffer);
+  if (deletion) {
+    return deletion;
+  }
+
   std::vector<std::vector<SortedRun>> sorted_runs = CalculateSortedRuns(
       *vstorage,
       ioptions_,
@@ -1367,6 +1394,57 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompaction(
   return nullptr;
 }
 
+std::unique_ptr<Compaction> UniversalCompactionPicker::PickExpiredFilesDeletion(
+    const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+    VersionStorageInfo* vstorage, LogBuffer* log_buffer) {
+  auto* factory = ioptions_.compaction_filter_factory;
+  if (factory == nullptr || !level0_compactions_in_progress_.empty()) {
+    return nullptr;
+  }
+
+  std::vector<FileMetaData*> files;
+  std::vector<std::shared_ptr<const TableProperties>> properties;
+  std::vector<FileExpirationInfo> infos;
+  for (int level = 0; level < vstorage->num_levels(); ++level) {
+    for (auto* f : vstorage->LevelFiles(level)) {
+      files.push_back(f);
+      // Only properties of already opened tables are used, to avoid I/O under the DB mutex.
+      properties.push_back(
+          f->fd.table_reader ? f->fd.table_reader->GetTableProperties() : nullptr);
+      infos.push_back(FileExpirationInfo {
+          properties.back().get(), f->largest.user_frontier.get() });
+    }
+  }
+  if (files.empty()) {
+    return nullptr;
+  }
+
+  std::vector<CompactionInputFiles> inputs(1);
+  inputs[0].level = 0;
+  for (auto idx : factory->ExpiredFiles(infos)) {
+    // Deletion compaction supports only level 0 files, that are listed first.
+    if (idx >= vstorage->LevelFiles(0).size() || files[idx]->being_compacted) {
+      continue;
+    }
+    auto* f = files[idx];
+    inputs[0].files.push_back(f);
+    LOG_TO_BUFFER(log_buffer, "[%s] Universal: picking expired file %" PRIu64 " for deletion",
+                  cf_name.c_str(), f->fd.GetNumber());
+  }
+  if (inputs[0].files.empty()) {
+    return nullptr;
+  }
+
+  auto c = std::make_unique<Compaction>(
+      vstorage, mutable_cf_options, std::move(inputs), 0 /* output_level */,
+      0 /* target_file_size */, 0 /* max_grandparent_overlap_bytes */, 0 /* output_path_id */,
+      kNoCompression, std::vector<FileMetaData*>(), /* is manual */ false,
+      vstorage->CompactionScore(0),
+      /* is deletion compaction */ true, CompactionReason::kUniversalExpiredFiles);
+  level0_compactions_in_progress_.insert(c.get());
+  return c;
+}
+
 std::unique_ptr<Compaction> UniversalCompactionPicker::DoPickCompaction(
     const std::string& cf_name,
     const MutableCFOptions& mutable_cf_options,
@@ -1706,6 +1784,8 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalRe
                 file_num_buf);
   }
 
+  path_id = OutputPathId(inputs, path_id);
+
   CompactionReason compaction_reason;
   if (max_number_of_files_to_compact == UINT_MAX) {
     compaction_reason = CompactionReason::kUniversalSortedRunNum;
@@ -1831,6 +1911,7 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalSi
     LOG_TO_BUFFER(log_buffer, "[%s] Universal: size amp picking %s",
                 cf_name.c_str(), file_num_buf);
   }
+  path_id = OutputPathId(inputs, path_id);
 
   return std::make_unique<Compaction>(
       vstorage, mutable_cf_options, std::move(inputs),
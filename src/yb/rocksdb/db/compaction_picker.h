@@ -186,6 +186,11 @@ class CompactionPicker {
                        const CompactionInputFiles& output_level_inputs,
                        std::vector<FileMetaData*>* grandparents);
 
+  // Returns the db_paths index for the output of a compaction of the given input files, as chosen
+  // by compaction_output_path_selector if it is set, otherwise default_path_id.
+  uint32_t OutputPathId(const std::vector<CompactionInputFiles>& inputs,
+                        uint32_t default_path_id) const;
+
   const ImmutableCFOptions& ioptions_;
 
   // A helper function to SanitizeCompactionInputFiles() that
@@ -264,6 +269,12 @@ class UniversalCompactionPicker : public CompactionPicker {
  private:
   struct SortedRun;
 
+  // Pick level 0 files that could be deleted without compaction, because all their entries are
+  // expired, see CompactionFilterFactory::ExpiredFiles.
+  std::unique_ptr<Compaction> PickExpiredFilesDeletion(
+      const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+      VersionStorageInfo* vstorage, LogBuffer* log_buffer);
+
   std::unique_ptr<Compaction> DoPickCompaction(
       const std::string& cf_name,
       const MutableCFOptions& mutable_cf_options,
@@ -23,6 +23,7 @@
 #include <cstdlib>
 #include <gflags/gflags.h>
 #include "yb/rocksdb/db/db_test_util.h"
+#include "yb/rocksdb/persistent_cache.h"
 #include "yb/rocksdb/port/stack_trace.h"
 
 DECLARE_double(cache_single_touch_ratio);
@@ -185,6 +186,37 @@ TEST_F(DBBlockCacheTest, TestWithoutCompressedBlockCache) {
   }
 }
 
+TEST_F(DBBlockCacheTest, TestWithPersistentCache) {
+  ReadOptions read_options;
+  auto table_options = GetTableOptions();
+  auto options = GetOptions(table_options);
+  InitTable(options);
+  ASSERT_OK(Flush());
+
+  std::shared_ptr<PersistentCache> persistent_cache;
+  ASSERT_OK(NewPersistentCache(
+      env_, dbname_ + "/persistent_cache", 1024 * 1024, 4096, &persistent_cache));
+  // Block cache with zero capacity does not keep blocks, so they should be found in the
+  // persistent cache.
+  table_options.block_cache = NewLRUCache(0, 0, false);
+  table_options.persistent_cache = persistent_cache;
+  options.table_factory.reset(new BlockBasedTableFactory(table_options));
+  Reopen(options);
+
+  std::string value(kValueSize, 'a');
+  for (size_t i = 0; i < kNumBlocks; i++) {
+    ASSERT_EQ(value, Get(ToString(i)));
+  }
+  size_t usage = persistent_cache->GetUsage();
+  ASSERT_LT(0, usage);
+
+  for (size_t i = 0; i < kNumBlocks; i++) {
+    ASSERT_EQ(value, Get(ToString(i)));
+  }
+  // All blocks were read from the persistent cache, so nothing new was added to it.
+  ASSERT_EQ(usage, persistent_cache->GetUsage());
+}
+
 #ifdef SNAPPY
 TEST_F(DBBlockCacheTest, TestWithCompressedBlockCache) {
   ReadOptions read_options;
@@ -430,6 +430,40 @@ TEST_F(DBBloomFilterTest, BloomFilterIndex) {
   } while (ChangeCompactOptions());
 }
 
+TEST_F(DBBloomFilterTest, FixedSizeFilterPrefetch) {
+  Options options = CurrentOptions();
+  BlockBasedTableOptions table_options;
+  table_options.filter_policy.reset(NewFixedSizeFilterPolicy(
+      FilterPolicy::kDefaultFixedSizeFilterBits, FilterPolicy::kDefaultFixedSizeFilterErrorRate,
+      nullptr));
+  table_options.filter_block_size = 1024;
+  table_options.cache_index_and_filter_blocks = true;
+  table_options.block_cache = NewLRUCache(8_MB);
+  table_options.fixed_size_filter_prefetch_bytes = 1_MB;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  const int kNumKeys = 10000;
+  for (int i = 0; i < kNumKeys; i++) {
+    ASSERT_OK(Put(Key(i), Key(i)));
+  }
+  ASSERT_OK(Flush());
+
+  // Reopen with an empty block cache and fresh statistics, so all filter blocks are prefetched
+  // when the SST file is opened.
+  table_options.block_cache = NewLRUCache(8_MB);
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  options.statistics = rocksdb::CreateDBStatistics();
+  Reopen(options);
+
+  for (int i = 0; i < kNumKeys; i++) {
+    ASSERT_EQ(Key(i), Get(Key(i)));
+  }
+  ASSERT_GT(TestGetTickerCount(options, BLOCK_CACHE_FILTER_PREFETCH), 1);
+  ASSERT_EQ(0, TestGetTickerCount(options, BLOCK_CACHE_FILTER_MISS));
+  ASSERT_GT(TestGetTickerCount(options, BLOCK_CACHE_FILTER_HIT), 0);
+}
+
 TEST_F(DBBloomFilterTest, BloomFilterRate) {
   while (ChangeFilterOptions()) {
     Options options = CurrentOptions();
@@ -27,6 +27,7 @@
 #include "yb/rocksdb/port/stack_trace.h"
 #include "yb/rocksdb/experimental.h"
 #include "yb/rocksdb/utilities/convenience.h"
+#include "yb/rocksdb/util/compression.h"
 #include "yb/rocksdb/util/sync_point.h"
 #include "yb/rocksdb/util/testutil.h"
 
@@ -317,6 +318,48 @@ TEST_F(DBCompactionTest, Checkpoint) {
   LOG(INFO) << "Total checkpoints: " << checkpoints.load(std::memory_order_acquire);
 }
 
+TEST_F(DBCompactionTest, CompactionCompressionSelector) {
+  if (!Zlib_Supported()) {
+    return;
+  }
+  Options options = CurrentOptions();
+  options.compression = kSnappyCompression;
+  std::atomic<int> num_selections{0};
+  std::atomic<uint64_t> selected_input_size{0};
+  options.compaction_compression_selector = std::make_shared<CompactionCompressionSelector>(
+      [&num_selections, &selected_input_size](
+          uint64_t input_size, const UserFrontier* largest_frontier,
+          CompressionType* compression, CompressionOptions* compression_opts) {
+        ASSERT_EQ(kSnappyCompression, *compression);
+        ++num_selections;
+        selected_input_size = input_size;
+        *compression = kZlibCompression;
+        compression_opts->level = 9;
+      });
+  DestroyAndReopen(options);
+  Random rnd(301);
+
+  constexpr int kNumFiles = 3;
+  constexpr int kKeysPerFile = 100;
+  std::vector<std::string> values;
+  for (int i = 0; i < kNumFiles; ++i) {
+    for (int j = 0; j < kKeysPerFile; ++j) {
+      values.push_back(RandomString(&rnd, 100));
+      ASSERT_OK(Put(Key(i * kKeysPerFile + j), values.back()));
+    }
+    ASSERT_OK(Flush());
+  }
+  // Flushes do not use the selector.
+  ASSERT_EQ(0, num_selections.load());
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_GE(num_selections.load(), 1);
+  ASSERT_GT(selected_input_size.load(), 0);
+  for (size_t k = 0; k < values.size(); ++k) {
+    ASSERT_EQ(values[k], Get(Key(static_cast<int>(k))));
+  }
+}
+
 TEST_F(DBCompactionTest, SkipStatsUpdateTest) {
   // This test verify UpdateAccumulatedStats is not on by observing
   // the compaction behavior when there are many of deletion entries.
@@ -244,6 +244,7 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
       : ThreadPoolTask(db_impl), manual_compaction_(manual_compaction),
         compaction_(manual_compaction->compaction.get()), priority_(CalcPriority()) {
     db_impl->mutex_.AssertHeld();
+    compaction_->SetPriority(priority_);
   }
 
   CompactionTask(DBImpl* db_impl, std::unique_ptr<Compaction> compaction)
@@ -251,6 +252,7 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
         compaction_holder_(std::move(compaction)), compaction_(compaction_holder_.get()),
         priority_(CalcPriority()) {
     db_impl->mutex_.AssertHeld();
+    compaction_->SetPriority(priority_);
   }
 
   void DoRun(yb::PriorityThreadPoolSuspender* suspender) override {
@@ -290,6 +292,7 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
     auto new_priority = CalcPriority();
     if (new_priority != priority_) {
       priority_ = new_priority;
+      compaction_->SetPriority(priority_);
       return true;
     }
     return false;
@@ -480,7 +483,7 @@ DBOptions SanitizeOptions(const std::string& dbname, const DBOptions& src) {
     result.db_paths.emplace_back(dbname, std::numeric_limits<uint64_t>::max());
   }
 
-  if (result.compaction_readahead_size > 0) {
+  if (result.compaction_readahead_size > 0 || result.use_direct_io_for_compaction) {
     result.new_table_reader_for_compaction_inputs = true;
   }
 
@@ -1960,6 +1963,16 @@ uint64_t DBImpl::GetCurrentVersionDataSstFilesSize() {
   return data_sst_file_size;
 }
 
+yb::Result<std::string> DBImpl::GetMiddleKey() {
+  auto cfd = default_cf_handle_->cfd();
+  // Super version keeps the current version and its files alive, so mutex is not held while the
+  // data index is read.
+  auto super_version = GetAndRefSuperVersion(cfd);
+  auto result = super_version->current->GetMiddleKey();
+  ReturnAndCleanupSuperVersion(cfd, super_version);
+  return result;
+}
+
 void DBImpl::NotifyOnFlushCompleted(ColumnFamilyData* cfd,
                                     FileMetaData* file_meta,
                                     const MutableCFOptions& mutable_cf_options,
@@ -3496,8 +3509,8 @@ Result<FileNumbersHolder> DBImpl::BackgroundCompaction(
     // file if there is alive snapshot pointing to it
     assert(c->num_input_files(1) == 0);
     assert(c->level() == 0);
-    assert(c->column_family_data()->ioptions()->compaction_style ==
-           kCompactionStyleFIFO);
+    assert(c->column_family_data()->ioptions()->compaction_style == kCompactionStyleFIFO ||
+           c->column_family_data()->ioptions()->compaction_style == kCompactionStyleUniversal);
 
     compaction_job_stats.num_input_files = c->num_input_files(0);
 
@@ -4986,8 +4999,9 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
     // 3. Deletes or SingleDeletes are not okay if filtering deletes
     //    (controlled by both batch and memtable setting)
     // 4. Merges are not okay
-    // 5. YugaByte-specific user-specified sequence numbers are currently not compatible with
-    //    parallel memtable writes.
+    //
+    // Sequence numbers are assigned to writers by the leader, and user frontiers are merged into
+    // the memtable under its frontiers mutex, so both are valid for parallel memtable writes.
     //
     // Rules 1..3 are enforced by checking the options
     // during startup (CheckConcurrentWritesSupported), so if
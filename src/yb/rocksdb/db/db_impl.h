@@ -632,6 +632,8 @@ class DBImpl : public DB {
 
   uint64_t GetCurrentVersionDataSstFilesSize() override;
 
+  yb::Result<std::string> GetMiddleKey() override;
+
   uint64_t GetCurrentVersionNumSSTFiles() override;
 
   int GetCfdImmNumNotFlushed() override;
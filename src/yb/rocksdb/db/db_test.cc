@@ -5322,6 +5322,64 @@ TEST_F(DBTest, ConcurrentMemtableNotSupported) {
   ASSERT_NOK(db_->CreateColumnFamily(cf_options, "name", &handle));
 }
 
+// Checks that sequence numbers, user frontiers and single deletes are handled correctly when
+// memtable inserts of a write group are executed in parallel.
+TEST_F(DBTest, ConcurrentMemtableWritesWithFrontiers) {
+  Options options = CurrentOptions();
+  options.allow_concurrent_memtable_write = true;
+  options.enable_write_thread_adaptive_yield = true;
+  options.memtable_factory = std::make_shared<SkipListFactory>(0, ConcurrentWrites::kTrue);
+  options.write_buffer_size = 64 << 20;
+  DestroyAndReopen(options);
+
+  constexpr int kThreads = 8;
+  constexpr int kBatchesPerThread = 200;
+  const auto initial_sequence = db_->GetLatestSequenceNumber();
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kThreads; ++t) {
+    threads.emplace_back([this, t] {
+      for (int i = 0; i != kBatchesPerThread; ++i) {
+        const auto value = 1 + t * kBatchesPerThread + i;
+        test::TestUserFrontiers frontiers(value, value);
+        WriteBatch batch;
+        batch.Put(Key(value), ToString(value));
+        batch.Put("deleted" + Key(value), "x");
+        batch.SetFrontiers(&frontiers);
+        ASSERT_OK(db_->Write(WriteOptions(), &batch));
+
+        WriteBatch delete_batch;
+        delete_batch.SingleDelete("deleted" + Key(value));
+        ASSERT_OK(db_->Write(WriteOptions(), &delete_batch));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  constexpr int kTotalBatches = kThreads * kBatchesPerThread;
+  // Each iteration writes 3 records.
+  ASSERT_EQ(initial_sequence + 3 * kTotalBatches, db_->GetLatestSequenceNumber());
+  for (int value = 1; value <= kTotalBatches; ++value) {
+    ASSERT_EQ(ToString(value), Get(Key(value)));
+    ASSERT_EQ("NOT_FOUND", Get("deleted" + Key(value)));
+  }
+
+  auto smallest = db_->GetMutableMemTableFrontier(UpdateUserValueType::kSmallest);
+  auto largest = db_->GetMutableMemTableFrontier(UpdateUserValueType::kLargest);
+  ASSERT_TRUE(smallest);
+  ASSERT_TRUE(largest);
+  ASSERT_EQ(1, down_cast<test::TestUserFrontier&>(*smallest).Value());
+  ASSERT_EQ(kTotalBatches, down_cast<test::TestUserFrontier&>(*largest).Value());
+
+  ASSERT_OK(Flush());
+  for (int value = 1; value <= kTotalBatches; value += kBatchesPerThread / 2) {
+    ASSERT_EQ(ToString(value), Get(Key(value)));
+    ASSERT_EQ("NOT_FOUND", Get("deleted" + Key(value)));
+  }
+}
+
 #endif  // ROCKSDB_LITE
 
 TEST_F(DBTest, SanitizeNumThreads) {
@@ -21,11 +21,18 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 
+#include <deque>
+#include <future>
+#include <mutex>
+#include <set>
+
 #include "yb/rocksdb/db/db_test_util.h"
 #include "yb/rocksdb/port/stack_trace.h"
 #if !defined(ROCKSDB_LITE)
 #include "yb/rocksdb/util/sync_point.h"
 
+#include "yb/util/priority_thread_pool.h"
+
 namespace rocksdb {
 
 static std::string CompressibleString(Random* rnd, int len) {
@@ -1474,6 +1481,224 @@ TEST_F(DBTestUniversalCompaction, IncludeFilesSmallerThanThreshold) {
   GenerateFilesAndCheckCompactionResult(options, file_sizes, value_size, 1);
 }
 
+namespace {
+
+// Records key prefixes processed by each compaction filter, i.e. by each subcompaction.
+class PrefixRecordingFilterFactory : public CompactionFilterFactory {
+ public:
+  explicit PrefixRecordingFilterFactory(size_t prefix_size) : prefix_size_(prefix_size) {}
+
+  std::unique_ptr<CompactionFilter> CreateCompactionFilter(
+      const CompactionFilter::Context& context) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    prefixes_.emplace_back();
+    return std::make_unique<PrefixRecordingFilter>(prefix_size_, &prefixes_.back());
+  }
+
+  const char* Name() const override { return "PrefixRecordingFilterFactory"; }
+
+  std::vector<std::set<std::string>> prefixes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::vector<std::set<std::string>>(prefixes_.begin(), prefixes_.end());
+  }
+
+ private:
+  class PrefixRecordingFilter : public CompactionFilter {
+   public:
+    PrefixRecordingFilter(size_t prefix_size, std::set<std::string>* prefixes)
+        : prefix_size_(prefix_size), prefixes_(prefixes) {}
+
+    FilterDecision Filter(int level, const Slice& key, const Slice& value,
+                          std::string* new_value, bool* value_changed) override {
+      prefixes_->insert(key.ToBuffer().substr(0, prefix_size_));
+      return FilterDecision::kKeep;
+    }
+
+    const char* Name() const override { return "PrefixRecordingFilter"; }
+
+   private:
+    const size_t prefix_size_;
+    std::set<std::string>* prefixes_;
+  };
+
+  const size_t prefix_size_;
+  std::mutex mutex_;
+  // Use deque, so pointers to already created sets are not invalidated.
+  std::deque<std::set<std::string>> prefixes_;
+};
+
+} // namespace
+
+TEST_F(DBTestUniversalCompaction, Subcompactions) {
+  constexpr int kNumFiles = 8;
+  constexpr int kKeysPerFile = 50;
+  constexpr int kValueSize = 1000;
+  // Keys with the same prefix should be processed by the same subcompaction.
+  constexpr size_t kPrefixSize = 8;
+
+  for (bool use_thread_pool : {false, true}) {
+    SCOPED_TRACE(yb::Format("use_thread_pool: $0", use_thread_pool));
+    yb::PriorityThreadPool thread_pool(4);
+    auto filter_factory = std::make_shared<PrefixRecordingFilterFactory>(kPrefixSize);
+    Options options = CurrentOptions();
+    options.compaction_style = kCompactionStyleUniversal;
+    options.num_levels = 1;
+    options.disable_auto_compactions = true;
+    options.target_file_size_base = 10 * kValueSize;
+    options.max_subcompactions = 4;
+    options.subcompaction_boundary_key_transform.reset(NewFixedPrefixTransform(kPrefixSize));
+    options.compaction_filter_factory = filter_factory;
+    options.statistics = CreateDBStatistics();
+    if (use_thread_pool) {
+      options.priority_thread_pool_for_compactions_and_flushes = &thread_pool;
+    }
+    DestroyAndReopen(options);
+
+    // Files cover adjacent key ranges, with boundaries in the middle of key prefixes.
+    Random rnd(301);
+    std::vector<std::string> values;
+    for (int i = 0; i != kNumFiles * kKeysPerFile; ++i) {
+      values.push_back(RandomString(&rnd, kValueSize));
+      ASSERT_OK(Put(Key(i), values.back()));
+      if ((i + 1) % kKeysPerFile == kKeysPerFile / 2) {
+        ASSERT_OK(Flush());
+      }
+    }
+    ASSERT_OK(Flush());
+
+    ASSERT_OK(dbfull()->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+
+    HistogramData subcompactions;
+    options.statistics->histogramData(NUM_SUBCOMPACTIONS_SCHEDULED, &subcompactions);
+    ASSERT_GT(subcompactions.max, 1);
+
+    for (int i = 0; i != kNumFiles * kKeysPerFile; ++i) {
+      ASSERT_EQ(values[i], Get(Key(i)));
+    }
+
+    // Each prefix should be processed by a single subcompaction.
+    std::set<std::string> all_prefixes;
+    size_t total_prefixes = 0;
+    for (const auto& prefixes : filter_factory->prefixes()) {
+      all_prefixes.insert(prefixes.begin(), prefixes.end());
+      total_prefixes += prefixes.size();
+    }
+    ASSERT_EQ(static_cast<size_t>(kNumFiles * kKeysPerFile / 10), all_prefixes.size());
+    ASSERT_EQ(all_prefixes.size(), total_prefixes);
+
+    Close();
+    thread_pool.Shutdown();
+  }
+}
+
+namespace {
+
+// Slowly processes keys and drops all of them, so the compaction does not write any output.
+class SlowDiscardingFilterFactory : public CompactionFilterFactory {
+ public:
+  std::unique_ptr<CompactionFilter> CreateCompactionFilter(
+      const CompactionFilter::Context& context) override {
+    return std::make_unique<SlowDiscardingFilter>(&num_filtered_);
+  }
+
+  const char* Name() const override { return "SlowDiscardingFilterFactory"; }
+
+  size_t num_filtered() const {
+    return num_filtered_.load(std::memory_order_acquire);
+  }
+
+ private:
+  class SlowDiscardingFilter : public CompactionFilter {
+   public:
+    explicit SlowDiscardingFilter(std::atomic<size_t>* num_filtered)
+        : num_filtered_(num_filtered) {}
+
+    FilterDecision Filter(int level, const Slice& key, const Slice& value,
+                          std::string* new_value, bool* value_changed) override {
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+      num_filtered_->fetch_add(1, std::memory_order_acq_rel);
+      return FilterDecision::kDiscard;
+    }
+
+    const char* Name() const override { return "SlowDiscardingFilter"; }
+
+   private:
+    std::atomic<size_t>* num_filtered_;
+  };
+
+  std::atomic<size_t> num_filtered_{0};
+};
+
+class FunctorTask : public yb::PriorityThreadPoolTask {
+ public:
+  explicit FunctorTask(std::function<void()> functor) : functor_(std::move(functor)) {}
+
+  void Run(const Status& status, yb::PriorityThreadPoolSuspender* suspender) override {
+    if (status.ok()) {
+      functor_();
+    }
+  }
+
+  bool BelongsTo(void* key) override {
+    return false;
+  }
+
+  std::string ToString() const override {
+    return "FunctorTask";
+  }
+
+ private:
+  std::function<void()> functor_;
+};
+
+} // namespace
+
+// A compaction that drops all its input should still be preempted by a task with higher priority.
+TEST_F(DBTestUniversalCompaction, PreemptDiscardingCompaction) {
+  constexpr int kNumKeys = 5000;
+  constexpr int kHighPriority = 1000;
+
+  yb::PriorityThreadPool thread_pool(1);
+  auto filter_factory = std::make_shared<SlowDiscardingFilterFactory>();
+  Options options = CurrentOptions();
+  options.compaction_style = kCompactionStyleUniversal;
+  options.num_levels = 1;
+  options.disable_auto_compactions = true;
+  options.compaction_filter_factory = filter_factory;
+  options.priority_thread_pool_for_compactions_and_flushes = &thread_pool;
+  DestroyAndReopen(options);
+
+  // Two files with interleaved keys.
+  for (int file = 0; file != 2; ++file) {
+    for (int i = file; i < kNumKeys; i += 2) {
+      ASSERT_OK(Put(Key(i), "value"));
+    }
+    ASSERT_OK(Flush());
+  }
+
+  std::thread compaction_thread([this] {
+    ASSERT_OK(dbfull()->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  });
+  while (filter_factory->num_filtered() == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  std::promise<size_t> filtered_before_task;
+  auto task = std::make_unique<FunctorTask>([&filter_factory, &filtered_before_task] {
+    filtered_before_task.set_value(filter_factory->num_filtered());
+  });
+  ASSERT_OK(thread_pool.Submit(kHighPriority, &task));
+  auto filtered = filtered_before_task.get_future().get();
+  compaction_thread.join();
+
+  // The only worker was given to the task before the compaction completed.
+  ASSERT_LT(filtered, kNumKeys);
+  ASSERT_EQ(kNumKeys, filter_factory->num_filtered());
+
+  Close();
+  thread_pool.Shutdown();
+}
+
 }  // namespace rocksdb
 
 #endif  // !defined(ROCKSDB_LITE)
@@ -375,6 +375,39 @@ class IterKey {
     key_size_ = total_size;
   }
 
+  // Same as TrimAppend, but also keeps the last shared_suffix_len bytes of the current key after
+  // the appended data. Used for blocks with the shared suffix encoding.
+  void TrimAppendWithSuffix(const size_t shared_len, const char* non_shared_data,
+                            const size_t non_shared_len, const size_t shared_suffix_len) {
+    assert(shared_len + shared_suffix_len <= key_size_);
+    const size_t total_size = shared_len + non_shared_len + shared_suffix_len;
+    const char* suffix = key_ + key_size_ - shared_suffix_len;
+
+    if (IsKeyPinned() /* key is not in buf_ */) {
+      EnlargeBufferIfNeeded(total_size);
+      memcpy(buf_, key_, shared_len);
+      memcpy(buf_ + shared_len + non_shared_len, suffix, shared_suffix_len);
+    } else if (total_size > buf_size_) {
+      char* p = new char[total_size];
+      memcpy(p, key_, shared_len);
+      memcpy(p + shared_len + non_shared_len, suffix, shared_suffix_len);
+
+      if (buf_ != space_) {
+        delete[] buf_;
+      }
+
+      buf_ = p;
+      buf_size_ = total_size;
+    } else {
+      // The suffix is moved to its place before the data is appended, so it is not overwritten.
+      memmove(buf_ + shared_len + non_shared_len, suffix, shared_suffix_len);
+    }
+
+    memcpy(buf_ + shared_len, non_shared_data, non_shared_len);
+    key_ = buf_;
+    key_size_ = total_size;
+  }
+
   Slice SetKey(const Slice& key, bool copy = true) {
     size_t size = key.size();
     if (copy) {
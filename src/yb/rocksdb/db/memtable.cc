@@ -39,6 +39,7 @@
 #include "yb/rocksdb/table/internal_iterator.h"
 #include "yb/rocksdb/table/merger.h"
 #include "yb/rocksdb/util/arena.h"
+#include "yb/rocksdb/util/arena_block_pool.h"
 #include "yb/rocksdb/util/coding.h"
 #include "yb/rocksdb/util/murmurhash.h"
 #include "yb/rocksdb/util/mutexlock.h"
@@ -72,6 +73,10 @@ MemTableOptions::MemTableOptions(
     statistics(ioptions.statistics),
     merge_operator(ioptions.merge_operator),
     info_log(ioptions.info_log) {
+  if (ioptions.memtable_arena_block_pool) {
+    arena_block_pool = ioptions.memtable_arena_block_pool;
+    arena_block_size = arena_block_pool->block_size();
+  }
   if (ioptions.mem_tracker) {
     mem_tracker = yb::MemTracker::FindOrCreateTracker("MemTable", ioptions.mem_tracker);
   }
@@ -85,7 +90,7 @@ MemTable::MemTable(const InternalKeyComparator& cmp,
       moptions_(ioptions, mutable_cf_options),
       refs_(0),
       kArenaBlockSize(OptimizeBlockSize(moptions_.arena_block_size)),
-      arena_(moptions_.arena_block_size, 0),
+      arena_(moptions_.arena_block_size, 0, moptions_.arena_block_pool),
       allocator_(&arena_, write_buffer),
       table_(ioptions.memtable_factory->CreateMemTableRep(
           comparator_, &allocator_, ioptions.prefix_extractor,
@@ -474,7 +479,7 @@ void MemTable::Add(SequenceNumber s, ValueType type,
         earliest_seqno_.load(std::memory_order_relaxed);
     while (
         (cur_earliest_seqno == kMaxSequenceNumber || s < cur_earliest_seqno) &&
-        !first_seqno_.compare_exchange_weak(cur_earliest_seqno, s)) {
+        !earliest_seqno_.compare_exchange_weak(cur_earliest_seqno, s)) {
     }
   }
 
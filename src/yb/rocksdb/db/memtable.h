@@ -66,6 +66,7 @@ struct MemTableOptions {
       const MutableCFOptions& mutable_cf_options);
   size_t write_buffer_size;
   size_t arena_block_size;
+  std::shared_ptr<ArenaBlockPool> arena_block_pool;
   uint32_t memtable_prefix_bloom_bits;
   uint32_t memtable_prefix_bloom_probes;
   size_t memtable_prefix_bloom_huge_page_tlb_size;
@@ -137,7 +137,18 @@ Status TableCache::GetTableReader(
     const InternalKeyComparatorPtr& internal_comparator, const FileDescriptor& fd,
     bool sequential_mode, bool record_read_stats, HistogramImpl* file_read_hist,
     unique_ptr<TableReader>* table_reader, bool skip_filters) {
-  const std::string base_fname = TableFileName(ioptions_.db_paths, fd.GetNumber(), fd.GetPathId());
+  std::string base_fname = TableFileName(ioptions_.db_paths, fd.GetNumber(), fd.GetPathId());
+  if (ioptions_.db_paths.size() > 1 && !ioptions_.env->FileExists(base_fname).ok()) {
+    // Checkpoints contain files of all paths in a single directory, so a DB restored from a
+    // checkpoint or remote bootstrapped could have files in another path than their path id.
+    for (uint32_t path_id = 0; path_id < ioptions_.db_paths.size(); ++path_id) {
+      auto fname = TableFileName(ioptions_.db_paths, fd.GetNumber(), path_id);
+      if (path_id != fd.GetPathId() && ioptions_.env->FileExists(fname).ok()) {
+        base_fname = std::move(fname);
+        break;
+      }
+    }
+  }
 
   Status s;
   {
@@ -234,9 +245,13 @@ Status TableCache::DoGetTableReaderForIterator(
   const bool create_new_table_reader =
       (for_compaction && ioptions_.new_table_reader_for_compaction_inputs);
   if (create_new_table_reader) {
+    // The table reader is used only by this compaction, so it could bypass the OS page cache.
+    // Readers that are put to the table cache should not, because they serve foreground reads.
+    EnvOptions compaction_env_options = env_options;
+    compaction_env_options.use_direct_io = ioptions_.use_direct_io_for_compaction;
     unique_ptr<TableReader> table_reader_unique_ptr;
     Status s = GetTableReader(
-        env_options, icomparator, fd, /* sequential mode */ true,
+        compaction_env_options, icomparator, fd, /* sequential mode */ true,
         /* record stats */ false, nullptr, &table_reader_unique_ptr);
     if (!s.ok()) {
       return s;
@@ -465,6 +480,26 @@ size_t TableCache::GetMemoryUsageByTableReader(
   return ret;
 }
 
+yb::Result<std::string> TableCache::GetMiddleKey(
+    const EnvOptions& env_options,
+    const InternalKeyComparatorPtr& internal_comparator,
+    const FileDescriptor& fd) {
+  auto table_reader = fd.table_reader;
+  // table already been pre-loaded?
+  if (table_reader) {
+    return table_reader->GetMiddleKey();
+  }
+
+  Cache::Handle* table_handle = nullptr;
+  RETURN_NOT_OK(FindTable(
+      env_options, internal_comparator, fd, &table_handle, kDefaultQueryId));
+  assert(table_handle);
+  auto table = GetTableReaderFromHandle(table_handle);
+  auto result = table->GetMiddleKey();
+  ReleaseHandle(table_handle);
+  return result;
+}
+
 void TableCache::Evict(Cache* cache, uint64_t file_number) {
   cache->Erase(GetSliceForFileNumber(&file_number));
 }
@@ -140,6 +140,12 @@ class TableCache {
       const InternalKeyComparatorPtr& internal_comparator,
       const FileDescriptor& fd);
 
+  // Returns middle key of the table, see TableReader::GetMiddleKey.
+  yb::Result<std::string> GetMiddleKey(
+      const EnvOptions& toptions,
+      const InternalKeyComparatorPtr& internal_comparator,
+      const FileDescriptor& fd);
+
   // Release the handle from a cache
   void ReleaseHandle(Cache::Handle* handle);
 
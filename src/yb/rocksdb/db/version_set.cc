@@ -721,6 +721,30 @@ size_t Version::GetMemoryUsageByTableReaders() {
   return total_usage;
 }
 
+yb::Result<std::string> Version::GetMiddleKey() {
+  const FdWithBoundaries* largest_file = nullptr;
+  for (auto& file_level : storage_info_.level_files_brief_) {
+    for (size_t i = 0; i < file_level.num_files; i++) {
+      const auto& file = file_level.files[i];
+      if (!largest_file ||
+          file.fd.GetTotalFileSize() > largest_file->fd.GetTotalFileSize()) {
+        largest_file = &file;
+      }
+    }
+  }
+  if (!largest_file) {
+    return STATUS(Incomplete, "No SST files");
+  }
+
+  const auto middle_key = VERIFY_RESULT(cfd_->table_cache()->GetMiddleKey(
+      vset_->env_options_, cfd_->internal_comparator(), largest_file->fd));
+  if (middle_key.size() < 8) {
+    return STATUS_FORMAT(Corruption, "Too short internal key in data index: $0",
+                         Slice(middle_key).ToDebugHexString());
+  }
+  return ExtractUserKey(middle_key).ToBuffer();
+}
+
 void Version::GetColumnFamilyMetaData(ColumnFamilyMetaData* cf_meta) {
   assert(cf_meta);
   assert(cfd_);
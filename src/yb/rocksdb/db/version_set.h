@@ -517,6 +517,11 @@ class Version {
 
   size_t GetMemoryUsageByTableReaders();
 
+  // Returns the middle user key of the largest SST file of this version. For universal compaction
+  // the largest file contains most of the data, so this key approximately splits the whole data
+  // into two halves.
+  yb::Result<std::string> GetMiddleKey();
+
   ColumnFamilyData* cfd() const { return cfd_; }
 
   // Return the next Version in the linked list. Used for debug only
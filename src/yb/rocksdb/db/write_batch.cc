@@ -704,8 +704,11 @@ class MemTableInserter : public WriteBatch::Handler {
       return seek_status;
     }
     MemTable* mem = cf_mems_->GetMemTable();
+    // In memory erase is not supported by concurrent memtables, and MemTable::Erase uses a shared
+    // buffer, so it is not even tried during concurrent writes.
     if ((delete_type == ValueType::kTypeSingleDeletion ||
          delete_type == ValueType::kTypeColumnFamilySingleDeletion) &&
+        !insert_flags_.Test(InsertFlag::kConcurrentMemtableWrites) &&
         mem->Erase(key)) {
       return Status::OK();
     }
@@ -311,6 +311,13 @@ class Env {
   // Delete the specified directory.
   virtual Status DeleteDir(const std::string& dirname) = 0;
 
+  // Truncate the named file to the specified size. Fails with IllegalState if the file has
+  // other hard links, e.g. SST files shared with a checkpoint, since truncation would change the
+  // content of all of them.
+  virtual Status TruncateFile(const std::string& fname, uint64_t size) {
+    return STATUS(NotSupported, "TruncateFile is not supported for this Env");
+  }
+
   // Store the size of fname in *file_size.
   virtual Status GetFileSize(const std::string& fname, uint64_t* file_size) = 0;
 
@@ -901,6 +908,9 @@ class EnvWrapper : public Env {
   Status DeleteDir(const std::string& d) override {
     return target_->DeleteDir(d);
   }
+  Status TruncateFile(const std::string& f, uint64_t size) override {
+    return target_->TruncateFile(f, size);
+  }
   Status GetFileSize(const std::string& f, uint64_t* s) override {
     return target_->GetFileSize(f, s);
   }
@@ -148,6 +148,10 @@ class FilterPolicy {
 
     // Transform a key.
     virtual Slice Transform(Slice key) const = 0;
+
+    // Returns false if the key could not be checked against the filter, e.g. because it is a
+    // prefix shorter than the keys added to the filter. The filter is not used for such keys.
+    virtual bool CanFilter(Slice key) const { return true; }
   };
 
   // Filter policy can optionally return key transformer to be used before writing key to filter or
@@ -191,6 +195,18 @@ class FilterPolicy {
 extern const FilterPolicy* NewBloomFilterPolicy(int bits_per_key,
     bool use_block_based_builder = true);
 
+// Format of filter blocks written by the fixed-size filter. In both formats all probes of a key
+// are inside of a single cache line. The format is recorded in the metadata of each filter block,
+// so filter blocks of any format are read by the same policy.
+enum class FixedSizeFilterFormat {
+  // Probes are checked one bit at a time.
+  kBitProbes,
+  // Probes of a key are collected into a 512 bit mask of its 64 byte line, which is checked against
+  // the line with a few wide instructions and without branches per probe. Older readers treat such
+  // filter blocks as matching all keys.
+  kLineMask,
+};
+
 // Return a new filter policy that uses a bloom filter divided into fixed-size blocks with
 // specified parameters:
 //
@@ -198,12 +214,13 @@ extern const FilterPolicy* NewBloomFilterPolicy(int bits_per_key,
 // some metadata added.
 // error_rate: expected false positive error rate to calculate maximum number of keys to store in
 // each filter block. This is used to determine whether a filter block is full.
+// format: format of the filter blocks built by this policy.
 //
 // Callers must delete the result after any database that is using the filter policy has been
 // closed.
-extern const FilterPolicy* NewFixedSizeFilterPolicy(uint32_t total_bits,
-                                                    double error_rate,
-                                                    Logger* logger);
+extern const FilterPolicy* NewFixedSizeFilterPolicy(
+    uint32_t total_bits, double error_rate, Logger* logger,
+    FixedSizeFilterFormat format = FixedSizeFilterFormat::kBitProbes);
 }  // namespace rocksdb
 
 #endif  // YB_ROCKSDB_FILTER_POLICY_H
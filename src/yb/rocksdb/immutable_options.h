@@ -119,6 +119,8 @@ struct ImmutableCFOptions {
 
   size_t compaction_readahead_size;
 
+  bool use_direct_io_for_compaction;
+
   int num_levels;
 
   bool optimize_filters_for_hits;
@@ -133,7 +135,13 @@ struct ImmutableCFOptions {
 
   std::shared_ptr<yb::MemTracker> block_based_table_mem_tracker;
 
+  std::shared_ptr<ArenaBlockPool> memtable_arena_block_pool;
+
   std::shared_ptr<IteratorReplacer> iterator_replacer;
+
+  std::shared_ptr<CompactionOutputPathSelector> compaction_output_path_selector;
+
+  std::shared_ptr<CompactionCompressionSelector> compaction_compression_selector;
 };
 
 }  // namespace rocksdb
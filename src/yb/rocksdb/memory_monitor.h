@@ -34,7 +34,12 @@ class MemoryMonitor {
     return memory_used_.load(std::memory_order_relaxed);
   }
 
-  size_t limit() const { return limit_; }
+  size_t limit() const { return limit_.load(std::memory_order_relaxed); }
+
+  // Changes the limit, the callback is notified on the next reservation above the new limit.
+  void SetLimit(size_t limit) {
+    limit_.store(limit, std::memory_order_relaxed);
+  }
 
   bool Exceeded() const {
     return Exceeded(memory_usage());
@@ -58,10 +63,11 @@ class MemoryMonitor {
  private:
 
   bool Exceeded(size_t size) const {
-    return limit() > 0 && size >= limit();
+    auto limit = this->limit();
+    return limit > 0 && size >= limit;
   }
 
-  const size_t limit_;
+  std::atomic<size_t> limit_;
   const std::function<void()> exceeded_callback_;
   std::atomic<size_t> memory_used_ {0};
 
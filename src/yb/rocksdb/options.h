@@ -52,6 +52,7 @@ class PriorityThreadPool;
 namespace rocksdb {
 
 class Arena;
+class ArenaBlockPool;
 class BoundaryValuesExtractor;
 class Cache;
 class CompactionFilter;
@@ -73,6 +74,7 @@ class SliceTransform;
 class Statistics;
 class InternalIterator;
 class InternalKeyComparator;
+class UserFrontier;
 class WalFilter;
 class MemoryMonitor;
 
@@ -168,6 +170,13 @@ struct CompressionOptions {
   int window_bits;
   int level;
   int strategy;
+  // Maximal size of the dictionary used to compress data blocks of an SST file. The dictionary is
+  // built from the first data blocks of the file and stored in its meta blocks. Supported by LZ4
+  // and ZSTD compression, 0 to compress each block on its own.
+  size_t max_dict_bytes = 0;
+  // Maximal size of data blocks buffered to build the dictionary before they are written, 0 means
+  // 100 * max_dict_bytes.
+  size_t max_dict_buffer_bytes = 0;
   CompressionOptions() : window_bits(-14), level(-1), strategy(0) {}
   CompressionOptions(int wbits, int _lev, int _strategy)
       : window_bits(wbits), level(_lev), strategy(_strategy) {}
@@ -829,6 +838,17 @@ struct ColumnFamilyOptions {
 typedef std::function<yb::Result<bool>(const MemTable&)> MemTableFilter;
 using IteratorReplacer =
     std::function<InternalIterator*(InternalIterator*, Arena*, const Slice&)>;
+// Returns the index in db_paths for the output of a compaction. largest_frontier is the largest
+// user frontier of the compaction input files, or nullptr if some input file does not have one.
+// default_path_id is the path chosen by the compaction style.
+using CompactionOutputPathSelector =
+    std::function<uint32_t(const UserFrontier* largest_frontier, uint32_t default_path_id)>;
+// Chooses the compression of compaction outputs. input_size is the total size of the compaction
+// input files, largest_frontier is as for CompactionOutputPathSelector. compression and
+// compression_opts are initialized from options and could be changed by the selector.
+using CompactionCompressionSelector = std::function<void(
+    uint64_t input_size, const UserFrontier* largest_frontier, CompressionType* compression,
+    CompressionOptions* compression_opts)>;
 
 struct DBOptions {
   // Some functions that make it easier to optimize RocksDB
@@ -1174,6 +1194,14 @@ struct DBOptions {
   // Default: 0
   size_t compaction_readahead_size;
 
+  // If true, compaction reads its input files and writes its output files with direct I/O, i.e.
+  // bypassing the OS page cache, so compactions don't evict data used by foreground reads.
+  //
+  // When true, we also force new_table_reader_for_compaction_inputs to true.
+  //
+  // Default: false
+  bool use_direct_io_for_compaction;
+
   // This is a maximum buffer size that is used by WinMmapReadableFile in
   // unbuffered disk I/O mode. We need to maintain an aligned buffer for
   // reads. We allow the buffer to grow until the specified value and then
@@ -1335,6 +1363,12 @@ struct DBOptions {
   // Max file size for compaction. Supported only for level0 of universal style compactions.
   uint64_t max_file_size_for_compaction = std::numeric_limits<uint64_t>::max();
 
+  // If set, subcompaction boundaries are replaced with the prefix extracted by this transform from
+  // the boundary user key, so all keys with the same prefix are processed by the same
+  // subcompaction. Should be used when the compaction filter keeps state across such keys.
+  // Boundaries which are not in the domain of the transform are ignored.
+  std::shared_ptr<const SliceTransform> subcompaction_boundary_key_transform;
+
   // Invoked after memtable switched.
   std::shared_ptr<std::function<MemTableFilter()>> mem_table_flush_filter_factory;
 
@@ -1347,9 +1381,29 @@ struct DBOptions {
   // Specific mem tracker for block based tables created by this RocksDB instance.
   std::shared_ptr<yb::MemTracker> block_based_table_mem_tracker;
 
+  // Pool of arena blocks shared with memtables of other RocksDB instances. If set, memtable arenas
+  // use the pool block size instead of arena_block_size.
+  //
+  // Default: nullptr (memtables allocate their own blocks)
+  std::shared_ptr<ArenaBlockPool> memtable_arena_block_pool;
+
   // Adds ability to modify iterator created for SST file.
   // For instance some additional filtering could be added.
   std::shared_ptr<IteratorReplacer> iterator_replacer;
+
+  // Overrides the db_paths entry chosen for outputs of automatic and manual compactions in
+  // universal compaction style, for instance to place old data on cheaper storage. Flush outputs
+  // are always placed in db_paths[0].
+  //
+  // Default: nullptr (path is chosen by the compaction style)
+  std::shared_ptr<CompactionOutputPathSelector> compaction_output_path_selector;
+
+  // Overrides the compression of compaction outputs, for instance to use cheaper compression for
+  // small files that are compacted again soon and stronger compression for large old files.
+  // Flush outputs always use the compression from column family options.
+  //
+  // Default: nullptr (compression is chosen by the compaction style and output level)
+  std::shared_ptr<CompactionCompressionSelector> compaction_compression_selector;
 };
 
 // Options to control the behavior of a database (passed to DB::Open)
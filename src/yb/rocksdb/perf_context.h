@@ -45,6 +45,7 @@ struct PerfContext {
   uint64_t block_read_time;           // total nanos spent on block reads
   uint64_t block_checksum_time;       // total nanos spent on block checksum
   uint64_t block_decompress_time;  // total nanos spent on block decompression
+  uint64_t block_compress_time;  // total nanos spent on block compression
   // total number of internal keys skipped over during iteration (overwritten or
   // deleted, to be more specific, hidden by a put or delete of the same key)
   uint64_t internal_key_skipped_count;
@@ -106,6 +107,18 @@ struct PerfContext {
   uint64_t bloom_sst_hit_count;
   // total number of SST table bloom misses
   uint64_t bloom_sst_miss_count;
+  // total number of bytes produced by block decompression
+  uint64_t block_decompress_byte;
+  // total number of seeks, including SeekToFirst and SeekToLast, on DB iterators
+  uint64_t iter_seek_count;
+  // total number of Next calls on DB iterators
+  uint64_t iter_next_count;
+  // total number of Prev calls on DB iterators
+  uint64_t iter_prev_count;
+  // total number of seeks done after Next calls tried to avoid them did not reach the seek key
+  uint64_t iter_forced_seek_count;
+  // total number of Next calls tried to avoid seeks, that were followed by a seek anyway
+  uint64_t iter_wasted_next_count;
 };
 
 #if defined(NPERF_CONTEXT) || defined(IOS_CROSS_COMPILE)
@@ -0,0 +1,83 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+// A PersistentCache is a secondary block cache tier that keeps raw (possibly compressed) block
+// contents on a local device, usually a fast NVMe drive. It is checked by the block based table
+// reader after the block cache misses and before the block is read from the SST file, and it is
+// populated with the blocks read from SST files.
+//
+// Cached data is not expected to survive the process restart, so implementations may discard
+// the content of the device on open.
+
+#ifndef YB_ROCKSDB_PERSISTENT_CACHE_H
+#define YB_ROCKSDB_PERSISTENT_CACHE_H
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include "yb/gutil/ref_counted.h"
+
+#include "yb/rocksdb/status.h"
+
+#include "yb/util/slice.h"
+
+namespace yb {
+
+class MetricEntity;
+
+} // namespace yb
+
+namespace rocksdb {
+
+class Env;
+
+class PersistentCache {
+ public:
+  PersistentCache() {}
+  virtual ~PersistentCache() {}
+
+  PersistentCache(const PersistentCache&) = delete;
+  void operator=(const PersistentCache&) = delete;
+
+  // Stores data under the specified key. Existing data for the same key is replaced.
+  virtual Status Insert(const Slice& key, const Slice& data) = 0;
+
+  // Looks up data for the specified key. Returns NotFound if there is no such key in the cache,
+  // or if the stored data is found to be corrupted.
+  virtual Status Lookup(const Slice& key, std::unique_ptr<char[]>* data, size_t* size) = 0;
+
+  // Return a new numeric id, that could be used to partition the key space between clients
+  // sharing the same cache. See Cache::NewId.
+  virtual uint64_t NewId() = 0;
+
+  // Returns the maximum configured capacity of the cache, in bytes.
+  virtual size_t GetCapacity() const = 0;
+
+  // Returns the number of bytes used by the entries residing in the cache.
+  virtual size_t GetUsage() const = 0;
+
+  virtual void SetMetrics(const scoped_refptr<yb::MetricEntity>& entity) = 0;
+};
+
+// Creates a log-structured file cache in the directory specified by path, with at most capacity
+// bytes of data. Cached blocks are appended to files of file_size bytes, when capacity is
+// reached the oldest file is evicted with all blocks it contains. Existing cache files in this
+// directory are removed.
+Status NewPersistentCache(
+    Env* env, const std::string& path, size_t capacity, size_t file_size,
+    std::shared_ptr<PersistentCache>* result);
+
+}  // namespace rocksdb
+
+#endif  // YB_ROCKSDB_PERSISTENT_CACHE_H
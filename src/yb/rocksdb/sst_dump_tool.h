@@ -20,11 +20,36 @@
 #ifndef ROCKSDB_LITE
 #pragma once
 
+#include <memory>
+#include <string>
+
+#include "yb/util/slice.h"
+
 namespace rocksdb {
 
+// Collects format specific statistics about entries of SST files, for --command=analyze.
+class SstKeyValueAnalyzer {
+ public:
+  virtual ~SstKeyValueAnalyzer() = default;
+
+  // Called for every entry of the analyzed files, in file order, with the user key of the entry.
+  virtual void Add(const Slice& user_key, const Slice& value) = 0;
+
+  // Returns human readable statistics about all entries added so far.
+  virtual std::string Report() const = 0;
+};
+
 class SSTDumpTool {
  public:
+  SSTDumpTool() = default;
+
+  explicit SSTDumpTool(std::unique_ptr<SstKeyValueAnalyzer> analyzer)
+      : analyzer_(std::move(analyzer)) {}
+
   int Run(int argc, char** argv);
+
+ private:
+  std::unique_ptr<SstKeyValueAnalyzer> analyzer_;
 };
 
 }  // namespace rocksdb
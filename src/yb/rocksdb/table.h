@@ -47,6 +47,7 @@ namespace rocksdb {
 
 // -- Block-based Table
 class FlushBlockPolicyFactory;
+class PersistentCache;
 struct TableReaderOptions;
 struct TableBuilderOptions;
 class TableBuilder;
@@ -122,6 +123,12 @@ struct BlockBasedTableOptions {
   // If NULL, rocksdb will not use a compressed block cache.
   std::shared_ptr<Cache> block_cache_compressed = nullptr;
 
+  // If non-NULL use the specified persistent cache as the secondary tier of block_cache. Blocks
+  // read from SST files are stored there in the same form as in the file (i.e. compressed), and
+  // it is checked on block cache miss before reading the SST file.
+  // Used only for data and index blocks, and only when block_cache is set.
+  std::shared_ptr<PersistentCache> persistent_cache = nullptr;
+
   // Approximate size of user data packed per block, in bytes. Note that the
   // block size specified here corresponds to uncompressed data.  The
   // actual size of the unit read from disk may be smaller if
@@ -133,6 +140,11 @@ struct BlockBasedTableOptions {
   // Size of each filter block, in bytes. Only applicable for fixed size filter block.
   size_t filter_block_size = 64 * 1024;
 
+  // Maximum total size of fixed-size filter blocks of a single SST file to load into the block
+  // cache when the file is opened, so the first point reads do not pay for filter block IO.
+  // Applied only when cache_index_and_filter_blocks is set. 0 disables prefetching.
+  size_t fixed_size_filter_prefetch_bytes = 0;
+
   // This is used to close a block before it reaches the configured
   // 'block_size'. If the percentage of free space in the current block is less
   // than this specified number and adding a new record to the block will
@@ -146,6 +158,24 @@ struct BlockBasedTableOptions {
   // value will be silently overwritten with 1.
   int block_restart_interval = 16;
 
+  // If set, data blocks are built with an in-block hash index that maps the key prefix, extracted
+  // from the user key by this transform, to the restart interval containing the first key with
+  // this prefix. Seek uses it to go directly to that restart interval instead of doing a binary
+  // search over restart points. All keys that have the same prefix should be adjacent.
+  //
+  // The same transform should be set when reading files written with it, otherwise the hash index
+  // is ignored. Files with the hash index could not be read by versions that do not support it.
+  std::shared_ptr<const SliceTransform> data_block_hash_index_key_transform = nullptr;
+
+  // Ratio of prefixes to buckets in the data block hash index.
+  double data_block_hash_index_util_ratio = 0.75;
+
+  // If true, entries of data blocks also omit the key suffix shared with the previous key, see
+  // block_builder.cc. It saves space for keys that differ only in the middle, like DocDB keys of
+  // different columns of the same row written at the same hybrid time. Files built with it could
+  // not be read by versions that do not support it.
+  bool data_block_shared_suffix_encoding = false;
+
   // Same as block_restart_interval but used for the index block.
   int index_block_restart_interval = 1;
 
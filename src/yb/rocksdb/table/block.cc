@@ -31,6 +31,7 @@
 #include <vector>
 
 #include "yb/rocksdb/comparator.h"
+#include "yb/rocksdb/slice_transform.h"
 #include "yb/rocksdb/table/format.h"
 #include "yb/rocksdb/table/block_hash_index.h"
 #include "yb/rocksdb/table/block_prefix_index.h"
@@ -47,21 +48,30 @@ namespace rocksdb {
 //
 // If any errors are detected, returns nullptr.  Otherwise, returns a
 // pointer to the key delta (just past the three decoded values).
+// When shared_suffix is not null, the entry is decoded in the shared suffix encoding.
 static inline const char* DecodeEntry(const char* p, const char* limit,
                                       uint32_t* shared,
                                       uint32_t* non_shared,
-                                      uint32_t* value_length) {
-  if (limit - p < 3) return nullptr;
+                                      uint32_t* value_length,
+                                      uint32_t* shared_suffix = nullptr) {
+  const ptrdiff_t header_size = shared_suffix ? 4 : 3;
+  if (limit - p < header_size) return nullptr;
   *shared = reinterpret_cast<const unsigned char*>(p)[0];
   *non_shared = reinterpret_cast<const unsigned char*>(p)[1];
   *value_length = reinterpret_cast<const unsigned char*>(p)[2];
-  if ((*shared | *non_shared | *value_length) < 128) {
-    // Fast path: all three values are encoded in one byte each
-    p += 3;
+  uint32_t all_values = *shared | *non_shared | *value_length;
+  if (shared_suffix) {
+    *shared_suffix = reinterpret_cast<const unsigned char*>(p)[3];
+    all_values |= *shared_suffix;
+  }
+  if (all_values < 128) {
+    // Fast path: all values are encoded in one byte each
+    p += header_size;
   } else {
     if ((p = GetVarint32Ptr(p, limit, shared)) == nullptr) return nullptr;
     if ((p = GetVarint32Ptr(p, limit, non_shared)) == nullptr) return nullptr;
     if ((p = GetVarint32Ptr(p, limit, value_length)) == nullptr) return nullptr;
+    if (shared_suffix && (p = GetVarint32Ptr(p, limit, shared_suffix)) == nullptr) return nullptr;
   }
 
   if (static_cast<uint32_t>(limit - p) < (*non_shared + *value_length)) {
@@ -104,6 +114,9 @@ void BlockIter::Initialize(const Comparator* comparator, const char* data,
 
   comparator_ = comparator;
   data_ = data;
+  data_block_hash_index_ = nullptr;
+  data_block_hash_index_key_transform_ = nullptr;
+  shared_suffix_encoding_ = false;
   restarts_ = restarts;
   num_restarts_ = num_restarts;
   current_ = restarts_;
@@ -122,6 +135,8 @@ void BlockIter::Seek(const Slice& target) {
   bool ok = false;
   if (prefix_index_) {
     ok = PrefixSeek(target, &index);
+  } else if (data_block_hash_index_ && DataBlockHashSeek(target, &index)) {
+    ok = true;
   } else {
     ok = hash_index_ ? HashSeek(target, &index)
       : BinarySeek(target, 0, num_restarts_ - 1, &index);
@@ -178,13 +193,16 @@ bool BlockIter::ParseNextKey() {
   }
 
   // Decode next entry
-  uint32_t shared, non_shared, value_length;
-  p = DecodeEntry(p, limit, &shared, &non_shared, &value_length);
-  if (p == nullptr || key_.Size() < shared) {
+  uint32_t shared, non_shared, value_length, shared_suffix = 0;
+  p = DecodeEntry(p, limit, &shared, &non_shared, &value_length,
+                  shared_suffix_encoding_ ? &shared_suffix : nullptr);
+  if (p == nullptr || key_.Size() < shared + shared_suffix) {
     CorruptionError();
     return false;
   } else {
-    if (shared == 0) {
+    if (shared_suffix != 0) {
+      key_.TrimAppendWithSuffix(shared, p, non_shared, shared_suffix);
+    } else if (shared == 0) {
       // If this key dont share any bytes with prev key then we dont need
       // to decode it and can use it's address in the block directly.
       key_.SetKey(Slice(p, non_shared), false /* copy */);
@@ -209,16 +227,11 @@ bool BlockIter::BinarySeek(const Slice& target, uint32_t left, uint32_t right,
 
   while (left < right) {
     uint32_t mid = (left + right + 1) / 2;
-    uint32_t region_offset = GetRestartPoint(mid);
-    uint32_t shared, non_shared, value_length;
-    const char* key_ptr =
-        DecodeEntry(data_ + region_offset, data_ + restarts_, &shared,
-                    &non_shared, &value_length);
-    if (key_ptr == nullptr || (shared != 0)) {
+    Slice mid_key;
+    if (!DecodeRestartKey(mid, &mid_key)) {
       CorruptionError();
       return false;
     }
-    Slice mid_key(key_ptr, non_shared);
     int cmp = Compare(mid_key, target);
     if (cmp < 0) {
       // Key at "mid" is smaller than "target". Therefore all
@@ -240,18 +253,26 @@ bool BlockIter::BinarySeek(const Slice& target, uint32_t left, uint32_t right,
 // Compare target key and the block key of the block of `block_index`.
 // Return -1 if error.
 int BlockIter::CompareBlockKey(uint32_t block_index, const Slice& target) {
-  uint32_t region_offset = GetRestartPoint(block_index);
-  uint32_t shared, non_shared, value_length;
-  const char* key_ptr = DecodeEntry(data_ + region_offset, data_ + restarts_,
-                                    &shared, &non_shared, &value_length);
-  if (key_ptr == nullptr || (shared != 0)) {
+  Slice block_key;
+  if (!DecodeRestartKey(block_index, &block_key)) {
     CorruptionError();
     return 1;  // Return target is smaller
   }
-  Slice block_key(key_ptr, non_shared);
   return Compare(block_key, target);
 }
 
+bool BlockIter::DecodeRestartKey(uint32_t index, Slice* key) {
+  uint32_t shared, non_shared, value_length, shared_suffix = 0;
+  const char* key_ptr = DecodeEntry(
+      data_ + GetRestartPoint(index), data_ + restarts_, &shared, &non_shared, &value_length,
+      shared_suffix_encoding_ ? &shared_suffix : nullptr);
+  if (key_ptr == nullptr || shared != 0 || shared_suffix != 0) {
+    return false;
+  }
+  *key = Slice(key_ptr, non_shared);
+  return true;
+}
+
 // Binary search in block_ids to find the first block
 // with a key >= target
 bool BlockIter::BinaryBlockIndexSeek(const Slice& target, uint32_t* block_ids,
@@ -332,9 +353,41 @@ bool BlockIter::PrefixSeek(const Slice& target, uint32_t* index) {
   }
 }
 
+bool BlockIter::DataBlockHashSeek(const Slice& target, uint32_t* index) {
+  const Slice user_key = ExtractUserKey(target);
+  if (!data_block_hash_index_key_transform_->InDomain(user_key)) {
+    return false;
+  }
+  const Slice prefix = data_block_hash_index_key_transform_->Transform(user_key);
+  const uint8_t restart_index = data_block_hash_index_->Lookup(prefix);
+  if (restart_index >= num_restarts_) {
+    // No entry, collision or corrupted index. In the first case the block could still contain
+    // keys greater than target, so we need the binary search anyway.
+    return false;
+  }
+
+  // Because of hash collisions the restart interval could belong to another prefix. Starting the
+  // linear search from it is correct when the restart key is less than target. It is also correct
+  // when the restart key has the same prefix as target, because in this case all preceding keys
+  // have smaller prefix.
+  Slice restart_key;
+  if (!DecodeRestartKey(restart_index, &restart_key)) {
+    return false;
+  }
+  if (Compare(restart_key, target) >= 0) {
+    const Slice restart_user_key = ExtractUserKey(restart_key);
+    if (!data_block_hash_index_key_transform_->InDomain(restart_user_key) ||
+        data_block_hash_index_key_transform_->Transform(restart_user_key) != prefix) {
+      return false;
+    }
+  }
+  *index = restart_index;
+  return true;
+}
+
 uint32_t Block::NumRestarts() const {
   assert(size_ >= 2*sizeof(uint32_t));
-  return DecodeFixed32(data_ + size_ - sizeof(uint32_t));
+  return num_restarts_;
 }
 
 Block::Block(BlockContents&& contents)
@@ -344,18 +397,27 @@ Block::Block(BlockContents&& contents)
   if (size_ < sizeof(uint32_t)) {
     size_ = 0;  // Error marker
   } else {
-    restart_offset_ =
-        static_cast<uint32_t>(size_) - (1 + NumRestarts()) * sizeof(uint32_t);
-    if (restart_offset_ > size_ - sizeof(uint32_t)) {
-      // The size is too small for NumRestarts() and therefore
-      // restart_offset_ wrapped around.
+    bool has_hash_index = false;
+    UnpackDataBlockFooter(
+        DecodeFixed32(data_ + size_ - sizeof(uint32_t)), &has_hash_index, &shared_suffix_encoding_,
+        &num_restarts_);
+    size_t restarts_end = size_ - sizeof(uint32_t);
+    if (has_hash_index) {
+      restarts_end = data_block_hash_index_.Initialize(data_, restarts_end);
+    }
+    if (restarts_end < num_restarts_ * sizeof(uint32_t) ||
+        (has_hash_index && data_block_hash_index_.empty())) {
+      // The size is too small for NumRestarts() or the hash index.
       size_ = 0;
+    } else {
+      restart_offset_ = static_cast<uint32_t>(restarts_end - num_restarts_ * sizeof(uint32_t));
     }
   }
 }
 
 InternalIterator* Block::NewIterator(const Comparator* cmp, BlockIter* iter,
-                                     bool total_order_seek) {
+                                     bool total_order_seek,
+                                     const SliceTransform* data_block_hash_index_key_transform) {
   if (size_ < 2*sizeof(uint32_t)) {
     if (iter != nullptr) {
       iter->SetStatus(STATUS(Corruption, "bad block contents"));
@@ -385,6 +447,12 @@ InternalIterator* Block::NewIterator(const Comparator* cmp, BlockIter* iter,
       iter = new BlockIter(cmp, data_, restart_offset_, num_restarts,
                            hash_index_ptr, prefix_index_ptr);
     }
+    if (shared_suffix_encoding_) {
+      iter->SetSharedSuffixEncoding();
+    }
+    if (data_block_hash_index_key_transform && !data_block_hash_index_.empty()) {
+      iter->SetDataBlockHashIndex(&data_block_hash_index_, data_block_hash_index_key_transform);
+    }
   }
 
   return iter;
@@ -35,6 +35,7 @@
 #include "yb/rocksdb/db/dbformat.h"
 #include "yb/rocksdb/table/block_prefix_index.h"
 #include "yb/rocksdb/table/block_hash_index.h"
+#include "yb/rocksdb/table/data_block_hash_index.h"
 #include "yb/rocksdb/table/format.h"
 #include "yb/rocksdb/table/internal_iterator.h"
 
@@ -43,6 +44,7 @@ namespace rocksdb {
 struct BlockContents;
 class Comparator;
 class BlockIter;
+class SliceTransform;
 class BlockHashIndex;
 class BlockPrefixIndex;
 
@@ -82,9 +84,12 @@ class Block {
   // If total_order_seek is true, hash_index_ and prefix_index_ are ignored.
   // This option only applies for index block. For data block, hash_index_
   // and prefix_index_ are null, so this option does not matter.
-  InternalIterator* NewIterator(const Comparator* comparator,
-                                BlockIter* iter = nullptr,
-                                bool total_order_seek = true);
+  //
+  // If data_block_hash_index_key_transform is not null and the block contains the in-block hash
+  // index, the iterator uses this index to find the restart interval for Seek.
+  InternalIterator* NewIterator(
+      const Comparator* comparator, BlockIter* iter = nullptr, bool total_order_seek = true,
+      const SliceTransform* data_block_hash_index_key_transform = nullptr);
   void SetBlockHashIndex(BlockHashIndex* hash_index);
   void SetBlockPrefixIndex(BlockPrefixIndex* prefix_index);
 
@@ -96,6 +101,9 @@ class Block {
   const char* data_;            // contents_.data.data()
   size_t size_;                 // contents_.data.size()
   uint32_t restart_offset_;     // Offset in data_ of restart array
+  uint32_t num_restarts_ = 0;
+  bool shared_suffix_encoding_ = false;
+  DataBlockHashIndex data_block_hash_index_;
   std::unique_ptr<BlockHashIndex> hash_index_;
   std::unique_ptr<BlockPrefixIndex> prefix_index_;
 
@@ -133,6 +141,18 @@ class BlockIter : public InternalIterator {
     status_ = s;
   }
 
+  // Makes Seek use the in-block hash index, see data_block_hash_index.h.
+  void SetDataBlockHashIndex(
+      const DataBlockHashIndex* hash_index, const SliceTransform* hash_index_key_transform) {
+    data_block_hash_index_ = hash_index;
+    data_block_hash_index_key_transform_ = hash_index_key_transform;
+  }
+
+  // Entries of the block use the shared suffix encoding, see block_builder.cc.
+  void SetSharedSuffixEncoding() {
+    shared_suffix_encoding_ = true;
+  }
+
   virtual bool Valid() const override { return current_ < restarts_; }
   virtual Status status() const override { return status_; }
   virtual Slice key() const override {
@@ -180,6 +200,9 @@ class BlockIter : public InternalIterator {
   Status status_;
   BlockHashIndex* hash_index_;
   BlockPrefixIndex* prefix_index_;
+  const DataBlockHashIndex* data_block_hash_index_ = nullptr;
+  const SliceTransform* data_block_hash_index_key_transform_ = nullptr;
+  bool shared_suffix_encoding_ = false;
 
   inline int Compare(const Slice& a, const Slice& b) const {
     return comparator_->Compare(a, b);
@@ -215,6 +238,9 @@ class BlockIter : public InternalIterator {
 
   int CompareBlockKey(uint32_t block_index, const Slice& target);
 
+  // Decodes the key of the restart point, returns false if the entry is corrupted.
+  bool DecodeRestartKey(uint32_t index, Slice* key);
+
   bool BinaryBlockIndexSeek(const Slice& target, uint32_t* block_ids,
                             uint32_t left, uint32_t right,
                             uint32_t* index);
@@ -223,6 +249,10 @@ class BlockIter : public InternalIterator {
 
   bool PrefixSeek(const Slice& target, uint32_t* index);
 
+  // Returns true if the in-block hash index identified the restart interval to start the linear
+  // search from. Otherwise the caller should fall back to the binary search.
+  bool DataBlockHashSeek(const Slice& target, uint32_t* index);
+
 };
 
 }  // namespace rocksdb
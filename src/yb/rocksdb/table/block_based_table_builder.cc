@@ -58,6 +58,7 @@
 #include "yb/rocksdb/util/coding.h"
 #include "yb/rocksdb/util/compression.h"
 #include "yb/rocksdb/util/crc32c.h"
+#include "yb/rocksdb/util/perf_context_imp.h"
 #include "yb/rocksdb/util/stop_watch.h"
 #include "yb/rocksdb/util/xxhash.h"
 
@@ -110,7 +111,8 @@ bool GoodCompressionRatio(size_t compressed_size, size_t raw_size) {
 Slice CompressBlock(const Slice& raw,
                     const CompressionOptions& compression_options,
                     CompressionType* type, uint32_t format_version,
-                    std::string* compressed_output) {
+                    std::string* compressed_output,
+                    const CompressionDict* compression_dict = nullptr) {
   if (*type == kNoCompression) {
     return raw;
   }
@@ -147,7 +149,7 @@ Slice CompressBlock(const Slice& raw,
       if (LZ4_Compress(
               compression_options,
               GetCompressFormatForVersion(kLZ4Compression, format_version),
-              raw.cdata(), raw.size(), compressed_output) &&
+              raw.cdata(), raw.size(), compressed_output, compression_dict) &&
           GoodCompressionRatio(compressed_output->size(), raw.size())) {
         return *compressed_output;
       }
@@ -163,7 +165,7 @@ Slice CompressBlock(const Slice& raw,
       break;     // fall back to no compression.
     case kZSTDNotFinalCompression:
       if (ZSTD_Compress(compression_options, raw.cdata(), raw.size(),
-                        compressed_output) &&
+                        compressed_output, compression_dict) &&
           GoodCompressionRatio(compressed_output->size(), raw.size())) {
         return *compressed_output;
       }
@@ -303,6 +305,20 @@ struct BlockBasedTableBuilder::Rep {
 
   yb::MemTrackerPtr mem_tracker;
 
+  // Data block kept in memory until the compression dictionary is built.
+  struct BufferedDataBlock {
+    std::string contents;
+    std::string last_key;
+    std::string next_block_first_key;
+  };
+
+  // Whether data blocks are buffered to build the compression dictionary from them, see
+  // CompressionOptions::max_dict_bytes.
+  bool buffer_data_blocks = false;
+  std::vector<BufferedDataBlock> buffered_data_blocks;
+  size_t buffered_data_size = 0;
+  std::unique_ptr<CompressionDict> compression_dict;
+
   Rep(const ImmutableCFOptions& _ioptions,
       const BlockBasedTableOptions& table_opt,
       const InternalKeyComparatorPtr& icomparator,
@@ -352,7 +368,10 @@ BlockBasedTableBuilder::Rep::Rep(
       filter_block_builder(skip_filters ? nullptr : CreateFilterBlockBuilder(
           _ioptions, table_options, filter_type)),
       data_block_builder(table_options.block_restart_interval,
-                 table_options.use_delta_encoding),
+                 table_options.use_delta_encoding,
+                 table_options.data_block_hash_index_key_transform.get(),
+                 table_options.data_block_hash_index_util_ratio,
+                 table_options.data_block_shared_suffix_encoding),
       internal_prefix_transform(_ioptions.prefix_extractor),
       filter_key_transformer(table_opt.filter_policy ?
           table_opt.filter_policy->GetKeyTransformer() : nullptr),
@@ -392,6 +411,10 @@ BlockBasedTableBuilder::Rep::Rep(
       new BlockBasedTablePropertiesCollector(
           this, table_options.index_type, table_options.whole_key_filtering,
           _ioptions.prefix_extractor != nullptr));
+  // Block based filter is built per data block at its offset, so data blocks could not be delayed.
+  buffer_data_blocks = compression_opts.max_dict_bytes > 0 &&
+                       CompressionDictSupported(compression_type) &&
+                       filter_type != FilterType::kBlockBasedFilter;
 }
 
 BlockBasedTableBuilder::BlockBasedTableBuilder(
@@ -486,12 +509,56 @@ void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
   Rep* const r = rep_;
   assert(!r->closed);
   if (!ok()) return;
-  size_t data_block_size = 0;
 
-  if (!r->data_block_builder.empty()) {
-    data_block_size = WriteBlock(&r->data_block_builder, &r->data_pending_handle,
-        r->data_writer.get());
+  if (r->buffer_data_blocks) {
+    const Slice block_contents = r->data_block_builder.Finish();
+    r->buffered_data_size += block_contents.size();
+    r->buffered_data_blocks.push_back(Rep::BufferedDataBlock {
+        block_contents.ToBuffer(), r->last_key, next_block_first_key.ToBuffer() });
+    r->data_block_builder.Reset();
+    const auto max_buffer_bytes = r->compression_opts.max_dict_buffer_bytes
+        ? r->compression_opts.max_dict_buffer_bytes : 100 * r->compression_opts.max_dict_bytes;
+    if (r->buffered_data_size >= max_buffer_bytes) {
+      StopBufferingDataBlocks();
+    }
+    return;
   }
+
+  WriteDataBlock(r->data_block_builder.Finish(), &r->last_key, next_block_first_key);
+  r->data_block_builder.Reset();
+}
+
+void BlockBasedTableBuilder::StopBufferingDataBlocks() {
+  Rep* const r = rep_;
+  r->buffer_data_blocks = false;
+
+  std::vector<Slice> samples;
+  samples.reserve(r->buffered_data_blocks.size());
+  for (const auto& block : r->buffered_data_blocks) {
+    samples.emplace_back(block.contents);
+  }
+  auto dict = BuildCompressionDict(
+      r->compression_type, samples, r->compression_opts.max_dict_bytes);
+  if (!dict.empty()) {
+    r->compression_dict = std::make_unique<CompressionDict>(
+        r->compression_type, std::move(dict), r->compression_opts.level);
+  }
+
+  for (auto& block : r->buffered_data_blocks) {
+    WriteDataBlock(block.contents, &block.last_key, block.next_block_first_key);
+    if (!ok()) break;
+  }
+  r->buffered_data_blocks.clear();
+  r->buffered_data_size = 0;
+}
+
+void BlockBasedTableBuilder::WriteDataBlock(
+    const Slice& block_contents, std::string* last_key, const Slice& next_block_first_key) {
+  Rep* const r = rep_;
+  if (!ok()) return;
+
+  const size_t data_block_size = WriteBlock(
+      block_contents, &r->data_pending_handle, r->data_writer.get(), r->compression_dict.get());
   if (!ok()) return;
 
   if (!r->table_options.skip_table_builder_flush) {
@@ -514,7 +581,7 @@ void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
   // "the r" as the key for the index block entry since it is >= all
   // entries in the first block and < all entries in subsequent
   // blocks.
-  r->data_index_builder->AddIndexEntry(&r->last_key,
+  r->data_index_builder->AddIndexEntry(last_key,
       next_block_first_key.empty() ? nullptr : &next_block_first_key,
       r->data_pending_handle);
   while (r->data_index_builder->ShouldFlush()) {
@@ -571,7 +638,8 @@ size_t BlockBasedTableBuilder::WriteBlock(BlockBuilder* block,
 
 size_t BlockBasedTableBuilder::WriteBlock(const Slice& raw_block_contents,
                                           BlockHandle* handle,
-                                          FileWriterWithOffsetAndCachePrefix* writer_info) {
+                                          FileWriterWithOffsetAndCachePrefix* writer_info,
+                                          const CompressionDict* compression_dict) {
   // File format contains a sequence of blocks where each block has:
   //    block_data: uint8[n]
   //    type: uint8
@@ -582,9 +650,10 @@ size_t BlockBasedTableBuilder::WriteBlock(const Slice& raw_block_contents,
   auto type = r->compression_type;
   Slice block_contents;
   if (raw_block_contents.size() < kCompressionSizeLimit) {
+    PERF_TIMER_GUARD(block_compress_time);
     block_contents =
         CompressBlock(raw_block_contents, r->compression_opts, &type,
-                      r->table_options.format_version, &r->compressed_output);
+                      r->table_options.format_version, &r->compressed_output, compression_dict);
   } else {
     RecordTick(r->ioptions.statistics, NUMBER_BLOCK_NOT_COMPRESSED);
     type = kNoCompression;
@@ -701,6 +770,9 @@ Status BlockBasedTableBuilder::Finish() {
   if (!r->data_block_builder.empty()) {
     FlushDataBlock(end_slice);  // no more data block
   }
+  if (r->buffer_data_blocks) {
+    StopBufferingDataBlocks();
+  }
   if (r->filter_block_builder != nullptr) {
     FlushFilterBlock(end_slice);  // no more filter block
   }
@@ -765,6 +837,14 @@ Status BlockBasedTableBuilder::Finish() {
       }
     }
 
+    if (r->compression_dict) {
+      BlockHandle compression_dict_block_handle;
+      WriteRawBlock(
+          r->compression_dict->dict(), kNoCompression, &compression_dict_block_handle,
+          r->metadata_writer.get());
+      meta_index_builder.Add(kCompressionDictBlock, compression_dict_block_handle);
+    }
+
     // Write properties block.
     {
       PropertyBlockBuilder property_block_builder;
@@ -849,8 +929,10 @@ uint64_t BlockBasedTableBuilder::NumEntries() const {
 }
 
 uint64_t BlockBasedTableBuilder::TotalFileSize() const {
-  return rep_->is_split_sst() ? rep_->metadata_writer->offset + rep_->data_writer->offset :
-      rep_->metadata_writer->offset;
+  // Buffered data blocks are counted by their uncompressed size, so files are split as expected.
+  return rep_->is_split_sst()
+      ? rep_->metadata_writer->offset + rep_->data_writer->offset + rep_->buffered_data_size
+      : rep_->metadata_writer->offset + rep_->buffered_data_size;
 }
 
 uint64_t BlockBasedTableBuilder::BaseFileSize() const {
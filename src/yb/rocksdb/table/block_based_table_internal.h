@@ -34,10 +34,10 @@ inline CHECKED_STATUS ReadBlockFromFile(
     RandomAccessFileReader* file, const Footer& footer, const ReadOptions& options,
     const BlockHandle& handle, std::unique_ptr<Block>* result, Env* env,
     const std::shared_ptr<yb::MemTracker>& mem_tracker,
-    bool do_uncompress = true) {
+    bool do_uncompress = true, const UncompressionDict* dict = nullptr) {
   BlockContents contents;
   Status s = ReadBlockContents(file, footer, options, handle, &contents, env,
-                               mem_tracker, do_uncompress);
+                               mem_tracker, do_uncompress, dict);
   if (s.ok()) {
     result->reset(new Block(std::move(contents)));
   }
@@ -68,8 +68,10 @@ inline Slice GetCacheKey(const CacheKeyPrefixBuffer& cache_key_prefix, const Blo
 }
 
 // Generate a cache key prefix from the file. Used for both data and metadata files.
-inline void GenerateCachePrefix(
-    Cache* cc, yb::FileWithUniqueId* file, CacheKeyPrefixBuffer* prefix) {
+// CacheType should provide NewId(), i.e. Cache or PersistentCache.
+template <class CacheType>
+void GenerateCachePrefix(
+    CacheType* cc, yb::FileWithUniqueId* file, CacheKeyPrefixBuffer* prefix) {
   // generate an id from the file
   prefix->size = file->GetUniqueId(prefix->data);
 
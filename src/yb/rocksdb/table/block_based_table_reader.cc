@@ -23,6 +23,7 @@
 
 #include "yb/rocksdb/table/block_based_table_reader.h"
 
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <cinttypes>
@@ -35,6 +36,7 @@
 #include "yb/rocksdb/filter_policy.h"
 #include "yb/rocksdb/iterator.h"
 #include "yb/rocksdb/options.h"
+#include "yb/rocksdb/persistent_cache.h"
 #include "yb/rocksdb/statistics.h"
 #include "yb/rocksdb/table.h"
 #include "yb/rocksdb/table_properties.h"
@@ -56,6 +58,7 @@
 #include "yb/rocksdb/table/two_level_iterator.h"
 
 #include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/compression.h"
 #include "yb/rocksdb/util/file_reader_writer.h"
 #include "yb/rocksdb/util/perf_context_imp.h"
 #include "yb/rocksdb/util/stop_watch.h"
@@ -64,8 +67,15 @@
 #include "yb/gutil/macros.h"
 #include "yb/util/logging.h"
 #include "yb/util/atomic.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/mem_tracker.h"
 
+DEFINE_int64(rocksdb_iterator_max_readahead_size, 256 * 1024,
+             "Maximum number of bytes of the data file to prefetch ahead of iterators that read "
+             "data blocks sequentially. 0 disables the readahead.");
+TAG_FLAG(rocksdb_iterator_max_readahead_size, advanced);
+TAG_FLAG(rocksdb_iterator_max_readahead_size, runtime);
+
 namespace rocksdb {
 
 extern const uint64_t kBlockBasedTableMagicNumber;
@@ -147,6 +157,9 @@ struct BlockBasedTable::FileReaderWithCachePrefix {
   // Similar prefix, but for compressed blocks cache:
   block_based_table::CacheKeyPrefixBuffer compressed_cache_key_prefix;
 
+  // Similar prefix, but for persistent cache:
+  block_based_table::CacheKeyPrefixBuffer persistent_cache_key_prefix;
+
   explicit FileReaderWithCachePrefix(unique_ptr<RandomAccessFileReader>&& _reader) :
       reader(std::move(_reader)) {}
 };
@@ -237,11 +250,18 @@ struct BlockBasedTable::Rep {
   unique_ptr<SliceTransform> internal_prefix_transform;
   DataIndexLoadMode data_index_load_mode;
   yb::MemTrackerPtr mem_tracker;
+  // Dictionary data blocks are compressed with, nullptr if they are compressed without one.
+  std::unique_ptr<UncompressionDict> uncompression_dict;
 };
 
-// BlockEntryIteratorState doesn't actually store any iterator state and is only used as an adapter
-// to BlockBasedTable. It is used by TwoLevelIterator and MultiLevelIterator to call BlockBasedTable
-// functions in order to check if prefix may match or to create a secondary iterator.
+// BlockEntryIteratorState is used as an adapter to BlockBasedTable. It is used by TwoLevelIterator
+// and MultiLevelIterator to call BlockBasedTable functions in order to check if prefix may match or
+// to create a secondary iterator.
+//
+// For data blocks it also tracks whether blocks are read sequentially. After a few sequential
+// blocks it asks the OS to prefetch the following part of the data file, doubling the readahead
+// window each time the iterator gets close to its end, up to rocksdb_iterator_max_readahead_size.
+// The prefetch is asynchronous, so the iterator does not wait for it.
 class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
  public:
   BlockEntryIteratorState(
@@ -254,6 +274,9 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
         block_type_(block_type) {}
 
   InternalIterator* NewSecondaryIterator(const Slice& index_value) override {
+    if (block_type_ == BlockType::kData) {
+      Readahead(index_value);
+    }
     return table_->NewDataBlockIterator(read_options_, index_value, block_type_);
   }
 
@@ -268,10 +291,48 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
   // Don't own table_. BlockEntryIteratorState should only be stored in iterators or in
   // corresponding BlockBasedTable. TableReader (superclass of BlockBasedTable) is only destroyed
   // after iterator is deleted.
+  // Readahead starts after this number of sequentially read blocks.
+  static constexpr size_t kReadaheadMinSequentialBlocks = 2;
+  static constexpr size_t kInitialReadaheadSize = 8 * 1024;
+
+  void Readahead(Slice index_value) {
+    const auto max_readahead_size = FLAGS_rocksdb_iterator_max_readahead_size;
+    if (max_readahead_size <= 0 || read_options_.read_tier == kBlockCacheTier) {
+      return;
+    }
+    BlockHandle handle;
+    if (!handle.DecodeFrom(&index_value).ok()) {
+      return;
+    }
+    const uint64_t block_end = handle.offset() + handle.size() + kBlockTrailerSize;
+    if (handle.offset() != next_block_offset_) {
+      // Random access, e.g. seek, so restart the detection.
+      num_sequential_blocks_ = 0;
+      readahead_size_ = kInitialReadaheadSize / 2;
+      readahead_limit_ = 0;
+    }
+    next_block_offset_ = block_end;
+    if (++num_sequential_blocks_ < kReadaheadMinSequentialBlocks ||
+        readahead_limit_ >= block_end + readahead_size_ / 2) {
+      return;
+    }
+    readahead_size_ = std::min<uint64_t>(readahead_size_ * 2, max_readahead_size);
+    const uint64_t start = std::max(readahead_limit_, block_end);
+    table_->GetBlockReader(BlockType::kData)->reader->file()->Prefetch(start, readahead_size_);
+    readahead_limit_ = start + readahead_size_;
+  }
+
   BlockBasedTable* const table_;
   const ReadOptions read_options_;
   const bool skip_filters_;
   const BlockType block_type_;
+
+  // Sequential read detection, used only for data blocks.
+  uint64_t next_block_offset_ = 0;
+  size_t num_sequential_blocks_ = 0;
+  uint64_t readahead_size_ = kInitialReadaheadSize / 2;
+  // End of the already prefetched part of the file.
+  uint64_t readahead_limit_ = 0;
 };
 
 
@@ -297,6 +358,7 @@ void BlockBasedTable::SetupCacheKeyPrefix(Rep* rep,
     FileReaderWithCachePrefix* reader_with_cache_prefix) {
   reader_with_cache_prefix->cache_key_prefix.size = 0;
   reader_with_cache_prefix->compressed_cache_key_prefix.size = 0;
+  reader_with_cache_prefix->persistent_cache_key_prefix.size = 0;
   if (rep->table_options.block_cache != nullptr) {
     GenerateCachePrefix(rep->table_options.block_cache.get(),
         reader_with_cache_prefix->reader->file(),
@@ -307,6 +369,11 @@ void BlockBasedTable::SetupCacheKeyPrefix(Rep* rep,
         reader_with_cache_prefix->reader->file(),
         &reader_with_cache_prefix->compressed_cache_key_prefix);
   }
+  if (rep->table_options.persistent_cache != nullptr) {
+    GenerateCachePrefix(rep->table_options.persistent_cache.get(),
+        reader_with_cache_prefix->reader->file(),
+        &reader_with_cache_prefix->persistent_cache_key_prefix);
+  }
 }
 
 BlockBasedTable::FileReaderWithCachePrefix* BlockBasedTable::GetBlockReader(BlockType block_type) {
@@ -325,7 +392,8 @@ BloomFilterAwareFileFilter::BloomFilterAwareFileFilter(
 
 bool BloomFilterAwareFileFilter::Filter(TableReader* reader) const {
   auto table = down_cast<BlockBasedTable*>(reader);
-  if (table->rep_->filter_type == FilterType::kFixedSizeFilter) {
+  if (table->rep_->filter_type == FilterType::kFixedSizeFilter &&
+      table->CanFilterUserKey(user_key_)) {
     const auto filter_key = table->GetFilterKeyFromUserKey(user_key_);
     auto filter_entry = table->GetFilter(read_options_.query_id,
         read_options_.read_tier == kBlockCacheTier /* no_io */, &filter_key);
@@ -340,7 +408,8 @@ bool BloomFilterAwareFileFilter::Filter(TableReader* reader) const {
     return use_file;
   } else {
     // For non fixed-size filters - take file into account. We are only using fixed-size bloom
-    // filters for DocDB, so not need to support others.
+    // filters for DocDB, so not need to support others. The same for keys that could not be
+    // checked against the filter.
     return true;
   }
 }
@@ -467,6 +536,21 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
         "Cannot find Properties block from file.");
   }
 
+  // Read the dictionary data blocks are compressed with.
+  BlockHandle compression_dict_handle;
+  if (FindMetaBlock(meta_iter.get(), kCompressionDictBlock, &compression_dict_handle).ok()) {
+    BlockContents compression_dict_block;
+    s = ReadBlockContents(
+        rep->base_reader_with_cache_prefix->reader.get(), rep->footer, ReadOptions::kDefault,
+        compression_dict_handle, &compression_dict_block, rep->ioptions.env, rep->mem_tracker,
+        true /* do_uncompress */);
+    if (!s.ok()) {
+      return s;
+    }
+    rep->uncompression_dict = std::make_unique<UncompressionDict>(
+        compression_dict_block.data.ToBuffer());
+  }
+
   // Determine whether whole key filtering is supported.
   if (rep->table_properties) {
     rep->whole_key_filtering &=
@@ -500,9 +584,13 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
     // pre-fetching of blocks is turned on
     // NOTE: Table reader objects are cached in table cache (table_cache.cc).
     if (rep->filter_policy && rep->filter_type == FilterType::kFixedSizeFilter) {
-      // TODO: may be put it in block cache instead of table reader in case
-      // table_options.cache_index_and_filter_blocks is set?
+      // The filter index is kept in the table reader, so it is always available without
+      // touching the block cache, while filter blocks themselves are loaded on demand.
       s = new_table->CreateFilterIndexReader(&rep->filter_index_reader);
+      if (s.ok() && table_options.cache_index_and_filter_blocks &&
+          table_options.fixed_size_filter_prefetch_bytes > 0) {
+        new_table->PrefetchFixedSizeFilterBlocks(table_options.fixed_size_filter_prefetch_bytes);
+      }
     }
 
     // Will use block cache for filter blocks access?
@@ -681,6 +769,31 @@ Tickers GetBlockCacheHitTicker(BlockType block_type) {
   FATAL_INVALID_ENUM_VALUE(BlockType, block_type);
 }
 
+// Persistent cache keeps block contents in the same form as they are stored in the file, followed
+// by the compression type.
+std::unique_ptr<Block> GetBlockFromPersistentCache(
+    PersistentCache* persistent_cache, const Slice& key,
+    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+  std::unique_ptr<char[]> data;
+  size_t size = 0;
+  if (!persistent_cache->Lookup(key, &data, &size).ok() || size == 0) {
+    return nullptr;
+  }
+  auto compression_type = static_cast<CompressionType>(data[size - 1]);
+  return std::make_unique<Block>(BlockContents(
+      std::move(data), size - 1, true /* cachable */, compression_type, mem_tracker));
+}
+
+void PutBlockToPersistentCache(
+    PersistentCache* persistent_cache, const Slice& key, const Block& raw_block) {
+  std::string data;
+  data.reserve(raw_block.size() + 1);
+  data.append(raw_block.data(), raw_block.size());
+  data.push_back(static_cast<char>(raw_block.compression_type()));
+  // Failure to populate the secondary cache tier does not affect the read.
+  WARN_NOT_OK(persistent_cache->Insert(key, data), "Failed to insert block to persistent cache");
+}
+
 } // namespace
 
 Status BlockBasedTable::GetDataBlockFromCache(
@@ -688,7 +801,7 @@ Status BlockBasedTable::GetDataBlockFromCache(
     Cache* block_cache, Cache* block_cache_compressed, Statistics* statistics,
     const ReadOptions& read_options, BlockBasedTable::CachableEntry<Block>* block,
     uint32_t format_version, BlockType block_type,
-    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+    const std::shared_ptr<yb::MemTracker>& mem_tracker, const UncompressionDict* dict) {
   Status s;
   Block* compressed_block = nullptr;
   Cache::Handle* block_cache_compressed_handle = nullptr;
@@ -732,7 +845,7 @@ Status BlockBasedTable::GetDataBlockFromCache(
   // Retrieve the uncompressed contents into a new buffer
   BlockContents contents;
   s = UncompressBlockContents(compressed_block->data(), compressed_block->size(), &contents,
-                              format_version, mem_tracker);
+                              format_version, mem_tracker, dict);
 
   // Insert uncompressed block into block cache
   if (s.ok()) {
@@ -760,16 +873,13 @@ Status BlockBasedTable::PutDataBlockToCache(
     Cache* block_cache, Cache* block_cache_compressed,
     const ReadOptions& read_options, Statistics* statistics,
     CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
-  assert(raw_block->compression_type() == kNoCompression ||
-         block_cache_compressed != nullptr);
-
+    const std::shared_ptr<yb::MemTracker>& mem_tracker, const UncompressionDict* dict) {
   Status s;
   // Retrieve the uncompressed contents into a new buffer
   BlockContents contents;
   if (raw_block->compression_type() != kNoCompression) {
     s = UncompressBlockContents(raw_block->data(), raw_block->size(), &contents,
-                                format_version, mem_tracker);
+                                format_version, mem_tracker, dict);
   }
   if (!s.ok()) {
     delete raw_block;
@@ -870,6 +980,57 @@ FilterBlockReader* BlockBasedTable::ReadFilterBlock(const BlockHandle& filter_ha
   return nullptr;
 }
 
+void BlockBasedTable::PrefetchFixedSizeFilterBlocks(size_t max_bytes) {
+  Cache* block_cache = rep_->table_options.block_cache.get();
+  if (block_cache == nullptr) {
+    return;
+  }
+  Statistics* statistics = rep_->ioptions.statistics;
+  BlockIter fiter;
+  rep_->filter_index_reader->NewIterator(&fiter,
+      // Following parameters are ignored by BinarySearchIndexReader which we use as
+      // filter_index_reader.
+      nullptr /* index_iterator_state */, true /* total_order_seek */);
+  size_t prefetched_bytes = 0;
+  for (fiter.SeekToFirst(); fiter.Valid(); fiter.Next()) {
+    BlockHandle filter_block_handle;
+    Slice filter_block_handle_encoded = fiter.value();
+    if (!filter_block_handle.DecodeFrom(&filter_block_handle_encoded).ok()) {
+      RLOG(InfoLogLevel::ERROR_LEVEL, rep_->ioptions.info_log,
+          "Failed to decode fixed-size filter block handle from filter index.");
+      return;
+    }
+    if (prefetched_bytes + filter_block_handle.size() > max_bytes) {
+      break;
+    }
+
+    char cache_key_buffer[block_based_table::kCacheKeyBufferSize];
+    auto filter_block_cache_key = GetCacheKey(
+        rep_->base_reader_with_cache_prefix->cache_key_prefix, filter_block_handle,
+        cache_key_buffer);
+    // Lookup directly, to avoid affecting filter block cache hit/miss statistics.
+    auto cache_handle = block_cache->Lookup(filter_block_cache_key, kDefaultQueryId);
+    if (cache_handle == nullptr) {
+      size_t filter_size = 0;
+      auto* filter = ReadFilterBlock(filter_block_handle, rep_, &filter_size);
+      if (filter == nullptr) {
+        return;
+      }
+      Status s = block_cache->Insert(filter_block_cache_key, kDefaultQueryId,
+                                     filter, filter_size,
+                                     &DeleteCachedEntry<FilterBlockReader>, &cache_handle,
+                                     statistics);
+      if (!s.ok()) {
+        delete filter;
+        return;
+      }
+      RecordTick(statistics, BLOCK_CACHE_FILTER_PREFETCH);
+    }
+    block_cache->Release(cache_handle);
+    prefetched_bytes += filter_block_handle.size();
+  }
+}
+
 Status BlockBasedTable::GetFixedSizeFilterBlockHandle(const Slice& filter_key,
     BlockHandle* filter_block_handle) const {
   // Determine block of fixed-size bloom filter using filter index.
@@ -900,6 +1061,10 @@ Slice BlockBasedTable::GetFilterKeyFromUserKey(const Slice &user_key) const {
       rep_->filter_key_transformer->Transform(user_key) : user_key;
 }
 
+bool BlockBasedTable::CanFilterUserKey(const Slice& user_key) const {
+  return !rep_->filter_key_transformer || rep_->filter_key_transformer->CanFilter(user_key);
+}
+
 BlockBasedTable::CachableEntry<FilterBlockReader> BlockBasedTable::GetFilter(
     const QueryId query_id,
     bool no_io,
@@ -1122,6 +1287,9 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
   }
 
   FileReaderWithCachePrefix* reader = GetBlockReader(block_type);
+  // Only data blocks are compressed with the dictionary.
+  const UncompressionDict* dict =
+      block_type == BlockType::kData ? rep_->uncompression_dict.get() : nullptr;
 
   // If either block cache is enabled, we'll try to read from it.
   if (block_cache != nullptr || block_cache_compressed != nullptr) {
@@ -1142,21 +1310,35 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
 
     s = GetDataBlockFromCache(
         key, ckey, block_cache, block_cache_compressed, statistics, ro, &block,
-        rep_->table_options.format_version, block_type, rep_->mem_tracker);
+        rep_->table_options.format_version, block_type, rep_->mem_tracker, dict);
 
     if (block.value == nullptr && !no_io && ro.fill_cache) {
       std::unique_ptr<Block> raw_block;
-      {
+      PersistentCache* persistent_cache =
+          block_cache != nullptr ? rep_->table_options.persistent_cache.get() : nullptr;
+      char persistent_cache_key[block_based_table::kCacheKeyBufferSize];
+      Slice pkey /* key to the persistent cache */;
+      if (persistent_cache != nullptr) {
+        pkey = GetCacheKey(reader->persistent_cache_key_prefix, handle, persistent_cache_key);
+        raw_block = GetBlockFromPersistentCache(persistent_cache, pkey, rep_->mem_tracker);
+      }
+      if (raw_block == nullptr) {
         StopWatch sw(rep_->ioptions.env, statistics, READ_BLOCK_GET_MICROS);
+        // Persistent cache stores blocks in the form they have in the file, so decompression is
+        // done by PutDataBlockToCache in this case.
         s = block_based_table::ReadBlockFromFile(
             reader->reader.get(), rep_->footer, ro, handle, &raw_block, rep_->ioptions.env,
-            rep_->mem_tracker, block_cache_compressed == nullptr);
+            rep_->mem_tracker, block_cache_compressed == nullptr && persistent_cache == nullptr,
+            dict);
+        if (s.ok() && persistent_cache != nullptr && raw_block->cachable()) {
+          PutBlockToPersistentCache(persistent_cache, pkey, *raw_block);
+        }
       }
 
       if (s.ok()) {
         s = PutDataBlockToCache(key, ckey, block_cache, block_cache_compressed,
                                 ro, statistics, &block, raw_block.release(),
-                                rep_->table_options.format_version, rep_->mem_tracker);
+                                rep_->table_options.format_version, rep_->mem_tracker, dict);
       }
     }
   }
@@ -1175,7 +1357,7 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
     std::unique_ptr<Block> block_value;
     s = block_based_table::ReadBlockFromFile(
         reader->reader.get(), rep_->footer, ro, handle, &block_value, rep_->ioptions.env,
-        rep_->mem_tracker);
+        rep_->mem_tracker, true /* do_uncompress */, dict);
     if (s.ok()) {
       block.value = block_value.release();
     }
@@ -1183,7 +1365,10 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
 
   InternalIterator* iter;
   if (s.ok() && block.value != nullptr) {
-    iter = block.value->NewIterator(rep_->comparator.get(), input_iter);
+    iter = block.value->NewIterator(
+        rep_->comparator.get(), input_iter, true /* total_order_seek */,
+        block_type == BlockType::kData
+            ? rep_->table_options.data_block_hash_index_key_transform.get() : nullptr);
     if (block.cache_handle != nullptr) {
       iter->RegisterCleanup(&ReleaseCachedEntry, block_cache,
           block.cache_handle);
@@ -1220,6 +1405,9 @@ bool BlockBasedTable::PrefixMayMatch(const Slice& internal_key) {
 
   assert(rep_->ioptions.prefix_extractor != nullptr);
   auto user_key = ExtractUserKey(internal_key);
+  if (!CanFilterUserKey(user_key)) {
+    return true;
+  }
   auto filter_key = rep_->filter_key_transformer ?
       rep_->filter_key_transformer->Transform(user_key) : user_key;
   if (!rep_->ioptions.prefix_extractor->InDomain(filter_key) ||
@@ -1337,6 +1525,9 @@ Status BlockBasedTable::Get(const ReadOptions& read_options, const Slice& intern
   Status s;
   CachableEntry<FilterBlockReader> filter_entry;
   Slice filter_key;
+  if (!skip_filters && !CanFilterUserKey(ExtractUserKey(internal_key))) {
+    skip_filters = true;
+  }
   if (!skip_filters) {
     filter_key = GetFilterKeyFromInternalKey(internal_key);
     filter_entry = GetFilter(read_options.query_id,
@@ -1613,6 +1804,29 @@ uint64_t BlockBasedTable::ApproximateOffsetOf(const Slice& key) {
   return result;
 }
 
+yb::Result<std::string> BlockBasedTable::GetMiddleKey() {
+  unique_ptr<InternalIterator> index_iter(NewIndexIterator(ReadOptions::kDefault));
+
+  size_t num_entries = 0;
+  for (index_iter->SeekToFirst(); index_iter->Valid(); index_iter->Next()) {
+    ++num_entries;
+  }
+  RETURN_NOT_OK(index_iter->status());
+  if (num_entries == 0) {
+    return STATUS(Incomplete, "Empty data index");
+  }
+
+  index_iter->SeekToFirst();
+  for (size_t i = 0; i < num_entries / 2 && index_iter->Valid(); ++i) {
+    index_iter->Next();
+  }
+  RETURN_NOT_OK(index_iter->status());
+  if (!index_iter->Valid()) {
+    return STATUS(Incomplete, "Data index changed while looking for middle key");
+  }
+  return index_iter->key().ToBuffer();
+}
+
 bool BlockBasedTable::TEST_filter_block_preloaded() const {
   return rep_->filter != nullptr;
 }
@@ -1836,6 +2050,30 @@ Status BlockBasedTable::DumpDataBlocks(WritableFile* out_file) {
   return Status::OK();
 }
 
+Status BlockBasedTable::VisitDataBlocks(const DataBlockVisitor& visitor) {
+  std::unique_ptr<InternalIterator> blockhandles_iter(NewIndexIterator(ReadOptions::kDefault));
+  RETURN_NOT_OK(blockhandles_iter->status());
+
+  FileReaderWithCachePrefix* reader = GetBlockReader(BlockType::kData);
+  for (blockhandles_iter->SeekToFirst(); blockhandles_iter->Valid(); blockhandles_iter->Next()) {
+    BlockHandle handle;
+    Slice input = blockhandles_iter->value();
+    RETURN_NOT_OK(handle.DecodeFrom(&input));
+
+    std::unique_ptr<Block> block;
+    RETURN_NOT_OK(block_based_table::ReadBlockFromFile(
+        reader->reader.get(), rep_->footer, ReadOptions::kDefault, handle, &block,
+        rep_->ioptions.env, rep_->mem_tracker, true /* do_uncompress */,
+        rep_->uncompression_dict.get()));
+    std::unique_ptr<InternalIterator> datablock_iter(block->NewIterator(
+        rep_->comparator.get(), nullptr /* iter */, true /* total_order_seek */,
+        rep_->table_options.data_block_hash_index_key_transform.get()));
+    RETURN_NOT_OK(datablock_iter->status());
+    visitor(handle.size(), block->size(), datablock_iter.get());
+  }
+  return blockhandles_iter->status();
+}
+
 const ImmutableCFOptions& BlockBasedTable::ioptions() {
   return rep_->ioptions;
 }
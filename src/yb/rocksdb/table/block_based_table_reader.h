@@ -49,6 +49,7 @@ class FilterBlockReader;
 class BlockBasedFilterBlockReader;
 class FullFilterBlockReader;
 class Footer;
+class UncompressionDict;
 class InternalKeyComparator;
 class Iterator;
 class TableCache;
@@ -178,6 +179,12 @@ class BlockBasedTable : public TableReader {
   // convert SST file to a human readable form
   Status DumpTable(WritableFile* out_file) override;
 
+  Status VisitDataBlocks(const DataBlockVisitor& visitor) override;
+
+  // Returns the key of the middle entry of the data index, so data blocks at both sides of it
+  // have about the same size.
+  yb::Result<std::string> GetMiddleKey() override;
+
   // input_iter: if it is not null, update this one and return it as Iterator
   InternalIterator* NewDataBlockIterator(
       const ReadOptions& ro, const Slice& index_value, BlockType block_type,
@@ -212,6 +219,9 @@ class BlockBasedTable : public TableReader {
   // Returns key to be added to filter or verified against filter based on user_key.
   Slice GetFilterKeyFromUserKey(const Slice& user_key) const;
 
+  // Returns false if the filter could not be used to check user_key.
+  bool CanFilterUserKey(const Slice& user_key) const;
+
   // If `no_io == true`, we will not try to read filter/index from sst file (except fixed-size
   // filter blocks) were they not present in cache yet.
   // filter_key is only required when using fixed-size bloom filter in order to use the filter index
@@ -247,7 +257,8 @@ class BlockBasedTable : public TableReader {
       Cache* block_cache, Cache* block_cache_compressed, Statistics* statistics,
       const ReadOptions& read_options, BlockBasedTable::CachableEntry<Block>* block,
       uint32_t format_version, BlockType block_type,
-      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+      const UncompressionDict* dict = nullptr);
 
   // Put a raw block (maybe compressed) to the corresponding block caches.
   // This method will perform decompression against raw_block if needed and then
@@ -262,7 +273,8 @@ class BlockBasedTable : public TableReader {
       Cache* block_cache, Cache* block_cache_compressed,
       const ReadOptions& read_options, Statistics* statistics,
       CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+      const UncompressionDict* dict = nullptr);
 
   // Calls (*handle_result)(arg, ...) repeatedly, starting with the entry found
   // after a call to Seek(key), until handle_result returns false.
@@ -294,6 +306,10 @@ class BlockBasedTable : public TableReader {
   // CreateFilterIndexReader from sst
   Status CreateFilterIndexReader(std::unique_ptr<IndexReader>* filter_index_reader);
 
+  // Loads fixed-size filter blocks into the block cache in key order, until their total size
+  // reaches max_bytes. Requires filter_index_reader to be created.
+  void PrefetchFixedSizeFilterBlocks(size_t max_bytes);
+
   // Helper function to setup the cache key's prefix for block of file passed within a reader
   // instance. Used for both data and metadata files.
   static void SetupCacheKeyPrefix(Rep* rep, FileReaderWithCachePrefix* reader_with_cache_prefix);
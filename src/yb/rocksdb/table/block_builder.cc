@@ -44,6 +44,20 @@
 //     restarts: uint32[num_restarts]
 //     num_restarts: uint32
 // restarts[i] contains the offset within the block of the ith restart point.
+// Data blocks could also contain a hash index, see data_block_hash_index.h for the layout.
+//
+// Data blocks built with the shared suffix encoding also omit the suffix shared with the previous
+// key. DocDB keys of the same row often differ only in the middle, i.e. in the column id, while the
+// encoded hybrid time and the sequence number after it, or their trailing bytes, are the same:
+//     shared_bytes: varint32
+//     unshared_bytes: varint32
+//     value_length: varint32
+//     shared_suffix_bytes: varint32
+//     key_delta: char[unshared_bytes]
+//     value: char[value_length]
+// The key is prev_key[0, shared_bytes) + key_delta + last shared_suffix_bytes of prev_key.
+// shared_bytes == shared_suffix_bytes == 0 for restart points. Such blocks are marked in the
+// footer.
 
 #include "yb/rocksdb/table/block_builder.h"
 
@@ -53,6 +67,7 @@
 
 #include "yb/rocksdb/comparator.h"
 #include "yb/rocksdb/db/dbformat.h"
+#include "yb/rocksdb/slice_transform.h"
 #include "yb/rocksdb/util/coding.h"
 
 namespace rocksdb {
@@ -67,6 +82,19 @@ BlockBuilder::BlockBuilder(int block_restart_interval, bool use_delta_encoding)
   restarts_.push_back(0);       // First restart point is at offset 0
 }
 
+BlockBuilder::BlockBuilder(int block_restart_interval,
+                           bool use_delta_encoding,
+                           const SliceTransform* hash_index_key_transform,
+                           double hash_index_util_ratio,
+                           bool shared_suffix_encoding)
+    : BlockBuilder(block_restart_interval, use_delta_encoding) {
+  shared_suffix_encoding_ = use_delta_encoding && shared_suffix_encoding;
+  if (hash_index_key_transform != nullptr) {
+    hash_index_key_transform_ = hash_index_key_transform;
+    hash_index_builder_ = std::make_unique<DataBlockHashIndexBuilder>(hash_index_util_ratio);
+  }
+}
+
 void BlockBuilder::Reset() {
   buffer_.clear();
   restarts_.clear();
@@ -74,6 +102,10 @@ void BlockBuilder::Reset() {
   counter_ = 0;
   finished_ = false;
   last_key_.clear();
+  if (hash_index_builder_) {
+    hash_index_builder_->Reset();
+    has_last_hash_index_prefix_ = false;
+  }
 }
 
 size_t BlockBuilder::CurrentSizeEstimate() const {
@@ -82,6 +114,9 @@ size_t BlockBuilder::CurrentSizeEstimate() const {
     // Restarts haven't been flushed to buffer yet.
     size += restarts_.size() * sizeof(uint32_t) +    // Restart array.
             sizeof(uint32_t);                        // Restart array length.
+    if (hash_index_builder_ && hash_index_builder_->valid()) {
+      size += hash_index_builder_->EstimateSize();
+    }
   }
   return size;
 }
@@ -97,6 +132,9 @@ size_t BlockBuilder::EstimateSizeAfterKV(const Slice& key, const Slice& value)
   estimate += sizeof(int32_t); // varint for shared prefix length.
   estimate += VarintLength(key.size()); // varint for key length.
   estimate += VarintLength(value.size()); // varint for value length.
+  if (shared_suffix_encoding_) {
+    estimate += sizeof(int32_t); // varint for shared suffix length.
+  }
 
   return estimate;
 }
@@ -110,7 +148,12 @@ Slice BlockBuilder::Finish() {
   for (size_t i = 0; i < restarts_.size(); i++) {
     PutFixed32(&buffer_, restarts_[i]);
   }
-  PutFixed32(&buffer_, static_cast<uint32_t>(restarts_.size()));
+  const auto num_restarts = static_cast<uint32_t>(restarts_.size());
+  const bool has_hash_index = hash_index_builder_ && hash_index_builder_->valid();
+  if (has_hash_index) {
+    hash_index_builder_->Finish(&buffer_);
+  }
+  PutFixed32(&buffer_, PackDataBlockFooter(has_hash_index, shared_suffix_encoding_, num_restarts));
   finished_ = true;
   return Slice(buffer_);
 }
@@ -120,6 +163,7 @@ void BlockBuilder::Add(const Slice& key, const Slice& value) {
   assert(!finished_);
   assert(counter_ <= block_restart_interval_);
   size_t shared = 0;  // number of bytes shared with prev key
+  size_t shared_suffix = 0;  // number of bytes at the end shared with prev key
   if (counter_ >= block_restart_interval_) {
     // Restart compression
     restarts_.push_back(static_cast<uint32_t>(buffer_.size()));
@@ -130,23 +174,58 @@ void BlockBuilder::Add(const Slice& key, const Slice& value) {
     while ((shared < min_length) && (last_key_piece[shared] == key[shared])) {
       shared++;
     }
+    if (shared_suffix_encoding_) {
+      const size_t max_suffix = min_length - shared;
+      while (shared_suffix < max_suffix &&
+             last_key_piece[last_key_piece.size() - 1 - shared_suffix] ==
+                 key[key.size() - 1 - shared_suffix]) {
+        shared_suffix++;
+      }
+    }
   }
-  const size_t non_shared = key.size() - shared;
+  const size_t non_shared = key.size() - shared - shared_suffix;
 
-  // Add "<shared><non_shared><value_size>" to buffer_
+  // Add "<shared><non_shared><value_size>[<shared_suffix>]" to buffer_
   PutVarint32(&buffer_, static_cast<uint32_t>(shared));
   PutVarint32(&buffer_, static_cast<uint32_t>(non_shared));
   PutVarint32(&buffer_, static_cast<uint32_t>(value.size()));
+  if (shared_suffix_encoding_) {
+    PutVarint32(&buffer_, static_cast<uint32_t>(shared_suffix));
+  }
 
   // Add string delta to buffer_ followed by value
   buffer_.append(key.cdata() + shared, non_shared);
   buffer_.append(value.cdata(), value.size());
 
+  if (hash_index_builder_) {
+    AddToHashIndex(key);
+  }
+
   // Update state
-  last_key_.resize(shared);
-  last_key_.append(key.cdata() + shared, non_shared);
+  if (shared_suffix == 0) {
+    last_key_.resize(shared);
+    last_key_.append(key.cdata() + shared, non_shared);
+  } else {
+    last_key_.assign(key.cdata(), key.size());
+  }
   assert(Slice(last_key_) == key);
   counter_++;
 }
 
+void BlockBuilder::AddToHashIndex(const Slice& key) {
+  const Slice user_key = ExtractUserKey(key);
+  if (!hash_index_key_transform_->InDomain(user_key)) {
+    has_last_hash_index_prefix_ = false;
+    return;
+  }
+  const Slice prefix = hash_index_key_transform_->Transform(user_key);
+  // Keys with the same prefix are adjacent, so only the first one is added to the index.
+  if (has_last_hash_index_prefix_ && prefix == Slice(last_hash_index_prefix_)) {
+    return;
+  }
+  hash_index_builder_->Add(prefix, restarts_.size() - 1);
+  last_hash_index_prefix_.assign(prefix.cdata(), prefix.size());
+  has_last_hash_index_prefix_ = true;
+}
+
 }  // namespace rocksdb
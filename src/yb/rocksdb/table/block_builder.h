@@ -25,11 +25,16 @@
 #define YB_ROCKSDB_TABLE_BLOCK_BUILDER_H
 
 #include <stdint.h>
+#include <memory>
+#include <string>
 #include <vector>
 #include "yb/util/slice.h"
+#include "yb/rocksdb/table/data_block_hash_index.h"
 
 namespace rocksdb {
 
+class SliceTransform;
+
 class BlockBuilder {
  public:
   BlockBuilder(const BlockBuilder&) = delete;
@@ -38,6 +43,17 @@ class BlockBuilder {
   explicit BlockBuilder(int block_restart_interval,
                         bool use_delta_encoding = true);
 
+  // Builds data blocks with the in-block hash index (see data_block_hash_index.h), when
+  // hash_index_key_transform is not null. Keys added to the block should be internal keys,
+  // hash_index_key_transform is applied to the user key.
+  // When shared_suffix_encoding is true, entries also omit the suffix shared with the previous key
+  // (see block_builder.cc).
+  BlockBuilder(int block_restart_interval,
+               bool use_delta_encoding,
+               const SliceTransform* hash_index_key_transform,
+               double hash_index_util_ratio,
+               bool shared_suffix_encoding = false);
+
   // Reset the contents as if the BlockBuilder was just constructed.
   void Reset();
 
@@ -65,14 +81,23 @@ class BlockBuilder {
   }
 
  private:
+  void AddToHashIndex(const Slice& key);
+
   const int          block_restart_interval_;
   const bool         use_delta_encoding_;
+  bool               shared_suffix_encoding_ = false;
 
   std::string           buffer_;    // Destination buffer
   std::vector<uint32_t> restarts_;  // Restart points
   int                   counter_;   // Number of entries emitted since restart
   bool                  finished_;  // Has Finish() been called?
   std::string           last_key_;
+
+  // Used only when the block is built with the hash index.
+  const SliceTransform* hash_index_key_transform_ = nullptr;
+  std::unique_ptr<DataBlockHashIndexBuilder> hash_index_builder_;
+  std::string           last_hash_index_prefix_;
+  bool                  has_last_hash_index_prefix_ = false;
 };
 
 }  // namespace rocksdb
@@ -243,6 +243,151 @@ TEST_F(BlockTest, IndexHashWithSharedPrefix) {
   CheckBlockContents(std::move(contents), kMaxKey, keys, values);
 }
 
+TEST_F(BlockTest, DataBlockHashIndex) {
+  constexpr int kMaxKey = 400;
+  constexpr int kPrefixGroup = 3;
+  std::vector<std::string> user_keys;
+  std::vector<std::string> values;
+  // Only even primary keys are present, so odd ones could be used to check missing prefixes.
+  GenerateRandomKVs(&user_keys, &values, 0, kMaxKey, 2, 0 /* padding size */, kPrefixGroup);
+  std::vector<std::string> keys;
+  for (const auto& user_key : user_keys) {
+    keys.push_back(InternalKey(user_key, 100, kTypeValue).Encode().ToString());
+  }
+
+  std::unique_ptr<const SliceTransform> transform(NewFixedPrefixTransform(6));
+  InternalKeyComparator comparator(BytewiseComparator());
+  BlockBuilder hash_builder(4, true, transform.get(), 0.75);
+  BlockBuilder plain_builder(4);
+  for (size_t i = 0; i != keys.size(); ++i) {
+    hash_builder.Add(keys[i], values[i]);
+    plain_builder.Add(keys[i], values[i]);
+  }
+
+  BlockContents hash_contents;
+  hash_contents.data = hash_builder.Finish();
+  hash_contents.cachable = false;
+  Block hash_block(std::move(hash_contents));
+  BlockContents plain_contents;
+  plain_contents.data = plain_builder.Finish();
+  plain_contents.cachable = false;
+  Block plain_block(std::move(plain_contents));
+  ASSERT_EQ(plain_block.NumRestarts(), hash_block.NumRestarts());
+  ASSERT_GT(hash_block.size(), plain_block.size());
+
+  std::unique_ptr<InternalIterator> hash_iter(hash_block.NewIterator(
+      &comparator, nullptr /* iter */, true /* total_order_seek */, transform.get()));
+  std::unique_ptr<InternalIterator> plain_iter(plain_block.NewIterator(&comparator));
+
+  // Iterating the block with the hash index should return all keys.
+  size_t count = 0;
+  for (hash_iter->SeekToFirst(); hash_iter->Valid(); hash_iter->Next(), ++count) {
+    ASSERT_EQ(keys[count], hash_iter->key().ToString());
+    ASSERT_EQ(values[count], hash_iter->value().ToString());
+  }
+  ASSERT_EQ(keys.size(), count);
+
+  // Seek to present and missing keys should position both iterators at the same key.
+  Random rnd(301);
+  for (int i = -1; i <= kMaxKey; ++i) {
+    for (int j = 0; j <= kPrefixGroup; ++j) {
+      const auto seq = rnd.OneIn(2) ? 50 : 150;
+      const InternalKey internal_key(GenerateKey(i, j, 0, &rnd), seq, kTypeValue);
+      const Slice target = internal_key.Encode();
+      hash_iter->Seek(target);
+      plain_iter->Seek(target);
+      ASSERT_OK(hash_iter->status());
+      ASSERT_EQ(plain_iter->Valid(), hash_iter->Valid()) << "Target: " << target.ToDebugString();
+      if (plain_iter->Valid()) {
+        ASSERT_EQ(plain_iter->key(), hash_iter->key()) << "Target: " << target.ToDebugString();
+        hash_iter->Prev();
+        plain_iter->Prev();
+        ASSERT_EQ(plain_iter->Valid(), hash_iter->Valid());
+        if (plain_iter->Valid()) {
+          ASSERT_EQ(plain_iter->key(), hash_iter->key());
+        }
+      }
+    }
+  }
+}
+
+TEST_F(BlockTest, SharedSuffixEncoding) {
+  constexpr int kNumRows = 200;
+  constexpr int kNumColumns = 4;
+  Random rnd(301);
+  std::vector<std::string> keys;
+  std::vector<std::string> values;
+  for (int i = 0; i != kNumRows; ++i) {
+    // All columns of the row share the suffix, like DocDB keys written at the same hybrid time.
+    // Some suffixes are long, to check varint encoded lengths.
+    const std::string suffix = RandomString(&rnd, i % 10 == 0 ? 200 : 12);
+    for (int j = 0; j != kNumColumns; ++j) {
+      keys.push_back(InternalKey(
+          GenerateKey(2 * i, j, 0 /* padding size */, &rnd) + suffix, 0, kTypeValue)
+              .Encode().ToString());
+      values.push_back(RandomString(&rnd, 10));
+    }
+  }
+
+  InternalKeyComparator comparator(BytewiseComparator());
+  BlockBuilder suffix_builder(
+      16, true, nullptr /* hash_index_key_transform */, 0.75, true /* shared_suffix_encoding */);
+  BlockBuilder plain_builder(16);
+  for (size_t i = 0; i != keys.size(); ++i) {
+    suffix_builder.Add(keys[i], values[i]);
+    plain_builder.Add(keys[i], values[i]);
+  }
+
+  BlockContents suffix_contents;
+  suffix_contents.data = suffix_builder.Finish();
+  suffix_contents.cachable = false;
+  Block suffix_block(std::move(suffix_contents));
+  BlockContents plain_contents;
+  plain_contents.data = plain_builder.Finish();
+  plain_contents.cachable = false;
+  Block plain_block(std::move(plain_contents));
+  ASSERT_EQ(plain_block.NumRestarts(), suffix_block.NumRestarts());
+  ASSERT_LT(suffix_block.size(), plain_block.size());
+
+  std::unique_ptr<InternalIterator> suffix_iter(suffix_block.NewIterator(&comparator));
+  std::unique_ptr<InternalIterator> plain_iter(plain_block.NewIterator(&comparator));
+
+  size_t count = 0;
+  for (suffix_iter->SeekToFirst(); suffix_iter->Valid(); suffix_iter->Next(), ++count) {
+    ASSERT_EQ(keys[count], suffix_iter->key().ToString());
+    ASSERT_EQ(values[count], suffix_iter->value().ToString());
+  }
+  ASSERT_OK(suffix_iter->status());
+  ASSERT_EQ(keys.size(), count);
+
+  for (suffix_iter->SeekToLast(); suffix_iter->Valid(); suffix_iter->Prev()) {
+    --count;
+    ASSERT_EQ(keys[count], suffix_iter->key().ToString());
+  }
+  ASSERT_EQ(0, count);
+
+  // Seek to present and missing keys should position both iterators at the same key.
+  for (int i = -1; i <= 2 * kNumRows; ++i) {
+    for (int j = 0; j <= kNumColumns; ++j) {
+      const InternalKey internal_key(GenerateKey(i, j, 0, &rnd), 0, kTypeValue);
+      const Slice target = internal_key.Encode();
+      suffix_iter->Seek(target);
+      plain_iter->Seek(target);
+      ASSERT_OK(suffix_iter->status());
+      ASSERT_EQ(plain_iter->Valid(), suffix_iter->Valid()) << "Target: " << target.ToDebugString();
+      if (plain_iter->Valid()) {
+        ASSERT_EQ(plain_iter->key(), suffix_iter->key()) << "Target: " << target.ToDebugString();
+        suffix_iter->Next();
+        plain_iter->Next();
+        ASSERT_EQ(plain_iter->Valid(), suffix_iter->Valid());
+        if (plain_iter->Valid()) {
+          ASSERT_EQ(plain_iter->key(), suffix_iter->key());
+        }
+      }
+    }
+  }
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char **argv) {
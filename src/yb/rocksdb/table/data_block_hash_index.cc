@@ -0,0 +1,115 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rocksdb/table/data_block_hash_index.h"
+
+#include <assert.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "yb/rocksdb/util/hash.h"
+
+namespace rocksdb {
+
+namespace {
+
+constexpr uint32_t kHashIndexFlag = 1u << 31;
+constexpr uint32_t kSharedSuffixFlag = 1u << 30;
+constexpr uint32_t kFooterFlags = kHashIndexFlag | kSharedSuffixFlag;
+constexpr uint32_t kDataBlockHashSeed = 0x7ad9e3b1;
+
+inline uint32_t HashPrefix(const Slice& key_prefix) {
+  return Hash(key_prefix.cdata(), key_prefix.size(), kDataBlockHashSeed);
+}
+
+} // namespace
+
+uint32_t PackDataBlockFooter(
+    bool has_hash_index, bool shared_suffix_encoding, uint32_t num_restarts) {
+  assert((num_restarts & kFooterFlags) == 0);
+  return num_restarts | (has_hash_index ? kHashIndexFlag : 0) |
+         (shared_suffix_encoding ? kSharedSuffixFlag : 0);
+}
+
+void UnpackDataBlockFooter(
+    uint32_t footer, bool* has_hash_index, bool* shared_suffix_encoding, uint32_t* num_restarts) {
+  *has_hash_index = (footer & kHashIndexFlag) != 0;
+  *shared_suffix_encoding = (footer & kSharedSuffixFlag) != 0;
+  *num_restarts = footer & ~kFooterFlags;
+}
+
+void DataBlockHashIndexBuilder::Add(const Slice& key_prefix, size_t restart_index) {
+  if (!valid_) {
+    return;
+  }
+  if (restart_index >= kDataBlockHashIndexMaxRestarts) {
+    valid_ = false;
+    return;
+  }
+  entries_.emplace_back(HashPrefix(key_prefix), static_cast<uint8_t>(restart_index));
+}
+
+uint16_t DataBlockHashIndexBuilder::NumBuckets() const {
+  // Use odd number of buckets for better distribution.
+  const size_t num_buckets = static_cast<size_t>(entries_.size() / util_ratio_) | 1;
+  return static_cast<uint16_t>(
+      std::min<size_t>(num_buckets, std::numeric_limits<uint16_t>::max()));
+}
+
+size_t DataBlockHashIndexBuilder::EstimateSize() const {
+  return NumBuckets() * sizeof(uint8_t) + sizeof(uint16_t);
+}
+
+void DataBlockHashIndexBuilder::Finish(std::string* buffer) {
+  const uint16_t num_buckets = NumBuckets();
+  std::vector<uint8_t> buckets(num_buckets, kDataBlockHashIndexNoEntry);
+  for (const auto& entry : entries_) {
+    auto& bucket = buckets[entry.first % num_buckets];
+    if (bucket == kDataBlockHashIndexNoEntry) {
+      bucket = entry.second;
+    } else if (bucket != entry.second) {
+      // Prefixes that start in the same restart interval could share the bucket, since the seek
+      // would start from the same restart point anyway.
+      bucket = kDataBlockHashIndexCollision;
+    }
+  }
+  buffer->append(reinterpret_cast<const char*>(buckets.data()), num_buckets);
+  buffer->push_back(static_cast<char>(num_buckets & 0xff));
+  buffer->push_back(static_cast<char>(num_buckets >> 8));
+}
+
+void DataBlockHashIndexBuilder::Reset() {
+  valid_ = true;
+  entries_.clear();
+}
+
+size_t DataBlockHashIndex::Initialize(const char* data, size_t end) {
+  if (end < sizeof(uint16_t)) {
+    return 0;
+  }
+  const auto* num_buckets_ptr = reinterpret_cast<const uint8_t*>(data + end - sizeof(uint16_t));
+  const uint16_t num_buckets = num_buckets_ptr[0] | (num_buckets_ptr[1] << 8);
+  if (num_buckets == 0 || end < sizeof(uint16_t) + num_buckets) {
+    return 0;
+  }
+  num_buckets_ = num_buckets;
+  buckets_ = num_buckets_ptr - num_buckets;
+  return end - sizeof(uint16_t) - num_buckets;
+}
+
+uint8_t DataBlockHashIndex::Lookup(const Slice& key_prefix) const {
+  return buckets_[HashPrefix(key_prefix) % num_buckets_];
+}
+
+}  // namespace rocksdb
@@ -0,0 +1,108 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_ROCKSDB_TABLE_DATA_BLOCK_HASH_INDEX_H
+#define YB_ROCKSDB_TABLE_DATA_BLOCK_HASH_INDEX_H
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "yb/util/slice.h"
+
+namespace rocksdb {
+
+// In-block hash index for data blocks. It maps the key prefix (as extracted by
+// BlockBasedTableOptions::data_block_hash_index_key_transform from the user key) to the index of
+// the restart interval that contains the first key with this prefix, so a seek could go directly
+// to that restart interval instead of doing a binary search over restart points.
+//
+// The index is stored right after the restart array:
+//     restarts: uint32[num_restarts]
+//     buckets: uint8[num_buckets]
+//     num_buckets: uint16
+//     footer: uint32
+// The highest bit of the footer is set when the block has a hash index, the next one is set when
+// entries of the block use the shared suffix encoding (see block_builder.cc), the lower bits
+// contain num_restarts. Blocks without these features have exactly the same layout as before.
+//
+// Each bucket contains either a restart index, kDataBlockHashIndexNoEntry or
+// kDataBlockHashIndexCollision, so the index could be used only for blocks with at most
+// kDataBlockHashIndexMaxRestarts restart intervals.
+constexpr uint8_t kDataBlockHashIndexNoEntry = 255;
+constexpr uint8_t kDataBlockHashIndexCollision = 254;
+constexpr uint32_t kDataBlockHashIndexMaxRestarts = 253;
+
+uint32_t PackDataBlockFooter(
+    bool has_hash_index, bool shared_suffix_encoding, uint32_t num_restarts);
+
+void UnpackDataBlockFooter(
+    uint32_t footer, bool* has_hash_index, bool* shared_suffix_encoding, uint32_t* num_restarts);
+
+class DataBlockHashIndexBuilder {
+ public:
+  explicit DataBlockHashIndexBuilder(double util_ratio) : util_ratio_(util_ratio) {}
+
+  // Whether the index could still be built for the current block.
+  bool valid() const {
+    return valid_;
+  }
+
+  // Adds the prefix which starts in the given restart interval. The same prefix should not be
+  // added twice for the same block.
+  void Add(const Slice& key_prefix, size_t restart_index);
+
+  // Appends buckets and num_buckets to buffer.
+  void Finish(std::string* buffer);
+
+  // Estimated number of bytes that Finish would append.
+  size_t EstimateSize() const;
+
+  void Reset();
+
+ private:
+  uint16_t NumBuckets() const;
+
+  const double util_ratio_;
+  bool valid_ = true;
+
+  // Pairs of prefix hash and restart index.
+  std::vector<std::pair<uint32_t, uint8_t>> entries_;
+};
+
+class DataBlockHashIndex {
+ public:
+  DataBlockHashIndex() = default;
+
+  // Initializes the index from the block data, where end is the offset of the block footer.
+  // Returns the offset of the index start, i.e. the end of the restart array, or 0 if the index is
+  // corrupted.
+  size_t Initialize(const char* data, size_t end);
+
+  // Returns restart index for the given key prefix, kDataBlockHashIndexNoEntry or
+  // kDataBlockHashIndexCollision.
+  uint8_t Lookup(const Slice& key_prefix) const;
+
+  bool empty() const {
+    return num_buckets_ == 0;
+  }
+
+ private:
+  const uint8_t* buckets_ = nullptr;
+  uint16_t num_buckets_ = 0;
+};
+
+}  // namespace rocksdb
+
+#endif  // YB_ROCKSDB_TABLE_DATA_BLOCK_HASH_INDEX_H
@@ -24,8 +24,10 @@
 #ifndef ROCKSDB_TABLE_TABLE_READER_H
 #define ROCKSDB_TABLE_TABLE_READER_H
 
+#include <functional>
 #include <memory>
 
+#include "yb/util/result.h"
 #include "yb/util/slice.h"
 
 namespace rocksdb {
@@ -114,6 +116,22 @@ class TableReader {
   virtual Status DumpTable(WritableFile* out_file) {
     return STATUS(NotSupported, "DumpTable() not supported");
   }
+
+  // Invoked for every data block with its size in the file, its size after decompression and an
+  // iterator over its entries, which is valid only during the call.
+  typedef std::function<void(size_t stored_size, size_t uncompressed_size, InternalIterator* iter)>
+      DataBlockVisitor;
+
+  // Visits data blocks of the table in order, used for offline analysis of SST files.
+  virtual Status VisitDataBlocks(const DataBlockVisitor& visitor) {
+    return STATUS(NotSupported, "VisitDataBlocks() not supported");
+  }
+
+  // Returns approximate middle key of the table, i.e. key that splits the table data into two
+  // parts of similar size.
+  virtual yb::Result<std::string> GetMiddleKey() {
+    return STATUS(NotSupported, "GetMiddleKey() not supported");
+  }
 };
 
 }  // namespace rocksdb
@@ -63,6 +63,7 @@
 #include "yb/rocksdb/util/testharness.h"
 #include "yb/rocksdb/util/testutil.h"
 #include "yb/util/enums.h"
+#include "yb/util/format.h"
 
 DECLARE_double(cache_single_touch_ratio);
 
@@ -298,7 +299,7 @@ class TableConstructor: public Constructor {
                             internal_comparator,
                             int_tbl_prop_collector_factories,
                             options.compression,
-                            CompressionOptions(),
+                            options.compression_opts,
                             /* skip_filters */ false),
         TablePropertiesCollectorFactory::Context::kUnknownColumnFamily,
         file_writer_.get()));
@@ -2169,6 +2170,61 @@ TEST_F(GeneralTableTest, ApproximateOffsetOfCompressed) {
   }
 }
 
+namespace {
+
+// Builds a table of small JSON like rows, checks its content and returns size of its data blocks.
+uint64_t BuildCompressionDictTable(CompressionType type, size_t max_dict_bytes) {
+  TableConstructor c(BytewiseComparator());
+  for (int i = 0; i < 5000; ++i) {
+    c.Add(yb::Format("k$0", 100000 + i),
+          yb::Format(R"({"id": $0, "name": "user$0", "status": "active", "country": "$1"})",
+                 i, i % 3 ? "Germany" : "Switzerland"));
+  }
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+  Options options;
+  auto ikc = std::make_shared<test::PlainInternalKeyComparator>(options.comparator);
+  options.compression = type;
+  options.compression_opts.max_dict_bytes = max_dict_bytes;
+  options.compression_opts.max_dict_buffer_bytes = 64 * 1024;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 1024;
+  const ImmutableCFOptions ioptions(options);
+  c.Finish(options, ioptions, table_options, ikc, &keys, &kvmap);
+
+  std::unique_ptr<InternalIterator> iter(c.NewIterator());
+  iter->SeekToFirst();
+  for (const auto& kv : kvmap) {
+    EXPECT_TRUE(iter->Valid());
+    if (!iter->Valid()) {
+      break;
+    }
+    EXPECT_EQ(kv.first, iter->key().ToString());
+    EXPECT_EQ(kv.second, iter->value().ToString());
+    iter->Next();
+  }
+  EXPECT_FALSE(iter->Valid());
+  EXPECT_TRUE(iter->status().ok()) << iter->status();
+  return c.GetTableProperties().data_size;
+}
+
+} // namespace
+
+TEST_F(GeneralTableTest, CompressionDict) {
+  for (auto type : {kLZ4Compression, kZSTDNotFinalCompression}) {
+    if (!CompressionDictSupported(type)) {
+      fprintf(stderr, "skipping %s compression dictionary test\n",
+              CompressionTypeToString(type).c_str());
+      continue;
+    }
+    const auto size_without_dict = BuildCompressionDictTable(type, 0);
+    const auto size_with_dict = BuildCompressionDictTable(type, 16 * 1024);
+    fprintf(stderr, "%s data size without dictionary: %" PRIu64 ", with dictionary: %" PRIu64
+            "\n", CompressionTypeToString(type).c_str(), size_without_dict, size_with_dict);
+    ASSERT_LT(size_with_dict, size_without_dict);
+  }
+}
+
 TEST_F(HarnessTest, Randomized) {
 #if defined(ROCKSDB_TSAN_RUN) || defined(THREAD_SANITIZER)
   static constexpr int kMaxNumEntries = 200;
@@ -111,6 +111,8 @@ struct TablePropertiesNames {
 };
 
 extern const std::string kPropertiesBlock;
+// Name of the meta block with the dictionary data blocks are compressed with.
+extern const std::string kCompressionDictBlock;
 
 enum EntryType {
   kEntryPut,
@@ -30,6 +30,7 @@
 #include "yb/rocksdb/filter_policy.h"
 #include "yb/rocksdb/table/block_based_table_factory.h"
 #include "yb/rocksdb/table/table_builder.h"
+#include "yb/rocksdb/tools/sst_dump_tool_imp.h"
 #include "yb/rocksdb/util/file_reader_writer.h"
 #include "yb/rocksdb/util/testharness.h"
 #include "yb/rocksdb/util/testutil.h"
@@ -225,6 +226,51 @@ TEST_F(SSTDumpToolTest, CompressedSizes) {
     delete[] usage[i];
   }
 }
+
+namespace {
+
+class CountingAnalyzer : public SstKeyValueAnalyzer {
+ public:
+  void Add(const Slice& user_key, const Slice& value) override {
+    ++num_entries;
+    last_key = user_key.ToBuffer();
+  }
+
+  std::string Report() const override {
+    return "Counted entries: " + std::to_string(num_entries) + "\n";
+  }
+
+  uint64_t num_entries = 0;
+  std::string last_key;
+};
+
+} // namespace
+
+TEST_F(SSTDumpToolTest, Analyze) {
+  std::string file_name = "rocksdb_sst_test.sst";
+  createSST(file_name, table_options_);
+
+  SstFileReader reader(file_name, false /* verify_checksum */, false /* output_hex */);
+  ASSERT_OK(reader.getStatus());
+  CountingAnalyzer analyzer;
+  SstAnalysis analysis;
+  ASSERT_OK(reader.Analyze(&analyzer, &analysis));
+
+  ASSERT_EQ(1024U, analyzer.num_entries);
+  ASSERT_EQ("k_1023", analyzer.last_key);
+  ASSERT_EQ(1U, analysis.num_files);
+  ASSERT_EQ(1024U, analysis.num_entries);
+  ASSERT_EQ(0U, analysis.num_deletions);
+  ASSERT_EQ(0U, analysis.num_unparsable_keys);
+  ASSERT_GT(analysis.num_data_blocks, 0U);
+  // The file is not compressed, so every block has compression ratio 1.0.
+  ASSERT_EQ(analysis.data_block_stored_bytes, analysis.data_block_uncompressed_bytes);
+  ASSERT_EQ(1U, analysis.data_blocks_by_compression_ratio.size());
+  ASSERT_EQ(analysis.num_data_blocks, analysis.data_blocks_by_compression_ratio[10]);
+
+  cleanup(file_name);
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
@@ -351,6 +351,73 @@ Status SstFileReader::ReadSequential(bool print_kv,
   return ret;
 }
 
+Status SstFileReader::Analyze(SstKeyValueAnalyzer* analyzer, SstAnalysis* analysis) {
+  if (!table_reader_) {
+    return init_result_;
+  }
+
+  ++analysis->num_files;
+  return table_reader_->VisitDataBlocks(
+      [analyzer, analysis](size_t stored_size, size_t uncompressed_size, InternalIterator* iter) {
+    analysis->AddDataBlock(stored_size, uncompressed_size);
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ParsedInternalKey ikey;
+      if (!ParseInternalKey(iter->key(), &ikey)) {
+        ++analysis->num_unparsable_keys;
+        continue;
+      }
+      analysis->AddEntry(ikey, iter->value());
+      if (analyzer) {
+        analyzer->Add(ikey.user_key, iter->value());
+      }
+    }
+  });
+}
+
+void SstAnalysis::AddDataBlock(size_t stored_size, size_t uncompressed_size) {
+  ++num_data_blocks;
+  data_block_stored_bytes += stored_size;
+  data_block_uncompressed_bytes += uncompressed_size;
+  if (stored_size != 0) {
+    ++data_blocks_by_compression_ratio[uncompressed_size * 10 / stored_size];
+  }
+}
+
+void SstAnalysis::AddEntry(const ParsedInternalKey& key, const Slice& value) {
+  ++num_entries;
+  if (key.type == kTypeDeletion || key.type == kTypeSingleDeletion) {
+    ++num_deletions;
+  } else if (key.type == kTypeMerge) {
+    ++num_merges;
+  }
+  user_key_bytes += key.user_key.size();
+  value_bytes += value.size();
+}
+
+std::string SstAnalysis::ToString() const {
+  std::ostringstream out;
+  out << "Files: " << num_files << "\n"
+      << "Entries: " << num_entries << " (deletions: " << num_deletions
+      << ", merges: " << num_merges << ", unparsable keys: " << num_unparsable_keys << ")\n"
+      << "User key bytes: " << user_key_bytes << "\n"
+      << "Value bytes: " << value_bytes << "\n"
+      << "Data blocks: " << num_data_blocks << "\n"
+      << "Data block bytes stored: " << data_block_stored_bytes
+      << ", uncompressed: " << data_block_uncompressed_bytes << "\n";
+  if (data_block_stored_bytes != 0) {
+    out << "Data compression ratio: "
+        << static_cast<double>(data_block_uncompressed_bytes) / data_block_stored_bytes << "\n";
+  }
+  if (!data_blocks_by_compression_ratio.empty()) {
+    out << "Data blocks by compression ratio:\n";
+    for (const auto& ratio_and_count : data_blocks_by_compression_ratio) {
+      out << "  " << ratio_and_count.first / 10 << "." << ratio_and_count.first % 10 << ": "
+          << ratio_and_count.second << "\n";
+    }
+  }
+  return out.str();
+}
+
 Status SstFileReader::ReadTableProperties(
     std::shared_ptr<const TableProperties>* table_properties) {
   if (!table_reader_) {
@@ -365,7 +432,7 @@ namespace {
 
 void print_help() {
   fprintf(stderr,
-          "sst_dump [--command=check|scan|none|raw] [--verify_checksum] "
+          "sst_dump [--command=check|scan|none|raw|analyze] [--verify_checksum] "
           "--file=data_dir_OR_sst_file"
           " [--output_hex]"
           " [--input_key_hex]"
@@ -466,6 +533,7 @@ int SSTDumpTool::Run(int argc, char** argv) {
       rocksdb::Slice(to_key).ToString(true).c_str());
 
   uint64_t total_read = 0;
+  SstAnalysis analysis;
   for (size_t i = 0; i < filenames.size(); i++) {
     std::string filename = filenames.at(i);
     if (filename.length() <= 4 ||
@@ -508,6 +576,14 @@ int SSTDumpTool::Run(int argc, char** argv) {
       continue;
     }
 
+    if (command == "analyze") {
+      st = reader.Analyze(analyzer_.get(), &analysis);
+      if (!st.ok()) {
+        fprintf(stderr, "%s: %s\n", filename.c_str(), st.ToString().c_str());
+      }
+      continue;
+    }
+
     // scan all files in give file path.
     if (command == "" || command == "scan" || command == "check") {
       st = reader.ReadSequential(command == "scan",
@@ -548,6 +624,12 @@ int SSTDumpTool::Run(int argc, char** argv) {
       }
     }
   }
+  if (command == "analyze") {
+    fprintf(stdout, "%s", analysis.ToString().c_str());
+    if (analyzer_) {
+      fprintf(stdout, "%s", analyzer_->Report().c_str());
+    }
+  }
   return 0;
 }
 }  // namespace rocksdb
@@ -26,6 +26,7 @@
 
 #include "yb/rocksdb/sst_dump_tool.h"
 
+#include <map>
 #include <memory>
 #include <string>
 #include "yb/rocksdb/db/dbformat.h"
@@ -33,6 +34,29 @@
 
 namespace rocksdb {
 
+// Format independent statistics of SST files, collected by --command=analyze.
+struct SstAnalysis {
+  uint64_t num_files = 0;
+  uint64_t num_entries = 0;
+  uint64_t num_deletions = 0;
+  uint64_t num_merges = 0;
+  uint64_t num_unparsable_keys = 0;
+  uint64_t user_key_bytes = 0;
+  uint64_t value_bytes = 0;
+
+  uint64_t num_data_blocks = 0;
+  uint64_t data_block_stored_bytes = 0;
+  uint64_t data_block_uncompressed_bytes = 0;
+  // Number of data blocks by compression ratio, in tenths, i.e. 25 stands for ratios in
+  // [2.5, 2.6).
+  std::map<uint64_t, uint64_t> data_blocks_by_compression_ratio;
+
+  void AddDataBlock(size_t stored_size, size_t uncompressed_size);
+  void AddEntry(const ParsedInternalKey& key, const Slice& value);
+
+  std::string ToString() const;
+};
+
 class SstFileReader {
  public:
   explicit SstFileReader(const std::string& file_name, bool verify_checksum,
@@ -52,6 +76,9 @@ class SstFileReader {
 
   int ShowAllCompressionSizes(size_t block_size);
 
+  // Adds statistics of the file to analysis and passes its entries to analyzer, when specified.
+  Status Analyze(SstKeyValueAnalyzer* analyzer, SstAnalysis* analysis);
+
  private:
   // Get the TableReader implementation for the sst file
   Status GetTableReader(const std::string& file_path);
@@ -34,6 +34,7 @@
 
 #include "yb/rocksdb/port/port.h"
 #include "yb/rocksdb/env.h"
+#include "yb/rocksdb/util/arena_block_pool.h"
 
 #include "yb/util/mem_tracker.h"
 
@@ -61,8 +62,8 @@ size_t OptimizeBlockSize(size_t block_size) {
   return block_size;
 }
 
-Arena::Arena(size_t block_size, size_t huge_page_size)
-    : kBlockSize(OptimizeBlockSize(block_size)) {
+Arena::Arena(size_t block_size, size_t huge_page_size, std::shared_ptr<ArenaBlockPool> block_pool)
+    : kBlockSize(OptimizeBlockSize(block_size)), block_pool_(std::move(block_pool)) {
   assert(kBlockSize >= kMinBlockSize && kBlockSize <= kMaxBlockSize &&
          kBlockSize % kAlignUnit == 0);
   alloc_bytes_remaining_ = sizeof(inline_block_);
@@ -81,6 +82,9 @@ Arena::~Arena() {
   for (const auto& block : blocks_) {
     delete[] block;
   }
+  for (const auto& block : pooled_blocks_) {
+    block_pool_->Return(block);
+  }
 
 #ifdef MAP_HUGETLB
   for (const auto& mmap_info : huge_blocks_) {
@@ -201,6 +205,14 @@ char* Arena::AllocateNewBlock(size_t block_bytes) {
   // this way the insertion into the vector below will not throw and we
   // won't leak the allocated memory in that case. if reserve() throws,
   // we won't leak either
+  if (block_pool_ && block_bytes == block_pool_->block_size()) {
+    pooled_blocks_.reserve(pooled_blocks_.size() + 1);
+    char* block = block_pool_->Borrow();
+    Consumed(block_bytes);
+    pooled_blocks_.push_back(block);
+    return block;
+  }
+
   blocks_.reserve(blocks_.size() + 1);
 
   char* block = new char[block_bytes];
@@ -37,6 +37,7 @@
 
 #include <cstddef>
 #include <cerrno>
+#include <memory>
 #include <vector>
 
 #include "yb/rocksdb/util/allocator.h"
@@ -50,6 +51,8 @@ class MemTracker;
 
 namespace rocksdb {
 
+class ArenaBlockPool;
+
 class Arena : public Allocator {
  public:
   // No copying allowed
@@ -63,7 +66,10 @@ class Arena : public Allocator {
   // huge_page_size: if 0, don't use huge page TLB. If > 0 (should set to the
   // supported hugepage size of the system), block allocation will try huge
   // page TLB first. If allocation fails, will fall back to normal case.
-  explicit Arena(size_t block_size = kMinBlockSize, size_t huge_page_size = 0);
+  // block_pool: if set, regular blocks of the pool block size are borrowed from the pool and
+  // given back to it when the arena is destroyed.
+  explicit Arena(size_t block_size = kMinBlockSize, size_t huge_page_size = 0,
+                 std::shared_ptr<ArenaBlockPool> block_pool = nullptr);
   ~Arena();
 
   char* Allocate(size_t bytes) override;
@@ -112,6 +118,9 @@ class Arena : public Allocator {
   // Array of new[] allocated memory blocks
   typedef std::vector<char*> Blocks;
   Blocks blocks_;
+  // Blocks borrowed from block_pool_.
+  Blocks pooled_blocks_;
+  std::shared_ptr<ArenaBlockPool> block_pool_;
 
   struct MmapInfo {
     void* addr_;
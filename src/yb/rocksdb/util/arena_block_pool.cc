@@ -0,0 +1,73 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rocksdb/util/arena_block_pool.h"
+
+#include "yb/rocksdb/util/arena.h"
+
+#include "yb/util/mem_tracker.h"
+
+namespace rocksdb {
+
+ArenaBlockPool::ArenaBlockPool(
+    size_t block_size, size_t max_idle_bytes, std::shared_ptr<yb::MemTracker> mem_tracker)
+    : block_size_(OptimizeBlockSize(block_size)),
+      max_idle_blocks_(max_idle_bytes / block_size_),
+      mem_tracker_(std::move(mem_tracker)) {
+}
+
+ArenaBlockPool::~ArenaBlockPool() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto* block : idle_blocks_) {
+    delete[] block;
+  }
+  if (mem_tracker_) {
+    mem_tracker_->Release(idle_blocks_.size() * block_size_);
+  }
+}
+
+char* ArenaBlockPool::Borrow() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!idle_blocks_.empty()) {
+      auto* result = idle_blocks_.back();
+      idle_blocks_.pop_back();
+      if (mem_tracker_) {
+        mem_tracker_->Release(block_size_);
+      }
+      return result;
+    }
+  }
+  return new char[block_size_];
+}
+
+void ArenaBlockPool::Return(char* block) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (idle_blocks_.size() < max_idle_blocks_) {
+      idle_blocks_.push_back(block);
+      if (mem_tracker_) {
+        mem_tracker_->Consume(block_size_);
+      }
+      return;
+    }
+  }
+  delete[] block;
+}
+
+size_t ArenaBlockPool::idle_blocks() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return idle_blocks_.size();
+}
+
+}  // namespace rocksdb
@@ -0,0 +1,72 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_ROCKSDB_UTIL_ARENA_BLOCK_POOL_H
+#define YB_ROCKSDB_UTIL_ARENA_BLOCK_POOL_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "yb/gutil/thread_annotations.h"
+
+namespace yb {
+
+class MemTracker;
+
+} // namespace yb
+
+namespace rocksdb {
+
+// Pool of fixed size arena blocks shared by memtables of all RocksDB instances in the process.
+//
+// Memtable arenas borrow their regular blocks from the pool and give them back when the memtable
+// is destroyed after flush, so the memory of flushed memtables is reused by other tablets instead
+// of being returned to the allocator and fragmenting the heap.
+//
+// Borrowed blocks are accounted by the mem tracker of the borrowing arena, idle blocks are
+// accounted by the mem tracker of the pool. At most max_idle_bytes of idle blocks are kept, blocks
+// given back above this limit are freed.
+class ArenaBlockPool {
+ public:
+  ArenaBlockPool(size_t block_size, size_t max_idle_bytes,
+                 std::shared_ptr<yb::MemTracker> mem_tracker);
+  ~ArenaBlockPool();
+
+  ArenaBlockPool(const ArenaBlockPool&) = delete;
+  void operator=(const ArenaBlockPool&) = delete;
+
+  size_t block_size() const {
+    return block_size_;
+  }
+
+  // Returns a block of block_size() bytes, reusing an idle block if there is one.
+  char* Borrow();
+
+  // Gives back a block previously returned by Borrow.
+  void Return(char* block);
+
+  size_t idle_blocks() const;
+
+ private:
+  const size_t block_size_;
+  const size_t max_idle_blocks_;
+  std::shared_ptr<yb::MemTracker> mem_tracker_;
+
+  mutable std::mutex mutex_;
+  std::vector<char*> idle_blocks_ GUARDED_BY(mutex_);
+};
+
+}  // namespace rocksdb
+
+#endif // YB_ROCKSDB_UTIL_ARENA_BLOCK_POOL_H
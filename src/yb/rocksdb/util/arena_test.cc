@@ -22,6 +22,7 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 
 #include "yb/rocksdb/util/arena.h"
+#include "yb/rocksdb/util/arena_block_pool.h"
 #include "yb/rocksdb/util/random.h"
 #include "yb/rocksdb/util/testharness.h"
 
@@ -203,6 +204,35 @@ TEST_F(ArenaTest, Simple) {
   SimpleTest(0);
   SimpleTest(kHugePageSize);
 }
+
+TEST_F(ArenaTest, BlockPool) {
+  const size_t kBlockSize = 8192;
+  auto pool = std::make_shared<ArenaBlockPool>(kBlockSize, 2 * kBlockSize, nullptr);
+  {
+    Arena arena(kBlockSize, 0, pool);
+    // Fills the inline block, so the following allocations take 3 blocks from the pool.
+    arena.Allocate(Arena::kInlineSize);
+    arena.Allocate(100);
+    for (int i = 0; i != 8; ++i) {
+      arena.Allocate(kBlockSize / 4);
+    }
+    // Irregular blocks are not pooled.
+    arena.Allocate(kBlockSize);
+    ASSERT_EQ(0U, pool->idle_blocks());
+  }
+  // Only 2 of the 3 blocks are kept.
+  ASSERT_EQ(2U, pool->idle_blocks());
+
+  {
+    Arena arena(kBlockSize, 0, pool);
+    arena.Allocate(Arena::kInlineSize);
+    arena.Allocate(100);
+    ASSERT_EQ(1U, pool->idle_blocks());
+    ASSERT_EQ(Arena::kInlineSize + kBlockSize, arena.MemoryAllocatedBytes());
+  }
+  ASSERT_EQ(2U, pool->idle_blocks());
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
@@ -21,7 +21,12 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include <cstdlib>
+#include <cstring>
 
 #include "yb/rocksdb/filter_policy.h"
 
@@ -63,6 +68,67 @@ inline void AddHash(uint32_t h, char* data, uint32_t num_lines, uint32_t total_b
   }
 }
 
+// Lines of the line mask format always have 64 bytes independently of CACHE_LINE_SIZE, so filters
+// could be read on any architecture.
+constexpr uint32_t kLineMaskLineSize = 64;
+constexpr uint32_t kLineMaskLineWords = kLineMaskLineSize / sizeof(uint64_t);
+
+// Selects the line of the hash. Does not depend on num_lines being odd.
+inline uint32_t LineMaskLine(uint32_t h, uint32_t num_lines) {
+  return static_cast<uint32_t>((static_cast<uint64_t>(h) * num_lines) >> 32);
+}
+
+// Sets the bits of all probes of the hash in the mask of its line. Line is selected by the high
+// bits of the hash, so probe positions are taken from the high bits of a remixed hash.
+inline void LineMaskProbes(uint32_t h, size_t num_probes, uint64_t* mask) {
+  h ^= h >> 16;
+  h *= 0x85ebca6b;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35;
+  h ^= h >> 16;
+  for (size_t i = 0; i < num_probes; ++i) {
+    const uint32_t bitpos = h >> 23;  // 9 bits for 512 bits of the line.
+    mask[bitpos / 64] |= 1ULL << (bitpos % 64);
+    h *= 0x9e3779b9;
+  }
+}
+
+inline void LineMaskAddHash(uint32_t h, char* data, uint32_t num_lines, size_t num_probes) {
+  uint64_t mask[kLineMaskLineWords] = {};
+  LineMaskProbes(h, num_probes, mask);
+  char* line = data + LineMaskLine(h, num_lines) * kLineMaskLineSize;
+  for (uint32_t i = 0; i < kLineMaskLineWords; ++i) {
+    uint64_t word;
+    memcpy(&word, line + i * sizeof(word), sizeof(word));
+    word |= mask[i];
+    memcpy(line + i * sizeof(word), &word, sizeof(word));
+  }
+}
+
+inline bool LineMaskHashMayMatch(uint32_t h, const char* data, uint32_t num_lines,
+                                 size_t num_probes) {
+  uint64_t mask[kLineMaskLineWords] = {};
+  LineMaskProbes(h, num_probes, mask);
+  const char* line = data + LineMaskLine(h, num_lines) * kLineMaskLineSize;
+#ifdef __SSE2__
+  __m128i missing = _mm_setzero_si128();
+  for (uint32_t i = 0; i < kLineMaskLineWords; i += 2) {
+    const __m128i bits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(line) + i / 2);
+    const __m128i probes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask + i));
+    missing = _mm_or_si128(missing, _mm_andnot_si128(bits, probes));
+  }
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(missing, _mm_setzero_si128())) == 0xffff;
+#else
+  uint64_t missing = 0;
+  for (uint32_t i = 0; i < kLineMaskLineWords; ++i) {
+    uint64_t word;
+    memcpy(&word, line + i * sizeof(word), sizeof(word));
+    missing |= mask[i] & ~word;
+  }
+  return missing == 0;
+#endif
+}
+
 class FullFilterBitsBuilder : public FilterBitsBuilder {
  public:
   explicit FullFilterBitsBuilder(const size_t bits_per_key,
@@ -404,6 +470,9 @@ class BloomFilterPolicy : public FilterPolicy {
 // and M bits for filter data.
 // For compliance with FullFilter, the metadata will be encoded
 // the same way as in FullFilter.
+// In the line mask format num_lines is stored as 0, so readers that do not know this format
+// consider the filter broken and treat it as matching all keys. Number of lines is then derived
+// from the filter size.
 //
 // For detailed proofs on the optimal number of keys and hash functions
 // please refer to https://en.wikipedia.org/wiki/Bloom_filter.
@@ -416,23 +485,25 @@ class FixedSizeFilterBitsBuilder : public FilterBitsBuilder {
   FixedSizeFilterBitsBuilder(const FixedSizeFilterBitsBuilder&) = delete;
   void operator=(const FixedSizeFilterBitsBuilder&) = delete;
 
-  FixedSizeFilterBitsBuilder(uint32_t total_bits, double error_rate)
-      : error_rate_(error_rate) {
+  FixedSizeFilterBitsBuilder(uint32_t total_bits, double error_rate, FixedSizeFilterFormat format)
+      : error_rate_(error_rate), format_(format) {
     DCHECK_GT(error_rate, 0);
     DCHECK_GT(total_bits, 0);
-    num_lines_ = yb::ceil_div(total_bits, CACHE_LINE_SIZE * 8);
+    const uint32_t line_size =
+        format_ == FixedSizeFilterFormat::kLineMask ? kLineMaskLineSize : CACHE_LINE_SIZE;
+    num_lines_ = yb::ceil_div(total_bits, line_size * 8);
     // AddHash implementation gives much higher false positive rate when num_lines_ is even, so
     // make sure it is odd.
     if (num_lines_ % 2 == 0) {
       // For small filter blocks - add one line, so we can have enough keys in block.
       // For bigger filter block - remove one line, so filter block will fit desired size.
-      if (num_lines_ * CACHE_LINE_SIZE < 4096) {
+      if (num_lines_ * line_size < 4096) {
         num_lines_++;
       } else {
         num_lines_--;
       }
     }
-    total_bits_ = num_lines_ * CACHE_LINE_SIZE * 8;
+    total_bits_ = num_lines_ * line_size * 8;
 
     const double minus_log_error_rate = -log(error_rate_);
     DCHECK_GT(minus_log_error_rate, 0);
@@ -453,14 +524,19 @@ class FixedSizeFilterBitsBuilder : public FilterBitsBuilder {
   virtual void AddKey(const Slice& key) override {
     ++keys_added_;
     uint32_t hash = BloomHash(key);
-    AddHash(hash, data_.get(), num_lines_, total_bits_, num_probes_);
+    if (format_ == FixedSizeFilterFormat::kLineMask) {
+      LineMaskAddHash(hash, data_.get(), num_lines_, num_probes_);
+    } else {
+      AddHash(hash, data_.get(), num_lines_, total_bits_, num_probes_);
+    }
   }
 
   virtual bool IsFull() const override { return keys_added_ >= max_keys_; }
 
   virtual Slice Finish(std::unique_ptr<const char[]>* buf) override {
     data_[total_bits_ / 8] = static_cast<char>(num_probes_);
-    EncodeFixed32(data_.get() + total_bits_ / 8 + 1, static_cast<uint32_t>(num_lines_));
+    EncodeFixed32(data_.get() + total_bits_ / 8 + 1,
+                  format_ == FixedSizeFilterFormat::kLineMask ? 0 : num_lines_);
     buf->reset(data_.release());
     return Slice(buf->get(), FilterSize());
   }
@@ -478,6 +554,7 @@ class FixedSizeFilterBitsBuilder : public FilterBitsBuilder {
   uint32_t total_bits_; // total number of bits used for filter (excluding metadata)
   uint32_t num_lines_;
   double error_rate_;
+  const FixedSizeFilterFormat format_;
   size_t num_probes_; // number of hash functions
 };
 
@@ -487,15 +564,50 @@ class FixedSizeFilterBitsReader : public FullFilterBitsReader {
   void operator=(const FixedSizeFilterBitsReader&) = delete;
 
   explicit FixedSizeFilterBitsReader(const Slice& contents, Logger* logger)
-      : FullFilterBitsReader(contents, logger) {}
+      : FullFilterBitsReader(contents, logger) {
+    // Filter of the line mask format has num_lines stored as 0, while filter of the bit probes
+    // format with 0 lines has only the metadata.
+    const size_t len = contents.size();
+    if (len <= FullFilterBitsBuilder::kMetaDataSize || DecodeFixed32(contents.end() - 4) != 0) {
+      return;
+    }
+    const size_t data_size = len - FullFilterBitsBuilder::kMetaDataSize;
+    if (data_size % kLineMaskLineSize != 0) {
+      RLOG(InfoLogLevel::ERROR_LEVEL, logger, "Bloom filter data is broken, won't be used.");
+      FAIL_IF_NOT_PRODUCTION();
+      return;
+    }
+    line_mask_data_ = contents.cdata();
+    line_mask_num_lines_ = static_cast<uint32_t>(data_size / kLineMaskLineSize);
+    line_mask_num_probes_ = static_cast<uint8_t>(contents[data_size]);
+  }
+
+  bool MayMatch(const Slice& entry) override {
+    if (line_mask_num_lines_ == 0) {
+      return FullFilterBitsReader::MayMatch(entry);
+    }
+    if (line_mask_num_probes_ == 0) {
+      return true;
+    }
+    return LineMaskHashMayMatch(
+        BloomHash(entry), line_mask_data_, line_mask_num_lines_, line_mask_num_probes_);
+  }
+
+ private:
+  // Set only for filters of the line mask format.
+  const char* line_mask_data_ = nullptr;
+  uint32_t line_mask_num_lines_ = 0;
+  size_t line_mask_num_probes_ = 0;
 };
 
 class FixedSizeFilterPolicy : public FilterPolicy {
  public:
-  explicit FixedSizeFilterPolicy(uint32_t total_bits, double error_rate, Logger* logger)
+  FixedSizeFilterPolicy(
+      uint32_t total_bits, double error_rate, Logger* logger, FixedSizeFilterFormat format)
       : total_bits_(total_bits),
         error_rate_(error_rate),
-        logger_(logger) {
+        logger_(logger),
+        format_(format) {
     DCHECK_GT(error_rate, 0);
     // Make sure num_probes > 0.
     DCHECK_GT(static_cast<int64_t> (-log(error_rate) / LOG2), 0);
@@ -519,7 +631,7 @@ class FixedSizeFilterPolicy : public FilterPolicy {
   }
 
   virtual FilterBitsBuilder* GetFilterBitsBuilder() const override {
-    return new FixedSizeFilterBitsBuilder(total_bits_, error_rate_);
+    return new FixedSizeFilterBitsBuilder(total_bits_, error_rate_, format_);
   }
 
   virtual FilterBitsReader* GetFilterBitsReader(const Slice& contents) const override {
@@ -532,6 +644,7 @@ class FixedSizeFilterPolicy : public FilterPolicy {
   uint32_t total_bits_;
   double error_rate_;
   Logger* logger_;
+  FixedSizeFilterFormat format_;
 };
 
 }  // namespace
@@ -542,10 +655,9 @@ const FilterPolicy* NewBloomFilterPolicy(int bits_per_key,
   // TODO - replace by NewFixedSizeFilterPolicy and check tests.
 }
 
-const FilterPolicy* NewFixedSizeFilterPolicy(uint32_t total_bits,
-                                             double error_rate,
-                                             Logger* logger) {
-  return new FixedSizeFilterPolicy(total_bits, error_rate, logger);
+const FilterPolicy* NewFixedSizeFilterPolicy(
+    uint32_t total_bits, double error_rate, Logger* logger, FixedSizeFilterFormat format) {
+  return new FixedSizeFilterPolicy(total_bits, error_rate, logger, format);
 }
 
 }  // namespace rocksdb
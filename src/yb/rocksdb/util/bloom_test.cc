@@ -217,6 +217,11 @@ class FullFilterBloomTestContext : public BloomTestContext {
 
 class FixedSizeFilterBloomTestContext : public BloomTestContext {
  public:
+  explicit FixedSizeFilterBloomTestContext(FixedSizeFilterFormat format)
+      : filter_policy_(NewFixedSizeFilterPolicy(
+            FilterPolicy::kDefaultFixedSizeFilterBits,
+            FilterPolicy::kDefaultFixedSizeFilterErrorRate, nullptr, format)) {}
+
   const FilterPolicy& filter_policy() const override { return *filter_policy_.get(); }
 
   // For fixed-size filter we limit maximum number of keys depending on total bits in test itself
@@ -228,13 +233,11 @@ class FixedSizeFilterBloomTestContext : public BloomTestContext {
   }
 
  private:
-  std::unique_ptr<const FilterPolicy> filter_policy_{
-      NewFixedSizeFilterPolicy(
-          FilterPolicy::kDefaultFixedSizeFilterBits, FilterPolicy::kDefaultFixedSizeFilterErrorRate,
-          nullptr)};
+  std::unique_ptr<const FilterPolicy> filter_policy_;
 };
 
-YB_DEFINE_ENUM(BuilderReaderBloomTestType, (kFullFilter)(kFixedSizeFilter));
+YB_DEFINE_ENUM(BuilderReaderBloomTestType,
+               (kFullFilter)(kFixedSizeFilter)(kFixedSizeLineMaskFilter));
 
 namespace {
 
@@ -243,7 +246,9 @@ std::unique_ptr<const BloomTestContext> CreateContext(BuilderReaderBloomTestType
     case BuilderReaderBloomTestType::kFullFilter:
       return std::make_unique<FullFilterBloomTestContext>();
     case BuilderReaderBloomTestType::kFixedSizeFilter:
-      return std::make_unique<FixedSizeFilterBloomTestContext>();
+      return std::make_unique<FixedSizeFilterBloomTestContext>(FixedSizeFilterFormat::kBitProbes);
+    case BuilderReaderBloomTestType::kFixedSizeLineMaskFilter:
+      return std::make_unique<FixedSizeFilterBloomTestContext>(FixedSizeFilterFormat::kLineMask);
   }
   FATAL_INVALID_ENUM_VALUE(BuilderReaderBloomTestType, type);
 }
@@ -372,7 +377,43 @@ TEST_P(BuilderReaderBloomTest, FullVaryingLengths) {
 
 INSTANTIATE_TEST_CASE_P(, BuilderReaderBloomTest, ::testing::Values(
     BuilderReaderBloomTestType::kFullFilter,
-    BuilderReaderBloomTestType::kFixedSizeFilter));
+    BuilderReaderBloomTestType::kFixedSizeFilter,
+    BuilderReaderBloomTestType::kFixedSizeLineMaskFilter));
+
+// Filter blocks of each fixed-size filter format should be read by the policy writing the other
+// format.
+TEST(FixedSizeFilterFormatTest, ReadOtherFormat) {
+  constexpr size_t kNumKeys = 1000;
+  char buffer[sizeof(size_t)];
+  for (auto format : {FixedSizeFilterFormat::kBitProbes, FixedSizeFilterFormat::kLineMask}) {
+    auto other_format = format == FixedSizeFilterFormat::kLineMask
+        ? FixedSizeFilterFormat::kBitProbes : FixedSizeFilterFormat::kLineMask;
+    std::unique_ptr<const FilterPolicy> writer(NewFixedSizeFilterPolicy(
+        FilterPolicy::kDefaultFixedSizeFilterBits, FilterPolicy::kDefaultFixedSizeFilterErrorRate,
+        nullptr, format));
+    std::unique_ptr<const FilterPolicy> reader_policy(NewFixedSizeFilterPolicy(
+        FilterPolicy::kDefaultFixedSizeFilterBits, FilterPolicy::kDefaultFixedSizeFilterErrorRate,
+        nullptr, other_format));
+
+    std::unique_ptr<FilterBitsBuilder> builder(writer->GetFilterBitsBuilder());
+    for (size_t i = 0; i < kNumKeys; ++i) {
+      builder->AddKey(Key(i, buffer));
+    }
+    std::unique_ptr<const char[]> buf;
+    Slice filter = builder->Finish(&buf);
+    std::unique_ptr<FilterBitsReader> reader(reader_policy->GetFilterBitsReader(filter));
+
+    size_t false_positives = 0;
+    for (size_t i = 0; i < kNumKeys; ++i) {
+      ASSERT_TRUE(reader->MayMatch(Key(i, buffer))) << "Key " << i;
+      if (reader->MayMatch(Key(i + 1000000000, buffer))) {
+        ++false_positives;
+      }
+    }
+    // Filter is not full, so the false positive rate should be well below the target one.
+    ASSERT_LE(false_positives, kNumKeys / 100);
+  }
+}
 
 }  // namespace rocksdb
 
@@ -24,6 +24,9 @@
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
+
+#include <vector>
+
 #include <gflags/gflags.h>
 
 #include "yb/util/metrics.h"
@@ -31,6 +34,7 @@
 #include "yb/rocksdb/statistics.h"
 #include "yb/rocksdb/port/port.h"
 #include "yb/rocksdb/util/autovector.h"
+#include "yb/rocksdb/util/cache_simulator.h"
 #include "yb/rocksdb/util/hash.h"
 #include "yb/rocksdb/util/mutexlock.h"
 #include "yb/rocksdb/util/statistics.h"
@@ -42,6 +46,11 @@
 DEFINE_double(cache_single_touch_ratio, 0.2,
               "fraction of the cache dedicated to single-touch items");
 
+DEFINE_bool(cache_frequency_admission, false,
+            "Admit a new item to a full single-touch cache only if its estimated access frequency "
+            "is higher than the frequency of the item it would evict, so large scans do not "
+            "flush frequently used items.");
+
 namespace rocksdb {
 
 Cache::~Cache() {
@@ -354,6 +363,91 @@ void LRUSubCache::LRU_Append(LRUHandle *e) {
   lru_usage_ += e->charge;
 }
 
+// Count-min sketch of access frequencies of cache keys, used for TinyLFU style admission.
+// Each key is counted by 4-bit counters in kDepth rows, its frequency is estimated as the minimum
+// of them. Counters are halved after a number of increments proportional to the sketch size, so
+// recent accesses dominate the estimate.
+class FrequencySketch {
+ public:
+  // Sizes the sketch for a cache of the specified capacity.
+  void Resize(size_t capacity) {
+    // Assume 4KB blocks, but have at least kMinCounters counters per row.
+    size_t counters = kMinCounters;
+    while (counters * 4096 < capacity) {
+      counters *= 2;
+    }
+    if (counters == width_) {
+      return;
+    }
+    width_ = counters;
+    table_.assign(kDepth * width_ / kCountersPerWord, 0);
+    increments_ = 0;
+  }
+
+  void Increment(uint32_t hash) {
+    bool incremented = false;
+    for (size_t row = 0; row != kDepth; ++row) {
+      auto& word = table_[WordIndex(hash, row)];
+      const auto shift = CounterShift(hash, row);
+      if (((word >> shift) & kMaxCount) != kMaxCount) {
+        word += 1ULL << shift;
+        incremented = true;
+      }
+    }
+    if (incremented && ++increments_ >= width_ * 10) {
+      Age();
+    }
+  }
+
+  uint32_t Estimate(uint32_t hash) const {
+    uint64_t result = kMaxCount;
+    for (size_t row = 0; row != kDepth; ++row) {
+      result = std::min(result,
+                        (table_[WordIndex(hash, row)] >> CounterShift(hash, row)) & kMaxCount);
+    }
+    return static_cast<uint32_t>(result);
+  }
+
+ private:
+  static constexpr size_t kDepth = 4;
+  static constexpr size_t kCountersPerWord = 16;
+  static constexpr size_t kMinCounters = 1024;
+  static constexpr uint64_t kMaxCount = 15;
+
+  static uint64_t RowHash(uint32_t hash, size_t row) {
+    static constexpr uint64_t kSeeds[kDepth] = {
+        0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL,
+        0xcbf29ce484222325ULL };
+    return (hash + row) * kSeeds[row];
+  }
+
+  // Counter index in the row is taken from the high bits of the row hash, so it is independent
+  // from the low bits of the key hash, that are used for sampling and sharding.
+  size_t CounterIndex(uint32_t hash, size_t row) const {
+    return (RowHash(hash, row) >> 32) & (width_ - 1);
+  }
+
+  size_t WordIndex(uint32_t hash, size_t row) const {
+    return (row * width_ + CounterIndex(hash, row)) / kCountersPerWord;
+  }
+
+  size_t CounterShift(uint32_t hash, size_t row) const {
+    return (CounterIndex(hash, row) % kCountersPerWord) * 4;
+  }
+
+  void Age() {
+    // Halve all counters at once: shift and drop the bit moved from the neighbouring counter.
+    for (auto& word : table_) {
+      word = (word >> 1) & 0x7777777777777777ULL;
+    }
+    increments_ /= 2;
+  }
+
+  size_t width_ = 0;
+  std::vector<uint64_t> table_;
+  size_t increments_ = 0;
+};
+
 class LRUHandleDeleter {
  public:
   explicit LRUHandleDeleter(yb::CacheMetrics* metrics) : metrics_(metrics) {}
@@ -449,6 +543,11 @@ class LRUCache {
   // Decrements the usage on the appropriate subcache.
   void DecrementUsage(const SubCacheType subcache_type, const size_t charge);
 
+  // Returns whether the entry should be added to the sub cache. Any entry is admitted unless
+  // frequency admission is enabled, and adding the entry would evict a single touch entry that was
+  // accessed at least as frequently.
+  bool Admit(LRUHandle* e, SubCacheType subcache_type);
+
   // Whether to reject insertion if cache reaches its full capacity.
   bool strict_capacity_limit_;
 
@@ -459,6 +558,9 @@ class LRUCache {
 
   HandleTable table_;
 
+  // Access frequencies of keys, maintained only when frequency admission is enabled.
+  FrequencySketch frequency_sketch_;
+
   shared_ptr<yb::CacheMetrics> metrics_;
 };
 
@@ -486,6 +588,18 @@ void LRUCache::DecrementUsage(const SubCacheType subcache_type, const size_t cha
   GetSubCache(subcache_type)->DecrementUsage(charge);
 }
 
+bool LRUCache::Admit(LRUHandle* e, SubCacheType subcache_type) {
+  if (!FLAGS_cache_frequency_admission || subcache_type != SINGLE_TOUCH) {
+    return true;
+  }
+  LRUSubCache* sub_cache = GetSubCache(subcache_type);
+  if (sub_cache->Usage() + e->charge <= sub_cache->Capacity() || sub_cache->IsLRUEmpty()) {
+    return true;
+  }
+  const LRUHandle* victim = sub_cache->LRU_Head().next;
+  return frequency_sketch_.Estimate(e->hash) > frequency_sketch_.Estimate(victim->hash);
+}
+
 // Call deleter and free
 
 void LRUCache::ApplyToAllCacheEntries(void (*callback)(void*, size_t),
@@ -535,6 +649,7 @@ void LRUCache::SetCapacity(size_t capacity) {
     single_touch_sub_cache_.SetCapacity(
       static_cast<size_t>(round(FLAGS_cache_single_touch_ratio * capacity)));
     multi_touch_sub_cache_.SetCapacity(capacity - single_touch_sub_cache_.Capacity());
+    frequency_sketch_.Resize(capacity);
     EvictFromLRU(0, &last_reference_list, SINGLE_TOUCH);
     EvictFromLRU(0, &last_reference_list, MULTI_TOUCH);
   }
@@ -548,6 +663,9 @@ void LRUCache::SetStrictCapacityLimit(bool strict_capacity_limit) {
 Cache::Handle* LRUCache::Lookup(const Slice& key, uint32_t hash, const QueryId query_id,
                                 Statistics* statistics)  {
   MutexLock l(&mutex_);
+  if (FLAGS_cache_frequency_admission) {
+    frequency_sketch_.Increment(hash);
+  }
   LRUHandle* e = table_.Lookup(key, hash);
   if (e != nullptr) {
     assert(e->in_cache);
@@ -703,10 +821,27 @@ Status LRUCache::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
     } else {
       subcache_type = table_.GetSubCacheTypeCandidate(e);
     }
-    EvictFromLRU(charge, &last_reference_list, subcache_type);
     LRUSubCache* sub_cache = GetSubCache(subcache_type);
-    // If the cache no longer has any more space in the given pool.
-    if (strict_capacity_limit_ &&
+    const bool admitted = Admit(e, subcache_type);
+    if (admitted) {
+      EvictFromLRU(charge, &last_reference_list, subcache_type);
+    }
+    if (!admitted) {
+      // The entry is not added to the cache, but the caller could still use it via the handle, so
+      // it is accounted as pinned while the handle is held.
+      if (handle == nullptr) {
+        last_reference_list.Add(e);
+      } else {
+        e->in_cache = false;
+        e->refs = 1;
+        sub_cache->IncrementUsage(charge);
+        *handle = reinterpret_cast<Cache::Handle*>(e);
+      }
+      if (metrics_ != nullptr) {
+        metrics_->cache_admission_rejections->Increment();
+      }
+      s = Status::OK();
+    } else if (strict_capacity_limit_ &&
         sub_cache->Usage() - sub_cache->LRU_Usage() + charge > sub_cache->Capacity()) {
       if (handle == nullptr) {
         last_reference_list.Add(e);
@@ -739,7 +874,7 @@ Status LRUCache::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
       }
       s = Status::OK();
     }
-    if (statistics != nullptr) {
+    if (statistics != nullptr && admitted) {
       if (s.ok()) {
         RecordTick(statistics, BLOCK_CACHE_ADD);
         RecordTick(statistics, BLOCK_CACHE_BYTES_WRITE, charge);
@@ -803,6 +938,7 @@ class ShardedLRUCache : public Cache {
   size_t capacity_;
   bool strict_capacity_limit_;
   shared_ptr<yb::CacheMetrics> metrics_;
+  std::unique_ptr<CacheSimulator> simulator_;
 
   static inline uint32_t HashSlice(const Slice& s) {
     return Hash(s.data(), s.size(), 0);
@@ -846,6 +982,9 @@ class ShardedLRUCache : public Cache {
       shards_[s].SetCapacity(per_shard);
     }
     capacity_ = capacity;
+    if (simulator_) {
+      simulator_->SetCapacity(capacity);
+    }
   }
 
   void SetStrictCapacityLimit(bool strict_capacity_limit) override {
@@ -864,6 +1003,9 @@ class ShardedLRUCache : public Cache {
       return Status::OK();
     }
     const uint32_t hash = HashSlice(key);
+    if (simulator_ && simulator_->IsSampled(hash)) {
+      simulator_->Insert(key, hash, charge, query_id);
+    }
     return shards_[Shard(hash)].Insert(key, hash, query_id, value, charge, deleter,
                                        handle, statistics);
   }
@@ -886,7 +1028,11 @@ class ShardedLRUCache : public Cache {
       return nullptr;
     }
     const uint32_t hash = HashSlice(key);
-    return shards_[Shard(hash)].Lookup(key, hash, query_id, statistics);
+    auto* handle = shards_[Shard(hash)].Lookup(key, hash, query_id, statistics);
+    if (simulator_ && simulator_->IsSampled(hash)) {
+      simulator_->Lookup(key, hash, handle ? GetUsage(handle) : 0, query_id);
+    }
+    return handle;
   }
 
   void Release(Handle* handle) override {
@@ -961,6 +1107,7 @@ class ShardedLRUCache : public Cache {
     for (int s = 0; s < num_shards; s++) {
       shards_[s].SetMetrics(metrics_);
     }
+    simulator_ = CacheSimulator::Create(capacity_, entity);
   }
 };
 
@@ -0,0 +1,431 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rocksdb/util/cache_simulator.h"
+
+#include <math.h>
+
+#include <list>
+#include <unordered_map>
+
+#include <gflags/gflags.h>
+
+#include "yb/rocksdb/util/hash.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/metrics.h"
+
+DEFINE_int32(block_cache_simulation_sample_rate, 0,
+             "Simulate block caches of other capacities and eviction policies for one of this "
+             "number of block cache keys, and expose their hits as metrics. 0 disables the "
+             "simulation.");
+TAG_FLAG(block_cache_simulation_sample_rate, advanced);
+
+DECLARE_double(cache_single_touch_ratio);
+
+METRIC_DEFINE_counter(server, block_cache_simulation_lookups,
+                      "Block Cache Simulation Lookups", yb::MetricUnit::kBlocks,
+                      "Number of sampled block cache lookups replayed against simulated caches");
+
+#define DEFINE_SIMULATED_CACHE_HITS(policy, policy_text, ratio, ratio_text) \
+  METRIC_DEFINE_counter(server, block_cache_simulation_##policy##_##ratio##_hits, \
+                        "Simulated " policy_text " Block Cache Hits at " ratio_text " Capacity", \
+                        yb::MetricUnit::kBlocks, \
+                        "Number of sampled block cache lookups that would hit " policy_text \
+                        " cache with " ratio_text " of the actual capacity")
+
+#define DEFINE_SIMULATED_CACHE_POLICY_HITS(policy, policy_text) \
+  DEFINE_SIMULATED_CACHE_HITS(policy, policy_text, 0_5x, "0.5x"); \
+  DEFINE_SIMULATED_CACHE_HITS(policy, policy_text, 1x, "1x"); \
+  DEFINE_SIMULATED_CACHE_HITS(policy, policy_text, 2x, "2x"); \
+  DEFINE_SIMULATED_CACHE_HITS(policy, policy_text, 4x, "4x")
+
+DEFINE_SIMULATED_CACHE_POLICY_HITS(lru, "LRU");
+DEFINE_SIMULATED_CACHE_POLICY_HITS(touch_split, "Single/Multi Touch");
+DEFINE_SIMULATED_CACHE_POLICY_HITS(arc, "ARC");
+
+namespace rocksdb {
+
+namespace {
+
+struct SimulationConfig {
+  CacheSimulationPolicy policy;
+  double capacity_ratio;
+  yb::CounterPrototype* hits;
+};
+
+#define SIMULATION_CONFIG(policy, policy_enum, ratio, ratio_name) \
+  { CacheSimulationPolicy::policy_enum, ratio, \
+    &METRIC_block_cache_simulation_##policy##_##ratio_name##_hits }
+
+#define SIMULATION_CONFIGS(policy, policy_enum) \
+  SIMULATION_CONFIG(policy, policy_enum, 0.5, 0_5x), \
+  SIMULATION_CONFIG(policy, policy_enum, 1, 1x), \
+  SIMULATION_CONFIG(policy, policy_enum, 2, 2x), \
+  SIMULATION_CONFIG(policy, policy_enum, 4, 4x)
+
+const SimulationConfig kSimulationConfigs[] = {
+  SIMULATION_CONFIGS(lru, kLru),
+  SIMULATION_CONFIGS(touch_split, kTouchSplit),
+  SIMULATION_CONFIGS(arc, kArc),
+};
+
+#undef SIMULATION_CONFIGS
+#undef SIMULATION_CONFIG
+
+struct SimulatedEntry {
+  uint64_t key;
+  size_t charge;
+  QueryId query_id;
+};
+
+// Entries ordered from the least recently used to the most recently used, with their total charge.
+class EntryList {
+ public:
+  typedef std::list<SimulatedEntry>::iterator iterator;
+
+  iterator PushBack(const SimulatedEntry& entry) {
+    usage_ += entry.charge;
+    return entries_.insert(entries_.end(), entry);
+  }
+
+  void MoveToBack(iterator it) {
+    entries_.splice(entries_.end(), entries_, it);
+  }
+
+  // Moves the entry to the back of the other list, the iterator stays valid.
+  void MoveToBackOf(EntryList* other, iterator it) {
+    usage_ -= it->charge;
+    other->usage_ += it->charge;
+    other->entries_.splice(other->entries_.end(), entries_, it);
+  }
+
+  void Erase(iterator it) {
+    usage_ -= it->charge;
+    entries_.erase(it);
+  }
+
+  iterator front() { return entries_.begin(); }
+  bool empty() const { return entries_.empty(); }
+  size_t usage() const { return usage_; }
+
+ private:
+  std::list<SimulatedEntry> entries_;
+  size_t usage_ = 0;
+};
+
+// Base of simulated caches, that keeps the location of every tracked key.
+class SimulatedCacheBase : public SimulatedCache {
+ protected:
+  struct Location {
+    EntryList* list;
+    EntryList::iterator it;
+  };
+
+  Location* Find(uint64_t key) {
+    auto it = index_.find(key);
+    return it == index_.end() ? nullptr : &it->second;
+  }
+
+  void Add(EntryList* list, const SimulatedEntry& entry) {
+    index_[entry.key] = Location { list, list->PushBack(entry) };
+  }
+
+  void Move(Location* location, EntryList* list) {
+    if (location->list == list) {
+      list->MoveToBack(location->it);
+    } else {
+      location->list->MoveToBackOf(list, location->it);
+      location->list = list;
+    }
+  }
+
+  void MoveFront(EntryList* from, EntryList* to) {
+    Move(&index_[from->front()->key], to);
+  }
+
+  void DropFront(EntryList* list) {
+    index_.erase(list->front()->key);
+    list->Erase(list->front());
+  }
+
+  void Drop(Location* location) {
+    auto key = location->it->key;
+    location->list->Erase(location->it);
+    index_.erase(key);
+  }
+
+  // Drops least recently used entries of the list, while its usage is above limit.
+  void Trim(EntryList* list, size_t limit) {
+    while (list->usage() > limit && !list->empty()) {
+      DropFront(list);
+    }
+  }
+
+ private:
+  std::unordered_map<uint64_t, Location> index_;
+};
+
+class LruSimulatedCache : public SimulatedCacheBase {
+ public:
+  explicit LruSimulatedCache(size_t capacity) : capacity_(capacity) {}
+
+  bool Lookup(uint64_t key, QueryId query_id) override {
+    auto* location = Find(key);
+    if (!location) {
+      return false;
+    }
+    Move(location, &entries_);
+    return true;
+  }
+
+  void Insert(uint64_t key, size_t charge, QueryId query_id) override {
+    if (Find(key)) {
+      return;
+    }
+    Add(&entries_, SimulatedEntry { key, charge, query_id });
+    Trim(&entries_, capacity_);
+  }
+
+  void SetCapacity(size_t capacity) override {
+    capacity_ = capacity;
+    Trim(&entries_, capacity_);
+  }
+
+ private:
+  size_t capacity_;
+  EntryList entries_;
+};
+
+// Mirrors the policy of the LRU block cache: entries are added to the single touch sub cache, and
+// are moved to the multi touch sub cache when accessed by another query.
+class TouchSplitSimulatedCache : public SimulatedCacheBase {
+ public:
+  explicit TouchSplitSimulatedCache(size_t capacity) {
+    SetCapacity(capacity);
+  }
+
+  bool Lookup(uint64_t key, QueryId query_id) override {
+    auto* location = Find(key);
+    if (!location) {
+      return false;
+    }
+    if (location->list == &single_touch_ && FLAGS_cache_single_touch_ratio < 1 &&
+        location->it->query_id != query_id) {
+      Move(location, &multi_touch_);
+      Trim(&multi_touch_, multi_touch_capacity_);
+    } else {
+      Move(location, location->list);
+    }
+    return true;
+  }
+
+  void Insert(uint64_t key, size_t charge, QueryId query_id) override {
+    if (Find(key)) {
+      return;
+    }
+    auto* list = FLAGS_cache_single_touch_ratio == 0 ? &multi_touch_ : &single_touch_;
+    Add(list, SimulatedEntry { key, charge, query_id });
+    Trim(list, list == &single_touch_ ? single_touch_capacity_ : multi_touch_capacity_);
+  }
+
+  void SetCapacity(size_t capacity) override {
+    single_touch_capacity_ = static_cast<size_t>(round(FLAGS_cache_single_touch_ratio * capacity));
+    multi_touch_capacity_ = capacity - single_touch_capacity_;
+    Trim(&single_touch_, single_touch_capacity_);
+    Trim(&multi_touch_, multi_touch_capacity_);
+  }
+
+ private:
+  size_t single_touch_capacity_;
+  size_t multi_touch_capacity_;
+  EntryList single_touch_;
+  EntryList multi_touch_;
+};
+
+// Adaptive replacement cache, with list sizes and the adaptation target measured in bytes.
+// recent_ and frequent_ hold cached entries seen once and at least twice, recent_ghosts_ and
+// frequent_ghosts_ hold keys recently evicted from them.
+class ArcSimulatedCache : public SimulatedCacheBase {
+ public:
+  explicit ArcSimulatedCache(size_t capacity) : capacity_(capacity) {}
+
+  bool Lookup(uint64_t key, QueryId query_id) override {
+    auto* location = Find(key);
+    if (!location || !IsCached(*location)) {
+      return false;
+    }
+    Move(location, &frequent_);
+    return true;
+  }
+
+  void Insert(uint64_t key, size_t charge, QueryId query_id) override {
+    auto* location = Find(key);
+    if (location && IsCached(*location)) {
+      return;
+    }
+    if (location) {
+      // Ghost hit, adapt the target size of recent_ towards the list that would have hit.
+      bool in_frequent_ghosts = location->list == &frequent_ghosts_;
+      if (in_frequent_ghosts) {
+        auto delta = AdaptationDelta(recent_ghosts_, frequent_ghosts_, charge);
+        recent_target_ = recent_target_ > delta ? recent_target_ - delta : 0;
+      } else {
+        auto delta = AdaptationDelta(frequent_ghosts_, recent_ghosts_, charge);
+        recent_target_ = std::min(capacity_, recent_target_ + delta);
+      }
+      Drop(location);
+      Replace(in_frequent_ghosts, charge);
+      Add(&frequent_, SimulatedEntry { key, charge, query_id });
+      return;
+    }
+
+    TrimGhosts(charge);
+    Replace(false, charge);
+    Add(&recent_, SimulatedEntry { key, charge, query_id });
+  }
+
+  void SetCapacity(size_t capacity) override {
+    capacity_ = capacity;
+    recent_target_ = std::min(recent_target_, capacity_);
+    Replace(false, 0);
+    TrimGhosts(0);
+  }
+
+ private:
+  bool IsCached(const Location& location) const {
+    return location.list == &recent_ || location.list == &frequent_;
+  }
+
+  size_t TotalUsage() const {
+    return recent_.usage() + frequent_.usage() + recent_ghosts_.usage() + frequent_ghosts_.usage();
+  }
+
+  static size_t AdaptationDelta(const EntryList& numerator, const EntryList& denominator,
+                                size_t charge) {
+    return std::max<size_t>(numerator.usage() / std::max<size_t>(denominator.usage(), 1), 1) *
+           charge;
+  }
+
+  // Keeps recent_ with its ghosts within the capacity, and all lists within double the capacity,
+  // when an entry with the specified charge is added.
+  void TrimGhosts(size_t charge) {
+    while (recent_.usage() + recent_ghosts_.usage() + charge > capacity_ &&
+           !recent_ghosts_.empty()) {
+      DropFront(&recent_ghosts_);
+    }
+    while (TotalUsage() + charge > 2 * capacity_ && !frequent_ghosts_.empty()) {
+      DropFront(&frequent_ghosts_);
+    }
+  }
+
+  // Moves least recently used cached entries to ghost lists, until charge fits the capacity.
+  void Replace(bool in_frequent_ghosts, size_t charge) {
+    while (recent_.usage() + frequent_.usage() + charge > capacity_ &&
+           !(recent_.empty() && frequent_.empty())) {
+      if (!recent_.empty() &&
+          (recent_.usage() > recent_target_ ||
+           (in_frequent_ghosts && recent_.usage() == recent_target_) || frequent_.empty())) {
+        MoveFront(&recent_, &recent_ghosts_);
+      } else {
+        MoveFront(&frequent_, &frequent_ghosts_);
+      }
+    }
+  }
+
+  size_t capacity_;
+  size_t recent_target_ = 0;
+  EntryList recent_;
+  EntryList frequent_;
+  EntryList recent_ghosts_;
+  EntryList frequent_ghosts_;
+};
+
+} // namespace
+
+std::unique_ptr<SimulatedCache> SimulatedCache::Create(
+    CacheSimulationPolicy policy, size_t capacity) {
+  switch (policy) {
+    case CacheSimulationPolicy::kLru:
+      return std::make_unique<LruSimulatedCache>(capacity);
+    case CacheSimulationPolicy::kTouchSplit:
+      return std::make_unique<TouchSplitSimulatedCache>(capacity);
+    case CacheSimulationPolicy::kArc:
+      return std::make_unique<ArcSimulatedCache>(capacity);
+  }
+  FATAL_INVALID_ENUM_VALUE(CacheSimulationPolicy, policy);
+}
+
+struct CacheSimulator::Simulation {
+  double capacity_ratio;
+  std::unique_ptr<SimulatedCache> cache;
+  scoped_refptr<yb::Counter> hits;
+};
+
+std::unique_ptr<CacheSimulator> CacheSimulator::Create(
+    size_t capacity, const scoped_refptr<yb::MetricEntity>& metric_entity) {
+  if (FLAGS_block_cache_simulation_sample_rate <= 0) {
+    return nullptr;
+  }
+  return std::make_unique<CacheSimulator>(
+      capacity, FLAGS_block_cache_simulation_sample_rate, metric_entity);
+}
+
+CacheSimulator::CacheSimulator(size_t capacity, uint32_t sample_rate,
+                               const scoped_refptr<yb::MetricEntity>& metric_entity)
+    : sample_rate_(sample_rate),
+      lookups_(METRIC_block_cache_simulation_lookups.Instantiate(metric_entity)) {
+  for (const auto& config : kSimulationConfigs) {
+    simulations_.push_back(Simulation {
+        config.capacity_ratio,
+        SimulatedCache::Create(config.policy, capacity * config.capacity_ratio / sample_rate_),
+        config.hits->Instantiate(metric_entity) });
+  }
+}
+
+CacheSimulator::~CacheSimulator() = default;
+
+uint64_t CacheSimulator::SimulationKey(const Slice& key, uint32_t hash) {
+  // Extend the hash used for sharding, so keys of simulated entries do not collide in practice.
+  return (static_cast<uint64_t>(Hash(key.data(), key.size(), 0xbc9f1d34)) << 32) | hash;
+}
+
+void CacheSimulator::Lookup(const Slice& key, uint32_t hash, size_t charge, QueryId query_id) {
+  const auto simulation_key = SimulationKey(key, hash);
+  lookups_->Increment();
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& simulation : simulations_) {
+    if (simulation.cache->Lookup(simulation_key, query_id)) {
+      simulation.hits->Increment();
+    } else if (charge != 0) {
+      // The actual cache has the entry, so it is not followed by an insert.
+      simulation.cache->Insert(simulation_key, charge, query_id);
+    }
+  }
+}
+
+void CacheSimulator::Insert(const Slice& key, uint32_t hash, size_t charge, QueryId query_id) {
+  const auto simulation_key = SimulationKey(key, hash);
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& simulation : simulations_) {
+    simulation.cache->Insert(simulation_key, charge, query_id);
+  }
+}
+
+void CacheSimulator::SetCapacity(size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& simulation : simulations_) {
+    simulation.cache->SetCapacity(capacity * simulation.capacity_ratio / sample_rate_);
+  }
+}
+
+}  // namespace rocksdb
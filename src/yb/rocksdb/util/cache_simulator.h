@@ -0,0 +1,102 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_ROCKSDB_UTIL_CACHE_SIMULATOR_H
+#define YB_ROCKSDB_UTIL_CACHE_SIMULATOR_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "yb/gutil/ref_counted.h"
+#include "yb/rocksdb/cache.h"
+#include "yb/util/enums.h"
+
+namespace yb {
+
+class Counter;
+class MetricEntity;
+
+} // namespace yb
+
+namespace rocksdb {
+
+YB_DEFINE_ENUM(CacheSimulationPolicy,
+    // Plain LRU.
+    (kLru)
+    // Single touch and multi touch LRU sub caches, as used by the block cache.
+    (kTouchSplit)
+    // Adaptive replacement cache, that balances recency and frequency using ghost entries.
+    (kArc));
+
+// Cache that tracks only keys and charges of entries, used to estimate hit rates of caches with
+// other capacities or eviction policies.
+class SimulatedCache {
+ public:
+  virtual ~SimulatedCache() {}
+
+  // Returns whether the entry is in cache, and makes it recently used if it is.
+  virtual bool Lookup(uint64_t key, QueryId query_id) = 0;
+
+  // Adds the entry, if it is not in cache yet.
+  virtual void Insert(uint64_t key, size_t charge, QueryId query_id) = 0;
+
+  virtual void SetCapacity(size_t capacity) = 0;
+
+  static std::unique_ptr<SimulatedCache> Create(CacheSimulationPolicy policy, size_t capacity);
+};
+
+// Ghost cache simulator, that replays block cache accesses of a sample of keys against simulated
+// caches of 0.5x, 1x, 2x and 4x the actual capacity, for each of the simulation policies, and
+// counts their hits as metrics.
+//
+// Keys are sampled by hash, so a simulated cache sees all accesses of sampled keys, and its
+// capacity is scaled down by the sample rate.
+class CacheSimulator {
+ public:
+  // Returns nullptr when simulation is disabled via block_cache_simulation_sample_rate.
+  static std::unique_ptr<CacheSimulator> Create(
+      size_t capacity, const scoped_refptr<yb::MetricEntity>& metric_entity);
+
+  CacheSimulator(size_t capacity, uint32_t sample_rate,
+                 const scoped_refptr<yb::MetricEntity>& metric_entity);
+  ~CacheSimulator();
+
+  bool IsSampled(uint32_t hash) const {
+    return hash % sample_rate_ == 0;
+  }
+
+  // Records a lookup of a sampled key. charge is the charge of the entry found in the actual cache,
+  // or 0 if it was not found, in which case the entry is added to simulated caches by the
+  // following Insert.
+  void Lookup(const Slice& key, uint32_t hash, size_t charge, QueryId query_id);
+
+  void Insert(const Slice& key, uint32_t hash, size_t charge, QueryId query_id);
+
+  void SetCapacity(size_t capacity);
+
+ private:
+  struct Simulation;
+
+  static uint64_t SimulationKey(const Slice& key, uint32_t hash);
+
+  const uint32_t sample_rate_;
+  scoped_refptr<yb::Counter> lookups_;
+
+  std::mutex mutex_;
+  std::vector<Simulation> simulations_;
+};
+
+}  // namespace rocksdb
+
+#endif // YB_ROCKSDB_UTIL_CACHE_SIMULATOR_H
@@ -28,12 +28,22 @@
 #include <string>
 #include <iostream>
 #include <gflags/gflags.h>
+#include "yb/rocksdb/util/cache_simulator.h"
 #include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/hash.h"
 #include "yb/util/string_util.h"
 #include "yb/rocksdb/util/testharness.h"
+#include "yb/util/metrics.h"
 
 DECLARE_double(cache_single_touch_ratio);
 
+METRIC_DECLARE_counter(block_cache_simulation_lookups);
+METRIC_DECLARE_counter(block_cache_simulation_lru_1x_hits);
+METRIC_DECLARE_counter(block_cache_simulation_lru_2x_hits);
+METRIC_DECLARE_counter(block_cache_simulation_arc_1x_hits);
+
+DECLARE_bool(cache_frequency_admission);
+
 namespace rocksdb {
 
 // Conversions between numeric keys/values and the types expected by Cache.
@@ -675,6 +685,75 @@ TEST_F(CacheTest, ApplyToAllCacheEntiresTest) {
   ASSERT_TRUE(inserted == callback_state);
 }
 
+TEST_F(CacheTest, FrequencyAdmission) {
+  FLAGS_cache_frequency_admission = true;
+  // Single shard, so all keys compete for the same 20 single touch entries.
+  auto cache = NewLRUCache(100, 0);
+  const int kHotKeys = 10;
+  for (int k = 0; k != kHotKeys; ++k) {
+    ASSERT_EQ(-1, Lookup(cache, k));
+    ASSERT_OK(Insert(cache, k, k));
+    // Accessed by the same query, so the keys stay in the single touch cache.
+    ASSERT_EQ(k, Lookup(cache, k));
+    ASSERT_EQ(k, Lookup(cache, k));
+  }
+  // Scanned keys are looked up once, so they are not admitted once the cache is full.
+  for (int k = 1000; k != 1100; ++k) {
+    ASSERT_EQ(-1, Lookup(cache, k));
+    ASSERT_OK(Insert(cache, k, k));
+  }
+  for (int k = 0; k != kHotKeys; ++k) {
+    ASSERT_EQ(k, Lookup(cache, k));
+  }
+  ASSERT_EQ(-1, Lookup(cache, 1099));
+  FLAGS_cache_frequency_admission = false;
+}
+
+TEST_F(CacheTest, Simulation) {
+  yb::MetricRegistry registry;
+  auto entity = METRIC_ENTITY_server.Instantiate(&registry, "test");
+  // All keys are sampled, so the simulated cache with the actual capacity holds 100 entries.
+  CacheSimulator simulator(100, 1, entity);
+  QueryId query_id = kTestQueryId;
+  auto access = [&simulator, &query_id](int k) {
+    auto key = EncodeKey(k);
+    auto hash = Hash(key.data(), key.size(), 0);
+    simulator.Lookup(key, hash, 0, query_id);
+    simulator.Insert(key, hash, 1, query_id);
+  };
+
+  const int kHotKeys = 50;
+  const int kScanKeys = 80;
+  const int kRounds = 4;
+  // Hot keys are accessed twice.
+  for (int i = 0; i != 2; ++i) {
+    for (int k = 0; k != kHotKeys; ++k) {
+      access(k);
+    }
+    ++query_id;
+  }
+  // Then each round accesses hot keys and scans keys that are never accessed again.
+  for (int round = 0; round != kRounds; ++round) {
+    for (int k = 0; k != kHotKeys; ++k) {
+      access(k);
+    }
+    for (int k = 0; k != kScanKeys; ++k) {
+      access(1000 + round * kScanKeys + k);
+    }
+    ++query_id;
+  }
+
+  ASSERT_EQ(2 * kHotKeys + kRounds * (kHotKeys + kScanKeys),
+            METRIC_block_cache_simulation_lookups.Instantiate(entity)->value());
+  // Scans evict hot keys from LRU, so they hit only during the second access and the first round.
+  ASSERT_EQ(2 * kHotKeys, METRIC_block_cache_simulation_lru_1x_hits.Instantiate(entity)->value());
+  // Hot keys always hit in a twice larger LRU, and in ARC, that protects frequently used entries.
+  ASSERT_EQ((1 + kRounds) * kHotKeys,
+            METRIC_block_cache_simulation_lru_2x_hits.Instantiate(entity)->value());
+  ASSERT_EQ((1 + kRounds) * kHotKeys,
+            METRIC_block_cache_simulation_arc_1x_hits.Instantiate(entity)->value());
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
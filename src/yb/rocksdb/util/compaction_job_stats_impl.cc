@@ -53,6 +53,8 @@ void CompactionJobStats::Reset() {
   file_range_sync_nanos = 0;
   file_fsync_nanos = 0;
   file_prepare_write_nanos = 0;
+  block_compress_nanos = 0;
+  block_decompress_nanos = 0;
 }
 
 void CompactionJobStats::Add(const CompactionJobStats& stats) {
@@ -82,6 +84,8 @@ void CompactionJobStats::Add(const CompactionJobStats& stats) {
   file_range_sync_nanos += stats.file_range_sync_nanos;
   file_fsync_nanos += stats.file_fsync_nanos;
   file_prepare_write_nanos += stats.file_prepare_write_nanos;
+  block_compress_nanos += stats.block_compress_nanos;
+  block_decompress_nanos += stats.block_decompress_nanos;
 }
 
 #else
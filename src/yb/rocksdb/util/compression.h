@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <limits>
 #include <string>
+#include <vector>
 
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/util/coding.h"
@@ -48,6 +49,7 @@
 #endif
 
 #if defined(ZSTD)
+#include <zdict.h>
 #include <zstd.h>
 #endif
 
@@ -132,6 +134,158 @@ inline std::string CompressionTypeToString(CompressionType compression_type) {
   }
 }
 
+inline bool CompressionDictSupported(CompressionType compression_type) {
+  switch (compression_type) {
+    case kLZ4Compression:
+      return LZ4_Supported();
+    case kZSTDNotFinalCompression:
+      return ZSTD_Supported();
+    default:
+      return false;
+  }
+}
+
+// Dictionary used to compress data blocks of an SST file. Keeps the state of the compression
+// library prepared for the dictionary, so it is not set up again for each block. Not thread safe,
+// it is used by a single table builder.
+class CompressionDict {
+ public:
+  CompressionDict(CompressionType compression_type, std::string dict, int level)
+      : dict_(std::move(dict)) {
+#ifdef LZ4
+    if (compression_type == kLZ4Compression) {
+      lz4_stream_ = LZ4_createStream();
+    }
+#endif
+#ifdef ZSTD
+    if (compression_type == kZSTDNotFinalCompression) {
+      zstd_cctx_ = ZSTD_createCCtx();
+      zstd_cdict_ = ZSTD_createCDict(dict_.data(), dict_.size(), level);
+    }
+#endif
+  }
+
+  ~CompressionDict() {
+#ifdef LZ4
+    if (lz4_stream_) {
+      LZ4_freeStream(lz4_stream_);
+    }
+#endif
+#ifdef ZSTD
+    ZSTD_freeCDict(zstd_cdict_);
+    ZSTD_freeCCtx(zstd_cctx_);
+#endif
+  }
+
+  CompressionDict(const CompressionDict&) = delete;
+  void operator=(const CompressionDict&) = delete;
+
+  const std::string& dict() const { return dict_; }
+
+#ifdef LZ4
+  // Returns the stream with the dictionary loaded, LZ4 needs it to be loaded again for each block.
+  LZ4_stream_t* lz4_stream() const {
+    LZ4_loadDict(lz4_stream_, dict_.data(), static_cast<int>(dict_.size()));
+    return lz4_stream_;
+  }
+#endif
+
+#ifdef ZSTD
+  ZSTD_CCtx* zstd_cctx() const { return zstd_cctx_; }
+  const ZSTD_CDict* zstd_cdict() const { return zstd_cdict_; }
+#endif
+
+ private:
+  std::string dict_;
+#ifdef LZ4
+  LZ4_stream_t* lz4_stream_ = nullptr;
+#endif
+#ifdef ZSTD
+  ZSTD_CCtx* zstd_cctx_ = nullptr;
+  ZSTD_CDict* zstd_cdict_ = nullptr;
+#endif
+};
+
+// Dictionary used to uncompress data blocks of an SST file. It is loaded once when the file is
+// opened and shared by all readers of the file.
+class UncompressionDict {
+ public:
+  explicit UncompressionDict(std::string dict) : dict_(std::move(dict)) {
+#ifdef ZSTD
+    zstd_ddict_ = ZSTD_createDDict(dict_.data(), dict_.size());
+#endif
+  }
+
+  ~UncompressionDict() {
+#ifdef ZSTD
+    ZSTD_freeDDict(zstd_ddict_);
+#endif
+  }
+
+  UncompressionDict(const UncompressionDict&) = delete;
+  void operator=(const UncompressionDict&) = delete;
+
+  const std::string& dict() const { return dict_; }
+
+#ifdef ZSTD
+  const ZSTD_DDict* zstd_ddict() const { return zstd_ddict_; }
+
+  // Decompression context of the current thread, so it is not allocated for each block.
+  static ZSTD_DCtx* ThreadLocalDCtx() {
+    struct DCtxHolder {
+      ZSTD_DCtx* dctx = ZSTD_createDCtx();
+      ~DCtxHolder() { ZSTD_freeDCtx(dctx); }
+    };
+    static thread_local DCtxHolder holder;
+    return holder.dctx;
+  }
+#endif
+
+ private:
+  std::string dict_;
+#ifdef ZSTD
+  ZSTD_DDict* zstd_ddict_ = nullptr;
+#endif
+};
+
+// Builds a dictionary of at most max_dict_bytes from samples of data blocks. ZSTD dictionaries are
+// trained from the samples, LZ4 uses the content of the latest samples as is. Returns an empty
+// string if the dictionary could not be built, e.g. when there are too few samples.
+inline std::string BuildCompressionDict(
+    CompressionType compression_type, const std::vector<Slice>& samples,
+    size_t max_dict_bytes) {
+  std::string samples_data;
+  std::vector<size_t> sample_sizes;
+  sample_sizes.reserve(samples.size());
+  for (const auto& sample : samples) {
+    samples_data.append(sample.cdata(), sample.size());
+    sample_sizes.push_back(sample.size());
+  }
+  switch (compression_type) {
+    case kLZ4Compression: {
+      // LZ4 uses at most 64KB of the dictionary.
+      const auto dict_size = std::min({max_dict_bytes, samples_data.size(), size_t(64 * 1024)});
+      return samples_data.substr(samples_data.size() - dict_size);
+    }
+    case kZSTDNotFinalCompression: {
+#ifdef ZSTD
+      std::string dict(max_dict_bytes, '\0');
+      const auto dict_size = ZDICT_trainFromBuffer(
+          &dict[0], dict.size(), samples_data.data(), sample_sizes.data(),
+          static_cast<unsigned>(sample_sizes.size()));
+      if (ZDICT_isError(dict_size)) {
+        return std::string();
+      }
+      dict.resize(dict_size);
+      return dict;
+#endif
+      return std::string();
+    }
+    default:
+      return std::string();
+  }
+}
+
 // compress_format_version can have two values:
 // 1 -- decompressed sizes for BZip2 and Zlib are not included in the compressed
 // block. Also, decompressed sizes for LZ4 are encoded in platform-dependent
@@ -498,7 +652,8 @@ inline char* BZip2_Uncompress(const char* input_data, size_t input_length,
 // header in varint32 format
 inline bool LZ4_Compress(const CompressionOptions& opts,
                          uint32_t compress_format_version, const char* input,
-                         size_t length, ::std::string* output) {
+                         size_t length, ::std::string* output,
+                         const CompressionDict* dict = nullptr) {
 #ifdef LZ4
   if (length > std::numeric_limits<uint32_t>::max()) {
     // Can't compress more than 4GB
@@ -521,9 +676,15 @@ inline bool LZ4_Compress(const CompressionOptions& opts,
 
   int compressBound = LZ4_compressBound(static_cast<int>(length));
   output->resize(static_cast<size_t>(output_header_len + compressBound));
-  int outlen =
-      LZ4_compress_limitedOutput(input, &(*output)[output_header_len],
-                                 static_cast<int>(length), compressBound);
+  int outlen;
+  if (dict) {
+    outlen = LZ4_compress_fast_continue(
+        dict->lz4_stream(), input, &(*output)[output_header_len], static_cast<int>(length),
+        compressBound, 1 /* acceleration */);
+  } else {
+    outlen = LZ4_compress_limitedOutput(input, &(*output)[output_header_len],
+                                        static_cast<int>(length), compressBound);
+  }
   if (outlen == 0) {
     return false;
   }
@@ -539,7 +700,8 @@ inline bool LZ4_Compress(const CompressionOptions& opts,
 // header in varint32 format
 inline char* LZ4_Uncompress(const char* input_data, size_t input_length,
                             int* decompress_size,
-                            uint32_t compress_format_version) {
+                            uint32_t compress_format_version,
+                            const UncompressionDict* dict = nullptr) {
 #ifdef LZ4
   uint32_t output_len = 0;
   if (compress_format_version == 2) {
@@ -559,9 +721,15 @@ inline char* LZ4_Uncompress(const char* input_data, size_t input_length,
     input_data += 8;
   }
   char* output = new char[output_len];
-  *decompress_size =
-      LZ4_decompress_safe(input_data, output, static_cast<int>(input_length),
-                          static_cast<int>(output_len));
+  if (dict) {
+    *decompress_size = LZ4_decompress_safe_usingDict(
+        input_data, output, static_cast<int>(input_length), static_cast<int>(output_len),
+        dict->dict().data(), static_cast<int>(dict->dict().size()));
+  } else {
+    *decompress_size =
+        LZ4_decompress_safe(input_data, output, static_cast<int>(input_length),
+                            static_cast<int>(output_len));
+  }
   if (*decompress_size < 0) {
     delete[] output;
     return nullptr;
@@ -621,7 +789,8 @@ inline bool LZ4HC_Compress(const CompressionOptions& opts,
 }
 
 inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
-                          size_t length, ::std::string* output) {
+                          size_t length, ::std::string* output,
+                          const CompressionDict* dict = nullptr) {
 #ifdef ZSTD
   if (length > std::numeric_limits<uint32_t>::max()) {
     // Can't compress more than 4GB
@@ -633,9 +802,11 @@ inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
 
   size_t compressBound = ZSTD_compressBound(length);
   output->resize(static_cast<size_t>(output_header_len + compressBound));
-  size_t outlen = ZSTD_compress(&(*output)[output_header_len], compressBound,
-                                input, length, opts.level);
-  if (outlen == 0) {
+  size_t outlen = dict
+      ? ZSTD_compress_usingCDict(dict->zstd_cctx(), &(*output)[output_header_len], compressBound,
+                                 input, length, dict->zstd_cdict())
+      : ZSTD_compress(&(*output)[output_header_len], compressBound, input, length, opts.level);
+  if (outlen == 0 || ZSTD_isError(outlen)) {
     return false;
   }
   output->resize(output_header_len + outlen);
@@ -645,7 +816,8 @@ inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
 }
 
 inline char* ZSTD_Uncompress(const char* input_data, size_t input_length,
-                             int* decompress_size) {
+                             int* decompress_size,
+                             const UncompressionDict* dict = nullptr) {
 #ifdef ZSTD
   uint32_t output_len = 0;
   if (!compression::GetDecompressedSizeInfo(&input_data, &input_length,
@@ -654,8 +826,14 @@ inline char* ZSTD_Uncompress(const char* input_data, size_t input_length,
   }
 
   char* output = new char[output_len];
-  size_t actual_output_length =
-      ZSTD_decompress(output, output_len, input_data, input_length);
+  size_t actual_output_length = dict
+      ? ZSTD_decompress_usingDDict(UncompressionDict::ThreadLocalDCtx(), output, output_len,
+                                   input_data, input_length, dict->zstd_ddict())
+      : ZSTD_decompress(output, output_len, input_data, input_length);
+  if (ZSTD_isError(actual_output_length)) {
+    delete[] output;
+    return nullptr;
+  }
   assert(actual_output_length == output_len);
   *decompress_size = static_cast<int>(actual_output_length);
   return output;
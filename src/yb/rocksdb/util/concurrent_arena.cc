@@ -34,8 +34,10 @@ namespace rocksdb {
 __thread uint32_t ConcurrentArena::tls_cpuid = 0;
 #endif
 
-ConcurrentArena::ConcurrentArena(size_t block_size, size_t huge_page_size)
-    : shard_block_size_(block_size / 8), arena_(block_size, huge_page_size) {
+ConcurrentArena::ConcurrentArena(
+    size_t block_size, size_t huge_page_size, std::shared_ptr<ArenaBlockPool> block_pool)
+    : shard_block_size_(block_size / 8),
+      arena_(block_size, huge_page_size, std::move(block_pool)) {
   // find a power of two >= num_cpus and >= 8
   index_mask_ = 7;
   size_t num_cpus = base::NumCPUs();
@@ -66,7 +66,8 @@ class ConcurrentArena : public Allocator {
   // shards compute their shard_block_size as a fraction of block_size
   // that varies according to the hardware concurrency level.
   explicit ConcurrentArena(size_t block_size = Arena::kMinBlockSize,
-                           size_t huge_page_size = 0);
+                           size_t huge_page_size = 0,
+                           std::shared_ptr<ArenaBlockPool> block_pool = nullptr);
 
   char* Allocate(size_t bytes) override {
     return AllocateImpl(bytes, false /*force_arena*/,
@@ -29,6 +29,18 @@
 #include "yb/rocksdb/util/mutexlock.h"
 #include "yb/rocksdb/util/sync_point.h"
 
+#include "yb/util/flag_tags.h"
+#include "yb/util/size_literals.h"
+
+using namespace yb::size_literals;  // NOLINT.
+
+DEFINE_uint64(trash_file_truncate_chunk_bytes, 256_MB,
+              "Files in trash that are larger than this are truncated in chunks of this size "
+              "before being deleted, so the file system frees their blocks gradually. "
+              "0 to delete files at once.");
+TAG_FLAG(trash_file_truncate_chunk_bytes, advanced);
+TAG_FLAG(trash_file_truncate_chunk_bytes, runtime);
+
 namespace rocksdb {
 
 DeleteScheduler::DeleteScheduler(Env* env, const std::string& trash_dir,
@@ -166,22 +178,15 @@ void DeleteScheduler::BackgroundEmptyTrash() {
 
       // We dont need to hold the lock while deleting the file
       mu_.Unlock();
-      uint64_t deleted_bytes = 0;
-      // Delete file from trash and update total_penlty value
-      Status s = DeleteTrashFile(path_in_trash,  &deleted_bytes);
-      total_deleted_bytes += deleted_bytes;
+      // Delete file from trash and update total_deleted_bytes value
+      Status s = DeleteTrashFile(path_in_trash, start_time, &total_deleted_bytes);
       mu_.Lock();
 
       if (!s.ok()) {
         bg_errors_[path_in_trash] = s;
       }
 
-      // Apply penlty if necessary
-      uint64_t total_penlty =
-          ((total_deleted_bytes * kMicrosInSecond) / rate_bytes_per_sec_);
-      while (!closing_ && !cv_.TimedWait(start_time + total_penlty)) {}
-      TEST_SYNC_POINT_CALLBACK("DeleteScheduler::BackgroundEmptyTrash:Wait",
-                               &total_penlty);
+      WaitForRateLimit(start_time, total_deleted_bytes);
 
       pending_files_--;
       if (pending_files_ == 0) {
@@ -193,10 +198,42 @@ void DeleteScheduler::BackgroundEmptyTrash() {
   }
 }
 
-Status DeleteScheduler::DeleteTrashFile(const std::string& path_in_trash,
-                                        uint64_t* deleted_bytes) {
+void DeleteScheduler::WaitForRateLimit(uint64_t start_time, uint64_t total_deleted_bytes) {
+  // Apply penlty if necessary
+  uint64_t total_penlty =
+      ((total_deleted_bytes * kMicrosInSecond) / rate_bytes_per_sec_);
+  while (!closing_ && !cv_.TimedWait(start_time + total_penlty)) {}
+  TEST_SYNC_POINT_CALLBACK("DeleteScheduler::BackgroundEmptyTrash:Wait",
+                           &total_penlty);
+}
+
+Status DeleteScheduler::DeleteTrashFile(const std::string& path_in_trash, uint64_t start_time,
+                                        uint64_t* total_deleted_bytes) {
   uint64_t file_size;
   Status s = env_->GetFileSize(path_in_trash, &file_size);
+
+  // Unlinking a very large file at once could stall the file system, that frees all its blocks.
+  const uint64_t chunk_size = FLAGS_trash_file_truncate_chunk_bytes;
+  while (s.ok() && chunk_size > 0 && file_size > chunk_size) {
+    s = env_->TruncateFile(path_in_trash, file_size - chunk_size);
+    if (s.IsNotSupported() || s.IsIllegalState()) {
+      // The file is hard linked from a snapshot, checkpoint or the live DB, so it is only unlinked,
+      // and its blocks are not freed anyway.
+      s = Status::OK();
+      break;
+    }
+    if (!s.ok()) {
+      break;
+    }
+    file_size -= chunk_size;
+    *total_deleted_bytes += chunk_size;
+    MutexLock l(&mu_);
+    if (closing_) {
+      break;
+    }
+    WaitForRateLimit(start_time, *total_deleted_bytes);
+  }
+
   if (s.ok()) {
     TEST_SYNC_POINT("DeleteScheduler::DeleteTrashFile:DeleteFile");
     s = env_->DeleteFile(path_in_trash);
@@ -207,9 +244,8 @@ Status DeleteScheduler::DeleteTrashFile(const std::string& path_in_trash,
     RLOG(InfoLogLevel::ERROR_LEVEL, info_log_,
         "Failed to delete %s from trash -- %s", path_in_trash.c_str(),
         s.ToString().c_str());
-    *deleted_bytes = 0;
   } else {
-    *deleted_bytes = file_size;
+    *total_deleted_bytes += file_size;
     if (sst_file_manager_) {
       sst_file_manager_->OnDeleteFile(path_in_trash);
     }
@@ -67,8 +67,14 @@ class DeleteScheduler {
  private:
   Status MoveToTrash(const std::string& file_path, std::string* path_in_trash);
 
-  Status DeleteTrashFile(const std::string& path_in_trash,
-                         uint64_t* deleted_bytes);
+  // Deletes the file, adding deleted bytes to total_deleted_bytes. Large files are truncated in
+  // chunks first, waiting for the rate limit after each chunk.
+  Status DeleteTrashFile(const std::string& path_in_trash, uint64_t start_time,
+                         uint64_t* total_deleted_bytes);
+
+  // Waits until total_deleted_bytes deleted since start_time are within the rate limit.
+  // mu_ should be held.
+  void WaitForRateLimit(uint64_t start_time, uint64_t total_deleted_bytes);
 
   void BackgroundEmptyTrash();
 
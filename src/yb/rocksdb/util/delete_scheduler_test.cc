@@ -34,6 +34,8 @@
 #include "yb/rocksdb/util/sync_point.h"
 #include "yb/rocksdb/util/testharness.h"
 
+DECLARE_uint64(trash_file_truncate_chunk_bytes);
+
 namespace rocksdb {
 
 class DeleteSchedulerTest : public testing::Test {
@@ -449,6 +451,31 @@ TEST_F(DeleteSchedulerTest, MoveToTrashError) {
 
   rocksdb::SyncPoint::GetInstance()->DisableProcessing();
 }
+
+// Large files should be truncated in chunks, waiting for the rate limit after each chunk.
+TEST_F(DeleteSchedulerTest, TruncateInChunks) {
+  const auto old_chunk_bytes = FLAGS_trash_file_truncate_chunk_bytes;
+  FLAGS_trash_file_truncate_chunk_bytes = 1024;
+
+  int num_waits = 0;
+  rocksdb::SyncPoint::GetInstance()->SetCallBack(
+      "DeleteScheduler::BackgroundEmptyTrash:Wait", [&](void* arg) { ++num_waits; });
+  rocksdb::SyncPoint::GetInstance()->EnableProcessing();
+
+  rate_bytes_per_sec_ = 1024 * 1024;
+  NewDeleteScheduler();
+  ASSERT_OK(delete_scheduler_->DeleteFile(NewDummyFile("large.data", 10 * 1024)));
+  ASSERT_OK(delete_scheduler_->DeleteFile(NewDummyFile("small.data", 512)));
+  delete_scheduler_->WaitForEmptyTrash();
+
+  // 9 chunks of the large file, after the large file and after the small file.
+  ASSERT_EQ(num_waits, 11);
+  ASSERT_EQ(CountFilesInDir(trash_dir_), 0);
+  ASSERT_EQ(delete_scheduler_->GetBackgroundErrors().size(), 0);
+
+  rocksdb::SyncPoint::GetInstance()->DisableProcessing();
+  FLAGS_trash_file_truncate_chunk_bytes = old_chunk_bytes;
+}
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
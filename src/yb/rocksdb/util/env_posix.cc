@@ -89,6 +89,28 @@ ThreadStatusUpdater* CreateThreadStatusUpdater() {
   return new ThreadStatusUpdater();
 }
 
+// Opens the file, with O_DIRECT when options->use_direct_io is set. Falls back to buffered I/O,
+// resetting options->use_direct_io, when direct I/O is not supported by the platform or the file
+// system.
+int OpenFile(const std::string& fname, int flags, mode_t mode, EnvOptions* options) {
+  int fd;
+#if defined(__linux__)
+  if (options->use_direct_io) {
+    do {
+      fd = open(fname.c_str(), flags | O_DIRECT, mode);
+    } while (fd < 0 && errno == EINTR);
+    if (fd >= 0 || errno != EINVAL) {
+      return fd;
+    }
+  }
+#endif
+  options->use_direct_io = false;
+  do {
+    fd = open(fname.c_str(), flags, mode);
+  } while (fd < 0 && errno == EINTR);
+  return fd;
+}
+
 // list of pathnames that are locked
 static std::set<std::string> lockedFiles;
 static port::Mutex mutex_lockedFiles;
@@ -280,6 +302,36 @@ class PosixEnv : public Env {
     return result;
   };
 
+  Status TruncateFile(const std::string& fname, uint64_t size) override {
+    int fd;
+    do {
+      fd = open(fname.c_str(), O_WRONLY | O_CLOEXEC);
+    } while (fd < 0 && errno == EINTR);
+    if (fd < 0) {
+      return STATUS_IO_ERROR(fname, errno);
+    }
+    // The link count is checked on the opened file, so it is the same file that is truncated.
+    struct stat st;
+    Status status;
+    int result = fstat(fd, &st);
+    if (result != 0) {
+      status = STATUS_IO_ERROR(fname, errno);
+    } else if (st.st_nlink != 1) {
+      status = STATUS_FORMAT(
+          IllegalState, "$0 has $1 hard links, truncating it would change the other links",
+          fname, st.st_nlink);
+    } else {
+      do {
+        result = ftruncate(fd, static_cast<off_t>(size));
+      } while (result != 0 && errno == EINTR);
+      if (result != 0) {
+        status = STATUS_IO_ERROR(fname, errno);
+      }
+    }
+    close(fd);
+    return status;
+  }
+
   Status GetFileSize(const std::string& fname, uint64_t* size) override {
     return file_factory_->GetFileSize(fname, size);
   }
@@ -611,9 +663,13 @@ class PosixRocksDBFileFactory : public RocksDBFileFactory {
     result->reset();
     Status s;
     int fd;
+    EnvOptions file_options = options;
+    if (file_options.use_mmap_reads) {
+      file_options.use_direct_io = false;
+    }
     {
       IOSTATS_TIMER_GUARD(open_nanos);
-      fd = open(fname.c_str(), O_RDONLY);
+      fd = OpenFile(fname, O_RDONLY, 0, &file_options);
     }
     SetFD_CLOEXEC(fd, &options);
     if (fd < 0) {
@@ -634,7 +690,7 @@ class PosixRocksDBFileFactory : public RocksDBFileFactory {
       }
       close(fd);
     } else {
-      *result = std::make_unique<yb::PosixRandomAccessFile>(fname, fd, options);
+      *result = std::make_unique<yb::PosixRandomAccessFile>(fname, fd, file_options);
     }
     return s;
   }
@@ -645,12 +701,16 @@ class PosixRocksDBFileFactory : public RocksDBFileFactory {
     result->reset();
     Status s;
     int fd = -1;
-    do {
+    EnvOptions file_options = options;
+    {
       IOSTATS_TIMER_GUARD(open_nanos);
-      fd = open(fname.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
-    } while (fd < 0 && errno == EINTR);
+      fd = OpenFile(fname, O_CREAT | O_RDWR | O_TRUNC, 0644, &file_options);
+    }
     if (fd < 0) {
       s = STATUS_IO_ERROR(fname, errno);
+    } else if (file_options.use_direct_io) {
+      SetFD_CLOEXEC(fd, &options);
+      *result = std::make_unique<PosixDirectIOWritableFile>(fname, fd, file_options);
     } else {
       SetFD_CLOEXEC(fd, &options);
       if (options.use_mmap_writes) {
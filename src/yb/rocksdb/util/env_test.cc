@@ -808,6 +808,49 @@ TEST_F(EnvPosixTest, InvalidateCache) {
   // Delete the file
   ASSERT_OK(env_->DeleteFile(fname));
 }
+
+TEST_F(EnvPosixTest, DirectIO) {
+  EnvOptions soptions;
+  soptions.use_direct_io = true;
+  soptions.writable_file_max_buffer_size = 8192;
+  std::string fname = test::TmpDir() + "/" + "testfile";
+
+  Random rnd(301);
+  std::string data = RandomString(&rnd, 20000);
+  {
+    unique_ptr<WritableFile> wfile;
+    ASSERT_OK(env_->NewWritableFile(fname, &wfile, soptions));
+    ASSERT_OK(wfile->Append(Slice(data.data(), 5000)));
+    // Incomplete last block is written on sync and rewritten by following appends.
+    ASSERT_OK(wfile->Sync());
+    uint64_t size = 0;
+    ASSERT_OK(env_->GetFileSize(fname, &size));
+    ASSERT_EQ(5000U, size);
+    ASSERT_OK(wfile->Append(Slice(data.data() + 5000, data.size() - 5000)));
+    ASSERT_EQ(data.size(), wfile->GetFileSize());
+    ASSERT_OK(wfile->Close());
+  }
+  uint64_t size = 0;
+  ASSERT_OK(env_->GetFileSize(fname, &size));
+  ASSERT_EQ(data.size(), size);
+
+  {
+    unique_ptr<RandomAccessFile> file;
+    std::vector<uint8_t> scratch(data.size());
+    Slice result;
+    ASSERT_OK(env_->NewRandomAccessFile(fname, &file, soptions));
+    for (auto offset_and_size : std::vector<std::pair<size_t, size_t>>{
+             {0, data.size()}, {1, 10}, {4095, 2}, {4096, 4096}, {12345, 6789}}) {
+      ASSERT_OK(file->Read(offset_and_size.first, offset_and_size.second, &result,
+                           scratch.data()));
+      ASSERT_EQ(data.substr(offset_and_size.first, offset_and_size.second), result.ToBuffer());
+    }
+    // Read after the end of the file.
+    ASSERT_OK(file->Read(19990, 100, &result, scratch.data()));
+    ASSERT_EQ(data.substr(19990), result.ToBuffer());
+  }
+  ASSERT_OK(env_->DeleteFile(fname));
+}
 #endif  // not TRAVIS
 #endif  // __linux__
 
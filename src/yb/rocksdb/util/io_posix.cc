@@ -40,6 +40,9 @@
 #include <sys/statfs.h>
 #include <sys/syscall.h>
 #endif
+
+#include <gflags/gflags.h>
+
 #include "yb/rocksdb/port/port.h"
 #include "yb/rocksdb/util/coding.h"
 #include "yb/rocksdb/util/posix_logger.h"
@@ -51,6 +54,8 @@
 #include "yb/util/stats/iostats_context_imp.h"
 #include "yb/util/string_util.h"
 
+DECLARE_int32(o_direct_block_alignment_bytes);
+
 namespace rocksdb {
 
 // A wrapper for fadvise, if the platform doesn't support fadvise,
@@ -497,6 +502,102 @@ size_t PosixWritableFile::GetUniqueId(char* id) const {
 }
 #endif
 
+/*
+ * PosixDirectIOWritableFile
+ *
+ * Use pwrite of aligned blocks to write data to a file opened with O_DIRECT.
+ */
+PosixDirectIOWritableFile::PosixDirectIOWritableFile(
+    const std::string& fname, int fd, const EnvOptions& options)
+    : filename_(fname), fd_(fd) {
+  const size_t alignment = FLAGS_o_direct_block_alignment_bytes;
+  buf_.Alignment(alignment);
+  buf_.AllocateNewBuffer(std::max(options.writable_file_max_buffer_size, alignment));
+}
+
+PosixDirectIOWritableFile::~PosixDirectIOWritableFile() {
+  if (fd_ >= 0) {
+    PosixDirectIOWritableFile::Close();
+  }
+}
+
+Status PosixDirectIOWritableFile::Append(const Slice& data) {
+  const char* src = data.cdata();
+  size_t left = data.size();
+  while (left != 0) {
+    const size_t appended = buf_.Append(src, left);
+    left -= appended;
+    src += appended;
+    filesize_ += appended;
+    if (buf_.CurrentSize() == buf_.Capacity()) {
+      RETURN_NOT_OK(WriteBuffer(false /* pad_tail */));
+    }
+  }
+  return Status::OK();
+}
+
+Status PosixDirectIOWritableFile::WriteBuffer(bool pad_tail) {
+  const size_t data_size = buf_.CurrentSize();
+  const size_t full_size = TruncateToPageBoundary(buf_.Alignment(), data_size);
+  if (pad_tail) {
+    buf_.PadToAlignmentWith(0);
+  }
+  const char* src = buf_.BufferStart();
+  size_t left = pad_tail ? buf_.CurrentSize() : full_size;
+  uint64_t offset = next_write_offset_;
+  // Restore the size, so padding is not treated as data.
+  buf_.Size(data_size);
+  while (left != 0) {
+    ssize_t done = pwrite(fd_, src, left, static_cast<off_t>(offset));
+    if (done < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return STATUS_IO_ERROR(filename_, errno);
+    }
+    left -= done;
+    src += done;
+    offset += done;
+  }
+  if (pad_tail && full_size != data_size && ftruncate(fd_, filesize_) != 0) {
+    return STATUS_IO_ERROR(filename_, errno);
+  }
+  buf_.RefitTail(full_size, data_size - full_size);
+  next_write_offset_ += full_size;
+  return Status::OK();
+}
+
+Status PosixDirectIOWritableFile::Close() {
+  Status s = WriteBuffer(true /* pad_tail */);
+  if (close(fd_) < 0 && s.ok()) {
+    s = STATUS_IO_ERROR(filename_, errno);
+  }
+  fd_ = -1;
+  return s;
+}
+
+Status PosixDirectIOWritableFile::Sync() {
+  RETURN_NOT_OK(WriteBuffer(true /* pad_tail */));
+  if (fdatasync(fd_) < 0) {
+    return STATUS_IO_ERROR(filename_, errno);
+  }
+  return Status::OK();
+}
+
+Status PosixDirectIOWritableFile::Fsync() {
+  RETURN_NOT_OK(WriteBuffer(true /* pad_tail */));
+  if (fsync(fd_) < 0) {
+    return STATUS_IO_ERROR(filename_, errno);
+  }
+  return Status::OK();
+}
+
+#ifdef ROCKSDB_FALLOCATE_PRESENT
+size_t PosixDirectIOWritableFile::GetUniqueId(char* id) const {
+  return yb::GetUniqueIdFromFile(fd_, pointer_cast<uint8_t*>(id));
+}
+#endif
+
 PosixDirectory::~PosixDirectory() { close(fd_); }
 
 Status PosixDirectory::Fsync() {
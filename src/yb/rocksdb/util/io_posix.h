@@ -26,6 +26,7 @@
 #pragma once
 #include <unistd.h>
 #include "yb/rocksdb/env.h"
+#include "yb/rocksdb/util/aligned_buffer.h"
 
 // For non linux platform, the following macros are used only as place
 // holder.
@@ -74,6 +75,39 @@ class PosixWritableFile : public WritableFile {
 #endif
 };
 
+// Writes the file with O_DIRECT, bypassing the OS page cache. Appended data is collected in an
+// aligned buffer, that is written in whole aligned blocks. The last incomplete block is written
+// padded with zeros on Sync and Close, and is rewritten when more data is appended.
+class PosixDirectIOWritableFile : public WritableFile {
+ public:
+  PosixDirectIOWritableFile(const std::string& fname, int fd, const EnvOptions& options);
+  ~PosixDirectIOWritableFile();
+
+  Status Truncate(uint64_t size) override { return Status::OK(); }
+  Status Close() override;
+  Status Append(const Slice& data) override;
+  // Data is kept in the buffer until it fills whole blocks, so nothing is done here.
+  Status Flush() override { return Status::OK(); }
+  Status Sync() override;
+  Status Fsync() override;
+  uint64_t GetFileSize() override { return filesize_; }
+#ifdef ROCKSDB_FALLOCATE_PRESENT
+  size_t GetUniqueId(char* id) const override;
+#endif
+
+ private:
+  // Writes whole blocks of the buffer. When pad_tail is true, also writes the incomplete last
+  // block padded with zeros, and truncates the file to its actual size.
+  Status WriteBuffer(bool pad_tail);
+
+  const std::string filename_;
+  int fd_;
+  uint64_t filesize_ = 0;
+  // Offset in the file of the start of the buffer, always aligned.
+  uint64_t next_write_offset_ = 0;
+  AlignedBuffer buf_;
+};
+
 class PosixMmapReadableFile : public RandomAccessFile {
  private:
   int fd_;
@@ -224,6 +224,9 @@ static std::unordered_map<std::string, OptionTypeInfo> db_options_type_info = {
     {"compaction_readahead_size",
      {offsetof(struct DBOptions, compaction_readahead_size), OptionType::kSizeT,
       OptionVerificationType::kNormal}},
+    {"use_direct_io_for_compaction",
+     {offsetof(struct DBOptions, use_direct_io_for_compaction), OptionType::kBoolean,
+      OptionVerificationType::kNormal}},
     {"random_access_max_buffer_size",
      {offsetof(struct DBOptions, random_access_max_buffer_size),
       OptionType::kSizeT, OptionVerificationType::kNormal}},
@@ -540,12 +543,18 @@ static std::unordered_map<std::string,
     {"filter_block_size",
      {offsetof(struct BlockBasedTableOptions, filter_block_size), OptionType::kSizeT,
       OptionVerificationType::kNormal}},
+    {"fixed_size_filter_prefetch_bytes",
+     {offsetof(struct BlockBasedTableOptions, fixed_size_filter_prefetch_bytes),
+      OptionType::kSizeT, OptionVerificationType::kNormal}},
     {"block_size_deviation",
      {offsetof(struct BlockBasedTableOptions, block_size_deviation),
       OptionType::kInt, OptionVerificationType::kNormal}},
     {"block_restart_interval",
      {offsetof(struct BlockBasedTableOptions, block_restart_interval),
       OptionType::kInt, OptionVerificationType::kNormal}},
+    {"data_block_shared_suffix_encoding",
+     {offsetof(struct BlockBasedTableOptions, data_block_shared_suffix_encoding),
+      OptionType::kBoolean, OptionVerificationType::kNormal}},
     {"index_block_restart_interval",
      {offsetof(struct BlockBasedTableOptions, index_block_restart_interval),
       OptionType::kInt, OptionVerificationType::kNormal}},
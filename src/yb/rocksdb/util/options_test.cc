@@ -1620,7 +1620,8 @@ Status GetFromString(BlockBasedTableOptions* source, BlockBasedTableOptions* des
       "cache_index_and_filter_blocks=1;index_type=kHashSearch;"
       "checksum=kxxHash;hash_index_allow_collision=1;no_block_cache=1;"
       "block_cache=1M;block_cache_compressed=1k;block_size=1024;filter_block_size=16384;"
-      "block_size_deviation=8;block_restart_interval=4; "
+      "fixed_size_filter_prefetch_bytes=65536;"
+      "block_size_deviation=8;block_restart_interval=4;data_block_shared_suffix_encoding=1; "
       "index_block_restart_interval=4;index_block_size=16384;min_keys_per_index_block=16;"
       "filter_policy=bloomfilter:4:true;whole_key_filtering=1;"
       "skip_table_builder_flush=1;format_version=1;"
@@ -1628,8 +1629,9 @@ Status GetFromString(BlockBasedTableOptions* source, BlockBasedTableOptions* des
 
   RETURN_NOT_OK(GetBlockBasedTableOptionsFromString(*source, kOptionsString, destination));
 
-  // This option is not setable:
+  // These options are not setable:
   destination->use_delta_encoding = false;
+  destination->data_block_hash_index_util_ratio = 0.5;
 
   EXPECT_NE(nullptr, destination->block_cache.get());
   EXPECT_NE(nullptr, destination->block_cache_compressed.get());
@@ -1659,6 +1661,7 @@ Status GetFromString(DBOptions* source, DBOptions* destination) {
       "max_total_wal_size=4295005604;"
       "compaction_readahead_size=0;"
       "new_table_reader_for_compaction_inputs=true;"
+      "use_direct_io_for_compaction=true;"
       "keep_log_file_num=4890;"
       "skip_stats_update_on_db_open=true;"
       "max_manifest_file_size=4295009941;"
@@ -1894,6 +1897,8 @@ TEST_F(OptionsParserTest, BlockBasedTableOptionsAllFieldsSettable) {
       BLACKLIST_ENTRY(BlockBasedTableOptions, flush_block_policy_factory),
       BLACKLIST_ENTRY(BlockBasedTableOptions, block_cache),
       BLACKLIST_ENTRY(BlockBasedTableOptions, block_cache_compressed),
+      BLACKLIST_ENTRY(BlockBasedTableOptions, persistent_cache),
+      BLACKLIST_ENTRY(BlockBasedTableOptions, data_block_hash_index_key_transform),
       BLACKLIST_ENTRY(BlockBasedTableOptions, filter_policy),
   };
 
@@ -1930,11 +1935,15 @@ TEST_F(OptionsParserTest, DBOptionsAllFieldsSettable) {
       BLACKLIST_ENTRY(DBOptions, row_cache),
       BLACKLIST_ENTRY(DBOptions, wal_filter),
       BLACKLIST_ENTRY(DBOptions, boundary_extractor),
+      BLACKLIST_ENTRY(DBOptions, subcompaction_boundary_key_transform),
       BLACKLIST_ENTRY(DBOptions, mem_table_flush_filter_factory),
       BLACKLIST_ENTRY(DBOptions, log_prefix),
       BLACKLIST_ENTRY(DBOptions, mem_tracker),
       BLACKLIST_ENTRY(DBOptions, block_based_table_mem_tracker),
+      BLACKLIST_ENTRY(DBOptions, memtable_arena_block_pool),
       BLACKLIST_ENTRY(DBOptions, iterator_replacer),
+      BLACKLIST_ENTRY(DBOptions, compaction_output_path_selector),
+      BLACKLIST_ENTRY(DBOptions, compaction_compression_selector),
   };
 
   TestAllFieldsSettable<DBOptions>(kDBOptionsBlacklist);
@@ -0,0 +1,284 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rocksdb/persistent_cache.h"
+
+#include <string.h>
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <glog/logging.h>
+
+#include "yb/rocksdb/env.h"
+#include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/crc32c.h"
+
+#include "yb/util/cache_metrics.h"
+#include "yb/util/format.h"
+#include "yb/util/metrics.h"
+
+namespace rocksdb {
+
+namespace {
+
+const char kCacheFileSuffix[] = ".pcache";
+
+// Each block is stored as a record:
+//     size: fixed32
+//     masked crc32c of data: fixed32
+//     data: char[size]
+constexpr size_t kRecordHeaderSize = 2 * sizeof(uint32_t);
+
+class BlockFilePersistentCache : public PersistentCache {
+ public:
+  BlockFilePersistentCache(Env* env, const std::string& path, size_t capacity, size_t file_size)
+      : env_(env), path_(path), capacity_(capacity), file_size_(file_size) {}
+
+  Status Open() {
+    RETURN_NOT_OK(env_->CreateDirIfMissing(path_));
+    std::vector<std::string> children;
+    RETURN_NOT_OK(env_->GetChildren(path_, &children));
+    for (const auto& child : children) {
+      if (boost::ends_with(child, kCacheFileSuffix)) {
+        RETURN_NOT_OK(env_->DeleteFile(path_ + "/" + child));
+      }
+    }
+    return Status::OK();
+  }
+
+  Status Insert(const Slice& key, const Slice& data) override;
+
+  Status Lookup(const Slice& key, std::unique_ptr<char[]>* data, size_t* size) override;
+
+  uint64_t NewId() override {
+    return last_id_.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  size_t GetCapacity() const override {
+    return capacity_;
+  }
+
+  size_t GetUsage() const override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return usage_;
+  }
+
+  void SetMetrics(const scoped_refptr<yb::MetricEntity>& entity) override {
+    metrics_ = std::make_shared<yb::PersistentCacheMetrics>(entity);
+  }
+
+ private:
+  struct CacheFile {
+    std::string name;
+    std::unique_ptr<RandomAccessFile> reader;
+    uint64_t size = 0;
+    // Keys of blocks written to this file, used to clean up the index when the file is evicted.
+    std::vector<std::string> keys;
+  };
+
+  typedef std::shared_ptr<CacheFile> CacheFilePtr;
+
+  struct BlockLocation {
+    // Keeps the file readable while lookup is in progress, even if the file is evicted.
+    CacheFilePtr file;
+    uint64_t offset;
+    size_t size;
+  };
+
+  // Starts a new file for writing.
+  // REQUIRES: write_mutex_ is locked.
+  Status StartNewFile();
+
+  // Removes the oldest file from the index and returns it, so the caller could delete it after
+  // releasing the mutex.
+  // REQUIRES: mutex_ is locked.
+  CacheFilePtr EvictOldestFile();
+
+  Env* const env_;
+  const std::string path_;
+  const size_t capacity_;
+  const size_t file_size_;
+  std::atomic<uint64_t> last_id_{0};
+  std::shared_ptr<yb::PersistentCacheMetrics> metrics_;
+
+  // Serializes writers.
+  std::mutex write_mutex_;
+  std::unique_ptr<WritableFile> writer_;
+  CacheFilePtr current_file_;
+  uint64_t next_file_number_ = 0;
+
+  // Protects the index and the list of files, never held during IO.
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, BlockLocation> index_;
+  // Files ordered from the oldest to the newest one.
+  std::deque<CacheFilePtr> files_;
+  size_t usage_ = 0;
+};
+
+Status BlockFilePersistentCache::StartNewFile() {
+  writer_.reset();
+  current_file_.reset();
+
+  auto file = std::make_shared<CacheFile>();
+  file->name = yb::Format("$0/$1$2", path_, next_file_number_++, kCacheFileSuffix);
+  EnvOptions env_options;
+  std::unique_ptr<WritableFile> writer;
+  RETURN_NOT_OK(env_->NewWritableFile(file->name, &writer, env_options));
+  RETURN_NOT_OK(env_->NewRandomAccessFile(file->name, &file->reader, env_options));
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    files_.push_back(file);
+  }
+  writer_ = std::move(writer);
+  current_file_ = std::move(file);
+  return Status::OK();
+}
+
+BlockFilePersistentCache::CacheFilePtr BlockFilePersistentCache::EvictOldestFile() {
+  auto file = std::move(files_.front());
+  files_.pop_front();
+  for (const auto& key : file->keys) {
+    auto it = index_.find(key);
+    // The key could be overwritten by a newer file.
+    if (it != index_.end() && it->second.file == file) {
+      index_.erase(it);
+    }
+  }
+  usage_ -= file->size;
+  if (metrics_) {
+    metrics_->evictions->IncrementBy(file->keys.size());
+    metrics_->cache_usage->DecrementBy(file->size);
+  }
+  return file;
+}
+
+Status BlockFilePersistentCache::Insert(const Slice& key, const Slice& data) {
+  char header[kRecordHeaderSize];
+  EncodeFixed32(header, static_cast<uint32_t>(data.size()));
+  EncodeFixed32(
+      header + sizeof(uint32_t), crc32c::Mask(crc32c::Value(data.cdata(), data.size())));
+  const size_t record_size = kRecordHeaderSize + data.size();
+
+  std::lock_guard<std::mutex> write_lock(write_mutex_);
+  Status s;
+  if (!writer_ || (current_file_->size != 0 && current_file_->size + record_size > file_size_)) {
+    s = StartNewFile();
+  }
+  if (s.ok()) {
+    s = writer_->Append(Slice(header, kRecordHeaderSize));
+  }
+  if (s.ok()) {
+    s = writer_->Append(data);
+  }
+  if (!s.ok()) {
+    // Partially written record is never indexed, just continue with a new file.
+    writer_.reset();
+    if (metrics_) {
+      metrics_->insert_failures->Increment();
+    }
+    return s;
+  }
+
+  const uint64_t offset = current_file_->size;
+  std::vector<CacheFilePtr> evicted_files;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    current_file_->size += record_size;
+    current_file_->keys.push_back(key.ToBuffer());
+    index_[key.ToBuffer()] = BlockLocation{current_file_, offset, data.size()};
+    usage_ += record_size;
+    if (metrics_) {
+      metrics_->inserts->Increment();
+      metrics_->cache_usage->IncrementBy(record_size);
+    }
+    // The file that is being written is never evicted.
+    while (usage_ > capacity_ && files_.size() > 1) {
+      evicted_files.push_back(EvictOldestFile());
+    }
+  }
+  // Readers that already found a block keep its file open, so it is safe to delete it here.
+  for (const auto& file : evicted_files) {
+    WARN_NOT_OK(env_->DeleteFile(file->name), "Failed to delete persistent cache file");
+  }
+  return Status::OK();
+}
+
+Status BlockFilePersistentCache::Lookup(
+    const Slice& key, std::unique_ptr<char[]>* data, size_t* size) {
+  if (metrics_) {
+    metrics_->lookups->Increment();
+  }
+  BlockLocation location;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key.ToBuffer());
+    if (it == index_.end()) {
+      if (metrics_) {
+        metrics_->cache_misses->Increment();
+      }
+      return STATUS(NotFound, "Block not found in persistent cache");
+    }
+    location = it->second;
+  }
+
+  const size_t record_size = kRecordHeaderSize + location.size;
+  std::unique_ptr<char[]> buffer(new char[record_size]);
+  Slice record;
+  Status s = location.file->reader->Read(location.offset, record_size, &record, buffer.get());
+  if (s.ok()) {
+    if (record.size() != record_size ||
+        DecodeFixed32(record.data()) != location.size ||
+        crc32c::Unmask(DecodeFixed32(record.data() + sizeof(uint32_t))) !=
+            crc32c::Value(record.cdata() + kRecordHeaderSize, location.size)) {
+      s = STATUS_FORMAT(
+          Corruption, "Corrupted persistent cache record in $0 at $1",
+          location.file->name, location.offset);
+    }
+  }
+  if (!s.ok()) {
+    LOG(WARNING) << "Failed to read persistent cache: " << s;
+    if (metrics_) {
+      metrics_->cache_misses->Increment();
+    }
+    return STATUS(NotFound, "Block not found in persistent cache", s.ToString());
+  }
+
+  // Move data to the beginning of the buffer, so it could be owned by the caller.
+  memmove(buffer.get(), record.cdata() + kRecordHeaderSize, location.size);
+  *data = std::move(buffer);
+  *size = location.size;
+  if (metrics_) {
+    metrics_->cache_hits->Increment();
+  }
+  return Status::OK();
+}
+
+} // namespace
+
+Status NewPersistentCache(
+    Env* env, const std::string& path, size_t capacity, size_t file_size,
+    std::shared_ptr<PersistentCache>* result) {
+  auto cache = std::make_shared<BlockFilePersistentCache>(env, path, capacity, file_size);
+  RETURN_NOT_OK(cache->Open());
+  *result = std::move(cache);
+  return Status::OK();
+}
+
+}  // namespace rocksdb
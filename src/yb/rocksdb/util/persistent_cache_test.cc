@@ -0,0 +1,120 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rocksdb/persistent_cache.h"
+
+#include <string>
+#include <vector>
+
+#include "yb/rocksdb/env.h"
+#include "yb/rocksdb/util/testharness.h"
+
+namespace rocksdb {
+
+class PersistentCacheTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    path_ = test::TmpDir(env_) + "/persistent_cache_test";
+  }
+
+  std::shared_ptr<PersistentCache> NewCache(size_t capacity, size_t file_size) {
+    std::shared_ptr<PersistentCache> cache;
+    EXPECT_OK(NewPersistentCache(env_, path_, capacity, file_size, &cache));
+    return cache;
+  }
+
+  bool Lookup(PersistentCache* cache, const std::string& key, std::string* value) {
+    std::unique_ptr<char[]> data;
+    size_t size = 0;
+    auto status = cache->Lookup(key, &data, &size);
+    if (!status.ok()) {
+      EXPECT_TRUE(status.IsNotFound()) << status;
+      return false;
+    }
+    value->assign(data.get(), size);
+    return true;
+  }
+
+  Env* env_ = Env::Default();
+  std::string path_;
+};
+
+TEST_F(PersistentCacheTest, InsertLookup) {
+  auto cache = NewCache(1024 * 1024, 4096);
+  std::string value;
+  ASSERT_FALSE(Lookup(cache.get(), "key1", &value));
+
+  ASSERT_OK(cache->Insert("key1", "value1"));
+  ASSERT_OK(cache->Insert("key2", std::string(10000, 'x')));
+  ASSERT_TRUE(Lookup(cache.get(), "key1", &value));
+  ASSERT_EQ("value1", value);
+  ASSERT_TRUE(Lookup(cache.get(), "key2", &value));
+  ASSERT_EQ(std::string(10000, 'x'), value);
+
+  // Newer data replaces the old one.
+  ASSERT_OK(cache->Insert("key1", "value2"));
+  ASSERT_TRUE(Lookup(cache.get(), "key1", &value));
+  ASSERT_EQ("value2", value);
+
+  ASSERT_NE(cache->NewId(), cache->NewId());
+}
+
+TEST_F(PersistentCacheTest, Eviction) {
+  constexpr size_t kValueSize = 1000;
+  constexpr size_t kNumKeys = 100;
+  // Each file contains a few values, and the whole cache only a few files.
+  auto cache = NewCache(10 * kValueSize, 3 * kValueSize);
+  auto value_for_key = [](size_t i) {
+    return std::string(kValueSize, static_cast<char>('a' + i % 26));
+  };
+  for (size_t i = 0; i != kNumKeys; ++i) {
+    ASSERT_OK(cache->Insert(std::to_string(i), value_for_key(i)));
+    ASSERT_LE(cache->GetUsage(), cache->GetCapacity());
+  }
+
+  std::string value;
+  // Oldest keys are evicted, while the latest ones are still there.
+  ASSERT_FALSE(Lookup(cache.get(), "0", &value));
+  ASSERT_TRUE(Lookup(cache.get(), std::to_string(kNumKeys - 1), &value));
+  ASSERT_EQ(value_for_key(kNumKeys - 1), value);
+
+  // Evicted files are removed from the device.
+  std::vector<std::string> children;
+  ASSERT_OK(env_->GetChildren(path_, &children));
+  size_t num_files = 0;
+  for (const auto& child : children) {
+    if (child != "." && child != "..") {
+      ++num_files;
+    }
+  }
+  ASSERT_LE(num_files, 5U);
+}
+
+TEST_F(PersistentCacheTest, Reopen) {
+  auto cache = NewCache(1024 * 1024, 4096);
+  ASSERT_OK(cache->Insert("key", "value"));
+  cache.reset();
+
+  // Content does not survive reopening.
+  cache = NewCache(1024 * 1024, 4096);
+  std::string value;
+  ASSERT_FALSE(Lookup(cache.get(), "key", &value));
+  ASSERT_EQ(0U, cache->GetUsage());
+}
+
+}  // namespace rocksdb
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -22,6 +22,9 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 
 #include "yb/rocksdb/util/rate_limiter.h"
+
+#include <algorithm>
+
 #include "yb/rocksdb/env.h"
 
 namespace rocksdb {
@@ -82,7 +85,9 @@ void GenericRateLimiter::SetBytesPerSecond(int64_t bytes_per_second) {
 }
 
 void GenericRateLimiter::Request(int64_t bytes, const Env::IOPriority pri) {
-  assert(bytes <= refill_bytes_per_period_.load(std::memory_order_relaxed));
+  // The rate could be lowered by SetBytesPerSecond after the caller checked GetSingleBurstBytes,
+  // so the request is capped here, otherwise it would never be granted.
+  bytes = std::min(bytes, refill_bytes_per_period_.load(std::memory_order_relaxed));
 
   MutexLock g(&request_mutex_);
   if (stop_) {
@@ -32,10 +32,12 @@
 #include <inttypes.h>
 #include <algorithm>
 #include <string>
+#include <unordered_map>
 #include "yb/rocksdb/db/filename.h"
 #include "yb/rocksdb/db/wal_manager.h"
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/env.h"
+#include "yb/rocksdb/metadata.h"
 #include "yb/rocksdb/transaction_log.h"
 #include "yb/rocksdb/util/file_util.h"
 #include "yb/rocksdb/port/port.h"
@@ -77,6 +79,20 @@ Status CreateCheckpoint(DB* db, const std::string& checkpoint_dir) {
   if (s.ok()) {
     s = db->GetSortedWalFiles(&live_wal_files);
   }
+  // Table files could be in other db_paths than the DB directory.
+  std::unordered_map<uint64_t, std::string> table_file_paths;
+  if (s.ok() && db->GetDBOptions().db_paths.size() > 1) {
+    std::vector<LiveFileMetaData> files_metadata;
+    db->GetLiveFilesMetaData(&files_metadata);
+    for (const auto& file_metadata : files_metadata) {
+      uint64_t number;
+      FileType type;
+      if (file_metadata.db_path != db->GetName() &&
+          ParseFileName(file_metadata.name, &number, &type)) {
+        table_file_paths.emplace(number, file_metadata.db_path);
+      }
+    }
+  }
   if (!s.ok()) {
     db->EnableFileDeletions(false);
     return s;
@@ -112,6 +128,20 @@ Status CreateCheckpoint(DB* db, const std::string& checkpoint_dir) {
     // * if it's kDescriptorFile, limit the size to manifest_file_size
     // * always copy if cross-device link
     bool is_table_file = type == kTableFile || type == kTableSBlockFile;
+    auto path_it = is_table_file ? table_file_paths.find(number) : table_file_paths.end();
+    if (path_it != table_file_paths.end() &&
+        db->GetCheckpointEnv()->FileExists(path_it->second + src_fname).ok()) {
+      // The file is in another db_path, that is usually on another drive, so it is linked if
+      // possible but does not affect linking of files in the DB directory.
+      const auto source_name = path_it->second + src_fname;
+      RLOG(db->GetOptions().info_log, "Hard Linking %s", source_name.c_str());
+      s = db->GetCheckpointEnv()->LinkFile(source_name, full_private_path + src_fname);
+      if (s.IsNotSupported()) {
+        RLOG(db->GetOptions().info_log, "Copying %s", source_name.c_str());
+        s = CopyFile(db->GetCheckpointEnv(), source_name, full_private_path + src_fname, 0);
+      }
+      continue;
+    }
     if (is_table_file && same_fs) {
       RLOG(db->GetOptions().info_log, "Hard Linking %s", src_fname.c_str());
       s = db->GetCheckpointEnv()->LinkFile(db->GetName() + src_fname,
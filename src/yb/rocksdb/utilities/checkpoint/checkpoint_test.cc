@@ -34,7 +34,9 @@
 #include "yb/rocksdb/port/stack_trace.h"
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/env.h"
+#include "yb/rocksdb/sst_file_manager.h"
 #include "yb/rocksdb/utilities/checkpoint.h"
+#include "yb/rocksdb/util/sst_file_manager_impl.h"
 #include "yb/rocksdb/util/sync_point.h"
 #include "yb/rocksdb/util/testharness.h"
 #include "yb/rocksdb/util/xfunc.h"
@@ -281,6 +283,53 @@ TEST_F(DBTest, GetSnapshotLink) {
     dbname_ = test::TmpDir(env_) + "/db_test";
 }
 
+// SST files of a checkpoint are hard links to files of the live DB. Deleting the checkpoint
+// through the trash, that truncates large files in chunks, should not change the live DB.
+TEST_F(DBTest, DeleteCheckpointThroughTrash) {
+  constexpr int kNumKeys = 100;
+  const std::string snapshot_name = test::TmpDir(env_) + "/snapshot";
+  const std::string trash_dir = test::TmpDir(env_) + "/trash";
+  const auto old_chunk_bytes = FLAGS_trash_file_truncate_chunk_bytes;
+  FLAGS_trash_file_truncate_chunk_bytes = 1024;
+
+  Options options = CurrentOptions();
+  options.compression = kNoCompression;
+  Reopen(options);
+  ASSERT_OK(DestroyDB(snapshot_name, options));
+  env_->DeleteDir(snapshot_name);
+
+  auto value = [](int i) { return std::string(1000, static_cast<char>('a' + i % 26)); };
+  for (int i = 0; i != kNumKeys; ++i) {
+    ASSERT_OK(Put(yb::Format("key-$0", i), value(i)));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_OK(checkpoint::CreateCheckpoint(db_, snapshot_name));
+
+  Status status;
+  std::unique_ptr<SstFileManager> sst_file_manager(NewSstFileManager(
+      env_, nullptr /* info_log */, trash_dir, 1024 * 1024 /* rate_bytes_per_sec */,
+      true /* delete_existing_trash */, &status));
+  ASSERT_OK(status);
+  auto* sst_file_manager_impl = static_cast<SstFileManagerImpl*>(sst_file_manager.get());
+  std::vector<std::string> files;
+  ASSERT_OK(env_->GetChildren(snapshot_name, &files));
+  for (const auto& file : files) {
+    if (file != "." && file != "..") {
+      ASSERT_OK(sst_file_manager_impl->ScheduleFileDeletion(snapshot_name + "/" + file));
+    }
+  }
+  sst_file_manager_impl->WaitForEmptyTrash();
+  ASSERT_OK(env_->DeleteDir(snapshot_name));
+
+  // Reopen, so the values are read from the SST files.
+  Reopen(options);
+  for (int i = 0; i != kNumKeys; ++i) {
+    ASSERT_EQ(value(i), Get(yb::Format("key-$0", i)));
+  }
+
+  FLAGS_trash_file_truncate_chunk_bytes = old_chunk_bytes;
+}
+
 TEST_F(DBTest, CheckpointCF) {
   Options options = CurrentOptions();
   CreateAndReopenWithCF({"one", "two", "three", "four", "five"}, options);
@@ -21,6 +21,7 @@
 #include "yb/util/logging.h"
 #include "yb/util/size_literals.h"
 
+using yb::operator"" _KB;
 using yb::operator"" _MB;
 
 DEFINE_bool(
@@ -37,6 +38,12 @@ DECLARE_int32(memory_limit_warn_threshold_percentage);
 namespace yb {
 namespace rpc {
 
+namespace {
+
+const size_t kMaxRejectedCallPrefix = 1_KB;
+
+} // namespace
+
 bool ShouldThrottleRpc(
     const MemTrackerPtr& throttle_tracker, size_t call_data_size, const char* throttle_message) {
   return (FLAGS_rpc_throttle_threshold_bytes >= 0 &&
@@ -106,8 +113,9 @@ Result<ProcessDataResult> BinaryCallParser::Parse(
         VLOG(4) << "BinaryCallParser::Parse, tracker_for_throttle memory usage: "
                 << (*tracker_for_throttle)->LogUsage("");
         if (ShouldThrottleRpc(*tracker_for_throttle, call_data_size, "Ignoring RPC call: ")) {
-          call_data_ = CallData(call_data_size, ShouldReject::kTrue);
-          return ProcessDataResult{ full_input_size, Slice(), call_data_size - call_received_size };
+          return RejectCall(
+              connection, data, consumed + body_offset, call_data_size,
+              STATUS(ServiceUnavailable, "Call rejected due to memory pressure"));
         }
       }
 
@@ -131,8 +139,10 @@ Result<ProcessDataResult> BinaryCallParser::Parse(
               << ", blocked by: " << AsString(blocking_mem_tracker)
               << ", consumption: " << consumption << " of " << limit << ". Call will be ignored.\n"
               << DumpMemoryUsage();
-          call_data_ = CallData(call_data_size, ShouldReject::kTrue);
-          return ProcessDataResult{full_input_size, Slice(), call_data_size - call_received_size};
+          return RejectCall(
+              connection, data, consumed + body_offset, call_data_size,
+              STATUS_FORMAT(ServiceUnavailable, "Call rejected because of memory limit of $0",
+                            AsString(blocking_mem_tracker)));
         } else {
           // For backward compatibility in behavior until we fix
           // https://github.com/yugabyte/yugabyte-db/issues/2563.
@@ -160,5 +170,20 @@ Result<ProcessDataResult> BinaryCallParser::Parse(
   return ProcessDataResult{ consumed, Slice() };
 }
 
+ProcessDataResult BinaryCallParser::RejectCall(
+    const ConnectionPtr& connection, const IoVecs& data, size_t begin, size_t call_data_size,
+    const Status& status) {
+  const auto full_input_size = IoVecsFullSize(data);
+  const size_t call_received_size = full_input_size - begin;
+  // Call header is small, so the prefix is limited to avoid copying big part of the call data.
+  std::vector<char> prefix;
+  IoVecsToBuffer(
+      data, begin, begin + std::min(call_received_size, kMaxRejectedCallPrefix), &prefix);
+  listener_->CallRejected(connection, Slice(prefix.data(), prefix.size()), status);
+
+  call_data_ = CallData(call_data_size, ShouldReject::kTrue);
+  return ProcessDataResult{full_input_size, Slice(), call_data_size - call_received_size};
+}
+
 } // namespace rpc
 } // namespace yb
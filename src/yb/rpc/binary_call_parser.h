@@ -31,6 +31,12 @@ YB_STRONGLY_TYPED_BOOL(SkipEmptyMessages);
 class BinaryCallParserListener {
  public:
   virtual CHECKED_STATUS HandleCall(const ConnectionPtr& connection, CallData* call_data) = 0;
+
+  // Invoked when a call is rejected before all its data has been received, for instance because of
+  // memory pressure. prefix contains the beginning of the call data, so the listener could decode
+  // the call header and respond with an error, instead of letting the caller wait for a timeout.
+  virtual void CallRejected(
+      const ConnectionPtr& connection, const Slice& prefix, const Status& status) {}
  protected:
   ~BinaryCallParserListener() {}
 };
@@ -50,6 +56,11 @@ class BinaryCallParser {
                                   const MemTrackerPtr* tracker_for_throttle);
 
  private:
+  // Rejects the call whose data starts at offset begin of data, skipping the rest of its data.
+  ProcessDataResult RejectCall(
+      const ConnectionPtr& connection, const IoVecs& data, size_t begin, size_t call_data_size,
+      const Status& status);
+
   MemTrackerPtr buffer_tracker_;
   std::vector<char> call_header_buffer_;
   ScopedTrackedConsumption call_data_consumption_;
@@ -32,6 +32,7 @@
 
 #include "yb/rpc/connection.h"
 
+#include <algorithm>
 #include <iostream>
 #include <thread>
 #include <utility>
@@ -192,11 +193,12 @@ void Connection::HandleTimeout(ev::timer& watcher, int revents) {  // NOLINT
     }
   }
 
-  while (!expiration_queue_.empty() && expiration_queue_.top().time <= now) {
-    auto& top = expiration_queue_.top();
+  while (!expiration_queue_.empty() && expiration_queue_.front().time <= now) {
+    std::pop_heap(expiration_queue_.begin(), expiration_queue_.end(), CompareExpiration());
+    auto& top = expiration_queue_.back();
     auto call = top.call.lock();
     auto handle = top.handle;
-    expiration_queue_.pop();
+    expiration_queue_.pop_back();
     if (call && !call->IsFinished()) {
       call->SetTimedOut();
       if (handle != std::numeric_limits<size_t>::max()) {
@@ -210,7 +212,7 @@ void Connection::HandleTimeout(ev::timer& watcher, int revents) {  // NOLINT
   }
 
   if (!expiration_queue_.empty()) {
-    deadline = std::min(deadline, expiration_queue_.top().time);
+    deadline = std::min(deadline, expiration_queue_.front().time);
   }
 
   if (deadline != CoarseTimePoint::max()) {
@@ -218,6 +220,24 @@ void Connection::HandleTimeout(ev::timer& watcher, int revents) {  // NOLINT
   }
 }
 
+void Connection::PushExpiration(ExpirationEntry entry) {
+  // Don't bother with compaction of small queues.
+  constexpr size_t kMinSizeToCompact = 64;
+  if (expiration_queue_.size() >= kMinSizeToCompact &&
+      expiration_queue_.size() >= expiration_queue_compacted_size_ * 2) {
+    auto it = std::remove_if(
+        expiration_queue_.begin(), expiration_queue_.end(), [](const ExpirationEntry& entry) {
+      auto call = entry.call.lock();
+      return !call || call->IsFinished();
+    });
+    expiration_queue_.erase(it, expiration_queue_.end());
+    std::make_heap(expiration_queue_.begin(), expiration_queue_.end(), CompareExpiration());
+    expiration_queue_compacted_size_ = expiration_queue_.size();
+  }
+  expiration_queue_.push_back(std::move(entry));
+  std::push_heap(expiration_queue_.begin(), expiration_queue_.end(), CompareExpiration());
+}
+
 void Connection::QueueOutboundCall(const OutboundCallPtr& call) {
   DCHECK(call);
   DCHECK_EQ(direction_, Direction::CLIENT);
@@ -228,8 +248,8 @@ void Connection::QueueOutboundCall(const OutboundCallPtr& call) {
   const MonoDelta& timeout = call->controller()->timeout();
   if (timeout.Initialized()) {
     auto expires_at = CoarseMonoClock::Now() + timeout.ToSteadyDuration();
-    auto reschedule = expiration_queue_.empty() || expiration_queue_.top().time > expires_at;
-    expiration_queue_.push({expires_at, call, handle});
+    auto reschedule = expiration_queue_.empty() || expiration_queue_.front().time > expires_at;
+    PushExpiration({expires_at, call, handle});
     if (reschedule && (stream_->IsConnected() ||
                        expires_at < last_activity_time_ + FLAGS_rpc_connection_timeout_ms * 1ms)) {
       timer_.Start(timeout.ToSteadyDuration());
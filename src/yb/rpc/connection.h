@@ -37,7 +37,6 @@
 #include <cstdint>
 #include <limits>
 #include <memory>
-#include <queue>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -246,9 +245,17 @@ class Connection final : public StreamContext, public std::enable_shared_from_th
     }
   };
 
-  std::priority_queue<ExpirationEntry,
-                      std::vector<ExpirationEntry>,
-                      CompareExpiration> expiration_queue_;
+  // Adds expiration entry for the call, compacting the queue when it is mostly filled by entries
+  // of calls that already finished.
+  void PushExpiration(ExpirationEntry entry);
+
+  // Binary heap of expiration entries, ordered by CompareExpiration. Entries of finished calls are
+  // not removed one by one, since the heap does not support removal from the middle, so the
+  // whole heap is compacted after its size doubles. It keeps the heap size proportional to the
+  // number of calls in flight, instead of the number of calls sent during the RPC timeout.
+  std::vector<ExpirationEntry> expiration_queue_;
+  // Size of the heap after the last compaction.
+  size_t expiration_queue_compacted_size_ = 0;
 
   EvTimerHolder timer_;
 
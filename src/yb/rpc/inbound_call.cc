@@ -101,6 +101,10 @@ InboundCall::~InboundCall() {
 void InboundCall::NotifyTransferred(const Status& status, Connection* conn) {
   if (status.ok()) {
     TRACE_TO(trace_, "Transfer finished");
+    if (call_phase_metrics_) {
+      timing_.time_transferred = MonoTime::Now();
+      call_phase_metrics_->Record(timing_);
+    }
   } else {
     YB_LOG_EVERY_N_SECS(WARNING, 10) << LogPrefix() << "Connection torn down before " << ToString()
                                      << " could send its response: " << status.ToString();
@@ -164,6 +168,27 @@ void InboundCall::RecordHandlingCompleted(scoped_refptr<Histogram> handler_run_t
   }
 }
 
+void InboundCall::DumpPhasesPB(RpcCallPhasesPB* phases) const {
+  auto since_received = [this](const MonoTime& time) {
+    return time.GetDeltaSince(timing_.time_received).ToMicroseconds();
+  };
+  if (timing_.time_queued.Initialized()) {
+    phases->set_queued_micros(since_received(timing_.time_queued));
+  }
+  if (timing_.time_handled.Initialized()) {
+    phases->set_handled_micros(since_received(timing_.time_handled));
+  }
+  if (timing_.time_request_parsed.Initialized()) {
+    phases->set_request_parsed_micros(since_received(timing_.time_request_parsed));
+  }
+  if (timing_.time_completed.Initialized()) {
+    phases->set_completed_micros(since_received(timing_.time_completed));
+  }
+  if (timing_.time_response_serialized.Initialized()) {
+    phases->set_response_serialized_micros(since_received(timing_.time_response_serialized));
+  }
+}
+
 bool InboundCall::ClientTimedOut() const {
   auto deadline = GetClientDeadline();
   if (deadline == CoarseTimePoint::max()) {
@@ -176,6 +201,7 @@ bool InboundCall::ClientTimedOut() const {
 void InboundCall::QueueResponse(bool is_success) {
   TRACE_TO(trace_, is_success ? "Queueing success response" : "Queueing failure response");
   LogTrace();
+  trace_->EndSpan();
   bool expected = false;
   if (responded_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
     connection()->context().QueueResponse(connection(), shared_from(this));
@@ -75,13 +75,18 @@ namespace rpc {
 
 class DumpRunningRpcsRequestPB;
 class RpcCallInProgressPB;
+class RpcCallPhasesPB;
 class RpcCallDetailsPB;
 class CQLCallDetailsPB;
 
 struct InboundCallTiming {
-  MonoTime time_received;   // Time the call was first accepted.
-  MonoTime time_handled;    // Time the call handler was kicked off.
-  MonoTime time_completed;  // Time the call handler completed.
+  MonoTime time_received;             // Time the call was read from the socket.
+  MonoTime time_queued;               // Time the call was queued to the service.
+  MonoTime time_handled;              // Time the call handler was kicked off.
+  MonoTime time_request_parsed;       // Time the request protobuf was parsed.
+  MonoTime time_completed;            // Time the call handler completed.
+  MonoTime time_response_serialized;  // Time the response was serialized.
+  MonoTime time_transferred;          // Time the response was written to the socket.
 };
 
 class InboundCallHandler {
@@ -137,6 +142,16 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
   // Not thread-safe. Should only be called by the current "owner" thread.
   void RecordHandlingCompleted(scoped_refptr<Histogram> handler_run_time);
 
+  // When the request protobuf was parsed by the handler.
+  void RecordRequestParsed() {
+    timing_.time_request_parsed = MonoTime::Now();
+  }
+
+  // Histograms updated with the duration of the call phases, when the response is transferred.
+  void SetCallPhaseMetrics(std::shared_ptr<const RpcCallPhaseMetrics> call_phase_metrics) {
+    call_phase_metrics_ = std::move(call_phase_metrics);
+  }
+
   // Return true if the deadline set by the client has already elapsed.
   // In this case, the server may stop processing the call, since the
   // call response will be ignored anyway.
@@ -157,6 +172,7 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
       return nullptr;
     }
     tracker_ = handler;
+    timing_.time_queued = MonoTime::Now();
     task_.Bind(handler, shared_this);
     return &task_;
   }
@@ -209,6 +225,9 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
 
   void QueueResponse(bool is_success);
 
+  // Fills microseconds since the call was received for each phase reached by the call.
+  void DumpPhasesPB(RpcCallPhasesPB* phases) const;
+
   // The serialized bytes of the request param protobuf. Set by ParseFrom().
   // This references memory held by 'request_data_'.
   Slice serialized_request_;
@@ -230,6 +249,7 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
   // The connection on which this inbound call arrived. Can be null for LocalYBInboundCall.
   ConnectionPtr conn_ = nullptr;
   RpcMetrics* rpc_metrics_;
+  std::shared_ptr<const RpcCallPhaseMetrics> call_phase_metrics_;
   const std::function<void(InboundCall*)> call_processed_listener_;
 
   class InboundCallTask : public ThreadPoolTask {
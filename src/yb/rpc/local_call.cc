@@ -15,6 +15,8 @@
 
 #include "yb/rpc/local_call.h"
 
+#include <google/protobuf/io/coded_stream.h>
+
 #include "yb/rpc/rpc_controller.h"
 #include "yb/util/memory/memory.h"
 
@@ -34,7 +36,23 @@ LocalOutboundCall::LocalOutboundCall(
 
 Status LocalOutboundCall::SetRequestParam(
     const google::protobuf::Message& req, const MemTrackerPtr& mem_tracker) {
-  req_ = &req;
+  const auto& attachments = controller()->request_attachments();
+  if (attachments.empty()) {
+    req_ = &req;
+    return Status::OK();
+  }
+
+  // There is no wire format for local calls, so attachments are parsed into a copy of the request.
+  req_with_attachments_.reset(req.New());
+  req_with_attachments_->CopyFrom(req);
+  for (const auto& attachment : attachments) {
+    google::protobuf::io::CodedInputStream in(
+        attachment.udata(), static_cast<int>(attachment.size()));
+    if (!req_with_attachments_->MergePartialFromCodedStream(&in)) {
+      return STATUS(InvalidArgument, "Failed to parse request attachment");
+    }
+  }
+  req_ = req_with_attachments_.get();
   return Status::OK();
 }
 
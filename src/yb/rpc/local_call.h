@@ -49,6 +49,9 @@ class LocalOutboundCall : public OutboundCall {
 
   const google::protobuf::Message* req_ = nullptr;
 
+  // Copy of the request merged with request attachments, if any.
+  std::unique_ptr<google::protobuf::Message> req_with_attachments_;
+
   std::shared_ptr<LocalYBInboundCall> inbound_call_;
 };
 
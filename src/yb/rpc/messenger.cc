@@ -68,6 +68,7 @@
 #include "yb/util/metrics.h"
 #include "yb/util/monotime.h"
 #include "yb/util/net/socket.h"
+#include "yb/util/numa.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/status.h"
@@ -94,6 +95,10 @@ DEFINE_int64(outbound_rpc_memory_limit, 0, "Outbound RPC memory limit");
 
 DEFINE_int32(rpc_queue_limit, 10000, "Queue limit for rpc server");
 DEFINE_int32(rpc_workers_limit, 256, "Workers limit for rpc server");
+DEFINE_bool(rpc_thread_pool_shard_per_reactor, false,
+            "Split the queue of the rpc thread pool into a shard per reactor, so inbound calls "
+            "are preferably run by workers of the shard of the reactor that received them.");
+TAG_FLAG(rpc_thread_pool_shard_per_reactor, advanced);
 
 DEFINE_int32(socket_receive_buffer_size, 0, "Socket receive buffer size, 0 to use default");
 
@@ -390,7 +395,7 @@ rpc::ThreadPool& Messenger::ThreadPool(ServicePriority priority) {
       }
       const ThreadPoolOptions& options = normal_thread_pool_->options();
       high_priority_thread_pool_.reset(new rpc::ThreadPool(
-          name_ + "-high-pri", options.queue_limit, options.max_workers));
+          name_ + "-high-pri", options.queue_limit, options.max_workers, options.num_shards));
       return *high_priority_thread_pool_.get();
   }
   FATAL_INVALID_ENUM_VALUE(ServicePriority, priority);
@@ -558,7 +563,10 @@ Messenger::Messenger(const MessengerBuilder &bld)
       metric_entity_(bld.metric_entity_),
       io_thread_pool_(name_, FLAGS_io_thread_pool_size),
       scheduler_(&io_thread_pool_.io_service()),
-      normal_thread_pool_(new rpc::ThreadPool(name_, bld.queue_limit_, bld.workers_limit_)),
+      normal_thread_pool_(new rpc::ThreadPool(
+          name_, bld.queue_limit_, bld.workers_limit_,
+          static_cast<size_t>(FLAGS_rpc_thread_pool_shard_per_reactor || NumaPlacementEnabled()
+                                  ? bld.num_reactors_ : 1))),
       rpc_metrics_(new RpcMetrics(bld.metric_entity_)),
       num_connections_to_server_(bld.num_connections_to_server_) {
 #ifndef NDEBUG
@@ -204,7 +204,7 @@ OutboundCall::OutboundCall(const RemoteMethod* remote_method,
   TRACE_TO_WITH_TIME(trace_, start_, "Outbound Call initiated.");
 
   if (Trace::CurrentTrace()) {
-    Trace::CurrentTrace()->AddChildTrace(trace_.get());
+    Trace::CurrentTrace()->AddChildTrace(trace_.get(), remote_method_->method_name());
   }
 
   DVLOG(4) << "OutboundCall " << this << " constructed with state_: " << StateName(state_)
@@ -250,6 +250,10 @@ void OutboundCall::NotifyTransferred(const Status& status, Connection* conn) {
 void OutboundCall::Serialize(boost::container::small_vector_base<RefCntBuffer>* output) {
   output->push_back(std::move(buffer_));
   buffer_consumption_ = ScopedTrackedConsumption();
+  for (auto& attachment : request_attachments_) {
+    output->push_back(std::move(attachment));
+  }
+  request_attachments_.clear();
 }
 
 Status OutboundCall::SetRequestParam(
@@ -257,10 +261,18 @@ Status OutboundCall::SetRequestParam(
   using serialization::SerializeHeader;
   using serialization::SerializeMessage;
 
+  // Attachments are serialized protobuf fields, so they are appended to the message and accounted
+  // in its size.
+  request_attachments_ = controller_->request_attachments();
+  size_t attachments_size = 0;
+  for (const auto& attachment : request_attachments_) {
+    attachments_size += attachment.size();
+  }
+
   size_t message_size = 0;
   auto status = SerializeMessage(message,
                                  /* param_buf */ nullptr,
-                                 /* additional_size */ 0,
+                                 attachments_size,
                                  /* use_cached_size */ false,
                                  /* offset */ 0,
                                  &message_size);
@@ -271,7 +283,8 @@ Status OutboundCall::SetRequestParam(
 
   RequestHeader header;
   InitHeader(&header);
-  status = SerializeHeader(header, message_size, &buffer_, message_size, &header_size);
+  status = SerializeHeader(
+      header, message_size + attachments_size, &buffer_, message_size, &header_size);
   remote_method_pool_->Release(header.release_remote_method());
   if (!status.ok()) {
     return status;
@@ -283,7 +296,7 @@ Status OutboundCall::SetRequestParam(
 
   return SerializeMessage(message,
                           &buffer_,
-                          /* additional_size */ 0,
+                          attachments_size,
                           /* use_cached_size */ true,
                           header_size);
 }
@@ -364,6 +377,7 @@ bool OutboundCall::SetState(State new_state) {
 }
 
 void OutboundCall::InvokeCallback() {
+  trace_->EndSpan();
   if (callback_thread_pool_) {
     callback_task_.SetOutboundCall(shared_from(this));
     callback_thread_pool_->Enqueue(&callback_task_);
@@ -565,6 +579,11 @@ void OutboundCall::InitHeader(RequestHeader* header) {
     }
   }
   header->set_allocated_remote_method(remote_method_pool_->Take());
+  if (trace_->sampled()) {
+    auto* trace_context = header->mutable_trace_context();
+    trace_context->set_trace_id(trace_->trace_id());
+    trace_context->set_parent_span_id(trace_->span_id());
+  }
 }
 
 ///
@@ -383,6 +383,10 @@ class OutboundCall : public RpcCall {
   // Consumption of buffer_.
   ScopedTrackedConsumption buffer_consumption_;
 
+  // Already serialized request fields that are sent after buffer_, see
+  // RpcController::set_request_attachments.
+  std::vector<RefCntBuffer> request_attachments_;
+
   // Once a response has been received for this call, contains that response.
   CallResponse call_response_;
 
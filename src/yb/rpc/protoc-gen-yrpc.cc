@@ -248,6 +248,34 @@ class ServiceSubstitutions : public Substituter {
 };
 
 
+// Phases of inbound call processing that get a histogram per method, in the order of
+// RpcCallPhaseMetrics::Create arguments.
+struct CallPhase {
+  const char* name;
+  const char* description;
+};
+
+const CallPhase kCallPhases[] = {
+  { "reactor_time", "in the reactor before being queued to the service" },
+  { "queue_time", "in the service queue" },
+  { "request_parse_time", "parsing the request" },
+  { "response_serialize_time", "serializing the response" },
+  { "response_transfer_time", "waiting for the response to be written to the socket" },
+};
+
+class CallPhaseSubstitutions : public Substituter {
+ public:
+  explicit CallPhaseSubstitutions(const CallPhase& phase) : phase_(phase) {}
+
+  void InitSubstitutionMap(map<string, string> *map) const override {
+    (*map)["phase_name"] = phase_.name;
+    (*map)["phase_description"] = phase_.description;
+  }
+
+ private:
+  const CallPhase& phase_;
+};
+
 class SubstitutionContext {
  public:
   // Takes ownership of the substituter
@@ -263,6 +291,10 @@ class SubstitutionContext {
     Push(new ServiceSubstitutions(service));
   }
 
+  void PushCallPhase(const CallPhase& phase) {
+    Push(new CallPhaseSubstitutions(phase));
+  }
+
   void Pop() {
     CHECK(!subs_.empty());
     subs_.pop_back();
@@ -454,6 +486,7 @@ class CodeGenerator : public ::google::protobuf::compiler::CodeGenerator {
       "#include \"yb/rpc/local_call.h\"\n"
       "#include \"yb/rpc/remote_method.h\"\n"
       "#include \"yb/rpc/rpc_context.h\"\n"
+      "#include \"yb/rpc/rpc_metrics.h\"\n"
       "#include \"yb/rpc/service_if.h\"\n"
       "#include \"yb/util/metrics.h\"\n"
       "\n");
@@ -476,6 +509,18 @@ class CodeGenerator : public ::google::protobuf::compiler::CodeGenerator {
           "  \"Microseconds spent handling $rpc_full_name$() RPC requests\",\n"
           "  60000000LU, 2);\n"
           "\n");
+        for (const auto& phase : kCallPhases) {
+          subs->PushCallPhase(phase);
+          Print(printer, *subs,
+            "METRIC_DEFINE_histogram_with_percentiles(server,"
+            " rpc_$phase_name$_$rpc_full_name_plainchars$,\n"
+            "  \"$rpc_full_name$ RPC $phase_name$\",\n"
+            "  yb::MetricUnit::kMicroseconds,\n"
+            "  \"Microseconds $rpc_full_name$() RPC requests spent $phase_description$\",\n"
+            "  60000000LU, 2);\n"
+            "\n");
+          subs->Pop();
+        }
         subs->Pop();
       }
 
@@ -513,11 +558,8 @@ class CodeGenerator : public ::google::protobuf::compiler::CodeGenerator {
         "        ::yb::rpc::RpcContext(\n"
         "            std::static_pointer_cast<::yb::rpc::LocalYBInboundCall>(yb_call), \n"
         "            metrics_[$metric_enum_key$]) :\n"
-        "        ::yb::rpc::RpcContext(\n"
-        "            yb_call, \n"
-        "            std::make_shared<$request$>(),\n"
-        "            std::make_shared<$response$>(),\n"
-        "            metrics_[$metric_enum_key$]);\n"
+        "        ::yb::rpc::MakeRpcContext<$request$, $response$>(\n"
+        "            yb_call, metrics_[$metric_enum_key$]);\n"
         "    if (!rpc_context.responded()) {\n"
         "      const auto* req = static_cast<const $request$*>(rpc_context.request_pb());\n"
         "      auto* resp = static_cast<$response$*>(rpc_context.response_pb());\n"
@@ -553,7 +595,15 @@ class CodeGenerator : public ::google::protobuf::compiler::CodeGenerator {
         Print(printer, *subs,
           "  metrics_[$metric_enum_key$].handler_latency = \n"
           "      METRIC_handler_latency_$rpc_full_name_plainchars$.Instantiate(entity);\n"
+          "  metrics_[$metric_enum_key$].call_phases = ::yb::rpc::RpcCallPhaseMetrics::Create(\n"
+          "      entity"
         );
+        for (const auto& phase : kCallPhases) {
+          subs->PushCallPhase(phase);
+          Print(printer, *subs, ",\n      &METRIC_rpc_$phase_name$_$rpc_full_name_plainchars$");
+          subs->Pop();
+        }
+        Print(printer, *subs, ");\n");
 
         subs->Pop();
       }
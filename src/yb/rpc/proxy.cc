@@ -49,11 +49,13 @@
 #include "yb/rpc/response_callback.h"
 #include "yb/rpc/rpc_header.pb.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/backoff_waiter.h"
 #include "yb/util/net/dns_resolver.h"
 #include "yb/util/net/sockaddr.h"
 #include "yb/util/net/socket.h"
 #include "yb/util/countdown_latch.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/status.h"
 #include "yb/util/user.h"
 
@@ -63,6 +65,12 @@ DEFINE_int32(num_connections_to_server, 8,
 DEFINE_int32(proxy_resolve_cache_ms, 5000,
              "Time in milliseconds to cache resolution result in Proxy");
 
+DEFINE_bool(rpc_handle_sync_local_calls_inline, true,
+            "Handle synchronous calls to a service of the same process in the calling thread, "
+            "instead of passing them to a service thread and waiting for the response.");
+TAG_FLAG(rpc_handle_sync_local_calls_inline, advanced);
+TAG_FLAG(rpc_handle_sync_local_calls_inline, runtime);
+
 using namespace std::literals;
 
 using google::protobuf::Message;
@@ -117,7 +125,7 @@ void Proxy::AsyncRequest(const RemoteMethod* method,
                          ResponseCallback callback) {
   DoAsyncRequest(
       method, req, resp, controller, std::move(callback),
-      false /* force_run_callback_on_reactor */);
+      false /* force_run_callback_on_reactor */, false /* sync */);
 }
 
 ThreadPool* Proxy::GetCallbackThreadPool(
@@ -140,7 +148,8 @@ void Proxy::DoAsyncRequest(const RemoteMethod* method,
                            google::protobuf::Message* resp,
                            RpcController* controller,
                            ResponseCallback callback,
-                           bool force_run_callback_on_reactor) {
+                           bool force_run_callback_on_reactor,
+                           bool sync) {
   CHECK(controller->call_.get() == nullptr) << "Controller should be reset";
   is_started_.store(true, std::memory_order_release);
 
@@ -177,10 +186,14 @@ void Proxy::DoAsyncRequest(const RemoteMethod* method,
     call->SetQueued();
     call->SetSent();
     // If currrent thread is RPC worker thread, it is ok to call the handler in the current thread.
+    // The same is true for the synchronous call, since the current thread would be blocked until
+    // the call completes anyway, so handling it here saves two thread switches.
     // Otherwise, enqueue the call to be handled by the service's handler thread.
     const shared_ptr<LocalYBInboundCall>& local_call =
         static_cast<LocalOutboundCall*>(call)->CreateLocalInboundCall();
-    if (controller->allow_local_calls_in_curr_thread() && ThreadPool::IsCurrentThreadRpcWorker()) {
+    if ((sync && GetAtomicFlag(&FLAGS_rpc_handle_sync_local_calls_inline)) ||
+        (controller->allow_local_calls_in_curr_thread() &&
+         ThreadPool::IsCurrentThreadRpcWorker())) {
       context_->Handle(local_call);
     } else {
       context_->QueueInboundCall(local_call);
@@ -293,7 +306,7 @@ Status Proxy::SyncRequest(const RemoteMethod* method,
   // separate pool.
   DoAsyncRequest(
       method, req, DCHECK_NOTNULL(resp), controller, [&latch]() { latch.CountDown(); },
-      true /* force_run_callback_on_reactor */);
+      true /* force_run_callback_on_reactor */, true /* sync */);
   latch.Wait();
   return controller->status();
 }
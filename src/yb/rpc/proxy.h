@@ -172,12 +172,15 @@ class Proxy {
 
   // Implements logic for AsyncRequest function, but allows to force to run callback on
   // reactor thread. This is an optimisation used by SyncRequest function.
+  // sync specifies that the caller is going to block until the call completes, so a local call
+  // could be handled in the current thread.
   void DoAsyncRequest(const RemoteMethod* method,
                       const google::protobuf::Message& req,
                       google::protobuf::Message* resp,
                       RpcController* controller,
                       ResponseCallback callback,
-                      bool force_run_callback_on_reactor);
+                      bool force_run_callback_on_reactor,
+                      bool sync);
 
   static void NotifyFailed(RpcController* controller, const Status& status);
 
@@ -424,6 +424,9 @@ class Reactor {
   // parent messenger
   Messenger* const messenger_;
 
+  // Index of the reactor in the messenger.
+  const int index_;
+
   const std::string name_;
 
   const std::string log_prefix_;
@@ -30,8 +30,10 @@
 // under the License.
 //
 
+#include <functional>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -149,6 +151,68 @@ TEST_F(RpcBench, BenchmarkCalls) {
   LOG(INFO) << "Sys CPU per req:  " << sys_cpu_micros_per_req << "us";
 }
 
+// Test making calls with many of them in flight on the same connection.
+TEST_F(RpcBench, BenchmarkCallsInFlight) {
+  constexpr size_t kCallsInFlight = 1000;
+
+  StartTestServerWithGeneratedCode(&server_hostport_);
+
+  auto client_messenger = CreateAutoShutdownMessengerHolder("Client");
+  ProxyCache proxy_cache(client_messenger.get());
+  rpc_test::CalculatorServiceProxy p(&proxy_cache, server_hostport_);
+
+  struct CallState {
+    rpc_test::AddRequestPB req;
+    rpc_test::AddResponsePB resp;
+    RpcController controller;
+  };
+
+  std::vector<CallState> calls(kCallsInFlight);
+  std::atomic<size_t> total_reqs{0};
+  std::atomic<size_t> in_flight{0};
+  CountDownLatch latch(1);
+  std::function<void(CallState*)> send = [&](CallState* call) {
+    if (!should_run_.load(std::memory_order_acquire)) {
+      if (in_flight.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        latch.CountDown();
+      }
+      return;
+    }
+    call->controller.Reset();
+    // Long timeout, so expiration entries of completed calls are accumulated by the connection.
+    call->controller.set_timeout(60s);
+    call->req.set_x(static_cast<int32_t>(total_reqs.load(std::memory_order_relaxed)));
+    call->req.set_y(1);
+    p.AddAsync(call->req, &call->resp, &call->controller, [&send, &total_reqs, call] {
+      CHECK_OK(call->controller.status());
+      CHECK_EQ(call->req.x() + call->req.y(), call->resp.result());
+      total_reqs.fetch_add(1, std::memory_order_acq_rel);
+      send(call);
+    });
+  };
+
+  Stopwatch sw(Stopwatch::ALL_THREADS);
+  sw.start();
+  in_flight = calls.size();
+  for (auto& call : calls) {
+    send(&call);
+  }
+
+  std::this_thread::sleep_for(10s);
+  should_run_.store(false, std::memory_order_release);
+  latch.Wait();
+  sw.stop();
+
+  float reqs_per_second = static_cast<float>(total_reqs / sw.elapsed().wall_seconds());
+  float user_cpu_micros_per_req = static_cast<float>(sw.elapsed().user / 1000.0 / total_reqs);
+  float sys_cpu_micros_per_req = static_cast<float>(sw.elapsed().system / 1000.0 / total_reqs);
+
+  LOG(INFO) << "Calls in flight:  " << kCallsInFlight;
+  LOG(INFO) << "Reqs/sec:         " << reqs_per_second;
+  LOG(INFO) << "User CPU per req: " << user_cpu_micros_per_req << "us";
+  LOG(INFO) << "Sys CPU per req:  " << sys_cpu_micros_per_req << "us";
+}
+
 } // namespace rpc
 } // namespace yb
 
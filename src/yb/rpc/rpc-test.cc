@@ -64,6 +64,9 @@
 
 METRIC_DECLARE_histogram(handler_latency_yb_rpc_test_CalculatorService_Sleep);
 METRIC_DECLARE_histogram(rpc_incoming_queue_time);
+METRIC_DECLARE_histogram(rpc_queue_time_yb_rpc_test_CalculatorService_Sleep);
+METRIC_DECLARE_histogram(rpc_request_parse_time_yb_rpc_test_CalculatorService_Sleep);
+METRIC_DECLARE_histogram(rpc_response_transfer_time_yb_rpc_test_CalculatorService_Sleep);
 
 DEFINE_int32(rpc_test_connection_keepalive_num_iterations, 1,
   "Number of iterations in TestRpc.TestConnectionKeepalive");
@@ -74,6 +77,7 @@ DECLARE_bool(enable_rpc_keepalive);
 DECLARE_int64(memory_limit_hard_bytes);
 DECLARE_bool(TEST_pause_calculator_echo_request);
 DECLARE_bool(binary_call_parser_reject_on_mem_tracker_hard_limit);
+DECLARE_bool(rpc_call_phase_metrics);
 
 using namespace std::chrono_literals;
 using std::string;
@@ -620,6 +624,43 @@ TEST_F(TestRpc, TestRpcHandlerLatencyMetric) {
   YB_ASSERT_TRUE(FindOrDie(metric_map, &METRIC_rpc_incoming_queue_time));
 }
 
+// Test per method call phase metrics.
+TEST_F(TestRpc, TestRpcCallPhaseMetrics) {
+  // Metrics are instantiated with the service, so the flag should be set before the server starts.
+  FLAGS_rpc_call_phase_metrics = true;
+
+  HostPort server_addr;
+  StartTestServerWithGeneratedCode(&server_addr);
+
+  auto client_messenger = CreateAutoShutdownMessengerHolder("Client");
+  Proxy p(client_messenger.get(), server_addr);
+
+  constexpr uint64_t kNumCalls = 10;
+  for (uint64_t i = 0; i != kNumCalls; ++i) {
+    RpcController controller;
+    rpc_test::SleepRequestPB req;
+    req.set_sleep_micros(1000);
+    rpc_test::SleepResponsePB resp;
+    ASSERT_OK(p.SyncRequest(CalculatorServiceMethods::SleepMethod(), req, &resp, &controller));
+  }
+
+  const auto metric_map = server_messenger()->metric_entity()->UnsafeMetricsMapForTests();
+  auto histogram = [&metric_map](const HistogramPrototype& prototype) {
+    return down_cast<Histogram*>(FindOrDie(metric_map, &prototype).get());
+  };
+
+  ASSERT_EQ(kNumCalls,
+            histogram(METRIC_rpc_queue_time_yb_rpc_test_CalculatorService_Sleep)->TotalCount());
+  ASSERT_EQ(kNumCalls,
+            histogram(METRIC_rpc_request_parse_time_yb_rpc_test_CalculatorService_Sleep)
+                ->TotalCount());
+  // The response is transferred after the client has received it, so wait for the last one.
+  auto* transfer_time = histogram(
+      METRIC_rpc_response_transfer_time_yb_rpc_test_CalculatorService_Sleep);
+  ASSERT_OK(WaitFor([transfer_time] { return transfer_time->TotalCount() == kNumCalls; },
+                    5s, "All responses transferred"));
+}
+
 TEST_F(TestRpc, TestRpcCallbackDestroysMessenger) {
   auto client_messenger = CreateAutoShutdownMessengerHolder("Client");
   HostPort bad_addr;
@@ -952,6 +993,13 @@ void TestCantAllocateReadBuffer(Messenger* client_messenger, const HostPort& ser
     auto& controller = controllers[i];
     ASSERT_TRUE(controller->finished());
     auto s = controller->status();
+    if (s.IsRemoteError()) {
+      // Calls rejected because of memory limit are responded as soon as their header is received.
+      ASSERT_NE(controller->error_response(), nullptr);
+      ASSERT_EQ(ErrorStatusPB::ERROR_SERVER_TOO_BUSY, controller->error_response()->code())
+          << "Unexpected error for call #" << i + 1 << ": " << AsString(s);
+      continue;
+    }
     ASSERT_TRUE(s.ok() || s.IsTimedOut())
         << "Unexpected error for call #" << i + 1 << ": " << AsString(s);
   }
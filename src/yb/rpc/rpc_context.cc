@@ -45,6 +45,7 @@
 #include "yb/rpc/reactor.h"
 #include "yb/rpc/yb_rpc.h"
 
+#include "yb/util/flag_tags.h"
 #include "yb/util/hdr_histogram.h"
 #include "yb/util/metrics.h"
 #include "yb/util/trace.h"
@@ -55,6 +56,12 @@
 using google::protobuf::Message;
 DECLARE_int32(rpc_max_message_size);
 
+DEFINE_bool(rpc_use_arena_for_inbound_calls, false,
+            "Allocate request and response protobufs of inbound calls on a per call arena, "
+            "instead of allocating each message field separately.");
+TAG_FLAG(rpc_use_arena_for_inbound_calls, advanced);
+TAG_FLAG(rpc_use_arena_for_inbound_calls, runtime);
+
 namespace yb {
 namespace rpc {
 
@@ -91,6 +98,10 @@ scoped_refptr<debug::ConvertableToTraceFormat> TracePb(const Message& msg) {
 }
 }  // anonymous namespace
 
+bool UseArenaForInboundCalls() {
+  return FLAGS_rpc_use_arena_for_inbound_calls;
+}
+
 RpcContext::~RpcContext() {
   if (call_ && !responded_) {
     LOG(DFATAL) << "RpcContext is destroyed, but response has not been sent, for call: "
@@ -106,6 +117,9 @@ RpcContext::RpcContext(std::shared_ptr<YBInboundCall> call,
       request_pb_(request_pb),
       response_pb_(std::move(response_pb)),
       metrics_(metrics) {
+  if (metrics_.call_phases) {
+    call_->SetCallPhaseMetrics(metrics_.call_phases);
+  }
   const Status s = call_->ParseParam(request_pb.get());
   if (PREDICT_FALSE(!s.ok())) {
     RespondRpcFailure(ErrorStatusPB::ERROR_INVALID_REQUEST, s);
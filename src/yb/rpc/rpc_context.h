@@ -32,8 +32,11 @@
 #ifndef YB_RPC_RPC_CONTEXT_H
 #define YB_RPC_RPC_CONTEXT_H
 
+#include <memory>
 #include <string>
 
+#include <google/protobuf/arena.h>
+
 #include "yb/gutil/gscoped_ptr.h"
 #include "yb/rpc/rpc_header.pb.h"
 #include "yb/rpc/service_if.h"
@@ -224,6 +227,29 @@ class RpcContext {
   bool responded_ = false;
 };
 
+// Whether request and response messages of inbound calls should be allocated on a protobuf arena.
+bool UseArenaForInboundCalls();
+
+// Creates the context for the call, with request and response messages of the specified types.
+// When the arena is used, both messages are allocated on the same arena, together with their
+// fields, and the arena is released with the last reference to the messages. Called only from
+// generated code.
+template <class Request, class Response>
+RpcContext MakeRpcContext(std::shared_ptr<YBInboundCall> call, RpcMethodMetrics metrics) {
+  if (UseArenaForInboundCalls()) {
+    auto arena = std::make_shared<google::protobuf::Arena>();
+    auto* request = google::protobuf::Arena::Create<Request>(arena.get());
+    auto* response = google::protobuf::Arena::Create<Response>(arena.get());
+    return RpcContext(
+        std::move(call), std::shared_ptr<google::protobuf::Message>(arena, request),
+        std::shared_ptr<google::protobuf::Message>(std::move(arena), response),
+        std::move(metrics));
+  }
+  return RpcContext(
+      std::move(call), std::make_shared<Request>(), std::make_shared<Response>(),
+      std::move(metrics));
+}
+
 void PanicRpc(RpcContext* context, const char* file, int line_number, const std::string& message);
 
 #define PANIC_RPC(rpc_context, message) \
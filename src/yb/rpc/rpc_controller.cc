@@ -70,6 +70,7 @@ void RpcController::Swap(RpcController* other) {
   std::swap(allow_local_calls_in_curr_thread_, other->allow_local_calls_in_curr_thread_);
   std::swap(call_, other->call_);
   std::swap(invoke_callback_mode_, other->invoke_callback_mode_);
+  request_attachments_.swap(other->request_attachments_);
 }
 
 void RpcController::Reset() {
@@ -78,6 +79,7 @@ void RpcController::Reset() {
     CHECK(finished());
   }
   call_.reset();
+  request_attachments_.clear();
 }
 
 bool RpcController::finished() const {
@@ -33,6 +33,7 @@
 #define YB_RPC_RPC_CONTROLLER_H
 
 #include <memory>
+#include <vector>
 
 #include <glog/logging.h>
 
@@ -40,6 +41,7 @@
 #include "yb/rpc/rpc_fwd.h"
 #include "yb/util/locks.h"
 #include "yb/util/monotime.h"
+#include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/status.h"
 
 namespace yb {
@@ -154,6 +156,16 @@ class RpcController {
   // May fail if index is invalid.
   Result<Slice> GetSidecar(int idx) const;
 
+  // Sets already serialized protobuf fields that are sent right after the serialized request,
+  // so the server parses them as a part of the request. Buffers are sent without copying, so the
+  // same serialized data could be shared by requests to several servers.
+  // Attachments apply to the next call only and are cleared by Reset().
+  void set_request_attachments(std::vector<RefCntBuffer> attachments) {
+    request_attachments_ = std::move(attachments);
+  }
+
+  const std::vector<RefCntBuffer>& request_attachments() const { return request_attachments_; }
+
  private:
   friend class OutboundCall;
   friend class Proxy;
@@ -166,6 +178,7 @@ class RpcController {
   OutboundCallPtr call_;
   bool allow_local_calls_in_curr_thread_ = false;
   InvokeCallbackMode invoke_callback_mode_ = InvokeCallbackMode::kThreadPool;
+  std::vector<RefCntBuffer> request_attachments_;
 
   DISALLOW_COPY_AND_ASSIGN(RpcController);
 };
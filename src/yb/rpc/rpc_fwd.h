@@ -71,6 +71,7 @@ class LocalYBInboundCall;
 struct CallData;
 struct ProcessDataResult;
 struct RpcMethodMetrics;
+struct RpcCallPhaseMetrics;
 struct RpcMetrics;
 
 class RpcCommand;
@@ -13,6 +13,15 @@
 
 #include "yb/rpc/rpc_metrics.h"
 
+#include "yb/rpc/inbound_call.h"
+
+#include "yb/util/flag_tags.h"
+
+DEFINE_bool(rpc_call_phase_metrics, false,
+            "Collect per method histograms of the time inbound calls spend in the reactor, "
+            "service queue, request parsing, response serialization and response transfer.");
+TAG_FLAG(rpc_call_phase_metrics, advanced);
+
 METRIC_DEFINE_gauge_int64(server, rpc_connections_alive,
                           "Number of alive RPC connections.",
                           yb::MetricUnit::kConnections,
@@ -57,5 +66,44 @@ RpcMetrics::RpcMetrics(const scoped_refptr<MetricEntity>& metric_entity) {
   }
 }
 
+namespace {
+
+void RecordPhase(const MonoTime& start, const MonoTime& finish, Histogram* histogram) {
+  if (start.Initialized() && finish.Initialized() && !(finish < start)) {
+    histogram->Increment(finish.GetDeltaSince(start).ToMicroseconds());
+  }
+}
+
+} // namespace
+
+std::shared_ptr<const RpcCallPhaseMetrics> RpcCallPhaseMetrics::Create(
+    const scoped_refptr<MetricEntity>& entity,
+    HistogramPrototype* reactor_time,
+    HistogramPrototype* queue_time,
+    HistogramPrototype* request_parse_time,
+    HistogramPrototype* response_serialize_time,
+    HistogramPrototype* response_transfer_time) {
+  if (!FLAGS_rpc_call_phase_metrics || !entity) {
+    return nullptr;
+  }
+  auto result = std::make_shared<RpcCallPhaseMetrics>();
+  result->reactor_time = reactor_time->Instantiate(entity);
+  result->queue_time = queue_time->Instantiate(entity);
+  result->request_parse_time = request_parse_time->Instantiate(entity);
+  result->response_serialize_time = response_serialize_time->Instantiate(entity);
+  result->response_transfer_time = response_transfer_time->Instantiate(entity);
+  return result;
+}
+
+void RpcCallPhaseMetrics::Record(const InboundCallTiming& timing) const {
+  RecordPhase(timing.time_received, timing.time_queued, reactor_time.get());
+  RecordPhase(timing.time_queued, timing.time_handled, queue_time.get());
+  RecordPhase(timing.time_handled, timing.time_request_parsed, request_parse_time.get());
+  RecordPhase(timing.time_completed, timing.time_response_serialized,
+              response_serialize_time.get());
+  RecordPhase(timing.time_response_serialized, timing.time_transferred,
+              response_transfer_time.get());
+}
+
 } // namespace rpc
 } // namespace yb
@@ -14,6 +14,8 @@
 #ifndef YB_RPC_RPC_METRICS_H
 #define YB_RPC_RPC_METRICS_H
 
+#include <memory>
+
 #include "yb/util/metrics.h"
 
 namespace yb {
@@ -30,6 +32,35 @@ struct RpcMetrics {
   scoped_refptr<Counter> outbound_calls_created;
 };
 
+struct InboundCallTiming;
+
+// Per method histograms of the phases an inbound call goes through, in microseconds.
+// Instantiated only when --rpc_call_phase_metrics is set, since every method gets its own set.
+struct RpcCallPhaseMetrics {
+  // From the call being read from the socket until it is queued to the service.
+  scoped_refptr<Histogram> reactor_time;
+  // From being queued until the handler is started.
+  scoped_refptr<Histogram> queue_time;
+  // From handler start until the request protobuf is parsed.
+  scoped_refptr<Histogram> request_parse_time;
+  // From handler completion until the response is serialized.
+  scoped_refptr<Histogram> response_serialize_time;
+  // From response serialization until it is written to the socket.
+  scoped_refptr<Histogram> response_transfer_time;
+
+  // Returns nullptr when call phase metrics are disabled.
+  static std::shared_ptr<const RpcCallPhaseMetrics> Create(
+      const scoped_refptr<MetricEntity>& entity,
+      HistogramPrototype* reactor_time,
+      HistogramPrototype* queue_time,
+      HistogramPrototype* request_parse_time,
+      HistogramPrototype* response_serialize_time,
+      HistogramPrototype* response_transfer_time);
+
+  // Updates histograms of phases that were reached by the call.
+  void Record(const InboundCallTiming& timing) const;
+};
+
 } // namespace rpc
 } // namespace yb
 
@@ -55,8 +55,14 @@
 
 DEFINE_bool(is_panic_test_child, false, "Used by TestRpcPanic");
 DECLARE_bool(socket_inject_short_recvs);
+DECLARE_int32(socket_receive_buffer_size);
 DECLARE_int32(rpc_slow_query_threshold_ms);
 DECLARE_int32(TEST_delay_connect_ms);
+DECLARE_bool(rpc_use_arena_for_inbound_calls);
+DECLARE_int64(rpc_queue_target_delay_ms);
+DECLARE_int64(rpc_queue_delay_interval_ms);
+DECLARE_int64(rpc_queue_overloaded_max_delay_ms);
+DECLARE_bool(rpc_handle_sync_local_calls_inline);
 
 using namespace std::chrono_literals;
 
@@ -315,6 +321,29 @@ TEST_F(RpcStubTest, TestBigCallData) {
   }
 }
 
+// A small socket receive buffer makes both the request and the response go through many partial
+// writev calls and partial reads, and short receives leave unread data in the socket after each
+// read. Each call should still complete promptly, without waiting on an extra EV_READ/EV_WRITE.
+TEST_F(RpcStubTest, TestBigCallDataPartialIO) {
+  constexpr int kNumCalls = 5;
+  constexpr size_t kMessageSize = NonTsanVsTsan(4_MB, 1_MB);
+
+  FLAGS_socket_receive_buffer_size = 16_KB;
+  FLAGS_socket_inject_short_recvs = true;
+
+  CalculatorServiceProxy p(proxy_cache_.get(), server_hostport_);
+
+  for (int i = 0; i != kNumCalls; ++i) {
+    EchoRequestPB req;
+    req.set_data(RandomHumanReadableString(kMessageSize));
+    EchoResponsePB resp;
+    RpcController controller;
+    controller.set_timeout(15s);
+    ASSERT_OK(p.Echo(req, &resp, &controller));
+    ASSERT_EQ(resp.data(), req.data());
+  }
+}
+
 TEST_F(RpcStubTest, TestRespondDeferred) {
   CalculatorServiceProxy p(proxy_cache_.get(), server_hostport_);
 
@@ -326,6 +355,27 @@ TEST_F(RpcStubTest, TestRespondDeferred) {
   ASSERT_OK(p.Sleep(req, &resp, &controller));
 }
 
+TEST_F(RpcStubTest, TestArenaForInboundCalls) {
+  FLAGS_rpc_use_arena_for_inbound_calls = true;
+  SendSimpleCall();
+
+  // Deferred response should be able to use messages after the handler returns.
+  CalculatorServiceProxy p(proxy_cache_.get(), server_hostport_);
+  RpcController controller;
+  SleepRequestPB req;
+  req.set_sleep_micros(1000);
+  req.set_deferred(true);
+  SleepResponsePB resp;
+  ASSERT_OK(p.Sleep(req, &resp, &controller));
+
+  controller.Reset();
+  EchoRequestPB echo_req;
+  echo_req.set_data(RandomHumanReadableString(1_MB));
+  EchoResponsePB echo_resp;
+  ASSERT_OK(p.Echo(echo_req, &echo_resp, &controller));
+  ASSERT_EQ(echo_req.data(), echo_resp.data());
+}
+
 // Test that the default user credentials are propagated to the server.
 TEST_F(RpcStubTest, TestDefaultCredentialsPropagated) {
   CalculatorServiceProxy p(proxy_cache_.get(), server_hostport_);
@@ -530,6 +580,134 @@ TEST_F(RpcStubTest, TestDontHandleTimedOutCalls) {
   ASSERT_EQ(1, timed_out_in_queue->value());
 }
 
+// Test that calls that waited long in a standing queue are rejected, while calls that did not wait
+// are admitted.
+TEST_F(RpcStubTest, TestRejectByQueueDelay) {
+  google::FlagSaver flag_saver;
+  FLAGS_rpc_queue_target_delay_ms = 50;
+  FLAGS_rpc_queue_delay_interval_ms = 100;
+  FLAGS_rpc_queue_overloaded_max_delay_ms = 50;
+  const Counter* rejected = server().service_pool().RpcsRejectedByQueueDelayMetricForTests();
+
+  // Calls are admitted while the queue is empty.
+  for (int i = 0; i != 5; ++i) {
+    ASSERT_NO_FATALS(SendSimpleCall());
+  }
+  ASSERT_EQ(0, rejected->value());
+
+  // Keep the queue standing, by sending much more sleep calls than there are worker threads.
+  CalculatorServiceProxy p(proxy_cache_.get(), server_hostport_);
+  vector<AsyncSleep*> sleeps;
+  ElementDeleter d(&sleeps);
+  const size_t count = client_messenger_->max_concurrent_requests() * 10;
+  CountDownLatch latch(count);
+  for (size_t i = 0; i < count; i++) {
+    gscoped_ptr<AsyncSleep> sleep(new AsyncSleep);
+    sleep->rpc.set_timeout(30s);
+    sleep->req.set_sleep_micros(100 * 1000); // 100ms
+    p.SleepAsync(sleep->req, &sleep->resp, &sleep->rpc, [&latch]() { latch.CountDown(); });
+    sleeps.push_back(sleep.release());
+  }
+  latch.Wait();
+
+  size_t failed = 0;
+  for (auto* sleep : sleeps) {
+    auto status = sleep->rpc.status();
+    if (!status.ok()) {
+      ASSERT_TRUE(status.IsRemoteError()) << status;
+      ASSERT_NE(sleep->rpc.error_response(), nullptr) << status;
+      ASSERT_EQ(ErrorStatusPB::ERROR_SERVER_TOO_BUSY, sleep->rpc.error_response()->code())
+          << status;
+      ++failed;
+    }
+  }
+  LOG(INFO) << "Rejected " << rejected->value() << ", failed " << failed << " of " << count;
+  ASSERT_GT(rejected->value(), 0);
+  ASSERT_EQ(failed, static_cast<size_t>(rejected->value()));
+  ASSERT_LT(failed, count);
+
+  // The queue is drained, so calls are admitted again. Wait for a few intervals, so the drained
+  // queue is also noticed by the standing queue detection.
+  const auto rejected_before = rejected->value();
+  for (int i = 0; i != 5; ++i) {
+    ASSERT_NO_FATALS(SendSimpleCall());
+    std::this_thread::sleep_for(FLAGS_rpc_queue_delay_interval_ms * 1ms);
+  }
+  ASSERT_EQ(rejected_before, rejected->value());
+
+  // Calls that fit into worker threads do not make the queue standing again.
+  vector<AsyncSleep*> short_sleeps;
+  ElementDeleter short_sleeps_deleter(&short_sleeps);
+  const size_t num_workers = TestServerOptions().n_worker_threads;
+  CountDownLatch short_latch(num_workers);
+  for (size_t i = 0; i != num_workers; ++i) {
+    gscoped_ptr<AsyncSleep> sleep(new AsyncSleep);
+    sleep->rpc.set_timeout(30s);
+    sleep->req.set_sleep_micros(10 * 1000); // 10ms
+    p.SleepAsync(sleep->req, &sleep->resp, &sleep->rpc, [&short_latch]() {
+      short_latch.CountDown();
+    });
+    short_sleeps.push_back(sleep.release());
+  }
+  short_latch.Wait();
+  for (auto* sleep : short_sleeps) {
+    ASSERT_OK(sleep->rpc.status());
+  }
+  ASSERT_EQ(rejected_before, rejected->value());
+}
+
+// Test that a synchronous local call is handled in the calling thread, so it does not wait for busy
+// service threads.
+TEST_F(RpcStubTest, TestSyncLocalCallHandledInline) {
+  google::FlagSaver flag_saver;
+  const auto kSleepTime = 3s;
+
+  // Occupy all service threads.
+  CalculatorServiceProxy remote_proxy(proxy_cache_.get(), server_hostport_);
+  const size_t num_workers = TestServerOptions().n_worker_threads;
+  vector<AsyncSleep> sleeps(num_workers);
+  CountDownLatch latch(num_workers);
+  for (auto& sleep : sleeps) {
+    sleep.rpc.set_timeout(30s);
+    sleep.req.set_sleep_micros(ToMicroseconds(kSleepTime));
+    remote_proxy.SleepAsync(sleep.req, &sleep.resp, &sleep.rpc, [&latch] { latch.CountDown(); });
+  }
+  std::this_thread::sleep_for(100ms);
+
+  ProxyCache local_proxy_cache(server_messenger());
+  CalculatorServiceProxy local_proxy(&local_proxy_cache, HostPort());
+  auto add = [&local_proxy]() -> Result<MonoDelta> {
+    RpcController controller;
+    controller.set_timeout(30s);
+    AddRequestPB req;
+    req.set_x(10);
+    req.set_y(20);
+    AddResponsePB resp;
+    auto start = MonoTime::Now();
+    RETURN_NOT_OK(local_proxy.Add(req, &resp, &controller));
+    if (resp.result() != 30) {
+      return STATUS_FORMAT(IllegalState, "Wrong result: $0", resp.result());
+    }
+    return MonoTime::Now() - start;
+  };
+
+  FLAGS_rpc_handle_sync_local_calls_inline = true;
+  auto inline_time = ASSERT_RESULT(add());
+  LOG(INFO) << "Inline local call time: " << inline_time;
+  ASSERT_LT(inline_time, MonoDelta(kSleepTime / 3));
+
+  // Without inline handling the call waits for a service thread.
+  FLAGS_rpc_handle_sync_local_calls_inline = false;
+  auto queued_time = ASSERT_RESULT(add());
+  LOG(INFO) << "Queued local call time: " << queued_time;
+  ASSERT_GT(queued_time, MonoDelta(kSleepTime / 3));
+
+  latch.Wait();
+  for (const auto& sleep : sleeps) {
+    ASSERT_OK(sleep.rpc.status());
+  }
+}
+
 TEST_F(RpcStubTest, TestDumpCallsInFlight) {
   CountDownLatch latch(1);
   CalculatorServiceProxy p(proxy_cache_.get(), server_hostport_);
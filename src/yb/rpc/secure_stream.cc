@@ -24,6 +24,7 @@
 #include "yb/rpc/rpc_util.h"
 
 #include "yb/util/errno.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/memory/memory.h"
 #include "yb/util/logging.h"
 #include "yb/util/scope_exit.h"
@@ -34,6 +35,11 @@ using namespace std::literals;
 
 DEFINE_bool(allow_insecure_connections, true, "Whether we should allow insecure connections.");
 DEFINE_bool(dump_certificate_entries, false, "Whether we should dump certificate entries.");
+DEFINE_bool(ssl_release_buffers, false,
+            "Release OpenSSL read and write buffers of a secure connection when they are not in "
+            "use. Saves about 34KB per idle connection, but allocates and frees the buffers for "
+            "each TLS record.");
+TAG_FLAG(ssl_release_buffers, advanced);
 
 namespace yb {
 namespace rpc {
@@ -352,6 +358,11 @@ class SecureStream : public Stream, public StreamContext {
   void Established(SecureState state);
   static int VerifyCallback(int preverified, X509_STORE_CTX* store_context);
   bool Verify(bool preverified, X509_STORE_CTX* store_context);
+  // Max size of data coalesced into a single TLS record by Send.
+  static constexpr size_t kMaxCoalescedSize = 4_KB;
+
+  // Encrypts slice, passing encrypted data to the lower stream when the BIO is full.
+  void SslWrite(Slice slice);
   void WriteEncrypted(OutboundDataPtr data);
   CHECKED_STATUS ReadDecrypted();
   Result<size_t> SslRead(void* buf, int num);
@@ -407,18 +418,30 @@ size_t SecureStream::Send(OutboundDataPtr data) {
   case SecureState::kEnabled: {
       boost::container::small_vector<RefCntBuffer, 10> queue;
       data->Serialize(&queue);
+      // Each SSL_write produces at least one TLS record, with its own header, MAC and cipher
+      // setup. So small buffers, like call headers, are coalesced into a single record.
+      char coalesced[kMaxCoalescedSize];
+      size_t coalesced_size = 0;
       for (const auto& buf : queue) {
-        Slice slice(buf.data(), buf.size());
-        for (;;) {
-          auto len = SSL_write(ssl_.get(), slice.data(), slice.size());
-          if (len == slice.size()) {
-            break;
-          }
-          VLOG_WITH_PREFIX(4) << "SSL_write was not full: " << slice.size() << ", written: " << len;
-          WriteEncrypted(nullptr);
-          slice.remove_prefix(len);
+        if (coalesced_size + buf.size() <= sizeof(coalesced)) {
+          memcpy(coalesced + coalesced_size, buf.data(), buf.size());
+          coalesced_size += buf.size();
+          continue;
+        }
+        if (coalesced_size) {
+          SslWrite(Slice(coalesced, coalesced_size));
+          coalesced_size = 0;
+        }
+        if (buf.size() < sizeof(coalesced)) {
+          memcpy(coalesced, buf.data(), buf.size());
+          coalesced_size = buf.size();
+        } else {
+          SslWrite(buf.as_slice());
         }
       }
+      if (coalesced_size) {
+        SslWrite(Slice(coalesced, coalesced_size));
+      }
       WriteEncrypted(std::move(data));
     }
     return std::numeric_limits<size_t>::max();
@@ -429,6 +452,18 @@ size_t SecureStream::Send(OutboundDataPtr data) {
   return std::numeric_limits<size_t>::max();
 }
 
+void SecureStream::SslWrite(Slice slice) {
+  for (;;) {
+    auto len = SSL_write(ssl_.get(), slice.data(), slice.size());
+    if (len == slice.size()) {
+      break;
+    }
+    VLOG_WITH_PREFIX(4) << "SSL_write was not full: " << slice.size() << ", written: " << len;
+    WriteEncrypted(nullptr);
+    slice.remove_prefix(len);
+  }
+}
+
 void SecureStream::WriteEncrypted(OutboundDataPtr data) {
   RefCntBuffer buf(BIO_ctrl_pending(bio_.get()));
   auto len = BIO_read(bio_.get(), buf.data(), buf.size());
@@ -680,7 +715,9 @@ Status SecureStream::Init() {
     ssl_ = secure_context_.Create();
     SSL_set_mode(ssl_.get(), SSL_MODE_ENABLE_PARTIAL_WRITE);
     SSL_set_mode(ssl_.get(), SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
-    SSL_set_mode(ssl_.get(), SSL_MODE_RELEASE_BUFFERS);
+    if (FLAGS_ssl_release_buffers) {
+      SSL_set_mode(ssl_.get(), SSL_MODE_RELEASE_BUFFERS);
+    }
     SSL_set_app_data(ssl_.get(), this);
 
     if (!need_connect_) {
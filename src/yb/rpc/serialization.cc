@@ -177,6 +177,31 @@ Status ParseYBMessage(const Slice& buf,
   return Status::OK();
 }
 
+Status ParseYBHeader(const Slice& prefix,
+                     MessageLite* parsed_header,
+                     bool* complete) {
+  CodedInputStream in(prefix.data(), prefix.size());
+  in.SetTotalBytesLimit(FLAGS_rpc_max_message_size, FLAGS_rpc_max_message_size*3/4);
+
+  uint32_t header_len;
+  if (!in.ReadVarint32(&header_len) ||
+      header_len > prefix.size() - static_cast<size_t>(in.CurrentPosition())) {
+    *complete = false;
+    return Status::OK();
+  }
+
+  CodedInputStream::Limit l;
+  l = in.PushLimit(header_len);
+  if (PREDICT_FALSE(!parsed_header->ParseFromCodedStream(&in))) {
+    return STATUS(Corruption, "Invalid packet: header too short",
+                              prefix.ToDebugString());
+  }
+  in.PopLimit(l);
+
+  *complete = true;
+  return Status::OK();
+}
+
 }  // namespace serialization
 }  // namespace rpc
 }  // namespace yb
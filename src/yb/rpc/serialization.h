@@ -95,6 +95,14 @@ Status ParseYBMessage(const Slice& buf,
                       google::protobuf::MessageLite* parsed_header,
                       Slice* parsed_main_message);
 
+// Deserialize the request header from the beginning of the request data.
+// In: prefix of the data buffer, that could be shorter than the whole request.
+// Out: parsed_header PB initialized and complete set to true, if the whole header is contained in
+//      the prefix. Otherwise complete is set to false.
+Status ParseYBHeader(const Slice& prefix,
+                     google::protobuf::MessageLite* parsed_header,
+                     bool* complete);
+
 
 }  // namespace serialization
 }  // namespace rpc
@@ -32,6 +32,7 @@
 #ifndef YB_RPC_SERVICE_IF_H_
 #define YB_RPC_SERVICE_IF_H_
 
+#include <memory>
 #include <string>
 
 #include "yb/gutil/macros.h"
@@ -58,6 +59,8 @@ struct RpcMethodMetrics {
   ~RpcMethodMetrics();
 
   scoped_refptr<Histogram> handler_latency;
+  // Null unless call phase metrics are enabled.
+  std::shared_ptr<const RpcCallPhaseMetrics> call_phases;
 };
 
 // Handles incoming messages that initiate an RPC.
@@ -53,6 +53,7 @@
 #include "yb/rpc/service_if.h"
 
 #include "yb/gutil/strings/substitute.h"
+#include "yb/util/allocation_profiler.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/lockfree.h"
 #include "yb/util/metrics.h"
@@ -76,6 +77,23 @@ DEFINE_int64(backpressure_recovery_period_ms, 600000,
              "for this duration (in ms)");
 TAG_FLAG(backpressure_recovery_period_ms, advanced);
 TAG_FLAG(backpressure_recovery_period_ms, runtime);
+DEFINE_int64(rpc_queue_target_delay_ms, 0,
+             "Adaptive admission control. When the minimal time spent in the service queue by "
+             "calls handled during rpc_queue_delay_interval_ms exceeds this value, the queue is "
+             "considered to be standing, and calls that waited in it longer than "
+             "rpc_queue_overloaded_max_delay_ms are rejected as server too busy, so clients back "
+             "off instead of timing out. 0 to disable.");
+TAG_FLAG(rpc_queue_target_delay_ms, advanced);
+TAG_FLAG(rpc_queue_target_delay_ms, runtime);
+DEFINE_int64(rpc_queue_delay_interval_ms, 100,
+             "Interval used to track the minimal time spent by calls in the service queue.");
+TAG_FLAG(rpc_queue_delay_interval_ms, advanced);
+TAG_FLAG(rpc_queue_delay_interval_ms, runtime);
+DEFINE_int64(rpc_queue_overloaded_max_delay_ms, 100,
+             "Calls that waited in the service queue longer than this value are rejected while "
+             "the queue is standing. See rpc_queue_target_delay_ms.");
+TAG_FLAG(rpc_queue_overloaded_max_delay_ms, advanced);
+TAG_FLAG(rpc_queue_overloaded_max_delay_ms, runtime);
 DEFINE_test_flag(bool, enable_backpressure_mode_for_testing, false,
             "For testing purposes. Enables the rpc's to be considered timed out in the queue even "
             "when we have not had any backpressure in the recent past.");
@@ -106,6 +124,12 @@ METRIC_DEFINE_counter(server, rpcs_queue_overflow,
                       "Number of RPCs dropped because the service queue "
                       "was full.");
 
+METRIC_DEFINE_counter(server, rpcs_rejected_by_queue_delay,
+                      "RPC Queue Delay Rejections",
+                      yb::MetricUnit::kRequests,
+                      "Number of RPCs rejected by adaptive admission control, because the "
+                      "service queue was standing.");
+
 namespace yb {
 namespace rpc {
 
@@ -132,6 +156,7 @@ class ServicePoolImpl final : public InboundCallHandler {
         rpcs_timed_out_early_in_queue_(
             METRIC_rpcs_timed_out_early_in_queue.Instantiate(entity)),
         rpcs_queue_overflow_(METRIC_rpcs_queue_overflow.Instantiate(entity)),
+        rpcs_rejected_by_queue_delay_(METRIC_rpcs_rejected_by_queue_delay.Instantiate(entity)),
         check_timeout_strand_(scheduler->io_service()),
         log_prefix_(Format("$0: ", service_->service_name())) {
 
@@ -204,6 +229,10 @@ class ServicePoolImpl final : public InboundCallHandler {
     return rpcs_queue_overflow_.get();
   }
 
+  const Counter* RpcsRejectedByQueueDelayMetricForTests() const {
+    return rpcs_rejected_by_queue_delay_.get();
+  }
+
   std::string service_name() const {
     return service_->service_name();
   }
@@ -255,10 +284,16 @@ class ServicePoolImpl final : public InboundCallHandler {
       error_message = kTimedOutInQueue;
     } else if (PREDICT_FALSE(ShouldDropRequestDuringHighLoad(incoming))) {
       error_message = "The server is overloaded. Call waited in the queue past max_time_in_queue.";
+    } else if (PREDICT_FALSE(ShouldRejectByQueueDelay(incoming))) {
+      RejectByQueueDelay(incoming);
+      return;
     } else {
       TRACE_TO(incoming->trace(), "Handling call");
 
       if (incoming->TryStartProcessing()) {
+        // Keeps the call, that owns the method name, alive while the allocation scope is set.
+        auto call = incoming;
+        ScopedAllocationScope allocation_scope(&call->method_name());
         service_->Handle(std::move(incoming));
       }
       return;
@@ -302,6 +337,57 @@ class ServicePoolImpl final : public InboundCallHandler {
     return incoming->GetTimeInQueue().ToMilliseconds() > FLAGS_max_time_in_queue_ms;
   }
 
+  // CoDel style detection of the standing queue. Good queue absorbs bursts and drains quickly,
+  // so at least some of the calls handled during the interval do not wait in it. When even the
+  // minimal queue time during the interval is above the target, the queue is standing, i.e.
+  // incoming load exceeds the capacity, and waiting longer only makes calls time out.
+  bool ShouldRejectByQueueDelay(const InboundCallPtr& incoming) {
+    const auto target_delay_ms = GetAtomicFlag(&FLAGS_rpc_queue_target_delay_ms);
+    if (target_delay_ms <= 0) {
+      return false;
+    }
+
+    const auto delay_us = incoming->GetTimeInQueue().ToMicroseconds();
+    const auto now = CoarseMonoClock::Now();
+    auto interval_start = queue_delay_interval_start_.load(std::memory_order_acquire);
+    const auto interval = GetAtomicFlag(&FLAGS_rpc_queue_delay_interval_ms) * 1ms;
+    if (now.time_since_epoch() >= interval_start + interval &&
+        queue_delay_interval_start_.compare_exchange_strong(
+            interval_start, now.time_since_epoch(), std::memory_order_acq_rel)) {
+      // Start the new interval with the delay of this call, and evaluate the finished one.
+      const auto min_delay_us = min_queue_delay_us_.exchange(delay_us, std::memory_order_acq_rel);
+      const bool standing = min_delay_us > target_delay_ms * 1000;
+      if (standing != queue_standing_.load(std::memory_order_acquire)) {
+        YB_LOG_EVERY_N_SECS(INFO, 1)
+            << LogPrefix() << "Queue " << (standing ? "became" : "is not") << " standing, min "
+            << "delay during interval: " << min_delay_us << "us";
+        queue_standing_.store(standing, std::memory_order_release);
+      }
+    } else {
+      auto current = min_queue_delay_us_.load(std::memory_order_acquire);
+      while (delay_us < current && !min_queue_delay_us_.compare_exchange_weak(
+                 current, delay_us, std::memory_order_acq_rel)) {
+      }
+    }
+
+    return queue_standing_.load(std::memory_order_acquire) &&
+           delay_us > GetAtomicFlag(&FLAGS_rpc_queue_overloaded_max_delay_ms) * 1000;
+  }
+
+  void RejectByQueueDelay(const InboundCallPtr& call) {
+    if (!call->TryStartProcessing()) {
+      return;
+    }
+    const auto err_msg = Format(
+        "$0 request on $1 from $2 rejected, service queue is standing, call waited $3",
+        call->method_name(), service_->service_name(), yb::ToString(call->remote_address()),
+        call->GetTimeInQueue());
+    YB_LOG_EVERY_N_SECS(WARNING, 3) << LogPrefix() << err_msg;
+    TRACE_TO(call->trace(), err_msg);
+    rpcs_rejected_by_queue_delay_->Increment();
+    call->RespondFailure(ErrorStatusPB::ERROR_SERVER_TOO_BUSY, STATUS(ServiceUnavailable, err_msg));
+  }
+
   void CheckTimeout(ScheduledTaskId task_id, CoarseTimePoint time, const Status& status) {
     auto se = ScopeExit([this, task_id, time] {
       auto expected_duration = time.time_since_epoch();
@@ -407,11 +493,17 @@ class ServicePoolImpl final : public InboundCallHandler {
   scoped_refptr<Counter> rpcs_timed_out_in_queue_;
   scoped_refptr<Counter> rpcs_timed_out_early_in_queue_;
   scoped_refptr<Counter> rpcs_queue_overflow_;
+  scoped_refptr<Counter> rpcs_rejected_by_queue_delay_;
   scoped_refptr<AtomicGauge<int64_t>> rpcs_in_queue_;
   // Have to use CoarseDuration here, since CoarseTimePoint does not work with clang + libstdc++
   std::atomic<CoarseDuration> last_backpressure_at_{CoarseTimePoint().time_since_epoch()};
   std::atomic<int64_t> queued_calls_{0};
 
+  // State of adaptive admission control, see ShouldRejectByQueueDelay.
+  std::atomic<CoarseDuration> queue_delay_interval_start_{CoarseTimePoint().time_since_epoch()};
+  std::atomic<int64_t> min_queue_delay_us_{0};
+  std::atomic<bool> queue_standing_{false};
+
   // It is too expensive to update timeout priority queue when each call is received.
   // So we are doing the following trick.
   // All calls are added to pre_check_timeout_queue_, w/o priority.
@@ -489,6 +581,10 @@ const Counter* ServicePool::RpcsQueueOverflowMetric() const {
   return impl_->RpcsQueueOverflowMetric();
 }
 
+const Counter* ServicePool::RpcsRejectedByQueueDelayMetricForTests() const {
+  return impl_->RpcsRejectedByQueueDelayMetricForTests();
+}
+
 std::string ServicePool::service_name() const {
   return impl_->service_name();
 }
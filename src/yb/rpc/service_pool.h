@@ -76,6 +76,7 @@ class ServicePool : public RpcService {
   void Handle(InboundCallPtr call) override;
   const Counter* RpcsTimedOutInQueueMetricForTests() const;
   const Counter* RpcsQueueOverflowMetric() const;
+  const Counter* RpcsRejectedByQueueDelayMetricForTests() const;
   std::string service_name() const;
 
   ServiceIfPtr TEST_get_service() const;
@@ -33,7 +33,8 @@ namespace rpc {
 
 namespace {
 
-const size_t kMaxIov = 16;
+// Number of buffers passed to a single writev call, so queued small messages are sent together.
+const size_t kMaxIov = 64;
 
 }
 
@@ -203,6 +204,10 @@ Status TcpStream::DoWrite() {
     auto status = fill_result.len != 0
         ? socket_.Writev(iov, fill_result.len, &written)
         : Status::OK();
+    size_t requested = 0;
+    for (int i = 0; i != fill_result.len; ++i) {
+      requested += iov[i].iov_len;
+    }
     DVLOG_WITH_PREFIX(4) << "Queued writes " << queued_bytes_to_send_ << " bytes. written "
                          << written << " . Status " << status << ", sending_.size(): "
                          << sending_.size();
@@ -237,6 +242,12 @@ Status TcpStream::DoWrite() {
         context_->Transferred(data, Status::OK());
       }
     }
+
+    if (static_cast<size_t>(written) < requested) {
+      // Socket send buffer is full, so wait until it is ready for write instead of trying to
+      // write the rest right away and getting EAGAIN.
+      break;
+    }
   }
 
   return Status::OK();
@@ -300,7 +311,8 @@ Status TcpStream::ReadHandler() {
   context_->UpdateLastRead();
 
   for (;;) {
-    auto received = Receive();
+    bool drained = false;
+    auto received = Receive(&drained);
     if (PREDICT_FALSE(!received.ok())) {
       if (Errno(received.status()) == ESHUTDOWN) {
         VLOG_WITH_PREFIX(1) << "Shut down by remote end.";
@@ -319,13 +331,15 @@ Status TcpStream::ReadHandler() {
     if (!continue_receiving.ok()) {
       return continue_receiving.status();
     }
-    if (!continue_receiving.get()) {
+    // Don't spend a syscall on the receive that would return EAGAIN, since the socket is level
+    // triggered we will be notified when more data arrives.
+    if (!continue_receiving.get() || drained) {
       return Status::OK();
     }
   }
 }
 
-Result<bool> TcpStream::Receive() {
+Result<bool> TcpStream::Receive(bool* drained) {
   auto iov = ReadBuffer().PrepareAppend();
   if (!iov.ok()) {
     VLOG_WITH_PREFIX(3) << "ReadBuffer().PrepareAppend() error: " << iov.status();
@@ -365,6 +379,7 @@ Result<bool> TcpStream::Receive() {
   }
 
   ReadBuffer().DataAppended(*nread);
+  *drained = static_cast<size_t>(*nread) < IoVecsFullSize(*iov);
   return *nread != 0;
 }
 
@@ -97,7 +97,10 @@ class TcpStream : public Stream {
   CHECKED_STATUS ReadHandler();
   CHECKED_STATUS WriteHandler(bool just_connected);
 
-  Result<bool> Receive();
+  // Receives data from the socket to the read buffer. Returns true if something was received.
+  // Sets drained to true when less data than requested was received, i.e. the socket does not
+  // have more data right now, so the next receive would fail with EAGAIN.
+  Result<bool> Receive(bool* drained);
   // Try to parse received data and process it.
   Result<bool> TryProcessReceived();
 
@@ -143,6 +143,39 @@ TEST_F(ThreadPoolTest, TestMultiProducers) {
   }
 }
 
+// Producers enqueue to different shards, while there are less workers than shards, so some tasks
+// could complete only when stolen by workers of other shards.
+TEST_F(ThreadPoolTest, TestShards) {
+  constexpr size_t kTotalTasks = 10000;
+  constexpr size_t kTotalWorkers = 2;
+  constexpr size_t kShards = 4;
+  constexpr size_t kProducers = 8;
+  ThreadPool pool("test", kTotalTasks, kTotalWorkers, kShards);
+
+  CountDownLatch latch(kTotalTasks);
+  std::vector<TestTask> tasks(kTotalTasks);
+  std::vector<std::thread> threads;
+  size_t begin = 0;
+  for (size_t i = 0; i != kProducers; ++i) {
+    size_t end = kTotalTasks * (i + 1) / kProducers;
+    threads.emplace_back([&pool, &latch, &tasks, begin, end] {
+      CDSAttacher attacher;
+      for (size_t i = begin; i != end; ++i) {
+        tasks[i].SetLatch(&latch);
+        ASSERT_TRUE(pool.Enqueue(&tasks[i]));
+      }
+    });
+    begin = end;
+  }
+  latch.Wait();
+  for (auto& task : tasks) {
+    ASSERT_TRUE(task.IsCompleted());
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
 TEST_F(ThreadPoolTest, TestQueueOverflow) {
   constexpr size_t kTotalTasks = 10000;
   constexpr size_t kTotalWorkers = 4;
@@ -15,13 +15,17 @@
 
 #include "yb/rpc/thread_pool.h"
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include <cds/container/basket_queue.h>
 #include <cds/gc/dhp.h>
 
+#include "yb/util/numa.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/thread.h"
 
@@ -35,13 +39,61 @@ class Worker;
 typedef cds::container::BasketQueue<cds::gc::DHP, ThreadPoolTask*> TaskQueue;
 typedef cds::container::BasketQueue<cds::gc::DHP, Worker*> WaitingWorkers;
 
-struct ThreadPoolShare {
-  ThreadPoolOptions options;
+struct ThreadPoolShard {
   TaskQueue task_queue;
   WaitingWorkers waiting_workers;
+};
+
+struct ThreadPoolShare {
+  ThreadPoolOptions options;
+  std::vector<std::unique_ptr<ThreadPoolShard>> shards;
 
   explicit ThreadPoolShare(ThreadPoolOptions o)
-      : options(std::move(o)) {}
+      : options(std::move(o)) {
+    options.num_shards = std::max<size_t>(options.num_shards, 1);
+    shards.reserve(options.num_shards);
+    while (shards.size() != options.num_shards) {
+      shards.push_back(std::make_unique<ThreadPoolShard>());
+    }
+  }
+
+  // Pops task from the specified shard, or steals it from other shards if this one is empty.
+  bool PopTask(size_t shard, ThreadPoolTask** task) {
+    for (size_t i = 0; i != shards.size(); ++i) {
+      if (shards[(shard + i) % shards.size()]->task_queue.pop(*task)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Shard for tasks enqueued by the current thread.
+  size_t CurrentThreadShard() const {
+    if (shards.size() == 1) {
+      return 0;
+    }
+    static std::atomic<size_t> next_thread_index{0};
+    thread_local size_t thread_index = next_thread_index.fetch_add(1, std::memory_order_relaxed);
+    // Thread bound to a NUMA node picks one of the shards, whose workers are bound to this node.
+    const auto current_node = CurrentThreadNumaNode();
+    if (current_node >= 0) {
+      const size_t node = current_node;
+      const auto num_nodes = NumNumaNodes();
+      const auto node_shards = (shards.size() + num_nodes - 1 - node) / num_nodes;
+      if (node_shards != 0) {
+        return node + num_nodes * (thread_index % node_shards);
+      }
+    }
+    return thread_index % shards.size();
+  }
+
+  // NUMA node of workers of the shard, or -1 if they should not be bound.
+  int ShardNumaNode(size_t shard) const {
+    if (shards.size() == 1 || !NumaPlacementEnabled()) {
+      return -1;
+    }
+    return static_cast<int>(shard % NumNumaNodes());
+  }
 };
 
 namespace {
@@ -53,7 +105,7 @@ const std::string kRpcThreadCategory = "rpc_thread_pool";
 class Worker {
  public:
   explicit Worker(ThreadPoolShare* share, size_t index)
-      : share_(share) {
+      : share_(share), shard_(index % share->shards.size()) {
     auto name = strings::Substitute("rpc_tp_$0_$1", share_->options.name, index);
     CHECK_OK(yb::Thread::Create(kRpcThreadCategory, name, &Worker::Execute, this, &thread_));
   }
@@ -93,6 +145,11 @@ class Worker {
   // does not have free hands (worker queue empty)
   void Execute() {
     Thread::current_thread()->SetUserData(share_);
+    const auto node = share_->ShardNumaNode(shard_);
+    if (node >= 0) {
+      auto status = BindCurrentThreadToNumaNode(node);
+      LOG_IF(WARNING, !status.ok()) << "Failed to bind rpc worker to NUMA node: " << status;
+    }
     while (!stop_requested_) {
       ThreadPoolTask* task = nullptr;
       if (PopTask(&task)) {
@@ -105,7 +162,7 @@ class Worker {
   bool PopTask(ThreadPoolTask** task) {
     // First of all we try to get already queued task, w/o locking.
     // If there is no task, so we could go to waiting state.
-    if (share_->task_queue.pop(*task)) {
+    if (share_->PopTask(shard_, task)) {
       return true;
     }
     std::unique_lock<std::mutex> lock(mutex_);
@@ -121,7 +178,7 @@ class Worker {
       // the worker queue. So worker queue could be empty in this case, and nobody was notified
       // about new task. So we check there for this case. This technique is similar to
       // double check.
-      if (share_->task_queue.pop(*task)) {
+      if (share_->PopTask(shard_, task)) {
         return true;
       }
 
@@ -129,7 +186,7 @@ class Worker {
 
       // Sometimes another worker could steal task before we wake up. In this case we will
       // just enqueue ourselves back.
-      if (share_->task_queue.pop(*task)) {
+      if (share_->PopTask(shard_, task)) {
         return true;
       }
     }
@@ -138,13 +195,14 @@ class Worker {
 
   void AddToWaitingWorkers() {
     if (!added_to_waiting_workers_) {
-      auto pushed = share_->waiting_workers.push(this);
+      auto pushed = share_->shards[shard_]->waiting_workers.push(this);
       DCHECK(pushed); // BasketQueue always succeed.
       added_to_waiting_workers_ = true;
     }
   }
 
   ThreadPoolShare* share_;
+  const size_t shard_;
   scoped_refptr<yb::Thread> thread_;
   std::mutex mutex_;
   std::condition_variable cond_;
@@ -179,13 +237,20 @@ class ThreadPool::Impl {
       task->Done(shutdown_status_);
       return false;
     }
-    bool added = share_.task_queue.push(task);
+    const auto num_shards = share_.shards.size();
+    const auto shard = share_.CurrentThreadShard();
+    bool added = share_.shards[shard]->task_queue.push(task);
     DCHECK(added); // BasketQueue always succeed.
     Worker* worker = nullptr;
-    while (share_.waiting_workers.pop(worker)) {
-      if (worker->Notify()) {
-        --adding_;
-        return true;
+    // Prefer a worker of the same shard, and wake up a worker of another shard to steal the task
+    // only when all workers of this shard are busy.
+    for (size_t i = 0; i != num_shards; ++i) {
+      auto& waiting_workers = share_.shards[(shard + i) % num_shards]->waiting_workers;
+      while (waiting_workers.pop(worker)) {
+        if (worker->Notify()) {
+          --adding_;
+          return true;
+        }
       }
     }
     --adding_;
@@ -211,7 +276,9 @@ class ThreadPool::Impl {
     {
       std::lock_guard<std::mutex> lock(mutex_);
       if (closing_) {
-        CHECK(share_.task_queue.empty());
+        for (const auto& shard : share_.shards) {
+          CHECK(shard->task_queue.empty());
+        }
         CHECK(workers_.empty());
         return;
       }
@@ -230,7 +297,7 @@ class ThreadPool::Impl {
     }
     workers_.clear();
     ThreadPoolTask* task = nullptr;
-    while (share_.task_queue.pop(task)) {
+    while (share_.PopTask(0, &task)) {
       task->Done(shutdown_status_);
     }
   }
@@ -44,6 +44,10 @@ struct ThreadPoolOptions {
   std::string name;
   size_t queue_limit;
   size_t max_workers;
+  // Number of task queues. When there are several of them, tasks enqueued by the same thread,
+  // for instance by the same reactor, are placed to the same queue and are run by workers
+  // assigned to this queue. Idle workers steal tasks from queues of other workers.
+  size_t num_shards = 1;
 };
 
 class ThreadPool {
@@ -198,6 +198,30 @@ Status YBInboundConnectionContext::HandleCall(
   return Status::OK();
 }
 
+void YBInboundConnectionContext::CallRejected(
+    const ConnectionPtr& connection, const Slice& prefix, const Status& status) {
+  DCHECK(connection->reactor()->IsCurrentThread());
+
+  auto call = InboundCall::Create<YBInboundCall>(connection, call_processed_listener());
+  auto parsed = call->ParseHeaderFrom(prefix);
+  if (!parsed.ok() || !*parsed) {
+    // Caller will get a timeout, since we don't know which call should be responded.
+    VLOG(3) << connection->ToString() << ": Unable to decode header of rejected call: "
+            << (parsed.ok() ? STATUS(Incomplete, "Header is not fully received")
+                            : parsed.status());
+    return;
+  }
+
+  auto store_status = Store(call.get());
+  if (!store_status.ok()) {
+    LOG(WARNING) << connection->ToString() << ": Failed to store rejected call: " << store_status;
+    return;
+  }
+
+  // Caller retries busy servers with backoff, instead of waiting for the call timeout.
+  call->RespondFailure(ErrorStatusPB::ERROR_SERVER_TOO_BUSY, status);
+}
+
 void YBInboundConnectionContext::Connected(const ConnectionPtr& connection) {
   DCHECK_EQ(connection->direction(), Connection::Direction::SERVER);
 
@@ -278,6 +302,20 @@ Status YBInboundCall::ParseFrom(const MemTrackerPtr& mem_tracker, CallData* call
   consumption_ = ScopedTrackedConsumption(mem_tracker, call_data->size());
   request_data_ = std::move(*call_data);
 
+  return AdoptRemoteMethod();
+}
+
+Result<bool> YBInboundCall::ParseHeaderFrom(const Slice& prefix) {
+  bool complete = false;
+  RETURN_NOT_OK(serialization::ParseYBHeader(prefix, &header_, &complete));
+  if (!complete) {
+    return false;
+  }
+  RETURN_NOT_OK(AdoptRemoteMethod());
+  return true;
+}
+
+Status YBInboundCall::AdoptRemoteMethod() {
   // Adopt the service/method info from the header as soon as it's available.
   if (PREDICT_FALSE(!header_.has_remote_method())) {
     return STATUS(Corruption, "Non-connection context request header must specify remote_method");
@@ -287,6 +325,10 @@ Status YBInboundCall::ParseFrom(const MemTrackerPtr& mem_tracker, CallData* call
         header_.remote_method().InitializationErrorString());
   }
   remote_method_.FromPB(header_.remote_method());
+  if (header_.has_trace_context()) {
+    trace_->StartSpan(remote_method_.ToString(), header_.trace_context().trace_id(),
+                      header_.trace_context().parent_span_id());
+  }
 
   return Status::OK();
 }
@@ -380,6 +422,7 @@ bool YBInboundCall::DumpPB(const DumpRunningRpcsRequestPB& req,
   }
   resp->set_elapsed_millis(MonoTime::Now().GetDeltaSince(timing_.time_received)
       .ToMilliseconds());
+  DumpPhasesPB(resp->mutable_phases());
   return true;
 }
 
@@ -434,6 +477,7 @@ Status YBInboundCall::ParseParam(google::protobuf::Message *message) {
     return STATUS(InvalidArgument, err);
   }
   consumption_.Add(message->SpaceUsedLong());
+  RecordRequestParsed();
 
   if (PREDICT_FALSE(FLAGS_TEST_yb_inbound_big_calls_parse_delay_ms > 0 &&
         request_data_.size() > FLAGS_rpc_throttle_threshold_bytes)) {
@@ -495,6 +539,7 @@ void YBInboundCall::Respond(const MessageLite& response, bool is_success) {
     // TODO: test error case, serialize error response instead
     LOG(DFATAL) << "Unable to serialize response: " << s.ToString();
   }
+  timing_.time_response_serialized = MonoTime::Now();
 
   TRACE_EVENT_ASYNC_END1("rpc", "InboundCall", this, "method", method_name());
 
@@ -71,6 +71,8 @@ class YBInboundConnectionContext : public YBConnectionContext {
  private:
   // Takes ownership of call_data content.
   CHECKED_STATUS HandleCall(const ConnectionPtr& connection, CallData* call_data) override;
+  void CallRejected(
+      const ConnectionPtr& connection, const Slice& prefix, const Status& status) override;
   void Connected(const ConnectionPtr& connection) override;
   Result<ProcessDataResult> ProcessCalls(const ConnectionPtr& connection,
                                           const IoVecs& data,
@@ -114,6 +116,12 @@ class YBInboundCall : public InboundCall {
   // Takes ownership of call_data content.
   CHECKED_STATUS ParseFrom(const MemTrackerPtr& mem_tracker, CallData* call_data);
 
+  // Parse only the header of the call from the beginning of its data, so the call could be
+  // responded before the rest of its data is received.
+  //
+  // Returns false if prefix does not contain the whole header.
+  Result<bool> ParseHeaderFrom(const Slice& prefix);
+
   int32_t call_id() const {
     return header_.call_id();
   }
@@ -196,6 +204,9 @@ class YBInboundCall : public InboundCall {
   virtual void Respond(const google::protobuf::MessageLite& response, bool is_success);
 
  private:
+  // Fills remote method from the parsed header.
+  CHECKED_STATUS AdoptRemoteMethod();
+
   // Serialize a response message for either success or failure. If it is a success,
   // 'response' should be the user-defined response type for the call. If it is a
   // failure, 'response' should be an ErrorStatusPB instance.
@@ -48,6 +48,7 @@
 #include <fstream>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -62,6 +63,7 @@
 #include "yb/gutil/strings/human_readable.h"
 #include "yb/gutil/strings/split.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/gutil/thread_annotations.h"
 #include "yb/server/pprof-path-handlers.h"
 #include "yb/server/webserver.h"
 #include "yb/util/flag_tags.h"
@@ -70,7 +72,9 @@
 #include "yb/util/mem_tracker.h"
 #include "yb/util/memory/memory.h"
 #include "yb/util/metrics.h"
+#include "yb/util/monotime.h"
 #include "yb/util/jsonwriter.h"
+#include "yb/util/trace.h"
 #include "yb/util/version_info.h"
 #include "yb/util/version_info.pb.h"
 
@@ -79,6 +83,12 @@ DEFINE_int64(web_log_bytes, 1024 * 1024,
 TAG_FLAG(web_log_bytes, advanced);
 TAG_FLAG(web_log_bytes, runtime);
 
+DEFINE_int32(prometheus_metrics_cache_ms, 1000,
+    "For how long, in milliseconds, a rendering of /prometheus-metrics is served to subsequent "
+    "requests with the same arguments. 0 to render every request.");
+TAG_FLAG(prometheus_metrics_cache_ms, advanced);
+TAG_FLAG(prometheus_metrics_cache_ms, runtime);
+
 namespace yb {
 
 using boost::replace_all;
@@ -242,10 +252,67 @@ static void WriteMetricsAsJson(const MetricRegistry* const metrics,
               "Couldn't write JSON metrics over HTTP");
 }
 
+// Last rendering of Prometheus metrics. Serving it to requests that arrive shortly after it was
+// rendered keeps concurrent scrapers from rendering all metrics again, and from resetting
+// histogram percentiles for each other.
+struct PrometheusMetricsCache {
+  std::mutex mutex;
+  string args GUARDED_BY(mutex);
+  CoarseTimePoint render_time GUARDED_BY(mutex);
+  string content GUARDED_BY(mutex);
+};
+
+static void RenderForPrometheus(const MetricRegistry* const metrics,
+                                const Webserver::WebRequest& req, std::stringstream* output) {
+  MetricPrometheusOptions opts;
+  const string* metrics_param = FindOrNull(req.parsed_args, "metrics");
+  if (metrics_param != nullptr) {
+    opts.metrics.clear();
+    SplitStringUsing(*metrics_param, ",", &opts.metrics);
+  }
+  const string* entity_types_param = FindOrNull(req.parsed_args, "entity_types");
+  if (entity_types_param != nullptr) {
+    SplitStringUsing(*entity_types_param, ",", &opts.entity_types);
+  }
+  auto aggregation_level = PrometheusAggregationLevel::kTable;
+  {
+    string arg = FindWithDefault(req.parsed_args, "aggregation", "table");
+    if (arg == "tablet") {
+      aggregation_level = PrometheusAggregationLevel::kTablet;
+    } else if (arg != "table") {
+      LOG(WARNING) << "Unknown Prometheus metrics aggregation level: " << arg;
+    }
+  }
+
+  PrometheusWriter writer(output, aggregation_level);
+  WARN_NOT_OK(metrics->WriteForPrometheus(&writer, opts),
+              "Couldn't write text metrics for Prometheus");
+}
+
 static void WriteForPrometheus(const MetricRegistry* const metrics,
+                               const std::shared_ptr<PrometheusMetricsCache>& cache,
                                const Webserver::WebRequest& req, std::stringstream* output) {
-  PrometheusWriter writer(output);
-  WARN_NOT_OK(metrics->WriteForPrometheus(&writer), "Couldn't write text metrics for Prometheus");
+  const auto cache_duration = MonoDelta::FromMilliseconds(FLAGS_prometheus_metrics_cache_ms);
+  if (cache_duration <= MonoDelta::kZero) {
+    RenderForPrometheus(metrics, req, output);
+    return;
+  }
+
+  string args;
+  for (const auto& arg : req.parsed_args) {
+    args += arg.first + "=" + arg.second + "&";
+  }
+  // Concurrent requests wait for the rendering in progress and are served from it.
+  std::lock_guard<std::mutex> lock(cache->mutex);
+  const auto now = CoarseMonoClock::Now();
+  if (cache->args != args || cache->render_time + cache_duration < now) {
+    std::stringstream rendered;
+    RenderForPrometheus(metrics, req, &rendered);
+    cache->args = std::move(args);
+    cache->render_time = now;
+    cache->content = rendered.str();
+  }
+  *output << cache->content;
 }
 
 static void HandleGetVersionInfo(
@@ -277,6 +344,12 @@ static void HandleGetVersionInfo(
   jw.EndObject();
 }
 
+// Returns recently finished spans of sampled distributed traces, in the OTLP/JSON format.
+static void HandleGetTraceSpans(
+    const Webserver::WebRequest& req, std::stringstream* output) {
+  WriteRecentTraceSpansAsOtlpJson(google::ProgramInvocationShortName(), output);
+}
+
 } // anonymous namespace
 
 void AddDefaultPathHandlers(Webserver* webserver) {
@@ -288,6 +361,8 @@ void AddDefaultPathHandlers(Webserver* webserver) {
                                  MemTrackersHandler, true, false);
   webserver->RegisterPathHandler("/api/v1/version-info", "Build Version Info",
                                  HandleGetVersionInfo, false, false);
+  webserver->RegisterPathHandler("/api/v1/trace-spans", "Trace Spans",
+                                 HandleGetTraceSpans, false, false);
 
   AddPprofPathHandlers(webserver);
 }
@@ -295,7 +370,7 @@ void AddDefaultPathHandlers(Webserver* webserver) {
 void RegisterMetricsJsonHandler(Webserver* webserver, const MetricRegistry* const metrics) {
   Webserver::PathHandlerCallback callback = std::bind(WriteMetricsAsJson, metrics, _1, _2);
   Webserver::PathHandlerCallback prometheus_callback = std::bind(
-      WriteForPrometheus, metrics, _1, _2);
+      WriteForPrometheus, metrics, std::make_shared<PrometheusMetricsCache>(), _1, _2);
   bool not_styled = false;
   bool not_on_nav_bar = false;
   webserver->RegisterPathHandler("/metrics", "Metrics", callback, not_styled, not_on_nav_bar);
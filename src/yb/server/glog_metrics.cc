@@ -33,7 +33,9 @@
 
 #include <glog/logging.h>
 
+#include "yb/gutil/bind.h"
 #include "yb/gutil/once.h"
+#include "yb/util/async_logger.h"
 #include "yb/util/metrics.h"
 
 METRIC_DEFINE_counter(server, glog_info_messages,
@@ -48,6 +50,16 @@ METRIC_DEFINE_counter(server, glog_error_messages,
                       "ERROR-level Log Messages", yb::MetricUnit::kMessages,
                       "Number of ERROR-level log messages emitted by the application.");
 
+METRIC_DEFINE_gauge_uint64(server, glog_async_dropped_messages,
+                           "Dropped Async Log Messages", yb::MetricUnit::kMessages,
+                           "Number of log messages dropped because the buffer of the async logger "
+                           "was full.");
+
+METRIC_DEFINE_gauge_uint64(server, glog_async_buffered_messages,
+                           "Buffered Async Log Messages", yb::MetricUnit::kMessages,
+                           "Number of log messages buffered by the async logger, that are not "
+                           "written to log files yet.");
+
 namespace yb {
 
 class MetricsSink : public google::LogSink {
@@ -90,6 +102,10 @@ class MetricsSink : public google::LogSink {
 ScopedGLogMetrics::ScopedGLogMetrics(const scoped_refptr<MetricEntity>& entity)
   : sink_(new MetricsSink(entity)) {
   google::AddLogSink(sink_.get());
+  METRIC_glog_async_dropped_messages.InstantiateFunctionGauge(
+      entity, Bind(&AsyncLoggingDroppedMessages));
+  METRIC_glog_async_buffered_messages.InstantiateFunctionGauge(
+      entity, Bind(&AsyncLoggingBufferedMessages));
 }
 
 ScopedGLogMetrics::~ScopedGLogMetrics() {
@@ -31,12 +31,14 @@
 //
 
 #include <algorithm>
+#include <atomic>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 
 #include "yb/server/hybrid_clock.h"
 #include "yb/server/mock_hybrid_clock.h"
 #include "yb/util/monotime.h"
+#include "yb/util/ntp_clock.h"
 #include "yb/util/random.h"
 #include "yb/util/random_util.h"
 #include "yb/util/test_util.h"
@@ -90,6 +92,27 @@ TEST(MockHybridClockTest, TestMockedSystemClock) {
             HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(time.time_point, 1).ToUint64());
 }
 
+// Test that the read restart window of the ntp time source follows the reported clock error.
+TEST(MockHybridClockTest, NtpClockErrorBound) {
+  MockClock mock_clock;
+  scoped_refptr<HybridClock> clock(
+      new HybridClock(std::make_shared<NtpClock>(mock_clock.AsClock())));
+  ASSERT_OK(clock->Init());
+  MicrosTime time_point = 0;
+  for (MicrosTime max_error : {100, 5000, 20}) {
+    // Advance the clock, so the hybrid clock does not fall back to the logical component.
+    time_point += 1000000;
+    PhysicalTime time = {time_point, max_error};
+    mock_clock.Set(time);
+    auto range = clock->NowRange();
+    // The clock returns the earliest possible time, and the global limit is the latest possible
+    // time of any other server using the same time source.
+    ASSERT_EQ(time.time_point - max_error, range.first.GetPhysicalValueMicros());
+    ASSERT_EQ(range.first.GetPhysicalValueMicros() + 2 * max_error,
+              range.second.GetPhysicalValueMicros());
+  }
+}
+
 // Test that two subsequent time reads are monotonically increasing.
 TEST_F(HybridClockTest, TestNow_ValuesIncreaseMonotonically) {
   const HybridTime now1 = clock_->Now();
@@ -171,6 +194,36 @@ void HybridClockTest::RunMultiThreadedTest(int num_reads_per_update) {
   }
 }
 
+// Measures the throughput of concurrent clock reads, mixed with occasional updates, for different
+// numbers of threads.
+TEST_F(HybridClockTest, ConcurrentNowPerformance) {
+  constexpr auto kTestDuration = std::chrono::seconds(2);
+  constexpr int kReadsPerUpdate = 1000;
+  for (int num_threads : {1, 4, 16, 64}) {
+    std::atomic<uint64_t> total_reads{0};
+    TestThreadHolder holder;
+    for (int i = 0; i != num_threads; ++i) {
+      holder.AddThread([this, &total_reads, &stop = holder.stop_flag()] {
+        HybridTime prev = HybridTime::kMin;
+        uint64_t reads = 0;
+        while (!stop.load(std::memory_order_acquire)) {
+          auto now = clock_->Now();
+          ASSERT_GT(now, prev);
+          prev = now;
+          if (++reads % kReadsPerUpdate == 0) {
+            clock_->Update(now.AddMicroseconds(1));
+          }
+        }
+        total_reads += reads;
+      });
+    }
+    holder.WaitAndStop(kTestDuration);
+    LOG(INFO) << num_threads << " threads: "
+              << total_reads.load() / std::chrono::duration<double>(kTestDuration).count()
+              << " reads per second";
+  }
+}
+
 TEST_F(HybridClockTest, CompareHybridClocksToDelta) {
   EXPECT_EQ(1, HybridClock::CompareHybridClocksToDelta(
       HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(1000, 10),
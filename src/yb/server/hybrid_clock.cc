@@ -45,6 +45,7 @@
 #include "yb/util/locks.h"
 #include "yb/util/logging.h"
 #include "yb/util/metrics.h"
+#include "yb/util/ntp_clock.h"
 #include "yb/util/status.h"
 
 DEFINE_bool(use_hybrid_clock, true,
@@ -62,10 +63,13 @@ METRIC_DEFINE_gauge_uint64(server, hybrid_clock_error,
                            "Server clock maximum error.");
 
 DEFINE_string(time_source, "",
-              "The clock source that HybridClock should use (for tests only). "
-              "Leave empty for WallClock, other values depend on added clock providers and "
-              "specific for appropriate tests, that adds them.");
-TAG_FLAG(time_source, hidden);
+              "The clock source that HybridClock should use. Leave empty for WallClock, that "
+              "assumes max_clock_skew_usec of clock error. Set to ntp to use the maximum error "
+              "reported by the kernel clock discipline (chrony, ntpd or a PTP daemon) as the "
+              "clock uncertainty, so read restart windows follow the actual clock error. "
+              "It should be the same on all servers of a cluster. Other values depend on added "
+              "clock providers and specific for appropriate tests, that adds them.");
+TAG_FLAG(time_source, advanced);
 
 using yb::Status;
 using strings::Substitute;
@@ -88,6 +92,11 @@ PhysicalClockPtr GetClock(const std::string& options) {
   auto pos = options.find(',');
   auto name = pos == std::string::npos ? options : options.substr(0, pos);
   auto arg = pos == std::string::npos ? std::string() : options.substr(pos + 1);
+#if !defined(__APPLE__)
+  if (name == NtpClock::Name()) {
+    return std::make_shared<NtpClock>();
+  }
+#endif
   std::lock_guard<std::mutex> lock(providers_mutex);
   auto it = providers.find(name);
   if (it == providers.end()) {
@@ -141,15 +150,15 @@ void HybridClock::NowWithError(HybridTime *hybrid_time, uint64_t *max_error_usec
   }
 
   // If the current time surpasses the last update just return it
-  HybridClockComponents current_components = components_.load(boost::memory_order_acquire);
-  HybridClockComponents new_components = { now->time_point, 1 };
+  const auto now_repr = HybridTimeFromMicroseconds(now->time_point).ToUint64();
+  auto current = next_.load(std::memory_order_acquire);
 
-  VLOG(4) << __func__ << ", new: " << new_components << ", current: " << current_components;
+  VLOG(4) << __func__ << ", now: " << now_repr << ", next: " << current;
 
   // Loop over the check in case of concurrent updates making the CAS fail.
-  while (now->time_point > current_components.last_usec) {
-    if (components_.compare_exchange_weak(current_components, new_components)) {
-      *hybrid_time = HybridTimeFromMicroseconds(new_components.last_usec);
+  while (now->time_point > (current >> HybridTime::kBitsForLogicalComponent)) {
+    if (next_.compare_exchange_weak(current, now_repr + 1, std::memory_order_acq_rel)) {
+      *hybrid_time = HybridTime(now_repr);
       *max_error_usec = now->max_error;
       if (PREDICT_FALSE(VLOG_IS_ON(2))) {
         VLOG(2) << "Current clock is higher than the last one. Resetting logical values."
@@ -177,18 +186,17 @@ void HybridClock::NowWithError(HybridTime *hybrid_time, uint64_t *max_error_usec
   // This broadens the error interval for both cases but always returns
   // a correct error interval.
 
-  do {
-    new_components.last_usec = current_components.last_usec;
-    new_components.logical = current_components.logical + 1;
-    new_components.HandleLogicalComponentOverflow();
-    // Loop over the check until the CAS succeeds, in case there are concurrent updates.
-  } while (!components_.compare_exchange_weak(current_components, new_components));
-
-  *max_error_usec = new_components.last_usec - (now->time_point - now->max_error);
+  // The value could only grow since it was loaded, so it is still not behind the physical clock.
+  const auto result = next_.fetch_add(1, std::memory_order_acq_rel);
+  if (PREDICT_FALSE(((result + 1) & HybridTime::kLogicalBitMask) == 0)) {
+    YB_LOG_EVERY_N_SECS(WARNING, 5) << "Logical component overflow: "
+        << HybridTime(result + 1).ToString();
+  }
 
-  // We've already atomically incremented the logical, so subtract 1.
-  *hybrid_time = HybridTimeFromMicrosecondsAndLogicalValue(
-      new_components.last_usec, new_components.logical).Decremented();
+  *max_error_usec =
+      ((result + 1) >> HybridTime::kBitsForLogicalComponent) -
+      (now->time_point - now->max_error);
+  *hybrid_time = HybridTime(result);
   if (PREDICT_FALSE(VLOG_IS_ON(2))) {
     VLOG(2) << "Current clock is lower than the last one. Returning last read and incrementing"
         " logical values. Hybrid time: " << *hybrid_time << " Error: " << *max_error_usec;
@@ -200,21 +208,18 @@ void HybridClock::Update(const HybridTime& to_update) {
     return;
   }
 
-  HybridClockComponents current_components = components_.load(boost::memory_order_acquire);
-  HybridClockComponents new_components = {
-    GetPhysicalValueMicros(to_update), GetLogicalValue(to_update) + 1
-  };
+  auto current = next_.load(std::memory_order_acquire);
+  // Logical component overflow carries into the physical component.
+  const auto new_value = to_update.ToUint64() + 1;
 
   // VLOG(4) crashes in TSAN mode
   if (VLOG_IS_ON(4)) {
-    LOG(INFO) << __func__ << ", new: " << new_components << ", current: " << current_components;
+    LOG(INFO) << __func__ << ", new: " << new_value << ", current: " << current;
   }
 
-  new_components.HandleLogicalComponentOverflow();
-
   // Keep trying to CAS until it works or until HT has advanced past this update.
-  while (current_components < new_components &&
-      !components_.compare_exchange_weak(current_components, new_components)) {}
+  while (current < new_value &&
+      !next_.compare_exchange_weak(current, new_value, std::memory_order_acq_rel)) {}
 }
 
 // Used to get the hybrid_time for metrics.
@@ -231,29 +236,6 @@ uint64_t HybridClock::ErrorForMetrics() {
   return error;
 }
 
-std::string HybridClockComponents::ToString() const {
-  return Format("{ last_usec: $0 logical: $1 }", last_usec, logical);
-}
-
-std::ostream& operator<<(std::ostream& out, const HybridClockComponents& components) {
-  return out << components.ToString();
-}
-
-void HybridClockComponents::HandleLogicalComponentOverflow() {
-  if (logical > HybridTime::kLogicalBitMask) {
-    static constexpr uint64_t kMaxOverflowValue = 1ULL << HybridTime::kBitsForLogicalComponent;
-    if (logical > kMaxOverflowValue) {
-      LOG(FATAL) << "Logical component is too high: last_usec=" << last_usec
-                 << "logical=" << logical << ", max allowed is " << kMaxOverflowValue;
-    }
-    YB_LOG_EVERY_N_SECS(WARNING, 5) << "Logical component overflow: "
-        << "last_usec=" << last_usec << ", logical=" << logical;
-
-    last_usec += logical >> HybridTime::kBitsForLogicalComponent;
-    logical &= HybridTime::kLogicalBitMask;
-  }
-}
-
 void HybridClock::RegisterMetrics(const scoped_refptr<MetricEntity>& metric_entity) {
   METRIC_hybrid_clock_hybrid_time.InstantiateFunctionGauge(
       metric_entity,
@@ -39,8 +39,6 @@
 #include <sys/timex.h>
 #endif // !defined(__APPLE__)
 
-#include <boost/atomic.hpp>
-
 #include "yb/gutil/ref_counted.h"
 #include "yb/server/clock.h"
 #include "yb/util/locks.h"
@@ -50,38 +48,6 @@
 namespace yb {
 namespace server {
 
-struct HybridClockComponents {
-  // The last clock read/update, in microseconds.
-  MicrosTime last_usec = 0;
-
-  // The next logical value to be assigned to a hybrid time.
-  LogicalTimeComponent logical = 0;
-
-  HybridClockComponents() noexcept {}
-
-  HybridClockComponents(MicrosTime last_usec_, LogicalTimeComponent logical_)
-      : last_usec(last_usec_),
-        logical(logical_) {
-  }
-
-  HybridClockComponents(HybridClockComponents&& other) = default;
-  HybridClockComponents(const HybridClockComponents& other) = default;
-
-  bool operator< (const HybridClockComponents& o) const {
-    return last_usec < o.last_usec || (last_usec == o.last_usec && logical < o.logical);
-  }
-
-  bool operator<= (const HybridClockComponents& o) const {
-    return last_usec < o.last_usec || (last_usec == o.last_usec && logical <= o.logical);
-  }
-
-  void HandleLogicalComponentOverflow();
-
-  std::string ToString() const;
-};
-
-std::ostream& operator<<(std::ostream& out, const HybridClockComponents& components);
-
 // The HybridTime clock.
 //
 // HybridTime should not be used on a distributed cluster running on OS X hosts,
@@ -154,7 +120,11 @@ class HybridClock : public Clock {
   uint64_t ErrorForMetrics();
 
   PhysicalClockPtr clock_;
-  boost::atomic<HybridClockComponents> components_{HybridClockComponents(0, 0)};
+  // Representation of the next hybrid time to be returned by a clock read, that does not advance
+  // the physical component. Packing it into a single word makes reads lock-free on all platforms,
+  // and lets them take the next logical value with a single fetch_add. Logical component overflow
+  // carries into the physical component.
+  std::atomic<HybridTimeRepr> next_{0};
   State state_ = kNotInitialized;
 
   // Clock metrics are set to detach to their last value. This means
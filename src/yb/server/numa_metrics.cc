@@ -0,0 +1,88 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/server/numa_metrics.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include "yb/util/format.h"
+#include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+#include "yb/util/numa.h"
+
+namespace yb {
+namespace numa {
+
+namespace {
+
+struct NodePrototypes {
+  std::unique_ptr<GaugePrototype<uint64_t>> local_bytes;
+  std::unique_ptr<GaugePrototype<uint64_t>> remote_bytes;
+};
+
+std::unique_ptr<GaugePrototype<uint64_t>> MakePrototype(
+    size_t node, const char* kind, const char* label, const char* description) {
+  return std::make_unique<OwningGaugePrototype<uint64_t>>(
+      "server", Format("numa_node$0_$1_allocated_bytes", node, kind),
+      Format("NUMA Node $0 $1 Allocated Memory", node, label), MetricUnit::kBytes,
+      Format("Memory allocated on NUMA node $0 $1, by all processes of the machine.",
+             node, description),
+      EXPOSE_AS_COUNTER);
+}
+
+// Prototypes are shared by all entities, and live until the process exits.
+const std::vector<NodePrototypes>& Prototypes() {
+  static std::vector<NodePrototypes>* prototypes = [] {
+    auto* result = new std::vector<NodePrototypes>(NumNumaNodes());
+    for (size_t node = 0; node != result->size(); ++node) {
+      (*result)[node].local_bytes = MakePrototype(
+          node, "local", "Local", "by threads that run on this node");
+      (*result)[node].remote_bytes = MakePrototype(
+          node, "remote", "Remote", "by threads that run on other nodes");
+    }
+    return result;
+  }();
+  return *prototypes;
+}
+
+uint64_t NodeAllocatedBytes(size_t node, bool remote) {
+  auto stats = GetNumaNodeMemoryStats(node);
+  if (!stats.ok()) {
+    YB_LOG_EVERY_N_SECS(WARNING, 60) << "Failed to get memory stats of NUMA node " << node << ": "
+                                     << stats.status();
+    return 0;
+  }
+  return remote ? stats->remote_bytes : stats->local_bytes;
+}
+
+} // namespace
+
+void RegisterMetrics(const scoped_refptr<MetricEntity>& entity) {
+  if (NumNumaNodes() < 2) {
+    return;
+  }
+  const auto& prototypes = Prototypes();
+  for (size_t node = 0; node != prototypes.size(); ++node) {
+    entity->NeverRetire(prototypes[node].local_bytes->InstantiateFunctionGauge(
+        entity, Bind(NodeAllocatedBytes, node, false /* remote */)));
+    entity->NeverRetire(prototypes[node].remote_bytes->InstantiateFunctionGauge(
+        entity, Bind(NodeAllocatedBytes, node, true /* remote */)));
+  }
+}
+
+} // namespace numa
+} // namespace yb
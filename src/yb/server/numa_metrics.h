@@ -0,0 +1,31 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_SERVER_NUMA_METRICS_H
+#define YB_SERVER_NUMA_METRICS_H
+
+#include "yb/gutil/ref_counted.h"
+
+namespace yb {
+class MetricEntity;
+namespace numa {
+
+// Registers per NUMA node memory allocation metrics, when there is more than one node.
+// Like tcmalloc metrics, they are the same for all entities, since allocations are counted by the
+// kernel for the whole machine.
+void RegisterMetrics(const scoped_refptr<MetricEntity>& entity);
+
+} // namespace numa
+} // namespace yb
+
+#endif // YB_SERVER_NUMA_METRICS_H
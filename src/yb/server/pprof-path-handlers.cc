@@ -62,13 +62,17 @@
 #include "yb/gutil/strings/substitute.h"
 #include "yb/gutil/sysinfo.h"
 #include "yb/server/webserver.h"
+#include "yb/util/allocation_profiler.h"
+#include "yb/util/continuous_profiler.h"
 #include "yb/util/env.h"
 #include "yb/util/logging.h"
 #include "yb/util/monotime.h"
 #include "yb/util/spinlock_profiling.h"
 #include "yb/util/status.h"
 
+DECLARE_int32(allocation_profiler_history_minutes);
 DECLARE_bool(enable_process_lifetime_heap_profiling);
+DECLARE_int32(continuous_profiler_history_minutes);
 DECLARE_string(heap_profile_path);
 
 
@@ -260,6 +264,37 @@ static void PprofSymbolHandler(const Webserver::WebRequest& req, stringstream* o
       pieces.size(), invalid_addrs, missing_symbols);
 }
 
+// Responds to /pprof/collapsed?minutes=XX with the number of samples of running threads taken by
+// the continuous profiler during the last XX minutes, as collapsed stacks, that could be rendered
+// as a flame graph, e.g. by flamegraph.pl.
+static void PprofCollapsedHandler(const Webserver::WebRequest& req, stringstream* output) {
+  auto it = req.parsed_args.find("minutes");
+  int minutes = FLAGS_continuous_profiler_history_minutes;
+  if (it != req.parsed_args.end()) {
+    minutes = atoi(it->second.c_str());
+  }
+  ContinuousProfiler::Instance()->WriteCollapsedStacks(
+      MonoDelta::FromSeconds(minutes * 60), output);
+}
+
+// Responds to /pprof/allocations?minutes=XX with heap allocation rates sampled by the allocation
+// profiler during the last XX minutes, per thread pool and RPC method. With format=collapsed,
+// responds with allocated bytes per collapsed stack instead.
+static void PprofAllocationsHandler(const Webserver::WebRequest& req, stringstream* output) {
+  auto it = req.parsed_args.find("minutes");
+  int minutes = FLAGS_allocation_profiler_history_minutes;
+  if (it != req.parsed_args.end()) {
+    minutes = atoi(it->second.c_str());
+  }
+  auto period = MonoDelta::FromSeconds(minutes * 60);
+  it = req.parsed_args.find("format");
+  if (it != req.parsed_args.end() && it->second == "collapsed") {
+    AllocationProfiler::Instance()->WriteCollapsedStacks(period, output);
+  } else {
+    AllocationProfiler::Instance()->WriteReport(period, output);
+  }
+}
+
 void AddPprofPathHandlers(Webserver* webserver) {
   // Path handlers for remote pprof profiling. For information see:
   // https://gperftools.googlecode.com/svn/trunk/doc/pprof_remote_servers.html
@@ -269,6 +304,11 @@ void AddPprofPathHandlers(Webserver* webserver) {
   webserver->RegisterPathHandler("/pprof/profile", "", PprofCpuProfileHandler, false, false);
   webserver->RegisterPathHandler("/pprof/symbol", "", PprofSymbolHandler, false, false);
   webserver->RegisterPathHandler("/pprof/contention", "", PprofContentionHandler, false, false);
+  webserver->RegisterPathHandler("/pprof/collapsed", "", PprofCollapsedHandler, false, false);
+  webserver->RegisterPathHandler("/pprof/allocations", "", PprofAllocationsHandler, false, false);
+
+  WARN_NOT_OK(ContinuousProfiler::Instance()->Start(), "Failed to start continuous profiler");
+  WARN_NOT_OK(AllocationProfiler::Start(), "Failed to start allocation profiler");
 }
 
 } // namespace yb
@@ -50,6 +50,7 @@
 #include "yb/server/glog_metrics.h"
 #include "yb/server/hybrid_clock.h"
 #include "yb/server/logical_clock.h"
+#include "yb/server/numa_metrics.h"
 #include "yb/server/rpc_server.h"
 #include "yb/server/rpcz-path-handler.h"
 #include "yb/server/server_base.pb.h"
@@ -243,6 +244,7 @@ Status RpcServerBase::Init() {
 
   glog_metrics_.reset(new ScopedGLogMetrics(metric_entity_));
   tcmalloc::RegisterMetrics(metric_entity_);
+  numa::RegisterMetrics(metric_entity_);
   RegisterSpinLockContentionMetrics(metric_entity_);
 
   InitSpinLockContentionProfiling();
@@ -29,10 +29,11 @@ Status AbstractTablet::HandleQLReadRequest(CoarseTimePoint deadline,
                                            const ReadHybridTime& read_time,
                                            const QLReadRequestPB& ql_read_request,
                                            const TransactionOperationContextOpt& txn_op_context,
-                                           QLReadRequestResult* result) {
+                                           QLReadRequestResult* result,
+                                           docdb::RowCache* row_cache) {
 
   // TODO(Robert): verify that all key column values are provided
-  docdb::QLReadOperation doc_op(ql_read_request, txn_op_context);
+  docdb::QLReadOperation doc_op(ql_read_request, txn_op_context, row_cache);
 
   // Form a schema of columns that are referenced by this query.
   const Schema &schema = SchemaRef();
@@ -75,9 +76,13 @@ Status AbstractTablet::HandlePgsqlReadRequest(CoarseTimePoint deadline,
                                               const ReadHybridTime& read_time,
                                               const PgsqlReadRequestPB& pgsql_read_request,
                                               const TransactionOperationContextOpt& txn_op_context,
-                                              PgsqlReadRequestResult* result) {
+                                              PgsqlReadRequestResult* result,
+                                              const docdb::DocDB* locks_doc_db) {
 
   docdb::PgsqlReadOperation doc_op(pgsql_read_request, txn_op_context);
+  if (locks_doc_db) {
+    doc_op.SkipLockedRows(*locks_doc_db);
+  }
 
   // Form a schema of columns that are referenced by this query.
   const Schema &schema = SchemaRef(pgsql_read_request.table_id());
@@ -96,6 +101,7 @@ Status AbstractTablet::HandlePgsqlReadRequest(CoarseTimePoint deadline,
     return Status::OK();
   }
   result->response.Swap(&doc_op.response());
+  result->row_keys_to_lock.swap(doc_op.row_keys_to_lock());
 
   RETURN_NOT_OK(CreatePagingStateForRead(
       pgsql_read_request, resultset.rsrow_count(), &result->response));
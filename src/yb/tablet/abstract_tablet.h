@@ -14,12 +14,17 @@
 #ifndef YB_TABLET_ABSTRACT_TABLET_H
 #define YB_TABLET_ABSTRACT_TABLET_H
 
+#include <string>
+#include <vector>
+
 #include "yb/common/pgsql_protocol.pb.h"
 #include "yb/common/ql_protocol.pb.h"
 #include "yb/common/ql_storage_interface.h"
 #include "yb/common/redis_protocol.pb.h"
 #include "yb/common/schema.h"
 
+#include "yb/docdb/docdb_fwd.h"
+
 #include "yb/tablet/tablet_fwd.h"
 
 namespace yb {
@@ -35,6 +40,8 @@ struct PgsqlReadRequestResult {
   PgsqlResponsePB response;
   faststring rows_data;
   HybridTime restart_read_ht;
+  // Encoded doc keys of the returned rows, that should be locked for the row mark of the request.
+  std::vector<std::string> row_keys_to_lock;
 };
 
 class AbstractTablet {
@@ -108,22 +115,27 @@ class AbstractTablet {
   // PGSQL support.
   //-----------------------------------------------------------------------------------------------
 
+  // row_cache, if not null, is used to serve reads of a single row by its primary key.
   CHECKED_STATUS HandleQLReadRequest(
       CoarseTimePoint deadline,
       const ReadHybridTime& read_time,
       const QLReadRequestPB& ql_read_request,
       const TransactionOperationContextOpt& txn_op_context,
-      QLReadRequestResult* result);
+      QLReadRequestResult* result,
+      docdb::RowCache* row_cache = nullptr);
 
   virtual CHECKED_STATUS CreatePagingStateForRead(const PgsqlReadRequestPB& pgsql_read_request,
                                                   const size_t row_count,
                                                   PgsqlResponsePB* response) const = 0;
 
+  // locks_doc_db, if not null, is used to skip rows locked by other transactions for the SKIP
+  // LOCKED wait policy.
   CHECKED_STATUS HandlePgsqlReadRequest(CoarseTimePoint deadline,
                                         const ReadHybridTime& read_time,
                                         const PgsqlReadRequestPB& pgsql_read_request,
                                         const TransactionOperationContextOpt& txn_op_context,
-                                        PgsqlReadRequestResult* result);
+                                        PgsqlReadRequestResult* result,
+                                        const docdb::DocDB* locks_doc_db = nullptr);
 
   virtual bool IsTransactionalRequest(bool is_ysql_request) const = 0;
 
@@ -0,0 +1,68 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/final_transaction_status_cache.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace tablet {
+
+class FinalTransactionStatusCacheTest : public YBTest {
+};
+
+TEST_F(FinalTransactionStatusCacheTest, FinalStatusesOnly) {
+  FinalTransactionStatusCache cache(10);
+  auto pending = GenerateTransactionId();
+  auto committed = GenerateTransactionId();
+  auto being_committed = GenerateTransactionId();
+  auto aborted = GenerateTransactionId();
+  const HybridTime kCommitTime(1000);
+
+  cache.Add(pending, TransactionStatusResult(TransactionStatus::PENDING, kCommitTime));
+  cache.Add(committed, TransactionStatusResult(TransactionStatus::COMMITTED, kCommitTime));
+  cache.Add(being_committed,
+            TransactionStatusResult(TransactionStatus::COMMITTED, HybridTime::kMax));
+  cache.Add(aborted, TransactionStatusResult::Aborted());
+
+  ASSERT_FALSE(cache.Get(pending));
+  ASSERT_FALSE(cache.Get(being_committed));
+
+  auto result = cache.Get(committed);
+  ASSERT_TRUE(result);
+  ASSERT_EQ(TransactionStatus::COMMITTED, result->status);
+  ASSERT_EQ(kCommitTime, result->status_time);
+
+  result = cache.Get(aborted);
+  ASSERT_TRUE(result);
+  ASSERT_EQ(TransactionStatus::ABORTED, result->status);
+}
+
+TEST_F(FinalTransactionStatusCacheTest, Eviction) {
+  constexpr size_t kCapacity = 5;
+  FinalTransactionStatusCache cache(kCapacity);
+  std::vector<TransactionId> ids;
+  for (size_t i = 0; i != 2 * kCapacity; ++i) {
+    ids.push_back(GenerateTransactionId());
+    cache.Add(ids.back(), TransactionStatusResult::Aborted());
+  }
+
+  // Only the latest transactions are kept.
+  for (size_t i = 0; i != ids.size(); ++i) {
+    ASSERT_EQ(i >= kCapacity, static_cast<bool>(cache.Get(ids[i]))) << i;
+  }
+}
+
+} // namespace tablet
+} // namespace yb
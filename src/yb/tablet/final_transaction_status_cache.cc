@@ -0,0 +1,56 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/final_transaction_status_cache.h"
+
+namespace yb {
+namespace tablet {
+
+FinalTransactionStatusCache::FinalTransactionStatusCache(size_t capacity) : capacity_(capacity) {
+}
+
+void FinalTransactionStatusCache::Add(
+    const TransactionId& id, const TransactionStatusResult& result) {
+  // kMax commit time means that COMMITTED record is not replicated yet.
+  if (result.status != TransactionStatus::ABORTED &&
+      (result.status != TransactionStatus::COMMITTED || !result.status_time.is_valid() ||
+       result.status_time == HybridTime::kMax)) {
+    return;
+  }
+  if (capacity_ == 0) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!statuses_.emplace(id, result).second) {
+    return;
+  }
+  order_.push_back(id);
+  while (order_.size() > capacity_) {
+    statuses_.erase(order_.front());
+    order_.pop_front();
+  }
+}
+
+boost::optional<TransactionStatusResult> FinalTransactionStatusCache::Get(
+    const TransactionId& id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = statuses_.find(id);
+  if (it == statuses_.end()) {
+    return boost::none;
+  }
+  return it->second;
+}
+
+} // namespace tablet
+} // namespace yb
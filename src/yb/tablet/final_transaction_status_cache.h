@@ -0,0 +1,57 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_FINAL_TRANSACTION_STATUS_CACHE_H
+#define YB_TABLET_FINAL_TRANSACTION_STATUS_CACHE_H
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+#include <boost/optional.hpp>
+
+#include "yb/common/transaction.h"
+
+namespace yb {
+namespace tablet {
+
+// Final statuses of recently finished transactions, i.e. COMMITTED with commit hybrid time or
+// ABORTED, shared by transaction participants of all tablets of the tablet server.
+//
+// Final status never changes, so when several tablets of the same server have intents of the same
+// transaction, only the first of them has to ask the status tablet about it.
+class FinalTransactionStatusCache {
+ public:
+  explicit FinalTransactionStatusCache(size_t capacity);
+
+  FinalTransactionStatusCache(const FinalTransactionStatusCache&) = delete;
+  void operator=(const FinalTransactionStatusCache&) = delete;
+
+  // Remembers final status of transaction, other statuses are ignored.
+  void Add(const TransactionId& id, const TransactionStatusResult& result);
+
+  boost::optional<TransactionStatusResult> Get(const TransactionId& id);
+
+ private:
+  const size_t capacity_;
+
+  std::mutex mutex_;
+  std::unordered_map<TransactionId, TransactionStatusResult, TransactionIdHash> statuses_;
+  // Transactions in order of addition, used to evict oldest ones when capacity is exceeded.
+  std::deque<TransactionId> order_;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_FINAL_TRANSACTION_STATUS_CACHE_H
@@ -0,0 +1,69 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/hot_keys_sampler.h"
+
+#include "yb/docdb/doc_key.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace tablet {
+
+class HotKeysSamplerTest : public YBTest {
+ protected:
+  static std::string HashKey(uint16_t hash, int64_t value) {
+    return docdb::DocKey(hash, { docdb::PrimitiveValue(value) }).Encode().data();
+  }
+};
+
+TEST_F(HotKeysSamplerTest, TopKeys) {
+  HotKeysSampler sampler(4, 16);
+  // Key 1 is hot, other keys are accessed once each and compete for the remaining slots.
+  for (int i = 0; i < 100; ++i) {
+    sampler.Add(HashKey(0x1000, 1));
+    sampler.Add(HashKey(0x8000, 1000 + i));
+  }
+
+  ASSERT_EQ(200, sampler.total());
+  auto top = sampler.TopKeys(2);
+  ASSERT_EQ(2, top.size());
+  ASSERT_EQ(HashKey(0x1000, 1), top[0].key);
+  ASSERT_EQ(100, top[0].count);
+  ASSERT_EQ(0, top[0].error);
+  // Other keys could be overestimated, but never above the hot key.
+  ASSERT_LE(top[1].count, top[0].count);
+  ASSERT_EQ(4, sampler.TopKeys(10).size());
+}
+
+TEST_F(HotKeysSamplerTest, HashBuckets) {
+  HotKeysSampler sampler(4, 16);
+  sampler.Add(HashKey(0x0000, 1));
+  sampler.Add(HashKey(0x0FFF, 2));
+  sampler.Add(HashKey(0x1000, 3));
+  sampler.Add(HashKey(0xFFFF, 4));
+  // Keys without hash are not accounted in buckets.
+  sampler.Add(docdb::DocKey({ docdb::PrimitiveValue(5L) }).Encode().data());
+
+  auto buckets = sampler.HashBucketCounts();
+  ASSERT_EQ(16, buckets.size());
+  ASSERT_EQ(2, buckets[0]);
+  ASSERT_EQ(1, buckets[1]);
+  ASSERT_EQ(1, buckets[15]);
+  ASSERT_EQ(0x1000, sampler.HashBucketStart(1));
+  ASSERT_EQ(5, sampler.total());
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,102 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/hot_keys_sampler.h"
+
+#include <algorithm>
+
+#include "yb/docdb/doc_key.h"
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+constexpr uint32_t kHashSpaceSize = 0x10000;
+
+// Returns true and sets hash if the encoded doc key starts with a hash code.
+bool DecodeHash(const Slice& key, uint16_t* hash) {
+  docdb::DocKeyDecoder decoder(key);
+  if (!decoder.DecodeCotableId().ok() || !decoder.DecodePgtableId().ok()) {
+    return false;
+  }
+  auto result = decoder.DecodeHashCode(hash);
+  return result.ok() && *result;
+}
+
+} // namespace
+
+HotKeysSampler::HotKeysSampler(size_t capacity, size_t num_hash_buckets)
+    : capacity_(std::max<size_t>(capacity, 1)),
+      hash_bucket_size_(std::max<uint32_t>(
+          kHashSpaceSize / std::max<size_t>(num_hash_buckets, 1), 1)),
+      hash_buckets_((kHashSpaceSize + hash_bucket_size_ - 1) / hash_bucket_size_) {
+}
+
+void HotKeysSampler::Add(const Slice& key) {
+  uint16_t hash = 0;
+  const bool has_hash = DecodeHash(key, &hash);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++total_;
+  if (has_hash) {
+    ++hash_buckets_[hash / hash_bucket_size_];
+  }
+
+  auto& by_key = keys_.get<KeyTag>();
+  auto it = by_key.find(key.ToBuffer());
+  if (it != by_key.end()) {
+    by_key.modify(it, [](KeyCount& entry) { ++entry.count; });
+    return;
+  }
+  if (keys_.size() < capacity_) {
+    keys_.insert(KeyCount { key.ToBuffer(), 1, 0 });
+    return;
+  }
+  // Replace the key with the minimal count, the new key could have been accessed that many times
+  // while it was not tracked.
+  auto& by_count = keys_.get<CountTag>();
+  auto min_it = by_count.begin();
+  by_count.modify(min_it, [&key](KeyCount& entry) {
+    entry.key = key.ToBuffer();
+    entry.error = entry.count;
+    ++entry.count;
+  });
+}
+
+std::vector<HotKeysSampler::KeyCount> HotKeysSampler::TopKeys(size_t limit) const {
+  std::vector<KeyCount> result;
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto& by_count = keys_.get<CountTag>();
+  for (auto it = by_count.rbegin(); it != by_count.rend() && result.size() < limit; ++it) {
+    result.push_back(*it);
+  }
+  return result;
+}
+
+std::vector<uint64_t> HotKeysSampler::HashBucketCounts() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hash_buckets_;
+}
+
+uint32_t HotKeysSampler::HashBucketStart(size_t index) const {
+  return index * hash_bucket_size_;
+}
+
+uint64_t HotKeysSampler::total() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return total_;
+}
+
+} // namespace tablet
+} // namespace yb
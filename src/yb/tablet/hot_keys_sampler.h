@@ -0,0 +1,98 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_HOT_KEYS_SAMPLER_H
+#define YB_TABLET_HOT_KEYS_SAMPLER_H
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+
+#include "yb/util/slice.h"
+
+namespace yb {
+namespace tablet {
+
+// Space bounded sample of the most frequently accessed keys of a tablet.
+//
+// Uses the SpaceSaving algorithm: at most capacity keys are tracked, when a new key is added and
+// all slots are taken, the key with the minimal count is replaced by the new key, that inherits
+// this count as its error. So the count of a tracked key is an upper bound of its real count, and
+// count - error is a lower bound. Every key added more than total / capacity times is tracked.
+//
+// Keys that start with a hash code, i.e. keys of hash partitioned tables, are also accounted in
+// buckets of the hash space, to show the skew across hash ranges.
+class HotKeysSampler {
+ public:
+  struct KeyCount {
+    std::string key;
+    uint64_t count;
+    uint64_t error;
+  };
+
+  HotKeysSampler(size_t capacity, size_t num_hash_buckets);
+
+  HotKeysSampler(const HotKeysSampler&) = delete;
+  void operator=(const HotKeysSampler&) = delete;
+
+  // Accounts an access to the encoded doc key.
+  void Add(const Slice& key);
+
+  // Returns up to limit tracked keys with the highest counts, in descending order of counts.
+  std::vector<KeyCount> TopKeys(size_t limit) const;
+
+  // Returns the number of sampled keys that fell into each bucket of the hash space.
+  std::vector<uint64_t> HashBucketCounts() const;
+
+  // Returns the first hash code of the bucket with the specified index.
+  uint32_t HashBucketStart(size_t index) const;
+
+  // Returns the total number of added keys.
+  uint64_t total() const;
+
+ private:
+  class KeyTag;
+  class CountTag;
+
+  typedef boost::multi_index_container<
+      KeyCount,
+      boost::multi_index::indexed_by<
+          boost::multi_index::hashed_unique<
+              boost::multi_index::tag<KeyTag>,
+              boost::multi_index::member<KeyCount, std::string, &KeyCount::key>
+          >,
+          boost::multi_index::ordered_non_unique<
+              boost::multi_index::tag<CountTag>,
+              boost::multi_index::member<KeyCount, uint64_t, &KeyCount::count>
+          >
+      >
+  > KeyCounts;
+
+  const size_t capacity_;
+  const uint32_t hash_bucket_size_;
+
+  mutable std::mutex mutex_;
+  KeyCounts keys_;
+  std::vector<uint64_t> hash_buckets_;
+  uint64_t total_ = 0;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_HOT_KEYS_SAMPLER_H
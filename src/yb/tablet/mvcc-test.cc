@@ -86,6 +86,26 @@ TEST_F(MvccTest, Basic) {
   }
 }
 
+TEST_F(MvccTest, PendingOperationsFromOtherPeer) {
+  ASSERT_FALSE(manager_.HasPendingOperationsFromOtherPeer());
+
+  // Operations of the leader itself get hybrid time assigned by AddPending.
+  HybridTime leader_ht;
+  manager_.AddPending(&leader_ht);
+  ASSERT_FALSE(manager_.HasPendingOperationsFromOtherPeer());
+  manager_.Replicated(leader_ht);
+
+  HybridTime replica_ht1 = clock_->Now();
+  HybridTime replica_ht2 = clock_->Now();
+  manager_.AddPending(&replica_ht1);
+  manager_.AddPending(&replica_ht2);
+  ASSERT_TRUE(manager_.HasPendingOperationsFromOtherPeer());
+  manager_.Replicated(replica_ht1);
+  ASSERT_TRUE(manager_.HasPendingOperationsFromOtherPeer());
+  manager_.Replicated(replica_ht2);
+  ASSERT_FALSE(manager_.HasPendingOperationsFromOtherPeer());
+}
+
 TEST_F(MvccTest, SafeHybridTimeToReadAt) {
   constexpr uint64_t kLease = 10;
   constexpr uint64_t kDelta = 10;
@@ -334,5 +354,33 @@ TEST_F(MvccTest, WaitForSafeTime) {
   ASSERT_FALSE(manager_.SafeTime(ht3, CoarseMonoClock::now() + 100ms, FixedHybridTimeLease()));
 }
 
+// Safe time that was already returned should be used, without locking, for requests that it
+// satisfies.
+TEST_F(MvccTest, PublishedSafeTime) {
+  HybridTime ht1;
+  manager_.AddPending(&ht1);
+  manager_.Replicated(ht1);
+  ASSERT_EQ(ht1, manager_.LastReplicatedHybridTime());
+
+  auto safe_time = manager_.SafeTime(FixedHybridTimeLease());
+  ASSERT_GE(safe_time, ht1);
+
+  clock_->Update(AddLogical(safe_time, 10));
+  HybridTime ht2;
+  manager_.AddPending(&ht2);
+  ASSERT_GT(ht2.Decremented(), safe_time);
+
+  // Published safe time satisfies min_allowed, so it is returned as is.
+  ASSERT_EQ(safe_time, manager_.SafeTime(
+      safe_time, CoarseTimePoint::max(), FixedHybridTimeLease()));
+  // Most recent safe time is returned when min_allowed is not specified or is not satisfied.
+  ASSERT_EQ(ht2.Decremented(), manager_.SafeTime(FixedHybridTimeLease()));
+  ASSERT_EQ(ht2.Decremented(), manager_.SafeTime(
+      ht2.Decremented(), CoarseTimePoint::max(), FixedHybridTimeLease()));
+
+  manager_.Replicated(ht2);
+  ASSERT_EQ(ht2, manager_.LastReplicatedHybridTime());
+}
+
 } // namespace tablet
 } // namespace yb
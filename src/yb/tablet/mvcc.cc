@@ -64,6 +64,7 @@ void MvccManager::Replicated(HybridTime ht) {
     CHECK_EQ(queue_.front(), ht) << LogPrefix();
     PopFront(&lock);
     last_replicated_ = ht;
+    published_last_replicated_.store(ht, std::memory_order_release);
   }
   cond_.notify_all();
 }
@@ -103,6 +104,9 @@ void MvccManager::AddPending(HybridTime* ht) {
   if (is_follower_side) {
     // This must be a follower-side transaction with already known hybrid time.
     VLOG_WITH_PREFIX(1) << "AddPending(" << *ht << ")";
+    if (*ht > max_preassigned_ht_.load(std::memory_order_relaxed)) {
+      max_preassigned_ht_.store(*ht, std::memory_order_release);
+    }
   } else {
     // Otherwise this is a new transaction and we must assign a new hybrid_time. We assign one in
     // the present.
@@ -199,6 +203,7 @@ void MvccManager::SetLastReplicated(HybridTime ht) {
   {
     std::lock_guard<std::mutex> lock(mutex_);
     last_replicated_ = ht;
+    published_last_replicated_.store(ht, std::memory_order_release);
   }
   cond_.notify_all();
 }
@@ -251,10 +256,29 @@ void MvccManager::UpdatePropagatedSafeTimeOnLeader(const FixedHybridTimeLease& h
 void MvccManager::SetLeaderOnlyMode(bool leader_only) {
   std::unique_lock<std::mutex> lock(mutex_);
   leader_only_mode_ = leader_only;
+  published_leader_only_mode_.store(leader_only, std::memory_order_release);
+}
+
+HybridTime MvccManager::PublishedSafeTime(
+    HybridTime min_allowed, const std::atomic<HybridTime>& published) {
+  if (min_allowed == HybridTime::kMin) {
+    // Caller is going to read at the returned time, so it should get the most recent safe time.
+    return HybridTime::kInvalid;
+  }
+  auto result = published.load(std::memory_order_acquire);
+  return result >= min_allowed ? result : HybridTime::kInvalid;
 }
 
 HybridTime MvccManager::SafeTimeForFollower(
     HybridTime min_allowed, CoarseTimePoint deadline) const {
+  auto published = PublishedSafeTime(
+      min_allowed,
+      published_leader_only_mode_.load(std::memory_order_acquire)
+          ? published_safe_time_without_lease_ : published_safe_time_for_follower_);
+  if (published.is_valid()) {
+    return published;
+  }
+
   std::unique_lock<std::mutex> lock(mutex_);
 
   if (leader_only_mode_) {
@@ -293,12 +317,20 @@ HybridTime MvccManager::SafeTimeForFollower(
       << ", max_safe_time_returned_for_follower_: "
       << max_safe_time_returned_for_follower_.ToString();
   max_safe_time_returned_for_follower_ = result;
+  published_safe_time_for_follower_.store(result.safe_time, std::memory_order_release);
   return result.safe_time;
 }
 
 HybridTime MvccManager::SafeTime(HybridTime min_allowed,
                                  CoarseTimePoint deadline,
                                  const FixedHybridTimeLease& ht_lease) const {
+  auto published = PublishedSafeTime(
+      min_allowed,
+      ht_lease.empty() ? published_safe_time_without_lease_ : published_safe_time_with_lease_);
+  if (published.is_valid()) {
+    return published;
+  }
+
   std::unique_lock<std::mutex> lock(mutex_);
   return DoGetSafeTime(min_allowed, deadline, ht_lease, &lock);
 }
@@ -368,16 +400,39 @@ HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
 
   if (has_lease) {
     max_safe_time_returned_with_lease_ = { result, source };
+    published_safe_time_with_lease_.store(result, std::memory_order_release);
   } else {
     max_safe_time_returned_without_lease_ = { result, source };
+    published_safe_time_without_lease_.store(result, std::memory_order_release);
   }
   return result;
 }
 
 HybridTime MvccManager::LastReplicatedHybridTime() const {
-  std::lock_guard<std::mutex> lock(mutex_);
-  VLOG_WITH_PREFIX(1) << __func__ << "(), result = " << last_replicated_;
-  return last_replicated_;
+  auto result = published_last_replicated_.load(std::memory_order_acquire);
+  VLOG_WITH_PREFIX(1) << __func__ << "(), result = " << result;
+  return result;
+}
+
+bool MvccManager::HasPendingOperationsFromOtherPeer() const {
+  return max_preassigned_ht_.load(std::memory_order_acquire) >
+         published_last_replicated_.load(std::memory_order_acquire);
+}
+
+// Sequentially consistent operations are used, so the registration of an operation, that is
+// followed by reading the clock for its hybrid time, is ordered with a point read, that updates
+// the clock past its read time and then checks for pending operations.
+void MvccManager::AddPendingWithoutLocks() {
+  num_pending_without_locks_.fetch_add(1);
+}
+
+void MvccManager::PendingWithoutLocksFinished() {
+  auto num_pending = num_pending_without_locks_.fetch_sub(1);
+  DCHECK_GT(num_pending, 0);
+}
+
+bool MvccManager::HasPendingOperationsWithoutLocks() const {
+  return num_pending_without_locks_.load() != 0;
 }
 
 }  // namespace tablet
@@ -32,6 +32,7 @@
 #ifndef YB_TABLET_MVCC_H_
 #define YB_TABLET_MVCC_H_
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <deque>
@@ -134,6 +135,10 @@ class MvccManager {
   //
   // Returns invalid hybrid time in case it cannot satisfy provided requirements, for instance
   // because of timeout.
+  //
+  // When `min_allowed` is specified and safe time that was already returned satisfies it, that
+  // safe time is returned without locking. So the result could be less than the most recent safe
+  // time, but it is never less than `min_allowed`.
   HybridTime SafeTime(
       HybridTime min_allowed, CoarseTimePoint deadline, const FixedHybridTimeLease& ht_lease) const;
 
@@ -147,6 +152,21 @@ class MvccManager {
   // Returns time of last replicated operation.
   HybridTime LastReplicatedHybridTime() const;
 
+  // Returns true when operations with hybrid time assigned by another peer, i.e. received from a
+  // leader or replayed during bootstrap, are not replicated yet. Such operations don't hold DocDB
+  // locks on this peer.
+  bool HasPendingOperationsFromOtherPeer() const;
+
+  // Tracks operations that change tablet data without holding DocDB locks, i.e. all operations
+  // except writes, such as truncate, snapshot restore, metadata change or transaction apply.
+  // AddPendingWithoutLocks should be called before the hybrid time of the operation is assigned,
+  // and PendingWithoutLocksFinished after its changes became visible or it was aborted.
+  void AddPendingWithoutLocks();
+  void PendingWithoutLocksFinished();
+
+  // Returns true while any operation registered with AddPendingWithoutLocks is pending.
+  bool HasPendingOperationsWithoutLocks() const;
+
  private:
   HybridTime DoGetSafeTime(HybridTime min_allowed,
                            CoarseTimePoint deadline,
@@ -156,6 +176,10 @@ class MvccManager {
   const std::string& LogPrefix() const { return prefix_; }
   void PopFront(std::lock_guard<std::mutex>* lock);
 
+  // Returns published safe time if it satisfies min_allowed, otherwise returns invalid hybrid time.
+  static HybridTime PublishedSafeTime(
+      HybridTime min_allowed, const std::atomic<HybridTime>& published);
+
   std::string prefix_;
   server::ClockPtr clock_;
   mutable std::mutex mutex_;
@@ -185,6 +209,18 @@ class MvccManager {
   mutable SafeTimeWithSource max_safe_time_returned_with_lease_;
   mutable SafeTimeWithSource max_safe_time_returned_without_lease_;
   mutable SafeTimeWithSource max_safe_time_returned_for_follower_ { HybridTime::kMin };
+
+  // Copies of the above safe times and last_replicated_, published for lock-free readers.
+  // Safe time that was returned once stays safe, since AddPending never assigns lower times.
+  mutable std::atomic<HybridTime> published_safe_time_with_lease_{HybridTime::kMin};
+  mutable std::atomic<HybridTime> published_safe_time_without_lease_{HybridTime::kMin};
+  mutable std::atomic<HybridTime> published_safe_time_for_follower_{HybridTime::kMin};
+  std::atomic<HybridTime> published_last_replicated_{HybridTime::kMin};
+  // Max hybrid time of operations added with already assigned hybrid time.
+  std::atomic<HybridTime> max_preassigned_ht_{HybridTime::kMin};
+  // Number of pending operations registered with AddPendingWithoutLocks.
+  std::atomic<int64_t> num_pending_without_locks_{0};
+  std::atomic<bool> published_leader_only_mode_{false};
 };
 
 }  // namespace tablet
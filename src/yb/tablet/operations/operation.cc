@@ -48,6 +48,24 @@ Operation::Operation(std::unique_ptr<OperationState> state,
                      OperationType operation_type)
     : state_(std::move(state)),
       operation_type_(operation_type) {
+  // Only writes lock their keys, so point reads have to wait for the safe time while any other
+  // operation is pending, see Tablet::SafeTimeForPointRead.
+  auto* tablet = state_->tablet();
+  if (operation_type_ != OperationType::kWrite && tablet) {
+    mvcc_without_locks_ = tablet->mvcc_manager();
+    mvcc_without_locks_->AddPendingWithoutLocks();
+  }
+}
+
+Operation::~Operation() {
+  FinishPendingWithoutLocks();
+}
+
+void Operation::FinishPendingWithoutLocks() {
+  if (mvcc_without_locks_) {
+    mvcc_without_locks_->PendingWithoutLocksFinished();
+    mvcc_without_locks_ = nullptr;
+  }
 }
 
 void Operation::Start() {
@@ -61,12 +79,24 @@ std::string Operation::LogPrefix() const {
 Status Operation::Replicated(int64_t leader_term) {
   Status complete_status = Status::OK();
   RETURN_NOT_OK(DoReplicated(leader_term, &complete_status));
-  state()->CompleteWithStatus(complete_status);
+  auto* tablet = state()->tablet();
+  if (tablet) {
+    // The client should be notified only after its changes were made visible.
+    tablet->RunAfterApplyBatch([this, complete_status] {
+      FinishPendingWithoutLocks();
+      state()->CompleteWithStatus(complete_status);
+    });
+  } else {
+    FinishPendingWithoutLocks();
+    state()->CompleteWithStatus(complete_status);
+  }
   return Status::OK();
 }
 
 void Operation::Aborted(const Status& status) {
-  state()->CompleteWithStatus(DoAborted(status));
+  auto complete_status = DoAborted(status);
+  FinishPendingWithoutLocks();
+  state()->CompleteWithStatus(complete_status);
 }
 
 void OperationState::CompleteWithStatus(const Status& status) const {
@@ -52,6 +52,7 @@ namespace yb {
 
 namespace tablet {
 
+class MvccManager;
 class Tablet;
 class OperationCompletionCallback;
 class OperationState;
@@ -109,9 +110,12 @@ class Operation {
 
   std::string LogPrefix() const;
 
-  virtual ~Operation() {}
+  virtual ~Operation();
 
  private:
+  // Unregisters the operation from MvccManager::AddPendingWithoutLocks, if it was registered.
+  void FinishPendingWithoutLocks();
+
   // Actual implementation of Replicated.
   // complete_status could be used to change completion status, i.e. callback will be invoked
   // with this status.
@@ -126,6 +130,9 @@ class Operation {
   // OperationState methods on destructors.
   std::unique_ptr<OperationState> state_;
   const OperationType operation_type_;
+
+  // Set while a non write operation is registered as pending without DocDB locks.
+  MvccManager* mvcc_without_locks_ = nullptr;
 };
 
 class OperationState {
@@ -163,6 +170,10 @@ class OperationState {
     completion_clbk_ = std::move(completion_clbk);
   }
 
+  std::unique_ptr<OperationCompletionCallback> release_completion_callback() {
+    return std::move(completion_clbk_);
+  }
+
   // Sets a heap object to be managed by this transaction's AutoReleasePool.
   template<class T>
   T* AddToAutoReleasePool(T* t) {
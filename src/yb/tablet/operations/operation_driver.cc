@@ -89,7 +89,7 @@ OperationDriver::OperationDriver(OperationTracker *operation_tracker,
       prepare_state_(NOT_PREPARED),
       table_type_(table_type) {
   if (Trace::CurrentTrace()) {
-    Trace::CurrentTrace()->AddChildTrace(trace_.get());
+    Trace::CurrentTrace()->AddChildTrace(trace_.get(), "Operation");
   }
   DCHECK(op_id_copy_.is_lock_free());
 }
@@ -188,6 +188,12 @@ void OperationDriver::HandleConsensusAppend() {
   replicate_msg->set_hybrid_time(operation_->state()->hybrid_time().ToUint64());
   replicate_msg->set_monotonic_counter(
       *operation_->state()->tablet()->monotonic_counter());
+  if (trace_->sampled()) {
+    // So updates sent to followers with this operation become child spans of the operation.
+    replicate_msg->set_trace_id(trace_->trace_id());
+    replicate_msg->set_trace_span_id(trace_->span_id());
+  }
+  TRACE("Appending to Raft log");
 }
 
 void OperationDriver::PrepareAndStartTask() {
@@ -332,6 +338,7 @@ void OperationDriver::HandleFailure(Status status) {
       VLOG_WITH_PREFIX(1) << "Operation " << ToString() << " failed prior to "
           "replication success: " << status;
       operation_->Aborted(status);
+      trace_->EndSpan();
       operation_tracker_->Release(this, nullptr /* applied_op_ids */);
       return;
     }
@@ -349,6 +356,7 @@ void OperationDriver::ReplicationFinished(
     const Status& status, int64_t leader_term, OpIds* applied_op_ids) {
   auto op_id_local = DCHECK_NOTNULL(mutable_state()->consensus_round())->id();
   DCHECK(!status.ok() || op_id_local.IsInitialized());
+  TRACE_TO(trace_, "Replication finished: $0", status.ToString());
   op_id_copy_.store(yb::OpId::FromPB(op_id_local), boost::memory_order_release);
 
   PrepareState prepare_state_copy;
@@ -438,10 +446,24 @@ void OperationDriver::ApplyTask(int64_t leader_term, OpIds* applied_op_ids) {
   // and end up calling Finalize() while we're still in this code.
   scoped_refptr<OperationDriver> ref(this);
 
+  auto* tablet = operation_->state()->tablet();
+  if (tablet) {
+    tablet->WaitForApplyBatch();
+  }
+
   {
     auto status = operation_->Replicated(leader_term);
     LOG_IF_WITH_PREFIX(FATAL, !status.ok()) << "Apply failed: " << status;
-    operation_tracker_->Release(this, applied_op_ids);
+    auto release = [this, ref, applied_op_ids] {
+      trace_->EndSpan();
+      operation_tracker_->Release(this, applied_op_ids);
+    };
+    if (tablet) {
+      // Operation is released only after it became visible, so the log could not be GCed earlier.
+      tablet->RunAfterApplyBatch(release);
+    } else {
+      release();
+    }
   }
 }
 
@@ -131,15 +131,18 @@ Status WriteOperation::DoReplicated(int64_t leader_term, Status* complete_status
   LOG_IF(INFO, !complete_status->ok()) << "Apply operation failed: " << *complete_status;
 
   // Now that all of the changes have been applied and the commit is durable
-  // make the changes visible to readers.
-  TRACE("FINISH: making edits visible");
-  state()->Commit();
-
-  TabletMetrics* metrics = tablet()->metrics();
-  if (metrics && state()->has_completion_callback()) {
-    auto op_duration_usec = MonoTime::Now().GetDeltaSince(start_time_).ToMicroseconds();
-    metrics->write_op_duration_client_propagated_consistency->Increment(op_duration_usec);
-  }
+  // make the changes visible to readers. When the operation is a part of an apply batch, it
+  // happens after the batch is written to RocksDB.
+  tablet()->RunAfterApplyBatch([this] {
+    TRACE("FINISH: making edits visible");
+    state()->Commit();
+
+    TabletMetrics* metrics = tablet()->metrics();
+    if (metrics && state()->has_completion_callback()) {
+      auto op_duration_usec = MonoTime::Now().GetDeltaSince(start_time_).ToMicroseconds();
+      metrics->write_op_duration_client_propagated_consistency->Increment(op_duration_usec);
+    }
+  });
 
   return Status::OK();
 }
@@ -259,6 +259,16 @@ class WriteOperation : public Operation {
     return deadline_;
   }
 
+  // Until this time the write waits for pending conflicting transactions, instead of aborting
+  // them.
+  CoarseTimePoint conflicts_wait_deadline() const {
+    return conflicts_wait_deadline_;
+  }
+
+  void set_conflicts_wait_deadline(CoarseTimePoint value) {
+    conflicts_wait_deadline_ = value;
+  }
+
   docdb::DocOperations& doc_ops() {
     return doc_ops_;
   }
@@ -307,6 +317,7 @@ class WriteOperation : public Operation {
   WriteOperationContext& context_;
   const int64_t term_;
   const CoarseTimePoint deadline_;
+  CoarseTimePoint conflicts_wait_deadline_;
 
   // this transaction's start time
   MonoTime start_time_;
@@ -13,37 +13,104 @@
 
 #include "yb/tablet/remove_intents_task.h"
 
+#include <algorithm>
+
+#include <gflags/gflags.h>
+
+#include "yb/tablet/running_transaction_context.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/monotime.h"
+
+DEFINE_int32(remove_intents_batch_max_transactions, 256,
+             "Max number of transactions, whose intents are removed using a single intents DB "
+             "write batch.");
+TAG_FLAG(remove_intents_batch_max_transactions, advanced);
+TAG_FLAG(remove_intents_batch_max_transactions, runtime);
+
+DEFINE_test_flag(int32, TEST_remove_intents_batch_delay_ms, 0,
+                 "Delay before removing each batch of intents.");
+
 namespace yb {
 namespace tablet {
 
 RemoveIntentsTask::RemoveIntentsTask(TransactionIntentApplier* applier,
                                      TransactionParticipantContext* participant_context,
-                                     RunningTransactionContext* running_transaction_context,
-                                     const TransactionId& id)
+                                     RunningTransactionContext* running_transaction_context)
     : applier_(*applier), participant_context_(*participant_context),
-      running_transaction_context_(*running_transaction_context), id_(id) {}
+      running_transaction_context_(*running_transaction_context) {}
 
-bool RemoveIntentsTask::Prepare(RunningTransactionPtr transaction) {
-  bool expected = false;
-  if (!used_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
-    return false;
+void RemoveIntentsTask::Add(const TransactionId& id) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (shutdown_) {
+      return;
+    }
+    queue_.insert(id);
+    if (scheduled_) {
+      return;
+    }
+    scheduled_ = true;
   }
+  participant_context_.Enqueue(this);
+}
 
-  transaction_ = std::move(transaction);
-  return true;
+void RemoveIntentsTask::Shutdown() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  shutdown_ = true;
+  cond_.wait(lock, [this] { return !scheduled_; });
 }
 
 void RemoveIntentsTask::Run() {
-  RemoveIntentsData data;
-  participant_context_.GetLastReplicatedData(&data);
-  auto status = applier_.RemoveIntents(data, id_);
-  LOG_IF_WITH_PREFIX(WARNING, !status.ok())
-      << "Failed to remove intents of aborted transaction " << id_ << ": " << status;
-  VLOG_WITH_PREFIX(2) << "Removed intents for: " << id_;
+  const size_t max_batch = std::max(FLAGS_remove_intents_batch_max_transactions, 1);
+  for (;;) {
+    if (FLAGS_TEST_remove_intents_batch_delay_ms > 0) {
+      SleepFor(MonoDelta::FromMilliseconds(FLAGS_TEST_remove_intents_batch_delay_ms));
+    }
+    TransactionIdSet batch;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (queue_.empty() || shutdown_) {
+        return;
+      }
+      if (queue_.size() <= max_batch) {
+        batch.swap(queue_);
+      } else {
+        auto it = queue_.begin();
+        while (batch.size() < max_batch) {
+          batch.insert(*it);
+          it = queue_.erase(it);
+        }
+      }
+    }
+
+    RemoveIntentsData data;
+    participant_context_.GetLastReplicatedData(&data);
+    auto status = applier_.RemoveIntents(data, batch);
+    LOG_IF_WITH_PREFIX(WARNING, !status.ok())
+        << "Failed to remove intents of " << batch.size() << " transactions: " << status;
+    VLOG_WITH_PREFIX(2) << "Removed intents for: " << yb::ToString(batch);
+  }
 }
 
 void RemoveIntentsTask::Done(const Status& status) {
-  transaction_.reset();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!status.ok()) {
+      // Thread pool is shutting down, intents of these transactions will be cleaned up after
+      // restart, when transactions are loaded.
+      VLOG_WITH_PREFIX(1) << "Dropped intents removal of " << queue_.size() << " transactions: "
+                          << status;
+      queue_.clear();
+    }
+    // Transactions could be added after the last batch was taken by Run.
+    if (queue_.empty() || shutdown_) {
+      scheduled_ = false;
+      cond_.notify_all();
+      return;
+    }
+  }
+  participant_context_.Enqueue(this);
 }
 
 const std::string& RemoveIntentsTask::LogPrefix() const {
@@ -14,22 +14,35 @@
 #ifndef YB_TABLET_REMOVE_INTENTS_TASK_H
 #define YB_TABLET_REMOVE_INTENTS_TASK_H
 
+#include <condition_variable>
+#include <mutex>
+
 #include "yb/rpc/thread_pool.h"
 
-#include "yb/tablet/running_transaction_context.h"
+#include "yb/tablet/transaction_participant.h"
 
 namespace yb {
 namespace tablet {
 
-// Used by RunningTransaction to remove its intents.
+class RunningTransactionContext;
+
+// Used by transaction participant to remove intents of transactions that are not running anymore.
+//
+// Transactions added while a batch is being removed are collected into the next batch, and the
+// whole batch is removed using a single intents DB write. So under high transaction churn the
+// number of intents DB writes does not grow with the number of completed transactions.
 class RemoveIntentsTask : public rpc::ThreadPoolTask {
  public:
   RemoveIntentsTask(TransactionIntentApplier* applier,
                     TransactionParticipantContext* participant_context,
-                    RunningTransactionContext* running_transaction_context,
-                    const TransactionId& id);
+                    RunningTransactionContext* running_transaction_context);
+
+  // Adds transaction to the next batch, scheduling the task if it is not scheduled yet.
+  void Add(const TransactionId& id);
+
+  // Waits until the scheduled batch is removed, further transactions are ignored.
+  void Shutdown();
 
-  bool Prepare(RunningTransactionPtr transaction);
   void Run() override;
   void Done(const Status& status) override;
 
@@ -41,9 +54,12 @@ class RemoveIntentsTask : public rpc::ThreadPoolTask {
   TransactionIntentApplier& applier_;
   TransactionParticipantContext& participant_context_;
   RunningTransactionContext& running_transaction_context_;
-  TransactionId id_;
-  std::atomic<bool> used_{false};
-  RunningTransactionPtr transaction_;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  TransactionIdSet queue_;
+  bool scheduled_ = false;
+  bool shutdown_ = false;
 };
 
 } // namespace tablet
@@ -17,6 +17,8 @@
 
 #include "yb/common/pgsql_error.h"
 
+#include "yb/tablet/final_transaction_status_cache.h"
+
 #include "yb/util/flag_tags.h"
 #include "yb/util/yb_pg_errcodes.h"
 
@@ -36,8 +38,6 @@ RunningTransaction::RunningTransaction(TransactionMetadata metadata,
       last_batch_data_(last_batch_data),
       replicated_batches_(std::move(replicated_batches)),
       context_(*context),
-      remove_intents_task_(&context->applier_, &context->participant_context_, context,
-                           metadata_.transaction_id),
       get_status_handle_(context->rpcs_.InvalidHandle()),
       abort_handle_(context->rpcs_.InvalidHandle()) {
 }
@@ -61,6 +61,34 @@ void RunningTransaction::BatchReplicated(const TransactionalBatchData& value) {
 
 void RunningTransaction::SetLocalCommitTime(HybridTime time) {
   local_commit_time_ = time;
+  // APPLYING pushed by the coordinator is the earliest point when participant learns that
+  // transaction was committed, so share it with other participants of this server.
+  AddToFinalStatusCache(TransactionStatusResult(TransactionStatus::COMMITTED, time));
+}
+
+void RunningTransaction::AddToFinalStatusCache(const TransactionStatusResult& result) {
+  auto* cache = context_.participant_context_.final_status_cache();
+  if (cache) {
+    cache->Add(id(), result);
+  }
+}
+
+bool RunningTransaction::UseFinalStatusCacheUnlocked(MinRunningNotifier* min_running_notifier) {
+  auto* cache = context_.participant_context_.final_status_cache();
+  if (!cache || local_commit_time_.is_valid()) {
+    return false;
+  }
+  auto result = cache->Get(id());
+  if (!result) {
+    return false;
+  }
+  VLOG_WITH_PREFIX(4) << "Use cached final status: " << *result;
+  last_known_status_ = result->status;
+  last_known_status_hybrid_time_ = result->status_time;
+  if (result->status == TransactionStatus::ABORTED) {
+    context_.EnqueueRemoveUnlocked(id(), min_running_notifier);
+  }
+  return true;
 }
 
 void RunningTransaction::Aborted() {
@@ -85,6 +113,16 @@ void RunningTransaction::RequestStatusAt(const StatusRequest& request,
       return;
     }
   }
+  // Destroyed after the lock is released.
+  MinRunningNotifier min_running_notifier(&context_.applier_);
+  if (UseFinalStatusCacheUnlocked(&min_running_notifier)) {
+    auto transaction_status = GetStatusAt(
+        request.global_limit_ht, last_known_status_hybrid_time_, last_known_status_);
+    HybridTime last_known_status_hybrid_time = last_known_status_hybrid_time_;
+    lock->unlock();
+    request.callback(TransactionStatusResult{*transaction_status, last_known_status_hybrid_time});
+    return;
+  }
   bool was_empty = status_waiters_.empty();
   status_waiters_.push_back(request);
   if (!was_empty) {
@@ -153,11 +191,9 @@ std::string RunningTransaction::ToString() const {
                 TransactionStatus_Name(last_known_status_), last_known_status_hybrid_time_);
 }
 
-void RunningTransaction::ScheduleRemoveIntents(const RunningTransactionPtr& shared_self) {
-  if (remove_intents_task_.Prepare(shared_self)) {
-    context_.participant_context_.Enqueue(&remove_intents_task_);
-    VLOG_WITH_PREFIX(1) << "Intents should be removed asynchronously";
-  }
+void RunningTransaction::ScheduleRemoveIntents() {
+  context_.remove_intents_task_.Add(metadata_.transaction_id);
+  VLOG_WITH_PREFIX(1) << "Intents should be removed asynchronously";
 }
 
 boost::optional<TransactionStatus> RunningTransaction::GetStatusAt(
@@ -268,6 +304,7 @@ void RunningTransaction::DoStatusReceived(const Status& status,
 
     time_of_status = last_known_status_hybrid_time_;
     transaction_status = last_known_status_;
+    AddToFinalStatusCache(TransactionStatusResult(transaction_status, time_of_status));
 
     status_waiters = ExtractFinishedStatusWaitersUnlocked(
         serial_no, time_of_status, transaction_status);
@@ -367,6 +404,7 @@ void RunningTransaction::AbortReceived(const Status& status,
     if (result.ok() && result->status_time != HybridTime::kMax) {
       last_known_status_ = result->status;
       last_known_status_hybrid_time_ = result->status_time;
+      AddToFinalStatusCache(*result);
     }
   }
   for (const auto& waiter : abort_waiters) {
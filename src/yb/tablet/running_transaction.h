@@ -16,7 +16,7 @@
 
 #include <memory>
 
-#include "yb/tablet/remove_intents_task.h"
+#include "yb/tablet/running_transaction_context.h"
 #include "yb/tablet/transaction_participant.h"
 
 #include "yb/tserver/tserver_service.pb.h"
@@ -79,7 +79,7 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
              std::unique_lock<std::mutex>* lock);
 
   std::string ToString() const;
-  void ScheduleRemoveIntents(const RunningTransactionPtr& shared_self);
+  void ScheduleRemoveIntents();
 
  private:
   static boost::optional<TransactionStatus> GetStatusAt(
@@ -89,6 +89,12 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
 
   void SendStatusRequest(int64_t serial_no, const RunningTransactionPtr& shared_self);
 
+  void AddToFinalStatusCache(const TransactionStatusResult& result);
+
+  // Updates last known status from the final status cache of the server.
+  // Returns true if cache contains status of this transaction.
+  bool UseFinalStatusCacheUnlocked(MinRunningNotifier* min_running_notifier);
+
   void StatusReceived(const Status& status,
                       const tserver::GetTransactionStatusResponsePB& response,
                       int64_t serial_no,
@@ -123,7 +129,6 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
   TransactionalBatchData last_batch_data_;
   OneWayBitmap replicated_batches_;
   RunningTransactionContext& context_;
-  RemoveIntentsTask remove_intents_task_;
   HybridTime local_commit_time_ = HybridTime::kInvalid;
 
   TransactionStatus last_known_status_ = TransactionStatus::CREATED;
@@ -16,6 +16,7 @@
 
 #include "yb/rpc/rpc.h"
 
+#include "yb/tablet/remove_intents_task.h"
 #include "yb/tablet/transaction_participant.h"
 
 #include "yb/util/delayer.h"
@@ -49,7 +50,8 @@ class RunningTransactionContext {
  public:
   RunningTransactionContext(TransactionParticipantContext* participant_context,
                             TransactionIntentApplier* applier)
-      : participant_context_(*participant_context), applier_(*applier) {
+      : participant_context_(*participant_context), applier_(*applier),
+        remove_intents_task_(applier, participant_context, this) {
   }
 
   virtual ~RunningTransactionContext() {}
@@ -77,6 +79,8 @@ class RunningTransactionContext {
   rpc::Rpcs rpcs_;
   TransactionParticipantContext& participant_context_;
   TransactionIntentApplier& applier_;
+  // Removes intents of transactions that were removed from the participant, in batches.
+  RemoveIntentsTask remove_intents_task_;
   int64_t request_serial_ = 0;
   std::mutex mutex_;
 
@@ -13,6 +13,8 @@
 //
 //
 
+#include <algorithm>
+
 #include <boost/algorithm/string/join.hpp>
 
 #include "yb/common/ql_protocol_util.h"
@@ -183,6 +185,114 @@ TEST_F(TabletSplitTest,  v) {
   ASSERT_TRUE(source_docdb_dump.empty()) << boost::algorithm::join(source_docdb_dump, "\n");
 }
 
+TEST_F(TabletSplitTest, MiddleSplitKey) {
+  constexpr auto kNumRows = 10000;
+  constexpr auto kValuePrefixLength = 1024;
+
+  // There are no SST files yet.
+  ASSERT_NOK(tablet()->GetEncodedMiddleSplitKey());
+
+  const auto value_format = RandomHumanReadableString(kValuePrefixLength) + "_$0";
+  std::vector<docdb::DocKeyHash> hash_codes;
+  {
+    LocalTabletWriter::Batch batch;
+    for (auto i = 1; i <= kNumRows; ++i) {
+      hash_codes.push_back(InsertRow(i, Format(value_format, i), &batch));
+    }
+    ASSERT_OK(writer_->WriteBatch(&batch));
+  }
+  ASSERT_OK(tablet()->Flush(FlushMode::kSync));
+  tablet()->ForceRocksDBCompactInTest();
+
+  const auto split_key = ASSERT_RESULT(tablet()->GetEncodedMiddleSplitKey());
+  const auto split_hash_code = PartitionSchema::DecodeMultiColumnHashValue(split_key);
+  LOG(INFO) << "Split hash code: " << split_hash_code;
+
+  const auto rows_before_split = std::count_if(
+      hash_codes.begin(), hash_codes.end(),
+      [split_hash_code](docdb::DocKeyHash hash_code) { return hash_code < split_hash_code; });
+  // All rows have about the same size, so the split key should divide them into two halves.
+  ASSERT_GT(rows_before_split, kNumRows * 45 / 100);
+  ASSERT_LT(rows_before_split, kNumRows * 55 / 100);
+}
+
+// Child tablets share the SST files of the parent until they are compacted. Checks that files
+// that straddle the split key are still read by the child, and that out of bounds files are
+// reported to the post split compaction until the child is compacted.
+TEST_F(TabletSplitTest, CompactOutOfBoundsData) {
+  constexpr auto kNumRows = 2000;
+  constexpr auto kNumFiles = 4;
+
+  // Rows are written in the order of their hash codes, so the key ranges of the files do not
+  // overlap.
+  std::vector<std::pair<docdb::DocKeyHash, int>> rows;
+  {
+    // Batch is used only to calculate hash codes of the rows.
+    LocalTabletWriter::Batch batch;
+    for (auto i = 1; i <= kNumRows; ++i) {
+      rows.emplace_back(InsertRow(i, Format("value_$0", i), &batch), i);
+    }
+  }
+  std::sort(rows.begin(), rows.end());
+  for (auto file = 0; file != kNumFiles; ++file) {
+    LocalTabletWriter::Batch batch;
+    for (auto i = file * kNumRows / kNumFiles; i != (file + 1) * kNumRows / kNumFiles; ++i) {
+      InsertRow(rows[i].second, Format("value_$0", rows[i].second), &batch);
+    }
+    ASSERT_OK(writer_->WriteBatch(&batch));
+    ASSERT_OK(tablet()->Flush(FlushMode::kSync));
+  }
+  ASSERT_EQ(0, tablet()->OutOfBoundsSstFilesSize());
+
+  // Split key is in the middle of the second file, so it straddles the boundary between children,
+  // while the third and the fourth files are fully out of bounds of the first child.
+  const auto split_hash_code = rows[kNumRows * 3 / 2 / kNumFiles].first;
+  const auto rows_before_split = std::count_if(
+      rows.begin(), rows.end(),
+      [split_hash_code](const auto& row) { return row.first < split_hash_code; });
+  docdb::KeyBytes split_key;
+  docdb::DocKeyEncoderAfterTableIdStep(&split_key).Hash(
+      split_hash_code, std::vector<docdb::PrimitiveValue>());
+  const auto split_partition_key = PartitionSchema::EncodeMultiColumnHashValue(split_hash_code);
+
+  Partition partition = tablet()->metadata()->partition();
+  std::vector<std::pair<std::string, size_t>> children;
+  {
+    const auto subtablet_id = tablet()->tablet_id() + "-sub-1";
+    partition.TEST_set_partition_key_end(split_partition_key);
+    ASSERT_OK(tablet()->CreateSubtablet(
+        subtablet_id, partition, docdb::KeyBounds(Slice(), split_key.AsSlice())));
+    children.emplace_back(subtablet_id, rows_before_split);
+  }
+  {
+    const auto subtablet_id = tablet()->tablet_id() + "-sub-2";
+    partition.TEST_set_partition_key_start(split_partition_key);
+    partition.TEST_set_partition_key_end("");
+    ASSERT_OK(tablet()->CreateSubtablet(
+        subtablet_id, partition, docdb::KeyBounds(split_key.AsSlice(), Slice())));
+    children.emplace_back(subtablet_id, kNumRows - rows_before_split);
+  }
+
+  for (const auto& child : children) {
+    SCOPED_TRACE(child.first);
+    auto split_tablet = ASSERT_RESULT(harness_->OpenTablet(child.first));
+    ASSERT_EQ(ASSERT_RESULT(SelectAll(split_tablet.get())).size(), child.second);
+    ASSERT_GT(split_tablet->OutOfBoundsSstFilesSize(), 0);
+
+    ASSERT_OK(split_tablet->CompactOutOfBoundsData());
+    // PostSplitCompactionOp is not runnable anymore, since it reports this size.
+    ASSERT_EQ(0, split_tablet->OutOfBoundsSstFilesSize());
+    ASSERT_EQ(ASSERT_RESULT(SelectAll(split_tablet.get())).size(), child.second);
+
+    // Size is recalculated from the SST files after restart.
+    split_tablet->StartShutdown();
+    split_tablet->CompleteShutdown();
+    split_tablet = ASSERT_RESULT(harness_->OpenTablet(child.first));
+    ASSERT_EQ(0, split_tablet->OutOfBoundsSstFilesSize());
+    ASSERT_EQ(ASSERT_RESULT(SelectAll(split_tablet.get())).size(), child.second);
+  }
+}
+
 // TODO: Need to test with distributed transactions both pending and committed
 // (but not yet applied) during split.
 // Split tablets should not return unexpected data for not yet applied, but committed transactions
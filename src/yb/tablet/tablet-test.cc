@@ -32,6 +32,8 @@
 
 #include <time.h>
 
+#include <thread>
+
 #include <glog/logging.h>
 
 #include "yb/client/table.h"
@@ -44,6 +46,8 @@
 #include "yb/tablet/local_tablet_writer.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet-test-base.h"
+#include "yb/tablet/tablet_metrics.h"
+#include "yb/util/metrics.h"
 #include "yb/util/slice.h"
 #include "yb/util/test_macros.h"
 
@@ -214,5 +218,121 @@ TYPED_TEST(TestTablet, TestFlushedOpId) {
   ASSERT_EQ(id.index, start_index + 2*kCount);
 }
 
+TYPED_TEST(TestTablet, TestApplyBatch) {
+  auto tablet = this->tablet().get();
+  LocalTabletWriter writer(tablet);
+  const int kCount = 100;
+
+  ASSERT_OK(this->InsertTestRow(&writer, kCount, 111));
+  ASSERT_OK(tablet->Flush(FlushMode::kSync));
+  const int64_t start_index = ASSERT_RESULT(tablet->MaxPersistentOpId()).regular.index;
+
+  std::vector<int> deferred;
+  tablet->StartApplyBatch();
+  ASSERT_TRUE(tablet->InApplyBatch());
+  for (int i = 0; i != kCount; ++i) {
+    ASSERT_OK(this->InsertTestRow(&writer, i, 222));
+    tablet->RunAfterApplyBatch([&deferred, i] { deferred.push_back(i); });
+  }
+  ASSERT_TRUE(deferred.empty());
+
+  // Apply from other thread should wait until the batch is finished.
+  std::atomic<bool> waited{false};
+  std::thread waiter([tablet, &waited] {
+    tablet->WaitForApplyBatch();
+    waited.store(true);
+  });
+  SleepFor(MonoDelta::FromMilliseconds(100));
+  const bool waited_before_finish = waited.load();
+  tablet->FinishApplyBatch();
+  waiter.join();
+
+  ASSERT_FALSE(waited_before_finish);
+  ASSERT_TRUE(waited.load());
+  ASSERT_FALSE(tablet->InApplyBatch());
+  ASSERT_EQ(kCount, deferred.size());
+  for (int i = 0; i != kCount; ++i) {
+    ASSERT_EQ(i, deferred[i]);
+  }
+
+  this->VerifyTestRows(0, kCount + 1);
+
+  // Frontiers of all batched operations are merged.
+  ASSERT_OK(tablet->Flush(FlushMode::kSync));
+  ASSERT_EQ(start_index + kCount, ASSERT_RESULT(tablet->MaxPersistentOpId()).regular.index);
+}
+
+TYPED_TEST(TestTablet, TestHibernate) {
+  auto tablet = this->tablet().get();
+  LocalTabletWriter writer(tablet);
+  const int kCount = 100;
+
+  this->InsertTestRows(0, kCount, 111);
+  ASSERT_OK(tablet->Hibernate());
+  ASSERT_TRUE(tablet->IsHibernated());
+  ASSERT_EQ(nullptr, tablet->TEST_db());
+  ASSERT_EQ(HybridTime::kMax, ASSERT_RESULT(tablet->OldestMutableMemtableWriteHybridTime()));
+
+  // Read wakes the tablet up, and sees rows written before hibernation.
+  this->VerifyTestRows(0, kCount);
+  ASSERT_FALSE(tablet->IsHibernated());
+  ASSERT_NE(nullptr, tablet->TEST_db());
+
+  // So does write.
+  ASSERT_OK(tablet->Hibernate());
+  ASSERT_OK(this->InsertTestRow(&writer, kCount, 222));
+  ASSERT_FALSE(tablet->IsHibernated());
+  this->VerifyTestRows(0, kCount + 1);
+
+  ASSERT_EQ(2, tablet->metrics()->hibernations->value());
+  ASSERT_EQ(2U, tablet->metrics()->hibernation_wake_up_latency->TotalCount());
+}
+
+TYPED_TEST(TestTablet, TestMoveRocksDB) {
+  auto tablet = this->tablet().get();
+  auto* env = tablet->metadata()->fs_manager()->env();
+  LocalTabletWriter writer(tablet);
+  const int kCount = 100;
+
+  this->InsertTestRows(0, kCount, 111);
+  const auto old_root = tablet->metadata()->data_root_dir();
+  const auto old_dir = tablet->metadata()->rocksdb_dir();
+  const auto new_root = this->GetTestPath("moved_data");
+  ASSERT_OK(tablet->MoveRocksDB(new_root));
+  ASSERT_EQ(new_root, tablet->metadata()->data_root_dir());
+  ASSERT_EQ(tablet->metadata()->rocksdb_dir(), tablet->TEST_db()->GetName());
+  ASSERT_FALSE(env->FileExists(old_dir));
+
+  this->VerifyTestRows(0, kCount);
+  ASSERT_OK(this->InsertTestRow(&writer, kCount, 222));
+  this->VerifyTestRows(0, kCount + 1);
+
+  // A hibernated tablet could be moved as well.
+  ASSERT_OK(tablet->Hibernate());
+  ASSERT_OK(tablet->MoveRocksDB(old_root));
+  ASSERT_EQ(old_dir, tablet->metadata()->rocksdb_dir());
+  this->VerifyTestRows(0, kCount + 1);
+}
+
+TYPED_TEST(TestTablet, TestPersistHotKeys) {
+  auto tablet = this->tablet().get();
+  auto* env = tablet->metadata()->fs_manager()->env();
+  const auto path = tablet->metadata()->rocksdb_dir() + kHotKeysFileSuffix;
+
+  // Nothing is written until keys are sampled.
+  ASSERT_OK(tablet->PersistHotKeys());
+  ASSERT_FALSE(env->FileExists(path));
+
+  tablet->TEST_RecordHotKey("hot_key");
+  ASSERT_OK(tablet->PersistHotKeys());
+  ASSERT_TRUE(env->FileExists(path));
+
+  // Once shutdown is requested, a late persist does not recreate the file of deleted tablet data.
+  ASSERT_OK(env->DeleteFile(path));
+  tablet->StartShutdown();
+  ASSERT_OK(tablet->PersistHotKeys());
+  ASSERT_FALSE(env->FileExists(path));
+}
+
 } // namespace tablet
 } // namespace yb
@@ -45,6 +45,7 @@
 #include <boost/optional.hpp>
 
 #include "yb/rocksdb/db.h"
+#include "yb/rocksdb/db/filename.h"
 #include "yb/rocksdb/db/memtable.h"
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/statistics.h"
@@ -77,6 +78,7 @@
 #include "yb/docdb/conflict_resolution.h"
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/cql_operation.h"
+#include "yb/docdb/doc_ql_scanspec.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
 #include "yb/docdb/docdb.h"
 #include "yb/docdb/docdb.pb.h"
@@ -84,10 +86,13 @@
 #include "yb/docdb/docdb_compaction_filter_intents.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent.h"
+#include "yb/docdb/intents_summary.h"
 #include "yb/docdb/lock_batch.h"
 #include "yb/docdb/pgsql_operation.h"
 #include "yb/docdb/primitive_value.h"
+#include "yb/docdb/primitive_value_util.h"
 #include "yb/docdb/redis_operation.h"
+#include "yb/docdb/row_cache.h"
 
 #include "yb/gutil/atomicops.h"
 #include "yb/gutil/map-util.h"
@@ -96,13 +101,18 @@
 #include "yb/gutil/strings/substitute.h"
 #include "yb/rocksutil/yb_rocksdb.h"
 #include "yb/rocksutil/yb_rocksdb_logger.h"
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/thread_pool.h"
 #include "yb/server/hybrid_clock.h"
 
 #include "yb/tablet/tablet_fwd.h"
 #include "yb/tablet/maintenance_manager.h"
 #include "yb/tablet/tablet_snapshots.h"
+#include "yb/tablet/tablet.pb.h"
 #include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_retention_policy.h"
+#include "yb/tablet/hot_keys_sampler.h"
+#include "yb/tablet/ttl_expiry_index.h"
 #include "yb/tablet/transaction_coordinator.h"
 #include "yb/tablet/transaction_participant.h"
 #include "yb/tablet/operations/change_metadata_operation.h"
@@ -115,14 +125,19 @@
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/enums.h"
 #include "yb/util/env.h"
+#include "yb/util/env_util.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/jsonwriter.h"
 #include "yb/util/locks.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/metrics.h"
+#include "yb/util/path_util.h"
+#include "yb/util/pb_util.h"
+#include "yb/util/random_util.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/slice.h"
 #include "yb/util/stopwatch.h"
+#include "yb/util/thread.h"
 #include "yb/util/trace.h"
 #include "yb/util/url-coding.h"
 
@@ -166,6 +181,49 @@ DEFINE_int32(num_raft_ops_to_force_idle_intents_db_to_flush, 1000,
 DEFINE_bool(delete_intents_sst_files, true,
             "Delete whole intents .SST files when possible.");
 
+DEFINE_int32(intents_summary_num_buckets, 1024,
+             "Number of buckets in the per tablet summary of intents, used to avoid intents DB "
+             "seeks for documents without intents. 0 to disable the summary.");
+TAG_FLAG(intents_summary_num_buckets, advanced);
+
+DEFINE_int64(ql_row_cache_size_bytes_per_tablet, 0,
+             "Size of the per tablet cache of rows read by YCQL point reads of non-transactional "
+             "tables, that serves reads of hot rows without reading DocDB. 0 to disable the "
+             "cache.");
+TAG_FLAG(ql_row_cache_size_bytes_per_tablet, advanced);
+
+DEFINE_int32(block_cache_warm_up_num_keys, 256,
+             "Number of recently read keys sampled per tablet, that are sent to the new leader on "
+             "leadership transfer, so it could warm up its block cache. 0 to disable.");
+TAG_FLAG(block_cache_warm_up_num_keys, advanced);
+
+DEFINE_int32(block_cache_warm_up_sample_rate, 16,
+             "One of each that many reads of a tablet is sampled for block cache warm up.");
+TAG_FLAG(block_cache_warm_up_sample_rate, advanced);
+
+DEFINE_int32(block_cache_warm_up_max_seeks_per_sec, 1000,
+             "Limits the rate of seeks done by block cache warm up of a tablet, so it does not "
+             "compete with the foreground reads for disk. 0 for no limit.");
+TAG_FLAG(block_cache_warm_up_max_seeks_per_sec, advanced);
+TAG_FLAG(block_cache_warm_up_max_seeks_per_sec, runtime);
+
+DEFINE_int32(ttl_expiry_index_bucket_sec, 60,
+             "Size of time buckets of the per tablet index of data written with TTL, used to "
+             "compact Redis tablets once enough of their data has expired. 0 to disable the "
+             "index.");
+TAG_FLAG(ttl_expiry_index_bucket_sec, advanced);
+
+DEFINE_int32(tablet_hot_keys_sample_rate, 100,
+             "Keys of one of this many read and write operations of a tablet are added to the "
+             "sample of hot keys of the tablet. 0 to disable sampling.");
+TAG_FLAG(tablet_hot_keys_sample_rate, advanced);
+TAG_FLAG(tablet_hot_keys_sample_rate, runtime);
+
+DEFINE_int32(tablet_hot_keys_capacity, 64,
+             "Max number of most frequently accessed keys tracked by the sample of hot keys of "
+             "each tablet.");
+TAG_FLAG(tablet_hot_keys_capacity, advanced);
+
 DEFINE_int32(backfill_index_write_batch_size, 128, "The batch size for backfilling the index.");
 TAG_FLAG(backfill_index_write_batch_size, advanced);
 TAG_FLAG(backfill_index_write_batch_size, runtime);
@@ -177,6 +235,41 @@ DEFINE_int32(backfill_index_rate_rows_per_sec, 0, "Rate of at which the "
 TAG_FLAG(backfill_index_rate_rows_per_sec, advanced);
 TAG_FLAG(backfill_index_rate_rows_per_sec, runtime);
 
+DEFINE_int32(backfill_index_num_workers, 4,
+             "Number of workers that concurrently scan disjoint hash ranges of a hash "
+             "partitioned tablet and write the resulting entries to the index during index "
+             "backfill. backfill_index_rate_rows_per_sec is shared between the workers.");
+TAG_FLAG(backfill_index_num_workers, advanced);
+TAG_FLAG(backfill_index_num_workers, runtime);
+
+DEFINE_bool(overlap_transactional_index_writes_with_replication, true,
+            "Whether index writes of a transactional write are flushed concurrently with the "
+            "replication of its intents, instead of before it. The write is acknowledged after "
+            "both of them have finished.");
+TAG_FLAG(overlap_transactional_index_writes_with_replication, advanced);
+TAG_FLAG(overlap_transactional_index_writes_with_replication, runtime);
+
+DEFINE_bool(point_reads_skip_safe_time_wait, false,
+            "Whether a leader serves a point read at the requested read time without waiting for "
+            "the safe time, when none of the read keys is locked by an in-flight write and no "
+            "operation other than a write is pending.");
+TAG_FLAG(point_reads_skip_safe_time_wait, advanced);
+TAG_FLAG(point_reads_skip_safe_time_wait, runtime);
+
+DEFINE_int32(wait_for_conflicting_transactions_ms, 0,
+             "Max time to wait for pending transactions that conflict with a write to commit or "
+             "abort, before resolving the conflict by aborting one of the sides. While waiting, "
+             "the write does not hold its locks. 0 means that conflicts are resolved "
+             "immediately.");
+TAG_FLAG(wait_for_conflicting_transactions_ms, advanced);
+TAG_FLAG(wait_for_conflicting_transactions_ms, runtime);
+
+DEFINE_int32(conflicting_transactions_poll_interval_ms, 10,
+             "Interval between checks of conflicting transaction statuses, while waiting for "
+             "them to commit or abort.");
+TAG_FLAG(conflicting_transactions_poll_interval_ms, advanced);
+TAG_FLAG(conflicting_transactions_poll_interval_ms, runtime);
+
 DEFINE_test_flag(int32, TEST_slowdown_backfill_by_ms, 0,
                  "If set > 0, slows down the backfill process by this amount.");
 
@@ -190,6 +283,7 @@ DEFINE_test_flag(
     "Dump write batches being written to RocksDB");
 
 DECLARE_int32(rocksdb_level0_slowdown_writes_trigger);
+DECLARE_int32(timestamp_history_retention_interval_sec);
 DECLARE_int32(rocksdb_level0_stop_writes_trigger);
 
 using namespace std::placeholders;
@@ -246,6 +340,9 @@ using docdb::StorageDbType;
 
 namespace {
 
+// Number of buckets of the hash space, that keys sampled by the hot keys sampler are accounted in.
+constexpr size_t kHotKeysHashBuckets = 16;
+
 void EmitRocksDbMetricsAsJson(
     std::shared_ptr<rocksdb::Statistics> rocksdb_statistics,
     JsonWriter* writer,
@@ -335,6 +432,52 @@ docdb::PartialRangeKeyIntents UsePartialRangeKeyIntents(RaftGroupMetadata* metad
   return docdb::PartialRangeKeyIntents(metadata->table_type() == TableType::PGSQL_TABLE_TYPE);
 }
 
+// Joins the replication of a write operation with the index writes flushed concurrently with it.
+// The original completion callback of the operation is invoked after both of them are done, with
+// the first failure.
+class PendingIndexUpdate {
+ public:
+  explicit PendingIndexUpdate(std::unique_ptr<OperationCompletionCallback> callback)
+      : callback_(std::move(callback)) {}
+
+  void Done(const Status& status, tserver::TabletServerErrorPB::Code code) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!status.ok() && status_.ok()) {
+        status_ = status;
+        code_ = code;
+      }
+      if (--pending_ != 0) {
+        return;
+      }
+    }
+    if (!status_.ok()) {
+      callback_->set_error(status_, code_);
+    }
+    callback_->OperationCompleted();
+  }
+
+ private:
+  std::unique_ptr<OperationCompletionCallback> callback_;
+  std::mutex mutex_;
+  int pending_ = 2;
+  Status status_;
+  tserver::TabletServerErrorPB::Code code_ = tserver::TabletServerErrorPB::UNKNOWN_ERROR;
+};
+
+class IndexUpdateCompletionCallback : public OperationCompletionCallback {
+ public:
+  explicit IndexUpdateCompletionCallback(std::shared_ptr<PendingIndexUpdate> pending)
+      : pending_(std::move(pending)) {}
+
+  void OperationCompleted() override {
+    pending_->Done(status_, code_);
+  }
+
+ private:
+  std::shared_ptr<PendingIndexUpdate> pending_;
+};
+
 } // namespace
 
 string DocDbOpIds::ToString() const {
@@ -440,6 +583,16 @@ Tablet::Tablet(
         metrics_->expired_transactions.get());
   }
 
+  if (FLAGS_block_cache_warm_up_num_keys > 0 && !is_sys_catalog_) {
+    hot_keys_ = std::make_unique<docdb::HotKeys>(
+        FLAGS_block_cache_warm_up_num_keys, FLAGS_block_cache_warm_up_sample_rate);
+  }
+
+  if (FLAGS_ql_row_cache_size_bytes_per_tablet > 0 && table_type_ == TableType::YQL_TABLE_TYPE &&
+      !is_sys_catalog_) {
+    row_cache_ = std::make_unique<docdb::RowCache>(FLAGS_ql_row_cache_size_bytes_per_tablet);
+  }
+
   snapshots_ = std::make_unique<TabletSnapshots>(this);
 }
 
@@ -566,6 +719,8 @@ Status Tablet::OpenKeyValueTablet() {
   static const std::string kRegularDB = "RegularDB"s;
   static const std::string kIntentsDB = "IntentsDB"s;
 
+  regular_db_generation_.fetch_add(1, std::memory_order_acq_rel);
+
   rocksdb::Options rocksdb_options;
   docdb::InitRocksDBOptions(
       &rocksdb_options, LogPrefix(docdb::StorageDbType::kRegular), rocksdb_statistics_,
@@ -587,6 +742,8 @@ Status Tablet::OpenKeyValueTablet() {
   // to this tablet. So, we ensure that rocksdb_ is reset before this tablet gets destroyed.
   rocksdb_options.compaction_filter_factory = make_shared<DocDBCompactionFilterFactory>(
       make_shared<TabletRetentionPolicy>(this), &key_bounds_);
+  rocksdb_options.table_properties_collector_factories.push_back(
+      std::make_shared<docdb::DocDBTablePropertiesCollectorFactory>());
 
   rocksdb_options.mem_table_flush_filter_factory = MakeMemTableFlushFilterFactory([this] {
     if (mem_table_flush_filter_factory_) {
@@ -595,12 +752,30 @@ Status Tablet::OpenKeyValueTablet() {
     return rocksdb::MemTableFilter();
   });
 
+  // SST files of a colocated tablet contain rows of different tables, so their bloom filters use
+  // only hashed components.
+  size_t num_bloom_filter_range_components = 0;
+  if (!metadata()->colocated()) {
+    const auto& schema = metadata()->schema();
+    num_bloom_filter_range_components = std::min<size_t>(
+        std::max(schema.table_properties().num_bloom_filter_range_components(), 0),
+        schema.num_range_key_columns());
+  }
+  if (num_bloom_filter_range_components != 0) {
+    docdb::SetBloomFilterRangeComponents(&rocksdb_options, num_bloom_filter_range_components);
+  }
+
   rocksdb_options.disable_auto_compactions = true;
   rocksdb_options.level0_slowdown_writes_trigger = std::numeric_limits<int>::max();
   rocksdb_options.level0_stop_writes_trigger = std::numeric_limits<int>::max();
 
   const string db_dir = metadata()->rocksdb_dir();
   RETURN_NOT_OK(CreateTabletDirectories(db_dir, metadata()->fs_manager()));
+  const auto cold_dir = metadata()->cold_rocksdb_dir();
+  if (!cold_dir.empty()) {
+    RETURN_NOT_OK(metadata()->fs_manager()->env()->CreateDirs(cold_dir));
+    docdb::SetColdStoragePath(db_dir, cold_dir, &rocksdb_options);
+  }
 
   LOG(INFO) << "Opening RocksDB at: " << db_dir;
   rocksdb::DB* db = nullptr;
@@ -615,6 +790,9 @@ Status Tablet::OpenKeyValueTablet() {
   }
   regular_db_.reset(db);
   regular_db_->ListenFilesChanged(std::bind(&Tablet::RegularDbFilesChanged, this));
+  if (row_cache_) {
+    row_cache_->Clear();
+  }
 
   if (transaction_participant_) {
     LOG_WITH_PREFIX(INFO) << "Opening intents DB at: " << db_dir + kIntentsDBSuffix;
@@ -624,6 +802,26 @@ Status Tablet::OpenKeyValueTablet() {
       return std::bind(&Tablet::IntentsDbFlushFilter, this, _1);
     });
 
+    // Applied and aborted intents are removed with single deletes, that rely on in memory erase,
+    // so the intents DB keeps the single writer memtable.
+    docdb::SetConcurrentMemtableWrites(&rocksdb_options, false);
+
+    // Intents are short lived, so they always stay in the data dir.
+    rocksdb_options.db_paths.clear();
+    rocksdb_options.compaction_output_path_selector = nullptr;
+
+    // Intents DB keys are not aligned by subcompaction_boundary_key_transform.
+    rocksdb_options.max_subcompactions = 1;
+    rocksdb_options.subcompaction_boundary_key_transform = nullptr;
+
+    // Intents DB keys don't end with the hybrid time of the entry.
+    rocksdb_options.table_properties_collector_factories.clear();
+
+    // Intents are also written for key prefixes, that are checked against the bloom filter.
+    if (num_bloom_filter_range_components != 0) {
+      docdb::SetBloomFilterRangeComponents(&rocksdb_options, 0);
+    }
+
     rocksdb_options.compaction_filter_factory =
         FLAGS_tablet_do_compaction_cleanup_for_intents ?
         std::make_shared<docdb::DocDBIntentsCompactionFilterFactory>(this, &key_bounds_) : nullptr;
@@ -643,6 +841,29 @@ Status Tablet::OpenKeyValueTablet() {
     RETURN_NOT_OK(rocksdb::DB::Open(rocksdb_options, db_dir + kIntentsDBSuffix, &intents_db));
     intents_db_.reset(intents_db);
     intents_db_->ListenFilesChanged(std::bind(&Tablet::CleanupIntentFiles, this));
+
+    intents_summary_.reset();
+    if (FLAGS_intents_summary_num_buckets > 0) {
+      intents_summary_ = std::make_unique<docdb::IntentsSummary>(
+          FLAGS_intents_summary_num_buckets);
+      auto status = intents_summary_->Load(intents_db_.get());
+      if (!status.ok()) {
+        LOG_WITH_PREFIX(WARNING) << "Failed to load intents summary: " << status;
+        intents_summary_->Disable();
+      }
+    }
+  }
+
+  ttl_expiry_index_.reset();
+  if (table_type_ == TableType::REDIS_TABLE_TYPE && FLAGS_ttl_expiry_index_bucket_sec > 0) {
+    ttl_expiry_index_ = std::make_unique<TtlExpiryIndex>(
+        MonoDelta::FromSeconds(FLAGS_ttl_expiry_index_bucket_sec));
+  }
+
+  hot_keys_sampler_.reset();
+  if (FLAGS_tablet_hot_keys_capacity > 0) {
+    hot_keys_sampler_ = std::make_unique<HotKeysSampler>(
+        FLAGS_tablet_hot_keys_capacity, kHotKeysHashBuckets);
   }
 
   ql_storage_.reset(new docdb::QLRocksDBStorage(doc_db()));
@@ -807,6 +1028,27 @@ void Tablet::PreventCallbacksFromRocksDBs(bool disable_flush_on_shutdown) {
 void Tablet::CompleteShutdown(IsDropTable is_drop_table) {
   StartShutdown();
 
+  {
+    // Warm up notices shutdown request and stops.
+    std::lock_guard<std::mutex> lock(warm_up_mutex_);
+    if (warm_up_thread_) {
+      warm_up_thread_->Join();
+      warm_up_thread_.reset();
+    }
+  }
+
+  {
+    // Waits for a concurrent hot keys persist to complete, later ones notice shutdown request.
+    std::lock_guard<std::mutex> lock(hot_keys_persist_mutex_);
+  }
+
+  // Writes waiting for conflicting transactions notice shutdown request and complete.
+  while (num_waiting_doc_writes_.load(std::memory_order_acquire) != 0) {
+    SleepFor(MonoDelta::FromMilliseconds(1));
+  }
+
+  // Waits for a concurrent hibernation or wake up to complete.
+  std::lock_guard<std::mutex> hibernation_lock(hibernation_mutex_);
   auto op_pause = PauseReadWriteOperations();
   if (!op_pause.ok()) {
     LOG_WITH_PREFIX(WARNING) << "Failed to shut down: " << op_pause.status();
@@ -863,6 +1105,11 @@ Status Tablet::ResetRocksDBs(bool destroy) {
   }
 
   Status intents_status = ResetRocksDB(destroy, rocksdb_options, &intents_db_);
+  if (destroy) {
+    // Also destroys SST files of the regular DB on the cold storage tier.
+    docdb::SetColdStoragePath(
+        metadata_->rocksdb_dir(), metadata_->cold_rocksdb_dir(), &rocksdb_options);
+  }
   Status regular_status = ResetRocksDB(destroy, rocksdb_options, &regular_db_);
   key_bounds_ = docdb::KeyBounds();
 
@@ -874,6 +1121,17 @@ Result<std::unique_ptr<common::YQLRowwiseIteratorIf>> Tablet::NewRowIterator(
     const boost::optional<TransactionId>& transaction_id,
     const ReadHybridTime read_hybrid_time,
     const TableId& table_id) const {
+  auto result = VERIFY_RESULT(
+      CreateRowIterator(projection, transaction_id, read_hybrid_time, table_id));
+  RETURN_NOT_OK(result->Init());
+  return std::move(result);
+}
+
+Result<std::unique_ptr<docdb::DocRowwiseIterator>> Tablet::CreateRowIterator(
+    const Schema& projection,
+    const boost::optional<TransactionId>& transaction_id,
+    const ReadHybridTime read_hybrid_time,
+    const TableId& table_id) const {
   if (state_ != kOpen) {
     return STATUS_FORMAT(IllegalState, "Tablet in wrong state: $0", state_);
   }
@@ -882,7 +1140,7 @@ Result<std::unique_ptr<common::YQLRowwiseIteratorIf>> Tablet::NewRowIterator(
     return STATUS_FORMAT(NotSupported, "Invalid table type: $0", table_type_);
   }
 
-  ScopedPendingOperation scoped_read_operation(&pending_op_counter_);
+  auto scoped_read_operation = StartReadWriteOperation();
   RETURN_NOT_OK(scoped_read_operation);
 
   VLOG_WITH_PREFIX(2) << "Created new Iterator reading at " << read_hybrid_time.ToString();
@@ -900,7 +1158,6 @@ Result<std::unique_ptr<common::YQLRowwiseIteratorIf>> Tablet::NewRowIterator(
   auto result = std::make_unique<DocRowwiseIterator>(
       std::move(mapped_projection), schema, txn_op_ctx, doc_db(),
       CoarseTimePoint::max() /* deadline */, read_time, &pending_op_counter_);
-  RETURN_NOT_OK(result->Init());
   return std::move(result);
 }
 
@@ -946,7 +1203,29 @@ Status Tablet::ApplyRowOperations(WriteOperationState* operation_state) {
   // Even if we have an external hybrid time, use the local commit hybrid time in the consensus
   // frontier.
   set_hybrid_time(operation_state->hybrid_time(), &frontiers);
-  return ApplyKeyValueRowOperations(write_request.batch_idx(), put_batch, &frontiers, hybrid_time);
+  RETURN_NOT_OK(ApplyKeyValueRowOperations(
+      write_request.batch_idx(), put_batch, &frontiers, hybrid_time));
+  if (!put_batch.has_transaction() && !put_batch.write_pairs().empty()) {
+    RegularDbWriteApplied(yb::OpId::FromPB(operation_state->op_id()));
+  }
+  return Status::OK();
+}
+
+void Tablet::RegularDbWriteApplied(const yb::OpId& op_id) {
+  std::lock_guard<simple_spinlock> lock(regular_db_writes_lock_);
+  if (last_regular_db_write_.term != op_id.term) {
+    last_regular_db_write_of_previous_term_ = last_regular_db_write_;
+  }
+  last_regular_db_write_ = op_id;
+}
+
+yb::OpId Tablet::LastRegularDbWriteBeforeTerm(int64_t term) const {
+  std::lock_guard<simple_spinlock> lock(regular_db_writes_lock_);
+  if (last_regular_db_write_.term < term) {
+    return last_regular_db_write_;
+  }
+  // Terms of applied operations never decrease, so the previous term is before `term`.
+  return last_regular_db_write_of_previous_term_;
 }
 
 Status Tablet::PrepareTransactionWriteBatch(
@@ -997,6 +1276,16 @@ Status Tablet::ApplyKeyValueRowOperations(int64_t batch_idx,
     return Status::OK();
   }
 
+  if (log_only()) {
+    // Operation is durable in the log, and log-only peer does not keep the data.
+    return Status::OK();
+  }
+
+  // Followers apply replicated writes without any other read/write operation, so a hibernated
+  // tablet is woken up here.
+  auto scoped_operation = StartReadWriteOperation();
+  RETURN_NOT_OK(scoped_operation);
+
   // Could return failure only for cases where it is safe to skip applying operations to DB.
   // For instance where aborted transaction intents are written.
   // In all other cases we should crash instead of skipping apply.
@@ -1005,15 +1294,77 @@ Status Tablet::ApplyKeyValueRowOperations(int64_t batch_idx,
   if (put_batch.has_transaction()) {
     RequestScope request_scope(transaction_participant_.get());
     RETURN_NOT_OK(PrepareTransactionWriteBatch(batch_idx, put_batch, hybrid_time, &write_batch));
+    // Intents should be added to the summary before they become visible to readers.
+    if (intents_summary_) {
+      intents_summary_->AddWriteBatch(write_batch);
+    }
     WriteToRocksDB(frontiers, &write_batch, StorageDbType::kIntents);
+  } else if (InApplyBatch()) {
+    PrepareNonTransactionWriteBatch(put_batch, hybrid_time, &apply_batch_write_batch_);
+    if (frontiers) {
+      if (apply_batch_frontiers_) {
+        apply_batch_frontiers_->MergeFrontiers(*frontiers);
+      } else {
+        apply_batch_frontiers_ = frontiers->Clone();
+      }
+    }
+    if (ttl_expiry_index_) {
+      ttl_expiry_index_->AddWriteBatch(put_batch, hybrid_time);
+    }
   } else {
     PrepareNonTransactionWriteBatch(put_batch, hybrid_time, &write_batch);
     WriteToRocksDB(frontiers, &write_batch, StorageDbType::kRegular);
+    if (ttl_expiry_index_) {
+      ttl_expiry_index_->AddWriteBatch(put_batch, hybrid_time);
+    }
   }
 
   return Status::OK();
 }
 
+void Tablet::StartApplyBatch() {
+  DCHECK(!InApplyBatch());
+  apply_batch_lock_ = std::unique_lock<std::mutex>(apply_batch_mutex_);
+  apply_batch_thread_.store(std::this_thread::get_id(), std::memory_order_release);
+}
+
+void Tablet::FinishApplyBatch() {
+  DCHECK(InApplyBatch());
+  if (apply_batch_write_batch_.Count() != 0) {
+    WriteToRocksDB(apply_batch_frontiers_.get(), &apply_batch_write_batch_,
+                   StorageDbType::kRegular);
+    apply_batch_write_batch_.Clear();
+    apply_batch_write_batch_.SetFrontiers(nullptr);
+  }
+  apply_batch_frontiers_.reset();
+  apply_batch_thread_.store(std::thread::id(), std::memory_order_release);
+
+  // Deferred steps are executed while the batch mutex is still held, so operations applied by
+  // other threads could not become visible before operations of this batch.
+  auto deferred = std::move(apply_batch_deferred_);
+  apply_batch_deferred_.clear();
+  for (auto& fn : deferred) {
+    fn();
+  }
+  apply_batch_lock_.unlock();
+}
+
+void Tablet::RunAfterApplyBatch(std::function<void()> fn) {
+  if (InApplyBatch()) {
+    apply_batch_deferred_.push_back(std::move(fn));
+  } else {
+    fn();
+  }
+}
+
+void Tablet::WaitForApplyBatch() {
+  if (apply_batch_thread_.load(std::memory_order_acquire) == std::thread::id() ||
+      InApplyBatch()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(apply_batch_mutex_);
+}
+
 void Tablet::WriteToRocksDB(
     const rocksdb::UserFrontiers* frontiers,
     rocksdb::WriteBatch* write_batch,
@@ -1039,6 +1390,20 @@ void Tablet::WriteToRocksDB(
     LOG_WITH_PREFIX(FATAL) << "Failed to write a batch with " << write_batch->Count()
                            << " operations into RocksDB: " << rocksdb_write_status;
   }
+  if (storage_db_type == StorageDbType::kRegular) {
+    // Also covers intents applied by ApplyIntents, that are written to the regular DB here.
+    if (row_cache_) {
+      row_cache_->InvalidateWriteBatch(*write_batch);
+    }
+  }
+  if (tablet_options_.memtable_write_listener &&
+      !memtable_write_reported_.load(std::memory_order_acquire) &&
+      !memtable_write_reported_.exchange(true, std::memory_order_acq_rel)) {
+    auto oldest_write = OldestMutableMemtableWriteHybridTime();
+    if (oldest_write.ok()) {
+      tablet_options_.memtable_write_listener(tablet_id(), *oldest_write);
+    }
+  }
 
   if (FLAGS_docdb_log_write_batches) {
     LOG_WITH_PREFIX(INFO)
@@ -1080,9 +1445,12 @@ void SetupKeyValueBatch(WriteRequestPB* write_request, WriteRequestPB* batch_req
 
 //--------------------------------------------------------------------------------------------------
 // Redis Request Processing.
-Status Tablet::KeyValueBatchFromRedisWriteBatch(WriteOperation* operation) {
-  ScopedPendingOperation scoped_read_operation(&pending_op_counter_);
-  RETURN_NOT_OK(scoped_read_operation);
+void Tablet::KeyValueBatchFromRedisWriteBatch(std::unique_ptr<WriteOperation> operation) {
+  auto scoped_read_operation = StartReadWriteOperation();
+  if (!scoped_read_operation.ok()) {
+    WriteOperation::StartSynchronization(std::move(operation), MoveStatus(scoped_read_operation));
+    return;
+  }
   docdb::DocOperations& doc_ops = operation->doc_ops();
   // Since we take exclusive locks, it's okay to use Now as the read TS for writes.
   WriteRequestPB batch_request;
@@ -1093,17 +1461,20 @@ Status Tablet::KeyValueBatchFromRedisWriteBatch(WriteOperation* operation) {
   for (size_t i = 0; i < redis_write_batch->size(); i++) {
     doc_ops.emplace_back(new RedisWriteOperation(redis_write_batch->Mutable(i)));
   }
-  RETURN_NOT_OK(StartDocWriteOperation(operation));
-  if (operation->restart_read_ht().is_valid()) {
-    return Status::OK();
-  }
-  auto* response = operation->response();
-  for (size_t i = 0; i < doc_ops.size(); i++) {
-    auto* redis_write_operation = down_cast<RedisWriteOperation*>(doc_ops[i].get());
-    response->add_redis_response_batch()->Swap(&redis_write_operation->response());
-  }
+  StartDocWriteOperation(std::move(operation), &Tablet::CompleteRedisWriteBatch);
+}
 
-  return Status::OK();
+void Tablet::CompleteRedisWriteBatch(
+    std::unique_ptr<WriteOperation> operation, const Status& status) {
+  if (status.ok() && !operation->restart_read_ht().is_valid()) {
+    auto& doc_ops = operation->doc_ops();
+    auto* response = operation->response();
+    for (size_t i = 0; i < doc_ops.size(); i++) {
+      auto* redis_write_operation = down_cast<RedisWriteOperation*>(doc_ops[i].get());
+      response->add_redis_response_batch()->Swap(&redis_write_operation->response());
+    }
+  }
+  WriteOperation::StartSynchronization(std::move(operation), status);
 }
 
 Status Tablet::HandleRedisReadRequest(CoarseTimePoint deadline,
@@ -1111,10 +1482,11 @@ Status Tablet::HandleRedisReadRequest(CoarseTimePoint deadline,
                                       const RedisReadRequestPB& redis_read_request,
                                       RedisResponsePB* response) {
   // TODO: move this locking to the top-level read request handler in TabletService.
-  ScopedPendingOperation scoped_read_operation(&pending_op_counter_);
+  auto scoped_read_operation = StartReadWriteOperation();
   RETURN_NOT_OK(scoped_read_operation);
 
   ScopedTabletMetricsTracker metrics_tracker(metrics_->redis_read_latency);
+  ScopedOperationCostTracker cost_tracker(&metrics_->read_cost);
 
   docdb::RedisReadOperation doc_op(redis_read_request, doc_db(), deadline, read_time);
   RETURN_NOT_OK(doc_op.Execute());
@@ -1130,9 +1502,10 @@ Status Tablet::HandleQLReadRequest(
     const QLReadRequestPB& ql_read_request,
     const TransactionMetadataPB& transaction_metadata,
     QLReadRequestResult* result) {
-  ScopedPendingOperation scoped_read_operation(&pending_op_counter_);
+  auto scoped_read_operation = StartReadWriteOperation();
   RETURN_NOT_OK(scoped_read_operation);
   ScopedTabletMetricsTracker metrics_tracker(metrics_->ql_read_latency);
+  ScopedOperationCostTracker cost_tracker(&metrics_->read_cost);
 
   if (metadata()->schema_version() != ql_read_request.schema_version()) {
     DVLOG(1) << "Setting status for read as YQL_STATUS_SCHEMA_VERSION_MISMATCH";
@@ -1140,11 +1513,15 @@ Status Tablet::HandleQLReadRequest(
     return Status::OK();
   }
 
+  if (ShouldSampleHotKeys()) {
+    SampleHotKeys(ql_read_request);
+  }
+
   Result<TransactionOperationContextOpt> txn_op_ctx =
       CreateTransactionOperationContext(transaction_metadata, /* is_ysql_catalog_table */ false);
   RETURN_NOT_OK(txn_op_ctx);
   return AbstractTablet::HandleQLReadRequest(
-      deadline, read_time, ql_read_request, *txn_op_ctx, result);
+      deadline, read_time, ql_read_request, *txn_op_ctx, result, row_cache_.get());
 }
 
 CHECKED_STATUS Tablet::CreatePagingStateForRead(const QLReadRequestPB& ql_read_request,
@@ -1193,7 +1570,7 @@ CHECKED_STATUS Tablet::CreatePagingStateForRead(const QLReadRequestPB& ql_read_r
 void Tablet::KeyValueBatchFromQLWriteBatch(std::unique_ptr<WriteOperation> operation) {
   DVLOG(2) << " Schema version for  " << metadata_->table_name() << " is "
            << metadata_->schema_version();
-  ScopedPendingOperation scoped_read_operation(&pending_op_counter_);
+  auto scoped_read_operation = StartReadWriteOperation();
   if (!scoped_read_operation.ok()) {
     WriteOperation::StartSynchronization(std::move(operation), MoveStatus(scoped_read_operation));
     return;
@@ -1244,17 +1621,19 @@ void Tablet::KeyValueBatchFromQLWriteBatch(std::unique_ptr<WriteOperation> opera
     return;
   }
 
-  auto status = StartDocWriteOperation(operation.get());
-  if (operation->restart_read_ht().is_valid()) {
-    WriteOperation::StartSynchronization(std::move(operation), Status::OK());
-    return;
-  }
+  StartDocWriteOperation(std::move(operation), [this](
+      std::unique_ptr<WriteOperation> operation, const Status& status) {
+    if (operation->restart_read_ht().is_valid()) {
+      WriteOperation::StartSynchronization(std::move(operation), Status::OK());
+      return;
+    }
 
-  if (status.ok()) {
-    UpdateQLIndexes(std::move(operation));
-  } else {
-    CompleteQLWriteBatch(std::move(operation), status);
-  }
+    if (status.ok()) {
+      UpdateQLIndexes(std::move(operation));
+    } else {
+      CompleteQLWriteBatch(std::move(operation), status);
+    }
+  });
 }
 
 void Tablet::CompleteQLWriteBatch(std::unique_ptr<WriteOperation> operation, const Status& status) {
@@ -1290,7 +1669,7 @@ void Tablet::UpdateQLIndexes(std::unique_ptr<WriteOperation> operation) {
   client::YBClient* client = nullptr;
   client::YBSessionPtr session;
   client::YBTransactionPtr txn;
-  std::vector<std::pair<std::shared_ptr<client::YBqlWriteOp>, QLWriteOperation*>> index_ops;
+  IndexOps index_ops;
   const ChildTransactionDataPB* child_transaction_data = nullptr;
   for (auto& doc_op : operation->doc_ops()) {
     auto* write_op = static_cast<QLWriteOperation*>(doc_op.get());
@@ -1352,7 +1731,7 @@ void Tablet::UpdateQLIndexes(std::unique_ptr<WriteOperation> operation) {
         operation->state()->CompleteWithStatus(status);
         return;
       }
-      index_ops.emplace_back(std::move(index_op), write_op);
+      index_ops.emplace_back(std::move(index_op), write_op->response());
     }
   }
 
@@ -1361,54 +1740,75 @@ void Tablet::UpdateQLIndexes(std::unique_ptr<WriteOperation> operation) {
     return;
   }
 
+  // Index writes of a transaction are a part of the same transaction as the intents of this
+  // write, so when any of them fails the client aborts the transaction. There is no need to wait
+  // for them before replicating the intents.
+  if (txn && FLAGS_overlap_transactional_index_writes_with_replication &&
+      operation->state()->has_completion_callback()) {
+    auto pending = std::make_shared<PendingIndexUpdate>(
+        operation->state()->release_completion_callback());
+    operation->state()->set_completion_callback(
+        std::make_unique<IndexUpdateCompletionCallback>(pending));
+    CompleteQLWriteBatch(std::move(operation), Status::OK());
+    session->FlushAsync(
+        [pending, session, txn, index_ops = std::move(index_ops)](const Status& status) {
+      pending->Done(
+          ProcessIndexUpdateResponses(status, session.get(), txn.get(), index_ops),
+          tserver::TabletServerErrorPB::UNKNOWN_ERROR);
+    });
+    return;
+  }
+
   session->FlushAsync(
       [this, op = operation.release(), session, txn, index_ops = std::move(index_ops)]
           (const Status& status) {
     std::unique_ptr<WriteOperation> operation(op);
-
-    if (PREDICT_FALSE(!status.ok())) {
-      // When any error occurs during the dispatching of YBOperation, YBSession saves the error and
-      // returns IOError. When it happens, retrieves the errors and discard the IOError.
-      if (status.IsIOError()) {
-        for (const auto& error : session->GetPendingErrors()) {
-          // return just the first error seen.
-          operation->state()->CompleteWithStatus(error->status());
-          return;
-        }
-      }
-      operation->state()->CompleteWithStatus(status);
+    auto process_status = ProcessIndexUpdateResponses(status, session.get(), txn.get(), index_ops);
+    if (!process_status.ok()) {
+      operation->state()->CompleteWithStatus(process_status);
       return;
     }
+    CompleteQLWriteBatch(std::move(operation), Status::OK());
+  });
+}
 
-    ChildTransactionResultPB child_result;
-    if (txn) {
-      auto finish_result = txn->FinishChild();
-      if (!finish_result.ok()) {
-        operation->state()->CompleteWithStatus(finish_result.status());
-        return;
+Status Tablet::ProcessIndexUpdateResponses(
+    const Status& flush_status, YBSession* session, YBTransaction* txn,
+    const IndexOps& index_ops) {
+  if (PREDICT_FALSE(!flush_status.ok())) {
+    // When any error occurs during the dispatching of YBOperation, YBSession saves the error and
+    // returns IOError. When it happens, retrieves the errors and discard the IOError.
+    if (flush_status.IsIOError()) {
+      for (const auto& error : session->GetPendingErrors()) {
+        // return just the first error seen.
+        return error->status();
       }
-      child_result = std::move(*finish_result);
     }
+    return flush_status;
+  }
 
-    // Check the responses of the index write ops.
-    for (const auto& pair : index_ops) {
-      shared_ptr<client::YBqlWriteOp> index_op = pair.first;
-      auto* response = pair.second->response();
-      DCHECK_ONLY_NOTNULL(response);
-      auto* index_response = index_op->mutable_response();
+  ChildTransactionResultPB child_result;
+  if (txn) {
+    child_result = VERIFY_RESULT(txn->FinishChild());
+  }
 
-      if (index_response->status() != QLResponsePB::YQL_STATUS_OK) {
-        DVLOG(1) << "Got status " << index_response->status() << " for " << yb::ToString(index_op);
-        response->set_status(index_response->status());
-        response->set_error_message(std::move(*index_response->mutable_error_message()));
-      }
-      if (txn) {
-        *response->mutable_child_transaction_result() = child_result;
-      }
-    }
+  // Check the responses of the index write ops.
+  for (const auto& pair : index_ops) {
+    shared_ptr<client::YBqlWriteOp> index_op = pair.first;
+    auto* response = pair.second;
+    DCHECK_ONLY_NOTNULL(response);
+    auto* index_response = index_op->mutable_response();
 
-    CompleteQLWriteBatch(std::move(operation), Status::OK());
-  });
+    if (index_response->status() != QLResponsePB::YQL_STATUS_OK) {
+      DVLOG(1) << "Got status " << index_response->status() << " for " << yb::ToString(index_op);
+      response->set_status(index_response->status());
+      response->set_error_message(std::move(*index_response->mutable_error_message()));
+    }
+    if (txn) {
+      *response->mutable_child_transaction_result() = child_result;
+    }
+  }
+  return Status::OK();
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1419,10 +1819,11 @@ Status Tablet::HandlePgsqlReadRequest(
     const PgsqlReadRequestPB& pgsql_read_request,
     const TransactionMetadataPB& transaction_metadata,
     PgsqlReadRequestResult* result) {
-  ScopedPendingOperation scoped_read_operation(&pending_op_counter_);
+  auto scoped_read_operation = StartReadWriteOperation();
   RETURN_NOT_OK(scoped_read_operation);
   // TODO(neil) Work on metrics for PGSQL.
   // ScopedTabletMetricsTracker metrics_tracker(metrics_->pgsql_read_latency);
+  ScopedOperationCostTracker cost_tracker(&metrics_->read_cost);
 
   const tablet::TableInfo* table_info =
       VERIFY_RESULT(metadata_->GetTableInfo(pgsql_read_request.table_id()));
@@ -1438,8 +1839,9 @@ Status Tablet::HandlePgsqlReadRequest(
           transaction_metadata,
           table_info->schema.table_properties().is_ysql_catalog_table());
   RETURN_NOT_OK(txn_op_ctx);
+  const auto locks_doc_db = doc_db();
   return AbstractTablet::HandlePgsqlReadRequest(
-      deadline, read_time, pgsql_read_request, *txn_op_ctx, result);
+      deadline, read_time, pgsql_read_request, *txn_op_ctx, result, &locks_doc_db);
 }
 
 CHECKED_STATUS Tablet::CreatePagingStateForRead(const PgsqlReadRequestPB& pgsql_read_request,
@@ -1451,14 +1853,18 @@ CHECKED_STATUS Tablet::CreatePagingStateForRead(const PgsqlReadRequestPB& pgsql_
   // key of the next tablet. Do so only if the request has no row count limit, or there is and we
   // haven't hit it, or we are asked to return paging state even when we have hit the limit.
   // Otherwise, leave the paging state empty which means we are completely done reading for the
-  // whole SELECT statement.
+  // whole SELECT statement. The same applies when the next tablet is beyond the max hash code of
+  // the request, i.e. the request was limited to a hash range.
   if (pgsql_read_request.partition_column_values().empty() &&
       pgsql_read_request.ybctid_column_value().value().binary_value().empty() &&
       !response->has_paging_state() &&
       (!pgsql_read_request.has_limit() || row_count < pgsql_read_request.limit() ||
        pgsql_read_request.return_paging_state())) {
     const string& next_partition_key = metadata_->partition().partition_key_end();
-    if (!next_partition_key.empty()) {
+    if (!next_partition_key.empty() &&
+        (!pgsql_read_request.has_max_hash_code() ||
+         PartitionSchema::DecodeMultiColumnHashValue(next_partition_key) <=
+             pgsql_read_request.max_hash_code())) {
       response->mutable_paging_state()->set_next_partition_key(next_partition_key);
     }
   }
@@ -1471,9 +1877,7 @@ CHECKED_STATUS Tablet::CreatePagingStateForRead(const PgsqlReadRequestPB& pgsql_
   return Status::OK();
 }
 
-Status Tablet::KeyValueBatchFromPgsqlWriteBatch(WriteOperation* operation) {
-  ScopedPendingOperation scoped_read_operation(&pending_op_counter_);
-  RETURN_NOT_OK(scoped_read_operation);
+Status Tablet::PgsqlWriteBatchToDocOperations(WriteOperation* operation) {
   docdb::DocOperations& doc_ops = operation->doc_ops();
   WriteRequestPB batch_request;
 
@@ -1512,24 +1916,39 @@ Status Tablet::KeyValueBatchFromPgsqlWriteBatch(WriteOperation* operation) {
     }
   }
 
-  // All operations have wrong schema version.
-  if (doc_ops.empty()) {
-    return Status::OK();
-  }
+  return Status::OK();
+}
 
-  RETURN_NOT_OK(StartDocWriteOperation(operation));
-  if (operation->restart_read_ht().is_valid()) {
-    return Status::OK();
+void Tablet::KeyValueBatchFromPgsqlWriteBatch(std::unique_ptr<WriteOperation> operation) {
+  auto scoped_read_operation = StartReadWriteOperation();
+  if (!scoped_read_operation.ok()) {
+    WriteOperation::StartSynchronization(std::move(operation), MoveStatus(scoped_read_operation));
+    return;
   }
-  for (size_t i = 0; i < doc_ops.size(); i++) {
-    PgsqlWriteOperation* pgsql_write_op = down_cast<PgsqlWriteOperation*>(doc_ops[i].get());
-    // We'll need to return the number of rows inserted, updated, or deleted by each operation.
-    doc_ops[i].release();
-    operation->state()->pgsql_write_ops()
-                      ->emplace_back(unique_ptr<PgsqlWriteOperation>(pgsql_write_op));
+
+  auto status = PgsqlWriteBatchToDocOperations(operation.get());
+  // Nothing to write when all operations have wrong schema version.
+  if (!status.ok() || operation->doc_ops().empty()) {
+    WriteOperation::StartSynchronization(std::move(operation), status);
+    return;
   }
 
-  return Status::OK();
+  StartDocWriteOperation(std::move(operation), &Tablet::CompletePgsqlWriteBatch);
+}
+
+void Tablet::CompletePgsqlWriteBatch(
+    std::unique_ptr<WriteOperation> operation, const Status& status) {
+  if (status.ok() && !operation->restart_read_ht().is_valid()) {
+    auto& doc_ops = operation->doc_ops();
+    for (size_t i = 0; i < doc_ops.size(); i++) {
+      PgsqlWriteOperation* pgsql_write_op = down_cast<PgsqlWriteOperation*>(doc_ops[i].get());
+      // We'll need to return the number of rows inserted, updated, or deleted by each operation.
+      doc_ops[i].release();
+      operation->state()->pgsql_write_ops()
+                        ->emplace_back(unique_ptr<PgsqlWriteOperation>(pgsql_write_op));
+    }
+  }
+  WriteOperation::StartSynchronization(std::move(operation), status);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1544,8 +1963,7 @@ void Tablet::AcquireLocksAndPerformDocOperations(std::unique_ptr<WriteOperation>
   const WriteRequestPB* key_value_write_request = operation->state()->request();
 
   if (!key_value_write_request->redis_write_batch().empty()) {
-    auto status = KeyValueBatchFromRedisWriteBatch(operation.get());
-    WriteOperation::StartSynchronization(std::move(operation), status);
+    KeyValueBatchFromRedisWriteBatch(std::move(operation));
     return;
   }
 
@@ -1555,25 +1973,23 @@ void Tablet::AcquireLocksAndPerformDocOperations(std::unique_ptr<WriteOperation>
   }
 
   if (!key_value_write_request->pgsql_write_batch().empty()) {
-    auto status = KeyValueBatchFromPgsqlWriteBatch(operation.get());
-    WriteOperation::StartSynchronization(std::move(operation), status);
+    KeyValueBatchFromPgsqlWriteBatch(std::move(operation));
     return;
   }
 
   if (key_value_write_request->has_write_batch()) {
-    Status status;
     if (!key_value_write_request->write_batch().read_pairs().empty()) {
-      ScopedPendingOperation scoped_operation(&pending_op_counter_);
+      auto scoped_operation = StartReadWriteOperation();
       if (!scoped_operation.ok()) {
         operation->state()->CompleteWithStatus(MoveStatus(scoped_operation));
         return;
       }
 
-      status = StartDocWriteOperation(operation.get());
-    } else {
-      DCHECK(key_value_write_request->has_external_hybrid_time());
+      StartDocWriteOperation(std::move(operation), &WriteOperation::StartSynchronization);
+      return;
     }
-    WriteOperation::StartSynchronization(std::move(operation), status);
+    DCHECK(key_value_write_request->has_external_hybrid_time());
+    WriteOperation::StartSynchronization(std::move(operation), Status::OK());
     return;
   }
 
@@ -1620,7 +2036,12 @@ Status Tablet::WaitForFlush() {
 
 Status Tablet::ImportData(const std::string& source_dir) {
   // We import only regular records, so don't have to deal with intents here.
-  return regular_db_->Import(source_dir);
+  regular_db_generation_.fetch_add(1, std::memory_order_acq_rel);
+  auto status = regular_db_->Import(source_dir);
+  if (row_cache_) {
+    row_cache_->Clear();
+  }
+  return status;
 }
 
 template <class Data>
@@ -1632,18 +2053,26 @@ void InitFrontiers(const Data& data, docdb::ConsensusFrontiers* frontiers) {
 // We apply intents by iterating over whole transaction reverse index.
 // Using value of reverse index record we find original intent record and apply it.
 // After that we delete both intent record and reverse index record.
-// TODO(dtxn) use multiple batches when applying really big transaction.
+//
+// Big transactions are applied in multiple batches. Only the last batch carries the frontiers of
+// the apply operation, so if only a part of the batches was flushed before a restart, the flushed
+// op id stays below the apply operation and the whole transaction is applied again during
+// bootstrap. Applying the same intents twice is safe, since they produce the same records.
 Status Tablet::ApplyIntents(const TransactionApplyData& data) {
   rocksdb::WriteBatch regular_write_batch;
   RETURN_NOT_OK(docdb::PrepareApplyIntentsBatch(
       data.transaction_id, data.commit_ht, &key_bounds_,
-      &regular_write_batch, intents_db_.get(), nullptr /* intents_write_batch */));
+      &regular_write_batch, intents_db_.get(), nullptr /* intents_write_batch */,
+      [this](rocksdb::WriteBatch* chunk) {
+        WriteToRocksDB(nullptr /* frontiers */, chunk, StorageDbType::kRegular);
+      }));
 
   // data.hybrid_time contains transaction commit time.
   // We don't set transaction field of put_batch, otherwise we would write another bunch of intents.
   docdb::ConsensusFrontiers frontiers;
   InitFrontiers(data, &frontiers);
   WriteToRocksDB(&frontiers, &regular_write_batch, StorageDbType::kRegular);
+  RegularDbWriteApplied(yb::OpId::FromPB(data.op_id));
   return Status::OK();
 }
 
@@ -1662,6 +2091,10 @@ CHECKED_STATUS Tablet::RemoveIntentsImpl(const RemoveIntentsData& data, const Id
   docdb::ConsensusFrontiers frontiers;
   InitFrontiers(data, &frontiers);
   WriteToRocksDB(&frontiers, &intents_write_batch, StorageDbType::kIntents);
+  // Intents should be removed from the summary only after they were removed from the intents DB.
+  if (intents_summary_) {
+    intents_summary_->RemoveWriteBatch(intents_write_batch);
+  }
   return Status::OK();
 }
 
@@ -1767,6 +2200,10 @@ Status Tablet::AlterSchema(ChangeMetadataOperationState *operation_state) {
 
   metadata_->SetSchema(*operation_state->schema(), operation_state->index_map(), deleted_cols,
                        operation_state->schema_version());
+  // Cached rows could be read with the default TTL of the old schema.
+  if (row_cache_) {
+    row_cache_->Clear();
+  }
   if (operation_state->has_new_table_name()) {
     metadata_->SetTableName(operation_state->new_table_name());
     if (metric_entity_) {
@@ -1813,7 +2250,9 @@ bool Tablet::ShouldRetainDeleteMarkersInMajorCompaction() const {
 // Should backfill the index with the information contained in this tablet.
 // Assume that we are already in the Backfilling mode.
 Status Tablet::BackfillIndexes(const std::vector<IndexInfo> &indexes,
-                               HybridTime read_time) {
+                               HybridTime read_time,
+                               const std::string& start_key,
+                               const std::string& end_key) {
   if (PREDICT_FALSE(FLAGS_TEST_slowdown_backfill_by_ms > 0)) {
     TRACE("Sleeping for $0 ms", FLAGS_TEST_slowdown_backfill_by_ms);
     SleepFor(MonoDelta::FromMilliseconds(FLAGS_TEST_slowdown_backfill_by_ms));
@@ -1853,11 +2292,87 @@ Status Tablet::BackfillIndexes(const std::vector<IndexInfo> &indexes,
     }
   }
   Schema projection(columns, {}, schema()->num_key_columns());
-  auto iter =
-      VERIFY_RESULT(NewRowIterator(projection, boost::none, ReadHybridTime::SingleTime(read_time)));
+
+  if (!metadata_->partition_schema().IsHashPartitioning()) {
+    RETURN_NOT_OK(BackfillIndexesForHashRange(
+        indexes, projection, read_time, boost::none, boost::none, /* num_workers */ 1));
+    LOG(INFO) << "Done BackfillIndexes at " << read_time << " for "
+              << yb::ToString(indexes);
+    return Status::OK();
+  }
+
+  // Split the requested hash range of the tablet into disjoint ranges of similar size, each of
+  // them scanned and written to the index by its own worker.
+  const auto& partition = metadata_->partition();
+  const auto& range_start = start_key.empty() ? partition.partition_key_start() : start_key;
+  const auto& range_end = end_key.empty() ? partition.partition_key_end() : end_key;
+  const int32_t min_hash_code =
+      range_start.empty() ? 0 : PartitionSchema::DecodeMultiColumnHashValue(range_start);
+  const int32_t end_hash_code = range_end.empty()
+      ? PartitionSchema::kMaxPartitionKey + 1
+      : PartitionSchema::DecodeMultiColumnHashValue(range_end);
+  if (min_hash_code >= end_hash_code) {
+    // A master, that resumes backfill of an already finished tablet, could send an empty range.
+    LOG(INFO) << "Nothing to backfill in empty hash range [" << min_hash_code << ", "
+              << end_hash_code << ") for " << yb::ToString(indexes);
+    return Status::OK();
+  }
+  const int num_workers =
+      std::min(std::max(FLAGS_backfill_index_num_workers, 1), end_hash_code - min_hash_code);
+
+  std::vector<Status> statuses(num_workers);
+  std::vector<scoped_refptr<Thread>> threads;
+  auto worker_range_start = [min_hash_code, end_hash_code, num_workers](int worker) {
+    return min_hash_code + (end_hash_code - min_hash_code) * worker / num_workers;
+  };
+  auto run_worker = [&, this](int worker) {
+    statuses[worker] = BackfillIndexesForHashRange(
+        indexes, projection, read_time, worker_range_start(worker),
+        worker_range_start(worker + 1) - 1, num_workers);
+  };
+  for (int worker = 1; worker != num_workers; ++worker) {
+    scoped_refptr<Thread> thread;
+    statuses[worker] = Thread::Create(
+        "backfill", Format("backfill-$0-$1", tablet_id(), worker), run_worker, worker, &thread);
+    if (!statuses[worker].ok()) {
+      break;
+    }
+    threads.push_back(std::move(thread));
+  }
+  run_worker(0);
+  for (const auto& thread : threads) {
+    thread->Join();
+  }
+  for (const auto& status : statuses) {
+    RETURN_NOT_OK(status);
+  }
+
+  LOG(INFO) << "Done BackfillIndexes at " << read_time << " for "
+            << yb::ToString(indexes) << " in hash range [" << min_hash_code << ", "
+            << end_hash_code << ") using " << num_workers << " workers";
+  return Status::OK();
+}
+
+Status Tablet::BackfillIndexesForHashRange(
+    const std::vector<IndexInfo>& indexes, const Schema& projection, HybridTime read_time,
+    boost::optional<int32_t> min_hash_code, boost::optional<int32_t> max_hash_code,
+    int num_workers) {
+  auto iter = VERIFY_RESULT(CreateRowIterator(
+      projection, boost::none, ReadHybridTime::SingleTime(read_time), "" /* table_id */));
+  // The scan spec keeps a pointer to the hashed components, so they should outlive the iterator.
+  const std::vector<docdb::PrimitiveValue> hashed_components;
+  if (min_hash_code) {
+    const docdb::DocQLScanSpec spec(
+        *schema(), min_hash_code, max_hash_code, hashed_components,
+        nullptr /* req */, nullptr /* if_req */, rocksdb::kDefaultQueryId);
+    RETURN_NOT_OK(iter->Init(spec));
+  } else {
+    RETURN_NOT_OK(iter->Init());
+  }
 
   QLTableRow row;
-  std::vector<std::pair<const IndexInfo*, QLWriteRequestPB>> index_requests;
+  IndexBackfillBatch batch;
+  batch.num_workers = num_workers;
   int num_rows = 0;
   while (VERIFY_RESULT((*iter).HasNext())) {
     RETURN_NOT_OK((*iter).NextRow(&row));
@@ -1868,25 +2383,21 @@ Status Tablet::BackfillIndexes(const std::vector<IndexInfo> &indexes,
       VLOG(1) << "Processed " << num_rows << " rows";
     }
 
-    RETURN_NOT_OK(UpdateIndexInBatches(row, indexes, &index_requests));
+    RETURN_NOT_OK(UpdateIndexInBatches(row, indexes, &batch));
   }
   VLOG(1) << "Processed " << num_rows << " rows";
-  RETURN_NOT_OK(FlushIndexBatchIfRequired(&index_requests, /* forced */ true));
-  LOG(INFO) << "Done BackfillIndexes at " << read_time << " for "
-            << yb::ToString(indexes);
-  return Status::OK();
+  return FlushIndexBatchIfRequired(&batch, /* forced */ true);
 }
 
 Status Tablet::UpdateIndexInBatches(
-    const QLTableRow& row, const std::vector<IndexInfo>& indexes,
-    std::vector<std::pair<const IndexInfo*, QLWriteRequestPB>>* index_requests) {
+    const QLTableRow& row, const std::vector<IndexInfo>& indexes, IndexBackfillBatch* batch) {
   const QLTableRow kEmptyRow;
   QLExprExecutor expr_executor;
 
   for (const IndexInfo& index : indexes) {
     bool ignored_key_changed;
-    index_requests->emplace_back(&index, QLWriteRequestPB());
-    QLWriteRequestPB* index_request = &index_requests->back().second;
+    batch->requests.emplace_back(&index, QLWriteRequestPB());
+    QLWriteRequestPB* index_request = &batch->requests.back().second;
     index_request->set_type(QLWriteRequestPB::QL_STMT_INSERT);
     RETURN_NOT_OK(docdb::PrepareIndexWriteAndCheckIfIndexKeyChanged(
         &expr_executor, kEmptyRow, row, &index, index_request, &ignored_key_changed));
@@ -1894,11 +2405,11 @@ Status Tablet::UpdateIndexInBatches(
   }
 
   // Update the index write op.
-  return FlushIndexBatchIfRequired(index_requests, false);
+  return FlushIndexBatchIfRequired(batch, false);
 }
 
-Status Tablet::FlushIndexBatchIfRequired(
-    std::vector<std::pair<const IndexInfo*, QLWriteRequestPB>>* index_requests, bool force_flush) {
+Status Tablet::FlushIndexBatchIfRequired(IndexBackfillBatch* batch, bool force_flush) {
+  auto* index_requests = &batch->requests;
   if (!force_flush && index_requests->size() < FLAGS_backfill_index_write_batch_size) {
     return Status::OK();
   }
@@ -1961,9 +2472,10 @@ Status Tablet::FlushIndexBatchIfRequired(
 
   auto now = CoarseMonoClock::Now();
   if (FLAGS_backfill_index_rate_rows_per_sec > 0) {
-    auto duration_since_last_batch = MonoDelta(now - last_backfill_flush_at_);
+    auto duration_since_last_batch = MonoDelta(now - batch->last_flush_at);
     auto expected_duration_ms = MonoDelta::FromMilliseconds(
-        index_requests->size() * 1000 / FLAGS_backfill_index_rate_rows_per_sec);
+        index_requests->size() * 1000 * batch->num_workers /
+        FLAGS_backfill_index_rate_rows_per_sec);
     DVLOG(3) << "Duration since last batch " << duration_since_last_batch
              << " expected duration " << expected_duration_ms
              << " extra time so sleep: " << expected_duration_ms - duration_since_last_batch;
@@ -1971,7 +2483,7 @@ Status Tablet::FlushIndexBatchIfRequired(
       SleepFor(expected_duration_ms - duration_since_last_batch);
     }
   }
-  last_backfill_flush_at_ = now;
+  batch->last_flush_at = now;
 
   index_requests->clear();
   return Status::OK();
@@ -1987,6 +2499,244 @@ ScopedPendingOperationPause Tablet::PauseReadWriteOperations() {
   FATAL_ERROR("Unreachable code -- the previous block must always return");
 }
 
+ScopedPendingOperation Tablet::StartReadWriteOperation() const {
+  last_operation_time_.store(CoarseMonoClock::Now(), std::memory_order_release);
+  ScopedPendingOperation result(&pending_op_counter_);
+  if (result.ok()) {
+    return result;
+  }
+
+  // Operations are also disabled while the tablet is being hibernated, WakeUp waits for it.
+  auto status = const_cast<Tablet*>(this)->WakeUp();
+  if (!status.ok()) {
+    LOG_WITH_PREFIX(WARNING) << "Failed to wake up: " << status;
+    return result;
+  }
+  return ScopedPendingOperation(&pending_op_counter_);
+}
+
+MonoDelta Tablet::IdleTime() const {
+  return CoarseMonoClock::Now() - last_operation_time_.load(std::memory_order_acquire);
+}
+
+Status Tablet::Hibernate() {
+  if (transaction_participant_ || transaction_coordinator_) {
+    return STATUS(NotSupported, "Transactional tablets could not be hibernated");
+  }
+
+  // Waits for the current apply batch, that writes to RocksDB after its operations completed,
+  // and prevents new batches until the tablet is hibernated.
+  std::lock_guard<std::mutex> apply_batch_lock(apply_batch_mutex_);
+  std::lock_guard<std::mutex> hibernation_lock(hibernation_mutex_);
+  if (IsHibernated()) {
+    return Status::OK();
+  }
+  if (state_ != kOpen) {
+    return STATUS_FORMAT(IllegalState, "Tablet in wrong state: $0", state_);
+  }
+
+  auto op_pause = PauseReadWriteOperations();
+  RETURN_NOT_OK(op_pause);
+
+  // Check if tablet is in shutdown mode.
+  if (IsShutdownRequested()) {
+    return STATUS(IllegalState, "Tablet was shut down");
+  }
+
+  RETURN_NOT_OK(Flush(FlushMode::kSync));
+
+  {
+    std::lock_guard<rw_spinlock> lock(component_lock_);
+    // Memtables were just flushed, so don't flush them again while closing.
+    PreventCallbacksFromRocksDBs(true);
+    RETURN_NOT_OK(ResetRocksDBs());
+  }
+  hibernated_.store(true, std::memory_order_release);
+  if (metrics_) {
+    metrics_->hibernations->Increment();
+  }
+  LOG_WITH_PREFIX(INFO) << "Hibernated after being idle for " << IdleTime();
+
+  // Read/write operations stay disabled until the tablet is woken up, that could happen in another
+  // thread, so only the exclusive operation mutex is released here. See WakeUp.
+  op_pause.ReleaseMutexButKeepDisabled();
+  DCHECK(op_pause.status().ok());  // Ensure that op_pause stays in scope throughout this function.
+  return Status::OK();
+}
+
+Status Tablet::WakeUp() {
+  std::lock_guard<std::mutex> lock(hibernation_mutex_);
+  if (!IsHibernated()) {
+    return Status::OK();
+  }
+  if (IsShutdownRequested()) {
+    return STATUS(IllegalState, "Tablet was shut down");
+  }
+
+  auto start = MonoTime::Now();
+  RETURN_NOT_OK(OpenKeyValueTablet());
+  RETURN_NOT_OK(DoEnableCompactions());
+  hibernated_.store(false, std::memory_order_release);
+  // Enables operations disabled by Hibernate.
+  pending_op_counter_.Enable(false /* unlock */);
+
+  auto elapsed = MonoTime::Now().GetDeltaSince(start);
+  if (metrics_) {
+    metrics_->hibernation_wake_up_latency->Increment(elapsed.ToMicroseconds());
+  }
+  LOG_WITH_PREFIX(INFO) << "Woken up in " << elapsed;
+  return Status::OK();
+}
+
+namespace {
+
+bool IsTableFile(const std::string& file_name) {
+  uint64_t number;
+  rocksdb::FileType type;
+  return rocksdb::ParseFileName(file_name, &number, &type) &&
+         (type == rocksdb::kTableFile || type == rocksdb::kTableSBlockFile);
+}
+
+// Makes dest_dir a copy of source_dir, that contains a closed RocksDB instance. SST files are
+// immutable, so the ones already copied to dest_dir with the same size are kept.
+Status SyncRocksDBDir(Env* env, const std::string& source_dir, const std::string& dest_dir) {
+  RETURN_NOT_OK(env->CreateDirs(dest_dir));
+  const auto source_files = VERIFY_RESULT(env->GetChildren(source_dir, ExcludeDots::kTrue));
+  const auto dest_files = VERIFY_RESULT(env->GetChildren(dest_dir, ExcludeDots::kTrue));
+  const std::unordered_set<std::string> source_set(source_files.begin(), source_files.end());
+  const std::unordered_set<std::string> dest_set(dest_files.begin(), dest_files.end());
+
+  for (const auto& file : dest_files) {
+    if (!source_set.count(file)) {
+      RETURN_NOT_OK(env->DeleteFile(JoinPathSegments(dest_dir, file)));
+    }
+  }
+  for (const auto& file : source_files) {
+    const auto source_path = JoinPathSegments(source_dir, file);
+    const auto dest_path = JoinPathSegments(dest_dir, file);
+    if (dest_set.count(file)) {
+      if (IsTableFile(file) &&
+          VERIFY_RESULT(env->GetFileSize(source_path)) ==
+              VERIFY_RESULT(env->GetFileSize(dest_path))) {
+        continue;
+      }
+      RETURN_NOT_OK(env->DeleteFile(dest_path));
+    }
+    RETURN_NOT_OK(env_util::CopyFile(env, source_path, dest_path, WritableFileOptions()));
+  }
+  return env->SyncDir(dest_dir);
+}
+
+} // namespace
+
+Status Tablet::MoveRocksDB(const std::string& data_root_dir) {
+  std::lock_guard<std::mutex> move_lock(move_rocksdb_mutex_);
+  RETURN_NOT_OK(WakeUp());
+
+  const auto old_dir = metadata_->rocksdb_dir();
+  const auto new_dir = metadata_->RocksDBDirForDataRoot(data_root_dir);
+  if (new_dir == old_dir) {
+    return Status::OK();
+  }
+  Env* const env = metadata_->fs_manager()->env();
+  const auto snapshots_dir = TabletSnapshots::SnapshotsDirName(old_dir);
+  if (env->FileExists(snapshots_dir) &&
+      !VERIFY_RESULT(env->GetChildren(snapshots_dir, ExcludeDots::kTrue)).empty()) {
+    return STATUS(NotSupported, "Tablets with snapshots could not be moved");
+  }
+  const std::vector<std::string> suffixes = { "", kIntentsDBSuffix };
+  for (const auto& suffix : suffixes) {
+    for (const auto& dir : { new_dir + suffix, new_dir + suffix + ".tmp" }) {
+      if (env->FileExists(dir)) {
+        LOG_WITH_PREFIX(INFO) << "Deleting leftover of a previous move: " << dir;
+        RETURN_NOT_OK(env->DeleteRecursively(dir));
+      }
+    }
+  }
+  RETURN_NOT_OK(env->CreateDirs(DirName(new_dir)));
+  auto start = MonoTime::Now();
+
+  // Copy most of the data while the tablet is online, so only the files written after the
+  // checkpoints have to be copied while operations are paused.
+  {
+    auto scoped_operation = StartReadWriteOperation();
+    RETURN_NOT_OK(scoped_operation);
+    if (!regular_db_) {
+      return STATUS(IllegalState, "RocksDB is not open");
+    }
+    RETURN_NOT_OK(rocksdb::checkpoint::CreateCheckpoint(regular_db_.get(), new_dir));
+    if (intents_db_) {
+      RETURN_NOT_OK(rocksdb::checkpoint::CreateCheckpoint(
+          intents_db_.get(), new_dir + kIntentsDBSuffix));
+    }
+  }
+  LOG_WITH_PREFIX(INFO) << "Copied checkpoint to " << new_dir << " in "
+                        << MonoTime::Now().GetDeltaSince(start);
+
+  // Switches the directory of closed RocksDB instances.
+  auto switch_dir = [this, env, &old_dir, &new_dir, &suffixes]() -> Status {
+    for (const auto& suffix : suffixes) {
+      if (env->FileExists(old_dir + suffix)) {
+        RETURN_NOT_OK(SyncRocksDBDir(env, old_dir + suffix, new_dir + suffix));
+      }
+    }
+    metadata_->set_rocksdb_dir(new_dir);
+    auto status = metadata_->Flush();
+    if (!status.ok()) {
+      metadata_->set_rocksdb_dir(old_dir);
+    }
+    return status;
+  };
+
+  // Waits for the current apply batch and blocks new ones, like Hibernate.
+  std::lock_guard<std::mutex> apply_batch_lock(apply_batch_mutex_);
+  std::lock_guard<std::mutex> hibernation_lock(hibernation_mutex_);
+  start = MonoTime::Now();
+  if (IsHibernated()) {
+    // RocksDB is already closed and will be reopened in the new directory by WakeUp.
+    RETURN_NOT_OK(switch_dir());
+  } else {
+    auto op_pause = PauseReadWriteOperations();
+    RETURN_NOT_OK(op_pause);
+
+    // Check if tablet is in shutdown mode.
+    if (IsShutdownRequested()) {
+      return STATUS(IllegalState, "Tablet was shut down");
+    }
+
+    RETURN_NOT_OK(Flush(FlushMode::kSync));
+    {
+      std::lock_guard<rw_spinlock> lock(component_lock_);
+      PreventCallbacksFromRocksDBs(true);
+      RETURN_NOT_OK(ResetRocksDBs());
+    }
+    auto status = switch_dir();
+    // Reopens RocksDB in the new directory, or in the old one if the switch failed.
+    RETURN_NOT_OK(OpenKeyValueTablet());
+    RETURN_NOT_OK(DoEnableCompactions());
+    RETURN_NOT_OK(status);
+    DCHECK(op_pause.status().ok());  // Ensure that op_pause stays in scope throughout this block.
+  }
+  LOG_WITH_PREFIX(INFO) << "Moved RocksDB from " << old_dir << " to " << new_dir
+                        << ", operations were paused for " << MonoTime::Now().GetDeltaSince(start);
+
+  for (const auto& suffix : suffixes) {
+    if (env->FileExists(old_dir + suffix)) {
+      WARN_NOT_OK(metadata_->fs_manager()->DeleteRecursivelyThrottled(old_dir + suffix),
+                  Format("Failed to delete $0", old_dir + suffix));
+    }
+  }
+  if (env->FileExists(old_dir + kHotKeysFileSuffix)) {
+    WARN_NOT_OK(env->DeleteFile(old_dir + kHotKeysFileSuffix),
+                Format("Failed to delete $0", old_dir + kHotKeysFileSuffix));
+  }
+  if (env->FileExists(snapshots_dir)) {
+    WARN_NOT_OK(metadata_->fs_manager()->DeleteRecursivelyThrottled(snapshots_dir),
+                Format("Failed to delete $0", snapshots_dir));
+  }
+  return Status::OK();
+}
+
 Status Tablet::ModifyFlushedFrontier(
     const docdb::ConsensusFrontier& frontier,
     rocksdb::FrontierModificationMode mode) {
@@ -2046,6 +2796,7 @@ Status Tablet::Truncate(TruncateOperationState *state) {
     return Status::OK();
   }
 
+  RETURN_NOT_OK(WakeUp());
   auto op_pause = PauseReadWriteOperations();
   RETURN_NOT_OK(op_pause);
 
@@ -2138,6 +2889,11 @@ yb::OpId MaxPersistentOpIdForDb(rocksdb::DB* db, bool invalid_if_no_new_data) {
 }
 
 Result<DocDbOpIds> Tablet::MaxPersistentOpId(bool invalid_if_no_new_data) const {
+  if (invalid_if_no_new_data && IsHibernated()) {
+    // All data was flushed before hibernation, and a new write would wake the tablet up.
+    return DocDbOpIds{yb::OpId::Invalid(), yb::OpId::Invalid()};
+  }
+
   ScopedPendingOperation scoped_read_operation(&pending_op_counter_);
   RETURN_NOT_OK(scoped_read_operation);
 
@@ -2204,6 +2960,10 @@ Result<HybridTime> Tablet::MaxPersistentHybridTime() const {
 }
 
 Result<HybridTime> Tablet::OldestMutableMemtableWriteHybridTime() const {
+  if (IsHibernated()) {
+    return HybridTime::kMax;
+  }
+
   ScopedPendingOperation scoped_read_operation(&pending_op_counter_);
   RETURN_NOT_OK(scoped_read_operation);
 
@@ -2241,7 +3001,7 @@ void Tablet::DocDBDebugDump(vector<string> *lines) {
 }
 
 Status Tablet::TEST_SwitchMemtable() {
-  ScopedPendingOperation scoped_operation(&pending_op_counter_);
+  auto scoped_operation = StartReadWriteOperation();
   RETURN_NOT_OK(scoped_operation);
 
   if (regular_db_) {
@@ -2252,7 +3012,134 @@ Status Tablet::TEST_SwitchMemtable() {
   return Status::OK();
 }
 
-Status Tablet::StartDocWriteOperation(WriteOperation* operation) {
+bool Tablet::ShouldSampleHotKeys() const {
+  const auto sample_rate = FLAGS_tablet_hot_keys_sample_rate;
+  return hot_keys_sampler_ && sample_rate > 0 && RandomWithChance(sample_rate);
+}
+
+void Tablet::SampleHotKeys(const docdb::DocOperations& doc_ops) {
+  boost::container::small_vector<RefCntPrefix, 8> paths;
+  for (const auto& doc_op : doc_ops) {
+    paths.clear();
+    IsolationLevel ignored_isolation_level;
+    if (!doc_op->GetDocPaths(
+            docdb::GetDocPathsMode::kLock, &paths, &ignored_isolation_level).ok() ||
+        paths.empty()) {
+      continue;
+    }
+    // The last path is the most specific one, i.e. the primary key rather than the hash key.
+    hot_keys_sampler_->Add(paths.back().as_slice());
+  }
+}
+
+void Tablet::SampleHotKeys(const QLReadRequestPB& ql_read_request) {
+  // Only reads of a specific hash key are sampled, scans do not have a particular hot key.
+  if (ql_read_request.hashed_column_values().empty()) {
+    return;
+  }
+  const auto& schema = metadata_->schema();
+  std::vector<docdb::PrimitiveValue> hashed_components;
+  if (!docdb::QLKeyColumnValuesToPrimitiveValues(
+          ql_read_request.hashed_column_values(), schema, 0, schema.num_hash_key_columns(),
+          &hashed_components).ok()) {
+    return;
+  }
+  docdb::DocKey doc_key(ql_read_request.hash_code(), std::move(hashed_components));
+  hot_keys_sampler_->Add(doc_key.Encode().AsSlice());
+}
+
+namespace {
+
+bool IsWaitForConflicts(const Status& status) {
+  return TransactionError(status).value() == TransactionErrorCode::kWaitForConflicts;
+}
+
+} // namespace
+
+// Repeats the attempt of a doc write operation that waits for conflicting transactions.
+// Executed on the messenger thread pool, because conflict resolution blocks on transaction status
+// requests.
+class Tablet::DocWriteOperationRetryTask : public rpc::ThreadPoolTask {
+ public:
+  DocWriteOperationRetryTask(
+      Tablet* tablet, std::unique_ptr<WriteOperation> operation,
+      DocWriteOperationCallback callback)
+      : tablet_(tablet), operation_(std::move(operation)), callback_(std::move(callback)) {
+    tablet_->num_waiting_doc_writes_.fetch_add(1, std::memory_order_acq_rel);
+  }
+
+  void Run() override {
+    auto scoped_operation = tablet_->StartReadWriteOperation();
+    if (!scoped_operation.ok()) {
+      status_ = MoveStatus(scoped_operation);
+      return;
+    }
+    tablet_->AttemptDocWriteOperation(std::move(operation_), std::move(callback_));
+  }
+
+  void Done(const Status& status) override {
+    std::unique_ptr<DocWriteOperationRetryTask> self(this);
+    if (operation_) {
+      callback_(std::move(operation_), status.ok() ? status_ : status);
+    }
+    tablet_->num_waiting_doc_writes_.fetch_sub(1, std::memory_order_acq_rel);
+  }
+
+ private:
+  Tablet* const tablet_;
+  std::unique_ptr<WriteOperation> operation_;
+  DocWriteOperationCallback callback_;
+  Status status_;
+};
+
+void Tablet::StartDocWriteOperation(
+    std::unique_ptr<WriteOperation> operation, DocWriteOperationCallback callback) {
+  if (ShouldSampleHotKeys()) {
+    SampleHotKeys(operation->doc_ops());
+  }
+
+  auto wait_ms = FLAGS_wait_for_conflicting_transactions_ms;
+  // Retries are scheduled on the messenger of the client, so don't wait when it is not available.
+  if (wait_ms > 0 && client_future_.valid() &&
+      client_future_.wait_for(0s) == std::future_status::ready) {
+    operation->set_conflicts_wait_deadline(
+        std::min(operation->deadline(), CoarseMonoClock::now() + wait_ms * 1ms));
+  }
+
+  AttemptDocWriteOperation(std::move(operation), std::move(callback));
+}
+
+void Tablet::AttemptDocWriteOperation(
+    std::unique_ptr<WriteOperation> operation, DocWriteOperationCallback callback) {
+  auto status = DoStartDocWriteOperation(operation.get());
+  if (!IsWaitForConflicts(status)) {
+    callback(std::move(operation), status);
+    return;
+  }
+  if (IsShutdownRequested()) {
+    callback(std::move(operation), STATUS(Aborted, "Tablet is shutting down"));
+    return;
+  }
+
+  // Locks were released by DoStartDocWriteOperation, so conflicting transactions could proceed,
+  // and we check their status again after the poll interval.
+  auto delay = std::min<CoarseMonoClock::Duration>(
+      FLAGS_conflicting_transactions_poll_interval_ms * 1ms,
+      operation->conflicts_wait_deadline() - CoarseMonoClock::now());
+  auto* messenger = client_future_.get()->messenger();
+  auto* task = new DocWriteOperationRetryTask(this, std::move(operation), std::move(callback));
+  messenger->scheduler().Schedule([messenger, task](const Status& status) {
+    if (!status.ok()) {
+      task->Done(status);
+      return;
+    }
+    messenger->ThreadPool().Enqueue(task);
+  }, std::max<CoarseMonoClock::Duration>(delay, CoarseMonoClock::Duration::zero()));
+}
+
+Status Tablet::DoStartDocWriteOperation(WriteOperation* operation) {
+  ScopedOperationCostTracker cost_tracker(&metrics_->write_cost);
+
   auto write_batch = operation->request()->mutable_write_batch();
   const IsolationLevel isolation_level = VERIFY_RESULT(GetIsolationLevelFromPB(*write_batch));
   const RowMarkType row_mark_type = GetRowMarkTypeFromPB(*write_batch);
@@ -2285,11 +3172,12 @@ Status Tablet::StartDocWriteOperation(WriteOperation* operation) {
       auto now = clock_->Now();
       auto result = VERIFY_RESULT(docdb::ResolveOperationConflicts(
           operation->doc_ops(), now, doc_db(), partial_range_key_intents,
-          transaction_participant_.get()));
+          transaction_participant_.get(), operation->conflicts_wait_deadline()));
       if (now != result) {
         clock_->Update(result);
       }
     } else {
+      const auto num_read_pairs = write_batch->read_pairs_size();
       if (isolation_level == IsolationLevel::SERIALIZABLE_ISOLATION &&
           prepare_result.need_read_snapshot) {
         boost::container::small_vector<RefCntPrefix, 16> paths;
@@ -2309,10 +3197,17 @@ Status Tablet::StartDocWriteOperation(WriteOperation* operation) {
         }
       }
 
-      RETURN_NOT_OK(docdb::ResolveTransactionConflicts(
+      auto resolve_status = docdb::ResolveTransactionConflicts(
           operation->doc_ops(), *write_batch, clock_->Now(),
           read_time ? read_time.read : HybridTime::kMax, doc_db(), partial_range_key_intents,
-          transaction_participant_.get(), metrics_->transaction_conflicts.get()));
+          transaction_participant_.get(), metrics_->transaction_conflicts.get(),
+          operation->conflicts_wait_deadline());
+      if (IsWaitForConflicts(resolve_status)) {
+        // The attempt would be repeated, so drop read pairs that were added by it.
+        write_batch->mutable_read_pairs()->DeleteSubrange(
+            num_read_pairs, write_batch->read_pairs_size() - num_read_pairs);
+      }
+      RETURN_NOT_OK(resolve_status);
 
       if (!read_time) {
         auto safe_time = SafeTime(RequireLease::kTrue);
@@ -2420,6 +3315,51 @@ HybridTime Tablet::DoGetSafeTime(
   return mvcc_.SafeTime(min_allowed, deadline, ht_lease);
 }
 
+HybridTime Tablet::SafeTimeForPointRead(
+    HybridTime read_time, const TransactionMetadataPB& transaction_metadata,
+    const google::protobuf::RepeatedPtrField<QLReadRequestPB>& ql_batch,
+    const google::protobuf::RepeatedPtrField<PgsqlReadRequestPB>& pgsql_batch) {
+  // Try without waiting first, usually the safe time is already past the read time.
+  const auto now = CoarseMonoClock::now();
+  auto safe_time = DoGetSafeTime(RequireLease::kTrue, read_time, now);
+  if (safe_time.is_valid() || !FLAGS_point_reads_skip_safe_time_wait ||
+      !ht_lease_provider_) {
+    return safe_time;
+  }
+
+  auto min_allowed_lease = read_time.GetPhysicalValueMicros();
+  if (read_time.GetLogicalValue()) {
+    ++min_allowed_lease;
+  }
+  auto ht_lease = ht_lease_provider_(min_allowed_lease, now);
+  if (!ht_lease.lease.is_valid() || read_time > ht_lease.lease) {
+    return HybridTime::kInvalid;
+  }
+
+  // Operations that get hybrid time after this point are ordered after the read. Writes of the
+  // current leader with lower hybrid time hold locks on their keys until they are applied, so the
+  // read does not have to wait, when none of them locks the read keys. Other operations, e.g.
+  // truncate, snapshot restore or transaction apply, hold no locks, so the read waits for them.
+  clock_->Update(read_time);
+  if (mvcc_.HasPendingOperationsFromOtherPeer() || mvcc_.HasPendingOperationsWithoutLocks()) {
+    return HybridTime::kInvalid;
+  }
+  docdb::KeyValueWriteBatchPB read_intents;
+  auto status = CreateReadIntents(transaction_metadata, ql_batch, pgsql_batch, &read_intents);
+  if (!status.ok()) {
+    VLOG_WITH_PREFIX(2) << "Failed to create read intents: " << status;
+    return HybridTime::kInvalid;
+  }
+  auto conflicts = docdb::ReadConflictsWithLockedWrites(
+      read_intents.read_pairs(), UsePartialRangeKeyIntents(metadata_.get()),
+      &shared_lock_manager_);
+  if (!conflicts.ok() || *conflicts) {
+    return HybridTime::kInvalid;
+  }
+  TRACE("Point read does not wait for safe time");
+  return read_time;
+}
+
 HybridTime Tablet::UpdateHistoryCutoff(HybridTime proposed_cutoff) {
   std::lock_guard<std::mutex> lock(active_readers_mutex_);
   HybridTime allowed_cutoff;
@@ -2468,6 +3408,170 @@ void Tablet::ForceRocksDBCompactInTest() {
   }
 }
 
+namespace {
+
+// Data that expired before this time could be removed by a compaction, unless it is still
+// required by a read in progress.
+HybridTime ExpiredDataCutoff(server::Clock* clock) {
+  return server::HybridClock::AddPhysicalTimeToHybridTime(
+      clock->Now(), MonoDelta::FromSeconds(-FLAGS_timestamp_history_retention_interval_sec));
+}
+
+} // namespace
+
+size_t Tablet::ExpiredDataSize() const {
+  if (!ttl_expiry_index_) {
+    return 0;
+  }
+  return ttl_expiry_index_->ExpiredBytes(ExpiredDataCutoff(clock_.get()));
+}
+
+Status Tablet::CompactExpiredData() {
+  ScopedPendingOperation scoped_operation(&pending_op_counter_);
+  RETURN_NOT_OK(scoped_operation);
+  if (!ttl_expiry_index_ || !regular_db_) {
+    return Status::OK();
+  }
+
+  // Data that expires while the compaction is running is kept accounted, since the compaction
+  // could leave it in place.
+  const auto cutoff = ExpiredDataCutoff(clock_.get());
+  RETURN_NOT_OK(regular_db_->CompactRange(
+      rocksdb::CompactRangeOptions(), /* begin = */ nullptr, /* end = */ nullptr));
+  ttl_expiry_index_->RemoveExpired(cutoff);
+  return Status::OK();
+}
+
+uint64_t Tablet::OutOfBoundsSstFilesSize() const {
+  if ((key_bounds_.lower.empty() && key_bounds_.upper.empty()) ||
+      out_of_bounds_data_compacted_.load(std::memory_order_acquire)) {
+    return 0;
+  }
+  ScopedPendingOperation scoped_operation(&pending_op_counter_);
+  if (!scoped_operation.ok() || !regular_db_) {
+    return 0;
+  }
+
+  std::vector<rocksdb::LiveFileMetaData> files;
+  regular_db_->GetLiveFilesMetaData(&files);
+  uint64_t result = 0;
+  for (const auto& file : files) {
+    // Bounds are encoded DocKeys, so user keys could be compared with them directly.
+    if ((!key_bounds_.lower.empty() && Slice(file.smallest.key).compare(key_bounds_.lower) < 0) ||
+        (!key_bounds_.upper.empty() && Slice(file.largest.key).compare(key_bounds_.upper) >= 0)) {
+      result += file.total_size;
+    }
+  }
+  if (result == 0) {
+    out_of_bounds_data_compacted_.store(true, std::memory_order_release);
+  }
+  return result;
+}
+
+Status Tablet::CompactOutOfBoundsData() {
+  ScopedPendingOperation scoped_operation(&pending_op_counter_);
+  RETURN_NOT_OK(scoped_operation);
+  if (!regular_db_) {
+    return Status::OK();
+  }
+
+  LOG_WITH_PREFIX(INFO) << "Compacting regular DB to remove keys outside of " << key_bounds_;
+  RETURN_NOT_OK(regular_db_->CompactRange(
+      rocksdb::CompactRangeOptions(), /* begin = */ nullptr, /* end = */ nullptr));
+  out_of_bounds_data_compacted_.store(true, std::memory_order_release);
+  return Status::OK();
+}
+
+std::vector<std::string> Tablet::GetHotKeys() const {
+  return hot_keys_ ? hot_keys_->Get() : std::vector<std::string>();
+}
+
+void Tablet::WarmUpBlockCache(std::vector<std::string> keys) {
+  if (keys.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(warm_up_mutex_);
+  if (IsShutdownRequested() || warm_up_running_.load(std::memory_order_acquire)) {
+    return;
+  }
+  if (warm_up_thread_) {
+    warm_up_thread_->Join();
+    warm_up_thread_.reset();
+  }
+  warm_up_running_.store(true, std::memory_order_release);
+  auto warm_up = [this, keys = std::move(keys)] {
+    auto start = CoarseMonoClock::Now();
+    size_t num_seeks = 0;
+    {
+      ScopedPendingOperation scoped_operation(&pending_op_counter_);
+      if (scoped_operation.ok() && regular_db_) {
+        rocksdb::ReadOptions read_options;
+        read_options.fill_cache = true;
+        std::unique_ptr<rocksdb::Iterator> iter(regular_db_->NewIterator(read_options));
+        for (const auto& key : keys) {
+          if (IsShutdownRequested()) {
+            break;
+          }
+          iter->Seek(key);
+          ++num_seeks;
+          const auto max_seeks_per_sec = FLAGS_block_cache_warm_up_max_seeks_per_sec;
+          if (max_seeks_per_sec > 0) {
+            auto wait_until = start + std::chrono::microseconds(
+                num_seeks * 1000000 / max_seeks_per_sec);
+            auto now = CoarseMonoClock::Now();
+            if (wait_until > now) {
+              SleepFor(MonoDelta(wait_until - now));
+            }
+          }
+        }
+      }
+    }
+    LOG_WITH_PREFIX(INFO) << "Warmed up block cache with " << num_seeks << " of " << keys.size()
+                          << " keys in " << MonoDelta(CoarseMonoClock::Now() - start);
+    warm_up_running_.store(false, std::memory_order_release);
+  };
+  auto status = Thread::Create(
+      "tablet", Format("warm-up-$0", tablet_id()), std::move(warm_up), &warm_up_thread_);
+  if (!status.ok()) {
+    LOG_WITH_PREFIX(WARNING) << "Failed to start block cache warm up: " << status;
+    warm_up_running_.store(false, std::memory_order_release);
+  }
+}
+
+Status Tablet::PersistHotKeys() {
+  // Shutdown waits for this lock, so the file is not written after tablet data is deleted.
+  std::lock_guard<std::mutex> lock(hot_keys_persist_mutex_);
+  if (IsShutdownRequested()) {
+    return Status::OK();
+  }
+  auto keys = GetHotKeys();
+  if (keys.empty()) {
+    return Status::OK();
+  }
+  HotKeysPB pb;
+  for (auto& key : keys) {
+    pb.add_keys(std::move(key));
+  }
+  return pb_util::WritePBContainerToPath(
+      metadata_->fs_manager()->env(), metadata_->rocksdb_dir() + kHotKeysFileSuffix, pb,
+      pb_util::OVERWRITE, pb_util::NO_SYNC);
+}
+
+void Tablet::WarmUpBlockCacheFromPersistedKeys() {
+  Env* const env = metadata_->fs_manager()->env();
+  const auto path = metadata_->rocksdb_dir() + kHotKeysFileSuffix;
+  if (!hot_keys_ || !env->FileExists(path)) {
+    return;
+  }
+  HotKeysPB pb;
+  auto status = pb_util::ReadPBContainerFromPath(env, path, &pb);
+  if (!status.ok()) {
+    LOG_WITH_PREFIX(WARNING) << "Failed to read hot keys: " << status;
+    return;
+  }
+  WarmUpBlockCache(std::vector<std::string>(pb.keys().begin(), pb.keys().end()));
+}
+
 std::string Tablet::TEST_DocDBDumpStr(IncludeIntents include_intents) {
   if (!regular_db_) return "";
 
@@ -2645,6 +3749,37 @@ Status Tablet::CreateSubtablet(
   return snapshots_->CreateCheckpoint(metadata->rocksdb_dir());
 }
 
+Result<std::string> Tablet::GetEncodedMiddleSplitKey() {
+  auto pending_op = StartReadWriteOperation();
+  RETURN_NOT_OK(pending_op);
+
+  if (!metadata_->partition_schema().IsHashPartitioning()) {
+    return STATUS(NotSupported, "Only hash partitioned tablets could be split by middle key");
+  }
+
+  const auto middle_key = VERIFY_RESULT(regular_db_->GetMiddleKey());
+  docdb::DocKeyDecoder decoder(middle_key);
+  RETURN_NOT_OK(decoder.DecodeCotableId());
+  RETURN_NOT_OK(decoder.DecodePgtableId());
+  uint16_t hash_code;
+  if (!VERIFY_RESULT(decoder.DecodeHashCode(&hash_code))) {
+    return STATUS_FORMAT(IllegalState, "Middle key without hash code: $0",
+                         Slice(middle_key).ToDebugHexString());
+  }
+
+  // All keys with this hash code would belong to the second tablet.
+  auto split_key = PartitionSchema::EncodeMultiColumnHashValue(hash_code);
+  const auto& partition = metadata_->partition();
+  if (split_key <= partition.partition_key_start() ||
+      (!partition.partition_key_end().empty() && split_key >= partition.partition_key_end())) {
+    return STATUS_FORMAT(
+        IllegalState, "Middle hash code $0 does not split partition [$1, $2)", hash_code,
+        Slice(partition.partition_key_start()).ToDebugHexString(),
+        Slice(partition.partition_key_end()).ToDebugHexString());
+  }
+  return split_key;
+}
+
 Result<int64_t> Tablet::CountIntents() {
   ScopedPendingOperation pending_op(&pending_op_counter_);
   RETURN_NOT_OK(pending_op);
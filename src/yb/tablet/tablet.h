@@ -32,11 +32,13 @@
 #ifndef YB_TABLET_TABLET_H_
 #define YB_TABLET_TABLET_H_
 
+#include <functional>
 #include <iosfwd>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "yb/rocksdb/cache.h"
@@ -56,6 +58,9 @@
 #include "yb/docdb/docdb.h"
 #include "yb/docdb/docdb_compaction_filter.h"
 #include "yb/docdb/doc_operation.h"
+#include "yb/docdb/hot_keys.h"
+#include "yb/docdb/nexts_to_avoid_seek.h"
+#include "yb/docdb/intents_summary.h"
 #include "yb/docdb/ql_rocksdb_storage.h"
 #include "yb/docdb/shared_lock_manager.h"
 
@@ -94,9 +99,11 @@ namespace yb {
 class MemTracker;
 class MetricEntity;
 class RowChangeList;
+class Thread;
 
 namespace docdb {
 class ConsensusFrontier;
+class DocRowwiseIterator;
 }
 
 namespace log {
@@ -210,18 +217,29 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   CHECKED_STATUS EnableCompactions(ScopedPendingOperationPause* operation_pause);
 
+  // Backfills indexes from the rows of this tablet in the partition key range [start_key, end_key),
+  // empty keys stand for the bounds of the tablet. The hash range of a hash partitioned tablet is
+  // split between backfill_index_num_workers workers, that scan and write to the indexes
+  // concurrently.
   CHECKED_STATUS BackfillIndexes(const std::vector<IndexInfo> &indexes,
-                                 HybridTime read_time);
+                                 HybridTime read_time,
+                                 const std::string& start_key = std::string(),
+                                 const std::string& end_key = std::string());
 
   bool ShouldRetainDeleteMarkersInMajorCompaction() const;
 
+  // Index writes accumulated by a backfill worker.
+  struct IndexBackfillBatch {
+    std::vector<std::pair<const IndexInfo*, QLWriteRequestPB>> requests;
+    CoarseTimePoint last_flush_at;
+    // Number of workers sharing backfill_index_rate_rows_per_sec of the tablet.
+    int num_workers = 1;
+  };
+
   CHECKED_STATUS UpdateIndexInBatches(
-      const QLTableRow& row, const std::vector<IndexInfo>& indexes,
-      std::vector<std::pair<const IndexInfo*, QLWriteRequestPB>>* index_requests);
+      const QLTableRow& row, const std::vector<IndexInfo>& indexes, IndexBackfillBatch* batch);
 
-  CHECKED_STATUS FlushIndexBatchIfRequired(
-      std::vector<std::pair<const IndexInfo*, QLWriteRequestPB>>* index_requests,
-      bool force_flush = false);
+  CHECKED_STATUS FlushIndexBatchIfRequired(IndexBackfillBatch* batch, bool force_flush = false);
 
   // Mark that the tablet has finished bootstrapping.
   // This transitions from kBootstrapping to kOpen state.
@@ -237,6 +255,24 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   void CompleteShutdown(IsDropTable is_drop_table = IsDropTable::kFalse);
 
+  // Closes RocksDB instances of an idle tablet to release their memory, while Raft keeps running.
+  // RocksDB is reopened by the first following read or write operation, including applying a
+  // replicated write. Tablets with a transaction participant or coordinator are not supported.
+  CHECKED_STATUS Hibernate();
+
+  bool IsHibernated() const {
+    return hibernated_.load(std::memory_order_acquire);
+  }
+
+  // Time since the last read or write operation was started.
+  MonoDelta IdleTime() const;
+
+  // Moves RocksDB instances of the tablet to the given data root dir, that is usually on another
+  // drive, while the tablet stays online. Files are first copied using a checkpoint, then
+  // operations are paused while the files written since the checkpoint are copied and RocksDB is
+  // reopened in the new directory. Tablets with snapshots are not supported.
+  CHECKED_STATUS MoveRocksDB(const std::string& data_root_dir);
+
   CHECKED_STATUS ImportData(const std::string& source_dir);
 
   CHECKED_STATUS ApplyIntents(const TransactionApplyData& data) override;
@@ -290,6 +326,28 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
       rocksdb::WriteBatch* write_batch,
       docdb::StorageDbType storage_db_type);
 
+  // Starts batching of applied Raft write operations on the current thread. Until
+  // FinishApplyBatch, non-transactional writes to the regular DB are accumulated in a single
+  // RocksDB write batch, and steps that make applied operations visible, registered with
+  // RunAfterApplyBatch, are deferred. Operations applied by other threads wait for the batch to
+  // finish.
+  void StartApplyBatch();
+
+  // Writes accumulated batch to RocksDB, then runs deferred steps in the order they were added.
+  void FinishApplyBatch();
+
+  // Runs fn after the current apply batch is written, or immediately if the current thread does
+  // not have an active apply batch.
+  void RunAfterApplyBatch(std::function<void()> fn);
+
+  // Waits until apply batch started by another thread is finished, so operations are applied in
+  // Raft order.
+  void WaitForApplyBatch();
+
+  bool InApplyBatch() const {
+    return apply_batch_thread_.load(std::memory_order_acquire) == std::this_thread::get_id();
+  }
+
   //------------------------------------------------------------------------------------------------
   // Redis Request Processing.
   // Takes a Redis WriteRequestPB as input with its redis_write_batch.
@@ -300,7 +358,7 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // operations to same/conflicting part of the key/sub-key space. The locks acquired are returned
   // via the 'keys_locked' vector, so that they may be unlocked later when the operation has been
   // committed.
-  CHECKED_STATUS KeyValueBatchFromRedisWriteBatch(WriteOperation* operation);
+  void KeyValueBatchFromRedisWriteBatch(std::unique_ptr<WriteOperation> operation);
 
   CHECKED_STATUS HandleRedisReadRequest(
       CoarseTimePoint deadline,
@@ -337,7 +395,7 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
       const PgsqlReadRequestPB& pgsql_read_request, const size_t row_count,
       PgsqlResponsePB* response) const override;
 
-  CHECKED_STATUS KeyValueBatchFromPgsqlWriteBatch(WriteOperation* operation);
+  void KeyValueBatchFromPgsqlWriteBatch(std::unique_ptr<WriteOperation> operation);
 
   // Create a new row iterator which yields the rows as of the current MVCC
   // state of this tablet.
@@ -407,6 +465,17 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // Set the conter to at least 'value'.
   void UpdateMonotonicCounter(int64_t value);
 
+  // Returns the op id of the latest write operation applied to the regular DB in a term before
+  // `term`, or an invalid op id if there was no such write since the tablet was opened. Used to
+  // find out whether leaders of other terms wrote to the tablet.
+  OpId LastRegularDbWriteBeforeTerm(int64_t term) const;
+
+  // Incremented each time the content of the regular DB is replaced as a whole, i.e. when the DB
+  // is reopened, e.g. after truncation or snapshot restore, and when data is imported into it.
+  int64_t regular_db_generation() const {
+    return regular_db_generation_.load(std::memory_order_acquire);
+  }
+
   const RaftGroupMetadata *metadata() const { return metadata_.get(); }
   RaftGroupMetadata *metadata() { return metadata_.get(); }
 
@@ -416,6 +485,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // May be NULL in unit tests, etc.
   TabletMetrics* metrics() { return metrics_.get(); }
 
+  // Returns the sample of the most frequently accessed keys of this tablet, or nullptr when
+  // sampling is disabled.
+  HotKeysSampler* hot_keys_sampler() const { return hot_keys_sampler_.get(); }
+
   // Return handle to the metric entity of this tablet.
   const scoped_refptr<MetricEntity>& GetMetricEntity() const { return metric_entity_; }
 
@@ -440,6 +513,12 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // is empty.
   Result<HybridTime> OldestMutableMemtableWriteHybridTime() const;
 
+  // Makes the next write report the oldest mutable memtable write to
+  // TabletOptions::memtable_write_listener.
+  void ResetMemtableWriteReported() {
+    memtable_write_reported_.store(false, std::memory_order_release);
+  }
+
   // For non-kudu table type fills key-value batch in transaction state request and updates
   // request in state. Due to acquiring locks it can block the thread.
   void AcquireLocksAndPerformDocOperations(std::unique_ptr<WriteOperation> operation);
@@ -480,7 +559,40 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   void ForceRocksDBCompactInTest();
 
-  docdb::DocDB doc_db() const { return { regular_db_.get(), intents_db_.get(), &key_bounds_ }; }
+  // Returns the size of data written with TTL that expired before the history cutoff, so it could
+  // be removed by a compaction. Returns 0 if expiry of data is not tracked for this tablet.
+  size_t ExpiredDataSize() const;
+
+  // Compacts the regular DB to remove data that is known to be expired.
+  CHECKED_STATUS CompactExpiredData();
+
+  // Returns the size of SST files of the regular DB that contain keys outside of the key bounds of
+  // the tablet. Such files are shared with the parent tablet after split, until compacted.
+  uint64_t OutOfBoundsSstFilesSize() const;
+
+  // Compacts the regular DB, so the compaction filter removes keys outside of the key bounds.
+  CHECKED_STATUS CompactOutOfBoundsData();
+
+  // Returns a sample of recently read keys, most recent first. Sent by the old leader to the new
+  // leader on leadership transfer.
+  std::vector<std::string> GetHotKeys() const;
+
+  // Asynchronously seeks the regular DB to the specified keys, so blocks containing them are
+  // loaded to the block cache. Does nothing if a previous warm up is still running.
+  void WarmUpBlockCache(std::vector<std::string> keys);
+
+  // Writes the sample of recently read keys next to the regular DB, so the block cache could be
+  // warmed up with them after restart. Does nothing if no keys were sampled or shutdown was
+  // requested.
+  CHECKED_STATUS PersistHotKeys();
+
+  // Starts warm up of the block cache with keys written by PersistHotKeys, if there are any.
+  void WarmUpBlockCacheFromPersistedKeys();
+
+  docdb::DocDB doc_db() const {
+    return { regular_db_.get(), intents_db_.get(), &key_bounds_, intents_summary_.get(),
+             hot_keys_.get(), &nexts_to_avoid_seek_stats_ };
+  }
 
   std::string TEST_DocDBDumpStr(IncludeIntents include_intents = IncludeIntents::kFalse);
 
@@ -488,12 +600,28 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   size_t TEST_CountRegularDBRecords();
 
+  void TEST_RecordHotKey(const Slice& key) {
+    if (hot_keys_) {
+      hot_keys_->Record(key);
+    }
+  }
+
   CHECKED_STATUS CreateReadIntents(
       const TransactionMetadataPB& transaction_metadata,
       const google::protobuf::RepeatedPtrField<QLReadRequestPB>& ql_batch,
       const google::protobuf::RepeatedPtrField<PgsqlReadRequestPB>& pgsql_batch,
       docdb::KeyValueWriteBatchPB* out);
 
+  // Returns the safe time for a leader point read at read_time without waiting for it. When the
+  // safe time is not past read_time yet, returns read_time if none of the read keys is locked by
+  // an in-flight write and no other operation is pending, since such writes are the only ones the
+  // read could miss. Otherwise returns invalid hybrid time, and the read should wait for the safe
+  // time.
+  HybridTime SafeTimeForPointRead(
+      HybridTime read_time, const TransactionMetadataPB& transaction_metadata,
+      const google::protobuf::RepeatedPtrField<QLReadRequestPB>& ql_batch,
+      const google::protobuf::RepeatedPtrField<PgsqlReadRequestPB>& pgsql_batch);
+
   uint64_t GetCurrentVersionSstFilesSize() const;
   uint64_t GetCurrentVersionSstFilesUncompressedSize() const;
   uint64_t GetCurrentVersionNumSSTFiles() const;
@@ -521,6 +649,15 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   bool ShouldApplyWrite();
 
+  // Log-only peer keeps the Raft log, but does not write replicated operations to its DocDB.
+  void SetLogOnly(bool value) {
+    log_only_.store(value, std::memory_order_release);
+  }
+
+  bool log_only() const {
+    return log_only_.load(std::memory_order_acquire);
+  }
+
   rocksdb::DB* TEST_db() const {
     return regular_db_.get();
   }
@@ -546,6 +683,11 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
       const TabletId& tablet_id, const Partition& partition,
       const docdb::KeyBounds& key_bounds);
 
+  // Returns the partition key, that could be used to split this tablet into two tablets with about
+  // the same amount of data. The key is chosen from the middle of the data index of the largest
+  // SST file. Only hash partitioned tablets are supported.
+  Result<std::string> GetEncodedMiddleSplitKey();
+
   // Scans the intent db. Potentially takes a long time. Used for testing/debugging.
   Result<int64_t> CountIntents();
 
@@ -581,9 +723,53 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   FRIEND_TEST(TestTablet, TestGetLogRetentionSizeForIndex);
 
-  CHECKED_STATUS StartDocWriteOperation(WriteOperation* operation);
+  typedef std::function<void(std::unique_ptr<WriteOperation>, const Status&)>
+      DocWriteOperationCallback;
+
+  class DocWriteOperationRetryTask;
+
+  // Prepares the write batch of operation from its doc operations, and invokes callback with the
+  // result. While wait_for_conflicting_transactions_ms did not pass and conflicting transactions
+  // are pending, locks are released and the attempt is repeated after
+  // conflicting_transactions_poll_interval_ms, so callback could be invoked from another thread.
+  void StartDocWriteOperation(
+      std::unique_ptr<WriteOperation> operation, DocWriteOperationCallback callback);
+
+  void AttemptDocWriteOperation(
+      std::unique_ptr<WriteOperation> operation, DocWriteOperationCallback callback);
+
+  // A single attempt of StartDocWriteOperation.
+  CHECKED_STATUS DoStartDocWriteOperation(WriteOperation* operation);
+
+  static void CompleteRedisWriteBatch(
+      std::unique_ptr<WriteOperation> operation, const Status& status);
+
+  CHECKED_STATUS PgsqlWriteBatchToDocOperations(WriteOperation* operation);
+
+  static void CompletePgsqlWriteBatch(
+      std::unique_ptr<WriteOperation> operation, const Status& status);
+
+  // Returns true if the next accessed keys should be added to hot_keys_sampler_.
+  bool ShouldSampleHotKeys() const;
+
+  void SampleHotKeys(const docdb::DocOperations& doc_ops);
+
+  void SampleHotKeys(const QLReadRequestPB& ql_read_request);
 
   CHECKED_STATUS OpenKeyValueTablet();
+
+  // Backfills indexes from the rows in the inclusive hash code range [min_hash_code,
+  // max_hash_code], or from all rows of the tablet when the hash codes are not specified.
+  CHECKED_STATUS BackfillIndexesForHashRange(
+      const std::vector<IndexInfo>& indexes, const Schema& projection, HybridTime read_time,
+      boost::optional<int32_t> min_hash_code, boost::optional<int32_t> max_hash_code,
+      int num_workers);
+
+  // Creates the iterator returned by NewRowIterator, without initializing it.
+  Result<std::unique_ptr<docdb::DocRowwiseIterator>> CreateRowIterator(
+      const Schema& projection, const boost::optional<TransactionId>& transaction_id,
+      const ReadHybridTime read_hybrid_time, const TableId& table_id) const;
+
   virtual CHECKED_STATUS CreateTabletDirectories(const string& db_dir, FsManager* fs);
 
   void DocDBDebugDump(std::vector<std::string> *lines);
@@ -599,6 +785,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
       HybridTime hybrid_time,
       rocksdb::WriteBatch* rocksdb_write_batch);
 
+  // Records that the write operation with the specified op id was applied to the regular DB.
+  void RegularDbWriteApplied(const OpId& op_id);
+
   Result<TransactionOperationContextOpt> CreateTransactionOperationContext(
       const TransactionMetadataPB& transaction_metadata,
       bool is_ysql_catalog_table) const;
@@ -610,6 +799,12 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // Pause any new read/write operations and wait for all pending read/write operations to finish.
   ScopedPendingOperationPause PauseReadWriteOperations();
 
+  // Starts a shared-ownership read/write operation, waking up the tablet if it is hibernated.
+  ScopedPendingOperation StartReadWriteOperation() const;
+
+  // Reopens RocksDB of a hibernated tablet, does nothing if the tablet is not hibernated.
+  CHECKED_STATUS WakeUp();
+
   CHECKED_STATUS ResetRocksDBs(bool destroy = false);
 
   CHECKED_STATUS DoEnableCompactions();
@@ -699,6 +894,34 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   std::unique_ptr<rocksdb::DB> intents_db_;
 
+  // Summary of strong write intents in intents_db_, see docdb::IntentsSummary.
+  std::unique_ptr<docdb::IntentsSummary> intents_summary_;
+
+  // Sample of recently read keys, see docdb::HotKeys.
+  std::unique_ptr<docdb::HotKeys> hot_keys_;
+
+  // Cache of rows read by YCQL point reads, see docdb::RowCache.
+  std::unique_ptr<docdb::RowCache> row_cache_;
+
+  // Number of nexts tried before a seek learned by iterators of this tablet.
+  mutable docdb::NextsToAvoidSeekStats nexts_to_avoid_seek_stats_;
+
+  std::mutex warm_up_mutex_;
+  scoped_refptr<Thread> warm_up_thread_ GUARDED_BY(warm_up_mutex_);
+  std::atomic<bool> warm_up_running_{false};
+
+  // Serializes PersistHotKeys with shutdown, so hot keys are not written after shutdown.
+  std::mutex hot_keys_persist_mutex_;
+
+  // Set after the regular DB of a split tablet was compacted to remove keys outside of the key
+  // bounds, so SST files are not checked for such keys anymore.
+  std::atomic<bool> out_of_bounds_data_compacted_{false};
+
+  // Created only for Redis tablets, where data is commonly written with TTL.
+  std::unique_ptr<TtlExpiryIndex> ttl_expiry_index_;
+
+  std::unique_ptr<HotKeysSampler> hot_keys_sampler_;
+
   // Optional key bounds (see docdb::KeyBounds) served by this tablet.
   docdb::KeyBounds key_bounds_;
 
@@ -714,6 +937,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // prevent race conditions between destroying the RocksDB instance and read/write operations.
   std::atomic_bool shutdown_requested_{false};
 
+  // Number of writes that released their locks to wait for conflicting transactions, and would be
+  // retried by DocWriteOperationRetryTask. Shutdown waits for them to complete.
+  std::atomic<int64_t> num_waiting_doc_writes_{0};
+
   // This is a special atomic counter per tablet that increases monotonically.
   // It is like timestamp, but doesn't need locks to read or update.
   // This is raft replicated as well. Each replicate message contains the current number.
@@ -746,12 +973,53 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   std::atomic<int64_t> last_committed_write_index_{0};
 
+  // Op id of the latest write operation applied to the regular DB, and op id of the latest write
+  // operation applied in a term before the term of that write.
+  mutable simple_spinlock regular_db_writes_lock_;
+  OpId last_regular_db_write_ GUARDED_BY(regular_db_writes_lock_) = OpId::Invalid();
+  OpId last_regular_db_write_of_previous_term_ GUARDED_BY(regular_db_writes_lock_) =
+      OpId::Invalid();
+
+  std::atomic<int64_t> regular_db_generation_{0};
+
+  // Whether the oldest memtable write was reported to TabletOptions::memtable_write_listener.
+  std::atomic<bool> memtable_write_reported_{false};
+
+  // State of the apply batch, see StartApplyBatch. Everything except apply_batch_thread_ is
+  // accessed only by the thread that owns the batch.
+  std::mutex apply_batch_mutex_;
+  std::unique_lock<std::mutex> apply_batch_lock_;
+  std::atomic<std::thread::id> apply_batch_thread_{std::thread::id()};
+  rocksdb::WriteBatch apply_batch_write_batch_;
+  std::unique_ptr<rocksdb::UserFrontiers> apply_batch_frontiers_;
+  std::vector<std::function<void()>> apply_batch_deferred_;
+
+  std::atomic<bool> log_only_{false};
+
+  // Serializes hibernation with wake up and shutdown, see Hibernate.
+  std::mutex hibernation_mutex_;
+  std::atomic<bool> hibernated_{false};
+  mutable std::atomic<CoarseTimePoint> last_operation_time_{CoarseMonoClock::Now()};
+
+  // Serializes moves of RocksDB directories, see MoveRocksDB.
+  std::mutex move_rocksdb_mutex_;
+
   HybridTimeLeaseProvider ht_lease_provider_;
 
   HybridTime DoGetSafeTime(
       RequireLease require_lease, HybridTime min_allowed, CoarseTimePoint deadline) const override;
 
+  // Index write ops and the responses of the writes they were produced by.
+  typedef std::vector<std::pair<std::shared_ptr<client::YBqlWriteOp>, QLResponsePB*>> IndexOps;
+
   void UpdateQLIndexes(std::unique_ptr<WriteOperation> operation);
+
+  // Returns the status of the flush of index writes, and propagates their errors and the result of
+  // the child transaction to the responses of the writes they were produced by.
+  static CHECKED_STATUS ProcessIndexUpdateResponses(
+      const Status& flush_status, client::YBSession* session, client::YBTransaction* txn,
+      const IndexOps& index_ops);
+
   void CompleteQLWriteBatch(std::unique_ptr<WriteOperation> operation, const Status& status);
 
   Result<bool> IntentsDbFlushFilter(const rocksdb::MemTable& memtable);
@@ -779,7 +1047,6 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   IsSysCatalogTablet is_sys_catalog_;
   TransactionsEnabled txns_enabled_;
-  CoarseTimePoint last_backfill_flush_at_;
 
   std::unique_ptr<ThreadPoolToken> cleanup_intent_files_token_;
 
@@ -46,6 +46,8 @@
 #include "yb/util/tostring.h"
 #include "yb/tablet/tablet_options.h"
 
+DECLARE_bool(bootstrap_pipeline_log_reads);
+
 using std::shared_ptr;
 using std::string;
 using std::vector;
@@ -365,5 +367,32 @@ TEST_F(BootstrapTest, TestBootstrapHighOpIdIndex) {
   ASSERT_OPID_EQ(last_opid, boot_info.last_committed_id);
 }
 
+// Test bootstrap of a log with multiple segments, that are read in background while the previous
+// segment is replayed.
+TEST_F(BootstrapTest, TestBootstrapMultipleSegments) {
+  google::FlagSaver flag_saver;
+  FLAGS_bootstrap_pipeline_log_reads = true;
+  const int kNumSegments = 4;
+  const int kEntriesPerSegment = 5;
+  BuildLog();
+  for (int i = 0; i < kNumSegments; i++) {
+    AppendReplicateBatchToLog(kEntriesPerSegment);
+    ASSERT_OK(RollLog());
+  }
+
+  TabletPtr tablet;
+  ConsensusBootstrapInfo boot_info;
+  ASSERT_OK(BootstrapTestTablet(&tablet, &boot_info));
+  OpId last_opid;
+  last_opid.set_term(1);
+  last_opid.set_index(current_index_ - 1);
+  ASSERT_OPID_EQ(last_opid, boot_info.last_id);
+  ASSERT_OPID_EQ(last_opid, boot_info.last_committed_id);
+
+  vector<string> results;
+  IterateTabletRows(tablet.get(), &results);
+  ASSERT_EQ(kNumSegments * kEntriesPerSegment, results.size());
+}
+
 } // namespace tablet
 } // namespace yb
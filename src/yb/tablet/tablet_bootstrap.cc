@@ -34,6 +34,7 @@
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/log_reader.h"
+#include "yb/consensus/quorum_util.h"
 #include "yb/consensus/retryable_requests.h"
 
 #include "yb/server/hybrid_clock.h"
@@ -51,6 +52,7 @@
 #include "yb/util/logging.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/stopwatch.h"
+#include "yb/util/thread.h"
 #include "yb/util/env_util.h"
 #include "yb/consensus/log_index.h"
 #include "yb/docdb/consensus_frontier.h"
@@ -81,6 +83,18 @@ DEFINE_bool(skip_flushed_entries, true,
             "Only replay WAL entries that are not flushed to RocksDB or within the retryable "
             "request timeout.");
 
+DEFINE_bool(skip_flushed_entries_in_retryable_requests_window, false,
+            "When skip_flushed_entries is set, also skip flushed WAL entries that are within the "
+            "retryable request timeout, so only entries after the flushed frontiers of regular "
+            "and intents RocksDB are replayed. Speeds up bootstrap, but writes retried by "
+            "clients after the restart are not detected as duplicates.");
+TAG_FLAG(skip_flushed_entries_in_retryable_requests_window, advanced);
+
+DEFINE_bool(bootstrap_pipeline_log_reads, false,
+            "Read and decode the next WAL segment in background while the entries of the current "
+            "segment are replayed during tablet bootstrap.");
+TAG_FLAG(bootstrap_pipeline_log_reads, advanced);
+
 DECLARE_int32(retryable_request_timeout_secs);
 
 DEFINE_uint64(transaction_status_tablet_log_segment_size_bytes, 4_MB,
@@ -437,6 +451,13 @@ Result<bool> TabletBootstrap::OpenTablet() {
   // operation like RestoreSnapshot or Truncate. However, those operations can't really be happening
   // concurrently as we haven't opened the tablet yet.
   RETURN_NOT_OK(has_ss_tables);
+  // Log-only peer should not write operations replayed from the log to its DocDB. It stays
+  // log-only until remote bootstrap, even when the config lists it as a full replica.
+  if (!meta_->log_only() && consensus::IsRaftConfigLogOnlyMember(
+          meta_->fs_manager()->uuid(), cmeta_->committed_config())) {
+    RETURN_NOT_OK(meta_->set_log_only());
+  }
+  tablet->SetLogOnly(meta_->log_only());
   tablet_ = std::move(tablet);
   return has_ss_tables.get();
 }
@@ -881,7 +902,9 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
 
         // Previous segment would have op_id and time less than required,
         // so we can ignore it.
-        if (op_id <= op_id_replay_lowest && time <= last_time - retain_limit) {
+        if (op_id <= op_id_replay_lowest &&
+            (FLAGS_skip_flushed_entries_in_retryable_requests_window ||
+             time <= last_time - retain_limit)) {
           LOG(INFO) << "Bootstrap optimizer, found first mandatory segment op id: " << op_id
                     << ", time: " << time.ToString() << ", last time: " << last_time.ToString()
                     << ", number of segments to be skipped: " << (iter - segments.begin());
@@ -893,10 +916,34 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
 
   yb::OpId last_committed_op_id;
   RestartSafeCoarseTimePoint last_entry_time;
+  // Thread that reads the next segment while the current segment is replayed, and its result.
+  // Read errors are returned in the status of the result.
+  scoped_refptr<Thread> next_read_thread;
+  log::ReadEntriesResult next_read_result;
+  auto join_next_read = ScopeExit([&next_read_thread] {
+    if (next_read_thread) {
+      WARN_NOT_OK(ThreadJoiner(next_read_thread.get()).Join(),
+                  "Failed to join bootstrap log read thread");
+    }
+  });
   for (; iter != segments.end(); ++iter) {
     const scoped_refptr<ReadableLogSegment>& segment = *iter;
 
-    auto read_result = segment->ReadEntries();
+    log::ReadEntriesResult read_result;
+    if (next_read_thread) {
+      RETURN_NOT_OK(ThreadJoiner(next_read_thread.get()).Join());
+      next_read_thread = nullptr;
+      read_result = std::move(next_read_result);
+    } else {
+      read_result = segment->ReadEntries();
+    }
+    if (FLAGS_bootstrap_pipeline_log_reads && iter + 1 != segments.end()) {
+      scoped_refptr<ReadableLogSegment> next_segment = *(iter + 1);
+      RETURN_NOT_OK(Thread::Create(
+          "tablet", "bootstrap_log_read", [next_segment, &next_read_result] {
+            next_read_result = next_segment->ReadEntries();
+          }, &next_read_thread));
+    }
     last_committed_op_id = std::max(last_committed_op_id, read_result.committed_op_id);
     for (int entry_idx = 0; entry_idx < read_result.entries.size(); ++entry_idx) {
       Status s = HandleEntry(
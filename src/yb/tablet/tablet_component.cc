@@ -20,6 +20,14 @@ ScopedPendingOperationPause TabletComponent::PauseReadWriteOperations() {
   return tablet_.PauseReadWriteOperations();
 }
 
+ScopedPendingOperation TabletComponent::StartReadWriteOperation() {
+  return tablet_.StartReadWriteOperation();
+}
+
+Status TabletComponent::WakeUp() {
+  return tablet_.WakeUp();
+}
+
 Status TabletComponent::ResetRocksDBs(bool destroy) {
   return tablet_.ResetRocksDBs(destroy);
 }
@@ -32,6 +32,10 @@ class TabletComponent {
  protected:
   ScopedPendingOperationPause PauseReadWriteOperations();
 
+  ScopedPendingOperation StartReadWriteOperation();
+
+  CHECKED_STATUS WakeUp();
+
   CHECKED_STATUS ResetRocksDBs(bool destroy = false);
 
   CHECKED_STATUS OpenRocksDBs();
@@ -22,6 +22,7 @@ namespace yb {
 namespace tablet {
 
 class AbstractTablet;
+class FinalTransactionStatusCache;
 
 class OperationDriver;
 typedef scoped_refptr<OperationDriver> OperationDriverPtr;
@@ -32,6 +33,7 @@ typedef scoped_refptr<RaftGroupMetadata> RaftGroupMetadataPtr;
 class Tablet;
 typedef std::shared_ptr<Tablet> TabletPtr;
 
+class HotKeysSampler;
 class TabletPeer;
 typedef std::shared_ptr<TabletPeer> TabletPeerPtr;
 
@@ -39,6 +41,7 @@ class SnapshotOperationState;
 class TabletSnapshots;
 class TabletStatusPB;
 class TabletStatusListener;
+class TtlExpiryIndex;
 class TransactionIntentApplier;
 class TransactionParticipant;
 class TransactionParticipantContext;
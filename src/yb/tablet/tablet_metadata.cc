@@ -56,6 +56,7 @@
 #include "yb/tablet/tablet_options.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/flag_tags.h"
+#include "yb/util/hash_util.h"
 #include "yb/util/logging.h"
 #include "yb/util/pb_util.h"
 #include "yb/util/random.h"
@@ -82,6 +83,7 @@ namespace tablet {
 const int64 kNoDurableMemStore = -1;
 const std::string kIntentsSubdir = "intents";
 const std::string kIntentsDBSuffix = ".intents";
+const std::string kHotKeysFileSuffix = ".hot_keys";
 
 // ============================================================================
 //  Raft group metadata
@@ -242,7 +244,7 @@ Status RaftGroupMetadata::CreateNew(FsManager* fs_manager,
                                  const bool colocated) {
 
   // Verify that no existing Raft group exists with the same ID.
-  if (fs_manager->env()->FileExists(fs_manager->GetRaftGroupMetadataPath(raft_group_id))) {
+  if (fs_manager->MetadataFileExists(fs_manager->GetRaftGroupMetadataPath(raft_group_id))) {
     return STATUS(AlreadyPresent, "Raft group already exists", raft_group_id);
   }
 
@@ -386,8 +388,16 @@ Status RaftGroupMetadata::DeleteTabletData(TabletDataState delete_type,
       &rocksdb_options, log_prefix, nullptr /* statistics */, tablet_options);
 
   const auto& rocksdb_dir = kv_store_.rocksdb_dir;
+  // Throttles deletion of SST files, so it does not stall other tablets on the same drive.
+  rocksdb_options.sst_file_manager = fs_manager_->GetSstFileManager(rocksdb_dir);
+  const auto cold_dir = cold_rocksdb_dir();
   LOG(INFO) << "Destroying regular db at: " << rocksdb_dir;
+  docdb::SetColdStoragePath(rocksdb_dir, cold_dir, &rocksdb_options);
   rocksdb::Status status = rocksdb::DestroyDB(rocksdb_dir, rocksdb_options);
+  if (!cold_dir.empty() && fs_manager_->env()->FileExists(cold_dir)) {
+    WARN_NOT_OK(fs_manager_->DeleteRecursivelyThrottled(cold_dir),
+                Format("Failed to delete cold storage dir $0", cold_dir));
+  }
 
   if (!status.ok()) {
     LOG(ERROR) << "Failed to destroy regular DB at: " << rocksdb_dir << ": " << status;
@@ -395,8 +405,15 @@ Status RaftGroupMetadata::DeleteTabletData(TabletDataState delete_type,
     LOG(INFO) << "Successfully destroyed regular DB at: " << rocksdb_dir;
   }
 
+  const auto hot_keys_path = rocksdb_dir + kHotKeysFileSuffix;
+  if (fs_manager_->env()->FileExists(hot_keys_path)) {
+    WARN_NOT_OK(fs_manager_->env()->DeleteFile(hot_keys_path),
+                Format("Failed to delete $0", hot_keys_path));
+  }
+
   const auto intents_dir = rocksdb_dir + kIntentsDBSuffix;
   if (fs_manager_->env()->FileExists(intents_dir)) {
+    rocksdb_options.db_paths.clear();
     status = rocksdb::DestroyDB(intents_dir, rocksdb_options);
 
     if (!status.ok()) {
@@ -431,7 +448,7 @@ Status RaftGroupMetadata::DeleteSuperBlock() {
   }
 
   string path = fs_manager_->GetRaftGroupMetadataPath(raft_group_id_);
-  RETURN_NOT_OK_PREPEND(fs_manager_->env()->DeleteFile(path),
+  RETURN_NOT_OK_PREPEND(fs_manager_->DeleteMetadataFile(path),
                         "Unable to delete superblock for Raft group " + raft_group_id_);
   return Status::OK();
 }
@@ -536,6 +553,7 @@ Status RaftGroupMetadata::LoadFromSuperBlock(const RaftGroupReplicaSuperBlockPB&
       tombstone_last_logged_opid_ = OpId();
     }
     cdc_min_replicated_index_ = superblock.cdc_min_replicated_index();
+    log_only_ = superblock.log_only();
   }
 
   return Status::OK();
@@ -573,9 +591,7 @@ Status RaftGroupMetadata::ReplaceSuperBlockUnlocked(const RaftGroupReplicaSuperB
   flush_lock_.AssertAcquired();
 
   string path = fs_manager_->GetRaftGroupMetadataPath(raft_group_id_);
-  RETURN_NOT_OK_PREPEND(pb_util::WritePBContainerToPath(
-                            fs_manager_->env(), path, pb,
-                            pb_util::OVERWRITE, pb_util::SYNC),
+  RETURN_NOT_OK_PREPEND(fs_manager_->WriteMetadataFile(path, pb),
                         Substitute("Failed to write Raft group metadata $0", raft_group_id_));
 
   return Status::OK();
@@ -584,7 +600,7 @@ Status RaftGroupMetadata::ReplaceSuperBlockUnlocked(const RaftGroupReplicaSuperB
 Status RaftGroupMetadata::ReadSuperBlockFromDisk(RaftGroupReplicaSuperBlockPB* superblock) const {
   string path = fs_manager_->GetRaftGroupMetadataPath(raft_group_id_);
   RETURN_NOT_OK_PREPEND(
-      pb_util::ReadPBContainerFromPath(fs_manager_->env(), path, superblock),
+      fs_manager_->ReadMetadataFile(path, superblock),
       Substitute("Could not load Raft group metadata from $0", path));
   // Migration for backward compatibility with versions which don't have separate
   // TableType::TRANSACTION_STATUS_TABLE_TYPE.
@@ -619,6 +635,7 @@ void RaftGroupMetadata::ToSuperBlockUnlocked(RaftGroupReplicaSuperBlockPB* super
   pb.set_primary_table_id(primary_table_id_);
   pb.set_colocated(colocated_);
   pb.set_cdc_min_replicated_index(cdc_min_replicated_index_);
+  pb.set_log_only(log_only_);
 
   superblock->Swap(&pb);
 }
@@ -711,7 +728,7 @@ void RaftGroupMetadata::RemoveTable(const std::string& table_id) {
 }
 
 string RaftGroupMetadata::data_root_dir() const {
-  const auto& rocksdb_dir = kv_store_.rocksdb_dir;
+  const auto rocksdb_dir = this->rocksdb_dir();
   if (rocksdb_dir.empty()) {
     return "";
   } else {
@@ -723,6 +740,29 @@ string RaftGroupMetadata::data_root_dir() const {
   }
 }
 
+void RaftGroupMetadata::set_rocksdb_dir(const std::string& rocksdb_dir) {
+  std::lock_guard<MutexType> lock(data_mutex_);
+  kv_store_.rocksdb_dir = rocksdb_dir;
+}
+
+string RaftGroupMetadata::RocksDBDirForDataRoot(const std::string& data_root_dir) const {
+  // The RocksDB dir is <data root>/rocksdb/table-<table id>/tablet-<tablet id>.
+  const auto rocksdb_dir = this->rocksdb_dir();
+  const auto tablet_dir = DirName(rocksdb_dir);
+  return JoinPathSegments(
+      data_root_dir, FsManager::kRocksDBDirName, BaseName(tablet_dir), BaseName(rocksdb_dir));
+}
+
+string RaftGroupMetadata::cold_rocksdb_dir() const {
+  const auto cold_data_root_dirs = fs_manager_->GetColdDataRootDirs();
+  if (cold_data_root_dirs.empty()) {
+    return "";
+  }
+  // The dir should not change across restarts, so it is chosen by the hash of the Raft group id.
+  const auto hash = HashUtil::MurmurHash2_64(raft_group_id_.data(), raft_group_id_.size(), 0);
+  return RocksDBDirForDataRoot(cold_data_root_dirs[hash % cold_data_root_dirs.size()]);
+}
+
 string RaftGroupMetadata::wal_root_dir() const {
   if (wal_dir_.empty()) {
     return "";
@@ -770,6 +810,19 @@ int64_t RaftGroupMetadata::cdc_min_replicated_index() const {
   return cdc_min_replicated_index_;
 }
 
+Status RaftGroupMetadata::set_log_only() {
+  {
+    std::lock_guard<MutexType> lock(data_mutex_);
+    log_only_ = true;
+  }
+  return Flush();
+}
+
+bool RaftGroupMetadata::log_only() const {
+  std::lock_guard<MutexType> lock(data_mutex_);
+  return log_only_;
+}
+
 void RaftGroupMetadata::set_tablet_data_state(TabletDataState state) {
   std::lock_guard<MutexType> lock(data_mutex_);
   tablet_data_state_ = state;
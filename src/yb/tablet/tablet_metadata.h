@@ -295,7 +295,21 @@ class RaftGroupMetadata : public RefCountedThreadSafe<RaftGroupMetadata> {
     return primary_table_info_guarded().first->deleted_cols;
   }
 
-  std::string rocksdb_dir() const { return kv_store_.rocksdb_dir; }
+  std::string rocksdb_dir() const {
+    std::lock_guard<MutexType> lock(data_mutex_);
+    return kv_store_.rocksdb_dir;
+  }
+
+  // Changes the RocksDB directory after the RocksDB instances of the Raft group were moved there,
+  // see Tablet::MoveRocksDB. The caller is responsible for flushing the metadata.
+  void set_rocksdb_dir(const std::string& rocksdb_dir);
+
+  // Returns the RocksDB directory the Raft group would have under the given data root dir.
+  std::string RocksDBDirForDataRoot(const std::string& data_root_dir) const;
+
+  // Returns the directory for SST files of the regular DB on the cold storage tier, or an empty
+  // string if the tier is not configured, see fs_cold_data_dirs.
+  std::string cold_rocksdb_dir() const;
 
   std::string lower_bound_key() const { return kv_store_.lower_bound_key; }
   std::string upper_bound_key() const { return kv_store_.upper_bound_key; }
@@ -312,6 +326,11 @@ class RaftGroupMetadata : public RefCountedThreadSafe<RaftGroupMetadata> {
 
   int64_t cdc_min_replicated_index() const;
 
+  // Marks the replica as log-only, see RaftGroupReplicaSuperBlockPB::log_only.
+  CHECKED_STATUS set_log_only();
+
+  bool log_only() const;
+
   // Returns the data root dir for this Raft group, for example:
   // /mnt/d0/yb-data/tserver/data
   // TODO(#79): rework when we have more than one KV-store (and data roots) per Raft group.
@@ -499,6 +518,9 @@ class RaftGroupMetadata : public RefCountedThreadSafe<RaftGroupMetadata> {
   // The minimum index that has been replicated by the cdc service.
   int64_t cdc_min_replicated_index_ = std::numeric_limits<int64_t>::max();
 
+  // True if the replica was a log-only peer, so its data is not complete.
+  bool log_only_ = false;
+
   DISALLOW_COPY_AND_ASSIGN(RaftGroupMetadata);
 };
 
@@ -506,6 +528,9 @@ CHECKED_STATUS MigrateSuperblock(RaftGroupReplicaSuperBlockPB* superblock);
 
 extern const std::string kIntentsSubdir;
 extern const std::string kIntentsDBSuffix;
+// Suffix of the file next to the regular DB directory, that keeps recently read keys of the tablet
+// to warm up the block cache after restart, see Tablet::PersistHotKeys.
+extern const std::string kHotKeysFileSuffix;
 
 } // namespace tablet
 } // namespace yb
@@ -32,9 +32,17 @@
 #include "yb/tablet/tablet_metrics.h"
 
 #include "yb/gutil/strings/substitute.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/metrics.h"
+#include "yb/util/random_util.h"
 #include "yb/util/trace.h"
 
+DEFINE_double(operation_cost_trace_sample_probability, 0.0,
+              "Probability of adding the storage cost of a tablet read or write operation to the "
+              "trace of its RPC.");
+TAG_FLAG(operation_cost_trace_sample_probability, runtime);
+TAG_FLAG(operation_cost_trace_sample_probability, advanced);
+
 // Tablet-specific metrics.
 METRIC_DEFINE_counter(tablet, rows_inserted, "Rows Inserted",
     yb::MetricUnit::kRows,
@@ -74,6 +82,11 @@ METRIC_DEFINE_histogram(
     tablet, write_lock_latency, "Write lock latency", yb::MetricUnit::kMicroseconds,
     "Time taken to acquire key locks for a write operation", 60000000LU, 2);
 
+METRIC_DEFINE_histogram(
+    tablet, hibernation_wake_up_latency, "Hibernated tablet wake up latency",
+    yb::MetricUnit::kMicroseconds,
+    "Time taken to reopen RocksDB of a hibernated tablet on its first access", 60000000LU, 2);
+
 METRIC_DEFINE_gauge_uint32(tablet, compact_rs_running,
   "RowSet Compactions Running",
   yb::MetricUnit::kMaintenanceOperations,
@@ -134,17 +147,82 @@ METRIC_DEFINE_counter(tablet, restart_read_requests,
   yb::MetricUnit::kRequests,
   "Number of read requests that require restart.");
 
+METRIC_DEFINE_counter(tablet, hibernations,
+  "Tablet Hibernations",
+  yb::MetricUnit::kOperations,
+  "Number of times RocksDB of this tablet was closed after it was idle.");
+
+#define DEFINE_OPERATION_COST_COUNTERS(kind) \
+  METRIC_DEFINE_counter(tablet, kind##_block_cache_hits, "Block Cache Hits By " #kind, \
+      yb::MetricUnit::kCacheHits, \
+      "Number of block cache hits by tablet " #kind " operations."); \
+  METRIC_DEFINE_counter(tablet, kind##_blocks_read, "Blocks Read By " #kind, \
+      yb::MetricUnit::kBlocks, \
+      "Number of blocks read from disk by tablet " #kind " operations."); \
+  METRIC_DEFINE_counter(tablet, kind##_block_bytes_read, "Block Bytes Read By " #kind, \
+      yb::MetricUnit::kBytes, \
+      "Number of block bytes read from disk by tablet " #kind " operations."); \
+  METRIC_DEFINE_counter(tablet, kind##_block_bytes_decompressed, \
+      "Block Bytes Decompressed By " #kind, \
+      yb::MetricUnit::kBytes, \
+      "Number of bytes produced by block decompression for tablet " #kind " operations."); \
+  METRIC_DEFINE_counter(tablet, kind##_iterator_seeks, "Iterator Seeks By " #kind, \
+      yb::MetricUnit::kOperations, \
+      "Number of RocksDB iterator seeks by tablet " #kind " operations."); \
+  METRIC_DEFINE_counter(tablet, kind##_iterator_nexts, "Iterator Nexts By " #kind, \
+      yb::MetricUnit::kOperations, \
+      "Number of RocksDB iterator steps by tablet " #kind " operations."); \
+  METRIC_DEFINE_counter(tablet, kind##_intents_examined, "Intents Examined By " #kind, \
+      yb::MetricUnit::kEntries, \
+      "Number of provisional records decoded by tablet " #kind " operations.")
+
+DEFINE_OPERATION_COST_COUNTERS(read);
+DEFINE_OPERATION_COST_COUNTERS(write);
+
+#undef DEFINE_OPERATION_COST_COUNTERS
+
 using strings::Substitute;
 
 namespace yb {
 namespace tablet {
 
+OperationCostMetrics::OperationCostMetrics(
+    const scoped_refptr<MetricEntity>& entity, CounterPrototype* block_cache_hits_,
+    CounterPrototype* blocks_read_, CounterPrototype* block_bytes_read_,
+    CounterPrototype* block_bytes_decompressed_, CounterPrototype* seeks_,
+    CounterPrototype* nexts_, CounterPrototype* intents_examined_)
+    : block_cache_hits(block_cache_hits_->Instantiate(entity)),
+      blocks_read(blocks_read_->Instantiate(entity)),
+      block_bytes_read(block_bytes_read_->Instantiate(entity)),
+      block_bytes_decompressed(block_bytes_decompressed_->Instantiate(entity)),
+      seeks(seeks_->Instantiate(entity)),
+      nexts(nexts_->Instantiate(entity)),
+      intents_examined(intents_examined_->Instantiate(entity)) {
+}
+
+void OperationCostMetrics::Increment(const docdb::OperationCost& cost) {
+  block_cache_hits->IncrementBy(cost.block_cache_hits);
+  blocks_read->IncrementBy(cost.blocks_read);
+  block_bytes_read->IncrementBy(cost.block_bytes_read);
+  block_bytes_decompressed->IncrementBy(cost.block_bytes_decompressed);
+  seeks->IncrementBy(cost.seeks);
+  nexts->IncrementBy(cost.nexts);
+  intents_examined->IncrementBy(cost.intents_examined);
+}
+
+#define OPERATION_COST_METRICS(kind) \
+    &METRIC_##kind##_block_cache_hits, &METRIC_##kind##_blocks_read, \
+    &METRIC_##kind##_block_bytes_read, &METRIC_##kind##_block_bytes_decompressed, \
+    &METRIC_##kind##_iterator_seeks, &METRIC_##kind##_iterator_nexts, \
+    &METRIC_##kind##_intents_examined
+
 #define MINIT(x) x(METRIC_##x.Instantiate(entity))
 TabletMetrics::TabletMetrics(const scoped_refptr<MetricEntity>& entity)
   : MINIT(snapshot_read_inflight_wait_duration),
     MINIT(redis_read_latency),
     MINIT(ql_read_latency),
     MINIT(write_lock_latency),
+    MINIT(hibernation_wake_up_latency),
     MINIT(write_op_duration_client_propagated_consistency),
     MINIT(not_leader_rejections),
     MINIT(leader_memory_pressure_rejections),
@@ -152,9 +230,13 @@ TabletMetrics::TabletMetrics(const scoped_refptr<MetricEntity>& entity)
     MINIT(transaction_conflicts),
     MINIT(expired_transactions),
     MINIT(restart_read_requests),
-    MINIT(rows_inserted) {
+    MINIT(rows_inserted),
+    MINIT(hibernations),
+    read_cost(entity, OPERATION_COST_METRICS(read)),
+    write_cost(entity, OPERATION_COST_METRICS(write)) {
 }
 #undef MINIT
+#undef OPERATION_COST_METRICS
 
 ScopedTabletMetricsTracker::ScopedTabletMetricsTracker(scoped_refptr<Histogram> latency)
     : latency_(latency), start_time_(MonoTime::Now()) {}
@@ -162,5 +244,17 @@ ScopedTabletMetricsTracker::ScopedTabletMetricsTracker(scoped_refptr<Histogram>
 ScopedTabletMetricsTracker::~ScopedTabletMetricsTracker() {
   latency_->Increment(MonoTime::Now().GetDeltaSince(start_time_).ToMicroseconds());
 }
+
+ScopedOperationCostTracker::ScopedOperationCostTracker(OperationCostMetrics* metrics)
+    : metrics_(metrics), start_(docdb::OperationCost::Current()) {}
+
+ScopedOperationCostTracker::~ScopedOperationCostTracker() {
+  auto cost = docdb::OperationCost::Current() - start_;
+  metrics_->Increment(cost);
+  auto probability = FLAGS_operation_cost_trace_sample_probability;
+  if (probability > 0 && Trace::CurrentTrace() && RandomActWithProbability(probability)) {
+    TRACE("Operation cost: $0", cost.ToString());
+  }
+}
 } // namespace tablet
 } // namespace yb
@@ -35,11 +35,14 @@
 #include "yb/gutil/macros.h"
 #include "yb/gutil/ref_counted.h"
 
+#include "yb/docdb/operation_cost.h"
+
 #include "yb/util/monotime.h"
 
 namespace yb {
 
 class Counter;
+class CounterPrototype;
 template<class T>
 class AtomicGauge;
 class Histogram;
@@ -47,6 +50,25 @@ class MetricEntity;
 
 namespace tablet {
 
+// Storage work done by read or write operations of a tablet, see docdb::OperationCost.
+struct OperationCostMetrics {
+  OperationCostMetrics(
+      const scoped_refptr<MetricEntity>& entity, CounterPrototype* block_cache_hits,
+      CounterPrototype* blocks_read, CounterPrototype* block_bytes_read,
+      CounterPrototype* block_bytes_decompressed, CounterPrototype* seeks,
+      CounterPrototype* nexts, CounterPrototype* intents_examined);
+
+  void Increment(const docdb::OperationCost& cost);
+
+  scoped_refptr<Counter> block_cache_hits;
+  scoped_refptr<Counter> blocks_read;
+  scoped_refptr<Counter> block_bytes_read;
+  scoped_refptr<Counter> block_bytes_decompressed;
+  scoped_refptr<Counter> seeks;
+  scoped_refptr<Counter> nexts;
+  scoped_refptr<Counter> intents_examined;
+};
+
 // Container for all metrics specific to a single tablet.
 struct TabletMetrics {
   explicit TabletMetrics(const scoped_refptr<MetricEntity>& metric_entity);
@@ -57,6 +79,7 @@ struct TabletMetrics {
   scoped_refptr<Histogram> redis_read_latency;
   scoped_refptr<Histogram> ql_read_latency;
   scoped_refptr<Histogram> write_lock_latency;
+  scoped_refptr<Histogram> hibernation_wake_up_latency;
   scoped_refptr<Histogram> write_op_duration_client_propagated_consistency;
   scoped_refptr<Histogram> write_op_duration_commit_wait_consistency;
 
@@ -68,6 +91,10 @@ struct TabletMetrics {
   scoped_refptr<Counter> restart_read_requests;
 
   scoped_refptr<Counter> rows_inserted;
+  scoped_refptr<Counter> hibernations;
+
+  OperationCostMetrics read_cost;
+  OperationCostMetrics write_cost;
 };
 
 class ScopedTabletMetricsTracker {
@@ -80,6 +107,19 @@ class ScopedTabletMetricsTracker {
   MonoTime start_time_;
 };
 
+// Accounts the storage work done by the current thread during the lifetime of the tracker.
+// The cost is also added to the current trace for a sample of operations, see
+// --operation_cost_trace_sample_probability.
+class ScopedOperationCostTracker {
+ public:
+  explicit ScopedOperationCostTracker(OperationCostMetrics* metrics);
+  ~ScopedOperationCostTracker();
+
+ private:
+  OperationCostMetrics* metrics_;
+  docdb::OperationCost start_;
+};
+
 } // namespace tablet
 } // namespace yb
 #endif /* YB_TABLET_TABLET_METRICS_H */
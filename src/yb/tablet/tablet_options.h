@@ -13,17 +13,22 @@
 #ifndef YB_TABLET_TABLET_OPTIONS_H
 #define YB_TABLET_TABLET_OPTIONS_H
 
+#include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
+#include "yb/common/hybrid_time.h"
 #include "yb/util/env.h"
 #include "yb/rocksdb/env.h"
 
 namespace rocksdb {
+class ArenaBlockPool;
 class Cache;
 class EventListener;
 class MemoryMonitor;
 class Env;
+class PersistentCache;
 }
 
 namespace yb {
@@ -34,10 +39,16 @@ YB_STRONGLY_TYPED_BOOL(IsDropTable);
 
 struct TabletOptions {
   std::shared_ptr<rocksdb::Cache> block_cache;
+  std::shared_ptr<rocksdb::PersistentCache> persistent_cache;
   std::shared_ptr<rocksdb::MemoryMonitor> memory_monitor;
+  std::shared_ptr<rocksdb::ArenaBlockPool> memtable_arena_block_pool;
   std::vector<std::shared_ptr<rocksdb::EventListener>> listeners;
   yb::Env* env = Env::Default();
   rocksdb::Env* rocksdb_env = rocksdb::Env::Default();
+
+  // Invoked with the tablet id and the oldest write in its mutable memtables, by the first write
+  // after Tablet::ResetMemtableWriteReported.
+  std::function<void(const std::string&, HybridTime)> memtable_write_listener;
 };
 
 } // namespace tablet
@@ -76,6 +76,7 @@
 #include "yb/tablet/operations/write_operation.h"
 #include "yb/tablet/operations/update_txn_operation.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/metrics.h"
@@ -91,6 +92,12 @@ using std::string;
 DEFINE_test_flag(int32, delay_init_tablet_peer_ms, 0,
                  "Wait before executing init tablet peer for specified amount of milliseconds.");
 
+DEFINE_bool(defer_replica_operations_prepare, true,
+            "Submit operations received by a follower for prepare after the consensus state "
+            "lock is released, instead of submitting each of them while holding the lock.");
+TAG_FLAG(defer_replica_operations_prepare, advanced);
+TAG_FLAG(defer_replica_operations_prepare, runtime);
+
 DEFINE_int32(cdc_min_replicated_index_considered_stale_secs, 900,
     "If cdc_min_replicated_index hasn't been replicated in this amount of time, we reset its"
     "value to max int64 to avoid retaining any logs");
@@ -177,7 +184,9 @@ Status TabletPeer::InitTabletPeer(const TabletPtr &tablet,
                                   const scoped_refptr<MetricEntity> &metric_entity,
                                   ThreadPool* raft_pool,
                                   ThreadPool* tablet_prepare_pool,
-                                  consensus::RetryableRequests* retryable_requests) {
+                                  consensus::RetryableRequests* retryable_requests,
+                                  consensus::MultiRaftManager* multi_raft_manager,
+                                  FinalTransactionStatusCache* final_status_cache) {
 
   DCHECK(tablet) << "A TabletPeer must be provided with a Tablet";
   DCHECK(log) << "A TabletPeer must be provided with a Log";
@@ -195,6 +204,7 @@ Status TabletPeer::InitTabletPeer(const TabletPtr &tablet,
     }
     tablet_ = tablet;
     client_future_ = client_future;
+    final_status_cache_ = final_status_cache;
     proxy_cache_ = proxy_cache;
     log_ = log;
     // "Publish" the log pointer so it can be retrieved using the log() accessor.
@@ -257,7 +267,8 @@ Status TabletPeer::InitTabletPeer(const TabletPtr &tablet,
         mark_dirty_clbk_,
         tablet_->table_type(),
         raft_pool,
-        retryable_requests);
+        retryable_requests,
+        multi_raft_manager);
     has_consensus_.store(true, std::memory_order_release);
 
     tablet_->SetHybridTimeLeaseProvider(std::bind(&TabletPeer::HybridTimeLease, this, _1, _2));
@@ -331,6 +342,24 @@ void TabletPeer::MajorityReplicated() {
 
 void TabletPeer::ChangeConfigReplicated(const RaftConfigPB& config) {
   tablet_->mvcc_manager()->SetLeaderOnlyMode(config.peers_size() == 1);
+
+  // Once the peer became log-only, it stays such until remote bootstrap replaces its data, since
+  // its DocDB misses the operations applied while it was log-only.
+  if (consensus::IsRaftConfigLogOnlyMember(permanent_uuid(), config)) {
+    if (!tablet_->log_only()) {
+      auto status = meta_->set_log_only();
+      LOG_IF_WITH_PREFIX(DFATAL, !status.ok()) << "Failed to persist log-only mode: " << status;
+      tablet_->SetLogOnly(true);
+    }
+  } else if (tablet_->log_only() && consensus::IsRaftConfigMember(permanent_uuid(), config)) {
+    LOG_WITH_PREFIX(ERROR)
+        << "Log-only peer is listed as a full replica in config " << config.ShortDebugString()
+        << ", it keeps rejecting requests until it is removed and remote bootstrapped";
+  }
+}
+
+bool TabletPeer::IsLogOnly() {
+  return tablet_->log_only();
 }
 
 uint64_t TabletPeer::NumSSTFiles() {
@@ -341,6 +370,10 @@ void TabletPeer::ListenNumSSTFilesChanged(std::function<void()> listener) {
   tablet_->ListenNumSSTFilesChanged(std::move(listener));
 }
 
+std::vector<std::string> TabletPeer::HotKeys() {
+  return tablet_->GetHotKeys();
+}
+
 Status TabletPeer::Start(const ConsensusBootstrapInfo& bootstrap_info) {
   {
     std::lock_guard<simple_spinlock> l(state_change_lock_);
@@ -955,10 +988,26 @@ Status TabletPeer::StartReplicaOperation(
     tablet()->mvcc_manager()->AddPending(&ht);
   }
 
-  driver->ExecuteAsync();
+  if (GetAtomicFlag(&FLAGS_defer_replica_operations_prepare)) {
+    std::lock_guard<std::mutex> lock(started_replica_operations_mutex_);
+    started_replica_operations_.push_back(std::move(driver));
+  } else {
+    driver->ExecuteAsync();
+  }
   return Status::OK();
 }
 
+void TabletPeer::ReplicaOperationsStarted() {
+  std::vector<OperationDriverPtr> drivers;
+  {
+    std::lock_guard<std::mutex> lock(started_replica_operations_mutex_);
+    drivers.swap(started_replica_operations_);
+  }
+  for (const auto& driver : drivers) {
+    driver->ExecuteAsync();
+  }
+}
+
 void TabletPeer::SetPropagatedSafeTime(HybridTime ht) {
   auto driver = NewReplicaOperationDriver(nullptr);
   if (!driver.ok()) {
@@ -973,6 +1022,14 @@ bool TabletPeer::ShouldApplyWrite() {
   return tablet_->ShouldApplyWrite();
 }
 
+void TabletPeer::StartApplyBatch() {
+  tablet_->StartApplyBatch();
+}
+
+void TabletPeer::FinishApplyBatch() {
+  tablet_->FinishApplyBatch();
+}
+
 consensus::Consensus* TabletPeer::consensus() const {
   return raft_consensus();
 }
@@ -1023,6 +1080,20 @@ void TabletPeer::RegisterMaintenanceOps(MaintenanceManager* maint_mgr) {
   maint_mgr->RegisterOp(log_gc.get());
   maintenance_ops_.push_back(log_gc.release());
   LOG_WITH_PREFIX(INFO) << "Registered log gc";
+
+  if (tablet_->table_type() == TableType::REDIS_TABLE_TYPE) {
+    gscoped_ptr<MaintenanceOp> expired_data_compaction(new ExpiredDataCompactionOp(this));
+    maint_mgr->RegisterOp(expired_data_compaction.get());
+    maintenance_ops_.push_back(expired_data_compaction.release());
+  }
+
+  // Keys outside of the key bounds are not written after split, so the compaction is required
+  // only if there are SST files with such keys when the tablet starts.
+  if (tablet_->OutOfBoundsSstFilesSize() != 0) {
+    gscoped_ptr<MaintenanceOp> post_split_compaction(new PostSplitCompactionOp(this));
+    maint_mgr->RegisterOp(post_split_compaction.get());
+    maintenance_ops_.push_back(post_split_compaction.release());
+  }
 }
 
 void TabletPeer::UnregisterMaintenanceOps() {
@@ -120,7 +120,9 @@ class TabletPeer : public consensus::ConsensusContext,
                                 const scoped_refptr<MetricEntity> &metric_entity,
                                 ThreadPool* raft_pool,
                                 ThreadPool* tablet_prepare_pool,
-                                consensus::RetryableRequests* retryable_requests);
+                                consensus::RetryableRequests* retryable_requests,
+                                consensus::MultiRaftManager* multi_raft_manager,
+                                FinalTransactionStatusCache* final_status_cache);
 
   // Starts the TabletPeer, making it available for Write()s. If this
   // TabletPeer is part of a consensus configuration this will connect it to other peers
@@ -178,6 +180,8 @@ class TabletPeer : public consensus::ConsensusContext,
       const scoped_refptr<consensus::ConsensusRound>& round,
       HybridTime propagated_safe_time) override;
 
+  void ReplicaOperationsStarted() override;
+
   // This is an override of a ConsensusContext method. This is called from
   // UpdateReplica -> EnqueuePreparesUnlocked on Raft heartbeats.
   void SetPropagatedSafeTime(HybridTime ht) override;
@@ -185,6 +189,9 @@ class TabletPeer : public consensus::ConsensusContext,
   // Returns false if it is preferable to don't apply write operation.
   bool ShouldApplyWrite() override;
 
+  void StartApplyBatch() override;
+  void FinishApplyBatch() override;
+
   consensus::Consensus* consensus() const;
   consensus::RaftConsensus* raft_consensus() const;
 
@@ -286,6 +293,10 @@ class TabletPeer : public consensus::ConsensusContext,
     return client_future_;
   }
 
+  FinalTransactionStatusCache* final_status_cache() override {
+    return final_status_cache_;
+  }
+
   int64_t LeaderTerm() const override;
   consensus::LeaderStatus LeaderStatus(bool allow_stale = false) const;
 
@@ -391,6 +402,11 @@ class TabletPeer : public consensus::ConsensusContext,
   gscoped_ptr<TabletStatusListener> status_listener_;
   simple_spinlock prepare_replicate_lock_;
 
+  // Replica operations started by consensus, that should be submitted for prepare when
+  // ReplicaOperationsStarted is invoked.
+  std::mutex started_replica_operations_mutex_;
+  std::vector<OperationDriverPtr> started_replica_operations_;
+
   // Lock protecting state_ as well as smart pointers to collaborating
   // classes such as tablet_ and consensus_.
   mutable simple_spinlock lock_;
@@ -442,6 +458,8 @@ class TabletPeer : public consensus::ConsensusContext,
   void ChangeConfigReplicated(const consensus::RaftConfigPB& config) override;
   uint64_t NumSSTFiles() override;
   void ListenNumSSTFilesChanged(std::function<void()> listener) override;
+  std::vector<std::string> HotKeys() override;
+  bool IsLogOnly() override;
 
   MetricRegistry* metric_registry_;
 
@@ -451,6 +469,8 @@ class TabletPeer : public consensus::ConsensusContext,
 
   std::shared_future<client::YBClient*> client_future_;
 
+  std::atomic<FinalTransactionStatusCache*> final_status_cache_{nullptr};
+
   DISALLOW_COPY_AND_ASSIGN(TabletPeer);
 };
 
@@ -53,6 +53,38 @@ METRIC_DEFINE_histogram(tablet, log_gc_duration,
                         "Log GC Duration",
                         yb::MetricUnit::kMilliseconds,
                         "Time spent garbage collecting the logs.", 60000LU, 1);
+METRIC_DEFINE_gauge_uint32(tablet, expired_data_compaction_running,
+                           "Expired Data Compactions Running",
+                           yb::MetricUnit::kOperations,
+                           "Number of compactions of expired data currently running.");
+METRIC_DEFINE_histogram(tablet, expired_data_compaction_duration,
+                        "Expired Data Compaction Duration",
+                        yb::MetricUnit::kMilliseconds,
+                        "Time spent compacting tablets to remove expired data.", 3600000LU, 1);
+
+DEFINE_double(expired_data_compaction_threshold, 0,
+              "Compact the regular DB of a Redis tablet when the size of data known to be expired "
+              "exceeds this fraction of the uncompressed size of its SST files. Versions "
+              "overwritten by later write batches are still accounted, so the estimate could be "
+              "too high for frequently overwritten keys. 0 to disable.");
+TAG_FLAG(expired_data_compaction_threshold, advanced);
+TAG_FLAG(expired_data_compaction_threshold, runtime);
+
+METRIC_DEFINE_gauge_uint32(tablet, post_split_compaction_running,
+                           "Post Split Compactions Running",
+                           yb::MetricUnit::kOperations,
+                           "Number of compactions of split tablets currently running.");
+METRIC_DEFINE_histogram(tablet, post_split_compaction_duration,
+                        "Post Split Compaction Duration",
+                        yb::MetricUnit::kMilliseconds,
+                        "Time spent compacting split tablets to remove keys of the other child.",
+                        3600000LU, 1);
+
+DEFINE_bool(post_split_compaction, true,
+            "Compact the regular DB of a split tablet in background, to remove keys outside of "
+            "its key bounds from SST files shared with the parent tablet.");
+TAG_FLAG(post_split_compaction, advanced);
+TAG_FLAG(post_split_compaction, runtime);
 
 namespace yb {
 namespace tablet {
@@ -108,5 +140,138 @@ scoped_refptr<AtomicGauge<uint32_t> > LogGCOp::RunningGauge() const {
   return log_gc_running_;
 }
 
+//
+// ExpiredDataCompactionOp.
+//
+
+ExpiredDataCompactionOp::ExpiredDataCompactionOp(TabletPeer* tablet_peer)
+    : MaintenanceOp(StringPrintf("ExpiredDataCompactionOp(%s)",
+                                 tablet_peer->tablet()->tablet_id().c_str()),
+                    MaintenanceOp::HIGH_IO_USAGE),
+      tablet_peer_(tablet_peer),
+      duration_(METRIC_expired_data_compaction_duration.Instantiate(
+                    tablet_peer->tablet()->GetMetricEntity())),
+      running_(METRIC_expired_data_compaction_running.Instantiate(
+                   tablet_peer->tablet()->GetMetricEntity(), 0)),
+      sem_(1) {}
+
+void ExpiredDataCompactionOp::UpdateStats(MaintenanceOpStats* stats) {
+  stats->set_runnable(false);
+  if (FLAGS_expired_data_compaction_threshold <= 0) {
+    return;
+  }
+  auto tablet = tablet_peer_->shared_tablet();
+  if (!tablet) {
+    return;
+  }
+  const auto expired_size = tablet->ExpiredDataSize();
+  if (expired_size == 0) {
+    return;
+  }
+  // Expired data is accounted by its uncompressed size, so compare it with uncompressed size of
+  // SST files.
+  const auto sst_size = tablet->GetCurrentVersionSstFilesUncompressedSize();
+  if (sst_size == 0) {
+    return;
+  }
+  const double expired_ratio = std::min(static_cast<double>(expired_size) / sst_size, 1.0);
+  if (expired_ratio < FLAGS_expired_data_compaction_threshold) {
+    return;
+  }
+  stats->set_perf_improvement(expired_ratio);
+  stats->set_runnable(sem_.GetValue() == 1);
+}
+
+bool ExpiredDataCompactionOp::Prepare() {
+  return sem_.try_lock();
+}
+
+void ExpiredDataCompactionOp::Perform() {
+  CHECK(!sem_.try_lock());
+
+  auto tablet = tablet_peer_->shared_tablet();
+  if (tablet) {
+    Status s = tablet->CompactExpiredData();
+    if (!s.ok()) {
+      LOG(WARNING) << s.CloneAndPrepend("Failed to compact expired data of tablet "
+                                        + tablet->tablet_id());
+    }
+  }
+
+  sem_.unlock();
+}
+
+scoped_refptr<Histogram> ExpiredDataCompactionOp::DurationHistogram() const {
+  return duration_;
+}
+
+scoped_refptr<AtomicGauge<uint32_t> > ExpiredDataCompactionOp::RunningGauge() const {
+  return running_;
+}
+
+//
+// PostSplitCompactionOp.
+//
+
+PostSplitCompactionOp::PostSplitCompactionOp(TabletPeer* tablet_peer)
+    : MaintenanceOp(StringPrintf("PostSplitCompactionOp(%s)",
+                                 tablet_peer->tablet()->tablet_id().c_str()),
+                    MaintenanceOp::HIGH_IO_USAGE),
+      tablet_peer_(tablet_peer),
+      duration_(METRIC_post_split_compaction_duration.Instantiate(
+                    tablet_peer->tablet()->GetMetricEntity())),
+      running_(METRIC_post_split_compaction_running.Instantiate(
+                   tablet_peer->tablet()->GetMetricEntity(), 0)),
+      sem_(1) {}
+
+void PostSplitCompactionOp::UpdateStats(MaintenanceOpStats* stats) {
+  stats->set_runnable(false);
+  if (!FLAGS_post_split_compaction) {
+    return;
+  }
+  auto tablet = tablet_peer_->shared_tablet();
+  if (!tablet) {
+    return;
+  }
+  const auto out_of_bounds_size = tablet->OutOfBoundsSstFilesSize();
+  if (out_of_bounds_size == 0) {
+    return;
+  }
+  const auto sst_size = tablet->GetCurrentVersionSstFilesSize();
+  if (sst_size == 0) {
+    return;
+  }
+  stats->set_perf_improvement(
+      std::min(static_cast<double>(out_of_bounds_size) / sst_size, 1.0));
+  stats->set_runnable(sem_.GetValue() == 1);
+}
+
+bool PostSplitCompactionOp::Prepare() {
+  return sem_.try_lock();
+}
+
+void PostSplitCompactionOp::Perform() {
+  CHECK(!sem_.try_lock());
+
+  auto tablet = tablet_peer_->shared_tablet();
+  if (tablet) {
+    Status s = tablet->CompactOutOfBoundsData();
+    if (!s.ok()) {
+      LOG(WARNING) << s.CloneAndPrepend("Failed to compact split tablet "
+                                        + tablet->tablet_id());
+    }
+  }
+
+  sem_.unlock();
+}
+
+scoped_refptr<Histogram> PostSplitCompactionOp::DurationHistogram() const {
+  return duration_;
+}
+
+scoped_refptr<AtomicGauge<uint32_t> > PostSplitCompactionOp::RunningGauge() const {
+  return running_;
+}
+
 }  // namespace tablet
 }  // namespace yb
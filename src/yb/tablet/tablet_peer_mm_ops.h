@@ -70,6 +70,54 @@ class LogGCOp : public MaintenanceOp {
   mutable Semaphore sem_;
 };
 
+// Maintenance task that compacts the regular DB of a tablet, when a large part of its data is
+// known to be expired. Reports the ratio of expired data to the uncompressed size of SST files as
+// perf improvement.
+class ExpiredDataCompactionOp : public MaintenanceOp {
+ public:
+  explicit ExpiredDataCompactionOp(TabletPeer* tablet_peer);
+
+  virtual void UpdateStats(MaintenanceOpStats* stats) override;
+
+  virtual bool Prepare() override;
+
+  virtual void Perform() override;
+
+  virtual scoped_refptr<Histogram> DurationHistogram() const override;
+
+  virtual scoped_refptr<AtomicGauge<uint32_t> > RunningGauge() const override;
+
+ private:
+  TabletPeer *const tablet_peer_;
+  scoped_refptr<Histogram> duration_;
+  scoped_refptr<AtomicGauge<uint32_t> > running_;
+  mutable Semaphore sem_;
+};
+
+// Maintenance task that compacts the regular DB of a split tablet, while it still shares SST files
+// containing keys of the other child with the parent tablet. Reports the ratio of the size of such
+// files to the size of all SST files as perf improvement, so it yields to more urgent operations.
+class PostSplitCompactionOp : public MaintenanceOp {
+ public:
+  explicit PostSplitCompactionOp(TabletPeer* tablet_peer);
+
+  virtual void UpdateStats(MaintenanceOpStats* stats) override;
+
+  virtual bool Prepare() override;
+
+  virtual void Perform() override;
+
+  virtual scoped_refptr<Histogram> DurationHistogram() const override;
+
+  virtual scoped_refptr<AtomicGauge<uint32_t> > RunningGauge() const override;
+
+ private:
+  TabletPeer *const tablet_peer_;
+  scoped_refptr<Histogram> duration_;
+  scoped_refptr<AtomicGauge<uint32_t> > running_;
+  mutable Semaphore sem_;
+};
+
 } // namespace tablet
 } // namespace yb
 
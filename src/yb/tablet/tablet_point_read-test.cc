@@ -0,0 +1,177 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <atomic>
+#include <future>
+
+#include "yb/common/ql_protocol_util.h"
+
+#include "yb/tablet/local_tablet_writer.h"
+#include "yb/tablet/operations/truncate_operation.h"
+#include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet-test-util.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+DECLARE_bool(point_reads_skip_safe_time_wait);
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+// Writes a row through the leader write path of the tablet and keeps the write pending, i.e.
+// with hybrid time assigned and keys locked, until Finish is called.
+class PendingTabletWriter : public WriteOperationContext {
+ public:
+  explicit PendingTabletWriter(Tablet* tablet) : tablet_(tablet) {}
+
+  ~PendingTabletWriter() {
+    CHECK(!operation_) << "Pending write was not finished";
+  }
+
+  CHECKED_STATUS Start(int32_t key, int32_t value) {
+    auto* req = req_.add_ql_write_batch();
+    req->set_type(QLWriteRequestPB::QL_STMT_INSERT);
+    req->set_schema_version(tablet_->metadata()->schema_version());
+    QLAddInt32HashValue(req, key);
+    QLSetHashCode(req);
+    QLAddInt32ColumnValue(req, kFirstColumnId + 1, value);
+
+    auto state = std::make_unique<WriteOperationState>(tablet_, &req_, &resp_);
+    auto operation = std::make_unique<WriteOperation>(
+        std::move(state), OpId::kUnknownTerm, CoarseTimePoint::max() /* deadline */, this);
+    tablet_->AcquireLocksAndPerformDocOperations(std::move(operation));
+    return submitted_.get_future().get();
+  }
+
+  HybridTime hybrid_time() const {
+    return operation_->state()->hybrid_time();
+  }
+
+  // Applies the write and releases its locks.
+  CHECKED_STATUS Finish() {
+    auto* state = down_cast<WriteOperationState*>(operation_->state());
+    // Create a "fake" OpId for anchoring, op ids must always be increasing.
+    static std::atomic<int64_t> next_index{1};
+    state->mutable_op_id()->set_term(1);
+    state->mutable_op_id()->set_index(next_index.fetch_add(1));
+    RETURN_NOT_OK(tablet_->ApplyRowOperations(state));
+    state->Commit();
+    state->ReleaseDocDbLocks();
+    operation_.reset();
+    return Status::OK();
+  }
+
+ private:
+  void Submit(std::unique_ptr<Operation> operation, int64_t term) override {
+    tablet_->StartOperation(down_cast<WriteOperationState*>(operation->state()));
+    operation_ = std::move(operation);
+    submitted_.set_value(Status::OK());
+  }
+
+  void Aborted(Operation* operation) override {
+    submitted_.set_value(STATUS(Aborted, "Write aborted"));
+  }
+
+  HybridTime ReportReadRestart() override {
+    return HybridTime();
+  }
+
+  Tablet* const tablet_;
+  tserver::WriteRequestPB req_;
+  tserver::WriteResponsePB resp_;
+  std::promise<Status> submitted_;
+  std::unique_ptr<Operation> operation_;
+};
+
+} // namespace
+
+class TabletPointReadTest : public YBTabletTest {
+ public:
+  TabletPointReadTest()
+      : YBTabletTest(
+            Schema({ ColumnSchema("key", INT32, false, true), ColumnSchema("val", INT32, true) },
+                   1)) {}
+
+  void SetUp() override {
+    FLAGS_point_reads_skip_safe_time_wait = true;
+    YBTabletTest::SetUp();
+    tablet()->SetHybridTimeLeaseProvider([this](MicrosTime, CoarseTimePoint) {
+      return FixedHybridTimeLease{clock()->Now(), HybridTime::kMax};
+    });
+  }
+
+  // Returns safe time for a point read of the key at a read time after all started operations.
+  HybridTime SafeTimeForPointRead(int32_t key) {
+    google::protobuf::RepeatedPtrField<QLReadRequestPB> ql_batch;
+    auto* req = ql_batch.Add();
+    QLAddInt32HashValue(req, key);
+    QLSetHashCode(req);
+    QLAddColumns(schema(), {}, req);
+    read_time_ = clock()->Now();
+    return tablet()->SafeTimeForPointRead(
+        read_time_, TransactionMetadataPB(), ql_batch,
+        google::protobuf::RepeatedPtrField<PgsqlReadRequestPB>());
+  }
+
+ protected:
+  HybridTime read_time_;
+};
+
+TEST_F(TabletPointReadTest, NonConflictingWrite) {
+  PendingTabletWriter writer(tablet().get());
+  ASSERT_OK(writer.Start(1, 10));
+
+  // The pending write holds the safe time back, but it does not lock the read key.
+  ASSERT_EQ(read_time_, SafeTimeForPointRead(2)) << "Write at " << writer.hybrid_time();
+  ASSERT_GT(read_time_, writer.hybrid_time());
+
+  FLAGS_point_reads_skip_safe_time_wait = false;
+  ASSERT_FALSE(SafeTimeForPointRead(2).is_valid());
+
+  ASSERT_OK(writer.Finish());
+}
+
+TEST_F(TabletPointReadTest, ConflictingWrite) {
+  PendingTabletWriter writer(tablet().get());
+  ASSERT_OK(writer.Start(1, 10));
+
+  // The read could miss the pending write of the same key, so it has to wait for the safe time.
+  ASSERT_FALSE(SafeTimeForPointRead(1).is_valid());
+
+  ASSERT_OK(writer.Finish());
+  ASSERT_GE(SafeTimeForPointRead(1), read_time_);
+}
+
+TEST_F(TabletPointReadTest, PendingTruncate) {
+  PendingTabletWriter writer(tablet().get());
+  ASSERT_OK(writer.Start(1, 10));
+
+  {
+    // Truncate holds no locks, so a read at a later time has to wait for it, whatever keys it
+    // reads.
+    TruncateOperation truncate(std::make_unique<TruncateOperationState>(tablet().get()));
+    ASSERT_TRUE(tablet()->mvcc_manager()->HasPendingOperationsWithoutLocks());
+    ASSERT_FALSE(SafeTimeForPointRead(2).is_valid());
+  }
+
+  ASSERT_FALSE(tablet()->mvcc_manager()->HasPendingOperationsWithoutLocks());
+  ASSERT_EQ(read_time_, SafeTimeForPointRead(2));
+
+  ASSERT_OK(writer.Finish());
+}
+
+} // namespace tablet
+} // namespace yb
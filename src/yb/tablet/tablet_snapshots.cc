@@ -13,6 +13,9 @@
 
 #include "yb/tablet/tablet_snapshots.h"
 
+#include <algorithm>
+#include <unordered_map>
+
 #include <boost/algorithm/string/predicate.hpp>
 
 #include "yb/docdb/consensus_frontier.h"
@@ -24,13 +27,22 @@
 #include "yb/rocksdb/utilities/checkpoint.h"
 
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet.pb.h"
 #include "yb/tablet/tablet_metadata.h"
 #include "yb/tablet/operations/snapshot_operation.h"
 
+#include "yb/util/flag_tags.h"
+#include "yb/util/oid_generator.h"
+#include "yb/util/pb_util.h"
 #include "yb/util/pending_op_counter.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/trace.h"
 
+DEFINE_bool(tablet_snapshot_write_manifest, true,
+            "Write a manifest to each tablet snapshot, that lists its files with content ids, "
+            "so backups could upload only the files that are not in the previous snapshot.");
+TAG_FLAG(tablet_snapshot_write_manifest, advanced);
+
 namespace yb {
 namespace tablet {
 
@@ -38,6 +50,105 @@ namespace {
 
 const std::string kSnapshotsDirSuffix = ".snapshots";
 const std::string kTempSnapshotDirSuffix = ".tmp";
+const std::string kSnapshotManifestFileName = "yb_snapshot_manifest";
+
+// Appends paths of all files under dir/relative_dir, relative to dir, to result.
+CHECKED_STATUS ListFilesRecursively(
+    Env* env, const std::string& dir, const std::string& relative_dir,
+    std::vector<std::string>* result) {
+  const auto full_dir = relative_dir.empty() ? dir : JoinPathSegments(dir, relative_dir);
+  for (const auto& child : VERIFY_RESULT(env->GetChildren(full_dir, ExcludeDots::kTrue))) {
+    const auto relative_path =
+        relative_dir.empty() ? child : JoinPathSegments(relative_dir, child);
+    if (VERIFY_RESULT(env->IsDirectory(JoinPathSegments(dir, relative_path)))) {
+      RETURN_NOT_OK(ListFilesRecursively(env, dir, relative_path, result));
+    } else {
+      result->push_back(relative_path);
+    }
+  }
+  return Status::OK();
+}
+
+// Finds the latest snapshot with a manifest in top_snapshots_dir, that is not snapshot_id.
+// Returns its directory and fills its manifest, or returns an empty string if there is no such
+// snapshot.
+Result<std::string> FindBaseSnapshot(
+    Env* env, const std::string& top_snapshots_dir, const std::string& snapshot_id,
+    SnapshotManifestPB* base_manifest) {
+  std::string result;
+  for (const auto& child : VERIFY_RESULT(env->GetChildren(top_snapshots_dir, ExcludeDots::kTrue))) {
+    if (child == snapshot_id || TabletSnapshots::IsTempSnapshotDir(child)) {
+      continue;
+    }
+    const auto dir = JoinPathSegments(top_snapshots_dir, child);
+    const auto manifest_path = TabletSnapshots::SnapshotManifestPath(dir);
+    if (!env->FileExists(manifest_path)) {
+      continue;
+    }
+    SnapshotManifestPB manifest;
+    auto status = pb_util::ReadPBContainerFromPath(env, manifest_path, &manifest);
+    if (!status.ok()) {
+      LOG(WARNING) << "Cannot read snapshot manifest " << manifest_path << ": " << status;
+      continue;
+    }
+    if (result.empty() || manifest.hybrid_time() > base_manifest->hybrid_time()) {
+      result = dir;
+      *base_manifest = std::move(manifest);
+    }
+  }
+  return result;
+}
+
+// Writes the manifest of the snapshot with snapshot_id, that was created in snapshot_dir.
+// A file gets the content id of the same file in the base snapshot, when both are hard links to
+// the same inode. SST files are immutable, and the base snapshot keeps its link to the inode, so
+// such files have the same content. Other files get a new content id.
+CHECKED_STATUS WriteSnapshotManifest(
+    Env* env, const std::string& top_snapshots_dir, const std::string& snapshot_dir,
+    const std::string& snapshot_id, HybridTime hybrid_time) {
+  SnapshotManifestPB base_manifest;
+  const auto base_dir = VERIFY_RESULT(FindBaseSnapshot(
+      env, top_snapshots_dir, snapshot_id, &base_manifest));
+  std::unordered_map<std::string, const SnapshotFilePB*> base_files;
+  for (const auto& file : base_manifest.files()) {
+    base_files.emplace(file.name(), &file);
+  }
+
+  SnapshotManifestPB manifest;
+  manifest.set_snapshot_id(snapshot_id);
+  if (!base_dir.empty()) {
+    manifest.set_base_snapshot_id(base_manifest.snapshot_id());
+  }
+  manifest.set_hybrid_time(hybrid_time.ToUint64());
+
+  std::vector<std::string> names;
+  RETURN_NOT_OK(ListFilesRecursively(env, snapshot_dir, std::string(), &names));
+  std::sort(names.begin(), names.end());
+  ObjectIdGenerator oid_generator;
+  for (const auto& name : names) {
+    const auto path = JoinPathSegments(snapshot_dir, name);
+    auto* file = manifest.add_files();
+    file->set_name(name);
+    file->set_size_bytes(VERIFY_RESULT(env->GetFileSize(path)));
+
+    auto it = base_files.find(name);
+    if (it != base_files.end()) {
+      const auto base_path = JoinPathSegments(base_dir, name);
+      auto base_inode = env->GetFileINode(base_path);
+      if (base_inode.ok() && *base_inode == VERIFY_RESULT(env->GetFileINode(path))) {
+        file->set_content_id(it->second->content_id());
+        file->set_in_base(true);
+        continue;
+      }
+    }
+    file->set_content_id(oid_generator.Next());
+    file->set_in_base(false);
+  }
+
+  return pb_util::WritePBContainerToPath(
+      env, TabletSnapshots::SnapshotManifestPath(snapshot_dir), manifest, pb_util::OVERWRITE,
+      pb_util::SYNC);
+}
 
 } // namespace
 
@@ -51,6 +162,10 @@ bool TabletSnapshots::IsTempSnapshotDir(const std::string& dir) {
   return boost::ends_with(dir, kTempSnapshotDirSuffix);
 }
 
+std::string TabletSnapshots::SnapshotManifestPath(const std::string& snapshot_dir) {
+  return JoinPathSegments(snapshot_dir, kSnapshotManifestFileName);
+}
+
 Status TabletSnapshots::Bootstrap(SnapshotOperationState* tx_state) {
   RETURN_NOT_OK(Prepare(tx_state));
 
@@ -100,7 +215,7 @@ Status TabletSnapshots::Prepare(SnapshotOperationState* tx_state) {
 }
 
 Status TabletSnapshots::Create(SnapshotOperationState* tx_state) {
-  ScopedPendingOperation scoped_read_operation(&pending_op_counter());
+  auto scoped_read_operation = StartReadWriteOperation();
   RETURN_NOT_OK(scoped_read_operation);
 
   Status s = regular_db().Flush(rocksdb::FlushOptions());
@@ -181,6 +296,14 @@ Status TabletSnapshots::Create(SnapshotOperationState* tx_state) {
     return s.CloneAndPrepend("Cannot create RocksDB checkpoint");
   }
 
+  if (FLAGS_tablet_snapshot_write_manifest) {
+    RETURN_NOT_OK_PREPEND(
+        WriteSnapshotManifest(
+            env, top_snapshots_dir, tmp_snapshot_dir, tx_state->request()->snapshot_id(),
+            tx_state->hybrid_time()),
+        Format("Cannot write manifest of snapshot $0", tx_state->request()->snapshot_id()));
+  }
+
   RETURN_NOT_OK_PREPEND(
       env->RenameFile(tmp_snapshot_dir, snapshot_dir),
       Format("Cannot rename temp snapshot dir $0 to $1", tmp_snapshot_dir, snapshot_dir));
@@ -219,6 +342,8 @@ Status TabletSnapshots::Restore(SnapshotOperationState* tx_state) {
 
 Status TabletSnapshots::RestoreCheckpoint(
     const std::string& dir, const docdb::ConsensusFrontier& frontier) {
+  RETURN_NOT_OK(WakeUp());
+
   // The following two lines can't just be changed to RETURN_NOT_OK(PauseReadWriteOperations()):
   // op_pause has to stay in scope until the end of the function.
   auto op_pause = PauseReadWriteOperations();
@@ -246,6 +371,16 @@ Status TabletSnapshots::RestoreCheckpoint(
     return STATUS(IllegalState, "Unable to copy checkpoint files", s.ToString());
   }
 
+  // The manifest describes the snapshot, it is not a part of the restored DB.
+  const auto manifest_path = SnapshotManifestPath(db_dir);
+  Env* const env = metadata().fs_manager()->env();
+  if (env->FileExists(manifest_path)) {
+    s = env->DeleteFile(manifest_path);
+    if (PREDICT_FALSE(!s.ok())) {
+      LOG_WITH_PREFIX(WARNING) << "Cannot delete snapshot manifest " << manifest_path << ": " << s;
+    }
+  }
+
   if (!intents_db_dir.empty()) {
     auto intents_tmp_dir = JoinPathSegments(dir, tablet::kIntentsSubdir);
     rocksdb_env().RenameFile(intents_db_dir, intents_db_dir);
@@ -300,7 +435,8 @@ Status TabletSnapshots::Delete(SnapshotOperationState* tx_state) {
   Env* const env = metadata().fs_manager()->env();
 
   if (env->FileExists(snapshot_dir)) {
-    const Status deletion_status = env->DeleteRecursively(snapshot_dir);
+    const Status deletion_status =
+        metadata().fs_manager()->DeleteRecursivelyThrottled(snapshot_dir);
     if (PREDICT_FALSE(!deletion_status.ok())) {
       LOG_WITH_PREFIX(WARNING) << "Cannot recursively delete snapshot dir " << snapshot_dir
                                << ": " << deletion_status;
@@ -328,7 +464,7 @@ Status TabletSnapshots::Delete(SnapshotOperationState* tx_state) {
 }
 
 Status TabletSnapshots::CreateCheckpoint(const std::string& dir) {
-  ScopedPendingOperation scoped_read_operation(&pending_op_counter());
+  auto scoped_read_operation = StartReadWriteOperation();
   RETURN_NOT_OK(scoped_read_operation);
 
   auto temp_intents_dir = dir + kIntentsDBSuffix;
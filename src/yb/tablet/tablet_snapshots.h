@@ -68,6 +68,10 @@ class TabletSnapshots : public TabletComponent {
 
   static bool IsTempSnapshotDir(const std::string& dir);
 
+  // Path of the manifest, that lists files of the snapshot in snapshot_dir with their content ids.
+  // See SnapshotManifestPB.
+  static std::string SnapshotManifestPath(const std::string& snapshot_dir);
+
  private:
   // Restore the RocksDB checkpoint from the provided directory.
   // Only used when table_type_ == YQL_TABLE_TYPE.
@@ -152,6 +152,7 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
       TransactionsModifiedUnlocked(&min_running_notifier);
     }
 
+    remove_intents_task_.Shutdown();
     rpcs_.Shutdown();
     if (load_thread_.joinable()) {
       load_thread_.join();
@@ -341,7 +342,7 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
       const auto& id = cleanup_queue_.front().transaction_id;
       auto it = transactions_.find(id);
       if (it != transactions_.end()) {
-        (**it).ScheduleRemoveIntents(*it);
+        (**it).ScheduleRemoveIntents();
         RemoveTransaction(it, min_running_notifier);
       }
       VLOG_WITH_PREFIX(2) << "Cleaned from queue: " << id;
@@ -857,7 +858,7 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
       const Transactions::iterator& it, const std::string& reason,
       MinRunningNotifier* min_running_notifier) {
     if (running_requests_.empty()) {
-      (**it).ScheduleRemoveIntents(*it);
+      (**it).ScheduleRemoveIntents();
       TransactionId txn_id = (**it).id();
       RemoveTransaction(it, min_running_notifier);
       VLOG_WITH_PREFIX(2) << "Cleaned transaction: " << txn_id << ", reason: " << reason
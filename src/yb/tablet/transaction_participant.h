@@ -120,6 +120,11 @@ class TransactionParticipantContext {
   // Returns hybrid time that lower than any future transaction apply record.
   virtual HybridTime SafeTimeForTransactionParticipant() = 0;
 
+  // Cache of final transaction statuses shared by all participants of the server, could be null.
+  virtual FinalTransactionStatusCache* final_status_cache() {
+    return nullptr;
+  }
+
   std::string LogPrefix() const;
 
  protected:
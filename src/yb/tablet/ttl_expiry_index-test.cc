@@ -0,0 +1,90 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/ttl_expiry_index.h"
+
+#include "yb/docdb/value.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace tablet {
+
+class TtlExpiryIndexTest : public YBTest {
+ protected:
+  static HybridTime Seconds(int64_t seconds) {
+    return HybridTime::FromMicros(seconds * MonoTime::kMicrosecondsPerSecond);
+  }
+};
+
+TEST_F(TtlExpiryIndexTest, Buckets) {
+  TtlExpiryIndex index(MonoDelta::FromSeconds(10));
+  index.Add(Seconds(100), MonoDelta::FromSeconds(5), 1);
+  index.Add(Seconds(100), MonoDelta::FromSeconds(8), 2);
+  index.Add(Seconds(100), MonoDelta::FromSeconds(25), 4);
+
+  // Data is counted as expired only when its whole bucket has expired.
+  ASSERT_EQ(0U, index.ExpiredBytes(Seconds(109)));
+  ASSERT_EQ(3U, index.ExpiredBytes(Seconds(110)));
+  ASSERT_EQ(3U, index.ExpiredBytes(Seconds(129)));
+  ASSERT_EQ(7U, index.ExpiredBytes(Seconds(130)));
+
+  index.RemoveExpired(Seconds(115));
+  ASSERT_EQ(0U, index.ExpiredBytes(Seconds(115)));
+  ASSERT_EQ(4U, index.ExpiredBytes(Seconds(130)));
+}
+
+TEST_F(TtlExpiryIndexTest, WriteBatch) {
+  TtlExpiryIndex index(MonoDelta::FromSeconds(1));
+  docdb::KeyValueWriteBatchPB batch;
+  auto* with_ttl = batch.add_write_pairs();
+  with_ttl->set_key("key1");
+  with_ttl->set_value(
+      docdb::Value(docdb::PrimitiveValue("value"), MonoDelta::FromSeconds(5)).Encode());
+  auto* without_ttl = batch.add_write_pairs();
+  without_ttl->set_key("key2");
+  without_ttl->set_value(docdb::Value(docdb::PrimitiveValue("value")).Encode());
+  auto* reset_ttl = batch.add_write_pairs();
+  reset_ttl->set_key("key3");
+  reset_ttl->set_value(
+      docdb::Value(docdb::PrimitiveValue("value"), docdb::Value::kResetTtl).Encode());
+
+  index.AddWriteBatch(batch, Seconds(100));
+  ASSERT_EQ(0U, index.ExpiredBytes(Seconds(105)));
+  ASSERT_EQ(with_ttl->key().size() + with_ttl->value().size(),
+            index.ExpiredBytes(Seconds(106)));
+  ASSERT_EQ(with_ttl->key().size() + with_ttl->value().size(),
+            index.ExpiredBytes(HybridTime::kMax));
+}
+
+TEST_F(TtlExpiryIndexTest, OverwriteInWriteBatch) {
+  TtlExpiryIndex index(MonoDelta::FromSeconds(1));
+  docdb::KeyValueWriteBatchPB batch;
+  auto* overwritten = batch.add_write_pairs();
+  overwritten->set_key("key");
+  overwritten->set_value(
+      docdb::Value(docdb::PrimitiveValue("value"), MonoDelta::FromSeconds(5)).Encode());
+  auto* last = batch.add_write_pairs();
+  last->set_key("key");
+  last->set_value(
+      docdb::Value(docdb::PrimitiveValue("new value"), MonoDelta::FromSeconds(10)).Encode());
+
+  // Only the last write of the key is accounted.
+  index.AddWriteBatch(batch, Seconds(100));
+  ASSERT_EQ(0U, index.ExpiredBytes(Seconds(106)));
+  ASSERT_EQ(last->key().size() + last->value().size(), index.ExpiredBytes(HybridTime::kMax));
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,76 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/ttl_expiry_index.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "yb/docdb/value.h"
+
+#include "yb/util/slice.h"
+
+namespace yb {
+namespace tablet {
+
+TtlExpiryIndex::TtlExpiryIndex(MonoDelta bucket_size)
+    : bucket_size_us_(std::max<MicrosTime>(bucket_size.ToMicroseconds(), 1)) {
+}
+
+void TtlExpiryIndex::AddWriteBatch(
+    const docdb::KeyValueWriteBatchPB& batch, HybridTime write_time) {
+  // Only the last write of a key in the batch is kept, so overwritten entries are not counted.
+  std::unordered_set<Slice, Slice::Hash> keys;
+  const auto& pairs = batch.write_pairs();
+  for (auto it = pairs.rbegin(); it != pairs.rend(); ++it) {
+    const auto& pair = *it;
+    if (!keys.insert(pair.key()).second) {
+      continue;
+    }
+    MonoDelta ttl;
+    if (!docdb::Value::DecodeTTL(pair.value(), &ttl).ok()) {
+      continue;
+    }
+    // Entries without TTL, and special TTL values, like reset or negative TTL, are not accounted.
+    if (ttl.Equals(docdb::Value::kMaxTtl) || ttl.ToNanoseconds() <= 0) {
+      continue;
+    }
+    Add(write_time, ttl, pair.key().size() + pair.value().size());
+  }
+}
+
+void TtlExpiryIndex::Add(HybridTime write_time, MonoDelta ttl, size_t size) {
+  const auto expire_us = write_time.GetPhysicalValueMicros() + ttl.ToMicroseconds();
+  const auto bucket_end = (expire_us / bucket_size_us_ + 1) * bucket_size_us_;
+  std::lock_guard<std::mutex> lock(mutex_);
+  buckets_[bucket_end] += size;
+}
+
+size_t TtlExpiryIndex::ExpiredBytes(HybridTime cutoff) const {
+  const auto cutoff_us = cutoff.GetPhysicalValueMicros();
+  size_t result = 0;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto it = buckets_.begin(); it != buckets_.end() && it->first <= cutoff_us; ++it) {
+    result += it->second;
+  }
+  return result;
+}
+
+void TtlExpiryIndex::RemoveExpired(HybridTime cutoff) {
+  const auto cutoff_us = cutoff.GetPhysicalValueMicros();
+  std::lock_guard<std::mutex> lock(mutex_);
+  buckets_.erase(buckets_.begin(), buckets_.upper_bound(cutoff_us));
+}
+
+} // namespace tablet
+} // namespace yb
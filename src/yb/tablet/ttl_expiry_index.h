@@ -0,0 +1,66 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_TTL_EXPIRY_INDEX_H
+#define YB_TABLET_TTL_EXPIRY_INDEX_H
+
+#include <map>
+#include <mutex>
+
+#include "yb/common/hybrid_time.h"
+
+#include "yb/docdb/docdb.pb.h"
+
+#include "yb/util/monotime.h"
+
+namespace yb {
+namespace tablet {
+
+// Time bucketed index of the amount of data written to the tablet with TTL.
+//
+// It is used to find out when enough data has expired for a compaction of the tablet to be
+// worthwhile, instead of waiting for the size based compaction to pick files with expired data.
+// Only entries that carry TTL are accounted, children of a document with TTL are not. The index
+// is kept in memory, so data written before the tablet was opened is not accounted.
+class TtlExpiryIndex {
+ public:
+  explicit TtlExpiryIndex(MonoDelta bucket_size);
+
+  TtlExpiryIndex(const TtlExpiryIndex&) = delete;
+  void operator=(const TtlExpiryIndex&) = delete;
+
+  // Accounts entries of the batch, applied at write_time, that have TTL.
+  void AddWriteBatch(const docdb::KeyValueWriteBatchPB& batch, HybridTime write_time);
+
+  // Accounts size bytes written at write_time, that expire after ttl.
+  void Add(HybridTime write_time, MonoDelta ttl, size_t size);
+
+  // Returns the number of accounted bytes that expired before cutoff.
+  size_t ExpiredBytes(HybridTime cutoff) const;
+
+  // Forgets data that expired before cutoff, supposed to be called after such data was removed by
+  // a compaction.
+  void RemoveExpired(HybridTime cutoff);
+
+ private:
+  const MicrosTime bucket_size_us_;
+
+  mutable std::mutex mutex_;
+  // Maps the end of a time bucket to the number of bytes that expire in this bucket.
+  std::map<MicrosTime, size_t> buckets_;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_TTL_EXPIRY_INDEX_H
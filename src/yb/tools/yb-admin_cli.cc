@@ -53,6 +53,7 @@ namespace {
 const int32 kDefaultRpcPort = 9100;
 const string kBlacklistAdd("ADD");
 const string kBlacklistRemove("REMOVE");
+const string kLogOnly("LOG_ONLY");
 
 CHECKED_STATUS GetUniverseConfig(ClusterAdminClientClass* client,
                                  const ClusterAdminCli::CLIArguments&) {
@@ -177,9 +178,9 @@ void ClusterAdminCli::RegisterCommandHandlers(ClusterAdminClientClass* client) {
 
   Register(
       "change_config",
-      " <tablet_id> <ADD_SERVER|REMOVE_SERVER> <peer_uuid> [PRE_VOTER|PRE_OBSERVER]",
+      " <tablet_id> <ADD_SERVER|REMOVE_SERVER> <peer_uuid> [PRE_VOTER|PRE_OBSERVER] [LOG_ONLY]",
       [client](const CLIArguments& args) -> Status {
-        if (args.size() < 5) {
+        if (args.size() < 5 || args.size() > 7) {
           return ClusterAdminCli::kInvalidArguments;
         }
         const string tablet_id = args[2];
@@ -189,8 +190,16 @@ void ClusterAdminCli::RegisterCommandHandlers(ClusterAdminClientClass* client) {
         if (args.size() > 5) {
           member_type = args[5];
         }
-        RETURN_NOT_OK_PREPEND(client->ChangeConfig(tablet_id, change_type, peer_uuid, member_type),
-                              "Unable to change config");
+        bool log_only = false;
+        if (args.size() > 6) {
+          if (args[6] != kLogOnly) {
+            return ClusterAdminCli::kInvalidArguments;
+          }
+          log_only = true;
+        }
+        RETURN_NOT_OK_PREPEND(
+            client->ChangeConfig(tablet_id, change_type, peer_uuid, member_type, log_only),
+            "Unable to change config");
         return Status::OK();
       });
 
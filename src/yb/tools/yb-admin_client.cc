@@ -285,7 +285,8 @@ Status ClusterAdminClient::ChangeConfig(
     const TabletId& tablet_id,
     const string& change_type,
     const PeerId& peer_uuid,
-    const boost::optional<string>& member_type) {
+    const boost::optional<string>& member_type,
+    bool log_only) {
   CHECK(initted_);
 
   consensus::ChangeConfigType cc_type;
@@ -313,6 +314,13 @@ Status ClusterAdminClient::ChangeConfig(
     return STATUS(InvalidArgument, "Must specify member_type when adding a server.");
   }
 
+  if (log_only) {
+    if (cc_type != consensus::ADD_SERVER || peer_pb.member_type() != RaftPeerPB::PRE_VOTER) {
+      return STATUS(InvalidArgument, "Only a PRE_VOTER server could be added as log-only.");
+    }
+    peer_pb.set_log_only(true);
+  }
+
   // Look up RPC address of peer if adding as a new server.
   if (cc_type == consensus::ADD_SERVER) {
     HostPort host_port = VERIFY_RESULT(GetFirstRpcAddressForTS(peer_uuid));
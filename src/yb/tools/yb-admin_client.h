@@ -87,12 +87,14 @@ class ClusterAdminClient {
       const std::string& change_type,
       consensus::ChangeConfigType* cc_type);
 
-  // Change the configuration of the specified tablet.
+  // Change the configuration of the specified tablet. When log_only is set, the server is added
+  // as a log-only (witness) peer, that votes and keeps the log, but not the data.
   CHECKED_STATUS ChangeConfig(
       const TabletId& tablet_id,
       const std::string& change_type,
       const PeerId& peer_uuid,
-      const boost::optional<std::string>& member_type);
+      const boost::optional<std::string>& member_type,
+      bool log_only = false);
 
   // Change the configuration of the master tablet.
   CHECKED_STATUS ChangeMasterConfig(
@@ -0,0 +1,298 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// Deterministic replay benchmark. Reads the WAL segments captured from a tablet and applies their
+// write batches to a fresh tablet, bypassing Raft, either as fast as possible or paced by the
+// original hybrid times of the entries. Reports apply throughput, memtable usage and flush and
+// compaction activity of the regular RocksDB, so storage engine changes could be compared on the
+// same production workload.
+
+#include <iostream>
+#include <memory>
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include "yb/consensus/consensus.pb.h"
+#include "yb/consensus/log_anchor_registry.h"
+#include "yb/consensus/log_index.h"
+#include "yb/consensus/log_reader.h"
+#include "yb/fs/fs_manager.h"
+#include "yb/rocksdb/statistics.h"
+#include "yb/server/logical_clock.h"
+#include "yb/tablet/operations/write_operation.h"
+#include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_metadata.h"
+#include "yb/util/env.h"
+#include "yb/util/flags.h"
+#include "yb/util/logging.h"
+#include "yb/util/mem_tracker.h"
+#include "yb/util/metrics.h"
+#include "yb/util/monotime.h"
+
+DEFINE_string(replay_dest_dir, "",
+              "Root directory of the file system the tablet is replayed into. Must not exist.");
+DEFINE_double(replay_speed, 0,
+              "Rate of replay relative to the original hybrid times of the WAL entries, i.e. 1 "
+              "replays at the original rate and 10 ten times faster. 0 replays as fast as "
+              "possible.");
+DEFINE_int64(replay_report_interval_ops, 100000,
+             "Log replay progress every this number of applied operations. 0 disables it.");
+DEFINE_bool(replay_flush_at_end, true,
+            "Flush the replayed tablet after the last entry, so flush cost is included.");
+
+namespace yb {
+namespace tools {
+
+using consensus::ReplicateMsg;
+using log::LogReader;
+using log::ReadableLogSegment;
+using log::SegmentSequence;
+using tablet::RaftGroupMetadata;
+using tablet::RaftGroupMetadataPtr;
+
+namespace {
+
+struct ReplayStats {
+  size_t applied_ops = 0;
+  size_t skipped_ops = 0;
+  size_t applied_bytes = 0;
+  MonoDelta apply_time = MonoDelta::kZero;
+  MonoDelta paced_wait = MonoDelta::kZero;
+};
+
+class WalReplayer {
+ public:
+  WalReplayer(std::string tablet_id, std::string wal_dir)
+      : env_(Env::Default()), tablet_id_(std::move(tablet_id)), wal_dir_(std::move(wal_dir)) {}
+
+  CHECKED_STATUS Init() {
+    if (FLAGS_replay_dest_dir.empty()) {
+      return STATUS(InvalidArgument, "--replay_dest_dir is not specified");
+    }
+    if (env_->FileExists(FLAGS_replay_dest_dir)) {
+      return STATUS_FORMAT(AlreadyPresent, "Replay destination $0 already exists",
+                           FLAGS_replay_dest_dir);
+    }
+
+    // Source tablet metadata provides the schema and partitioning of the replayed tablet.
+    FsManagerOpts source_opts;
+    source_opts.read_only = true;
+    source_fs_manager_.reset(new FsManager(env_, source_opts));
+    RETURN_NOT_OK(source_fs_manager_->Open());
+    RaftGroupMetadataPtr source_metadata;
+    RETURN_NOT_OK(RaftGroupMetadata::Load(source_fs_manager_.get(), tablet_id_, &source_metadata));
+
+    fs_manager_.reset(new FsManager(env_, FLAGS_replay_dest_dir, "tserver_test"));
+    RETURN_NOT_OK(fs_manager_->CreateInitialFileSystemLayout());
+    RETURN_NOT_OK(fs_manager_->Open());
+
+    RaftGroupMetadataPtr metadata;
+    RETURN_NOT_OK(RaftGroupMetadata::LoadOrCreate(fs_manager_.get(),
+                                                  source_metadata->table_id(),
+                                                  tablet_id_,
+                                                  source_metadata->table_name(),
+                                                  source_metadata->table_type(),
+                                                  source_metadata->schema(),
+                                                  source_metadata->partition_schema(),
+                                                  source_metadata->partition(),
+                                                  boost::none /* index_info */,
+                                                  tablet::TABLET_DATA_READY,
+                                                  &metadata));
+
+    metric_registry_.reset(new MetricRegistry());
+    mem_tracker_ = MemTracker::CreateTracker("WalReplay");
+    clock_ = server::LogicalClock::CreateStartingAt(HybridTime::kInitial);
+    tablet_ = std::make_shared<tablet::Tablet>(
+        metadata,
+        std::shared_future<client::YBClient*>(),
+        clock_,
+        mem_tracker_,
+        std::shared_ptr<MemTracker>(),
+        metric_registry_.get(),
+        new log::LogAnchorRegistry(),
+        tablet::TabletOptions(),
+        std::string() /* log_pefix_suffix */,
+        nullptr /* transaction_participant_context */,
+        client::LocalTabletFilter(),
+        nullptr /* transaction_coordinator_context */,
+        tablet::IsSysCatalogTablet::kFalse,
+        tablet::TransactionsEnabled::kFalse);
+    RETURN_NOT_OK(tablet_->Open());
+    tablet_->MarkFinishedBootstrapping();
+    return tablet_->EnableCompactions(/* operation_pause */ nullptr);
+  }
+
+  CHECKED_STATUS Run() {
+    std::unique_ptr<LogReader> reader;
+    RETURN_NOT_OK(LogReader::Open(env_,
+                                  scoped_refptr<log::LogIndex>(),
+                                  tablet_id_,
+                                  wal_dir_,
+                                  source_fs_manager_->uuid(),
+                                  scoped_refptr<MetricEntity>(),
+                                  &reader));
+    SegmentSequence segments;
+    RETURN_NOT_OK(reader->GetSegmentsSnapshot(&segments));
+
+    start_ = MonoTime::Now();
+    for (const scoped_refptr<ReadableLogSegment>& segment : segments) {
+      auto read_entries = segment->ReadEntries();
+      RETURN_NOT_OK(read_entries.status);
+      for (const auto& entry : read_entries.entries) {
+        if (entry->has_replicate()) {
+          Replay(entry->mutable_replicate());
+        }
+      }
+    }
+
+    if (FLAGS_replay_flush_at_end) {
+      auto flush_start = MonoTime::Now();
+      RETURN_NOT_OK(tablet_->Flush(tablet::FlushMode::kSync));
+      stats_.apply_time += MonoTime::Now() - flush_start;
+    }
+    total_time_ = MonoTime::Now() - start_;
+    Report();
+    tablet_->StartShutdown();
+    tablet_->CompleteShutdown();
+    return Status::OK();
+  }
+
+ private:
+  void Replay(ReplicateMsg* replicate) {
+    // Transactional writes need a transaction participant and are applied by UPDATE_TRANSACTION_OP
+    // entries, so only plain writes are replayed.
+    HybridTime hybrid_time(replicate->hybrid_time());
+    if (replicate->op_type() != consensus::WRITE_OP ||
+        replicate->write_request().write_batch().has_transaction() ||
+        hybrid_time <= last_hybrid_time_) {
+      // Entries of an overwritten term could go back in time, MVCC requires increasing hybrid
+      // times so those are skipped as well.
+      ++stats_.skipped_ops;
+      return;
+    }
+    WaitForReplayTime(hybrid_time);
+
+    auto apply_start = MonoTime::Now();
+    tablet::WriteOperationState operation_state(nullptr, replicate->mutable_write_request());
+    operation_state.mutable_op_id()->CopyFrom(replicate->id());
+    operation_state.set_hybrid_time(hybrid_time);
+    clock_->Update(hybrid_time);
+
+    tablet_->mvcc_manager()->AddPending(&hybrid_time);
+    tablet_->StartOperation(&operation_state);
+    WARN_NOT_OK(tablet_->ApplyRowOperations(&operation_state), "ApplyRowOperations failed: ");
+    tablet_->mvcc_manager()->Replicated(hybrid_time);
+    stats_.apply_time += MonoTime::Now() - apply_start;
+
+    last_hybrid_time_ = hybrid_time;
+    stats_.applied_bytes += replicate->write_request().ByteSize();
+    ++stats_.applied_ops;
+    if (FLAGS_replay_report_interval_ops > 0 &&
+        stats_.applied_ops % FLAGS_replay_report_interval_ops == 0) {
+      LOG(INFO) << "Applied " << stats_.applied_ops << " operations, memtables: "
+                << mem_tracker_->consumption() << " bytes";
+    }
+  }
+
+  // Sleeps until the wall clock offset from the start of the replay matches the offset of the
+  // entry from the first replayed entry, divided by the replay speed.
+  void WaitForReplayTime(HybridTime hybrid_time) {
+    if (FLAGS_replay_speed <= 0) {
+      return;
+    }
+    if (!first_hybrid_time_.is_valid()) {
+      first_hybrid_time_ = hybrid_time;
+      return;
+    }
+    auto offset = MonoDelta::FromMicroseconds(
+        hybrid_time.PhysicalDiff(first_hybrid_time_) / FLAGS_replay_speed);
+    auto wait = start_ + offset - MonoTime::Now();
+    if (wait.ToMicroseconds() > 0) {
+      SleepFor(wait);
+      stats_.paced_wait += wait;
+    }
+  }
+
+  void Report() {
+    const auto& statistics = tablet_->rocksdb_statistics();
+    auto seconds = std::max(stats_.apply_time.ToSeconds(), 1e-6);
+    std::cout << "Applied operations: " << stats_.applied_ops << std::endl
+              << "Skipped operations: " << stats_.skipped_ops << std::endl
+              << "Applied bytes: " << stats_.applied_bytes << std::endl
+              << "Total time: " << total_time_.ToString() << std::endl
+              << "Apply time: " << stats_.apply_time.ToString() << std::endl
+              << "Paced wait: " << stats_.paced_wait.ToString() << std::endl
+              << "Apply throughput: " << stats_.applied_ops / seconds << " ops/s, "
+              << stats_.applied_bytes / seconds << " bytes/s" << std::endl
+              << "Peak memtable usage: " << mem_tracker_->peak_consumption() << std::endl
+              << "SST files: " << tablet_->GetCurrentVersionNumSSTFiles() << ", "
+              << tablet_->GetCurrentVersionSstFilesSize() << " bytes" << std::endl;
+    if (statistics) {
+      std::cout << "Flush write bytes: "
+                << statistics->getTickerCount(rocksdb::FLUSH_WRITE_BYTES) << std::endl
+                << "Compaction read bytes: "
+                << statistics->getTickerCount(rocksdb::COMPACT_READ_BYTES) << std::endl
+                << "Compaction write bytes: "
+                << statistics->getTickerCount(rocksdb::COMPACT_WRITE_BYTES) << std::endl
+                << "Write stall micros: "
+                << statistics->getTickerCount(rocksdb::STALL_MICROS) << std::endl;
+    }
+  }
+
+  Env* const env_;
+  const std::string tablet_id_;
+  const std::string wal_dir_;
+
+  std::unique_ptr<FsManager> source_fs_manager_;
+  std::unique_ptr<FsManager> fs_manager_;
+  std::unique_ptr<MetricRegistry> metric_registry_;
+  std::shared_ptr<MemTracker> mem_tracker_;
+  scoped_refptr<server::Clock> clock_;
+  tablet::TabletPtr tablet_;
+
+  MonoTime start_;
+  MonoDelta total_time_;
+  HybridTime first_hybrid_time_;
+  HybridTime last_hybrid_time_ = HybridTime::kMin;
+  ReplayStats stats_;
+};
+
+} // namespace
+
+Status ReplayWal(const std::string& tablet_id, const std::string& wal_dir) {
+  WalReplayer replayer(tablet_id, wal_dir);
+  RETURN_NOT_OK(replayer.Init());
+  return replayer.Run();
+}
+
+} // namespace tools
+} // namespace yb
+
+int main(int argc, char** argv) {
+  yb::ParseCommandLineFlags(&argc, &argv, true);
+  if (argc != 3) {
+    std::cerr << "usage: " << argv[0]
+              << " -fs_data_dirs <dirs> -replay_dest_dir <dir> <tablet_id> <wal dir>"
+              << std::endl;
+    return 1;
+  }
+  yb::InitGoogleLoggingSafe(argv[0]);
+
+  auto status = yb::tools::ReplayWal(argv[1], argv[2]);
+  if (!status.ok()) {
+    std::cerr << "Error: " << status.ToString() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -444,7 +444,16 @@ Status Heartbeater::Thread::TryHeartbeat() {
   }
 
   // Update the live tserver list.
-  return server_->PopulateLiveTServers(last_hb_response_);
+  RETURN_NOT_OK(server_->PopulateLiveTServers(last_hb_response_));
+
+  if (req.tablet_report().remaining_tablet_count() > 0) {
+    // Send the rest of the tablets right away, instead of waiting for the heartbeat interval.
+    VLOG_WITH_PREFIX(1) << "Tablets remaining for the next tablet report: "
+                        << req.tablet_report().remaining_tablet_count();
+    return STATUS(TryAgain, "");
+  }
+
+  return Status::OK();
 }
 
 Status Heartbeater::Thread::DoHeartbeat() {
@@ -0,0 +1,103 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/memory_rebalancer.h"
+
+#include "yb/util/test_util.h"
+
+DECLARE_int32(memory_rebalancer_step_percentage);
+DECLARE_int32(memory_rebalancer_max_change_percentage);
+DECLARE_double(memory_rebalancer_min_pressure_gap);
+
+METRIC_DECLARE_counter(memory_rebalancer_moves);
+
+namespace yb {
+namespace tserver {
+
+class MemoryRebalancerTest : public YBTest {
+ protected:
+  MemoryConsumer Consumer(const std::string& name, int64_t budget, const double* pressure,
+                          int64_t* applied) {
+    *applied = budget;
+    return MemoryConsumer {
+      name, budget, [pressure] { return *pressure; }, [applied](int64_t b) { *applied = b; },
+      nullptr
+    };
+  }
+
+  MetricRegistry registry_;
+  scoped_refptr<MetricEntity> entity_ = METRIC_ENTITY_server.Instantiate(&registry_, "test");
+};
+
+TEST_F(MemoryRebalancerTest, MovesBudgetWithinBounds) {
+  FLAGS_memory_rebalancer_step_percentage = 10;
+  FLAGS_memory_rebalancer_max_change_percentage = 50;
+  FLAGS_memory_rebalancer_min_pressure_gap = 0.1;
+
+  double cache_pressure = 0.9;
+  double memstore_pressure = 0.1;
+  double log_cache_pressure = 0.5;
+  int64_t cache_budget, memstore_budget, log_cache_budget;
+  MemoryRebalancer rebalancer({
+      Consumer("cache", 600, &cache_pressure, &cache_budget),
+      Consumer("memstore", 200, &memstore_pressure, &memstore_budget),
+      Consumer("log cache", 200, &log_cache_pressure, &log_cache_budget),
+  }, entity_);
+
+  // 10% of the total budget is moved from the memstore to the cache.
+  ASSERT_TRUE(rebalancer.Rebalance());
+  ASSERT_EQ(700, cache_budget);
+  ASSERT_EQ(100, memstore_budget);
+  ASSERT_EQ(200, log_cache_budget);
+
+  // The memstore reached its lower bound, so the log cache becomes the donor.
+  ASSERT_TRUE(rebalancer.Rebalance());
+  ASSERT_EQ(800, cache_budget);
+  ASSERT_EQ(100, memstore_budget);
+  ASSERT_EQ(100, log_cache_budget);
+
+  // Other consumers reached their lower bounds.
+  ASSERT_FALSE(rebalancer.Rebalance());
+  ASSERT_EQ(800, cache_budget);
+
+  ASSERT_EQ((std::vector<int64_t>{800, 100, 100}), rebalancer.budgets());
+  ASSERT_EQ(2, METRIC_memory_rebalancer_moves.Instantiate(entity_)->value());
+
+  // Pressure moved to the memstore.
+  cache_pressure = 0.5;
+  memstore_pressure = 1.0;
+  ASSERT_TRUE(rebalancer.Rebalance());
+  ASSERT_EQ(200, memstore_budget);
+  ASSERT_EQ(700, cache_budget);
+  ASSERT_EQ(100, log_cache_budget);
+  ASSERT_EQ(1000, cache_budget + memstore_budget + log_cache_budget);
+}
+
+TEST_F(MemoryRebalancerTest, SimilarPressure) {
+  FLAGS_memory_rebalancer_min_pressure_gap = 0.1;
+
+  double cache_pressure = 0.55;
+  double memstore_pressure = 0.5;
+  int64_t cache_budget, memstore_budget;
+  MemoryRebalancer rebalancer({
+      Consumer("cache", 500, &cache_pressure, &cache_budget),
+      Consumer("memstore", 500, &memstore_pressure, &memstore_budget),
+  }, entity_);
+
+  ASSERT_FALSE(rebalancer.Rebalance());
+  ASSERT_EQ(500, cache_budget);
+  ASSERT_EQ(500, memstore_budget);
+}
+
+} // namespace tserver
+} // namespace yb
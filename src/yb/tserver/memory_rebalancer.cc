@@ -0,0 +1,148 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/memory_rebalancer.h"
+
+#include <algorithm>
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/format.h"
+#include "yb/util/logging.h"
+
+DEFINE_int32(memory_rebalancer_step_percentage, 1,
+             "Percentage of the total memory budget moved between consumers by a single "
+             "rebalancing decision.");
+TAG_FLAG(memory_rebalancer_step_percentage, advanced);
+TAG_FLAG(memory_rebalancer_step_percentage, runtime);
+
+DEFINE_int32(memory_rebalancer_max_change_percentage, 50,
+             "Budget of every consumer stays within this percentage of its configured budget.");
+TAG_FLAG(memory_rebalancer_max_change_percentage, advanced);
+TAG_FLAG(memory_rebalancer_max_change_percentage, runtime);
+
+DEFINE_double(memory_rebalancer_min_pressure_gap, 0.1,
+              "Budget is moved only when pressures of the donor and the receiver, in the range "
+              "from 0 to 1, differ by at least this value.");
+TAG_FLAG(memory_rebalancer_min_pressure_gap, advanced);
+TAG_FLAG(memory_rebalancer_min_pressure_gap, runtime);
+
+METRIC_DEFINE_counter(server, memory_rebalancer_moves, "Memory Rebalancer Moves",
+                      yb::MetricUnit::kOperations,
+                      "Number of times the memory rebalancer moved budget between consumers.");
+METRIC_DEFINE_counter(server, memory_rebalancer_moved_bytes, "Memory Rebalancer Moved Bytes",
+                      yb::MetricUnit::kBytes,
+                      "Total budget moved by the memory rebalancer between consumers.");
+
+namespace yb {
+namespace tserver {
+
+MemoryRebalancer::MemoryRebalancer(std::vector<MemoryConsumer> consumers,
+                                   const scoped_refptr<MetricEntity>& metric_entity) {
+  consumers_.reserve(consumers.size());
+  for (auto& consumer : consumers) {
+    total_budget_ += consumer.initial_budget;
+    auto budget = consumer.initial_budget;
+    if (consumer.budget_gauge) {
+      consumer.budget_gauge->set_value(budget);
+    }
+    consumers_.push_back(ConsumerState { std::move(consumer), budget });
+  }
+  if (metric_entity) {
+    moves_ = METRIC_memory_rebalancer_moves.Instantiate(metric_entity);
+    moved_bytes_ = METRIC_memory_rebalancer_moved_bytes.Instantiate(metric_entity);
+  }
+}
+
+bool MemoryRebalancer::Rebalance() {
+  const auto max_change =
+      std::min(std::max(FLAGS_memory_rebalancer_max_change_percentage, 0), 100);
+  auto min_budget = [max_change](const ConsumerState& state) {
+    return state.consumer.initial_budget * (100 - max_change) / 100;
+  };
+  auto max_budget = [max_change](const ConsumerState& state) {
+    return state.consumer.initial_budget * (100 + max_change) / 100;
+  };
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<double> pressures;
+  pressures.reserve(consumers_.size());
+  for (const auto& state : consumers_) {
+    pressures.push_back(std::min(std::max(state.consumer.pressure(), 0.0), 1.0));
+  }
+
+  // The receiver is the consumer with the highest pressure that could still grow, and the donor is
+  // the consumer with the lowest pressure that could still shrink.
+  ConsumerState* receiver = nullptr;
+  ConsumerState* donor = nullptr;
+  double receiver_pressure = 0;
+  double donor_pressure = 0;
+  for (size_t i = 0; i != consumers_.size(); ++i) {
+    auto& state = consumers_[i];
+    if (state.budget < max_budget(state) && (!receiver || pressures[i] > receiver_pressure)) {
+      receiver = &state;
+      receiver_pressure = pressures[i];
+    }
+  }
+  for (size_t i = 0; i != consumers_.size(); ++i) {
+    auto& state = consumers_[i];
+    if (&state != receiver && state.budget > min_budget(state) &&
+        (!donor || pressures[i] < donor_pressure)) {
+      donor = &state;
+      donor_pressure = pressures[i];
+    }
+  }
+  if (!receiver || !donor ||
+      receiver_pressure - donor_pressure < FLAGS_memory_rebalancer_min_pressure_gap) {
+    return false;
+  }
+
+  auto step = total_budget_ * std::max(FLAGS_memory_rebalancer_step_percentage, 0) / 100;
+  step = std::min({step, max_budget(*receiver) - receiver->budget,
+                   donor->budget - min_budget(*donor)});
+  if (step <= 0) {
+    return false;
+  }
+
+  LOG(INFO) << Format(
+      "Moving $0 bytes of memory budget from $1 (pressure $2, budget $3) to $4 (pressure $5, "
+          "budget $6)",
+      step, donor->consumer.name, donor_pressure, donor->budget, receiver->consumer.name,
+      receiver_pressure, receiver->budget);
+
+  // Shrink the donor first, so the sum of applied budgets never exceeds the total.
+  for (auto* state : {donor, receiver}) {
+    state->budget += state == donor ? -step : step;
+    state->consumer.set_budget(state->budget);
+    if (state->consumer.budget_gauge) {
+      state->consumer.budget_gauge->set_value(state->budget);
+    }
+  }
+  if (moves_) {
+    moves_->Increment();
+    moved_bytes_->IncrementBy(step);
+  }
+  return true;
+}
+
+std::vector<int64_t> MemoryRebalancer::budgets() const {
+  std::vector<int64_t> result;
+  std::lock_guard<std::mutex> lock(mutex_);
+  result.reserve(consumers_.size());
+  for (const auto& state : consumers_) {
+    result.push_back(state.budget);
+  }
+  return result;
+}
+
+} // namespace tserver
+} // namespace yb
@@ -0,0 +1,83 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TSERVER_MEMORY_REBALANCER_H
+#define YB_TSERVER_MEMORY_REBALANCER_H
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "yb/util/metrics.h"
+
+namespace yb {
+namespace tserver {
+
+// Memory consumer, whose budget could be changed at runtime.
+struct MemoryConsumer {
+  std::string name;
+
+  // Budget, in bytes, the consumer was configured with. Bounds of the budget are derived from it.
+  int64_t initial_budget = 0;
+
+  // Returns how much the consumer would benefit from a larger budget, from 0 to 1. For instance
+  // the miss ratio of a cache, or the fraction of the budget in use.
+  std::function<double()> pressure;
+
+  // Applies the new budget in bytes.
+  std::function<void(int64_t)> set_budget;
+
+  // Optional gauge that reflects the current budget.
+  scoped_refptr<AtomicGauge<int64_t>> budget_gauge;
+};
+
+// Shifts memory budget between consumers, keeping the sum of budgets unchanged.
+//
+// Each Rebalance() moves memory_rebalancer_step_percentage of the total budget from the consumer
+// with the lowest pressure to the consumer with the highest pressure, when their pressures differ
+// by at least memory_rebalancer_min_pressure_gap. Budget of every consumer stays within
+// memory_rebalancer_max_change_percentage of its initial budget.
+class MemoryRebalancer {
+ public:
+  MemoryRebalancer(std::vector<MemoryConsumer> consumers,
+                   const scoped_refptr<MetricEntity>& metric_entity);
+
+  MemoryRebalancer(const MemoryRebalancer&) = delete;
+  void operator=(const MemoryRebalancer&) = delete;
+
+  // Makes a single rebalancing decision, returns true if budget was moved.
+  bool Rebalance();
+
+  // Returns the current budget of each consumer, in the order they were specified.
+  std::vector<int64_t> budgets() const;
+
+ private:
+  struct ConsumerState {
+    MemoryConsumer consumer;
+    int64_t budget;
+  };
+
+  std::vector<ConsumerState> consumers_;
+  int64_t total_budget_ = 0;
+
+  scoped_refptr<Counter> moves_;
+  scoped_refptr<Counter> moved_bytes_;
+
+  mutable std::mutex mutex_;
+};
+
+} // namespace tserver
+} // namespace yb
+
+#endif // YB_TSERVER_MEMORY_REBALANCER_H
@@ -0,0 +1,68 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <map>
+
+#include "yb/tserver/memstore_write_index.h"
+
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace tserver {
+
+class MemstoreWriteIndexTest : public YBTest {
+ protected:
+  TabletId Oldest() {
+    return index_.Oldest([this](const TabletId& tablet_id) {
+      auto it = actual_.find(tablet_id);
+      return it == actual_.end() ? HybridTime::kMax : it->second;
+    });
+  }
+
+  void Write(const TabletId& tablet_id, HybridTime ht) {
+    actual_[tablet_id] = ht;
+    index_.Update(tablet_id, ht);
+  }
+
+  MemstoreWriteIndex index_;
+  // Actual oldest memtable writes of tablets.
+  std::map<TabletId, HybridTime> actual_;
+};
+
+TEST_F(MemstoreWriteIndexTest, Basic) {
+  ASSERT_EQ("", Oldest());
+
+  Write("a", HybridTime(30));
+  Write("b", HybridTime(10));
+  Write("c", HybridTime(20));
+  ASSERT_EQ("b", Oldest());
+  ASSERT_EQ(3, index_.size());
+
+  // Tablet b was flushed, but its entry was not updated.
+  actual_.erase("b");
+  ASSERT_EQ("c", Oldest());
+  ASSERT_EQ(2, index_.size());
+
+  // Tablet c was flushed and got a new write, that was not reported.
+  actual_["c"] = HybridTime(40);
+  ASSERT_EQ("a", Oldest());
+  ASSERT_EQ(2, index_.size());
+
+  index_.Update("a", HybridTime::kMax);
+  actual_.erase("a");
+  ASSERT_EQ("c", Oldest());
+  ASSERT_EQ(1, index_.size());
+}
+
+} // namespace tserver
+} // namespace yb
@@ -0,0 +1,67 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/memstore_write_index.h"
+
+namespace yb {
+namespace tserver {
+
+void MemstoreWriteIndex::Update(const TabletId& tablet_id, HybridTime oldest_write) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  UpdateUnlocked(tablet_id, oldest_write);
+}
+
+void MemstoreWriteIndex::UpdateUnlocked(const TabletId& tablet_id, HybridTime oldest_write) {
+  auto& by_tablet = entries_.get<TabletTag>();
+  auto it = by_tablet.find(tablet_id);
+  if (oldest_write == HybridTime::kMax) {
+    if (it != by_tablet.end()) {
+      by_tablet.erase(it);
+    }
+    return;
+  }
+  if (it == by_tablet.end()) {
+    by_tablet.insert(Entry { tablet_id, oldest_write });
+  } else {
+    by_tablet.modify(it, [oldest_write](Entry& entry) { entry.oldest_write = oldest_write; });
+  }
+}
+
+TabletId MemstoreWriteIndex::Oldest(const OldestWriteProvider& provider) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& by_time = entries_.get<TimeTag>();
+  while (!by_time.empty()) {
+    auto it = by_time.begin();
+    auto tablet_id = it->tablet_id;
+    auto actual = provider(tablet_id);
+    if (actual <= it->oldest_write) {
+      // Tablet is even older than it was recorded, so it is the oldest one anyway.
+      if (actual != it->oldest_write) {
+        UpdateUnlocked(tablet_id, actual);
+      }
+      return tablet_id;
+    }
+    // Stale entry, reposition or remove it and look at the next oldest one. Entries are moved
+    // only to later times, so the loop terminates.
+    UpdateUnlocked(tablet_id, actual);
+  }
+  return TabletId();
+}
+
+size_t MemstoreWriteIndex::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+} // namespace tserver
+} // namespace yb
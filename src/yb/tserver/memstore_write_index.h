@@ -0,0 +1,85 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TSERVER_MEMSTORE_WRITE_INDEX_H
+#define YB_TSERVER_MEMSTORE_WRITE_INDEX_H
+
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+
+#include "yb/common/entity_ids.h"
+#include "yb/common/hybrid_time.h"
+
+namespace yb {
+namespace tserver {
+
+// Orders tablets by the hybrid time of the oldest write in their mutable memtables, so the tablet
+// to flush, when the global memstore limit is reached, is found without scanning all tablets.
+//
+// Entries are allowed to be stale: a tablet is reported once per memtable, and its entry is
+// validated only when it becomes the oldest one.
+class MemstoreWriteIndex {
+ public:
+  // Returns the actual oldest memtable write of the tablet, or HybridTime::kMax when the tablet
+  // should be removed from the index, e.g. because its memtable is empty or it was shut down.
+  typedef std::function<HybridTime(const TabletId&)> OldestWriteProvider;
+
+  // Sets the oldest memtable write of the tablet, HybridTime::kMax removes the tablet.
+  void Update(const TabletId& tablet_id, HybridTime oldest_write);
+
+  // Returns the tablet with the oldest memtable write, or an empty string if there is no such
+  // tablet. Entries are validated with the provider, which is invoked under the lock of the index,
+  // so it must not call the index.
+  TabletId Oldest(const OldestWriteProvider& provider);
+
+  size_t size() const;
+
+ private:
+  struct Entry {
+    TabletId tablet_id;
+    HybridTime oldest_write;
+  };
+
+  class TabletTag;
+  class TimeTag;
+
+  typedef boost::multi_index_container<
+      Entry,
+      boost::multi_index::indexed_by<
+          boost::multi_index::hashed_unique<
+              boost::multi_index::tag<TabletTag>,
+              boost::multi_index::member<Entry, TabletId, &Entry::tablet_id>
+          >,
+          boost::multi_index::ordered_non_unique<
+              boost::multi_index::tag<TimeTag>,
+              boost::multi_index::member<Entry, HybridTime, &Entry::oldest_write>
+          >
+      >
+  > Entries;
+
+  void UpdateUnlocked(const TabletId& tablet_id, HybridTime oldest_write);
+
+  mutable std::mutex mutex_;
+  Entries entries_;
+};
+
+} // namespace tserver
+} // namespace yb
+
+#endif // YB_TSERVER_MEMSTORE_WRITE_INDEX_H
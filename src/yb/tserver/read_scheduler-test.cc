@@ -0,0 +1,95 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/read_scheduler.h"
+
+#include "yb/util/countdown_latch.h"
+#include "yb/util/test_util.h"
+#include "yb/util/threadpool.h"
+
+DECLARE_int32(read_scheduler_max_concurrent_scans);
+
+namespace yb {
+namespace tserver {
+
+class ReadSchedulerTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    ASSERT_OK(ThreadPoolBuilder("test").set_max_threads(4).Build(&pool_));
+  }
+
+  std::unique_ptr<ThreadPool> pool_;
+};
+
+TEST_F(ReadSchedulerTest, RoundRobin) {
+  FLAGS_read_scheduler_max_concurrent_scans = 1;
+  ReadScheduler scheduler(pool_.get());
+
+  std::mutex mutex;
+  std::vector<std::string> order;
+  CountDownLatch blocker(1);
+  CountDownLatch done(5);
+  auto task = [&](const std::string& name) {
+    return [&, name] {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(name);
+      }
+      done.CountDown();
+    };
+  };
+
+  // Occupies the only slot, so following tasks are queued.
+  scheduler.Submit("a", [&] {
+    blocker.Wait();
+    done.CountDown();
+  });
+  scheduler.Submit("a", task("a1"));
+  scheduler.Submit("a", task("a2"));
+  scheduler.Submit("a", task("a3"));
+  scheduler.Submit("b", task("b1"));
+  ASSERT_EQ(4, scheduler.queued());
+
+  blocker.CountDown();
+  ASSERT_TRUE(done.WaitFor(MonoDelta::FromSeconds(10)));
+  pool_->Wait();
+  ASSERT_EQ((std::vector<std::string>{"a1", "b1", "a2", "a3"}), order);
+  ASSERT_EQ(0, scheduler.queued());
+}
+
+TEST_F(ReadSchedulerTest, Concurrency) {
+  FLAGS_read_scheduler_max_concurrent_scans = 2;
+  ReadScheduler scheduler(pool_.get());
+
+  CountDownLatch started(2);
+  CountDownLatch blocker(1);
+  CountDownLatch done(3);
+  for (const auto* key : {"a", "b", "c"}) {
+    scheduler.Submit(key, [&] {
+      started.CountDown();
+      blocker.Wait();
+      done.CountDown();
+    });
+  }
+
+  ASSERT_TRUE(started.WaitFor(MonoDelta::FromSeconds(10)));
+  ASSERT_EQ(1, scheduler.queued());
+  blocker.CountDown();
+  ASSERT_TRUE(done.WaitFor(MonoDelta::FromSeconds(10)));
+  pool_->Wait();
+  ASSERT_EQ(0, scheduler.queued());
+}
+
+} // namespace tserver
+} // namespace yb
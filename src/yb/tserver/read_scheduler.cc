@@ -0,0 +1,104 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/read_scheduler.h"
+
+#include <algorithm>
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/threadpool.h"
+
+DEFINE_int32(read_scheduler_max_concurrent_scans, 0,
+             "Maximum number of scans that are executed concurrently by a tablet server. Queued "
+             "scans are served round robin across tablets, while point reads are not queued. "
+             "0 disables scheduling, so scans are executed by RPC service threads.");
+TAG_FLAG(read_scheduler_max_concurrent_scans, advanced);
+TAG_FLAG(read_scheduler_max_concurrent_scans, runtime);
+
+namespace yb {
+namespace tserver {
+
+ReadScheduler::ReadScheduler(ThreadPool* pool) : pool_(pool) {}
+
+bool ReadScheduler::Enabled() {
+  return FLAGS_read_scheduler_max_concurrent_scans > 0;
+}
+
+void ReadScheduler::Submit(const std::string& key, Task task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& queue = queues_[key];
+    if (queue.empty()) {
+      ready_keys_.push_back(key);
+    }
+    queue.push_back(std::move(task));
+    ++queued_;
+
+    const auto max_running = static_cast<size_t>(
+        std::max(FLAGS_read_scheduler_max_concurrent_scans, 1));
+    if (running_ >= max_running) {
+      return;
+    }
+    // Picks the next task in round robin order, that is not necessarily the submitted one.
+    PickNext(&task);
+    ++running_;
+  }
+  Run(std::move(task));
+}
+
+void ReadScheduler::Run(Task task) {
+  auto status = pool_->SubmitFunc([this, task] { Execute(task); });
+  if (!status.ok()) {
+    YB_LOG_EVERY_N_SECS(WARNING, 10) << "Failed to submit read, executing inline: " << status;
+    Execute(std::move(task));
+  }
+}
+
+void ReadScheduler::Execute(Task task) {
+  // The thread keeps serving queued tasks, so the number of running tasks is not exceeded.
+  for (;;) {
+    task();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!PickNext(&task)) {
+      --running_;
+      return;
+    }
+  }
+}
+
+bool ReadScheduler::PickNext(Task* task) {
+  if (ready_keys_.empty()) {
+    return false;
+  }
+  auto key = std::move(ready_keys_.front());
+  ready_keys_.pop_front();
+  auto it = queues_.find(key);
+  *task = std::move(it->second.front());
+  it->second.pop_front();
+  --queued_;
+  if (it->second.empty()) {
+    queues_.erase(it);
+  } else {
+    ready_keys_.push_back(std::move(key));
+  }
+  return true;
+}
+
+size_t ReadScheduler::queued() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return queued_;
+}
+
+} // namespace tserver
+} // namespace yb
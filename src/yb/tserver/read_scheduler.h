@@ -0,0 +1,74 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TSERVER_READ_SCHEDULER_H
+#define YB_TSERVER_READ_SCHEDULER_H
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "yb/gutil/thread_annotations.h"
+
+namespace yb {
+
+class ThreadPool;
+
+namespace tserver {
+
+// Runs long reads, i.e. scans, on the thread pool, limiting the number of concurrently running
+// reads to read_scheduler_max_concurrent_scans, so they could not occupy all RPC service threads
+// and starve point reads, that are executed inline.
+//
+// Queued reads are picked round robin by key, usually the tablet id, so a few tablets doing big
+// scans do not delay scans of other tablets. Each page of a scan is a separate read, so long scans
+// yield between pages.
+class ReadScheduler {
+ public:
+  typedef std::function<void()> Task;
+
+  explicit ReadScheduler(ThreadPool* pool);
+
+  ReadScheduler(const ReadScheduler&) = delete;
+  void operator=(const ReadScheduler&) = delete;
+
+  // Whether long reads should be submitted to the scheduler.
+  static bool Enabled();
+
+  // Runs the task, now or after queued tasks of other keys. The task is executed inline when the
+  // thread pool does not accept it, e.g. during shutdown.
+  void Submit(const std::string& key, Task task);
+
+  size_t queued() const;
+
+ private:
+  void Run(Task task);
+  void Execute(Task task);
+  bool PickNext(Task* task) REQUIRES(mutex_);
+
+  ThreadPool* const pool_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::deque<Task>> queues_ GUARDED_BY(mutex_);
+  // Keys that have queued tasks, in the order they are served.
+  std::deque<std::string> ready_keys_ GUARDED_BY(mutex_);
+  size_t running_ GUARDED_BY(mutex_) = 0;
+  size_t queued_ GUARDED_BY(mutex_) = 0;
+};
+
+} // namespace tserver
+} // namespace yb
+
+#endif // YB_TSERVER_READ_SCHEDULER_H
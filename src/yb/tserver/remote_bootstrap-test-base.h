@@ -80,8 +80,13 @@ class RemoteBootstrapTest : public TabletServerTestBase {
  protected:
   // Check that the contents and CRC32C of a DataChunkPB are equal to a local buffer.
   static void AssertDataEqual(const uint8_t* local, int64_t size, const DataChunkPB& remote) {
-    ASSERT_EQ(size, remote.data().size());
-    ASSERT_TRUE(strings::memeq(local, remote.data().data(), size));
+    AssertDataEqual(local, size, remote, remote.data());
+  }
+
+  static void AssertDataEqual(
+      const uint8_t* local, int64_t size, const DataChunkPB& remote, const Slice& remote_data) {
+    ASSERT_EQ(size, remote_data.size());
+    ASSERT_TRUE(strings::memeq(local, remote_data.data(), size));
     uint32_t crc32 = crc::Crc32c(local, size);
     ASSERT_EQ(crc32, remote.crc32());
   }
@@ -32,6 +32,8 @@
 
 #include "yb/tserver/remote_bootstrap_client.h"
 
+#include <unordered_set>
+
 #include <gflags/gflags.h>
 #include <glog/logging.h>
 
@@ -61,6 +63,7 @@
 #include "yb/util/net/net_util.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
+#include "yb/util/threadpool.h"
 
 using namespace yb::size_literals;
 
@@ -86,6 +89,14 @@ DEFINE_int32(committed_config_change_role_timeout_sec, 30,
              "timing out. ");
 TAG_FLAG(committed_config_change_role_timeout_sec, hidden);
 
+DEFINE_int32(remote_bootstrap_max_parallel_file_downloads, 1,
+             "Maximum number of RocksDB files downloaded in parallel by a single remote bootstrap "
+             "session. The transmission rate limit is shared between all downloads. Values "
+             "above 1 require the bootstrap source to be able to serve parallel fetches of a "
+             "session.");
+TAG_FLAG(remote_bootstrap_max_parallel_file_downloads, advanced);
+TAG_FLAG(remote_bootstrap_max_parallel_file_downloads, runtime);
+
 DEFINE_test_flag(double, fault_crash_bootstrap_client_before_changing_role, 0.0,
                  "The remote bootstrap client will crash before closing the session with the "
                  "leader. Because the session won't be closed successfully, the leader won't issue "
@@ -263,6 +274,9 @@ Status RemoteBootstrapClient::Start(const string& bootstrap_peer_uuid,
   kv_store->clear_rocksdb_dir();
   superblock_->clear_wal_dir();
 
+  // Remote bootstrap copies the whole data, so the replica is not log-only anymore.
+  superblock_->clear_log_only();
+
   superblock_->set_tablet_data_state(tablet::TABLET_DATA_COPYING);
   wal_seqnos_.assign(resp.deprecated_wal_segment_seqnos().begin(),
                      resp.deprecated_wal_segment_seqnos().end());
@@ -645,15 +659,14 @@ Status RemoteBootstrapClient::DownloadRocksDBFiles() {
 
   RETURN_NOT_OK(CreateTabletDirectories(rocksdb_dir, meta_->fs_manager()));
 
-  DataIdPB data_id;
-  data_id.set_type(DataIdPB::ROCKSDB_FILE);
-  for (auto const& file_pb : new_superblock_.kv_store().rocksdb_files()) {
-    auto start = MonoTime::Now();
-    RETURN_NOT_OK(downloader_.DownloadFile(file_pb, rocksdb_dir, &data_id));
-    auto elapsed = MonoTime::Now().GetDeltaSince(start);
-    LOG_WITH_PREFIX(INFO)
-        << "Downloaded file " << file_pb.name() << " of size " << file_pb.size_bytes()
-        << " in " << elapsed.ToSeconds() << " seconds";
+  const auto& files = new_superblock_.kv_store().rocksdb_files();
+  const auto max_parallel_downloads = FLAGS_remote_bootstrap_max_parallel_file_downloads;
+  if (max_parallel_downloads > 1 && files.size() > 1) {
+    RETURN_NOT_OK(DownloadRocksDBFilesInParallel(rocksdb_dir, max_parallel_downloads));
+  } else {
+    for (auto const& file_pb : files) {
+      RETURN_NOT_OK(DownloadRocksDBFile(file_pb, rocksdb_dir));
+    }
   }
 
   // To avoid adding new file type to remote bootstrap we move intents as subdir of regular DB.
@@ -671,6 +684,75 @@ Status RemoteBootstrapClient::DownloadRocksDBFiles() {
   return Status::OK();
 }
 
+Status RemoteBootstrapClient::DownloadRocksDBFile(
+    const tablet::FilePB& file_pb, const std::string& rocksdb_dir) {
+  DataIdPB data_id;
+  data_id.set_type(DataIdPB::ROCKSDB_FILE);
+  auto start = MonoTime::Now();
+  RETURN_NOT_OK(downloader_.DownloadFile(file_pb, rocksdb_dir, &data_id));
+  auto elapsed = MonoTime::Now().GetDeltaSince(start);
+  LOG_WITH_PREFIX(INFO)
+      << "Downloaded file " << file_pb.name() << " of size " << file_pb.size_bytes()
+      << " in " << elapsed.ToSeconds() << " seconds";
+  return Status::OK();
+}
+
+Status RemoteBootstrapClient::DownloadRocksDBFilesInParallel(
+    const std::string& rocksdb_dir, int max_parallel_downloads) {
+  // Files sharing an inode with an earlier file are hard linked to it after all other files are
+  // downloaded, so the same data is not fetched twice.
+  std::vector<const tablet::FilePB*> files_to_download;
+  std::vector<const tablet::FilePB*> files_to_link;
+  std::unordered_set<uint64_t> inodes;
+  for (const auto& file_pb : new_superblock_.kv_store().rocksdb_files()) {
+    if (file_pb.inode() != 0 && !inodes.insert(file_pb.inode()).second) {
+      files_to_link.push_back(&file_pb);
+    } else {
+      files_to_download.push_back(&file_pb);
+    }
+  }
+  // Start from the largest files, so a single large file does not delay the end of the download.
+  std::sort(files_to_download.begin(), files_to_download.end(),
+            [](const tablet::FilePB* lhs, const tablet::FilePB* rhs) {
+    return lhs->size_bytes() > rhs->size_bytes();
+  });
+
+  std::unique_ptr<ThreadPool> pool;
+  RETURN_NOT_OK(ThreadPoolBuilder("rb-download")
+                    .set_max_threads(max_parallel_downloads)
+                    .Build(&pool));
+  std::mutex mutex;
+  Status first_failure;
+  for (const auto* file_pb : files_to_download) {
+    auto status = pool->SubmitFunc([this, file_pb, &rocksdb_dir, &mutex, &first_failure] {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!first_failure.ok()) {
+          return;
+        }
+      }
+      auto status = DownloadRocksDBFile(*file_pb, rocksdb_dir);
+      if (!status.ok()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (first_failure.ok()) {
+          first_failure = status;
+        }
+      }
+    });
+    if (!status.ok()) {
+      pool->Wait();
+      return status;
+    }
+  }
+  pool->Wait();
+  RETURN_NOT_OK(first_failure);
+
+  for (const auto* file_pb : files_to_link) {
+    RETURN_NOT_OK(DownloadRocksDBFile(*file_pb, rocksdb_dir));
+  }
+  return Status::OK();
+}
+
 Status RemoteBootstrapClient::DownloadWAL(uint64_t wal_segment_seqno) {
   VLOG_WITH_PREFIX(1) << "Downloading WAL segment with seqno " << wal_segment_seqno;
   DataIdPB data_id;
@@ -170,6 +170,13 @@ class RemoteBootstrapClient {
 
   CHECKED_STATUS DownloadRocksDBFiles();
 
+  // Download a single RocksDB file of the checkpoint into rocksdb_dir.
+  CHECKED_STATUS DownloadRocksDBFile(const tablet::FilePB& file_pb, const std::string& rocksdb_dir);
+
+  // Download RocksDB files of the checkpoint using up to max_parallel_downloads threads.
+  CHECKED_STATUS DownloadRocksDBFilesInParallel(
+      const std::string& rocksdb_dir, int max_parallel_downloads);
+
   // End the remote bootstrap session.
   CHECKED_STATUS EndRemoteSession();
 
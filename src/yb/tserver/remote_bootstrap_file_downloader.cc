@@ -21,11 +21,13 @@
 
 #include "yb/tserver/remote_bootstrap.proxy.h"
 
+#include "yb/util/background_io_rate_controller.h"
 #include "yb/util/crc.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/net/rate_limiter.h"
+#include "yb/util/scope_exit.h"
 
 using namespace yb::size_literals;
 
@@ -49,6 +51,11 @@ DEFINE_int32(bytes_remote_bootstrap_durable_write_mb, 8,
              "Explicitly call fsync after downloading the specified amount of data in MB "
              "during a remote bootstrap session. If 0 fsync() is not called.");
 
+DEFINE_bool(remote_bootstrap_use_direct_io, false,
+            "Write files downloaded by remote bootstrap with O_DIRECT, so they don't evict data "
+            "used by foreground reads from the OS page cache.");
+TAG_FLAG(remote_bootstrap_use_direct_io, advanced);
+
 // RETURN_NOT_OK_PREPEND() with a remote-error unwinding step.
 #define RETURN_NOT_OK_UNWIND_PREPEND(status, controller, msg) \
   RETURN_NOT_OK_PREPEND(UnwindRemoteError(status, controller), msg)
@@ -77,6 +84,14 @@ CHECKED_STATUS ExtractRemoteError(
 
 extern std::atomic<int32_t> remote_bootstrap_clients_started_;
 
+namespace {
+
+// Number of files being downloaded by all remote bootstrap sessions of this process. Used to share
+// the transmission rate between sessions, that could download several files in parallel.
+std::atomic<int32_t> remote_bootstrap_file_downloads_{0};
+
+} // namespace
+
 RemoteBootstrapFileDownloader::RemoteBootstrapFileDownloader(
     const std::string* log_prefix, FsManager* fs_manager)
     : log_prefix_(*log_prefix), fs_manager_(*fs_manager) {
@@ -100,22 +115,30 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
   RETURN_NOT_OK(env().CreateDirs(DirName(file_path)));
 
   if (file_pb.inode() != 0) {
-    auto it = inode2file_.find(file_pb.inode());
-    if (it != inode2file_.end()) {
+    std::string linked_file;
+    {
+      std::lock_guard<std::mutex> lock(inode2file_mutex_);
+      auto it = inode2file_.find(file_pb.inode());
+      if (it != inode2file_.end()) {
+        linked_file = it->second;
+      }
+    }
+    if (!linked_file.empty()) {
       VLOG_WITH_PREFIX(2) << "File with the same inode already found: " << file_path
-                          << " => " << it->second;
-      auto link_status = env().LinkFile(it->second, file_path);
+                          << " => " << linked_file;
+      auto link_status = env().LinkFile(linked_file, file_path);
       if (link_status.ok()) {
         return Status::OK();
       }
       // TODO fallback to copy.
-      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << it->second
+      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << linked_file
                              << ": " << link_status;
     }
   }
 
   WritableFileOptions opts;
   opts.sync_on_close = true;
+  opts.o_direct = FLAGS_remote_bootstrap_use_direct_io;
   std::unique_ptr<WritableFile> file;
   RETURN_NOT_OK(env().NewWritableFile(opts, file_path, &file));
 
@@ -126,6 +149,7 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
   VLOG_WITH_PREFIX(2) << "Downloaded file " << file_path;
 
   if (file_pb.inode() != 0) {
+    std::lock_guard<std::mutex> lock(inode2file_mutex_);
     inode2file_.emplace(file_pb.inode(), file_path);
   }
 
@@ -145,6 +169,11 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
 
   std::unique_ptr<RateLimiter> rate_limiter;
 
+  remote_bootstrap_file_downloads_.fetch_add(1, std::memory_order_acq_rel);
+  auto se = ScopeExit([] {
+    remote_bootstrap_file_downloads_.fetch_sub(1, std::memory_order_acq_rel);
+  });
+
   if (FLAGS_remote_bootstrap_rate_limit_bytes_per_sec > 0) {
     static auto rate_updater = []() {
       auto remote_bootstrap_clients_started =
@@ -154,8 +183,14 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
                                    << remote_bootstrap_clients_started;
         return static_cast<uint64_t>(FLAGS_remote_bootstrap_rate_limit_bytes_per_sec);
       }
-      return static_cast<uint64_t>(
-          FLAGS_remote_bootstrap_rate_limit_bytes_per_sec / remote_bootstrap_clients_started);
+      // Each session downloads at least one file, so the rate is shared between all downloads.
+      auto downloads = std::max(
+          remote_bootstrap_clients_started,
+          remote_bootstrap_file_downloads_.load(std::memory_order_acquire));
+      // Remote bootstrap is throttled together with flushes and compactions.
+      auto factor = BackgroundIoRateController::Instance()->rate_factor();
+      return std::max<uint64_t>(
+          FLAGS_remote_bootstrap_rate_limit_bytes_per_sec * factor / downloads, 1);
     };
 
     rate_limiter = std::make_unique<RateLimiter>(rate_updater);
@@ -174,6 +209,7 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
     req.set_session_id(session_id_);
     req.mutable_data_id()->CopyFrom(data_id);
     req.set_offset(offset);
+    req.set_use_data_sidecar(true);
     if (rate_limiter->active()) {
       auto max_size = rate_limiter->GetMaxSizeForNextTransmission();
       if (max_size > std::numeric_limits<decltype(max_length)>::max()) {
@@ -186,25 +222,39 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
     FetchDataResponsePB resp;
     auto status = rate_limiter->SendOrReceiveData([this, &req, &resp, &controller]() {
       return proxy_->FetchData(req, &resp, &controller);
-    }, [&resp]() { return resp.ByteSize(); });
+    }, [&resp, &controller]() -> uint64_t {
+      uint64_t size = resp.ByteSize();
+      if (resp.chunk().has_data_sidecar()) {
+        auto sidecar = controller.GetSidecar(resp.chunk().data_sidecar());
+        if (sidecar.ok()) {
+          size += sidecar->size();
+        }
+      }
+      return size;
+    });
     RETURN_NOT_OK_UNWIND_PREPEND(status, controller, "Unable to fetch data from remote");
-    DCHECK_LE(resp.chunk().data().size(), max_length);
+
+    // Servers that do not support sidecars send the data in the response itself.
+    Slice data = resp.chunk().data();
+    if (resp.chunk().has_data_sidecar()) {
+      data = VERIFY_RESULT(controller.GetSidecar(resp.chunk().data_sidecar()));
+    }
+    DCHECK_LE(data.size(), max_length);
 
     // Sanity-check for corruption.
-    RETURN_NOT_OK_PREPEND(VerifyData(offset, resp.chunk()),
+    RETURN_NOT_OK_PREPEND(VerifyData(offset, resp.chunk(), data),
                           Format("Error validating data item $0", data_id));
 
     // Write the data.
-    RETURN_NOT_OK(appendable->Append(resp.chunk().data()));
-    VLOG_WITH_PREFIX(3)
-        << "resp size: " << resp.ByteSize() << ", chunk size: " << resp.chunk().data().size();
+    RETURN_NOT_OK(appendable->Append(data));
+    VLOG_WITH_PREFIX(3) << "resp size: " << resp.ByteSize() << ", chunk size: " << data.size();
 
-    if (offset + resp.chunk().data().size() == resp.chunk().total_data_length()) {
+    if (offset + data.size() == resp.chunk().total_data_length()) {
       done = true;
     }
-    offset += resp.chunk().data().size();
+    offset += data.size();
     if (FLAGS_bytes_remote_bootstrap_durable_write_mb != 0) {
-      periodic_sync_unsynced_bytes += resp.chunk().data().size();
+      periodic_sync_unsynced_bytes += data.size();
       if (periodic_sync_unsynced_bytes > FLAGS_bytes_remote_bootstrap_durable_write_mb * 1_MB) {
         RETURN_NOT_OK(appendable->Sync());
         periodic_sync_unsynced_bytes = 0;
@@ -217,7 +267,8 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
   return Status::OK();
 }
 
-Status RemoteBootstrapFileDownloader::VerifyData(uint64_t offset, const DataChunkPB& chunk) {
+Status RemoteBootstrapFileDownloader::VerifyData(
+    uint64_t offset, const DataChunkPB& chunk, const Slice& data) {
   // Verify the offset is what we expected.
   if (offset != chunk.offset()) {
     return STATUS_FORMAT(
@@ -226,11 +277,11 @@ Status RemoteBootstrapFileDownloader::VerifyData(uint64_t offset, const DataChun
   }
 
   // Verify the checksum.
-  uint32_t crc32 = crc::Crc32c(chunk.data().data(), chunk.data().length());
+  uint32_t crc32 = crc::Crc32c(data.data(), data.size());
   if (PREDICT_FALSE(crc32 != chunk.crc32())) {
     return STATUS_FORMAT(
         Corruption, "CRC32 does not match at offset $0 size $1: $2 vs $3",
-        offset, chunk.data().size(), crc32, chunk.crc32());
+        offset, data.size(), crc32, chunk.crc32());
   }
   return Status::OK();
 }
@@ -15,6 +15,7 @@
 #define YB_TSERVER_REMOTE_BOOTSTRAP_FILE_DOWNLOADER_H
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -26,6 +27,7 @@
 
 #include "yb/util/monotime.h"
 #include "yb/util/status.h"
+#include "yb/util/thread_annotations.h"
 
 namespace yb {
 
@@ -45,6 +47,7 @@ class RemoteBootstrapFileDownloader {
       std::shared_ptr<RemoteBootstrapServiceProxy> proxy, std::string session_id,
       MonoDelta session_idle_timeout);
 
+  // Could be called concurrently for different files of the same session.
   CHECKED_STATUS DownloadFile(
       const tablet::FilePB& file_pb, const std::string& dir, DataIdPB* data_id);
 
@@ -67,7 +70,7 @@ class RemoteBootstrapFileDownloader {
   }
 
  private:
-  CHECKED_STATUS VerifyData(uint64_t offset, const DataChunkPB& resp);
+  CHECKED_STATUS VerifyData(uint64_t offset, const DataChunkPB& chunk, const Slice& data);
 
   const std::string& LogPrefix() const {
     return log_prefix_;
@@ -81,7 +84,8 @@ class RemoteBootstrapFileDownloader {
   std::shared_ptr<RemoteBootstrapServiceProxy> proxy_;
   std::string session_id_;
   MonoDelta session_idle_timeout_ = MonoDelta::kZero;
-  std::unordered_map<uint64_t, std::string> inode2file_;
+  std::mutex inode2file_mutex_;
+  std::unordered_map<uint64_t, std::string> inode2file_ GUARDED_BY(inode2file_mutex_);
 };
 
 CHECKED_STATUS UnwindRemoteError(const Status& status, const rpc::RpcController& controller);
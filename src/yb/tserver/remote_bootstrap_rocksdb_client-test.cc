@@ -20,6 +20,8 @@
 
 using std::shared_ptr;
 
+DECLARE_int32(remote_bootstrap_max_parallel_file_downloads);
+
 namespace yb {
 namespace tserver {
 
@@ -31,6 +33,47 @@ using tablet::TabletStatusListener;
 class RemoteBootstrapRocksDBClientTest : public RemoteBootstrapClientTest {
  public:
   RemoteBootstrapRocksDBClientTest() : RemoteBootstrapClientTest(YQL_TABLE_TYPE) {}
+
+ protected:
+  void TestDownloadRocksDBFiles() {
+    TabletStatusListener listener(meta_);
+    ASSERT_OK(client_->FetchAll(&listener));
+    auto tablet_peer_checkpoint_dir =
+        tablet_peer_->tablet()->snapshots().TEST_LastRocksDBCheckpointDir();
+
+    vector<std::string> rocksdb_files;
+    LOG(INFO) << "RocksDB dir: " << meta_->rocksdb_dir();
+    ASSERT_OK(fs_manager_->ListDir(meta_->rocksdb_dir(), &rocksdb_files));
+
+    vector<std::string> tablet_peer_checkpoint_files;
+    ASSERT_OK(tablet_peer_->tablet_metadata()->fs_manager()->ListDir(
+        tablet_peer_checkpoint_dir, &tablet_peer_checkpoint_files));
+
+    std::sort(rocksdb_files.begin(), rocksdb_files.end());
+    std::sort(tablet_peer_checkpoint_files.begin(), tablet_peer_checkpoint_files.end());
+
+    ASSERT_EQ(rocksdb_files.size(), tablet_peer_checkpoint_files.size())
+        << AsString(rocksdb_files) << " vs " << AsString(tablet_peer_checkpoint_files);
+
+    // Verify that the client has the same files that the leader has.
+    for (int i = 0; i < rocksdb_files.size(); ++i) {
+      auto local_rocksdb_file = rocksdb_files[i];
+      auto tablet_peer_rocksdb_file = tablet_peer_checkpoint_files[i];
+      ASSERT_EQ(local_rocksdb_file, tablet_peer_rocksdb_file);
+
+      if (local_rocksdb_file == "." || local_rocksdb_file == "..") {
+        continue;
+      }
+
+      auto local_rocksdb_file_path = JoinPathSegments(meta_->rocksdb_dir(), local_rocksdb_file);
+      auto tablet_peer_rocksdb_file_path = JoinPathSegments(tablet_peer_checkpoint_dir,
+                                                            tablet_peer_rocksdb_file);
+
+      LOG(INFO) << "Comparing file " << local_rocksdb_file_path
+                << " and file " << tablet_peer_rocksdb_file_path;
+      ASSERT_OK(CompareFileContents(local_rocksdb_file_path, tablet_peer_rocksdb_file_path));
+    }
+  }
 };
 
 // Basic begin / end remote bootstrap session.
@@ -42,43 +85,12 @@ TEST_F(RemoteBootstrapRocksDBClientTest, TestBeginEndSession) {
 
 // Basic RocksDB files download unit test.
 TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
-  TabletStatusListener listener(meta_);
-  ASSERT_OK(client_->FetchAll(&listener));
-  auto tablet_peer_checkpoint_dir =
-      tablet_peer_->tablet()->snapshots().TEST_LastRocksDBCheckpointDir();
-
-  vector<std::string> rocksdb_files;
-  LOG(INFO) << "RocksDB dir: " << meta_->rocksdb_dir();
-  ASSERT_OK(fs_manager_->ListDir(meta_->rocksdb_dir(), &rocksdb_files));
-
-  vector<std::string> tablet_peer_checkpoint_files;
-  ASSERT_OK(tablet_peer_->tablet_metadata()->fs_manager()->ListDir(tablet_peer_checkpoint_dir,
-                                                                   &tablet_peer_checkpoint_files));
-
-  std::sort(rocksdb_files.begin(), rocksdb_files.end());
-  std::sort(tablet_peer_checkpoint_files.begin(), tablet_peer_checkpoint_files.end());
-
-  ASSERT_EQ(rocksdb_files.size(), tablet_peer_checkpoint_files.size())
-      << AsString(rocksdb_files) << " vs " << AsString(tablet_peer_checkpoint_files);
-
-  // Verify that the client has the same files that the leader has.
-  for (int i = 0; i < rocksdb_files.size(); ++i) {
-    auto local_rocksdb_file = rocksdb_files[i];
-    auto tablet_peer_rocksdb_file = tablet_peer_checkpoint_files[i];
-    ASSERT_EQ(local_rocksdb_file, tablet_peer_rocksdb_file);
-
-    if (local_rocksdb_file == "." || local_rocksdb_file == "..") {
-      continue;
-    }
-
-    auto local_rocksdb_file_path = JoinPathSegments(meta_->rocksdb_dir(), local_rocksdb_file);
-    auto tablet_peer_rocksdb_file_path = JoinPathSegments(tablet_peer_checkpoint_dir,
-                                                          tablet_peer_rocksdb_file);
+  TestDownloadRocksDBFiles();
+}
 
-    LOG(INFO) << "Comparing file " << local_rocksdb_file_path
-              << " and file " << tablet_peer_rocksdb_file_path;
-    ASSERT_OK(CompareFileContents(local_rocksdb_file_path, tablet_peer_rocksdb_file_path));
-  }
+TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFilesInParallel) {
+  FLAGS_remote_bootstrap_max_parallel_file_downloads = 4;
+  TestDownloadRocksDBFiles();
 }
 
 } // namespace tserver
@@ -129,14 +129,19 @@ class RemoteBootstrapServiceTest : public RemoteBootstrapTest {
         remote_bootstrap_proxy_->CheckSessionActive(req, resp, controller), controller);
   }
 
+  // Fetches the first log segment and checks that it matches the local one.
+  void TestFetchLog(bool use_data_sidecar);
+
   Status DoFetchData(const string& session_id, const DataIdPB& data_id,
                      uint64_t* offset, int64_t* max_length,
                      FetchDataResponsePB* resp,
-                     RpcController* controller) {
+                     RpcController* controller,
+                     bool use_data_sidecar = false) {
     controller->set_timeout(MonoDelta::FromSeconds(1.0));
     FetchDataRequestPB req;
     req.set_session_id(session_id);
     req.mutable_data_id()->CopyFrom(data_id);
+    req.set_use_data_sidecar(use_data_sidecar);
     if (offset) {
       req.set_offset(*offset);
     }
@@ -332,7 +337,7 @@ TEST_F(RemoteBootstrapServiceTest, TestInvalidBlockOrOpId) {
 }
 
 // Test that we are able to fetch log segments.
-TEST_F(RemoteBootstrapServiceTest, TestFetchLog) {
+void RemoteBootstrapServiceTest::TestFetchLog(bool use_data_sidecar) {
   string session_id;
   tablet::RaftGroupReplicaSuperBlockPB superblock;
   uint64_t idle_timeout_millis;
@@ -350,7 +355,9 @@ TEST_F(RemoteBootstrapServiceTest, TestFetchLog) {
   DataIdPB data_id;
   data_id.set_type(DataIdPB::LOG_SEGMENT);
   data_id.set_wal_segment_seqno(segment_seqno);
-  ASSERT_OK(DoFetchData(session_id, data_id, nullptr, nullptr, &resp, &controller));
+  ASSERT_OK(DoFetchData(
+      session_id, data_id, nullptr, nullptr, &resp, &controller, use_data_sidecar));
+  ASSERT_EQ(use_data_sidecar, resp.chunk().has_data_sidecar());
 
   // Fetch the local data.
   log::SegmentSequence local_segments;
@@ -369,7 +376,21 @@ TEST_F(RemoteBootstrapServiceTest, TestFetchLog) {
   Slice slice;
   ASSERT_OK(ReadFully(segment->readable_file_checkpoint().get(), 0, size, &slice, scratch.data()));
 
-  AssertDataEqual(slice.data(), slice.size(), resp.chunk());
+  if (use_data_sidecar) {
+    ASSERT_TRUE(resp.chunk().data().empty());
+    auto remote_data = ASSERT_RESULT(controller.GetSidecar(resp.chunk().data_sidecar()));
+    AssertDataEqual(slice.data(), slice.size(), resp.chunk(), remote_data);
+  } else {
+    AssertDataEqual(slice.data(), slice.size(), resp.chunk());
+  }
+}
+
+TEST_F(RemoteBootstrapServiceTest, TestFetchLog) {
+  TestFetchLog(/* use_data_sidecar */ false);
+}
+
+TEST_F(RemoteBootstrapServiceTest, TestFetchLogWithSidecar) {
+  TestFetchLog(/* use_data_sidecar */ true);
 }
 
 // Test that the remote bootstrap session timeout works properly.
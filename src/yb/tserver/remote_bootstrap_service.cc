@@ -249,12 +249,12 @@ void RemoteBootstrapServiceImpl::FetchData(const FetchDataRequestPB* req,
 
   MAYBE_FAULT(FLAGS_fault_crash_on_handle_rb_fetch_data);
 
-  int64_t rate_limit = session->rate_limiter().GetMaxSizeForNextTransmission();
+  int64_t rate_limit = session->GetMaxSizeForNextTransmission();
   VLOG(3) << " rate limiter max len: " << rate_limit;
   GetDataPieceInfo info = {
     .offset = req->offset(),
     .client_maxlen = rate_limit == 0 ? req->max_length() : std::min(req->max_length(), rate_limit),
-    .data = std::string(),
+    .data = RefCntBuffer(),
     .data_size = 0,
     .error_code = RemoteBootstrapErrorPB::UNKNOWN_ERROR,
   };
@@ -265,11 +265,19 @@ void RemoteBootstrapServiceImpl::FetchData(const FetchDataRequestPB* req,
   RPC_RETURN_NOT_OK(session->GetDataPiece(data_id, &info),
                     info.error_code, "Unable to get piece of data file");
 
-  session->rate_limiter().UpdateDataSizeAndMaybeSleep(info.data.size());
-  uint32_t crc32 = Crc32c(info.data.data(), info.data.length());
+  session->UpdateDataSizeAndMaybeSleep(info.data.size());
+  uint32_t crc32 = Crc32c(info.data.data(), info.data.size());
 
   DataChunkPB* data_chunk = resp->mutable_chunk();
-  *data_chunk->mutable_data() = std::move(info.data);
+  if (req->use_data_sidecar()) {
+    int sidecar_idx = 0;
+    RPC_RETURN_NOT_OK(context.AddRpcSidecar(std::move(info.data), &sidecar_idx),
+                      RemoteBootstrapErrorPB::UNKNOWN_ERROR, "Unable to add data sidecar");
+    data_chunk->mutable_data();
+    data_chunk->set_data_sidecar(sidecar_idx);
+  } else {
+    data_chunk->set_data(info.data.data(), info.data.size());
+  }
   data_chunk->set_total_data_length(info.data_size);
   data_chunk->set_offset(info.offset);
 
@@ -353,11 +353,9 @@ Status ReadFileChunkToBuf(RandomAccessFile* file, const string& data_name, GetDa
   Stopwatch chunk_timer(Stopwatch::THIS_THREAD);
   chunk_timer.start();
 
-  // Writing into a std::string buffer is basically guaranteed to work on C++11,
-  // however any modern compiler should be compatible with it.
-  // Violates the API contract, but avoids excessive copies.
-  info->data.resize(response_data_size);
-  auto buf = reinterpret_cast<uint8_t*>(const_cast<char*>(info->data.data()));
+  // The buffer is not initialized, and it is sent as is, so the file is read right into it.
+  info->data = RefCntBuffer(response_data_size);
+  auto buf = info->data.udata();
   Slice slice;
   Status s = env_util::ReadFully(file, info->offset, response_data_size, &slice, buf);
   if (PREDICT_FALSE(!s.ok())) {
@@ -491,9 +489,11 @@ Status RemoteBootstrapSession::GetFilePiece(
   RETURN_NOT_OK(env->NewRandomAccessFile(file_path, &readable_file));
 
   info->data_size = VERIFY_RESULT(readable_file->Size());
-  auto inode = VERIFY_RESULT(readable_file->INode());
-  VLOG(2) << "Reading RocksDB file. File path: " << file_path << ", file size: " << info->data_size
-          << ", inode: " << inode;
+  if (VLOG_IS_ON(2)) {
+    auto inode = VERIFY_RESULT(readable_file->INode());
+    VLOG(2) << "Reading RocksDB file. File path: " << file_path
+            << ", file size: " << info->data_size << ", inode: " << inode;
+  }
 
   RETURN_NOT_OK(ReadFileChunkToBuf(
       readable_file.get(), Substitute("rocksdb file $0", file_name), info));
@@ -571,11 +571,21 @@ bool RemoteBootstrapSession::Succeeded() {
 }
 
 void RemoteBootstrapSession::EnsureRateLimiterIsInitialized() {
+  std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
   if (!rate_limiter_.IsInitialized()) {
     InitRateLimiter();
   }
 }
 
+uint64_t RemoteBootstrapSession::GetMaxSizeForNextTransmission() {
+  std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+  return rate_limiter_.GetMaxSizeForNextTransmission();
+}
+
+void RemoteBootstrapSession::UpdateDataSizeAndMaybeSleep(uint64_t data_size) {
+  std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+  rate_limiter_.UpdateDataSizeAndMaybeSleep(data_size);
+}
 
 void RemoteBootstrapSession::InitRateLimiter() {
   if (FLAGS_remote_bootstrap_rate_limit_bytes_per_sec > 0 && nsessions_) {
@@ -48,6 +48,7 @@
 #include "yb/util/env_util.h"
 #include "yb/util/net/rate_limiter.h"
 #include "yb/util/locks.h"
+#include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/status.h"
 
 namespace yb {
@@ -68,7 +69,7 @@ struct GetDataPieceInfo {
   int64_t client_maxlen;
 
   // Output
-  std::string data;
+  RefCntBuffer data;
   int64_t data_size;
   RemoteBootstrapErrorPB::Code error_code;
 
@@ -128,11 +129,16 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
   // Change the peer's role to VOTER.
   CHECKED_STATUS ChangeRole();
 
-  void InitRateLimiter();
-
   void EnsureRateLimiterIsInitialized();
 
-  RateLimiter& rate_limiter() { return rate_limiter_; }
+  // Returns the maximum size of the next data chunk sent by this session, 0 if the rate is not
+  // limited.
+  uint64_t GetMaxSizeForNextTransmission();
+
+  // Accounts data sent by this session, and sleeps if the transmission rate is above the target.
+  // The client could fetch several files of the session in parallel, so the sleep is done under
+  // the rate limiter lock to keep the aggregate rate of the session within its target.
+  void UpdateDataSizeAndMaybeSleep(uint64_t data_size);
 
   static const std::string kCheckpointsDir;
 
@@ -180,6 +186,8 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
   // Get a piece of a RocksDB checkpoint file.
   CHECKED_STATUS GetRocksDBFilePiece(const std::string& file_name, GetDataPieceInfo* info);
 
+  void InitRateLimiter() REQUIRES(rate_limiter_mutex_);
+
   Env* env() const;
 
   RemoteBootstrapSource* Source(DataIdPB::IdType id_type) const;
@@ -217,7 +225,8 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
   MonoTime start_time_;
 
   // Used to limit the transmission rate.
-  RateLimiter rate_limiter_;
+  std::mutex rate_limiter_mutex_;
+  RateLimiter rate_limiter_ GUARDED_BY(rate_limiter_mutex_);
 
   // Pointer to the counter for of the number of sessions in RemoteBootstrapService. Used to
   // calculate the rate for the rate limiter.
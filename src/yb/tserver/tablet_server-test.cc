@@ -30,6 +30,7 @@
 // under the License.
 //
 
+#include "yb/consensus/consensus.proxy.h"
 #include "yb/consensus/log-test-base.h"
 
 #include "yb/common/ql_value.h"
@@ -46,6 +47,7 @@
 #include "yb/server/hybrid_clock.h"
 #include "yb/server/server_base.pb.h"
 #include "yb/server/server_base.proxy.h"
+#include "yb/tablet/local_tablet_writer.h"
 
 #include "yb/tserver/mini_tablet_server.h"
 #include "yb/tserver/tablet_server.h"
@@ -545,6 +547,43 @@ TEST_F(TabletServerTest, TestClientGetsErrorBackWhenRecoveryFailed) {
   ASSERT_STR_CONTAINS(resp.error().status().message(), "Tablet not RUNNING: FAILED");
 }
 
+// Log-only peer does not apply operations to its DocDB, and rejects requests, so clients fail
+// over to a replica that has the data.
+TEST_F(TabletServerTest, TestLogOnlyPeer) {
+  WriteRequestPB req;
+  req.set_tablet_id(kTabletId);
+  WriteResponsePB resp;
+  RpcController controller;
+
+  AddTestRowInsert(1, 1, "full replica", &req);
+  ASSERT_OK(proxy_->Write(req, &resp, &controller));
+  ASSERT_FALSE(resp.has_error()) << resp.ShortDebugString();
+  req.clear_ql_write_batch();
+
+  tablet_peer_->tablet()->SetLogOnly(true);
+
+  controller.Reset();
+  AddTestRowInsert(2, 2, "log-only peer", &req);
+  ASSERT_OK(proxy_->Write(req, &resp, &controller));
+  ASSERT_TRUE(resp.has_error());
+  ASSERT_EQ(TabletServerErrorPB::TABLET_NOT_RUNNING, resp.error().code());
+
+  {
+    ReadRequestPB read_req;
+    read_req.set_tablet_id(kTabletId);
+    ReadResponsePB read_resp;
+    controller.Reset();
+    ASSERT_OK(proxy_->Read(read_req, &read_resp, &controller));
+    ASSERT_TRUE(read_resp.has_error());
+    ASSERT_EQ(TabletServerErrorPB::TABLET_NOT_RUNNING, read_resp.error().code());
+  }
+
+  // Replicated operations are durable in the log, but are not applied.
+  tablet::LocalTabletWriter writer(tablet_peer_->tablet());
+  ASSERT_OK(writer.WriteBatch(req.mutable_ql_write_batch()));
+  VerifyRows(schema_, { KeyValue(1, 1) });
+}
+
 TEST_F(TabletServerTest, TestCreateTablet_TabletExists) {
   CreateTabletRequestPB req;
   CreateTabletResponsePB resp;
@@ -639,6 +678,66 @@ TEST_F(TabletServerTest, TestDeleteTablet_TabletNotCreated) {
   }
 }
 
+TEST_F(TabletServerTest, TestMultiRaftUpdateConsensus) {
+  consensus::MultiRaftConsensusRequestPB req;
+  consensus::MultiRaftConsensusResponsePB resp;
+  RpcController rpc;
+
+  const auto& uuid = mini_server_->server()->fs_manager()->uuid();
+  for (const auto& tablet_id : {"NotPresentTabletId1", "NotPresentTabletId2"}) {
+    auto* consensus_req = req.add_consensus_request();
+    consensus_req->set_dest_uuid(uuid);
+    consensus_req->set_tablet_id(tablet_id);
+    consensus_req->set_caller_uuid("caller");
+    consensus_req->set_caller_term(1);
+    consensus_req->mutable_committed_index()->set_term(0);
+    consensus_req->mutable_committed_index()->set_index(0);
+  }
+
+  // Wrong destination is reported for the whole batch.
+  req.set_dest_uuid("WrongUuid");
+  ASSERT_OK(consensus_proxy_->MultiRaftUpdateConsensus(req, &resp, &rpc));
+  ASSERT_TRUE(resp.has_error());
+  ASSERT_EQ(TabletServerErrorPB::WRONG_SERVER_UUID, resp.error().code());
+  ASSERT_EQ(0, resp.consensus_response_size());
+
+  // Every request of the batch gets its own response.
+  req.set_dest_uuid(uuid);
+  resp.Clear();
+  rpc.Reset();
+  ASSERT_OK(consensus_proxy_->MultiRaftUpdateConsensus(req, &resp, &rpc));
+  SCOPED_TRACE(resp.DebugString());
+  ASSERT_FALSE(resp.has_error());
+  ASSERT_EQ(2, resp.consensus_response_size());
+  for (const auto& consensus_resp : resp.consensus_response()) {
+    ASSERT_TRUE(consensus_resp.has_error());
+    ASSERT_EQ(TabletServerErrorPB::TABLET_NOT_FOUND, consensus_resp.error().code());
+  }
+}
+
+TEST_F(TabletServerTest, TestMultiWrite) {
+  MultiWriteRequestPB req;
+  MultiWriteResponsePB resp;
+  RpcController controller;
+
+  AddTestRowInsert(1, 1, "first", req.add_write_request());
+  req.mutable_write_request(0)->set_tablet_id(kTabletId);
+  AddTestRowInsert(2, 2, "second", req.add_write_request());
+  req.mutable_write_request(1)->set_tablet_id("NotPresentTabletId");
+
+  ASSERT_OK(proxy_->MultiWrite(req, &resp, &controller));
+  SCOPED_TRACE(resp.DebugString());
+  ASSERT_FALSE(resp.has_error());
+  ASSERT_EQ(2, resp.write_response_size());
+
+  // Failure of one tablet does not affect other writes of the batch.
+  ASSERT_FALSE(resp.write_response(0).has_error());
+  ASSERT_TRUE(resp.write_response(1).has_error());
+  ASSERT_EQ(TabletServerErrorPB::TABLET_NOT_FOUND, resp.write_response(1).error().code());
+
+  VerifyRows(schema_, { KeyValue(1, 1) });
+}
+
 // Test that with concurrent requests to delete the same tablet, one wins and
 // the other fails, with no assertion failures. Regression test for KUDU-345.
 TEST_F(TabletServerTest, TestConcurrentDeleteTablet) {
@@ -151,7 +151,7 @@ class TabletServer : public server::RpcAndWebServerBase, public TabletServerIf {
   const std::string& permanent_uuid() const { return fs_manager_->uuid(); }
 
   // Returns the proxy to call this tablet server locally.
-  const std::shared_ptr<TabletServerServiceProxy>& proxy() const { return proxy_; }
+  const std::shared_ptr<TabletServerServiceProxy>& proxy() const override { return proxy_; }
 
   const TabletServerOptions& options() const { return opts_; }
 
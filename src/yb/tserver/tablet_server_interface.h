@@ -29,6 +29,7 @@ class TSInformationPB;
 namespace tserver {
 
 class TabletPeerLookupIf;
+class TabletServerServiceProxy;
 class TSTabletManager;
 
 class TabletServerIf : public LocalTabletServer {
@@ -46,6 +47,9 @@ class TabletServerIf : public LocalTabletServer {
   virtual const scoped_refptr<MetricEntity>& MetricEnt() const = 0;
 
   virtual client::TransactionPool* TransactionPool() = 0;
+
+  // Proxy to the tablet server service of this server, null if the server does not provide one.
+  virtual const std::shared_ptr<TabletServerServiceProxy>& proxy() const = 0;
 };
 
 } // namespace tserver
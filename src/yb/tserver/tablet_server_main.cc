@@ -42,6 +42,7 @@
 #endif
 
 #include "yb/yql/cql/cqlserver/cql_server.h"
+#include "yb/yql/pgwrapper/pg_conn_mux.h"
 #include "yb/yql/pgwrapper/pg_wrapper.h"
 #include "yb/yql/redis/redisserver/redis_server.h"
 
@@ -68,6 +69,7 @@ using yb::redisserver::RedisServerOptions;
 using yb::cqlserver::CQLServer;
 using yb::cqlserver::CQLServerOptions;
 
+using yb::pgwrapper::PgConnectionMultiplexer;
 using yb::pgwrapper::PgProcessConf;
 using yb::pgwrapper::PgWrapper;
 using yb::pgwrapper::PgSupervisor;
@@ -99,6 +101,7 @@ DECLARE_int32(cql_proxy_webserver_port);
 DECLARE_string(pgsql_proxy_bind_address);
 DECLARE_bool(start_pgsql_proxy);
 DECLARE_bool(enable_ysql);
+DECLARE_bool(ysql_conn_mux);
 
 DECLARE_int64(remote_bootstrap_rate_limit_bytes_per_sec);
 
@@ -201,6 +204,7 @@ int TabletServerMain(int argc, char** argv) {
     call_home->ScheduleCallHome();
   }
 
+  std::unique_ptr<PgConnectionMultiplexer> pg_conn_mux;
   std::unique_ptr<PgSupervisor> pg_supervisor;
   if (FLAGS_start_pgsql_proxy || FLAGS_enable_ysql) {
     auto pg_process_conf_result = PgProcessConf::CreateValidateAndRunInitDb(
@@ -221,6 +225,15 @@ int TabletServerMain(int argc, char** argv) {
         server->options().rpc_opts.rpc_bind_addresses, 0);
     LOG_AND_RETURN_FROM_MAIN_NOT_OK(hosts_result);
     pg_process_conf.cert_base_name = hosts_result->front().host();
+    if (FLAGS_ysql_conn_mux) {
+      if (pg_process_conf.enable_tls) {
+        LOG(WARNING) << "YSQL connection multiplexer is not supported with client to server "
+                     << "encryption, not starting it";
+      } else {
+        pg_conn_mux = std::make_unique<PgConnectionMultiplexer>(server->metric_entity());
+        LOG_AND_RETURN_FROM_MAIN_NOT_OK(pg_conn_mux->Start(&pg_process_conf));
+      }
+    }
     LOG(INFO) << "Starting PostgreSQL server listening on "
               << pg_process_conf.listen_addresses << ", port " << pg_process_conf.pg_port;
 
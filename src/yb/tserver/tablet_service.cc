@@ -33,6 +33,7 @@
 #include "yb/tserver/tablet_service.h"
 
 #include <algorithm>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <vector>
@@ -45,6 +46,7 @@
 #include "yb/common/schema.h"
 #include "yb/common/wire_protocol.h"
 #include "yb/consensus/leader_lease.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/consensus/raft_consensus.h"
 
 #include "yb/docdb/cql_operation.h"
@@ -75,6 +77,7 @@
 #include "yb/tserver/ts_tablet_manager.h"
 #include "yb/tserver/tserver_error.h"
 #include "yb/tserver/tserver.pb.h"
+#include "yb/tserver/tserver_service.proxy.h"
 
 #include "yb/util/crc.h"
 #include "yb/util/debug/long_operation_tracker.h"
@@ -191,6 +194,14 @@ DEFINE_test_flag(double, respond_write_failed_probability, 0.0,
 
 DEFINE_test_flag(bool, rpc_delete_tablet_fail, false, "Should delete tablet RPC fail.");
 
+DEFINE_bool(ysql_lock_rows_after_read, true,
+            "Lock the rows returned by YSQL reads with row marks, with a single write operation "
+            "per read request issued after the read, instead of locking the whole key range "
+            "selected by the request before reading it. Reads that select a whole key range "
+            "still lock the range.");
+TAG_FLAG(ysql_lock_rows_after_read, advanced);
+TAG_FLAG(ysql_lock_rows_after_read, runtime);
+
 DECLARE_uint64(max_clock_skew_usec);
 DECLARE_uint64(transaction_min_running_check_interval_ms);
 
@@ -263,6 +274,16 @@ Status GetTabletRef(const TabletPeerPtr& tablet_peer,
   return Status::OK();
 }
 
+// Max staleness of a read served by a follower, 0 if not bounded.
+template <class Req>
+uint64_t MaxStalenessMs(const Req& req) {
+  return 0;
+}
+
+uint64_t MaxStalenessMs(const ReadRequestPB& req) {
+  return req.max_staleness_ms();
+}
+
 // overlimit - we have 2 bounds, value and random score.
 // overlimit is calculated as:
 // score + (value - lower_bound) / (upper_bound - lower_bound).
@@ -388,7 +409,7 @@ class WriteOperationCompletionCallback : public OperationCompletionCallback {
       rowblock->Serialize(ql_write_req.client(), &rows_data);
       int rows_data_sidecar_idx = 0;
       RETURN_UNKNOWN_ERROR_IF_NOT_OK(
-          context_->AddRpcSidecar(RefCntBuffer(rows_data), &rows_data_sidecar_idx),
+          context_->AddRpcSidecar(RefCntBuffer(std::move(rows_data)), &rows_data_sidecar_idx),
           response_, context_.get());
       ql_write_resp->set_rows_data_sidecar(rows_data_sidecar_idx);
     }
@@ -404,7 +425,7 @@ class WriteOperationCompletionCallback : public OperationCompletionCallback {
             pggate::PgDocData::WriteTuples(resultset, &rows_data), response_, context_.get());
         int rows_data_sidecar_idx = 0;
         RETURN_UNKNOWN_ERROR_IF_NOT_OK(
-            context_->AddRpcSidecar(RefCntBuffer(rows_data), &rows_data_sidecar_idx),
+            context_->AddRpcSidecar(RefCntBuffer(std::move(rows_data)), &rows_data_sidecar_idx),
             response_, context_.get());
         pgsql_write_resp->set_rows_data_sidecar(rows_data_sidecar_idx);
       }
@@ -680,8 +701,8 @@ void TabletServiceAdminImpl::BackfillIndex(
     index_ids.push_back(index_map.at(idx.table_id()).table_id());
   }
 
-  Status s =
-      tablet.peer->tablet()->BackfillIndexes(indices_to_backfill, read_at);
+  Status s = tablet.peer->tablet()->BackfillIndexes(
+      indices_to_backfill, read_at, req->start_key(), req->end_key());
   DVLOG(1) << "Tablet " << tablet.peer->tablet_id()
            << ". Backfilled indices for : " << yb::ToString(index_ids) << " with status " << s;
   if (!s.ok()) {
@@ -817,6 +838,93 @@ void TabletServiceImpl::UpdateTransaction(const UpdateTransactionRequestPB* req,
   }
 }
 
+namespace {
+
+// Responds to UpdateTransactions RPC when operations for all states of the request are completed.
+class UpdateTransactionsCompletion {
+ public:
+  UpdateTransactionsCompletion(
+      rpc::RpcContext context, UpdateTransactionsResponsePB* response,
+      const server::ClockPtr& clock, int num_states)
+      : context_(std::move(context)), response_(response), clock_(clock),
+        num_pending_(num_states) {
+    for (int i = 0; i != num_states; ++i) {
+      response_->add_statuses();
+    }
+  }
+
+  void Completed(int idx, const Status& status) {
+    StatusToPB(status, response_->mutable_statuses(idx));
+    if (num_pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      response_->set_propagated_hybrid_time(clock_->Now().ToUint64());
+      context_.RespondSuccess();
+    }
+  }
+
+ private:
+  rpc::RpcContext context_;
+  UpdateTransactionsResponsePB* const response_;
+  server::ClockPtr clock_;
+  std::atomic<int> num_pending_;
+};
+
+class UpdateTransactionsEntryCallback : public OperationCompletionCallback {
+ public:
+  UpdateTransactionsEntryCallback(
+      std::shared_ptr<UpdateTransactionsCompletion> completion, int idx)
+      : completion_(std::move(completion)), idx_(idx) {}
+
+  void OperationCompleted() override {
+    completion_->Completed(idx_, status_);
+  }
+
+ private:
+  std::shared_ptr<UpdateTransactionsCompletion> completion_;
+  const int idx_;
+};
+
+} // namespace
+
+void TabletServiceImpl::UpdateTransactions(const UpdateTransactionsRequestPB* req,
+                                           UpdateTransactionsResponsePB* resp,
+                                           rpc::RpcContext context) {
+  TRACE("UpdateTransactions");
+
+  VLOG(1) << "UpdateTransactions: " << req->ShortDebugString()
+          << ", context: " << context.ToString();
+  UpdateClock(*req, server_->Clock());
+
+  auto tablet = LookupLeaderTabletOrRespond(
+      server_->tablet_peer_lookup(), req->tablet_id(), resp, &context);
+  if (!tablet) {
+    return;
+  }
+
+  if (req->state().empty()) {
+    resp->set_propagated_hybrid_time(server_->Clock()->Now().ToUint64());
+    context.RespondSuccess();
+    return;
+  }
+
+  auto completion = std::make_shared<UpdateTransactionsCompletion>(
+      std::move(context), resp, server_->Clock(), req->state_size());
+  auto* coordinator = tablet.peer->tablet()->transaction_coordinator();
+  for (int i = 0; i != req->state_size(); ++i) {
+    const auto& state_pb = req->state(i);
+    if (state_pb.status() != TransactionStatus::PENDING) {
+      completion->Completed(i, STATUS_FORMAT(
+          InvalidArgument, "Only PENDING transactions could be batched, but $0 was requested",
+          TransactionStatus_Name(state_pb.status())));
+      continue;
+    }
+    auto state = std::make_unique<tablet::UpdateTxnOperationState>(
+        tablet.peer->tablet(), &state_pb);
+    state->set_completion_callback(
+        std::make_unique<UpdateTransactionsEntryCallback>(completion, i));
+    coordinator->Handle(std::move(state), tablet.leader_term);
+  }
+}
+
 template <class Req, class Resp, class Action>
 void TabletServiceImpl::PerformAtLeader(
     const Req& req, Resp* resp, rpc::RpcContext* context, const Action& action) {
@@ -1272,6 +1380,112 @@ void TabletServiceImpl::Write(const WriteRequestPB* req,
       std::move(operation_state), tablet.leader_term, context_ptr->GetClientDeadline());
 }
 
+namespace {
+
+// State of the MultiWrite RPC, while writes of the batch are in progress.
+class MultiWriteState {
+ public:
+  MultiWriteState(rpc::RpcContext context, MultiWriteResponsePB* resp, size_t num_writes)
+      : context_(std::move(context)), resp_(resp), controllers_(num_writes),
+        running_(num_writes) {
+  }
+
+  rpc::RpcController* controller(size_t idx) {
+    return &controllers_[idx];
+  }
+
+  CoarseTimePoint deadline() const {
+    return context_.GetClientDeadline();
+  }
+
+  void WriteDone() {
+    if (--running_ == 0) {
+      Respond();
+    }
+  }
+
+ private:
+  void Respond() {
+    for (size_t i = 0; i != controllers_.size(); ++i) {
+      auto* write_resp = resp_->mutable_write_response(static_cast<int>(i));
+      auto status = controllers_[i].status();
+      if (status.ok()) {
+        status = MoveSidecars(controllers_[i], write_resp);
+      }
+      if (!status.ok()) {
+        write_resp->Clear();
+        auto* error = write_resp->mutable_error();
+        StatusToPB(status, error->mutable_status());
+        error->set_code(TabletServerErrorPB::UNKNOWN_ERROR);
+      }
+    }
+    context_.RespondSuccess();
+  }
+
+  // Sidecars of the write are added to the MultiWrite RPC, and the indexes in the write response
+  // are updated accordingly.
+  template <class Responses>
+  Status MoveSidecars(const rpc::RpcController& controller, Responses* responses) {
+    for (auto& response : *responses) {
+      if (!response.has_rows_data_sidecar()) {
+        continue;
+      }
+      auto sidecar = VERIFY_RESULT(controller.GetSidecar(response.rows_data_sidecar()));
+      int idx = 0;
+      RETURN_NOT_OK(context_.AddRpcSidecar(RefCntBuffer(sidecar.data(), sidecar.size()), &idx));
+      response.set_rows_data_sidecar(idx);
+    }
+    return Status::OK();
+  }
+
+  Status MoveSidecars(const rpc::RpcController& controller, WriteResponsePB* write_resp) {
+    RETURN_NOT_OK(MoveSidecars(controller, write_resp->mutable_ql_response_batch()));
+    return MoveSidecars(controller, write_resp->mutable_pgsql_response_batch());
+  }
+
+  rpc::RpcContext context_;
+  MultiWriteResponsePB* const resp_;
+  std::vector<rpc::RpcController> controllers_;
+  std::atomic<size_t> running_;
+};
+
+} // namespace
+
+void TabletServiceImpl::MultiWrite(const MultiWriteRequestPB* req,
+                                   MultiWriteResponsePB* resp,
+                                   rpc::RpcContext context) {
+  TRACE_EVENT1("tserver", "TabletServiceImpl::MultiWrite",
+               "num_writes", req->write_request_size());
+  const auto& proxy = server_->proxy();
+  if (!proxy) {
+    SetupErrorAndRespond(
+        resp->mutable_error(), STATUS(NotSupported, "MultiWrite is not supported by this server"),
+        TabletServerErrorPB::UNKNOWN_ERROR, &context);
+    return;
+  }
+  if (req->write_request().empty()) {
+    context.RespondSuccess();
+    return;
+  }
+
+  // Responses are added before dispatching any write, so pointers to them stay valid.
+  for (int i = 0; i != req->write_request_size(); ++i) {
+    resp->add_write_response();
+  }
+
+  // Each write is dispatched as a local call to this service, so it is processed exactly like a
+  // separately sent Write RPC, and failure of one tablet does not affect other tablets of the batch.
+  auto state = std::make_shared<MultiWriteState>(
+      std::move(context), resp, req->write_request_size());
+  for (int i = 0; i != req->write_request_size(); ++i) {
+    auto* controller = state->controller(i);
+    controller->set_deadline(state->deadline());
+    proxy->WriteAsync(
+        req->write_request(i), resp->mutable_write_response(i), controller,
+        [state] { state->WriteDone(); });
+  }
+}
+
 Status TabletServiceImpl::CheckPeerIsReady(const TabletPeer& tablet_peer) {
   shared_ptr<consensus::Consensus> consensus = tablet_peer.shared_consensus();
   if (!consensus) {
@@ -1327,6 +1541,7 @@ bool TabletServiceImpl::DoGetTabletOrRespond(
     return false;
   }
 
+  bool served_by_follower = false;
   // Check for leader only in strong consistency level.
   if (req->consistency_level() == YBConsistencyLevel::STRONG) {
     if (PREDICT_FALSE(FLAGS_assert_reads_served_by_follower) &&
@@ -1346,6 +1561,7 @@ bool TabletServiceImpl::DoGetTabletOrRespond(
     }
   } else {
     s = CheckPeerIsLeader(*tablet_peer.get());
+    served_by_follower = !s.ok();
 
     // Peer is not the leader, so check that the time since it last heard from the leader is less
     // than FLAGS_max_stale_read_bound_time_ms.
@@ -1400,6 +1616,31 @@ bool TabletServiceImpl::DoGetTabletOrRespond(
     SetupErrorAndRespond(resp->mutable_error(), s, error_code, context);
     return false;
   }
+
+  if (PREDICT_FALSE(ptr->log_only())) {
+    // Log-only peer does not have the data, so the client should try another replica.
+    SetupErrorAndRespond(
+        resp->mutable_error(), STATUS(IllegalState, "Log-only peer does not serve requests"),
+        TabletServerErrorPB::TABLET_NOT_RUNNING, context);
+    return false;
+  }
+
+  // Bounded staleness read could be served by a follower only when its safe time is recent enough.
+  const auto max_staleness_ms = served_by_follower ? MaxStalenessMs(*req) : 0;
+  if (max_staleness_ms && server_ && server_->Clock()) {
+    auto safe_time = ptr->SafeTime(tablet::RequireLease::kFalse);
+    auto now_micros = server_->Clock()->Now().GetPhysicalValueMicros();
+    if (!safe_time.is_valid() ||
+        safe_time.GetPhysicalValueMicros() + max_staleness_ms * 1000 < now_micros) {
+      SetupErrorAndRespond(
+          resp->mutable_error(),
+          STATUS_FORMAT(IllegalState, "Safe time $0 is staler than $1 ms", safe_time,
+                        max_staleness_ms),
+          TabletServerErrorPB::STALE_FOLLOWER, context);
+      return false;
+    }
+  }
+
   *tablet = ptr;
   return true;
 }
@@ -1415,10 +1656,19 @@ struct ReadContext {
   HybridTime safe_ht_to_read;
   ReadHybridTime used_read_time;
   tablet::RequireLease require_lease = tablet::RequireLease::kFalse;
+  // Whether each request of the batch reads a single key, see IsScan.
+  bool point_read = false;
   HostPortPB* host_port_pb = nullptr;
   bool allow_retry = false;
   RequestScope request_scope;
 
+  // When lock_rows_peer is set, the rows returned by the read are locked with lock_rows_row_mark
+  // before responding, see TabletServiceImpl::LockReadRows.
+  tablet::TabletPeerPtr lock_rows_peer;
+  int64_t lock_rows_leader_term = OpId::kUnknownTerm;
+  RowMarkType lock_rows_row_mark = RowMarkType::ROW_MARK_ABSENT;
+  std::vector<std::string> row_keys_to_lock;
+
   bool transactional() const {
     return tablet->IsTransactionalRequest(req->pgsql_batch_size() > 0);
   }
@@ -1440,8 +1690,14 @@ struct ReadContext {
         read_time.global_limit = read_time.read;
       }
     } else {
-      safe_ht_to_read = tablet->SafeTime(
-          require_lease, read_time.read, context->GetClientDeadline());
+      if (require_lease && point_read) {
+        safe_ht_to_read = down_cast<tablet::Tablet*>(tablet.get())->SafeTimeForPointRead(
+            read_time.read, req->transaction(), req->ql_batch(), req->pgsql_batch());
+      }
+      if (!safe_ht_to_read.is_valid()) {
+        safe_ht_to_read = tablet->SafeTime(
+            require_lease, read_time.read, context->GetClientDeadline());
+      }
       if (!safe_ht_to_read.is_valid()) { // Timed out
         const char* error_message = "Timed out waiting for read time";
         TRACE(error_message);
@@ -1452,6 +1708,28 @@ struct ReadContext {
   }
 };
 
+namespace {
+
+// Returns true if the read is a scan, i.e. it is not limited to a single key or it continues a
+// paged read.
+bool IsScan(const ReadRequestPB& req) {
+  for (const auto& ql_req : req.ql_batch()) {
+    if (ql_req.has_paging_state() || ql_req.hashed_column_values().empty()) {
+      return true;
+    }
+  }
+  for (const auto& pgsql_req : req.pgsql_batch()) {
+    if (pgsql_req.has_paging_state() ||
+        (!pgsql_req.has_ybctid_column_value() && pgsql_req.partition_column_values().empty() &&
+         pgsql_req.range_column_values().empty())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
 // Used when we write intents during read, i.e. for serializable isolation.
 // We cannot proceed with read from ReadOperationCompletionCallback, to avoid holding
 // replica state lock for too long.
@@ -1596,6 +1874,10 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
     }
   }
   const bool has_row_mark = IsValidRowMarkType(batch_row_mark);
+  // Rows of serializable transactions are read after read intents are written, so they keep being
+  // locked before the read.
+  const bool lock_rows_after_read =
+      has_row_mark && !serializable_isolation && FLAGS_ysql_lock_rows_after_read;
 
   LeaderTabletPeer leader_peer;
   ReadContext read_context = {req, resp, &context};
@@ -1640,6 +1922,7 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
   read_context.allow_retry = !read_time;
   read_context.require_lease = tablet::RequireLease(
       req->consistency_level() == YBConsistencyLevel::STRONG);
+  read_context.point_read = req->redis_batch().empty() && !IsScan(*req);
   // TODO: should check all the tables referenced by the requests to decide if it is transactional.
   const bool transactional = read_context.transactional();
   // Should not pick read time for serializable isolation, since it is picked after read intents
@@ -1669,6 +1952,14 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
   host_port_pb.set_port(remote_address.port());
   read_context.host_port_pb = &host_port_pb;
 
+  if (lock_rows_after_read) {
+    read_context.lock_rows_peer = leader_peer.peer;
+    read_context.lock_rows_leader_term = leader_peer.leader_term;
+    read_context.lock_rows_row_mark = batch_row_mark;
+    CompleteRead(&read_context);
+    return;
+  }
+
   if (serializable_isolation || has_row_mark) {
     WriteRequestPB write_req;
     *write_req.mutable_write_batch()->mutable_transaction() = req->transaction();
@@ -1706,6 +1997,29 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
     return;
   }
 
+  if (ReadScheduler::Enabled() && IsScan(*req) && server_->tablet_manager()) {
+    // Scans are executed by the read scheduler, so they do not occupy RPC service threads, that
+    // serve point reads.
+    auto context_ptr = std::make_shared<RpcContext>(std::move(context));
+    auto host_port_ptr = std::make_shared<HostPortPB>(std::move(host_port_pb));
+    read_context.context = context_ptr.get();
+    read_context.host_port_pb = host_port_ptr.get();
+    auto read_context_ptr = std::make_shared<ReadContext>(std::move(read_context));
+    server_->tablet_manager()->read_scheduler()->Submit(
+        req->tablet_id(), [this, read_context_ptr, context_ptr, host_port_ptr] {
+      if (CoarseMonoClock::now() > context_ptr->GetClientDeadline()) {
+        TRACE("Scheduled read timed out");
+        SetupErrorAndRespond(
+            read_context_ptr->resp->mutable_error(),
+            STATUS(TimedOut, "Timed out waiting for read to be scheduled"),
+            TabletServerErrorPB::UNKNOWN_ERROR, context_ptr.get());
+        return;
+      }
+      CompleteRead(read_context_ptr.get());
+    });
+    return;
+  }
+
   CompleteRead(&read_context);
 }
 
@@ -1713,6 +2027,7 @@ void TabletServiceImpl::CompleteRead(ReadContext* read_context) {
   for (;;) {
     read_context->resp->Clear();
     read_context->context->ResetRpcSidecars();
+    read_context->row_keys_to_lock.clear();
     VLOG(1) << "Read time: " << read_context->read_time
             << ", safe: " << read_context->safe_ht_to_read;
     auto result = DoRead(read_context);
@@ -1782,12 +2097,48 @@ void TabletServiceImpl::CompleteRead(ReadContext* read_context) {
   }
 #endif
 
+  if (read_context->lock_rows_peer && !read_context->resp->has_restart_read_time() &&
+      !read_context->row_keys_to_lock.empty()) {
+    LockReadRows(read_context);
+    return;
+  }
+
   RpcOperationCompletionCallback<ReadResponsePB> callback(
       std::move(*read_context->context), read_context->resp, server_->Clock());
   callback.OperationCompleted();
   TRACE("Done Read");
 }
 
+void TabletServiceImpl::LockReadRows(ReadContext* read_context) {
+  TRACE("Lock $0 rows", read_context->row_keys_to_lock.size());
+  const auto& req = *read_context->req;
+  WriteRequestPB write_req;
+  auto* write_batch = write_req.mutable_write_batch();
+  *write_batch->mutable_transaction() = req.transaction();
+  write_batch->set_row_mark_type(read_context->lock_rows_row_mark);
+  // Conflict resolution checks that the rows were not changed after they were read.
+  read_context->used_read_time.ToPB(write_req.mutable_read_time());
+  write_req.set_tablet_id(req.tablet_id());
+  write_batch->set_deprecated_may_have_metadata(true);
+  write_req.set_batch_idx(req.batch_idx());
+  for (auto& key : read_context->row_keys_to_lock) {
+    auto* pair = write_batch->add_read_pairs();
+    pair->set_key(std::move(key));
+    pair->set_value(std::string(1, docdb::ValueTypeAsChar::kNullLow));
+  }
+
+  const auto& peer = read_context->lock_rows_peer;
+  auto operation_state = std::make_unique<WriteOperationState>(
+      peer->tablet(), &write_req, nullptr /* response */, docdb::OperationKind::kRead);
+  AdjustYsqlOperationTransactionality(req.pgsql_batch_size(), peer.get(), operation_state.get());
+
+  // The response is already filled by the read, it is sent once the rows are locked.
+  const auto deadline = read_context->context->GetClientDeadline();
+  operation_state->set_completion_callback(MakeRpcOperationCompletionCallback(
+      std::move(*read_context->context), read_context->resp, server_->Clock()));
+  peer->WriteAsync(std::move(operation_state), read_context->lock_rows_leader_term, deadline);
+}
+
 void HandleRedisReadRequestAsync(
     tablet::AbstractTablet* tablet,
     CoarseTimePoint deadline,
@@ -1860,11 +2211,13 @@ Result<ReadHybridTime> TabletServiceImpl::DoRead(ReadContext* read_context) {
     ReadRequestPB* mutable_req = const_cast<ReadRequestPB*>(read_context->req);
     for (QLReadRequestPB& ql_read_req : *mutable_req->mutable_ql_batch()) {
       // Update the remote endpoint.
-      ql_read_req.set_allocated_remote_endpoint(read_context->host_port_pb);
-      ql_read_req.set_allocated_proxy_uuid(mutable_req->mutable_proxy_uuid());
+      // Fields are borrowed, so unsafe arena accessors are used, that never take ownership, nor
+      // copy, regardless of whether the request is allocated on an arena.
+      ql_read_req.unsafe_arena_set_allocated_remote_endpoint(read_context->host_port_pb);
+      ql_read_req.unsafe_arena_set_allocated_proxy_uuid(mutable_req->mutable_proxy_uuid());
       auto se = ScopeExit([&ql_read_req] {
-        ql_read_req.release_remote_endpoint();
-        ql_read_req.release_proxy_uuid();
+        ql_read_req.unsafe_arena_release_remote_endpoint();
+        ql_read_req.unsafe_arena_release_proxy_uuid();
       });
 
       tablet::QLReadRequestResult result;
@@ -1883,9 +2236,13 @@ Result<ReadHybridTime> TabletServiceImpl::DoRead(ReadContext* read_context) {
       }
       int rows_data_sidecar_idx = 0;
       RETURN_NOT_OK(read_context->context->AddRpcSidecar(
-          RefCntBuffer(result.rows_data), &rows_data_sidecar_idx));
+          RefCntBuffer(std::move(result.rows_data)), &rows_data_sidecar_idx));
       result.response.set_rows_data_sidecar(rows_data_sidecar_idx);
-      read_context->resp->add_ql_batch()->Swap(&result.response);
+      // Response could be allocated on an arena, so heap allocated batch is added to avoid
+      // copying during swap between different arenas.
+      auto* ql_response = new QLResponsePB();
+      ql_response->Swap(&result.response);
+      read_context->resp->mutable_ql_batch()->AddAllocated(ql_response);
     }
     return ReadHybridTime();
   }
@@ -1907,9 +2264,17 @@ Result<ReadHybridTime> TabletServiceImpl::DoRead(ReadContext* read_context) {
       }
       int rows_data_sidecar_idx = 0;
       RETURN_NOT_OK(read_context->context->AddRpcSidecar(
-          RefCntBuffer(result.rows_data), &rows_data_sidecar_idx));
+          RefCntBuffer(std::move(result.rows_data)), &rows_data_sidecar_idx));
       result.response.set_rows_data_sidecar(rows_data_sidecar_idx);
-      read_context->resp->add_pgsql_batch()->Swap(&result.response);
+      if (read_context->lock_rows_peer) {
+        auto& row_keys = read_context->row_keys_to_lock;
+        row_keys.insert(row_keys.end(),
+                        std::make_move_iterator(result.row_keys_to_lock.begin()),
+                        std::make_move_iterator(result.row_keys_to_lock.end()));
+      }
+      auto* pgsql_response = new PgsqlResponsePB();
+      pgsql_response->Swap(&result.response);
+      read_context->resp->mutable_pgsql_batch()->AddAllocated(pgsql_response);
     }
     return ReadHybridTime();
   }
@@ -1937,37 +2302,77 @@ void ConsensusServiceImpl::UpdateConsensus(const ConsensusRequestPB* req,
   if (!CheckUuidMatchOrRespond(tablet_manager_, "UpdateConsensus", req, resp, &context)) {
     return;
   }
-  auto tablet_peer = VERIFY_RESULT_OR_RETURN(LookupTabletPeerOrRespond(
-      tablet_manager_, req->tablet_id(), resp, &context));
-
-  // Submit the update directly to the TabletPeer's Consensus instance.
-  shared_ptr<Consensus> consensus;
-  if (!GetConsensusOrRespond(tablet_peer, resp, &context, &consensus)) return;
 
   // Unfortunately, we have to use const_cast here, because the protobuf-generated interface only
   // gives us a const request, but we need to be able to move messages out of the request for
   // efficiency.
-  Status s = consensus->Update(
-      const_cast<ConsensusRequestPB*>(req), resp, context.GetClientDeadline());
+  TabletServerErrorPB::Code error_code = TabletServerErrorPB::UNKNOWN_ERROR;
+  Status s = DoUpdateConsensus(
+      const_cast<ConsensusRequestPB*>(req), resp, context.GetClientDeadline(), &error_code);
   if (PREDICT_FALSE(!s.ok())) {
     // Clear the response first, since a partially-filled response could
     // result in confusing a caller, or in having missing required fields
     // in embedded optional messages.
     resp->Clear();
 
-    SetupErrorAndRespond(resp->mutable_error(), s,
-                         TabletServerErrorPB::UNKNOWN_ERROR,
-                         &context);
+    SetupErrorAndRespond(resp->mutable_error(), s, error_code, &context);
     return;
   }
 
+  context.RespondSuccess();
+}
+
+void ConsensusServiceImpl::MultiRaftUpdateConsensus(
+    const consensus::MultiRaftConsensusRequestPB* req,
+    consensus::MultiRaftConsensusResponsePB* resp,
+    rpc::RpcContext context) {
+  DVLOG(3) << "Received Batched Consensus Update RPC: " << req->ShortDebugString();
+  if (!CheckUuidMatchOrRespond(tablet_manager_, "MultiRaftUpdateConsensus", req, resp, &context)) {
+    return;
+  }
+
+  // Each request is processed independently, so failure of one tablet does not affect the
+  // responses to other tablets of the batch.
+  auto deadline = context.GetClientDeadline();
+  auto* mutable_req = const_cast<consensus::MultiRaftConsensusRequestPB*>(req);
+  for (auto& consensus_req : *mutable_req->mutable_consensus_request()) {
+    consensus::ApplyBatchLeaderLease(*req, &consensus_req);
+    auto* consensus_resp = resp->add_consensus_response();
+    TabletServerErrorPB::Code error_code = TabletServerErrorPB::UNKNOWN_ERROR;
+    Status s = DoUpdateConsensus(&consensus_req, consensus_resp, deadline, &error_code);
+    if (PREDICT_FALSE(!s.ok())) {
+      consensus_resp->Clear();
+      auto* error = consensus_resp->mutable_error();
+      StatusToPB(s, error->mutable_status());
+      error->set_code(error_code);
+    }
+  }
+
+  context.RespondSuccess();
+}
+
+Status ConsensusServiceImpl::DoUpdateConsensus(
+    ConsensusRequestPB* req, ConsensusResponsePB* resp, CoarseTimePoint deadline,
+    TabletServerErrorPB::Code* error_code) {
+  auto tablet_peer = VERIFY_RESULT(LookupTabletPeer(tablet_manager_, req->tablet_id(), error_code));
+
+  // Submit the update directly to the TabletPeer's Consensus instance.
+  shared_ptr<Consensus> consensus = tablet_peer->shared_consensus();
+  if (!consensus) {
+    *error_code = TabletServerErrorPB::TABLET_NOT_RUNNING;
+    return STATUS(ServiceUnavailable, "Consensus unavailable. Tablet not running");
+  }
+
+  *error_code = TabletServerErrorPB::UNKNOWN_ERROR;
+  RETURN_NOT_OK(consensus->Update(req, resp, deadline));
+
   auto tablet = tablet_peer->shared_tablet();
   if (tablet) {
     resp->set_num_sst_files(tablet->GetCurrentVersionNumSSTFiles());
   }
 
   resp->set_propagated_hybrid_time(tablet_peer->clock().Now().ToUint64());
-  context.RespondSuccess();
+  return Status::OK();
 }
 
 void ConsensusServiceImpl::RequestConsensusVote(const VoteRequestPB* req,
@@ -2043,10 +2448,10 @@ class RpcScope {
     if (!CheckUuidMatchOrRespond(tablet_manager, method_name, req, resp, context)) {
       return;
     }
-    auto tablet_peer = VERIFY_RESULT_OR_RETURN(LookupTabletPeerOrRespond(
+    tablet_peer_ = VERIFY_RESULT_OR_RETURN(LookupTabletPeerOrRespond(
         tablet_manager, req->tablet_id(), resp, context));
 
-    if (!GetConsensusOrRespond(tablet_peer, resp, context, &consensus_)) {
+    if (!GetConsensusOrRespond(tablet_peer_, resp, context, &consensus_)) {
       return;
     }
     responded_ = false;
@@ -2073,6 +2478,10 @@ class RpcScope {
     return consensus_.get();
   }
 
+  const std::shared_ptr<tablet::TabletPeer>& tablet_peer() const {
+    return tablet_peer_;
+  }
+
   explicit operator bool() const {
     return !responded_;
   }
@@ -2080,6 +2489,7 @@ class RpcScope {
  private:
   rpc::RpcContext* context_;
   bool responded_ = true;
+  std::shared_ptr<tablet::TabletPeer> tablet_peer_;
   shared_ptr<Consensus> consensus_;
 };
 
@@ -2101,6 +2511,14 @@ void ConsensusServiceImpl::RunLeaderElection(const RunLeaderElectionRequestPB* r
         consensus::TEST_SuppressVoteRequest(
           req->has_suppress_vote_request() && req->suppress_vote_request()) });
   scope.CheckStatus(s, resp);
+
+  if (s.ok() && req->hot_keys_size() != 0) {
+    auto tablet = scope.tablet_peer()->shared_tablet();
+    if (tablet) {
+      tablet->WarmUpBlockCache(
+          std::vector<std::string>(req->hot_keys().begin(), req->hot_keys().end()));
+    }
+  }
 }
 
 void ConsensusServiceImpl::LeaderElectionLost(const consensus::LeaderElectionLostRequestPB *req,
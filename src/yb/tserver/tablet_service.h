@@ -68,6 +68,9 @@ class TabletServiceImpl : public TabletServerServiceIf {
 
   void Write(const WriteRequestPB* req, WriteResponsePB* resp, rpc::RpcContext context) override;
 
+  void MultiWrite(const MultiWriteRequestPB* req, MultiWriteResponsePB* resp,
+                  rpc::RpcContext context) override;
+
   void Read(const ReadRequestPB* req, ReadResponsePB* resp, rpc::RpcContext context) override;
 
   void NoOp(const NoOpRequestPB* req, NoOpResponsePB* resp, rpc::RpcContext context) override;
@@ -104,6 +107,10 @@ class TabletServiceImpl : public TabletServerServiceIf {
                          UpdateTransactionResponsePB* resp,
                          rpc::RpcContext context) override;
 
+  void UpdateTransactions(const UpdateTransactionsRequestPB* req,
+                          UpdateTransactionsResponsePB* resp,
+                          rpc::RpcContext context) override;
+
   void GetTransactionStatus(const GetTransactionStatusRequestPB* req,
                             GetTransactionStatusResponsePB* resp,
                             rpc::RpcContext context) override;
@@ -173,6 +180,9 @@ class TabletServiceImpl : public TabletServerServiceIf {
   // Completes read, invokes DoRead in loop, adjusting read time due to read restart time.
   // Sends response, etc.
   void CompleteRead(ReadContext* read_context);
+  // Locks the rows returned by the read with a single write operation, and sends the response
+  // once they are locked.
+  void LockReadRows(ReadContext* read_context);
 
   TabletServerIf *const server_;
 };
@@ -251,6 +261,10 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                                consensus::ConsensusResponsePB *resp,
                                rpc::RpcContext context) override;
 
+  void MultiRaftUpdateConsensus(const consensus::MultiRaftConsensusRequestPB* req,
+                                consensus::MultiRaftConsensusResponsePB* resp,
+                                rpc::RpcContext context) override;
+
   virtual void RequestConsensusVote(const consensus::VoteRequestPB* req,
                                     consensus::VoteResponsePB* resp,
                                     rpc::RpcContext context) override;
@@ -288,6 +302,12 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                                     rpc::RpcContext context) override;
 
  private:
+  // Applies the update to the consensus of the tablet specified in the request.
+  // On failure error_code is filled with the code that should be reported to the caller.
+  CHECKED_STATUS DoUpdateConsensus(
+      consensus::ConsensusRequestPB* req, consensus::ConsensusResponsePB* resp,
+      CoarseTimePoint deadline, TabletServerErrorPB::Code* error_code);
+
   TabletPeerLookupIf* tablet_manager_;
 };
 
@@ -58,6 +58,7 @@
   ASSERT_NO_FATALS(AssertMonotonicReportSeqno(report_seqno, tablet_report))
 
 DECLARE_bool(pretend_memory_exceeded_enforce_flush);
+DECLARE_int32(tablet_report_limit);
 
 namespace yb {
 namespace tserver {
@@ -414,6 +415,31 @@ TEST_F(TsTabletManagerTest, TestTabletReports) {
   ASSERT_REPORT_HAS_UPDATED_TABLET(report, "tablet-1");
   ASSERT_REPORT_HAS_UPDATED_TABLET(report, "tablet-2");
   ASSERT_MONOTONIC_REPORT_SEQNO(&seqno, report);
+
+  // A full report that does not fit into the limit should be sent in parts, all of them
+  // non-incremental.
+  FlagSaver flag_saver;
+  FLAGS_tablet_report_limit = 1;
+  tablet_manager_->GenerateFullTabletReport(&report);
+  ASSERT_FALSE(report.is_incremental());
+  ASSERT_EQ(1, report.updated_tablets().size());
+  ASSERT_EQ(1, report.remaining_tablet_count());
+  ASSERT_MONOTONIC_REPORT_SEQNO(&seqno, report);
+  const auto first_tablet_id = report.updated_tablets(0).tablet_id();
+  tablet_manager_->MarkTabletReportAcknowledged(report);
+
+  tablet_manager_->GenerateIncrementalTabletReport(&report);
+  ASSERT_FALSE(report.is_incremental());
+  ASSERT_EQ(1, report.updated_tablets().size());
+  ASSERT_EQ(0, report.remaining_tablet_count());
+  ASSERT_NE(first_tablet_id, report.updated_tablets(0).tablet_id());
+  ASSERT_MONOTONIC_REPORT_SEQNO(&seqno, report);
+  tablet_manager_->MarkTabletReportAcknowledged(report);
+
+  // Once all parts are acknowledged, reports are incremental again.
+  tablet_manager_->GenerateIncrementalTabletReport(&report);
+  ASSERT_TRUE(report.is_incremental());
+  ASSERT_MONOTONIC_REPORT_SEQNO(&seqno, report);
 }
 
 } // namespace tserver
@@ -33,6 +33,7 @@
 #include "yb/tserver/ts_tablet_manager.h"
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -50,6 +51,7 @@
 #include "yb/consensus/log.h"
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/metadata.pb.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/quorum_util.h"
 #include "yb/consensus/retryable_requests.h"
@@ -65,9 +67,13 @@
 #include "yb/master/sys_catalog.h"
 
 #include "yb/rocksdb/memory_monitor.h"
+#include "yb/rocksdb/util/arena_block_pool.h"
+#include "yb/rocksdb/persistent_cache.h"
+#include "yb/rocksdb/statistics.h"
 
 #include "yb/rpc/messenger.h"
 
+#include "yb/tablet/final_transaction_status_cache.h"
 #include "yb/tablet/metadata.pb.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet.pb.h"
@@ -78,6 +84,7 @@
 #include "yb/tablet/tablet_options.h"
 
 #include "yb/tserver/heartbeater.h"
+#include "yb/tserver/memory_rebalancer.h"
 #include "yb/tserver/remote_bootstrap_client.h"
 #include "yb/tserver/remote_bootstrap_session.h"
 #include "yb/tserver/remote_bootstrap_snapshots.h"
@@ -94,6 +101,7 @@
 #include "yb/util/metrics.h"
 #include "yb/util/pb_util.h"
 #include "yb/util/scope_exit.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/stopwatch.h"
 #include "yb/util/trace.h"
 #include "yb/util/tsan_util.h"
@@ -102,6 +110,7 @@
 
 using namespace std::literals;
 using namespace std::placeholders;
+using namespace yb::size_literals;
 
 DEFINE_int32(num_tablets_to_open_simultaneously, 0,
              "Number of threads available to open tablets during startup. If this "
@@ -176,6 +185,12 @@ DEFINE_int64(global_memstore_size_mb_max, 2048,
              "memory. However, this flag limits it in absolute size. Value of 0 "
              "means no limit on the value obtained by the percentage. Default is 2048.");
 
+DEFINE_int64(memstore_arena_pool_max_idle_mb, 0,
+             "Memtables of all tablets borrow their arena blocks from a shared pool, that keeps "
+             "up to this number of megabytes of blocks given back by flushed memtables for reuse. "
+             "0 disables the pool, so each memtable allocates its own blocks.");
+TAG_FLAG(memstore_arena_pool_max_idle_mb, advanced);
+
 DEFINE_int64(db_block_cache_size_bytes, kDbCacheSizeUsePercentage,
              "Size of cross-tablet shared RocksDB block cache (in bytes). "
              "This defaults to -1 for system auto-generated default, which would use "
@@ -186,6 +201,22 @@ DEFINE_int32(db_block_cache_size_percentage, 50,
              "Default percentage of total available memory to use as block cache size, if not "
              "asking for a raw number, through FLAGS_db_block_cache_size_bytes.");
 
+DEFINE_string(db_persistent_cache_path, "",
+              "Directory on a fast local device (e.g. NVMe) to keep the secondary tier of the "
+              "RocksDB block cache. Blocks read from SST files are stored there in their on-disk, "
+              "compressed, form. Empty value disables persistent block cache.");
+TAG_FLAG(db_persistent_cache_path, advanced);
+
+DEFINE_int64(db_persistent_cache_size_bytes, 0,
+             "Size of the persistent block cache (in bytes). Zero disables persistent block "
+             "cache.");
+TAG_FLAG(db_persistent_cache_size_bytes, advanced);
+
+DEFINE_int64(db_persistent_cache_file_size_bytes, 64_MB,
+             "Size of the single file of the persistent block cache. Eviction from the persistent "
+             "block cache drops the oldest file.");
+TAG_FLAG(db_persistent_cache_file_size_bytes, advanced);
+
 DEFINE_int32(read_pool_max_threads, 128,
              "The maximum number of threads allowed for read_pool_. This pool is used "
              "to run multiple read operations, that are part of the same tablet rpc, "
@@ -204,6 +235,58 @@ DEFINE_int32(tserver_yb_client_default_timeout_ms, kTServerYbClientDefaultTimeou
              "Default timeout for the YBClient embedded into the tablet server that is used "
              "for distributed transactions.");
 
+DEFINE_uint64(final_transaction_status_cache_size, 100000,
+              "Max number of finished transactions, whose final status is cached by the tablet "
+              "server for participants of all its tablets. 0 disables the cache.");
+TAG_FLAG(final_transaction_status_cache_size, advanced);
+
+DEFINE_int32(tablet_report_limit, 1000,
+             "Max number of tablets reported to the master in a single heartbeat. Remaining "
+             "tablets are reported in the following heartbeats, that are sent right after the "
+             "previous one is acknowledged. 0 means no limit.");
+TAG_FLAG(tablet_report_limit, advanced);
+TAG_FLAG(tablet_report_limit, runtime);
+
+DEFINE_int32(memory_rebalancer_interval_ms, 0,
+             "Interval between decisions of the memory rebalancer, that shifts memory budget "
+             "between the block cache, the global memstore and the log cache, depending on their "
+             "hit rates and pressure. 0 disables the rebalancer.");
+TAG_FLAG(memory_rebalancer_interval_ms, advanced);
+
+DEFINE_int32(tablet_hibernation_idle_timeout_sec, 0,
+             "Close RocksDB of tablets that did not serve reads or writes for this number of "
+             "seconds to release their memory, Raft keeps running and RocksDB is reopened on the "
+             "next access. Transactional tablets are not hibernated. 0 disables hibernation.");
+TAG_FLAG(tablet_hibernation_idle_timeout_sec, advanced);
+
+DEFINE_int32(hot_keys_persist_interval_sec, 300,
+             "How often recently read keys of tablets are persisted, so the block cache could be "
+             "warmed up with them after restart. 0 to disable.");
+TAG_FLAG(hot_keys_persist_interval_sec, advanced);
+
+DEFINE_bool(tablet_placement_drive_load_aware, false,
+            "Choose data and WAL root dirs of new and remote bootstrapped tablets by the bytes "
+            "stored and the write rate of the tablets in each dir, instead of only by the number "
+            "of tablets of the same table in each dir.");
+TAG_FLAG(tablet_placement_drive_load_aware, advanced);
+TAG_FLAG(tablet_placement_drive_load_aware, runtime);
+
+DEFINE_int32(intra_node_disk_rebalance_interval_sec, 0,
+             "Interval of moving a tablet from the data root dir storing the most bytes to the "
+             "one storing the least, while the tablet stays online. 0 disables the rebalancing.");
+TAG_FLAG(intra_node_disk_rebalance_interval_sec, advanced);
+
+DEFINE_int32(intra_node_disk_rebalance_threshold_pct, 20,
+             "Data root dirs are rebalanced when the bytes stored in the least loaded dir are "
+             "lower than in the most loaded one by more than this percentage.");
+TAG_FLAG(intra_node_disk_rebalance_threshold_pct, advanced);
+TAG_FLAG(intra_node_disk_rebalance_threshold_pct, runtime);
+
+DECLARE_int32(memstore_arena_size_kb);
+
+METRIC_DECLARE_counter(block_cache_hits_caching);
+METRIC_DECLARE_counter(block_cache_misses_caching);
+
 namespace yb {
 namespace tserver {
 
@@ -249,6 +332,16 @@ METRIC_DEFINE_histogram(server, op_read_run_time, "Operation Read op Run Time",
                             "that operations consist of very large batches.",
                         10000000, 2);
 
+METRIC_DEFINE_gauge_int64(server, block_cache_budget, "Block Cache Budget",
+                          MetricUnit::kBytes,
+                          "Capacity of the shared block cache set by the memory rebalancer.");
+METRIC_DEFINE_gauge_int64(server, memstore_budget, "Global Memstore Budget",
+                          MetricUnit::kBytes,
+                          "Global memstore limit set by the memory rebalancer.");
+METRIC_DEFINE_gauge_int64(server, log_cache_budget, "Log Cache Budget",
+                          MetricUnit::kBytes,
+                          "Server wide log cache limit set by the memory rebalancer.");
+
 METRIC_DEFINE_histogram(server, ts_bootstrap_time, "TServer Bootstrap Time",
                         MetricUnit::kMicroseconds,
                         "Time that the tablet server takes to bootstrap all of its tablets.",
@@ -297,6 +390,7 @@ void TSTabletManager::MaybeFlushTablet() {
     // we will schedule a second flush, which will unnecessarily stall writes for a short time. This
     // will not happen often, but should be fixed.
     if (tablet_to_flush) {
+      num_memstore_limit_flushes_.fetch_add(1, std::memory_order_release);
       LOG(INFO)
           << TabletLogPrefix(tablet_to_flush->tablet_id())
           << "Flushing tablet with oldest memstore write at "
@@ -312,28 +406,247 @@ void TSTabletManager::MaybeFlushTablet() {
   }
 }
 
+void TSTabletManager::HibernateIdleTablets() {
+  const auto idle_timeout = MonoDelta::FromSeconds(FLAGS_tablet_hibernation_idle_timeout_sec);
+  for (const auto& peer : GetTabletPeers()) {
+    if (peer->state() != RUNNING) {
+      continue;
+    }
+    const auto tablet = peer->shared_tablet();
+    if (!tablet || tablet->IsHibernated() || tablet->transaction_participant() ||
+        tablet->transaction_coordinator() || tablet->IdleTime() < idle_timeout) {
+      continue;
+    }
+    auto status = tablet->Hibernate();
+    if (!status.ok()) {
+      LOG(WARNING) << TabletLogPrefix(peer->tablet_id()) << "Failed to hibernate: " << status;
+    }
+  }
+}
+
+void TSTabletManager::PersistHotKeys() {
+  for (const auto& peer : GetTabletPeers()) {
+    if (peer->state() != RUNNING) {
+      continue;
+    }
+    const auto tablet = peer->shared_tablet();
+    if (!tablet) {
+      continue;
+    }
+    auto status = tablet->PersistHotKeys();
+    if (!status.ok()) {
+      LOG(WARNING) << TabletLogPrefix(peer->tablet_id()) << "Failed to persist hot keys: "
+                   << status;
+    }
+  }
+}
+
+void TSTabletManager::ComputeDriveLoads(DriveLoadMap* data_loads, DriveLoadMap* wal_loads) {
+  // Samples taken more often are not precise enough to update rates.
+  const auto kMinSampleInterval = std::chrono::seconds(1);
+  const auto now = CoarseMonoClock::Now();
+  std::lock_guard<std::mutex> lock(write_samples_mutex_);
+  std::unordered_map<TabletId, TabletWriteSample> new_samples;
+  for (const auto& peer : GetTabletPeers()) {
+    const auto tablet = peer->shared_tablet();
+    const auto& meta = peer->tablet_metadata();
+    if (!tablet || !meta || meta->table_id() == master::kSysCatalogTableId) {
+      continue;
+    }
+    TabletWriteSample sample;
+    sample.time = now;
+    const auto& statistics = tablet->rocksdb_statistics();
+    if (statistics) {
+      sample.data_bytes = statistics->getTickerCount(rocksdb::FLUSH_WRITE_BYTES) +
+                          statistics->getTickerCount(rocksdb::COMPACT_WRITE_BYTES);
+    }
+    auto* log = peer->log_available() ? peer->log() : nullptr;
+    sample.wal_bytes = log ? log->BytesLogged() : 0;
+
+    auto it = write_samples_.find(peer->tablet_id());
+    // RocksDB of a hibernated tablet is closed, so its size from before hibernation is used.
+    if (!tablet->IsHibernated() || it == write_samples_.end()) {
+      sample.sst_files_size = tablet->GetCurrentVersionSstFilesSize();
+    } else {
+      sample.sst_files_size = it->second.sst_files_size;
+    }
+    if (it != write_samples_.end()) {
+      const auto& previous = it->second;
+      if (now - previous.time < kMinSampleInterval) {
+        sample.time = previous.time;
+        sample.data_bytes = previous.data_bytes;
+        sample.wal_bytes = previous.wal_bytes;
+        sample.data_write_rate = previous.data_write_rate;
+        sample.wal_write_rate = previous.wal_write_rate;
+      } else {
+        // Counters start over when the tablet is replaced, e.g. by remote bootstrap.
+        const auto interval = ToSeconds(now - previous.time);
+        sample.data_write_rate = sample.data_bytes >= previous.data_bytes
+            ? (sample.data_bytes - previous.data_bytes) / interval : previous.data_write_rate;
+        sample.wal_write_rate = sample.wal_bytes >= previous.wal_bytes
+            ? (sample.wal_bytes - previous.wal_bytes) / interval : previous.wal_write_rate;
+      }
+    }
+    new_samples.emplace(peer->tablet_id(), sample);
+
+    auto& data_load = (*data_loads)[meta->data_root_dir()];
+    data_load.bytes += sample.sst_files_size;
+    data_load.write_rate += sample.data_write_rate;
+    auto& wal_load = (*wal_loads)[meta->wal_root_dir()];
+    wal_load.bytes += log ? log->OnDiskSize() : 0;
+    wal_load.write_rate += sample.wal_write_rate;
+  }
+  // Also drops samples of deleted tablets.
+  write_samples_.swap(new_samples);
+}
+
+std::string TSTabletManager::LeastLoadedDir(
+    const std::unordered_map<std::string, std::unordered_set<std::string>>& table_assignment,
+    const DriveLoadMap& loads) {
+  DriveLoad total;
+  for (const auto& entry : loads) {
+    total.bytes += entry.second.bytes;
+    total.write_rate += entry.second.write_rate;
+  }
+  // Bytes and write rate have the same weight, each normalized by its total over all dirs.
+  auto score = [&loads, &total](const std::string& dir) {
+    auto it = loads.find(dir);
+    if (it == loads.end()) {
+      return 0.0;
+    }
+    double result = 0;
+    if (total.bytes) {
+      result += static_cast<double>(it->second.bytes) / total.bytes;
+    }
+    if (total.write_rate > 0) {
+      result += it->second.write_rate / total.write_rate;
+    }
+    return result;
+  };
+
+  std::string min_dir;
+  double min_dir_score = std::numeric_limits<double>::max();
+  uint64_t min_dir_count = kuint64max;
+  for (const auto& entry : table_assignment) {
+    const auto dir_score = score(entry.first);
+    if (dir_score < min_dir_score ||
+        (dir_score == min_dir_score && entry.second.size() < min_dir_count)) {
+      min_dir = entry.first;
+      min_dir_score = dir_score;
+      min_dir_count = entry.second.size();
+    }
+  }
+  return min_dir;
+}
+
+Status TSTabletManager::MoveTabletData(
+    const TabletId& tablet_id, const std::string& data_root_dir) {
+  auto data_root_dirs = fs_manager_->GetDataRootDirs();
+  if (std::find(data_root_dirs.begin(), data_root_dirs.end(), data_root_dir) ==
+          data_root_dirs.end()) {
+    return STATUS(InvalidArgument, "Unknown data root dir", data_root_dir);
+  }
+  TabletPeerPtr peer;
+  if (!LookupTablet(tablet_id, &peer)) {
+    return STATUS(NotFound, "Tablet not found", tablet_id);
+  }
+  const auto tablet = peer->shared_tablet();
+  if (!tablet || peer->state() != RUNNING) {
+    return STATUS_FORMAT(IllegalState, "Tablet $0 is not running", tablet_id);
+  }
+  const auto& meta = peer->tablet_metadata();
+  const auto old_data_root_dir = meta->data_root_dir();
+  if (old_data_root_dir == data_root_dir) {
+    return Status::OK();
+  }
+
+  RETURN_NOT_OK(tablet->MoveRocksDB(data_root_dir));
+  UnregisterDataWalDir(meta->table_id(), tablet_id, meta->table_type(), old_data_root_dir,
+                       meta->wal_root_dir());
+  RegisterDataAndWalDir(fs_manager_, meta->table_id(), tablet_id, meta->table_type(),
+                        data_root_dir, meta->wal_root_dir());
+  return Status::OK();
+}
+
+void TSTabletManager::RebalanceDataDirs() {
+  DriveLoadMap data_loads;
+  DriveLoadMap wal_loads;
+  for (const auto& dir : fs_manager_->GetDataRootDirs()) {
+    data_loads[dir];
+  }
+  ComputeDriveLoads(&data_loads, &wal_loads);
+  if (data_loads.size() < 2) {
+    return;
+  }
+  auto compare_bytes = [](const auto& lhs, const auto& rhs) {
+    return lhs.second.bytes < rhs.second.bytes;
+  };
+  const auto min_it = std::min_element(data_loads.begin(), data_loads.end(), compare_bytes);
+  const auto max_it = std::max_element(data_loads.begin(), data_loads.end(), compare_bytes);
+  const auto difference = max_it->second.bytes - min_it->second.bytes;
+  if (difference * 100 <= max_it->second.bytes * FLAGS_intra_node_disk_rebalance_threshold_pct) {
+    return;
+  }
+
+  // Moving a tablet of half of the difference equalizes the dirs, a tablet of the whole
+  // difference or larger would not reduce it.
+  TabletId best_tablet_id;
+  uint64_t best_distance = difference / 2;
+  for (const auto& peer : GetTabletPeers()) {
+    const auto tablet = peer->shared_tablet();
+    const auto& meta = peer->tablet_metadata();
+    if (!tablet || peer->state() != RUNNING || meta->data_root_dir() != max_it->first ||
+        meta->table_id() == master::kSysCatalogTableId) {
+      continue;
+    }
+    const auto size = tablet->GetCurrentVersionSstFilesSize();
+    if (size == 0 || size >= difference) {
+      continue;
+    }
+    const auto distance = size > difference / 2 ? size - difference / 2 : difference / 2 - size;
+    if (distance < best_distance) {
+      best_tablet_id = peer->tablet_id();
+      best_distance = distance;
+    }
+  }
+  if (best_tablet_id.empty()) {
+    return;
+  }
+
+  LOG(INFO) << TabletLogPrefix(best_tablet_id) << "Moving from data dir " << max_it->first
+            << " storing " << max_it->second.bytes << " bytes to " << min_it->first
+            << " storing " << min_it->second.bytes << " bytes";
+  auto status = MoveTabletData(best_tablet_id, min_it->first);
+  if (!status.ok()) {
+    LOG(WARNING) << TabletLogPrefix(best_tablet_id) << "Failed to move: " << status;
+  }
+}
+
 // Return the tablet with the oldest write in memstore, or nullptr if all tablet memstores are
 // empty or about to flush.
 TabletPeerPtr TSTabletManager::TabletToFlush() {
-  SharedLock<RWMutex> lock(lock_); // For using the tablet map
-  HybridTime oldest_write_in_memstores = HybridTime::kMax;
   TabletPeerPtr tablet_to_flush;
-  for (const TabletMap::value_type& entry : tablet_map_) {
-    const auto tablet = entry.second->shared_tablet();
-    if (tablet) {
-      const auto ht = tablet->OldestMutableMemtableWriteHybridTime();
-      if (ht.ok()) {
-        if (*ht < oldest_write_in_memstores) {
-          oldest_write_in_memstores = *ht;
-          tablet_to_flush = entry.second;
-        }
-      } else {
-        YB_LOG_EVERY_N_SECS(WARNING, 5) << Format(
-            "Failed to get oldest mutable memtable write ht for tablet $0: $1",
-            tablet->tablet_id(), ht.status());
-      }
+  memstore_write_index_.Oldest([this, &tablet_to_flush](const TabletId& tablet_id) {
+    TabletPeerPtr peer;
+    if (!LookupTablet(tablet_id, &peer)) {
+      return HybridTime::kMax;
     }
-  }
+    const auto tablet = peer->shared_tablet();
+    if (!tablet) {
+      return HybridTime::kMax;
+    }
+    // Reset before reading the actual value, so a concurrent write would update the index.
+    tablet->ResetMemtableWriteReported();
+    const auto ht = tablet->OldestMutableMemtableWriteHybridTime();
+    if (!ht.ok()) {
+      YB_LOG_EVERY_N_SECS(WARNING, 5) << Format(
+          "Failed to get oldest mutable memtable write ht for tablet $0: $1",
+          tablet_id, ht.status());
+      return HybridTime::kMax;
+    }
+    tablet_to_flush = peer;
+    return *ht;
+  });
   return tablet_to_flush;
 }
 
@@ -421,6 +734,7 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
                .set_max_queue_size(FLAGS_read_pool_max_queue_size)
                .set_metrics(std::move(read_metrics))
                .Build(&read_pool_));
+  read_scheduler_ = std::make_unique<ReadScheduler>(read_pool_.get());
 
   int64_t block_cache_size_bytes = FLAGS_db_block_cache_size_bytes;
   int64_t total_ram_avail = MemTracker::GetRootTracker()->limit();
@@ -445,6 +759,19 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
     tablet_options_.block_cache->SetMetrics(server_->metric_entity());
     block_based_table_gc_ = std::make_shared<LRUCacheGC>(tablet_options_.block_cache);
     block_based_table_mem_tracker_->AddGarbageCollector(block_based_table_gc_);
+
+    if (!FLAGS_db_persistent_cache_path.empty() && FLAGS_db_persistent_cache_size_bytes > 0) {
+      auto status = rocksdb::NewPersistentCache(
+          tablet_options_.rocksdb_env, FLAGS_db_persistent_cache_path,
+          FLAGS_db_persistent_cache_size_bytes, FLAGS_db_persistent_cache_file_size_bytes,
+          &tablet_options_.persistent_cache);
+      if (status.ok()) {
+        tablet_options_.persistent_cache->SetMetrics(server_->metric_entity());
+      } else {
+        LOG(WARNING) << "Failed to create persistent block cache in "
+                     << FLAGS_db_persistent_cache_path << ": " << status;
+      }
+    }
   }
 
   auto log_cache_mem_tracker = consensus::LogCache::GetServerMemTracker(server_->mem_tracker());
@@ -466,6 +793,12 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
                                    static_cast<size_t>(FLAGS_global_memstore_size_mb_max << 20));
   }
 
+  if (FLAGS_memstore_arena_pool_max_idle_mb > 0) {
+    tablet_options_.memtable_arena_block_pool = std::make_shared<rocksdb::ArenaBlockPool>(
+        FLAGS_memstore_arena_size_kb * 1_KB, FLAGS_memstore_arena_pool_max_idle_mb * 1_MB,
+        MemTracker::FindOrCreateTracker("MemTableArenaPool", server_->mem_tracker()));
+  }
+
   // Add memory monitor and background thread for flushing
   if (should_count_memory) {
     background_task_.reset(new BackgroundTask(
@@ -478,6 +811,115 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
         std::function<void()>([this](){
                                 YB_WARN_NOT_OK(background_task_->Wake(), "Wakeup error"); }));
   }
+
+  if (FLAGS_memory_rebalancer_interval_ms > 0) {
+    InitMemoryRebalancer(log_cache_mem_tracker);
+  }
+
+  if (FLAGS_intra_node_disk_rebalance_interval_sec > 0) {
+    data_dir_rebalance_task_ = std::make_unique<BackgroundTask>(
+        [this]() { RebalanceDataDirs(); },
+        "tablet manager",
+        "data dir rebalancer",
+        std::chrono::milliseconds(
+            std::chrono::seconds(FLAGS_intra_node_disk_rebalance_interval_sec)));
+  }
+
+  if (FLAGS_hot_keys_persist_interval_sec > 0) {
+    hot_keys_persist_task_ = std::make_unique<BackgroundTask>(
+        [this]() { PersistHotKeys(); },
+        "tablet manager",
+        "hot keys persist",
+        std::chrono::milliseconds(std::chrono::seconds(FLAGS_hot_keys_persist_interval_sec)));
+  }
+
+  if (FLAGS_tablet_hibernation_idle_timeout_sec > 0) {
+    // Checks a few times per timeout, so tablets are hibernated soon after they become idle.
+    hibernation_task_ = std::make_unique<BackgroundTask>(
+        [this]() { HibernateIdleTablets(); },
+        "tablet manager",
+        "hibernation",
+        std::max<std::chrono::milliseconds>(
+            std::chrono::milliseconds(
+                std::chrono::seconds(FLAGS_tablet_hibernation_idle_timeout_sec)) / 10,
+            std::chrono::seconds(1)));
+  }
+}
+
+void TSTabletManager::InitMemoryRebalancer(const MemTrackerPtr& log_cache_mem_tracker) {
+  const auto& metric_entity = server_->metric_entity();
+  std::vector<MemoryConsumer> consumers;
+
+  if (tablet_options_.block_cache) {
+    auto cache = tablet_options_.block_cache;
+    auto hits = METRIC_block_cache_hits_caching.Instantiate(metric_entity);
+    auto misses = METRIC_block_cache_misses_caching.Instantiate(metric_entity);
+    consumers.push_back(MemoryConsumer {
+      "block cache",
+      static_cast<int64_t>(cache->GetCapacity()),
+      // Miss ratio of lookups since the previous decision.
+      [hits, misses, last_hits = hits->value(), last_misses = misses->value()]() mutable {
+        auto new_hits = hits->value() - last_hits;
+        auto new_misses = misses->value() - last_misses;
+        last_hits += new_hits;
+        last_misses += new_misses;
+        return new_hits + new_misses > 0 ? new_misses * 1.0 / (new_hits + new_misses) : 0.0;
+      },
+      [cache, tracker = block_based_table_mem_tracker_](int64_t budget) {
+        cache->SetCapacity(budget);
+        tracker->SetLimit(budget);
+      },
+      METRIC_block_cache_budget.Instantiate(metric_entity, 0)
+    });
+  }
+
+  if (tablet_options_.memory_monitor) {
+    auto monitor = tablet_options_.memory_monitor;
+    consumers.push_back(MemoryConsumer {
+      "memstore",
+      static_cast<int64_t>(monitor->limit()),
+      // Flushes forced by the limit since the previous decision mean full pressure, otherwise
+      // pressure is the fraction of the limit in use.
+      [this, monitor, last_flushes = num_memstore_limit_flushes_.load()]() mutable {
+        auto flushes = num_memstore_limit_flushes_.load(std::memory_order_acquire);
+        if (flushes != last_flushes) {
+          last_flushes = flushes;
+          return 1.0;
+        }
+        return monitor->limit() ? monitor->memory_usage() * 1.0 / monitor->limit() : 0.0;
+      },
+      [this, monitor](int64_t budget) {
+        monitor->SetLimit(budget);
+        if (monitor->Exceeded()) {
+          YB_WARN_NOT_OK(background_task_->Wake(), "Wakeup error");
+        }
+      },
+      METRIC_memstore_budget.Instantiate(metric_entity, 0)
+    });
+  }
+
+  if (log_cache_mem_tracker->has_limit()) {
+    consumers.push_back(MemoryConsumer {
+      "log cache",
+      log_cache_mem_tracker->limit(),
+      // Log cache evicts entries once its limit is reached, so pressure is the fraction in use.
+      [log_cache_mem_tracker]() {
+        auto limit = log_cache_mem_tracker->limit();
+        return limit ? log_cache_mem_tracker->consumption() * 1.0 / limit : 0.0;
+      },
+      [log_cache_mem_tracker](int64_t budget) {
+        log_cache_mem_tracker->SetLimit(budget);
+      },
+      METRIC_log_cache_budget.Instantiate(metric_entity, 0)
+    });
+  }
+
+  memory_rebalancer_ = std::make_unique<MemoryRebalancer>(std::move(consumers), metric_entity);
+  memory_rebalancer_task_ = std::make_unique<BackgroundTask>(
+      [this]() { memory_rebalancer_->Rebalance(); },
+      "tablet manager",
+      "memory rebalancer",
+      std::chrono::milliseconds(FLAGS_memory_rebalancer_interval_ms));
 }
 
 TSTabletManager::~TSTabletManager() {
@@ -492,9 +934,19 @@ Status TSTabletManager::Init() {
       &server_->options(), server_->metric_entity(), server_->mem_tracker(),
       server_->messenger());
 
+  multi_raft_manager_ = std::make_unique<consensus::MultiRaftManager>(
+      server_->messenger(), &server_->proxy_cache());
+
+  final_status_cache_ = std::make_unique<tablet::FinalTransactionStatusCache>(
+      FLAGS_final_transaction_status_cache_size);
+
   tablet_options_.env = server_->GetEnv();
   tablet_options_.rocksdb_env = server_->GetRocksDBEnv();
   tablet_options_.listeners = server_->options().listeners;
+  tablet_options_.memtable_write_listener = [this](
+      const TabletId& tablet_id, HybridTime oldest_write) {
+    memstore_write_index_.Update(tablet_id, oldest_write);
+  };
 
   // Start the threadpool we'll use to open tablets.
   // This has to be done in Init() instead of the constructor, since the
@@ -569,6 +1021,22 @@ Status TSTabletManager::Init() {
     RETURN_NOT_OK(background_task_->Init());
   }
 
+  if (memory_rebalancer_task_) {
+    RETURN_NOT_OK(memory_rebalancer_task_->Init());
+  }
+
+  if (hibernation_task_) {
+    RETURN_NOT_OK(hibernation_task_->Init());
+  }
+
+  if (hot_keys_persist_task_) {
+    RETURN_NOT_OK(hot_keys_persist_task_->Init());
+  }
+
+  if (data_dir_rebalance_task_) {
+    RETURN_NOT_OK(data_dir_rebalance_task_->Init());
+  }
+
   return Status::OK();
 }
 
@@ -1141,7 +1609,9 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
                                          tablet->GetMetricEntity(),
                                          raft_pool(),
                                          tablet_prepare_pool(),
-                                         &retryable_requests);
+                                         &retryable_requests,
+                                         multi_raft_manager_.get(),
+                                         final_status_cache_.get());
 
     if (!s.ok()) {
       LOG(ERROR) << kLogPrefix << "Tablet failed to init: "
@@ -1160,6 +1630,11 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
     }
 
     tablet_peer->RegisterMaintenanceOps(server_->maintenance_manager());
+
+    auto tablet = tablet_peer->shared_tablet();
+    if (tablet) {
+      tablet->WarmUpBlockCacheFromPersistedKeys();
+    }
   }
 
   int elapsed_ms = MonoTime::Now().GetDeltaSince(start).ToMilliseconds();
@@ -1179,6 +1654,22 @@ void TSTabletManager::StartShutdown() {
     background_task_->Shutdown();
   }
 
+  if (memory_rebalancer_task_) {
+    memory_rebalancer_task_->Shutdown();
+  }
+
+  if (hibernation_task_) {
+    hibernation_task_->Shutdown();
+  }
+
+  if (hot_keys_persist_task_) {
+    hot_keys_persist_task_->Shutdown();
+  }
+
+  if (data_dir_rebalance_task_) {
+    data_dir_rebalance_task_->Shutdown();
+  }
+
   {
     std::lock_guard<RWMutex> lock(lock_);
     switch (state_) {
@@ -1503,7 +1994,7 @@ void TSTabletManager::CreateReportedTabletPB(const TabletPeerPtr& tablet_peer,
 
 void TSTabletManager::GenerateIncrementalTabletReport(TabletReportPB* report) {
   report->Clear();
-  report->set_is_incremental(true);
+  const int32_t limit = FLAGS_tablet_report_limit;
   // Creating the tablet report can be slow in the case that it is in the
   // middle of flushing its consensus metadata. We don't want to hold
   // lock_ for too long, even in read mode, since it can cause other readers
@@ -1513,13 +2004,22 @@ void TSTabletManager::GenerateIncrementalTabletReport(TabletReportPB* report) {
   vector<std::string> tablet_ids;
   {
     SharedLock<RWMutex> shared_lock(lock_);
-    tablet_ids.reserve(dirty_tablets_.size() + tablets_being_remote_bootstrapped_.size());
-    to_report.reserve(dirty_tablets_.size() + tablets_being_remote_bootstrapped_.size());
+    // Parts of a full report that did not fit into a single report are sent as non-incremental
+    // reports, so the master knows that the full report is not complete yet.
+    report->set_is_incremental(!sending_full_report_);
+    const size_t num_dirty =
+        limit > 0 ? std::min<size_t>(dirty_tablets_.size(), limit) : dirty_tablets_.size();
+    tablet_ids.reserve(num_dirty + tablets_being_remote_bootstrapped_.size());
+    to_report.reserve(num_dirty + tablets_being_remote_bootstrapped_.size());
     report->set_sequence_number(next_report_seq_++);
     for (const DirtyMap::value_type& dirty_entry : dirty_tablets_) {
+      if (tablet_ids.size() == num_dirty) {
+        break;
+      }
       const string& tablet_id = dirty_entry.first;
       tablet_ids.push_back(tablet_id);
     }
+    report->set_remaining_tablet_count(dirty_tablets_.size() - num_dirty);
     for (auto const& tablet_id : tablets_being_remote_bootstrapped_) {
       tablet_ids.push_back(tablet_id);
     }
@@ -1541,25 +2041,17 @@ void TSTabletManager::GenerateIncrementalTabletReport(TabletReportPB* report) {
 }
 
 void TSTabletManager::GenerateFullTabletReport(TabletReportPB* report) {
-  report->Clear();
-  report->set_is_incremental(false);
-  // Creating the tablet report can be slow in the case that it is in the
-  // middle of flushing its consensus metadata. We don't want to hold
-  // lock_ for too long, even in read mode, since it can cause other readers
-  // to block if there is a waiting writer (see KUDU-2193). So, we just make
-  // a local copy of the set of replicas.
-  vector<std::shared_ptr<TabletPeer>> to_report;
+  // All tablets are marked as dirty, so the full report could be sent in several parts, in the
+  // same way as incremental reports are.
   {
-    SharedLock<RWMutex> shared_lock(lock_);
-    report->set_sequence_number(next_report_seq_++);
-    GetTabletPeersUnlocked(&to_report);
-  }
-  for (const auto& replica : to_report) {
-    CreateReportedTabletPB(replica, report->add_updated_tablets());
+    std::lock_guard<RWMutex> lock(lock_);
+    dirty_tablets_.clear();
+    for (const auto& entry : tablet_map_) {
+      dirty_tablets_[entry.first].change_seq = next_report_seq_;
+    }
+    sending_full_report_ = true;
   }
-
-  std::lock_guard<RWMutex> l(lock_);
-  dirty_tablets_.clear();
+  GenerateIncrementalTabletReport(report);
 }
 
 void TSTabletManager::MarkTabletReportAcknowledged(const TabletReportPB& report) {
@@ -1568,19 +2060,26 @@ void TSTabletManager::MarkTabletReportAcknowledged(const TabletReportPB& report)
   int32_t acked_seq = report.sequence_number();
   CHECK_LT(acked_seq, next_report_seq_);
 
-  // Clear the "dirty" state for any tablets which have not changed since
-  // this report.
-  auto it = dirty_tablets_.begin();
-  while (it != dirty_tablets_.end()) {
-    const TabletReportState& state = it->second;
-    if (state.change_seq <= acked_seq) {
+  // Clear the "dirty" state for reported tablets which have not changed since
+  // this report. Dirty tablets that did not fit into the report stay dirty.
+  auto mark_reported = [this, acked_seq](const std::string& tablet_id) {
+    auto it = dirty_tablets_.find(tablet_id);
+    if (it != dirty_tablets_.end() && it->second.change_seq <= acked_seq) {
       // This entry has not changed since this tablet report, we no longer need
       // to track it as dirty. If it becomes dirty again, it will be re-added
       // with a higher sequence number.
-      it = dirty_tablets_.erase(it);
-    } else {
-      ++it;
+      dirty_tablets_.erase(it);
     }
+  };
+  for (const auto& reported : report.updated_tablets()) {
+    mark_reported(reported.tablet_id());
+  }
+  for (const auto& tablet_id : report.removed_tablet_ids()) {
+    mark_reported(tablet_id);
+  }
+
+  if (!report.is_incremental() && report.remaining_tablet_count() == 0) {
+    sending_full_report_ = false;
   }
 }
 
@@ -1636,6 +2135,12 @@ void TSTabletManager::GetAndRegisterDataAndWalDir(FsManager* fs_manager,
   }
   LOG(INFO) << "Get and update data/wal directory assignment map for table: " \
             << table_id << " and tablet " << tablet_id;
+  DriveLoadMap data_loads;
+  DriveLoadMap wal_loads;
+  if (FLAGS_tablet_placement_drive_load_aware) {
+    // Computed before acquiring dir_assignment_lock_, since it iterates the tablet peers.
+    ComputeDriveLoads(&data_loads, &wal_loads);
+  }
   MutexLock l(dir_assignment_lock_);
   // Initialize the map if the directory mapping does not exist.
   auto data_root_dirs = fs_manager->GetDataRootDirs();
@@ -1647,25 +2152,16 @@ void TSTabletManager::GetAndRegisterDataAndWalDir(FsManager* fs_manager,
       table_data_assignment_map_[table_id][data_root_iter] = tablet_id_set;
     }
   }
-  // Find the data directory with the least count of tablets for this table.
+  // Find the least loaded data directory, or the one with the least count of tablets for this
+  // table when loads are not used.
   table_data_assignment_iter = table_data_assignment_map_.find(table_id);
-  auto data_assignment_value_map = table_data_assignment_iter->second;
-  string min_dir;
-  uint64_t min_dir_count = kuint64max;
-  for (auto it = data_assignment_value_map.begin(); it != data_assignment_value_map.end(); ++it) {
-    if (min_dir_count > it->second.size()) {
-      min_dir = it->first;
-      min_dir_count = it->second.size();
-    }
-  }
+  string min_dir = LeastLoadedDir(table_data_assignment_iter->second, data_loads);
   *data_root_dir = min_dir;
   // Increment the count for min_dir.
   auto data_assignment_value_iter = table_data_assignment_map_[table_id].find(min_dir);
   data_assignment_value_iter->second.insert(tablet_id);
 
-  // Find the wal directory with the least count of tablets for this table.
-  min_dir = "";
-  min_dir_count = kuint64max;
+  // Same for the wal directory.
   auto wal_root_dirs = fs_manager->GetWalRootDirs();
   CHECK(!wal_root_dirs.empty()) << "No wal root directories found";
   auto table_wal_assignment_iter = table_wal_assignment_map_.find(table_id);
@@ -1676,13 +2172,7 @@ void TSTabletManager::GetAndRegisterDataAndWalDir(FsManager* fs_manager,
     }
   }
   table_wal_assignment_iter = table_wal_assignment_map_.find(table_id);
-  auto wal_assignment_value_map = table_wal_assignment_iter->second;
-  for (auto it = wal_assignment_value_map.begin(); it != wal_assignment_value_map.end(); ++it) {
-    if (min_dir_count > it->second.size()) {
-      min_dir = it->first;
-      min_dir_count = it->second.size();
-    }
-  }
+  min_dir = LeastLoadedDir(table_wal_assignment_iter->second, wal_loads);
   *wal_root_dir = min_dir;
   auto wal_assignment_value_iter = table_wal_assignment_map_[table_id].find(min_dir);
   wal_assignment_value_iter->second.insert(tablet_id);
@@ -1872,7 +2362,7 @@ Status DeleteTabletData(const RaftGroupMetadataPtr& meta,
   MAYBE_FAULT(FLAGS_fault_crash_after_blocks_deleted);
 
   RETURN_NOT_OK(Log::DeleteOnDiskData(
-      meta->fs_manager()->env(), meta->raft_group_id(), meta->wal_dir(),
+      meta->fs_manager(), meta->raft_group_id(), meta->wal_dir(),
       meta->fs_manager()->uuid()));
   MAYBE_FAULT(FLAGS_fault_crash_after_wal_deleted);
 
@@ -32,7 +32,9 @@
 #ifndef YB_TSERVER_TS_TABLET_MANAGER_H
 #define YB_TSERVER_TS_TABLET_MANAGER_H
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -53,6 +55,8 @@
 #include "yb/gutil/macros.h"
 #include "yb/gutil/ref_counted.h"
 #include "yb/tablet/tablet_fwd.h"
+#include "yb/tserver/memstore_write_index.h"
+#include "yb/tserver/read_scheduler.h"
 #include "yb/tserver/tablet_peer_lookup.h"
 #include "yb/tserver/tserver.pb.h"
 #include "yb/tserver/tserver_admin.pb.h"
@@ -84,6 +88,7 @@ class TabletReportPB;
 } // namespace master
 
 namespace tserver {
+class MemoryRebalancer;
 class TabletServer;
 class TsTabletManagerListener {
  public:
@@ -146,6 +151,8 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   ThreadPool* tablet_prepare_pool() const { return tablet_prepare_pool_.get(); }
   ThreadPool* raft_pool() const { return raft_pool_.get(); }
   ThreadPool* read_pool() const { return read_pool_.get(); }
+
+  ReadScheduler* read_scheduler() const { return read_scheduler_.get(); }
   ThreadPool* append_pool() const { return append_pool_.get(); }
 
   // Create a new tablet and register it with the tablet manager. The new tablet
@@ -215,9 +222,15 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   //
   // This is thread-safe to call along with tablet modification, but not safe
   // to call from multiple threads at the same time.
+  //
+  // At most tablet_report_limit tablets are included into the report, and the number of tablets
+  // left for the following reports is stored in its remaining_tablet_count.
   void GenerateIncrementalTabletReport(master::TabletReportPB* report);
 
   // Generate a full tablet report and reset any incremental state tracking.
+  // If not all tablets fit into the report, the following reports generated by
+  // GenerateIncrementalTabletReport() are also non-incremental, until the full report is
+  // acknowledged by the master.
   void GenerateFullTabletReport(master::TabletReportPB* report);
 
   // Mark that the master successfully received and processed the given
@@ -295,6 +308,20 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   // Flush some tablet if the memstore memory limit is exceeded
   void MaybeFlushTablet();
 
+  // Hibernate tablets that were idle for longer than tablet_hibernation_idle_timeout_sec.
+  void HibernateIdleTablets();
+
+  // Persists recently read keys of all running tablets, see Tablet::PersistHotKeys.
+  void PersistHotKeys();
+
+  // Moves RocksDB of the tablet to the given data root dir while the tablet stays online, see
+  // Tablet::MoveRocksDB.
+  CHECKED_STATUS MoveTabletData(const TabletId& tablet_id, const std::string& data_root_dir);
+
+  // Moves a tablet from the data root dir storing the most bytes to the one storing the least,
+  // if they differ by more than intra_node_disk_rebalance_threshold_pct.
+  void RebalanceDataDirs();
+
   client::YBClient& client();
 
   tablet::TabletOptions* TEST_tablet_options() { return &tablet_options_; }
@@ -416,6 +443,9 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
 
   void LogCacheGC(MemTracker* log_cache_mem_tracker, size_t required);
 
+  // Creates the rebalancer of block cache, memstore and log cache budgets.
+  void InitMemoryRebalancer(const MemTrackerPtr& log_cache_mem_tracker);
+
   const CoarseTimePoint start_time_;
 
   FsManager* const fs_manager_;
@@ -431,8 +461,35 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
                              std::unordered_map<std::string, std::unordered_set<std::string>>>
     TableDiskAssignmentMap;
 
-  // Lock protecting tablet_map_, dirty_tablets_, state_, transition_in_progress_, and
-  // tablets_being_remote_bootstrapped_.
+  // Load of a data or WAL root dir, summed over the tablets in the dir.
+  struct DriveLoad {
+    uint64_t bytes = 0;
+    // Bytes written per second.
+    double write_rate = 0;
+  };
+  typedef std::unordered_map<std::string, DriveLoad> DriveLoadMap;
+
+  // Bytes written by a tablet at the time of the last sample, used to compute write rates.
+  struct TabletWriteSample {
+    CoarseTimePoint time;
+    uint64_t data_bytes = 0;
+    uint64_t wal_bytes = 0;
+    uint64_t sst_files_size = 0;
+    double data_write_rate = 0;
+    double wal_write_rate = 0;
+  };
+
+  // Computes loads of data and WAL root dirs from the tablets in them.
+  void ComputeDriveLoads(DriveLoadMap* data_loads, DriveLoadMap* wal_loads);
+
+  // Returns the dir with the lowest load, breaking ties by the number of tablets of the table that
+  // are assigned to the dir.
+  static std::string LeastLoadedDir(
+      const std::unordered_map<std::string, std::unordered_set<std::string>>& table_assignment,
+      const DriveLoadMap& loads);
+
+  // Lock protecting tablet_map_, dirty_tablets_, sending_full_report_, state_,
+  // transition_in_progress_, and tablets_being_remote_bootstrapped_.
   mutable RWMutex lock_;
 
   // Map from tablet ID to tablet
@@ -443,6 +500,9 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   TableDiskAssignmentMap table_wal_assignment_map_;
   mutable Mutex dir_assignment_lock_;
 
+  std::mutex write_samples_mutex_;
+  std::unordered_map<TabletId, TabletWriteSample> write_samples_;
+
   // Map of tablet ids -> reason strings where the keys are tablets whose
   // bootstrap, creation, or deletion is in-progress
   TransitionInProgressMap transition_in_progress_;
@@ -457,6 +517,9 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   // Next tablet report seqno.
   int32_t next_report_seq_;
 
+  // Whether a full tablet report, that did not fit into a single report, is being sent.
+  bool sending_full_report_ = false;
+
   MetricRegistry* metric_registry_;
 
   TSTabletManagerStatePB state_;
@@ -476,12 +539,36 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   // Thread pool for appender threads, shared between all tablets.
   std::unique_ptr<ThreadPool> append_pool_;
 
+  // Runs scans on read_pool_, fairly across tablets. Declared before read_pool_, so it outlives
+  // tasks running on the pool.
+  std::unique_ptr<ReadScheduler> read_scheduler_;
+
   // Thread pool for read ops, that are run in parallel, shared between all tablets.
   std::unique_ptr<ThreadPool> read_pool_;
 
   // Used for scheduling flushes
   std::unique_ptr<BackgroundTask> background_task_;
 
+  // Tablets ordered by the oldest write in their memstores, used to pick the tablet to flush when
+  // the global memstore limit is reached.
+  MemstoreWriteIndex memstore_write_index_;
+
+  // Number of flushes scheduled because the global memstore limit was reached.
+  std::atomic<uint64_t> num_memstore_limit_flushes_{0};
+
+  // Periodically shifts memory budget between the block cache, memstore and log cache.
+  std::unique_ptr<MemoryRebalancer> memory_rebalancer_;
+  std::unique_ptr<BackgroundTask> memory_rebalancer_task_;
+
+  // Periodically closes RocksDB of idle tablets, see Tablet::Hibernate.
+  std::unique_ptr<BackgroundTask> hibernation_task_;
+
+  // Periodically persists recently read keys of tablets, see PersistHotKeys.
+  std::unique_ptr<BackgroundTask> hot_keys_persist_task_;
+
+  // Periodically moves tablets between data root dirs of this server, see RebalanceDataDirs.
+  std::unique_ptr<BackgroundTask> data_dir_rebalance_task_;
+
   // For block cache and memory monitor shared across tablets
   tablet::TabletOptions tablet_options_;
 
@@ -494,6 +581,12 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
 
   std::shared_ptr<MemTracker> block_based_table_mem_tracker_;
 
+  // Batches Raft heartbeats of tablets hosted by this server, per destination server.
+  std::unique_ptr<consensus::MultiRaftManager> multi_raft_manager_;
+
+  // Final statuses of recently finished transactions, shared by participants of all tablets.
+  std::unique_ptr<tablet::FinalTransactionStatusCache> final_status_cache_;
+
   DISALLOW_COPY_AND_ASSIGN(TSTabletManager);
 };
 
@@ -34,6 +34,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -42,12 +43,15 @@
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/quorum_util.h"
+#include "yb/docdb/doc_key.h"
 #include "yb/gutil/map-util.h"
+#include "yb/gutil/stringprintf.h"
 #include "yb/gutil/strings/human_readable.h"
 #include "yb/gutil/strings/join.h"
 #include "yb/gutil/strings/numbers.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/server/webui_util.h"
+#include "yb/tablet/hot_keys_sampler.h"
 #include "yb/tablet/maintenance_manager.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet.pb.h"
@@ -56,6 +60,7 @@
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
+#include "yb/util/bytes_formatter.h"
 #include "yb/util/url-coding.h"
 
 namespace {
@@ -144,6 +149,8 @@ using std::shared_ptr;
 using std::vector;
 using strings::Substitute;
 
+DECLARE_int32(tablet_hot_keys_sample_rate);
+
 using namespace std::placeholders;  // NOLINT(build/namespaces)
 
 namespace {
@@ -208,7 +215,8 @@ void HandleTabletPage(
   std::initializer_list<std::array<const char*, 2>> entries = {
       {"tablet-consensus-status", "Consensus Status"},
       {"log-anchors", "Tablet Log Anchors"},
-      {"transactions", "Transactions"} };
+      {"transactions", "Transactions"},
+      {"tablet-hot-keys", "Hot Keys"} };
 
   auto encoded_tablet_id = UrlEncodeToString(tablet_id);
   for (const auto& entry : entries) {
@@ -264,6 +272,51 @@ void HandleTransactionsPage(
   *output << "Tablet is non transactional";
 }
 
+void HandleHotKeysPage(
+    const std::string& tablet_id, const tablet::TabletPeerPtr& peer,
+    const Webserver::WebRequest& req, std::stringstream* output) {
+  *output << "<h1>Hot Keys for Tablet " << EscapeForHtmlToString(tablet_id) << "</h1>"
+          << std::endl;
+
+  auto tablet = peer->shared_tablet();
+  auto* sampler = tablet ? tablet->hot_keys_sampler() : nullptr;
+  if (!sampler) {
+    *output << "Hot keys sampling is disabled";
+    return;
+  }
+
+  const auto total = sampler->total();
+  *output << "<p>Sampled " << total << " keys, one of every "
+          << FLAGS_tablet_hot_keys_sample_rate << " operations. Reads are accounted by their "
+          << "hash key, writes by their primary key.</p>" << std::endl;
+
+  *output << "<h2>Keys</h2>" << std::endl
+          << "<table class='table table-striped'>" << std::endl
+          << "  <tr><th>Key</th><th>Sampled Count</th><th>Max Error</th></tr>" << std::endl;
+  for (const auto& entry : sampler->TopKeys(std::numeric_limits<size_t>::max())) {
+    docdb::DocKey doc_key;
+    auto key_str = doc_key.FullyDecodeFrom(entry.key).ok()
+        ? doc_key.ToString() : FormatBytesAsStr(entry.key);
+    *output << Format("  <tr><td>$0</td><td>$1</td><td>$2</td></tr>",
+                      EscapeForHtmlToString(key_str), entry.count, entry.error)
+            << std::endl;
+  }
+  *output << "</table>" << std::endl;
+
+  *output << "<h2>Hash Ranges</h2>" << std::endl
+          << "<table class='table table-striped'>" << std::endl
+          << "  <tr><th>Hash Range Start</th><th>Sampled Count</th><th>Percent</th></tr>"
+          << std::endl;
+  const auto buckets = sampler->HashBucketCounts();
+  for (size_t i = 0; i != buckets.size(); ++i) {
+    *output << Format("  <tr><td>0x$0</td><td>$1</td><td>$2%</td></tr>",
+                      StringPrintf("%04X", sampler->HashBucketStart(i)), buckets[i],
+                      total ? buckets[i] * 100 / total : 0)
+            << std::endl;
+  }
+  *output << "</table>" << std::endl;
+}
+
 template<class F>
 void RegisterTabletPathHandler(
     Webserver* web_server, TabletServer* tserver, const std::string& path, const F& f) {
@@ -298,6 +351,7 @@ Status TabletServerPathHandlers::Register(Webserver* server) {
       server, tserver_, "/tablet-consensus-status", &HandleConsensusStatusPage);
   RegisterTabletPathHandler(server, tserver_, "/log-anchors", &HandleLogAnchorsPage);
   RegisterTabletPathHandler(server, tserver_, "/transactions", &HandleTransactionsPage);
+  RegisterTabletPathHandler(server, tserver_, "/tablet-hot-keys", &HandleHotKeysPage);
   server->RegisterPathHandler(
       "/", "Dashboards",
       std::bind(&TabletServerPathHandlers::HandleDashboardsPage, this, _1, _2), true /* styled */,
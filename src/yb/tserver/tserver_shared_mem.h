@@ -23,6 +23,13 @@
 namespace yb {
 namespace tserver {
 
+// Data published by the tablet server to the local postgres backends.
+//
+// The segment is created by the tablet server before postgres is started, and is inherited by
+// backends, that map it read-only. So it could be used only for data written by the tablet
+// server, and read by any backend. Transferring requests or per-backend results through shared
+// memory would require segments writable by backends and a wake up mechanism, and is not
+// supported.
 class TServerSharedData {
  public:
   TServerSharedData() {
@@ -0,0 +1,70 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <sstream>
+
+#include "yb/util/allocation_profiler.h"
+#include "yb/util/test_util.h"
+#include "yb/util/thread.h"
+
+DECLARE_int64(allocation_profiler_sample_interval_bytes);
+
+namespace yb {
+
+class AllocationProfilerTest : public YBTest {
+};
+
+namespace {
+
+void Allocate(AllocationProfiler* profiler) {
+  const std::string scope = "TestMethod";
+  ScopedAllocationScope allocation_scope(&scope);
+  for (int i = 0; i != 100; ++i) {
+    profiler->RecordAllocation(100);
+  }
+}
+
+} // namespace
+
+TEST_F(AllocationProfilerTest, AttributeToThreadAndScope) {
+  FLAGS_allocation_profiler_sample_interval_bytes = 1000;
+  AllocationProfiler profiler;
+  scoped_refptr<Thread> thread;
+  ASSERT_OK(Thread::Create("test_category", "allocator-1", &Allocate, &profiler, &thread));
+  ASSERT_OK(ThreadJoiner(thread.get()).Join());
+  // Allocations of a thread without a scope.
+  for (int i = 0; i != 20; ++i) {
+    profiler.RecordAllocation(100);
+  }
+
+  std::stringstream report;
+  profiler.WriteReport(MonoDelta::FromSeconds(60), &report);
+  LOG(INFO) << "Allocation report:\n" << report.str();
+  // 10000 bytes and 100 allocations sampled during less than a second, reported as rates per
+  // second, sorted by bytes.
+  ASSERT_STR_CONTAINS(report.str(), "10000 100 test_category;allocator- TestMethod\n");
+  ASSERT_STR_CONTAINS(report.str(), " none\n");
+  ASSERT_LT(report.str().find("TestMethod"), report.str().find("none"));
+
+  std::stringstream stacks;
+  profiler.WriteCollapsedStacks(MonoDelta::FromSeconds(60), &stacks);
+  LOG(INFO) << "Collapsed stacks:\n" << stacks.str();
+  ASSERT_STR_CONTAINS(stacks.str(), "test_category;allocator-;TestMethod;");
+
+  // Nothing was sampled in the future.
+  std::stringstream empty;
+  profiler.WriteReport(MonoDelta::FromSeconds(-120), &empty);
+  ASSERT_EQ("", empty.str());
+}
+
+} // namespace yb
@@ -0,0 +1,212 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/util/allocation_profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+#ifdef TCMALLOC_ENABLED
+#include <gperftools/malloc_hook.h>
+#endif
+
+#include "yb/util/continuous_profiler.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/thread.h"
+
+DEFINE_int64(allocation_profiler_sample_interval_bytes, 0,
+             "Average number of bytes allocated by a thread between stack samples of the "
+             "allocation profiler. 0 to disable the profiler.");
+TAG_FLAG(allocation_profiler_sample_interval_bytes, advanced);
+TAG_FLAG(allocation_profiler_sample_interval_bytes, runtime);
+
+DEFINE_int32(allocation_profiler_history_minutes, 10,
+             "For how many minutes samples of the allocation profiler are kept.");
+TAG_FLAG(allocation_profiler_history_minutes, advanced);
+TAG_FLAG(allocation_profiler_history_minutes, runtime);
+
+namespace yb {
+
+namespace {
+
+const auto kBucketDuration = std::chrono::minutes(1);
+
+// Per thread state of the profiler. Plain __thread variables are used, because they are accessed
+// from the allocation hook and must not allocate on first access.
+__thread uint64_t tls_bytes_since_sample = 0;
+__thread uint64_t tls_allocations_since_sample = 0;
+__thread const std::string* tls_scope = nullptr;
+// Set while the profiler itself allocates on this thread, so those allocations are ignored and
+// do not re-enter it.
+__thread bool tls_ignore_allocations = false;
+
+class IgnoreAllocations {
+ public:
+  IgnoreAllocations() : previous_(tls_ignore_allocations) {
+    tls_ignore_allocations = true;
+  }
+
+  ~IgnoreAllocations() {
+    tls_ignore_allocations = previous_;
+  }
+
+ private:
+  bool previous_;
+};
+
+#ifdef TCMALLOC_ENABLED
+void NewHook(const void* ptr, size_t size) {
+  AllocationProfiler::Instance()->RecordAllocation(size);
+}
+#endif
+
+} // namespace
+
+ScopedAllocationScope::ScopedAllocationScope(const std::string* name) : previous_(tls_scope) {
+  tls_scope = name;
+}
+
+ScopedAllocationScope::~ScopedAllocationScope() {
+  tls_scope = previous_;
+}
+
+size_t AllocationProfiler::StackKeyHash::operator()(const StackKey& key) const {
+  size_t result = std::hash<std::string>()(key.thread);
+  boost::hash_combine(result, key.scope);
+  boost::hash_combine(result, key.stack.HashCode());
+  return result;
+}
+
+AllocationProfiler::AllocationProfiler() = default;
+
+AllocationProfiler* AllocationProfiler::Instance() {
+  // Never destroyed, since allocations could happen during and after static destruction.
+  static AllocationProfiler* instance = new AllocationProfiler();
+  return instance;
+}
+
+Status AllocationProfiler::Start() {
+#ifdef TCMALLOC_ENABLED
+  static std::atomic<bool> hook_added{false};
+  // Instantiate the profiler before the hook could call it.
+  Instance();
+  bool expected = false;
+  if (hook_added.compare_exchange_strong(expected, true) && !MallocHook::AddNewHook(&NewHook)) {
+    return STATUS(RuntimeError, "Failed to add tcmalloc new hook");
+  }
+#endif
+  return Status::OK();
+}
+
+void AllocationProfiler::RecordAllocation(size_t size) {
+  if (tls_ignore_allocations) {
+    return;
+  }
+  const auto interval = FLAGS_allocation_profiler_sample_interval_bytes;
+  if (interval <= 0) {
+    return;
+  }
+  tls_bytes_since_sample += size;
+  ++tls_allocations_since_sample;
+  if (tls_bytes_since_sample < static_cast<uint64_t>(interval)) {
+    return;
+  }
+
+  IgnoreAllocations ignore_allocations;
+  Allocations allocations;
+  allocations.bytes = tls_bytes_since_sample;
+  allocations.count = tls_allocations_since_sample;
+  tls_bytes_since_sample = 0;
+  tls_allocations_since_sample = 0;
+
+  StackKey key;
+  // Skip this function and the allocation hook.
+  key.stack.Collect(/* skip_frames */ 2);
+  auto* thread = Thread::current_thread();
+  key.thread = thread ? ThreadGroupName(thread->category(), thread->name()) : "unknown;unknown";
+  key.scope = tls_scope ? *tls_scope : "none";
+  AddSample(std::move(key), allocations);
+}
+
+void AllocationProfiler::AddSample(StackKey key, const Allocations& allocations) {
+  const auto now = CoarseMonoClock::Now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (buckets_.empty() || buckets_.back().start + kBucketDuration <= now) {
+    buckets_.push_back(Bucket { now, StackSamples() });
+  }
+  const auto history = kBucketDuration * std::max(FLAGS_allocation_profiler_history_minutes, 1);
+  while (buckets_.front().start + history <= now) {
+    buckets_.pop_front();
+  }
+  buckets_.back().samples[std::move(key)] += allocations;
+}
+
+MonoDelta AllocationProfiler::CollectSamples(MonoDelta period, StackSamples* samples) const {
+  // Holding the mutex, allocations of this thread must not be sampled.
+  IgnoreAllocations ignore_allocations;
+  const auto now = CoarseMonoClock::Now();
+  auto since = now - period.ToSteadyDuration();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!buckets_.empty()) {
+    since = std::max(since, buckets_.front().start);
+  }
+  for (const auto& bucket : buckets_) {
+    if (bucket.start + kBucketDuration <= since) {
+      continue;
+    }
+    for (const auto& sample : bucket.samples) {
+      (*samples)[sample.first] += sample.second;
+    }
+  }
+  return MonoDelta(now - since);
+}
+
+void AllocationProfiler::WriteReport(MonoDelta period, std::ostream* out) const {
+  StackSamples samples;
+  const auto seconds = std::max(CollectSamples(period, &samples).ToSeconds(), 1.0);
+
+  std::map<std::pair<std::string, std::string>, Allocations> totals;
+  for (const auto& sample : samples) {
+    totals[std::make_pair(sample.first.thread, sample.first.scope)] += sample.second;
+  }
+  std::vector<std::pair<std::pair<std::string, std::string>, Allocations>> sorted(
+      totals.begin(), totals.end());
+  std::sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.second.bytes > rhs.second.bytes;
+  });
+  for (const auto& entry : sorted) {
+    *out << static_cast<uint64_t>(entry.second.bytes / seconds) << " "
+         << static_cast<uint64_t>(entry.second.count / seconds) << " "
+         << entry.first.first << " " << entry.first.second << "\n";
+  }
+}
+
+void AllocationProfiler::WriteCollapsedStacks(MonoDelta period, std::ostream* out) const {
+  StackSamples samples;
+  CollectSamples(period, &samples);
+
+  std::unordered_map<void*, std::string> frame_names;
+  for (const auto& sample : samples) {
+    *out << sample.first.thread << ";" << sample.first.scope;
+    const auto& stack = sample.first.stack;
+    for (int i = stack.num_frames(); i-- > 0;) {
+      *out << ";" << CollapsedStackFrame(stack.frame(i), &frame_names);
+    }
+    *out << " " << sample.second.bytes << "\n";
+  }
+}
+
+} // namespace yb
@@ -0,0 +1,128 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_UTIL_ALLOCATION_PROFILER_H
+#define YB_UTIL_ALLOCATION_PROFILER_H
+
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+#include "yb/gutil/thread_annotations.h"
+#include "yb/util/debug-util.h"
+#include "yb/util/monotime.h"
+#include "yb/util/status.h"
+
+namespace yb {
+
+// Names the operation performed by the current thread, e.g. the RPC method being handled, so
+// allocations sampled while the scope is alive are attributed to it. The name is not copied and
+// should outlive the scope.
+class ScopedAllocationScope {
+ public:
+  explicit ScopedAllocationScope(const std::string* name);
+  ~ScopedAllocationScope();
+
+  ScopedAllocationScope(const ScopedAllocationScope&) = delete;
+  void operator=(const ScopedAllocationScope&) = delete;
+
+ private:
+  const std::string* previous_;
+};
+
+// Sampling profiler of heap allocations.
+//
+// A tcmalloc new hook counts the bytes allocated by each thread, and every
+// allocation_profiler_sample_interval_bytes bytes takes the stack of the current allocation.
+// The stack is charged with all bytes and allocations made by the thread since its previous sample,
+// and is attributed to the thread category and name, i.e. the thread pool, and to the allocation
+// scope of the thread, e.g. the RPC method.
+//
+// Samples are aggregated per minute for the last allocation_profiler_history_minutes minutes, and
+// could be written as an allocation rate report, or as collapsed stacks.
+class AllocationProfiler {
+ public:
+  AllocationProfiler();
+
+  AllocationProfiler(const AllocationProfiler&) = delete;
+  void operator=(const AllocationProfiler&) = delete;
+
+  // Process wide profiler, that receives allocations after the first call to Start().
+  static AllocationProfiler* Instance();
+
+  // Installs the allocation hook of the process wide profiler, does nothing if it is already
+  // installed or tcmalloc is not used.
+  static CHECKED_STATUS Start();
+
+  // Accounts an allocation of size bytes by the current thread, invoked by the allocation hook and
+  // exposed for tests.
+  void RecordAllocation(size_t size);
+
+  // Writes allocation rates during the last period, per thread pool and allocation scope, sorted by
+  // allocated bytes, one line per pair:
+  // bytes_per_second allocations_per_second category;thread_name scope
+  void WriteReport(MonoDelta period, std::ostream* out) const;
+
+  // Writes stacks sampled during the last period, one line per distinct stack:
+  // category;thread_name;scope;outermost_frame;...;innermost_frame allocated_bytes
+  void WriteCollapsedStacks(MonoDelta period, std::ostream* out) const;
+
+ private:
+  // Key of the aggregated samples: the thread group, the allocation scope and the sampled stack.
+  struct StackKey {
+    std::string thread;
+    std::string scope;
+    StackTrace stack;
+
+    bool operator==(const StackKey& rhs) const {
+      return thread == rhs.thread && scope == rhs.scope && stack == rhs.stack;
+    }
+  };
+
+  struct StackKeyHash {
+    size_t operator()(const StackKey& key) const;
+  };
+
+  struct Allocations {
+    uint64_t bytes = 0;
+    uint64_t count = 0;
+
+    Allocations& operator+=(const Allocations& rhs) {
+      bytes += rhs.bytes;
+      count += rhs.count;
+      return *this;
+    }
+  };
+
+  typedef std::unordered_map<StackKey, Allocations, StackKeyHash> StackSamples;
+
+  // Samples taken during one minute.
+  struct Bucket {
+    CoarseTimePoint start;
+    StackSamples samples;
+  };
+
+  void AddSample(StackKey key, const Allocations& allocations);
+
+  // Collects samples of the last period, returns the duration they cover.
+  MonoDelta CollectSamples(MonoDelta period, StackSamples* samples) const;
+
+  mutable std::mutex mutex_;
+  std::deque<Bucket> buckets_ GUARDED_BY(mutex_);
+};
+
+} // namespace yb
+
+#endif // YB_UTIL_ALLOCATION_PROFILER_H
@@ -0,0 +1,80 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <thread>
+
+#include "yb/util/async_future.h"
+#include "yb/util/status.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+
+class AsyncFutureTest : public YBTest {
+};
+
+TEST_F(AsyncFutureTest, ContinuationAttachedBeforeAndAfterValue) {
+  AsyncPromise<int> promise;
+  int result = 0;
+  promise.GetFuture().OnReady([&result](int value) { result = value; });
+  ASSERT_EQ(0, result);
+  promise.SetValue(1);
+  ASSERT_EQ(1, result);
+
+  MakeReadyAsyncFuture(2).OnReady([&result](int value) { result = value; });
+  ASSERT_EQ(2, result);
+}
+
+TEST_F(AsyncFutureTest, Then) {
+  AsyncPromise<int> first;
+  AsyncPromise<std::string> second;
+  auto future = first.GetFuture().Then([](int value) {
+    return value * 2;
+  }).Then([&second](int value) {
+    // Returned future is flattened.
+    return second.GetFuture().Then([value](const std::string& str) {
+      return str + std::to_string(value);
+    });
+  });
+
+  first.SetValue(21);
+  std::string result;
+  future.OnReady([&result](const std::string& value) { result = value; });
+  ASSERT_TRUE(result.empty());
+  second.SetValue("answer ");
+  ASSERT_EQ("answer 42", result);
+}
+
+TEST_F(AsyncFutureTest, ContinuationRunsOnProvidingThread) {
+  AsyncPromise<Status> promise;
+  auto future = promise.GetFuture().Then([](const Status&) {
+    return std::this_thread::get_id();
+  });
+  std::thread::id provider_id;
+  std::thread provider([&promise, &provider_id] {
+    provider_id = std::this_thread::get_id();
+    promise.SetValue(Status::OK());
+  });
+  auto continuation_id = future.Get();
+  provider.join();
+  ASSERT_EQ(provider_id, continuation_id);
+}
+
+TEST_F(AsyncFutureTest, MakeAsyncFuture) {
+  std::function<void(const Status&)> callback;
+  auto future = MakeAsyncFuture<Status>([&callback](auto cb) { callback = std::move(cb); });
+  callback(STATUS(TimedOut, "Timed out"));
+  ASSERT_TRUE(future.Get().IsTimedOut());
+}
+
+} // namespace yb
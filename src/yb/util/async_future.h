@@ -0,0 +1,183 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_UTIL_ASYNC_FUTURE_H
+#define YB_UTIL_ASYNC_FUTURE_H
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+#include <boost/optional.hpp>
+
+namespace yb {
+
+template <class T>
+class AsyncFuture;
+
+template <class T>
+class AsyncPromise;
+
+namespace async_future_internal {
+
+template <class T>
+class State {
+ public:
+  void SetValue(T value) {
+    std::function<void(T)> continuation;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!continuation_) {
+        value_ = std::move(value);
+        return;
+      }
+      continuation = std::move(continuation_);
+    }
+    continuation(std::move(value));
+  }
+
+  void SetContinuation(std::function<void(T)> continuation) {
+    boost::optional<T> value;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!value_) {
+        continuation_ = std::move(continuation);
+        return;
+      }
+      value.swap(value_);
+    }
+    continuation(std::move(*value));
+  }
+
+ private:
+  std::mutex mutex_;
+  boost::optional<T> value_;
+  std::function<void(T)> continuation_;
+};
+
+// Describes the future returned by Then for a continuation returning R. When the continuation
+// returns a future, it is flattened, so continuations could be chained without nesting.
+template <class R>
+struct ThenTraits {
+  typedef R ValueType;
+
+  static void Complete(R value, const AsyncPromise<R>& promise) {
+    promise.SetValue(std::move(value));
+  }
+};
+
+template <class U>
+struct ThenTraits<AsyncFuture<U>> {
+  typedef U ValueType;
+
+  static void Complete(AsyncFuture<U> future, const AsyncPromise<U>& promise) {
+    future.OnReady([promise](U value) { promise.SetValue(std::move(value)); });
+  }
+};
+
+} // namespace async_future_internal
+
+// Result of an asynchronous operation, that could be continued without blocking a thread.
+//
+// Unlike std::future, a continuation is invoked by the thread that provides the value, usually a
+// reactor thread that handled the RPC response, so a chain of operations is executed without
+// thread hops. Continuations should not block, as other callbacks of asynchronous operations:
+//
+//   session->FlushAsyncFuture().Then([txn](const Status& status) {
+//     return status.ok() ? txn->CommitAsyncFuture() : MakeReadyAsyncFuture(status);
+//   }).OnReady([](const Status& status) { ... });
+//
+// Only one continuation could be attached to a future.
+template <class T>
+class AsyncFuture {
+ public:
+  typedef T ValueType;
+
+  // Invokes continuation with the value, when it is ready. The continuation is invoked by the
+  // current thread if the value is already ready.
+  template <class F>
+  void OnReady(F continuation) {
+    state_->SetContinuation(std::move(continuation));
+  }
+
+  // Returns future for the value returned by continuation, that is invoked as in OnReady.
+  template <class F>
+  auto Then(F continuation) -> AsyncFuture<typename async_future_internal::ThenTraits<
+      decltype(continuation(std::declval<T>()))>::ValueType> {
+    typedef async_future_internal::ThenTraits<decltype(continuation(std::declval<T>()))> Traits;
+    AsyncPromise<typename Traits::ValueType> promise;
+    auto result = promise.GetFuture();
+    OnReady([promise, continuation](T value) mutable {
+      Traits::Complete(continuation(std::move(value)), promise);
+    });
+    return result;
+  }
+
+  // Blocks the current thread until the value is ready, only for callers that could block.
+  T Get() {
+    std::promise<T> promise;
+    auto future = promise.get_future();
+    OnReady([&promise](T value) { promise.set_value(std::move(value)); });
+    return future.get();
+  }
+
+ private:
+  friend class AsyncPromise<T>;
+
+  explicit AsyncFuture(std::shared_ptr<async_future_internal::State<T>> state)
+      : state_(std::move(state)) {}
+
+  std::shared_ptr<async_future_internal::State<T>> state_;
+};
+
+// Provides the value of an AsyncFuture. Copies share the same value.
+template <class T>
+class AsyncPromise {
+ public:
+  AsyncPromise() : state_(std::make_shared<async_future_internal::State<T>>()) {}
+
+  AsyncFuture<T> GetFuture() const {
+    return AsyncFuture<T>(state_);
+  }
+
+  // Should be invoked once, invokes the continuation of the future if it is already attached.
+  void SetValue(T value) const {
+    state_->SetValue(std::move(value));
+  }
+
+ private:
+  std::shared_ptr<async_future_internal::State<T>> state_;
+};
+
+template <class T>
+AsyncFuture<typename std::decay<T>::type> MakeReadyAsyncFuture(T&& value) {
+  AsyncPromise<typename std::decay<T>::type> promise;
+  promise.SetValue(std::forward<T>(value));
+  return promise.GetFuture();
+}
+
+// Functor is any functor that accepts callback as only argument, see MakeFuture.
+template <class Result, class Functor>
+AsyncFuture<Result> MakeAsyncFuture(const Functor& functor) {
+  AsyncPromise<Result> promise;
+  auto result = promise.GetFuture();
+  functor([promise](Result value) { promise.SetValue(std::move(value)); });
+  return result;
+}
+
+} // namespace yb
+
+#endif // YB_UTIL_ASYNC_FUTURE_H
@@ -0,0 +1,134 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "yb/util/async_logger.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+
+namespace {
+
+// Logger that records written messages, and blocks writes while the test holds its mutex.
+class RecordingLogger : public google::base::Logger {
+ public:
+  void Write(bool force_flush, time_t timestamp, const char* message, int message_len) override {
+    std::lock_guard<std::mutex> lock(mutex);
+    messages.emplace_back(message, message_len);
+  }
+
+  void Flush() override {
+  }
+
+  google::uint32 LogSize() override {
+    return 0;
+  }
+
+  std::vector<std::string> Messages() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return messages;
+  }
+
+  std::mutex mutex;
+  std::vector<std::string> messages;
+};
+
+void WriteMessage(google::base::Logger* logger, const std::string& message) {
+  logger->Write(/* force_flush= */ true, 0, message.data(), message.size());
+}
+
+} // namespace
+
+class AsyncLoggerTest : public YBTest {
+};
+
+TEST_F(AsyncLoggerTest, WritesInOrder) {
+  RecordingLogger recording_logger;
+  AsyncLogger logger(google::INFO, &recording_logger, 16);
+  for (int i = 0; i != 100; ++i) {
+    WriteMessage(&logger, Format("I$0", i));
+  }
+  ASSERT_OK(WaitFor([&logger] { return logger.buffered_messages() == 0; },
+                    MonoDelta::FromSeconds(10), "Buffered messages written"));
+  logger.Drain();
+
+  auto messages = recording_logger.Messages();
+  std::vector<std::string> expected;
+  for (int i = 0; i != 100; ++i) {
+    expected.push_back(Format("I$0", i));
+  }
+  // Some messages could be dropped if the background thread was late, but order is preserved.
+  size_t pos = 0;
+  for (const auto& message : messages) {
+    if (message.find("Dropped") != std::string::npos) {
+      continue;
+    }
+    while (pos != expected.size() && expected[pos] != message) {
+      ++pos;
+    }
+    ASSERT_NE(pos, expected.size()) << "Unexpected message: " << message;
+  }
+}
+
+TEST_F(AsyncLoggerTest, DropsWhenFullAndErrorsAreSynchronous) {
+  constexpr size_t kCapacity = 4;
+  RecordingLogger recording_logger;
+  AsyncLogger logger(google::INFO, &recording_logger, kCapacity);
+  {
+    // Background thread is blocked on the first written message.
+    std::unique_lock<std::mutex> lock(recording_logger.mutex);
+    for (int i = 0; i != 20; ++i) {
+      WriteMessage(&logger, Format("I$0", i));
+    }
+    ASSERT_GT(logger.dropped_messages(), 0);
+    ASSERT_LE(logger.buffered_messages(), kCapacity);
+  }
+  const auto dropped = logger.dropped_messages();
+
+  // glog writes an error message to the ERROR logger first, and then to the INFO logger.
+  RecordingLogger error_logger;
+  SynchronousMessageMarker marker(&error_logger);
+  const std::string error = "error";
+  WriteMessage(&marker, error);
+  WriteMessage(&logger, error);
+  // Error message is written before Write returns, after all buffered messages.
+  auto messages = recording_logger.Messages();
+  ASSERT_FALSE(messages.empty());
+  ASSERT_EQ(messages.back(), error);
+  ASSERT_EQ(error_logger.Messages(), std::vector<std::string>{error});
+  ASSERT_EQ(logger.buffered_messages(), 0);
+  ASSERT_EQ(messages.size(), 20 - dropped + 2) << AsString(messages);
+
+  bool dropped_reported = false;
+  for (const auto& message : messages) {
+    if (message.find(Format("Dropped $0 log messages", dropped)) != std::string::npos) {
+      dropped_reported = true;
+    }
+  }
+  ASSERT_TRUE(dropped_reported) << AsString(messages);
+}
+
+TEST_F(AsyncLoggerTest, SeverityDoesNotDependOnPrefix) {
+  RecordingLogger recording_logger;
+  AsyncLogger logger(google::INFO, &recording_logger, 16);
+  std::unique_lock<std::mutex> lock(recording_logger.mutex);
+  // Without log prefix a message could start with any letter, it is still buffered.
+  WriteMessage(&logger, "Error is not the severity of this message");
+  ASSERT_EQ(logger.buffered_messages(), 1);
+  ASSERT_TRUE(recording_logger.messages.empty());
+}
+
+} // namespace yb
@@ -0,0 +1,192 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/util/async_logger.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "yb/util/format.h"
+
+using namespace std::literals;
+
+namespace yb {
+
+namespace {
+
+// How often the background thread checks for new messages, if it was not notified.
+const auto kPollInterval = 100ms;
+
+// Message that is being written by this thread to the logger of ERROR or FATAL severity. glog
+// passes the same buffer to loggers of all severities the message is written to.
+thread_local const char* synchronous_message = nullptr;
+
+std::mutex installed_loggers_mutex;
+// Installed loggers are never destroyed, since glog could use them until the process exits.
+std::vector<AsyncLogger*> installed_loggers;
+
+void DrainInstalledLoggers() {
+  std::lock_guard<std::mutex> lock(installed_loggers_mutex);
+  for (auto* logger : installed_loggers) {
+    logger->Drain();
+  }
+}
+
+} // namespace
+
+void SynchronousMessageMarker::Write(
+    bool force_flush, time_t timestamp, const char* message, int message_len) {
+  synchronous_message = message;
+  wrapped_->Write(force_flush, timestamp, message, message_len);
+}
+
+AsyncLogger::AsyncLogger(
+    google::LogSeverity severity, google::base::Logger* wrapped, size_t capacity)
+    : severity_(severity), wrapped_(wrapped), capacity_(std::max<size_t>(capacity, 1)),
+      entries_(new Entry[capacity_]) {
+  thread_ = std::thread(&AsyncLogger::Run, this);
+}
+
+AsyncLogger::~AsyncLogger() {
+  stop_.store(true, std::memory_order_release);
+  wait_cond_.notify_one();
+  thread_.join();
+  Drain();
+}
+
+void AsyncLogger::Write(
+    bool force_flush, time_t timestamp, const char* message, int message_len) {
+  const bool synchronous = message == synchronous_message;
+  // INFO is the last severity the message is written to, so the mark is not needed anymore. glog
+  // reuses message buffers, so it would match the next message otherwise.
+  if (severity_ == google::INFO) {
+    synchronous_message = nullptr;
+  }
+  if (synchronous) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    WriteBuffered();
+    wrapped_->Write(/* force_flush= */ true, timestamp, message, message_len);
+    return;
+  }
+
+  const auto tail = tail_.load(std::memory_order_relaxed);
+  const auto head = head_.load(std::memory_order_acquire);
+  if (tail - head >= capacity_) {
+    dropped_messages_.fetch_add(1, std::memory_order_acq_rel);
+    return;
+  }
+  auto& entry = entries_[tail % capacity_];
+  entry.timestamp = timestamp;
+  // The string keeps its capacity after being written, so it usually does not allocate.
+  entry.message.assign(message, message_len);
+  tail_.store(tail + 1, std::memory_order_release);
+  // The background thread could be waiting only if the buffer was empty.
+  if (tail == head) {
+    wait_cond_.notify_one();
+  }
+}
+
+void AsyncLogger::Flush() {
+  flush_requested_.store(true, std::memory_order_release);
+  wait_cond_.notify_one();
+}
+
+google::uint32 AsyncLogger::LogSize() {
+  return wrapped_->LogSize();
+}
+
+void AsyncLogger::Drain() {
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  WriteBuffered();
+  wrapped_->Flush();
+}
+
+void AsyncLogger::Run() {
+  while (!stop_.load(std::memory_order_acquire)) {
+    {
+      std::unique_lock<std::mutex> lock(wait_mutex_);
+      wait_cond_.wait_for(lock, kPollInterval, [this] {
+        return stop_.load(std::memory_order_acquire) || buffered_messages() != 0 ||
+               flush_requested_.load(std::memory_order_acquire);
+      });
+    }
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    if (WriteBuffered() || flush_requested_.exchange(false, std::memory_order_acq_rel)) {
+      wrapped_->Flush();
+    }
+  }
+}
+
+bool AsyncLogger::WriteBuffered() {
+  bool written = false;
+  const auto dropped = dropped_messages_.load(std::memory_order_acquire);
+  if (dropped != reported_dropped_messages_) {
+    const auto message = Format(
+        "Dropped $0 log messages because the async logging buffer was full\n",
+        dropped - reported_dropped_messages_);
+    wrapped_->Write(/* force_flush= */ false, time(nullptr), message.data(), message.size());
+    reported_dropped_messages_ = dropped;
+    written = true;
+  }
+
+  auto head = head_.load(std::memory_order_relaxed);
+  const auto tail = tail_.load(std::memory_order_acquire);
+  for (; head != tail; ++head) {
+    const auto& entry = entries_[head % capacity_];
+    wrapped_->Write(
+        /* force_flush= */ false, entry.timestamp, entry.message.data(), entry.message.size());
+    head_.store(head + 1, std::memory_order_release);
+    written = true;
+  }
+  return written;
+}
+
+void InstallAsyncLoggers(size_t capacity) {
+  std::lock_guard<std::mutex> lock(installed_loggers_mutex);
+  if (!installed_loggers.empty()) {
+    return;
+  }
+  for (auto severity : {google::INFO, google::WARNING}) {
+    auto* logger = new AsyncLogger(severity, google::base::GetLogger(severity), capacity);
+    google::base::SetLogger(severity, logger);
+    installed_loggers.push_back(logger);
+  }
+  for (auto severity : {google::ERROR, google::FATAL}) {
+    google::base::SetLogger(
+        severity, new SynchronousMessageMarker(google::base::GetLogger(severity)));
+  }
+  // Messages still buffered at exit are written by the exiting thread.
+  atexit(&DrainInstalledLoggers);
+}
+
+uint64_t AsyncLoggingDroppedMessages() {
+  std::lock_guard<std::mutex> lock(installed_loggers_mutex);
+  uint64_t result = 0;
+  for (auto* logger : installed_loggers) {
+    result += logger->dropped_messages();
+  }
+  return result;
+}
+
+uint64_t AsyncLoggingBufferedMessages() {
+  std::lock_guard<std::mutex> lock(installed_loggers_mutex);
+  uint64_t result = 0;
+  for (auto* logger : installed_loggers) {
+    result += logger->buffered_messages();
+  }
+  return result;
+}
+
+} // namespace yb
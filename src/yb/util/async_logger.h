@@ -0,0 +1,139 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_UTIL_ASYNC_LOGGER_H
+#define YB_UTIL_ASYNC_LOGGER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <glog/logging.h>
+
+#include "yb/gutil/thread_annotations.h"
+
+namespace yb {
+
+// Wraps a glog file logger, so messages are written to it by a background thread and a slow log
+// device does not block threads that log.
+//
+// Messages are kept in a bounded ring buffer. When it is full, messages are dropped and counted,
+// and the number of dropped messages is written to the log once there is room again. ERROR and
+// FATAL messages are written synchronously, after all buffered messages, so they are never lost.
+//
+// glog does not pass the severity of a message to Write, but it writes a message to the logger of
+// its severity first, and then to loggers of lower severities. So loggers of ERROR and FATAL are
+// wrapped with SynchronousMessageMarker, which marks the message being written, and an async logger
+// writes marked messages synchronously.
+//
+// glog calls Write of a logger while holding its own mutex, so there is a single producer at a
+// time, and adding a message to the buffer does not require any lock.
+class AsyncLogger : public google::base::Logger {
+ public:
+  // severity is the severity of messages written to the log file of wrapped.
+  AsyncLogger(google::LogSeverity severity, google::base::Logger* wrapped, size_t capacity);
+  ~AsyncLogger();
+
+  AsyncLogger(const AsyncLogger&) = delete;
+  void operator=(const AsyncLogger&) = delete;
+
+  void Write(bool force_flush, time_t timestamp, const char* message, int message_len) override;
+
+  // Asks the background thread to flush the wrapped logger, without waiting for it.
+  void Flush() override;
+
+  google::uint32 LogSize() override;
+
+  // Writes all buffered messages to the wrapped logger and flushes it.
+  void Drain();
+
+  uint64_t dropped_messages() const {
+    return dropped_messages_.load(std::memory_order_acquire);
+  }
+
+  size_t buffered_messages() const {
+    return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+  }
+
+ private:
+  struct Entry {
+    time_t timestamp;
+    std::string message;
+  };
+
+  void Run();
+
+  // Writes messages buffered so far to the wrapped logger. Returns whether anything was written.
+  bool WriteBuffered() REQUIRES(write_mutex_);
+
+  const google::LogSeverity severity_;
+  google::base::Logger* const wrapped_;
+  const size_t capacity_;
+  std::unique_ptr<Entry[]> entries_;
+
+  // Index of the next entry to write to the wrapped logger, changed only under write_mutex_.
+  std::atomic<size_t> head_{0};
+  // Index of the next entry to add, changed only by the producer.
+  std::atomic<size_t> tail_{0};
+  std::atomic<uint64_t> dropped_messages_{0};
+  std::atomic<bool> flush_requested_{false};
+  std::atomic<bool> stop_{false};
+
+  // Serializes writes to the wrapped logger.
+  std::mutex write_mutex_;
+  uint64_t reported_dropped_messages_ GUARDED_BY(write_mutex_) = 0;
+
+  std::mutex wait_mutex_;
+  std::condition_variable wait_cond_;
+
+  std::thread thread_;
+};
+
+// Wraps the glog file logger of ERROR or FATAL severity, and marks messages written to it, so
+// async loggers of lower severities write them synchronously.
+class SynchronousMessageMarker : public google::base::Logger {
+ public:
+  explicit SynchronousMessageMarker(google::base::Logger* wrapped) : wrapped_(wrapped) {}
+
+  SynchronousMessageMarker(const SynchronousMessageMarker&) = delete;
+  void operator=(const SynchronousMessageMarker&) = delete;
+
+  void Write(bool force_flush, time_t timestamp, const char* message, int message_len) override;
+
+  void Flush() override {
+    wrapped_->Flush();
+  }
+
+  google::uint32 LogSize() override {
+    return wrapped_->LogSize();
+  }
+
+ private:
+  google::base::Logger* const wrapped_;
+};
+
+// Replaces glog file loggers of INFO and WARNING severities with async loggers of the specified
+// capacity, and wraps loggers of ERROR and FATAL severities with SynchronousMessageMarker.
+// ERROR and FATAL log files receive only messages that are written synchronously anyway.
+void InstallAsyncLoggers(size_t capacity);
+
+// Stats summed over installed async loggers.
+uint64_t AsyncLoggingDroppedMessages();
+uint64_t AsyncLoggingBufferedMessages();
+
+} // namespace yb
+
+#endif // YB_UTIL_ASYNC_LOGGER_H
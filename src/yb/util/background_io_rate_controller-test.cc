@@ -0,0 +1,88 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/util/background_io_rate_controller.h"
+
+#include "yb/util/test_util.h"
+
+DECLARE_int32(adaptive_background_io_target_latency_ms);
+DECLARE_int32(adaptive_background_io_min_rate_percentage);
+DECLARE_int32(adaptive_background_io_window_ms);
+
+using namespace std::literals;
+
+namespace yb {
+
+class BackgroundIoRateControllerTest : public YBTest {
+ protected:
+  // Records a window of samples, each 100th of them with the specified latency.
+  void RecordWindow(MonoDelta slow_latency) {
+    for (int i = 0; i != 100; ++i) {
+      controller_.RecordLatency(i == 0 ? slow_latency : MonoDelta::FromMilliseconds(1), now_);
+    }
+    now_ += 1s;
+    controller_.RecordLatency(MonoDelta::FromMilliseconds(1), now_);
+  }
+
+  BackgroundIoRateController controller_;
+  CoarseTimePoint now_ = CoarseMonoClock::Now();
+};
+
+TEST_F(BackgroundIoRateControllerTest, AdditiveIncreaseMultiplicativeDecrease) {
+  FLAGS_adaptive_background_io_target_latency_ms = 10;
+  FLAGS_adaptive_background_io_min_rate_percentage = 20;
+  FLAGS_adaptive_background_io_window_ms = 1000;
+
+  std::vector<double> factors;
+  bool keep_listener = true;
+  controller_.AddListener([&factors, &keep_listener](double factor) {
+    factors.push_back(factor);
+    return keep_listener;
+  });
+
+  // A single slow sample of 101 is within the target.
+  RecordWindow(MonoDelta::FromMilliseconds(50));
+  ASSERT_EQ(1.0, controller_.rate_factor());
+
+  controller_.RecordLatency(MonoDelta::FromMilliseconds(50), now_);
+  RecordWindow(MonoDelta::FromMilliseconds(50));
+  ASSERT_DOUBLE_EQ(0.5, controller_.rate_factor());
+
+  controller_.RecordLatency(MonoDelta::FromMilliseconds(50), now_);
+  RecordWindow(MonoDelta::FromMilliseconds(50));
+  ASSERT_DOUBLE_EQ(0.25, controller_.rate_factor());
+
+  // The factor does not drop below the minimal rate.
+  controller_.RecordLatency(MonoDelta::FromMilliseconds(50), now_);
+  RecordWindow(MonoDelta::FromMilliseconds(50));
+  ASSERT_DOUBLE_EQ(0.2, controller_.rate_factor());
+
+  RecordWindow(MonoDelta::FromMilliseconds(1));
+  ASSERT_DOUBLE_EQ(0.3, controller_.rate_factor());
+
+  ASSERT_EQ(4, factors.size());
+  ASSERT_DOUBLE_EQ(0.3, factors.back());
+
+  // Removed listener is not invoked anymore.
+  keep_listener = false;
+  RecordWindow(MonoDelta::FromMilliseconds(1));
+  RecordWindow(MonoDelta::FromMilliseconds(1));
+  ASSERT_EQ(5, factors.size());
+
+  // Disabling the adaptation restores the full rate.
+  FLAGS_adaptive_background_io_target_latency_ms = 0;
+  controller_.RecordLatency(MonoDelta::FromMilliseconds(50), now_);
+  ASSERT_EQ(1.0, controller_.rate_factor());
+}
+
+} // namespace yb
@@ -0,0 +1,113 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/util/background_io_rate_controller.h"
+
+#include <algorithm>
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+
+DEFINE_int32(adaptive_background_io_target_latency_ms, 0,
+             "Target latency of WAL syncs. When it is exceeded, the rate of flushes, compactions "
+             "and remote bootstrap is reduced. 0 disables the adaptation.");
+TAG_FLAG(adaptive_background_io_target_latency_ms, advanced);
+TAG_FLAG(adaptive_background_io_target_latency_ms, runtime);
+
+DEFINE_int32(adaptive_background_io_min_rate_percentage, 10,
+             "The rate of background I/O is never reduced below this percentage of its "
+             "configured rate.");
+TAG_FLAG(adaptive_background_io_min_rate_percentage, advanced);
+TAG_FLAG(adaptive_background_io_min_rate_percentage, runtime);
+
+DEFINE_int32(adaptive_background_io_window_ms, 1000,
+             "Interval between adjustments of the background I/O rate.");
+TAG_FLAG(adaptive_background_io_window_ms, advanced);
+TAG_FLAG(adaptive_background_io_window_ms, runtime);
+
+namespace yb {
+
+namespace {
+
+constexpr double kIncreaseStep = 0.1;
+constexpr double kDecreaseFactor = 0.5;
+// Rate is decreased when more than 1 of kSlowSamplesDivider samples is slow, i.e. p99 is above
+// the target.
+constexpr size_t kSlowSamplesDivider = 100;
+
+} // namespace
+
+BackgroundIoRateController* BackgroundIoRateController::Instance() {
+  static BackgroundIoRateController instance;
+  return &instance;
+}
+
+void BackgroundIoRateController::RecordLatency(MonoDelta latency, CoarseTimePoint now) {
+  const auto target_ms = FLAGS_adaptive_background_io_target_latency_ms;
+  if (target_ms <= 0 && rate_factor() == 1.0) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (target_ms > 0) {
+    ++window_samples_;
+    if (latency.ToMilliseconds() > target_ms) {
+      ++window_slow_samples_;
+    }
+  }
+  const auto window = std::chrono::milliseconds(FLAGS_adaptive_background_io_window_ms);
+  if (window_start_ == CoarseTimePoint()) {
+    window_start_ = now;
+  }
+  if (target_ms > 0 && now < window_start_ + window) {
+    return;
+  }
+
+  const double min_factor =
+      std::min(std::max(FLAGS_adaptive_background_io_min_rate_percentage, 1), 100) / 100.0;
+  const double old_factor = rate_factor();
+  double new_factor;
+  if (target_ms <= 0) {
+    new_factor = 1.0;
+  } else if (window_slow_samples_ * kSlowSamplesDivider > window_samples_) {
+    new_factor = std::max(old_factor * kDecreaseFactor, min_factor);
+  } else {
+    new_factor = std::min(old_factor + kIncreaseStep, 1.0);
+  }
+  if (new_factor != old_factor) {
+    YB_LOG_EVERY_N_SECS(INFO, 10)
+        << "Background I/O rate factor changed from " << old_factor << " to " << new_factor
+        << ", slow foreground I/O operations: " << window_slow_samples_ << " of "
+        << window_samples_;
+    SetRateFactor(new_factor);
+  }
+  window_start_ = now;
+  window_samples_ = 0;
+  window_slow_samples_ = 0;
+}
+
+void BackgroundIoRateController::AddListener(Listener listener) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  listeners_.push_back(std::move(listener));
+}
+
+void BackgroundIoRateController::SetRateFactor(double value) {
+  rate_factor_.store(value, std::memory_order_release);
+  listeners_.erase(std::remove_if(listeners_.begin(), listeners_.end(),
+                                  [value](const Listener& listener) {
+                                    return !listener(value);
+                                  }),
+                   listeners_.end());
+}
+
+} // namespace yb
@@ -0,0 +1,73 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_UTIL_BACKGROUND_IO_RATE_CONTROLLER_H
+#define YB_UTIL_BACKGROUND_IO_RATE_CONTROLLER_H
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "yb/gutil/thread_annotations.h"
+#include "yb/util/monotime.h"
+
+namespace yb {
+
+// Adapts the rate of background I/O, i.e. flushes, compactions and remote bootstrap, to the
+// latency of latency sensitive foreground I/O, i.e. WAL syncs.
+//
+// Latencies are accounted in windows of adaptive_background_io_window_ms. When more than 1% of
+// operations in a window took longer than adaptive_background_io_target_latency_ms, the rate
+// factor is halved, otherwise it is increased by 10% of the configured rate (AIMD). The factor
+// never drops below adaptive_background_io_min_rate_percentage.
+class BackgroundIoRateController {
+ public:
+  // Invoked with the new rate factor, returns false when the listener should be removed, e.g.
+  // because the rate limiter it updates was destroyed. Listeners are invoked under the lock of
+  // the controller, so they should be cheap and must not call the controller.
+  typedef std::function<bool(double)> Listener;
+
+  BackgroundIoRateController() = default;
+
+  BackgroundIoRateController(const BackgroundIoRateController&) = delete;
+  void operator=(const BackgroundIoRateController&) = delete;
+
+  static BackgroundIoRateController* Instance();
+
+  // Accounts latency of a foreground I/O operation.
+  void RecordLatency(MonoDelta latency, CoarseTimePoint now = CoarseMonoClock::Now());
+
+  // Fraction, from 0 to 1, of the configured rate, that background I/O could use now.
+  double rate_factor() const {
+    return rate_factor_.load(std::memory_order_acquire);
+  }
+
+  // Adds listener, that is invoked every time the rate factor changes.
+  void AddListener(Listener listener);
+
+ private:
+  void SetRateFactor(double value) REQUIRES(mutex_);
+
+  std::mutex mutex_;
+  CoarseTimePoint window_start_ GUARDED_BY(mutex_);
+  size_t window_samples_ GUARDED_BY(mutex_) = 0;
+  size_t window_slow_samples_ GUARDED_BY(mutex_) = 0;
+  std::vector<Listener> listeners_ GUARDED_BY(mutex_);
+
+  std::atomic<double> rate_factor_{1.0};
+};
+
+} // namespace yb
+
+#endif // YB_UTIL_BACKGROUND_IO_RATE_CONTROLLER_H
@@ -207,8 +207,8 @@ const vector<BFDecl> kBFDirectory = {
   { "PartitionHash", "partition_hash", "", INT32, {TYPEARGS} },
 
   // Counter functions.
-  { "IncCounter", "counter+", "", INT64, {INT64, INT64} },
-  { "DecCounter", "counter-", "", INT64, {INT64, INT64} },
+  { "IncCounter", "counter+", "OPCODE_COUNTER_INC", INT64, {INT64, INT64} },
+  { "DecCounter", "counter-", "OPCODE_COUNTER_DEC", INT64, {INT64, INT64} },
 
   // Now function.
   { "NowTimeUuid", "now", "", TIMEUUID, {} },
@@ -59,6 +59,10 @@ METRIC_DEFINE_counter(server, block_cache_hits_caching,
                       "Number of lookups that were expecting a block that found one."
                       "Use this number instead of cache_hits when trying to determine how "
                       "efficient the cache is");
+METRIC_DEFINE_counter(server, block_cache_admission_rejections,
+                      "Block Cache Admission Rejections", yb::MetricUnit::kBlocks,
+                      "Number of blocks that were not added to the cache, because they were "
+                      "accessed less frequently than the blocks they would evict");
 
 METRIC_DEFINE_gauge_uint64(server, block_cache_usage, "Block Cache Memory Usage",
                            yb::MetricUnit::kBytes,
@@ -71,6 +75,29 @@ METRIC_DEFINE_gauge_uint64(server, block_cache_multi_touch_usage,
                            "Multi Cache Block Cache Memory Usage",
                            yb::MetricUnit::kBytes,
                            "Memory consumed by the multi cache block cache");
+
+METRIC_DEFINE_counter(server, block_cache_persistent_inserts,
+                      "Persistent Block Cache Inserts", yb::MetricUnit::kBlocks,
+                      "Number of blocks inserted in the persistent block cache");
+METRIC_DEFINE_counter(server, block_cache_persistent_insert_failures,
+                      "Persistent Block Cache Insert Failures", yb::MetricUnit::kBlocks,
+                      "Number of blocks that failed to be written to the persistent block cache");
+METRIC_DEFINE_counter(server, block_cache_persistent_lookups,
+                      "Persistent Block Cache Lookups", yb::MetricUnit::kBlocks,
+                      "Number of blocks looked up from the persistent block cache");
+METRIC_DEFINE_counter(server, block_cache_persistent_evictions,
+                      "Persistent Block Cache Evictions", yb::MetricUnit::kBlocks,
+                      "Number of blocks evicted from the persistent block cache");
+METRIC_DEFINE_counter(server, block_cache_persistent_hits,
+                      "Persistent Block Cache Hits", yb::MetricUnit::kBlocks,
+                      "Number of persistent block cache lookups that found a block");
+METRIC_DEFINE_counter(server, block_cache_persistent_misses,
+                      "Persistent Block Cache Misses", yb::MetricUnit::kBlocks,
+                      "Number of persistent block cache lookups that didn't yield a block");
+METRIC_DEFINE_gauge_uint64(server, block_cache_persistent_usage,
+                           "Persistent Block Cache Disk Usage", yb::MetricUnit::kBytes,
+                           "Disk space consumed by the persistent block cache");
+
 namespace yb {
 
 #define MINIT(member, x) member(METRIC_##x.Instantiate(entity))
@@ -83,10 +110,21 @@ CacheMetrics::CacheMetrics(const scoped_refptr<MetricEntity>& entity)
     MINIT(cache_hits_caching, block_cache_hits_caching),
     MINIT(cache_misses, block_cache_misses),
     MINIT(cache_misses_caching, block_cache_misses_caching),
+    MINIT(cache_admission_rejections, block_cache_admission_rejections),
     GINIT(cache_usage, block_cache_usage),
     GINIT(single_touch_cache_usage, block_cache_single_touch_usage),
     GINIT(multi_touch_cache_usage, block_cache_multi_touch_usage) {
 }
+
+PersistentCacheMetrics::PersistentCacheMetrics(const scoped_refptr<MetricEntity>& entity)
+  : MINIT(inserts, block_cache_persistent_inserts),
+    MINIT(insert_failures, block_cache_persistent_insert_failures),
+    MINIT(lookups, block_cache_persistent_lookups),
+    MINIT(evictions, block_cache_persistent_evictions),
+    MINIT(cache_hits, block_cache_persistent_hits),
+    MINIT(cache_misses, block_cache_persistent_misses),
+    GINIT(cache_usage, block_cache_persistent_usage) {
+}
 #undef MINIT
 #undef GINIT
 
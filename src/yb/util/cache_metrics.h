@@ -54,11 +54,26 @@ struct CacheMetrics {
   scoped_refptr<Counter> cache_hits_caching;
   scoped_refptr<Counter> cache_misses;
   scoped_refptr<Counter> cache_misses_caching;
+  scoped_refptr<Counter> cache_admission_rejections;
 
   scoped_refptr<AtomicGauge<uint64_t> > cache_usage;
   scoped_refptr<AtomicGauge<uint64_t> > single_touch_cache_usage;
   scoped_refptr<AtomicGauge<uint64_t> > multi_touch_cache_usage;
 };
 
+// Metrics of the secondary, file based, block cache tier.
+struct PersistentCacheMetrics {
+  explicit PersistentCacheMetrics(const scoped_refptr<MetricEntity>& metric_entity);
+
+  scoped_refptr<Counter> inserts;
+  scoped_refptr<Counter> insert_failures;
+  scoped_refptr<Counter> lookups;
+  scoped_refptr<Counter> evictions;
+  scoped_refptr<Counter> cache_hits;
+  scoped_refptr<Counter> cache_misses;
+
+  scoped_refptr<AtomicGauge<uint64_t> > cache_usage;
+};
+
 } // namespace yb
 #endif /* YB_UTIL_CACHE_METRICS_H */
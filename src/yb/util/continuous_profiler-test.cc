@@ -0,0 +1,63 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+
+#include "yb/util/continuous_profiler.h"
+#include "yb/util/test_util.h"
+#include "yb/util/thread.h"
+
+using namespace std::literals;
+
+namespace yb {
+
+class ContinuousProfilerTest : public YBTest {
+};
+
+namespace {
+
+void BusyLoop(std::atomic<bool>* stop) {
+  while (!stop->load(std::memory_order_acquire)) {
+  }
+}
+
+} // namespace
+
+TEST_F(ContinuousProfilerTest, SampleBusyThread) {
+  std::atomic<bool> stop{false};
+  scoped_refptr<Thread> thread;
+  ASSERT_OK(Thread::Create("test_category", "busy_worker-1", &BusyLoop, &stop, &thread));
+
+  ContinuousProfiler profiler;
+  for (int i = 0; i != 10; ++i) {
+    std::this_thread::sleep_for(20ms);
+    profiler.Sample();
+  }
+  stop.store(true, std::memory_order_release);
+  ASSERT_OK(ThreadJoiner(thread.get()).Join());
+
+  std::stringstream out;
+  profiler.WriteCollapsedStacks(MonoDelta::FromSeconds(60), &out);
+  LOG(INFO) << "Collapsed stacks:\n" << out.str();
+  // The worker index is dropped from the thread name.
+  ASSERT_STR_CONTAINS(out.str(), "test_category;busy_worker-;");
+
+  // Nothing was sampled in the future.
+  std::stringstream empty;
+  profiler.WriteCollapsedStacks(MonoDelta::FromSeconds(-120), &empty);
+  ASSERT_EQ("", empty.str());
+}
+
+} // namespace yb
@@ -0,0 +1,199 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/util/continuous_profiler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/os-util.h"
+
+DEFINE_int32(continuous_profiler_interval_ms, 1000,
+             "Interval between samples of the continuous CPU profiler. 0 to disable the "
+             "profiler.");
+TAG_FLAG(continuous_profiler_interval_ms, advanced);
+TAG_FLAG(continuous_profiler_interval_ms, runtime);
+
+DEFINE_int32(continuous_profiler_history_minutes, 10,
+             "For how many minutes samples of the continuous CPU profiler are kept.");
+TAG_FLAG(continuous_profiler_history_minutes, advanced);
+TAG_FLAG(continuous_profiler_history_minutes, runtime);
+
+namespace yb {
+
+namespace {
+
+const auto kBucketDuration = std::chrono::minutes(1);
+
+} // namespace
+
+size_t ContinuousProfiler::StackKeyHash::operator()(const StackKey& key) const {
+  size_t result = std::hash<std::string>()(key.thread);
+  boost::hash_combine(result, key.stack.HashCode());
+  return result;
+}
+
+const std::string& CollapsedStackFrame(void* pc, std::unordered_map<void*, std::string>* cache) {
+  auto it = cache->find(pc);
+  if (it != cache->end()) {
+    return it->second;
+  }
+  auto name = SymbolizeAddress(pc, StackTraceLineFormat::SYMBOL_ONLY);
+  while (!name.empty() && name.back() == '\n') {
+    name.pop_back();
+  }
+  // Drop " (file:line)", so samples from different lines of a function are merged.
+  auto file_pos = name.rfind(" (");
+  if (file_pos != std::string::npos && file_pos != 0) {
+    name.erase(file_pos);
+  }
+  // ';' separates frames in the collapsed format.
+  std::replace(name.begin(), name.end(), ';', ':');
+  return cache->emplace(pc, std::move(name)).first->second;
+}
+
+ContinuousProfiler::ContinuousProfiler() = default;
+
+ContinuousProfiler::~ContinuousProfiler() {
+  Shutdown();
+}
+
+ContinuousProfiler* ContinuousProfiler::Instance() {
+  // Never destroyed, so it outlives all servers of the process.
+  static ContinuousProfiler* instance = new ContinuousProfiler();
+  return instance;
+}
+
+Status ContinuousProfiler::Start() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (thread_) {
+    return Status::OK();
+  }
+  return Thread::Create("profiler", "continuous_profiler", &ContinuousProfiler::Run, this,
+                        &thread_);
+}
+
+void ContinuousProfiler::Shutdown() {
+  stop_latch_.CountDown();
+  scoped_refptr<Thread> thread;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    thread = thread_;
+  }
+  if (thread) {
+    WARN_NOT_OK(ThreadJoiner(thread.get()).Join(), "Failed to join continuous profiler thread");
+  }
+}
+
+void ContinuousProfiler::Run() {
+  for (;;) {
+    auto interval = FLAGS_continuous_profiler_interval_ms;
+    // Check whether the profiler was enabled once per second, when it is disabled.
+    if (stop_latch_.WaitFor(MonoDelta::FromMilliseconds(interval > 0 ? interval : 1000))) {
+      return;
+    }
+    if (interval > 0) {
+      Sample();
+    }
+  }
+}
+
+void ContinuousProfiler::Sample() {
+  struct RunningThread {
+    ThreadIdForStack tid_for_stack;
+    std::string group;
+  };
+
+  const auto self = Thread::CurrentThreadId();
+  std::vector<RunningThread> running;
+  for (const auto& thread : ListRunningThreads()) {
+    if (thread.tid == self) {
+      continue;
+    }
+    ThreadStats stats;
+    if (!GetThreadStats(thread.tid, &stats).ok()) {
+      continue;
+    }
+    // Only threads that are on CPU or waiting for it are sampled. The stack of such a thread is
+    // what it is running right now, while CPU time consumed since the previous sample could have
+    // been spent anywhere.
+    if (stats.state != 'R') {
+      continue;
+    }
+    running.push_back(RunningThread {
+        thread.tid_for_stack, ThreadGroupName(thread.category, thread.name) });
+  }
+  if (running.empty()) {
+    return;
+  }
+
+  std::sort(running.begin(), running.end(), [](const RunningThread& lhs,
+                                               const RunningThread& rhs) {
+    return lhs.tid_for_stack < rhs.tid_for_stack;
+  });
+  std::vector<ThreadIdForStack> tids;
+  tids.reserve(running.size());
+  for (const auto& thread : running) {
+    tids.push_back(thread.tid_for_stack);
+  }
+  auto stacks = ThreadStacks(tids);
+
+  const auto now = CoarseMonoClock::Now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (buckets_.empty() || buckets_.back().start + kBucketDuration <= now) {
+    buckets_.push_back(Bucket { now, StackSamples() });
+  }
+  const auto history = kBucketDuration * std::max(FLAGS_continuous_profiler_history_minutes, 1);
+  while (buckets_.front().start + history <= now) {
+    buckets_.pop_front();
+  }
+  auto& samples = buckets_.back().samples;
+  for (size_t i = 0; i != running.size(); ++i) {
+    if (!stacks[i].ok()) {
+      continue;
+    }
+    ++samples[StackKey { std::move(running[i].group), *stacks[i] }];
+  }
+}
+
+void ContinuousProfiler::WriteCollapsedStacks(MonoDelta period, std::ostream* out) const {
+  StackSamples samples;
+  {
+    const auto since = CoarseMonoClock::Now() - period.ToSteadyDuration();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& bucket : buckets_) {
+      if (bucket.start + kBucketDuration <= since) {
+        continue;
+      }
+      for (const auto& sample : bucket.samples) {
+        samples[sample.first] += sample.second;
+      }
+    }
+  }
+
+  std::unordered_map<void*, std::string> frame_names;
+  for (const auto& sample : samples) {
+    *out << sample.first.thread;
+    const auto& stack = sample.first.stack;
+    for (int i = stack.num_frames(); i-- > 0;) {
+      *out << ";" << CollapsedStackFrame(stack.frame(i), &frame_names);
+    }
+    *out << " " << sample.second << "\n";
+  }
+}
+
+} // namespace yb
@@ -0,0 +1,101 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_UTIL_CONTINUOUS_PROFILER_H
+#define YB_UTIL_CONTINUOUS_PROFILER_H
+
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+#include "yb/gutil/thread_annotations.h"
+#include "yb/util/countdown_latch.h"
+#include "yb/util/debug-util.h"
+#include "yb/util/monotime.h"
+#include "yb/util/status.h"
+#include "yb/util/thread.h"
+
+namespace yb {
+
+// Returns the name of the function containing pc, in the form used for frames of collapsed stacks.
+// Names are cached in cache, since symbolization is expensive.
+const std::string& CollapsedStackFrame(void* pc, std::unordered_map<void*, std::string>* cache);
+
+// Always-on, low rate sampling CPU profiler.
+//
+// Periodically reads the scheduler state of every thread started via Thread, and takes the stacks
+// of threads that are running or runnable. Each such stack is charged with one sample, and is
+// attributed to the thread category and name, e.g. the thread pool the thread belongs to.
+//
+// Samples are aggregated per minute for the last continuous_profiler_history_minutes minutes,
+// and could be written as collapsed stacks, the input format of flame graph tools.
+class ContinuousProfiler {
+ public:
+  ContinuousProfiler();
+  ~ContinuousProfiler();
+
+  ContinuousProfiler(const ContinuousProfiler&) = delete;
+  void operator=(const ContinuousProfiler&) = delete;
+
+  // Process wide profiler, that is started by the first call to Start().
+  static ContinuousProfiler* Instance();
+
+  // Starts the sampling thread, does nothing if it is already running.
+  CHECKED_STATUS Start();
+
+  void Shutdown();
+
+  // Takes a single sample, exposed for tests.
+  void Sample();
+
+  // Writes stacks sampled during the last period, one line per distinct stack:
+  // category;thread_name;outermost_frame;...;innermost_frame num_samples
+  void WriteCollapsedStacks(MonoDelta period, std::ostream* out) const;
+
+ private:
+  // Key of the aggregated samples: the thread category and name, and the sampled stack.
+  struct StackKey {
+    std::string thread;
+    StackTrace stack;
+
+    bool operator==(const StackKey& rhs) const {
+      return thread == rhs.thread && stack == rhs.stack;
+    }
+  };
+
+  struct StackKeyHash {
+    size_t operator()(const StackKey& key) const;
+  };
+
+  typedef std::unordered_map<StackKey, uint64_t, StackKeyHash> StackSamples;
+
+  // Samples taken during one minute.
+  struct Bucket {
+    CoarseTimePoint start;
+    StackSamples samples;
+  };
+
+  void Run();
+
+  CountDownLatch stop_latch_{1};
+  scoped_refptr<Thread> thread_;
+
+  mutable std::mutex mutex_;
+  std::deque<Bucket> buckets_ GUARDED_BY(mutex_);
+};
+
+} // namespace yb
+
+#endif // YB_UTIL_CONTINUOUS_PROFILER_H
@@ -55,8 +55,10 @@ Status BlockAccessCipherStream::Init() {
           encryption_params_->key_size);
   }
 
+  // The key is set once, so its schedule is not expanded again for every encrypted buffer, only the
+  // iv is set by EncryptByBlock.
   const auto encrypt_init_ex_result = EVP_EncryptInit_ex(
-      encryption_context_.get(), cipher, /* impl */ nullptr, /* key */ nullptr,
+      encryption_context_.get(), cipher, /* impl */ nullptr, encryption_params_->key,
       /* iv */ nullptr);
   if (encrypt_init_ex_result != 1) {
     return STATUS_FORMAT(InternalError,
@@ -156,7 +158,7 @@ Status BlockAccessCipherStream::EncryptByBlock(
 
   const int init_result =
       EVP_EncryptInit_ex(encryption_context_.get(), /* cipher */ nullptr, /* impl */ nullptr,
-                         encryption_params_->key, iv);
+                         /* key */ nullptr, iv);
   if (init_result != 1) {
     return STATUS_FORMAT(InternalError,
                          "EVP_EncryptInit_ex returned $0 when encrypting/decrypting $1 bytes "
@@ -182,6 +182,15 @@ class StackTrace {
                  pointer_cast<const char*>(frames_ + num_frames_));
   }
 
+  int num_frames() const {
+    return num_frames_;
+  }
+
+  // Returns the frame with the specified index, the innermost frame has index 0.
+  void* frame(int index) const {
+    return frames_[index];
+  }
+
  private:
   enum {
     // The maximum number of stack frames to collect.
@@ -292,5 +292,56 @@ TEST_F(DecimalTest, TestFloatDoubleCanonicalization) {
   EXPECT_EQ(*(reinterpret_cast<int64_t *>(&d1)), *(reinterpret_cast<int64_t *>(&d2)));
 }
 
+TEST_F(DecimalTest, FixedDecimal) {
+  // Sums of test_cases with extreme exponents are too large for Decimal, so they are only used to
+  // check encoding.
+  const std::vector<std::string> values = {
+      "0", "1", "-1", "10", "0.5", "-1.34", "120e0", "1.2e+100", "-0.000000001",
+      "123456789.123456789", "-987654321987654321.25", "1e12", "88888888888888888888.000000001",
+      "99999999999999999999999999999999999999", "-99999999999999999999999999999999999999", "1e37",
+      "1e-30", "1e40", "5e-60"};
+
+  for (const auto& values_to_encode : {test_cases, values}) {
+    for (const auto& str : values_to_encode) {
+      SCOPED_TRACE(Format("Value: $0", str));
+      const auto encoded = Decimal(str).EncodeToComparable();
+      FixedDecimal fixed;
+      if (fixed.DecodeFromComparable(encoded)) {
+        std::string reencoded;
+        fixed.EncodeToComparable(&reencoded);
+        ASSERT_EQ(Slice(encoded).ToDebugHexString(), Slice(reencoded).ToDebugHexString());
+      }
+    }
+  }
+
+  for (const auto& lhs_str : values) {
+    SCOPED_TRACE(Format("Value: $0", lhs_str));
+    for (const auto& rhs_str : values) {
+      SCOPED_TRACE(Format("Added value: $0", rhs_str));
+      const auto expected = (Decimal(lhs_str) + Decimal(rhs_str)).EncodeToComparable();
+      std::string sum = Decimal(lhs_str).EncodeToComparable();
+      ASSERT_OK(AddComparableDecimals(sum, Decimal(rhs_str).EncodeToComparable(), &sum));
+      ASSERT_EQ(Slice(expected).ToDebugHexString(), Slice(sum).ToDebugHexString());
+    }
+  }
+
+  // Values that fit are decoded, values that do not fit are left to Decimal.
+  FixedDecimal fixed;
+  ASSERT_TRUE(fixed.DecodeFromComparable(Decimal("-12.345").EncodeToComparable()));
+  // Digits are decoded in pairs, so the coefficient could have a trailing zero.
+  ASSERT_EQ(-123450, static_cast<int64_t>(fixed.coefficient()));
+  ASSERT_EQ(4, fixed.scale());
+  ASSERT_FALSE(fixed.DecodeFromComparable(Decimal("1e40").EncodeToComparable()));
+  ASSERT_FALSE(fixed.DecodeFromComparable(Decimal("1.36e-2147483645").EncodeToComparable()));
+
+  FixedDecimal sum;
+  ASSERT_TRUE(FixedDecimal::Add(FixedDecimal(5, 1), FixedDecimal(-25, 2), &sum));
+  ASSERT_EQ(25, static_cast<int64_t>(sum.coefficient()));
+  ASSERT_EQ(2, sum.scale());
+  ASSERT_TRUE(fixed.DecodeFromComparable(
+      Decimal("99999999999999999999999999999999999999").EncodeToComparable()));
+  ASSERT_FALSE(FixedDecimal::Add(fixed, FixedDecimal(1, 0), &sum));
+}
+
 } // namespace util
 } // namespace yb
@@ -11,11 +11,13 @@
 // under the License.
 //
 
+#include <array>
 #include <vector>
 #include <limits>
 #include <iomanip>
 #include <glog/logging.h>
 
+#include "yb/gutil/casts.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/util/decimal.h"
 #include "yb/util/stol_utils.h"
@@ -445,6 +447,229 @@ void Decimal::make_canonical() {
   }
 }
 
+namespace {
+
+// Max absolute value of exponent handled by FixedDecimal encoding, so it fits 8 bytes.
+constexpr int64_t kMaxFixedDecimalExponent = 1 << 20;
+
+const __int128* PowersOf10() {
+  static const auto powers = [] {
+    std::array<__int128, FixedDecimal::kMaxDigits + 1> result;
+    result[0] = 1;
+    for (size_t i = 1; i < result.size(); ++i) {
+      result[i] = result[i - 1] * 10;
+    }
+    return result;
+  }();
+  return powers.data();
+}
+
+bool FitsFixedDecimal(__int128 coefficient) {
+  const auto limit = PowersOf10()[FixedDecimal::kMaxDigits];
+  return coefficient < limit && coefficient > -limit;
+}
+
+// Multiplies coefficient by 10^power. Returns false if the result does not fit FixedDecimal.
+bool ScaleUp(__int128 coefficient, int power, __int128* out) {
+  if (coefficient == 0) {
+    *out = 0;
+    return true;
+  }
+  if (power > FixedDecimal::kMaxDigits) {
+    return false;
+  }
+  const auto limit = PowersOf10()[FixedDecimal::kMaxDigits - power];
+  if (coefficient >= limit || coefficient <= -limit) {
+    return false;
+  }
+  *out = coefficient * PowersOf10()[power];
+  return true;
+}
+
+// Decodes exponent encoded by VarInt::EncodeToComparable with 2 reserved bits, when it does not
+// exceed kMaxFixedDecimalExponent. Bytes of slice are complemented when negative is true.
+bool DecodeFixedDecimalExponent(
+    const Slice& slice, bool complement, int64_t* exponent, size_t* num_decoded_bytes) {
+  constexpr size_t kMaxBytes = 8;
+  uint8_t buffer[kMaxBytes];
+  const auto len = std::min(slice.size(), kMaxBytes);
+  for (size_t i = 0; i != len; ++i) {
+    buffer[i] = complement ? ~slice[i] : slice[i];
+  }
+  const bool negative = (buffer[0] & 0x20) == 0;
+  if (negative) {
+    for (size_t i = 0; i != len; ++i) {
+      buffer[i] = ~buffer[i];
+    }
+  }
+  buffer[0] |= 0xc0;
+  size_t idx = 0;
+  size_t num_ones = 0;
+  while (buffer[idx] == 0xff) {
+    ++idx;
+    if (idx >= len) {
+      return false;
+    }
+    num_ones += 8;
+  }
+  uint8_t mask = 0x80;
+  while (buffer[idx] & mask) {
+    buffer[idx] ^= mask;
+    ++num_ones;
+    mask >>= 1;
+  }
+  num_ones -= 2;
+  if (num_ones > len) {
+    return false;
+  }
+  uint64_t magnitude = 0;
+  for (size_t i = idx; i != num_ones; ++i) {
+    magnitude = (magnitude << 8) | buffer[i];
+  }
+  if (magnitude > kMaxFixedDecimalExponent) {
+    return false;
+  }
+  *exponent = negative ? -static_cast<int64_t>(magnitude) : static_cast<int64_t>(magnitude);
+  *num_decoded_bytes = num_ones;
+  return true;
+}
+
+// Same as VarInt(exponent).EncodeToComparable(/* num_reserved_bits */ 2).
+void AppendFixedDecimalExponent(int64_t exponent, std::string* out) {
+  if (exponent == 0) {
+    out->push_back(0x20);
+    return;
+  }
+  const uint64_t magnitude = exponent < 0 ? -exponent : exponent;
+  const size_t num_bits = 64 - __builtin_clzll(magnitude);
+  const size_t num_bytes = (num_bits + 1 + 2 + 6) / 7;
+  uint8_t data[8];
+  for (size_t i = 0; i != num_bytes; ++i) {
+    data[i] = static_cast<uint8_t>(magnitude >> (8 * (num_bytes - 1 - i)));
+  }
+  size_t idx = 0;
+  size_t num_ones = num_bytes + 2;
+  while (num_ones > 8) {
+    data[idx] = 0xff;
+    num_ones -= 8;
+    ++idx;
+  }
+  data[idx] |= 0xff ^ ((1 << (8 - num_ones)) - 1);
+  if (exponent < 0) {
+    for (size_t i = 0; i != num_bytes; ++i) {
+      data[i] = ~data[i];
+    }
+  }
+  data[0] &= 0x3f;
+  out->append(pointer_cast<const char*>(data), num_bytes);
+}
+
+} // namespace
+
+bool FixedDecimal::DecodeFromComparable(const Slice& slice) {
+  if (slice.empty()) {
+    return false;
+  }
+  if (slice[0] == 128) {
+    coefficient_ = 0;
+    scale_ = 0;
+    return true;
+  }
+  const bool is_positive = slice[0] >= 128;
+  int64_t exponent;
+  size_t num_exponent_bytes;
+  if (!DecodeFixedDecimalExponent(slice, !is_positive, &exponent, &num_exponent_bytes)) {
+    return false;
+  }
+  __int128 coefficient = 0;
+  int num_digits = 0;
+  for (size_t i = num_exponent_bytes;; ++i) {
+    if (i >= slice.size() || num_digits + 2 > kMaxDigits) {
+      return false;
+    }
+    uint8_t byte = is_positive ? slice[i] : ~slice[i];
+    coefficient = coefficient * 100 + (byte >> 1);
+    num_digits += 2;
+    if (!(byte & 1)) {
+      break;
+    }
+  }
+  // The value is 0.<digits> * 10^exponent.
+  int64_t scale = num_digits - exponent;
+  if (scale < 0) {
+    if (!ScaleUp(coefficient, -scale, &coefficient)) {
+      return false;
+    }
+    scale = 0;
+  }
+  coefficient_ = is_positive ? coefficient : -coefficient;
+  scale_ = scale;
+  return true;
+}
+
+void FixedDecimal::EncodeToComparable(std::string* out) const {
+  out->clear();
+  if (coefficient_ == 0) {
+    out->push_back(static_cast<char>(128));
+    return;
+  }
+  unsigned __int128 magnitude = coefficient_ < 0 ? -coefficient_ : coefficient_;
+  int64_t scale = scale_;
+  while (magnitude % 10 == 0) {
+    magnitude /= 10;
+    --scale;
+  }
+  // Digits in reverse order.
+  uint8_t digits[kMaxDigits + 1];
+  int num_digits = 0;
+  while (magnitude != 0) {
+    digits[num_digits++] = magnitude % 10;
+    magnitude /= 10;
+  }
+  AppendFixedDecimalExponent(num_digits - scale, out);
+  for (int i = num_digits; i > 0; i -= 2) {
+    uint8_t pair = digits[i - 1] * 10 + (i > 1 ? digits[i - 2] : 0);
+    out->push_back(pair * 2 + (i > 2 ? 1 : 0));
+  }
+  (*out)[0] |= 0xc0;
+  if (coefficient_ < 0) {
+    for (auto& c : *out) {
+      c = ~c;
+    }
+  }
+}
+
+bool FixedDecimal::Add(const FixedDecimal& lhs, const FixedDecimal& rhs, FixedDecimal* out) {
+  __int128 lhs_coefficient = lhs.coefficient_;
+  __int128 rhs_coefficient = rhs.coefficient_;
+  int scale = std::max(lhs.scale_, rhs.scale_);
+  if (!ScaleUp(lhs_coefficient, scale - lhs.scale_, &lhs_coefficient) ||
+      !ScaleUp(rhs_coefficient, scale - rhs.scale_, &rhs_coefficient)) {
+    return false;
+  }
+  // Both coefficients are less than 10^38 by absolute value, so the sum does not overflow.
+  auto sum = lhs_coefficient + rhs_coefficient;
+  if (!FitsFixedDecimal(sum)) {
+    return false;
+  }
+  *out = FixedDecimal(sum, scale);
+  return true;
+}
+
+Status AddComparableDecimals(const Slice& lhs, const Slice& rhs, std::string* out) {
+  FixedDecimal fixed_lhs, fixed_rhs, fixed_sum;
+  if (fixed_lhs.DecodeFromComparable(lhs) && fixed_rhs.DecodeFromComparable(rhs) &&
+      FixedDecimal::Add(fixed_lhs, fixed_rhs, &fixed_sum)) {
+    fixed_sum.EncodeToComparable(out);
+    return Status::OK();
+  }
+  Decimal decimal_lhs, decimal_rhs;
+  RETURN_NOT_OK(decimal_lhs.DecodeFromComparable(lhs));
+  RETURN_NOT_OK(decimal_rhs.DecodeFromComparable(rhs));
+  *out = (decimal_lhs + decimal_rhs).EncodeToComparable();
+  return Status::OK();
+}
+
 Decimal DecimalFromComparable(const Slice& slice) {
   Decimal decimal;
   CHECK_OK(decimal.DecodeFromComparable(slice));
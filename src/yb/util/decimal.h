@@ -170,6 +170,41 @@ class Decimal {
   bool is_positive_;
 };
 
+// Decimal with at most kMaxDigits significant digits, whose value is coefficient * 10^-scale.
+//
+// Used as the fast path of decimal arithmetic, that does not allocate memory. It reads and writes
+// the same comparable encoding as Decimal, and operations fail when the value does not fit, so the
+// caller could fall back to Decimal.
+class FixedDecimal {
+ public:
+  static constexpr int kMaxDigits = 38;
+
+  FixedDecimal() {}
+
+  FixedDecimal(__int128 coefficient, int scale) : coefficient_(coefficient), scale_(scale) {}
+
+  __int128 coefficient() const { return coefficient_; }
+  int scale() const { return scale_; }
+
+  // Decodes the comparable encoding of Decimal. Returns false if the value does not fit, or the
+  // encoding is not valid.
+  bool DecodeFromComparable(const Slice& slice);
+
+  // Replaces content of out with the encoding produced by Decimal::EncodeToComparable.
+  void EncodeToComparable(std::string* out) const;
+
+  // Stores the sum of lhs and rhs to out. Returns false if the sum does not fit.
+  static bool Add(const FixedDecimal& lhs, const FixedDecimal& rhs, FixedDecimal* out);
+
+ private:
+  __int128 coefficient_ = 0;
+  int scale_ = 0;
+};
+
+// Replaces content of out with the comparable encoding of the sum of decimals in comparable
+// encoding lhs and rhs. out could refer to the buffer of lhs or rhs.
+CHECKED_STATUS AddComparableDecimals(const Slice& lhs, const Slice& rhs, std::string* out);
+
 Decimal DecimalFromComparable(const Slice& slice);
 Decimal DecimalFromComparable(const std::string& string);
 
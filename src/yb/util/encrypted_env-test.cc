@@ -22,6 +22,7 @@
 #include "yb/util/header_manager_mock_impl.h"
 #include "yb/util/encryption_test_util.h"
 #include "yb/util/random_util.h"
+#include "yb/util/size_literals.h"
 
 #include <glog/logging.h>
 #include <gtest/gtest.h>
@@ -29,6 +30,8 @@
 namespace yb {
 namespace enterprise {
 
+using namespace yb::size_literals;
+
 constexpr uint32_t kDataSize = 1000;
 
 class TestEncryptedEnv : public YBTest {};
@@ -59,5 +62,53 @@ TEST_F(TestEncryptedEnv, FileOps) {
   }
 }
 
+TEST_F(TestEncryptedEnv, Throughput) {
+  constexpr size_t kChunkSize = 64_KB;
+  constexpr size_t kNumChunks = 256;
+
+  auto header_manager = GetMockHeaderManager();
+  HeaderManager* hm_ptr = header_manager.get();
+
+  auto env = yb::enterprise::NewEncryptedEnv(std::move(header_manager));
+  auto bytes = RandomBytes(kChunkSize);
+  Slice chunk(bytes.data(), kChunkSize);
+  std::vector<uint8_t> scratch(kChunkSize);
+
+  auto mb_per_second = [](MonoDelta passed) {
+    return kChunkSize * kNumChunks * 1.0 / 1_MB / passed.ToSeconds();
+  };
+
+  for (bool encrypted : {false, true}) {
+    down_cast<HeaderManagerMockImpl*>(hm_ptr)->SetFileEncryption(encrypted);
+
+    string fname;
+    std::unique_ptr<WritableFile> writable_file;
+    ASSERT_OK(env->NewTempWritableFile(
+        WritableFileOptions(), "test-fileXXXXXX", &fname, &writable_file));
+    auto start = MonoTime::Now();
+    for (size_t i = 0; i != kNumChunks; ++i) {
+      ASSERT_OK(writable_file->Append(chunk));
+    }
+    ASSERT_OK(writable_file->Close());
+    const auto write_time = MonoTime::Now() - start;
+
+    std::unique_ptr<RandomAccessFile> ra_file;
+    ASSERT_OK(env->NewRandomAccessFile(fname, &ra_file));
+    start = MonoTime::Now();
+    for (size_t i = 0; i != kNumChunks; ++i) {
+      Slice result;
+      ASSERT_OK(ra_file->Read(i * kChunkSize, kChunkSize, &result, scratch.data()));
+      ASSERT_EQ(result, chunk);
+    }
+    const auto read_time = MonoTime::Now() - start;
+
+    LOG(INFO) << (encrypted ? "Encrypted" : "Plain") << " write: "
+              << mb_per_second(write_time) << " MB/s, read: " << mb_per_second(read_time)
+              << " MB/s";
+
+    ASSERT_OK(env->DeleteFile(fname));
+  }
+}
+
 } // namespace enterprise
 } // namespace yb
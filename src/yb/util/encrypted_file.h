@@ -55,6 +55,10 @@ class EncryptedRandomAccessFile : public RandomAccessFileWrapper {
     return true;
   }
 
+  void Prefetch(uint64_t offset, size_t n) override {
+    RandomAccessFileWrapper::Prefetch(offset + header_size_, n);
+  }
+
   CHECKED_STATUS ReadAndValidate(
       uint64_t offset, size_t n, Slice* result, char* scratch,
       const ReadValidator& validator) override;
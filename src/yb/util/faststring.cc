@@ -32,12 +32,23 @@
 
 #include "yb/util/faststring.h"
 
+#include <stdlib.h>
+
 #include <glog/logging.h>
 
-#include "yb/gutil/gscoped_ptr.h"
 
 namespace yb {
 
+uint8_t* faststring::AllocateHeapData(size_t capacity) {
+  auto* block = static_cast<uint8_t*>(malloc(capacity + kReservedPrefixSize));
+  CHECK(block != nullptr);
+  return block + kReservedPrefixSize;
+}
+
+void faststring::FreeHeapData(uint8_t* data) {
+  free(data - kReservedPrefixSize);
+}
+
 void faststring::GrowByAtLeast(size_t count) {
   // Not enough space, need to reserve more.
   // Don't reserve exactly enough space for the new string -- that makes it
@@ -53,18 +64,18 @@ void faststring::GrowByAtLeast(size_t count) {
 
 void faststring::GrowArray(size_t newcapacity) {
   DCHECK_GE(newcapacity, capacity_);
-  gscoped_array<uint8_t> newdata(new uint8_t[newcapacity]);
+  uint8_t* newdata = AllocateHeapData(newcapacity);
   if (len_ > 0) {
-    memcpy(&newdata[0], &data_[0], len_);
+    memcpy(newdata, data_, len_);
   }
   capacity_ = newcapacity;
   if (data_ != initial_data_) {
-    delete[] data_;
+    FreeHeapData(data_);
   } else {
     ASAN_POISON_MEMORY_REGION(initial_data_, arraysize(initial_data_));
   }
 
-  data_ = newdata.release();
+  data_ = newdata;
   ASAN_POISON_MEMORY_REGION(data_ + len_, capacity_ - len_);
 }
 
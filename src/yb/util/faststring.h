@@ -57,7 +57,7 @@ class faststring {
       len_(0),
       capacity_(kInitialCapacity) {
     if (capacity > capacity_) {
-      data_ = new uint8_t[capacity];
+      data_ = AllocateHeapData(capacity);
       capacity_ = capacity;
     }
     ASAN_POISON_MEMORY_REGION(data_, capacity_);
@@ -66,7 +66,7 @@ class faststring {
   ~faststring() {
     ASAN_UNPOISON_MEMORY_REGION(initial_data_, arraysize(initial_data_));
     if (data_ != initial_data_) {
-      delete[] data_;
+      FreeHeapData(data_);
     }
   }
 
@@ -96,10 +96,11 @@ class faststring {
   //
   // NOTE: the data pointer returned by release() is not necessarily the pointer
   uint8_t *release() WARN_UNUSED_RESULT {
-    uint8_t *ret = data_;
-    if (ret == initial_data_) {
-      ret = new uint8_t[len_];
-      memcpy(ret, data_, len_);
+    // Heap data is preceded by the reserved prefix, so it cannot be released to the caller as is.
+    uint8_t *ret = new uint8_t[len_];
+    memcpy(ret, data_, len_);
+    if (data_ != initial_data_) {
+      FreeHeapData(data_);
     }
     len_ = 0;
     capacity_ = kInitialCapacity;
@@ -108,6 +109,28 @@ class faststring {
     return ret;
   }
 
+  // Size of the prefix reserved in front of the heap allocated data. It allows RefCntBuffer to
+  // adopt the heap block of a string, placing its header in the prefix, instead of copying the
+  // data. See ReleaseHeapBlock.
+  static constexpr size_t kReservedPrefixSize = 2 * sizeof(size_t);
+
+  // Releases the heap block of the string, when the data is stored in the heap and does not waste
+  // more than half of the block. The block starts kReservedPrefixSize bytes before the data, and
+  // should be freed with free(). Returns nullptr and leaves the string unchanged otherwise.
+  // After successful release the string is left empty.
+  uint8_t* ReleaseHeapBlock() {
+    if (data_ == initial_data_ || len_ < capacity_ / 2) {
+      return nullptr;
+    }
+    ASAN_UNPOISON_MEMORY_REGION(data_, capacity_);
+    uint8_t* result = data_ - kReservedPrefixSize;
+    len_ = 0;
+    capacity_ = kInitialCapacity;
+    data_ = initial_data_;
+    ASAN_POISON_MEMORY_REGION(data_, capacity_);
+    return result;
+  }
+
   // Reserve space for the given total amount of data. If the current capacity is already
   // larger than the newly requested capacity, this is a no-op (i.e. it does not ever free memory).
   //
@@ -257,6 +280,9 @@ class faststring {
   // the current capacity.
   void GrowArray(size_t newcapacity);
 
+  static uint8_t* AllocateHeapData(size_t capacity);
+  static void FreeHeapData(uint8_t* data);
+
   enum {
     kInitialCapacity = 32
   };
@@ -37,6 +37,10 @@ struct FileSystemOptions {
 
   // If true, then use mmap to read data.
   bool use_mmap_reads = false;
+
+  // If true, then bypass OS buffers using O_DIRECT, where it is supported. The file takes care of
+  // the alignment of the underlying I/O, so callers could use arbitrary offsets and sizes.
+  bool use_direct_io = false;
 };
 
 // Interface to filesystem.
@@ -176,6 +180,10 @@ class RandomAccessFile : public FileWithUniqueId {
 
   virtual void Hint(AccessPattern pattern) {}
 
+  // Asynchronously loads the specified range of the file to the OS page cache, so following reads
+  // of this range don't have to wait for the disk. Does nothing if it is not supported.
+  virtual void Prefetch(uint64_t offset, size_t n) {}
+
   // Remove any kind of caching of data from the offset to offset+length
   // of this file. If the length is 0, then it refers to the end of file.
   // If the system is not caching the file contents, then this is a noop.
@@ -238,6 +246,8 @@ class RandomAccessFileWrapper : public RandomAccessFile {
 
   void Hint(AccessPattern pattern) override { return target_->Hint(pattern); }
 
+  void Prefetch(uint64_t offset, size_t n) override { target_->Prefetch(offset, n); }
+
   Status InvalidateCache(size_t offset, size_t length) override {
     return target_->InvalidateCache(offset, length);
   }
@@ -16,6 +16,8 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
@@ -28,6 +30,9 @@
 #include <sys/syscall.h>
 #endif // __linux__
 
+#include <algorithm>
+#include <memory>
+
 #include "yb/util/coding.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/errno.h"
@@ -35,6 +40,7 @@
 #include "yb/util/thread_restrictions.h"
 
 DECLARE_bool(suicide_on_eio);
+DECLARE_int32(o_direct_block_alignment_bytes);
 
 // For platforms without fdatasync (like OS X)
 #ifndef fdatasync
@@ -159,7 +165,8 @@ Status PosixSequentialFile::InvalidateCache(size_t offset, size_t length) {
 
 PosixRandomAccessFile::PosixRandomAccessFile(const std::string& fname, int fd,
                                              const FileSystemOptions& options)
-    : filename_(fname), fd_(fd), use_os_buffer_(options.use_os_buffer) {
+    : filename_(fname), fd_(fd), use_os_buffer_(options.use_os_buffer),
+      use_direct_io_(options.use_direct_io) {
   assert(!options.use_mmap_reads || sizeof(void*) < 8);
 }
 
@@ -168,6 +175,9 @@ PosixRandomAccessFile::~PosixRandomAccessFile() { close(fd_); }
 Status PosixRandomAccessFile::Read(uint64_t offset, size_t n, Slice* result,
                                    uint8_t* scratch) const {
   ThreadRestrictions::AssertIOAllowed();
+  if (use_direct_io_) {
+    return ReadDirect(offset, n, result, scratch);
+  }
   Status s;
   ssize_t r = -1;
   size_t left = n;
@@ -199,6 +209,45 @@ Status PosixRandomAccessFile::Read(uint64_t offset, size_t n, Slice* result,
   return s;
 }
 
+Status PosixRandomAccessFile::ReadDirect(uint64_t offset, size_t n, Slice* result,
+                                         uint8_t* scratch) const {
+  // O_DIRECT requires the file offset, the size and the memory of the read to be aligned, so the
+  // aligned range that covers the requested one is read to a temporary aligned buffer.
+  const size_t alignment = FLAGS_o_direct_block_alignment_bytes;
+  const uint64_t aligned_offset = offset - offset % alignment;
+  const size_t prefix = offset - aligned_offset;
+  const size_t aligned_size = (prefix + n + alignment - 1) / alignment * alignment;
+  void* buffer = nullptr;
+  int err = posix_memalign(&buffer, alignment, aligned_size);
+  if (err != 0) {
+    return STATUS_IO_ERROR(filename_, err);
+  }
+  std::unique_ptr<uint8_t, decltype(&free)> buffer_holder(static_cast<uint8_t*>(buffer), &free);
+
+  size_t done = 0;
+  while (done < aligned_size) {
+    ssize_t r = pread(fd_, buffer_holder.get() + done, aligned_size - done,
+                      static_cast<off_t>(aligned_offset + done));
+    if (r < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      *result = Slice(scratch, 0);
+      return STATUS_IO_ERROR(filename_, errno);
+    }
+    done += r;
+    // Unaligned read means that the end of the file was reached.
+    if (r == 0 || r % alignment != 0) {
+      break;
+    }
+  }
+
+  const size_t size = done > prefix ? std::min(done - prefix, n) : 0;
+  memcpy(scratch, buffer_holder.get() + prefix, size);
+  *result = Slice(scratch, size);
+  return Status::OK();
+}
+
 Result<uint64_t> PosixRandomAccessFile::Size() const {
   TRACE_EVENT1("io", __PRETTY_FUNCTION__, "path", filename_);
   ThreadRestrictions::AssertIOAllowed();
@@ -252,6 +301,14 @@ void PosixRandomAccessFile::Hint(AccessPattern pattern) {
   }
 }
 
+void PosixRandomAccessFile::Prefetch(uint64_t offset, size_t n) {
+  if (use_direct_io_) {
+    return;
+  }
+  // On Linux WILLNEED initiates a non-blocking read of the range into the page cache.
+  Fadvise(fd_, offset, n, POSIX_FADV_WILLNEED);
+}
+
 Status PosixRandomAccessFile::InvalidateCache(size_t offset, size_t length) {
 #ifndef __linux__
   return Status::OK();
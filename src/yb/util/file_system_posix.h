@@ -62,12 +62,17 @@ class PosixRandomAccessFile : public RandomAccessFile {
   virtual size_t GetUniqueId(char* id) const override;
 #endif
   virtual void Hint(AccessPattern pattern) override;
+  void Prefetch(uint64_t offset, size_t n) override;
   virtual CHECKED_STATUS InvalidateCache(size_t offset, size_t length) override;
 
  private:
+  // Read for the file opened with O_DIRECT.
+  CHECKED_STATUS ReadDirect(uint64_t offset, size_t n, Slice* result, uint8_t* scratch) const;
+
   std::string filename_;
   int fd_;
   bool use_os_buffer_;
+  bool use_direct_io_;
 };
 
 } // namespace yb
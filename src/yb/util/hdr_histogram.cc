@@ -59,10 +59,8 @@ HdrHistogram::HdrHistogram(uint64_t highest_trackable_value, int num_significant
     sub_bucket_half_count_magnitude_(0),
     sub_bucket_half_count_(0),
     sub_bucket_mask_(0),
-    total_count_(0),
-    total_sum_(0),
-    current_count_(0),
-    current_sum_(0),
+    reset_count_(0),
+    reset_sum_(0),
     min_value_(std::numeric_limits<Atomic64>::max()),
     max_value_(0),
     counts_(nullptr) {
@@ -78,10 +76,8 @@ HdrHistogram::HdrHistogram(const HdrHistogram& other)
     sub_bucket_half_count_magnitude_(0),
     sub_bucket_half_count_(0),
     sub_bucket_mask_(0),
-    total_count_(0),
-    total_sum_(0),
-    current_count_(0),
-    current_sum_(0),
+    reset_count_(0),
+    reset_sum_(0),
     min_value_(std::numeric_limits<Atomic64>::max()),
     max_value_(0),
     counts_(nullptr) {
@@ -89,8 +85,8 @@ HdrHistogram::HdrHistogram(const HdrHistogram& other)
 
   // Not a consistent snapshot but we try to roughly keep it close.
   // Copy the sum and min first.
-  NoBarrier_Store(&total_sum_, NoBarrier_Load(&other.total_sum_));
-  NoBarrier_Store(&current_sum_, NoBarrier_Load(&other.current_sum_));
+  total_sum_.IncrementBy(other.TotalSum());
+  NoBarrier_Store(&reset_sum_, NoBarrier_Load(&other.reset_sum_));
   NoBarrier_Store(&min_value_, NoBarrier_Load(&other.min_value_));
 
   uint64_t total_copied_count = 0;
@@ -102,17 +98,18 @@ HdrHistogram::HdrHistogram(const HdrHistogram& other)
   }
   // Copy the max observed value last.
   NoBarrier_Store(&max_value_, NoBarrier_Load(&other.max_value_));
-  // We must ensure the total is consistent with the copied counts.
-  NoBarrier_Store(&total_count_, NoBarrier_Load(&other.total_count_));
-  NoBarrier_Store(&current_count_, total_copied_count);
+  // We must ensure the current count is consistent with the copied counts.
+  const uint64_t total_count = other.TotalCount();
+  total_count_.IncrementBy(total_count);
+  NoBarrier_Store(&reset_count_, total_count - total_copied_count);
 }
 
 void HdrHistogram::ResetPercentiles() {
   for (int i = 0; i < counts_array_length_; i++) {
     NoBarrier_Store(&counts_[i], 0);
   }
-  NoBarrier_Store(&current_count_, 0);
-  NoBarrier_Store(&current_sum_, 0);
+  NoBarrier_Store(&reset_count_, TotalCount());
+  NoBarrier_Store(&reset_sum_, TotalSum());
 
   NoBarrier_Store(&min_value_, std::numeric_limits<Atomic64>::max());
   NoBarrier_Store(&max_value_, 0);
@@ -186,12 +183,10 @@ void HdrHistogram::IncrementBy(int64_t value, int64_t count) {
   int sub_bucket_index = SubBucketIndex(value, bucket_index);
   int counts_index = CountsArrayIndex(bucket_index, sub_bucket_index);
 
-  // Increment bucket, total, and sum.
+  // Increment bucket, total, and sum. Current count and sum are derived from the totals.
   NoBarrier_AtomicIncrement(&counts_[counts_index], count);
-  NoBarrier_AtomicIncrement(&total_count_, count);
-  NoBarrier_AtomicIncrement(&current_count_, count);
-  NoBarrier_AtomicIncrement(&total_sum_, value * count);
-  NoBarrier_AtomicIncrement(&current_sum_, value * count);
+  total_count_.IncrementBy(count);
+  total_sum_.IncrementBy(value * count);
 
   // Update min, if needed.
   {
@@ -62,6 +62,7 @@
 #include "yb/gutil/atomicops.h"
 #include "yb/gutil/gscoped_ptr.h"
 #include "yb/util/status.h"
+#include "yb/util/striped64.h"
 
 namespace yb {
 
@@ -114,21 +115,21 @@ class HdrHistogram {
   int SubBucketIndex(uint64_t value, int bucket_index) const;
 
   // Count of all events recorded.
-  uint64_t TotalCount() const { return base::subtle::NoBarrier_Load(&total_count_); }
+  uint64_t TotalCount() const { return total_count_.Value(); }
 
   // Count of all events recorded since last Reset. Resets to 0 after
   // ResetPercentiles.
   uint64_t CurrentCount() const {
-    return base::subtle::NoBarrier_Load(&current_count_);
+    return TotalCount() - base::subtle::NoBarrier_Load(&reset_count_);
   }
 
   // Sum of all events recorded.
-  uint64_t TotalSum() const { return base::subtle::NoBarrier_Load(&total_sum_); }
+  uint64_t TotalSum() const { return total_sum_.Value(); }
 
   // Sum of all events recorded since last Reset. Resets to 0 after
   // ResetPercentiles.
   uint64_t CurrentSum() const {
-    return base::subtle::NoBarrier_Load(&current_sum_);
+    return TotalSum() - base::subtle::NoBarrier_Load(&reset_sum_);
   }
 
   // Return number of items at index.
@@ -218,12 +219,13 @@ class HdrHistogram {
   uint32_t sub_bucket_mask_;
 
   // Also hot.
-  // Non-resetting sum and counts.
-  base::subtle::Atomic64 total_count_;
-  base::subtle::Atomic64 total_sum_;
-  // Resetting values
-  base::subtle::Atomic64 current_count_;
-  base::subtle::Atomic64 current_sum_;
+  // Non-resetting sum and counts. They are updated by every increment, so they are striped to
+  // avoid contention between threads, and are merged on read.
+  LongAdder total_count_;
+  LongAdder total_sum_;
+  // Values of the total count and sum at the last reset, "current" values are the difference.
+  base::subtle::Atomic64 reset_count_;
+  base::subtle::Atomic64 reset_sum_;
   base::subtle::Atomic64 min_value_;
   base::subtle::Atomic64 max_value_;
   gscoped_array<base::subtle::Atomic64> counts_;
@@ -46,6 +46,7 @@
 #include <signal.h>
 #include <stdio.h>
 
+#include <algorithm>
 #include <sstream>
 #include <iostream>
 #include <fstream>
@@ -61,6 +62,7 @@
 #include "yb/gutil/spinlock.h"
 #include "yb/gutil/ref_counted.h"
 
+#include "yb/util/async_logger.h"
 #include "yb/util/debug-util.h"
 #include "yb/util/flag_tags.h"
 
@@ -79,6 +81,18 @@ DEFINE_string(ref_counted_debug_type_name_regex, "",
               "Regex for type names for debugging RefCounted / scoped_refptr based classes. "
               "An empty string disables RefCounted debug logging.");
 
+DEFINE_bool(async_logging, false,
+            "Whether INFO and WARNING messages are written to log files by a background thread, "
+            "so a slow log device does not block threads that log. ERROR and FATAL messages are "
+            "always written synchronously. Buffered messages are lost if the process is killed "
+            "by a signal.");
+TAG_FLAG(async_logging, advanced);
+
+DEFINE_int32(async_logging_buffer_messages, 8192,
+             "Maximum number of messages buffered by each async logger. Messages logged while the "
+             "buffer is full are dropped and counted.");
+TAG_FLAG(async_logging_buffer_messages, advanced);
+
 const char* kProjName = "yb";
 
 bool logging_initialized = false;
@@ -282,6 +296,10 @@ void InitGoogleLoggingSafe(const char* arg) {
 
   InitializeGoogleLogging(arg);
 
+  if (FLAGS_async_logging && !FLAGS_logtostderr) {
+    InstallAsyncLoggers(std::max(FLAGS_async_logging_buffer_messages, 1));
+  }
+
   // Needs to be done after InitGoogleLogging
   if (FLAGS_log_filename.empty()) {
     CHECK_STRNE(google::ProgramInvocationShortName(), "UNKNOWN")
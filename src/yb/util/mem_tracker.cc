@@ -249,7 +249,7 @@ void MemTracker::CreateRootTracker() {
   LOG(INFO) << StringPrintf("MemTracker: hard memory limit is %.6f GB",
                             (static_cast<float>(limit) / (1024.0 * 1024.0 * 1024.0)));
   LOG(INFO) << StringPrintf("MemTracker: soft memory limit is %.6f GB",
-                            (static_cast<float>(root_tracker->soft_limit_) /
+                            (static_cast<float>(root_tracker->soft_limit()) /
                                 (1024.0 * 1024.0 * 1024.0)));
 }
 
@@ -298,7 +298,8 @@ MemTracker::MemTracker(int64_t byte_limit, const string& id,
                        ConsumptionFunctor consumption_functor, std::shared_ptr<MemTracker> parent,
                        AddToParent add_to_parent, CreateMetrics create_metrics)
     : limit_(byte_limit),
-      soft_limit_(limit_ == -1 ? -1 : (limit_ * FLAGS_memory_limit_soft_percentage) / 100),
+      soft_limit_(
+          byte_limit == -1 ? -1 : (byte_limit * FLAGS_memory_limit_soft_percentage) / 100),
       id_(id),
       consumption_functor_(std::move(consumption_functor)),
       descr_(Substitute("memory consumption for $0", id)),
@@ -497,15 +498,16 @@ bool MemTracker::TryConsume(int64_t bytes, MemTracker** blocking_mem_tracker) {
   // won't accommodate the change.
   for (i = all_trackers_.size() - 1; i >= 0; --i) {
     MemTracker *tracker = all_trackers_[i];
-    if (tracker->limit_ < 0) {
+    const auto limit = tracker->limit();
+    if (limit < 0) {
       IncrementBy(bytes, &tracker->consumption_, tracker->metrics_);
     } else {
-      if (!TryIncrementBy(bytes, tracker->limit_, &tracker->consumption_, tracker->metrics_)) {
+      if (!TryIncrementBy(bytes, limit, &tracker->consumption_, tracker->metrics_)) {
         // One of the trackers failed, attempt to GC memory or expand our limit. If that
         // succeeds, TryUpdate() again. Bail if either fails.
-        if (!tracker->GcMemory(tracker->limit_ - bytes) ||
+        if (!tracker->GcMemory(limit - bytes) ||
             tracker->ExpandLimit(bytes)) {
-          if (!TryIncrementBy(bytes, tracker->limit_, &tracker->consumption_, tracker->metrics_)) {
+          if (!TryIncrementBy(bytes, limit, &tracker->consumption_, tracker->metrics_)) {
             break;
           }
         } else {
@@ -585,11 +587,22 @@ bool MemTracker::AnyLimitExceeded() {
 
 bool MemTracker::LimitExceeded() {
   if (PREDICT_FALSE(CheckLimitExceeded())) {
-    return GcMemory(limit_);
+    return GcMemory(limit());
   }
   return false;
 }
 
+void MemTracker::SetLimit(int64_t byte_limit) {
+  if (!has_limit() || byte_limit < 0) {
+    LOG(DFATAL) << "Cannot change limit of " << ToString() << " to " << byte_limit;
+    return;
+  }
+  soft_limit_.store(
+      (byte_limit * FLAGS_memory_limit_soft_percentage) / 100, std::memory_order_relaxed);
+  limit_.store(byte_limit, std::memory_order_relaxed);
+  GcMemory(byte_limit);
+}
+
 SoftLimitExceededResult MemTracker::SoftLimitExceeded(double score) {
   // Did we exceed the actual limit?
   if (LimitExceeded()) {
@@ -597,13 +610,15 @@ SoftLimitExceededResult MemTracker::SoftLimitExceeded(double score) {
   }
 
   // No soft limit defined.
-  if (!has_limit() || limit_ == soft_limit_) {
+  const auto limit = this->limit();
+  const auto soft_limit = this->soft_limit();
+  if (limit < 0 || limit == soft_limit) {
     return {false, 0.0};
   }
 
   // Are we under the soft limit threshold?
   int64_t usage = consumption();
-  if (usage < soft_limit_) {
+  if (usage < soft_limit) {
     return {false, 0.0};
   }
 
@@ -611,8 +626,8 @@ SoftLimitExceededResult MemTracker::SoftLimitExceeded(double score) {
   if (score == 0.0) {
     score = RandomUniformReal<double>();
   }
-  if (usage + (limit_ - soft_limit_) * score > limit_ && GcMemory(soft_limit_)) {
-    return {true, usage * 100.0 / limit()};
+  if (usage + (limit - soft_limit) * score > limit && GcMemory(soft_limit)) {
+    return {true, usage * 100.0 / limit};
   }
   return {false, 0.0};
 }
@@ -743,8 +758,9 @@ string MemTracker::LogUsage(const string& prefix, size_t usage_threshold, int in
   if (CheckLimitExceeded()) {
     ss << " memory limit exceeded.";
   }
-  if (limit_ > 0) {
-    ss << " Limit=" << HumanReadableNumBytes::ToString(limit_);
+  const auto limit = this->limit();
+  if (limit > 0) {
+    ss << " Limit=" << HumanReadableNumBytes::ToString(limit);
   }
   ss << " Consumption=" << HumanReadableNumBytes::ToString(consumption());
 
@@ -765,7 +781,7 @@ string MemTracker::LogUsage(const string& prefix, size_t usage_threshold, int in
 void MemTracker::LogUpdate(bool is_consume, int64_t bytes) const {
   stringstream ss;
   ss << this << " " << (is_consume ? "Consume: " : "Release: ") << bytes
-     << " Consumption: " << consumption() << " Limit: " << limit_;
+     << " Consumption: " << consumption() << " Limit: " << limit();
   if (log_stack_) {
     ss << std::endl << GetStackTrace();
   }
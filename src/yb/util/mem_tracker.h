@@ -34,6 +34,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <string>
@@ -314,8 +315,13 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
   int64_t SpareCapacity() const;
 
 
-  int64_t limit() const { return limit_; }
-  bool has_limit() const { return limit_ >= 0; }
+  int64_t limit() const { return limit_.load(std::memory_order_relaxed); }
+  bool has_limit() const { return limit() >= 0; }
+
+  // Changes the limit of a tracker that was created with a limit, the soft limit is scaled
+  // accordingly. If consumption is above the new limit, GC functions are called to free memory.
+  // Trackers without a limit could not get one, because descendants cache trackers with limits.
+  void SetLimit(int64_t byte_limit);
   const std::string& id() const { return id_; }
 
   // Returns the memory consumed in bytes.
@@ -373,7 +379,8 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
 
  private:
   bool CheckLimitExceeded() const {
-    return limit_ >= 0 && limit_ < consumption();
+    auto limit = this->limit();
+    return limit >= 0 && limit < consumption();
   }
 
   // If consumption is higher than max_consumption, attempts to free memory by calling any
@@ -416,8 +423,10 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
   // TODO: this is a stopgap.
   static const int64_t GC_RELEASE_SIZE = 128 * 1024L * 1024L;
 
-  const int64_t limit_;
-  const int64_t soft_limit_;
+  int64_t soft_limit() const { return soft_limit_.load(std::memory_order_relaxed); }
+
+  std::atomic<int64_t> limit_;
+  std::atomic<int64_t> soft_limit_;
   const std::string id_;
   const ConsumptionFunctor consumption_functor_;
   PollChildrenConsumptionFunctors poll_children_consumption_functors_;
@@ -56,6 +56,7 @@ DECLARE_int32(metrics_retirement_age_ms);
 namespace yb {
 
 METRIC_DEFINE_entity(test_entity);
+METRIC_DEFINE_entity(tablet);
 
 class MetricsTest : public YBTest {
  public:
@@ -265,6 +266,61 @@ TEST_F(MetricsTest, JsonPrintTest) {
   ASSERT_EQ("", out.str());
 }
 
+METRIC_DEFINE_counter(tablet, tablet_reqs, "Tablet Requests", MetricUnit::kRequests,
+                      "Number of tablet requests");
+METRIC_DEFINE_counter(server, server_reqs, "Server Requests", MetricUnit::kRequests,
+                      "Number of server requests");
+
+TEST_F(MetricsTest, PrometheusTest) {
+  MetricEntity::AttributeMap attrs = {{"table_id", "table-id"}, {"table_name", "test_table"}};
+  auto tablet1 = METRIC_ENTITY_tablet.Instantiate(&registry_, "tablet-1", attrs);
+  auto tablet2 = METRIC_ENTITY_tablet.Instantiate(&registry_, "tablet-2", attrs);
+  METRIC_tablet_reqs.Instantiate(tablet1)->IncrementBy(1);
+  METRIC_tablet_reqs.Instantiate(tablet2)->IncrementBy(2);
+  auto server = METRIC_ENTITY_server.Instantiate(&registry_, "yb.test");
+  METRIC_server_reqs.Instantiate(server)->IncrementBy(5);
+
+  // Returns the exported lines, that contain the specified substring.
+  auto write = [this](PrometheusAggregationLevel level, const MetricPrometheusOptions& opts,
+                      const string& substr) {
+    std::stringstream out;
+    PrometheusWriter writer(&out, level);
+    CHECK_OK(registry_.WriteForPrometheus(&writer, opts));
+    vector<string> result;
+    string line;
+    while (std::getline(out, line)) {
+      if (line.find(substr) != string::npos) {
+        result.push_back(line);
+      }
+    }
+    return result;
+  };
+
+  // Tablet metrics are summed up per table, including the first tablet seen.
+  auto lines = write(PrometheusAggregationLevel::kTable, MetricPrometheusOptions(), "tablet_reqs");
+  ASSERT_EQ(1, lines.size());
+  ASSERT_STR_CONTAINS(lines[0], "table_name=\"test_table\"");
+  ASSERT_STR_CONTAINS(lines[0], "} 3 ");
+  ASSERT_EQ(string::npos, lines[0].find("tablet-1"));
+  ASSERT_EQ(1, write(PrometheusAggregationLevel::kTable, MetricPrometheusOptions(),
+                     "server_reqs").size());
+
+  lines = write(PrometheusAggregationLevel::kTablet, MetricPrometheusOptions(), "tablet-2");
+  ASSERT_EQ(1, lines.size());
+  ASSERT_STR_CONTAINS(lines[0], "metric_id=\"tablet-2\"");
+  ASSERT_STR_CONTAINS(lines[0], "} 2 ");
+
+  MetricPrometheusOptions opts;
+  opts.metrics = {"server"};
+  ASSERT_EQ(0, write(PrometheusAggregationLevel::kTable, opts, "tablet_reqs").size());
+  ASSERT_EQ(1, write(PrometheusAggregationLevel::kTable, opts, "server_reqs").size());
+
+  opts = MetricPrometheusOptions();
+  opts.entity_types = {"tablet"};
+  ASSERT_EQ(1, write(PrometheusAggregationLevel::kTable, opts, "tablet_reqs").size());
+  ASSERT_EQ(0, write(PrometheusAggregationLevel::kTable, opts, "server_reqs").size());
+}
+
 // Test that metrics are retired when they are no longer referenced.
 TEST_F(MetricsTest, RetirementTest) {
   FLAGS_metrics_retirement_age_ms = 100;
@@ -358,7 +414,7 @@ TEST_F(MetricsTest, TestDumpJsonPrototypes) {
   int num_entities = d["entities"].Size();
   LOG(INFO) << "Parsed " << num_metrics << " metrics and " << num_entities << " entities";
   ASSERT_GT(num_metrics, 5);
-  ASSERT_EQ(num_entities, 2);
+  ASSERT_EQ(num_entities, 3);
 
   // Spot-check that some metrics were properly registered and that the JSON was properly
   // formed.
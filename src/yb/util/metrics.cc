@@ -31,6 +31,7 @@
 //
 #include "yb/util/metrics.h"
 
+#include <algorithm>
 #include <iostream>
 #include <map>
 #include <regex>
@@ -288,7 +289,14 @@ Status MetricEntity::WriteAsJson(JsonWriter* writer,
   return Status::OK();
 }
 
-CHECKED_STATUS MetricEntity::WriteForPrometheus(PrometheusWriter* writer) const {
+CHECKED_STATUS MetricEntity::WriteForPrometheus(
+    PrometheusWriter* writer, const MetricPrometheusOptions& opts) const {
+  if (!opts.entity_types.empty() &&
+      std::find(opts.entity_types.begin(), opts.entity_types.end(), prototype_->name()) ==
+          opts.entity_types.end()) {
+    return Status::OK();
+  }
+  const bool select_all = MatchMetricInList("*", opts.metrics);
   // We want the keys to be in alphabetical order when printing, so we use an ordered map here.
   typedef std::map<const char*, scoped_refptr<Metric> > OrderedMetricMap;
   OrderedMetricMap metrics;
@@ -304,15 +312,20 @@ CHECKED_STATUS MetricEntity::WriteForPrometheus(PrometheusWriter* writer) const
       const MetricPrototype* prototype = val.first;
       const scoped_refptr<Metric>& metric = val.second;
 
-      InsertOrDie(&metrics, prototype->name(), metric);
+      if (select_all || MatchMetricInList(prototype->name(), opts.metrics)) {
+        InsertOrDie(&metrics, prototype->name(), metric);
+      }
     }
   }
   AttributeMap prometheus_attr;
   // Per tablet metrics come with tablet_id, as well as table_id and table_name attributes.
-  // We ignore the tablet part to squash at the table level.
+  // Unless requested per tablet, we ignore the tablet part to squash at the table level.
   if (strcmp(prototype_->name(), "tablet") == 0)  {
     prometheus_attr["table_id"] = attrs["table_id"];
     prometheus_attr["table_name"] = attrs["table_name"];
+    if (writer->aggregation_level() == PrometheusAggregationLevel::kTablet) {
+      prometheus_attr["metric_id"] = id_;
+    }
   } else if (strcmp(prototype_->name(), "server") == 0 ||
       strcmp(prototype_->name(), "cluster") == 0) {
     prometheus_attr = attrs;
@@ -330,9 +343,12 @@ CHECKED_STATUS MetricEntity::WriteForPrometheus(PrometheusWriter* writer) const
                 strings::Substitute("Failed to write $0 as Prometheus", val.first));
 
   }
-  // Run the external metrics collection callback if there is one set.
-  for (const ExternalPrometheusMetricsCb& cb : external_metrics_cbs) {
-    cb(writer);
+  // Run the external metrics collection callback if there is one set. External metrics could not be
+  // filtered by name, so they are skipped when only specific metrics are requested.
+  if (select_all) {
+    for (const ExternalPrometheusMetricsCb& cb : external_metrics_cbs) {
+      cb(writer);
+    }
   }
 
   return Status::OK();
@@ -453,7 +469,8 @@ Status MetricRegistry::WriteAsJson(JsonWriter* writer,
   return Status::OK();
 }
 
-CHECKED_STATUS MetricRegistry::WriteForPrometheus(PrometheusWriter* writer) const {
+CHECKED_STATUS MetricRegistry::WriteForPrometheus(
+    PrometheusWriter* writer, const MetricPrometheusOptions& opts) const {
   EntityMap entities;
   {
     std::lock_guard<simple_spinlock> l(lock_);
@@ -465,7 +482,7 @@ CHECKED_STATUS MetricRegistry::WriteForPrometheus(PrometheusWriter* writer) cons
       continue;
     }
 
-    WARN_NOT_OK(e.second->WriteForPrometheus(writer),
+    WARN_NOT_OK(e.second->WriteForPrometheus(writer, opts),
                 Substitute("Failed to write entity $0 as Prometheus", e.second->id()));
   }
   RETURN_NOT_OK(writer->FlushAggregatedValues());
@@ -259,6 +259,7 @@
 #include "yb/gutil/singleton.h"
 
 #include "yb/util/atomic.h"
+#include "yb/util/enums.h"
 #include "yb/util/jsonwriter.h"
 #include "yb/util/locks.h"
 #include "yb/util/monotime.h"
@@ -456,6 +457,24 @@ struct MetricJsonOptions {
   bool include_schema_info;
 };
 
+// Level at which per tablet metrics are exported for Prometheus.
+YB_DEFINE_ENUM(PrometheusAggregationLevel,
+    // Metrics of all tablets of a table are summed up and exported once per table.
+    (kTable)
+    // Metrics are exported per tablet, labeled with the tablet id in metric_id.
+    (kTablet));
+
+struct MetricPrometheusOptions {
+  // Substrings to match metric names against, where '*' matches all metrics.
+  // External metrics, e.g. RocksDB statistics, are exported only when all metrics are requested.
+  // Default: all metrics.
+  std::vector<std::string> metrics = {"*"};
+
+  // Types of entities to export, e.g. tablet, server or cluster.
+  // Default: empty, i.e. all entity types.
+  std::vector<std::string> entity_types;
+};
+
 class MetricEntityPrototype {
  public:
   explicit MetricEntityPrototype(const char* name);
@@ -518,7 +537,10 @@ class MetricEntity : public RefCountedThreadSafe<MetricEntity> {
                      const std::vector<std::string>& requested_metrics,
                      const MetricJsonOptions& opts) const;
 
-  CHECKED_STATUS WriteForPrometheus(PrometheusWriter* writer) const;
+  // See MetricRegistry::WriteForPrometheus()
+  CHECKED_STATUS WriteForPrometheus(
+      PrometheusWriter* writer,
+      const MetricPrometheusOptions& opts = MetricPrometheusOptions()) const;
 
   const MetricMap& UnsafeMetricsMapForTests() const { return metric_map_; }
 
@@ -598,8 +620,11 @@ typedef scoped_refptr<MetricEntity> MetricEntityPtr;
 
 class PrometheusWriter {
  public:
-  explicit PrometheusWriter(std::stringstream* output)
+  explicit PrometheusWriter(
+      std::stringstream* output,
+      PrometheusAggregationLevel aggregation_level = PrometheusAggregationLevel::kTable)
     : output_(output),
+      aggregation_level_(aggregation_level),
       timestamp_(std::chrono::duration_cast<std::chrono::milliseconds>(
           std::chrono::system_clock::now().time_since_epoch()).count()) {}
 
@@ -609,15 +634,13 @@ class PrometheusWriter {
   CHECKED_STATUS WriteSingleEntry(
       const MetricEntity::AttributeMap& attr, const std::string& name, const T& value) {
     auto it = attr.find("table_id");
-    if (it != attr.end()) {
+    if (it != attr.end() && aggregation_level_ == PrometheusAggregationLevel::kTable) {
       // For tablet level metrics, we roll up on the table level.
       if (per_table_attributes_.find(it->second) == per_table_attributes_.end()) {
         // If it's the first time we see this table, create the aggregate structures.
         per_table_attributes_[it->second] = attr;
-        per_table_values_[it->second];
-      } else {
-        per_table_values_[it->second][name] += value;
       }
+      per_table_values_[it->second][name] += value;
     } else {
       // For non-tablet level metrics, export them directly.
       RETURN_NOT_OK(FlushSingleEntry(attr, name, value));
@@ -635,6 +658,8 @@ class PrometheusWriter {
     return Status::OK();
   }
 
+  PrometheusAggregationLevel aggregation_level() const { return aggregation_level_; }
+
  private:
   // FlushSingleEntry() was a function template with type of "value" as template
   // var T. To allow NMSWriter to override FlushSingleEntry(), the type of "value"
@@ -665,6 +690,8 @@ class PrometheusWriter {
   std::map<std::string, std::map<std::string, double>> per_table_values_;
   // Output stream
   std::stringstream* output_;
+  // Level at which tablet metrics are exported.
+  PrometheusAggregationLevel aggregation_level_;
   // Timestamp for all metrics belonging to this writer instance.
   int64_t timestamp_;
 };
@@ -767,7 +794,13 @@ class MetricRegistry {
                      const std::vector<std::string>& requested_metrics,
                      const MetricJsonOptions& opts) const;
 
-  CHECKED_STATUS WriteForPrometheus(PrometheusWriter* writer) const;
+  // Writes metrics in this registry to 'writer' in Prometheus text format.
+  //
+  // See the MetricPrometheusOptions struct definition above for options filtering the
+  // exported entities and metrics.
+  CHECKED_STATUS WriteForPrometheus(
+      PrometheusWriter* writer,
+      const MetricPrometheusOptions& opts = MetricPrometheusOptions()) const;
 
   // For each registered entity, retires orphaned metrics. If an entity has no more
   // metrics and there are no external references, entities are removed as well.
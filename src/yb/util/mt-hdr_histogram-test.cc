@@ -38,6 +38,7 @@
 #include "yb/gutil/strings/substitute.h"
 #include "yb/util/hdr_histogram.h"
 #include "yb/util/status.h"
+#include "yb/util/stopwatch.h"
 #include "yb/util/test_util.h"
 #include "yb/util/thread.h"
 
@@ -89,6 +90,43 @@ TEST_F(MtHdrHistogramTest, ConcurrentWriteTest) {
   delete[] threads;
 }
 
+// Increment values spread over the whole range of the histogram, like latencies do.
+static void IncrementSpreadHistValues(HdrHistogram* hist, uint64_t times) {
+  for (uint64_t i = 0; i < times; i++) {
+    hist->Increment((i * 7919) % hist->highest_trackable_value());
+  }
+}
+
+TEST_F(MtHdrHistogramTest, ConcurrentWritePerf) {
+  HdrHistogram hist(60000000LU, 2);
+
+  Stopwatch sw;
+  sw.start();
+  auto threads = new scoped_refptr<yb::Thread>[num_threads_];
+  for (int i = 0; i < num_threads_; i++) {
+    CHECK_OK(yb::Thread::Create("test", strings::Substitute("thread-$0", i),
+        IncrementSpreadHistValues, &hist, num_times_, &threads[i]));
+  }
+  for (int i = 0; i < num_threads_; i++) {
+    CHECK_OK(ThreadJoiner(threads[i].get()).Join());
+  }
+  sw.stop();
+
+  const uint64_t total = num_threads_ * num_times_;
+  LOG(INFO) << num_threads_ << " threads did " << total << " increments in "
+            << sw.elapsed().wall_seconds() << "s, "
+            << total / std::max(sw.elapsed().wall_seconds(), 1e-9) << " increments/s";
+  ASSERT_EQ(total, hist.TotalCount());
+  ASSERT_EQ(total, hist.CurrentCount());
+
+  hist.ResetPercentiles();
+  ASSERT_EQ(total, hist.TotalCount());
+  ASSERT_EQ(0, hist.CurrentCount());
+  ASSERT_EQ(0, hist.CurrentSum());
+
+  delete[] threads;
+}
+
 // Copy while writing, then iterate to ensure copies are consistent.
 TEST_F(MtHdrHistogramTest, ConcurrentCopyWhileWritingTest) {
   const int kNumCopies = 10;
@@ -0,0 +1,189 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/util/numa.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include <glog/logging.h>
+
+#include "yb/gutil/strings/numbers.h"
+#include "yb/gutil/strings/split.h"
+#include "yb/gutil/strings/strip.h"
+#include "yb/gutil/strings/util.h"
+
+#include "yb/util/env.h"
+#include "yb/util/errno.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/format.h"
+
+DEFINE_bool(numa_aware_placement, false,
+            "Bind rpc reactors and workers of their rpc thread pool shards to NUMA nodes, so "
+            "buffers of the calls they handle are allocated on the node that runs them. Has no "
+            "effect on machines with a single NUMA node.");
+TAG_FLAG(numa_aware_placement, advanced);
+
+namespace yb {
+
+namespace {
+
+const std::string kNodesDir = "/sys/devices/system/node";
+
+thread_local int current_thread_numa_node = -1;
+
+struct NumaNode {
+  // Id of the node in sysfs, ids could be sparse.
+  int id;
+  std::vector<int> cpus;
+};
+
+Result<std::string> ReadSysFile(const std::string& path) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    return STATUS_FORMAT(IOError, "Could not open $0", path);
+  }
+  std::stringstream result;
+  result << file.rdbuf();
+  return result.str();
+}
+
+Result<std::vector<int>> ReadCpuList(const std::string& path) {
+  return ParseCpuList(VERIFY_RESULT(ReadSysFile(path)));
+}
+
+std::vector<NumaNode> LoadNumaNodes() {
+  std::vector<NumaNode> result;
+  std::vector<std::string> children;
+  if (!Env::Default()->GetChildren(kNodesDir, ExcludeDots::kTrue, &children).ok()) {
+    return result;
+  }
+  for (const auto& child : children) {
+    int32 id;
+    if (!HasPrefixString(child, "node") || !safe_strto32(child.substr(4), &id)) {
+      continue;
+    }
+    auto cpus = ReadCpuList(Format("$0/$1/cpulist", kNodesDir, child));
+    if (!cpus.ok()) {
+      LOG(WARNING) << "Failed to read CPUs of NUMA node " << id << ": " << cpus.status();
+      return std::vector<NumaNode>();
+    }
+    // Nodes with memory only could not run threads.
+    if (!cpus->empty()) {
+      result.push_back(NumaNode{id, std::move(*cpus)});
+    }
+  }
+  std::sort(result.begin(), result.end(), [](const NumaNode& lhs, const NumaNode& rhs) {
+    return lhs.id < rhs.id;
+  });
+  return result;
+}
+
+const std::vector<NumaNode>& NumaNodes() {
+  static const std::vector<NumaNode> nodes = LoadNumaNodes();
+  return nodes;
+}
+
+} // namespace
+
+size_t NumNumaNodes() {
+  return std::max<size_t>(NumaNodes().size(), 1);
+}
+
+bool NumaPlacementEnabled() {
+  return FLAGS_numa_aware_placement && NumaNodes().size() > 1;
+}
+
+Status BindCurrentThreadToNumaNode(size_t node) {
+  const auto& nodes = NumaNodes();
+  if (node >= nodes.size()) {
+    return STATUS_FORMAT(InvalidArgument, "NUMA node $0 is out of range, known nodes: $1",
+                         node, nodes.size());
+  }
+#if defined(__linux__)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (auto cpu : nodes[node].cpus) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpu_set);
+    }
+  }
+  int err = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+  if (err != 0) {
+    return STATUS_FORMAT(RuntimeError, "Failed to bind thread to NUMA node $0: $1",
+                         nodes[node].id, ErrnoToString(err));
+  }
+  current_thread_numa_node = static_cast<int>(node);
+  return Status::OK();
+#else
+  return STATUS(NotSupported, "Binding threads to NUMA nodes is not supported on this platform");
+#endif
+}
+
+int CurrentThreadNumaNode() {
+  return current_thread_numa_node;
+}
+
+Result<NumaNodeMemoryStats> GetNumaNodeMemoryStats(size_t node) {
+  const auto& nodes = NumaNodes();
+  if (node >= nodes.size()) {
+    return STATUS_FORMAT(InvalidArgument, "NUMA node $0 is out of range, known nodes: $1",
+                         node, nodes.size());
+  }
+  auto content = VERIFY_RESULT(ReadSysFile(
+      Format("$0/node$1/numastat", kNodesDir, nodes[node].id)));
+  static const uint64_t page_size = sysconf(_SC_PAGESIZE);
+  NumaNodeMemoryStats result;
+  // The file has lines like "local_node 12345", with number of pages.
+  std::vector<std::string> lines = strings::Split(content, "\n", strings::SkipEmpty());
+  for (const auto& line : lines) {
+    std::vector<std::string> fields = strings::Split(line, " ", strings::SkipEmpty());
+    uint64 pages;
+    if (fields.size() != 2 || !safe_strtou64(fields[1], &pages)) {
+      continue;
+    }
+    if (fields[0] == "local_node") {
+      result.local_bytes = pages * page_size;
+    } else if (fields[0] == "other_node") {
+      result.remote_bytes = pages * page_size;
+    }
+  }
+  return result;
+}
+
+Result<std::vector<int>> ParseCpuList(const std::string& list) {
+  std::string stripped = list;
+  StripWhiteSpace(&stripped);
+  std::vector<int> result;
+  std::vector<std::string> ranges = strings::Split(stripped, ",", strings::SkipEmpty());
+  for (const auto& range : ranges) {
+    std::vector<std::string> bounds = strings::Split(range, "-");
+    int32 first, last;
+    if (bounds.empty() || bounds.size() > 2 ||
+        !safe_strto32(bounds.front(), &first) || !safe_strto32(bounds.back(), &last) ||
+        first < 0 || last < first) {
+      return STATUS_FORMAT(Corruption, "Invalid CPU list: $0", list);
+    }
+    for (int cpu = first; cpu <= last; ++cpu) {
+      result.push_back(cpu);
+    }
+  }
+  return result;
+}
+
+} // namespace yb
@@ -0,0 +1,60 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_UTIL_NUMA_H
+#define YB_UTIL_NUMA_H
+
+#include <string>
+#include <vector>
+
+#include "yb/util/result.h"
+#include "yb/util/status.h"
+
+namespace yb {
+
+// Placement of threads on NUMA nodes.
+//
+// Threads are bound to CPUs of a node, and memory is not bound explicitly. The default kernel
+// policy allocates pages on the node of the thread that first touches them, so buffers allocated
+// by a bound thread, like rpc call buffers and blocks read from disk, are placed on its node.
+
+// Returns number of NUMA nodes that have CPUs, 1 when the topology is not known.
+size_t NumNumaNodes();
+
+// Whether threads should be placed on NUMA nodes, i.e. --numa_aware_placement is set and there is
+// more than one NUMA node.
+bool NumaPlacementEnabled();
+
+// Binds the current thread to CPUs of the specified node, node should be less than
+// NumNumaNodes().
+CHECKED_STATUS BindCurrentThreadToNumaNode(size_t node);
+
+// Returns the node the current thread was bound to, or -1 if it was not bound.
+int CurrentThreadNumaNode();
+
+struct NumaNodeMemoryStats {
+  // Memory allocated on the node by threads running on this node.
+  uint64_t local_bytes = 0;
+  // Memory allocated on the node by threads running on other nodes.
+  uint64_t remote_bytes = 0;
+};
+
+// Returns allocation stats of the node since system start, for all processes.
+Result<NumaNodeMemoryStats> GetNumaNodeMemoryStats(size_t node);
+
+// Parses list of CPUs in the sysfs format, e.g. "0-3,8,10-11".
+Result<std::vector<int>> ParseCpuList(const std::string& list);
+
+} // namespace yb
+
+#endif // YB_UTIL_NUMA_H
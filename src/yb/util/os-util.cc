@@ -69,6 +69,7 @@ static const int64_t TICKS_PER_SEC = sysconf(_SC_CLK_TCK);
 //
 // They are themselves offset by two because the pid and comm fields of the
 // file are parsed separately.
+static const int64_t STATE = 2 - 2;
 static const int64_t USER_TICKS = 13 - 2;
 static const int64_t KERNEL_TICKS = 14 - 2;
 static const int64_t IO_WAIT = 41 - 2;
@@ -96,6 +97,7 @@ Status ParseStat(const std::string& buffer, std::string* name, ThreadStats* stat
     return STATUS(IOError, "Unrecognised /proc format");
   }
 
+  stats->state = splits[STATE][0];
   int64 tmp;
   if (safe_strto64(splits[USER_TICKS], &tmp)) {
     stats->user_ns = tmp * (1e9 / TICKS_PER_SEC);
@@ -51,10 +51,12 @@ struct ThreadStats {
   int64_t user_ns;
   int64_t kernel_ns;
   int64_t iowait_ns;
+  // Scheduler state of the thread, e.g. 'R' for running or runnable, 'S' for sleeping.
+  char state;
 
   // Default constructor zeroes all members in case structure can't be filled by
   // GetThreadStats.
-  ThreadStats() : user_ns(0), kernel_ns(0), iowait_ns(0) { }
+  ThreadStats() : user_ns(0), kernel_ns(0), iowait_ns(0), state(0) { }
 };
 
 // Populates ThreadStats object using a given buffer. The buffer is expected to
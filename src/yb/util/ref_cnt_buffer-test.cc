@@ -21,6 +21,7 @@
 
 #include <gtest/gtest.h>
 
+#include "yb/util/faststring.h"
 #include "yb/util/ref_cnt_buffer.h"
 
 #include "yb/util/test_util.h"
@@ -71,6 +72,36 @@ TEST_F(RefCntBufferTest, TestFromData) {
   }
 }
 
+// Test taking data from faststring, with and without adopting its heap block.
+TEST_F(RefCntBufferTest, TestFromFaststring) {
+  for (size_t size : std::vector<size_t>{0, 10, 100, kSizeLimit}) {
+    faststring string;
+    for (size_t index = 0; index != size; ++index) {
+      string.push_back(static_cast<char>(index));
+    }
+    const auto* string_data = string.data();
+    const bool heap = size > 32;
+
+    RefCntBuffer buffer(std::move(string));
+    ASSERT_EQ(size, buffer.size());
+    ASSERT_TRUE(string.empty());
+    for (size_t index = 0; index != size; ++index) {
+      ASSERT_EQ(static_cast<char>(index), buffer.begin()[index]);
+    }
+    if (heap) {
+      ASSERT_EQ(static_cast<const void*>(string_data), static_cast<const void*>(buffer.data()));
+    }
+  }
+
+  // Mostly unused block is copied, so the buffer does not hold the wasted memory.
+  faststring string(kSizeLimit);
+  string.append("data", 4);
+  const auto* string_data = string.data();
+  RefCntBuffer buffer(std::move(string));
+  ASSERT_EQ("data", buffer.ToBuffer());
+  ASSERT_NE(static_cast<const void*>(string_data), static_cast<const void*>(buffer.data()));
+}
+
 // Test vector of buffers.
 TEST_F(RefCntBufferTest, TestVector) {
   std::vector<RefCntBuffer> v;
@@ -48,6 +48,21 @@ RefCntBuffer::RefCntBuffer(const faststring& string)
     : RefCntBuffer(string.data(), string.size()) {
 }
 
+RefCntBuffer::RefCntBuffer(faststring&& string) {
+  static_assert(sizeof(CounterType) + sizeof(size_t) == faststring::kReservedPrefixSize,
+                "RefCntBuffer header should fit the prefix reserved by faststring");
+  const size_t size = string.size();
+  data_ = static_cast<char*>(static_cast<void*>(string.ReleaseHeapBlock()));
+  if (!data_) {
+    data_ = static_cast<char*>(malloc(GetInternalBufSize(size)));
+    CHECK(data_ != nullptr);
+    memcpy(this->data(), string.data(), size);
+    string.clear();
+  }
+  size_reference() = size;
+  new (&counter_reference()) CounterType(1);
+}
+
 RefCntBuffer::~RefCntBuffer() {
   Reset();
 }
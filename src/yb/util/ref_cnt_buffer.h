@@ -46,6 +46,10 @@ class RefCntBuffer {
 
   explicit RefCntBuffer(const faststring& string);
 
+  // Takes the data of the string, without copying it when the string heap block could be adopted.
+  // The string is left empty.
+  explicit RefCntBuffer(faststring&& string);
+
   RefCntBuffer(const RefCntBuffer& rhs) noexcept;
   RefCntBuffer(RefCntBuffer&& rhs) noexcept;
 
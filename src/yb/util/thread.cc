@@ -210,6 +210,8 @@ class ThreadMgr {
   // already been removed, this is a no-op.
   void RemoveThread(const pthread_t& pthread_id, const string& category);
 
+  std::vector<ThreadDescription> ListThreads();
+
  private:
   // Container class for any details we want to capture about a thread
   // TODO: Add start-time.
@@ -371,6 +373,26 @@ void ThreadMgr::RemoveThread(const pthread_t& pthread_id, const string& category
   ANNOTATE_IGNORE_READS_AND_WRITES_END();
 }
 
+std::vector<ThreadDescription> ThreadMgr::ListThreads() {
+  std::vector<ThreadDescription> result;
+  MutexLock l(lock_);
+  for (const auto& category : thread_categories_) {
+    for (const auto& thread : category.second) {
+      result.push_back(ThreadDescription {
+          category.first,
+          thread.second.name(),
+          thread.second.thread_id(),
+#if defined(__linux__)
+          thread.second.thread_id()
+#else
+          thread.first
+#endif
+      });
+    }
+  }
+  return result;
+}
+
 int Compare(const Result<StackTrace>& lhs, const Result<StackTrace>& rhs) {
   if (lhs.ok()) {
     if (!rhs.ok()) {
@@ -555,6 +577,16 @@ void InitThreading() {
   std::call_once(init_threading_internal_once_flag, InitThreadingInternal);
 }
 
+std::vector<ThreadDescription> ListRunningThreads() {
+  InitThreading();
+  return thread_manager->ListThreads();
+}
+
+std::string ThreadGroupName(const std::string& category, const std::string& name) {
+  auto end = name.find_last_not_of("0123456789");
+  return category + ";" + (end == std::string::npos ? name : name.substr(0, end + 1));
+}
+
 __thread Thread* Thread::tls_ = nullptr;
 
 Status StartThreadInstrumentation(const scoped_refptr<MetricEntity>& server_metrics,
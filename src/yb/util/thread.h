@@ -407,6 +407,21 @@ void InitThreading();
 
 void SetThreadName(const std::string& name);
 
+// Describes a running thread, that was started via Thread.
+struct ThreadDescription {
+  std::string category;
+  std::string name;
+  int64_t tid;
+  ThreadIdForStack tid_for_stack;
+};
+
+// Returns all running threads, that were started via Thread.
+std::vector<ThreadDescription> ListRunningThreads();
+
+// Returns "category;name" with the trailing worker index dropped from the thread name, since names
+// of threads of the same pool usually differ only in it.
+std::string ThreadGroupName(const std::string& category, const std::string& name);
+
 class CDSAttacher {
  public:
   CDSAttacher();
@@ -52,6 +52,8 @@ using rapidjson::Value;
 using std::string;
 using std::vector;
 
+DECLARE_double(trace_sample_ratio);
+
 namespace yb {
 
 class TraceTest : public YBTest {
@@ -121,6 +123,57 @@ TEST_F(TraceTest, TestChildTrace) {
             XOutDigits(traceA->DumpToString(false)));
 }
 
+TEST_F(TraceTest, TestSampledSpans) {
+  FLAGS_enable_tracing = false;
+  FLAGS_trace_sample_ratio = 0;
+  scoped_refptr<Trace> not_sampled(new Trace);
+  not_sampled->MaybeStartRootSpan("not_sampled");
+  ASSERT_FALSE(not_sampled->sampled());
+
+  FLAGS_trace_sample_ratio = 1;
+  scoped_refptr<Trace> root(new Trace);
+  root->MaybeStartRootSpan("root");
+  ASSERT_TRUE(root->sampled());
+  scoped_refptr<Trace> child(new Trace);
+  {
+    // Sampled traces are adopted and collect entries even when tracing is disabled.
+    ADOPT_TRACE(root.get());
+    TRACE("hello from root");
+    Trace::CurrentTrace()->AddChildTrace(child.get(), "child");
+  }
+  ASSERT_EQ(root->trace_id(), child->trace_id());
+  child->EndSpan();
+  root->EndSpan();
+  // Span is exported only once.
+  root->EndSpan();
+
+  vector<TraceSpan> spans;
+  for (auto& span : RecentTraceSpans()) {
+    if (span.trace_id == root->trace_id()) {
+      spans.push_back(std::move(span));
+    }
+  }
+  ASSERT_EQ(2, spans.size());
+  ASSERT_EQ("child", spans[0].name);
+  ASSERT_EQ(root->span_id(), spans[0].parent_span_id);
+  ASSERT_EQ("root", spans[1].name);
+  ASSERT_EQ(0, spans[1].parent_span_id);
+  ASSERT_EQ(1, spans[1].events.size());
+  ASSERT_STR_CONTAINS(spans[1].events[0].message, "hello from root");
+  ASSERT_LE(spans[1].start_time_usec, spans[1].end_time_usec);
+
+  std::stringstream out;
+  WriteRecentTraceSpansAsOtlpJson("trace-test", &out);
+  Document d;
+  d.Parse<0>(out.str().c_str());
+  ASSERT_TRUE(d.IsObject()) << out.str();
+  const Value& otlp_spans = d["resourceSpans"][0]["scopeSpans"][0]["spans"];
+  ASSERT_TRUE(otlp_spans.IsArray());
+  ASSERT_GE(otlp_spans.Size(), 2);
+  ASSERT_EQ(32, strlen(otlp_spans[0]["traceId"].GetString()));
+  ASSERT_EQ(16, strlen(otlp_spans[0]["spanId"].GetString()));
+}
+
 static void GenerateTraceEvents(int thread_id,
                                 int num_events) {
   for (int i = 0; i < num_events; i++) {
@@ -32,9 +32,12 @@
 
 #include "yb/util/trace.h"
 
+#include <cinttypes>
+#include <deque>
 #include <iomanip>
 #include <ios>
 #include <iostream>
+#include <mutex>
 #include <strstream>
 #include <string>
 #include <vector>
@@ -42,16 +45,30 @@
 #include <boost/range/iterator_range.hpp>
 #include <boost/range/adaptor/indirected.hpp>
 
+#include "yb/gutil/stringprintf.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/gutil/walltime.h"
 
+#include "yb/util/flag_tags.h"
+#include "yb/util/jsonwriter.h"
 #include "yb/util/memory/arena.h"
 #include "yb/util/memory/memory.h"
 #include "yb/util/object_pool.h"
+#include "yb/util/random_util.h"
 #include "yb/util/size_literals.h"
 
 DEFINE_bool(enable_tracing, false, "Flag to enable/disable tracing across the code.");
 
+DEFINE_double(trace_sample_ratio, 0,
+              "Ratio of client requests, that start a sampled distributed trace. Context of "
+              "sampled traces is propagated with RPCs, and finished spans are exported.");
+TAG_FLAG(trace_sample_ratio, runtime);
+
+DEFINE_int32(trace_span_buffer_size, 1000,
+             "Max number of recently finished distributed trace spans kept for export.");
+TAG_FLAG(trace_span_buffer_size, advanced);
+TAG_FLAG(trace_span_buffer_size, runtime);
+
 namespace yb {
 
 using strings::internal::SubstituteArg;
@@ -156,10 +173,49 @@ int64_t GetCurrentMicrosFast(MonoTime now) {
   return initial_micros_offset + now.GetDeltaSinceMin().ToMicroseconds();
 }
 
+class TraceSpanBuffer {
+ public:
+  void Add(TraceSpan span) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    spans_.push_back(std::move(span));
+    while (spans_.size() > static_cast<size_t>(std::max(FLAGS_trace_span_buffer_size, 0))) {
+      spans_.pop_front();
+    }
+  }
+
+  std::vector<TraceSpan> Spans() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::vector<TraceSpan>(spans_.begin(), spans_.end());
+  }
+
+ private:
+  std::mutex mutex_;
+  std::deque<TraceSpan> spans_;
+};
+
+TraceSpanBuffer& SpanBuffer() {
+  static TraceSpanBuffer result;
+  return result;
+}
+
+uint64_t NewSpanId() {
+  uint64_t result;
+  do {
+    result = RandomUniformInt<uint64_t>();
+  } while (result == 0);
+  return result;
+}
+
+// OTLP/JSON encodes trace ids as 16 bytes and span ids as 8 bytes, in hex.
+std::string OtlpId(uint64_t id, bool trace_id) {
+  return trace_id ? StringPrintf("%032" PRIx64, id) : StringPrintf("%016" PRIx64, id);
+}
+
 } // namespace
 
 ScopedAdoptTrace::ScopedAdoptTrace(Trace* t)
-    : old_trace_(Trace::threadlocal_trace_), is_enabled_(GetAtomicFlag(&FLAGS_enable_tracing)) {
+    : old_trace_(Trace::threadlocal_trace_),
+      is_enabled_(GetAtomicFlag(&FLAGS_enable_tracing) || (t && t->sampled())) {
   if (is_enabled_) {
     trace_ = t;
     Trace::threadlocal_trace_ = t;
@@ -349,8 +405,11 @@ void Trace::DumpCurrentTrace() {
   t->Dump(&std::cerr, true);
 }
 
-void Trace::AddChildTrace(Trace* child_trace) {
+void Trace::AddChildTrace(Trace* child_trace, const std::string& span_name) {
   CHECK_NOTNULL(child_trace);
+  if (sampled() && !child_trace->sampled()) {
+    child_trace->StartSpan(span_name, trace_id(), span_id_);
+  }
   {
     std::lock_guard<simple_spinlock> l(lock_);
     scoped_refptr<Trace> ptr(child_trace);
@@ -359,6 +418,127 @@ void Trace::AddChildTrace(Trace* child_trace) {
   CHECK(!child_trace->HasOneRef());
 }
 
+void Trace::StartSpan(const std::string& name, uint64_t trace_id, uint64_t parent_span_id) {
+  std::lock_guard<simple_spinlock> l(lock_);
+  span_id_ = NewSpanId();
+  parent_span_id_ = parent_span_id;
+  span_name_ = name;
+  span_start_time_usec_ = GetCurrentMicrosFast(MonoTime::Now());
+  span_pending_export_ = true;
+  trace_id_.store(trace_id, std::memory_order_release);
+}
+
+void Trace::MaybeStartRootSpan(const std::string& name) {
+  auto ratio = GetAtomicFlag(&FLAGS_trace_sample_ratio);
+  if (ratio > 0 && !sampled() && RandomActWithProbability(ratio)) {
+    StartSpan(name, NewSpanId(), 0);
+  }
+}
+
+void Trace::JoinSpan(uint64_t trace_id, uint64_t span_id) {
+  std::lock_guard<simple_spinlock> l(lock_);
+  span_id_ = span_id;
+  trace_id_.store(trace_id, std::memory_order_release);
+}
+
+void Trace::EndSpan() {
+  if (!sampled()) {
+    return;
+  }
+  TraceSpan span;
+  {
+    std::lock_guard<simple_spinlock> l(lock_);
+    if (!span_pending_export_) {
+      return;
+    }
+    span_pending_export_ = false;
+    span.trace_id = trace_id();
+    span.span_id = span_id_;
+    span.parent_span_id = parent_span_id_;
+    span.name = span_name_;
+    span.start_time_usec = span_start_time_usec_;
+    for (TraceEntry* cur = entries_head_; cur != nullptr; cur = cur->next) {
+      std::stringstream message;
+      cur->Dump(&message);
+      span.events.push_back(TraceSpan::Event {
+          GetCurrentMicrosFast(cur->timestamp), message.str() });
+    }
+  }
+  span.end_time_usec = GetCurrentMicrosFast(MonoTime::Now());
+  SpanBuffer().Add(std::move(span));
+}
+
+std::vector<TraceSpan> RecentTraceSpans() {
+  return SpanBuffer().Spans();
+}
+
+void WriteRecentTraceSpansAsOtlpJson(const std::string& service_name, std::ostream* out) {
+  JsonWriter jw(out, JsonWriter::COMPACT);
+  jw.StartObject();
+  jw.String("resourceSpans");
+  jw.StartArray();
+  jw.StartObject();
+
+  jw.String("resource");
+  jw.StartObject();
+  jw.String("attributes");
+  jw.StartArray();
+  jw.StartObject();
+  jw.String("key");
+  jw.String("service.name");
+  jw.String("value");
+  jw.StartObject();
+  jw.String("stringValue");
+  jw.String(service_name);
+  jw.EndObject();
+  jw.EndObject();
+  jw.EndArray();
+  jw.EndObject();
+
+  jw.String("scopeSpans");
+  jw.StartArray();
+  jw.StartObject();
+  jw.String("spans");
+  jw.StartArray();
+  for (const auto& span : RecentTraceSpans()) {
+    jw.StartObject();
+    jw.String("traceId");
+    jw.String(OtlpId(span.trace_id, /* trace_id= */ true));
+    jw.String("spanId");
+    jw.String(OtlpId(span.span_id, /* trace_id= */ false));
+    if (span.parent_span_id != 0) {
+      jw.String("parentSpanId");
+      jw.String(OtlpId(span.parent_span_id, /* trace_id= */ false));
+    }
+    jw.String("name");
+    jw.String(span.name);
+    // OTLP/JSON encodes 64 bit integers as strings.
+    jw.String("startTimeUnixNano");
+    jw.String(std::to_string(span.start_time_usec * 1000));
+    jw.String("endTimeUnixNano");
+    jw.String(std::to_string(span.end_time_usec * 1000));
+    jw.String("events");
+    jw.StartArray();
+    for (const auto& event : span.events) {
+      jw.StartObject();
+      jw.String("timeUnixNano");
+      jw.String(std::to_string(event.time_usec * 1000));
+      jw.String("name");
+      jw.String(event.message);
+      jw.EndObject();
+    }
+    jw.EndArray();
+    jw.EndObject();
+  }
+  jw.EndArray();
+  jw.EndObject();
+  jw.EndArray();
+
+  jw.EndObject();
+  jw.EndArray();
+  jw.EndObject();
+}
+
 size_t Trace::DynamicMemoryUsage() const {
   auto arena = arena_.load();
   return arena ? arena->memory_footprint() : 0;
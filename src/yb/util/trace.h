@@ -64,19 +64,17 @@ DECLARE_bool(enable_tracing);
 //  TRACE("Acquired timestamp $0", timestamp);
 #define TRACE(format, substitutions...) \
   do { \
-    if (GetAtomicFlag(&FLAGS_enable_tracing)) { \
-      yb::Trace* _trace = Trace::CurrentTrace(); \
-      if (_trace) { \
-        _trace->SubstituteAndTrace(__FILE__, __LINE__, MonoTime::Now(), (format),  \
-          ##substitutions); \
-      } \
+    yb::Trace* _trace = Trace::CurrentTrace(); \
+    if (_trace && (GetAtomicFlag(&FLAGS_enable_tracing) || _trace->sampled())) { \
+      _trace->SubstituteAndTrace(__FILE__, __LINE__, MonoTime::Now(), (format),  \
+        ##substitutions); \
     } \
   } while (0)
 
 // Like the above, but takes the trace pointer as an explicit argument.
 #define TRACE_TO(trace, format, substitutions...) \
   do { \
-    if (GetAtomicFlag(&FLAGS_enable_tracing)) { \
+    if (GetAtomicFlag(&FLAGS_enable_tracing) || (trace)->sampled()) { \
       (trace)->SubstituteAndTrace( \
           __FILE__, __LINE__, MonoTime::Now(), (format), ##substitutions); \
     } \
@@ -85,7 +83,7 @@ DECLARE_bool(enable_tracing);
 // Like the above, but takes the trace pointer as an explicit argument.
 #define TRACE_TO_WITH_TIME(trace, time, format, substitutions...) \
   do { \
-    if (GetAtomicFlag(&FLAGS_enable_tracing)) { \
+    if (GetAtomicFlag(&FLAGS_enable_tracing) || (trace)->sampled()) { \
       (trace)->SubstituteAndTrace( \
           __FILE__, __LINE__, (time), (format), ##substitutions); \
     } \
@@ -109,6 +107,10 @@ struct TraceEntry;
 // methods of this class. Rather, the TRACE(...) macros defined above should
 // be used such that file/line numbers are automatically included, etc.
 //
+// A trace could also be a span of a sampled distributed trace, that links traces of a request
+// across threads and servers. Entries of sampled traces are collected even when tracing is not
+// enabled, and the span is exported when it ends, see RecentTraceSpans().
+//
 // This class is thread-safe.
 class Trace : public RefCountedThreadSafe<Trace> {
  public:
@@ -155,7 +157,36 @@ class Trace : public RefCountedThreadSafe<Trace> {
   std::string DumpToString(bool include_time_deltas) const;
 
   // Attaches the given trace which will get appended at the end when Dumping.
-  void AddChildTrace(Trace* child_trace);
+  // If this trace is sampled, the child trace starts a child span with the specified name.
+  void AddChildTrace(Trace* child_trace, const std::string& span_name = std::string());
+
+  // Starts a span of the distributed trace trace_id, whose parent span is parent_span_id.
+  // Should be called before the trace is shared with other threads.
+  void StartSpan(const std::string& name, uint64_t trace_id, uint64_t parent_span_id);
+
+  // Starts a new distributed trace, if it is chosen by sampling according to trace_sample_ratio.
+  void MaybeStartRootSpan(const std::string& name);
+
+  // Makes this trace represent the existing span span_id of trace_id, e.g. to create child spans
+  // of it from another thread. Such trace does not export the span.
+  void JoinSpan(uint64_t trace_id, uint64_t span_id);
+
+  // Finishes the span and exports it, does nothing if the trace is not a sampled span, or the span
+  // was already finished.
+  void EndSpan();
+
+  // Whether this trace is a span of a sampled distributed trace.
+  bool sampled() const {
+    return trace_id_.load(std::memory_order_acquire) != 0;
+  }
+
+  uint64_t trace_id() const {
+    return trace_id_.load(std::memory_order_acquire);
+  }
+
+  uint64_t span_id() const {
+    return span_id_;
+  }
 
   // Return the current trace attached to this thread, if there is one.
   static Trace* CurrentTrace() {
@@ -202,9 +233,40 @@ class Trace : public RefCountedThreadSafe<Trace> {
 
   std::vector<scoped_refptr<Trace> > child_traces_;
 
+  // Distributed trace span, trace_id_ is 0 when the trace is not sampled.
+  std::atomic<uint64_t> trace_id_{0};
+  uint64_t span_id_ = 0;
+  uint64_t parent_span_id_ = 0;
+  std::string span_name_;
+  int64_t span_start_time_usec_ = 0;
+  // Whether the span should be exported when it ends, protected by lock_.
+  bool span_pending_export_ = false;
+
   DISALLOW_COPY_AND_ASSIGN(Trace);
 };
 
+// A finished span of a sampled distributed trace.
+struct TraceSpan {
+  struct Event {
+    int64_t time_usec;
+    std::string message;
+  };
+
+  uint64_t trace_id;
+  uint64_t span_id;
+  uint64_t parent_span_id;
+  std::string name;
+  int64_t start_time_usec;
+  int64_t end_time_usec;
+  std::vector<Event> events;
+};
+
+// Returns recently finished spans, at most trace_span_buffer_size of them.
+std::vector<TraceSpan> RecentTraceSpans();
+
+// Writes recently finished spans in the OTLP/JSON format of OpenTelemetry trace export requests.
+void WriteRecentTraceSpansAsOtlpJson(const std::string& service_name, std::ostream* out);
+
 typedef scoped_refptr<Trace> TracePtr;
 
 // Adopt a Trace object into the current thread for the duration
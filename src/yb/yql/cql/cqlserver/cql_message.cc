@@ -16,6 +16,8 @@
 
 #include <regex>
 
+#include <gflags/gflags.h>
+
 #include "yb/client/client.h"
 
 #include "yb/common/ql_protocol.pb.h"
@@ -28,6 +30,14 @@
 #include "yb/gutil/strings/substitute.h"
 
 #include "yb/util/random_util.h"
+#include "yb/util/size_literals.h"
+
+DEFINE_int32(cql_compression_min_body_size, 0,
+             "Responses with a body smaller than this are sent uncompressed even when the "
+             "connection negotiated compression. Responses whose compressed body is not smaller "
+             "than the original one are always sent uncompressed.");
+
+DECLARE_int32(max_message_length);
 
 namespace yb {
 namespace cqlserver {
@@ -186,6 +196,62 @@ Type LoadInt(const Slice& slice, size_t offset) {
   return static_cast<Type>(NetworkByteOrder::Load32(slice.data() + offset));
 }
 
+// Scratch buffers larger than this are not kept by a thread after use.
+constexpr size_t kMaxRetainedScratchSize = 1_MB;
+
+// Returns an empty buffer owned by the current thread. Buffers are reused across messages, so
+// compressed messages do not need a heap allocation each. A buffer that grew above
+// kMaxRetainedScratchSize is replaced, so a single large message does not pin its memory.
+faststring* AcquireScratch(std::unique_ptr<faststring>* scratch) {
+  if (!*scratch || (*scratch)->capacity() > kMaxRetainedScratchSize) {
+    *scratch = std::make_unique<faststring>();
+  }
+  (*scratch)->clear();
+  return scratch->get();
+}
+
+thread_local std::unique_ptr<faststring> request_body_scratch;
+thread_local std::unique_ptr<faststring> response_body_scratch;
+
+// Appends body compressed with the given scheme to mesg. Returns false and leaves mesg unchanged
+// when the body is too small to be compressed, or does not get smaller after compression.
+bool CompressBody(
+    const CQLMessage::CompressionScheme compression_scheme, const Slice& body, faststring* mesg) {
+  if (body.size() < static_cast<size_t>(std::max(FLAGS_cql_compression_min_body_size, 0))) {
+    return false;
+  }
+  const size_t curr_size = mesg->size();
+  switch (compression_scheme) {
+    case CQLMessage::CompressionScheme::kLz4: {
+      const int max_comp_size = LZ4_compressBound(body.size());
+      mesg->resize(curr_size + sizeof(uint32_t) + max_comp_size);
+      NetworkByteOrder::Store32(mesg->data() + curr_size, static_cast<uint32_t>(body.size()));
+      const int comp_size = LZ4_compress_default(
+          body.cdata(), to_char_ptr(mesg->data() + curr_size + sizeof(uint32_t)), body.size(),
+          max_comp_size);
+      CHECK_NE(comp_size, 0) << "LZ4 compression failed";
+      mesg->resize(curr_size + sizeof(uint32_t) + comp_size);
+      break;
+    }
+    case CQLMessage::CompressionScheme::kSnappy: {
+      const size_t max_comp_size = MaxCompressedLength(body.size());
+      size_t comp_size = 0;
+      mesg->resize(curr_size + max_comp_size);
+      RawCompress(body.cdata(), body.size(), to_char_ptr(mesg->data() + curr_size), &comp_size);
+      mesg->resize(curr_size + comp_size);
+      break;
+    }
+    case CQLMessage::CompressionScheme::kNone:
+      LOG(FATAL) << "No compression scheme";
+      break;
+  }
+  if (mesg->size() - curr_size >= body.size()) {
+    mesg->resize(curr_size);
+    return false;
+  }
+  return true;
+}
+
 } // namespace
 
 // ------------------------------------ CQL request -----------------------------------
@@ -236,9 +302,9 @@ bool CQLRequest::ParseRequest(
 
   size_t body_size = mesg.size() - kMessageHeaderLength;
   const uint8_t* body_data = body_size > 0 ? mesg.data() + kMessageHeaderLength : to_uchar_ptr("");
-  unique_ptr<uint8_t[]> buffer;
 
-  // If the message body is compressed, uncompress it.
+  // If the message body is compressed, uncompress it. The body is parsed completely before
+  // returning, so it is uncompressed into the scratch buffer of the thread.
   if (body_size > 0 && (header.flags & kCompressionFlag)) {
     if (header.opcode == Opcode::STARTUP) {
       error_response->reset(
@@ -258,10 +324,18 @@ bool CQLRequest::ParseRequest(
         }
 
         const uint32_t uncomp_size = static_cast<uint32_t>(NetworkByteOrder::Load32(body_data));
-        buffer = std::make_unique<uint8_t[]>(uncomp_size);
+        if (uncomp_size > static_cast<uint32_t>(FLAGS_max_message_length)) {
+          error_response->reset(
+              new ErrorResponse(
+                  header.stream_id, ErrorResponse::Code::PROTOCOL_ERROR,
+                  "Uncompressed CQL message too long"));
+          return false;
+        }
+        faststring* buffer = AcquireScratch(&request_body_scratch);
+        buffer->resize(uncomp_size);
         body_data += sizeof(uncomp_size);
         body_size -= sizeof(uncomp_size);
-        const int size = LZ4_decompress_safe(to_char_ptr(body_data), to_char_ptr(buffer.get()),
+        const int size = LZ4_decompress_safe(to_char_ptr(body_data), to_char_ptr(buffer->data()),
                                              body_size, uncomp_size);
         if (size < 0 || size != uncomp_size) {
           error_response->reset(
@@ -270,16 +344,18 @@ bool CQLRequest::ParseRequest(
                   "Error occurred when uncompressing CQL message"));
           return false;
         }
-        body_data = buffer.get();
+        body_data = buffer->data();
         body_size = uncomp_size;
         break;
       }
       case CompressionScheme::kSnappy: {
         size_t uncomp_size = 0;
-        if (GetUncompressedLength(to_char_ptr(body_data), body_size, &uncomp_size)) {
-          buffer = std::make_unique<uint8_t[]>(uncomp_size);
-          if (RawUncompress(to_char_ptr(body_data), body_size, to_char_ptr(buffer.get()))) {
-            body_data = buffer.get();
+        if (GetUncompressedLength(to_char_ptr(body_data), body_size, &uncomp_size) &&
+            uncomp_size <= static_cast<size_t>(FLAGS_max_message_length)) {
+          faststring* buffer = AcquireScratch(&request_body_scratch);
+          buffer->resize(uncomp_size);
+          if (RawUncompress(to_char_ptr(body_data), body_size, to_char_ptr(buffer->data()))) {
+            body_data = buffer->data();
             body_size = uncomp_size;
             break;
           }
@@ -288,7 +364,7 @@ bool CQLRequest::ParseRequest(
             new ErrorResponse(
                 header.stream_id, ErrorResponse::Code::PROTOCOL_ERROR,
                 "Error occurred when uncompressing CQL message"));
-        break;
+        return false;
       }
       case CompressionScheme::kNone:
         error_response->reset(
@@ -943,35 +1019,12 @@ void CQLResponse::Serialize(const CompressionScheme compression_scheme, faststri
   const bool compress = (compression_scheme != CQLMessage::CompressionScheme::kNone);
   SerializeHeader(compress, mesg);
   if (compress) {
-    faststring body;
-    SerializeBody(&body);
-    switch (compression_scheme) {
-      case CQLMessage::CompressionScheme::kLz4: {
-        SerializeInt(static_cast<int32_t>(body.size()), mesg);
-        const size_t curr_size = mesg->size();
-        const int max_comp_size = LZ4_compressBound(body.size());
-        mesg->resize(curr_size + max_comp_size);
-        const int comp_size = LZ4_compress_default(to_char_ptr(body.data()),
-                                                   to_char_ptr(mesg->data() + curr_size),
-                                                   body.size(),
-                                                   max_comp_size);
-        CHECK_NE(comp_size, 0) << "LZ4 compression failed";
-        mesg->resize(curr_size + comp_size);
-        break;
-      }
-      case CQLMessage::CompressionScheme::kSnappy: {
-        const size_t curr_size = mesg->size();
-        const size_t max_comp_size = MaxCompressedLength(body.size());
-        size_t comp_size = 0;
-        mesg->resize(curr_size + max_comp_size);
-        RawCompress(to_char_ptr(body.data()), body.size(),
-                    to_char_ptr(mesg->data() + curr_size), &comp_size);
-        mesg->resize(curr_size + comp_size);
-        break;
-      }
-      case CQLMessage::CompressionScheme::kNone:
-        LOG(FATAL) << "No compression scheme";
-        break;
+    faststring* body = AcquireScratch(&response_body_scratch);
+    SerializeBody(body);
+    if (!CompressBody(compression_scheme, Slice(*body), mesg)) {
+      // Compression is flagged per frame, so a body that does not benefit from it is sent as is.
+      mesg->data()[start_pos + kHeaderPosFlags] &= ~kCompressionFlag;
+      mesg->append(body->data(), body->size());
     }
   } else {
     SerializeBody(mesg);
@@ -1533,7 +1586,11 @@ void RowsResultResponse::SerializeResultBody(faststring* mesg) const {
   SerializeRowsMetadata(
       RowsMetadata(result_->table_name(), result_->column_schemas(),
                    result_->paging_state(), skip_metadata_), mesg);
-  mesg->append(result_->rows_data());
+  // The rows data comes from the tablet servers already in the CQL wire format, so it is forwarded
+  // as is. Reserve the exact room for it, so it is copied only once into the response.
+  const auto& rows_data = result_->rows_data();
+  mesg->reserve(mesg->size() + rows_data.size());
+  mesg->append(rows_data);
 }
 
 //----------------------------------------------------------------------------------------
@@ -73,6 +73,13 @@ METRIC_DEFINE_counter(server, cql_processors_created,
 
 DECLARE_bool(use_cassandra_authentication);
 
+DEFINE_bool(cql_cache_unprepared_statements, false,
+            "Keep parse trees of queries that were not prepared by the client in a cache of the "
+            "CQL proxy, so the same query text sent again in the same keyspace is executed "
+            "without being parsed and analyzed again. The cache is separate from the prepared "
+            "statements cache and is limited by "
+            "cql_service_max_unprepared_statement_size_bytes.");
+
 namespace yb {
 namespace cqlserver {
 
@@ -194,7 +201,8 @@ void CQLProcessor::SendResponse(const CQLResponse& response) {
   const auto compression_scheme = context.compression_scheme();
   faststring msg;
   response.Serialize(compression_scheme, &msg);
-  call_->RespondSuccess(RefCntBuffer(msg), cql_metrics_->rpc_method_metrics_);
+  // Adopt the serialized message instead of copying it, large rows results are sent as is.
+  call_->RespondSuccess(RefCntBuffer(std::move(msg)), cql_metrics_->rpc_method_metrics_);
 
   MonoTime response_done = MonoTime::Now();
   cql_metrics_->time_to_process_request_->Increment(
@@ -318,6 +326,14 @@ CQLResponse* CQLProcessor::ProcessRequest(const ExecuteRequest& req) {
 
 CQLResponse* CQLProcessor::ProcessRequest(const QueryRequest& req) {
   VLOG(1) << "QUERY " << req.query();
+  if (FLAGS_cql_cache_unprepared_statements) {
+    const Result<shared_ptr<const CQLStatement>> stmt = GetQueryStatement(req.query());
+    if (!stmt.ok()) {
+      return ProcessError(stmt.status());
+    }
+    const Status s = (*stmt)->ExecuteAsync(this, req.params(), statement_executed_cb_);
+    return s.ok() ? nullptr : ProcessError(s);
+  }
   RunAsync(req.query(), req.params(), statement_executed_cb_);
   return nullptr;
 }
@@ -392,6 +408,23 @@ shared_ptr<const CQLStatement> CQLProcessor::GetPreparedStatement(const CQLMessa
   return stmt;
 }
 
+Result<shared_ptr<const CQLStatement>> CQLProcessor::GetQueryStatement(const string& query) {
+  // The query is cached apart from prepared statements, so that ad hoc queries do not evict them.
+  // Like for PREPARE, concurrent callers contend on the same cached statement, and only the first
+  // one parses and analyzes it.
+  const CQLMessage::QueryId query_id = CQLStatement::GetQueryId(ql_env_.CurrentKeyspace(), query);
+  shared_ptr<CQLStatement> stmt = service_impl_->AllocateUnpreparedStatement(
+      query_id, ql_env_.CurrentKeyspace(), query);
+  const Status s = stmt->Prepare(this, service_impl_->unprepared_stmts_mem_tracker());
+  if (!s.ok()) {
+    service_impl_->DeletePreparedStatement(stmt);
+    return s;
+  }
+  stmt->clear_reparsed();
+  stmts_.insert(stmt);
+  return shared_ptr<const CQLStatement>(std::move(stmt));
+}
+
 void CQLProcessor::StatementExecuted(const Status& s, const ExecutedResult::SharedPtr& result) {
   unique_ptr<CQLResponse> response(s.ok() ? ProcessResult(result) : ProcessError(s));
   PrepareAndSendResponse(response);
@@ -410,7 +443,9 @@ CQLResponse* CQLProcessor::ProcessError(const Status& s,
         if (stmt->stale()) {
           service_impl_->DeletePreparedStatement(stmt);
         }
-        if (stmt->unprepared() || stmt->stale()) {
+        // The client did not prepare the statements of a query, so it could not reprepare them.
+        if ((stmt->unprepared() || stmt->stale()) &&
+            request_->opcode() != CQLMessage::Opcode::QUERY) {
           query_id = stmt->query_id();
         }
       }
@@ -88,6 +88,10 @@ class CQLProcessor : public ql::QLProcessor {
   // Get a prepared statement and adds it to the set of statements currently being executed.
   std::shared_ptr<const CQLStatement> GetPreparedStatement(const CQLMessage::QueryId& id);
 
+  // Get the cached statement of a query that was not prepared by the client, preparing it if it
+  // is not cached yet, and add it to the set of statements currently being executed.
+  Result<std::shared_ptr<const CQLStatement>> GetQueryStatement(const std::string& query);
+
   // Statement executed callback.
   void StatementExecuted(const Status& s, const ql::ExecutedResult::SharedPtr& result = nullptr);
 
@@ -187,7 +187,7 @@ void CQLInboundCall::RespondFailure(rpc::ErrorStatusPB::RpcErrorCodePB error_cod
       break;
     }
   }
-  response_msg_buf_ = RefCntBuffer(msg);
+  response_msg_buf_ = RefCntBuffer(std::move(msg));
 
   QueueResponse(/* is_success */ false);
 }
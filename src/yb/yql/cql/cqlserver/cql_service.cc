@@ -40,6 +40,9 @@ DECLARE_bool(use_cassandra_authentication);
 DEFINE_int64(cql_service_max_prepared_statement_size_bytes, 128_MB,
              "The maximum amount of memory the CQL proxy should use to maintain prepared "
              "statements. 0 or negative means unlimited.");
+DEFINE_int64(cql_service_max_unprepared_statement_size_bytes, 16_MB,
+             "The maximum amount of memory the CQL proxy should use to cache statements of "
+             "queries that were not prepared by the client. 0 or negative means unlimited.");
 DEFINE_int32(cql_ybclient_reactor_threads, 24,
              "The number of reactor threads to be used for processing ybclient "
              "requests originating in the cql layer");
@@ -60,6 +63,22 @@ using yb::client::YBSession;
 using yb::client::YBMetaDataCache;
 using yb::rpc::InboundCall;
 
+class CQLServiceImpl::UnpreparedStatementsCollector : public GarbageCollector {
+ public:
+  explicit UnpreparedStatementsCollector(std::weak_ptr<CQLServiceImpl> service)
+      : service_(std::move(service)) {}
+
+  void CollectGarbage(size_t required) override {
+    auto service = service_.lock();
+    if (service) {
+      service->CollectUnpreparedGarbage(required);
+    }
+  }
+
+ private:
+  const std::weak_ptr<CQLServiceImpl> service_;
+};
+
 CQLServiceImpl::CQLServiceImpl(CQLServer* server, const CQLServerOptions& opts,
                                ql::TransactionPoolProvider transaction_pool_provider)
     : CQLServerServiceIf(server->metric_entity()),
@@ -81,6 +100,10 @@ CQLServiceImpl::CQLServiceImpl(CQLServer* server, const CQLServerOptions& opts,
       FLAGS_cql_service_max_prepared_statement_size_bytes > 0 ?
       FLAGS_cql_service_max_prepared_statement_size_bytes : -1,
       "CQL prepared statements", server->mem_tracker());
+  unprepared_stmts_mem_tracker_ = MemTracker::CreateTracker(
+      FLAGS_cql_service_max_unprepared_statement_size_bytes > 0 ?
+      FLAGS_cql_service_max_unprepared_statement_size_bytes : -1,
+      "CQL unprepared statements", server->mem_tracker());
 
   auth_prepared_stmt_ = std::make_shared<ql::Statement>(
       "",
@@ -120,6 +143,9 @@ const std::shared_ptr<client::YBMetaDataCache>& CQLServiceImpl::metadata_cache()
 
 void CQLServiceImpl::CompleteInit() {
   prepared_stmts_mem_tracker_->AddGarbageCollector(shared_from_this());
+  unprepared_stmts_collector_ = std::make_shared<UnpreparedStatementsCollector>(
+      shared_from_this());
+  unprepared_stmts_mem_tracker_->AddGarbageCollector(unprepared_stmts_collector_);
 }
 
 void CQLServiceImpl::Shutdown() {
@@ -170,26 +196,47 @@ shared_ptr<CQLStatement> CQLServiceImpl::AllocatePreparedStatement(
   // Get exclusive lock before allocating a prepared statement and updating the LRU list.
   std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
 
+  auto stmt = AllocateStatementUnlocked(
+      query_id, keyspace, query, &prepared_stmts_map_, &prepared_stmts_list_);
+
+  VLOG(1) << "InsertPreparedStatement: CQL prepared statement cache count = "
+          << prepared_stmts_map_.size() << "/" << prepared_stmts_list_.size()
+          << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
+
+  return stmt;
+}
+
+shared_ptr<CQLStatement> CQLServiceImpl::AllocateUnpreparedStatement(
+    const CQLMessage::QueryId& query_id, const string& keyspace, const string& query) {
+  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
+
+  auto stmt = AllocateStatementUnlocked(
+      query_id, keyspace, query, &unprepared_stmts_map_, &unprepared_stmts_list_);
+
+  VLOG(1) << "InsertUnpreparedStatement: CQL unprepared statement cache count = "
+          << unprepared_stmts_map_.size() << "/" << unprepared_stmts_list_.size()
+          << ", memory usage = " << unprepared_stmts_mem_tracker_->consumption();
+
+  return stmt;
+}
+
+shared_ptr<CQLStatement> CQLServiceImpl::AllocateStatementUnlocked(
+    const CQLMessage::QueryId& query_id, const string& keyspace, const string& query,
+    CQLStatementMap* map, CQLStatementList* list) {
   shared_ptr<CQLStatement> stmt;
-  const auto itr = prepared_stmts_map_.find(query_id);
-  if (itr == prepared_stmts_map_.end()) {
+  const auto itr = map->find(query_id);
+  if (itr == map->end()) {
     // Allocate the prepared statement placeholder that multiple clients trying to prepare the same
     // statement to contend on. The statement will then be prepared by one client while the rest
     // wait for the results.
-    stmt = prepared_stmts_map_.emplace(
-        query_id, std::make_shared<CQLStatement>(
-            keyspace, query, prepared_stmts_list_.end())).first->second;
-    InsertLruPreparedStatementUnlocked(stmt);
+    stmt = map->emplace(
+        query_id, std::make_shared<CQLStatement>(keyspace, query, list->end())).first->second;
+    InsertLruStatementUnlocked(stmt, list);
   } else {
     // Return existing statement if found.
     stmt = itr->second;
-    MoveLruPreparedStatementUnlocked(stmt);
+    MoveLruStatementUnlocked(stmt, list);
   }
-
-  VLOG(1) << "InsertPreparedStatement: CQL prepared statement cache count = "
-          << prepared_stmts_map_.size() << "/" << prepared_stmts_list_.size()
-          << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
-
   return stmt;
 }
 
@@ -215,7 +262,7 @@ shared_ptr<const CQLStatement> CQLServiceImpl::GetPreparedStatement(
     return nullptr;
   }
 
-  MoveLruPreparedStatementUnlocked(stmt);
+  MoveLruStatementUnlocked(stmt, &prepared_stmts_list_);
   return stmt;
 }
 
@@ -230,31 +277,42 @@ void CQLServiceImpl::DeletePreparedStatement(const shared_ptr<const CQLStatement
           << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
 }
 
-void CQLServiceImpl::InsertLruPreparedStatementUnlocked(const shared_ptr<CQLStatement>& stmt) {
+void CQLServiceImpl::InsertLruStatementUnlocked(
+    const shared_ptr<CQLStatement>& stmt, CQLStatementList* list) {
   // Insert the statement at the front of the LRU list.
-  stmt->set_pos(prepared_stmts_list_.insert(prepared_stmts_list_.begin(), stmt));
+  stmt->set_pos(list->insert(list->begin(), stmt));
 }
 
-void CQLServiceImpl::MoveLruPreparedStatementUnlocked(const shared_ptr<CQLStatement>& stmt) {
+void CQLServiceImpl::MoveLruStatementUnlocked(
+    const shared_ptr<CQLStatement>& stmt, CQLStatementList* list) {
   // Move the statement to the front of the LRU list.
-  prepared_stmts_list_.splice(prepared_stmts_list_.begin(), prepared_stmts_list_, stmt->pos());
+  list->splice(list->begin(), *list, stmt->pos());
 }
 
 void CQLServiceImpl::DeletePreparedStatementUnlocked(
     const std::shared_ptr<const CQLStatement> stmt) {
-  // Remove statement from cache by looking it up by query ID and only when it is same statement
-  // object. Note that the "stmt" parameter above is not a ref ("&") intentionally so that we have
-  // a separate copy of the shared_ptr and not the very shared_ptr in prepared_stmts_map_ or
-  // prepared_stmt_list_ we are deleting.
-  const auto itr = prepared_stmts_map_.find(stmt->query_id());
-  if (itr != prepared_stmts_map_.end() && itr->second == stmt) {
-    prepared_stmts_map_.erase(itr);
+  // Note that the "stmt" parameter above is not a ref ("&") intentionally so that we have a
+  // separate copy of the shared_ptr and not the very shared_ptr in the cache or the LRU list we
+  // are deleting.
+  if (!DeleteStatementUnlocked(stmt, &prepared_stmts_map_, &prepared_stmts_list_)) {
+    DeleteStatementUnlocked(stmt, &unprepared_stmts_map_, &unprepared_stmts_list_);
   }
-  // Remove statement from LRU list only when it is in the list, i.e. pos() != end().
-  if (stmt->pos() != prepared_stmts_list_.end()) {
-    prepared_stmts_list_.erase(stmt->pos());
-    stmt->set_pos(prepared_stmts_list_.end());
+}
+
+bool CQLServiceImpl::DeleteStatementUnlocked(
+    const std::shared_ptr<const CQLStatement>& stmt, CQLStatementMap* map,
+    CQLStatementList* list) {
+  // Remove statement from cache by looking it up by query ID and only when it is same statement
+  // object. A statement is in the LRU list of a cache as long as it is in the cache, so its
+  // position is only valid for this list then.
+  const auto itr = map->find(stmt->query_id());
+  if (itr == map->end() || itr->second != stmt) {
+    return false;
   }
+  map->erase(itr);
+  list->erase(stmt->pos());
+  stmt->set_pos(list->end());
+  return true;
 }
 
 void CQLServiceImpl::CollectGarbage(size_t required) {
@@ -271,6 +329,18 @@ void CQLServiceImpl::CollectGarbage(size_t required) {
           << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
 }
 
+void CQLServiceImpl::CollectUnpreparedGarbage(size_t required) {
+  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
+
+  if (!unprepared_stmts_list_.empty()) {
+    DeletePreparedStatementUnlocked(unprepared_stmts_list_.back());
+  }
+
+  VLOG(1) << "DeleteLruUnpreparedStatement: CQL unprepared statement cache count = "
+          << unprepared_stmts_map_.size() << "/" << unprepared_stmts_list_.size()
+          << ", memory usage = " << unprepared_stmts_mem_tracker_->consumption();
+}
+
 server::Clock* CQLServiceImpl::clock() {
   return server_->clock();
 }
@@ -66,12 +66,18 @@ class CQLServiceImpl : public CQLServerServiceIf,
   std::shared_ptr<CQLStatement> AllocatePreparedStatement(
       const CQLMessage::QueryId& id, const std::string& keyspace, const std::string& query);
 
+  // Allocate the statement of a query that was not prepared by the client in a separate, smaller
+  // cache, so that ad hoc queries do not evict prepared statements. If the statement already
+  // exists, return it instead.
+  std::shared_ptr<CQLStatement> AllocateUnpreparedStatement(
+      const CQLMessage::QueryId& id, const std::string& keyspace, const std::string& query);
+
   // Look up a prepared statement by its id. Nullptr will be returned if the statement is not found.
   std::shared_ptr<const CQLStatement> GetPreparedStatement(const CQLMessage::QueryId& id);
 
   std::shared_ptr<ql::Statement> GetAuthPreparedStatement() const { return auth_prepared_stmt_; }
 
-  // Delete the prepared statement from the cache.
+  // Delete the prepared or unprepared statement from its cache.
   void DeletePreparedStatement(const std::shared_ptr<const CQLStatement>& stmt);
 
   // Return the memory tracker for prepared statements.
@@ -79,6 +85,11 @@ class CQLServiceImpl : public CQLServerServiceIf,
     return prepared_stmts_mem_tracker_;
   }
 
+  // Return the memory tracker for statements of queries that were not prepared by the client.
+  const MemTrackerPtr& unprepared_stmts_mem_tracker() const {
+    return unprepared_stmts_mem_tracker_;
+  }
+
   // Return the YBClient to communicate with either master or tserver.
   client::YBClient* client() const;
 
@@ -98,26 +109,44 @@ class CQLServiceImpl : public CQLServerServiceIf,
   }
 
  private:
+  class UnpreparedStatementsCollector;
+
   constexpr static int kRpcTimeoutSec = 5;
 
   // Either gets an available processor or creates a new one.
   CQLProcessor *GetProcessor();
 
-  // Insert a prepared statement at the front of the LRU list. "prepared_stmts_mutex_" needs to be
-  // locked before this call.
-  void InsertLruPreparedStatementUnlocked(const std::shared_ptr<CQLStatement>& stmt);
+  // Allocate a statement in the given cache and LRU list, or return the existing one.
+  // "prepared_stmts_mutex_" needs to be locked before this call.
+  std::shared_ptr<CQLStatement> AllocateStatementUnlocked(
+      const CQLMessage::QueryId& query_id, const std::string& keyspace, const std::string& query,
+      CQLStatementMap* map, CQLStatementList* list);
 
-  // Move a prepared statement to the front of the LRU list. "prepared_stmts_mutex_" needs to be
-  // locked before this call.
-  void MoveLruPreparedStatementUnlocked(const std::shared_ptr<CQLStatement>& stmt);
+  // Insert a statement at the front of the LRU list. "prepared_stmts_mutex_" needs to be locked
+  // before this call.
+  void InsertLruStatementUnlocked(
+      const std::shared_ptr<CQLStatement>& stmt, CQLStatementList* list);
 
-  // Delete a prepared statement from the cache and the LRU list. "prepared_stmts_mutex_" needs to
-  // be locked before this call.
+  // Move a statement to the front of the LRU list. "prepared_stmts_mutex_" needs to be locked
+  // before this call.
+  void MoveLruStatementUnlocked(const std::shared_ptr<CQLStatement>& stmt, CQLStatementList* list);
+
+  // Delete a prepared or unprepared statement from its cache and LRU list.
+  // "prepared_stmts_mutex_" needs to be locked before this call.
   void DeletePreparedStatementUnlocked(const std::shared_ptr<const CQLStatement> stmt);
 
+  // Delete a statement from the given cache and LRU list if it is there. Return whether it was.
+  // "prepared_stmts_mutex_" needs to be locked before this call.
+  bool DeleteStatementUnlocked(
+      const std::shared_ptr<const CQLStatement>& stmt, CQLStatementMap* map,
+      CQLStatementList* list);
+
   // Delete the least recently used prepared statement from the cache to free up memory.
   void CollectGarbage(size_t required) override;
 
+  // Delete the least recently used unprepared statement from the cache to free up memory.
+  void CollectUnpreparedGarbage(size_t required);
+
   // CQLServer of this service.
   CQLServer* const server_;
 
@@ -145,7 +174,11 @@ class CQLServiceImpl : public CQLServerServiceIf,
   // Prepared statements LRU list (least recently used one at the end).
   CQLStatementList prepared_stmts_list_;
 
-  // Mutex that protects the prepared statements and the LRU list.
+  // Cache and LRU list of statements of queries that were not prepared by the client.
+  CQLStatementMap unprepared_stmts_map_;
+  CQLStatementList unprepared_stmts_list_;
+
+  // Mutex that protects the prepared and unprepared statements and the LRU lists.
   std::mutex prepared_stmts_mutex_;
 
   std::shared_ptr<ql::Statement> auth_prepared_stmt_;
@@ -153,6 +186,10 @@ class CQLServiceImpl : public CQLServerServiceIf,
   // Tracker to measure and limit memory usage of prepared statements.
   MemTrackerPtr prepared_stmts_mem_tracker_;
 
+  // Tracker to measure and limit memory usage of unprepared statements, and its garbage collector.
+  MemTrackerPtr unprepared_stmts_mem_tracker_;
+  std::shared_ptr<GarbageCollector> unprepared_stmts_collector_;
+
   // Metrics to be collected and reported.
   yb::rpc::RpcMethodMetrics metrics_;
 
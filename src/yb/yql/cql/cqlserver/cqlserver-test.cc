@@ -15,6 +15,9 @@
 #include <string>
 #include <vector>
 
+#include <lz4.h>
+#include <snappy.h>
+
 #include "yb/gutil/strings/substitute.h"
 #include "yb/integration-tests/yb_table_test_base.h"
 
@@ -266,6 +269,71 @@ TEST_F(TestCQLService, TestCQLServerEventConst) {
   ASSERT_EQ(0, memcmp(buffer, ptr, kSize));
 }
 
+TEST_F(TestCQLService, CompressedResponse) {
+  const string kLongMessage(1000, 'x');
+  for (auto scheme : {CQLMessage::CompressionScheme::kLz4,
+                      CQLMessage::CompressionScheme::kSnappy}) {
+    faststring plain;
+    ErrorResponse(0, ErrorResponse::Code::SERVER_ERROR, kLongMessage).Serialize(
+        CQLMessage::CompressionScheme::kNone, &plain);
+    faststring compressed;
+    ErrorResponse(0, ErrorResponse::Code::SERVER_ERROR, kLongMessage).Serialize(
+        scheme, &compressed);
+    ASSERT_TRUE(compressed[CQLMessage::kHeaderPosFlags] & CQLMessage::kCompressionFlag)
+        << "Compression flag is not set";
+    ASSERT_LT(compressed.size(), plain.size());
+    ASSERT_EQ(NetworkByteOrder::Load32(compressed.data() + CQLMessage::kHeaderPosLength),
+              compressed.size() - CQLMessage::kMessageHeaderLength);
+
+    const Slice plain_body(plain.data() + CQLMessage::kMessageHeaderLength,
+                           plain.size() - CQLMessage::kMessageHeaderLength);
+    const Slice compressed_body(compressed.data() + CQLMessage::kMessageHeaderLength,
+                                compressed.size() - CQLMessage::kMessageHeaderLength);
+    string uncompressed;
+    if (scheme == CQLMessage::CompressionScheme::kLz4) {
+      const auto size = NetworkByteOrder::Load32(compressed_body.data());
+      ASSERT_EQ(size, plain_body.size());
+      uncompressed.resize(size);
+      ASSERT_EQ(LZ4_decompress_safe(
+          compressed_body.cdata() + sizeof(uint32_t), &uncompressed[0],
+          compressed_body.size() - sizeof(uint32_t), size), static_cast<int>(size));
+    } else {
+      ASSERT_TRUE(snappy::Uncompress(
+          compressed_body.cdata(), compressed_body.size(), &uncompressed));
+    }
+    ASSERT_EQ(uncompressed, plain_body.ToBuffer());
+
+    // A body that does not get smaller after compression is sent uncompressed.
+    faststring small;
+    ErrorResponse(0, ErrorResponse::Code::SERVER_ERROR, "x").Serialize(scheme, &small);
+    ASSERT_FALSE(small[CQLMessage::kHeaderPosFlags] & CQLMessage::kCompressionFlag)
+        << "Compression flag is set";
+  }
+
+  // Compressed request that claims an uncompressed size above the message length limit.
+  unique_ptr<CQLRequest> request;
+  unique_ptr<CQLResponse> response;
+  ASSERT_FALSE(CQLRequest::ParseRequest(
+      BINARY_STRING("\x04\x01\x00\x00\x07" "\x00\x00\x00\x05" "\xff\xff\xff\xff" "\x00"),
+      CQLMessage::CompressionScheme::kLz4, &request, &response));
+  ASSERT_NE(response, nullptr);
+  ASSERT_EQ(request, nullptr);
+}
+
+// A large serialized response should be sent without copying it once more.
+TEST_F(TestCQLService, AdoptSerializedResponse) {
+  const string kLongMessage(100000, 'x');
+  faststring msg;
+  ErrorResponse(0, ErrorResponse::Code::SERVER_ERROR, kLongMessage).Serialize(
+      CQLMessage::CompressionScheme::kNone, &msg);
+  const string expected = msg.ToString();
+  const auto* data = msg.data();
+  RefCntBuffer buffer(std::move(msg));
+  ASSERT_EQ(buffer.udata(), data);
+  ASSERT_EQ(buffer.ToBuffer(), expected);
+  ASSERT_TRUE(msg.empty());
+}
+
 void TestCQLService::TestSchemaChangeEvent() {
   LOG(INFO) << "Test CQL SCHEMA_CHANGE event with gflag cql_server_always_send_events = " <<
       FLAGS_cql_server_always_send_events;
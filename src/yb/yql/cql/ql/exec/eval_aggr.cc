@@ -35,15 +35,41 @@ Status Executor::AggregateResultSets(const PTSelectStmt* pt_select, TnodeContext
   shared_ptr<RowsResult> rows_result = tnode_context->rows_result();
   DCHECK(rows_result->client() == QLClient::YQL_CLIENT_CQL);
   shared_ptr<QLRowBlock> row_block = rows_result->GetRowBlock();
-  int column_index = 0;
   faststring buffer;
 
-  CQLEncodeLength(1, &buffer);
+  if (pt_select->is_grouped()) {
+    // The grouping columns include all hash columns, so every group is read from a single tablet,
+    // and each row holds the partial aggregates of a whole group.
+    CQLEncodeLength(row_block->row_count(), &buffer);
+    for (const QLRow& row : row_block->rows()) {
+      auto group_block = std::make_shared<QLRowBlock>(row_block->schema());
+      RETURN_NOT_OK(group_block->AddRow(row));
+      RETURN_NOT_OK(AggregateRows(pt_select, group_block, rows_result.get(), &buffer));
+    }
+  } else {
+    CQLEncodeLength(1, &buffer);
+    RETURN_NOT_OK(AggregateRows(pt_select, row_block, rows_result.get(), &buffer));
+  }
+
+  // Change the result set to the aggregate result.
+  rows_result->set_rows_data(buffer.c_str(), buffer.size());
+  return Status::OK();
+}
+
+Status Executor::AggregateRows(const PTSelectStmt* pt_select,
+                               const shared_ptr<QLRowBlock>& row_block,
+                               RowsResult* rows_result,
+                               faststring* buffer) {
+  int column_index = 0;
   for (auto expr_node : pt_select->selected_exprs()) {
     QLValue ql_value;
 
     switch (expr_node->aggregate_opcode()) {
       case TSOpcode::kNoOp:
+        // A non-aggregate value is a grouping column, that is the same in all rows of the group.
+        if (row_block->row_count() > 0) {
+          ql_value = row_block->row(0).column(column_index);
+        }
         break;
       case TSOpcode::kAvg:
         RETURN_NOT_OK(EvalAvg(row_block, column_index, expr_node->ql_type()->main(),
@@ -68,12 +94,9 @@ Status Executor::AggregateResultSets(const PTSelectStmt* pt_select, TnodeContext
     }
 
     // Serialize the return value.
-    ql_value.Serialize(expr_node->ql_type(), rows_result->client(), &buffer);
+    ql_value.Serialize(expr_node->ql_type(), rows_result->client(), buffer);
     column_index++;
   }
-
-  // Change the result set to the aggregate result.
-  rows_result->set_rows_data(buffer.c_str(), buffer.size());
   return Status::OK();
 }
 
@@ -153,14 +176,11 @@ Status Executor::EvalSum(const shared_ptr<QLRowBlock>& row_block,
         ql_value->set_double_value(ql_value->double_value() +
                                    row.column(column_index).double_value());
         break;
-      case DataType::DECIMAL: {
-        Decimal sum, value;
-        RETURN_NOT_OK(sum.DecodeFromComparable(ql_value->decimal_value()));
-        RETURN_NOT_OK(value.DecodeFromComparable(row.column(column_index).decimal_value()));
-        sum = sum + value;
-        ql_value->set_decimal_value(sum.EncodeToComparable());
+      case DataType::DECIMAL:
+        RETURN_NOT_OK(util::AddComparableDecimals(
+            ql_value->decimal_value(), row.column(column_index).decimal_value(),
+            ql_value->mutable_decimal_value()));
         break;
-      }
       default:
         return STATUS(RuntimeError, "Unexpected datatype for argument of SUM()");
     }
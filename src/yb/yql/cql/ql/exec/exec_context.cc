@@ -168,6 +168,7 @@ void ExecContext::Reset(const Restart restart, Rescheduler* rescheduler) {
   }
   restart_ = restart;
   tnode_contexts_.clear();
+  batch_session_ = nullptr;
   if (restart) {
     num_retries_++;
   }
@@ -255,6 +255,16 @@ class ExecContext : public ProcessContextBase {
     return transactional_session_;
   }
 
+  // Return the non-transactional session of the statement when it is executed in a split batch,
+  // nullptr otherwise.
+  const client::YBSessionPtr& batch_session() const {
+    return batch_session_;
+  }
+
+  void set_batch_session(client::YBSessionPtr session) {
+    batch_session_ = std::move(session);
+  }
+
   // Does this statement have pending operations?
   bool HasPendingOperations() const;
 
@@ -286,6 +296,10 @@ class ExecContext : public ProcessContextBase {
   client::YBSessionPtr transactional_session_;
   MonoTime transaction_start_time_;
 
+  // Session of the sub-batch to apply non-transactional write operations in, when the batch of
+  // this statement is split.
+  client::YBSessionPtr batch_session_;
+
   // The number of times this statement has been retried.
   int64_t num_retries_ = 0;
 };
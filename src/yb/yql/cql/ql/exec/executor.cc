@@ -38,6 +38,17 @@
 #include "yb/util/thread_restrictions.h"
 #include "yb/util/trace.h"
 
+DEFINE_int32(cql_batch_split_min_statements, 0,
+             "Non-transactional CQL batches with at least this many statements are split into "
+             "sub-batches by the tablets their rows belong to. Each sub-batch is flushed "
+             "independently, so statements are processed as soon as their tablet responds "
+             "instead of after the whole batch. 0 disables splitting.");
+
+DEFINE_int32(cql_uncovered_index_read_chunk_size, 0,
+             "Max number of primary keys read from an uncovered secondary index per request. The "
+             "rows of a chunk are fetched from the indexed table while the next chunk is read "
+             "from the index, instead of after the whole page is read. 0 reads full pages.");
+
 namespace yb {
 namespace ql {
 
@@ -160,6 +171,8 @@ void Executor::ExecuteAsync(const StatementBatch& batch, StatementExecutedCallba
     }
   }
 
+  split_batch_ = FLAGS_cql_batch_split_min_statements > 0 &&
+                 batch.size() >= static_cast<size_t>(FLAGS_cql_batch_split_min_statements);
   for (const auto& pair : batch) {
     const ParseTree& parse_tree = pair.first;
     const StatementParameters& params = pair.second;
@@ -781,6 +794,21 @@ Status Executor::GetOffsetOrLimit(
 
 //--------------------------------------------------------------------------------------------------
 
+namespace {
+
+// Is this the nested select of primary keys from an uncovered index?
+bool IsUncoveredIndexSelect(const PTSelectStmt* tnode) {
+  return !tnode->index_id().empty() && !tnode->covers_fully();
+}
+
+// Max number of rows to read from an uncovered index per request.
+uint64_t IndexReadChunkSize() {
+  return FLAGS_cql_uncovered_index_read_chunk_size > 0
+      ? FLAGS_cql_uncovered_index_read_chunk_size : std::numeric_limits<uint64_t>::max();
+}
+
+} // namespace
+
 Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_context) {
   const shared_ptr<client::YBTable>& table = tnode->table();
   if (table == nullptr) {
@@ -817,6 +845,9 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
   // Where clause - Hash, range, and regular columns.
 
   req->set_is_aggregate(tnode->is_aggregate());
+  for (const ColumnDesc* desc : tnode->group_by_columns()) {
+    req->add_group_by_column_ids(desc->id());
+  }
 
   Result<uint64_t> max_rows_estimate = WhereClauseToPB(req, tnode->key_where_ops(),
                                                        tnode->where_ops(),
@@ -971,6 +1002,14 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
     return Status::OK();
   }
 
+  // When reading primary keys from an uncovered index, read in chunks to pipeline the index reads
+  // with the reads from the indexed table. A paging state is required to continue after a chunk.
+  if (IsUncoveredIndexSelect(tnode) && req->has_limit() &&
+      req->limit() > IndexReadChunkSize()) {
+    req->set_limit(IndexReadChunkSize());
+    req->set_return_paging_state(true);
+  }
+
   // Add the operation.
   return AddOperation(select_op, tnode_context);
 }
@@ -1073,7 +1112,11 @@ Result<bool> Executor::FetchMoreRows(const PTSelectStmt* tnode,
   // Fetch more results.
 
   // Update limit, offset and paging_state information for next scan request.
-  op->mutable_request()->set_limit(fetch_limit - current_fetch_row_count);
+  uint64_t next_limit = fetch_limit - current_fetch_row_count;
+  if (IsUncoveredIndexSelect(tnode)) {
+    next_limit = std::min(next_limit, IndexReadChunkSize());
+  }
+  op->mutable_request()->set_limit(next_limit);
   if (tnode->offset()) {
     QLExpressionPB offset_pb;
     RETURN_NOT_OK(PTExprToPB(tnode->offset(), &offset_pb));
@@ -1497,6 +1540,11 @@ void Executor::FlushAsync() {
   if (session_->CountBufferedOperations() > 0) {
     flush_sessions.push_back({session_, nullptr});
   }
+  for (const auto& entry : batch_sessions_) {
+    if (entry.second->CountBufferedOperations() > 0) {
+      flush_sessions.push_back({entry.second, nullptr});
+    }
+  }
   for (ExecContext& exec_context : exec_contexts_) {
     if (exec_context.HasTransaction()) {
       auto transactional_session = exec_context.transactional_session();
@@ -1532,8 +1580,8 @@ void Executor::FlushAsync() {
     auto exec_context = pair.second;
     session->SetRejectionScoreSource(rejection_score_source);
     TRACE("Flush Async");
-    session->FlushAsync([this, exec_context](const Status& s) {
-        FlushAsyncDone(s, exec_context);
+    session->FlushAsync([this, session, exec_context](const Status& s) {
+        FlushAsyncDone(session, s, exec_context);
       });
   }
 
@@ -1565,11 +1613,11 @@ void Executor::FlushAsync() {
 // ExecContexts, care must be taken so that the callbacks only update the individual ExecContexts.
 // Any update on data structures shared in Executor should either be protected by a mutex or
 // deferred to ProcessAsyncResults() that will be invoked exclusively.
-void Executor::FlushAsyncDone(Status s, ExecContext* exec_context) {
+void Executor::FlushAsyncDone(const YBSessionPtr& session, Status s, ExecContext* exec_context) {
   TRACE("Flush Async Done");
-  // Process FlushAsync status for either transactional session in an ExecContext, or the
-  // non-transactional session in the Executor for other ExecContexts with no transactional session.
-  const YBSessionPtr& session = exec_context != nullptr ? GetSession(exec_context) : session_;
+  // Process FlushAsync status for either transactional session in an ExecContext, or a
+  // non-transactional session for the ExecContexts with no transactional session that apply their
+  // operations in it.
 
   // When any error occurs during the dispatching of YBOperation, YBSession saves the error and
   // returns IOError. When it happens, retrieves the errors and discard the IOError.
@@ -1590,7 +1638,7 @@ void Executor::FlushAsyncDone(Status s, ExecContext* exec_context) {
       }
     } else {
       for (auto& exec_context : exec_contexts_) {
-        if (!exec_context.HasTransaction()) {
+        if (!exec_context.HasTransaction() && GetSession(&exec_context) == session) {
           s = ProcessAsyncStatus(op_errors, &exec_context);
           if (!s.ok()) {
             std::lock_guard<std::mutex> lock(status_mutex_);
@@ -2141,6 +2189,13 @@ Status Executor::AddOperation(const YBqlReadOpPtr& op, TnodeContext *tnode_conte
 Status Executor::AddOperation(const YBqlWriteOpPtr& op, TnodeContext *tnode_context) {
   tnode_context->AddOperation(op);
 
+  // In a split batch, all operations of a statement, including its index updates, are applied in
+  // the sub-batch of its first operation. So concurrent FlushAsyncDone() callbacks of different
+  // sub-batches never process the same ExecContext.
+  if (split_batch_ && !exec_context_->HasTransaction() && !exec_context_->batch_session()) {
+    exec_context_->set_batch_session(VERIFY_RESULT(GetBatchSession(op)));
+  }
+
   // Check for inter-dependency in the current write batch before applying the write operation.
   // Apply it in the transactional session in exec_context for the current statement if there is
   // one. Otherwise, apply to the non-transactional session in the executor.
@@ -2158,6 +2213,19 @@ Status Executor::AddOperation(const YBqlWriteOpPtr& op, TnodeContext *tnode_cont
   return UpdateIndexes(dml_stmt, op->mutable_request(), tnode_context);
 }
 
+Result<YBSessionPtr> Executor::GetBatchSession(const YBqlWriteOpPtr& op) {
+  string partition_key;
+  RETURN_NOT_OK(op->GetPartitionKey(&partition_key));
+  auto& session = batch_sessions_[
+      op->table()->id() + op->table()->FindPartitionStart(partition_key)];
+  if (session == nullptr) {
+    session = ql_env_->NewSession();
+    session->SetForceConsistentRead(client::ForceConsistentRead::kFalse);
+    session->SetReadPoint(client::Restart::kFalse);
+  }
+  return session;
+}
+
 //--------------------------------------------------------------------------------------------------
 
 Status Executor::ProcessStatementStatus(const ParseTree& parse_tree, const Status& s) {
@@ -2338,6 +2406,11 @@ void Executor::Reset() {
   exec_contexts_.clear();
   write_batch_.Clear();
   session_->Abort();
+  for (const auto& entry : batch_sessions_) {
+    entry.second->Abort();
+  }
+  batch_sessions_.clear();
+  split_batch_ = false;
   num_flushes_ = 0;
   result_ = nullptr;
   cb_.Reset();
@@ -177,15 +177,22 @@ class Executor : public QLExprExecutor {
 
   // Returns the YBSession for the statement in execution.
   client::YBSessionPtr GetSession(ExecContext* exec_context) {
-    return exec_context->HasTransaction() ? exec_context->transactional_session() : session_;
+    if (exec_context->HasTransaction()) {
+      return exec_context->transactional_session();
+    }
+    return exec_context->batch_session() ? exec_context->batch_session() : session_;
   }
 
+  // Returns the session of the sub-batch for the tablet the given write operation goes to.
+  Result<client::YBSessionPtr> GetBatchSession(const client::YBqlWriteOpPtr& op);
+
   // Flush operations that have been applied and commit. If there is none, finish the statement
   // execution.
   void FlushAsync();
 
   // Callback for FlushAsync.
-  void FlushAsyncDone(Status s, ExecContext* exec_context = nullptr);
+  void FlushAsyncDone(const client::YBSessionPtr& session, Status s,
+                      ExecContext* exec_context = nullptr);
 
   // Callback for Commit.
   void CommitDone(Status s, ExecContext* exec_context);
@@ -228,6 +235,11 @@ class Executor : public QLExprExecutor {
 
   // Aggregate all result sets from all tablet servers to form the requested resultset.
   CHECKED_STATUS AggregateResultSets(const PTSelectStmt* pt_select, TnodeContext* tnode_context);
+  // Aggregate the partial results in row_block into one row and serialize it into buffer.
+  CHECKED_STATUS AggregateRows(const PTSelectStmt* pt_select,
+                               const std::shared_ptr<QLRowBlock>& row_block,
+                               RowsResult* rows_result,
+                               faststring* buffer);
   CHECKED_STATUS EvalCount(const std::shared_ptr<QLRowBlock>& row_block,
                            int column_index,
                            QLValue *ql_value);
@@ -423,6 +435,13 @@ class Executor : public QLExprExecutor {
   // are applied using the corresponding transactional session in ExecContext.
   const client::YBSessionPtr session_;
 
+  // Whether the current batch is split into sub-batches by tablet, and the non-transactional
+  // sessions of the sub-batches keyed by table id and tablet partition start. Sub-batches are
+  // flushed independently, and the statements of a sub-batch are processed as soon as it
+  // completes.
+  bool split_batch_ = false;
+  std::unordered_map<std::string, client::YBSessionPtr> batch_sessions_;
+
   // The number of outstanding async calls pending, the async error status and the mutex to protect
   // its update.
   std::atomic<int64_t> num_async_calls_ = {0};
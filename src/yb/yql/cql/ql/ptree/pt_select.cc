@@ -17,6 +17,7 @@
 
 #include "yb/yql/cql/ql/ptree/pt_select.h"
 
+#include <algorithm>
 #include <functional>
 
 #include "yb/client/client.h"
@@ -264,7 +265,8 @@ PTSelectStmt::PTSelectStmt(MemoryContext *memctx,
       order_by_clause_(order_by_clause),
       limit_clause_(limit_clause),
       offset_clause_(offset_clause),
-      covering_exprs_(memctx) {
+      covering_exprs_(memctx),
+      group_by_columns_(memctx) {
 }
 
 // Construct a nested select tnode to select from the index. Only the syntactic information
@@ -287,6 +289,7 @@ PTSelectStmt::PTSelectStmt(MemoryContext *memctx,
       limit_clause_(other.limit_clause_),
       offset_clause_(other.offset_clause_),
       covering_exprs_(memctx),
+      group_by_columns_(memctx),
       index_id_(index_id),
       covers_fully_(covers_fully) {
 }
@@ -340,6 +343,7 @@ CHECKED_STATUS PTSelectStmt::Analyze(SemContext *sem_context) {
   RETURN_NOT_OK(selected_exprs_->Analyze(sem_context));
 
   sem_state.set_allowing_aggregate(false);
+  RETURN_NOT_OK(AnalyzeGroupByClause(sem_context));
   sem_state.set_allowing_column_refs(false);
 
   if (distinct_) {
@@ -352,12 +356,14 @@ CHECKED_STATUS PTSelectStmt::Analyze(SemContext *sem_context) {
   }
 
   // Check if this is an aggregate read.
+  // Values of the grouping columns are the same in all rows of a group, so they may be selected
+  // together with aggregate values.
   bool has_aggregate_expr = false;
   bool has_singular_expr = false;
   for (auto expr_node : selected_exprs_->node_list()) {
     if (expr_node->IsAggregateCall()) {
       has_aggregate_expr = true;
-    } else {
+    } else if (!IsGroupByColumnRef(*expr_node)) {
       has_singular_expr = true;
     }
   }
@@ -367,6 +373,10 @@ CHECKED_STATUS PTSelectStmt::Analyze(SemContext *sem_context) {
         "Selecting aggregate together with rows of non-aggregate values is not allowed",
         ErrorCode::CQL_STATEMENT_INVALID);
   }
+  if (is_grouped() && !has_aggregate_expr) {
+    return sem_context->Error(group_by_clause_, "GROUP BY requires aggregate values to select",
+                              ErrorCode::CQL_STATEMENT_INVALID);
+  }
   is_aggregate_ = has_aggregate_expr;
 
   // Run error checking on the WHERE conditions.
@@ -376,8 +386,9 @@ CHECKED_STATUS PTSelectStmt::Analyze(SemContext *sem_context) {
   RETURN_NOT_OK(AnalyzeIfClause(sem_context));
 
   // Check if there is an index to use. If there is and it covers the query fully, we will query
-  // just the index and that is it.
-  if (index_id_.empty()) {
+  // just the index and that is it. Groups are formed by the primary key of the indexed table, so
+  // grouped selects read the table itself.
+  if (index_id_.empty() && !is_grouped()) {
     RETURN_NOT_OK(AnalyzeIndexes(sem_context));
     if (child_select_ && child_select_->covers_fully_) {
       return Status::OK();
@@ -617,6 +628,56 @@ CHECKED_STATUS PTSelectStmt::AnalyzeDistinctClause(SemContext *sem_context) {
   return Status::OK();
 }
 
+CHECKED_STATUS PTSelectStmt::AnalyzeGroupByClause(SemContext *sem_context) {
+  if (having_clause_ != nullptr) {
+    return sem_context->Error(having_clause_, "HAVING clause is not supported",
+                              ErrorCode::FEATURE_NOT_SUPPORTED);
+  }
+  if (group_by_clause_ == nullptr) {
+    return Status::OK();
+  }
+
+  // Groups are aggregated by the tablets, so a group should not span tablets and should be
+  // contiguous in the scan order. That holds when the grouping columns are a prefix of the primary
+  // key that includes all hash columns.
+  RETURN_NOT_OK(group_by_clause_->Analyze(sem_context));
+  for (const auto& node : group_by_clause_->node_list()) {
+    const ColumnDesc* desc = nullptr;
+    if (node->opcode() == TreeNodeOpcode::kPTRef) {
+      desc = static_cast<const PTRef*>(node.get())->desc();
+    }
+    if (desc == nullptr || desc->index() != static_cast<int>(group_by_columns_.size())) {
+      return sem_context->Error(
+          node, "GROUP BY must list primary key columns in the order of the primary key",
+          ErrorCode::CQL_STATEMENT_INVALID);
+    }
+    group_by_columns_.push_back(desc);
+  }
+  if (group_by_columns_.size() < static_cast<size_t>(num_hash_key_columns())) {
+    return sem_context->Error(group_by_clause_, "GROUP BY must include all partition key columns",
+                              ErrorCode::CQL_STATEMENT_INVALID);
+  }
+  if (distinct_) {
+    return sem_context->Error(group_by_clause_, "GROUP BY is not supported with DISTINCT",
+                              ErrorCode::CQL_STATEMENT_INVALID);
+  }
+  if (limit_clause_ != nullptr || offset_clause_ != nullptr) {
+    return sem_context->Error(group_by_clause_,
+                              "GROUP BY is not supported with LIMIT or OFFSET clause",
+                              ErrorCode::FEATURE_NOT_SUPPORTED);
+  }
+  return Status::OK();
+}
+
+bool PTSelectStmt::IsGroupByColumnRef(const PTExpr& expr) const {
+  if (expr.opcode() != TreeNodeOpcode::kPTRef) {
+    return false;
+  }
+  const ColumnDesc* desc = static_cast<const PTRef&>(expr).desc();
+  return std::find(group_by_columns_.begin(), group_by_columns_.end(), desc) !=
+         group_by_columns_.end();
+}
+
 bool PTSelectStmt::IsReadableByAllSystemTable() const {
   const client::YBTableName t = table_name();
   const string& keyspace = t.namespace_name();
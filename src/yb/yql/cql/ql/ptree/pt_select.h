@@ -201,6 +201,16 @@ class PTSelectStmt : public PTDmlStmt {
     return selected_exprs_->node_list();
   }
 
+  // Columns of the GROUP BY clause in the clause order. They form a prefix of the primary key
+  // that includes all hash columns. Empty when the select is not grouped.
+  const MCVector<const ColumnDesc*>& group_by_columns() const {
+    return group_by_columns_;
+  }
+
+  bool is_grouped() const {
+    return !group_by_columns_.empty();
+  }
+
   // Returns table name.
   virtual client::YBTableName table_name() const override {
     // CQL only allows one table at a time.
@@ -260,6 +270,9 @@ class PTSelectStmt : public PTDmlStmt {
   CHECKED_STATUS LookupIndex(SemContext *sem_context);
   CHECKED_STATUS AnalyzeIndexes(SemContext *sem_context);
   CHECKED_STATUS AnalyzeDistinctClause(SemContext *sem_context);
+  CHECKED_STATUS AnalyzeGroupByClause(SemContext *sem_context);
+  // Is the expression a reference to a column of the GROUP BY clause?
+  bool IsGroupByColumnRef(const PTExpr& expr) const;
   CHECKED_STATUS AnalyzeOrderByClause(SemContext *sem_context);
   CHECKED_STATUS AnalyzeLimitClause(SemContext *sem_context);
   CHECKED_STATUS AnalyzeOffsetClause(SemContext *sem_context);
@@ -291,6 +304,7 @@ class PTSelectStmt : public PTDmlStmt {
 
   bool is_forward_scan_ = true;
   bool is_aggregate_ = false;
+  MCVector<const ColumnDesc*> group_by_columns_;
 
   // Child select statement. Currently only a select statement using an index (covered or uncovered)
   // has a child select statement to query an index.
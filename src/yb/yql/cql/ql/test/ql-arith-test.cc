@@ -21,6 +21,9 @@
 #include "yb/yql/cql/ql/test/ql-test-base.h"
 #include "yb/gutil/strings/substitute.h"
 
+DECLARE_bool(ycql_blind_counter_updates);
+DECLARE_int32(ycql_counter_deltas_per_full_value);
+
 using std::string;
 using std::unique_ptr;
 using std::shared_ptr;
@@ -188,6 +191,48 @@ TEST_F(TestQLArith, TestQLArithCounter) {
   const QLRow& new_row = row_block->row(0);
   CHECK_EQ(new_row.column(0).int32_value(), 1);
   CHECK_EQ(new_row.column(1).int64_value(), 87);
+
+  // Decrement a counter and increment another one.
+  CHECK_VALID_STMT("UPDATE test_counter SET c1 = c1 - 7, c2 = c2 + 5 WHERE h1 = 1;");
+
+  // Select counters.
+  CHECK_VALID_STMT("SELECT * FROM test_counter WHERE h1 = 1");
+  row_block = processor->row_block();
+  CHECK_EQ(row_block->row_count(), 1);
+  const QLRow& last_row = row_block->row(0);
+  CHECK_EQ(last_row.column(0).int32_value(), 1);
+  CHECK_EQ(last_row.column(1).int64_value(), 80);
+  CHECK_EQ(last_row.column(2).int64_value(), 5);
+  CHECK(last_row.column(3).IsNull());
+}
+
+// Counter updates written as deltas, that are periodically folded by writing the full value.
+TEST_F(TestQLArith, TestQLArithBlindCounter) {
+  FLAGS_ycql_blind_counter_updates = true;
+  FLAGS_ycql_counter_deltas_per_full_value = 3;
+
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster());
+
+  // Get a processor.
+  TestQLProcessor *processor = GetQLProcessor();
+  CHECK_VALID_STMT("CREATE TABLE test_counter(h1 int primary key, c1 counter, c2 counter);");
+
+  int64_t c1 = 0;
+  int64_t c2 = 0;
+  for (int i = 1; i <= 20; ++i) {
+    CHECK_VALID_STMT(Substitute(
+        "UPDATE test_counter SET c1 = c1 + $0, c2 = c2 - 1 WHERE h1 = 1;", i));
+    c1 += i;
+    --c2;
+
+    CHECK_VALID_STMT("SELECT * FROM test_counter WHERE h1 = 1");
+    auto row_block = processor->row_block();
+    ASSERT_EQ(row_block->row_count(), 1);
+    const QLRow& row = row_block->row(0);
+    ASSERT_EQ(row.column(1).int64_value(), c1);
+    ASSERT_EQ(row.column(2).int64_value(), c2);
+  }
 }
 
 TEST_F(TestQLArith, TestQLErrorArithCounter) {
@@ -13,6 +13,7 @@
 //
 //--------------------------------------------------------------------------------------------------
 
+#include <set>
 #include <thread>
 #include <cmath>
 
@@ -21,6 +22,7 @@
 #include "yb/common/ql_value.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/master/master.h"
+#include "yb/master/ts_descriptor.h"
 #include "yb/master/ts_manager.h"
 #include "yb/util/yb_partition.h"
 #include "yb/util/crypt.h"
@@ -1582,6 +1584,46 @@ TEST_F(TestQLQuery, TestInvalidPeerTableEntries) {
   }
 }
 
+// The replica addresses of system.partitions are updated when a tablet server re-registers with
+// another address, even though the replica locations of its tablets are unchanged.
+TEST_F(TestQLQuery, TestPartitionsAfterReregistration) {
+  ASSERT_NO_FATALS(CreateSimulatedCluster(1));
+  ASSERT_OK(cluster_->WaitForTabletServerCount(1));
+  TestQLProcessor* processor = GetQLProcessor();
+  ASSERT_OK(processor->Run("CREATE TABLE partitions_test (k int PRIMARY KEY)"));
+
+  // Returns the set of replica addresses of the test table tablets.
+  auto replica_hosts = [processor]() -> Result<std::set<std::string>> {
+    RETURN_NOT_OK(processor->Run("SELECT * FROM system.partitions"));
+    std::set<std::string> hosts;
+    for (const auto& row : processor->row_block()->rows()) {
+      if (row.column(1).string_value() != "partitions_test") {
+        continue;
+      }
+      for (const auto& key : row.column(5).map_value().keys()) {
+        hosts.insert(QLValue::inetaddress_value(key).ToString());
+      }
+    }
+    return hosts;
+  };
+
+  const auto& instance = cluster_->mini_tablet_server(0)->server()->instance_pb();
+  auto ts_manager = cluster_->leader_mini_master()->master()->ts_manager();
+  master::TSDescriptorPtr ts_desc;
+  ASSERT_TRUE(ts_manager->LookupTSByUUID(instance.permanent_uuid(), &ts_desc));
+  master::TSRegistrationPB registration = ts_desc->GetTSInformationPB()->registration();
+  const std::string old_host = registration.common().private_rpc_addresses(0).host();
+  ASSERT_OK(WaitFor([&]() -> Result<bool> {
+    return VERIFY_RESULT(replica_hosts()) == std::set<std::string>{old_host};
+  }, MonoDelta::FromSeconds(30), "Tablets of the test table are running"));
+
+  const std::string new_host = "127.0.0.203";
+  registration.mutable_common()->mutable_private_rpc_addresses(0)->set_host(new_host);
+  ASSERT_OK(ts_manager->RegisterTS(instance, registration, CloudInfoPB(), nullptr));
+
+  ASSERT_EQ(ASSERT_RESULT(replica_hosts()), std::set<std::string>{new_host});
+}
+
 TEST_F(TestQLQuery, TestPagination) {
   // Init the simulated cluster.
   ASSERT_NO_FATALS(CreateSimulatedCluster());
@@ -5,6 +5,7 @@
 #include <thread>
 #include <cmath>
 #include <limits>
+#include <set>
 
 #include "yb/yql/cql/ql/test/ql-test-base.h"
 #include "yb/gutil/strings/substitute.h"
@@ -615,6 +616,75 @@ TEST_F(QLTestSelectedExpr, TestAggregateExprWithNull) {
   }
 }
 
+TEST_F(QLTestSelectedExpr, TestGroupByAggregate) {
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster());
+
+  // Get a processor.
+  TestQLProcessor *processor = GetQLProcessor();
+  LOG(INFO) << "Test aggregate functions with GROUP BY clause.";
+
+  CHECK_VALID_STMT("CREATE TABLE test_group_by(h int, r1 int, r2 int, v int,"
+                   "                           primary key(h, r1, r2));");
+  for (int h = 0; h < 4; h++) {
+    for (int r1 = 0; r1 < 3; r1++) {
+      for (int r2 = 0; r2 < 5; r2++) {
+        CHECK_VALID_STMT(strings::Substitute(
+            "INSERT INTO test_group_by(h, r1, r2, v) VALUES($0, $1, $2, $3);",
+            h, r1, r2, h * 100 + r1 * 10 + r2));
+      }
+    }
+  }
+
+  std::shared_ptr<QLRowBlock> row_block;
+
+  // Group by the hash column. Groups come back in the hash order, so they are not checked by
+  // position.
+  CHECK_VALID_STMT("SELECT h, count(*), sum(v) FROM test_group_by GROUP BY h;");
+  row_block = processor->row_block();
+  CHECK_EQ(row_block->row_count(), 4);
+  std::set<int32_t> seen_groups;
+  for (const auto& row : row_block->rows()) {
+    const int32_t h = row.column(0).int32_value();
+    CHECK(seen_groups.insert(h).second);
+    CHECK_EQ(row.column(1).int64_value(), 15);
+    CHECK_EQ(row.column(2).int32_value(), 15 * h * 100 + 5 * (0 + 10 + 20) + 3 * 10);
+  }
+
+  // Group by a primary key prefix that includes a range column.
+  CHECK_VALID_STMT("SELECT h, r1, count(*), min(v), max(v) FROM test_group_by GROUP BY h, r1;");
+  row_block = processor->row_block();
+  CHECK_EQ(row_block->row_count(), 12);
+  for (const auto& row : row_block->rows()) {
+    const int32_t base = row.column(0).int32_value() * 100 + row.column(1).int32_value() * 10;
+    CHECK_EQ(row.column(2).int64_value(), 5);
+    CHECK_EQ(row.column(3).int32_value(), base);
+    CHECK_EQ(row.column(4).int32_value(), base + 4);
+  }
+
+  // Group within a single partition, groups are returned in the clustering order.
+  CHECK_VALID_STMT("SELECT r1, sum(v) FROM test_group_by WHERE h = 1 GROUP BY h, r1;");
+  row_block = processor->row_block();
+  CHECK_EQ(row_block->row_count(), 3);
+  for (int r1 = 0; r1 < 3; r1++) {
+    const QLRow& row = row_block->row(r1);
+    CHECK_EQ(row.column(0).int32_value(), r1);
+    CHECK_EQ(row.column(1).int32_value(), 5 * (100 + r1 * 10) + 10);
+  }
+
+  // Only primary key prefixes that include the hash columns are supported.
+  CHECK_INVALID_STMT("SELECT count(*) FROM test_group_by GROUP BY r1;");
+  CHECK_INVALID_STMT("SELECT count(*) FROM test_group_by GROUP BY h, r2;");
+  CHECK_INVALID_STMT("SELECT count(*) FROM test_group_by GROUP BY v;");
+  // Selected columns must be grouped.
+  CHECK_INVALID_STMT("SELECT v, count(*) FROM test_group_by GROUP BY h;");
+  // Aggregate is required.
+  CHECK_INVALID_STMT("SELECT h FROM test_group_by GROUP BY h;");
+  // Unsupported clauses.
+  CHECK_INVALID_STMT("SELECT h, count(*) FROM test_group_by GROUP BY h LIMIT 2;");
+  CHECK_INVALID_STMT("SELECT h, count(*) FROM test_group_by GROUP BY h HAVING count(*) > 1;");
+}
+
 TEST_F(QLTestSelectedExpr, TestQLSelectNumericExpr) {
   // Init the simulated cluster.
   ASSERT_NO_FATALS(CreateSimulatedCluster());
@@ -183,6 +183,11 @@ Status PgCreateTable::Exec() {
       transactional ? "transactional" : "non-transactional", table_name_.ToString());
   if (transactional) {
     table_properties.SetTransactional(true);
+  }
+  if (packed_row_) {
+    table_properties.SetUsePackedRow(true);
+  }
+  if (transactional || packed_row_) {
     schema_builder_.SetTableProperties(table_properties);
   }
 
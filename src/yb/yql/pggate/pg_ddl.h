@@ -168,6 +168,11 @@ class PgCreateTable : public PgDdl {
   // Specify the number of tablets explicitly.
   virtual CHECKED_STATUS SetNumTablets(int32_t num_tablets);
 
+  // Store inserted rows of the table as packed rows.
+  void SetPackedRow(bool packed_row) {
+    packed_row_ = packed_row;
+  }
+
   // Execute.
   virtual CHECKED_STATUS Exec();
 
@@ -188,6 +193,7 @@ class PgCreateTable : public PgDdl {
   bool is_shared_table_;
   bool if_not_exist_;
   bool colocated_ = true;
+  bool packed_row_ = false;
   boost::optional<YBHashSchema> hash_schema_;
   std::vector<std::string> range_columns_;
   client::YBSchemaBuilder schema_builder_;
@@ -214,6 +214,21 @@ Status PgDmlRead::BindColumnCondEq(int attr_num, PgExpr *attr_value) {
   return Status::OK();
 }
 
+Status PgDmlRead::AppendWhereExpr(PgExpr *where_expr) {
+  if (!where_expr->is_condition()) {
+    return STATUS(InvalidArgument, "WHERE expression must be a condition");
+  }
+
+  // All conditions are combined with AND, so DocDB returns only the rows that match all of them.
+  if (!read_req_->has_where_expr()) {
+    read_req_->mutable_where_expr()->mutable_condition()->set_op(QL_OP_AND);
+  }
+  PgsqlExpressionPB *expr_pb = read_req_->mutable_where_expr()->mutable_condition()->add_operands();
+
+  // Columns referenced by the condition are added to column refs, so DocDB reads them.
+  return where_expr->PrepareForRead(this, expr_pb);
+}
+
 Status PgDmlRead::BindColumnCondBetween(int attr_num, PgExpr *attr_value, PgExpr *attr_value_end) {
   if (secondary_index_query_) {
     // Bind by secondary key.
@@ -75,6 +75,9 @@ class PgDmlRead : public PgDml {
   // Bind a column with an IN condition.
   CHECKED_STATUS BindColumnCondIn(int attnum, int n_attr_values, PgExpr **attr_values);
 
+  // Add a condition of WHERE clause, that is evaluated by DocDB for every scanned row.
+  CHECKED_STATUS AppendWhereExpr(PgExpr *where_expr);
+
   // Execute.
   virtual CHECKED_STATUS Exec(const PgExecParameters *exec_params);
 
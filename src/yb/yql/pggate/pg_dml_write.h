@@ -42,6 +42,10 @@ class PgDmlWrite : public PgDml {
     write_req_->set_is_ysql_catalog_change(true);
   }
 
+  void SetCatalogInvalidationMessages(const Slice& messages) {
+    write_req_->set_ysql_catalog_invalidation_messages(messages.cdata(), messages.size());
+  }
+
   void SetCatalogCacheVersion(const uint64_t catalog_cache_version) override {
     write_req_->set_ysql_catalog_version(catalog_cache_version);
   }
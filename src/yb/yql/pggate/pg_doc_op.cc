@@ -106,6 +106,7 @@ PgDocOp::PgDocOp(const PgSession::ScopedRefPtr& pg_session)
   exec_params_.limit_count = FLAGS_ysql_prefetch_limit;
   exec_params_.limit_offset = 0;
   exec_params_.limit_use_default = true;
+  exec_params_.limit_applies_to_scan = false;
 }
 
 PgDocOp::~PgDocOp() {
@@ -194,6 +195,7 @@ void PgDocReadOp::Initialize(const PgExecParameters *exec_params) {
   PgDocOp::Initialize(exec_params);
 
   can_produce_more_ops_ = true;
+  rows_fetched_ = 0;
   template_op_->mutable_request()->set_return_paging_state(true);
   SetRequestPrefetchLimit();
   SetRowMark();
@@ -304,13 +306,46 @@ void PgDocReadOp::SetRequestPrefetchLimit() {
   req->set_limit(limit_count);
 }
 
+int64_t PgDocReadOp::StatementRowLimit() const {
+  // LIMIT ALL is passed as zero count, LIMIT 0 does not reach DocDB at all.
+  if (exec_params_.limit_use_default || !exec_params_.limit_applies_to_scan ||
+      exec_params_.limit_count <= 0 ||
+      template_op_->request().is_aggregate()) {
+    return 0;
+  }
+  return exec_params_.limit_count + exec_params_.limit_offset;
+}
+
+bool PgDocReadOp::ApplyStatementRowLimit(int64_t rows_fetched) {
+  const auto row_limit = StatementRowLimit();
+  if (row_limit <= 0) {
+    return false;
+  }
+  rows_fetched_ += rows_fetched;
+  if (rows_fetched_ >= row_limit) {
+    return true;
+  }
+  // Next pages, e.g. from the following tablets of a range partitioned table, have to return only
+  // the rows that are still missing.
+  const auto remaining = static_cast<uint64_t>(row_limit - rows_fetched_);
+  for (auto& read_op : read_ops_) {
+    auto* req = read_op->mutable_request();
+    if (req->limit() > remaining) {
+      req->set_limit(remaining);
+    }
+  }
+  return false;
+}
+
 void PgDocReadOp::SetRowMark() {
   PgsqlReadRequestPB *const req = template_op_->mutable_request();
 
   if (exec_params_.rowmark < 0) {
     req->clear_row_mark_type();
+    req->clear_wait_policy();
   } else {
     req->set_row_mark_type(static_cast<yb::RowMarkType>(exec_params_.rowmark));
+    req->set_wait_policy(static_cast<yb::RowMarkWaitPolicy>(exec_params_.wait_policy));
   }
 }
 
@@ -320,6 +355,10 @@ void PgDocReadOp::InitializeNextOps(int num_ops) {
   }
 
   if (template_op_->request().partition_column_values_size() == 0) {
+    if (IsParallelScan()) {
+      InitializeNextPartitionOps(num_ops);
+      return;
+    }
     // TODO(dmitry): Use template_op_ directly instead of copy in case of single partition expr.
     read_ops_.push_back(template_op_->DeepCopy());
     can_produce_more_ops_ = false;
@@ -373,6 +412,61 @@ void PgDocReadOp::InitializeNextOps(int num_ops) {
   DCHECK(!read_ops_.empty()) << "read_ops_ should not be empty after setting!";
 }
 
+bool PgDocReadOp::IsParallelScan() const {
+  if (num_hash_key_columns_ == 0) {
+    return false;
+  }
+  const auto& req = template_op_->request();
+  if (req.is_aggregate()) {
+    if (!FLAGS_ysql_enable_parallel_aggregate_scan) {
+      return false;
+    }
+  } else if (FLAGS_ysql_max_parallel_scan_partitions <= 1 || !exec_params_.limit_use_default) {
+    // Rows of a statement with LIMIT are usually returned by the first partitions, so reading
+    // other partitions in advance would be wasted.
+    return false;
+  }
+  if (!req.is_forward_scan() || req.has_index_request() ||
+      req.has_ybctid_column_value() || req.batch_arguments_size() > 0 ||
+      req.has_paging_state() || req.has_hash_code() || req.has_max_hash_code()) {
+    return false;
+  }
+  const auto* table = template_op_->table();
+  return table->partition_schema().IsHashPartitioning() && table->GetPartitionCount() > 1;
+}
+
+void PgDocReadOp::InitializeNextPartitionOps(int num_ops) {
+  // Each operation scans a single partition. Rows of a full scan of a hash partitioned table are
+  // not ordered, so results of different partitions are returned in the order of operations.
+  // For aggregates each partition returns its partial aggregate, and postgres combines them.
+  const auto& partitions = template_op_->table()->GetPartitions();
+  const int partition_count = partitions.size();
+  if (FLAGS_ysql_max_parallel_scan_partitions > 0) {
+    num_ops = std::min<int>(
+        num_ops, FLAGS_ysql_max_parallel_scan_partitions - static_cast<int>(read_ops_.size()));
+  }
+  while (num_ops > 0 && next_op_idx_ < partition_count) {
+    auto read_op(template_op_->DeepCopy());
+    auto* req = read_op->mutable_request();
+    const auto& start_key = partitions[next_op_idx_];
+    if (!start_key.empty()) {
+      req->set_hash_code(PartitionSchema::DecodeMultiColumnHashValue(start_key));
+    }
+    if (next_op_idx_ + 1 < partition_count) {
+      req->set_max_hash_code(
+          PartitionSchema::DecodeMultiColumnHashValue(partitions[next_op_idx_ + 1]) - 1);
+    }
+    read_ops_.push_back(std::move(read_op));
+    --num_ops;
+    ++next_op_idx_;
+  }
+
+  if (next_op_idx_ == partition_count) {
+    can_produce_more_ops_ = false;
+  }
+  DCHECK(!read_ops_.empty()) << "read_ops_ should not be empty after setting!";
+}
+
 Status PgDocReadOp::SendRequestImpl(bool force_non_bufferable) {
   DCHECK(!read_ops_.empty() || can_produce_more_ops_);
   if (can_produce_more_ops_) {
@@ -391,10 +485,12 @@ Status PgDocReadOp::ProcessResponseImpl(const Status& exec_status) {
     RETURN_NOT_OK(pg_session_->HandleResponse(*read_op, PgObjectId()));
   }
 
+  int64_t rows_fetched = 0;
   if (batch_row_orders_.size() == 0) {
     for (auto& read_op : read_ops_) {
       DCHECK(!read_op->rows_data().empty()) << "Read operation should not return empty data";
       result_cache_.push_back(make_shared<PgDocResult>(read_op->rows_data()));
+      rows_fetched += result_cache_.back()->row_count();
     }
   } else {
     for (int partition = 0; partition < batch_ops_.size(); partition++) {
@@ -457,6 +553,13 @@ Status PgDocReadOp::ProcessResponseImpl(const Status& exec_status) {
     return true;
   }), read_ops_.end());
 
+  // Rows fetched so far satisfy the statement LIMIT, so following pages and partitions are not
+  // read, instead of being prefetched and discarded by postgres.
+  if (batch_row_orders_.empty() && ApplyStatementRowLimit(rows_fetched)) {
+    read_ops_.clear();
+    can_produce_more_ops_ = false;
+  }
+
   end_of_data_ = read_ops_.empty() && !can_produce_more_ops_;
   return Status::OK();
 }
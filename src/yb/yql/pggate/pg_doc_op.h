@@ -185,6 +185,15 @@ class PgDocReadOp : public PgDocOp {
   // Analyze options and pick the appropriate prefetch limit.
   void SetRequestPrefetchLimit();
 
+  // Returns LIMIT(count + offset) of the statement if every row returned by DocDB is counted
+  // against it, or 0 otherwise.
+  int64_t StatementRowLimit() const;
+
+  // Accounts rows fetched for the statement LIMIT. Returns true if the limit is reached, so no
+  // more requests are required. Otherwise limits the next requests of read_ops_ to the number of
+  // rows still required.
+  bool ApplyStatementRowLimit(int64_t rows_fetched);
+
   // Set the row_mark_type field of our read request based on our exec control parameter.
   void SetRowMark();
 
@@ -204,6 +213,15 @@ class PgDocReadOp : public PgDocOp {
   // Also updates the value of can_produce_more_ops_.
   void InitializeNextOps(int num_ops);
 
+  // Whether the request is a full scan, that could be sent to partitions of the table in
+  // parallel, see ysql_enable_parallel_aggregate_scan and ysql_max_parallel_scan_partitions.
+  bool IsParallelScan() const;
+
+  // Initialize up to N new operations from template_op_, each limited to a single partition of the
+  // table by hash_code and max_hash_code. Uses next_op_idx_ as the index of the next partition.
+  // No more than ysql_max_parallel_scan_partitions operations are kept in read_ops_ if it is set.
+  void InitializeNextPartitionOps(int num_ops);
+
   // Used internally for InitializeNextOps to keep track of which permutation should be used
   // to construct the next read_op.
   // Is valid as long as can_produce_more_ops_ is true.
@@ -257,6 +275,10 @@ class PgDocReadOp : public PgDocOp {
 
   // The order number of each argument when the operator sends request in batch fashion.
   int64_t batch_row_ordering_counter_ = 0;
+
+  // Number of rows fetched since initialization, used to stop reading when the statement LIMIT
+  // is reached.
+  int64_t rows_fetched_ = 0;
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -33,6 +33,8 @@ using std::placeholders::_2;
 // Mapping Postgres operator names to YugaByte opcodes.
 // When constructing expresions, Postgres layer will pass the operator name.
 const std::unordered_map<string, PgExpr::Opcode> kOperatorNames = {
+  { "and", PgExpr::Opcode::PG_EXPR_AND },
+  { "or", PgExpr::Opcode::PG_EXPR_OR },
   { "!", PgExpr::Opcode::PG_EXPR_NOT },
   { "not", PgExpr::Opcode::PG_EXPR_NOT },
   { "=", PgExpr::Opcode::PG_EXPR_EQ },
@@ -114,6 +116,41 @@ bfpg::TSOpcode PgExpr::PGOpcodeToTSOpcode(const PgExpr::Opcode opcode) {
   }
 }
 
+QLOperator PgExpr::PGOpcodeToQLOperator(const PgExpr::Opcode opcode) {
+  switch (opcode) {
+    case Opcode::PG_EXPR_AND:
+      return QL_OP_AND;
+
+    case Opcode::PG_EXPR_OR:
+      return QL_OP_OR;
+
+    case Opcode::PG_EXPR_NOT:
+      return QL_OP_NOT;
+
+    case Opcode::PG_EXPR_EQ:
+      return QL_OP_EQUAL;
+
+    case Opcode::PG_EXPR_NE:
+      return QL_OP_NOT_EQUAL;
+
+    case Opcode::PG_EXPR_GE:
+      return QL_OP_GREATER_THAN_EQUAL;
+
+    case Opcode::PG_EXPR_GT:
+      return QL_OP_GREATER_THAN;
+
+    case Opcode::PG_EXPR_LE:
+      return QL_OP_LESS_THAN_EQUAL;
+
+    case Opcode::PG_EXPR_LT:
+      return QL_OP_LESS_THAN;
+
+    default:
+      LOG(DFATAL) << "No supported QL operator for PG opcode: " << static_cast<int32_t>(opcode);
+      return QL_OP_NOOP;
+  }
+}
+
 bfpg::TSOpcode PgExpr::OperandTypeToSumTSOpcode(InternalType type) {
   switch (type) {
     case InternalType::kInt8Value:
@@ -308,27 +345,27 @@ InternalType PgExpr::internal_type() const {
 void PgExpr::InitializeTranslateData() {
   switch (type_entity_->yb_type) {
     case YB_YQL_DATA_TYPE_INT8:
-      translate_data_ = TranslateNumber<int8_t>;
+      translate_data_ = GetTranslateNumber<int8_t>();
       break;
 
     case YB_YQL_DATA_TYPE_INT16:
-      translate_data_ = TranslateNumber<int16_t>;
+      translate_data_ = GetTranslateNumber<int16_t>();
       break;
 
     case YB_YQL_DATA_TYPE_INT32:
-      translate_data_ = TranslateNumber<int32_t>;
+      translate_data_ = GetTranslateNumber<int32_t>();
       break;
 
     case YB_YQL_DATA_TYPE_INT64:
-      translate_data_ = TranslateNumber<int64_t>;
+      translate_data_ = GetTranslateNumber<int64_t>();
       break;
 
     case YB_YQL_DATA_TYPE_UINT32:
-      translate_data_ = TranslateNumber<uint32_t>;
+      translate_data_ = GetTranslateNumber<uint32_t>();
       break;
 
     case YB_YQL_DATA_TYPE_UINT64:
-      translate_data_ = TranslateNumber<uint64_t>;
+      translate_data_ = GetTranslateNumber<uint64_t>();
       break;
 
     case YB_YQL_DATA_TYPE_STRING:
@@ -336,7 +373,7 @@ void PgExpr::InitializeTranslateData() {
       break;
 
     case YB_YQL_DATA_TYPE_BOOL:
-      translate_data_ = TranslateNumber<bool>;
+      translate_data_ = GetTranslateNumber<bool>();
       break;
 
     case YB_YQL_DATA_TYPE_FLOAT:
@@ -352,7 +389,7 @@ void PgExpr::InitializeTranslateData() {
       break;
 
     case YB_YQL_DATA_TYPE_TIMESTAMP:
-      translate_data_ = TranslateNumber<int64_t>;
+      translate_data_ = GetTranslateNumber<int64_t>();
       break;
 
     case YB_YQL_DATA_TYPE_DECIMAL:
@@ -666,6 +703,10 @@ void PgOperator::AppendArg(PgExpr *arg) {
 }
 
 Status PgOperator::PrepareForRead(PgDml *pg_stmt, PgsqlExpressionPB *expr_pb) {
+  if (is_condition()) {
+    return PrepareConditionForRead(pg_stmt, expr_pb);
+  }
+
   PgsqlBCallPB *tscall = expr_pb->mutable_tscall();
   bfpg::TSOpcode tsopcode;
   if (opcode_ == Opcode::PG_EXPR_SUM) {
@@ -684,5 +725,44 @@ Status PgOperator::PrepareForRead(PgDml *pg_stmt, PgsqlExpressionPB *expr_pb) {
   return Status::OK();
 }
 
+Status PgOperator::PrepareConditionForRead(PgDml *pg_stmt, PgsqlExpressionPB *expr_pb) {
+  const bool is_logical = opcode_ == Opcode::PG_EXPR_AND || opcode_ == Opcode::PG_EXPR_OR ||
+                          opcode_ == Opcode::PG_EXPR_NOT;
+  const bool valid_num_args = opcode_ == Opcode::PG_EXPR_NOT
+      ? args_.size() == 1
+      : (is_logical ? !args_.empty() : args_.size() == 2);
+  if (!valid_num_args) {
+    return STATUS_FORMAT(InvalidArgument, "Wrong number of arguments for operator $0: $1",
+                         opname_, args_.size());
+  }
+
+  PgsqlConditionPB *condition = expr_pb->mutable_condition();
+  if (!is_logical) {
+    // Unlike DocDB, SQL comparison with NULL is never true. So the comparison is guarded by
+    // IS NOT NULL checks of its operands.
+    condition->set_op(QL_OP_AND);
+    for (const auto& arg : args_) {
+      PgsqlConditionPB *not_null = condition->add_operands()->mutable_condition();
+      not_null->set_op(QL_OP_IS_NOT_NULL);
+      PgsqlExpressionPB *op = not_null->add_operands();
+      RETURN_NOT_OK(arg->PrepareForRead(pg_stmt, op));
+      RETURN_NOT_OK(arg->Eval(pg_stmt, op));
+    }
+    condition = condition->add_operands()->mutable_condition();
+  }
+
+  condition->set_op(PGOpcodeToQLOperator(opcode_));
+  for (const auto& arg : args_) {
+    if (is_logical && !arg->is_condition()) {
+      return STATUS_FORMAT(InvalidArgument, "Argument of operator $0 must be a condition",
+                           opname_);
+    }
+    PgsqlExpressionPB *op = condition->add_operands();
+    RETURN_NOT_OK(arg->PrepareForRead(pg_stmt, op));
+    RETURN_NOT_OK(arg->Eval(pg_stmt, op));
+  }
+  return Status::OK();
+}
+
 }  // namespace pggate
 }  // namespace yb
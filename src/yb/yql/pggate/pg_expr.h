@@ -31,7 +31,9 @@ class PgExpr {
     PG_EXPR_COLREF,
     PG_EXPR_VARIABLE,
 
-    // The logical expression for defining the conditions when we support WHERE clause.
+    // The logical expression for defining the conditions of WHERE clause.
+    PG_EXPR_AND,
+    PG_EXPR_OR,
     PG_EXPR_NOT,
     PG_EXPR_EQ,
     PG_EXPR_NE,
@@ -90,6 +92,9 @@ class PgExpr {
             opcode_ == Opcode::PG_EXPR_MAX ||
             opcode_ == Opcode::PG_EXPR_MIN);
   }
+  bool is_condition() const {
+    return opcode_ >= Opcode::PG_EXPR_AND && opcode_ <= Opcode::PG_EXPR_LT;
+  }
   virtual bool is_ybbasetid() const {
     return false;
   }
@@ -98,6 +103,11 @@ class PgExpr {
   // Write the result to output buffer (pg_cursor) in Postgres format.
   CHECKED_STATUS ResultToPg(Slice *yb_cursor, Slice *pg_cursor);
 
+  // Plain function pointer rather than std::function, since it is called for every column of
+  // every fetched row.
+  typedef void (*TranslateDataFunction)(Slice *, const PgWireDataHeader&, int,
+                                        const YBCPgTypeEntity *, const PgTypeAttrs *, PgTuple *);
+
   // Function translate_data_() reads the received data from DocDB and writes it to Postgres buffer
   // using to_datum().
   // - DocDB supports a number of datatypes, and we would need to provide one translate function for
@@ -129,6 +139,21 @@ class PgExpr {
     pg_tuple->WriteDatum(index, type_entity->yb_to_datum(&result, read_size, type_attrs));
   }
 
+  // Translates DocDB-numeric datatypes, whose Postgres datum is the value itself, without calling
+  // the type converter.
+  template<typename data_type>
+  static void TranslateNumberAsDatum(Slice *yb_cursor, const PgWireDataHeader& header, int index,
+                                     const YBCPgTypeEntity *type_entity,
+                                     const PgTypeAttrs *type_attrs, PgTuple *pg_tuple) {
+    if (header.is_null()) {
+      return pg_tuple->WriteNull(index, header);
+    }
+    data_type result = 0;
+    size_t read_size = PgDocData::ReadNumber(yb_cursor, &result);
+    yb_cursor->remove_prefix(read_size);
+    pg_tuple->WriteDatum(index, static_cast<uint64_t>(result));
+  }
+
   // Translates DocDB-char-based datatypes.
   static void TranslateText(Slice *yb_cursor, const PgWireDataHeader& header, int index,
                             const YBCPgTypeEntity *type_entity, const PgTypeAttrs *type_attrs,
@@ -193,17 +218,23 @@ class PgExpr {
   static CHECKED_STATUS CheckOperatorName(const char *name);
   static Opcode NameToOpcode(const char *name);
   static bfpg::TSOpcode PGOpcodeToTSOpcode(const PgExpr::Opcode opcode);
+  static QLOperator PGOpcodeToQLOperator(const PgExpr::Opcode opcode);
   static bfpg::TSOpcode OperandTypeToSumTSOpcode(InternalType type);
 
  protected:
   void InitializeTranslateData();
 
+  template<typename data_type>
+  TranslateDataFunction GetTranslateNumber() const {
+    return type_entity_->yb_to_datum_is_cast ? TranslateNumberAsDatum<data_type>
+                                             : TranslateNumber<data_type>;
+  }
+
   // Data members.
   Opcode opcode_;
   const PgTypeEntity *type_entity_;
   const PgTypeAttrs type_attrs_;
-  std::function<void(Slice *, const PgWireDataHeader&, int, const YBCPgTypeEntity *,
-                     const PgTypeAttrs *, PgTuple *)> translate_data_;
+  TranslateDataFunction translate_data_ = nullptr;
 };
 
 class PgConstant : public PgExpr {
@@ -295,6 +326,9 @@ class PgOperator : public PgExpr {
   virtual CHECKED_STATUS PrepareForRead(PgDml *pg_stmt, PgsqlExpressionPB *expr_pb);
 
  private:
+  // Setup a condition of WHERE clause, that is evaluated by DocDB for every scanned row.
+  CHECKED_STATUS PrepareConditionForRead(PgDml *pg_stmt, PgsqlExpressionPB *expr_pb);
+
   const string opname_;
   std::vector<PgExpr*> args_;
 };
@@ -39,6 +39,12 @@ class PgInsert : public PgDmlWrite {
 
   StmtOp stmt_op() const override { return StmtOp::STMT_INSERT; }
 
+  // Overwrite the row with the same key instead of reporting a duplicate key, so the existing row
+  // does not have to be read before the write.
+  void SetUpsertMode() {
+    write_req_->set_stmt_type(PgsqlWriteRequestPB::PGSQL_UPSERT);
+  }
+
  private:
   std::unique_ptr<client::YBPgsqlWriteOp> AllocWriteOperation() const override {
     return target_desc_->NewPgsqlInsert();
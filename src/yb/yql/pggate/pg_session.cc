@@ -13,6 +13,7 @@
 //
 //--------------------------------------------------------------------------------------------------
 
+#include <algorithm>
 #include <memory>
 
 #include "yb/yql/pggate/pg_expr.h"
@@ -198,7 +199,8 @@ PgSession::RunHelper::RunHelper(PgSession* pg_session, bool transactional)
        buffered_ops_(transactional_ ? pg_session_.buffered_txn_ops_
                                     : pg_session_.buffered_ops_) {
   if (!transactional_) {
-    pg_session_.InvalidateForeignKeyReferenceCache();
+    // Intents are kept, since they are only hints of rows to check.
+    pg_session_.fk_reference_cache_.clear();
   }
 }
 
@@ -403,6 +405,15 @@ Status PgSession::GetCatalogMasterVersion(uint64_t *version) {
   return client_->GetYsqlCatalogMasterVersion(version);
 }
 
+Status PgSession::GetCatalogInvalidations(uint64_t since_version, uint64_t *version,
+                                          boost::optional<std::string>* messages) {
+  return client_->GetYsqlCatalogInvalidations(since_version, version, messages);
+}
+
+Status PgSession::IncrementCatalogVersion(const std::string& messages, uint64_t *version) {
+  return client_->IncrementYsqlCatalogVersion(messages, version);
+}
+
 Status PgSession::CreateSequencesDataTable() {
   const YBTableName table_name(YQL_DATABASE_PGSQL,
                                kPgSequencesDataNamespaceId,
@@ -814,6 +825,131 @@ Status PgSession::DeleteForeignKeyReference(uint32_t table_id, std::string&& ybc
   return Status::OK();
 }
 
+Status PgSession::AddForeignKeyReferenceIntent(uint32_t table_id, std::string&& ybctid) {
+  if (FLAGS_ysql_fk_check_batch_size <= 0) {
+    return Status::OK();
+  }
+  PgForeignKeyReference reference = {table_id, std::move(ybctid)};
+  if (fk_reference_cache_.count(reference)) {
+    return Status::OK();
+  }
+  auto& intents = fk_reference_intents_[table_id];
+  if (intents.size() < static_cast<size_t>(FLAGS_ysql_fk_check_batch_size)) {
+    intents.push_back(reference.ybctid);
+  }
+  return Status::OK();
+}
+
+Status PgSession::ResolveForeignKeyReferenceIntents(const PgObjectId& table_id) {
+  auto it = fk_reference_intents_.find(table_id.object_oid);
+  if (it == fk_reference_intents_.end()) {
+    return Status::OK();
+  }
+  std::vector<std::string> intents = std::move(it->second);
+  fk_reference_intents_.erase(it);
+
+  std::vector<std::string> ybctids;
+  ybctids.reserve(intents.size());
+  std::unordered_set<std::string> requested;
+  for (auto& ybctid : intents) {
+    if (fk_reference_cache_.count({table_id.object_oid, std::string(ybctid)}) ||
+        !requested.insert(ybctid).second) {
+      continue;
+    }
+    ybctids.push_back(std::move(ybctid));
+  }
+  if (ybctids.empty()) {
+    return Status::OK();
+  }
+
+  auto found = VERIFY_RESULT(ReadRowsByYbctid(table_id, ybctids, RowMarkType::ROW_MARK_KEYSHARE));
+  for (const auto& ybctid : found) {
+    fk_reference_cache_.emplace(table_id.object_oid, std::string(ybctid));
+  }
+  return Status::OK();
+}
+
+Status PgSession::AddInsertOnConflictKeyIntent(uint32_t table_id, std::string&& ybctid) {
+  on_conflict_key_intents_[table_id].push_back(std::move(ybctid));
+  return Status::OK();
+}
+
+Status PgSession::ResolveInsertOnConflictKeyIntents(const PgObjectId& table_id) {
+  absent_on_conflict_keys_.clear();
+  auto it = on_conflict_key_intents_.find(table_id.object_oid);
+  if (it == on_conflict_key_intents_.end()) {
+    return Status::OK();
+  }
+  std::vector<std::string> ybctids = std::move(it->second);
+  on_conflict_key_intents_.erase(it);
+  std::sort(ybctids.begin(), ybctids.end());
+  ybctids.erase(std::unique(ybctids.begin(), ybctids.end()), ybctids.end());
+
+  // The conflict check does not lock the row, the insert itself fails on a conflict with a row
+  // inserted concurrently.
+  auto found = VERIFY_RESULT(ReadRowsByYbctid(table_id, ybctids, RowMarkType::ROW_MARK_ABSENT));
+  for (auto& ybctid : ybctids) {
+    if (!found.count(ybctid)) {
+      absent_on_conflict_keys_.emplace(table_id.object_oid, std::move(ybctid));
+    }
+  }
+  return Status::OK();
+}
+
+bool PgSession::TakeAbsentInsertOnConflictKey(uint32_t table_id, std::string&& ybctid) {
+  return absent_on_conflict_keys_.erase({table_id, std::move(ybctid)}) != 0;
+}
+
+Result<std::unordered_set<std::string>> PgSession::ReadRowsByYbctid(
+    const PgObjectId& table_id, const std::vector<std::string>& ybctids,
+    RowMarkType row_mark_type) {
+  std::unordered_set<std::string> result;
+  if (ybctids.empty()) {
+    return result;
+  }
+
+  // The rows could be written by buffered operations of the same transaction.
+  if (!buffered_keys_.empty()) {
+    RETURN_NOT_OK(FlushBufferedOperationsImpl());
+  }
+
+  PgTableDesc::ScopedRefPtr table = VERIFY_RESULT(LoadTable(table_id));
+  std::vector<std::shared_ptr<client::YBPgsqlReadOp>> ops;
+  ops.reserve(ybctids.size());
+  for (const auto& ybctid : ybctids) {
+    std::shared_ptr<client::YBPgsqlReadOp> op(table->NewPgsqlSelect());
+    auto* read_request = op->mutable_request();
+    read_request->mutable_ybctid_column_value()->mutable_value()->set_binary_value(ybctid);
+    read_request->add_targets()->set_column_id(static_cast<int>(PgSystemAttrNum::kYBTupleId));
+    if (row_mark_type != RowMarkType::ROW_MARK_ABSENT) {
+      read_request->set_row_mark_type(row_mark_type);
+    }
+    ops.push_back(std::move(op));
+  }
+
+  const bool transactional = ShouldHandleTransactionally(*ops.front());
+  auto session = VERIFY_RESULT(GetSession(transactional, false /* read_only_op */));
+  if (transactional) {
+    session->SetInTxnLimit(HybridTime(clock_->Now().ToUint64()));
+  }
+  for (const auto& op : ops) {
+    RETURN_NOT_OK(session->Apply(op));
+  }
+  const auto status = session->FlushFuture().get();
+  RETURN_NOT_OK(CombineErrorsToStatus(session->GetPendingErrors(), status));
+
+  for (const auto& op : ops) {
+    RETURN_NOT_OK(HandleResponse(*op, table_id));
+    Slice cursor;
+    int64_t row_count = 0;
+    PgDocData::LoadCache(op->rows_data(), &row_count, &cursor);
+    if (row_count > 0) {
+      result.insert(op->request().ybctid_column_value().value().binary_value());
+    }
+  }
+  return result;
+}
+
 Status PgSession::HandleResponse(const client::YBPgsqlOp& op, const PgObjectId& relation_id) {
   if (op.succeeded()) {
     return Status::OK();
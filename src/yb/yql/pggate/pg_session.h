@@ -136,6 +136,11 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
 
   CHECKED_STATUS GetCatalogMasterVersion(uint64_t *version);
 
+  CHECKED_STATUS GetCatalogInvalidations(uint64_t since_version, uint64_t *version,
+                                         boost::optional<std::string>* messages);
+
+  CHECKED_STATUS IncrementCatalogVersion(const std::string& messages, uint64_t *version);
+
   // API for sequences data operations.
   CHECKED_STATUS CreateSequencesDataTable();
 
@@ -247,6 +252,12 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
 
   void InvalidateForeignKeyReferenceCache() {
     fk_reference_cache_.clear();
+    fk_reference_intents_.clear();
+  }
+
+  void InvalidateInsertOnConflictKeys() {
+    on_conflict_key_intents_.clear();
+    absent_on_conflict_keys_.clear();
   }
 
   // Check if initdb has already been run before. Needed to make initdb idempotent.
@@ -266,12 +277,40 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   // Deletes the row referenced by ybctid from FK reference cache.
   CHECKED_STATUS DeleteForeignKeyReference(uint32_t table_id, std::string&& ybctid);
 
+  // Registers the row referenced by ybctid, that is going to be checked by FK check, so it could
+  // be read in the same batch with other rows of the table.
+  CHECKED_STATUS AddForeignKeyReferenceIntent(uint32_t table_id, std::string&& ybctid);
+
+  // Reads all registered rows of the table, locking them in the key share mode, and adds found
+  // ones to FK reference cache. Rows that were not found are left to the regular FK check, so it
+  // reports the violation.
+  CHECKED_STATUS ResolveForeignKeyReferenceIntents(const PgObjectId& table_id);
+
+  // Registers the primary key of a row that is going to be inserted by INSERT ... ON CONFLICT, so
+  // the conflict check of the row could be made in the same batch with other rows of the table.
+  CHECKED_STATUS AddInsertOnConflictKeyIntent(uint32_t table_id, std::string&& ybctid);
+
+  // Reads all registered rows of the table, and remembers the ones that were not found. Keys
+  // remembered by the previous call are forgotten.
+  CHECKED_STATUS ResolveInsertOnConflictKeyIntents(const PgObjectId& table_id);
+
+  // Returns true if the row was not found by the last resolve of the registered keys, so the row
+  // could be inserted without the conflict check. The key is forgotten, since the row is going
+  // to be inserted, and another row with the same key conflicts with it.
+  bool TakeAbsentInsertOnConflictKey(uint32_t table_id, std::string&& ybctid);
+
   CHECKED_STATUS HandleResponse(const client::YBPgsqlOp& op, const PgObjectId& relation_id);
 
  private:
   CHECKED_STATUS FlushBufferedOperationsImpl();
   CHECKED_STATUS FlushBufferedOperationsImpl(const PgsqlOpBuffer& ops, bool transactional);
 
+  // Reads the rows of the table by ybctids with one RPC per tablet, and returns ybctids of the
+  // found rows. Buffered operations are flushed first, since they could write the rows.
+  Result<std::unordered_set<std::string>> ReadRowsByYbctid(
+      const PgObjectId& table_id, const std::vector<std::string>& ybctids,
+      RowMarkType row_mark_type);
+
   // Helper class to run multiple operations on single session.
   // This class allows to keep implementation of RunAsync template method simple
   // without moving its implementation details into header file.
@@ -342,6 +381,13 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
 
   std::unordered_map<TableId, std::shared_ptr<client::YBTable>> table_cache_;
   std::unordered_set<PgForeignKeyReference, boost::hash<PgForeignKeyReference>> fk_reference_cache_;
+  // ybctids of rows to be checked by FK checks, grouped by referenced table.
+  std::unordered_map<uint32_t, std::vector<std::string>> fk_reference_intents_;
+  // Primary keys of rows to be inserted by INSERT ... ON CONFLICT, grouped by table.
+  std::unordered_map<uint32_t, std::vector<std::string>> on_conflict_key_intents_;
+  // Primary keys of rows that were not found by the last resolve of on_conflict_key_intents_.
+  std::unordered_set<PgForeignKeyReference, boost::hash<PgForeignKeyReference>>
+      absent_on_conflict_keys_;
 
   // Should write operations be buffered?
   bool buffering_enabled_ = false;
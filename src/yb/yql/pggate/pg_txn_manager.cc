@@ -130,7 +130,8 @@ Status PgTxnManager::BeginWriteTransactionIfNecessary(bool read_only_op) {
           << txn_in_progress_ << ", txn_=" << txn_.get();
 
   // Using Postgres isolation_level_, read_only_, and deferrable_, determine the internal isolation
-  // level and defer effect.
+  // level and defer effect. READ COMMITTED transactions use snapshot isolation too, but each of
+  // their statements gets its own read point, see ResetTransactionReadPoint.
   IsolationLevel isolation = (isolation_level_ == PgIsolationLevel::SERIALIZABLE) && !read_only_
       ? IsolationLevel::SERIALIZABLE_ISOLATION : IsolationLevel::SNAPSHOT_ISOLATION;
   bool defer = read_only_ && deferrable_;
@@ -190,6 +191,11 @@ Status PgTxnManager::RestartTransaction() {
   if (!txn_->IsRestartRequired()) {
     return STATUS(IllegalState, "Attempted to restart when transaction does not require restart");
   }
+  if (IsReadCommitted()) {
+    // Only the current statement is restarted, so writes of previous statements are preserved.
+    txn_->read_point().Restart();
+    return Status::OK();
+  }
   txn_ = VERIFY_RESULT(txn_->CreateRestartedTransaction());
   session_->SetTransaction(txn_);
 
@@ -198,6 +204,26 @@ Status PgTxnManager::RestartTransaction() {
   return Status::OK();
 }
 
+Status PgTxnManager::ResetTransactionReadPoint() {
+  if (!txn_in_progress_ || ddl_txn_ || !IsReadCommitted()) {
+    return Status::OK();
+  }
+  VLOG(2) << "ResetTransactionReadPoint: txn_=" << txn_.get();
+  if (txn_) {
+    txn_->read_point().SetCurrentReadTime();
+  } else {
+    session_->SetReadPoint(client::Restart::kFalse);
+  }
+  return Status::OK();
+}
+
+bool PgTxnManager::IsReadCommitted() const {
+  // Postgres executes READ UNCOMMITTED as READ COMMITTED.
+  return FLAGS_ysql_enable_read_committed_isolation &&
+         (isolation_level_ == PgIsolationLevel::READ_COMMITED ||
+          isolation_level_ == PgIsolationLevel::READ_UNCOMMITED);
+}
+
 Status PgTxnManager::CommitTransaction() {
   if (!txn_in_progress_) {
     VLOG(2) << "No transaction in progress, nothing to commit.";
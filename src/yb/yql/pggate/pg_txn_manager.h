@@ -54,6 +54,9 @@ class PgTxnManager : public RefCountedThreadSafe<PgTxnManager> {
 
   CHECKED_STATUS BeginTransaction();
   CHECKED_STATUS RestartTransaction();
+  // Picks a new read point for the next statement of a read committed transaction.
+  // Does nothing for other isolation levels.
+  CHECKED_STATUS ResetTransactionReadPoint();
   CHECKED_STATUS CommitTransaction();
   CHECKED_STATUS AbortTransaction();
   CHECKED_STATUS SetIsolationLevel(int isolation);
@@ -77,6 +80,9 @@ class PgTxnManager : public RefCountedThreadSafe<PgTxnManager> {
   void ResetTxnAndSession();
   void StartNewSession();
 
+  // Whether each statement of the current transaction should use its own read point.
+  bool IsReadCommitted() const;
+
   client::AsyncClientInitialiser* async_client_init_ = nullptr;
   scoped_refptr<ClockBase> clock_;
   const tserver::TServerSharedObject* const tserver_shared_object_;
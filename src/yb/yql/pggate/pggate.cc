@@ -198,6 +198,11 @@ Status PgApiImpl::InvalidateCache() {
   return Status::OK();
 }
 
+Status PgApiImpl::InvalidateTableCache(const PgObjectId& table_id) {
+  pg_session_->InvalidateTableCache(table_id);
+  return Status::OK();
+}
+
 //--------------------------------------------------------------------------------------------------
 
 Status PgApiImpl::CreateSequencesDataTable() {
@@ -342,6 +347,25 @@ Status PgApiImpl::GetCatalogMasterVersion(uint64_t *version) {
   return pg_session_->GetCatalogMasterVersion(version);
 }
 
+Status PgApiImpl::GetCatalogInvalidations(uint64_t since_version, uint64_t *version,
+                                          const char **messages, size_t *messages_size) {
+  RETURN_NOT_OK(pg_session_->GetCatalogInvalidations(
+      since_version, version, &catalog_invalidation_messages_));
+  if (!catalog_invalidation_messages_) {
+    *messages = nullptr;
+    *messages_size = 0;
+    return Status::OK();
+  }
+  *messages = catalog_invalidation_messages_->data();
+  *messages_size = catalog_invalidation_messages_->size();
+  return Status::OK();
+}
+
+Status PgApiImpl::IncrementCatalogVersion(const char *messages, size_t messages_size,
+                                          uint64_t *version) {
+  return pg_session_->IncrementCatalogVersion(std::string(messages, messages_size), version);
+}
+
 //--------------------------------------------------------------------------------------------------
 
 Status PgApiImpl::NewCreateTable(const char *database_name,
@@ -380,6 +404,15 @@ Status PgApiImpl::CreateTableSetNumTablets(PgStatement *handle, int32_t num_tabl
   return down_cast<PgCreateTable*>(handle)->SetNumTablets(num_tablets);
 }
 
+Status PgApiImpl::CreateTableSetPackedRow(PgStatement *handle, bool packed_row) {
+  if (!PgStatement::IsValidStmt(handle, StmtOp::STMT_CREATE_TABLE)) {
+    // Invalid handle.
+    return STATUS(InvalidArgument, "Invalid statement handle");
+  }
+  down_cast<PgCreateTable*>(handle)->SetPackedRow(packed_row);
+  return Status::OK();
+}
+
 Status PgApiImpl::ExecCreateTable(PgStatement *handle) {
   if (!PgStatement::IsValidStmt(handle, StmtOp::STMT_CREATE_TABLE)) {
     // Invalid handle.
@@ -539,6 +572,26 @@ Status PgApiImpl::SetIsSysCatalogVersionChange(PgStatement *handle) {
   return STATUS(InvalidArgument, "Invalid statement handle");
 }
 
+Status PgApiImpl::SetCatalogInvalidationMessages(PgStatement *handle, const char *messages,
+                                                 size_t messages_size) {
+  if (!handle) {
+    return STATUS(InvalidArgument, "Invalid statement handle");
+  }
+
+  switch (handle->stmt_op()) {
+    case StmtOp::STMT_UPDATE:
+    case StmtOp::STMT_DELETE:
+    case StmtOp::STMT_INSERT:
+      down_cast<PgDmlWrite *>(handle)->SetCatalogInvalidationMessages(
+          Slice(messages, messages_size));
+      return Status::OK();
+    default:
+      break;
+  }
+
+  return STATUS(InvalidArgument, "Invalid statement handle");
+}
+
 Status PgApiImpl::SetCatalogCacheVersion(PgStatement *handle, uint64_t catalog_cache_version) {
   if (!handle) {
     return STATUS(InvalidArgument, "Invalid statement handle");
@@ -641,6 +694,10 @@ Status PgApiImpl::DmlBindColumnCondIn(PgStatement *handle, int attr_num, int n_a
   return down_cast<PgDmlRead*>(handle)->BindColumnCondIn(attr_num, n_attr_values, attr_values);
 }
 
+Status PgApiImpl::DmlAppendWhereExpr(PgStatement *handle, PgExpr *where_expr) {
+  return down_cast<PgDmlRead*>(handle)->AppendWhereExpr(where_expr);
+}
+
 Status PgApiImpl::DmlBindTable(PgStatement *handle) {
   return down_cast<PgDml*>(handle)->BindTable();
 }
@@ -710,6 +767,15 @@ Status PgApiImpl::ExecInsert(PgStatement *handle) {
   return down_cast<PgInsert*>(handle)->Exec();
 }
 
+Status PgApiImpl::InsertStmtSetUpsertMode(PgStatement *handle) {
+  if (!PgStatement::IsValidStmt(handle, StmtOp::STMT_INSERT)) {
+    // Invalid handle.
+    return STATUS(InvalidArgument, "Invalid statement handle");
+  }
+  down_cast<PgInsert*>(handle)->SetUpsertMode();
+  return Status::OK();
+}
+
 // Update ------------------------------------------------------------------------------------------
 
 Status PgApiImpl::NewUpdate(const PgObjectId& table_id,
@@ -922,21 +988,29 @@ Result<uint64_t> PgApiImpl::GetSharedCatalogVersion() {
 // Transaction Control -----------------------------------------------------------------------------
 Status PgApiImpl::BeginTransaction() {
   pg_session_->InvalidateForeignKeyReferenceCache();
+  pg_session_->InvalidateInsertOnConflictKeys();
   return pg_txn_manager_->BeginTransaction();
 }
 
 Status PgApiImpl::RestartTransaction() {
   pg_session_->InvalidateForeignKeyReferenceCache();
+  pg_session_->InvalidateInsertOnConflictKeys();
   return pg_txn_manager_->RestartTransaction();
 }
 
+Status PgApiImpl::ResetTransactionReadPoint() {
+  return pg_txn_manager_->ResetTransactionReadPoint();
+}
+
 Status PgApiImpl::CommitTransaction() {
   pg_session_->InvalidateForeignKeyReferenceCache();
+  pg_session_->InvalidateInsertOnConflictKeys();
   return pg_txn_manager_->CommitTransaction();
 }
 
 Status PgApiImpl::AbortTransaction() {
   pg_session_->InvalidateForeignKeyReferenceCache();
+  pg_session_->InvalidateInsertOnConflictKeys();
   return pg_txn_manager_->AbortTransaction();
 }
 
@@ -972,9 +1046,33 @@ Status PgApiImpl::DeleteForeignKeyReference(YBCPgOid table_id, std::string&& ybc
   return pg_session_->DeleteForeignKeyReference(table_id, std::move(ybctid));
 }
 
+Status PgApiImpl::AddForeignKeyReferenceIntent(YBCPgOid table_id, std::string&& ybctid) {
+  return pg_session_->AddForeignKeyReferenceIntent(table_id, std::move(ybctid));
+}
+
+Status PgApiImpl::ResolveForeignKeyReferenceIntents(const PgObjectId& table_id) {
+  return pg_session_->ResolveForeignKeyReferenceIntents(table_id);
+}
+
 void PgApiImpl::ClearForeignKeyReferenceCache() {
   pg_session_->InvalidateForeignKeyReferenceCache();
 }
 
+Status PgApiImpl::AddInsertOnConflictKeyIntent(YBCPgOid table_id, std::string&& ybctid) {
+  return pg_session_->AddInsertOnConflictKeyIntent(table_id, std::move(ybctid));
+}
+
+Status PgApiImpl::ResolveInsertOnConflictKeyIntents(const PgObjectId& table_id) {
+  return pg_session_->ResolveInsertOnConflictKeyIntents(table_id);
+}
+
+bool PgApiImpl::TakeAbsentInsertOnConflictKey(YBCPgOid table_id, std::string&& ybctid) {
+  return pg_session_->TakeAbsentInsertOnConflictKey(table_id, std::move(ybctid));
+}
+
+void PgApiImpl::ClearInsertOnConflictKeys() {
+  pg_session_->InvalidateInsertOnConflictKeys();
+}
+
 } // namespace pggate
 } // namespace yb
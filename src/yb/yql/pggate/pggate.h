@@ -78,6 +78,9 @@ class PgApiImpl {
   // Invalidate the sessions table cache.
   CHECKED_STATUS InvalidateCache();
 
+  // Invalidate the cached descriptor of the table.
+  CHECKED_STATUS InvalidateTableCache(const PgObjectId& table_id);
+
   Result<bool> IsInitDbDone();
 
   Result<uint64_t> GetSharedCatalogVersion();
@@ -159,6 +162,15 @@ class PgApiImpl {
 
   CHECKED_STATUS GetCatalogMasterVersion(uint64_t *version);
 
+  // Fetches the invalidation messages of the catalog changes after since_version. messages is set
+  // to nullptr if the master does not have the messages of all of them, otherwise it points to
+  // the messages, that stay valid until the next call.
+  CHECKED_STATUS GetCatalogInvalidations(uint64_t since_version, uint64_t *version,
+                                         const char **messages, size_t *messages_size);
+
+  CHECKED_STATUS IncrementCatalogVersion(const char *messages, size_t messages_size,
+                                         uint64_t *version);
+
   //------------------------------------------------------------------------------------------------
   // Create, alter and drop table.
   CHECKED_STATUS NewCreateTable(const char *database_name,
@@ -177,6 +189,8 @@ class PgApiImpl {
 
   CHECKED_STATUS CreateTableSetNumTablets(PgStatement *handle, int32_t num_tablets);
 
+  CHECKED_STATUS CreateTableSetPackedRow(PgStatement *handle, bool packed_row);
+
   CHECKED_STATUS ExecCreateTable(PgStatement *handle);
 
   CHECKED_STATUS NewAlterTable(const PgObjectId& table_id,
@@ -220,6 +234,9 @@ class PgApiImpl {
 
   CHECKED_STATUS SetIsSysCatalogVersionChange(PgStatement *handle);
 
+  CHECKED_STATUS SetCatalogInvalidationMessages(PgStatement *handle, const char *messages,
+                                                size_t messages_size);
+
   CHECKED_STATUS SetCatalogCacheVersion(PgStatement *handle, uint64_t catalog_cache_version);
 
   //------------------------------------------------------------------------------------------------
@@ -274,6 +291,8 @@ class PgApiImpl {
   CHECKED_STATUS DmlBindColumnCondIn(YBCPgStatement handle, int attr_num, int n_attr_values,
       YBCPgExpr *attr_value);
 
+  CHECKED_STATUS DmlAppendWhereExpr(YBCPgStatement handle, PgExpr *where_expr);
+
   // Binding Tables: Bind the whole table in a statement.  Do not use with BindColumn.
   CHECKED_STATUS DmlBindTable(YBCPgStatement handle);
 
@@ -300,10 +319,11 @@ class PgApiImpl {
   // DB Operations: SET, WHERE, ORDER_BY, GROUP_BY, etc.
   // + The following operations are run by DocDB.
   //   - API for "set_clause" (not yet implemented).
+  //   - API for "where_expr" conditions that DocDB can evaluate (DmlAppendWhereExpr).
   //
   // + The following operations are run by Postgres layer. An API might be added to move these
   //   operations to DocDB.
-  //   - API for "where_expr"
+  //   - API for the rest of "where_expr"
   //   - API for "order_by_expr"
   //   - API for "group_by_expr"
 
@@ -319,6 +339,8 @@ class PgApiImpl {
 
   CHECKED_STATUS ExecInsert(PgStatement *handle);
 
+  CHECKED_STATUS InsertStmtSetUpsertMode(PgStatement *handle);
+
   //------------------------------------------------------------------------------------------------
   // Update.
   CHECKED_STATUS NewUpdate(const PgObjectId& table_id,
@@ -360,6 +382,7 @@ class PgApiImpl {
 
   CHECKED_STATUS BeginTransaction();
   CHECKED_STATUS RestartTransaction();
+  CHECKED_STATUS ResetTransactionReadPoint();
   CHECKED_STATUS CommitTransaction();
   CHECKED_STATUS AbortTransaction();
   CHECKED_STATUS SetTransactionIsolationLevel(int isolation);
@@ -405,8 +428,16 @@ class PgApiImpl {
   bool ForeignKeyReferenceExists(YBCPgOid table_id, std::string&& ybctid);
   CHECKED_STATUS CacheForeignKeyReference(YBCPgOid table_id, std::string&& ybctid);
   CHECKED_STATUS DeleteForeignKeyReference(YBCPgOid table_id, std::string&& ybctid);
+  CHECKED_STATUS AddForeignKeyReferenceIntent(YBCPgOid table_id, std::string&& ybctid);
+  CHECKED_STATUS ResolveForeignKeyReferenceIntents(const PgObjectId& table_id);
   void ClearForeignKeyReferenceCache();
 
+  // Batched conflict checks of INSERT ... ON CONFLICT.
+  CHECKED_STATUS AddInsertOnConflictKeyIntent(YBCPgOid table_id, std::string&& ybctid);
+  CHECKED_STATUS ResolveInsertOnConflictKeyIntents(const PgObjectId& table_id);
+  bool TakeAbsentInsertOnConflictKey(YBCPgOid table_id, std::string&& ybctid);
+  void ClearInsertOnConflictKeys();
+
   struct MessengerHolder {
     std::unique_ptr<rpc::SecureContext> security_context;
     std::unique_ptr<rpc::Messenger> messenger;
@@ -445,6 +476,9 @@ class PgApiImpl {
   scoped_refptr<PgSession> pg_session_;
 
   YBCPgCallbacks pg_callbacks_;
+
+  // Catalog invalidation messages returned by the last GetCatalogInvalidations.
+  boost::optional<std::string> catalog_invalidation_messages_;
 };
 
 }  // namespace pggate
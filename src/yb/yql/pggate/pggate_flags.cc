@@ -51,6 +51,20 @@ DEFINE_int32(ysql_request_limit, 1024,
 DEFINE_int32(ysql_prefetch_limit, 1024,
              "Maximum number of rows to prefetch");
 
+DEFINE_bool(ysql_enable_parallel_aggregate_scan, false,
+            "Whether aggregates pushed down to DocDB by a full scan of a hash partitioned table "
+            "should be evaluated by all tablets in parallel, instead of visiting tablets one "
+            "after another. All tablet servers of the cluster should stop paging at the max "
+            "hash code of the request before it is enabled.");
+
+DEFINE_int32(ysql_max_parallel_scan_partitions, 0,
+             "Max number of partitions of a hash partitioned table, that are read in parallel by "
+             "a full scan without LIMIT. Pages of different partitions are fetched at once, so "
+             "rows are returned in no particular order. 0 or 1 means partitions are read one "
+             "after another. The same tablet server support as for "
+             "ysql_enable_parallel_aggregate_scan is required. For aggregates this also limits "
+             "the number of partitions evaluated in parallel.");
+
 DEFINE_double(ysql_backward_prefetch_scale_factor, 0.0625 /* 1/16th */,
               "Scale factor to reduce ysql_prefetch_limit for backward scan");
 
@@ -61,6 +75,12 @@ DEFINE_int32(ysql_session_max_batch_size, 512,
 DEFINE_bool(ysql_non_txn_copy, false,
             "Execute COPY inserts non-transactionally.");
 
+DEFINE_bool(ysql_non_txn_copy_bulk_load, false,
+            "When non-transactional COPY loads a table that is empty at the start of the COPY, "
+            "write rows as upserts, so tablet servers do not read the primary key of each row "
+            "before writing it. Duplicate keys within the loaded data are still reported, the "
+            "keys of the first 100000 rows are checked by the YSQL backend.");
+
 DEFINE_int32(ysql_max_read_restart_attempts, 10,
              "How many read restarts can we try transparently before giving up");
 
@@ -69,6 +89,21 @@ DEFINE_int32(ysql_output_buffer_size, 262144,
              "While fetched data resides within this buffer and hasn't been flushed to client yet, "
              "we're free to transparently restart operation in case of restart read error.");
 
+DEFINE_int32(ysql_sequence_cache_minval, 0,
+             "Minimum number of values a backend reserves with a single update of a sequence, "
+             "regardless of the CACHE option of the sequence. Values that were reserved but not "
+             "used by the backend are lost, as with the CACHE option. 0 means no minimum.");
+
+DEFINE_int32(ysql_fk_check_batch_size, 0,
+             "Max number of rows referenced by foreign keys of a statement, that are checked with "
+             "a single batched read of the referenced table, instead of a read per row. "
+             "0 disables batching.");
+
+DEFINE_int32(ysql_insert_on_conflict_batch_size, 0,
+             "Max number of rows of INSERT ... ON CONFLICT, whose primary keys are checked for "
+             "conflicts with a single batched read before the rows are inserted, instead of a "
+             "read per row. 0 disables batching.");
+
 DEFINE_bool(ysql_suppress_unsupported_error, false,
             "Suppress ERROR on use of unsupported SQL statement and use WARNING instead");
 
@@ -93,6 +128,11 @@ DEFINE_bool(ysql_enable_manual_sys_table_txn_ctl, false,
             "Enable manual transaction control for YSQL system tables. Mostly needed for testing. "
             "This flag should go away once full transactional DDL is implemented.");
 
+DEFINE_bool(ysql_enable_read_committed_isolation, false,
+            "Whether each statement of READ COMMITTED transactions should read data committed "
+            "before the statement started. Otherwise READ COMMITTED is executed as repeatable "
+            "read, with a single read point for the whole transaction.");
+
 DEFINE_bool(ysql_serializable_isolation_for_ddl_txn, false,
             "Whether to use serializable isolation for separate DDL-only transactions. "
             "By default, repeatable read isolation is used. "
@@ -25,11 +25,17 @@ DECLARE_int32(pggate_tserver_shm_fd);
 DECLARE_bool(pggate_ignore_tserver_shm);
 DECLARE_int32(ysql_request_limit);
 DECLARE_int32(ysql_prefetch_limit);
+DECLARE_bool(ysql_enable_parallel_aggregate_scan);
+DECLARE_int32(ysql_max_parallel_scan_partitions);
 DECLARE_double(ysql_backward_prefetch_scale_factor);
 DECLARE_int32(ysql_session_max_batch_size);
 DECLARE_bool(ysql_non_txn_copy);
+DECLARE_bool(ysql_non_txn_copy_bulk_load);
 DECLARE_int32(ysql_max_read_restart_attempts);
 DECLARE_int32(ysql_output_buffer_size);
+DECLARE_int32(ysql_sequence_cache_minval);
+DECLARE_int32(ysql_fk_check_batch_size);
+DECLARE_int32(ysql_insert_on_conflict_batch_size);
 
 DECLARE_bool(ysql_suppress_unsupported_error);
 
@@ -40,5 +46,6 @@ DECLARE_bool(ysql_beta_feature_roles);
 DECLARE_bool(ysql_beta_feature_extension);
 DECLARE_bool(ysql_enable_manual_sys_table_txn_ctl);
 DECLARE_bool(ysql_serializable_isolation_for_ddl_txn);
+DECLARE_bool(ysql_enable_read_committed_isolation);
 
 #endif  // YB_YQL_PGGATE_PGGATE_FLAGS_H
@@ -26,16 +26,6 @@ PgTuple::PgTuple(uint64_t *datums, bool *isnulls, PgSysColumns *syscols)
     : datums_(datums), isnulls_(isnulls), syscols_(syscols) {
 }
 
-void PgTuple::WriteNull(int index, const PgWireDataHeader& header) {
-  isnulls_[index] = true;
-  datums_[index] = 0;
-}
-
-void PgTuple::WriteDatum(int index, uint64_t datum) {
-  isnulls_[index] = false;
-  datums_[index] = datum;
-}
-
 void PgTuple::Write(uint8_t **pgbuf, const PgWireDataHeader& header, const uint8_t *value,
                     int64_t bytes) {
   // TODO: return a status instead of crashing.
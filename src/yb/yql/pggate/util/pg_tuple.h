@@ -32,10 +32,16 @@ class PgTuple {
   PgTuple(uint64_t *datums, bool *isnulls, PgSysColumns *syscols);
 
   // Write null value.
-  void WriteNull(int index, const PgWireDataHeader& header);
+  void WriteNull(int index, const PgWireDataHeader& header) {
+    isnulls_[index] = true;
+    datums_[index] = 0;
+  }
 
   // Write datum to tuple slot.
-  void WriteDatum(int index, uint64_t datum);
+  void WriteDatum(int index, uint64_t datum) {
+    isnulls_[index] = false;
+    datums_[index] = datum;
+  }
 
   // Write data in Postgres format.
   void Write(uint8_t **pgbuf, const PgWireDataHeader& header, const uint8_t *value, int64_t bytes);
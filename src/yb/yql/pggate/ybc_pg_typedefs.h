@@ -133,6 +133,10 @@ typedef struct PgTypeEntity {
 
   // Converting YugaByte values to Postgres in-memory-formatted datum.
   YBCPgDatumFromData yb_to_datum;
+
+  // True if yb_to_datum only casts the fixed size numeric value to datum, so the value could be
+  // converted without calling it. Set for integer-like pass-by-value types.
+  bool yb_to_datum_is_cast;
 } YBCPgTypeEntity;
 
 // API to read type information.
@@ -206,14 +210,22 @@ typedef struct PgExecParameters {
   //     for filtering before LIMIT is applied.
   //   o ORDER BY clause is not processed by YugaByte. Similarly all rows must be fetched and sent
   //     to Postgres code layer.
+  // - limit_applies_to_scan: The LIMIT node reads directly from the scan that is started with
+  //   these parameters, and each row returned by DocDB reaches the LIMIT node. So the scan could
+  //   stop once count + offset rows are read. Other operations, like joins, DISTINCT or filters
+  //   in Postgres, could consume any number of rows of the scan.
   uint64_t limit_count;
   uint64_t limit_offset;
   bool limit_use_default;
+  bool limit_applies_to_scan;
   // For now we only support one rowmark.
+  // - wait_policy is the LockWaitPolicy of the rowmark.
 #ifdef __cplusplus
   int rowmark = -1;
+  int wait_policy = 0;
 #else
   int rowmark;
+  int wait_policy;
 #endif
 } YBCPgExecParameters;
 
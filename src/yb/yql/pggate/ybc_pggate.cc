@@ -99,6 +99,12 @@ YBCStatus YBCPgInvalidateCache() {
   return ToYBCStatus(pgapi->InvalidateCache());
 }
 
+YBCStatus YBCPgInvalidateTableCacheByTableId(const YBCPgOid database_oid,
+                                             const YBCPgOid table_oid) {
+  const PgObjectId table_id(database_oid, table_oid);
+  return ToYBCStatus(pgapi->InvalidateTableCache(table_id));
+}
+
 const YBCPgTypeEntity *YBCPgFindTypeEntity(int type_oid) {
   return pgapi->FindTypeEntity(type_oid);
 }
@@ -177,6 +183,20 @@ YBCStatus YBCPgGetCatalogMasterVersion(uint64_t *version) {
   return ToYBCStatus(pgapi->GetCatalogMasterVersion(version));
 }
 
+YBCStatus YBCPgGetCatalogInvalidations(uint64_t since_version,
+                                       uint64_t *version,
+                                       const char **messages,
+                                       size_t *messages_size) {
+  return ToYBCStatus(pgapi->GetCatalogInvalidations(since_version, version, messages,
+                                                    messages_size));
+}
+
+YBCStatus YBCPgIncrementCatalogVersion(const char *messages,
+                                       size_t messages_size,
+                                       uint64_t *version) {
+  return ToYBCStatus(pgapi->IncrementCatalogVersion(messages, messages_size, version));
+}
+
 // Statement Operations ----------------------------------------------------------------------------
 
 YBCStatus YBCPgDeleteStatement(YBCPgStatement handle) {
@@ -263,6 +283,10 @@ YBCStatus YBCPgCreateTableSetNumTablets(YBCPgStatement handle, int32_t num_table
   return ToYBCStatus(pgapi->CreateTableSetNumTablets(handle, num_tablets));
 }
 
+YBCStatus YBCPgCreateTableSetPackedRow(YBCPgStatement handle, bool packed_row) {
+  return ToYBCStatus(pgapi->CreateTableSetPackedRow(handle, packed_row));
+}
+
 YBCStatus YBCPgExecCreateTable(YBCPgStatement handle) {
   return ToYBCStatus(pgapi->ExecCreateTable(handle));
 }
@@ -340,6 +364,12 @@ YBCStatus YBCPgSetIsSysCatalogVersionChange(YBCPgStatement handle) {
   return ToYBCStatus(pgapi->SetIsSysCatalogVersionChange(handle));
 }
 
+YBCStatus YBCPgSetCatalogInvalidationMessages(YBCPgStatement handle,
+                                              const char *messages,
+                                              size_t messages_size) {
+  return ToYBCStatus(pgapi->SetCatalogInvalidationMessages(handle, messages, messages_size));
+}
+
 YBCStatus YBCPgNewTruncateTable(const YBCPgOid database_oid,
                                 const YBCPgOid table_oid,
                                 YBCPgStatement *handle) {
@@ -419,6 +449,10 @@ YBCStatus YBCPgDmlBindColumnCondIn(YBCPgStatement handle, int attr_num, int n_at
   return ToYBCStatus(pgapi->DmlBindColumnCondIn(handle, attr_num, n_attr_values, attr_values));
 }
 
+YBCStatus YBCPgDmlAppendWhereExpr(YBCPgStatement handle, YBCPgExpr where_expr) {
+  return ToYBCStatus(pgapi->DmlAppendWhereExpr(handle, where_expr));
+}
+
 YBCStatus YBCPgDmlBindTable(YBCPgStatement handle) {
   return ToYBCStatus(pgapi->DmlBindTable(handle));
 }
@@ -464,6 +498,10 @@ YBCStatus YBCPgExecInsert(YBCPgStatement handle) {
   return ToYBCStatus(pgapi->ExecInsert(handle));
 }
 
+YBCStatus YBCPgInsertStmtSetUpsertMode(YBCPgStatement handle) {
+  return ToYBCStatus(pgapi->InsertStmtSetUpsertMode(handle));
+}
+
 // UPDATE Operations -------------------------------------------------------------------------------
 YBCStatus YBCPgNewUpdate(const YBCPgOid database_oid,
                          const YBCPgOid table_oid,
@@ -592,6 +630,10 @@ YBCStatus YBCPgRestartTransaction() {
   return ToYBCStatus(pgapi->RestartTransaction());
 }
 
+YBCStatus YBCPgResetTransactionReadPoint() {
+  return ToYBCStatus(pgapi->ResetTransactionReadPoint());
+}
+
 YBCStatus YBCPgCommitTransaction() {
   return ToYBCStatus(pgapi->CommitTransaction());
 }
@@ -638,10 +680,40 @@ YBCStatus YBCPgDeleteFromForeignKeyReferenceCache(YBCPgOid table_id, uint64_t yb
   return ToYBCStatus(pgapi->DeleteForeignKeyReference(table_id, std::string(value, bytes)));
 }
 
+YBCStatus YBCAddForeignKeyReferenceIntent(YBCPgOid table_id, const char* ybctid,
+                                          int64_t ybctid_size) {
+  return ToYBCStatus(pgapi->AddForeignKeyReferenceIntent(
+      table_id, std::string(ybctid, ybctid_size)));
+}
+
+YBCStatus YBCResolveForeignKeyReferenceIntents(YBCPgOid database_oid, YBCPgOid table_id) {
+  return ToYBCStatus(pgapi->ResolveForeignKeyReferenceIntents(
+      PgObjectId(database_oid, table_id)));
+}
+
 void ClearForeignKeyReferenceCache() {
   pgapi->ClearForeignKeyReferenceCache();
 }
 
+YBCStatus YBCAddInsertOnConflictKeyIntent(YBCPgOid table_id, const char* ybctid,
+                                          int64_t ybctid_size) {
+  return ToYBCStatus(pgapi->AddInsertOnConflictKeyIntent(
+      table_id, std::string(ybctid, ybctid_size)));
+}
+
+YBCStatus YBCResolveInsertOnConflictKeyIntents(YBCPgOid database_oid, YBCPgOid table_id) {
+  return ToYBCStatus(pgapi->ResolveInsertOnConflictKeyIntents(
+      PgObjectId(database_oid, table_id)));
+}
+
+bool YBCTakeAbsentInsertOnConflictKey(YBCPgOid table_id, const char* ybctid, int64_t ybctid_size) {
+  return pgapi->TakeAbsentInsertOnConflictKey(table_id, std::string(ybctid, ybctid_size));
+}
+
+void YBCClearInsertOnConflictKeys() {
+  pgapi->ClearInsertOnConflictKeys();
+}
+
 bool YBCIsInitDbModeEnvVarSet() {
   static bool cached_value = false;
   static bool cached = false;
@@ -685,6 +757,18 @@ int32_t YBCGetOutputBufferSize() {
   return FLAGS_ysql_output_buffer_size;
 }
 
+int32_t YBCGetSequenceCacheMinval() {
+  return FLAGS_ysql_sequence_cache_minval;
+}
+
+int32_t YBCGetForeignKeyCheckBatchSize() {
+  return FLAGS_ysql_fk_check_batch_size;
+}
+
+int32_t YBCGetInsertOnConflictBatchSize() {
+  return FLAGS_ysql_insert_on_conflict_batch_size;
+}
+
 bool YBCPgIsYugaByteEnabled() {
   return pgapi;
 }
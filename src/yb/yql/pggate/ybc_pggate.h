@@ -42,6 +42,10 @@ YBCStatus YBCPgInitSession(const YBCPgEnv pg_env, const char *database_name);
 // Invalidate the sessions table cache.
 YBCStatus YBCPgInvalidateCache();
 
+// Invalidate the cached descriptor of the table.
+YBCStatus YBCPgInvalidateTableCacheByTableId(const YBCPgOid database_oid,
+                                             const YBCPgOid table_oid);
+
 // Delete statement given its handle.
 YBCStatus YBCPgDeleteStatement(YBCPgStatement handle);
 
@@ -124,6 +128,19 @@ YBCStatus YBCPgReserveOids(YBCPgOid database_oid,
 
 YBCStatus YBCPgGetCatalogMasterVersion(uint64_t *version);
 
+// Get the catalog version from the master, and the invalidation messages of the catalog changes
+// after since_version. *messages is set to NULL if the master does not have the messages of all of
+// them. The messages stay valid until the next call.
+YBCStatus YBCPgGetCatalogInvalidations(uint64_t since_version,
+                                       uint64_t *version,
+                                       const char **messages,
+                                       size_t *messages_size);
+
+// Increment the catalog version, recording the invalidation messages with the new version.
+YBCStatus YBCPgIncrementCatalogVersion(const char *messages,
+                                       size_t messages_size,
+                                       uint64_t *version);
+
 // TABLE -------------------------------------------------------------------------------------------
 // Create and drop table "database_name.schema_name.table_name()".
 // - When "schema_name" is NULL, the table "database_name.table_name" is created.
@@ -145,6 +162,8 @@ YBCStatus YBCPgCreateTableAddColumn(YBCPgStatement handle, const char *attr_name
 
 YBCStatus YBCPgCreateTableSetNumTablets(YBCPgStatement handle, int32_t num_tablets);
 
+YBCStatus YBCPgCreateTableSetPackedRow(YBCPgStatement handle, bool packed_row);
+
 YBCStatus YBCPgExecCreateTable(YBCPgStatement handle);
 
 YBCStatus YBCPgNewAlterTable(YBCPgOid database_oid,
@@ -192,6 +211,11 @@ YBCStatus YBCPgDmlModifiesRow(YBCPgStatement handle, bool *modifies_row);
 
 YBCStatus YBCPgSetIsSysCatalogVersionChange(YBCPgStatement handle);
 
+// Set the invalidation messages of the catalog caches entries affected by the catalog change.
+YBCStatus YBCPgSetCatalogInvalidationMessages(YBCPgStatement handle,
+                                              const char *messages,
+                                              size_t messages_size);
+
 YBCStatus YBCPgSetCatalogCacheVersion(YBCPgStatement handle, uint64_t catalog_cache_version);
 
 // INDEX -------------------------------------------------------------------------------------------
@@ -262,6 +286,10 @@ YBCStatus YBCPgDmlBindColumnCondBetween(YBCPgStatement handle, int attr_num, YBC
 YBCStatus YBCPgDmlBindColumnCondIn(YBCPgStatement handle, int attr_num, int n_attr_values,
     YBCPgExpr *attr_values);
 
+// Add a condition on any columns, that DocDB evaluates for every scanned row. Rows that do not
+// match the condition are not returned. Multiple conditions are combined with AND.
+YBCStatus YBCPgDmlAppendWhereExpr(YBCPgStatement handle, YBCPgExpr where_expr);
+
 // Binding Tables: Bind the whole table in a statement.  Do not use with BindColumn.
 YBCStatus YBCPgDmlBindTable(YBCPgStatement handle);
 
@@ -284,11 +312,11 @@ YBCStatus YBCPgDmlBuildYBTupleId(YBCPgStatement handle, const YBCPgAttrValueDesc
 
 // DB Operations: WHERE, ORDER_BY, GROUP_BY, etc.
 // + The following operations are run by DocDB.
-//   - Not yet
+//   - API for "where_expr" conditions that DocDB can evaluate (YBCPgDmlAppendWhereExpr).
 //
 // + The following operations are run by Postgres layer. An API might be added to move these
 //   operations to DocDB.
-//   - API for "where_expr"
+//   - API for the rest of "where_expr"
 //   - API for "order_by_expr"
 //   - API for "group_by_expr"
 
@@ -305,6 +333,9 @@ YBCStatus YBCPgNewInsert(YBCPgOid database_oid,
 
 YBCStatus YBCPgExecInsert(YBCPgStatement handle);
 
+// Write the row even if a row with the same key already exists.
+YBCStatus YBCPgInsertStmtSetUpsertMode(YBCPgStatement handle);
+
 // UPDATE ------------------------------------------------------------------------------------------
 YBCStatus YBCPgNewUpdate(YBCPgOid database_oid,
                          YBCPgOid table_oid,
@@ -343,6 +374,7 @@ YBCStatus YBCPgExecSelect(YBCPgStatement handle, const YBCPgExecParameters *exec
 // Transaction control -----------------------------------------------------------------------------
 YBCStatus YBCPgBeginTransaction();
 YBCStatus YBCPgRestartTransaction();
+YBCStatus YBCPgResetTransactionReadPoint();
 YBCStatus YBCPgCommitTransaction();
 YBCStatus YBCPgAbortTransaction();
 YBCStatus YBCPgSetTransactionIsolationLevel(int isolation);
@@ -390,8 +422,33 @@ YBCStatus YBCCacheForeignKeyReference(YBCPgOid table_id, const char* ybctid, int
 // Delete an entry from foreign key reference cache.
 YBCStatus YBCPgDeleteFromForeignKeyReferenceCache(YBCPgOid table_id, uint64_t ybctid);
 
+// Register the row that is going to be checked by a foreign key check, so it could be read
+// together with other registered rows of the same table.
+YBCStatus YBCAddForeignKeyReferenceIntent(YBCPgOid table_id, const char* ybctid,
+                                          int64_t ybctid_size);
+
+// Read all registered rows of the table with batched reads, locking them as FOR KEY SHARE does,
+// and add existing ones to foreign key reference cache.
+YBCStatus YBCResolveForeignKeyReferenceIntents(YBCPgOid database_oid, YBCPgOid table_id);
+
 void ClearForeignKeyReferenceCache();
 
+// Batched conflict checks of INSERT ... ON CONFLICT.
+// Register the primary key of a row that is going to be inserted, so it could be checked for a
+// conflict together with other registered rows of the same table.
+YBCStatus YBCAddInsertOnConflictKeyIntent(YBCPgOid table_id, const char* ybctid,
+                                          int64_t ybctid_size);
+
+// Read all registered rows of the table with batched reads, and remember the keys of the rows
+// that were not found.
+YBCStatus YBCResolveInsertOnConflictKeyIntents(YBCPgOid database_oid, YBCPgOid table_id);
+
+// Check if the row was not found by the last resolve, and forget its key, so the following rows
+// with the same key are checked by reading the table.
+bool YBCTakeAbsentInsertOnConflictKey(YBCPgOid table_id, const char* ybctid, int64_t ybctid_size);
+
+void YBCClearInsertOnConflictKeys();
+
 bool YBCIsInitDbModeEnvVarSet();
 
 // This is called by initdb. Used to customize some behavior.
@@ -403,6 +460,15 @@ int32_t YBCGetMaxReadRestartAttempts();
 // Retrieves value of ysql_output_buffer_size gflag
 int32_t YBCGetOutputBufferSize();
 
+// Retrieves value of ysql_sequence_cache_minval gflag
+int32_t YBCGetSequenceCacheMinval();
+
+// Retrieves value of ysql_fk_check_batch_size gflag
+int32_t YBCGetForeignKeyCheckBatchSize();
+
+// Retrieves value of ysql_insert_on_conflict_batch_size gflag
+int32_t YBCGetInsertOnConflictBatchSize();
+
 bool YBCPgIsYugaByteEnabled();
 
 //--------------------------------------------------------------------------------------------------
@@ -0,0 +1,111 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+
+#include <set>
+
+#include "yb/util/test_util.h"
+
+#include "yb/yql/pgwrapper/libpq_test_base.h"
+#include "yb/yql/pgwrapper/libpq_utils.h"
+#include "yb/yql/pgwrapper/pg_conn_mux.h"
+
+namespace yb {
+namespace pgwrapper {
+
+class QueryCreatesSessionStateTest : public YBTest {
+};
+
+TEST_F(QueryCreatesSessionStateTest, Classify) {
+  for (const auto* query : {
+      "SET search_path TO s", "set statement_timeout = 10", "  /* c */ RESET ALL",
+      "PREPARE p AS SELECT 1", "CREATE TEMP TABLE t (k INT)", "CREATE TEMPORARY TABLE t (k INT)",
+      "LISTEN channel", "DECLARE c CURSOR WITH HOLD FOR SELECT 1", "DISCARD ALL",
+      "SELECT set_config('search_path', 's', false)", "SELECT pg_advisory_lock(1)",
+      "BEGIN; SET SESSION work_mem = '1MB'; COMMIT"}) {
+    ASSERT_TRUE(QueryCreatesSessionState(query)) << query;
+  }
+  for (const auto* query : {
+      "SELECT 1", "BEGIN", "SET LOCAL statement_timeout = 10",
+      "SET TRANSACTION ISOLATION LEVEL SERIALIZABLE", "-- SET x\nSELECT 1",
+      "CREATE TABLE t (k INT)", "INSERT INTO t VALUES (1); COMMIT",
+      "SELECT pg_advisory_xact_lock(1)"}) {
+    ASSERT_FALSE(QueryCreatesSessionState(query)) << query;
+  }
+}
+
+class HbaRuleDependsOnClientAddressTest : public YBTest {
+};
+
+TEST_F(HbaRuleDependsOnClientAddressTest, Classify) {
+  for (const auto* rule : {
+      "host all all 10.0.0.0/8 trust", "hostssl all all 127.0.0.1/32 md5",
+      "host all all 192.168.0.0 255.255.0.0 md5", "host all all samenet trust",
+      "host all all .example.com md5"}) {
+    ASSERT_TRUE(HbaRuleDependsOnClientAddress(rule)) << rule;
+  }
+  for (const auto* rule : {
+      "host all all 0.0.0.0/0 trust", "host all all ::0/0 md5", "host all all all trust",
+      "local all yugabyte trust", "host all all 0.0.0.0 0.0.0.0 md5", "", "# host all all x md5"}) {
+    ASSERT_FALSE(HbaRuleDependsOnClientAddress(rule)) << rule;
+  }
+}
+
+class PgConnMuxTest : public LibPqTestBase {
+ protected:
+  static constexpr int kPoolSize = 3;
+
+  void UpdateMiniClusterOptions(ExternalMiniClusterOptions* options) override {
+    options->extra_tserver_flags.push_back("--ysql_conn_mux=true");
+    options->extra_tserver_flags.push_back(Format("--ysql_conn_mux_pool_size=$0", kPoolSize));
+  }
+};
+
+// Transactions of many client connections should be executed by a few pooled backends.
+TEST_F(PgConnMuxTest, YB_DISABLE_TEST_IN_TSAN(ShareBackends)) {
+  constexpr int kNumConnections = 20;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (key INT PRIMARY KEY, value INT)"));
+
+  std::vector<PGConn> connections;
+  for (int i = 0; i != kNumConnections; ++i) {
+    connections.push_back(ASSERT_RESULT(Connect()));
+  }
+
+  std::set<int> pids;
+  for (int i = 0; i != kNumConnections; ++i) {
+    auto& connection = connections[i];
+    ASSERT_OK(connection.Execute("BEGIN"));
+    ASSERT_OK(connection.ExecuteFormat("INSERT INTO t VALUES ($0, $0)", i));
+    pids.insert(ASSERT_RESULT(connection.FetchValue<int32_t>("SELECT pg_backend_pid()")));
+    ASSERT_OK(connection.Execute("COMMIT"));
+  }
+  ASSERT_LE(pids.size(), kPoolSize);
+
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t")), kNumConnections);
+}
+
+// Settings of a client should be kept, and should not be seen by other clients.
+TEST_F(PgConnMuxTest, YB_DISABLE_TEST_IN_TSAN(SessionState)) {
+  auto conn1 = ASSERT_RESULT(Connect());
+  auto conn2 = ASSERT_RESULT(Connect());
+
+  ASSERT_OK(conn1.Execute("SET statement_timeout = 123456"));
+  for (int i = 0; i != 5; ++i) {
+    ASSERT_EQ(ASSERT_RESULT(conn2.FetchValue<std::string>("SHOW statement_timeout")), "0");
+    ASSERT_EQ(ASSERT_RESULT(conn1.FetchValue<std::string>("SHOW statement_timeout")),
+              "123456ms");
+  }
+}
+
+} // namespace pgwrapper
+} // namespace yb
@@ -0,0 +1,1240 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+
+#include "yb/yql/pgwrapper/pg_conn_mux.h"
+
+#include <ctype.h>
+
+#include <algorithm>
+#include <deque>
+#include <sstream>
+#include <unordered_map>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/optional.hpp>
+
+#include "yb/gutil/endian.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/format.h"
+#include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+#include "yb/util/monotime.h"
+#include "yb/util/net/net_util.h"
+#include "yb/util/net/sockaddr.h"
+#include "yb/util/size_literals.h"
+#include "yb/util/thread.h"
+#include "yb/yql/pgwrapper/pg_wrapper.h"
+
+DEFINE_bool(ysql_conn_mux, false,
+            "Accept YSQL client connections in the tablet server and multiplex them onto a pool of "
+            "PostgreSQL backends per user, database and startup settings. Clients are attached to "
+            "a backend only for the duration of a transaction, unless they create session state. "
+            "Not supported with client to server encryption.");
+TAG_FLAG(ysql_conn_mux, advanced);
+
+DEFINE_int32(ysql_conn_mux_backend_port, 0,
+             "Port the PostgreSQL server listens on for connections of the YSQL connection "
+             "multiplexer, 0 to use the YSQL port plus one.");
+TAG_FLAG(ysql_conn_mux_backend_port, advanced);
+
+DEFINE_int32(ysql_conn_mux_pool_size, 10,
+             "Maximal number of PostgreSQL backends the YSQL connection multiplexer keeps for "
+             "clients with the same user, database and startup settings.");
+TAG_FLAG(ysql_conn_mux_pool_size, advanced);
+TAG_FLAG(ysql_conn_mux_pool_size, runtime);
+
+METRIC_DEFINE_gauge_int64(server, ysql_conn_mux_clients, "YSQL Multiplexer Clients",
+                          yb::MetricUnit::kConnections,
+                          "Number of client connections of the YSQL connection multiplexer.");
+METRIC_DEFINE_gauge_int64(server, ysql_conn_mux_backends, "YSQL Multiplexer Backends",
+                          yb::MetricUnit::kConnections,
+                          "Number of pooled backends of the YSQL connection multiplexer.");
+METRIC_DEFINE_gauge_int64(server, ysql_conn_mux_idle_backends, "YSQL Multiplexer Idle Backends",
+                          yb::MetricUnit::kConnections,
+                          "Number of pooled backends that are not attached to a client.");
+METRIC_DEFINE_gauge_int64(server, ysql_conn_mux_waiting_clients,
+                          "YSQL Multiplexer Waiting Clients", yb::MetricUnit::kConnections,
+                          "Number of clients waiting for a pooled backend to become idle.");
+METRIC_DEFINE_counter(server, ysql_conn_mux_backend_attaches, "YSQL Multiplexer Backend Attaches",
+                      yb::MetricUnit::kOperations,
+                      "Number of times a pooled backend was attached to a client.");
+METRIC_DEFINE_counter(server, ysql_conn_mux_pinned_clients, "YSQL Multiplexer Pinned Clients",
+                      yb::MetricUnit::kConnections,
+                      "Number of clients that were pinned to their backend because they created "
+                      "session state.");
+
+DECLARE_string(ysql_hba_conf);
+
+using namespace std::placeholders;
+using boost::asio::ip::tcp;
+
+namespace yb {
+namespace pgwrapper {
+
+namespace {
+
+// Codes of the startup packet, see pqcomm.h.
+constexpr uint32_t kProtocolVersion3 = 3 << 16;
+constexpr uint32_t kCancelRequestCode = 1234 << 16 | 5678;
+constexpr uint32_t kSslRequestCode = 1234 << 16 | 5679;
+constexpr uint32_t kGssEncRequestCode = 1234 << 16 | 5680;
+constexpr size_t kMaxStartupPacketLength = 10000;
+
+// Size of the type byte and the length of a regular protocol message.
+constexpr size_t kMessageHeaderSize = 5;
+
+constexpr size_t kReadBufferSize = 16_KB;
+
+// Reading from a connection is paused while more than this amount of data read from it is waiting
+// to be written to its peer.
+constexpr size_t kMaxPendingOutput = 1_MB;
+
+void AppendUInt32(uint32_t value, std::string* out) {
+  char buffer[sizeof(value)];
+  BigEndian::Store32(buffer, value);
+  out->append(buffer, sizeof(buffer));
+}
+
+// Builds a FATAL ErrorResponse message.
+std::string FatalErrorMessage(const char* sqlstate, const std::string& message) {
+  std::string fields;
+  for (auto field : {std::make_pair('S', "FATAL"), std::make_pair('V', "FATAL"),
+                     std::make_pair('C', sqlstate), std::make_pair('M', message.c_str())}) {
+    fields += field.first;
+    fields += field.second;
+    fields += '\0';
+  }
+  fields += '\0';
+  std::string result = "E";
+  AppendUInt32(fields.size() + sizeof(uint32_t), &result);
+  return result + fields;
+}
+
+const char* SkipSpacesAndComments(const char* p, const char* end) {
+  while (p != end) {
+    if (isspace(*p)) {
+      ++p;
+    } else if (*p == '-' && p + 1 != end && p[1] == '-') {
+      p = std::find(p, end, '\n');
+    } else if (*p == '/' && p + 1 != end && p[1] == '*') {
+      static const char kCommentEnd[] = "*/";
+      p = std::search(p + 2, end, kCommentEnd, kCommentEnd + 2);
+      p = p == end ? end : p + 2;
+    } else {
+      break;
+    }
+  }
+  return p;
+}
+
+// Reads the next word of the statement in lower case.
+std::string NextWord(const char** p, const char* end) {
+  *p = SkipSpacesAndComments(*p, end);
+  std::string result;
+  while (*p != end && (isalnum(**p) || **p == '_')) {
+    result += tolower(**p);
+    ++*p;
+  }
+  return result;
+}
+
+bool StatementCreatesSessionState(const char* begin, const char* end) {
+  std::string text(begin, end);
+  std::transform(text.begin(), text.end(), text.begin(), ::tolower);
+  if (text.find("set_config") != std::string::npos ||
+      text.find("advisory_lock") != std::string::npos) {
+    return true;
+  }
+
+  const char* p = begin;
+  const auto first = NextWord(&p, end);
+  if (first == "set") {
+    const auto second = NextWord(&p, end);
+    return second != "local" && second != "transaction";
+  }
+  if (first == "create") {
+    return text.find("temp") != std::string::npos;
+  }
+  return first == "reset" || first == "prepare" || first == "listen" || first == "declare" ||
+         first == "discard" || first == "load";
+}
+
+class PgMuxState;
+class PgClient;
+class PgBackend;
+
+typedef std::shared_ptr<PgClient> PgClientPtr;
+typedef std::shared_ptr<PgBackend> PgBackendPtr;
+
+// Connection of the multiplexer, that reads data from the socket and queues data to write to it.
+class MuxConnection : public std::enable_shared_from_this<MuxConnection> {
+ public:
+  MuxConnection(PgMuxState* state, tcp::socket socket)
+      : state_(state), socket_(std::move(socket)) {}
+
+  virtual ~MuxConnection() = default;
+
+  void Send(Slice data) {
+    output_.append(data.cdata(), data.size());
+    StartWrite();
+  }
+
+  size_t pending_output() const {
+    return output_.size() + writing_.size();
+  }
+
+  bool closed() const {
+    return closed_;
+  }
+
+  void Close() {
+    if (closed_) {
+      return;
+    }
+    closed_ = true;
+    boost::system::error_code ec;
+    socket_.close(ec);
+    Closed();
+  }
+
+  // Closes the connection after the queued data was written to it.
+  void CloseWhenFlushed() {
+    if (pending_output() == 0) {
+      Close();
+      return;
+    }
+    close_when_flushed_ = true;
+    Pause();
+  }
+
+  // Continues reading after it was paused.
+  void Resume() {
+    if (!paused_ || closed_ || close_when_flushed_) {
+      return;
+    }
+    paused_ = false;
+    ProcessInput();
+    StartRead();
+  }
+
+ protected:
+  // Processes data read from the socket, that is accumulated in input_.
+  virtual void ProcessInput() = 0;
+
+  // Called when the connection is closed.
+  virtual void Closed() = 0;
+
+  // Connection whose reading is paused while output of this connection is pending.
+  virtual MuxConnection* source() = 0;
+
+  void Started() {
+    started_ = true;
+    StartWrite();
+    StartRead();
+  }
+
+  void Pause() {
+    paused_ = true;
+  }
+
+  bool paused() const {
+    return paused_;
+  }
+
+  // Returns the size of the next complete message in input_ starting at pos, or 0 if input does
+  // not contain a complete message yet.
+  size_t CompleteMessageSize(size_t pos) const {
+    if (input_.size() < pos + kMessageHeaderSize) {
+      return 0;
+    }
+    const size_t size = BigEndian::Load32(input_.data() + pos + 1) + 1;
+    return input_.size() - pos >= size ? size : 0;
+  }
+
+  PgMuxState* const state_;
+  tcp::socket socket_;
+  std::string input_;
+
+ private:
+  void StartRead() {
+    if (reading_ || paused_ || closed_ || !started_) {
+      return;
+    }
+    reading_ = true;
+    read_buffer_.resize(kReadBufferSize);
+    socket_.async_read_some(
+        boost::asio::buffer(read_buffer_),
+        std::bind(&MuxConnection::HandleRead, this, _1, _2, shared_from_this()));
+  }
+
+  void HandleRead(const boost::system::error_code& ec, size_t transferred,
+                  const std::shared_ptr<MuxConnection>& self) {
+    reading_ = false;
+    if (closed_) {
+      return;
+    }
+    if (ec) {
+      VLOG(1) << "Read failed: " << ec.message();
+      Close();
+      return;
+    }
+    input_.append(read_buffer_.data(), transferred);
+    if (!paused_) {
+      ProcessInput();
+    }
+    StartRead();
+  }
+
+  void StartWrite() {
+    if (!writing_.empty() || output_.empty() || closed_ || !started_) {
+      return;
+    }
+    writing_.swap(output_);
+    boost::asio::async_write(
+        socket_, boost::asio::buffer(writing_),
+        std::bind(&MuxConnection::HandleWrite, this, _1, shared_from_this()));
+  }
+
+  void HandleWrite(const boost::system::error_code& ec,
+                   const std::shared_ptr<MuxConnection>& self) {
+    writing_.clear();
+    if (closed_) {
+      return;
+    }
+    if (ec) {
+      VLOG(1) << "Write failed: " << ec.message();
+      Close();
+      return;
+    }
+    StartWrite();
+    if (close_when_flushed_ && pending_output() == 0) {
+      Close();
+      return;
+    }
+    auto* source_connection = source();
+    if (source_connection && pending_output() <= kMaxPendingOutput) {
+      source_connection->Resume();
+    }
+  }
+
+  std::vector<char> read_buffer_;
+  std::string output_;
+  std::string writing_;
+  bool started_ = false;
+  bool reading_ = false;
+  bool paused_ = false;
+  bool closed_ = false;
+  bool close_when_flushed_ = false;
+};
+
+YB_DEFINE_ENUM(PgBackendState, (kConnecting)(kAuthenticating)(kIdle)(kAttached));
+
+// Connection to a PostgreSQL backend.
+class PgBackend : public MuxConnection {
+ public:
+  PgBackend(PgMuxState* state, tcp::socket socket, std::string pool_key)
+      : MuxConnection(state, std::move(socket)), pool_key_(std::move(pool_key)) {}
+
+  std::shared_ptr<PgBackend> shared_self() {
+    return std::static_pointer_cast<PgBackend>(shared_from_this());
+  }
+
+  // Connects to the backend and authenticates the client using the client's startup packet.
+  void StartAuthentication(const Endpoint& endpoint, const PgClientPtr& client,
+                           const std::string& startup_packet);
+
+  void Attach(const PgClientPtr& client) {
+    DCHECK_EQ(state_of_backend_, PgBackendState::kIdle);
+    state_of_backend_ = PgBackendState::kAttached;
+    client_ = client;
+  }
+
+  void Detach() {
+    state_of_backend_ = PgBackendState::kIdle;
+    client_.reset();
+  }
+
+  const std::string& pool_key() const {
+    return pool_key_;
+  }
+
+  bool pooled() const {
+    return pooled_;
+  }
+
+  void set_pooled(bool value) {
+    pooled_ = value;
+  }
+
+  // Transaction status of the last ReadyForQuery message.
+  char transaction_status() const {
+    return transaction_status_;
+  }
+
+  std::pair<uint32_t, uint32_t> cancel_key() const {
+    return cancel_key_;
+  }
+
+  // Terminates the backend session gracefully.
+  void Terminate() {
+    static const char kTerminate[] = {'X', 0, 0, 0, 4};
+    Send(Slice(kTerminate, sizeof(kTerminate)));
+    terminating_ = true;
+    CloseWhenFlushed();
+  }
+
+ protected:
+  void ProcessInput() override;
+  void Closed() override;
+  MuxConnection* source() override;
+
+ private:
+  void HandleConnect(const boost::system::error_code& ec, const PgBackendPtr& self);
+
+  const std::string pool_key_;
+  PgBackendState state_of_backend_ = PgBackendState::kConnecting;
+  PgClientPtr client_;
+  std::pair<uint32_t, uint32_t> cancel_key_{0, 0};
+  char transaction_status_ = 'I';
+  bool pooled_ = false;
+  bool terminating_ = false;
+};
+
+YB_DEFINE_ENUM(PgClientState, (kStartup)(kAuthenticating)(kReady));
+
+// Client connection of the multiplexer.
+class PgClient : public MuxConnection {
+ public:
+  PgClient(PgMuxState* state, tcp::socket socket);
+
+  std::shared_ptr<PgClient> shared_self() {
+    return std::static_pointer_cast<PgClient>(shared_from_this());
+  }
+
+  void Start() {
+    Started();
+  }
+
+  // Called by the authenticating backend, after it sent ReadyForQuery.
+  void AuthenticationDone(const PgBackendPtr& backend);
+
+  // Called by the attached backend, after it sent ReadyForQuery.
+  void BackendReady();
+
+  // Attaches a pooled backend to the client, that waited for it.
+  void BackendAttached(const PgBackendPtr& backend);
+
+  void BackendClosed();
+
+  // Fails the client, that could not get a backend.
+  void Fail(const char* sqlstate, const std::string& message) {
+    Send(FatalErrorMessage(sqlstate, message));
+    failed_ = true;
+    CloseWhenFlushed();
+  }
+
+  const PgBackendPtr& backend() const {
+    return backend_;
+  }
+
+  const std::string& pool_key() const {
+    return pool_key_;
+  }
+
+  bool waiting() const {
+    return waiting_;
+  }
+
+  void set_waiting(bool value) {
+    waiting_ = value;
+  }
+
+ protected:
+  void ProcessInput() override;
+  void Closed() override;
+  MuxConnection* source() override;
+
+ private:
+  void ProcessStartupPacket();
+  void ProcessMessages();
+  void ProcessMessage(char type, Slice body);
+  void Pin();
+
+  // Returns the backend to the pool, if the client session does not need it anymore.
+  void MaybeReleaseBackend();
+
+  // Processes messages left in the input after the attached backend has changed.
+  void ContinueInput();
+
+  PgClientState state_of_client_ = PgClientState::kStartup;
+  std::string pool_key_;
+  PgBackendPtr backend_;
+  std::pair<uint32_t, uint32_t> cancel_key_{0, 0};
+  // Number of requests, that are answered by ReadyForQuery, sent to the attached backend.
+  int pending_syncs_ = 0;
+  // Whether extended query protocol messages were sent after the last Sync.
+  bool unsynced_ = false;
+  bool pinned_ = false;
+  bool waiting_ = false;
+  bool failed_ = false;
+};
+
+// Backends of clients with the same startup packet.
+struct PgBackendPool {
+  // Number of backends in the pool, including the attached ones.
+  size_t size = 0;
+  std::vector<PgBackendPtr> idle;
+  std::deque<PgClientPtr> waiting;
+};
+
+// State of the multiplexer, that is accessed only from the thread running the io context.
+class PgMuxState {
+ public:
+  PgMuxState(boost::asio::io_context* io_context, const Endpoint& backend_endpoint,
+             const scoped_refptr<MetricEntity>& metric_entity)
+      : io_context_(*io_context), backend_endpoint_(backend_endpoint),
+        clients_(METRIC_ysql_conn_mux_clients.Instantiate(metric_entity, 0)),
+        backends_(METRIC_ysql_conn_mux_backends.Instantiate(metric_entity, 0)),
+        idle_backends_(METRIC_ysql_conn_mux_idle_backends.Instantiate(metric_entity, 0)),
+        waiting_clients_(METRIC_ysql_conn_mux_waiting_clients.Instantiate(metric_entity, 0)),
+        backend_attaches_(METRIC_ysql_conn_mux_backend_attaches.Instantiate(metric_entity)),
+        pinned_clients_(METRIC_ysql_conn_mux_pinned_clients.Instantiate(metric_entity)) {}
+
+  void Accepted(tcp::socket socket) {
+    auto client = std::make_shared<PgClient>(this, std::move(socket));
+    clients_->Increment();
+    auto it = std::find_if(client_list_.begin(), client_list_.end(),
+                           [](const auto& weak_client) { return weak_client.expired(); });
+    if (it != client_list_.end()) {
+      *it = client;
+    } else {
+      client_list_.push_back(client);
+    }
+    client->Start();
+  }
+
+  void ClientClosed(PgClient* client) {
+    clients_->Decrement();
+    if (client->waiting()) {
+      client->set_waiting(false);
+      waiting_clients_->Decrement();
+      auto it = pools_.find(client->pool_key());
+      if (it != pools_.end()) {
+        auto& waiting = it->second.waiting;
+        waiting.erase(std::remove_if(
+            waiting.begin(), waiting.end(),
+            [client](const PgClientPtr& waiting_client) { return waiting_client.get() == client; }),
+            waiting.end());
+      }
+    }
+  }
+
+  PgBackendPtr StartAuthentication(const PgClientPtr& client, const std::string& pool_key,
+                                   const std::string& startup_packet) {
+    auto backend = std::make_shared<PgBackend>(this, tcp::socket(io_context_), pool_key);
+    backend->StartAuthentication(backend_endpoint_, client, startup_packet);
+    return backend;
+  }
+
+  // Adds the backend, that authenticated a client, to the pool, or terminates it if the pool is
+  // full.
+  void Authenticated(const PgBackendPtr& backend) {
+    auto& pool = pools_[backend->pool_key()];
+    if (pool.size >= std::max(FLAGS_ysql_conn_mux_pool_size, 1)) {
+      backend->Detach();
+      backend->Terminate();
+      return;
+    }
+    ++pool.size;
+    backends_->Increment();
+    backend->set_pooled(true);
+    Release(backend);
+  }
+
+  // Returns an idle backend of the pool, or nullptr if the client has to wait for one.
+  PgBackendPtr Acquire(const PgClientPtr& client, const std::string& pool_key) {
+    auto& pool = pools_[pool_key];
+    if (!pool.idle.empty()) {
+      auto backend = std::move(pool.idle.back());
+      pool.idle.pop_back();
+      idle_backends_->Decrement();
+      backend->Attach(client);
+      backend_attaches_->Increment();
+      return backend;
+    }
+    if (pool.size == 0) {
+      client->Fail("08006", "No YSQL backend available for the connection");
+      return nullptr;
+    }
+    pool.waiting.push_back(client);
+    client->set_waiting(true);
+    waiting_clients_->Increment();
+    return nullptr;
+  }
+
+  // Returns the backend to the pool, or attaches it to a waiting client.
+  void Release(const PgBackendPtr& backend) {
+    backend->Detach();
+    auto& pool = pools_[backend->pool_key()];
+    while (!pool.waiting.empty()) {
+      auto client = std::move(pool.waiting.front());
+      pool.waiting.pop_front();
+      if (!client->waiting()) {
+        continue;
+      }
+      client->set_waiting(false);
+      waiting_clients_->Decrement();
+      backend->Attach(client);
+      backend_attaches_->Increment();
+      client->BackendAttached(backend);
+      return;
+    }
+    pool.idle.push_back(backend);
+    idle_backends_->Increment();
+  }
+
+  void BackendClosed(PgBackend* backend) {
+    if (!backend->pooled()) {
+      return;
+    }
+    backend->set_pooled(false);
+    backends_->Decrement();
+    auto it = pools_.find(backend->pool_key());
+    if (it == pools_.end()) {
+      return;
+    }
+    auto& pool = it->second;
+    --pool.size;
+    auto idle_it = std::find_if(
+        pool.idle.begin(), pool.idle.end(),
+        [backend](const PgBackendPtr& idle_backend) { return idle_backend.get() == backend; });
+    if (idle_it != pool.idle.end()) {
+      pool.idle.erase(idle_it);
+      idle_backends_->Decrement();
+    }
+    if (pool.size != 0) {
+      return;
+    }
+    // Nobody would release a backend to clients waiting for this pool.
+    auto waiting = std::move(pool.waiting);
+    pools_.erase(it);
+    for (const auto& client : waiting) {
+      if (client->waiting()) {
+        client->set_waiting(false);
+        waiting_clients_->Decrement();
+        client->Fail("08006", "No YSQL backend available for the connection");
+      }
+    }
+  }
+
+  void RegisterCancelKey(std::pair<uint32_t, uint32_t> key, const PgClientPtr& client) {
+    cancel_keys_[key] = client;
+  }
+
+  void UnregisterCancelKey(std::pair<uint32_t, uint32_t> key) {
+    cancel_keys_.erase(key);
+  }
+
+  // Forwards a cancel request of a client to the backend attached to it.
+  void Cancel(std::pair<uint32_t, uint32_t> key) {
+    auto it = cancel_keys_.find(key);
+    if (it == cancel_keys_.end()) {
+      return;
+    }
+    auto client = it->second.lock();
+    if (!client || !client->backend()) {
+      return;
+    }
+    auto backend_key = client->backend()->cancel_key();
+    auto packet = std::make_shared<std::string>();
+    AppendUInt32(16, packet.get());
+    AppendUInt32(kCancelRequestCode, packet.get());
+    AppendUInt32(backend_key.first, packet.get());
+    AppendUInt32(backend_key.second, packet.get());
+    auto socket = std::make_shared<tcp::socket>(io_context_);
+    socket->async_connect(backend_endpoint_, [socket, packet](
+        const boost::system::error_code& ec) {
+      if (ec) {
+        LOG(WARNING) << "Failed to connect to send cancel request: " << ec.message();
+        return;
+      }
+      boost::asio::async_write(
+          *socket, boost::asio::buffer(*packet),
+          [socket, packet](const boost::system::error_code& ec, size_t) {
+        LOG_IF(WARNING, ec) << "Failed to send cancel request: " << ec.message();
+      });
+    });
+  }
+
+  void PinnedClient() {
+    pinned_clients_->Increment();
+  }
+
+  void Shutdown() {
+    for (auto& weak_client : client_list_) {
+      auto client = weak_client.lock();
+      if (client) {
+        client->Close();
+      }
+    }
+    client_list_.clear();
+    for (auto& pool : pools_) {
+      auto idle = std::move(pool.second.idle);
+      for (auto& backend : idle) {
+        backend->Close();
+      }
+    }
+  }
+
+ private:
+  struct CancelKeyHash {
+    size_t operator()(std::pair<uint32_t, uint32_t> key) const {
+      return std::hash<uint64_t>()(static_cast<uint64_t>(key.first) << 32 | key.second);
+    }
+  };
+
+  boost::asio::io_context& io_context_;
+  const Endpoint backend_endpoint_;
+  std::unordered_map<std::string, PgBackendPool> pools_;
+  std::unordered_map<std::pair<uint32_t, uint32_t>, std::weak_ptr<PgClient>, CancelKeyHash>
+      cancel_keys_;
+  std::vector<std::weak_ptr<PgClient>> client_list_;
+
+  scoped_refptr<AtomicGauge<int64_t>> clients_;
+  scoped_refptr<AtomicGauge<int64_t>> backends_;
+  scoped_refptr<AtomicGauge<int64_t>> idle_backends_;
+  scoped_refptr<AtomicGauge<int64_t>> waiting_clients_;
+  scoped_refptr<Counter> backend_attaches_;
+  scoped_refptr<Counter> pinned_clients_;
+};
+
+void PgBackend::StartAuthentication(
+    const Endpoint& endpoint, const PgClientPtr& client, const std::string& startup_packet) {
+  state_of_backend_ = PgBackendState::kAuthenticating;
+  client_ = client;
+  Send(startup_packet);
+  socket_.async_connect(
+      endpoint, std::bind(&PgBackend::HandleConnect, this, _1, shared_self()));
+}
+
+void PgBackend::HandleConnect(const boost::system::error_code& ec, const PgBackendPtr& self) {
+  if (closed()) {
+    return;
+  }
+  if (ec) {
+    LOG(WARNING) << "Failed to connect to YSQL backend: " << ec.message();
+    if (client_) {
+      client_->Fail("08006", "Failed to connect to YSQL backend: " + ec.message());
+    }
+    Close();
+    return;
+  }
+  boost::system::error_code nodelay_ec;
+  socket_.set_option(tcp::no_delay(true), nodelay_ec);
+  Started();
+}
+
+void PgBackend::ProcessInput() {
+  size_t pos = 0;
+  while (size_t size = CompleteMessageSize(pos)) {
+    const char type = input_[pos];
+    Slice message(input_.data() + pos, size);
+    pos += size;
+    if (type == 'K' && size >= kMessageHeaderSize + 8) {
+      cancel_key_.first = BigEndian::Load32(message.data() + kMessageHeaderSize);
+      cancel_key_.second = BigEndian::Load32(message.data() + kMessageHeaderSize + 4);
+    } else if (type == 'Z' && size > kMessageHeaderSize) {
+      transaction_status_ = message[kMessageHeaderSize];
+    }
+    if (!client_) {
+      // Notices of an idle backend, like the one about its termination, have no receiver.
+      continue;
+    }
+    // The client could be detached by the handling of ReadyForQuery.
+    auto client = client_;
+    client->Send(message);
+    if (type == 'Z') {
+      if (state_of_backend_ == PgBackendState::kAuthenticating) {
+        client->AuthenticationDone(shared_self());
+      } else {
+        client->BackendReady();
+      }
+    }
+    if (client_ && client_->pending_output() > kMaxPendingOutput) {
+      Pause();
+      break;
+    }
+  }
+  input_.erase(0, pos);
+}
+
+void PgBackend::Closed() {
+  LOG_IF(INFO, !terminating_) << "YSQL backend connection closed, pid: " << cancel_key_.first;
+  state_->BackendClosed(this);
+  auto client = std::move(client_);
+  if (client) {
+    client->BackendClosed();
+  }
+}
+
+MuxConnection* PgBackend::source() {
+  return client_.get();
+}
+
+PgClient::PgClient(PgMuxState* state, tcp::socket socket)
+    : MuxConnection(state, std::move(socket)) {
+  boost::system::error_code ec;
+  socket_.set_option(tcp::no_delay(true), ec);
+}
+
+void PgClient::ProcessInput() {
+  switch (state_of_client_) {
+    case PgClientState::kStartup:
+      ProcessStartupPacket();
+      return;
+    case PgClientState::kAuthenticating:
+      // Authentication messages are passed through, they could be in a protocol that is not
+      // known to the multiplexer.
+      if (backend_ && !input_.empty()) {
+        backend_->Send(input_);
+        input_.clear();
+      }
+      return;
+    case PgClientState::kReady:
+      ProcessMessages();
+      return;
+  }
+  FATAL_INVALID_ENUM_VALUE(PgClientState, state_of_client_);
+}
+
+void PgClient::ProcessStartupPacket() {
+  while (input_.size() >= 2 * sizeof(uint32_t)) {
+    const size_t length = BigEndian::Load32(input_.data());
+    if (length < 2 * sizeof(uint32_t) || length > kMaxStartupPacketLength) {
+      LOG(WARNING) << "Invalid YSQL startup packet length: " << length;
+      Close();
+      return;
+    }
+    if (input_.size() < length) {
+      return;
+    }
+    const uint32_t code = BigEndian::Load32(input_.data() + sizeof(uint32_t));
+    if (code == kSslRequestCode || code == kGssEncRequestCode) {
+      // Encryption is not supported by the multiplexer, the client could continue without it.
+      input_.erase(0, length);
+      Send(Slice("N", 1));
+      continue;
+    }
+    if (code == kCancelRequestCode) {
+      if (length == 16) {
+        state_->Cancel(std::make_pair(BigEndian::Load32(input_.data() + 8),
+                                      BigEndian::Load32(input_.data() + 12)));
+      }
+      Close();
+      return;
+    }
+    if (code >> 16 != kProtocolVersion3 >> 16) {
+      Send(FatalErrorMessage("0A000", Format("Unsupported frontend protocol $0", code)));
+      CloseWhenFlushed();
+      return;
+    }
+    std::string startup_packet = input_.substr(0, length);
+    input_.erase(0, length);
+    // Clients sending the same startup packet get backends with the same user, database and
+    // session settings.
+    pool_key_ = startup_packet.substr(sizeof(uint32_t));
+    state_of_client_ = PgClientState::kAuthenticating;
+    backend_ = state_->StartAuthentication(shared_self(), pool_key_, startup_packet);
+    return;
+  }
+}
+
+void PgClient::ProcessMessages() {
+  size_t pos = 0;
+  while (size_t size = CompleteMessageSize(pos)) {
+    const char type = input_[pos];
+    if (type == 'X') {
+      input_.clear();
+      Close();
+      return;
+    }
+    if (!backend_) {
+      if (waiting_ || failed_) {
+        break;
+      }
+      backend_ = state_->Acquire(shared_self(), pool_key_);
+      if (!backend_) {
+        break;
+      }
+    }
+    Slice message(input_.data() + pos, size);
+    pos += size;
+    ProcessMessage(type, Slice(message.data() + kMessageHeaderSize, size - kMessageHeaderSize));
+    backend_->Send(message);
+    if (backend_->pending_output() > kMaxPendingOutput) {
+      input_.erase(0, pos);
+      Pause();
+      return;
+    }
+  }
+  input_.erase(0, pos);
+  if (!backend_ && input_.size() > kMaxPendingOutput) {
+    // Reading continues while the client waits for a backend, so its disconnect is noticed.
+    Pause();
+  }
+}
+
+void PgClient::ProcessMessage(char type, Slice body) {
+  switch (type) {
+    case 'Q':
+      ++pending_syncs_;
+      if (!pinned_ && QueryCreatesSessionState(body)) {
+        Pin();
+      }
+      return;
+    case 'P': {
+      unsynced_ = true;
+      // Named prepared statements live until the end of the session.
+      if (!pinned_ && (body.empty() || body[0] != 0 ||
+                       QueryCreatesSessionState(Slice(body.data() + 1, body.size() - 1)))) {
+        Pin();
+      }
+      return;
+    }
+    case 'S':
+      ++pending_syncs_;
+      unsynced_ = false;
+      return;
+    case 'F':
+      ++pending_syncs_;
+      if (!pinned_) {
+        Pin();
+      }
+      return;
+    case 'B': FALLTHROUGH_INTENDED;
+    case 'E': FALLTHROUGH_INTENDED;
+    case 'D': FALLTHROUGH_INTENDED;
+    case 'C':
+      unsynced_ = true;
+      return;
+  }
+}
+
+void PgClient::Pin() {
+  pinned_ = true;
+  state_->PinnedClient();
+}
+
+void PgClient::AuthenticationDone(const PgBackendPtr& backend) {
+  state_of_client_ = PgClientState::kReady;
+  cancel_key_ = backend->cancel_key();
+  state_->RegisterCancelKey(cancel_key_, shared_self());
+  backend_.reset();
+  state_->Authenticated(backend);
+  // Messages received with the end of authentication are processed as regular ones.
+  ProcessMessages();
+}
+
+void PgClient::BackendReady() {
+  if (pending_syncs_ > 0) {
+    --pending_syncs_;
+  }
+  MaybeReleaseBackend();
+  if (!backend_) {
+    ContinueInput();
+  }
+}
+
+void PgClient::ContinueInput() {
+  if (paused()) {
+    Resume();
+  } else {
+    ProcessMessages();
+  }
+}
+
+void PgClient::MaybeReleaseBackend() {
+  if (!backend_ || pinned_ || pending_syncs_ != 0 || unsynced_ ||
+      backend_->transaction_status() != 'I') {
+    return;
+  }
+  auto backend = std::move(backend_);
+  state_->Release(backend);
+}
+
+void PgClient::BackendAttached(const PgBackendPtr& backend) {
+  backend_ = backend;
+  ContinueInput();
+}
+
+void PgClient::BackendClosed() {
+  backend_.reset();
+  if (failed_) {
+    return;
+  }
+  if (state_of_client_ != PgClientState::kReady || pinned_ || pending_syncs_ != 0 || unsynced_) {
+    // The client lost its session state, or did not get the response to its request.
+    CloseWhenFlushed();
+  }
+}
+
+void PgClient::Closed() {
+  state_->ClientClosed(this);
+  if (state_of_client_ == PgClientState::kReady) {
+    state_->UnregisterCancelKey(cancel_key_);
+  }
+  auto backend = std::move(backend_);
+  if (!backend) {
+    return;
+  }
+  if (state_of_client_ != PgClientState::kReady || !backend->pooled()) {
+    backend->Close();
+    return;
+  }
+  if (pinned_ || pending_syncs_ != 0 || unsynced_ || backend->transaction_status() != 'I') {
+    // The session state of the backend is not reusable by other clients.
+    backend->Detach();
+    backend->Terminate();
+    return;
+  }
+  state_->Release(backend);
+}
+
+MuxConnection* PgClient::source() {
+  return backend_.get();
+}
+
+} // namespace
+
+bool QueryCreatesSessionState(Slice query) {
+  const char* begin = query.cdata();
+  const char* end = begin + query.size();
+  // Strip the terminating zero of the protocol string.
+  end = std::find(begin, end, '\0');
+  while (begin != end) {
+    auto statement_end = std::find(begin, end, ';');
+    if (StatementCreatesSessionState(begin, statement_end)) {
+      return true;
+    }
+    begin = statement_end == end ? end : statement_end + 1;
+  }
+  return false;
+}
+
+bool HbaRuleDependsOnClientAddress(const std::string& rule) {
+  std::vector<std::string> tokens;
+  std::istringstream input(rule);
+  for (std::string token; input >> token;) {
+    if (token[0] == '#') {
+      break;
+    }
+    tokens.push_back(std::move(token));
+  }
+  // Rules of local connections, i.e. over unix socket, and malformed rules are not affected.
+  if (tokens.size() < 4 || !boost::starts_with(tokens[0], "host")) {
+    return false;
+  }
+  const auto& address = tokens[3];
+  if (address == "all" || address == "0.0.0.0/0" || address == "::0/0" || address == "::/0") {
+    return false;
+  }
+  // Address could be followed by a separate mask column.
+  if (tokens.size() >= 5 &&
+      ((address == "0.0.0.0" && tokens[4] == "0.0.0.0") ||
+       ((address == "::" || address == "::0") && (tokens[4] == "::" || tokens[4] == "::0")))) {
+    return false;
+  }
+  return true;
+}
+
+class PgConnectionMultiplexer::Impl {
+ public:
+  explicit Impl(const scoped_refptr<MetricEntity>& metric_entity)
+      : metric_entity_(metric_entity) {}
+
+  ~Impl() {
+    Shutdown();
+  }
+
+  CHECKED_STATUS Start(PgProcessConf* conf) {
+    // Clients reach PostgreSQL from the backend address of the multiplexer, so rules that match
+    // the client address would be applied to the wrong address.
+    std::vector<std::string> hba_rules;
+    boost::split(hba_rules, FLAGS_ysql_hba_conf, boost::is_any_of(","));
+    for (const auto& rule : hba_rules) {
+      if (HbaRuleDependsOnClientAddress(rule)) {
+        return STATUS_FORMAT(
+            NotSupported,
+            "YSQL connection multiplexer does not support hba rules that depend on the client "
+            "address: $0", rule);
+      }
+    }
+
+    std::vector<Endpoint> endpoints;
+    for (const auto& host_port : VERIFY_RESULT(
+             HostPort::ParseStrings(conf->listen_addresses, conf->pg_port))) {
+      std::vector<Endpoint> host_endpoints;
+      RETURN_NOT_OK(host_port.ResolveAddresses(&host_endpoints));
+      if (host_endpoints.empty()) {
+        return STATUS_FORMAT(NetworkError, "Failed to resolve $0", host_port);
+      }
+      endpoints.push_back(host_endpoints.front());
+    }
+    if (endpoints.empty()) {
+      return STATUS_FORMAT(NetworkError, "Failed to resolve $0", conf->listen_addresses);
+    }
+
+    // PostgreSQL listens on the first address, or on loopback when any of the addresses is
+    // unspecified, since the multiplexer takes the port on all interfaces then.
+    auto backend_address = endpoints.front().address();
+    for (const auto& endpoint : endpoints) {
+      if (endpoint.address().is_unspecified()) {
+        if (endpoint.address().is_v6()) {
+          backend_address = boost::asio::ip::address_v6::loopback();
+        } else {
+          backend_address = boost::asio::ip::address_v4::loopback();
+        }
+        break;
+      }
+    }
+    const uint16_t backend_port = FLAGS_ysql_conn_mux_backend_port > 0
+        ? FLAGS_ysql_conn_mux_backend_port : conf->pg_port + 1;
+    Endpoint backend_endpoint(backend_address, backend_port);
+
+    for (const auto& endpoint : endpoints) {
+      listeners_.push_back(std::make_unique<Listener>(&io_context_));
+      RETURN_NOT_OK(Listen(endpoint, &listeners_.back()->acceptor));
+    }
+
+    LOG(INFO) << "Starting YSQL connection multiplexer: " << conf->listen_addresses << ":"
+              << conf->pg_port << " => " << backend_endpoint;
+    state_.emplace(&io_context_, backend_endpoint, metric_entity_);
+    for (const auto& listener : listeners_) {
+      StartAccept(listener.get());
+    }
+    thread_ = VERIFY_RESULT(Thread::Make(
+        "pg_conn_mux", "pg_conn_mux", std::bind(&Impl::Execute, this)));
+
+    conf->listen_addresses = backend_address.to_string();
+    conf->pg_port = backend_port;
+    return Status::OK();
+  }
+
+  void Shutdown() {
+    if (!thread_) {
+      return;
+    }
+    boost::asio::post(io_context_, [this] {
+      for (const auto& listener : listeners_) {
+        boost::system::error_code ec;
+        listener->acceptor.close(ec);
+      }
+      state_->Shutdown();
+    });
+    work_.reset();
+    auto deadline = CoarseMonoClock::Now() + std::chrono::seconds(15);
+    while (!io_context_.stopped()) {
+      if (CoarseMonoClock::Now() >= deadline) {
+        LOG(ERROR) << "YSQL connection multiplexer failed to stop";
+        io_context_.stop();
+        break;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    thread_->Join();
+    thread_.reset();
+  }
+
+ private:
+  struct Listener {
+    explicit Listener(boost::asio::io_context* io_context)
+        : acceptor(*io_context), socket(*io_context) {}
+
+    tcp::acceptor acceptor;
+    tcp::socket socket;
+  };
+
+  static CHECKED_STATUS Listen(const Endpoint& endpoint, tcp::acceptor* acceptor) {
+    boost::system::error_code ec;
+    acceptor->open(endpoint.protocol(), ec);
+    if (ec) {
+      return STATUS_FORMAT(NetworkError, "Open failed: $0", ec.message());
+    }
+    acceptor->set_option(boost::asio::socket_base::reuse_address(true), ec);
+    if (ec) {
+      return STATUS_FORMAT(NetworkError, "Reuse address failed: $0", ec.message());
+    }
+    acceptor->bind(endpoint, ec);
+    if (ec) {
+      return STATUS_FORMAT(NetworkError, "Bind to $0 failed: $1", endpoint, ec.message());
+    }
+    acceptor->listen(boost::asio::ip::tcp::socket::max_listen_connections, ec);
+    if (ec) {
+      return STATUS_FORMAT(NetworkError, "Listen failed: $0", ec.message());
+    }
+    return Status::OK();
+  }
+
+  void Execute() {
+    boost::system::error_code ec;
+    io_context_.run(ec);
+    LOG_IF(ERROR, ec) << "Failed to run io context: " << ec;
+  }
+
+  void StartAccept(Listener* listener) {
+    listener->acceptor.async_accept(
+        listener->socket, std::bind(&Impl::HandleAccept, this, listener, _1));
+  }
+
+  void HandleAccept(Listener* listener, const boost::system::error_code& ec) {
+    if (ec) {
+      LOG_IF(WARNING, ec != boost::asio::error::operation_aborted)
+          << "Accept failed: " << ec.message();
+      if (ec == boost::asio::error::operation_aborted || !listener->acceptor.is_open()) {
+        return;
+      }
+    } else {
+      state_->Accepted(std::move(listener->socket));
+      listener->socket = tcp::socket(io_context_);
+    }
+    StartAccept(listener);
+  }
+
+  scoped_refptr<MetricEntity> metric_entity_;
+  boost::asio::io_context io_context_;
+  boost::optional<boost::asio::io_context::work> work_{io_context_};
+  std::vector<std::unique_ptr<Listener>> listeners_;
+  boost::optional<PgMuxState> state_;
+  scoped_refptr<Thread> thread_;
+};
+
+PgConnectionMultiplexer::PgConnectionMultiplexer(
+    const scoped_refptr<MetricEntity>& metric_entity)
+    : impl_(new Impl(metric_entity)) {
+}
+
+PgConnectionMultiplexer::~PgConnectionMultiplexer() {
+}
+
+Status PgConnectionMultiplexer::Start(PgProcessConf* conf) {
+  return impl_->Start(conf);
+}
+
+void PgConnectionMultiplexer::Shutdown() {
+  impl_->Shutdown();
+}
+
+}  // namespace pgwrapper
+}  // namespace yb
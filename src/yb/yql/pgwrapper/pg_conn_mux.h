@@ -0,0 +1,70 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+
+#ifndef YB_YQL_PGWRAPPER_PG_CONN_MUX_H
+#define YB_YQL_PGWRAPPER_PG_CONN_MUX_H
+
+#include <memory>
+#include <string>
+
+#include "yb/gutil/ref_counted.h"
+#include "yb/util/slice.h"
+#include "yb/util/status.h"
+
+namespace yb {
+
+class MetricEntity;
+
+namespace pgwrapper {
+
+struct PgProcessConf;
+
+// Returns whether the query could create session state, that must be kept on the backend for the
+// rest of the client session, like settings, prepared statements or temporary tables.
+// False positives only make the multiplexer pin the client to its backend.
+bool QueryCreatesSessionState(Slice query);
+
+// Returns whether the hba rule matches connections by client address. Clients reach PostgreSQL
+// from the address of the multiplexer, so such rules are not supported with it.
+bool HbaRuleDependsOnClientAddress(const std::string& rule);
+
+// Multiplexes YSQL client connections onto a smaller number of PostgreSQL backends.
+//
+// Backends are pooled by the startup parameters of the client connection, i.e. user, database and
+// session settings. A client is attached to a backend only while it is in a transaction or has
+// requests in flight, and the backend goes back to the pool when it is ready for query outside of
+// a transaction. Clients that create session state stay pinned to their backend until they
+// disconnect.
+//
+// Each client is authenticated by a new backend, that joins the pool afterwards if the pool is not
+// full yet, and is terminated otherwise.
+class PgConnectionMultiplexer {
+ public:
+  explicit PgConnectionMultiplexer(const scoped_refptr<MetricEntity>& metric_entity);
+  ~PgConnectionMultiplexer();
+
+  // Listens for clients on all addresses of conf, and changes conf, so PostgreSQL listens on the
+  // local backend address that the multiplexer connects to.
+  // Fails if ysql_hba_conf has rules that depend on the client address.
+  CHECKED_STATUS Start(PgProcessConf* conf);
+
+  void Shutdown();
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace pgwrapper
+}  // namespace yb
+
+#endif  // YB_YQL_PGWRAPPER_PG_CONN_MUX_H
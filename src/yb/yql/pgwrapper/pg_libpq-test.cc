@@ -10,6 +10,8 @@
 // or implied.  See the License for the specific language governing permissions and limitations
 // under the License.
 
+#include <set>
+
 #include "yb/util/monotime.h"
 #include "yb/util/random_util.h"
 #include "yb/util/scope_exit.h"
@@ -742,6 +744,368 @@ TEST_F(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(InTxnDelete)) {
   ASSERT_NO_FATALS(AssertRows(&conn, 1));
 }
 
+// Rows inserted into a table with packed_row storage parameter are stored as single packed values.
+// Checks that their columns are still read, updated and deleted as usual.
+TEST_F(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(PackedRow)) {
+  auto conn = ASSERT_RESULT(Connect());
+
+  ASSERT_OK(conn.Execute(
+      "CREATE TABLE test (pk int PRIMARY KEY, v int, t text) WITH (packed_row = true)"));
+  ASSERT_NOK(conn.Execute("CREATE INDEX test_v ON test (v) WITH (packed_row = true)"));
+
+  ASSERT_OK(conn.Execute("INSERT INTO test VALUES (1, 10, 'one'), (2, 20, NULL)"));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int32_t>("SELECT v FROM test WHERE pk = 1")), 10);
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<std::string>("SELECT t FROM test WHERE pk = 1")),
+            "one");
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>(
+      "SELECT count(*) FROM test WHERE t IS NULL")), 1);
+
+  // Duplicate insert should be detected for packed rows as well.
+  ASSERT_NOK(conn.Execute("INSERT INTO test VALUES (1, 11, 'dup')"));
+
+  ASSERT_OK(conn.Execute("UPDATE test SET v = 12 WHERE pk = 1"));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int32_t>("SELECT v FROM test WHERE pk = 1")), 12);
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<std::string>("SELECT t FROM test WHERE pk = 1")),
+            "one");
+
+  ASSERT_OK(conn.Execute("DELETE FROM test WHERE pk = 2"));
+  ASSERT_NO_FATALS(AssertRows(&conn, 1));
+}
+
+class PgLibPqReadCommittedTest : public PgLibPqTest {
+ protected:
+  void UpdateMiniClusterOptions(ExternalMiniClusterOptions* options) override {
+    PgLibPqTest::UpdateMiniClusterOptions(options);
+    options->extra_tserver_flags.push_back("--ysql_enable_read_committed_isolation=true");
+  }
+};
+
+// Each statement of a READ COMMITTED transaction should see rows committed before it started,
+// while REPEATABLE READ transaction keeps reading at the same read point.
+TEST_F(PgLibPqReadCommittedTest, YB_DISABLE_TEST_IN_TSAN(StatementReadPoint)) {
+  auto conn = ASSERT_RESULT(Connect());
+  auto write_conn = ASSERT_RESULT(Connect());
+
+  ASSERT_OK(conn.Execute("CREATE TABLE test (pk int PRIMARY KEY)"));
+
+  ASSERT_OK(conn.Execute("BEGIN ISOLATION LEVEL READ COMMITTED"));
+  ASSERT_OK(conn.Execute("INSERT INTO test VALUES (1)"));
+  ASSERT_NO_FATALS(AssertRows(&conn, 1));
+  ASSERT_OK(write_conn.Execute("INSERT INTO test VALUES (2)"));
+  ASSERT_NO_FATALS(AssertRows(&conn, 2));
+  ASSERT_OK(conn.Execute("COMMIT"));
+  ASSERT_NO_FATALS(AssertRows(&conn, 2));
+
+  ASSERT_OK(conn.Execute("BEGIN ISOLATION LEVEL REPEATABLE READ"));
+  ASSERT_NO_FATALS(AssertRows(&conn, 2));
+  ASSERT_OK(write_conn.Execute("INSERT INTO test VALUES (3)"));
+  ASSERT_NO_FATALS(AssertRows(&conn, 2));
+  ASSERT_OK(conn.Execute("COMMIT"));
+  ASSERT_NO_FATALS(AssertRows(&conn, 3));
+}
+
+class PgLibPqParallelScanTest : public PgLibPqTest {
+ protected:
+  void UpdateMiniClusterOptions(ExternalMiniClusterOptions* options) override {
+    PgLibPqTest::UpdateMiniClusterOptions(options);
+    options->extra_tserver_flags.push_back("--ysql_enable_parallel_aggregate_scan=true");
+    options->extra_tserver_flags.push_back("--ysql_max_parallel_scan_partitions=4");
+    // Small pages, so each partition is read using several pages.
+    options->extra_tserver_flags.push_back("--ysql_prefetch_limit=32");
+  }
+};
+
+// Aggregates evaluated by all tablets of the table in parallel should be combined into the same
+// result as aggregates evaluated by visiting tablets one after another.
+TEST_F(PgLibPqParallelScanTest, YB_DISABLE_TEST_IN_TSAN(Aggregates)) {
+  constexpr int kNumRows = 1000;
+  auto conn = ASSERT_RESULT(Connect());
+
+  ASSERT_OK(conn.Execute("CREATE TABLE test (k int PRIMARY KEY, v int)"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO test SELECT i, i * 2 FROM generate_series(1, $0) AS i", kNumRows));
+
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT count(*) FROM test")), kNumRows);
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT sum(v) FROM test")),
+            static_cast<int64_t>(kNumRows) * (kNumRows + 1));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int32_t>("SELECT min(v) FROM test")), 2);
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int32_t>("SELECT max(v) FROM test")), kNumRows * 2);
+
+  ASSERT_OK(conn.Execute("DELETE FROM test"));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT count(*) FROM test")), 0);
+}
+
+// Full scan reading several partitions in parallel should return every row exactly once.
+TEST_F(PgLibPqParallelScanTest, YB_DISABLE_TEST_IN_TSAN(Rows)) {
+  constexpr int kNumRows = 1000;
+  auto conn = ASSERT_RESULT(Connect());
+
+  ASSERT_OK(conn.Execute("CREATE TABLE test (k int PRIMARY KEY, v int)"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO test SELECT i, i FROM generate_series(1, $0) AS i", kNumRows));
+
+  auto res = ASSERT_RESULT(conn.Fetch("SELECT k, v FROM test"));
+  ASSERT_EQ(PQntuples(res.get()), kNumRows);
+  std::vector<bool> seen(kNumRows + 1);
+  for (int row = 0; row != kNumRows; ++row) {
+    auto key = ASSERT_RESULT(GetInt32(res.get(), row, 0));
+    ASSERT_EQ(ASSERT_RESULT(GetInt32(res.get(), row, 1)), key);
+    ASSERT_GE(key, 1);
+    ASSERT_LE(key, kNumRows);
+    ASSERT_FALSE(seen[key]) << "Duplicate key: " << key;
+    seen[key] = true;
+  }
+
+  // Statement with LIMIT reads partitions one after another.
+  res = ASSERT_RESULT(conn.Fetch("SELECT k FROM test LIMIT 10"));
+  ASSERT_EQ(PQntuples(res.get()), 10);
+}
+
+// Nested loop join fetching inner rows for a batch of outer rows should produce the same result
+// as the join rescanning the inner table for each outer row.
+TEST_F(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(BatchedNestLoopJoin)) {
+  constexpr int kNumDimRows = 50;
+  constexpr int kNumFactRows = 300;
+  auto conn = ASSERT_RESULT(Connect());
+
+  ASSERT_OK(conn.Execute("CREATE TABLE dim (k int PRIMARY KEY, v int)"));
+  ASSERT_OK(conn.Execute("CREATE TABLE fact (id int PRIMARY KEY, dim_k int)"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO dim SELECT i, i * 10 FROM generate_series(1, $0) AS i", kNumDimRows));
+  // Some fact rows reference missing dim rows, and some have NULL reference.
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO fact SELECT i, CASE WHEN i % 7 = 0 THEN NULL ELSE i % ($0 + 10) END "
+      "FROM generate_series(1, $1) AS i", kNumDimRows, kNumFactRows));
+
+  ASSERT_OK(conn.Execute("SET enable_hashjoin = off"));
+  ASSERT_OK(conn.Execute("SET enable_mergejoin = off"));
+  const std::vector<std::string> queries = {
+      "SELECT count(*) FROM fact f JOIN dim d ON d.k = f.dim_k",
+      "SELECT sum(f.id * d.v) FROM fact f JOIN dim d ON d.k = f.dim_k",
+      "SELECT sum(f.id * coalesce(d.v, 1)) FROM fact f LEFT JOIN dim d ON d.k = f.dim_k",
+      "SELECT count(*) FROM fact f WHERE NOT EXISTS (SELECT 1 FROM dim d WHERE d.k = f.dim_k)",
+  };
+  for (const auto& query : queries) {
+    ASSERT_OK(conn.Execute("SET yb_nest_loop_batch_size = 1"));
+    auto expected = ASSERT_RESULT(conn.FetchValue<int64_t>(query));
+    ASSERT_OK(conn.Execute("SET yb_nest_loop_batch_size = 16"));
+    auto batched = ASSERT_RESULT(conn.FetchValue<int64_t>(query));
+    ASSERT_EQ(expected, batched) << query;
+  }
+}
+
+class PgLibPqCatalogPreloadTest : public PgLibPqTest {
+ protected:
+  void UpdateMiniClusterOptions(ExternalMiniClusterOptions* options) override {
+    PgLibPqTest::UpdateMiniClusterOptions(options);
+    options->extra_tserver_flags.push_back(
+        "--ysql_pg_conf=yb_preload_catalog_caches_on_connect=true");
+  }
+};
+
+// Connections that preload catalog caches at start should see the catalog changes made before
+// they were started.
+TEST_F(PgLibPqCatalogPreloadTest, YB_DISABLE_TEST_IN_TSAN(NewConnectionsSeeCatalogChanges)) {
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE test (k int PRIMARY KEY)"));
+  ASSERT_OK(conn.Execute("INSERT INTO test VALUES (1)"));
+
+  auto conn2 = ASSERT_RESULT(Connect());
+  ASSERT_EQ(ASSERT_RESULT(conn2.FetchValue<int64_t>("SELECT count(*) FROM test")), 1);
+
+  ASSERT_OK(conn.Execute("ALTER TABLE test ADD COLUMN v int"));
+  ASSERT_OK(conn.Execute("INSERT INTO test VALUES (2, 20)"));
+
+  auto conn3 = ASSERT_RESULT(Connect());
+  ASSERT_EQ(ASSERT_RESULT(conn3.FetchValue<int32_t>("SELECT v FROM test WHERE k = 2")), 20);
+}
+
+// Existing connections should see catalog changes made by other connections, whether the caches
+// are invalidated by the shipped invalidation messages or fully refreshed.
+void TestCatalogChangesSeenByOtherConnection(PGConn* conn1, PGConn* conn2) {
+  ASSERT_OK(conn1->Execute("CREATE TABLE test (k int PRIMARY KEY)"));
+  ASSERT_OK(conn1->Execute("INSERT INTO test VALUES (1)"));
+  ASSERT_EQ(ASSERT_RESULT(conn2->FetchValue<int64_t>("SELECT count(*) FROM test")), 1);
+
+  ASSERT_OK(conn1->Execute("ALTER TABLE test ADD COLUMN v int"));
+  ASSERT_OK(conn2->Execute("INSERT INTO test VALUES (2, 20)"));
+  ASSERT_EQ(ASSERT_RESULT(conn2->FetchValue<int32_t>("SELECT v FROM test WHERE k = 2")), 20);
+
+  ASSERT_OK(conn1->Execute("CREATE INDEX test_v_idx ON test (v)"));
+  ASSERT_OK(conn2->Execute("INSERT INTO test VALUES (3, 30)"));
+  ASSERT_EQ(ASSERT_RESULT(conn1->FetchValue<int32_t>("SELECT k FROM test WHERE v = 30")), 3);
+
+  ASSERT_OK(conn1->Execute("BEGIN"));
+  ASSERT_OK(conn1->Execute("ALTER TABLE test RENAME COLUMN v TO w"));
+  ASSERT_OK(conn1->Execute("CREATE TABLE test2 (k int PRIMARY KEY)"));
+  ASSERT_OK(conn1->Execute("COMMIT"));
+  ASSERT_EQ(ASSERT_RESULT(conn2->FetchValue<int32_t>("SELECT w FROM test WHERE k = 3")), 30);
+  ASSERT_OK(conn2->Execute("INSERT INTO test2 VALUES (1)"));
+
+  ASSERT_OK(conn1->Execute("DROP TABLE test2"));
+  ASSERT_NOK(conn2->Execute("INSERT INTO test2 VALUES (2)"));
+}
+
+TEST_F(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(CatalogChangesSeenByOtherConnection)) {
+  auto conn1 = ASSERT_RESULT(Connect());
+  auto conn2 = ASSERT_RESULT(Connect());
+  TestCatalogChangesSeenByOtherConnection(&conn1, &conn2);
+}
+
+class PgLibPqNoCatalogInvalidationHistoryTest : public PgLibPqTest {
+ protected:
+  void UpdateMiniClusterOptions(ExternalMiniClusterOptions* options) override {
+    PgLibPqTest::UpdateMiniClusterOptions(options);
+    options->extra_master_flags.push_back("--ysql_catalog_invalidation_history_size=0");
+  }
+};
+
+TEST_F(PgLibPqNoCatalogInvalidationHistoryTest,
+       YB_DISABLE_TEST_IN_TSAN(CatalogChangesSeenByOtherConnection)) {
+  auto conn1 = ASSERT_RESULT(Connect());
+  auto conn2 = ASSERT_RESULT(Connect());
+  TestCatalogChangesSeenByOtherConnection(&conn1, &conn2);
+}
+
+class PgLibPqSequenceCacheTest : public PgLibPqTest {
+ protected:
+  void UpdateMiniClusterOptions(ExternalMiniClusterOptions* options) override {
+    PgLibPqTest::UpdateMiniClusterOptions(options);
+    options->extra_tserver_flags.push_back(
+        Format("--ysql_sequence_cache_minval=$0", kCacheMinval));
+  }
+
+  static constexpr int kCacheMinval = 100;
+};
+
+// Every backend should reserve at least ysql_sequence_cache_minval sequence values at once, and
+// serve them without updating the sequence.
+TEST_F(PgLibPqSequenceCacheTest, YB_DISABLE_TEST_IN_TSAN(MinimalCache)) {
+  auto conn1 = ASSERT_RESULT(Connect());
+  auto conn2 = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn1.Execute("CREATE SEQUENCE seq"));
+
+  for (int i = 1; i <= kCacheMinval; ++i) {
+    ASSERT_EQ(ASSERT_RESULT(conn1.FetchValue<int64_t>("SELECT nextval('seq')")), i);
+  }
+  ASSERT_EQ(ASSERT_RESULT(conn2.FetchValue<int64_t>("SELECT nextval('seq')")), kCacheMinval + 1);
+  ASSERT_EQ(ASSERT_RESULT(conn1.FetchValue<int64_t>("SELECT nextval('seq')")),
+            2 * kCacheMinval + 1);
+}
+
+class PgLibPqFKCheckBatchTest : public PgLibPqTest {
+ protected:
+  void UpdateMiniClusterOptions(ExternalMiniClusterOptions* options) override {
+    PgLibPqTest::UpdateMiniClusterOptions(options);
+    options->extra_tserver_flags.push_back("--ysql_fk_check_batch_size=1024");
+  }
+};
+
+// Foreign keys checked with batched reads of the referenced table should accept and reject the
+// same rows as checks made row by row.
+TEST_F(PgLibPqFKCheckBatchTest, YB_DISABLE_TEST_IN_TSAN(InsertSelect)) {
+  constexpr int kNumParents = 100;
+  constexpr int kNumChildren = 2000;
+  auto conn = ASSERT_RESULT(Connect());
+
+  ASSERT_OK(conn.Execute("CREATE TABLE parent (k int PRIMARY KEY, u int UNIQUE)"));
+  ASSERT_OK(conn.Execute(
+      "CREATE TABLE child (k int PRIMARY KEY, pk int REFERENCES parent(k), "
+      "pu int REFERENCES parent(u))"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO parent SELECT i, -i FROM generate_series(1, $0) AS i", kNumParents));
+
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO child SELECT i, i % $0 + 1, -(i % $0 + 1) FROM generate_series(1, $1) AS i",
+      kNumParents, kNumChildren));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT count(*) FROM child")),
+            kNumChildren);
+
+  // The last row references missing parent.
+  ASSERT_NOK(conn.ExecuteFormat(
+      "INSERT INTO child SELECT i, CASE WHEN i = $1 THEN $0 + 1 ELSE 1 END, NULL "
+      "FROM generate_series($1 - 100, $1) AS i", kNumParents, 2 * kNumChildren));
+  ASSERT_NOK(conn.ExecuteFormat(
+      "INSERT INTO child VALUES ($0, 1, -($1 + 1))", 3 * kNumChildren, kNumParents));
+
+  // Parent inserted by the same transaction.
+  ASSERT_OK(conn.Execute("BEGIN"));
+  ASSERT_OK(conn.ExecuteFormat("INSERT INTO parent VALUES ($0, -$0)", kNumParents + 1));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO child SELECT i, $0, -$0 FROM generate_series($1, $1 + 10) AS i",
+      kNumParents + 1, 4 * kNumChildren));
+  ASSERT_OK(conn.Execute("COMMIT"));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT count(*) FROM child")),
+            kNumChildren + 11);
+}
+
+// Conditions on non-key columns evaluated by DocDB should select the same rows as conditions
+// evaluated by Postgres, including the rows with NULL values.
+TEST_F(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(WherePushdown)) {
+  constexpr int kNumRows = 1000;
+  auto conn = ASSERT_RESULT(Connect());
+
+  ASSERT_OK(conn.Execute("CREATE TABLE t (k int PRIMARY KEY, v int, b bool, s text)"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, CASE WHEN i % 7 = 0 THEN NULL ELSE i % 100 END, i % 3 = 0, "
+      "CASE WHEN i % 11 = 0 THEN NULL ELSE 'value' || (i % 10) END "
+      "FROM generate_series(1, $0) AS i", kNumRows));
+
+  const std::vector<std::string> conditions = {
+    "v = 10",
+    "v <> 10",
+    "20 > v",
+    "v >= 50 AND v < 60",
+    "v <= 5 OR s = 'value3'",
+    "NOT (v > 10 OR b = true)",
+    "s <> 'value1' AND b = false",
+    "s > 'value5'",
+  };
+  auto fetch_matching = [&conn](const std::string& condition) -> Result<std::string> {
+    auto res = VERIFY_RESULT(conn.FetchMatrix(
+        Format("SELECT count(*), coalesce(sum(k), 0) FROM t WHERE $0", condition), 1, 2));
+    return Format("$0 rows, sum $1", VERIFY_RESULT(GetInt64(res.get(), 0, 0)),
+                  VERIFY_RESULT(GetInt64(res.get(), 0, 1)));
+  };
+  for (const auto& condition : conditions) {
+    ASSERT_OK(conn.Execute("SET yb_enable_where_pushdown = false"));
+    auto expected = ASSERT_RESULT(fetch_matching(condition));
+    ASSERT_OK(conn.Execute("SET yb_enable_where_pushdown = true"));
+    auto pushed_down = ASSERT_RESULT(fetch_matching(condition));
+    ASSERT_EQ(expected, pushed_down) << "Condition: " << condition;
+  }
+}
+
+// Statements executed while a cursor is open should not move the read point of the cursor.
+TEST_F(PgLibPqReadCommittedTest, YB_DISABLE_TEST_IN_TSAN(CursorReadPoint)) {
+  // Cursor should fetch rows from tablet servers in several batches.
+  constexpr int kNumRows = 5000;
+
+  auto conn = ASSERT_RESULT(Connect());
+  auto write_conn = ASSERT_RESULT(Connect());
+
+  ASSERT_OK(conn.Execute("CREATE TABLE test (pk int PRIMARY KEY)"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO test SELECT i FROM generate_series(1, $0) AS i", kNumRows));
+
+  ASSERT_OK(conn.Execute("BEGIN ISOLATION LEVEL READ COMMITTED"));
+  ASSERT_OK(conn.Execute("DECLARE c CURSOR FOR SELECT * FROM test"));
+  auto res = ASSERT_RESULT(conn.Fetch("FETCH 1 FROM c"));
+  ASSERT_EQ(PQntuples(res.get()), 1);
+
+  ASSERT_OK(write_conn.Execute("DELETE FROM test"));
+
+  // Read point is kept while the cursor is open.
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT count(*) FROM test")), kNumRows);
+  res = ASSERT_RESULT(conn.Fetch("FETCH ALL FROM c"));
+  ASSERT_EQ(PQntuples(res.get()), kNumRows - 1);
+
+  // After the cursor is closed, the next statement sees the rows committed before it.
+  ASSERT_OK(conn.Execute("CLOSE c"));
+  ASSERT_NO_FATALS(AssertRows(&conn, 0));
+  ASSERT_OK(conn.Execute("COMMIT"));
+}
+
 TEST_F(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(CompoundKeyColumnOrder)) {
   const string table_name = "test";
   auto conn = ASSERT_RESULT(Connect());
@@ -820,6 +1184,56 @@ TEST_F(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(BulkCopy)) {
   }
 }
 
+class PgLibPqBulkLoadCopyTest : public PgLibPqTest {
+ protected:
+  void UpdateMiniClusterOptions(ExternalMiniClusterOptions* options) override {
+    PgLibPqTest::UpdateMiniClusterOptions(options);
+    options->extra_tserver_flags.push_back("--ysql_non_txn_copy=true");
+    options->extra_tserver_flags.push_back("--ysql_non_txn_copy_bulk_load=true");
+  }
+
+  CHECKED_STATUS CopyRows(PGConn* conn, int first_key, int last_key) {
+    RETURN_NOT_OK(conn->CopyBegin("COPY test FROM STDIN WITH BINARY"));
+    for (int key = first_key; key <= last_key; ++key) {
+      conn->CopyStartRow(2);
+      conn->CopyPutInt32(key);
+      conn->CopyPutString(Format("Value $0", key));
+    }
+    RETURN_NOT_OK(conn->CopyEnd());
+    return Status::OK();
+  }
+};
+
+// COPY into an empty table writes rows without checking each of them against the existing rows,
+// while duplicate keys are still reported both within the loaded rows and against existing rows.
+TEST_F(PgLibPqBulkLoadCopyTest, YB_DISABLE_TEST_IN_TSAN(EmptyTable)) {
+  constexpr int kNumRows = 1000;
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE test (k int PRIMARY KEY, v text)"));
+
+  ASSERT_OK(CopyRows(&conn, 1, kNumRows));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT count(*) FROM test")), kNumRows);
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<std::string>("SELECT v FROM test WHERE k = 10")),
+            "Value 10");
+
+  ASSERT_NOK(CopyRows(&conn, kNumRows, kNumRows));
+  ASSERT_OK(CopyRows(&conn, kNumRows + 1, kNumRows + 10));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT count(*) FROM test")), kNumRows + 10);
+}
+
+TEST_F(PgLibPqBulkLoadCopyTest, YB_DISABLE_TEST_IN_TSAN(DuplicateKeys)) {
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE test (k int PRIMARY KEY, v text)"));
+
+  ASSERT_OK(conn.CopyBegin("COPY test FROM STDIN WITH BINARY"));
+  for (int key : {1, 2, 1}) {
+    conn.CopyStartRow(2);
+    conn.CopyPutInt32(key);
+    conn.CopyPutString(Format("Value $0", key));
+  }
+  ASSERT_NOK(conn.CopyEnd());
+}
+
 TEST_F(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(CatalogManagerMapsTest)) {
   auto conn = ASSERT_RESULT(Connect());
   ASSERT_OK(conn.Execute("CREATE DATABASE test_db"));
@@ -1074,6 +1488,79 @@ TEST_F(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(TxnConflictsForColocatedTables)) {
   ASSERT_OK(conn2.CommitTransaction());
 }
 
+// Rows locked by SELECT ... FOR UPDATE should not block locking of other rows of the same
+// tablet, and SKIP LOCKED should return rows that are not locked yet, as a job queue does.
+TEST_F(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(SelectForUpdateSkipLocked)) {
+  constexpr int kNumJobs = 10;
+  constexpr int kJobsPerTake = 3;
+
+  auto conn1 = ASSERT_RESULT(Connect());
+  auto conn2 = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn1.Execute("CREATE TABLE jobs (id INT, PRIMARY KEY (id ASC))"));
+  ASSERT_OK(conn1.ExecuteFormat("INSERT INTO jobs SELECT generate_series(1, $0)", kNumJobs));
+
+  ASSERT_OK(conn1.StartTransaction(IsolationLevel::SNAPSHOT_ISOLATION));
+  ASSERT_OK(conn2.StartTransaction(IsolationLevel::SNAPSHOT_ISOLATION));
+  auto res = ASSERT_RESULT(conn1.Fetch("SELECT id FROM jobs WHERE id = 1 FOR UPDATE"));
+  ASSERT_EQ(PQntuples(res.get()), 1);
+  res = ASSERT_RESULT(conn2.Fetch("SELECT id FROM jobs WHERE id = 2 FOR UPDATE"));
+  ASSERT_EQ(PQntuples(res.get()), 1);
+  ASSERT_OK(conn1.CommitTransaction());
+  ASSERT_OK(conn2.CommitTransaction());
+
+  const auto take_jobs = Format(
+      "SELECT id FROM jobs FOR UPDATE SKIP LOCKED LIMIT $0", kJobsPerTake);
+  ASSERT_OK(conn1.StartTransaction(IsolationLevel::SNAPSHOT_ISOLATION));
+  ASSERT_OK(conn2.StartTransaction(IsolationLevel::SNAPSHOT_ISOLATION));
+  std::set<int32_t> taken;
+  for (auto* conn : {&conn1, &conn2}) {
+    res = ASSERT_RESULT(conn->Fetch(take_jobs));
+    ASSERT_EQ(PQntuples(res.get()), kJobsPerTake);
+    for (int i = 0; i != kJobsPerTake; ++i) {
+      ASSERT_TRUE(taken.insert(ASSERT_RESULT(GetInt32(res.get(), i, 0))).second);
+    }
+  }
+  ASSERT_OK(conn1.CommitTransaction());
+  ASSERT_OK(conn2.CommitTransaction());
+}
+
+// Rows fetched in batches should be updated by their own ybctid.
+TEST_F(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(UpdateRowsFetchedInBatches)) {
+  constexpr int kNumRows = 500;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (k INT PRIMARY KEY, v INT)"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, i FROM generate_series(1, $0) AS i", kNumRows));
+  ASSERT_OK(conn.Execute("UPDATE t SET v = v + 1 WHERE v > 0"));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t WHERE v = k + 1")),
+            kNumRows);
+}
+
+// Each row of a batch fetched by NextRowBatch should get its own ybctid, rather than the ybctid of
+// the iterator position after the batch.
+TEST_F(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(YbctidOfRowsFetchedInBatches)) {
+  constexpr int kNumRows = 500;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (k INT PRIMARY KEY, v INT)"));
+  ASSERT_OK(conn.Execute("CREATE TABLE ids (k INT PRIMARY KEY, id BYTEA)"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, i FROM generate_series(1, $0) AS i", kNumRows));
+
+  // Full scan fetches rows of each tablet in batches.
+  ASSERT_OK(conn.Execute("INSERT INTO ids SELECT k, ybctid FROM t"));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(DISTINCT id) FROM ids")),
+            kNumRows);
+
+  // Point lookup by the collected ybctid should return the row it was collected for.
+  for (int k = 1; k <= kNumRows; k += 37) {
+    ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int32_t>(Format(
+                  "SELECT t.k FROM t WHERE t.ybctid = (SELECT id FROM ids WHERE k = $0)", k))),
+              k);
+  }
+}
+
 // Test that the number of RPCs sent to master upon first connection is not too high.
 // See https://github.com/yugabyte/yugabyte-db/issues/3049
 TEST_F(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(NumberOfInitialRpcs)) {
@@ -414,5 +414,49 @@ TEST_F(PgOnConflictTest, YB_DISABLE_TEST_IN_TSAN(NoTxnOnConflict)) {
   LogResult(ASSERT_RESULT(conn.Fetch("SELECT * FROM test ORDER BY k")).get());
 }
 
+class PgOnConflictBatchTest : public PgOnConflictTest {
+ protected:
+  void UpdateMiniClusterOptions(ExternalMiniClusterOptions* options) override {
+    PgOnConflictTest::UpdateMiniClusterOptions(options);
+    options->extra_tserver_flags.push_back("--ysql_insert_on_conflict_batch_size=16");
+  }
+};
+
+// Rows checked for conflicts with batched reads should be inserted and updated as with checks
+// made row by row, including rows that conflict with earlier rows of the same statement.
+TEST_F(PgOnConflictBatchTest, YB_DISABLE_TEST_IN_TSAN(Upsert)) {
+  constexpr int kNumRows = 100;
+  auto conn = ASSERT_RESULT(Connect());
+
+  ASSERT_OK(conn.Execute("CREATE TABLE test (k int PRIMARY KEY, v int)"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO test SELECT i, 0 FROM generate_series(1, $0, 2) AS i", kNumRows));
+
+  // Odd keys exist, even keys are new.
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO test SELECT i, 1 FROM generate_series(1, $0) AS i "
+      "ON CONFLICT (k) DO UPDATE SET v = test.v + excluded.v", kNumRows));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT count(*) FROM test")), kNumRows);
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT sum(v) FROM test")), kNumRows);
+
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO test SELECT i, 10 FROM generate_series(1, 2 * $0) AS i "
+      "ON CONFLICT DO NOTHING", kNumRows));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT count(*) FROM test")), 2 * kNumRows);
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT sum(v) FROM test")), 11 * kNumRows);
+
+  // Each key is inserted twice, by rows of different batches, and by rows of the same batch.
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO test SELECT 2 * $0 + 1 + i % $0, i FROM generate_series(0, 2 * $0 - 1) AS i "
+      "ON CONFLICT (k) DO NOTHING", kNumRows));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO test VALUES ($0, 1), ($0, 2) ON CONFLICT (k) DO NOTHING", 4 * kNumRows));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT count(*) FROM test")),
+            3 * kNumRows + 1);
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>(Format(
+                "SELECT sum(v) FROM test WHERE k > $0", 2 * kNumRows))),
+            kNumRows * (kNumRows - 1) / 2 + 1);
+}
+
 } // namespace pgwrapper
 } // namespace yb
@@ -376,9 +376,26 @@ void ClusterCommand(
     size_t idx,
     BatchContext* context) {
   RedisResponsePB cluster_response;
-  auto array_response = cluster_response.mutable_array_response();
   LocalCommandData data(info, idx, context);
-  GetTabletLocations(data, array_response);
+  if (data.arg_size() == 3 && boost::iequals(data.arg(1).ToBuffer(), "KEYSLOT")) {
+    // Slot of the key is its hash partition key, see PartitionSchema::EncodeRedisKey.
+    auto* table = data.table();
+    if (table == nullptr) {
+      data.Respond(STATUS(ServiceUnavailable, "Redis table is not available"), &cluster_response);
+      return;
+    }
+    std::string partition_key;
+    auto status = table->partition_schema().EncodeRedisKey(data.arg(2), &partition_key);
+    if (!status.ok()) {
+      data.Respond(status, &cluster_response);
+      return;
+    }
+    cluster_response.set_code(RedisResponsePB::OK);
+    cluster_response.set_int_response(PartitionSchema::DecodeMultiColumnHashValue(partition_key));
+    data.Respond(&cluster_response);
+    return;
+  }
+  GetTabletLocations(data, cluster_response.mutable_array_response());
   context->call()->RespondSuccess(idx, info.metrics, &cluster_response);
   VLOG(1) << "Done responding to CLUSTER.";
 }
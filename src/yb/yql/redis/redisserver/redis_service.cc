@@ -15,6 +15,7 @@
 
 #include <iostream>
 #include <thread>
+#include <vector>
 
 #include <boost/algorithm/string/case_conv.hpp>
 
@@ -39,7 +40,9 @@
 #include "yb/client/table.h"
 #include "yb/client/yb_op.h"
 
+#include "yb/common/partition.h"
 #include "yb/common/redis_protocol.pb.h"
+#include "yb/common/wire_protocol.h"
 
 #include "yb/yql/redis/redisserver/redis_commands.h"
 #include "yb/yql/redis/redisserver/redis_constants.h"
@@ -55,6 +58,7 @@
 #include "yb/tserver/tserver_service.proxy.h"
 
 #include "yb/util/bytes_formatter.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/locks.h"
 #include "yb/util/logging.h"
 #include "yb/util/memory/mc_types.h"
@@ -122,6 +126,18 @@ DEFINE_int32(redis_password_caching_duration_ms, 5000,
 
 DEFINE_bool(redis_safe_batch, true, "Use safe batching with Redis service");
 DEFINE_bool(enable_redis_auth, true, "Enable AUTH for the Redis service");
+DEFINE_bool(redis_single_flush_per_batch, true,
+            "Flush operations of a batch that don't depend on other operations using a single "
+            "session, instead of a session per tablet");
+DEFINE_bool(redis_cluster_redirects, false,
+            "Reply with a Redis Cluster MOVED redirection to the redis server of the tablet "
+            "leader, when a command for a key is received by a server that does not lead the "
+            "tablet of the key. Lets cluster aware clients, that learn the slot ranges from "
+            "CLUSTER SLOTS, send commands directly to leaders. Locations of the tablet are "
+            "refreshed from the master after each redirect. Should be enabled only when all "
+            "clients are cluster aware.");
+TAG_FLAG(redis_cluster_redirects, advanced);
+TAG_FLAG(redis_cluster_redirects, runtime);
 
 DECLARE_string(placement_cloud);
 DECLARE_string(placement_region);
@@ -397,6 +413,14 @@ class Block : public std::enable_shared_from_this<Block> {
     ops_.push_back(operation);
   }
 
+  // Moves all operations of the other block to this one. The other block should be independent,
+  // i.e. it should not have next block, and should not be launched after this call.
+  void TakeOperations(Block* other) {
+    DCHECK(!other->next_);
+    ops_.insert(ops_.end(), other->ops_.begin(), other->ops_.end());
+    other->ops_.clear();
+  }
+
   void Launch(SessionPool* session_pool, bool allow_local_calls_in_curr_thread = true) {
     session_pool_ = session_pool;
     session_ = session_pool->Take();
@@ -582,17 +606,16 @@ class TabletOperations {
     FATAL_INVALID_ENUM_VALUE(OperationType, type);
   }
 
-  void Done(SessionPool* session_pool, bool allow_local_calls_in_curr_thread) {
+  // Collects blocks that should be launched for this tablet to heads.
+  // When read_group and write_group are specified, independent read and write blocks of this
+  // tablet are merged into them, so they are flushed together with other tablets.
+  void Done(BlockPtr* read_group, BlockPtr* write_group, std::vector<BlockPtr>* heads) {
     if (flush_head_) {
-      flush_head_->Launch(session_pool, allow_local_calls_in_curr_thread);
-    } else {
-      if (read_data_.block) {
-        read_data_.block->Launch(session_pool, allow_local_calls_in_curr_thread);
-      }
-      if (write_data_.block) {
-        write_data_.block->Launch(session_pool, allow_local_calls_in_curr_thread);
-      }
+      heads->push_back(flush_head_);
+      return;
     }
+    MergeOrAdd(read_data_.block, read_group, heads);
+    MergeOrAdd(write_data_.block, write_group, heads);
   }
 
   void Process(const BatchContextPtr& context,
@@ -634,6 +657,20 @@ class TabletOperations {
   }
 
  private:
+  static void MergeOrAdd(
+      const BlockPtr& block, BlockPtr* group, std::vector<BlockPtr>* heads) {
+    if (!block) {
+      return;
+    }
+    if (!group) {
+      heads->push_back(block);
+    } else if (!*group) {
+      *group = block;
+    } else {
+      (*group)->TakeOperations(block.get());
+    }
+  }
+
   void ProcessLocalOperation(const BatchContextPtr& context,
                              Arena* arena,
                              Operation* operation,
@@ -927,6 +964,32 @@ class BatchContextImpl : public BatchContext {
     }
   }
 
+  // Responds with MOVED to the redis server of the leader of the operation tablet, if it is not
+  // the local tserver. Operations of tablets with unknown leader are served locally.
+  void RedirectToLeader(Operation* operation) {
+    const auto& partition_key = operation->partition_key();
+    if ((operation->type() != OperationType::kRead &&
+         operation->type() != OperationType::kWrite) ||
+        partition_key.size() != PartitionSchema::kPartitionKeySize) {
+      return;
+    }
+    auto* leader = operation->tablet()->LeaderTServer();
+    if (!leader || leader->IsLocal()) {
+      return;
+    }
+    const auto& host = DesiredHostPort(
+        leader->public_rpc_hostports(), leader->private_rpc_hostports(), leader->cloud_info(),
+        CloudInfoPB()).host();
+    // Redis servers of the cluster are expected to listen on the same port.
+    const auto redis_port = impl_data_->server_->opts().rpc_opts.default_port;
+    operation->Respond(STATUS_FORMAT(
+        IllegalState, "MOVED $0 $1:$2",
+        PartitionSchema::DecodeMultiColumnHashValue(partition_key), host, redis_port));
+    // The leader could be taken from stale locations, so refresh them before the next redirect
+    // of this tablet. Otherwise clients could be bounced between servers with stale caches.
+    operation->tablet()->MarkStale();
+  }
+
   void LookupDone(
       Operation* operation, int retries, const Result<client::internal::RemoteTabletPtr>& result) {
     const int kMaxRetries = 2;
@@ -939,6 +1002,9 @@ class BatchContextImpl : public BatchContext {
       }
     } else {
       operation->SetTablet(*result);
+      if (FLAGS_redis_cluster_redirects) {
+        RedirectToLeader(operation);
+      }
     }
     if (lookups_left_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
       return;
@@ -961,11 +1027,27 @@ class BatchContextImpl : public BatchContext {
       }
     }
 
-    int idx = 0;
+    // Operations that don't depend on others are flushed together, and their RPCs are sent by
+    // the session per tablet, so a pipeline of commands on different keys takes one flush.
+    BlockPtr read_group, write_group;
+    const bool single_flush = FLAGS_redis_single_flush_per_batch;
+    std::vector<BlockPtr> heads;
     for (auto& tablet : tablets_) {
-      tablet.second.Done(&impl_data_->session_pool_, ++idx == tablets_.size());
+      tablet.second.Done(
+          single_flush ? &read_group : nullptr, single_flush ? &write_group : nullptr, &heads);
+    }
+    if (read_group) {
+      heads.push_back(std::move(read_group));
+    }
+    if (write_group) {
+      heads.push_back(std::move(write_group));
     }
     tablets_.clear();
+
+    size_t idx = 0;
+    for (const auto& head : heads) {
+      head->Launch(&impl_data_->session_pool_, ++idx == heads.size());
+    }
   }
 
   RedisServiceImplData* impl_data_ = nullptr;
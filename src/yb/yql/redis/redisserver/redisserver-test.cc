@@ -50,7 +50,10 @@ DECLARE_uint64(redis_max_read_buffer_size);
 DECLARE_uint64(redis_max_queued_bytes);
 DECLARE_int64(redis_rpc_block_size);
 DECLARE_bool(redis_safe_batch);
+DECLARE_bool(redis_single_flush_per_batch);
+DECLARE_bool(redis_cluster_redirects);
 DECLARE_bool(emulate_redis_responses);
+DECLARE_bool(redis_sorted_set_read_from_end);
 DECLARE_bool(test_tserver_timeout);
 DECLARE_bool(enable_backpressure_mode_for_testing);
 DECLARE_bool(yedis_enable_flush);
@@ -1204,6 +1207,26 @@ TEST_F_EX(TestRedisService, Pipeline, TestRedisServicePipelined) {
   LOG(INFO) << yb::Format("Unsafe set: $0ms, get: $1ms", set_time.count(), get_time.count());
 }
 
+class TestRedisServicePipelinedPerTabletFlush : public TestRedisServicePipelined {
+ public:
+  void SetUp() override {
+    FLAGS_redis_single_flush_per_batch = false;
+    TestRedisServicePipelined::SetUp();
+  }
+};
+
+TEST_F_EX(TestRedisService, PipelinePerTabletFlush, TestRedisServicePipelinedPerTabletFlush) {
+  auto start = std::chrono::steady_clock::now();
+  SendCommandAndExpectResponse(__LINE__, PipelineSetCommand(), PipelineSetResponse());
+  auto mid = std::chrono::steady_clock::now();
+  SendCommandAndExpectResponse(__LINE__, PipelineGetCommand(), PipelineGetResponse());
+  auto end = std::chrono::steady_clock::now();
+  auto set_time = std::chrono::duration_cast<std::chrono::milliseconds>(mid - start);
+  auto get_time = std::chrono::duration_cast<std::chrono::milliseconds>(end - mid);
+  LOG(INFO) << yb::Format("Per tablet flush set: $0ms, get: $1ms",
+                          set_time.count(), get_time.count());
+}
+
 TEST_F_EX(TestRedisService, PipelinePartial, TestRedisServicePipelined) {
   SendCommandAndExpectResponse(__LINE__,
       PipelineSetCommand(),
@@ -3244,6 +3267,37 @@ TEST_F(TestRedisService, TestDummyLocal) {
   VerifyCallbacks();
 }
 
+TEST_F(TestRedisService, TestClusterKeySlot) {
+  expected_no_sessions_ = true;
+  DoRedisTestInt(__LINE__, {"CLUSTER", "KEYSLOT", "foo"}, 12182);
+  DoRedisTestInt(__LINE__, {"CLUSTER", "KEYSLOT", "somekey"}, 11058);
+  // Only the hash tag is hashed.
+  DoRedisTestInt(__LINE__, {"CLUSTER", "KEYSLOT", "{user1000}.following"}, 3443);
+  DoRedisTestInt(__LINE__, {"cluster", "keyslot", "user1000"}, 3443);
+
+  SyncClient();
+  VerifyCallbacks();
+}
+
+// The test redis server does not run in a tablet server, so the leaders of all tablets are remote.
+TEST_F(TestRedisService, TestClusterRedirects) {
+  FLAGS_redis_cluster_redirects = true;
+  DoRedisTestExpectError(__LINE__, {"SET", "foo", "v"}, "MOVED 12182 ");
+  DoRedisTestExpectError(__LINE__, {"GET", "{user1000}.following"}, "MOVED 3443 ");
+  // The locations of the tablet were refreshed after the first redirect.
+  DoRedisTestExpectError(__LINE__, {"GET", "foo"}, "MOVED 12182 ");
+  // Commands without keys are still served locally.
+  DoRedisTestInt(__LINE__, {"CLUSTER", "KEYSLOT", "foo"}, 12182);
+  SyncClient();
+
+  FLAGS_redis_cluster_redirects = false;
+  DoRedisTestOk(__LINE__, {"SET", "foo", "v"});
+  DoRedisTestBulkString(__LINE__, {"GET", "foo"}, "v");
+
+  SyncClient();
+  VerifyCallbacks();
+}
+
 TEST_F(TestRedisService, TestTimeSeriesTtl) {
   FLAGS_emulate_redis_responses = true;
   DoRedisTestOk(__LINE__, {"TSADD", "key", "10", "v", "EXPIRE_IN", "5"});
@@ -3623,6 +3677,53 @@ TEST_F(TestRedisService, TestZRevRange) {
   VerifyCallbacks();
 }
 
+TEST_F(TestRedisService, TestZRangeFromEnd) {
+  constexpr int kNumMembers = 100;
+  // Members with the same score form groups of 3, scores and names have the same order, since
+  // all names have the same length.
+  std::vector<std::string> command = {"ZADD", "z_large"};
+  for (int i = 0; i != kNumMembers; ++i) {
+    command.push_back(std::to_string(i / 3));
+    command.push_back(Format("m$0", 1000 + i));
+  }
+  DoRedisTestInt(__LINE__, command, kNumMembers);
+  SyncClient();
+
+  // Removed members should not be counted by the backward iteration.
+  std::vector<std::string> members;
+  for (int i = 0; i != kNumMembers; ++i) {
+    auto member = Format("m$0", 1000 + i);
+    if (i % 7 == 0) {
+      DoRedisTestInt(__LINE__, {"ZREM", "z_large", member}, 1);
+    } else {
+      members.push_back(member);
+    }
+  }
+  SyncClient();
+
+  const int num_members = static_cast<int>(members.size());
+  for (bool read_from_end : {false, true}) {
+    FLAGS_redis_sorted_set_read_from_end = read_from_end;
+    for (auto range : std::vector<std::pair<int, int>>{
+             {0, 4}, {num_members - 5, num_members - 1}, {50, 70}, {0, num_members - 1},
+             {num_members - 1, num_members + 10}}) {
+      std::vector<std::string> expected;
+      std::vector<std::string> expected_reverse;
+      for (int i = range.first; i <= std::min(range.second, num_members - 1); ++i) {
+        expected.push_back(members[i]);
+        expected_reverse.push_back(members[num_members - 1 - i]);
+      }
+      auto low = std::to_string(range.first);
+      auto high = std::to_string(range.second);
+      DoRedisTestArray(__LINE__, {"ZRANGE", "z_large", low, high}, expected);
+      DoRedisTestArray(__LINE__, {"ZREVRANGE", "z_large", low, high}, expected_reverse);
+      SyncClient();
+    }
+  }
+
+  VerifyCallbacks();
+}
+
 TEST_F(TestRedisService, TestZRange) {
   // The default value is true, but we explicitly set this here for clarity.
   FLAGS_emulate_redis_responses = true;